@@ -186,7 +186,7 @@ int up_allocpage(FAR struct tcb_s *tcb, FAR void **vpage)
    */
 
   pgndx = g_pgndx++;
-  if (g_pgndx >= CONFIG_PAGING)
+  if (g_pgndx >= CONFIG_PAGING_NPPAGED)
     {
       g_pgndx  = 0;
       g_pgwrap = true;
@@ -35,6 +35,11 @@
 #include "arm_arch.h"
 #include "arm_internal.h"
 
+#ifdef CONFIG_ARMV7M_STACKGUARD
+#  include "sched/sched.h"
+#  include "mpu.h"
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -76,6 +81,20 @@ uint32_t *arm_doirq(int irq, uint32_t *regs)
    * switch occurred during interrupt processing.
    */
 
+#ifdef CONFIG_ARMV7M_STACKGUARD
+  if ((uint32_t *)CURRENT_REGS != regs)
+    {
+      /* Move the guard region under the stack of the new thread.  The IDLE
+       * thread does not have a stack allocation.
+       */
+
+      FAR struct tcb_s *tcb = this_task();
+
+      mpu_stackguard(tcb->stack_alloc_ptr != NULL ?
+                     STACKGUARD_BASE(tcb->stack_alloc_ptr) : 0);
+    }
+#endif
+
   regs = (uint32_t *)CURRENT_REGS;
 
   /* Restore the previous value of CURRENT_REGS.  NULL would indicate that
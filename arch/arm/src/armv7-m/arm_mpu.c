@@ -28,6 +28,7 @@
 #include <assert.h>
 
 #include "mpu.h"
+#include "barriers.h"
 #include "arm_internal.h"
 
 /*****************************************************************************
@@ -196,7 +197,13 @@ static inline uint32_t mpu_subregion_ls(size_t offset, uint8_t l2size)
 
 unsigned int mpu_allocregion(void)
 {
+#ifdef CONFIG_ARMV7M_STACKGUARD
+  /* The last region is reserved for the stack guard */
+
+  DEBUGASSERT(g_region < CONFIG_ARM_MPU_NREGIONS - 1);
+#else
   DEBUGASSERT(g_region < CONFIG_ARM_MPU_NREGIONS);
+#endif
   return (unsigned int)g_region++;
 }
 
@@ -386,3 +393,49 @@ void mpu_configure_region(uintptr_t base, size_t size,
            flags;
   putreg32(regval, MPU_RASR);
 }
+
+/*****************************************************************************
+ * Name: mpu_stackguard
+ *
+ * Description:
+ *   Move the stack guard region to 'base' or disable it if 'base' is zero.
+ *   The guard uses the last region, which overrides all other regions, and
+ *   allows no access at all.
+ *
+ *****************************************************************************/
+
+#ifdef CONFIG_ARMV7M_STACKGUARD
+void mpu_stackguard(uintptr_t base)
+{
+  unsigned int region = CONFIG_ARM_MPU_NREGIONS - 1;
+
+  DEBUGASSERT((base & (STACKGUARD_SIZE - 1)) == 0);
+
+  putreg32(region, MPU_RNR);
+  if (base == 0)
+    {
+      putreg32(0, MPU_RASR);
+    }
+  else
+    {
+      putreg32(base | region | MPU_RBAR_VALID, MPU_RBAR);
+      putreg32(MPU_RASR_ENABLE              | /* Enable region  */
+               MPU_RASR_SIZE_LOG2(5)        | /* 32 bytes       */
+               MPU_RASR_AP_NONO             | /* P:None U:None  */
+               MPU_RASR_XN,                   /* No Instruction access */
+               MPU_RASR);
+    }
+
+  /* The guard needs the MPU.  Keep the default memory map for everything
+   * else if nobody enabled it yet.
+   */
+
+  if ((getreg32(MPU_CTRL) & MPU_CTRL_ENABLE) == 0)
+    {
+      mpu_control(true, false, true);
+    }
+
+  ARM_DSB();
+  ARM_ISB();
+}
+#endif
@@ -0,0 +1,164 @@
+/****************************************************************************
+ * arch/arm/src/armv7-m/dcache.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __ARCH_ARM_SRC_ARMV7_M_DCACHE_H
+#define __ARCH_ARM_SRC_ARMV7_M_DCACHE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <nuttx/cache.h>
+#include <nuttx/kmalloc.h>
+
+#include "chip.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Buffers that are the target of DMA must occupy whole D-Cache lines:  A
+ * line that is shared with other data may be written back over the data
+ * received by DMA, or invalidated with the other data still dirty in it.
+ * ARMV7M_DCACHE_LINESIZE is provided by the chip.h header of MCUs with a
+ * D-Cache.
+ */
+
+#if defined(CONFIG_ARMV7M_DCACHE) && defined(ARMV7M_DCACHE_LINESIZE) && \
+    ARMV7M_DCACHE_LINESIZE > 0
+#  define ARMV7M_DCACHE_LINEMASK   (ARMV7M_DCACHE_LINESIZE - 1)
+#else
+#  define ARMV7M_DCACHE_LINEMASK   0
+#endif
+
+/* Round a size up to whole D-Cache lines */
+
+#define ARMV7M_DCACHE_ALIGN_UP(n) \
+  (((n) + ARMV7M_DCACHE_LINEMASK) & ~ARMV7M_DCACHE_LINEMASK)
+
+/* True if a buffer starts on a D-Cache line boundary */
+
+#define ARMV7M_DCACHE_ALIGNED(p) \
+  (((uintptr_t)(p) & ARMV7M_DCACHE_LINEMASK) == 0)
+
+/* Declare a static DMA buffer, for example:
+ *
+ *   static uint8_t g_rxbuffer[ARMV7M_DCACHE_ALIGN_UP(512)]
+ *     ARMV7M_DCACHE_ALIGNMENT;
+ */
+
+#if ARMV7M_DCACHE_LINEMASK > 0
+#  define ARMV7M_DCACHE_ALIGNMENT  aligned_data(ARMV7M_DCACHE_LINESIZE)
+#else
+#  define ARMV7M_DCACHE_ALIGNMENT
+#endif
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+#ifndef __ASSEMBLY__
+
+/****************************************************************************
+ * Name: arm_dma_alloc
+ *
+ * Description:
+ *   Allocate a buffer for DMA.  The buffer starts on a D-Cache line
+ *   boundary and is rounded up to whole lines, so that its cache
+ *   maintenance never touches other data.  It is freed with kmm_free().
+ *
+ ****************************************************************************/
+
+static inline FAR void *arm_dma_alloc(size_t size)
+{
+#if ARMV7M_DCACHE_LINEMASK > 0
+  return kmm_memalign(ARMV7M_DCACHE_LINESIZE, ARMV7M_DCACHE_ALIGN_UP(size));
+#else
+  return kmm_malloc(size);
+#endif
+}
+
+/****************************************************************************
+ * Name: arm_dma_txprepare
+ *
+ * Description:
+ *   Write the data of a buffer back to memory before a DMA transfer reads
+ *   it.  Only the lines that hold the buffer are cleaned.
+ *
+ ****************************************************************************/
+
+static inline void arm_dma_txprepare(FAR const void *buffer, size_t len)
+{
+  uintptr_t start = (uintptr_t)buffer;
+
+  if (len > 0)
+    {
+      up_clean_dcache(start, start + len);
+    }
+}
+
+/****************************************************************************
+ * Name: arm_dma_rxprepare
+ *
+ * Description:
+ *   Discard the cached content of a buffer before a DMA transfer writes
+ *   it, so that no dirty line is evicted over the received data while the
+ *   transfer is in progress.
+ *
+ ****************************************************************************/
+
+static inline void arm_dma_rxprepare(FAR void *buffer, size_t len)
+{
+  uintptr_t start = (uintptr_t)buffer;
+
+  if (len > 0)
+    {
+      up_invalidate_dcache(start, start + len);
+    }
+}
+
+/****************************************************************************
+ * Name: arm_dma_rxcomplete
+ *
+ * Description:
+ *   Discard the cached content of a buffer after a DMA transfer wrote it.
+ *   The CPU may have loaded lines of the buffer speculatively while the
+ *   transfer was in progress.  Only the received length needs to be
+ *   given.
+ *
+ ****************************************************************************/
+
+static inline void arm_dma_rxcomplete(FAR void *buffer, size_t len)
+{
+  uintptr_t start = (uintptr_t)buffer;
+
+  if (len > 0)
+    {
+      up_invalidate_dcache(start, start + len);
+    }
+}
+
+#endif /* __ASSEMBLY__ */
+#endif /* __ARCH_ARM_SRC_ARMV7_M_DCACHE_H */
@@ -210,6 +210,18 @@ uint32_t mpu_subregion(uintptr_t base, size_t size, uint8_t l2size);
 
 void mpu_control(bool enable, bool hfnmiena, bool privdefena);
 
+/*********************************************************************************************
+ * Name: mpu_stackguard
+ *
+ * Description:
+ *   Move the stack guard region to 'base' or disable it if 'base' is zero
+ *
+ *********************************************************************************************/
+
+#ifdef CONFIG_ARMV7M_STACKGUARD
+void mpu_stackguard(uintptr_t base);
+#endif
+
 /*********************************************************************************************
  * Name: mpu_configure_region
  *
@@ -368,6 +368,12 @@ void up_disable_dcache(void)
  *   in sets that could be associated with the address range, regardless of
  *   whether the address range is contained in the cache or not.
  *
+ *   A cache line at either end that is only partly in the region is
+ *   cleaned and invalidated instead, so that data of neighboring objects
+ *   in the same line is not lost.  Buffers for DMA should still be
+ *   aligned to cache lines:  Such a line is written back over whatever
+ *   the DMA placed in it.
+ *
  * Input Parameters:
  *   start - virtual start address of region
  *   end   - virtual end address of region + 1
@@ -398,16 +404,33 @@ void up_invalidate_dcache(uintptr_t start, uintptr_t end)
 
   ssize  = (1 << sshift);
 
-  /* Round down the start address to the nearest cache line boundary.
-   *
-   *   sshift = 5      : Offset to the beginning of the set field
-   *   (ssize - 1)  = 0x007f : Mask of the set field
+  ARM_DSB();
+
+  /* Clean and invalidate a partial line at the start of the region and
+   * continue with the next line boundary.
    */
 
-  start &= ~(ssize - 1);
-  ARM_DSB();
+  if ((start & (ssize - 1)) != 0)
+    {
+      start &= ~(ssize - 1);
+      putreg32(start, NVIC_DCCIMVAC);
+      start += ssize;
+    }
 
-  do
+  /* Clean and invalidate a partial line at the end of the region (unless
+   * it is the same line as at the start) and stop at its boundary.
+   */
+
+  if ((end & (ssize - 1)) != 0)
+    {
+      end &= ~(ssize - 1);
+      if (end >= start)
+        {
+          putreg32(end, NVIC_DCCIMVAC);
+        }
+    }
+
+  while (start < end)
     {
       /* The below store causes the cache to check its directory and
        * determine if this address is contained in the cache. If so, it
@@ -422,7 +445,6 @@ void up_invalidate_dcache(uintptr_t start, uintptr_t end)
 
       start += ssize;
     }
-  while (start < end);
 
   ARM_DSB();
   ARM_ISB();
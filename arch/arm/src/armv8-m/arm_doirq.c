@@ -35,6 +35,19 @@
 #include "arm_arch.h"
 #include "arm_internal.h"
 
+#ifdef CONFIG_ARMV8M_STACKLIMIT
+#  include <nuttx/tls.h>
+#  include "sched/sched.h"
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_ARMV8M_STACKLIMIT
+uint32_t g_stacklimit;
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -46,6 +59,9 @@ uint32_t *arm_doirq(int irq, uint32_t *regs)
   PANIC();
 #else
   uint32_t *savestate;
+#ifdef CONFIG_ARMV8M_STACKLIMIT
+  FAR struct tcb_s *tcb;
+#endif
 
   /* Nested interrupts are not supported in this implementation.  If you
    * want to implement nested interrupts, you would have to (1) change the
@@ -78,6 +94,19 @@ uint32_t *arm_doirq(int irq, uint32_t *regs)
 
   regs = (uint32_t *)CURRENT_REGS;
 
+#ifdef CONFIG_ARMV8M_STACKLIMIT
+  /* Provide the stack limit of the thread that we return to.  The limit
+   * excludes the TLS data at the bottom of the stack and is 8-byte aligned
+   * as required by the hardware.  The IDLE thread does not have a stack
+   * allocation and is not checked.
+   */
+
+  tcb          = this_task();
+  g_stacklimit = tcb->stack_alloc_ptr == NULL ? 0 :
+                 ((uintptr_t)tcb->stack_alloc_ptr +
+                  sizeof(struct tls_info_s) + 7) & ~7;
+#endif
+
   /* Restore the previous value of CURRENT_REGS.  NULL would indicate that
    * we are no longer in an interrupt handler.  It will be non-NULL if we
    * are returning from a nested interrupt.
@@ -109,6 +109,15 @@ static size_t do_stackcheck(uintptr_t alloc, size_t size, bool int_stack)
   start = alloc & ~3;
 #endif
 
+#ifdef CONFIG_ARMV7M_STACKGUARD
+  /* The MPU guard region of the running thread may not be read */
+
+  if (!int_stack)
+    {
+      start = STACKGUARD_BASE(alloc) + STACKGUARD_SIZE;
+    }
+#endif
+
   end   = (alloc + size + 3) & ~3;
 
   /* Get the adjusted size based on the top and bottom of the stack */
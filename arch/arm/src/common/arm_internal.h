@@ -31,6 +31,9 @@
 #  include <nuttx/compiler.h>
 #  include <sys/types.h>
 #  include <stdint.h>
+#  ifdef CONFIG_ARMV7M_STACKGUARD
+#    include <nuttx/tls.h>
+#  endif
 #endif
 
 /****************************************************************************
@@ -163,6 +166,17 @@
 #define INTSTACK_COLOR 0xdeadbeef
 #define HEAP_COLOR     'h'
 
+/* The ARMv7-M MPU stack guard region lies just above the TLS data at the
+ * bottom of the stack allocation.
+ */
+
+#ifdef CONFIG_ARMV7M_STACKGUARD
+#  define STACKGUARD_SIZE 32
+#  define STACKGUARD_BASE(alloc) \
+     (((uintptr_t)(alloc) + sizeof(struct tls_info_s) + \
+       STACKGUARD_SIZE - 1) & ~(STACKGUARD_SIZE - 1))
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -221,6 +235,12 @@ EXTERN uint32_t g_intstackalloc; /* Allocated stack base */
 EXTERN uint32_t g_intstackbase;  /* Initial top of interrupt stack */
 #endif
 
+/* The stack limit that exception_common() loads on return to a thread */
+
+#ifdef CONFIG_ARMV8M_STACKLIMIT
+EXTERN uint32_t g_stacklimit;
+#endif
+
 /* These 'addresses' of these values are setup by the linker script.  They
  * are not actual uint32_t storage locations! They are only used
  * meaningfully in the following way:
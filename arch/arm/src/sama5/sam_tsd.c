@@ -67,6 +67,7 @@
 #include <nuttx/clock.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/input/touchscreen.h>
+#include <nuttx/fs/fs.h>
 
 #include <arch/board/board.h>
 
@@ -280,7 +281,7 @@ static void sam_tsd_notify(struct sam_tsd_s *priv)
         {
           fds->revents |= POLLIN;
           iinfo("Report events: %02x\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_notify(fds);
         }
     }
 }
@@ -315,6 +315,7 @@ struct stm32_i2s_s
 #ifdef I2S_HAVE_TX
   struct stm32_transport_s tx;    /* TX transport state */
 #endif
+  struct audio_stats_s stats;     /* Buffer and xrun counts */
 
   /* Pre-allocated pool of buffer containers */
 
@@ -443,6 +444,8 @@ static int      stm32_i2s_send(struct i2s_dev_s *dev,
                                struct ap_buffer_s *apb,
                                i2s_callback_t callback, void *arg,
                                uint32_t timeout);
+static int      stm32_i2s_ioctl(struct i2s_dev_s *dev, int cmd,
+                                unsigned long arg);
 
 /* Initialization */
 
@@ -476,6 +479,10 @@ static const struct i2s_ops_s g_i2sops =
   .i2s_txsamplerate = stm32_i2s_txsamplerate,
   .i2s_txdatawidth  = stm32_i2s_txdatawidth,
   .i2s_send         = stm32_i2s_send,
+
+  /* Ioctl */
+
+  .i2s_ioctl        = stm32_i2s_ioctl,
 };
 
 /****************************************************************************
@@ -1272,6 +1279,16 @@ static void i2s_rx_schedule(struct stm32_i2s_s *priv, int result)
       /* Report the result of the transfer */
 
       bfcontainer->result = result;
+      priv->stats.rxbuffers++;
+
+      /* If no free buffer is waiting, the samples that arrive before the
+       * worker can start the next DMA are lost.
+       */
+
+      if (sq_empty(&priv->rx.pend))
+        {
+          priv->stats.overruns++;
+        }
 
       /* Add the completed buffer container to the tail of the rx.done
        * queue
@@ -1659,6 +1676,17 @@ static void i2s_tx_schedule(struct stm32_i2s_s *priv, int result)
       /* Report the result of the transfer */
 
       bfcontainer->result = result;
+      priv->stats.txbuffers++;
+
+      /* Running out of data before the final buffer leaves a gap in the
+       * output.
+       */
+
+      if (sq_empty(&priv->tx.pend) &&
+          (bfcontainer->apb->flags & AUDIO_APB_FINAL) == 0)
+        {
+          priv->stats.underruns++;
+        }
 
       /* Add the completed buffer container to the tail of the tx.done
        * queue
@@ -2182,6 +2210,47 @@ errout_with_buf:
 #endif
 }
 
+/****************************************************************************
+ * Name: stm32_i2s_ioctl
+ *
+ * Description:
+ *   Handle the I2S ioctl commands.  Only AUDIOIOC_GETSTATS is supported.
+ *
+ * Input Parameters:
+ *   dev - Device-specific state data
+ *   cmd - The ioctl command
+ *   arg - The ioctl argument
+ *
+ * Returned Value:
+ *   OK on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+static int stm32_i2s_ioctl(struct i2s_dev_s *dev, int cmd,
+                           unsigned long arg)
+{
+  struct stm32_i2s_s *priv = (struct stm32_i2s_s *)dev;
+  struct audio_stats_s *stats;
+  irqstate_t flags;
+
+  switch (cmd)
+    {
+      case AUDIOIOC_GETSTATS:
+        stats = (struct audio_stats_s *)((uintptr_t)arg);
+        DEBUGASSERT(stats != NULL);
+
+        /* The counts are updated from the DMA interrupt */
+
+        flags  = enter_critical_section();
+        *stats = priv->stats;
+        leave_critical_section(flags);
+        return OK;
+
+      default:
+        return -ENOTTY;
+    }
+}
+
 /****************************************************************************
  * Name: i2s_mckdivider
  *
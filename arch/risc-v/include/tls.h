@@ -62,7 +62,20 @@
  *
  ****************************************************************************/
 
-#ifdef CONFIG_TLS_ALIGNED
+#if defined(CONFIG_TLS_THREAD_POINTER)
+static inline FAR struct tls_info_s *up_tls_info(void)
+{
+  FAR struct tls_info_s *info;
+
+  /* up_initial_state() loaded tp with the beginning of the stack memory
+   * allocation.
+   */
+
+  DEBUGASSERT(!up_interrupt_context());
+  __asm__ __volatile__ ("mv %0, tp" : "=r" (info));
+  return info;
+}
+#elif defined(CONFIG_TLS_ALIGNED)
 static inline FAR struct tls_info_s *up_tls_info(void)
 {
   DEBUGASSERT(!up_interrupt_context());
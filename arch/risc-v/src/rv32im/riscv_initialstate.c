@@ -88,6 +88,14 @@ void up_initial_state(struct tcb_s *tcb)
 
   xcp->regs[REG_EPC]     = (uint32_t)tcb->start;
 
+#ifdef CONFIG_TLS_THREAD_POINTER
+  /* The thread pointer holds the location of the TLS data, which lies at
+   * the beginning of the stack memory allocation (see up_tls_info()).
+   */
+
+  xcp->regs[REG_TP]      = (uint32_t)tcb->stack_alloc_ptr;
+#endif
+
   /* If this task is running PIC, then set the PIC base register to the
    * address of the allocated D-Space region.
    */
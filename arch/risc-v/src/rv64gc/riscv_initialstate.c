@@ -88,6 +88,14 @@ void up_initial_state(struct tcb_s *tcb)
 
   xcp->regs[REG_EPC]     = (uintptr_t)tcb->start;
 
+#ifdef CONFIG_TLS_THREAD_POINTER
+  /* The thread pointer holds the location of the TLS data, which lies at
+   * the beginning of the stack memory allocation (see up_tls_info()).
+   */
+
+  xcp->regs[REG_TP]      = (uintptr_t)tcb->stack_alloc_ptr;
+#endif
+
   /* Set the initial value of the interrupt context register.
    *
    * Since various RISC-V platforms use different interrupt
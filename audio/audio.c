@@ -55,6 +55,8 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/mqueue.h>
 #include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/audio/audio.h>
 #include <nuttx/semaphore.h>
@@ -92,6 +94,7 @@ struct audio_upperhalf_s
   sem_t             exclsem;          /* Supports mutual exclusion */
   FAR struct audio_lowerhalf_s *dev;  /* lower-half state */
   mqd_t             usermq;           /* User mode app's message queue */
+  struct audio_position_s position;   /* Stream position at the last dequeue */
 };
 
 /****************************************************************************
@@ -334,6 +337,14 @@ static int audio_start(FAR struct audio_upperhalf_s *upper)
 
   if (!upper->started)
     {
+      irqstate_t flags;
+
+      /* Count the position from the start of this stream */
+
+      flags = enter_critical_section();
+      memset(&upper->position, 0, sizeof(upper->position));
+      leave_critical_section(flags);
+
       /* Invoke the bottom half method to start the audio stream */
 
 #ifdef CONFIG_AUDIO_MULTI_SESSION
@@ -667,6 +678,31 @@ static int audio_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         }
         break;
 
+      /* AUDIOIOC_GETPOSITION - Get the stream position
+       *
+       *   ioctl argument:  Pointer to the audio_position_s structure
+       */
+
+      case AUDIOIOC_GETPOSITION:
+        {
+          FAR struct audio_position_s *position =
+            (FAR struct audio_position_s *)((uintptr_t)arg);
+          irqstate_t flags;
+
+          audinfo("AUDIOIOC_GETPOSITION\n");
+          DEBUGASSERT(position != NULL);
+
+          /* The position is updated by the dequeue callback which may run
+           * in interrupt context.
+           */
+
+          flags = enter_critical_section();
+          *position = upper->position;
+          leave_critical_section(flags);
+          ret = OK;
+        }
+        break;
+
       /* Any unrecognized IOCTL commands might be
        * platform-specific ioctl commands
        */
@@ -726,9 +762,17 @@ static inline void audio_dequeuebuffer(FAR struct audio_upperhalf_s *upper,
 #endif
 {
   struct audio_msg_s    msg;
+  irqstate_t            flags;
 
   audinfo("Entry\n");
 
+  /* Advance the stream position */
+
+  flags = enter_critical_section();
+  upper->position.nbytes += apb->nbytes;
+  clock_systime_timespec(&upper->position.ts);
+  leave_critical_section(flags);
+
   /* Send a dequeue message to the user if a message queue is registered */
 
   if (upper->usermq != NULL)
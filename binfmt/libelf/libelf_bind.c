@@ -596,6 +596,15 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
       return ret;
     }
 
+#ifdef CONFIG_SYMTAB_HASH
+  /* Hash the exported symbols once rather than searching them for each
+   * undefined symbol.  Without memory for the hash table, elf_symvalue()
+   * searches the symbols as before.
+   */
+
+  symtab_hashinit(&loadinfo->exphash, exports, nexports);
+#endif
+
 #ifdef CONFIG_ARCH_ADDRENV
   /* If CONFIG_ARCH_ADDRENV=y, then the loaded ELF lies in a virtual address
    * space that may not be in place now.  elf_addrenv_select() will
@@ -684,5 +693,11 @@ int elf_bind(FAR struct elf_loadinfo_s *loadinfo,
 
 #endif
 
+#ifdef CONFIG_SYMTAB_HASH
+  /* The hash table of the exported symbols is not needed any longer */
+
+  symtab_hashfree(&loadinfo->exphash);
+#endif
+
   return ret;
 }
@@ -48,6 +48,7 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/binfmt/elf.h>
 
 #include "libelf.h"
@@ -170,6 +171,23 @@ int elf_init(FAR const char *filename, FAR struct elf_loadinfo_s *loadinfo)
       return ret;
     }
 
+#ifdef CONFIG_ELF_XIP
+  /* Check if the file can be accessed in place.  If so, elf_read() copies
+   * from the mapped file and elf_load() may use read-only sections where
+   * they lie.
+   */
+
+  if (nx_ioctl(loadinfo->filfd, FIOC_MMAP,
+               (unsigned long)((uintptr_t)&loadinfo->xipbase)) < 0)
+    {
+      loadinfo->xipbase = NULL;
+    }
+  else
+    {
+      binfo("File mapped at %p\n", loadinfo->xipbase);
+    }
+#endif
+
   /* Read the ELF ehdr from offset 0 */
 
   ret = elf_read(loadinfo, (FAR uint8_t *)&loadinfo->ehdr,
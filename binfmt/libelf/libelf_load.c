@@ -41,6 +41,7 @@
 
 #include <sys/types.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -81,6 +82,57 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: elf_xipsection
+ *
+ * Description:
+ *   Check if a section can be used in place in the memory-mapped ELF file.
+ *   That is possible for read-only sections that have data in the file,
+ *   that are properly aligned in memory and that have no relocations.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ELF_XIP
+static bool elf_xipsection(FAR struct elf_loadinfo_s *loadinfo, int secidx)
+{
+  FAR Elf_Shdr *shdr = &loadinfo->shdr[secidx];
+  uintptr_t addr;
+  int i;
+
+  if (loadinfo->xipbase == NULL ||
+      (shdr->sh_flags & (SHF_ALLOC | SHF_WRITE)) != SHF_ALLOC ||
+      shdr->sh_type == SHT_NOBITS || shdr->sh_size == 0 ||
+      shdr->sh_offset + shdr->sh_size > loadinfo->filelen)
+    {
+      return false;
+    }
+
+  addr = (uintptr_t)loadinfo->xipbase + shdr->sh_offset;
+  if ((addr & ELF_ALIGN_MASK) != 0 ||
+      (shdr->sh_addralign > 1 && (addr & (shdr->sh_addralign - 1)) != 0))
+    {
+      return false;
+    }
+
+  /* The section must not be modified by any relocation */
+
+  for (i = 1; i < loadinfo->ehdr.e_shnum; i++)
+    {
+      FAR Elf_Shdr *relsec = &loadinfo->shdr[i];
+
+      if ((relsec->sh_type == SHT_REL || relsec->sh_type == SHT_RELA) &&
+          relsec->sh_info == secidx)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+#else
+#  define elf_xipsection(l,i) false
+#endif
+
 /****************************************************************************
  * Name: elf_elfsize
  *
@@ -109,10 +161,10 @@ static void elf_elfsize(struct elf_loadinfo_s *loadinfo)
       FAR Elf_Shdr *shdr = &loadinfo->shdr[i];
 
       /* SHF_ALLOC indicates that the section requires memory during
-       * execution.
+       * execution.  Sections that are used in place need none.
        */
 
-      if ((shdr->sh_flags & SHF_ALLOC) != 0)
+      if ((shdr->sh_flags & SHF_ALLOC) != 0 && !elf_xipsection(loadinfo, i))
         {
           /* SHF_WRITE indicates that the section address space is write-
            * able
@@ -175,6 +227,20 @@ static inline int elf_loadfile(FAR struct elf_loadinfo_s *loadinfo)
           continue;
         }
 
+#ifdef CONFIG_ELF_XIP
+      /* Use read-only sections in the mapped file where they lie */
+
+      if (elf_xipsection(loadinfo, i))
+        {
+          binfo("%d. %08lx->%p (in place)\n", i,
+                (unsigned long)shdr->sh_addr,
+                &loadinfo->xipbase[shdr->sh_offset]);
+
+          shdr->sh_addr = (uintptr_t)&loadinfo->xipbase[shdr->sh_offset];
+          continue;
+        }
+#endif
+
       /* SHF_WRITE indicates that the section address space is write-
        * able
        */
@@ -47,6 +47,7 @@
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/binfmt/elf.h>
 
 /****************************************************************************
@@ -90,33 +91,19 @@ static inline void elf_dumpreaddata(FAR char *buffer, int buflen)
 #endif
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: elf_read
+ * Name: elf_readfile
  *
  * Description:
- *   Read 'readsize' bytes from the object file at 'offset'.  The data is
- *   read into 'buffer.' If 'buffer' is part of the ELF address environment,
- *   then the caller is responsible for assuring that that address
- *   environment is in place before calling this function (i.e., that
- *   elf_addrenv_select() has been called if CONFIG_ARCH_ADDRENV=y).
- *
- * Returned Value:
- *   0 (OK) is returned on success and a negated errno is returned on
- *   failure.
+ *   Read 'readsize' bytes from the object file at 'offset' with read().
  *
  ****************************************************************************/
 
-int elf_read(FAR struct elf_loadinfo_s *loadinfo, FAR uint8_t *buffer,
-             size_t readsize, off_t offset)
+static int elf_readfile(FAR struct elf_loadinfo_s *loadinfo,
+                        FAR uint8_t *buffer, size_t readsize, off_t offset)
 {
   ssize_t nbytes;      /* Number of bytes read */
   off_t   rpos;        /* Position returned by lseek */
 
-  binfo("Read %ld bytes from offset %ld\n", (long)readsize, (long)offset);
-
   /* Loop until all of the requested data has been read. */
 
   while (readsize > 0)
@@ -162,3 +149,125 @@ int elf_read(FAR struct elf_loadinfo_s *loadinfo, FAR uint8_t *buffer,
   elf_dumpreaddata(buffer, readsize);
   return OK;
 }
+
+/****************************************************************************
+ * Name: elf_readahead
+ *
+ * Description:
+ *   Read 'readsize' bytes from the object file at 'offset' through the
+ *   read-ahead buffer.  The buffer is refilled with a single read of the
+ *   file if it does not already hold all of the requested data.
+ *
+ ****************************************************************************/
+
+#if CONFIG_ELF_READAHEAD > 0
+static int elf_readahead(FAR struct elf_loadinfo_s *loadinfo,
+                         FAR uint8_t *buffer, size_t readsize, off_t offset)
+{
+  size_t nbytes;
+  int ret;
+
+  if (offset < loadinfo->raoffset ||
+      offset + (off_t)readsize > loadinfo->raoffset +
+                                 (off_t)loadinfo->ralen)
+    {
+      /* Fill the buffer from the offset up to the end of the file */
+
+      if (offset >= loadinfo->filelen)
+        {
+          return elf_readfile(loadinfo, buffer, readsize, offset);
+        }
+
+      nbytes = CONFIG_ELF_READAHEAD;
+      if (offset + (off_t)nbytes > loadinfo->filelen)
+        {
+          nbytes = loadinfo->filelen - offset;
+        }
+
+      if (nbytes < readsize)
+        {
+          return elf_readfile(loadinfo, buffer, readsize, offset);
+        }
+
+      if (loadinfo->rabuffer == NULL)
+        {
+          loadinfo->rabuffer = (FAR uint8_t *)
+                               kmm_malloc(CONFIG_ELF_READAHEAD);
+          if (loadinfo->rabuffer == NULL)
+            {
+              /* Not fatal.  Read the data without the buffer. */
+
+              return elf_readfile(loadinfo, buffer, readsize, offset);
+            }
+        }
+
+      loadinfo->ralen = 0;
+      ret = elf_readfile(loadinfo, loadinfo->rabuffer, nbytes, offset);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      loadinfo->raoffset = offset;
+      loadinfo->ralen    = nbytes;
+    }
+
+  memcpy(buffer, &loadinfo->rabuffer[offset - loadinfo->raoffset],
+         readsize);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: elf_read
+ *
+ * Description:
+ *   Read 'readsize' bytes from the object file at 'offset'.  The data is
+ *   read into 'buffer.' If 'buffer' is part of the ELF address environment,
+ *   then the caller is responsible for assuring that that address
+ *   environment is in place before calling this function (i.e., that
+ *   elf_addrenv_select() has been called if CONFIG_ARCH_ADDRENV=y).
+ *
+ * Returned Value:
+ *   0 (OK) is returned on success and a negated errno is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+int elf_read(FAR struct elf_loadinfo_s *loadinfo, FAR uint8_t *buffer,
+             size_t readsize, off_t offset)
+{
+  binfo("Read %ld bytes from offset %ld\n", (long)readsize, (long)offset);
+
+#ifdef CONFIG_ELF_XIP
+  /* The data of a file that is mapped in memory is simply copied */
+
+  if (loadinfo->xipbase != NULL)
+    {
+      if (offset < 0 || offset + (off_t)readsize > loadinfo->filelen)
+        {
+          berr("Unexpected end of file\n");
+          return -ENODATA;
+        }
+
+      memcpy(buffer, &loadinfo->xipbase[offset], readsize);
+      elf_dumpreaddata((FAR char *)buffer, readsize);
+      return OK;
+    }
+#endif
+
+#if CONFIG_ELF_READAHEAD > 0
+  /* Small reads go through the read-ahead buffer */
+
+  if (readsize > 0 && readsize < CONFIG_ELF_READAHEAD)
+    {
+      return elf_readahead(loadinfo, buffer, readsize, offset);
+    }
+#endif
+
+  return elf_readfile(loadinfo, buffer, readsize, offset);
+}
@@ -154,6 +154,34 @@ static int elf_symname(FAR struct elf_loadinfo_s *loadinfo,
   return OK;
 }
 
+/****************************************************************************
+ * Name: elf_findexport
+ *
+ * Description:
+ *   Find the exported symbol with the given name, using the hash table of
+ *   the exported symbols if elf_bind() has built one.
+ *
+ ****************************************************************************/
+
+static FAR const struct symtab_s *
+elf_findexport(FAR struct elf_loadinfo_s *loadinfo, FAR const char *name,
+               FAR const struct symtab_s *exports, int nexports)
+{
+#ifdef CONFIG_SYMTAB_HASH
+  if (loadinfo->exphash.symtab == exports &&
+      loadinfo->exphash.nsyms == nexports)
+    {
+      return symtab_findbyhash(&loadinfo->exphash, name);
+    }
+#endif
+
+#ifdef CONFIG_SYMTAB_ORDEREDBYNAME
+  return symtab_findorderedbyname(exports, name, nexports);
+#else
+  return symtab_findbyname(exports, name, nexports);
+#endif
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -304,14 +332,8 @@ int elf_symvalue(FAR struct elf_loadinfo_s *loadinfo, FAR Elf_Sym *sym,
 
         /* Check if the base code exports a symbol of this name */
 
-#ifdef CONFIG_SYMTAB_ORDEREDBYNAME
-        symbol = symtab_findorderedbyname(exports,
-                                          (FAR char *)loadinfo->iobuffer,
-                                          nexports);
-#else
-        symbol = symtab_findbyname(exports, (FAR char *)loadinfo->iobuffer,
-                                   nexports);
-#endif
+        symbol = elf_findexport(loadinfo, (FAR char *)loadinfo->iobuffer,
+                                exports, nexports);
         if (!symbol)
           {
             berr("SHN_UNDEF: Exported symbol \"%s\" not found\n",
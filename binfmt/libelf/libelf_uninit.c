@@ -122,5 +122,18 @@ int elf_freebuffers(struct elf_loadinfo_s *loadinfo)
       loadinfo->buflen    = 0;
     }
 
+#if CONFIG_ELF_READAHEAD > 0
+  if (loadinfo->rabuffer)
+    {
+      kmm_free((FAR void *)loadinfo->rabuffer);
+      loadinfo->rabuffer  = NULL;
+      loadinfo->ralen     = 0;
+    }
+#endif
+
+#ifdef CONFIG_SYMTAB_HASH
+  symtab_hashfree(&loadinfo->exphash);
+#endif
+
   return OK;
 }
@@ -41,10 +41,56 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 
+#include <nuttx/crypto/crypto.h>
 #include <nuttx/crypto/aes.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Multiply each of the four bytes of a word by 2 in the galois field */
+
+#define AES_XTIME(w) ((((w) & 0x7f7f7f7f) << 1) ^ \
+                      ((((w) >> 7) & 0x01010101) * 0x1b))
+
+/* Rotate a word right */
+
+#define AES_ROR(w, n) (((w) >> (n)) | ((w) << (32 - (n))))
+
+/* One column of a full round.  g_te0[] and g_td0[] hold the contribution
+ * of byte 0 of a column; the contributions of the other bytes are the same
+ * words rotated.
+ */
+
+#define AES_TE(s, c) \
+  (g_te0[(s)[c] & 0xff] ^ \
+   AES_ROR(g_te0[((s)[((c) + 1) & 3] >> 8) & 0xff], 24) ^ \
+   AES_ROR(g_te0[((s)[((c) + 2) & 3] >> 16) & 0xff], 16) ^ \
+   AES_ROR(g_te0[(s)[((c) + 3) & 3] >> 24], 8))
+
+#define AES_TD(s, c) \
+  (g_td0[(s)[c] & 0xff] ^ \
+   AES_ROR(g_td0[((s)[((c) + 3) & 3] >> 8) & 0xff], 24) ^ \
+   AES_ROR(g_td0[((s)[((c) + 2) & 3] >> 16) & 0xff], 16) ^ \
+   AES_ROR(g_td0[(s)[((c) + 1) & 3] >> 24], 8))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state of one GCM operation */
+
+struct aes_gcm_s
+{
+  struct aes_state_s aes;   /* The expanded key */
+  uint64_t hh[16];          /* Multiples of H, high halves */
+  uint64_t hl[16];          /* Multiples of H, low halves */
+  uint8_t y[16];            /* The GHASH accumulator */
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -136,6 +182,154 @@ static const uint8_t g_rcon[11] =
   0x8d, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
 };
 
+/* SubBytes and MixColumns of byte 0 of a column */
+
+static const uint32_t g_te0[256] =
+{
+  0xa56363c6, 0x847c7cf8, 0x997777ee, 0x8d7b7bf6,
+  0x0df2f2ff, 0xbd6b6bd6, 0xb16f6fde, 0x54c5c591,
+  0x50303060, 0x03010102, 0xa96767ce, 0x7d2b2b56,
+  0x19fefee7, 0x62d7d7b5, 0xe6abab4d, 0x9a7676ec,
+  0x45caca8f, 0x9d82821f, 0x40c9c989, 0x877d7dfa,
+  0x15fafaef, 0xeb5959b2, 0xc947478e, 0x0bf0f0fb,
+  0xecadad41, 0x67d4d4b3, 0xfda2a25f, 0xeaafaf45,
+  0xbf9c9c23, 0xf7a4a453, 0x967272e4, 0x5bc0c09b,
+  0xc2b7b775, 0x1cfdfde1, 0xae93933d, 0x6a26264c,
+  0x5a36366c, 0x413f3f7e, 0x02f7f7f5, 0x4fcccc83,
+  0x5c343468, 0xf4a5a551, 0x34e5e5d1, 0x08f1f1f9,
+  0x937171e2, 0x73d8d8ab, 0x53313162, 0x3f15152a,
+  0x0c040408, 0x52c7c795, 0x65232346, 0x5ec3c39d,
+  0x28181830, 0xa1969637, 0x0f05050a, 0xb59a9a2f,
+  0x0907070e, 0x36121224, 0x9b80801b, 0x3de2e2df,
+  0x26ebebcd, 0x6927274e, 0xcdb2b27f, 0x9f7575ea,
+  0x1b090912, 0x9e83831d, 0x742c2c58, 0x2e1a1a34,
+  0x2d1b1b36, 0xb26e6edc, 0xee5a5ab4, 0xfba0a05b,
+  0xf65252a4, 0x4d3b3b76, 0x61d6d6b7, 0xceb3b37d,
+  0x7b292952, 0x3ee3e3dd, 0x712f2f5e, 0x97848413,
+  0xf55353a6, 0x68d1d1b9, 0x00000000, 0x2cededc1,
+  0x60202040, 0x1ffcfce3, 0xc8b1b179, 0xed5b5bb6,
+  0xbe6a6ad4, 0x46cbcb8d, 0xd9bebe67, 0x4b393972,
+  0xde4a4a94, 0xd44c4c98, 0xe85858b0, 0x4acfcf85,
+  0x6bd0d0bb, 0x2aefefc5, 0xe5aaaa4f, 0x16fbfbed,
+  0xc5434386, 0xd74d4d9a, 0x55333366, 0x94858511,
+  0xcf45458a, 0x10f9f9e9, 0x06020204, 0x817f7ffe,
+  0xf05050a0, 0x443c3c78, 0xba9f9f25, 0xe3a8a84b,
+  0xf35151a2, 0xfea3a35d, 0xc0404080, 0x8a8f8f05,
+  0xad92923f, 0xbc9d9d21, 0x48383870, 0x04f5f5f1,
+  0xdfbcbc63, 0xc1b6b677, 0x75dadaaf, 0x63212142,
+  0x30101020, 0x1affffe5, 0x0ef3f3fd, 0x6dd2d2bf,
+  0x4ccdcd81, 0x140c0c18, 0x35131326, 0x2fececc3,
+  0xe15f5fbe, 0xa2979735, 0xcc444488, 0x3917172e,
+  0x57c4c493, 0xf2a7a755, 0x827e7efc, 0x473d3d7a,
+  0xac6464c8, 0xe75d5dba, 0x2b191932, 0x957373e6,
+  0xa06060c0, 0x98818119, 0xd14f4f9e, 0x7fdcdca3,
+  0x66222244, 0x7e2a2a54, 0xab90903b, 0x8388880b,
+  0xca46468c, 0x29eeeec7, 0xd3b8b86b, 0x3c141428,
+  0x79dedea7, 0xe25e5ebc, 0x1d0b0b16, 0x76dbdbad,
+  0x3be0e0db, 0x56323264, 0x4e3a3a74, 0x1e0a0a14,
+  0xdb494992, 0x0a06060c, 0x6c242448, 0xe45c5cb8,
+  0x5dc2c29f, 0x6ed3d3bd, 0xefacac43, 0xa66262c4,
+  0xa8919139, 0xa4959531, 0x37e4e4d3, 0x8b7979f2,
+  0x32e7e7d5, 0x43c8c88b, 0x5937376e, 0xb76d6dda,
+  0x8c8d8d01, 0x64d5d5b1, 0xd24e4e9c, 0xe0a9a949,
+  0xb46c6cd8, 0xfa5656ac, 0x07f4f4f3, 0x25eaeacf,
+  0xaf6565ca, 0x8e7a7af4, 0xe9aeae47, 0x18080810,
+  0xd5baba6f, 0x887878f0, 0x6f25254a, 0x722e2e5c,
+  0x241c1c38, 0xf1a6a657, 0xc7b4b473, 0x51c6c697,
+  0x23e8e8cb, 0x7cdddda1, 0x9c7474e8, 0x211f1f3e,
+  0xdd4b4b96, 0xdcbdbd61, 0x868b8b0d, 0x858a8a0f,
+  0x907070e0, 0x423e3e7c, 0xc4b5b571, 0xaa6666cc,
+  0xd8484890, 0x05030306, 0x01f6f6f7, 0x120e0e1c,
+  0xa36161c2, 0x5f35356a, 0xf95757ae, 0xd0b9b969,
+  0x91868617, 0x58c1c199, 0x271d1d3a, 0xb99e9e27,
+  0x38e1e1d9, 0x13f8f8eb, 0xb398982b, 0x33111122,
+  0xbb6969d2, 0x70d9d9a9, 0x898e8e07, 0xa7949433,
+  0xb69b9b2d, 0x221e1e3c, 0x92878715, 0x20e9e9c9,
+  0x49cece87, 0xff5555aa, 0x78282850, 0x7adfdfa5,
+  0x8f8c8c03, 0xf8a1a159, 0x80898909, 0x170d0d1a,
+  0xdabfbf65, 0x31e6e6d7, 0xc6424284, 0xb86868d0,
+  0xc3414182, 0xb0999929, 0x772d2d5a, 0x110f0f1e,
+  0xcbb0b07b, 0xfc5454a8, 0xd6bbbb6d, 0x3a16162c
+};
+
+/* InvSubBytes and InvMixColumns of byte 0 of a column */
+
+static const uint32_t g_td0[256] =
+{
+  0x50a7f451, 0x5365417e, 0xc3a4171a, 0x965e273a,
+  0xcb6bab3b, 0xf1459d1f, 0xab58faac, 0x9303e34b,
+  0x55fa3020, 0xf66d76ad, 0x9176cc88, 0x254c02f5,
+  0xfcd7e54f, 0xd7cb2ac5, 0x80443526, 0x8fa362b5,
+  0x495ab1de, 0x671bba25, 0x980eea45, 0xe1c0fe5d,
+  0x02752fc3, 0x12f04c81, 0xa397468d, 0xc6f9d36b,
+  0xe75f8f03, 0x959c9215, 0xeb7a6dbf, 0xda595295,
+  0x2d83bed4, 0xd3217458, 0x2969e049, 0x44c8c98e,
+  0x6a89c275, 0x78798ef4, 0x6b3e5899, 0xdd71b927,
+  0xb64fe1be, 0x17ad88f0, 0x66ac20c9, 0xb43ace7d,
+  0x184adf63, 0x82311ae5, 0x60335197, 0x457f5362,
+  0xe07764b1, 0x84ae6bbb, 0x1ca081fe, 0x942b08f9,
+  0x58684870, 0x19fd458f, 0x876cde94, 0xb7f87b52,
+  0x23d373ab, 0xe2024b72, 0x578f1fe3, 0x2aab5566,
+  0x0728ebb2, 0x03c2b52f, 0x9a7bc586, 0xa50837d3,
+  0xf2872830, 0xb2a5bf23, 0xba6a0302, 0x5c8216ed,
+  0x2b1ccf8a, 0x92b479a7, 0xf0f207f3, 0xa1e2694e,
+  0xcdf4da65, 0xd5be0506, 0x1f6234d1, 0x8afea6c4,
+  0x9d532e34, 0xa055f3a2, 0x32e18a05, 0x75ebf6a4,
+  0x39ec830b, 0xaaef6040, 0x069f715e, 0x51106ebd,
+  0xf98a213e, 0x3d06dd96, 0xae053edd, 0x46bde64d,
+  0xb58d5491, 0x055dc471, 0x6fd40604, 0xff155060,
+  0x24fb9819, 0x97e9bdd6, 0xcc434089, 0x779ed967,
+  0xbd42e8b0, 0x888b8907, 0x385b19e7, 0xdbeec879,
+  0x470a7ca1, 0xe90f427c, 0xc91e84f8, 0x00000000,
+  0x83868009, 0x48ed2b32, 0xac70111e, 0x4e725a6c,
+  0xfbff0efd, 0x5638850f, 0x1ed5ae3d, 0x27392d36,
+  0x64d90f0a, 0x21a65c68, 0xd1545b9b, 0x3a2e3624,
+  0xb1670a0c, 0x0fe75793, 0xd296eeb4, 0x9e919b1b,
+  0x4fc5c080, 0xa220dc61, 0x694b775a, 0x161a121c,
+  0x0aba93e2, 0xe52aa0c0, 0x43e0223c, 0x1d171b12,
+  0x0b0d090e, 0xadc78bf2, 0xb9a8b62d, 0xc8a91e14,
+  0x8519f157, 0x4c0775af, 0xbbdd99ee, 0xfd607fa3,
+  0x9f2601f7, 0xbcf5725c, 0xc53b6644, 0x347efb5b,
+  0x7629438b, 0xdcc623cb, 0x68fcedb6, 0x63f1e4b8,
+  0xcadc31d7, 0x10856342, 0x40229713, 0x2011c684,
+  0x7d244a85, 0xf83dbbd2, 0x1132f9ae, 0x6da129c7,
+  0x4b2f9e1d, 0xf330b2dc, 0xec52860d, 0xd0e3c177,
+  0x6c16b32b, 0x99b970a9, 0xfa489411, 0x2264e947,
+  0xc48cfca8, 0x1a3ff0a0, 0xd82c7d56, 0xef903322,
+  0xc74e4987, 0xc1d138d9, 0xfea2ca8c, 0x360bd498,
+  0xcf81f5a6, 0x28de7aa5, 0x268eb7da, 0xa4bfad3f,
+  0xe49d3a2c, 0x0d927850, 0x9bcc5f6a, 0x62467e54,
+  0xc2138df6, 0xe8b8d890, 0x5ef7392e, 0xf5afc382,
+  0xbe805d9f, 0x7c93d069, 0xa92dd56f, 0xb31225cf,
+  0x3b99acc8, 0xa77d1810, 0x6e639ce8, 0x7bbb3bdb,
+  0x097826cd, 0xf418596e, 0x01b79aec, 0xa89a4f83,
+  0x656e95e6, 0x7ee6ffaa, 0x08cfbc21, 0xe6e815ef,
+  0xd99be7ba, 0xce366f4a, 0xd4099fea, 0xd67cb029,
+  0xafb2a431, 0x31233f2a, 0x3094a5c6, 0xc066a235,
+  0x37bc4e74, 0xa6ca82fc, 0xb0d090e0, 0x15d8a733,
+  0x4a9804f1, 0xf7daec41, 0x0e50cd7f, 0x2ff69117,
+  0x8dd64d76, 0x4db0ef43, 0x544daacc, 0xdf0496e4,
+  0xe3b5d19e, 0x1b886a4c, 0xb81f2cc1, 0x7f516546,
+  0x04ea5e9d, 0x5d358c01, 0x737487fa, 0x2e410bfb,
+  0x5a1d67b3, 0x52d2db92, 0x335610e9, 0x1347d66d,
+  0x8c61d79a, 0x7a0ca137, 0x8e14f859, 0x893c13eb,
+  0xee27a9ce, 0x35c961b7, 0xede51ce1, 0x3cb1477a,
+  0x59dfd29c, 0x3f73f255, 0x79ce1418, 0xbf37c773,
+  0xeacdf753, 0x5baafd5f, 0x146f3ddf, 0x86db4478,
+  0x81f3afca, 0x3ec468b9, 0x2c342438, 0x5f40a3c2,
+  0x72c31d16, 0x0c25e2bc, 0x8b493c28, 0x41950dff,
+  0x7101a839, 0xdeb30c08, 0x9ce4b4d8, 0x90c15664,
+  0x6184cb7b, 0x70b632d5, 0x745c6c48, 0x4257b8d0
+};
+
+/* Reduction of the 4 bits shifted out of a GHASH multiplication */
+
+static const uint16_t g_gcm_last4[16] =
+{
+  0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+  0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0
+};
+
 static struct aes_state_s g_aes_state;
 
 /****************************************************************************
@@ -221,49 +415,107 @@ static void expand_key(FAR uint8_t *expanded_key, FAR const uint8_t *key)
 }
 
 /****************************************************************************
- * Name: galois_mul2
+ * Name: aes_load and aes_store
  *
  * Description:
- *    Multiply by 2 in the galois field
+ *   Load/store one column of the state or of a round key as a 32-bit word.
+ *   Byte n of the column is bits 8n..8n+7 of the word.
  *
- * Input Parameters:
- *  value    argument to multiply
+ ****************************************************************************/
+
+static inline uint32_t aes_load(FAR const uint8_t *p)
+{
+  return (uint32_t)p[0] | (uint32_t)p[1] << 8 |
+         (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static inline void aes_store(FAR uint8_t *p, uint32_t w)
+{
+  p[0] = (uint8_t)w;
+  p[1] = (uint8_t)(w >> 8);
+  p[2] = (uint8_t)(w >> 16);
+  p[3] = (uint8_t)(w >> 24);
+}
+
+/****************************************************************************
+ * Name: aes_mixcolumn
  *
- * Returned Value:
- *  Multiplied argument
+ * Description:
+ *   MixColumns of one column.  All four bytes are multiplied by 2 in the
+ *   galois field at once and without branches:
+ *
+ *     b'n = 2 * (bn ^ bn+1) ^ bn+1 ^ bn+2 ^ bn+3
  *
  ****************************************************************************/
 
-static uint8_t galois_mul2(uint8_t value)
+static inline uint32_t aes_mixcolumn(uint32_t w)
 {
-  if (value >> 7)
-    {
-      value = value << 1;
-      return (value ^ 0x1b);
-    }
-  else
-    {
-      return value << 1;
-    }
+  uint32_t r8 = AES_ROR(w, 8);
+
+  return AES_XTIME(w ^ r8) ^ r8 ^ AES_ROR(w, 16) ^ AES_ROR(w, 24);
+}
+
+/****************************************************************************
+ * Name: aes_invmixcolumn
+ *
+ * Description:
+ *   InvMixColumns of one column.  The inverse matrix is the product of the
+ *   MixColumns matrix and one that just adds 4 * bn+2 to each byte.
+ *
+ ****************************************************************************/
+
+static inline uint32_t aes_invmixcolumn(uint32_t w)
+{
+  uint32_t t = AES_XTIME(AES_XTIME(w ^ AES_ROR(w, 16)));
+
+  return aes_mixcolumn(w ^ t);
+}
+
+/****************************************************************************
+ * Name: aes_subshift
+ *
+ * Description:
+ *   SubBytes and ShiftRows of column 'c' of the state 's'.
+ *
+ ****************************************************************************/
+
+static inline uint32_t aes_subshift(FAR const uint32_t *s, int c)
+{
+  return (uint32_t)g_sbox[s[c] & 0xff] |
+         (uint32_t)g_sbox[(s[(c + 1) & 3] >> 8) & 0xff] << 8 |
+         (uint32_t)g_sbox[(s[(c + 2) & 3] >> 16) & 0xff] << 16 |
+         (uint32_t)g_sbox[s[(c + 3) & 3] >> 24] << 24;
+}
+
+/****************************************************************************
+ * Name: aes_invsubshift
+ *
+ * Description:
+ *   InvShiftRows and InvSubBytes of column 'c' of the state 's'.
+ *
+ ****************************************************************************/
+
+static inline uint32_t aes_invsubshift(FAR const uint32_t *s, int c)
+{
+  return (uint32_t)g_rsbox[s[c] & 0xff] |
+         (uint32_t)g_rsbox[(s[(c + 3) & 3] >> 8) & 0xff] << 8 |
+         (uint32_t)g_rsbox[(s[(c + 2) & 3] >> 16) & 0xff] << 16 |
+         (uint32_t)g_rsbox[s[(c + 1) & 3] >> 24] << 24;
 }
 
 /****************************************************************************
  * Name: aes_encr
  *
  * Description:
- *  Internal implementation of AES128 encryption.
- *  Straight forward aes encryption implementation. First the group of
- *  operations:
+ *  Internal implementation of AES128 encryption.  The state is processed
+ *  one 32-bit column at a time.  Each of the rounds 1-9 is
  *
- *    - addRoundKey
- *    - subbytes
- *    - shiftrows
+ *    - subbytes and shiftrows
  *    - mixcolums
+ *    - addRoundKey
  *
- *  is executed 9 times, after this addroundkey to finish the 9th round,
- *  after that the 10th round without mixcolums no further subfunctions
- *  to save cycles for function calls no structuring with "for (....)"
- *  to save cycles.
+ *  the 10th round is without mixcolumns.  subbytes and mixcolumns of
+ *  the full rounds are looked up in g_te0[].
  *
  * Input Parameters:
  *  expanded_key expanded AES128 key
@@ -276,205 +528,54 @@ static uint8_t galois_mul2(uint8_t value)
 
 static void aes_encr(FAR uint8_t *state, FAR const uint8_t *expanded_key)
 {
-  uint8_t buf1;
-  uint8_t buf2;
-  uint8_t buf3;
-  uint8_t round;
+  uint32_t s[4];
+  uint32_t t[4];
+  int round;
+  int c;
 
-  for (round = 0; round < 9; round ++)
+  for (c = 0; c < 4; c++)
     {
-      /* addroundkey, sbox and shiftrows */
-
-      /* Row 0 */
-
-      state[0]   = g_sbox[(state[0]  ^ expanded_key[(round * 16)])];
-      state[4]   = g_sbox[(state[4]  ^ expanded_key[(round * 16) +  4])];
-      state[8]   = g_sbox[(state[8]  ^ expanded_key[(round * 16) +  8])];
-      state[12]  = g_sbox[(state[12] ^ expanded_key[(round * 16) + 12])];
-
-      /* Row 1 */
-
-      buf1       = state[1] ^ expanded_key[(round * 16) + 1];
-      state[1]   = g_sbox[(state[5]  ^ expanded_key[(round * 16) +  5])];
-      state[5]   = g_sbox[(state[9]  ^ expanded_key[(round * 16) +  9])];
-      state[9]   = g_sbox[(state[13] ^ expanded_key[(round * 16) + 13])];
-      state[13]  = g_sbox[buf1];
-
-      /* Row 2 */
-
-      buf1       = state[2] ^ expanded_key[(round * 16) + 2];
-      buf2       = state[6] ^ expanded_key[(round * 16) + 6];
-      state[2]   = g_sbox[(state[10] ^ expanded_key[(round * 16) + 10])];
-      state[6]   = g_sbox[(state[14] ^ expanded_key[(round * 16) + 14])];
-      state[10]  = g_sbox[buf1];
-      state[14]  = g_sbox[buf2];
-
-      /* Row 3 */
-
-      buf1       = state[15] ^ expanded_key[(round * 16) + 15];
-      state[15]  = g_sbox[(state[11] ^ expanded_key[(round * 16) + 11])];
-      state[11]  = g_sbox[(state[7]  ^ expanded_key[(round * 16) +  7])];
-      state[7]   = g_sbox[(state[3]  ^ expanded_key[(round * 16) +  3])];
-      state[3]   = g_sbox[buf1];
-
-      /* mixcolums */
-
-      /* Col1 */
-
-      buf1 = state[0] ^ state[1] ^ state[2] ^ state[3];
-      buf2 = state[0];
-
-      buf3 = state[0] ^ state[1];
-      buf3 = galois_mul2(buf3);
-      state[0] = state[0] ^ buf3 ^ buf1;
-
-      buf3 = state[1] ^ state[2];
-      buf3 = galois_mul2(buf3);
-      state[1] = state[1] ^ buf3 ^ buf1;
-
-      buf3 = state[2] ^ state[3];
-      buf3 = galois_mul2(buf3);
-      state[2] = state[2] ^ buf3 ^ buf1;
-
-      buf3 = state[3] ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[3] = state[3] ^ buf3 ^ buf1;
-
-      /* Col2 */
-
-      buf1 = state[4] ^ state[5] ^ state[6] ^ state[7];
-      buf2 = state[4];
-
-      buf3 = state[4] ^ state[5];
-      buf3 = galois_mul2(buf3);
-      state[4] = state[4] ^ buf3 ^ buf1;
-
-      buf3 = state[5] ^ state[6];
-      buf3 = galois_mul2(buf3);
-      state[5] = state[5] ^ buf3 ^ buf1;
-
-      buf3 = state[6] ^ state[7];
-      buf3 = galois_mul2(buf3);
-      state[6] = state[6] ^ buf3 ^ buf1;
-
-      buf3 = state[7] ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[7] = state[7] ^ buf3 ^ buf1;
-
-      /* Col3 */
-
-      buf1 = state[8] ^ state[9] ^ state[10] ^ state[11];
-      buf2 = state[8];
-
-      buf3 = state[8] ^ state[9];
-      buf3 = galois_mul2(buf3);
-      state[8] = state[8] ^ buf3 ^ buf1;
-
-      buf3 = state[9] ^ state[10];
-      buf3 = galois_mul2(buf3);
-      state[9] = state[9] ^ buf3 ^ buf1;
-
-      buf3 = state[10] ^ state[11];
-      buf3 = galois_mul2(buf3);
-      state[10] = state[10] ^ buf3 ^ buf1;
-
-      buf3 = state[11] ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[11] = state[11] ^ buf3 ^ buf1;
-
-      /* Col4 */
-
-      buf1 = state[12] ^ state[13] ^ state[14] ^ state[15];
-      buf2 = state[12];
-
-      buf3 = state[12] ^ state[13];
-      buf3 = galois_mul2(buf3);
-      state[12] = state[12] ^ buf3 ^ buf1;
-
-      buf3 = state[13] ^ state[14];
-      buf3 = galois_mul2(buf3);
-      state[13] = state[13] ^ buf3 ^ buf1;
-
-      buf3 = state[14] ^ state[15];
-      buf3 = galois_mul2(buf3);
-      state[14] = state[14] ^ buf3 ^ buf1;
-
-      buf3 = state[15] ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[15] = state[15] ^ buf3 ^ buf1;
+      s[c] = aes_load(&state[4 * c]) ^ aes_load(&expanded_key[4 * c]);
     }
 
-  /* 10th round without mixcols */
-
-  state[0]   = g_sbox[(state[0]  ^ expanded_key[(round * 16)])];
-  state[4]   = g_sbox[(state[4]  ^ expanded_key[(round * 16) +  4])];
-  state[8]   = g_sbox[(state[8]  ^ expanded_key[(round * 16) +  8])];
-  state[12]  = g_sbox[(state[12] ^ expanded_key[(round * 16) + 12])];
-
-  /* Row 1 */
-
-  buf1       = state[1] ^ expanded_key[(round * 16) + 1];
-  state[1]   = g_sbox[(state[5]  ^ expanded_key[(round * 16) +  5])];
-  state[5]   = g_sbox[(state[9]  ^ expanded_key[(round * 16) +  9])];
-  state[9]   = g_sbox[(state[13] ^ expanded_key[(round * 16) + 13])];
-  state[13]  = g_sbox[buf1];
-
-  /* Row 2 */
-
-  buf1       = state[2] ^ expanded_key[(round * 16) + 2];
-  buf2       = state[6] ^ expanded_key[(round * 16) + 6];
-  state[2]   = g_sbox[(state[10] ^ expanded_key[(round * 16) + 10])];
-  state[6]   = g_sbox[(state[14] ^ expanded_key[(round * 16) + 14])];
-  state[10]  = g_sbox[buf1];
-  state[14]  = g_sbox[buf2];
+  for (round = 1; round < 10; round++)
+    {
+      expanded_key += 16;
 
-  /* Row 3 */
+      t[0] = AES_TE(s, 0) ^ aes_load(&expanded_key[0]);
+      t[1] = AES_TE(s, 1) ^ aes_load(&expanded_key[4]);
+      t[2] = AES_TE(s, 2) ^ aes_load(&expanded_key[8]);
+      t[3] = AES_TE(s, 3) ^ aes_load(&expanded_key[12]);
 
-  buf1       = state[15] ^ expanded_key[(round * 16) + 15];
-  state[15]  = g_sbox[(state[11] ^ expanded_key[(round * 16) + 11])];
-  state[11]  = g_sbox[(state[7]  ^ expanded_key[(round * 16) +  7])];
-  state[7]   = g_sbox[(state[3]  ^ expanded_key[(round * 16) +  3])];
-  state[3]   = g_sbox[buf1];
+      memcpy(s, t, sizeof(s));
+    }
 
-  /* Last addroundkey */
+  expanded_key += 16;
 
-  state[0]  ^= expanded_key[160];
-  state[1]  ^= expanded_key[161];
-  state[2]  ^= expanded_key[162];
-  state[3]  ^= expanded_key[163];
-  state[4]  ^= expanded_key[164];
-  state[5]  ^= expanded_key[165];
-  state[6]  ^= expanded_key[166];
-  state[7]  ^= expanded_key[167];
-  state[8]  ^= expanded_key[168];
-  state[9]  ^= expanded_key[169];
-  state[10] ^= expanded_key[170];
-  state[11] ^= expanded_key[171];
-  state[12] ^= expanded_key[172];
-  state[13] ^= expanded_key[173];
-  state[14] ^= expanded_key[174];
-  state[15] ^= expanded_key[175];
+  for (c = 0; c < 4; c++)
+    {
+      aes_store(&state[4 * c],
+                aes_subshift(s, c) ^ aes_load(&expanded_key[4 * c]));
+    }
 }
 
 /****************************************************************************
  * Name: aes_decr
  *
  * Description:
- *  Internal implementation of AES128 decryption.
- *  Straight forward aes decryption implementation.  The order of substeps is
- *  the exact reverse of decryption inverse functions:
+ *  Internal implementation of AES128 decryption.  The state is processed
+ *  one 32-bit column at a time.  Each of the rounds 9-1 is
  *
- *     - addRoundKey is its own inverse
- *     - rsbox is inverse of sbox
- *     - rightshift instead of leftshift
- *     - invMixColumns = barreto + mixColumns
+ *    - inverse shiftrows and inverse subbytes
+ *    - addRoundKey
+ *    - inverse mixcolums
  *
- *  No further subfunctions to save cycles for function calls no structuring
- *  with "for (....)" to save cycles
+ *  the last round is without inverse mixcolumns.  The inverse subbytes
+ *  and mixcolumns of the full rounds are looked up in g_td0[].
  *
  * Input Parameters:
  *  expanded_key expanded AES128 key
- *  state        16 bytes of cipher text and plain text
+ *  state        16 bytes of plain text and cipher text
  *
  * Returned Value:
  *  None
@@ -483,224 +584,316 @@ static void aes_encr(FAR uint8_t *state, FAR const uint8_t *expanded_key)
 
 static void aes_decr(FAR uint8_t *state, FAR const uint8_t *expanded_key)
 {
-  uint8_t buf1;
-  uint8_t buf2;
-  uint8_t buf3;
-  int8_t round;
-
-  round = 9;
-
-  /* Initial addroundkey */
-
-  state[0]  ^= expanded_key[160];
-  state[1]  ^= expanded_key[161];
-  state[2]  ^= expanded_key[162];
-  state[3]  ^= expanded_key[163];
-  state[4]  ^= expanded_key[164];
-  state[5]  ^= expanded_key[165];
-  state[6]  ^= expanded_key[166];
-  state[7]  ^= expanded_key[167];
-  state[8]  ^= expanded_key[168];
-  state[9]  ^= expanded_key[169];
-  state[10] ^= expanded_key[170];
-  state[11] ^= expanded_key[171];
-  state[12] ^= expanded_key[172];
-  state[13] ^= expanded_key[173];
-  state[14] ^= expanded_key[174];
-  state[15] ^= expanded_key[175];
+  uint32_t s[4];
+  uint32_t t[4];
+  int round;
+  int c;
 
-  /* 10th round without mixcols */
-
-  state[0]   = g_rsbox[state[0]]  ^ expanded_key[(round * 16)];
-  state[4]   = g_rsbox[state[4]]  ^ expanded_key[(round * 16) +  4];
-  state[8]   = g_rsbox[state[8]]  ^ expanded_key[(round * 16) +  8];
-  state[12]  = g_rsbox[state[12]] ^ expanded_key[(round * 16) + 12];
-
-  /* Row 1 */
+  for (c = 0; c < 4; c++)
+    {
+      s[c] = aes_load(&state[4 * c]) ^
+             aes_load(&expanded_key[160 + 4 * c]);
+    }
 
-  buf1       = g_rsbox[state[13]] ^ expanded_key[(round * 16) +  1];
-  state[13]  = g_rsbox[state[9]]  ^ expanded_key[(round * 16) + 13];
-  state[9]   = g_rsbox[state[5]]  ^ expanded_key[(round * 16) +  9];
-  state[5]   = g_rsbox[state[1]]  ^ expanded_key[(round * 16) +  5];
-  state[1]   = buf1;
-
-  /* Row 2 */
+  /* InvMixColumns is linear, so the round key is added to the state after
+   * InvMixColumns as InvMixColumns of the round key.
+   */
 
-  buf1       = g_rsbox[state[2]]  ^ expanded_key[(round * 16) + 10];
-  buf2       = g_rsbox[state[6]]  ^ expanded_key[(round * 16) + 14];
-  state[2]   = g_rsbox[state[10]] ^ expanded_key[(round * 16) +  2];
-  state[6]   = g_rsbox[state[14]] ^ expanded_key[(round * 16) +  6];
-  state[10]  = buf1;
-  state[14]  = buf2;
+  for (round = 9; round > 0; round--)
+    {
+      FAR const uint8_t *rk = &expanded_key[16 * round];
 
-  /* Row 3 */
+      t[0] = AES_TD(s, 0) ^ aes_invmixcolumn(aes_load(&rk[0]));
+      t[1] = AES_TD(s, 1) ^ aes_invmixcolumn(aes_load(&rk[4]));
+      t[2] = AES_TD(s, 2) ^ aes_invmixcolumn(aes_load(&rk[8]));
+      t[3] = AES_TD(s, 3) ^ aes_invmixcolumn(aes_load(&rk[12]));
 
-  buf1       = g_rsbox[state[3]]  ^ expanded_key[(round * 16) + 15];
-  state[3]   = g_rsbox[state[7]]  ^ expanded_key[(round * 16) +  3];
-  state[7]   = g_rsbox[state[11]] ^ expanded_key[(round * 16) +  7];
-  state[11]  = g_rsbox[state[15]] ^ expanded_key[(round * 16) + 11];
-  state[15]  = buf1;
+      memcpy(s, t, sizeof(s));
+    }
 
-  for (round = 8; round >= 0; round--)
+  for (c = 0; c < 4; c++)
     {
-      /* barreto */
+      aes_store(&state[4 * c],
+                aes_invsubshift(s, c) ^ aes_load(&expanded_key[4 * c]));
+    }
+}
 
-      /* Col1 */
+/****************************************************************************
+ * Name: aes_gcm_load64 and aes_gcm_store64
+ *
+ * Description:
+ *   Load/store a big-endian 64-bit value.
+ *
+ ****************************************************************************/
 
-      buf1       = galois_mul2(galois_mul2(state[0] ^ state[2]));
-      buf2       = galois_mul2(galois_mul2(state[1] ^ state[3]));
-      state[0]  ^= buf1;
-      state[1]  ^= buf2;
-      state[2]  ^= buf1;
-      state[3]  ^= buf2;
+static uint64_t aes_gcm_load64(FAR const uint8_t *p)
+{
+  uint64_t v = 0;
+  int i;
 
-      /* Col2 */
+  for (i = 0; i < 8; i++)
+    {
+      v = v << 8 | p[i];
+    }
 
-      buf1       = galois_mul2(galois_mul2(state[4] ^ state[6]));
-      buf2       = galois_mul2(galois_mul2(state[5] ^ state[7]));
-      state[4]  ^= buf1;
-      state[5]  ^= buf2;
-      state[6]  ^= buf1;
-      state[7]  ^= buf2;
+  return v;
+}
 
-      /* Col3 */
+static void aes_gcm_store64(FAR uint8_t *p, uint64_t v)
+{
+  int i;
 
-      buf1       = galois_mul2(galois_mul2(state[8] ^ state[10]));
-      buf2       = galois_mul2(galois_mul2(state[9] ^ state[11]));
-      state[8]  ^= buf1;
-      state[9]  ^= buf2;
-      state[10] ^= buf1;
-      state[11] ^= buf2;
+  for (i = 7; i >= 0; i--)
+    {
+      p[i] = (uint8_t)v;
+      v >>= 8;
+    }
+}
 
-      /* Col4 */
+/****************************************************************************
+ * Name: aes_gcm_init
+ *
+ * Description:
+ *   Expand the key and precompute the multiples of the hash key H for the
+ *   4-bit table driven GHASH multiplication.
+ *
+ ****************************************************************************/
 
-      buf1       = galois_mul2(galois_mul2(state[12] ^ state[14]));
-      buf2       = galois_mul2(galois_mul2(state[13] ^ state[15]));
-      state[12] ^= buf1;
-      state[13] ^= buf2;
-      state[14] ^= buf1;
-      state[15] ^= buf2;
+static void aes_gcm_init(FAR struct aes_gcm_s *gcm, FAR const uint8_t *key)
+{
+  uint8_t h[16];
+  uint64_t vh;
+  uint64_t vl;
+  int i;
+  int j;
 
-      /* mixcolums */
+  aes_setupkey(&gcm->aes, key, AES128_KEY_SIZE);
 
-      /* Col1 */
+  memset(h, 0, sizeof(h));
+  aes_encr(h, gcm->aes.expanded_key);
 
-      buf1 = state[0]  ^ state[1] ^ state[2] ^ state[3];
-      buf2 = state[0];
+  vh = aes_gcm_load64(h);
+  vl = aes_gcm_load64(h + 8);
 
-      buf3 = state[0]  ^ state[1];
-      buf3 = galois_mul2(buf3);
-      state[0] = state[0] ^ buf3 ^ buf1;
+  gcm->hh[0] = 0;
+  gcm->hl[0] = 0;
+  gcm->hh[8] = vh;
+  gcm->hl[8] = vl;
 
-      buf3 = state[1]  ^ state[2];
-      buf3 = galois_mul2(buf3);
-      state[1] = state[1] ^ buf3 ^ buf1;
+  for (i = 4; i > 0; i >>= 1)
+    {
+      uint64_t t = (vl & 1) * 0xe100000000000000ull;
 
-      buf3 = state[2]  ^ state[3];
-      buf3 = galois_mul2(buf3);
-      state[2] = state[2] ^ buf3 ^ buf1;
+      vl = (vh << 63) | (vl >> 1);
+      vh = (vh >> 1) ^ t;
+      gcm->hh[i] = vh;
+      gcm->hl[i] = vl;
+    }
 
-      buf3 = state[3]  ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[3] = state[3] ^ buf3 ^ buf1;
+  for (i = 2; i <= 8; i <<= 1)
+    {
+      for (j = 1; j < i; j++)
+        {
+          gcm->hh[i + j] = gcm->hh[i] ^ gcm->hh[j];
+          gcm->hl[i + j] = gcm->hl[i] ^ gcm->hl[j];
+        }
+    }
 
-      /* Col2 */
+  memset(gcm->y, 0, sizeof(gcm->y));
+}
 
-      buf1 = state[4]  ^ state[5] ^ state[6] ^ state[7];
-      buf2 = state[4];
+/****************************************************************************
+ * Name: aes_gcm_mult
+ *
+ * Description:
+ *   Multiply the GHASH accumulator by H, four bits at a time.
+ *
+ ****************************************************************************/
 
-      buf3 = state[4]  ^ state[5];
-      buf3 = galois_mul2(buf3);
-      state[4] = state[4] ^ buf3 ^ buf1;
+static void aes_gcm_mult(FAR struct aes_gcm_s *gcm)
+{
+  FAR uint8_t *x = gcm->y;
+  uint64_t zh;
+  uint64_t zl;
+  uint8_t rem;
+  uint8_t nib;
+  int i;
 
-      buf3 = state[5]  ^ state[6];
-      buf3 = galois_mul2(buf3);
-      state[5] = state[5] ^ buf3 ^ buf1;
+  zh = gcm->hh[x[15] & 0xf];
+  zl = gcm->hl[x[15] & 0xf];
 
-      buf3 = state[6]  ^ state[7];
-      buf3 = galois_mul2(buf3);
-      state[6] = state[6] ^ buf3 ^ buf1;
+  for (i = 15; i >= 0; i--)
+    {
+      if (i != 15)
+        {
+          nib = x[i] & 0xf;
+          rem = zl & 0xf;
+          zl  = (zh << 60) | (zl >> 4);
+          zh  = (zh >> 4) ^ ((uint64_t)g_gcm_last4[rem] << 48);
+          zh ^= gcm->hh[nib];
+          zl ^= gcm->hl[nib];
+        }
+
+      nib = x[i] >> 4;
+      rem = zl & 0xf;
+      zl  = (zh << 60) | (zl >> 4);
+      zh  = (zh >> 4) ^ ((uint64_t)g_gcm_last4[rem] << 48);
+      zh ^= gcm->hh[nib];
+      zl ^= gcm->hl[nib];
+    }
 
-      buf3 = state[7]  ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[7] = state[7] ^ buf3 ^ buf1;
+  aes_gcm_store64(x, zh);
+  aes_gcm_store64(x + 8, zl);
+}
 
-      /* Col3 */
+/****************************************************************************
+ * Name: aes_gcm_ghash
+ *
+ * Description:
+ *   Add data to the GHASH, the last block padded with zeros.
+ *
+ ****************************************************************************/
 
-      buf1 = state[8]  ^ state[9] ^ state[10] ^ state[11];
-      buf2 = state[8];
+static void aes_gcm_ghash(FAR struct aes_gcm_s *gcm,
+                          FAR const uint8_t *data, size_t len)
+{
+  size_t n;
+  size_t i;
 
-      buf3 = state[8]  ^ state[9];
-      buf3 = galois_mul2(buf3);
-      state[8] = state[8] ^ buf3 ^ buf1;
+  for (; len > 0; len -= n, data += n)
+    {
+      n = len < AES128_BLOCK_SIZE ? len : AES128_BLOCK_SIZE;
 
-      buf3 = state[9]  ^ state[10];
-      buf3 = galois_mul2(buf3);
-      state[9] = state[9] ^ buf3 ^ buf1;
+      for (i = 0; i < n; i++)
+        {
+          gcm->y[i] ^= data[i];
+        }
 
-      buf3 = state[10] ^ state[11];
-      buf3 = galois_mul2(buf3);
-      state[10] = state[10] ^ buf3 ^ buf1;
+      aes_gcm_mult(gcm);
+    }
+}
 
-      buf3 = state[11] ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[11] = state[11] ^ buf3 ^ buf1;
+/****************************************************************************
+ * Name: aes_gcm_ctr
+ *
+ * Description:
+ *   Encrypt or decrypt with the 32-bit counter mode of GCM, starting with
+ *   the counter block following 'j0'.
+ *
+ ****************************************************************************/
 
-      /* Col4 */
+static void aes_gcm_ctr(FAR struct aes_gcm_s *gcm, FAR const uint8_t *j0,
+                        FAR const uint8_t *in, FAR uint8_t *out,
+                        size_t len)
+{
+  uint8_t ctr[AES128_BLOCK_SIZE];
+  uint8_t ks[AES128_BLOCK_SIZE];
+  size_t n;
+  size_t i;
 
-      buf1 = state[12] ^ state[13] ^ state[14] ^ state[15];
-      buf2 = state[12];
+  memcpy(ctr, j0, AES128_BLOCK_SIZE);
 
-      buf3 = state[12] ^ state[13];
-      buf3 = galois_mul2(buf3);
-      state[12] = state[12] ^ buf3 ^ buf1;
+  for (; len > 0; len -= n, in += n, out += n)
+    {
+      for (i = AES128_BLOCK_SIZE - 1;
+           i >= AES128_BLOCK_SIZE - 4 && ++ctr[i] == 0;
+           i--)
+        {
+        }
+
+      memcpy(ks, ctr, AES128_BLOCK_SIZE);
+      aes_encr(ks, gcm->aes.expanded_key);
+
+      n = len < AES128_BLOCK_SIZE ? len : AES128_BLOCK_SIZE;
+      for (i = 0; i < n; i++)
+        {
+          out[i] = in[i] ^ ks[i];
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: aes_gcm
+ *
+ * Description:
+ *   The common part of aes_gcm_encrypt() and aes_gcm_decrypt().  Returns
+ *   the full 16 byte tag.
+ *
+ ****************************************************************************/
+
+static int aes_gcm(FAR const uint8_t *key, uint32_t keysize,
+                   FAR const uint8_t *iv, size_t ivlen,
+                   FAR const uint8_t *aad, size_t aadlen,
+                   FAR const uint8_t *in, FAR uint8_t *out, size_t len,
+                   FAR uint8_t *tag, int encrypt)
+{
+  struct aes_gcm_s gcm;
+  uint8_t j0[AES128_BLOCK_SIZE];
+  uint8_t lens[AES128_BLOCK_SIZE];
+  int i;
 
-      buf3 = state[13] ^ state[14];
-      buf3 = galois_mul2(buf3);
-      state[13] = state[13] ^ buf3 ^ buf1;
+  if (keysize != AES128_KEY_SIZE)
+    {
+      return -ENOTSUP;
+    }
 
-      buf3 = state[14] ^ state[15];
-      buf3 = galois_mul2(buf3);
-      state[14] = state[14] ^ buf3 ^ buf1;
+  if (iv == NULL || ivlen == 0)
+    {
+      return -EINVAL;
+    }
 
-      buf3 = state[15] ^ buf2;
-      buf3 = galois_mul2(buf3);
-      state[15] = state[15] ^ buf3 ^ buf1;
+  aes_gcm_init(&gcm, key);
 
-      /* addroundkey, rsbox and shiftrows */
+  /* The pre-counter block J0 */
 
-      /* Row 0 */
+  if (ivlen == 12)
+    {
+      memcpy(j0, iv, 12);
+      j0[12] = 0;
+      j0[13] = 0;
+      j0[14] = 0;
+      j0[15] = 1;
+    }
+  else
+    {
+      aes_gcm_ghash(&gcm, iv, ivlen);
+      aes_gcm_store64(lens, 0);
+      aes_gcm_store64(lens + 8, (uint64_t)ivlen << 3);
+      aes_gcm_ghash(&gcm, lens, sizeof(lens));
 
-      state[0]   = g_rsbox[state[0]]  ^ expanded_key[(round * 16)];
-      state[4]   = g_rsbox[state[4]]  ^ expanded_key[(round * 16) +  4];
-      state[8]   = g_rsbox[state[8]]  ^ expanded_key[(round * 16) +  8];
-      state[12]  = g_rsbox[state[12]] ^ expanded_key[(round * 16) + 12];
+      memcpy(j0, gcm.y, sizeof(j0));
+      memset(gcm.y, 0, sizeof(gcm.y));
+    }
 
-      /* Row 1 */
+  /* GHASH the additional data and the cypher text */
 
-      buf1       = g_rsbox[state[13]] ^ expanded_key[(round * 16) +  1];
-      state[13]  = g_rsbox[state[9]]  ^ expanded_key[(round * 16) + 13];
-      state[9]   = g_rsbox[state[5]]  ^ expanded_key[(round * 16) +  9];
-      state[5]   = g_rsbox[state[1]]  ^ expanded_key[(round * 16) +  5];
-      state[1]   = buf1;
+  aes_gcm_ghash(&gcm, aad, aadlen);
 
-      /* Row 2 */
+  if (encrypt)
+    {
+      aes_gcm_ctr(&gcm, j0, in, out, len);
+      aes_gcm_ghash(&gcm, out, len);
+    }
+  else
+    {
+      aes_gcm_ghash(&gcm, in, len);
+      aes_gcm_ctr(&gcm, j0, in, out, len);
+    }
 
-      buf1       = g_rsbox[state[2]]  ^ expanded_key[(round * 16) + 10];
-      buf2       = g_rsbox[state[6]]  ^ expanded_key[(round * 16) + 14];
-      state[2]   = g_rsbox[state[10]] ^ expanded_key[(round * 16) +  2];
-      state[6]   = g_rsbox[state[14]] ^ expanded_key[(round * 16) +  6];
-      state[10]  = buf1;
-      state[14]  = buf2;
+  aes_gcm_store64(lens, (uint64_t)aadlen << 3);
+  aes_gcm_store64(lens + 8, (uint64_t)len << 3);
+  aes_gcm_ghash(&gcm, lens, sizeof(lens));
 
-      /* Row 3 */
+  /* The tag is the GHASH encrypted with J0 */
 
-      buf1       = g_rsbox[state[3]]  ^ expanded_key[(round * 16) + 15];
-      state[3]   = g_rsbox[state[7]]  ^ expanded_key[(round * 16) +  3];
-      state[7]   = g_rsbox[state[11]] ^ expanded_key[(round * 16) +  7];
-      state[11]  = g_rsbox[state[15]] ^ expanded_key[(round * 16) + 11];
-      state[15]  = buf1;
+  aes_encr(j0, gcm.aes.expanded_key);
+  for (i = 0; i < AES128_BLOCK_SIZE; i++)
+    {
+      tag[i] = gcm.y[i] ^ j0[i];
     }
+
+  memset(&gcm, 0, sizeof(gcm));
+  return OK;
 }
 
 /****************************************************************************
@@ -840,3 +1033,225 @@ void aes_decrypt(FAR uint8_t *state, FAR const uint8_t *key)
   aes_setupkey(&g_aes_state, key, 16);
   aes_decr(state, g_aes_state.expanded_key);
 }
+
+/****************************************************************************
+ * Name: aes_swcypher
+ *
+ * Description:
+ *   AES128 encryption or decryption of a buffer in ECB, CBC or CTR mode
+ *   with the software implementation.  This has the interface of
+ *   aes_cypher() and is the last resort of crypto_cypher().
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -ENOTSUP if the key or mode is not supported
+ *   -EINVAL if a parameter is invalid
+ *
+ ****************************************************************************/
+
+int aes_swcypher(FAR void *out, FAR const void *in, uint32_t size,
+                 FAR const void *iv, FAR const void *key, uint32_t keysize,
+                 int mode, int encrypt)
+{
+  struct aes_state_s state;
+  FAR uint8_t *dst = out;
+  FAR const uint8_t *src = in;
+  uint8_t chain[AES128_BLOCK_SIZE];
+  uint8_t block[AES128_BLOCK_SIZE];
+  uint32_t len;
+  int i;
+
+  if (keysize != AES128_KEY_SIZE)
+    {
+      return -ENOTSUP;
+    }
+
+  mode &= AES_MODE_MASK;
+  if (mode != AES_MODE_ECB && mode != AES_MODE_CBC && mode != AES_MODE_CTR)
+    {
+      return -ENOTSUP;
+    }
+
+  /* Only CTR is a stream mode */
+
+  if (mode != AES_MODE_CTR && (size % AES128_BLOCK_SIZE) != 0)
+    {
+      return -EINVAL;
+    }
+
+  if (mode != AES_MODE_ECB)
+    {
+      if (iv == NULL)
+        {
+          return -EINVAL;
+        }
+
+      memcpy(chain, iv, AES128_BLOCK_SIZE);
+    }
+
+  aes_setupkey(&state, key, keysize);
+
+  for (; size > 0; size -= len, src += len, dst += len)
+    {
+      len = size < AES128_BLOCK_SIZE ? size : AES128_BLOCK_SIZE;
+
+      switch (mode)
+        {
+          case AES_MODE_ECB:
+            memcpy(block, src, AES128_BLOCK_SIZE);
+            if (encrypt)
+              {
+                aes_encr(block, state.expanded_key);
+              }
+            else
+              {
+                aes_decr(block, state.expanded_key);
+              }
+            break;
+
+          case AES_MODE_CBC:
+            if (encrypt)
+              {
+                for (i = 0; i < AES128_BLOCK_SIZE; i++)
+                  {
+                    block[i] = src[i] ^ chain[i];
+                  }
+
+                aes_encr(block, state.expanded_key);
+                memcpy(chain, block, AES128_BLOCK_SIZE);
+              }
+            else
+              {
+                /* Keep the cypher text for the next block, 'src' may be
+                 * overwritten by 'dst'.
+                 */
+
+                memcpy(block, src, AES128_BLOCK_SIZE);
+                aes_decr(block, state.expanded_key);
+
+                for (i = 0; i < AES128_BLOCK_SIZE; i++)
+                  {
+                    block[i] ^= chain[i];
+                  }
+
+                memcpy(chain, src, AES128_BLOCK_SIZE);
+              }
+            break;
+
+          default: /* AES_MODE_CTR */
+            memcpy(block, chain, AES128_BLOCK_SIZE);
+            aes_encr(block, state.expanded_key);
+
+            for (i = 0; i < len; i++)
+              {
+                block[i] ^= src[i];
+              }
+
+            /* Increment the big-endian counter */
+
+            for (i = AES128_BLOCK_SIZE - 1; i >= 0 && ++chain[i] == 0; i--)
+              {
+              }
+            break;
+        }
+
+      memcpy(dst, block, len);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aes_gcm_encrypt
+ *
+ * Description:
+ *   AES128-GCM authenticated encryption of 'len' bytes from 'in' to 'out'
+ *   ('in' may be equal to 'out').  The 'aad' is authenticated but not
+ *   encrypted.  A tag of 'taglen' (at most 16) bytes is returned in 'tag'.
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -ENOTSUP if the key size is not supported
+ *   -EINVAL if a parameter is invalid
+ *
+ ****************************************************************************/
+
+int aes_gcm_encrypt(FAR const uint8_t *key, uint32_t keysize,
+                    FAR const uint8_t *iv, size_t ivlen,
+                    FAR const uint8_t *aad, size_t aadlen,
+                    FAR const uint8_t *in, FAR uint8_t *out, size_t len,
+                    FAR uint8_t *tag, size_t taglen)
+{
+  uint8_t full[AES128_BLOCK_SIZE];
+  int ret;
+
+  if (taglen > AES128_BLOCK_SIZE)
+    {
+      return -EINVAL;
+    }
+
+  ret = aes_gcm(key, keysize, iv, ivlen, aad, aadlen, in, out, len, full,
+                CYPHER_ENCRYPT);
+  if (ret >= 0)
+    {
+      memcpy(tag, full, taglen);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: aes_gcm_decrypt
+ *
+ * Description:
+ *   AES128-GCM authenticated decryption of 'len' bytes from 'in' to 'out'
+ *   ('in' may be equal to 'out').  If the tag does not match, the output is
+ *   cleared.
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -EBADMSG if the tag does not match
+ *   -ENOTSUP if the key size is not supported
+ *   -EINVAL if a parameter is invalid
+ *
+ ****************************************************************************/
+
+int aes_gcm_decrypt(FAR const uint8_t *key, uint32_t keysize,
+                    FAR const uint8_t *iv, size_t ivlen,
+                    FAR const uint8_t *aad, size_t aadlen,
+                    FAR const uint8_t *in, FAR uint8_t *out, size_t len,
+                    FAR const uint8_t *tag, size_t taglen)
+{
+  uint8_t full[AES128_BLOCK_SIZE];
+  uint8_t diff = 0;
+  size_t i;
+  int ret;
+
+  if (taglen > AES128_BLOCK_SIZE)
+    {
+      return -EINVAL;
+    }
+
+  ret = aes_gcm(key, keysize, iv, ivlen, aad, aadlen, in, out, len, full,
+                CYPHER_DECRYPT);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Compare in constant time */
+
+  for (i = 0; i < taglen; i++)
+    {
+      diff |= full[i] ^ tag[i];
+    }
+
+  if (diff != 0)
+    {
+      memset(out, 0, len);
+      return -EBADMSG;
+    }
+
+  return OK;
+}
+
@@ -0,0 +1,546 @@
+/****************************************************************************
+ * crypto/chachapoly.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/crypto/chachapoly.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define ROL32(x, n)  (((x) << (n)) | ((x) >> (32 - (n))))
+
+#define QUARTERROUND(a, b, c, d) \
+  do \
+    { \
+      a += b; d ^= a; d = ROL32(d, 16); \
+      c += d; b ^= c; b = ROL32(b, 12); \
+      a += b; d ^= a; d = ROL32(d, 8); \
+      c += d; b ^= c; b = ROL32(b, 7); \
+    } \
+  while (0)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline uint32_t cp_load32(FAR const uint8_t *p)
+{
+  return (uint32_t)p[0] | (uint32_t)p[1] << 8 |
+         (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static inline void cp_store32(FAR uint8_t *p, uint32_t v)
+{
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+/****************************************************************************
+ * Name: chacha20_block
+ *
+ * Description:
+ *   Generate one 64 byte block of key stream.  The state is kept in
+ *   registers; the eight double rounds are unrolled only as far as the
+ *   column and diagonal rounds.
+ *
+ ****************************************************************************/
+
+static void chacha20_block(FAR const uint32_t *input, FAR uint8_t *out)
+{
+  uint32_t x0  = input[0];
+  uint32_t x1  = input[1];
+  uint32_t x2  = input[2];
+  uint32_t x3  = input[3];
+  uint32_t x4  = input[4];
+  uint32_t x5  = input[5];
+  uint32_t x6  = input[6];
+  uint32_t x7  = input[7];
+  uint32_t x8  = input[8];
+  uint32_t x9  = input[9];
+  uint32_t x10 = input[10];
+  uint32_t x11 = input[11];
+  uint32_t x12 = input[12];
+  uint32_t x13 = input[13];
+  uint32_t x14 = input[14];
+  uint32_t x15 = input[15];
+  int i;
+
+  for (i = 0; i < 10; i++)
+    {
+      QUARTERROUND(x0, x4, x8,  x12);
+      QUARTERROUND(x1, x5, x9,  x13);
+      QUARTERROUND(x2, x6, x10, x14);
+      QUARTERROUND(x3, x7, x11, x15);
+      QUARTERROUND(x0, x5, x10, x15);
+      QUARTERROUND(x1, x6, x11, x12);
+      QUARTERROUND(x2, x7, x8,  x13);
+      QUARTERROUND(x3, x4, x9,  x14);
+    }
+
+  cp_store32(out + 0,  x0  + input[0]);
+  cp_store32(out + 4,  x1  + input[1]);
+  cp_store32(out + 8,  x2  + input[2]);
+  cp_store32(out + 12, x3  + input[3]);
+  cp_store32(out + 16, x4  + input[4]);
+  cp_store32(out + 20, x5  + input[5]);
+  cp_store32(out + 24, x6  + input[6]);
+  cp_store32(out + 28, x7  + input[7]);
+  cp_store32(out + 32, x8  + input[8]);
+  cp_store32(out + 36, x9  + input[9]);
+  cp_store32(out + 40, x10 + input[10]);
+  cp_store32(out + 44, x11 + input[11]);
+  cp_store32(out + 48, x12 + input[12]);
+  cp_store32(out + 52, x13 + input[13]);
+  cp_store32(out + 56, x14 + input[14]);
+  cp_store32(out + 60, x15 + input[15]);
+}
+
+/****************************************************************************
+ * Name: poly1305_blocks
+ *
+ * Description:
+ *   Add 16 byte blocks to the accumulator.  The arithmetic uses 26-bit
+ *   limbs so that the products fit in 64 bits.  'hibit' is 1 << 24 for
+ *   whole blocks and zero for the padded last block.
+ *
+ ****************************************************************************/
+
+static void poly1305_blocks(FAR struct poly1305_ctx_s *ctx,
+                            FAR const uint8_t *in, size_t len,
+                            uint32_t hibit)
+{
+  uint32_t r0 = ctx->r[0];
+  uint32_t r1 = ctx->r[1];
+  uint32_t r2 = ctx->r[2];
+  uint32_t r3 = ctx->r[3];
+  uint32_t r4 = ctx->r[4];
+  uint32_t s1 = r1 * 5;
+  uint32_t s2 = r2 * 5;
+  uint32_t s3 = r3 * 5;
+  uint32_t s4 = r4 * 5;
+  uint32_t h0 = ctx->h[0];
+  uint32_t h1 = ctx->h[1];
+  uint32_t h2 = ctx->h[2];
+  uint32_t h3 = ctx->h[3];
+  uint32_t h4 = ctx->h[4];
+  uint64_t d0;
+  uint64_t d1;
+  uint64_t d2;
+  uint64_t d3;
+  uint64_t d4;
+  uint32_t c;
+
+  for (; len >= POLY1305_TAG_LENGTH; len -= POLY1305_TAG_LENGTH,
+                                     in += POLY1305_TAG_LENGTH)
+    {
+      /* h += m */
+
+      h0 += (cp_load32(in + 0)) & 0x3ffffff;
+      h1 += (cp_load32(in + 3) >> 2) & 0x3ffffff;
+      h2 += (cp_load32(in + 6) >> 4) & 0x3ffffff;
+      h3 += (cp_load32(in + 9) >> 6) & 0x3ffffff;
+      h4 += (cp_load32(in + 12) >> 8) | hibit;
+
+      /* h *= r */
+
+      d0 = (uint64_t)h0 * r0 + (uint64_t)h1 * s4 + (uint64_t)h2 * s3 +
+           (uint64_t)h3 * s2 + (uint64_t)h4 * s1;
+      d1 = (uint64_t)h0 * r1 + (uint64_t)h1 * r0 + (uint64_t)h2 * s4 +
+           (uint64_t)h3 * s3 + (uint64_t)h4 * s2;
+      d2 = (uint64_t)h0 * r2 + (uint64_t)h1 * r1 + (uint64_t)h2 * r0 +
+           (uint64_t)h3 * s4 + (uint64_t)h4 * s3;
+      d3 = (uint64_t)h0 * r3 + (uint64_t)h1 * r2 + (uint64_t)h2 * r1 +
+           (uint64_t)h3 * r0 + (uint64_t)h4 * s4;
+      d4 = (uint64_t)h0 * r4 + (uint64_t)h1 * r3 + (uint64_t)h2 * r2 +
+           (uint64_t)h3 * r1 + (uint64_t)h4 * r0;
+
+      /* Partial reduction mod 2^130 - 5 */
+
+      c = (uint32_t)(d0 >> 26);
+      h0 = (uint32_t)d0 & 0x3ffffff;
+      d1 += c;
+      c = (uint32_t)(d1 >> 26);
+      h1 = (uint32_t)d1 & 0x3ffffff;
+      d2 += c;
+      c = (uint32_t)(d2 >> 26);
+      h2 = (uint32_t)d2 & 0x3ffffff;
+      d3 += c;
+      c = (uint32_t)(d3 >> 26);
+      h3 = (uint32_t)d3 & 0x3ffffff;
+      d4 += c;
+      c = (uint32_t)(d4 >> 26);
+      h4 = (uint32_t)d4 & 0x3ffffff;
+      h0 += c * 5;
+      c = h0 >> 26;
+      h0 &= 0x3ffffff;
+      h1 += c;
+    }
+
+  ctx->h[0] = h0;
+  ctx->h[1] = h1;
+  ctx->h[2] = h2;
+  ctx->h[3] = h3;
+  ctx->h[4] = h4;
+}
+
+/****************************************************************************
+ * Name: chachapoly_mac
+ *
+ * Description:
+ *   Compute the tag of RFC 8439, section 2.8, over the AAD and the cipher
+ *   text.
+ *
+ ****************************************************************************/
+
+static void chachapoly_mac(FAR const uint8_t *key, FAR const uint8_t *nonce,
+                           FAR const uint8_t *aad, size_t aadlen,
+                           FAR const uint8_t *ct, size_t len,
+                           FAR uint8_t *tag)
+{
+  static const uint8_t zeros[POLY1305_TAG_LENGTH];
+  struct poly1305_ctx_s ctx;
+  uint8_t otk[CHACHA20_BLOCK_LENGTH];
+  uint8_t lens[16];
+
+  /* The one-time key is the first 32 bytes of the block with counter 0 */
+
+  memset(otk, 0, sizeof(otk));
+  chacha20(otk, otk, sizeof(otk), key, nonce, 0);
+  poly1305_init(&ctx, otk);
+
+  poly1305_update(&ctx, aad, aadlen);
+  poly1305_update(&ctx, zeros, -aadlen % POLY1305_TAG_LENGTH);
+  poly1305_update(&ctx, ct, len);
+  poly1305_update(&ctx, zeros, -len % POLY1305_TAG_LENGTH);
+
+  cp_store32(lens + 0, (uint32_t)aadlen);
+  cp_store32(lens + 4, (uint32_t)((uint64_t)aadlen >> 32));
+  cp_store32(lens + 8, (uint32_t)len);
+  cp_store32(lens + 12, (uint32_t)((uint64_t)len >> 32));
+  poly1305_update(&ctx, lens, sizeof(lens));
+
+  poly1305_final(&ctx, tag);
+  memset(otk, 0, sizeof(otk));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: chacha20
+ *
+ * Description:
+ *   Encrypt or decrypt 'len' bytes with ChaCha20.
+ *
+ ****************************************************************************/
+
+void chacha20(FAR uint8_t *out, FAR const uint8_t *in, size_t len,
+              FAR const uint8_t *key, FAR const uint8_t *nonce,
+              uint32_t counter)
+{
+  uint32_t input[16];
+  uint8_t block[CHACHA20_BLOCK_LENGTH];
+  size_t n;
+  size_t i;
+
+  /* "expand 32-byte k" */
+
+  input[0]  = 0x61707865;
+  input[1]  = 0x3320646e;
+  input[2]  = 0x79622d32;
+  input[3]  = 0x6b206574;
+
+  for (i = 0; i < 8; i++)
+    {
+      input[4 + i] = cp_load32(key + 4 * i);
+    }
+
+  input[12] = counter;
+  input[13] = cp_load32(nonce + 0);
+  input[14] = cp_load32(nonce + 4);
+  input[15] = cp_load32(nonce + 8);
+
+  while (len > 0)
+    {
+      chacha20_block(input, block);
+      input[12]++;
+
+      n = len < CHACHA20_BLOCK_LENGTH ? len : CHACHA20_BLOCK_LENGTH;
+      for (i = 0; i < n; i++)
+        {
+          out[i] = in[i] ^ block[i];
+        }
+
+      in  += n;
+      out += n;
+      len -= n;
+    }
+
+  memset(block, 0, sizeof(block));
+  memset(input, 0, sizeof(input));
+}
+
+/****************************************************************************
+ * Name: poly1305_init
+ *
+ * Description:
+ *   Start a Poly1305 MAC with a 32 byte one-time key.
+ *
+ ****************************************************************************/
+
+void poly1305_init(FAR struct poly1305_ctx_s *ctx, FAR const uint8_t *key)
+{
+  /* r &= 0x0ffffffc0ffffffc0ffffffc0fffffff */
+
+  ctx->r[0] = (cp_load32(key + 0)) & 0x3ffffff;
+  ctx->r[1] = (cp_load32(key + 3) >> 2) & 0x3ffff03;
+  ctx->r[2] = (cp_load32(key + 6) >> 4) & 0x3ffc0ff;
+  ctx->r[3] = (cp_load32(key + 9) >> 6) & 0x3f03fff;
+  ctx->r[4] = (cp_load32(key + 12) >> 8) & 0x00fffff;
+
+  memset(ctx->h, 0, sizeof(ctx->h));
+
+  ctx->pad[0] = cp_load32(key + 16);
+  ctx->pad[1] = cp_load32(key + 20);
+  ctx->pad[2] = cp_load32(key + 24);
+  ctx->pad[3] = cp_load32(key + 28);
+
+  ctx->leftover = 0;
+}
+
+/****************************************************************************
+ * Name: poly1305_update
+ *
+ * Description:
+ *   Add data to a Poly1305 MAC.
+ *
+ ****************************************************************************/
+
+void poly1305_update(FAR struct poly1305_ctx_s *ctx, FAR const uint8_t *in,
+                     size_t inlen)
+{
+  size_t n;
+
+  if (ctx->leftover > 0)
+    {
+      n = POLY1305_TAG_LENGTH - ctx->leftover;
+      if (n > inlen)
+        {
+          n = inlen;
+        }
+
+      memcpy(ctx->buffer + ctx->leftover, in, n);
+      ctx->leftover += n;
+      in            += n;
+      inlen         -= n;
+
+      if (ctx->leftover < POLY1305_TAG_LENGTH)
+        {
+          return;
+        }
+
+      poly1305_blocks(ctx, ctx->buffer, POLY1305_TAG_LENGTH, 1 << 24);
+      ctx->leftover = 0;
+    }
+
+  n = inlen & ~(size_t)(POLY1305_TAG_LENGTH - 1);
+  poly1305_blocks(ctx, in, n, 1 << 24);
+
+  memcpy(ctx->buffer, in + n, inlen - n);
+  ctx->leftover = inlen - n;
+}
+
+/****************************************************************************
+ * Name: poly1305_final
+ *
+ * Description:
+ *   Finish a Poly1305 MAC and return the 16 byte tag.
+ *
+ ****************************************************************************/
+
+void poly1305_final(FAR struct poly1305_ctx_s *ctx, FAR uint8_t *tag)
+{
+  uint32_t h0;
+  uint32_t h1;
+  uint32_t h2;
+  uint32_t h3;
+  uint32_t h4;
+  uint32_t g0;
+  uint32_t g1;
+  uint32_t g2;
+  uint32_t g3;
+  uint32_t g4;
+  uint32_t mask;
+  uint32_t c;
+  uint64_t f;
+
+  /* Process the last partial block padded with 0x01 */
+
+  if (ctx->leftover > 0)
+    {
+      ctx->buffer[ctx->leftover] = 1;
+      memset(ctx->buffer + ctx->leftover + 1, 0,
+             POLY1305_TAG_LENGTH - ctx->leftover - 1);
+      poly1305_blocks(ctx, ctx->buffer, POLY1305_TAG_LENGTH, 0);
+    }
+
+  /* Fully carry h */
+
+  h0 = ctx->h[0];
+  h1 = ctx->h[1];
+  h2 = ctx->h[2];
+  h3 = ctx->h[3];
+  h4 = ctx->h[4];
+
+  c = h1 >> 26;
+  h1 &= 0x3ffffff;
+  h2 += c;
+  c = h2 >> 26;
+  h2 &= 0x3ffffff;
+  h3 += c;
+  c = h3 >> 26;
+  h3 &= 0x3ffffff;
+  h4 += c;
+  c = h4 >> 26;
+  h4 &= 0x3ffffff;
+  h0 += c * 5;
+  c = h0 >> 26;
+  h0 &= 0x3ffffff;
+  h1 += c;
+
+  /* g = h + -p; select h if h < p, else g, without branches */
+
+  g0 = h0 + 5;
+  c = g0 >> 26;
+  g0 &= 0x3ffffff;
+  g1 = h1 + c;
+  c = g1 >> 26;
+  g1 &= 0x3ffffff;
+  g2 = h2 + c;
+  c = g2 >> 26;
+  g2 &= 0x3ffffff;
+  g3 = h3 + c;
+  c = g3 >> 26;
+  g3 &= 0x3ffffff;
+  g4 = h4 + c - (1 << 26);
+
+  mask = (g4 >> 31) - 1;
+  g0 &= mask;
+  g1 &= mask;
+  g2 &= mask;
+  g3 &= mask;
+  g4 &= mask;
+  mask = ~mask;
+  h0 = (h0 & mask) | g0;
+  h1 = (h1 & mask) | g1;
+  h2 = (h2 & mask) | g2;
+  h3 = (h3 & mask) | g3;
+  h4 = (h4 & mask) | g4;
+
+  /* h = h % 2^128 as four 32-bit words, then tag = h + pad */
+
+  h0 = (h0 | (h1 << 26)) & 0xffffffff;
+  h1 = ((h1 >> 6) | (h2 << 20)) & 0xffffffff;
+  h2 = ((h2 >> 12) | (h3 << 14)) & 0xffffffff;
+  h3 = ((h3 >> 18) | (h4 << 8)) & 0xffffffff;
+
+  f = (uint64_t)h0 + ctx->pad[0];
+  cp_store32(tag + 0, (uint32_t)f);
+  f = (uint64_t)h1 + ctx->pad[1] + (f >> 32);
+  cp_store32(tag + 4, (uint32_t)f);
+  f = (uint64_t)h2 + ctx->pad[2] + (f >> 32);
+  cp_store32(tag + 8, (uint32_t)f);
+  f = (uint64_t)h3 + ctx->pad[3] + (f >> 32);
+  cp_store32(tag + 12, (uint32_t)f);
+
+  memset(ctx, 0, sizeof(*ctx));
+}
+
+/****************************************************************************
+ * Name: chachapoly_encrypt
+ *
+ * Description:
+ *   Encrypt 'len' bytes with ChaCha20-Poly1305 and return the tag.
+ *
+ ****************************************************************************/
+
+void chachapoly_encrypt(FAR const uint8_t *key, FAR const uint8_t *nonce,
+                        FAR const uint8_t *aad, size_t aadlen,
+                        FAR const uint8_t *in, FAR uint8_t *out,
+                        size_t len, FAR uint8_t *tag)
+{
+  chacha20(out, in, len, key, nonce, 1);
+  chachapoly_mac(key, nonce, aad, aadlen, out, len, tag);
+}
+
+/****************************************************************************
+ * Name: chachapoly_decrypt
+ *
+ * Description:
+ *   Verify the tag and decrypt 'len' bytes with ChaCha20-Poly1305.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EBADMSG if the tag does not match.  The output
+ *   is cleared on failure.
+ *
+ ****************************************************************************/
+
+int chachapoly_decrypt(FAR const uint8_t *key, FAR const uint8_t *nonce,
+                       FAR const uint8_t *aad, size_t aadlen,
+                       FAR const uint8_t *in, FAR uint8_t *out,
+                       size_t len, FAR const uint8_t *tag)
+{
+  uint8_t expected[POLY1305_TAG_LENGTH];
+  uint8_t diff = 0;
+  int i;
+
+  /* The tag covers the cipher text, so check it before decrypting in
+   * place.
+   */
+
+  chachapoly_mac(key, nonce, aad, aadlen, in, len, expected);
+
+  for (i = 0; i < POLY1305_TAG_LENGTH; i++)
+    {
+      diff |= expected[i] ^ tag[i];
+    }
+
+  if (diff != 0)
+    {
+      memset(out, 0, len);
+      return -EBADMSG;
+    }
+
+  chacha20(out, in, len, key, nonce, 1);
+  return OK;
+}
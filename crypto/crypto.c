@@ -43,10 +43,14 @@
 #include <stdbool.h>
 #include <string.h>
 #include <poll.h>
+#include <assert.h>
 #include <errno.h>
 
 #include <nuttx/fs/fs.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/crypto/crypto.h>
+#include <nuttx/crypto/aes.h>
 
 /****************************************************************************
  * Private Function Prototypes
@@ -56,14 +60,254 @@
  * Private Data
  ****************************************************************************/
 
+/* The registered providers in the order of their priority */
+
+static FAR struct crypto_provider_s *g_providers;
+static sem_t g_providersem = SEM_INITIALIZER(1);
+
+#ifdef CONFIG_CRYPTO_ASYNC
+/* The queue of asynchronous requests */
+
+static FAR struct crypto_req_s *g_reqhead;
+static FAR struct crypto_req_s *g_reqtail;
+static sem_t g_reqsem = SEM_INITIALIZER(1);
+static struct work_s g_reqwork;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: crypto_fallback
+ *
+ * Description:
+ *   Return true if the next provider should be tried after a provider
+ *   returned 'ret'.
+ *
+ ****************************************************************************/
+
+static bool crypto_fallback(int ret)
+{
+  return ret == -ENOTSUP || ret == -ENOSYS;
+}
+
+/****************************************************************************
+ * Name: crypto_worker
+ *
+ * Description:
+ *   Process the queued asynchronous requests.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_CRYPTO_ASYNC
+static void crypto_worker(FAR void *arg)
+{
+  FAR struct crypto_req_s *req;
+  FAR struct crypto_req_s *next;
+
+  for (; ; )
+    {
+      /* Take all of the requests queued so far */
+
+      nxsem_wait_uninterruptible(&g_reqsem);
+      req       = g_reqhead;
+      g_reqhead = NULL;
+      g_reqtail = NULL;
+      nxsem_post(&g_reqsem);
+
+      if (req == NULL)
+        {
+          break;
+        }
+
+      for (; req != NULL; req = next)
+        {
+          next = req->flink;
+
+          req->result = crypto_cypher(req->out, req->in, req->size,
+                                      req->iv, req->key, req->keysize,
+                                      req->mode, req->encrypt);
+          req->done(req);
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: crypto_register
+ *
+ * Description:
+ *   Register a crypto provider.  crypto_cypher() will then offer requests to
+ *   the provider before the providers of a lower priority.
+ *
+ ****************************************************************************/
+
+int crypto_register(FAR struct crypto_provider_s *provider)
+{
+  FAR struct crypto_provider_s **link;
+  int ret;
+
+  DEBUGASSERT(provider != NULL && provider->cypher != NULL);
+
+  ret = nxsem_wait(&g_providersem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (link = &g_providers;
+       *link != NULL && (*link)->priority >= provider->priority;
+       link = &(*link)->flink)
+    {
+    }
+
+  provider->flink = *link;
+  *link = provider;
+
+  nxsem_post(&g_providersem);
+  cryptinfo("Registered %s\n", provider->name);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: crypto_unregister
+ *
+ * Description:
+ *   Unregister a crypto provider registered with crypto_register().
+ *
+ ****************************************************************************/
+
+int crypto_unregister(FAR struct crypto_provider_s *provider)
+{
+  FAR struct crypto_provider_s **link;
+  int ret;
+
+  ret = nxsem_wait(&g_providersem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (link = &g_providers; *link != NULL; link = &(*link)->flink)
+    {
+      if (*link == provider)
+        {
+          *link = provider->flink;
+          break;
+        }
+    }
+
+  nxsem_post(&g_providersem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: crypto_cypher
+ *
+ * Description:
+ *   Encrypt or decrypt a buffer with the first provider that supports the
+ *   request.  The registered providers are tried in the order of their
+ *   priority, then aes_cypher() (CONFIG_CRYPTO_AES) and finally the
+ *   software AES (CONFIG_CRYPTO_SW_AES).
+ *
+ ****************************************************************************/
+
+int crypto_cypher(FAR void *out, FAR const void *in, uint32_t size,
+                  FAR const void *iv, FAR const void *key, uint32_t keysize,
+                  int mode, int encrypt)
+{
+  FAR struct crypto_provider_s *provider;
+  int ret;
+
+  /* The provider list is locked during the request so that a provider
+   * cannot be unregistered while it is in use.
+   */
+
+  ret = nxsem_wait(&g_providersem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = -ENOTSUP;
+  for (provider = g_providers;
+       provider != NULL && crypto_fallback(ret);
+       provider = provider->flink)
+    {
+      ret = provider->cypher(provider, out, in, size, iv, key, keysize,
+                             mode, encrypt);
+    }
+
+  nxsem_post(&g_providersem);
+
+#ifdef CONFIG_CRYPTO_AES
+  if (crypto_fallback(ret))
+    {
+      ret = aes_cypher(out, in, size, iv, key, keysize, mode, encrypt);
+    }
+#endif
+
+#ifdef CONFIG_CRYPTO_SW_AES
+  if (crypto_fallback(ret))
+    {
+      ret = aes_swcypher(out, in, size, iv, key, keysize, mode, encrypt);
+    }
+#endif
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: crypto_submit
+ *
+ * Description:
+ *   Queue a request to be processed on the low priority work queue.  All
+ *   requests queued before the worker runs are processed in one batch.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_CRYPTO_ASYNC
+int crypto_submit(FAR struct crypto_req_s *req)
+{
+  int ret;
+
+  DEBUGASSERT(req != NULL && req->done != NULL);
+
+  ret = nxsem_wait(&g_reqsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  req->flink = NULL;
+  if (g_reqtail == NULL)
+    {
+      g_reqhead = req;
+    }
+  else
+    {
+      g_reqtail->flink = req;
+    }
+
+  g_reqtail = req;
+
+  /* Start the worker unless it is already pending */
+
+  if (work_available(&g_reqwork))
+    {
+      ret = work_queue(LPWORK, &g_reqwork, crypto_worker, NULL, 0);
+    }
+
+  nxsem_post(&g_reqsem);
+  return ret;
+}
+#endif
+
 int up_cryptoinitialize(void)
 {
 #ifdef CONFIG_CRYPTO_ALGTEST
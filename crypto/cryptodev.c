@@ -50,16 +50,8 @@
 
 #include <nuttx/crypto/crypto.h>
 #include <nuttx/crypto/cryptodev.h>
-
-/****************************************************************************
- * Pre-processor Definitions
- ****************************************************************************/
-
-#ifdef CONFIG_CRYPTO_AES
-#  define AES_CYPHER(mode) \
-  aes_cypher(op->dst, op->src, op->len, op->iv, ses->key, ses->keylen, \
-             mode, encrypt)
-#endif
+#include <nuttx/crypto/sha2.h>
+#include <nuttx/crypto/chachapoly.h>
 
 /****************************************************************************
  * Private Function Prototypes
@@ -99,6 +91,119 @@ static const struct file_operations g_cryptodevops =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: cryptodev_crypt
+ *
+ * Description:
+ *   Perform one CIOCCRYPT operation.  AES goes to the best crypto provider;
+ *   the hashes and ChaCha20-Poly1305 are done in software.
+ *
+ ****************************************************************************/
+
+static int cryptodev_crypt(FAR struct crypt_op *op)
+{
+  FAR struct session_op *ses = (FAR struct session_op *)op->ses;
+  int encrypt;
+  int mode;
+
+  /* A hash session has no cipher */
+
+  switch (ses->mac)
+    {
+    case 0:
+      break;
+
+#ifdef CONFIG_CRYPTO_SHA2
+    case CRYPTO_SHA2_256:
+      if (ses->cipher != 0 || op->mac == NULL)
+        {
+          return -EINVAL;
+        }
+
+      sha256((FAR uint8_t *)op->mac, op->src, op->len);
+      return OK;
+
+    case CRYPTO_SHA2_512:
+      if (ses->cipher != 0 || op->mac == NULL)
+        {
+          return -EINVAL;
+        }
+
+      sha512((FAR uint8_t *)op->mac, op->src, op->len);
+      return OK;
+#endif
+
+    default:
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_CRYPTO_CHACHAPOLY
+  if (ses->cipher == CRYPTO_CHACHA20_POLY1305)
+    {
+      if (ses->keylen != CHACHA20_KEY_LENGTH || op->iv == NULL ||
+          op->mac == NULL)
+        {
+          return -EINVAL;
+        }
+
+      if (op->op == COP_ENCRYPT)
+        {
+          chachapoly_encrypt((FAR const uint8_t *)ses->key,
+                             (FAR const uint8_t *)op->iv, NULL, 0,
+                             (FAR const uint8_t *)op->src,
+                             (FAR uint8_t *)op->dst, op->len,
+                             (FAR uint8_t *)op->mac);
+          return OK;
+        }
+      else if (op->op == COP_DECRYPT)
+        {
+          return chachapoly_decrypt((FAR const uint8_t *)ses->key,
+                                    (FAR const uint8_t *)op->iv, NULL, 0,
+                                    (FAR const uint8_t *)op->src,
+                                    (FAR uint8_t *)op->dst, op->len,
+                                    (FAR const uint8_t *)op->mac);
+        }
+
+      return -EINVAL;
+    }
+#endif
+
+  switch (op->op)
+    {
+    case COP_ENCRYPT:
+      encrypt = CYPHER_ENCRYPT;
+      break;
+
+    case COP_DECRYPT:
+      encrypt = CYPHER_DECRYPT;
+      break;
+
+    default:
+      return -EINVAL;
+    }
+
+  switch (ses->cipher)
+    {
+    case CRYPTO_AES_ECB:
+      mode = AES_MODE_ECB;
+      break;
+
+    case CRYPTO_AES_CBC:
+      mode = AES_MODE_CBC;
+      break;
+
+    case CRYPTO_AES_CTR:
+      mode = AES_MODE_CTR;
+      break;
+
+    default:
+      return -EINVAL;
+    }
+
+  return crypto_cypher(op->dst, op->src, op->len, op->iv, ses->key,
+                       ses->keylen, mode, encrypt);
+}
+
 static ssize_t cryptodev_read(FAR struct file *filep,
                               FAR char *buffer,
                               size_t len)
@@ -131,43 +236,30 @@ static int cryptodev_ioctl(FAR struct file *filep,
       return OK;
     }
 
-#ifdef CONFIG_CRYPTO_AES
   case CIOCCRYPT:
     {
-      FAR struct crypt_op *op    = (FAR struct crypt_op *)arg;
-      FAR struct session_op *ses = (FAR struct session_op *)op->ses;
-      int encrypt;
-
-      switch (op->op)
-        {
-        case COP_ENCRYPT:
-          encrypt = 1;
-          break;
+      return cryptodev_crypt((FAR struct crypt_op *)arg);
+    }
 
-        case COP_DECRYPT:
-          encrypt = 0;
-          break;
+  case CIOCNCRYPTM:
+    {
+      FAR struct crypt_mop *mop = (FAR struct crypt_mop *)arg;
+      uint32_t i;
+      int ret = OK;
 
-        default:
-          return -EINVAL;
+      for (i = 0; i < mop->count && ret >= 0; i++)
+        {
+          ret = cryptodev_crypt(&mop->reqs[i]);
         }
 
-      switch (ses->cipher)
+      if (ret < 0)
         {
-        case CRYPTO_AES_ECB:
-          return AES_CYPHER(AES_MODE_ECB);
-
-        case CRYPTO_AES_CBC:
-          return AES_CYPHER(AES_MODE_CBC);
-
-        case CRYPTO_AES_CTR:
-          return AES_CYPHER(AES_MODE_CTR);
-
-        default:
-           return -EINVAL;
+          i--;
         }
+
+      mop->count = i;
+      return ret;
     }
-#endif
 
   default:
     return -ENOTTY;
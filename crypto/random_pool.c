@@ -49,10 +49,14 @@
 #include <errno.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/clock.h>
 #include <nuttx/random.h>
 #include <nuttx/board.h>
+#include <nuttx/spinlock.h>
 
 #include <nuttx/crypto/blake2s.h>
+#include <nuttx/crypto/chachapoly.h>
 
 /****************************************************************************
  * Definitions
@@ -65,6 +69,22 @@
 #define ROTL_32(x,n) ( ((x) << (n)) | ((x) >> (32-(n))) )
 #define ROTR_32(x,n) ( ((x) >> (n)) | ((x) << (32-(n))) )
 
+#ifdef CONFIG_SMP
+#  define RNG_NCPUS        CONFIG_SMP_NCPUS
+#else
+#  define RNG_NCPUS        1
+#endif
+
+/* The per-CPU output generators are reseeded from the BLAKE2Xs generator
+ * after this much time or output, or when the BLAKE2Xs generator itself
+ * has been reseeded.
+ */
+
+#define RNG_RESEED_TICKS   SEC2TICK(CONFIG_CRYPTO_RANDOM_POOL_RESEED_INTERVAL)
+#define RNG_RESEED_BYTES   (1024 * 1024)
+
+#define RNG_IRQ_BATCH      CONFIG_CRYPTO_RANDOM_POOL_IRQ_BATCH
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -81,16 +101,36 @@ struct blake2xs_rng_s
   char out_root[BLAKE2S_OUTBYTES];
 };
 
+/* Per-CPU ChaCha20 output generator and interrupt entropy batch.  Only
+ * the owning CPU touches it, with local interrupts disabled.
+ */
+
+struct rng_cpu_s
+{
+  uint8_t key[CHACHA20_KEY_LENGTH]; /* Replaced on every use */
+  bool initialized;                 /* Seeded at least once */
+  uint32_t generation;              /* rd_generation when last seeded */
+  clock_t seeded;                   /* Time when last seeded */
+  size_t nbytes;                    /* Output since last seeded */
+  uint16_t prev_irq;                /* Last interrupt added to batch[] */
+  uint8_t nbatch;                   /* Number of words in batch[] */
+  uint32_t batch[RNG_IRQ_BATCH];    /* Interrupt timing not yet mixed in */
+};
+
 struct rng_s
 {
-  sem_t rd_sem; /* Threads can only exclusively access the RNG */
+  sem_t rd_sem; /* Threads can only exclusively access the BLAKE2Xs RNG */
+#ifdef CONFIG_SMP
+  spinlock_t rd_lock; /* Serializes stirring of the entropy pool */
+#endif
   volatile uint32_t rd_addptr;
   volatile uint32_t rd_newentr;
+  volatile uint32_t rd_generation;
   volatile uint8_t rd_rotate;
   volatile uint8_t rd_prev_time;
-  volatile uint16_t rd_prev_irq;
   bool output_initialized;
   struct blake2xs_rng_s blake2xs;
+  struct rng_cpu_s rd_cpu[RNG_NCPUS];
 };
 
 enum
@@ -140,6 +180,34 @@ static const uint32_t pool_twist[8] =
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: rng_pool_lock and rng_pool_unlock
+ *
+ * Description:
+ *   Serialize stirring of the entropy pool.  Entropy is added from
+ *   interrupt handlers, so this disables local interrupts, and on SMP also
+ *   takes a spinlock that is held only while the pool is stirred.
+ *
+ ****************************************************************************/
+
+static inline irqstate_t rng_pool_lock(void)
+{
+  irqstate_t flags = up_irq_save();
+
+#ifdef CONFIG_SMP
+  spin_lock(&g_rng.rd_lock);
+#endif
+  return flags;
+}
+
+static inline void rng_pool_unlock(irqstate_t flags)
+{
+#ifdef CONFIG_SMP
+  spin_unlock(&g_rng.rd_lock);
+#endif
+  up_irq_restore(flags);
+}
+
 /****************************************************************************
  * Name: addentropy
  *
@@ -312,6 +380,10 @@ static void rng_reseed(void)
 
   explicit_bzero(&g_rng.blake2xs.ctx, sizeof(g_rng.blake2xs.ctx));
 
+  /* Make the per-CPU generators pick up the new root */
+
+  g_rng.rd_generation++;
+
   /* Setup parameters for output phase. */
 
   g_rng.blake2xs.param.key_length = 0;
@@ -374,87 +446,143 @@ static void rng_buf_internal(FAR void *bytes, size_t nbytes)
     }
 }
 
-static void rng_init(void)
-{
-  cryptinfo("Initializing RNG\n");
-
-  memset(&g_rng, 0, sizeof(struct rng_s));
-  nxsem_init(&g_rng.rd_sem, 0, 1);
+/****************************************************************************
+ * Name: rng_cpu_stale
+ *
+ * Description:
+ *   Return true if the output generator of a CPU must be reseeded.  Called
+ *   with local interrupts disabled.
+ *
+ ****************************************************************************/
 
-  /* We do not initialize output here because this is called
-   * quite early in boot and there may not be enough entropy.
-   *
-   * Board level may define CONFIG_BOARD_INITRNGSEED if it implements
-   * early random seeding.
-   */
+static bool rng_cpu_stale(FAR struct rng_cpu_s *cpu)
+{
+  return !cpu->initialized || cpu->generation != g_rng.rd_generation ||
+         cpu->nbytes >= RNG_RESEED_BYTES ||
+         clock_systime_ticks() - cpu->seeded >= RNG_RESEED_TICKS;
 }
 
 /****************************************************************************
- * Public Functions
+ * Name: rng_cpu_seed
+ *
+ * Description:
+ *   Mix a new seed from the BLAKE2Xs generator into the output generator of
+ *   the current CPU.  A generator that was already seeded does not wait
+ *   for another thread using the BLAKE2Xs generator: it keeps its key and
+ *   tries again on the next request.
+ *
  ****************************************************************************/
 
+static void rng_cpu_seed(bool initialized)
+{
+  FAR struct rng_cpu_s *cpu;
+  uint8_t seed[CHACHA20_KEY_LENGTH];
+  uint32_t generation;
+  irqstate_t flags;
+  int ret;
+  int i;
+
+  if (initialized)
+    {
+      ret = nxsem_trywait(&g_rng.rd_sem);
+    }
+  else
+    {
+      ret = nxsem_wait_uninterruptible(&g_rng.rd_sem);
+    }
+
+  if (ret < 0)
+    {
+      return;
+    }
+
+  rng_buf_internal(seed, sizeof(seed));
+  generation = g_rng.rd_generation;
+  nxsem_post(&g_rng.rd_sem);
+
+  /* The thread may have moved to another CPU meanwhile.  That CPU takes the
+   * seed, and the first one will try again.
+   */
+
+  flags = up_irq_save();
+  cpu = &g_rng.rd_cpu[up_cpu_index()];
+
+  for (i = 0; i < CHACHA20_KEY_LENGTH; i++)
+    {
+      cpu->key[i] ^= seed[i];
+    }
+
+  cpu->initialized = true;
+  cpu->generation  = generation;
+  cpu->seeded      = clock_systime_ticks();
+  cpu->nbytes      = 0;
+
+  up_irq_restore(flags);
+  explicit_bzero(seed, sizeof(seed));
+}
+
 /****************************************************************************
- * Name: up_rngaddint
+ * Name: rng_cpu_getkey
  *
  * Description:
- *   Add one integer to entropy pool, contributing a specific kind
- *   of entropy to pool.
+ *   Return a fresh ChaCha20 key for one request of 'nbytes' random bytes.
  *
- * Input Parameters:
- *   kindof  - Enumeration constant telling where val came from
- *   val     - Integer to be added
- *
- * Returned Value:
- *   None
+ *   This is "fast key erasure": one ChaCha20 block of the CPU's generator
+ *   gives both the next key of the generator and the key of the request,
+ *   so no earlier output can be recovered from the state.  Interrupts are
+ *   disabled for that one block only; the request itself is generated
+ *   with interrupts enabled and without any lock.
  *
  ****************************************************************************/
 
-void up_rngaddint(enum rnd_source_t kindof, int val)
+static void rng_cpu_getkey(FAR uint8_t *key, size_t nbytes)
 {
-  uint32_t buf[1];
+  static const uint8_t nonce[CHACHA20_NONCE_LENGTH];
+  FAR struct rng_cpu_s *cpu;
+  uint8_t block[CHACHA20_BLOCK_LENGTH];
+  irqstate_t flags;
 
-  buf[0] = val;
+  flags = up_irq_save();
+  cpu = &g_rng.rd_cpu[up_cpu_index()];
 
-  up_rngaddentropy(kindof, buf, 1);
+  if (rng_cpu_stale(cpu))
+    {
+      bool initialized = cpu->initialized;
+
+      up_irq_restore(flags);
+      rng_cpu_seed(initialized);
+
+      flags = up_irq_save();
+      cpu = &g_rng.rd_cpu[up_cpu_index()];
+    }
+
+  memset(block, 0, sizeof(block));
+  chacha20(block, block, sizeof(block), cpu->key, nonce, 0);
+  memcpy(cpu->key, block, CHACHA20_KEY_LENGTH);
+  cpu->nbytes += MIN(nbytes, RNG_RESEED_BYTES);
+
+  up_irq_restore(flags);
+
+  memcpy(key, block + CHACHA20_KEY_LENGTH, CHACHA20_KEY_LENGTH);
+  explicit_bzero(block, sizeof(block));
 }
 
 /****************************************************************************
- * Name: up_rngaddentropy
+ * Name: rng_addentropy
  *
  * Description:
- *   Add buffer of integers to entropy pool.
- *
- * Input Parameters:
- *   kindof  - Enumeration constant telling where val came from
- *   buf     - Buffer of integers to be added
- *   n       - Number of elements in buf
- *
- * Returned Value:
- *   None
+ *   Mix a buffer of integers and a timestamp into the entropy pool.
  *
  ****************************************************************************/
 
-void up_rngaddentropy(enum rnd_source_t kindof, FAR const uint32_t *buf,
-                      size_t n)
+static void rng_addentropy(enum rnd_source_t kindof,
+                           FAR const uint32_t *buf, size_t n)
 {
   uint32_t tbuf[1];
   struct timespec ts;
+  irqstate_t flags;
   bool new_inc = true;
 
-  if (kindof == RND_SRC_IRQ && n > 0)
-    {
-      /* Ignore interrupt randomness if previous interrupt was from same
-       * source.
-       */
-
-      if (buf[0] == g_rng.rd_prev_irq)
-        {
-          return;
-        }
-
-      g_rng.rd_prev_irq = buf[0];
-    }
-
   /* We don't actually track what kind of entropy we receive,
    * just add it all to pool. One exception is interrupt
    * and timer randomness, where we limit rate of new pool entry
@@ -467,6 +595,8 @@ void up_rngaddentropy(enum rnd_source_t kindof, FAR const uint32_t *buf,
   tbuf[0] += ROTL_32(kindof, 27);
   tbuf[0] += ROTL_32((uintptr_t)&tbuf[0], 11);
 
+  flags = rng_pool_lock();
+
   if (kindof == RND_SRC_TIME || kindof == RND_SRC_IRQ)
     {
       uint8_t curr_time = ts.tv_sec * 8 + ts.tv_nsec / (NSEC_PER_SEC / 8);
@@ -494,9 +624,139 @@ void up_rngaddentropy(enum rnd_source_t kindof, FAR const uint32_t *buf,
 
   addentropy(tbuf, 1, new_inc);
 
+  /* A batch of interrupts counts as a single new entry */
+
   if (n > 0)
     {
-      addentropy(buf, n, new_inc);
+      addentropy(buf, n, new_inc && kindof != RND_SRC_IRQ);
+    }
+
+  rng_pool_unlock(flags);
+}
+
+/****************************************************************************
+ * Name: rng_addirq
+ *
+ * Description:
+ *   Add the timing of an interrupt to the batch of the current CPU.  The
+ *   pool is stirred only once per RNG_IRQ_BATCH interrupts.
+ *
+ ****************************************************************************/
+
+static void rng_addirq(uint32_t irq)
+{
+  FAR struct rng_cpu_s *cpu;
+  uint32_t batch[RNG_IRQ_BATCH];
+  struct timespec ts;
+  irqstate_t flags;
+  bool full = false;
+
+  flags = up_irq_save();
+  cpu = &g_rng.rd_cpu[up_cpu_index()];
+
+  /* Ignore interrupt randomness if previous interrupt was from same
+   * source.
+   */
+
+  if (irq != cpu->prev_irq)
+    {
+      cpu->prev_irq = irq;
+
+      clock_gettime(CLOCK_REALTIME, &ts);
+      cpu->batch[cpu->nbatch++] = ROTL_32(ts.tv_nsec, 17) ^ irq;
+
+      if (cpu->nbatch >= RNG_IRQ_BATCH)
+        {
+          memcpy(batch, cpu->batch, sizeof(batch));
+          cpu->nbatch = 0;
+          full = true;
+        }
+    }
+
+  up_irq_restore(flags);
+
+  if (full)
+    {
+      rng_addentropy(RND_SRC_IRQ, batch, RNG_IRQ_BATCH);
+    }
+}
+
+static void rng_init(void)
+{
+  cryptinfo("Initializing RNG\n");
+
+  memset(&g_rng, 0, sizeof(struct rng_s));
+  nxsem_init(&g_rng.rd_sem, 0, 1);
+#ifdef CONFIG_SMP
+  spin_initialize(&g_rng.rd_lock, SP_UNLOCKED);
+#endif
+
+  /* We do not initialize output here because this is called
+   * quite early in boot and there may not be enough entropy.
+   *
+   * Board level may define CONFIG_BOARD_INITRNGSEED if it implements
+   * early random seeding.
+   */
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_rngaddint
+ *
+ * Description:
+ *   Add one integer to entropy pool, contributing a specific kind
+ *   of entropy to pool.
+ *
+ * Input Parameters:
+ *   kindof  - Enumeration constant telling where val came from
+ *   val     - Integer to be added
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void up_rngaddint(enum rnd_source_t kindof, int val)
+{
+  uint32_t buf[1];
+
+  buf[0] = val;
+
+  up_rngaddentropy(kindof, buf, 1);
+}
+
+/****************************************************************************
+ * Name: up_rngaddentropy
+ *
+ * Description:
+ *   Add buffer of integers to entropy pool.
+ *
+ * Input Parameters:
+ *   kindof  - Enumeration constant telling where val came from
+ *   buf     - Buffer of integers to be added
+ *   n       - Number of elements in buf
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void up_rngaddentropy(enum rnd_source_t kindof, FAR const uint32_t *buf,
+                      size_t n)
+{
+  if (kindof == RND_SRC_IRQ)
+    {
+      while (n-- > 0)
+        {
+          rng_addirq(*buf++);
+        }
+    }
+  else
+    {
+      rng_addentropy(kindof, buf, n);
     }
 }
 
@@ -504,7 +764,8 @@ void up_rngaddentropy(enum rnd_source_t kindof, FAR const uint32_t *buf,
  * Name: up_rngreseed
  *
  * Description:
- *   Force reseeding random number generator from entropy pool
+ *   Force reseeding random number generator from entropy pool.  The
+ *   output generators of all CPUs are reseeded on their next use.
  *
  ****************************************************************************/
 
@@ -552,6 +813,9 @@ void up_randompool_initialize(void)
  *
  *   Note that this function cannot fail, other than by asserting.
  *
+ *   The bytes come from the ChaCha20 generator of the current CPU, so
+ *   concurrent callers do not serialize on a lock.
+ *
  * Input Parameters:
  *   bytes  - Buffer for returned random bytes
  *   nbytes - Number of bytes requested.
@@ -563,12 +827,12 @@ void up_randompool_initialize(void)
 
 void getrandom(FAR void *bytes, size_t nbytes)
 {
-  int ret;
+  static const uint8_t nonce[CHACHA20_NONCE_LENGTH];
+  uint8_t key[CHACHA20_KEY_LENGTH];
 
-  ret = nxsem_wait_uninterruptible(&g_rng.rd_sem);
-  if (ret >= 0)
-    {
-      rng_buf_internal(bytes, nbytes);
-      nxsem_post(&g_rng.rd_sem);
-    }
+  rng_cpu_getkey(key, nbytes);
+
+  memset(bytes, 0, nbytes);
+  chacha20(bytes, bytes, nbytes, key, nonce, 0);
+  explicit_bzero(key, sizeof(key));
 }
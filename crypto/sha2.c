@@ -0,0 +1,526 @@
+/****************************************************************************
+ * crypto/sha2.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <nuttx/crypto/sha2.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define ROR32(x, n)  (((x) >> (n)) | ((x) << (32 - (n))))
+#define ROR64(x, n)  (((x) >> (n)) | ((x) << (64 - (n))))
+
+#define CH(x, y, z)  (((x) & ((y) ^ (z))) ^ (z))
+#define MAJ(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+
+#define S256_0(x)    (ROR32(x, 2) ^ ROR32(x, 13) ^ ROR32(x, 22))
+#define S256_1(x)    (ROR32(x, 6) ^ ROR32(x, 11) ^ ROR32(x, 25))
+#define s256_0(x)    (ROR32(x, 7) ^ ROR32(x, 18) ^ ((x) >> 3))
+#define s256_1(x)    (ROR32(x, 17) ^ ROR32(x, 19) ^ ((x) >> 10))
+
+#define S512_0(x)    (ROR64(x, 28) ^ ROR64(x, 34) ^ ROR64(x, 39))
+#define S512_1(x)    (ROR64(x, 14) ^ ROR64(x, 18) ^ ROR64(x, 41))
+#define s512_0(x)    (ROR64(x, 1) ^ ROR64(x, 8) ^ ((x) >> 7))
+#define s512_1(x)    (ROR64(x, 19) ^ ROR64(x, 61) ^ ((x) >> 6))
+
+/* The message schedule is kept in a ring of 16 words */
+
+#define W(i)         w[(i) & 15]
+#define W256(i)      (W(i) += s256_1(W((i) - 2)) + W((i) - 7) + \
+                              s256_0(W((i) - 15)))
+#define W512(i)      (W(i) += s512_1(W((i) - 2)) + W((i) - 7) + \
+                              s512_0(W((i) - 15)))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const uint32_t g_sha256_k[64] =
+{
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+  0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+  0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+  0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+  0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+  0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+  0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+  0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+  0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint64_t g_sha512_k[80] =
+{
+  0x428a2f98d728ae22ull, 0x7137449123ef65cdull,
+  0xb5c0fbcfec4d3b2full, 0xe9b5dba58189dbbcull,
+  0x3956c25bf348b538ull, 0x59f111f1b605d019ull,
+  0x923f82a4af194f9bull, 0xab1c5ed5da6d8118ull,
+  0xd807aa98a3030242ull, 0x12835b0145706fbeull,
+  0x243185be4ee4b28cull, 0x550c7dc3d5ffb4e2ull,
+  0x72be5d74f27b896full, 0x80deb1fe3b1696b1ull,
+  0x9bdc06a725c71235ull, 0xc19bf174cf692694ull,
+  0xe49b69c19ef14ad2ull, 0xefbe4786384f25e3ull,
+  0x0fc19dc68b8cd5b5ull, 0x240ca1cc77ac9c65ull,
+  0x2de92c6f592b0275ull, 0x4a7484aa6ea6e483ull,
+  0x5cb0a9dcbd41fbd4ull, 0x76f988da831153b5ull,
+  0x983e5152ee66dfabull, 0xa831c66d2db43210ull,
+  0xb00327c898fb213full, 0xbf597fc7beef0ee4ull,
+  0xc6e00bf33da88fc2ull, 0xd5a79147930aa725ull,
+  0x06ca6351e003826full, 0x142929670a0e6e70ull,
+  0x27b70a8546d22ffcull, 0x2e1b21385c26c926ull,
+  0x4d2c6dfc5ac42aedull, 0x53380d139d95b3dfull,
+  0x650a73548baf63deull, 0x766a0abb3c77b2a8ull,
+  0x81c2c92e47edaee6ull, 0x92722c851482353bull,
+  0xa2bfe8a14cf10364ull, 0xa81a664bbc423001ull,
+  0xc24b8b70d0f89791ull, 0xc76c51a30654be30ull,
+  0xd192e819d6ef5218ull, 0xd69906245565a910ull,
+  0xf40e35855771202aull, 0x106aa07032bbd1b8ull,
+  0x19a4c116b8d2d0c8ull, 0x1e376c085141ab53ull,
+  0x2748774cdf8eeb99ull, 0x34b0bcb5e19b48a8ull,
+  0x391c0cb3c5c95a63ull, 0x4ed8aa4ae3418acbull,
+  0x5b9cca4f7763e373ull, 0x682e6ff3d6b2b8a3ull,
+  0x748f82ee5defb2fcull, 0x78a5636f43172f60ull,
+  0x84c87814a1f0ab72ull, 0x8cc702081a6439ecull,
+  0x90befffa23631e28ull, 0xa4506cebde82bde9ull,
+  0xbef9a3f7b2c67915ull, 0xc67178f2e372532bull,
+  0xca273eceea26619cull, 0xd186b8c721c0c207ull,
+  0xeada7dd6cde0eb1eull, 0xf57d4f7fee6ed178ull,
+  0x06f067aa72176fbaull, 0x0a637dc5a2c898a6ull,
+  0x113f9804bef90daeull, 0x1b710b35131c471bull,
+  0x28db77f523047d84ull, 0x32caab7b40c72493ull,
+  0x3c9ebe0a15c9bebcull, 0x431d67c49c100d4cull,
+  0x4cc5d4becb3e42b6ull, 0x597f299cfc657e2aull,
+  0x5fcb6fab3ad6faecull, 0x6c44198c4a475817ull
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sha2_load32/sha2_load64 and sha2_store32/sha2_store64
+ *
+ * Description:
+ *   Load and store big-endian words.
+ *
+ ****************************************************************************/
+
+static inline uint32_t sha2_load32(FAR const uint8_t *p)
+{
+  return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 |
+         (uint32_t)p[2] << 8 | (uint32_t)p[3];
+}
+
+static inline uint64_t sha2_load64(FAR const uint8_t *p)
+{
+  return (uint64_t)sha2_load32(p) << 32 | sha2_load32(p + 4);
+}
+
+static inline void sha2_store32(FAR uint8_t *p, uint32_t v)
+{
+  p[0] = (uint8_t)(v >> 24);
+  p[1] = (uint8_t)(v >> 16);
+  p[2] = (uint8_t)(v >> 8);
+  p[3] = (uint8_t)v;
+}
+
+static inline void sha2_store64(FAR uint8_t *p, uint64_t v)
+{
+  sha2_store32(p, (uint32_t)(v >> 32));
+  sha2_store32(p + 4, (uint32_t)v);
+}
+
+/****************************************************************************
+ * Name: sha256_blocks
+ *
+ * Description:
+ *   Add 'nblocks' consecutive 64 byte blocks to the hash.
+ *
+ ****************************************************************************/
+
+static void sha256_blocks(FAR uint32_t *state, FAR const uint8_t *in,
+                          size_t nblocks)
+{
+  uint32_t w[16];
+  uint32_t a;
+  uint32_t b;
+  uint32_t c;
+  uint32_t d;
+  uint32_t e;
+  uint32_t f;
+  uint32_t g;
+  uint32_t h;
+  uint32_t t1;
+  uint32_t t2;
+  int i;
+
+  for (; nblocks > 0; nblocks--, in += SHA256_BLOCK_LENGTH)
+    {
+      a = state[0];
+      b = state[1];
+      c = state[2];
+      d = state[3];
+      e = state[4];
+      f = state[5];
+      g = state[6];
+      h = state[7];
+
+      for (i = 0; i < 64; i++)
+        {
+          t1 = h + S256_1(e) + CH(e, f, g) + g_sha256_k[i] +
+               (i < 16 ? (W(i) = sha2_load32(in + 4 * i)) : W256(i));
+          t2 = S256_0(a) + MAJ(a, b, c);
+
+          h = g;
+          g = f;
+          f = e;
+          e = d + t1;
+          d = c;
+          c = b;
+          b = a;
+          a = t1 + t2;
+        }
+
+      state[0] += a;
+      state[1] += b;
+      state[2] += c;
+      state[3] += d;
+      state[4] += e;
+      state[5] += f;
+      state[6] += g;
+      state[7] += h;
+    }
+}
+
+/****************************************************************************
+ * Name: sha512_blocks
+ *
+ * Description:
+ *   Add 'nblocks' consecutive 128 byte blocks to the hash.
+ *
+ ****************************************************************************/
+
+static void sha512_blocks(FAR uint64_t *state, FAR const uint8_t *in,
+                          size_t nblocks)
+{
+  uint64_t w[16];
+  uint64_t a;
+  uint64_t b;
+  uint64_t c;
+  uint64_t d;
+  uint64_t e;
+  uint64_t f;
+  uint64_t g;
+  uint64_t h;
+  uint64_t t1;
+  uint64_t t2;
+  int i;
+
+  for (; nblocks > 0; nblocks--, in += SHA512_BLOCK_LENGTH)
+    {
+      a = state[0];
+      b = state[1];
+      c = state[2];
+      d = state[3];
+      e = state[4];
+      f = state[5];
+      g = state[6];
+      h = state[7];
+
+      for (i = 0; i < 80; i++)
+        {
+          t1 = h + S512_1(e) + CH(e, f, g) + g_sha512_k[i] +
+               (i < 16 ? (W(i) = sha2_load64(in + 8 * i)) : W512(i));
+          t2 = S512_0(a) + MAJ(a, b, c);
+
+          h = g;
+          g = f;
+          f = e;
+          e = d + t1;
+          d = c;
+          c = b;
+          b = a;
+          a = t1 + t2;
+        }
+
+      state[0] += a;
+      state[1] += b;
+      state[2] += c;
+      state[3] += d;
+      state[4] += e;
+      state[5] += f;
+      state[6] += g;
+      state[7] += h;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sha256_init
+ *
+ * Description:
+ *   Start a new SHA-256 hash.
+ *
+ ****************************************************************************/
+
+void sha256_init(FAR struct sha256_ctx_s *ctx)
+{
+  ctx->state[0] = 0x6a09e667;
+  ctx->state[1] = 0xbb67ae85;
+  ctx->state[2] = 0x3c6ef372;
+  ctx->state[3] = 0xa54ff53a;
+  ctx->state[4] = 0x510e527f;
+  ctx->state[5] = 0x9b05688c;
+  ctx->state[6] = 0x1f83d9ab;
+  ctx->state[7] = 0x5be0cd19;
+  ctx->count    = 0;
+}
+
+/****************************************************************************
+ * Name: sha256_update
+ *
+ * Description:
+ *   Add data to a SHA-256 hash.  Whole blocks are hashed directly from the
+ *   caller's buffer.
+ *
+ ****************************************************************************/
+
+void sha256_update(FAR struct sha256_ctx_s *ctx, FAR const void *in,
+                   size_t inlen)
+{
+  FAR const uint8_t *src = in;
+  size_t used = ctx->count % SHA256_BLOCK_LENGTH;
+  size_t n;
+
+  ctx->count += inlen;
+
+  /* Complete a partial block first */
+
+  if (used > 0)
+    {
+      n = SHA256_BLOCK_LENGTH - used;
+      if (n > inlen)
+        {
+          n = inlen;
+        }
+
+      memcpy(ctx->buffer + used, src, n);
+      src   += n;
+      inlen -= n;
+
+      if (used + n < SHA256_BLOCK_LENGTH)
+        {
+          return;
+        }
+
+      sha256_blocks(ctx->state, ctx->buffer, 1);
+    }
+
+  n = inlen / SHA256_BLOCK_LENGTH;
+  sha256_blocks(ctx->state, src, n);
+  src   += n * SHA256_BLOCK_LENGTH;
+  inlen -= n * SHA256_BLOCK_LENGTH;
+
+  memcpy(ctx->buffer, src, inlen);
+}
+
+/****************************************************************************
+ * Name: sha256_final
+ *
+ * Description:
+ *   Finish a SHA-256 hash and return the 32 byte digest.
+ *
+ ****************************************************************************/
+
+void sha256_final(FAR struct sha256_ctx_s *ctx, FAR uint8_t *digest)
+{
+  size_t used = ctx->count % SHA256_BLOCK_LENGTH;
+  int i;
+
+  /* Pad with 0x80, zeros and the length in bits */
+
+  ctx->buffer[used++] = 0x80;
+  if (used > SHA256_BLOCK_LENGTH - 8)
+    {
+      memset(ctx->buffer + used, 0, SHA256_BLOCK_LENGTH - used);
+      sha256_blocks(ctx->state, ctx->buffer, 1);
+      used = 0;
+    }
+
+  memset(ctx->buffer + used, 0, SHA256_BLOCK_LENGTH - 8 - used);
+  sha2_store64(ctx->buffer + SHA256_BLOCK_LENGTH - 8, ctx->count << 3);
+  sha256_blocks(ctx->state, ctx->buffer, 1);
+
+  for (i = 0; i < 8; i++)
+    {
+      sha2_store32(digest + 4 * i, ctx->state[i]);
+    }
+
+  memset(ctx, 0, sizeof(*ctx));
+}
+
+/****************************************************************************
+ * Name: sha512_init
+ *
+ * Description:
+ *   Start a new SHA-512 hash.
+ *
+ ****************************************************************************/
+
+void sha512_init(FAR struct sha512_ctx_s *ctx)
+{
+  ctx->state[0] = 0x6a09e667f3bcc908ull;
+  ctx->state[1] = 0xbb67ae8584caa73bull;
+  ctx->state[2] = 0x3c6ef372fe94f82bull;
+  ctx->state[3] = 0xa54ff53a5f1d36f1ull;
+  ctx->state[4] = 0x510e527fade682d1ull;
+  ctx->state[5] = 0x9b05688c2b3e6c1full;
+  ctx->state[6] = 0x1f83d9abfb41bd6bull;
+  ctx->state[7] = 0x5be0cd19137e2179ull;
+  ctx->count    = 0;
+}
+
+/****************************************************************************
+ * Name: sha512_update
+ *
+ * Description:
+ *   Add data to a SHA-512 hash.  Whole blocks are hashed directly from the
+ *   caller's buffer.
+ *
+ ****************************************************************************/
+
+void sha512_update(FAR struct sha512_ctx_s *ctx, FAR const void *in,
+                   size_t inlen)
+{
+  FAR const uint8_t *src = in;
+  size_t used = ctx->count % SHA512_BLOCK_LENGTH;
+  size_t n;
+
+  ctx->count += inlen;
+
+  /* Complete a partial block first */
+
+  if (used > 0)
+    {
+      n = SHA512_BLOCK_LENGTH - used;
+      if (n > inlen)
+        {
+          n = inlen;
+        }
+
+      memcpy(ctx->buffer + used, src, n);
+      src   += n;
+      inlen -= n;
+
+      if (used + n < SHA512_BLOCK_LENGTH)
+        {
+          return;
+        }
+
+      sha512_blocks(ctx->state, ctx->buffer, 1);
+    }
+
+  n = inlen / SHA512_BLOCK_LENGTH;
+  sha512_blocks(ctx->state, src, n);
+  src   += n * SHA512_BLOCK_LENGTH;
+  inlen -= n * SHA512_BLOCK_LENGTH;
+
+  memcpy(ctx->buffer, src, inlen);
+}
+
+/****************************************************************************
+ * Name: sha512_final
+ *
+ * Description:
+ *   Finish a SHA-512 hash and return the 64 byte digest.  Messages are
+ *   limited to 2^61 bytes, so the upper half of the 128-bit length is zero.
+ *
+ ****************************************************************************/
+
+void sha512_final(FAR struct sha512_ctx_s *ctx, FAR uint8_t *digest)
+{
+  size_t used = ctx->count % SHA512_BLOCK_LENGTH;
+  int i;
+
+  /* Pad with 0x80, zeros and the length in bits */
+
+  ctx->buffer[used++] = 0x80;
+  if (used > SHA512_BLOCK_LENGTH - 16)
+    {
+      memset(ctx->buffer + used, 0, SHA512_BLOCK_LENGTH - used);
+      sha512_blocks(ctx->state, ctx->buffer, 1);
+      used = 0;
+    }
+
+  memset(ctx->buffer + used, 0, SHA512_BLOCK_LENGTH - 8 - used);
+  sha2_store64(ctx->buffer + SHA512_BLOCK_LENGTH - 8, ctx->count << 3);
+  sha512_blocks(ctx->state, ctx->buffer, 1);
+
+  for (i = 0; i < 8; i++)
+    {
+      sha2_store64(digest + 8 * i, ctx->state[i]);
+    }
+
+  memset(ctx, 0, sizeof(*ctx));
+}
+
+/****************************************************************************
+ * Name: sha256 and sha512
+ *
+ * Description:
+ *   Hash a buffer in one call.
+ *
+ ****************************************************************************/
+
+void sha256(FAR uint8_t *digest, FAR const void *in, size_t inlen)
+{
+  struct sha256_ctx_s ctx;
+
+  sha256_init(&ctx);
+  sha256_update(&ctx, in, inlen);
+  sha256_final(&ctx, digest);
+}
+
+void sha512(FAR uint8_t *digest, FAR const void *in, size_t inlen)
+{
+  struct sha512_ctx_s ctx;
+
+  sha512_init(&ctx);
+  sha512_update(&ctx, in, inlen);
+  sha512_final(&ctx, digest);
+}
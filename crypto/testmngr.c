@@ -49,6 +49,8 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/crypto/crypto.h>
+#include <nuttx/crypto/sha2.h>
+#include <nuttx/crypto/chachapoly.h>
 
 #ifdef CONFIG_CRYPTO_ALGTEST
 
@@ -62,12 +64,12 @@
 #  define ARRAY_SIZE(x) (sizeof(x) / sizeof((x)[0]))
 #endif
 
-#if defined(CONFIG_CRYPTO_AES)
-
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#if defined(CONFIG_CRYPTO_AES)
+
 static int do_test_aes(FAR struct cipher_testvec *test,
                        int mode,
                        int encrypt)
@@ -123,6 +125,97 @@ static int test_aes(void)
 }
 #endif
 
+#if defined(CONFIG_CRYPTO_SHA2)
+static int test_sha2(void)
+{
+  uint8_t digest[SHA512_DIGEST_LENGTH];
+  int i;
+
+  for (i = 0; i < ARRAY_SIZE(sha256_tv_template); i++)
+    {
+      FAR struct hash_testvec *test = &sha256_tv_template[i];
+
+      sha256(digest, test->plaintext, test->psize);
+      if (memcmp(digest, test->digest, SHA256_DIGEST_LENGTH))
+        {
+          crypterr("ERROR: Failed SHA-256 test #%i\n", i);
+          return -1;
+        }
+    }
+
+  for (i = 0; i < ARRAY_SIZE(sha512_tv_template); i++)
+    {
+      FAR struct hash_testvec *test = &sha512_tv_template[i];
+
+      sha512(digest, test->plaintext, test->psize);
+      if (memcmp(digest, test->digest, SHA512_DIGEST_LENGTH))
+        {
+          crypterr("ERROR: Failed SHA-512 test #%i\n", i);
+          return -1;
+        }
+    }
+
+  return OK;
+}
+#endif
+
+#if defined(CONFIG_CRYPTO_CHACHAPOLY)
+static int do_test_chachapoly(FAR struct aead_testvec *test)
+{
+  FAR uint8_t *out = kmm_zalloc(test->rlen);
+  FAR const uint8_t *tag = (FAR const uint8_t *)test->result + test->ilen;
+  int res;
+
+  if (out == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  chachapoly_encrypt((FAR const uint8_t *)test->key,
+                     (FAR const uint8_t *)test->iv,
+                     (FAR const uint8_t *)test->assoc, test->alen,
+                     (FAR const uint8_t *)test->input, out, test->ilen,
+                     out + test->ilen);
+  res = memcmp(out, test->result, test->rlen);
+  if (res == 0)
+    {
+      res = chachapoly_decrypt((FAR const uint8_t *)test->key,
+                               (FAR const uint8_t *)test->iv,
+                               (FAR const uint8_t *)test->assoc, test->alen,
+                               (FAR const uint8_t *)test->result, out,
+                               test->ilen, tag);
+    }
+
+  if (res == 0)
+    {
+      res = memcmp(out, test->input, test->ilen);
+    }
+
+  kmm_free(out);
+  return res;
+}
+
+static int test_chachapoly(void)
+{
+  int i;
+
+  for (i = 0; i < ARRAY_SIZE(chachapoly_tv_template); i++)
+    {
+      if (do_test_chachapoly(&chachapoly_tv_template[i]))
+        {
+          crypterr("ERROR: Failed ChaCha20-Poly1305 test #%i\n", i);
+          return -1;
+        }
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
 int crypto_test(void)
 {
 #if defined(CONFIG_CRYPTO_AES)
@@ -132,6 +225,20 @@ int crypto_test(void)
     }
 #endif
 
+#if defined(CONFIG_CRYPTO_SHA2)
+  if (test_sha2())
+    {
+      return -1;
+    }
+#endif
+
+#if defined(CONFIG_CRYPTO_CHACHAPOLY)
+  if (test_chachapoly())
+    {
+      return -1;
+    }
+#endif
+
   return OK;
 }
 
@@ -60,6 +60,26 @@ struct cipher_testvec
   unsigned short rlen;
 };
 
+struct hash_testvec
+{
+  FAR char *plaintext;
+  FAR char *digest;
+  unsigned short psize;
+};
+
+struct aead_testvec
+{
+  FAR char *key;
+  FAR char *iv;
+  FAR char *assoc;
+  FAR char *input;
+  FAR char *result;
+  unsigned char klen;
+  unsigned short alen;
+  unsigned short ilen;
+  unsigned short rlen;
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -525,4 +545,115 @@ static struct cipher_testvec aes_ctr_dec_tv_template[] =
 };
 
 #endif /* CONFIG_CRYPTO_AES */
+
+#if defined(CONFIG_CRYPTO_SHA2)
+
+/* SHA-2 test vectors from FIPS 180-2 */
+
+static struct hash_testvec sha256_tv_template[] =
+{
+  {
+    .plaintext = "abc",
+    .psize = 3,
+    .digest = "\xba\x78\x16\xbf\x8f\x01\xcf\xea"
+        "\x41\x41\x40\xde\x5d\xae\x22\x23"
+        "\xb0\x03\x61\xa3\x96\x17\x7a\x9c"
+        "\xb4\x10\xff\x61\xf2\x00\x15\xad",
+  },
+  {
+    .plaintext = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+    .psize = 56,
+    .digest = "\x24\x8d\x6a\x61\xd2\x06\x38\xb8"
+        "\xe5\xc0\x26\x93\x0c\x3e\x60\x39"
+        "\xa3\x3c\xe4\x59\x64\xff\x21\x67"
+        "\xf6\xec\xed\xd4\x19\xdb\x06\xc1",
+  }
+};
+
+static struct hash_testvec sha512_tv_template[] =
+{
+  {
+    .plaintext = "abc",
+    .psize = 3,
+    .digest = "\xdd\xaf\x35\xa1\x93\x61\x7a\xba"
+        "\xcc\x41\x73\x49\xae\x20\x41\x31"
+        "\x12\xe6\xfa\x4e\x89\xa9\x7e\xa2"
+        "\x0a\x9e\xee\xe6\x4b\x55\xd3\x9a"
+        "\x21\x92\x99\x2a\x27\x4f\xc1\xa8"
+        "\x36\xba\x3c\x23\xa3\xfe\xeb\xbd"
+        "\x45\x4d\x44\x23\x64\x3c\xe8\x0e"
+        "\x2a\x9a\xc9\x4f\xa5\x4c\xa4\x9f",
+  },
+  {
+    .plaintext = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+    .psize = 56,
+    .digest = "\x20\x4a\x8f\xc6\xdd\xa8\x2f\x0a"
+        "\x0c\xed\x7b\xeb\x8e\x08\xa4\x16"
+        "\x57\xc1\x6e\xf4\x68\xb2\x28\xa8"
+        "\x27\x9b\xe3\x31\xa7\x03\xc3\x35"
+        "\x96\xfd\x15\xc1\x3b\x1b\x07\xf9"
+        "\xaa\x1d\x3b\xea\x57\x78\x9c\xa0"
+        "\x31\xad\x85\xc7\xa7\x1d\xd7\x03"
+        "\x54\xec\x63\x12\x38\xca\x34\x45",
+  }
+};
+
+#endif /* CONFIG_CRYPTO_SHA2 */
+
+#if defined(CONFIG_CRYPTO_CHACHAPOLY)
+
+/* ChaCha20-Poly1305 test vectors */
+
+static struct aead_testvec chachapoly_tv_template[] =
+{
+  { /* From RFC 8439, section 2.8.2 */
+    .key = "\x80\x81\x82\x83\x84\x85\x86\x87"
+        "\x88\x89\x8a\x8b\x8c\x8d\x8e\x8f"
+        "\x90\x91\x92\x93\x94\x95\x96\x97"
+        "\x98\x99\x9a\x9b\x9c\x9d\x9e\x9f",
+    .klen = 32,
+    .iv = "\x07\x00\x00\x00\x40\x41\x42\x43"
+        "\x44\x45\x46\x47",
+    .assoc = "\x50\x51\x52\x53\xc0\xc1\xc2\xc3"
+        "\xc4\xc5\xc6\xc7",
+    .alen = 12,
+    .input = "\x4c\x61\x64\x69\x65\x73\x20\x61"
+        "\x6e\x64\x20\x47\x65\x6e\x74\x6c"
+        "\x65\x6d\x65\x6e\x20\x6f\x66\x20"
+        "\x74\x68\x65\x20\x63\x6c\x61\x73"
+        "\x73\x20\x6f\x66\x20\x27\x39\x39"
+        "\x3a\x20\x49\x66\x20\x49\x20\x63"
+        "\x6f\x75\x6c\x64\x20\x6f\x66\x66"
+        "\x65\x72\x20\x79\x6f\x75\x20\x6f"
+        "\x6e\x6c\x79\x20\x6f\x6e\x65\x20"
+        "\x74\x69\x70\x20\x66\x6f\x72\x20"
+        "\x74\x68\x65\x20\x66\x75\x74\x75"
+        "\x72\x65\x2c\x20\x73\x75\x6e\x73"
+        "\x63\x72\x65\x65\x6e\x20\x77\x6f"
+        "\x75\x6c\x64\x20\x62\x65\x20\x69"
+        "\x74\x2e",
+    .ilen = 114,
+    .result = "\xd3\x1a\x8d\x34\x64\x8e\x60\xdb"
+        "\x7b\x86\xaf\xbc\x53\xef\x7e\xc2"
+        "\xa4\xad\xed\x51\x29\x6e\x08\xfe"
+        "\xa9\xe2\xb5\xa7\x36\xee\x62\xd6"
+        "\x3d\xbe\xa4\x5e\x8c\xa9\x67\x12"
+        "\x82\xfa\xfb\x69\xda\x92\x72\x8b"
+        "\x1a\x71\xde\x0a\x9e\x06\x0b\x29"
+        "\x05\xd6\xa5\xb6\x7e\xcd\x3b\x36"
+        "\x92\xdd\xbd\x7f\x2d\x77\x8b\x8c"
+        "\x98\x03\xae\xe3\x28\x09\x1b\x58"
+        "\xfa\xb3\x24\xe4\xfa\xd6\x75\x94"
+        "\x55\x85\x80\x8b\x48\x31\xd7\xbc"
+        "\x3f\xf4\xde\xf0\x8e\x4b\x7a\x9d"
+        "\xe5\x76\xd2\x65\x86\xce\xc6\x4b"
+        "\x61\x16\x1a\xe1\x0b\x59\x4f\x09"
+        "\xe2\x6a\x7e\x90\x2e\xcb\xd0\x60"
+        "\x06\x91",
+    .rlen = 130,
+  }
+};
+
+#endif /* CONFIG_CRYPTO_CHACHAPOLY */
+
 #endif /* __CRYPTO_TESTMNGR_H */
@@ -58,6 +58,7 @@
 #include <nuttx/fs/fs.h>
 #include <nuttx/arch.h>
 #include <nuttx/analog/adc.h>
+#include <nuttx/analog/ioctl.h>
 #include <nuttx/random.h>
 
 #include <nuttx/irq.h>
@@ -73,6 +74,10 @@ static ssize_t adc_read(FAR struct file *fielp, FAR char *buffer,
 static int     adc_ioctl(FAR struct file *filep, int cmd, unsigned long arg);
 static int     adc_receive(FAR struct adc_dev_s *dev, uint8_t ch,
                            int32_t data);
+#ifdef CONFIG_ADC_STREAM
+static int     adc_stream(FAR struct adc_dev_s *dev, FAR const void *buffer,
+                          size_t nbytes);
+#endif
 static void    adc_notify(FAR struct adc_dev_s *dev);
 static int     adc_poll(FAR struct file *filep, struct pollfd *fds,
                         bool setup);
@@ -98,6 +103,9 @@ static const struct file_operations g_adc_fops =
 static const struct adc_callback_s g_adc_callback =
 {
   adc_receive   /* au_receive */
+#ifdef CONFIG_ADC_STREAM
+  , adc_stream  /* au_stream */
+#endif
 };
 
 /****************************************************************************
@@ -206,6 +214,16 @@ static int adc_close(FAR struct file *filep)
 
           dev->ad_ocount = 0;
 
+#ifdef CONFIG_ADC_STREAM
+          /* Stop the DMA streaming */
+
+          if (dev->ad_streaming)
+            {
+              dev->ad_ops->ao_stream(dev, NULL);
+              dev->ad_streaming = false;
+            }
+#endif
+
           /* Free the IRQ and disable the ADC device */
 
           flags = enter_critical_section();    /* Disable interrupts */
@@ -219,6 +237,87 @@ static int adc_close(FAR struct file *filep)
   return ret;
 }
 
+/****************************************************************************
+ * Name: adc_streamread
+ *
+ * Description:
+ *   Return the latest block filled by the DMA, with a single copy.  The
+ *   blocks that were overwritten before they could be read are counted as
+ *   overruns.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ADC_STREAM
+static ssize_t adc_streamread(FAR struct file *filep,
+                              FAR struct adc_dev_s *dev,
+                              FAR char *buffer, size_t buflen)
+{
+  FAR const void *block;
+  irqstate_t flags;
+  uint32_t seq;
+  size_t nbytes;
+  int ret;
+
+  flags = enter_critical_section();
+  for (; ; )
+    {
+      while (dev->ad_stseq == dev->ad_stread)
+        {
+          if (filep->f_oflags & O_NONBLOCK)
+            {
+              ret = -EAGAIN;
+              goto errout;
+            }
+
+          dev->ad_nrxwaiters++;
+          ret = nxsem_wait(&dev->ad_recv.af_sem);
+          dev->ad_nrxwaiters--;
+          if (ret < 0)
+            {
+              goto errout;
+            }
+        }
+
+      /* Only the last block is still valid:  The DMA is already filling
+       * the one before it.
+       */
+
+      seq    = dev->ad_stseq;
+      block  = dev->ad_stbuffer;
+      nbytes = dev->ad_stnbytes;
+      if (buflen < nbytes)
+        {
+          ret = -EINVAL;
+          goto errout;
+        }
+
+      dev->ad_stoverruns += seq - dev->ad_stread - 1;
+      dev->ad_stread = seq;
+
+      /* Copy the block with interrupts enabled.  If another block was
+       * reported meanwhile, the DMA may have overwritten this one while it
+       * was copied.
+       */
+
+      leave_critical_section(flags);
+      memcpy(buffer, block, nbytes);
+      flags = enter_critical_section();
+
+      if (dev->ad_stseq == seq)
+        {
+          ret = nbytes;
+          break;
+        }
+
+      dev->ad_stoverruns++;
+    }
+
+errout:
+  leave_critical_section(flags);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: adc_read
  ****************************************************************************/
@@ -235,6 +334,13 @@ static ssize_t adc_read(FAR struct file *filep, FAR char *buffer,
 
   ainfo("buflen: %d\n", (int)buflen);
 
+#ifdef CONFIG_ADC_STREAM
+  if (dev->ad_streaming)
+    {
+      return adc_streamread(filep, dev, buffer, buflen);
+    }
+#endif
+
   /* Determine size of the messages to return.
    *
    * REVISIT:  What if buflen is 8 does that mean 4 messages of size 2?  Or
@@ -411,6 +517,72 @@ static int adc_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
   FAR struct adc_dev_s *dev = inode->i_private;
   int ret;
 
+#ifdef CONFIG_ADC_STREAM
+  FAR struct adc_stream_s *stream;
+  FAR uint32_t *overruns;
+  irqstate_t flags;
+
+  switch (cmd)
+    {
+      case ANIOC_STREAM_START:
+        stream = (FAR struct adc_stream_s *)((uintptr_t)arg);
+        if (stream == NULL)
+          {
+            return -EINVAL;
+          }
+
+        if (dev->ad_ops->ao_stream == NULL)
+          {
+            return -ENOTSUP;
+          }
+
+        if (dev->ad_streaming)
+          {
+            return -EBUSY;
+          }
+
+        flags = enter_critical_section();
+        dev->ad_stseq      = 0;
+        dev->ad_stread     = 0;
+        dev->ad_stoverruns = 0;
+        leave_critical_section(flags);
+
+        ret = dev->ad_ops->ao_stream(dev, stream);
+        if (ret >= 0)
+          {
+            dev->ad_streaming = true;
+          }
+
+        return ret;
+
+      case ANIOC_STREAM_STOP:
+        if (!dev->ad_streaming)
+          {
+            return OK;
+          }
+
+        ret = dev->ad_ops->ao_stream(dev, NULL);
+        dev->ad_streaming = false;
+        return ret;
+
+      case ANIOC_STREAM_OVERRUNS:
+        overruns = (FAR uint32_t *)((uintptr_t)arg);
+        if (overruns == NULL)
+          {
+            return -EINVAL;
+          }
+
+        flags = enter_critical_section();
+        *overruns = dev->ad_stoverruns;
+        dev->ad_stoverruns = 0;
+        leave_critical_section(flags);
+        return OK;
+
+      default:
+        break;
+    }
+#endif
+
   ret = dev->ad_ops->ao_ioctl(dev, cmd, arg);
   return ret;
 }
@@ -456,6 +628,32 @@ static int adc_receive(FAR struct adc_dev_s *dev, uint8_t ch, int32_t data)
   return errcode;
 }
 
+/****************************************************************************
+ * Name: adc_stream
+ *
+ * Description:
+ *   Called by the lower half, usually from its DMA interrupt, each time a
+ *   block of the streaming buffer is full.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ADC_STREAM
+static int adc_stream(FAR struct adc_dev_s *dev, FAR const void *buffer,
+                      size_t nbytes)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  dev->ad_stbuffer = buffer;
+  dev->ad_stnbytes = nbytes;
+  dev->ad_stseq++;
+
+  adc_notify(dev);
+  leave_critical_section(flags);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: adc_pollnotify
  ****************************************************************************/
@@ -470,7 +668,7 @@ static void adc_pollnotify(FAR struct adc_dev_s *dev, uint32_t type)
       if (fds)
         {
           fds->revents |= type;
-          nxsem_post(fds->sem);
+          poll_notify(fds);
         }
     }
 }
@@ -558,6 +756,13 @@ static int adc_poll(FAR struct file *filep, struct pollfd *fds, bool setup)
         {
           adc_pollnotify(dev, POLLIN);
         }
+
+#ifdef CONFIG_ADC_STREAM
+      if (dev->ad_streaming && dev->ad_stseq != dev->ad_stread)
+        {
+          adc_pollnotify(dev, POLLIN);
+        }
+#endif
     }
   else if (fds->priv)
     {
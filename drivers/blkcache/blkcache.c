@@ -0,0 +1,1083 @@
+/****************************************************************************
+ * drivers/blkcache/blkcache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/mount.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/drivers/blkcache.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define blkcache_semgive(d) nxsem_post(&(d)->sem)  /* To match blkcache_semtake */
+#define MAX_OPENCNT         (255)                  /* Limit of uint8_t */
+#define BLKCACHE_NONE       (0xffff)               /* No cache block */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one sector of the cache */
+
+struct blkcache_block_s
+{
+  size_t       sector;       /* The sector held (if in a hash chain) */
+  uint32_t     age;          /* Time of last use, for LRU replacement */
+  uint16_t     hnext;        /* Next block in the same hash chain */
+  bool         valid;        /* true: The block holds a sector */
+  bool         dirty;        /* true: The sector must be written back */
+};
+
+struct blkcache_dev_s
+{
+  sem_t        sem;                     /* For exclusive access */
+  FAR struct inode *inode;              /* The block driver that is cached */
+  FAR uint8_t *buffer;                  /* The data of the cached sectors */
+#ifdef CONFIG_DRVR_BLKCACHE_WRITEBACK
+  FAR uint8_t *runbuffer;               /* Gathers sectors to write back */
+#endif
+  FAR struct blkcache_block_s *blocks;  /* The cached sectors */
+  FAR uint16_t *hash;                   /* Heads of the hash chains */
+  size_t       nsectors;                /* Number of sectors on device */
+  uint32_t     age;                     /* Incremented on each access */
+  uint16_t     sectsize;                /* The size of one sector */
+  uint16_t     nblocks;                 /* The number of sectors cached */
+  uint16_t     hashmask;                /* Number of hash chains minus 1 */
+  uint8_t      opencnt;                 /* Count of open references */
+  bool         readonly;                /* true: Only read access is supported */
+  struct blkcache_stats_s stats;        /* Cache statistics */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     blkcache_semtake(FAR struct blkcache_dev_s *dev);
+static int     blkcache_open(FAR struct inode *inode);
+static int     blkcache_close(FAR struct inode *inode);
+static ssize_t blkcache_read(FAR struct inode *inode,
+                             FAR unsigned char *buffer, size_t start_sector,
+                             unsigned int nsectors);
+static ssize_t blkcache_write(FAR struct inode *inode,
+                              FAR const unsigned char *buffer,
+                              size_t start_sector, unsigned int nsectors);
+static int     blkcache_geometry(FAR struct inode *inode,
+                                 FAR struct geometry *geometry);
+static int     blkcache_ioctl(FAR struct inode *inode, int cmd,
+                              unsigned long arg);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct block_operations g_bops =
+{
+  blkcache_open,     /* open */
+  blkcache_close,    /* close */
+  blkcache_read,     /* read */
+  blkcache_write,    /* write */
+  blkcache_geometry, /* geometry */
+  blkcache_ioctl     /* ioctl */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL             /* unlink */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: blkcache_semtake
+ ****************************************************************************/
+
+static int blkcache_semtake(FAR struct blkcache_dev_s *dev)
+{
+  return nxsem_wait(&dev->sem);
+}
+
+/****************************************************************************
+ * Name: blkcache_data
+ *
+ * Description:
+ *   Return the data of a cache block
+ *
+ ****************************************************************************/
+
+static inline FAR uint8_t *blkcache_data(FAR struct blkcache_dev_s *dev,
+                                         uint16_t ndx)
+{
+  return &dev->buffer[(size_t)ndx * dev->sectsize];
+}
+
+/****************************************************************************
+ * Name: blkcache_lookup
+ *
+ * Description:
+ *   Return the cache block holding a sector, or BLKCACHE_NONE if the sector
+ *   is not cached.
+ *
+ ****************************************************************************/
+
+static uint16_t blkcache_lookup(FAR struct blkcache_dev_s *dev,
+                                size_t sector)
+{
+  uint16_t ndx;
+
+  for (ndx = dev->hash[sector & dev->hashmask];
+       ndx != BLKCACHE_NONE;
+       ndx = dev->blocks[ndx].hnext)
+    {
+      if (dev->blocks[ndx].sector == sector)
+        {
+          return ndx;
+        }
+    }
+
+  return BLKCACHE_NONE;
+}
+
+/****************************************************************************
+ * Name: blkcache_remove
+ *
+ * Description:
+ *   Remove a cache block from its hash chain, discarding its contents.
+ *
+ ****************************************************************************/
+
+static void blkcache_remove(FAR struct blkcache_dev_s *dev, uint16_t ndx)
+{
+  FAR struct blkcache_block_s *block = &dev->blocks[ndx];
+  FAR uint16_t *link;
+
+  if (block->valid)
+    {
+      for (link = &dev->hash[block->sector & dev->hashmask];
+           *link != BLKCACHE_NONE;
+           link = &dev->blocks[*link].hnext)
+        {
+          if (*link == ndx)
+            {
+              *link = block->hnext;
+              break;
+            }
+        }
+
+      block->valid = false;
+      block->dirty = false;
+    }
+}
+
+/****************************************************************************
+ * Name: blkcache_writeback
+ *
+ * Description:
+ *   Write back a dirty cache block together with the dirty blocks holding
+ *   the sectors around it, up to CONFIG_DRVR_BLKCACHE_MAXRUN sectors, in a
+ *   single transfer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_BLKCACHE_WRITEBACK
+static int blkcache_writeback(FAR struct blkcache_dev_s *dev, uint16_t ndx)
+{
+  FAR struct blkcache_block_s *block;
+  FAR uint8_t *buffer;
+  size_t sector;
+  uint16_t runndx;
+  unsigned int nsectors;
+  unsigned int i;
+  ssize_t ret;
+
+  /* Find the first sector of the run of dirty sectors */
+
+  sector   = dev->blocks[ndx].sector;
+  nsectors = 1;
+
+  while (sector > 0 && nsectors < CONFIG_DRVR_BLKCACHE_MAXRUN)
+    {
+      runndx = blkcache_lookup(dev, sector - 1);
+      if (runndx == BLKCACHE_NONE || !dev->blocks[runndx].dirty)
+        {
+          break;
+        }
+
+      sector--;
+      nsectors++;
+    }
+
+  /* Then gather the run, extending it after the dirty block as well */
+
+  nsectors = 0;
+  while (nsectors < CONFIG_DRVR_BLKCACHE_MAXRUN)
+    {
+      runndx = blkcache_lookup(dev, sector + nsectors);
+      if (runndx == BLKCACHE_NONE || !dev->blocks[runndx].dirty)
+        {
+          break;
+        }
+
+      memcpy(&dev->runbuffer[nsectors * dev->sectsize],
+             blkcache_data(dev, runndx), dev->sectsize);
+      nsectors++;
+    }
+
+  DEBUGASSERT(nsectors > 0);
+
+  /* A single sector is written from the cache block itself */
+
+  buffer = nsectors > 1 ? dev->runbuffer : blkcache_data(dev, ndx);
+  ret    = dev->inode->u.i_bops->write(dev->inode, buffer, sector,
+                                       nsectors);
+  if (ret < 0)
+    {
+      ferr("ERROR: Write back of sector %lu failed: %d\n",
+           (unsigned long)sector, (int)ret);
+      return (int)ret;
+    }
+
+  dev->stats.bs_writes++;
+  dev->stats.bs_nwritten += nsectors;
+
+  /* The sectors are no longer dirty */
+
+  for (i = 0; i < nsectors; i++)
+    {
+      runndx = blkcache_lookup(dev, sector + i);
+      block  = &dev->blocks[runndx];
+      block->dirty = false;
+      dev->stats.bs_ndirty--;
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: blkcache_flush
+ *
+ * Description:
+ *   Write back all dirty cache blocks
+ *
+ ****************************************************************************/
+
+static int blkcache_flush(FAR struct blkcache_dev_s *dev)
+{
+#ifdef CONFIG_DRVR_BLKCACHE_WRITEBACK
+  uint16_t ndx;
+  int ret;
+
+  for (ndx = 0; ndx < dev->nblocks && dev->stats.bs_ndirty > 0; ndx++)
+    {
+      if (dev->blocks[ndx].dirty)
+        {
+          ret = blkcache_writeback(dev, ndx);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+#endif
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: blkcache_invalidate
+ *
+ * Description:
+ *   Discard all cached sectors, as when the media has changed.
+ *
+ ****************************************************************************/
+
+static void blkcache_invalidate(FAR struct blkcache_dev_s *dev)
+{
+  uint16_t ndx;
+
+  for (ndx = 0; ndx < dev->nblocks; ndx++)
+    {
+      dev->blocks[ndx].valid = false;
+      dev->blocks[ndx].dirty = false;
+    }
+
+  for (ndx = 0; ndx <= dev->hashmask; ndx++)
+    {
+      dev->hash[ndx] = BLKCACHE_NONE;
+    }
+
+  dev->stats.bs_ndirty = 0;
+}
+
+/****************************************************************************
+ * Name: blkcache_alloc
+ *
+ * Description:
+ *   Assign a cache block to a sector that is not cached, replacing the
+ *   least recently used sector.  The contents of the block are undefined.
+ *
+ * Returned Value:
+ *   The cache block on success; a negated errno value if a dirty sector
+ *   could not be written back.
+ *
+ ****************************************************************************/
+
+static int blkcache_alloc(FAR struct blkcache_dev_s *dev, size_t sector)
+{
+  FAR struct blkcache_block_s *block;
+  uint16_t victim = 0;
+  uint16_t ndx;
+#ifdef CONFIG_DRVR_BLKCACHE_WRITEBACK
+  int ret;
+#endif
+
+  for (ndx = 0; ndx < dev->nblocks; ndx++)
+    {
+      block = &dev->blocks[ndx];
+      if (!block->valid)
+        {
+          victim = ndx;
+          break;
+        }
+
+      if (dev->age - block->age > dev->age - dev->blocks[victim].age)
+        {
+          victim = ndx;
+        }
+    }
+
+  block = &dev->blocks[victim];
+  if (block->valid)
+    {
+#ifdef CONFIG_DRVR_BLKCACHE_WRITEBACK
+      if (block->dirty)
+        {
+          ret = blkcache_writeback(dev, victim);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+#endif
+
+      blkcache_remove(dev, victim);
+      dev->stats.bs_evictions++;
+    }
+
+  block->sector = sector;
+  block->age    = ++dev->age;
+  block->valid  = true;
+  block->hnext  = dev->hash[sector & dev->hashmask];
+  dev->hash[sector & dev->hashmask] = victim;
+
+  return victim;
+}
+
+/****************************************************************************
+ * Name: blkcache_fill
+ *
+ * Description:
+ *   Copy sectors just transferred to or from the device into the cache.
+ *   Long transfers are not cached so that they do not flush the cache.
+ *
+ ****************************************************************************/
+
+static int blkcache_fill(FAR struct blkcache_dev_s *dev,
+                         FAR const uint8_t *buffer, size_t start_sector,
+                         unsigned int nsectors)
+{
+  uint16_t ndx;
+  unsigned int i;
+  int ret;
+
+  for (i = 0; i < nsectors; i++)
+    {
+      ndx = blkcache_lookup(dev, start_sector + i);
+      if (ndx == BLKCACHE_NONE)
+        {
+          if (nsectors >= dev->nblocks)
+            {
+              continue;
+            }
+
+          ret = blkcache_alloc(dev, start_sector + i);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          ndx = (uint16_t)ret;
+        }
+      else if (dev->blocks[ndx].dirty)
+        {
+          /* The data written supersedes the dirty sector */
+
+          dev->blocks[ndx].dirty = false;
+          dev->stats.bs_ndirty--;
+        }
+
+      memcpy(blkcache_data(dev, ndx), &buffer[i * dev->sectsize],
+             dev->sectsize);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: blkcache_open
+ *
+ * Description: Open the block device
+ *
+ ****************************************************************************/
+
+static int blkcache_open(FAR struct inode *inode)
+{
+  FAR struct blkcache_dev_s *dev;
+  int ret;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct blkcache_dev_s *)inode->i_private;
+
+  /* Make sure we have exclusive access to the state structure */
+
+  ret = blkcache_semtake(dev);
+  if (ret == OK)
+    {
+      if (dev->opencnt == MAX_OPENCNT)
+        {
+          ret = -EMFILE;
+        }
+      else
+        {
+          /* Increment the open count */
+
+          dev->opencnt++;
+        }
+
+      blkcache_semgive(dev);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: blkcache_close
+ *
+ * Description: close the block device
+ *
+ ****************************************************************************/
+
+static int blkcache_close(FAR struct inode *inode)
+{
+  FAR struct blkcache_dev_s *dev;
+  int ret;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct blkcache_dev_s *)inode->i_private;
+
+  /* Make sure we have exclusive access to the state structure */
+
+  ret = blkcache_semtake(dev);
+  if (ret == OK)
+    {
+      if (dev->opencnt == 0)
+        {
+          ret = -EIO;
+        }
+      else
+        {
+          /* Decrement the open count.  Write back the cache when the last
+           * user, typically a file system being unmounted, is gone.
+           */
+
+          dev->opencnt--;
+          if (dev->opencnt == 0)
+            {
+              ret = blkcache_flush(dev);
+            }
+        }
+
+      blkcache_semgive(dev);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: blkcache_read
+ *
+ * Description:  Read the specified number of sectors
+ *
+ ****************************************************************************/
+
+static ssize_t blkcache_read(FAR struct inode *inode,
+                             FAR unsigned char *buffer, size_t start_sector,
+                             unsigned int nsectors)
+{
+  FAR struct blkcache_dev_s *dev;
+  FAR struct blkcache_block_s *block;
+  unsigned int nread;
+  unsigned int run;
+  uint16_t ndx;
+  ssize_t ret;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct blkcache_dev_s *)inode->i_private;
+
+  if (start_sector + nsectors > dev->nsectors)
+    {
+      ferr("ERROR: Read past end of device\n");
+      return -EIO;
+    }
+
+  ret = blkcache_semtake(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  nread = 0;
+  while (nread < nsectors)
+    {
+      /* Copy out the sector if it is cached */
+
+      ndx = blkcache_lookup(dev, start_sector + nread);
+      if (ndx != BLKCACHE_NONE)
+        {
+          block      = &dev->blocks[ndx];
+          block->age = ++dev->age;
+
+          memcpy(&buffer[nread * dev->sectsize], blkcache_data(dev, ndx),
+                 dev->sectsize);
+
+          dev->stats.bs_hits++;
+          nread++;
+          continue;
+        }
+
+      /* Otherwise, read the whole run of sectors that are not cached
+       * directly into the caller's buffer with one transfer.
+       */
+
+      for (run = 1; nread + run < nsectors; run++)
+        {
+          if (blkcache_lookup(dev, start_sector + nread + run) !=
+              BLKCACHE_NONE)
+            {
+              break;
+            }
+        }
+
+      ret = dev->inode->u.i_bops->read(dev->inode,
+                                       &buffer[nread * dev->sectsize],
+                                       start_sector + nread, run);
+      if (ret < 0)
+        {
+          ferr("ERROR: Read of sector %lu failed: %d\n",
+               (unsigned long)(start_sector + nread), (int)ret);
+          goto errout_with_sem;
+        }
+
+      dev->stats.bs_reads++;
+      dev->stats.bs_misses += ret;
+
+      /* Then keep a copy of the sectors read */
+
+      ret = blkcache_fill(dev, &buffer[nread * dev->sectsize],
+                          start_sector + nread, ret);
+      if (ret < 0)
+        {
+          goto errout_with_sem;
+        }
+
+      nread += run;
+    }
+
+  ret = nread;
+
+errout_with_sem:
+  blkcache_semgive(dev);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: blkcache_write
+ *
+ * Description: Write the specified number of sectors
+ *
+ ****************************************************************************/
+
+static ssize_t blkcache_write(FAR struct inode *inode,
+                              FAR const unsigned char *buffer,
+                              size_t start_sector, unsigned int nsectors)
+{
+  FAR struct blkcache_dev_s *dev;
+#ifdef CONFIG_DRVR_BLKCACHE_WRITEBACK
+  FAR struct blkcache_block_s *block;
+  unsigned int i;
+  uint16_t ndx;
+#endif
+  ssize_t ret;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct blkcache_dev_s *)inode->i_private;
+
+  if (dev->readonly)
+    {
+      return -EACCES;
+    }
+
+  if (start_sector + nsectors > dev->nsectors)
+    {
+      ferr("ERROR: Write past end of device\n");
+      return -EIO;
+    }
+
+  ret = blkcache_semtake(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+#ifdef CONFIG_DRVR_BLKCACHE_WRITEBACK
+  /* Keep the sectors in the cache to be written back later, unless the
+   * transfer is too long to be cached.
+   */
+
+  if (nsectors < dev->nblocks)
+    {
+      for (i = 0; i < nsectors; i++)
+        {
+          ndx = blkcache_lookup(dev, start_sector + i);
+          if (ndx == BLKCACHE_NONE)
+            {
+              ret = blkcache_alloc(dev, start_sector + i);
+              if (ret < 0)
+                {
+                  goto errout_with_sem;
+                }
+
+              ndx = (uint16_t)ret;
+            }
+
+          block      = &dev->blocks[ndx];
+          block->age = ++dev->age;
+          if (!block->dirty)
+            {
+              block->dirty = true;
+              dev->stats.bs_ndirty++;
+            }
+
+          memcpy(blkcache_data(dev, ndx), &buffer[i * dev->sectsize],
+                 dev->sectsize);
+        }
+
+      ret = nsectors;
+      goto errout_with_sem;
+    }
+#endif
+
+  /* Write the sectors through to the device */
+
+  ret = dev->inode->u.i_bops->write(dev->inode, buffer, start_sector,
+                                    nsectors);
+  if (ret < 0)
+    {
+      ferr("ERROR: Write of sector %lu failed: %d\n",
+           (unsigned long)start_sector, (int)ret);
+      goto errout_with_sem;
+    }
+
+  dev->stats.bs_writes++;
+  dev->stats.bs_nwritten += ret;
+
+  /* Then update the cached copies of the sectors written */
+
+  nsectors = ret;
+  ret = blkcache_fill(dev, buffer, start_sector, nsectors);
+  if (ret >= 0)
+    {
+      ret = nsectors;
+    }
+
+errout_with_sem:
+  blkcache_semgive(dev);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: blkcache_geometry
+ *
+ * Description: Return device geometry
+ *
+ ****************************************************************************/
+
+static int blkcache_geometry(FAR struct inode *inode,
+                             FAR struct geometry *geometry)
+{
+  FAR struct blkcache_dev_s *dev;
+  int ret;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct blkcache_dev_s *)inode->i_private;
+
+  if (geometry == NULL)
+    {
+      return -EINVAL;
+    }
+
+  ret = dev->inode->u.i_bops->geometry(dev->inode, geometry);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* The cached sectors are of no use if the media has changed */
+
+  if (geometry->geo_mediachanged || !geometry->geo_available ||
+      geometry->geo_sectorsize != dev->sectsize)
+    {
+      ret = blkcache_semtake(dev);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      if (dev->stats.bs_ndirty > 0)
+        {
+          ferr("ERROR: Media changed, %u sectors lost\n",
+               dev->stats.bs_ndirty);
+        }
+
+      blkcache_invalidate(dev);
+      blkcache_semgive(dev);
+    }
+
+  if (dev->readonly)
+    {
+      geometry->geo_writeenabled = false;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: blkcache_ioctl
+ *
+ * Description: Handle the cache ioctl commands.  Others are passed through
+ *   to the cached block driver.
+ *
+ ****************************************************************************/
+
+static int blkcache_ioctl(FAR struct inode *inode, int cmd,
+                          unsigned long arg)
+{
+  FAR struct blkcache_dev_s *dev;
+  FAR struct inode *blkinode;
+  int ret;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev      = (FAR struct blkcache_dev_s *)inode->i_private;
+  blkinode = dev->inode;
+
+  switch (cmd)
+    {
+      case BIOC_CACHESTATS:
+        {
+          FAR struct blkcache_stats_s *stats =
+            (FAR struct blkcache_stats_s *)((uintptr_t)arg);
+
+          if (stats == NULL)
+            {
+              return -EINVAL;
+            }
+
+          ret = blkcache_semtake(dev);
+          if (ret >= 0)
+            {
+              *stats = dev->stats;
+              blkcache_semgive(dev);
+            }
+        }
+        break;
+
+      case BIOC_FLUSH:
+        {
+          /* Write back the cache and then flush the device itself */
+
+          ret = blkcache_semtake(dev);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          ret = blkcache_flush(dev);
+          blkcache_semgive(dev);
+
+          if (ret >= 0 && blkinode->u.i_bops->ioctl != NULL)
+            {
+              ret = blkinode->u.i_bops->ioctl(blkinode, cmd, arg);
+              if (ret == -ENOTTY)
+                {
+                  ret = OK;
+                }
+            }
+        }
+        break;
+
+      default:
+        {
+          ret = -ENOTTY;
+          if (blkinode->u.i_bops->ioctl != NULL)
+            {
+              ret = blkinode->u.i_bops->ioctl(blkinode, cmd, arg);
+            }
+        }
+        break;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: blkcache_setup
+ *
+ * Description:
+ *   Register the block driver 'devname' that caches the sectors of the
+ *   block driver 'blkdev'.
+ *
+ ****************************************************************************/
+
+int blkcache_setup(FAR const char *devname, FAR const char *blkdev,
+                   uint16_t nblocks, bool readonly)
+{
+  FAR struct blkcache_dev_s *dev;
+  struct geometry geo;
+  unsigned int nbuckets;
+  int ret;
+
+  /* Sanity check */
+
+#ifdef CONFIG_DEBUG_FEATURES
+  if (devname == NULL || blkdev == NULL || nblocks == 0 ||
+      nblocks == BLKCACHE_NONE)
+    {
+      return -EINVAL;
+    }
+#endif
+
+  /* Allocate a block cache device structure */
+
+  dev = (FAR struct blkcache_dev_s *)
+    kmm_zalloc(sizeof(struct blkcache_dev_s));
+  if (dev == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* Open the block driver to be cached */
+
+  ret = open_blockdriver(blkdev, readonly ? MS_RDONLY : 0, &dev->inode);
+  if (ret < 0)
+    {
+      ferr("ERROR: Failed to open %s: %d\n", blkdev, ret);
+      goto errout_with_dev;
+    }
+
+  DEBUGASSERT(dev->inode->u.i_bops && dev->inode->u.i_bops->geometry);
+
+  ret = dev->inode->u.i_bops->geometry(dev->inode, &geo);
+  if (ret < 0 || !geo.geo_available)
+    {
+      ferr("ERROR: geometry failed: %d\n", ret);
+      ret = ret < 0 ? ret : -ENODEV;
+      goto errout_with_inode;
+    }
+
+  if (!readonly && (dev->inode->u.i_bops->write == NULL ||
+                    !geo.geo_writeenabled))
+    {
+      readonly = true;
+    }
+
+  /* The number of hash chains is the power of two at or above the number
+   * of cached sectors.
+   */
+
+  for (nbuckets = 1; nbuckets < nblocks; nbuckets <<= 1);
+
+  /* Initialize the block cache device structure */
+
+  nxsem_init(&dev->sem, 0, 1);
+  dev->nsectors          = geo.geo_nsectors;
+  dev->sectsize          = geo.geo_sectorsize;
+  dev->nblocks           = nblocks;
+  dev->hashmask          = nbuckets - 1;
+  dev->readonly          = readonly;
+  dev->stats.bs_nblocks  = nblocks;
+
+  /* Allocate the cache */
+
+  dev->buffer = (FAR uint8_t *)kmm_malloc((size_t)nblocks * dev->sectsize);
+  dev->blocks = (FAR struct blkcache_block_s *)
+    kmm_zalloc(nblocks * sizeof(struct blkcache_block_s));
+  dev->hash   = (FAR uint16_t *)kmm_malloc(nbuckets * sizeof(uint16_t));
+#ifdef CONFIG_DRVR_BLKCACHE_WRITEBACK
+  dev->runbuffer = (FAR uint8_t *)
+    kmm_malloc(CONFIG_DRVR_BLKCACHE_MAXRUN * dev->sectsize);
+  if (dev->runbuffer == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_buffers;
+    }
+#endif
+
+  if (dev->buffer == NULL || dev->blocks == NULL || dev->hash == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_buffers;
+    }
+
+  blkcache_invalidate(dev);
+
+  /* Inode private data will be reference to the block cache device */
+
+  ret = register_blockdriver(devname, &g_bops, 0, dev);
+  if (ret < 0)
+    {
+      ferr("ERROR: register_blockdriver failed: %d\n", -ret);
+      goto errout_with_buffers;
+    }
+
+  return OK;
+
+errout_with_buffers:
+#ifdef CONFIG_DRVR_BLKCACHE_WRITEBACK
+  kmm_free(dev->runbuffer);
+#endif
+  kmm_free(dev->hash);
+  kmm_free(dev->blocks);
+  kmm_free(dev->buffer);
+  nxsem_destroy(&dev->sem);
+
+errout_with_inode:
+  close_blockdriver(dev->inode);
+
+errout_with_dev:
+  kmm_free(dev);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: blkcache_teardown
+ *
+ * Description:
+ *   Write back the cached sectors and undo the setup performed by
+ *   blkcache_setup().
+ *
+ ****************************************************************************/
+
+int blkcache_teardown(FAR const char *devname)
+{
+  FAR struct blkcache_dev_s *dev;
+  FAR struct inode *inode;
+  int ret;
+
+  /* Sanity check */
+
+#ifdef CONFIG_DEBUG_FEATURES
+  if (devname == NULL)
+    {
+      return -EINVAL;
+    }
+#endif
+
+  /* Open the block driver associated with devname so that we can get the
+   * inode reference.
+   */
+
+  ret = open_blockdriver(devname, MS_RDONLY, &inode);
+  if (ret < 0)
+    {
+      ferr("ERROR: Failed to open %s: %d\n", devname, -ret);
+      return ret;
+    }
+
+  /* Inode private data is a reference to the block cache device */
+
+  dev = (FAR struct blkcache_dev_s *)inode->i_private;
+  close_blockdriver(inode);
+
+  DEBUGASSERT(dev != NULL);
+
+  /* Are there still open references to the device */
+
+  if (dev->opencnt > 0)
+    {
+      return -EBUSY;
+    }
+
+  /* Write back anything that is still cached */
+
+  ret = blkcache_flush(dev);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Otherwise, unregister the block device */
+
+  ret = unregister_blockdriver(devname);
+
+  /* Release the device structure */
+
+  close_blockdriver(dev->inode);
+
+#ifdef CONFIG_DRVR_BLKCACHE_WRITEBACK
+  kmm_free(dev->runbuffer);
+#endif
+  kmm_free(dev->hash);
+  kmm_free(dev->blocks);
+  kmm_free(dev->buffer);
+  nxsem_destroy(&dev->sem);
+  kmm_free(dev);
+  return ret;
+}
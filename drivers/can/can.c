@@ -55,6 +55,7 @@
 #include <debug.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/clock.h>
 #include <nuttx/signal.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/can/can.h>
@@ -203,7 +204,7 @@ static void can_pollnotify(FAR struct can_dev_s *dev, pollevent_t eventset)
           if (fds->revents != 0)
             {
               caninfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
@@ -1242,12 +1243,23 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
   FAR uint8_t             *dest;
   FAR struct list_node    *node;
   FAR struct list_node    *tmp;
+#ifdef CONFIG_CAN_TIMESTAMP
+  struct timespec          ts;
+#endif
   int                      nexttail;
   int                      errcode = -ENOMEM;
   int                      i;
 
   caninfo("ID: %d DLC: %d\n", hdr->ch_id, hdr->ch_dlc);
 
+#ifdef CONFIG_CAN_TIMESTAMP
+  /* Take the time of reception before the frame is copied anywhere */
+
+  clock_systime_timespec(&ts);
+  hdr->ch_ts.tv_sec  = ts.tv_sec;
+  hdr->ch_ts.tv_usec = ts.tv_nsec / 1000;
+#endif
+
   /* Check if adding this new message would over-run the drivers ability to
    * enqueue read data.
    */
@@ -1347,12 +1359,6 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
             }
 
           errcode = OK;
-
-          /* Notify all poll/select waiters that they can read from the
-           * cd_recv buffer
-           */
-
-          can_pollnotify(dev, POLLIN);
         }
 #ifdef CONFIG_CAN_ERRORS
       else
@@ -1364,6 +1370,16 @@ int can_receive(FAR struct can_dev_s *dev, FAR struct can_hdr_s *hdr,
 #endif
     }
 
+  /* Notify all poll/select waiters that they can read from the cd_recv
+   * buffer.  Once per frame:  The waiters are the same for all of the
+   * readers.
+   */
+
+  if (errcode == OK)
+    {
+      can_pollnotify(dev, POLLIN);
+    }
+
   return errcode;
 }
 
@@ -97,7 +97,9 @@
 #include <string.h>
 #include <nuttx/fs/fs.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/signal.h>
 #include <nuttx/i2c/i2c_master.h>
 #include <nuttx/eeprom/i2c_xx24xx.h>
 
@@ -109,6 +111,18 @@
 #  define CONFIG_EE24XX_FREQUENCY 100000
 #endif
 
+#ifndef CONFIG_EE24XX_POLL_USEC
+#  define CONFIG_EE24XX_POLL_USEC 100
+#endif
+
+/* The write cycle is polled at CONFIG_EE24XX_POLL_USEC for up to the
+ * typical write cycle time of the parts, then once per millisecond until
+ * the timeout.
+ */
+
+#define EE24XX_BUSYWAIT_USEC 5000
+#define EE24XX_TIMEOUT_USEC  50000
+
 #define UUID_SIZE   16
 
 /****************************************************************************
@@ -276,7 +290,7 @@ static const struct file_operations at24cs_uuid_fops =
  * Name: ee24xx_waitwritecomplete
  *
  * Use ACK polling to detect the completion of the write operation.
- * Returns TRUE if write is complete (device replies to ACK).
+ * Returns OK if write is complete (device replies to ACK).
  *
  ****************************************************************************/
 
@@ -284,8 +298,8 @@ static int ee24xx_waitwritecomplete(FAR struct ee24xx_dev_s *eedev,
                                     uint32_t memaddr)
 {
   struct i2c_msg_s msgs[1];
+  uint32_t elapsed = 0;
   int ret;
-  int retries = 500;
   uint8_t adr;
   uint32_t addr_hi = (memaddr >> (eedev->addrlen << 3));
 
@@ -296,12 +310,30 @@ static int ee24xx_waitwritecomplete(FAR struct ee24xx_dev_s *eedev,
   msgs[0].buffer    = &adr;
   msgs[0].length    = 1;
 
-  do
+  for (; ; )
     {
-     ret = I2C_TRANSFER(eedev->i2c, msgs, 1);
-     retries--;
+      ret = I2C_TRANSFER(eedev->i2c, msgs, 1);
+      if (ret == OK || elapsed >= EE24XX_TIMEOUT_USEC)
+        {
+          break;
+        }
+
+      /* The device does not ACK during the write cycle.  Poll with a short
+       * busy wait first so that the write completes as soon as the device
+       * is ready rather than on the next clock tick.
+       */
+
+      if (CONFIG_EE24XX_POLL_USEC > 0 && elapsed < EE24XX_BUSYWAIT_USEC)
+        {
+          up_udelay(CONFIG_EE24XX_POLL_USEC);
+          elapsed += CONFIG_EE24XX_POLL_USEC;
+        }
+      else
+        {
+          nxsig_usleep(1000);
+          elapsed += 1000;
+        }
     }
-  while (ret != 0 && retries > 0);
 
   return ret;
 }
@@ -121,6 +121,7 @@
 #include <errno.h>
 #include <nuttx/fs/fs.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/signal.h>
 #include <nuttx/spi/spi.h>
@@ -133,6 +134,16 @@
 #  define CONFIG_EE25XX_SPIMODE 0
 #endif
 
+#ifndef CONFIG_EE25XX_POLL_USEC
+#  define CONFIG_EE25XX_POLL_USEC 100
+#endif
+
+/* The write cycle is polled at CONFIG_EE25XX_POLL_USEC for up to this
+ * time, the typical write cycle time of the parts.
+ */
+
+#define EE25XX_BUSYWAIT_USEC 5000
+
 /* EEPROM commands
  * High bit of low nibble used for A8 in 25xx040/at25040 products
  */
@@ -383,6 +394,7 @@ static void ee25xx_sendcmd(FAR struct spi_dev_s *spi, uint8_t cmd,
 
 static void ee25xx_waitwritecomplete(struct ee25xx_dev_s *priv)
 {
+  uint32_t elapsed = 0;
   uint8_t status;
 
   /* Loop as long as the memory is busy with a write cycle */
@@ -409,13 +421,24 @@ static void ee25xx_waitwritecomplete(struct ee25xx_dev_s *priv)
 
       /* Given that writing could take up to a few milliseconds,
        * the following short delay in the "busy" case will allow
-       * other peripherals to access the SPI bus.
+       * other peripherals to access the SPI bus.  Poll with a short
+       * busy wait first so that the write completes as soon as the part
+       * is ready rather than on the next clock tick.
        */
 
       if ((status & EE25XX_SR_WIP) != 0)
         {
           ee25xx_unlock(priv->spi);
-          nxsig_usleep(1000);
+          if (CONFIG_EE25XX_POLL_USEC > 0 && elapsed < EE25XX_BUSYWAIT_USEC)
+            {
+              up_udelay(CONFIG_EE25XX_POLL_USEC);
+              elapsed += CONFIG_EE25XX_POLL_USEC;
+            }
+          else
+            {
+              nxsig_usleep(1000);
+            }
+
           ee25xx_lock(priv->spi);
         }
     }
@@ -654,6 +677,7 @@ static ssize_t ee25xx_read(FAR struct file *filep, FAR char *buffer,
 {
   FAR struct ee25xx_dev_s *eedev;
   FAR struct inode        *inode = filep->f_inode;
+  int                      ret;
 
   DEBUGASSERT(inode && inode->i_private);
   eedev = (FAR struct ee25xx_dev_s *)inode->i_private;
@@ -0,0 +1,234 @@
+/****************************************************************************
+ * drivers/i2c/i2c_queue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <string.h>
+#include <queue.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/i2c/i2c_master.h>
+
+#ifdef CONFIG_I2C_QUEUE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if defined(CONFIG_I2C_QUEUE_HPWORK)
+#  define I2CWORK HPWORK
+#else
+#  define I2CWORK LPWORK
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: i2c_queue_worker
+ *
+ * Description:
+ *   Perform the queued requests of one I2C bus, highest priority first,
+ *   until the queue is empty.  A request submitted while another one is
+ *   performed is taken on the next turn of the loop, without another trip
+ *   through the work queue.
+ *
+ ****************************************************************************/
+
+static void i2c_queue_worker(FAR void *arg)
+{
+  FAR struct i2c_queue_s *queue = (FAR struct i2c_queue_s *)arg;
+  FAR struct i2c_request_s *req;
+  irqstate_t flags;
+  int ret;
+
+  for (; ; )
+    {
+      flags = enter_critical_section();
+      req   = (FAR struct i2c_request_s *)sq_remfirst(&queue->pending);
+      leave_critical_section(flags);
+
+      if (req == NULL)
+        {
+          break;
+        }
+
+      ret = I2C_TRANSFER(queue->i2c, req->msgv, req->count);
+      if (req->callback != NULL)
+        {
+          req->callback(req, ret, req->arg);
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: i2c_queue_initialize
+ *
+ * Description:
+ *   Initialize the request queue of one I2C bus.  All of the drivers that
+ *   submit requests to that bus must share the same queue.
+ *
+ * Input Parameters:
+ *   queue - The queue to initialize
+ *   i2c   - An instance of the I2C bus that the queue feeds
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void i2c_queue_initialize(FAR struct i2c_queue_s *queue,
+                          FAR struct i2c_master_s *i2c)
+{
+  DEBUGASSERT(queue != NULL && i2c != NULL);
+
+  memset(queue, 0, sizeof(struct i2c_queue_s));
+  queue->i2c = i2c;
+  sq_init(&queue->pending);
+}
+
+/****************************************************************************
+ * Name: i2c_queue_submit
+ *
+ * Description:
+ *   Add a request to the queue of an I2C bus and return without waiting.
+ *   The requests are performed on the I2C work queue, followed by the call
+ *   of their callback with the result of I2C_TRANSFER().  This may be
+ *   called from an interrupt handler.
+ *
+ * Input Parameters:
+ *   queue - The queue of the I2C bus
+ *   req   - The request to perform
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.  The callback
+ *   is not called if the request could not be queued.
+ *
+ ****************************************************************************/
+
+int i2c_queue_submit(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req)
+{
+  FAR struct i2c_request_s *prev = NULL;
+  FAR struct i2c_request_s *next;
+  irqstate_t flags;
+  bool idle;
+  int ret = OK;
+
+  DEBUGASSERT(queue != NULL && req != NULL && req->msgv != NULL &&
+              req->count > 0);
+
+  flags = enter_critical_section();
+
+  /* Keep the queue sorted by priority:  Insert the request after the last
+   * one with the same or a higher priority.
+   */
+
+  for (next = (FAR struct i2c_request_s *)sq_peek(&queue->pending);
+       next != NULL && next->priority >= req->priority;
+       next = next->flink)
+    {
+      prev = next;
+    }
+
+  /* The worker performs all of the pending requests before it returns.
+   * It only has to be started if it found the queue empty.
+   */
+
+  idle = sq_empty(&queue->pending);
+  if (prev == NULL)
+    {
+      sq_addfirst((FAR sq_entry_t *)req, &queue->pending);
+    }
+  else
+    {
+      sq_addafter((FAR sq_entry_t *)prev, (FAR sq_entry_t *)req,
+                  &queue->pending);
+    }
+
+  if (idle)
+    {
+      ret = work_queue(I2CWORK, &queue->work, i2c_queue_worker, queue, 0);
+      if (ret < 0)
+        {
+          sq_rem((FAR sq_entry_t *)req, &queue->pending);
+        }
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: i2c_queue_cancel
+ *
+ * Description:
+ *   Remove a request from the queue before it is started.
+ *
+ * Input Parameters:
+ *   queue - The queue of the I2C bus
+ *   req   - The request to remove
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was removed; its callback will not be called.
+ *   -ENOENT if the request is no longer queued: It is being performed or
+ *   it already completed.
+ *
+ ****************************************************************************/
+
+int i2c_queue_cancel(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req)
+{
+  FAR sq_entry_t *entry;
+  irqstate_t flags;
+  int ret = -ENOENT;
+
+  DEBUGASSERT(queue != NULL && req != NULL);
+
+  flags = enter_critical_section();
+  for (entry = sq_peek(&queue->pending); entry != NULL;
+       entry = sq_next(entry))
+    {
+      if (entry == (FAR sq_entry_t *)req)
+        {
+          sq_rem(entry, &queue->pending);
+          ret = OK;
+          break;
+        }
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+#endif /* CONFIG_I2C_QUEUE */
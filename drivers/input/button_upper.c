@@ -307,7 +307,7 @@ static void btn_sample(FAR struct btn_upperhalf_s *priv)
                   if (fds->revents != 0)
                     {
                       iinfo("Report events: %02x\n", fds->revents);
-                      nxsem_post(fds->sem);
+                      poll_notify(fds);
                     }
                 }
             }
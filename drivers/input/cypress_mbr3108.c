@@ -50,6 +50,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/signal.h>
 #include <nuttx/i2c/i2c_master.h>
+#include <nuttx/fs/fs.h>
 
 #include <nuttx/input/cypress_mbr3108.h>
 
@@ -1018,7 +1019,7 @@ static void mbr3108_poll_notify(FAR struct mbr3108_dev_s *priv)
           mbr3108_dbg("Report events: %02x\n", fds->revents);
 
           fds->revents |= POLLIN;
-          nxsem_post(fds->sem);
+          poll_notify(fds);
         }
     }
 }
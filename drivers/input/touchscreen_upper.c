@@ -0,0 +1,598 @@
+/****************************************************************************
+ * drivers/input/touchscreen_upper.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/input/touchscreen.h>
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure provides the state of one touchscreen device.  The
+ * samples are kept in a ring of nums entries of samplesize bytes each.
+ * head is the index of the oldest queued sample.
+ */
+
+struct touch_upperhalf_s
+{
+  FAR struct touch_lowerhalf_s *lower; /* The lower half driver */
+  uint8_t crefs;                       /* Number of open references */
+  uint8_t nwaiters;                    /* Number of threads waiting in read */
+  uint8_t nums;                        /* Number of entries of the ring */
+  uint8_t head;                        /* Index of the oldest sample */
+  uint8_t count;                       /* Number of queued samples */
+  size_t samplesize;                   /* Size of one entry of the ring */
+  sem_t exclsem;                       /* Exclusive access to the device */
+  sem_t waitsem;                       /* Wait for a sample */
+  FAR uint8_t *buffer;                 /* The ring of samples */
+
+  /* The poll structures of threads waiting for driver events */
+
+  FAR struct pollfd *fds[CONFIG_INPUT_TOUCHSCREEN_NPOLLWAITERS];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int     touch_open(FAR struct file *filep);
+static int     touch_close(FAR struct file *filep);
+static ssize_t touch_read(FAR struct file *filep, FAR char *buffer,
+                          size_t buflen);
+static int     touch_ioctl(FAR struct file *filep, int cmd,
+                           unsigned long arg);
+static int     touch_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                          bool setup);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_touch_fops =
+{
+  touch_open,    /* open */
+  touch_close,   /* close */
+  touch_read,    /* read */
+  NULL,          /* write */
+  NULL,          /* seek */
+  touch_ioctl,   /* ioctl */
+  touch_poll     /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL         /* unlink */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: touch_entry
+ *
+ * Description:
+ *   Return the entry of the ring with the given index.
+ *
+ ****************************************************************************/
+
+static inline FAR struct touch_sample_s *
+touch_entry(FAR struct touch_upperhalf_s *upper, unsigned int index)
+{
+  return (FAR struct touch_sample_s *)
+    &upper->buffer[(index % upper->nums) * upper->samplesize];
+}
+
+/****************************************************************************
+ * Name: touch_coalesce
+ *
+ * Description:
+ *   Return true if the new sample can replace the queued sample: Both only
+ *   report movement of the same set of contacts, so nothing is lost if the
+ *   reader only sees the newer positions.
+ *
+ ****************************************************************************/
+
+static bool touch_coalesce(FAR const struct touch_sample_s *queued,
+                           FAR const struct touch_sample_s *sample)
+{
+  int i;
+
+  if (queued->npoints != sample->npoints)
+    {
+      return false;
+    }
+
+  for (i = 0; i < sample->npoints; i++)
+    {
+      if (queued->point[i].id != sample->point[i].id ||
+          (queued->point[i].flags & (TOUCH_DOWN | TOUCH_UP)) != 0 ||
+          (sample->point[i].flags & (TOUCH_DOWN | TOUCH_UP)) != 0)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: touch_open
+ ****************************************************************************/
+
+static int touch_open(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct touch_upperhalf_s *upper = inode->i_private;
+  irqstate_t flags;
+  int ret;
+
+  ret = nxsem_wait(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (upper->crefs == UINT8_MAX)
+    {
+      ret = -EMFILE;
+    }
+  else
+    {
+      /* Discard the samples that were queued while nobody was listening */
+
+      if (upper->crefs++ == 0)
+        {
+          flags = enter_critical_section();
+          upper->count = 0;
+          leave_critical_section(flags);
+        }
+    }
+
+  nxsem_post(&upper->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: touch_close
+ ****************************************************************************/
+
+static int touch_close(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct touch_upperhalf_s *upper = inode->i_private;
+  int ret;
+
+  ret = nxsem_wait_uninterruptible(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  DEBUGASSERT(upper->crefs > 0);
+  upper->crefs--;
+
+  nxsem_post(&upper->exclsem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: touch_read
+ *
+ * Description:
+ *   Return as many of the queued samples as fit into the buffer, oldest
+ *   first.  Each sample takes SIZEOF_TOUCH_SAMPLE_S(npoints) bytes of the
+ *   buffer.  The buffer must hold at least one sample with the maximum
+ *   number of touch points.
+ *
+ ****************************************************************************/
+
+static ssize_t touch_read(FAR struct file *filep, FAR char *buffer,
+                          size_t buflen)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct touch_upperhalf_s *upper = inode->i_private;
+  FAR struct touch_sample_s *sample;
+  irqstate_t flags;
+  ssize_t nread = 0;
+  size_t size;
+  int ret;
+
+  if (buflen < SIZEOF_TOUCH_SAMPLE_S(upper->lower->maxpoint))
+    {
+      return -EINVAL;
+    }
+
+  ret = nxsem_wait(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Wait for a sample.  The interrupts are disabled while checking the
+   * queue so that a sample cannot be reported between the check and the
+   * wait.
+   */
+
+  flags = enter_critical_section();
+  while (upper->count == 0)
+    {
+      if ((filep->f_oflags & O_NONBLOCK) != 0)
+        {
+          nread = -EAGAIN;
+          goto out;
+        }
+
+      upper->nwaiters++;
+      nxsem_post(&upper->exclsem);
+      ret = nxsem_wait(&upper->waitsem);
+      if (ret < 0)
+        {
+          leave_critical_section(flags);
+          return ret;
+        }
+
+      ret = nxsem_wait(&upper->exclsem);
+      if (ret < 0)
+        {
+          leave_critical_section(flags);
+          return ret;
+        }
+    }
+
+  /* Copy the samples that fit */
+
+  while (upper->count > 0)
+    {
+      sample = touch_entry(upper, upper->head);
+      size   = SIZEOF_TOUCH_SAMPLE_S(sample->npoints);
+      if (nread + size > buflen)
+        {
+          break;
+        }
+
+      memcpy(&buffer[nread], sample, size);
+      nread += size;
+
+      upper->head = (upper->head + 1) % upper->nums;
+      upper->count--;
+    }
+
+out:
+  leave_critical_section(flags);
+  nxsem_post(&upper->exclsem);
+  return nread;
+}
+
+/****************************************************************************
+ * Name: touch_ioctl
+ ****************************************************************************/
+
+static int touch_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct touch_upperhalf_s *upper = inode->i_private;
+  FAR struct touch_lowerhalf_s *lower = upper->lower;
+  int ret;
+
+  if (lower->control == NULL)
+    {
+      return -ENOTTY;
+    }
+
+  ret = nxsem_wait(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  ret = lower->control(lower, cmd, arg);
+
+  nxsem_post(&upper->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: touch_poll
+ ****************************************************************************/
+
+static int touch_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                      bool setup)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct touch_upperhalf_s *upper = inode->i_private;
+  FAR struct pollfd **slot;
+  irqstate_t flags;
+  int ret;
+  int i;
+
+  ret = nxsem_wait(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (setup)
+    {
+      /* Find an available slot for the poll structure */
+
+      for (i = 0; i < CONFIG_INPUT_TOUCHSCREEN_NPOLLWAITERS; i++)
+        {
+          if (upper->fds[i] == NULL)
+            {
+              upper->fds[i] = fds;
+              fds->priv     = &upper->fds[i];
+              break;
+            }
+        }
+
+      if (i >= CONFIG_INPUT_TOUCHSCREEN_NPOLLWAITERS)
+        {
+          ierr("ERROR: Too many poll waiters\n");
+          fds->priv = NULL;
+          ret       = -EBUSY;
+        }
+      else
+        {
+          /* Report a sample that is already queued */
+
+          flags = enter_critical_section();
+          if (upper->count > 0)
+            {
+              fds->revents |= (fds->events & POLLIN);
+              if (fds->revents != 0)
+                {
+                  poll_notify(fds);
+                }
+            }
+
+          leave_critical_section(flags);
+        }
+    }
+  else if (fds->priv != NULL)
+    {
+      /* This is a request to tear down the poll */
+
+      flags     = enter_critical_section();
+      slot      = (FAR struct pollfd **)fds->priv;
+      *slot     = NULL;
+      fds->priv = NULL;
+      leave_critical_section(flags);
+    }
+
+  nxsem_post(&upper->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: touch_event
+ *
+ * Description:
+ *   Queue a sample reported by the lower half.  The time stamp of each
+ *   touch point is set here.  If the queue is full, the oldest sample is
+ *   discarded.  This function may be called from the interrupt level.
+ *
+ * Input Parameters:
+ *   priv    - The priv field of the lower half structure
+ *   sample  - The sample.  It must not hold more than maxpoint touch points.
+ *
+ ****************************************************************************/
+
+void touch_event(FAR void *priv, FAR const struct touch_sample_s *sample)
+{
+  FAR struct touch_upperhalf_s *upper = priv;
+  FAR struct touch_sample_s *entry;
+  FAR struct pollfd *fds;
+  struct timespec ts;
+  irqstate_t flags;
+  uint64_t timestamp;
+  int i;
+
+  DEBUGASSERT(upper != NULL && sample != NULL && sample->npoints > 0 &&
+              sample->npoints <= upper->lower->maxpoint);
+
+  clock_systime_timespec(&ts);
+  timestamp = (uint64_t)ts.tv_sec * USEC_PER_SEC +
+              ts.tv_nsec / NSEC_PER_USEC;
+
+  flags = enter_critical_section();
+
+  /* Merge pure movement into the newest queued sample, if possible.
+   * Otherwise use a new entry, dropping the oldest sample if the ring is
+   * full.
+   */
+
+  entry = NULL;
+  if (upper->count > 0)
+    {
+      entry = touch_entry(upper, upper->head + upper->count - 1);
+      if (!touch_coalesce(entry, sample))
+        {
+          entry = NULL;
+        }
+    }
+
+  if (entry == NULL)
+    {
+      if (upper->count >= upper->nums)
+        {
+          upper->head = (upper->head + 1) % upper->nums;
+          upper->count--;
+        }
+
+      entry = touch_entry(upper, upper->head + upper->count);
+      upper->count++;
+    }
+
+  memcpy(entry, sample, SIZEOF_TOUCH_SAMPLE_S(sample->npoints));
+  for (i = 0; i < entry->npoints; i++)
+    {
+      entry->point[i].timestamp = timestamp;
+    }
+
+  /* Wake up the readers and the poll waiters */
+
+  while (upper->nwaiters > 0)
+    {
+      upper->nwaiters--;
+      nxsem_post(&upper->waitsem);
+    }
+
+  for (i = 0; i < CONFIG_INPUT_TOUCHSCREEN_NPOLLWAITERS; i++)
+    {
+      fds = upper->fds[i];
+      if (fds != NULL)
+        {
+          fds->revents |= (fds->events & POLLIN);
+          if (fds->revents != 0)
+            {
+              poll_notify(fds);
+            }
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: touch_register
+ *
+ * Description:
+ *   Register a touchscreen lower half driver with the common upper half.
+ *
+ * Input Parameters:
+ *   lower   - The lower half driver.  Its maxpoint field must be set.
+ *   path    - The path of the device, by convention /dev/inputN
+ *   nums    - The number of samples that can be queued
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int touch_register(FAR struct touch_lowerhalf_s *lower,
+                   FAR const char *path, uint8_t nums)
+{
+  FAR struct touch_upperhalf_s *upper;
+  int ret;
+
+  DEBUGASSERT(lower != NULL && path != NULL && lower->maxpoint > 0);
+
+  if (nums == 0)
+    {
+      return -EINVAL;
+    }
+
+  upper = kmm_zalloc(sizeof(struct touch_upperhalf_s));
+  if (upper == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  upper->lower      = lower;
+  upper->nums       = nums;
+  upper->samplesize = SIZEOF_TOUCH_SAMPLE_S(lower->maxpoint);
+
+  upper->buffer = kmm_malloc(nums * upper->samplesize);
+  if (upper->buffer == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_upper;
+    }
+
+  nxsem_init(&upper->exclsem, 0, 1);
+  nxsem_init(&upper->waitsem, 0, 0);
+
+  /* The wait semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_setprotocol(&upper->waitsem, SEM_PRIO_NONE);
+
+  lower->priv = upper;
+
+  ret = register_driver(path, &g_touch_fops, 0444, upper);
+  if (ret < 0)
+    {
+      ierr("ERROR: register_driver failed: %d\n", ret);
+      goto errout_with_sem;
+    }
+
+  return OK;
+
+errout_with_sem:
+  lower->priv = NULL;
+  nxsem_destroy(&upper->waitsem);
+  nxsem_destroy(&upper->exclsem);
+  kmm_free(upper->buffer);
+
+errout_with_upper:
+  kmm_free(upper);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: touch_unregister
+ *
+ * Description:
+ *   Unregister a touchscreen device registered with touch_register().
+ *
+ ****************************************************************************/
+
+void touch_unregister(FAR struct touch_lowerhalf_s *lower,
+                      FAR const char *path)
+{
+  FAR struct touch_upperhalf_s *upper;
+
+  DEBUGASSERT(lower != NULL && lower->priv != NULL);
+  upper = lower->priv;
+
+  if (unregister_driver(path) < 0)
+    {
+      ierr("ERROR: unregister_driver failed\n");
+    }
+
+  lower->priv = NULL;
+  nxsem_destroy(&upper->waitsem);
+  nxsem_destroy(&upper->exclsem);
+  kmm_free(upper->buffer);
+  kmm_free(upper);
+}
@@ -106,6 +106,7 @@ struct mmcsd_state_s
   uint8_t wrprotect:1;             /* true: Card is write protected (from CSD) */
   uint8_t locked:1;                /* true: Media is locked (from R1) */
   uint8_t dsrimp:1;                /* true: card supports CMD4/DSR setting (from CSD) */
+  uint8_t blkcount:1;              /* true: card supports CMD23 (from SCR) */
 #ifdef CONFIG_SDIO_DMA
   uint8_t dma:1;                   /* true: hardware supports DMA */
 #endif
@@ -181,6 +182,10 @@ static int     mmcsd_transferready(FAR struct mmcsd_state_s *priv);
 #ifndef CONFIG_MMCSD_MULTIBLOCK_DISABLE
 static int     mmcsd_stoptransmission(FAR struct mmcsd_state_s *priv);
 #endif
+#ifdef CONFIG_MMCSD_BLOCKCOUNT
+static bool    mmcsd_setblockcount(FAR struct mmcsd_state_s *priv,
+                 size_t nblocks);
+#endif
 static int     mmcsd_setblocklen(FAR struct mmcsd_state_s *priv,
                  uint32_t blocklen);
 static ssize_t mmcsd_readsingle(FAR struct mmcsd_state_s *priv,
@@ -964,7 +969,7 @@ static void mmcsd_decode_cid(FAR struct mmcsd_state_s *priv, uint32_t cid[4])
  *
  * Description:
  *   Show the contents of the SD Configuration Register (SCR).  The only
- *   value retained is:  priv->buswidth;
+ *   values retained are:  priv->buswidth and priv->blkcount;
  *
  ****************************************************************************/
 
@@ -980,13 +985,16 @@ static void mmsd_decode_scr(FAR struct mmcsd_state_s *priv, uint32_t scr[2])
    *   DATA_STATE_AFTER_ERASE 55:55 1-bit erase status
    *   SD_SECURITY            54:52 3-bit SD security support level
    *   SD_BUS_WIDTHS          51:48 4-bit bus width indicator
-   *   Reserved               47:32 16-bit SD reserved space
+   *   Reserved               47:34 14-bit SD reserved space
+   *   CMD_SUPPORT            33:32 2-bit CMD23 (bit 33) and CMD20 support
    */
 
 #ifdef CONFIG_ENDIAN_BIG  /* Card transfers SCR in big-endian order */
   priv->buswidth     = (scr[0] >> 16) & 15;
+  priv->blkcount     = (scr[0] >> 1) & 1;
 #else
   priv->buswidth     = (scr[0] >> 8) & 15;
+  priv->blkcount     = (scr[0] >> 25) & 1;
 #endif
 
 #ifdef CONFIG_DEBUG_FS_INFO
@@ -1026,6 +1034,7 @@ static void mmsd_decode_scr(FAR struct mmcsd_state_s *priv, uint32_t scr[2])
         decoded.scrversion, decoded.sdversion);
   finfo("  DATA_STATE_AFTER_ERASE: %d SD_SECURITY: %d SD_BUS_WIDTHS: %x\n",
         decoded.erasestate, decoded.security, decoded.buswidth);
+  finfo("  CMD23 support: %d\n", priv->blkcount);
   finfo("  Manufacturing data: %08x\n",
         decoded.mfgdata);
 #endif
@@ -1317,6 +1326,47 @@ static int mmcsd_stoptransmission(FAR struct mmcsd_state_s *priv)
 }
 #endif
 
+/****************************************************************************
+ * Name: mmcsd_setblockcount
+ *
+ * Description:
+ *   Send SET_BLOCK_COUNT just before a multiple block transfer if the card
+ *   supports it.
+ *
+ * Returned Value:
+ *   True if the card will end the transfer by itself after nblocks blocks;
+ *   false if the transfer must be ended with STOP_TRANSMISSION.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MMCSD_BLOCKCOUNT
+static bool mmcsd_setblockcount(FAR struct mmcsd_state_s *priv,
+                                size_t nblocks)
+{
+  int ret;
+
+  if (!IS_SD(priv->type) || !priv->blkcount || nblocks > 0xffff)
+    {
+      return false;
+    }
+
+  /* Send CMD23, SET_BLOCK_COUNT, and verify that good R1 status is
+   * returned.  Stop using it if the card rejects it anyway.
+   */
+
+  mmcsd_sendcmdpoll(priv, SD_CMD23, nblocks);
+  ret = mmsd_recv_r1(priv, SD_CMD23);
+  if (ret != OK)
+    {
+      ferr("ERROR: mmsd_recv_r1 for CMD23 failed: %d\n", ret);
+      priv->blkcount = false;
+      return false;
+    }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: mmcsd_setblocklen
  *
@@ -1503,6 +1553,7 @@ static ssize_t mmcsd_readmultiple(FAR struct mmcsd_state_s *priv,
 {
   size_t nbytes;
   off_t  offset;
+  bool   predefined = false;
   int ret;
 
   finfo("startblock=%d nblocks=%d\n", startblock, nblocks);
@@ -1572,6 +1623,12 @@ static ssize_t mmcsd_readmultiple(FAR struct mmcsd_state_s *priv,
       return ret;
     }
 
+#ifdef CONFIG_MMCSD_BLOCKCOUNT
+  /* Tell the card how many blocks will be read */
+
+  predefined = mmcsd_setblockcount(priv, nblocks);
+#endif
+
   /* Configure SDIO controller hardware for the read transfer */
 
   SDIO_BLOCKSETUP(priv->dev, priv->blocksize, nblocks);
@@ -1617,9 +1674,15 @@ static ssize_t mmcsd_readmultiple(FAR struct mmcsd_state_s *priv,
       return ret;
     }
 
-  /* Send STOP_TRANSMISSION */
+  /* Send STOP_TRANSMISSION, unless the card stopped after the number of
+   * blocks set with SET_BLOCK_COUNT.
+   */
+
+  if (!predefined)
+    {
+      ret = mmcsd_stoptransmission(priv);
+    }
 
-  ret = mmcsd_stoptransmission(priv);
 #ifdef CONFIG_SDIO_DMA
   SDIO_DMADELYDINVLDT(priv->dev, buffer, priv->blocksize * nblocks);
 #endif
@@ -1879,6 +1942,7 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
 {
   off_t  offset;
   size_t nbytes;
+  bool   predefined = false;
   int ret;
   int evret = OK;
 
@@ -1951,13 +2015,21 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
       return ret;
     }
 
+#ifdef CONFIG_MMCSD_BLOCKCOUNT
+  /* Tell the card how many blocks will be written.  This also lets the
+   * card prepare the whole range, so ACMD23 is not sent in that case.
+   */
+
+  predefined = mmcsd_setblockcount(priv, nblocks);
+#endif
+
   /* If this is an SD card, then send ACMD23 (SET_WR_BLK_ERASE_COUNT) just
    * before sending CMD25 (WRITE_MULTIPLE_BLOCK).  This sets the number of
    * write blocks to be pre-erased and might make the following multiple
    * block write command faster.
    */
 
-  if (IS_SD(priv->type))
+  if (IS_SD(priv->type) && !predefined)
     {
       /* Send CMD55, APP_CMD, a verify that good R1 status is returned */
 
@@ -2055,9 +2127,16 @@ static ssize_t mmcsd_writemultiple(FAR struct mmcsd_state_s *priv,
        */
     }
 
-  /* Send STOP_TRANSMISSION */
+  /* Send STOP_TRANSMISSION, unless the card stopped after the number of
+   * blocks set with SET_BLOCK_COUNT.  After an error, it is always sent.
+   */
+
+  ret = OK;
+  if (!predefined || evret != OK)
+    {
+      ret = mmcsd_stoptransmission(priv);
+    }
 
-  ret = mmcsd_stoptransmission(priv);
   if (evret != OK)
     {
       return evret;
@@ -3539,6 +3618,7 @@ static int mmcsd_removed(FAR struct mmcsd_state_s *priv)
   priv->type         = MMCSD_CARDTYPE_UNKNOWN;
   priv->rca          = 0;
   priv->selblocklen  = 0;
+  priv->blkcount     = false;
 
   /* Go back to the default 1-bit data bus. */
 
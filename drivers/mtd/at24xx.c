@@ -57,6 +57,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/signal.h>
 #include <nuttx/fs/ioctl.h>
@@ -144,6 +145,16 @@
 #  define CONFIG_AT24XX_TIMEOUT_MS 10
 #endif
 
+#ifndef CONFIG_AT24XX_POLL_USEC
+#  define CONFIG_AT24XX_POLL_USEC 100
+#endif
+
+/* The write cycle is polled at CONFIG_AT24XX_POLL_USEC for up to the typical
+ * write cycle time of the parts, then once per millisecond until the timeout.
+ */
+
+#define AT24XX_BUSYWAIT_USEC 5000
+
 /************************************************************************************
  * Private Types
  ************************************************************************************/
@@ -249,6 +260,49 @@ static int at24c_i2c_read(FAR struct at24c_dev_s *priv, uint16_t at24addr,
   return I2C_TRANSFER(priv->dev, &msg, 1);
 }
 
+/****************************************************************************
+ * Name: at24c_waitwritecomplete
+ *
+ * Description:
+ *   Use ACK polling to wait for the completion of a preceding write cycle.
+ *   The device is addressed with the data address in buf, which is also
+ *   the address of the following access.
+ *
+ ****************************************************************************/
+
+static int at24c_waitwritecomplete(FAR struct at24c_dev_s *priv,
+                                   uint16_t at24addr,
+                                   FAR const uint8_t *buf)
+{
+  uint32_t elapsed = 0;
+
+  while (at24c_i2c_write(priv, at24addr, buf, AT24XX_ADDRSIZE) < 0)
+    {
+      finfo("wait\n");
+      if (elapsed >= CONFIG_AT24XX_TIMEOUT_MS * 1000)
+        {
+          return -ETIMEDOUT;
+        }
+
+      /* Poll with a short busy wait first so that the write completes as
+       * soon as the device is ready rather than on the next clock tick.
+       */
+
+      if (CONFIG_AT24XX_POLL_USEC > 0 && elapsed < AT24XX_BUSYWAIT_USEC)
+        {
+          up_udelay(CONFIG_AT24XX_POLL_USEC);
+          elapsed += CONFIG_AT24XX_POLL_USEC;
+        }
+      else
+        {
+          nxsig_usleep(1000);
+          elapsed += 1000;
+        }
+    }
+
+  return OK;
+}
+
 /************************************************************************************
  * Name: at24c_eraseall
  ************************************************************************************/
@@ -257,7 +311,7 @@ static int at24c_eraseall(FAR struct at24c_dev_s *priv)
 {
   uint8_t buf[AT24XX_PAGESIZE + AT24XX_ADDRSIZE];
   int startblock = 0;
-  uint16_t wait;
+  int ret;
 
   memset(&buf[AT24XX_ADDRSIZE], 0xff, priv->pagesize);
 
@@ -275,16 +329,10 @@ static int at24c_eraseall(FAR struct at24c_dev_s *priv)
       at24addr = (priv->addr | ((offset >> 8) & 0x07));
 #endif
 
-      wait = CONFIG_AT24XX_TIMEOUT_MS;
-      while (at24c_i2c_write(priv, at24addr, buf, AT24XX_ADDRSIZE) < 0)
+      ret = at24c_waitwritecomplete(priv, at24addr, buf);
+      if (ret < 0)
         {
-          finfo("wait\n");
-          if (!wait--)
-            {
-              return -ETIMEDOUT;
-            }
-
-          nxsig_usleep(1000);
+          return ret;
         }
 
       at24c_i2c_write(priv, at24addr, buf, AT24XX_PAGESIZE + AT24XX_ADDRSIZE);
@@ -314,7 +362,7 @@ static ssize_t at24c_read_internal(FAR struct at24c_dev_s *priv, off_t offset,
 {
   uint8_t buf[AT24XX_ADDRSIZE];
   uint16_t at24addr;
-  uint16_t wait;
+  int ret;
 
   finfo("offset: %lu nbytes: %lu address: %02x\n",
         (unsigned long)offset, (unsigned long)nbytes, address);
@@ -341,16 +389,10 @@ static ssize_t at24c_read_internal(FAR struct at24c_dev_s *priv, off_t offset,
   at24addr = (address | ((offset >> 8) & 0x07));
 #endif
 
-  wait = CONFIG_AT24XX_TIMEOUT_MS;
-  while (at24c_i2c_write(priv, at24addr, buf, AT24XX_ADDRSIZE) < 0)
+  ret = at24c_waitwritecomplete(priv, at24addr, buf);
+  if (ret < 0)
     {
-      finfo("wait\n");
-      if (!wait--)
-        {
-          return -ETIMEDOUT;
-        }
-
-      nxsig_usleep(1000);
+      return ret;
     }
 
   /* Then transfer the following bytes */
@@ -430,7 +472,7 @@ static ssize_t at24c_bwrite(FAR struct mtd_dev_s *dev, off_t startblock, size_t
   FAR struct at24c_dev_s *priv = (FAR struct at24c_dev_s *)dev;
   size_t blocksleft;
   uint8_t buf[AT24XX_PAGESIZE + AT24XX_ADDRSIZE];
-  uint16_t wait;
+  int ret;
 
 #if CONFIG_AT24XX_MTD_BLOCKSIZE > AT24XX_PAGESIZE
   startblock *= (CONFIG_AT24XX_MTD_BLOCKSIZE / AT24XX_PAGESIZE);
@@ -464,16 +506,10 @@ static ssize_t at24c_bwrite(FAR struct mtd_dev_s *dev, off_t startblock, size_t
       at24addr = (priv->addr | ((offset >> 8) & 0x07));
 #endif
 
-      wait = CONFIG_AT24XX_TIMEOUT_MS;
-      while (at24c_i2c_write(priv, at24addr, buf, AT24XX_ADDRSIZE) < 0)
+      ret = at24c_waitwritecomplete(priv, at24addr, buf);
+      if (ret < 0)
         {
-          finfo("wait\n");
-          if (!wait--)
-            {
-              return -ETIMEDOUT;
-            }
-
-          nxsig_usleep(1000);
+          return ret;
         }
 
       memcpy(&buf[AT24XX_ADDRSIZE], buffer, priv->pagesize);
@@ -49,6 +49,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/arch.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/signal.h>
 #include <nuttx/fs/ioctl.h>
@@ -69,6 +70,16 @@
 #  define CONFIG_AT25_SPIFREQUENCY 20000000
 #endif
 
+#ifndef CONFIG_AT25_POLL_USEC
+#  define CONFIG_AT25_POLL_USEC 100
+#endif
+
+/* The busy status is polled at CONFIG_AT25_POLL_USEC for up to the
+ * maximum page program time.  Longer operations are erases.
+ */
+
+#define AT25_BUSYWAIT_USEC        5000
+
 /* AT25 Registers *******************************************************************/
 
 /* Identification register values */
@@ -272,6 +283,7 @@ static inline int at25_readid(struct at25_dev_s *priv)
 
 static void at25_waitwritecomplete(struct at25_dev_s *priv)
 {
+  uint32_t elapsed = 0;
   uint8_t status;
 
   /* Loop as long as the memory is busy with a write cycle */
@@ -296,13 +308,23 @@ static void at25_waitwritecomplete(struct at25_dev_s *priv)
 
       /* Given that writing could take up to few tens of milliseconds, and erasing
        * could take more.  The following short delay in the "busy" case will allow
-       * other peripherals to access the SPI bus.
+       * other peripherals to access the SPI bus.  A page program is polled with a
+       * short busy wait first so that it does not take a full sleep.
        */
 
       if ((status & AT25_SR_BUSY) != 0)
         {
           at25_unlock(priv->dev);
-          nxsig_usleep(10000);
+          if (CONFIG_AT25_POLL_USEC > 0 && elapsed < AT25_BUSYWAIT_USEC)
+            {
+              up_udelay(CONFIG_AT25_POLL_USEC);
+              elapsed += CONFIG_AT25_POLL_USEC;
+            }
+          else
+            {
+              nxsig_usleep(10000);
+            }
+
           at25_lock(priv->dev);
         }
     }
@@ -219,6 +219,28 @@ static ssize_t ftl_read(FAR struct inode *inode, unsigned char *buffer,
 #endif
 }
 
+/****************************************************************************
+ * Name: ftl_is_erased
+ *
+ * Description: Check if the buffered data is all in the erased state
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FTL_SKIPERASE
+static bool ftl_is_erased(FAR const uint8_t *buffer, size_t nbytes)
+{
+  while (nbytes-- > 0)
+    {
+      if (*buffer++ != CONFIG_FTL_ERASEDSTATE)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: ftl_flush
  *
@@ -286,18 +308,6 @@ static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
           return -EIO;
         }
 
-      /* Then erase the erase block */
-
-      eraseblock = rwblock / dev->blkper;
-      ret        = MTD_ERASE(dev->mtd, eraseblock, 1);
-      if (ret < 0)
-        {
-          ferr("ERROR: Erase block=%d failed: %d\n", eraseblock, ret);
-          return ret;
-        }
-
-      /* Copy the user data at the end of the buffered erase block */
-
       offset = (startblock & mask) * dev->geo.blocksize;
 
       if (short_write)
@@ -309,18 +319,50 @@ static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
           nbytes = dev->geo.erasesize - offset;
         }
 
-      finfo("Copy %d bytes into erase block=%d at offset=%d\n",
-             nbytes, eraseblock, offset);
+#ifdef CONFIG_FTL_SKIPERASE
+      /* If the blocks to be written are still erased, then just program
+       * them.  There is no need to erase and rewrite the erase block.
+       */
 
-      memcpy(dev->eblock + offset, buffer, nbytes);
+      if (ftl_is_erased(dev->eblock + offset, nbytes))
+        {
+          nxfrd = MTD_BWRITE(dev->mtd, startblock,
+                             nbytes / dev->geo.blocksize, buffer);
+          if (nxfrd != nbytes / dev->geo.blocksize)
+            {
+              ferr("ERROR: Write block %d failed: %d\n", startblock, nxfrd);
+              return -EIO;
+            }
+        }
+      else
+#endif
+        {
+          /* Then erase the erase block */
 
-      /* And write the erase block back to flash */
+          eraseblock = rwblock / dev->blkper;
+          ret        = MTD_ERASE(dev->mtd, eraseblock, 1);
+          if (ret < 0)
+            {
+              ferr("ERROR: Erase block=%d failed: %d\n", eraseblock, ret);
+              return ret;
+            }
 
-      nxfrd = MTD_BWRITE(dev->mtd, rwblock, dev->blkper, dev->eblock);
-      if (nxfrd != dev->blkper)
-        {
-          ferr("ERROR: Write erase block %d failed: %d\n", rwblock, nxfrd);
-          return -EIO;
+          /* Copy the user data at the end of the buffered erase block */
+
+          finfo("Copy %d bytes into erase block=%d at offset=%d\n",
+                 nbytes, eraseblock, offset);
+
+          memcpy(dev->eblock + offset, buffer, nbytes);
+
+          /* And write the erase block back to flash */
+
+          nxfrd = MTD_BWRITE(dev->mtd, rwblock, dev->blkper, dev->eblock);
+          if (nxfrd != dev->blkper)
+            {
+              ferr("ERROR: Write erase block %d failed: %d\n",
+                   rwblock, nxfrd);
+              return -EIO;
+            }
         }
 
       /* Then update for amount written */
@@ -392,31 +434,52 @@ static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
           return -EIO;
         }
 
-      /* Then erase the erase block */
-
-      eraseblock = alignedblock / dev->blkper;
-      ret        = MTD_ERASE(dev->mtd, eraseblock, 1);
-      if (ret < 0)
-        {
-          ferr("ERROR: Erase block=%d failed: %d\n", eraseblock, ret);
-          return ret;
-        }
-
-      /* Copy the user data at the beginning the buffered erase block */
-
       nbytes = remaining * dev->geo.blocksize;
-      finfo("Copy %d bytes into erase block=%d at offset=0\n",
-             nbytes, alignedblock);
-      memcpy(dev->eblock, buffer, nbytes);
 
-      /* And write the erase back to flash */
+#ifdef CONFIG_FTL_SKIPERASE
+      /* If the blocks to be written are still erased, then just program
+       * them.
+       */
 
-      nxfrd = MTD_BWRITE(dev->mtd, alignedblock, dev->blkper, dev->eblock);
-      if (nxfrd != dev->blkper)
+      if (ftl_is_erased(dev->eblock, nbytes))
         {
-          ferr("ERROR: Write erase block %d failed: %d\n",
-               alignedblock, nxfrd);
-          return -EIO;
+          nxfrd = MTD_BWRITE(dev->mtd, alignedblock, remaining, buffer);
+          if (nxfrd != remaining)
+            {
+              ferr("ERROR: Write block %d failed: %d\n",
+                   alignedblock, nxfrd);
+              return -EIO;
+            }
+        }
+      else
+#endif
+        {
+          /* Then erase the erase block */
+
+          eraseblock = alignedblock / dev->blkper;
+          ret        = MTD_ERASE(dev->mtd, eraseblock, 1);
+          if (ret < 0)
+            {
+              ferr("ERROR: Erase block=%d failed: %d\n", eraseblock, ret);
+              return ret;
+            }
+
+          /* Copy the user data at the beginning the buffered erase block */
+
+          finfo("Copy %d bytes into erase block=%d at offset=0\n",
+                 nbytes, alignedblock);
+          memcpy(dev->eblock, buffer, nbytes);
+
+          /* And write the erase back to flash */
+
+          nxfrd = MTD_BWRITE(dev->mtd, alignedblock, dev->blkper,
+                             dev->eblock);
+          if (nxfrd != dev->blkper)
+            {
+              ferr("ERROR: Write erase block %d failed: %d\n",
+                   alignedblock, nxfrd);
+              return -EIO;
+            }
         }
     }
 
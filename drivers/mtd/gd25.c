@@ -51,6 +51,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/signal.h>
 #include <nuttx/fs/ioctl.h>
@@ -93,6 +94,8 @@
 #define GD25_RDMFID                 0x90    /* Read Manufacturer / Device */
 #define GD25_JEDEC_ID               0x9f    /* JEDEC ID read              */
 #define GD25_4BEN                   0xb7    /* Enable 4-byte Mode         */
+#define GD25_ES                     0x75    /* Erase suspend              */
+#define GD25_ER                     0x7a    /* Erase resume               */
 
 /**************************************************************************
  * GD25 Registers
@@ -157,6 +160,10 @@ struct gd25_dev_s
   uint16_t              nsectors;    /* Number of erase sectors */
   uint8_t               prev_instr;  /* Previous instruction given to GD25 device */
   bool                  addr_4byte;  /* True: Use Four-byte address */
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  off_t                 eraseaddr;   /* Address of the last sector erased */
+  clock_t               resumed;     /* Time when the erase was last resumed */
+#endif
 };
 
 /**************************************************************************
@@ -188,6 +195,11 @@ static void gd25_pagewrite(FAR struct gd25_dev_s *priv,
 #endif
 static inline uint8_t gd25_rdsr(FAR struct gd25_dev_s *priv, uint32_t id);
 static inline void gd25_4ben(FAR struct gd25_dev_s *priv);
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+static bool gd25_erasesuspend(FAR struct gd25_dev_s *priv, off_t address,
+                              size_t nbytes);
+static void gd25_eraseresume(FAR struct gd25_dev_s *priv);
+#endif
 
 /* MTD driver methods */
 
@@ -451,6 +463,82 @@ static inline void gd25_4ben(FAR struct gd25_dev_s *priv)
   SPI_SELECT(priv->spi, SPIDEV_FLASH(priv->spi_devid), false);
 }
 
+/**************************************************************************
+ * Name: gd25_erasesuspend
+ *
+ * Description:
+ *   Suspend a sector erase that is still in progress so that 'nbytes' at
+ *   'address' can be read.  A suspended erase must be resumed with
+ *   gd25_eraseresume() after the read.
+ *
+ * Returned Value:
+ *   True if the erase was suspended.  False if there is no erase that can
+ *   be suspended; the caller must then wait for the device as usual.
+ *
+ **************************************************************************/
+
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+static bool gd25_erasesuspend(FAR struct gd25_dev_s *priv, off_t address,
+                              size_t nbytes)
+{
+  /* Data in the sector being erased cannot be read while the erase is
+   * suspended.  And the erase is not suspended again within the clock
+   * tick that it was resumed in:  Back-to-back reads would starve it
+   * otherwise.
+   */
+
+  if (priv->prev_instr != GD25_SE ||
+      (address < priv->eraseaddr + GD25_SECTOR_SIZE &&
+       address + (off_t)nbytes > priv->eraseaddr) ||
+      clock_systime_ticks() == priv->resumed)
+    {
+      return false;
+    }
+
+  if ((gd25_rdsr(priv, 0) & GD25_SR_WIP) == 0)
+    {
+      /* The erase has already completed */
+
+      return false;
+    }
+
+  /* Send the "Erase Suspend (ES)" instruction.  This is ignored if the
+   * erase completed in the meantime, as is the "Erase Resume" instruction
+   * later.
+   */
+
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(priv->spi_devid), true);
+  SPI_SEND(priv->spi, GD25_ES);
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(priv->spi_devid), false);
+
+  /* The device is ready for reads within a few tens of microseconds */
+
+  while ((gd25_rdsr(priv, 0) & GD25_SR_WIP) != 0);
+
+  return true;
+}
+#endif
+
+/**************************************************************************
+ * Name: gd25_eraseresume
+ **************************************************************************/
+
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+static void gd25_eraseresume(FAR struct gd25_dev_s *priv)
+{
+  /* Send the "Erase Resume (ER)" instruction */
+
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(priv->spi_devid), true);
+  SPI_SEND(priv->spi, GD25_ER);
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(priv->spi_devid), false);
+
+  /* The erase is in progress again */
+
+  priv->prev_instr = GD25_SE;
+  priv->resumed    = clock_systime_ticks();
+}
+#endif
+
 /**************************************************************************
  * Name:  gd25_wren
  **************************************************************************/
@@ -548,6 +636,9 @@ static void gd25_sectorerase(FAR struct gd25_dev_s *priv, off_t sector)
 
   SPI_SEND(priv->spi, GD25_SE);
   priv->prev_instr = GD25_SE;
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  priv->eraseaddr  = address;
+#endif
 
   /* Send the sector address high byte first.  Only the most significant
    * bits (those corresponding to the sector) have any meaning.
@@ -597,15 +688,27 @@ static inline int gd25_chiperase(FAR struct gd25_dev_s *priv)
 static void gd25_byteread(FAR struct gd25_dev_s *priv, FAR uint8_t *buffer,
                           off_t address, size_t nbytes)
 {
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  bool suspended;
+#endif
+
   finfo("address: %08lx nbytes: %d\n", (long)address, (int)nbytes);
 
-  /* Wait for any preceding write or erase operation to complete. */
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  /* Suspend a sector erase in progress rather than waiting for it */
 
-  gd25_waitwritecomplete(priv);
+  suspended = gd25_erasesuspend(priv, address, nbytes);
+  if (!suspended)
+#endif
+    {
+      /* Wait for any preceding write or erase operation to complete. */
 
-  /* Make sure that writing is disabled */
+      gd25_waitwritecomplete(priv);
+
+      /* Make sure that writing is disabled */
 
-  gd25_wrdi(priv);
+      gd25_wrdi(priv);
+    }
 
   SPI_SELECT(priv->spi, SPIDEV_FLASH(priv->spi_devid), true);
 
@@ -641,6 +744,13 @@ static void gd25_byteread(FAR struct gd25_dev_s *priv, FAR uint8_t *buffer,
   SPI_RECVBLOCK(priv->spi, buffer, nbytes);
 
   SPI_SELECT(priv->spi, SPIDEV_FLASH(priv->spi_devid), false);
+
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  if (suspended)
+    {
+      gd25_eraseresume(priv);
+    }
+#endif
 }
 
 /**************************************************************************
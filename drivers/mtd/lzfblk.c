@@ -0,0 +1,748 @@
+/****************************************************************************
+ * drivers/mtd/lzfblk.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* A read-only block driver that presents the uncompressed contents of an
+ * LZF compressed image stored on an MTD device.  Any file system can then
+ * be mounted read-only on the block driver.
+ *
+ * The image is made by tools/mklzfblk.py.  It starts with this header.
+ * All multi-byte fields are big-endian, like those of the LZF headers:
+ *
+ *   Offset  Size  Content
+ *   0       4     Magic: 'L' 'Z' 'F' 'B'
+ *   4       1     Version: 1
+ *   5       1     log2 of the uncompressed block size, 9 to 15
+ *   6       2     Reserved, zero
+ *   8       4     Number of blocks, N
+ *   12      4*N+4 Image offset of each block, then the end of the last one
+ *
+ * Each block holds one LZF block of include/lzf.h (type 0 or type 1) with
+ * exactly the uncompressed block size.  The blocks are stored in order,
+ * so the compressed data of consecutive blocks is read from the MTD
+ * device in one transfer.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <lzf.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/mtd/mtd.h>
+
+#ifdef CONFIG_MTD_LZFBLK
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define LZFBLK_MAGIC        "LZFB"
+#define LZFBLK_VERSION      1
+#define LZFBLK_HDR_SIZE     12
+#define LZFBLK_MIN_BSHIFT   9
+#define LZFBLK_MAX_BSHIFT   15
+
+/* The block driver always has 512 byte sectors */
+
+#define LZFBLK_SECTSHIFT    9
+#define LZFBLK_SECTSIZE     (1 << LZFBLK_SECTSHIFT)
+
+#define LZFBLK_NOBLOCK      UINT32_MAX
+
+/* The maximum length of the device name paths is the maximum length of a
+ * name plus 5 for the the length of "/dev/" and a NUL terminator.
+ */
+
+#define DEV_NAME_MAX        (NAME_MAX + 5)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One decompressed block */
+
+struct lzfblk_cache_s
+{
+  uint32_t              block;    /* Block number or LZFBLK_NOBLOCK */
+  FAR uint8_t          *data;     /* The uncompressed data */
+};
+
+struct lzfblk_dev_s
+{
+  FAR struct mtd_dev_s *mtd;      /* Contained MTD interface */
+  struct mtd_geometry_s geo;      /* Device geometry */
+  sem_t                 exclsem;  /* Protects the buffers */
+  uint16_t              refs;     /* Number of references */
+  bool                  unlinked; /* The driver has been unlinked */
+  uint8_t               bshift;   /* log2 of the uncompressed block size */
+  uint8_t               next;     /* Next cache entry to replace */
+  uint32_t              nblocks;  /* Number of uncompressed blocks */
+  uint32_t              mtdsize;  /* Size of the MTD device in bytes */
+  FAR uint32_t         *index;    /* Image offsets of the blocks */
+
+  /* The compressed data window.  It holds the image data from woffset to
+   * woffset + wlen.
+   */
+
+  FAR uint8_t          *window;
+  uint32_t              wsize;    /* Size of the window buffer */
+  uint32_t              woffset;  /* Image offset of window[0] */
+  uint32_t              wlen;     /* Number of valid bytes in window */
+
+  struct lzfblk_cache_s cache[CONFIG_MTD_LZFBLK_NCACHE];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void    lzfblk_free(FAR struct lzfblk_dev_s *dev);
+static FAR const uint8_t *lzfblk_getbytes(FAR struct lzfblk_dev_s *dev,
+                 uint32_t offset, uint32_t nbytes);
+static FAR const uint8_t *lzfblk_getblock(FAR struct lzfblk_dev_s *dev,
+                 uint32_t block);
+
+static int     lzfblk_open(FAR struct inode *inode);
+static int     lzfblk_close(FAR struct inode *inode);
+static ssize_t lzfblk_read(FAR struct inode *inode,
+                 FAR unsigned char *buffer, size_t start_sector,
+                 unsigned int nsectors);
+static int     lzfblk_geometry(FAR struct inode *inode,
+                 FAR struct geometry *geometry);
+static int     lzfblk_ioctl(FAR struct inode *inode, int cmd,
+                 unsigned long arg);
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+static int     lzfblk_unlink(FAR struct inode *inode);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct block_operations g_bops =
+{
+  lzfblk_open,     /* open     */
+  lzfblk_close,    /* close    */
+  lzfblk_read,     /* read     */
+  NULL,            /* write    */
+  lzfblk_geometry, /* geometry */
+  lzfblk_ioctl     /* ioctl    */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , lzfblk_unlink  /* unlink   */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lzfblk_getbe32
+ ****************************************************************************/
+
+static uint32_t lzfblk_getbe32(FAR const uint8_t *ptr)
+{
+  return (uint32_t)ptr[0] << 24 | (uint32_t)ptr[1] << 16 |
+         (uint32_t)ptr[2] << 8 | (uint32_t)ptr[3];
+}
+
+/****************************************************************************
+ * Name: lzfblk_free
+ *
+ * Description: Free the driver and its buffers
+ *
+ ****************************************************************************/
+
+static void lzfblk_free(FAR struct lzfblk_dev_s *dev)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_MTD_LZFBLK_NCACHE; i++)
+    {
+      if (dev->cache[i].data != NULL)
+        {
+          kmm_free(dev->cache[i].data);
+        }
+    }
+
+  if (dev->window != NULL)
+    {
+      kmm_free(dev->window);
+    }
+
+  if (dev->index != NULL)
+    {
+      kmm_free(dev->index);
+    }
+
+  nxsem_destroy(&dev->exclsem);
+  kmm_free(dev);
+}
+
+/****************************************************************************
+ * Name: lzfblk_getbytes
+ *
+ * Description:
+ *   Return the address of nbytes of the image at offset.  If they are not
+ *   in the window, the window is reloaded from offset on.  The load reads
+ *   as much of the following data as fits, which is the read-ahead for the
+ *   next blocks.  Returns NULL on a read error or if the bytes are outside
+ *   of the MTD device.
+ *
+ ****************************************************************************/
+
+static FAR const uint8_t *lzfblk_getbytes(FAR struct lzfblk_dev_s *dev,
+                                          uint32_t offset, uint32_t nbytes)
+{
+  uint32_t start;
+  uint32_t len;
+  ssize_t nread;
+
+  if (offset >= dev->woffset && nbytes <= dev->wlen &&
+      offset - dev->woffset <= dev->wlen - nbytes)
+    {
+      return &dev->window[offset - dev->woffset];
+    }
+
+  if (offset > dev->mtdsize || nbytes > dev->mtdsize - offset)
+    {
+      return NULL;
+    }
+
+  /* Devices without byte reads are read in whole blocks.  The window has
+   * room for two more blocks than the data to allow for the alignment.
+   */
+
+  start = offset;
+  if (dev->mtd->read == NULL)
+    {
+      start -= offset % dev->geo.blocksize;
+    }
+
+  len = dev->mtdsize - start;
+  if (len > dev->wsize)
+    {
+      len = dev->wsize;
+    }
+
+  dev->wlen = 0;
+  if (dev->mtd->read != NULL)
+    {
+      nread = MTD_READ(dev->mtd, start, len, dev->window);
+    }
+  else
+    {
+      len  -= len % dev->geo.blocksize;
+      nread = MTD_BREAD(dev->mtd, start / dev->geo.blocksize,
+                        len / dev->geo.blocksize, dev->window);
+      if (nread > 0)
+        {
+          nread *= dev->geo.blocksize;
+        }
+    }
+
+  if (nread < 0 || (size_t)nread < offset - start + nbytes)
+    {
+      ferr("ERROR: Read of %lu bytes at %lu failed: %d\n",
+           (unsigned long)len, (unsigned long)start, (int)nread);
+      return NULL;
+    }
+
+  dev->woffset = start;
+  dev->wlen    = nread;
+  return &dev->window[offset - start];
+}
+
+/****************************************************************************
+ * Name: lzfblk_getblock
+ *
+ * Description:
+ *   Return the uncompressed data of a block, decompressing it into the
+ *   cache if it is not already there.  Returns NULL on errors.
+ *
+ ****************************************************************************/
+
+static FAR const uint8_t *lzfblk_getblock(FAR struct lzfblk_dev_s *dev,
+                                          uint32_t block)
+{
+  FAR struct lzfblk_cache_s *entry;
+  FAR const uint8_t *src;
+  uint32_t bsize = (uint32_t)1 << dev->bshift;
+  uint32_t offset;
+  uint32_t nbytes;
+  unsigned int ulen;
+  int i;
+
+  for (i = 0; i < CONFIG_MTD_LZFBLK_NCACHE; i++)
+    {
+      if (dev->cache[i].block == block)
+        {
+          return dev->cache[i].data;
+        }
+    }
+
+  /* Replace the oldest entry */
+
+  entry     = &dev->cache[dev->next];
+  dev->next = (dev->next + 1) % CONFIG_MTD_LZFBLK_NCACHE;
+  entry->block = LZFBLK_NOBLOCK;
+
+  offset = dev->index[block];
+  nbytes = dev->index[block + 1] - offset;
+  if (dev->index[block + 1] < offset || nbytes < LZF_MIN_HDR_SIZE ||
+      nbytes > bsize + LZF_MAX_HDR_SIZE)
+    {
+      ferr("ERROR: Bad index entry for block %lu\n", (unsigned long)block);
+      return NULL;
+    }
+
+  src = lzfblk_getbytes(dev, offset, nbytes);
+  if (src == NULL)
+    {
+      return NULL;
+    }
+
+  if (src[0] != 'Z' || src[1] != 'V')
+    {
+      ulen = 0;
+    }
+  else if (src[2] == LZF_TYPE0_HDR)
+    {
+      ulen = (unsigned int)src[3] << 8 | src[4];
+      if (ulen == bsize && nbytes == ulen + LZF_TYPE0_HDR_SIZE)
+        {
+          memcpy(entry->data, &src[LZF_TYPE0_HDR_SIZE], bsize);
+        }
+      else
+        {
+          ulen = 0;
+        }
+    }
+  else if (src[2] == LZF_TYPE1_HDR && nbytes >= LZF_TYPE1_HDR_SIZE)
+    {
+      ulen = lzf_decompress(&src[LZF_TYPE1_HDR_SIZE],
+                            nbytes - LZF_TYPE1_HDR_SIZE,
+                            entry->data, bsize);
+    }
+  else
+    {
+      ulen = 0;
+    }
+
+  if (ulen != bsize)
+    {
+      ferr("ERROR: Bad data in block %lu\n", (unsigned long)block);
+      return NULL;
+    }
+
+  entry->block = block;
+  return entry->data;
+}
+
+/****************************************************************************
+ * Name: lzfblk_open
+ *
+ * Description: Open the block device
+ *
+ ****************************************************************************/
+
+static int lzfblk_open(FAR struct inode *inode)
+{
+  FAR struct lzfblk_dev_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct lzfblk_dev_s *)inode->i_private;
+
+  dev->refs++;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lzfblk_close
+ *
+ * Description: close the block device
+ *
+ ****************************************************************************/
+
+static int lzfblk_close(FAR struct inode *inode)
+{
+  FAR struct lzfblk_dev_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct lzfblk_dev_s *)inode->i_private;
+
+  if (--dev->refs == 0 && dev->unlinked)
+    {
+      lzfblk_free(dev);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: lzfblk_read
+ *
+ * Description:  Read the specified number of sectors
+ *
+ ****************************************************************************/
+
+static ssize_t lzfblk_read(FAR struct inode *inode,
+                           FAR unsigned char *buffer, size_t start_sector,
+                           unsigned int nsectors)
+{
+  FAR struct lzfblk_dev_s *dev;
+  FAR const uint8_t *data;
+  unsigned int sectshift;
+  size_t sector = start_sector;
+  size_t remaining;
+  size_t nsects;
+  uint32_t block;
+  uint32_t first;
+  int ret;
+
+  finfo("sector: %d nsectors: %d\n", start_sector, nsectors);
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct lzfblk_dev_s *)inode->i_private;
+
+  sectshift = dev->bshift - LZFBLK_SECTSHIFT;
+  if (start_sector >= ((size_t)dev->nblocks << sectshift))
+    {
+      return 0;
+    }
+
+  remaining = ((size_t)dev->nblocks << sectshift) - start_sector;
+  if (remaining > nsectors)
+    {
+      remaining = nsectors;
+    }
+
+  ret = nxsem_wait_uninterruptible(&dev->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  while (remaining > 0)
+    {
+      block = sector >> sectshift;
+      first = sector & ((1 << sectshift) - 1);
+
+      data = lzfblk_getblock(dev, block);
+      if (data == NULL)
+        {
+          break;
+        }
+
+      nsects = ((size_t)1 << sectshift) - first;
+      if (nsects > remaining)
+        {
+          nsects = remaining;
+        }
+
+      memcpy(buffer, &data[first << LZFBLK_SECTSHIFT],
+             nsects << LZFBLK_SECTSHIFT);
+
+      buffer    += nsects << LZFBLK_SECTSHIFT;
+      sector    += nsects;
+      remaining -= nsects;
+    }
+
+  nxsem_post(&dev->exclsem);
+
+  if (sector == start_sector)
+    {
+      return -EIO;
+    }
+
+  return sector - start_sector;
+}
+
+/****************************************************************************
+ * Name: lzfblk_geometry
+ *
+ * Description: Return device geometry
+ *
+ ****************************************************************************/
+
+static int lzfblk_geometry(FAR struct inode *inode,
+                           FAR struct geometry *geometry)
+{
+  FAR struct lzfblk_dev_s *dev;
+
+  DEBUGASSERT(inode);
+  if (geometry)
+    {
+      dev = (FAR struct lzfblk_dev_s *)inode->i_private;
+      geometry->geo_available     = true;
+      geometry->geo_mediachanged  = false;
+      geometry->geo_writeenabled  = false;
+      geometry->geo_nsectors      = (blkcnt_t)dev->nblocks <<
+                                    (dev->bshift - LZFBLK_SECTSHIFT);
+      geometry->geo_sectorsize    = LZFBLK_SECTSIZE;
+
+      finfo("nsectors: %d sectorsize: %d\n",
+            geometry->geo_nsectors, geometry->geo_sectorsize);
+
+      return OK;
+    }
+
+  return -EINVAL;
+}
+
+/****************************************************************************
+ * Name: lzfblk_ioctl
+ *
+ * Description: Handle the block driver ioctl commands
+ *
+ ****************************************************************************/
+
+static int lzfblk_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
+{
+  /* The uncompressed data is never directly accessible, so BIOC_XIPBASE
+   * and all of the MTD commands are not supported.
+   */
+
+  return -ENOTTY;
+}
+
+/****************************************************************************
+ * Name: lzfblk_unlink
+ *
+ * Description: Unlink the device
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+static int lzfblk_unlink(FAR struct inode *inode)
+{
+  FAR struct lzfblk_dev_s *dev;
+
+  DEBUGASSERT(inode && inode->i_private);
+  dev = (FAR struct lzfblk_dev_s *)inode->i_private;
+
+  dev->unlinked = true;
+  if (dev->refs == 0)
+    {
+      lzfblk_free(dev);
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lzfblk_initialize_by_path
+ *
+ * Description:
+ *   Initialize a read-only block driver that decompresses an LZF block
+ *   image stored on an MTD device.
+ *
+ * Input Parameters:
+ *   path - The block device path.
+ *   mtd  - The MTD device that holds the image.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int lzfblk_initialize_by_path(FAR const char *path,
+                              FAR struct mtd_dev_s *mtd)
+{
+  FAR struct lzfblk_dev_s *dev;
+  FAR const uint8_t *hdr;
+  uint32_t bsize;
+  uint32_t i;
+  int ret;
+
+  if (path == NULL || mtd == NULL)
+    {
+      return -EINVAL;
+    }
+
+  finfo("path=\"%s\"\n", path);
+
+  dev = (FAR struct lzfblk_dev_s *)kmm_zalloc(sizeof(struct lzfblk_dev_s));
+  if (dev == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  dev->mtd = mtd;
+  nxsem_init(&dev->exclsem, 0, 1);
+
+  ret = MTD_IOCTL(mtd, MTDIOC_GEOMETRY,
+                  (unsigned long)((uintptr_t)&dev->geo));
+  if (ret < 0)
+    {
+      ferr("ERROR: MTD ioctl(MTDIOC_GEOMETRY) failed: %d\n", ret);
+      goto errout;
+    }
+
+  dev->mtdsize = dev->geo.erasesize * dev->geo.neraseblocks;
+
+  /* The window holds the compressed data of CONFIG_MTD_LZFBLK_READAHEAD
+   * blocks of the largest size, plus two MTD blocks for the alignment of
+   * the devices without byte reads.  The header is read through the window
+   * too, so start with enough room for it.
+   */
+
+  dev->wsize  = LZFBLK_HDR_SIZE + 4 + dev->geo.blocksize;
+  dev->window = (FAR uint8_t *)kmm_malloc(dev->wsize);
+  if (dev->window == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  ret = -EINVAL;
+  hdr = lzfblk_getbytes(dev, 0, LZFBLK_HDR_SIZE);
+  if (hdr == NULL || memcmp(hdr, LZFBLK_MAGIC, 4) != 0 ||
+      hdr[4] != LZFBLK_VERSION || hdr[5] < LZFBLK_MIN_BSHIFT ||
+      hdr[5] > LZFBLK_MAX_BSHIFT)
+    {
+      ferr("ERROR: No LZF block image on the device\n");
+      goto errout;
+    }
+
+  dev->bshift  = hdr[5];
+  dev->nblocks = lzfblk_getbe32(&hdr[8]);
+  bsize        = (uint32_t)1 << dev->bshift;
+
+  if (dev->nblocks == 0 ||
+      dev->nblocks > (dev->mtdsize - LZFBLK_HDR_SIZE) / 4 - 1)
+    {
+      ferr("ERROR: Bad number of blocks: %lu\n",
+           (unsigned long)dev->nblocks);
+      goto errout;
+    }
+
+  /* Now resize the window for the blocks */
+
+  kmm_free(dev->window);
+  dev->wsize  = CONFIG_MTD_LZFBLK_READAHEAD * (bsize + LZF_MAX_HDR_SIZE) +
+                2 * dev->geo.blocksize;
+  dev->window = (FAR uint8_t *)kmm_malloc(dev->wsize);
+  dev->wlen   = 0;
+
+  dev->index  = (FAR uint32_t *)
+                kmm_malloc((dev->nblocks + 1) * sizeof(uint32_t));
+  if (dev->window == NULL || dev->index == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  /* Load the index.  Each offset is read through the window, which reads
+   * the index in large pieces.
+   */
+
+  for (i = 0; i <= dev->nblocks; i++)
+    {
+      hdr = lzfblk_getbytes(dev, LZFBLK_HDR_SIZE + 4 * i, 4);
+      if (hdr == NULL)
+        {
+          ret = -EIO;
+          goto errout;
+        }
+
+      dev->index[i] = lzfblk_getbe32(hdr);
+    }
+
+  for (i = 0; i < CONFIG_MTD_LZFBLK_NCACHE; i++)
+    {
+      dev->cache[i].block = LZFBLK_NOBLOCK;
+      dev->cache[i].data  = (FAR uint8_t *)kmm_malloc(bsize);
+      if (dev->cache[i].data == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout;
+        }
+    }
+
+  ret = register_blockdriver(path, &g_bops, 0444, dev);
+  if (ret < 0)
+    {
+      ferr("ERROR: register_blockdriver failed: %d\n", -ret);
+      goto errout;
+    }
+
+  return OK;
+
+errout:
+  lzfblk_free(dev);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: lzfblk_initialize
+ *
+ * Description:
+ *   Initialize a read-only block driver that decompresses an LZF block
+ *   image stored on an MTD device.
+ *
+ * Input Parameters:
+ *   minor - The minor device number.  The block device will be registered
+ *           as /dev/lzfblockN where N is the minor number.
+ *   mtd   - The MTD device that holds the image.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int lzfblk_initialize(int minor, FAR struct mtd_dev_s *mtd)
+{
+  char path[DEV_NAME_MAX];
+
+#ifdef CONFIG_DEBUG_FEATURES
+  /* Sanity check */
+
+  if (minor < 0 || minor > 255)
+    {
+      return -EINVAL;
+    }
+#endif
+
+  snprintf(path, DEV_NAME_MAX, "/dev/lzfblock%d", minor);
+  return lzfblk_initialize_by_path(path, mtd);
+}
+
+#endif /* CONFIG_MTD_LZFBLK */
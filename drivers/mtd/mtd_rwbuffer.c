@@ -303,6 +303,24 @@ static int mtd_ioctl(FAR struct mtd_dev_s *dev, int cmd, unsigned long arg)
         }
         break;
 
+      case BIOC_FLUSH:
+        {
+          /* Write the buffered data to the media, then let the device flush
+           * its own buffers, if it has any.
+           */
+
+          ret = rwb_flush(&priv->rwb);
+          if (ret >= 0)
+            {
+              ret = priv->dev->ioctl(priv->dev, BIOC_FLUSH, 0);
+              if (ret == -ENOTTY)
+                {
+                  ret = OK;
+                }
+            }
+        }
+        break;
+
       case MTDIOC_XIPBASE:
       default:
         ret = -ENOTTY; /* Bad command */
@@ -318,20 +336,25 @@ static int mtd_ioctl(FAR struct mtd_dev_s *dev, int cmd, unsigned long arg)
  ************************************************************************************/
 
 /************************************************************************************
- * Name: mtd_rwb_initialize
+ * Name: mtd_rwb_initialize_nblocks
  *
  * Description:
- *   Create an initialized MTD device instance.  This MTD driver contains another
- *   MTD driver and converts a larger sector size to a standard 512 byte sector
- *   size.
+ *   Create an initialized MTD device instance like mtd_rwb_initialize(), but
+ *   with the given buffer sizes instead of CONFIG_MTD_NWRBLOCKS and
+ *   CONFIG_MTD_NRDBLOCKS.  This allows each partition of a FLASH part to be
+ *   buffered according to the file system on it.
  *
- *   MTD devices are not registered in the file system, but are created as instances
- *   that can be bound to other functions (such as a block or character driver front
- *   end).
+ * Input Parameters:
+ *   mtd       - The MTD device to be buffered (for example, a partition)
+ *   nwrblocks - The number of blocks in the write buffer (zero disables)
+ *   nrdblocks - The number of blocks in the read-ahead buffer (zero
+ *               disables)
  *
  ************************************************************************************/
 
-FAR struct mtd_dev_s *mtd_rwb_initialize(FAR struct mtd_dev_s *mtd)
+FAR struct mtd_dev_s *mtd_rwb_initialize_nblocks(FAR struct mtd_dev_s *mtd,
+                                                 uint16_t nwrblocks,
+                                                 uint16_t nrdblocks)
 {
   FAR struct mtd_rwbuffer_s *priv;
   struct mtd_geometry_s geo;
@@ -392,10 +415,14 @@ FAR struct mtd_dev_s *mtd_rwb_initialize(FAR struct mtd_dev_s *mtd)
   /* Buffer setup */
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-  priv->rwb.wrmaxblocks = CONFIG_MTD_NWRBLOCKS;
+  priv->rwb.wrmaxblocks = nwrblocks;
+#else
+  UNUSED(nwrblocks);
 #endif
 #ifdef CONFIG_DRVR_READAHEAD
-  priv->rwb.rhmaxblocks = CONFIG_MTD_NRDBLOCKS;
+  priv->rwb.rhmaxblocks = nrdblocks;
+#else
+  UNUSED(nrdblocks);
 #endif
 
   /* Callouts */
@@ -419,4 +446,24 @@ FAR struct mtd_dev_s *mtd_rwb_initialize(FAR struct mtd_dev_s *mtd)
   return &priv->mtd;
 }
 
+/************************************************************************************
+ * Name: mtd_rwb_initialize
+ *
+ * Description:
+ *   Create an initialized MTD device instance.  This MTD driver contains another
+ *   MTD driver and converts a larger sector size to a standard 512 byte sector
+ *   size.
+ *
+ *   MTD devices are not registered in the file system, but are created as instances
+ *   that can be bound to other functions (such as a block or character driver front
+ *   end).
+ *
+ ************************************************************************************/
+
+FAR struct mtd_dev_s *mtd_rwb_initialize(FAR struct mtd_dev_s *mtd)
+{
+  return mtd_rwb_initialize_nblocks(mtd, CONFIG_MTD_NWRBLOCKS,
+                                    CONFIG_MTD_NRDBLOCKS);
+}
+
 #endif /* CONFIG_DRVR_WRITEBUFFER || CONFIG_DRVR_READAHEAD */
@@ -53,6 +53,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/signal.h>
 #include <nuttx/fs/ioctl.h>
@@ -247,6 +248,11 @@ struct mx25l_dev_s
   uint16_t              esectno;     /* Erase sector number in the cache */
   FAR uint8_t          *sector;      /* Allocated sector data */
 #endif
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  bool                  erasing;     /* True: A sector erase is in progress */
+  off_t                 eraseaddr;   /* Address of the sector being erased */
+  clock_t               resumed;     /* Time when the erase was last resumed */
+#endif
 };
 
 /************************************************************************************
@@ -261,6 +267,12 @@ static inline int mx25l_readid(FAR struct mx25l_dev_s *priv);
 static void mx25l_waitwritecomplete(FAR struct mx25l_dev_s *priv);
 static void mx25l_writeenable(FAR struct mx25l_dev_s *priv);
 static void mx25l_writedisable(FAR struct mx25l_dev_s *priv);
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+static uint8_t mx25l_rdsr(FAR struct mx25l_dev_s *priv);
+static bool mx25l_erasesuspend(FAR struct mx25l_dev_s *priv, off_t address,
+                               size_t nbytes);
+static void mx25l_eraseresume(FAR struct mx25l_dev_s *priv);
+#endif
 static inline void mx25l_sectorerase(FAR struct mx25l_dev_s *priv, off_t offset);
 static inline int  mx25l_chiperase(FAR struct mx25l_dev_s *priv);
 static void mx25l_byteread(FAR struct mx25l_dev_s *priv, FAR uint8_t *buffer,
@@ -489,6 +501,97 @@ static void mx25l_writedisable(FAR struct mx25l_dev_s *priv)
   mxlinfo("Disabled\n");
 }
 
+/************************************************************************************
+ * Name: mx25l_rdsr
+ ************************************************************************************/
+
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+static uint8_t mx25l_rdsr(FAR struct mx25l_dev_s *priv)
+{
+  uint8_t status;
+
+  SPI_SELECT(priv->dev, SPIDEV_FLASH(0), true);
+  SPI_SEND(priv->dev, MX25L_RDSR);
+  status = SPI_SEND(priv->dev, MX25L_DUMMY);
+  SPI_SELECT(priv->dev, SPIDEV_FLASH(0), false);
+
+  return status;
+}
+#endif
+
+/************************************************************************************
+ * Name: mx25l_erasesuspend
+ *
+ * Description:
+ *   Suspend a sector erase that is still in progress so that 'nbytes' at
+ *   'address' can be read.  The task that erases the sector waits for the
+ *   erase to complete with the SPI bus unlocked, so this happens when another
+ *   task reads from the FLASH in the meantime.  A suspended erase must be
+ *   resumed with mx25l_eraseresume() after the read.
+ *
+ * Returned Value:
+ *   True if the erase was suspended.  False if there is no erase that can be
+ *   suspended; the caller must then wait for the device as usual.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+static bool mx25l_erasesuspend(FAR struct mx25l_dev_s *priv, off_t address,
+                               size_t nbytes)
+{
+  /* Data in the sector being erased cannot be read while the erase is
+   * suspended.  And the erase is not suspended again within the clock tick
+   * that it was resumed in:  Back-to-back reads would starve it otherwise.
+   */
+
+  if (!priv->erasing ||
+      (address < priv->eraseaddr + (1 << priv->sectorshift) &&
+       address + (off_t)nbytes > priv->eraseaddr) ||
+      clock_systime_ticks() == priv->resumed)
+    {
+      return false;
+    }
+
+  if ((mx25l_rdsr(priv) & MX25L_SR_WIP) == 0)
+    {
+      /* The erase has already completed */
+
+      return false;
+    }
+
+  /* Send the "Erase Suspend" instruction.  This is ignored if the erase
+   * completed in the meantime, as is the "Erase Resume" instruction later.
+   */
+
+  SPI_SELECT(priv->dev, SPIDEV_FLASH(0), true);
+  SPI_SEND(priv->dev, MX25L_ERS_SUSPEND);
+  SPI_SELECT(priv->dev, SPIDEV_FLASH(0), false);
+
+  /* The device is ready for reads within a few tens of microseconds */
+
+  while ((mx25l_rdsr(priv) & MX25L_SR_WIP) != 0);
+
+  return true;
+}
+#endif
+
+/************************************************************************************
+ * Name: mx25l_eraseresume
+ ************************************************************************************/
+
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+static void mx25l_eraseresume(FAR struct mx25l_dev_s *priv)
+{
+  /* Send the "Erase Resume" instruction */
+
+  SPI_SELECT(priv->dev, SPIDEV_FLASH(0), true);
+  SPI_SEND(priv->dev, MX25L_ERS_RESUME);
+  SPI_SELECT(priv->dev, SPIDEV_FLASH(0), false);
+
+  priv->resumed = clock_systime_ticks();
+}
+#endif
+
 /************************************************************************************
  * Name:  mx25l_sectorerase (4k)
  ************************************************************************************/
@@ -544,8 +647,17 @@ static void mx25l_sectorerase(FAR struct mx25l_dev_s *priv, off_t sector)
 
   SPI_SELECT(priv->dev, SPIDEV_FLASH(0), false);
 
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  priv->eraseaddr = offset;
+  priv->erasing   = true;
+#endif
+
   mx25l_waitwritecomplete(priv);
 
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  priv->erasing   = false;
+#endif
+
   mxlinfo("Erased\n");
 }
 
@@ -586,15 +698,27 @@ static inline int mx25l_chiperase(FAR struct mx25l_dev_s *priv)
 static void mx25l_byteread(FAR struct mx25l_dev_s *priv, FAR uint8_t *buffer,
                            off_t address, size_t nbytes)
 {
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  bool suspended;
+#endif
+
   mxlinfo("address: %08lx nbytes: %d\n", (long)address, (int)nbytes);
 
-  /* Wait for any preceding write or erase operation to complete. */
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  /* Suspend a sector erase in progress rather than waiting for it */
 
-  mx25l_waitwritecomplete(priv);
+  suspended = mx25l_erasesuspend(priv, address, nbytes);
+  if (!suspended)
+#endif
+    {
+      /* Wait for any preceding write or erase operation to complete. */
+
+      mx25l_waitwritecomplete(priv);
 
-  /* Make sure that writing is disabled */
+      /* Make sure that writing is disabled */
 
-  mx25l_writedisable(priv);
+      mx25l_writedisable(priv);
+    }
 
   /* Select this FLASH part */
 
@@ -639,6 +763,13 @@ static void mx25l_byteread(FAR struct mx25l_dev_s *priv, FAR uint8_t *buffer,
   /* Deselect the FLASH */
 
   SPI_SELECT(priv->dev, SPIDEV_FLASH(0), false);
+
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  if (suspended)
+    {
+      mx25l_eraseresume(priv);
+    }
+#endif
 }
 
 /************************************************************************************
@@ -58,7 +58,10 @@
 #include <crc32.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/mtd/mtd.h>
@@ -131,6 +134,18 @@
 #  define SMART_HAVE_RWBUFFER 1
 #endif
 
+/* The background garbage collection runs concurrently with the file system
+ * so the device must be locked.
+ */
+
+#ifdef CONFIG_MTD_SMART_BGGC
+#  define smart_lock(d)   nxsem_wait_uninterruptible(&(d)->exclsem)
+#  define smart_unlock(d) nxsem_post(&(d)->exclsem)
+#else
+#  define smart_lock(d)
+#  define smart_unlock(d)
+#endif
+
 #ifndef CONFIG_MTD_SMART_SECTOR_SIZE
 #  define CONFIG_MTD_SMART_SECTOR_SIZE 1024
 #endif
@@ -241,6 +256,16 @@ struct smart_struct_s
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
   uint32_t              unusedsectors;    /* Count of unused sectors (i.e. free when erased) */
   uint32_t              blockerases;      /* Count of unused sectors (i.e. free when erased) */
+  uint32_t              gccollects;       /* Blocks collected by writes */
+  uint32_t              gcticks;          /* Time of the collections by writes */
+  uint32_t              gcmaxticks;       /* Longest collection by a write */
+#ifdef CONFIG_MTD_SMART_BGGC
+  uint32_t              bgcollects;       /* Blocks collected in background */
+#endif
+#endif
+#ifdef CONFIG_MTD_SMART_BGGC
+  sem_t                 exclsem;          /* Exclusive access to the device */
+  struct work_s         bgwork;           /* Background garbage collection */
 #endif
   uint16_t              neraseblocks;     /* Number of erase blocks or sub-sectors */
   uint16_t              lastallocblock;   /* Last  block we allocated a sector from */
@@ -893,6 +918,7 @@ static ssize_t smart_read(FAR struct inode *inode, unsigned char *buffer,
                           size_t start_sector, unsigned int nsectors)
 {
   FAR struct smart_struct_s *dev;
+  ssize_t ret;
 
   finfo("SMART: sector: %d nsectors: %d\n", start_sector, nsectors);
 
@@ -902,7 +928,11 @@ static ssize_t smart_read(FAR struct inode *inode, unsigned char *buffer,
 #else
   dev = (struct smart_struct_s *)inode->i_private;
 #endif
-  return smart_reload(dev, buffer, start_sector, nsectors);
+
+  smart_lock(dev);
+  ret = smart_reload(dev, buffer, start_sector, nsectors);
+  smart_unlock(dev);
+  return ret;
 }
 
 /****************************************************************************
@@ -939,7 +969,7 @@ static ssize_t smart_write(FAR struct inode *inode,
   dev = (FAR struct smart_struct_s *)inode->i_private;
 #endif
 
-  /* I think maybe we need to lock on a mutex here */
+  smart_lock(dev);
 
   /* Get the aligned block.  Here is is assumed: (1) The number of R/W blocks
    * per erase block is a power of 2, and (2) the erase begins with that same
@@ -978,9 +1008,7 @@ static ssize_t smart_write(FAR struct inode *inode,
           if (ret < 0)
             {
               ferr("ERROR: Erase block=%d failed: %d\n", eraseblock, ret);
-
-              /* Unlock the mutex if we add one */
-
+              smart_unlock(dev);
               return ret;
             }
         }
@@ -1007,9 +1035,7 @@ static ssize_t smart_write(FAR struct inode *inode,
           /* The block is not empty!!  What to do? */
 
           ferr("ERROR: Write block %d failed: %d.\n", nextblock, nxfrd);
-
-          /* Unlock the mutex if we add one */
-
+          smart_unlock(dev);
           return -EIO;
         }
 
@@ -1021,6 +1047,7 @@ static ssize_t smart_write(FAR struct inode *inode,
       alignedblock += mtdblkspererase;
     }
 
+  smart_unlock(dev);
   return nsectors;
 }
 
@@ -3989,6 +4016,10 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
 #ifdef CONFIG_MTD_SMART_PACK_COUNTS
   uint8_t   count;
 #endif
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+  clock_t   start;
+  uint32_t  elapsed;
+#endif
 
   while (collect)
     {
@@ -4080,8 +4111,24 @@ static int smart_garbagecollect(FAR struct smart_struct_s *dev)
 
           /* Relocate the active data in the collection block */
 
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+          start = clock_systime_ticks();
+#endif
+
           ret = smart_relocate_block(dev, collectblock);
 
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+          /* Keep track of the time the writes have to wait */
+
+          elapsed = clock_systime_ticks() - start;
+          dev->gccollects++;
+          dev->gcticks += elapsed;
+          if (elapsed > dev->gcmaxticks)
+            {
+              dev->gcmaxticks = elapsed;
+            }
+#endif
+
 #ifdef CONFIG_SMART_LOCAL_CHECKFREE
           if (smart_checkfree(dev, __LINE__) != OK)
             {
@@ -5433,6 +5480,119 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: smart_bggc_worker
+ *
+ * Description: Collect one erase block with many released sectors while
+ *              the device is idle.  This is repeated until no block needs
+ *              to be collected or until the device is accessed again.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_BGGC
+static void smart_bggc_worker(FAR void *arg)
+{
+  FAR struct smart_struct_s *dev = (FAR struct smart_struct_s *)arg;
+  uint16_t collectblock = 0xffff;
+  uint16_t releasemin;
+  uint16_t releasemax = 0;
+  uint16_t released;
+  uint16_t active;
+  int x;
+
+  /* Don't wait for the file system.  Its next access re-queues the work. */
+
+  if (nxsem_trywait(&dev->exclsem) < 0)
+    {
+      return;
+    }
+
+  if (dev->formatstatus != SMART_FMT_STAT_FORMATTED ||
+      dev->freesectors >= (uint32_t)dev->totalsectors *
+                          CONFIG_MTD_SMART_BGGC_FREE / 100)
+    {
+      goto out;
+    }
+
+  /* Find the block with the most released sectors above the threshold */
+
+  releasemin = (dev->sectorsperblk * CONFIG_MTD_SMART_BGGC_RELEASED + 99) /
+               100;
+
+  for (x = 0; x < dev->neraseblocks; x++)
+    {
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+      /* Don't collect blocks that have been worn completely */
+
+      if (smart_get_wear_level(dev, x) >= SMART_WEAR_REORG_THRESHOLD)
+        {
+          continue;
+        }
+#endif
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+      released = smart_get_count(dev, dev->releasecount, x);
+#else
+      released = dev->releasecount[x];
+#endif
+
+      if (released >= releasemin && released > releasemax)
+        {
+          releasemax   = released;
+          collectblock = x;
+        }
+    }
+
+  if (collectblock == 0xffff)
+    {
+      goto out;
+    }
+
+  /* The active sectors are moved to free sectors in other blocks.  Leave
+   * the reserve needed by the garbage collection of the writes alone.
+   */
+
+#ifdef CONFIG_MTD_SMART_PACK_COUNTS
+  active = dev->availsectperblk - releasemax -
+           smart_get_count(dev, dev->freecount, collectblock);
+#else
+  active = dev->availsectperblk - releasemax -
+           dev->freecount[collectblock];
+#endif
+
+  if (dev->freesectors < active + dev->sectorsperblk + 4)
+    {
+      goto out;
+    }
+
+  finfo("Background collect block %d, released=%d\n",
+        collectblock, releasemax);
+
+  if (smart_relocate_block(dev, collectblock) < 0)
+    {
+      goto out;
+    }
+
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+  dev->bgcollects++;
+#endif
+
+#ifdef CONFIG_MTD_SMART_WEAR_LEVEL
+  if (dev->wearflags & SMART_WEARFLAGS_WRITE_NEEDED)
+    {
+      smart_write_wearstatus(dev);
+    }
+#endif
+
+  /* Look for the next block right away */
+
+  work_queue(LPWORK, &dev->bgwork, smart_bggc_worker, dev, 0);
+
+out:
+  smart_unlock(dev);
+}
+#endif /* CONFIG_MTD_SMART_BGGC */
+
 /****************************************************************************
  * Name: smart_ioctl
  *
@@ -5458,6 +5618,8 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
   dev = (FAR struct smart_struct_s *)inode->i_private;
 #endif
 
+  smart_lock(dev);
+
   /* Process the ioctl's we care about first, pass any we don't respond
    * to directly to the underlying MTD device.
    */
@@ -5474,7 +5636,8 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
       if (arg == 0)
         {
           ferr("ERROR: BIOC_XIPBASE argument is NULL\n");
-          return -EINVAL;
+          ret = -EINVAL;
+          goto ok_out;
         }
 #endif
 
@@ -5582,6 +5745,12 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 #endif
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
       procfs_data->uneven_wearcount = dev->uneven_wearcount;
+#endif
+      procfs_data->gccollects     = dev->gccollects;
+      procfs_data->gctime         = TICK2MSEC(dev->gcticks);
+      procfs_data->gcmaxtime      = TICK2MSEC(dev->gcmaxticks);
+#ifdef CONFIG_MTD_SMART_BGGC
+      procfs_data->bgcollects     = dev->bgcollects;
 #endif
       ret = OK;
       goto ok_out;
@@ -5616,6 +5785,17 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
     }
 
 ok_out:
+#ifdef CONFIG_MTD_SMART_BGGC
+  /* (Re-)start the idle time before the background garbage collection */
+
+  if (dev->releasesectors > 0)
+    {
+      work_queue(LPWORK, &dev->bgwork, smart_bggc_worker, dev,
+                 MSEC2TICK(CONFIG_MTD_SMART_BGGC_DELAY));
+    }
+#endif
+
+  smart_unlock(dev);
   return ret;
 }
 
@@ -6151,6 +6331,9 @@ int smart_initialize(int minor, FAR struct mtd_dev_s *mtd,
       /* Initialize the SMART device structure */
 
       dev->mtd = mtd;
+#ifdef CONFIG_MTD_SMART_BGGC
+      nxsem_init(&dev->exclsem, 0, 1);
+#endif
 
       /* Get the device geometry. (casting to uintptr_t first eliminates
        * complaints on some architectures where the sizeof long is different
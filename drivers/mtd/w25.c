@@ -37,6 +37,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/signal.h>
 #include <nuttx/fs/ioctl.h>
@@ -83,6 +84,8 @@
 #define W25_PURDID                 0xab    /* Release PD, Device ID                 */
 #define W25_RDMFID                 0x90    /* Read Manufacturer / Device            */
 #define W25_JEDEC_ID               0x9f    /* JEDEC ID read                         */
+#define W25_ES                     0x75    /* Erase suspend (W25Q only)             */
+#define W25_ER                     0x7a    /* Erase resume (W25Q only)              */
 
 /* W25 Registers ********************************************************************/
 
@@ -218,6 +221,12 @@ struct w25_dev_s
   uint16_t              nsectors;    /* Number of erase sectors */
   uint8_t               prev_instr;  /* Previous instruction given to W25 device */
 
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  bool                  suspend;     /* True: Erase suspend is supported */
+  off_t                 eraseaddr;   /* Address of the last sector erased */
+  clock_t               resumed;     /* Time when the erase was last resumed */
+#endif
+
 #if defined(CONFIG_W25_SECTOR512) && !defined(CONFIG_W25_READONLY)
   uint8_t               flags;       /* Buffered sector flags */
   uint16_t              esectno;     /* Erase sector number in the cache*/
@@ -240,6 +249,12 @@ static void w25_unprotect(FAR struct w25_dev_s *priv);
 static uint8_t w25_waitwritecomplete(FAR struct w25_dev_s *priv);
 static inline void w25_wren(FAR struct w25_dev_s *priv);
 static inline void w25_wrdi(FAR struct w25_dev_s *priv);
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+static uint8_t w25_rdsr(FAR struct w25_dev_s *priv);
+static bool w25_erasesuspend(FAR struct w25_dev_s *priv, off_t address,
+                             size_t nbytes);
+static void w25_eraseresume(FAR struct w25_dev_s *priv);
+#endif
 static bool w25_is_erased(struct w25_dev_s *priv, off_t address, off_t size);
 static void w25_sectorerase(FAR struct w25_dev_s *priv, off_t offset);
 static inline int w25_chiperase(FAR struct w25_dev_s *priv);
@@ -365,6 +380,12 @@ static inline int w25_readid(struct w25_dev_s *priv)
        memory == W25Q_JEDEC_MEMORY_TYPE_B ||
        memory == W25Q_JEDEC_MEMORY_TYPE_C))
     {
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+      /* Only the W25Q parts support erase suspend and resume */
+
+      priv->suspend = (memory != W25X_JEDEC_MEMORY_TYPE);
+#endif
+
       /* Okay.. is it a FLASH capacity that we understand? If so, save
        * the FLASH capacity.
        */
@@ -564,6 +585,98 @@ static inline void w25_wrdi(struct w25_dev_s *priv)
   SPI_SELECT(priv->spi, SPIDEV_FLASH(0), false);
 }
 
+/************************************************************************************
+ * Name: w25_rdsr
+ ************************************************************************************/
+
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+static uint8_t w25_rdsr(FAR struct w25_dev_s *priv)
+{
+  uint8_t status;
+
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), true);
+  SPI_SEND(priv->spi, W25_RDSR);
+  status = SPI_SEND(priv->spi, W25_DUMMY);
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), false);
+
+  return status;
+}
+#endif
+
+/************************************************************************************
+ * Name: w25_erasesuspend
+ *
+ * Description:
+ *   Suspend a sector erase that is still in progress so that 'nbytes' at
+ *   'address' can be read.  A suspended erase must be resumed with
+ *   w25_eraseresume() after the read.
+ *
+ * Returned Value:
+ *   True if the erase was suspended.  False if there is no erase that can be
+ *   suspended; the caller must then wait for the device as usual.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+static bool w25_erasesuspend(FAR struct w25_dev_s *priv, off_t address,
+                             size_t nbytes)
+{
+  /* Data in the sector being erased cannot be read while the erase is
+   * suspended.  And the erase is not suspended again within the clock tick
+   * that it was resumed in:  Back-to-back reads would starve it otherwise.
+   */
+
+  if (!priv->suspend || priv->prev_instr != W25_SE ||
+      (address < priv->eraseaddr + W25_SECTOR_SIZE &&
+       address + (off_t)nbytes > priv->eraseaddr) ||
+      clock_systime_ticks() == priv->resumed)
+    {
+      return false;
+    }
+
+  if ((w25_rdsr(priv) & W25_SR_BUSY) == 0)
+    {
+      /* The erase has already completed */
+
+      return false;
+    }
+
+  /* Send the "Erase Suspend (ES)" instruction.  This is ignored if the erase
+   * completed in the meantime, as is the "Erase Resume" instruction later.
+   */
+
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), true);
+  SPI_SEND(priv->spi, W25_ES);
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), false);
+
+  /* The device is ready for reads within a few tens of microseconds */
+
+  while ((w25_rdsr(priv) & W25_SR_BUSY) != 0);
+
+  return true;
+}
+#endif
+
+/************************************************************************************
+ * Name: w25_eraseresume
+ ************************************************************************************/
+
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+static void w25_eraseresume(FAR struct w25_dev_s *priv)
+{
+  /* Send the "Erase Resume (ER)" instruction */
+
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), true);
+  SPI_SEND(priv->spi, W25_ER);
+  SPI_SELECT(priv->spi, SPIDEV_FLASH(0), false);
+
+  /* The erase is in progress again */
+
+  priv->prev_instr = W25_SE;
+  priv->resumed    = clock_systime_ticks();
+}
+#endif
+
 /************************************************************************************
  * Name:  w25_is_erased
  ************************************************************************************/
@@ -648,6 +761,9 @@ static void w25_sectorerase(struct w25_dev_s *priv, off_t sector)
 
   SPI_SEND(priv->spi, W25_SE);
   priv->prev_instr = W25_SE;
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  priv->eraseaddr  = address;
+#endif
 
   /* Send the sector address high byte first. Only the most significant bits (those
    * corresponding to the sector) have any meaning.
@@ -702,17 +818,28 @@ static void w25_byteread(FAR struct w25_dev_s *priv, FAR uint8_t *buffer,
                            off_t address, size_t nbytes)
 {
   uint8_t status;
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  bool suspended;
+#endif
 
   finfo("address: %08lx nbytes: %d\n", (long)address, (int)nbytes);
 
-  /* Wait for any preceding write or erase operation to complete. */
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  /* Suspend a sector erase in progress rather than waiting for it */
 
-  status = w25_waitwritecomplete(priv);
-  DEBUGASSERT((status & (W25_SR_WEL | W25_SR_BP_MASK)) == 0);
+  suspended = w25_erasesuspend(priv, address, nbytes);
+  if (!suspended)
+#endif
+    {
+      /* Wait for any preceding write or erase operation to complete. */
 
-  /* Make sure that writing is disabled */
+      status = w25_waitwritecomplete(priv);
+      DEBUGASSERT((status & (W25_SR_WEL | W25_SR_BP_MASK)) == 0);
 
-  w25_wrdi(priv);
+      /* Make sure that writing is disabled */
+
+      w25_wrdi(priv);
+    }
 
   /* Select this FLASH part */
 
@@ -747,6 +874,13 @@ static void w25_byteread(FAR struct w25_dev_s *priv, FAR uint8_t *buffer,
   /* Deselect the FLASH */
 
   SPI_SELECT(priv->spi, SPIDEV_FLASH(0), false);
+
+#ifdef CONFIG_MTD_ERASE_SUSPEND
+  if (suspended)
+    {
+      w25_eraseresume(priv);
+    }
+#endif
 }
 
 /************************************************************************************
@@ -96,6 +96,7 @@ struct lo_driver_s
 {
   bool lo_bifup;               /* true:ifup false:ifdown */
   bool lo_txdone;              /* One RX packet was looped back */
+  bool lo_polling;             /* The device is being polled */
   WDOG_ID lo_polldog;          /* TX poll timer */
   struct work_s lo_work;       /* For deferring poll work to the work queue */
 
@@ -234,7 +235,8 @@ static void lo_poll_work(FAR void *arg)
   /* Perform the poll */
 
   net_lock();
-  priv->lo_txdone = false;
+  priv->lo_polling = true;
+  priv->lo_txdone  = false;
   devif_timer(&priv->lo_dev, LO_WDDELAY, lo_txpoll);
 
   /* Was something received and looped back? */
@@ -247,6 +249,8 @@ static void lo_poll_work(FAR void *arg)
       devif_poll(&priv->lo_dev, lo_txpoll);
     }
 
+  priv->lo_polling = false;
+
   /* Setup the watchdog poll timer again */
 
   wd_start(priv->lo_polldog, LO_WDDELAY, lo_poll_expiry, 1, priv);
@@ -357,7 +361,8 @@ static int lo_ifdown(FAR struct net_driver_s *dev)
  * Name: lo_txavail_work
  *
  * Description:
- *   Perform an out-of-cycle poll on the worker thread.
+ *   Perform an out-of-cycle poll on the worker thread or, with
+ *   CONFIG_NET_LOOPBACK_DIRECT, on the thread that sent the data.
  *
  * Input Parameters:
  *   arg - Reference to the NuttX driver state structure (cast to void*)
@@ -377,8 +382,19 @@ static void lo_txavail_work(FAR void *arg)
   /* Ignore the notification if the interface is not yet up */
 
   net_lock();
-  if (priv->lo_bifup)
+  if (priv->lo_polling)
+    {
+      /* The notification comes from within a poll of this device, for
+       * example from the TCP callback of a connection.  The single packet
+       * buffer is in use, so just let that poll run once more.
+       */
+
+      priv->lo_txdone = true;
+    }
+  else if (priv->lo_bifup)
     {
+      priv->lo_polling = true;
+
       do
         {
           /* If so, then poll the network for new XMIT data */
@@ -387,6 +403,8 @@ static void lo_txavail_work(FAR void *arg)
           devif_poll(&priv->lo_dev, lo_txpoll);
         }
       while (priv->lo_txdone);
+
+      priv->lo_polling = false;
     }
 
   net_unlock();
@@ -415,6 +433,18 @@ static int lo_txavail(FAR struct net_driver_s *dev)
 {
   FAR struct lo_driver_s *priv = (FAR struct lo_driver_s *)dev->d_private;
 
+#ifdef CONFIG_NET_LOOPBACK_DIRECT
+  /* Poll right away on the caller's thread.  The network lock is
+   * recursive, so this also works while the caller holds it.
+   */
+
+  if (!up_interrupt_context())
+    {
+      lo_txavail_work(priv);
+      return OK;
+    }
+#endif
+
   /* Is our single work structure available?  It may not be if there are
    * pending interrupt actions and we will have to ignore the Tx
    * availability action.
@@ -523,6 +553,14 @@ int localhost_initialize(void)
   priv->lo_dev.d_buf     = g_iobuffer;   /* Attach the IO buffer */
   priv->lo_dev.d_private = (FAR void *)priv; /* Used to recover private state from dev */
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* The packets never leave memory, so there is nothing that checksums
+   * could protect against.
+   */
+
+  priv->lo_dev.d_features = NETDEV_FEATURE_TXCSUM | NETDEV_FEATURE_RXCSUM;
+#endif
+
   /* Create a watchdog for timing polling for and timing of transmissions */
 
   priv->lo_polldog       = wd_create();  /* Create periodic poll timer */
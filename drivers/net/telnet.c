@@ -1261,7 +1261,7 @@ static int telnet_poll(FAR struct file *filep, FAR struct pollfd *fds,
       fds->revents |= (POLLRDNORM & fds->events);
       if (fds->revents)
         {
-          nxsem_post(fds->sem);
+          poll_notify(fds);
         }
     }
 
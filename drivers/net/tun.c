@@ -65,6 +65,7 @@
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ethernet.h>
 #include <nuttx/net/tun.h>
+#include <nuttx/fs/fs.h>
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_TUN)
 
@@ -312,7 +313,7 @@ static void tun_pollnotify(FAR struct tun_device_s *priv,
   if (eventset != 0)
     {
       fds->revents |= eventset;
-      nxsem_post(fds->sem);
+      poll_notify(fds);
     }
 }
 
@@ -108,7 +108,7 @@ static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev,
           if (fds->revents != 0)
             {
               finfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
@@ -396,6 +396,7 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
   FAR uint8_t           *start  = (FAR uint8_t *)buffer;
 #endif
   ssize_t                nread  = 0;
+  size_t                 nbytes;
   int                    sval;
   int                    ret;
 
@@ -455,18 +456,37 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
         }
     }
 
-  /* Then return whatever is available in the pipe (which is at least one byte) */
+  /* Then return whatever is available in the pipe (which is at least one
+   * byte).  This takes at most two copies:  Up to the end of the circular
+   * buffer and then from its beginning.
+   */
 
   nread = 0;
   while ((size_t)nread < len && dev->d_wrndx != dev->d_rdndx)
     {
-      *buffer++ = dev->d_buffer[dev->d_rdndx];
-      if (++dev->d_rdndx >= dev->d_bufsize)
+      if (dev->d_wrndx > dev->d_rdndx)
         {
-          dev->d_rdndx = 0;
+          nbytes = dev->d_wrndx - dev->d_rdndx;
+        }
+      else
+        {
+          nbytes = dev->d_bufsize - dev->d_rdndx;
+        }
+
+      if (nbytes > len - nread)
+        {
+          nbytes = len - nread;
         }
 
-      nread++;
+      memcpy(buffer, &dev->d_buffer[dev->d_rdndx], nbytes);
+      buffer += nbytes;
+      nread  += nbytes;
+
+      dev->d_rdndx += nbytes;
+      if (dev->d_rdndx >= dev->d_bufsize)
+        {
+          dev->d_rdndx = 0;
+        }
     }
 
   /* Notify all waiting writers that bytes have been removed from the buffer */
@@ -496,6 +516,7 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
   FAR struct pipe_dev_s *dev      = inode->i_private;
   ssize_t                nwritten = 0;
   ssize_t                last;
+  size_t                 nbytes;
   int                    nxtwrndx;
   int                    sval;
   int                    ret;
@@ -553,26 +574,51 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer,
   last = 0;
   for (; ; )
     {
-      /* Calculate the write index AFTER the next byte is written */
+      /* Calculate the number of bytes that can be copied without
+       * overflowing the circular buffer or wrapping around.  One byte
+       * always remains free to distinguish a full from an empty buffer.
+       */
 
-      nxtwrndx = dev->d_wrndx + 1;
-      if (nxtwrndx >= dev->d_bufsize)
+      if (dev->d_wrndx >= dev->d_rdndx)
         {
-          nxtwrndx = 0;
+          nbytes = dev->d_bufsize - dev->d_wrndx;
+          if (dev->d_rdndx == 0)
+            {
+              nbytes--;
+            }
+        }
+      else
+        {
+          nbytes = dev->d_rdndx - dev->d_wrndx - 1;
         }
 
       /* Would the next write overflow the circular buffer? */
 
-      if (nxtwrndx != dev->d_rdndx)
+      if (nbytes > 0)
         {
-          /* No... copy the byte */
+          /* No... copy the bytes */
+
+          if (nbytes > len - nwritten)
+            {
+              nbytes = len - nwritten;
+            }
+
+          memcpy(&dev->d_buffer[dev->d_wrndx], buffer, nbytes);
+          buffer   += nbytes;
+          nwritten += nbytes;
+
+          /* Calculate the write index AFTER the bytes are written */
+
+          nxtwrndx = dev->d_wrndx + nbytes;
+          if (nxtwrndx >= dev->d_bufsize)
+            {
+              nxtwrndx = 0;
+            }
 
-          dev->d_buffer[dev->d_wrndx] = *buffer++;
           dev->d_wrndx = nxtwrndx;
 
           /* Is the write complete? */
 
-          nwritten++;
           if ((size_t)nwritten >= len)
             {
               /* Yes.. Notify all of the waiting readers that more data is available */
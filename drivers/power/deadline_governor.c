@@ -0,0 +1,160 @@
+/****************************************************************************
+ * drivers/power/deadline_governor.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/wdog.h>
+#include <nuttx/power/pm.h>
+
+#include "deadline_governor.h"
+#include "pm.h"
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The cost of entering one power state */
+
+struct deadline_state_s
+{
+  uint32_t latency;    /* Time to resume normal operation (usec) */
+  uint32_t residency;  /* Shortest worthwhile time in the state (usec) */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* PM governor methods */
+
+static enum pm_state_e deadline_governor_checkstate(int domain);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct pm_governor_s g_deadline_governor_ops =
+{
+  .initialize   = NULL,                         /* initialize */
+  .statechanged = NULL,                         /* statechanged */
+  .checkstate   = deadline_governor_checkstate, /* checkstate */
+  .activity     = NULL,                         /* activity */
+};
+
+static const struct deadline_state_s g_deadline_states[PM_COUNT] =
+{
+  {
+    0, 0                                        /* PM_NORMAL */
+  },
+  {
+    CONFIG_PM_GOVERNOR_IDLE_LATENCY,            /* PM_IDLE */
+    CONFIG_PM_GOVERNOR_IDLE_RESIDENCY
+  },
+  {
+    CONFIG_PM_GOVERNOR_STANDBY_LATENCY,         /* PM_STANDBY */
+    CONFIG_PM_GOVERNOR_STANDBY_RESIDENCY
+  },
+  {
+    CONFIG_PM_GOVERNOR_SLEEP_LATENCY,           /* PM_SLEEP */
+    CONFIG_PM_GOVERNOR_SLEEP_RESIDENCY
+  }
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: deadline_governor_checkstate
+ *
+ * Description:
+ *   Suggest the lowest power state that is not locked by pm_stay(), that
+ *   is left quickly enough for the strictest latency constraint of the
+ *   domain and that is worth entering before the next watchdog expires.
+ *
+ ****************************************************************************/
+
+static enum pm_state_e deadline_governor_checkstate(int domain)
+{
+  FAR struct pm_domain_s *pdom;
+  FAR const struct deadline_state_s *next;
+  irqstate_t flags;
+  uint32_t latency;
+  uint32_t sleep;
+  int ticks;
+  int state;
+
+  pdom = &g_pmglobals.domain[domain];
+
+  /* The time until the next watchdog is the longest possible sleep */
+
+  ticks = wd_getnext();
+  sleep = (uint32_t)ticks >= UINT32_MAX / USEC_PER_TICK ?
+          UINT32_MAX : TICK2USEC((uint32_t)ticks);
+
+  /* We disable interrupts since pm_stay()/pm_relax() could be
+   * simultaneously invoked, which modifies the stay count which we are
+   * about to read.
+   */
+
+  flags   = enter_critical_section();
+  latency = pm_qos_latency(domain);
+
+  for (state = PM_NORMAL; state < PM_COUNT - 1 && pdom->stay[state] == 0;
+       state++)
+    {
+      next = &g_deadline_states[state + 1];
+      if (next->latency > latency || next->residency > sleep)
+        {
+          break;
+        }
+    }
+
+  leave_critical_section(flags);
+  return state;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pm_deadline_governor_initialize
+ *
+ * Description:
+ *   Return the deadline governor instance.
+ *
+ * Returned Value:
+ *   A pointer to the governor struct.
+ *
+ ****************************************************************************/
+
+FAR const struct pm_governor_s *pm_deadline_governor_initialize(void)
+{
+  return &g_deadline_governor_ops;
+}
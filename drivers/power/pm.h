@@ -94,6 +94,10 @@ struct pm_domain_s
   /* The power state lock count */
 
   uint16_t stay[PM_COUNT];
+
+  /* The wakeup latency constraints (struct pm_qos_s) of the drivers */
+
+  dq_queue_t qos;
 };
 
 /* This structure encapsulates all of the global data used by the PM system */
@@ -0,0 +1,178 @@
+/****************************************************************************
+ * drivers/power/pm_qos.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <nuttx/power/pm.h>
+#include <nuttx/irq.h>
+
+#include "pm.h"
+
+#ifdef CONFIG_PM
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pm_qos_add
+ *
+ * Description:
+ *   This function is called by a device driver to declare the longest
+ *   wakeup latency that it can tolerate in a PM domain.  The governor will
+ *   not recommend a state that takes longer to leave.  The constraint holds
+ *   until it is removed with pm_qos_remove().
+ *
+ * Input Parameters:
+ *   qos     - The constraint structure allocated by the driver
+ *   domain  - The domain of the constraint
+ *   latency - The maximum tolerable wakeup latency in microseconds
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void pm_qos_add(FAR struct pm_qos_s *qos, int domain, uint32_t latency)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(qos != NULL && domain >= 0 && domain < CONFIG_PM_NDOMAINS);
+
+  qos->domain  = domain;
+  qos->latency = latency;
+
+  flags = enter_critical_section();
+  dq_addlast(&qos->entry, &g_pmglobals.domain[domain].qos);
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: pm_qos_update
+ *
+ * Description:
+ *   This function is called by a device driver to change the latency of a
+ *   constraint added with pm_qos_add().
+ *
+ * Input Parameters:
+ *   qos     - The constraint to change
+ *   latency - The new maximum tolerable wakeup latency in microseconds
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void pm_qos_update(FAR struct pm_qos_s *qos, uint32_t latency)
+{
+  DEBUGASSERT(qos != NULL);
+
+  /* A single aligned word is written atomically */
+
+  qos->latency = latency;
+}
+
+/****************************************************************************
+ * Name: pm_qos_remove
+ *
+ * Description:
+ *   This function is called by a device driver to remove a constraint added
+ *   with pm_qos_add().
+ *
+ * Input Parameters:
+ *   qos - The constraint to remove
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void pm_qos_remove(FAR struct pm_qos_s *qos)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(qos != NULL && qos->domain >= 0 &&
+              qos->domain < CONFIG_PM_NDOMAINS);
+
+  flags = enter_critical_section();
+  dq_rem(&qos->entry, &g_pmglobals.domain[qos->domain].qos);
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: pm_qos_latency
+ *
+ * Description:
+ *   This function is called by the governor to get the strictest wakeup
+ *   latency constraint of a PM domain.
+ *
+ * Input Parameters:
+ *   domain - The domain of the constraints
+ *
+ * Returned Value:
+ *   The smallest tolerable wakeup latency in microseconds or UINT32_MAX if
+ *   there is no constraint.
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+uint32_t pm_qos_latency(int domain)
+{
+  FAR struct pm_qos_s *qos;
+  uint32_t latency = UINT32_MAX;
+  irqstate_t flags;
+
+  DEBUGASSERT(domain >= 0 && domain < CONFIG_PM_NDOMAINS);
+
+  flags = enter_critical_section();
+  for (qos = (FAR struct pm_qos_s *)g_pmglobals.domain[domain].qos.head;
+       qos != NULL;
+       qos = (FAR struct pm_qos_s *)qos->entry.flink)
+    {
+      if (qos->latency < latency)
+        {
+          latency = qos->latency;
+        }
+    }
+
+  leave_critical_section(flags);
+  return latency;
+}
+
+#endif /* CONFIG_PM */
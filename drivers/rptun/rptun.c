@@ -44,6 +44,7 @@
 #include <fcntl.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/kthread.h>
 #include <nuttx/rptun/openamp.h>
@@ -63,6 +64,10 @@
 #  define ALIGN_UP(s, a)        (((s) + (a) - 1) & ~((a) - 1))
 #endif
 
+#ifndef CONFIG_RPTUN_NOTIFY_BATCH
+#  define CONFIG_RPTUN_NOTIFY_BATCH 0
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -76,6 +81,10 @@ struct rptun_priv_s
   struct metal_list            bind;
   struct metal_list            node;
   int                          pid;
+#if CONFIG_RPTUN_NOTIFY_BATCH > 0
+  bool                         batching;  /* Notifications are coalesced */
+  int                          nkicks;    /* Notifications not sent yet */
+#endif
 };
 
 struct rptun_bind_s
@@ -191,7 +200,33 @@ static int rptun_thread(int argc, FAR char *argv[])
       ret = nxsig_timedwait(&set, NULL, NULL);
       if (ret == SIGUSR1)
         {
+#if CONFIG_RPTUN_NOTIFY_BATCH > 0
+          irqstate_t flags;
+          int nkicks;
+
+          /* Hold back the notifications of the remote core until all
+           * received messages are processed.
+           */
+
+          flags = enter_critical_section();
+          priv->batching = true;
+          leave_critical_section(flags);
+#endif
+
           remoteproc_get_notification(&priv->rproc, RPTUN_NOTIFY_ALL);
+
+#if CONFIG_RPTUN_NOTIFY_BATCH > 0
+          flags = enter_critical_section();
+          priv->batching = false;
+          nkicks         = priv->nkicks;
+          priv->nkicks   = 0;
+          leave_critical_section(flags);
+
+          if (nkicks > 0)
+            {
+              RPTUN_NOTIFY(priv->dev, RPTUN_NOTIFY_ALL);
+            }
+#endif
         }
     }
 
@@ -297,6 +332,24 @@ static int rptun_notify(FAR struct remoteproc *rproc, uint32_t id)
 {
   FAR struct rptun_priv_s *priv = rproc->priv;
 
+#if CONFIG_RPTUN_NOTIFY_BATCH > 0
+  irqstate_t flags;
+
+  /* The notifications are not distinguished by the virtqueue, so one
+   * notification at the end of the batch stands for all of them.
+   */
+
+  flags = enter_critical_section();
+  if (priv->batching && ++priv->nkicks < CONFIG_RPTUN_NOTIFY_BATCH)
+    {
+      leave_critical_section(flags);
+      return 0;
+    }
+
+  priv->nkicks = 0;
+  leave_critical_section(flags);
+#endif
+
   RPTUN_NOTIFY(priv->dev, RPTUN_NOTIFY_ALL);
 
   return 0;
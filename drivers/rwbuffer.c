@@ -134,9 +134,70 @@ static inline void rwb_resetwrbuffer(FAR struct rwbuffer_s *rwb)
 {
   /* We assume that the caller holds the wrsem */
 
-  rwb->wrnblocks       = 0;
-  rwb->wrblockstart    = (off_t)-1;
-  rwb->wrexpectedblock = (off_t)-1;
+  rwb->wrnblocks = 0;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrfind
+ *
+ * Description:
+ *   Return the index of the write buffer slot that holds a block or -1 if
+ *   the block is not buffered.
+ *
+ * Assumptions:
+ *   The caller holds the wrsem semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static int rwb_wrfind(FAR struct rwbuffer_s *rwb, off_t block)
+{
+  int index;
+
+  /* Search from the most recently written block.  That is the one most
+   * likely to be rewritten.
+   */
+
+  for (index = rwb->wrnblocks - 1; index >= 0; index--)
+    {
+      if (rwb->wrblocks[index] == block)
+        {
+          break;
+        }
+    }
+
+  return index;
+}
+#endif
+
+/****************************************************************************
+ * Name: rwb_wrremove
+ *
+ * Description:
+ *   Remove one block from the write buffer, keeping the remaining blocks in
+ *   the order in which they were written.
+ *
+ * Assumptions:
+ *   The caller holds the wrsem semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DRVR_WRITEBUFFER
+static void rwb_wrremove(FAR struct rwbuffer_s *rwb, int index)
+{
+  int nmove = rwb->wrnblocks - index - 1;
+
+  if (nmove > 0)
+    {
+      memmove(&rwb->wrbuffer[index * rwb->blocksize],
+              &rwb->wrbuffer[(index + 1) * rwb->blocksize],
+              nmove * rwb->blocksize);
+      memmove(&rwb->wrblocks[index], &rwb->wrblocks[index + 1],
+              nmove * sizeof(off_t));
+    }
+
+  rwb->wrnblocks--;
 }
 #endif
 
@@ -149,29 +210,55 @@ static inline void rwb_resetwrbuffer(FAR struct rwbuffer_s *rwb)
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-static void rwb_wrflush(FAR struct rwbuffer_s *rwb)
+static int rwb_wrflush(FAR struct rwbuffer_s *rwb)
 {
-  int ret;
+  ssize_t ret;
+  int first;
+  int nrun;
+
+  /* The blocks are written to the media in the order in which they were
+   * last written to the buffer.  A power failure in the middle of the
+   * flush then leaves the media in a state that the file system produced
+   * itself, just with some of the latest writes missing.  Runs of
+   * consecutive blocks are merged into one transfer.
+   */
 
-  if (rwb->wrnblocks > 0)
+  for (first = 0; first < rwb->wrnblocks; first += nrun)
     {
-      finfo("Flushing: blockstart=0x%08lx nblocks=%d from buffer=%p\n",
-      (long)rwb->wrblockstart, rwb->wrnblocks, rwb->wrbuffer);
+      nrun = 1;
+      while (first + nrun < rwb->wrnblocks &&
+             rwb->wrblocks[first + nrun] == rwb->wrblocks[first] + nrun)
+        {
+          nrun++;
+        }
+
+      finfo("Flushing: blockstart=0x%08lx nblocks=%d\n",
+            (long)rwb->wrblocks[first], nrun);
 
-      /* Flush cache.  On success, the flush method will return the number
-       * of blocks written.  Anything other than the number requested is
-       * an error.
+      /* On success, the flush method will return the number of blocks
+       * written.  Anything other than the number requested is an error.
        */
 
-      ret = rwb->wrflush(rwb->dev, rwb->wrbuffer, rwb->wrblockstart,
-                         rwb->wrnblocks);
-      if (ret != rwb->wrnblocks)
+      ret = rwb->wrflush(rwb->dev, &rwb->wrbuffer[first * rwb->blocksize],
+                         rwb->wrblocks[first], nrun);
+      if (ret != nrun)
         {
-          ferr("ERROR: Error flushing write buffer: %d\n", ret);
-        }
+          ferr("ERROR: Error flushing write buffer: %d\n", (int)ret);
 
-      rwb_resetwrbuffer(rwb);
+          /* Keep the blocks that were not written */
+
+          rwb->wrnblocks -= first;
+          memmove(rwb->wrbuffer, &rwb->wrbuffer[first * rwb->blocksize],
+                  rwb->wrnblocks * rwb->blocksize);
+          memmove(rwb->wrblocks, &rwb->wrblocks[first],
+                  rwb->wrnblocks * sizeof(off_t));
+
+          return ret < 0 ? (int)ret : -EIO;
+        }
     }
+
+  rwb_resetwrbuffer(rwb);
+  return OK;
 }
 #endif
 
@@ -240,42 +327,42 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
                                off_t startblock, uint32_t nblocks,
                                FAR const uint8_t *wrbuffer)
 {
+  uint32_t i;
+  int index;
   int ret;
 
   /* Write writebuffer Logic */
 
   rwb_wrcanceltimeout(rwb);
 
-  /* First: Should we flush out our cache? We would do that if (1) we already
-   * buffering blocks and the next block writing is not in the same sequence,
-   * or (2) the number of blocks would exceed our allocated buffer capacity
+  /* First: Coalesce the new blocks with the buffered ones.  A block that
+   * is already buffered is dropped here and added again at the end of the
+   * buffer below, keeping the buffer in the order of the last writes.
    */
 
-  if (((startblock != rwb->wrexpectedblock) && (rwb->wrnblocks)) ||
-      ((rwb->wrnblocks + nblocks) > rwb->wrmaxblocks))
+  for (i = 0; i < nblocks; i++)
     {
-      finfo("writebuffer miss, expected: %08x, given: %08x\n",
-            rwb->wrexpectedblock, startblock);
+      index = rwb_wrfind(rwb, startblock + i);
+      if (index >= 0)
+        {
+          finfo("writebuffer hit: block 0x%08lx\n", (long)(startblock + i));
+          rwb_wrremove(rwb, index);
+        }
+    }
 
-      /* Flush the write buffer */
+  /* Then: Should we flush out our cache?  We would do that if the number
+   * of blocks would exceed our allocated buffer capacity.
+   */
 
-      ret = rwb->wrflush(rwb->dev, rwb->wrbuffer, rwb->wrblockstart,
-                         rwb->wrnblocks);
+  if ((rwb->wrnblocks + nblocks) > rwb->wrmaxblocks)
+    {
+      ret = rwb_wrflush(rwb);
       if (ret < 0)
         {
           ferr("ERROR: Error writing multiple from cache: %d\n", -ret);
+          rwb_wrstarttimeout(rwb);
           return ret;
         }
-
-      rwb_resetwrbuffer(rwb);
-    }
-
-  /* writebuffer is empty? Then initialize it */
-
-  if (rwb->wrnblocks == 0)
-    {
-      finfo("Fresh cache starting at block: 0x%08x\n", startblock);
-      rwb->wrblockstart = startblock;
     }
 
   /* Add data to cache */
@@ -286,8 +373,11 @@ static ssize_t rwb_writebuffer(FAR struct rwbuffer_s *rwb,
   memcpy(&rwb->wrbuffer[rwb->wrnblocks * rwb->blocksize],
          wrbuffer, nblocks * rwb->blocksize);
 
-  rwb->wrnblocks      += nblocks;
-  rwb->wrexpectedblock = rwb->wrblockstart + rwb->wrnblocks;
+  for (i = 0; i < nblocks; i++)
+    {
+      rwb->wrblocks[rwb->wrnblocks++] = startblock + i;
+    }
+
   rwb_wrstarttimeout(rwb);
   return nblocks;
 }
@@ -419,8 +509,9 @@ int rwb_invalidate_writebuffer(FAR struct rwbuffer_s *rwb,
 
   if (rwb->wrmaxblocks > 0 && rwb->wrnblocks > 0)
     {
-      off_t wrbend;
       off_t invend;
+      int from;
+      int to;
 
       finfo("startblock=%d blockcount=%p\n", startblock, blockcount);
 
@@ -430,112 +521,29 @@ int rwb_invalidate_writebuffer(FAR struct rwbuffer_s *rwb,
           return ret;
         }
 
-      /* Now there are five cases:
-       *
-       * 1. We invalidate nothing
+      /* Drop the buffered blocks within the region, keeping the others
+       * in the order in which they were written.
        */
 
-      wrbend = rwb->wrblockstart + rwb->wrnblocks;
       invend = startblock + blockcount;
-
-      if (wrbend <= startblock || rwb->wrblockstart >= invend)
-        {
-          ret = OK;
-        }
-
-      /* 2. We invalidate the entire write buffer. */
-
-      else if (rwb->wrblockstart >= startblock && wrbend <= invend)
-        {
-          rwb->wrnblocks = 0;
-          ret = OK;
-        }
-
-      /* We are going to invalidate a subset of the write buffer.  Three
-       * more cases to consider:
-       *
-       * 2. We invalidate a portion in the middle of the write buffer
-       */
-
-      else if (rwb->wrblockstart < startblock && wrbend > invend)
+      for (from = to = 0; from < rwb->wrnblocks; from++)
         {
-          FAR uint8_t *src;
-          off_t block;
-          off_t offset;
-          size_t nblocks;
-
-          /* Write the blocks at the end of the media to hardware */
-
-          nblocks = wrbend - invend;
-          block   = invend;
-          offset  = block - rwb->wrblockstart;
-          src     = rwb->wrbuffer + offset * rwb->blocksize;
-
-          ret = rwb->wrflush(rwb->dev, src, block, nblocks);
-          if (ret < 0)
+          if (rwb->wrblocks[from] < startblock ||
+              rwb->wrblocks[from] >= invend)
             {
-              ferr("ERROR: wrflush failed: %d\n", ret);
-            }
-
-          /* Keep the blocks at the beginning of the buffer up the
-           * start of the invalidated region.
-           */
+              if (to != from)
+                {
+                  memcpy(&rwb->wrbuffer[to * rwb->blocksize],
+                         &rwb->wrbuffer[from * rwb->blocksize],
+                         rwb->blocksize);
+                  rwb->wrblocks[to] = rwb->wrblocks[from];
+                }
 
-          else
-            {
-              rwb->wrnblocks = startblock - rwb->wrblockstart;
-              ret = OK;
+              to++;
             }
         }
 
-      /* 3. We invalidate a portion at the end of the write buffer */
-
-      else if (wrbend > startblock && wrbend <= invend)
-        {
-          rwb->wrnblocks = wrbend - startblock;
-          ret = OK;
-        }
-
-      /* 4. We invalidate a portion at the beginning of the write buffer */
-
-      else /* if (rwb->wrblockstart >= startblock && wrbend > invend) */
-        {
-          FAR uint8_t *src;
-          size_t ninval;
-          size_t nkeep;
-
-          DEBUGASSERT(rwb->wrblockstart >= startblock && wrbend > invend);
-
-          /* Copy the data from the uninvalidated region to the beginning
-           * of the write buffer.
-           *
-           * First calculate the source and destination of the transfer.
-           */
-
-          ninval = invend - rwb->wrblockstart;
-          src    = rwb->wrbuffer + ninval * rwb->blocksize;
-
-          /* Calculate the number of blocks we are keeping.  We keep
-           * the ones that we don't invalidate.
-           */
-
-          nkeep  = rwb->wrnblocks - ninval;
-
-          /* Then move the data that we are keeping to the beginning
-           * the write buffer.
-           */
-
-          memcpy(rwb->wrbuffer, src, nkeep * rwb->blocksize);
-
-          /* Update the block info.  The first block is now the one just
-           * after the invalidation region and the number buffered blocks
-           * is the number that we kept.
-           */
-
-          rwb->wrblockstart = invend;
-          rwb->wrnblocks    = nkeep;
-          ret = OK;
-        }
+      rwb->wrnblocks = to;
 
       rwb_semgive(&rwb->wrsem);
     }
@@ -686,6 +694,7 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
 #ifdef CONFIG_DRVR_WRITEBUFFER
   DEBUGASSERT(rwb->wrflush != NULL);
   rwb->wrbuffer = NULL;
+  rwb->wrblocks = NULL;
 #endif
 #ifdef CONFIG_DRVR_READAHEAD
   DEBUGASSERT(rwb->rhreload != NULL);
@@ -717,6 +726,16 @@ int rwb_initialize(FAR struct rwbuffer_s *rwb)
               ferr("Write buffer kmm_malloc(%d) failed\n", allocsize);
               return -ENOMEM;
             }
+
+          /* And the block numbers of the buffered blocks */
+
+          rwb->wrblocks = kmm_malloc(rwb->wrmaxblocks * sizeof(off_t));
+          if (!rwb->wrblocks)
+            {
+              ferr("Write buffer kmm_malloc(%d) failed\n",
+                   rwb->wrmaxblocks * sizeof(off_t));
+              return -ENOMEM;
+            }
         }
 
       finfo("Write buffer size: %d bytes\n", allocsize);
@@ -772,6 +791,11 @@ void rwb_uninitialize(FAR struct rwbuffer_s *rwb)
         {
           kmm_free(rwb->wrbuffer);
         }
+
+      if (rwb->wrblocks)
+        {
+          kmm_free(rwb->wrblocks);
+        }
     }
 #endif
 
@@ -889,52 +913,51 @@ ssize_t rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock,
         (long)startblock, (long)nblocks, rdbuffer);
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
-  /* If the new read data overlaps any part of the write buffer, we
-   * directly copy write buffer to read buffer. This boost performance.
+  /* The write buffer holds the most recent data of the blocks in it.  Copy
+   * the buffered blocks directly and read the others from the media.
    */
 
   if (rwb->wrmaxblocks > 0)
     {
+      size_t rdblocks;
+      int index;
+
       ret = nxsem_wait(&rwb->wrsem);
       if (ret < 0)
         {
           return (ssize_t)ret;
         }
 
-      /* If the write buffer overlaps the block(s) requested */
-
-      if (rwb_overlap(rwb->wrblockstart, rwb->wrnblocks, startblock,
-                      nblocks))
+      while (nblocks > 0)
         {
-          size_t rdblocks = 0;
-          size_t wrnpass  = 0;
-
-          if (rwb->wrblockstart > startblock)
+          index = rwb_wrfind(rwb, startblock);
+          if (index >= 0)
+            {
+              memcpy(rdbuffer, &rwb->wrbuffer[index * rwb->blocksize],
+                     rwb->blocksize);
+              rdblocks = 1;
+            }
+          else
             {
-              rdblocks = rwb->wrblockstart - startblock;
+              /* Read up to the next buffered block from the media */
+
+              rdblocks = 1;
+              while (rdblocks < nblocks &&
+                     rwb_wrfind(rwb, startblock + rdblocks) < 0)
+                {
+                  rdblocks++;
+                }
+
               ret = rwb_read_(rwb, startblock, rdblocks, rdbuffer);
-              if (ret < 0)
+              if (ret <= 0)
                 {
                   rwb_semgive(&rwb->wrsem);
-                  return (ssize_t)ret;
+                  return readblocks > 0 ? (ssize_t)readblocks : ret;
                 }
 
-              startblock += ret;
-              nblocks    -= ret;
-              rdbuffer   += ret * rwb->blocksize;
-              readblocks += ret;
+              rdblocks = ret;
             }
 
-          if (rwb->wrblockstart < startblock)
-            {
-              wrnpass = startblock - rwb->wrblockstart;
-            }
-
-          rdblocks = nblocks > (rwb->wrnblocks - wrnpass) ?
-                    (rwb->wrnblocks - wrnpass) : nblocks;
-          memcpy(rdbuffer, &rwb->wrbuffer[wrnpass * rwb->blocksize],
-                rdblocks * rwb->blocksize);
-
           startblock += rdblocks;
           nblocks    -= rdblocks;
           rdbuffer   += rdblocks * rwb->blocksize;
@@ -942,6 +965,7 @@ ssize_t rwb_read(FAR struct rwbuffer_s *rwb, off_t startblock,
         }
 
       rwb_semgive(&rwb->wrsem);
+      return (ssize_t)readblocks;
     }
 #endif
 
@@ -1019,8 +1043,12 @@ ssize_t rwb_write(FAR struct rwbuffer_s *rwb, off_t startblock,
               return (ssize_t)ret;
             }
 
-          rwb_wrflush(rwb);
+          ret = rwb_wrflush(rwb);
           rwb_semgive(&rwb->wrsem);
+          if (ret < 0)
+            {
+              return (ssize_t)ret;
+            }
 
           /* Then transfer the data directly to the media */
 
@@ -1170,21 +1198,29 @@ int rwb_invalidate(FAR struct rwbuffer_s *rwb,
  * Name: rwb_flush
  *
  * Description:
- *   Flush the write buffer
+ *   Flush the write buffer.  All data written before the call is on the
+ *   media when the call returns successfully, so file systems may use this
+ *   as a write barrier.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_DRVR_WRITEBUFFER
 int rwb_flush(FAR struct rwbuffer_s *rwb)
 {
+  int result;
   int ret;
 
+  if (rwb->wrmaxblocks == 0)
+    {
+      return OK;
+    }
+
   ret = rwb_forcetake(&rwb->wrsem);
   rwb_wrcanceltimeout(rwb);
-  rwb_wrflush(rwb);
+  result = rwb_wrflush(rwb);
   rwb_semgive(&rwb->wrsem);
 
-  return ret;
+  return result < 0 ? result : ret;
 }
 #endif
 
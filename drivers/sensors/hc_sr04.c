@@ -50,6 +50,7 @@
 #include <nuttx/signal.h>
 #include <nuttx/random.h>
 #include <nuttx/sensors/hc_sr04.h>
+#include <nuttx/fs/fs.h>
 
 /****************************************************************************
  * Pre-Processor Definitions
@@ -303,7 +304,7 @@ static void hcsr04_notify(FAR struct hcsr04_dev_s *priv)
         {
           fds->revents |= POLLIN;
           hcsr04_dbg("Report events: %02x\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_notify(fds);
         }
     }
 }
@@ -51,6 +51,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/signal.h>
 #include <nuttx/random.h>
+#include <nuttx/fs/fs.h>
 
 #include <nuttx/sensors/hts221.h>
 
@@ -1086,7 +1087,7 @@ static void hts221_notify(FAR struct hts221_dev_s *priv)
         {
           fds->revents |= POLLIN;
           hts221_dbg("Report events: %02x\n", fds->revents);
-          nxsem_post(fds->sem);
+          poll_notify(fds);
         }
     }
 }
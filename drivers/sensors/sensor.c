@@ -0,0 +1,678 @@
+/****************************************************************************
+ * drivers/sensors/sensor.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/sensors/sensor.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The device path:  "/dev/sensor/" + name + devno */
+
+#define SENSOR_PATHLEN 32
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The name and the event size of each sensor type */
+
+struct sensor_info_s
+{
+  FAR const char *name;
+  uint8_t esize;
+};
+
+/* The state of the upper half of one sensor.  The event buffer is a
+ * circular buffer of complete events:  head is the offset of the next
+ * event pushed, nbytes is the number of bytes buffered.  When it is full,
+ * the oldest events are overwritten; a reader wants the latest samples.
+ */
+
+struct sensor_upperhalf_s
+{
+  FAR struct sensor_lowerhalf_s *lower; /* The lower half */
+  FAR char *buffer;                     /* The event buffer */
+  size_t bufsize;                       /* Size of the buffer in bytes */
+  volatile size_t head;                 /* Offset of the next event */
+  volatile size_t nbytes;               /* Number of bytes buffered */
+  uint8_t esize;                        /* Size of one event */
+  uint8_t crefs;                        /* Number of opens */
+  bool enabled;                         /* The sensor is activated */
+  sem_t exclsem;                        /* Serializes the file operations */
+  sem_t buffersem;                      /* Wakes up the blocked readers */
+
+  /* The poll waiters */
+
+  FAR struct pollfd *fds[CONFIG_SENSORS_NPOLLWAITERS];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void    sensor_push_event(FAR void *priv, FAR const void *data,
+                                 size_t bytes);
+
+/* Character driver methods */
+
+static int     sensor_open(FAR struct file *filep);
+static int     sensor_close(FAR struct file *filep);
+static ssize_t sensor_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen);
+static int     sensor_ioctl(FAR struct file *filep, int cmd,
+                            unsigned long arg);
+static int     sensor_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                           bool setup);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct sensor_info_s g_sensor_info[SENSOR_TYPE_COUNT] =
+{
+  {"accel", sizeof(struct sensor_event_accel)},
+  {"mag",   sizeof(struct sensor_event_mag)},
+  {"gyro",  sizeof(struct sensor_event_gyro)},
+  {"light", sizeof(struct sensor_event_light)},
+  {"baro",  sizeof(struct sensor_event_baro)},
+  {"prox",  sizeof(struct sensor_event_prox)},
+  {"humi",  sizeof(struct sensor_event_humi)},
+  {"temp",  sizeof(struct sensor_event_temp)}
+};
+
+static const struct file_operations g_sensor_fops =
+{
+  sensor_open,   /* open */
+  sensor_close,  /* close */
+  sensor_read,   /* read */
+  NULL,          /* write */
+  NULL,          /* seek */
+  sensor_ioctl,  /* ioctl */
+  sensor_poll    /* poll */
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL         /* unlink */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sensor_pollnotify
+ *
+ * Description:
+ *   Wake up the poll waiters.  Called with interrupts disabled.
+ *
+ ****************************************************************************/
+
+static void sensor_pollnotify(FAR struct sensor_upperhalf_s *upper)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_SENSORS_NPOLLWAITERS; i++)
+    {
+      FAR struct pollfd *fds = upper->fds[i];
+      if (fds != NULL)
+        {
+          fds->revents |= fds->events & POLLIN;
+          if (fds->revents != 0)
+            {
+              poll_notify(fds);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: sensor_push_event
+ *
+ * Description:
+ *   Add events to the buffer and wake up the readers once for the whole
+ *   batch.  This is the push_event() method of the lower half.
+ *
+ ****************************************************************************/
+
+static void sensor_push_event(FAR void *priv, FAR const void *data,
+                              size_t bytes)
+{
+  FAR struct sensor_upperhalf_s *upper = priv;
+  FAR const char *src = data;
+  irqstate_t flags;
+  size_t ncopy;
+  int semcount;
+
+  /* Only complete events.  Of a batch larger than the buffer, only the
+   * latest events are kept.
+   */
+
+  bytes -= bytes % upper->esize;
+  if (bytes > upper->bufsize)
+    {
+      src  += bytes - upper->bufsize;
+      bytes = upper->bufsize;
+    }
+
+  if (bytes == 0)
+    {
+      return;
+    }
+
+  flags = enter_critical_section();
+
+  /* At most two copies, before and after the end of the buffer */
+
+  ncopy = upper->bufsize - upper->head;
+  if (ncopy > bytes)
+    {
+      ncopy = bytes;
+    }
+
+  memcpy(upper->buffer + upper->head, src, ncopy);
+  memcpy(upper->buffer, src + ncopy, bytes - ncopy);
+
+  upper->head = (upper->head + bytes) % upper->bufsize;
+  upper->nbytes += bytes;
+  if (upper->nbytes > upper->bufsize)
+    {
+      /* The oldest events were overwritten */
+
+      upper->nbytes = upper->bufsize;
+    }
+
+  nxsem_getvalue(&upper->buffersem, &semcount);
+  if (semcount < 0)
+    {
+      nxsem_post(&upper->buffersem);
+    }
+
+  sensor_pollnotify(upper);
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: sensor_open
+ ****************************************************************************/
+
+static int sensor_open(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct sensor_upperhalf_s *upper = inode->i_private;
+  int ret;
+
+  ret = nxsem_wait(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (upper->crefs == UINT8_MAX)
+    {
+      ret = -EMFILE;
+    }
+  else
+    {
+      upper->crefs++;
+    }
+
+  nxsem_post(&upper->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: sensor_close
+ *
+ * Description:
+ *   The last close stops the sensor.
+ *
+ ****************************************************************************/
+
+static int sensor_close(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct sensor_upperhalf_s *upper = inode->i_private;
+  FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  int ret;
+
+  ret = nxsem_wait_uninterruptible(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (--upper->crefs == 0 && upper->enabled)
+    {
+      if (lower->ops->activate != NULL)
+        {
+          lower->ops->activate(lower, false);
+        }
+
+      upper->enabled = false;
+    }
+
+  nxsem_post(&upper->exclsem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: sensor_read
+ *
+ * Description:
+ *   Return as many of the buffered events, oldest first, as fit into the
+ *   user buffer.  Wait for the first event unless O_NONBLOCK.
+ *
+ ****************************************************************************/
+
+static ssize_t sensor_read(FAR struct file *filep, FAR char *buffer,
+                           size_t buflen)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct sensor_upperhalf_s *upper = inode->i_private;
+  FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  irqstate_t flags;
+  size_t tail;
+  size_t nread;
+  size_t ncopy;
+  int ret;
+
+  if (buffer == NULL || buflen < upper->esize)
+    {
+      return -EINVAL;
+    }
+
+  ret = nxsem_wait(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Sensors without an interrupt are read now */
+
+  if (lower->ops->fetch != NULL)
+    {
+      ret = lower->ops->fetch(lower, buffer, buflen);
+      nxsem_post(&upper->exclsem);
+      return ret;
+    }
+
+  flags = enter_critical_section();
+  while (upper->nbytes == 0)
+    {
+      if ((filep->f_oflags & O_NONBLOCK) != 0)
+        {
+          ret = -EAGAIN;
+          goto errout;
+        }
+
+      ret = nxsem_wait(&upper->buffersem);
+      if (ret < 0)
+        {
+          goto errout;
+        }
+    }
+
+  nread = buflen - buflen % upper->esize;
+  if (nread > upper->nbytes)
+    {
+      nread = upper->nbytes;
+    }
+
+  /* The events are copied with interrupts disabled:  A batch pushed now
+   * could otherwise overwrite the oldest events while they are copied.
+   */
+
+  tail  = (upper->head + upper->bufsize - upper->nbytes) % upper->bufsize;
+  ncopy = upper->bufsize - tail;
+  if (ncopy > nread)
+    {
+      ncopy = nread;
+    }
+
+  memcpy(buffer, upper->buffer + tail, ncopy);
+  memcpy(buffer + ncopy, upper->buffer, nread - ncopy);
+  upper->nbytes -= nread;
+  ret = nread;
+
+errout:
+  leave_critical_section(flags);
+  nxsem_post(&upper->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: sensor_ioctl
+ ****************************************************************************/
+
+static int sensor_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct sensor_upperhalf_s *upper = inode->i_private;
+  FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  FAR unsigned int *val = (FAR unsigned int *)((uintptr_t)arg);
+  int ret;
+
+  ret = nxsem_wait(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  switch (cmd)
+    {
+      /* Start or stop the sensor.  Arg: bool value */
+
+      case SNIOC_ACTIVATE:
+        {
+          bool enable = (bool)arg;
+
+          if (enable == upper->enabled)
+            {
+              ret = OK;
+            }
+          else if (lower->ops->activate == NULL)
+            {
+              ret = -ENOTSUP;
+            }
+          else
+            {
+              ret = lower->ops->activate(lower, enable);
+              if (ret >= 0)
+                {
+                  upper->enabled = enable;
+                }
+            }
+        }
+        break;
+
+      /* Set the sampling period.  Arg: unsigned int* pointer (us) */
+
+      case SNIOC_SET_PERIOD:
+        if (val == NULL)
+          {
+            ret = -EINVAL;
+          }
+        else if (lower->ops->set_interval == NULL)
+          {
+            ret = -ENOTSUP;
+          }
+        else
+          {
+            ret = lower->ops->set_interval(lower, val);
+          }
+        break;
+
+      /* Set the batch latency.  Arg: unsigned int* pointer (us) */
+
+      case SNIOC_BATCH:
+        if (val == NULL)
+          {
+            ret = -EINVAL;
+          }
+        else if (lower->ops->batch == NULL)
+          {
+            ret = *val == 0 ? OK : -ENOTSUP;
+          }
+        else
+          {
+            ret = lower->ops->batch(lower, val);
+          }
+        break;
+
+      default:
+        if (lower->ops->control != NULL)
+          {
+            ret = lower->ops->control(lower, cmd, arg);
+          }
+        else
+          {
+            ret = -ENOTTY;
+          }
+        break;
+    }
+
+  nxsem_post(&upper->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: sensor_poll
+ ****************************************************************************/
+
+static int sensor_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                       bool setup)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct sensor_upperhalf_s *upper = inode->i_private;
+  FAR struct pollfd **slot;
+  irqstate_t flags;
+  int ret;
+  int i;
+
+  ret = nxsem_wait(&upper->exclsem);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (setup)
+    {
+      /* This is a request to set up the poll.  Find an available slot for
+       * the poll structure reference.
+       */
+
+      for (i = 0; i < CONFIG_SENSORS_NPOLLWAITERS; i++)
+        {
+          if (upper->fds[i] == NULL)
+            {
+              upper->fds[i] = fds;
+              fds->priv     = &upper->fds[i];
+              break;
+            }
+        }
+
+      if (i >= CONFIG_SENSORS_NPOLLWAITERS)
+        {
+          fds->priv = NULL;
+          ret       = -EBUSY;
+          goto out;
+        }
+
+      /* Report the events that are already buffered.  A sensor that is
+       * read on demand is always ready.
+       */
+
+      flags = enter_critical_section();
+      if (upper->lower->ops->fetch != NULL || upper->nbytes > 0)
+        {
+          fds->revents |= fds->events & POLLIN;
+          if (fds->revents != 0)
+            {
+              poll_notify(fds);
+            }
+        }
+
+      leave_critical_section(flags);
+    }
+  else if (fds->priv != NULL)
+    {
+      /* This is a request to tear down the poll. */
+
+      slot      = (FAR struct pollfd **)fds->priv;
+      *slot     = NULL;
+      fds->priv = NULL;
+    }
+
+out:
+  nxsem_post(&upper->exclsem);
+  return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sensor_register
+ *
+ * Description:
+ *   Register the character device of a sensor lower half as
+ *   /dev/sensor/<name><devno>.  The device returns timestamped events of
+ *   the type of the sensor; one read() returns as many buffered events as
+ *   fit into the user buffer.
+ *
+ * Input Parameters:
+ *   lower - The lower half of the sensor
+ *   devno - The number of the device, e.g. 0 for /dev/sensor/accel0
+ *
+ * Returned Value:
+ *   OK if the driver was successfully registered; A negated errno value is
+ *   returned on any failure.
+ *
+ ****************************************************************************/
+
+int sensor_register(FAR struct sensor_lowerhalf_s *lower, int devno)
+{
+  FAR struct sensor_upperhalf_s *upper;
+  char path[SENSOR_PATHLEN];
+  int ret;
+
+  DEBUGASSERT(lower != NULL && lower->ops != NULL);
+
+  if (lower->type < 0 || lower->type >= SENSOR_TYPE_COUNT)
+    {
+      snerr("ERROR: Bad sensor type: %d\n", lower->type);
+      return -EINVAL;
+    }
+
+  upper = (FAR struct sensor_upperhalf_s *)
+    kmm_zalloc(sizeof(struct sensor_upperhalf_s));
+  if (upper == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  upper->lower = lower;
+  upper->esize = g_sensor_info[lower->type].esize;
+
+  /* Sensors that are read on demand do not push events */
+
+  if (lower->ops->fetch == NULL)
+    {
+      upper->bufsize = upper->esize *
+                       (lower->buffer_number > 0 ? lower->buffer_number : 1);
+      upper->buffer  = (FAR char *)kmm_malloc(upper->bufsize);
+      if (upper->buffer == NULL)
+        {
+          ret = -ENOMEM;
+          goto errout_with_upper;
+        }
+    }
+
+  nxsem_init(&upper->exclsem, 0, 1);
+
+  /* The buffer semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&upper->buffersem, 0, 0);
+  nxsem_setprotocol(&upper->buffersem, SEM_PRIO_NONE);
+
+  lower->priv       = upper;
+  lower->push_event = sensor_push_event;
+
+  snprintf(path, sizeof(path), "/dev/sensor/%s%d",
+           g_sensor_info[lower->type].name, devno);
+
+  ret = register_driver(path, &g_sensor_fops, 0444, upper);
+  if (ret < 0)
+    {
+      snerr("ERROR: Failed to register %s: %d\n", path, ret);
+      goto errout_with_sem;
+    }
+
+  return OK;
+
+errout_with_sem:
+  lower->push_event = NULL;
+  lower->priv       = NULL;
+  nxsem_destroy(&upper->exclsem);
+  nxsem_destroy(&upper->buffersem);
+  kmm_free(upper->buffer);
+
+errout_with_upper:
+  kmm_free(upper);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: sensor_unregister
+ *
+ * Description:
+ *   Unregister the character device of a sensor and free its upper half.
+ *
+ * Input Parameters:
+ *   lower - The lower half of the sensor
+ *   devno - The number of the device
+ *
+ ****************************************************************************/
+
+void sensor_unregister(FAR struct sensor_lowerhalf_s *lower, int devno)
+{
+  FAR struct sensor_upperhalf_s *upper;
+  char path[SENSOR_PATHLEN];
+
+  DEBUGASSERT(lower != NULL && lower->priv != NULL);
+
+  upper = (FAR struct sensor_upperhalf_s *)lower->priv;
+
+  snprintf(path, sizeof(path), "/dev/sensor/%s%d",
+           g_sensor_info[lower->type].name, devno);
+  unregister_driver(path);
+
+  lower->push_event = NULL;
+  lower->priv       = NULL;
+
+  nxsem_destroy(&upper->exclsem);
+  nxsem_destroy(&upper->buffersem);
+  kmm_free(upper->buffer);
+  kmm_free(upper);
+}
@@ -82,6 +82,10 @@ static void    uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset);
 /* Write support */
 
 static int     uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock);
+static size_t  uart_xmitrun(FAR uart_dev_t *dev, FAR const char *buffer,
+                 size_t buflen);
+static size_t  uart_putxmitbuf(FAR uart_dev_t *dev, FAR const char *buffer,
+                 size_t buflen);
 static inline ssize_t uart_irqwrite(FAR uart_dev_t *dev, FAR const char *buffer,
                                     size_t buflen);
 static int     uart_tcdrain(FAR uart_dev_t *dev, clock_t timeout);
@@ -167,14 +171,20 @@ static void uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset)
 
               /* Limit the number of times that the semaphore is posted.
                * The critical section is needed to make the following
-               * operation atomic.
+               * operation atomic.  A poll callback must always be called;
+               * it does its own limiting.
                */
 
-              flags = enter_critical_section();
-              nxsem_getvalue(fds->sem, &semcount);
+              flags    = enter_critical_section();
+              semcount = 0;
+              if (fds->cb == NULL)
+                {
+                  nxsem_getvalue(fds->sem, &semcount);
+                }
+
               if (semcount < 1)
                 {
-                  nxsem_post(fds->sem);
+                  poll_notify(fds);
                 }
 
               leave_critical_section(flags);
@@ -338,6 +348,122 @@ err_out:
   return ret;
 }
 
+/************************************************************************************
+ * Name: uart_xmitrun
+ *
+ * Description:
+ *   Return the number of characters at the beginning of 'buffer' that need no
+ *   output post-processing and may be copied to the TX buffer as they are.
+ *
+ ************************************************************************************/
+
+static size_t uart_xmitrun(FAR uart_dev_t *dev, FAR const char *buffer,
+                           size_t buflen)
+{
+  size_t i;
+
+#ifdef CONFIG_SERIAL_TERMIOS
+  /* CR and NL are the only characters that output post-processing changes */
+
+  if ((dev->tc_oflag & OPOST) == 0 ||
+      (dev->tc_oflag & (OCRNL | ONLCR | ONLRET)) == 0)
+    {
+      return buflen;
+    }
+
+  for (i = 0; i < buflen && buffer[i] != '\n' && buffer[i] != '\r'; i++)
+    {
+    }
+
+#else
+  /* Only the console converts \n -> \r\n */
+
+  if (!dev->isconsole)
+    {
+      return buflen;
+    }
+
+  for (i = 0; i < buflen && buffer[i] != '\n'; i++)
+    {
+    }
+#endif
+
+  return i;
+}
+
+/************************************************************************************
+ * Name: uart_putxmitbuf
+ *
+ * Description:
+ *   Copy as many characters as fit into the TX buffer without waiting.  At most
+ *   two copies are needed, one before and one after the end of the circular
+ *   buffer.  As with uart_putxmitchar(), the caller has disabled the TX
+ *   interrupt.
+ *
+ * Returned Value:
+ *   The number of characters copied.  Zero if the TX buffer is full.
+ *
+ ************************************************************************************/
+
+static size_t uart_putxmitbuf(FAR uart_dev_t *dev, FAR const char *buffer,
+                              size_t buflen)
+{
+  FAR struct uart_buffer_s *xmit = &dev->xmit;
+  size_t nbytes = 0;
+  size_t ncopy;
+  int16_t head;
+  int16_t tail;
+
+#ifdef CONFIG_SMP
+  irqstate_t flags = enter_critical_section();
+#endif
+
+  head = xmit->head;
+  while (nbytes < buflen)
+    {
+      /* One slot is always left empty to tell a full buffer from an empty
+       * one.
+       */
+
+      tail = xmit->tail;
+      if (head >= tail)
+        {
+          ncopy = xmit->size - head - (tail == 0 ? 1 : 0);
+        }
+      else
+        {
+          ncopy = tail - head - 1;
+        }
+
+      if (ncopy == 0)
+        {
+          break;
+        }
+
+      if (ncopy > buflen - nbytes)
+        {
+          ncopy = buflen - nbytes;
+        }
+
+      memcpy(&xmit->buffer[head], buffer + nbytes, ncopy);
+      nbytes += ncopy;
+      head   += ncopy;
+
+      if (head >= xmit->size)
+        {
+          head = 0;
+        }
+    }
+
+  xmit->head = head;
+
+#ifdef CONFIG_SMP
+  leave_critical_section(flags);
+#endif
+
+  return nbytes;
+}
+
 /************************************************************************************
  * Name: uart_putc
  ************************************************************************************/
@@ -711,8 +837,12 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 #endif
   irqstate_t flags;
   ssize_t recvd = 0;
+  size_t nbytes;
+  int16_t head;
   int16_t tail;
+#ifdef CONFIG_SERIAL_TERMIOS
   char ch;
+#endif
   int ret;
 
   /* Only one user can access rxbuf->tail at a time */
@@ -762,8 +892,40 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
        * 8-bit accesses to obtain the 16-bit head index.
        */
 
+      head = rxbuf->head;
       tail = rxbuf->tail;
-      if (rxbuf->head != tail)
+
+#ifdef CONFIG_SERIAL_TERMIOS
+      if (head != tail && (dev->tc_iflag & (INLCR | IGNCR | ICRNL)) == 0)
+#else
+      if (head != tail)
+#endif
+        {
+          /* No input processing.  Copy the characters up to the head or up to
+           * the end of the circular buffer at once.
+           */
+
+          nbytes = (head > tail ? head : rxbuf->size) - tail;
+          if (nbytes > buflen - (size_t)recvd)
+            {
+              nbytes = buflen - (size_t)recvd;
+            }
+
+          memcpy(buffer, &rxbuf->buffer[tail], nbytes);
+          buffer += nbytes;
+          recvd  += nbytes;
+
+          tail += nbytes;
+          if (tail >= rxbuf->size)
+            {
+              tail = 0;
+            }
+
+          rxbuf->tail = tail;
+        }
+
+#ifdef CONFIG_SERIAL_TERMIOS
+      else if (head != tail)
         {
           /* Take the next character from the tail of the buffer */
 
@@ -781,8 +943,7 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 
           rxbuf->tail = tail;
 
-#ifdef CONFIG_SERIAL_TERMIOS
-          /* Do input processing if any is enabled */
+          /* Do input processing */
 
           if (dev->tc_iflag & (INLCR | IGNCR | ICRNL))
             {
@@ -813,13 +974,13 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
            * IUCLC - Not Posix
            * IXON/OXOFF - no xon/xoff flow control.
            */
-#endif
 
           /* Store the received character */
 
           *buffer++ = ch;
           recvd++;
         }
+#endif
 
 #ifdef CONFIG_DEV_SERIAL_FULLBLOCKS
       /* No... then we would have to wait to get receive more data.
@@ -1051,6 +1212,7 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
   FAR uart_dev_t   *dev      = inode->i_private;
   ssize_t           nwritten = buflen;
   bool              oktoblock;
+  size_t            nbytes;
   int               ret;
   char              ch;
 
@@ -1120,8 +1282,25 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
    */
 
   uart_disabletxint(dev);
-  for (; buflen; buflen--)
+  while (buflen > 0)
     {
+      /* Copy the characters that need no post-processing in bulk.  Only when
+       * the TX buffer is full or a character must be processed, continue
+       * with a single character below.
+       */
+
+      nbytes = uart_xmitrun(dev, buffer, buflen);
+      if (nbytes > 0)
+        {
+          nbytes = uart_putxmitbuf(dev, buffer, nbytes);
+          if (nbytes > 0)
+            {
+              buffer += nbytes;
+              buflen -= nbytes;
+              continue;
+            }
+        }
+
       ch  = *buffer++;
       ret = OK;
 
@@ -1205,6 +1384,8 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer,
 
           break;
         }
+
+      buflen--;
     }
 
   if (dev->xmit.head != dev->xmit.tail)
@@ -41,6 +41,8 @@
 
 #include <sys/types.h>
 #include <stdint.h>
+#include <string.h>
+#include <assert.h>
 #include <debug.h>
 
 #include <nuttx/serial/serial.h>
@@ -408,4 +410,123 @@ void uart_recvchars_done(FAR uart_dev_t *dev)
 }
 #endif
 
+/****************************************************************************
+ * Name: uart_recvchars_circular
+ *
+ * Description:
+ *   Move the data received by a circular DMA channel, from the last position
+ *   up to 'pos', into the RX circular buffer and wake up any threads that
+ *   may have been waiting for new data.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXDMA_CIRCULAR
+void uart_recvchars_circular(FAR uart_dev_t *dev, size_t pos)
+{
+  FAR struct uart_dmacirc_s *circ = &dev->dmacirc;
+  FAR struct uart_buffer_s *rxbuf = &dev->recv;
+  size_t nbytes = 0;
+  size_t ncopy;
+  size_t nfree;
+  int16_t head;
+  int16_t tail;
+#if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGSTP)
+  int signo = 0;
+#endif
+
+  DEBUGASSERT(pos <= circ->size);
+
+  /* The full-transfer interrupt reports the end of the DMA buffer */
+
+  if (pos >= circ->size)
+    {
+      pos = 0;
+    }
+
+  head = rxbuf->head;
+  while (circ->pos != pos)
+    {
+      /* The new data up to 'pos' or up to the end of the DMA buffer */
+
+      ncopy = (pos > circ->pos ? pos : circ->size) - circ->pos;
+
+      /* The free space up to the tail or up to the end of the RX buffer.
+       * One slot is always left empty to tell a full buffer from an empty
+       * one.
+       */
+
+      tail = rxbuf->tail;
+      if (head >= tail)
+        {
+          nfree = rxbuf->size - head - (tail == 0 ? 1 : 0);
+        }
+      else
+        {
+          nfree = tail - head - 1;
+        }
+
+      if (nfree == 0)
+        {
+#ifdef CONFIG_SERIAL_IFLOWCONTROL
+          /* Let the lower half driver pause the sender */
+
+          uart_rxflowcontrol(dev, rxbuf->size, true);
+#endif
+          break;
+        }
+
+      if (ncopy > nfree)
+        {
+          ncopy = nfree;
+        }
+
+      memcpy(&rxbuf->buffer[head], &circ->buffer[circ->pos], ncopy);
+
+#if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGSTP)
+      /* Check if the SIGINT character is in the newly received data */
+
+      if (dev->pid >= 0 && signo == 0)
+        {
+          signo = uart_check_signo(&rxbuf->buffer[head], ncopy);
+        }
+#endif
+
+      head += ncopy;
+      if (head >= rxbuf->size)
+        {
+          head = 0;
+        }
+
+      circ->pos += ncopy;
+      if (circ->pos >= circ->size)
+        {
+          circ->pos = 0;
+        }
+
+      nbytes += ncopy;
+    }
+
+  rxbuf->head = head;
+
+  /* If any bytes were added to the buffer, inform any waiters there is new
+   * incoming data available.
+   */
+
+  if (nbytes > 0)
+    {
+      uart_datareceived(dev);
+    }
+
+#if defined(CONFIG_TTY_SIGINT) || defined(CONFIG_TTY_SIGSTP)
+  /* Send the signal if necessary */
+
+  if (signo != 0)
+    {
+      kill(dev->pid, signo);
+      uart_reset_sem(dev);
+    }
+#endif
+}
+#endif
+
 #endif /* CONFIG_SERIAL_TXDMA || CONFIG_SERIAL_RXDMA */
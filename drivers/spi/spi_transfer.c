@@ -40,10 +40,12 @@
 #include <nuttx/config.h>
 
 #include <unistd.h>
+#include <string.h>
 #include <assert.h>
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
 #include <nuttx/signal.h>
 #include <nuttx/spi/spi.h>
 #include <nuttx/spi/spi_transfer.h>
@@ -51,16 +53,27 @@
 #ifdef CONFIG_SPI_EXCHANGE
 
 /****************************************************************************
- * Public Functions
+ * Pre-processor Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_SPI_QUEUE
+#  if defined(CONFIG_SPI_QUEUE_HPWORK)
+#    define SPIWORK HPWORK
+#  else
+#    define SPIWORK LPWORK
+#  endif
+#endif
+
 /****************************************************************************
- * Name: spi_transfer
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spi_sequence
  *
  * Description:
- *   This is a helper function that can be used to encapsulate and manage
- *   a sequence of SPI transfers.  The SPI bus will be locked and the
- *   SPI device selected for the duration of the transfers.
+ *   Perform a sequence of SPI transfers.  The caller holds the SPI bus
+ *   lock.
  *
  * Input Parameters:
  *   spi - An instance of the SPI device to use for the transfer
@@ -71,18 +84,13 @@
  *
  ****************************************************************************/
 
-int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq)
+static int spi_sequence(FAR struct spi_dev_s *spi,
+                        FAR struct spi_sequence_s *seq)
 {
   FAR struct spi_trans_s *trans;
   int ret = OK;
   int i;
 
-  DEBUGASSERT(spi != NULL && seq != NULL && seq->trans != NULL);
-
-  /* Get exclusive access to the SPI bus */
-
-  SPI_LOCK(spi, true);
-
   /* Establish the fixed SPI attributes for all transfers in the sequence */
 
   SPI_SETFREQUENCY(spi, seq->frequency);
@@ -92,7 +100,6 @@ int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq)
   if (ret < 0)
     {
       spierr("ERROR: SPI_SETDELAY failed: %d\n", ret);
-      SPI_LOCK(spi, false);
       return ret;
     }
 #endif
@@ -154,8 +161,207 @@ int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq)
     }
 
   SPI_SELECT(spi, seq->dev, false);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: spi_queue_worker
+ *
+ * Description:
+ *   Perform the queued messages of one SPI bus.  The bus stays locked from
+ *   the first message to the last one, so that the messages follow each
+ *   other without waiting for the bus again, including the messages that
+ *   are submitted by the callbacks.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPI_QUEUE
+static void spi_queue_worker(FAR void *arg)
+{
+  FAR struct spi_queue_s *queue = (FAR struct spi_queue_s *)arg;
+  FAR struct spi_message_s *msg;
+  irqstate_t flags;
+  int ret;
+
+  SPI_LOCK(queue->spi, true);
+
+  for (; ; )
+    {
+      flags = enter_critical_section();
+      msg   = (FAR struct spi_message_s *)sq_remfirst(&queue->pending);
+      leave_critical_section(flags);
+
+      if (msg == NULL)
+        {
+          break;
+        }
+
+      ret = spi_sequence(queue->spi, msg->seq);
+      if (msg->callback != NULL)
+        {
+          msg->callback(msg, ret, msg->arg);
+        }
+    }
+
+  SPI_LOCK(queue->spi, false);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spi_transfer
+ *
+ * Description:
+ *   This is a helper function that can be used to encapsulate and manage
+ *   a sequence of SPI transfers.  The SPI bus will be locked and the
+ *   SPI device selected for the duration of the transfers.
+ *
+ * Input Parameters:
+ *   spi - An instance of the SPI device to use for the transfer
+ *   seq - Describes the sequence of transfers.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq)
+{
+  int ret;
+
+  DEBUGASSERT(spi != NULL && seq != NULL && seq->trans != NULL);
+
+  /* Get exclusive access to the SPI bus */
+
+  SPI_LOCK(spi, true);
+  ret = spi_sequence(spi, seq);
   SPI_LOCK(spi, false);
   return ret;
 }
 
+/****************************************************************************
+ * Name: spi_queue_initialize
+ *
+ * Description:
+ *   Initialize the message queue of one SPI bus.  All of the drivers that
+ *   submit messages to that bus must share the same queue.
+ *
+ * Input Parameters:
+ *   queue - The queue to initialize
+ *   spi   - An instance of the SPI bus that the queue feeds
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPI_QUEUE
+void spi_queue_initialize(FAR struct spi_queue_s *queue,
+                          FAR struct spi_dev_s *spi)
+{
+  DEBUGASSERT(queue != NULL && spi != NULL);
+
+  memset(queue, 0, sizeof(struct spi_queue_s));
+  queue->spi = spi;
+  sq_init(&queue->pending);
+}
+
+/****************************************************************************
+ * Name: spi_queue_submit
+ *
+ * Description:
+ *   Add a message to the queue of an SPI bus and return without waiting.
+ *   The messages are performed in order on the SPI work queue, followed by
+ *   the call of their callback with the result of the message.  This may
+ *   be called from an interrupt handler, e.g. to start reading a sensor
+ *   when it reports new data.
+ *
+ * Input Parameters:
+ *   queue - The queue of the SPI bus
+ *   msg   - The message to perform
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.  The callback
+ *   is not called if the message could not be queued.
+ *
+ ****************************************************************************/
+
+int spi_queue_submit(FAR struct spi_queue_s *queue,
+                     FAR struct spi_message_s *msg)
+{
+  irqstate_t flags;
+  bool idle;
+  int ret = OK;
+
+  DEBUGASSERT(queue != NULL && msg != NULL && msg->seq != NULL &&
+              msg->seq->trans != NULL);
+
+  flags = enter_critical_section();
+
+  /* The worker performs all of the pending messages before it returns.
+   * It only has to be started if it found the queue empty.
+   */
+
+  idle = sq_empty(&queue->pending);
+  sq_addlast((FAR sq_entry_t *)msg, &queue->pending);
+
+  if (idle)
+    {
+      ret = work_queue(SPIWORK, &queue->work, spi_queue_worker, queue, 0);
+      if (ret < 0)
+        {
+          sq_rem((FAR sq_entry_t *)msg, &queue->pending);
+        }
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: spi_queue_cancel
+ *
+ * Description:
+ *   Remove a message from the queue before it is started.
+ *
+ * Input Parameters:
+ *   queue - The queue of the SPI bus
+ *   msg   - The message to remove
+ *
+ * Returned Value:
+ *   Zero (OK) if the message was removed; its callback will not be called.
+ *   -ENOENT if the message is no longer queued: It is being performed or
+ *   it already completed.
+ *
+ ****************************************************************************/
+
+int spi_queue_cancel(FAR struct spi_queue_s *queue,
+                     FAR struct spi_message_s *msg)
+{
+  FAR sq_entry_t *entry;
+  irqstate_t flags;
+  int ret = -ENOENT;
+
+  DEBUGASSERT(queue != NULL && msg != NULL);
+
+  flags = enter_critical_section();
+  for (entry = sq_peek(&queue->pending); entry != NULL;
+       entry = sq_next(entry))
+    {
+      if (entry == (FAR sq_entry_t *)msg)
+        {
+          sq_rem(entry, &queue->pending);
+          ret = OK;
+          break;
+        }
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+#endif /* CONFIG_SPI_QUEUE */
+
 #endif /* CONFIG_SPI_EXCHANGE */
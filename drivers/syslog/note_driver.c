@@ -56,6 +56,10 @@
 
 static ssize_t note_read(FAR struct file *filep, FAR char *buffer,
                  size_t buflen);
+#ifdef CONFIG_SCHED_INSTRUMENTATION_TRACE
+static int     note_ioctl(FAR struct file *filep, int cmd,
+                 unsigned long arg);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -68,7 +72,11 @@ static const struct file_operations note_fops =
   note_read,     /* read */
   NULL,          /* write */
   NULL,          /* seek */
+#ifdef CONFIG_SCHED_INSTRUMENTATION_TRACE
+  note_ioctl,    /* ioctl */
+#else
   NULL,          /* ioctl */
+#endif
   NULL           /* poll */
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , 0            /* unlink */
@@ -139,6 +147,27 @@ static ssize_t note_read(FAR struct file *filep, FAR char *buffer,
   return retlen;
 }
 
+/****************************************************************************
+ * Name: note_ioctl
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_TRACE
+static int note_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+  switch (cmd)
+    {
+      /* Set the enabled tracepoint categories */
+
+      case NOTEIOC_TRACEMASK:
+        g_note_tracemask = (uint32_t)arg;
+        return OK;
+
+      default:
+        return -ENOTTY;
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
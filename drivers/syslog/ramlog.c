@@ -80,6 +80,10 @@ struct ramlog_dev_s
 #endif
   size_t            rl_bufsize;      /* Size of the RAM buffer */
   FAR char         *rl_buffer;       /* Circular RAM buffer */
+#ifdef CONFIG_RAMLOG_OVERWRITE
+  uint32_t          rl_seq;          /* Number of bytes ever added */
+#endif
+  size_t            rl_npending;     /* Bytes added since readers notified */
 
   /* The following is a list if poll structures of threads waiting for
    * driver events. The 'struct pollfd' reference for each open is also
@@ -100,7 +104,14 @@ static int     ramlog_readnotify(FAR struct ramlog_dev_s *priv);
 #endif
 static void    ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
                                  pollevent_t eventset);
-static ssize_t ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch);
+static size_t  ramlog_addbuf(FAR struct ramlog_dev_s *priv,
+                             FAR const char *buffer, size_t len);
+static size_t  ramlog_addstring(FAR struct ramlog_dev_s *priv,
+                                FAR const char *buffer, size_t len);
+static void    ramlog_notify(FAR struct ramlog_dev_s *priv);
+static size_t  ramlog_readchunk(FAR struct ramlog_dev_s *priv,
+                                FAR struct file *filep, FAR char *buffer,
+                                size_t len);
 
 /* Character driver methods */
 
@@ -169,12 +180,17 @@ static struct ramlog_dev_s g_sysdev =
 static int ramlog_readnotify(FAR struct ramlog_dev_s *priv)
 {
   irqstate_t flags;
-  int i;
+  int nwaiters;
+  int semcount;
 
-  /* Notify all waiting readers that they can read from the FIFO */
+  /* Notify all waiting readers that they can read from the FIFO.  Readers
+   * that were already notified, but did not run yet, are not posted
+   * again.
+   */
 
   flags = enter_critical_section();
-  for (i = 0; i < priv->rl_nwaiters; i++)
+  nwaiters = priv->rl_nwaiters;
+  while (nxsem_getvalue(&priv->rl_waitsem, &semcount) >= 0 && semcount < 0)
     {
       nxsem_post(&priv->rl_waitsem);
     }
@@ -183,7 +199,7 @@ static int ramlog_readnotify(FAR struct ramlog_dev_s *priv)
 
   /* Return number of notified readers. */
 
-  return i;
+  return nwaiters;
 }
 #endif
 
@@ -209,7 +225,7 @@ static void ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
           fds->revents |= (fds->events & eventset);
           if (fds->revents != 0)
             {
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
       leave_critical_section(flags);
@@ -217,42 +233,270 @@ static void ramlog_pollnotify(FAR struct ramlog_dev_s *priv,
 }
 
 /****************************************************************************
- * Name: ramlog_addchar
+ * Name: ramlog_addbuf
+ *
+ * Description:
+ *   Copy data into the circular buffer with at most two copies, one before
+ *   and one after the end of the buffer.  The data that does not fit is
+ *   dropped or, with CONFIG_RAMLOG_OVERWRITE, the oldest data is dropped
+ *   to make room.  Returns the number of bytes added.
+ *
  ****************************************************************************/
 
-static ssize_t ramlog_addchar(FAR struct ramlog_dev_s *priv, char ch)
+static size_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
+                            FAR const char *buffer, size_t len)
 {
   irqstate_t flags;
-  size_t nexthead;
+  size_t nwritten;
+  size_t nfree;
+  size_t ncopy;
+  size_t head;
+  size_t tail;
 
   /* Disable interrupts (in case we are NOT called from interrupt handler) */
 
   flags = enter_critical_section();
 
-  /* Calculate the write index AFTER the next byte is written */
+  head = priv->rl_head;
+  tail = priv->rl_tail;
+
+  /* One slot is always left empty to tell a full buffer from an empty
+   * one.
+   */
 
-  nexthead = priv->rl_head + 1;
-  if (nexthead >= priv->rl_bufsize)
+  nfree = (tail > head ? tail - head : priv->rl_bufsize - head + tail) - 1;
+
+#ifdef CONFIG_RAMLOG_OVERWRITE
+  /* All data ever added counts, also the data that is dropped at once */
+
+  priv->rl_seq += len;
+
+  /* Only the end of data larger than the buffer is kept */
+
+  if (len > priv->rl_bufsize - 1)
     {
-      nexthead = 0;
+      buffer += len - (priv->rl_bufsize - 1);
+      len     = priv->rl_bufsize - 1;
     }
 
-  /* Would the next write overflow the circular buffer? */
+  /* Drop the oldest data to make room */
 
-  if (nexthead == priv->rl_tail)
+  if (len > nfree)
     {
-      /* Yes... Return an indication that nothing was saved in the buffer. */
+      tail += len - nfree;
+      if (tail >= priv->rl_bufsize)
+        {
+          tail -= priv->rl_bufsize;
+        }
 
-      leave_critical_section(flags);
-      return -EBUSY;
+      priv->rl_tail = tail;
+    }
+#else
+  if (len > nfree)
+    {
+      len = nfree;
+    }
+#endif
+
+  for (nwritten = 0; nwritten < len; nwritten += ncopy)
+    {
+      ncopy = priv->rl_bufsize - head;
+      if (ncopy > len - nwritten)
+        {
+          ncopy = len - nwritten;
+        }
+
+      memcpy(&priv->rl_buffer[head], &buffer[nwritten], ncopy);
+
+      head += ncopy;
+      if (head >= priv->rl_bufsize)
+        {
+          head = 0;
+        }
+    }
+
+  priv->rl_head = head;
+  priv->rl_npending += len;
+
+  leave_critical_section(flags);
+  return len;
+}
+
+/****************************************************************************
+ * Name: ramlog_addstring
+ *
+ * Description:
+ *   Add data to the RAM log with the CR/LF processing of CONFIG_RAMLOG_CRLF.
+ *   The runs of characters that need no processing are added in bulk.
+ *   Returns the number of bytes consumed from 'buffer'.
+ *
+ ****************************************************************************/
+
+static size_t ramlog_addstring(FAR struct ramlog_dev_s *priv,
+                               FAR const char *buffer, size_t len)
+{
+#ifdef CONFIG_RAMLOG_CRLF
+  size_t nwritten;
+  size_t nrun;
+
+  for (nwritten = 0; nwritten < len; )
+    {
+      /* Find the run of characters up to the next CR or LF */
+
+      for (nrun = 0;
+           nwritten + nrun < len && buffer[nwritten + nrun] != '\r' &&
+           buffer[nwritten + nrun] != '\n';
+           nrun++)
+        {
+        }
+
+      if (nrun > 0)
+        {
+          if (ramlog_addbuf(priv, &buffer[nwritten], nrun) < nrun)
+            {
+              /* The buffer is full.  The remaining data to be written is
+               * dropped on the floor.
+               */
+
+              break;
+            }
+
+          nwritten += nrun;
+          continue;
+        }
+
+      /* Ignore carriage returns and pre-pend a carriage return before a
+       * linefeed.
+       */
+
+      if (buffer[nwritten] == '\n' &&
+          ramlog_addbuf(priv, "\r\n", 2) < 2)
+        {
+          break;
+        }
+
+      nwritten++;
+    }
+
+  return nwritten;
+#else
+  return ramlog_addbuf(priv, buffer, len);
+#endif
+}
+
+/****************************************************************************
+ * Name: ramlog_notify
+ *
+ * Description:
+ *   Notify the readers and the poll waiters that data was added.
+ *
+ ****************************************************************************/
+
+static void ramlog_notify(FAR struct ramlog_dev_s *priv)
+{
+  int readers_waken = 0;
+
+  priv->rl_npending = 0;
+
+#ifndef CONFIG_RAMLOG_NONBLOCKING
+  /* Are there threads waiting for read data? */
+
+  readers_waken = ramlog_readnotify(priv);
+#endif
+
+  /* If there are multiple readers, some of them might block despite
+   * POLLIN because first reader might read all data. Favor readers
+   * and notify poll waiters only if no reader was awaken, even if the
+   * latter may starve.
+   *
+   * This also implies we do not have to make these two notify
+   * operations a critical section.
+   */
+
+  if (readers_waken == 0)
+    {
+      /* Notify all poll/select waiters that they can read from the FIFO */
+
+      ramlog_pollnotify(priv, POLLIN);
+    }
+}
+
+/****************************************************************************
+ * Name: ramlog_readchunk
+ *
+ * Description:
+ *   Copy the data up to the head or up to the end of the circular buffer.
+ *   Without CONFIG_RAMLOG_OVERWRITE, the data is removed from the buffer.
+ *   Otherwise, the position of the reader is kept in f_pos and the data is
+ *   left for the other readers.  Returns the number of bytes copied; zero
+ *   if there is nothing to read.
+ *
+ ****************************************************************************/
+
+static size_t ramlog_readchunk(FAR struct ramlog_dev_s *priv,
+                               FAR struct file *filep, FAR char *buffer,
+                               size_t len)
+{
+  irqstate_t flags;
+  size_t navail;
+  size_t start;
+  size_t used;
+#ifdef CONFIG_RAMLOG_OVERWRITE
+  uint32_t pos;
+#endif
+
+  flags = enter_critical_section();
+
+  used = priv->rl_head >= priv->rl_tail ?
+         priv->rl_head - priv->rl_tail :
+         priv->rl_bufsize - priv->rl_tail + priv->rl_head;
+
+#ifdef CONFIG_RAMLOG_OVERWRITE
+  /* A reader that fell behind the oldest data continues there */
+
+  pos = (uint32_t)filep->f_pos;
+  if (priv->rl_seq - pos > used)
+    {
+      pos = priv->rl_seq - used;
+    }
+
+  navail = priv->rl_seq - pos;
+  start  = priv->rl_head + priv->rl_bufsize - navail;
+  if (start >= priv->rl_bufsize)
+    {
+      start -= priv->rl_bufsize;
+    }
+#else
+  navail = used;
+  start  = priv->rl_tail;
+#endif
+
+  if (navail > priv->rl_bufsize - start)
+    {
+      navail = priv->rl_bufsize - start;
+    }
+
+  if (navail > len)
+    {
+      navail = len;
     }
 
-  /* No... copy the byte and re-enable interrupts */
+  memcpy(buffer, &priv->rl_buffer[start], navail);
+
+#ifdef CONFIG_RAMLOG_OVERWRITE
+  filep->f_pos = (off_t)(pos + navail);
+#else
+  start += navail;
+  if (start >= priv->rl_bufsize)
+    {
+      start = 0;
+    }
+
+  priv->rl_tail = start;
+#endif
 
-  priv->rl_buffer[priv->rl_head] = ch;
-  priv->rl_head = nexthead;
   leave_critical_section(flags);
-  return OK;
+  return navail;
 }
 
 /****************************************************************************
@@ -264,7 +508,7 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
   FAR struct inode *inode = filep->f_inode;
   FAR struct ramlog_dev_s *priv;
   ssize_t nread;
-  char ch;
+  size_t ncopy;
   int ret;
 
   /* Some sanity checking */
@@ -290,9 +534,14 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
   for (nread = 0; (size_t)nread < len; )
     {
-      /* Get the next byte from the buffer */
+      /* Get the next bytes from the buffer */
 
-      if (priv->rl_head == priv->rl_tail)
+      ncopy = ramlog_readchunk(priv, filep, &buffer[nread], len - nread);
+      if (ncopy > 0)
+        {
+          nread += ncopy;
+        }
+      else
         {
           /* The circular buffer is empty. */
 
@@ -373,26 +622,6 @@ static ssize_t ramlog_read(FAR struct file *filep, FAR char *buffer, size_t len)
             }
 #endif /* CONFIG_RAMLOG_NONBLOCKING */
         }
-      else
-        {
-          /* The circular buffer is not empty, get the next byte from the
-           * tail index.
-           */
-
-          ch = priv->rl_buffer[priv->rl_tail];
-
-          /* Increment the tail index. */
-
-          if (++priv->rl_tail >= priv->rl_bufsize)
-            {
-              priv->rl_tail = 0;
-            }
-
-          /* Add the character to the user buffer. */
-
-          buffer[nread] = ch;
-          nread++;
-        }
     }
 
   /* Relinquish the mutual exclusion semaphore */
@@ -423,95 +652,23 @@ static ssize_t ramlog_write(FAR struct file *filep, FAR const char *buffer, size
 {
   FAR struct inode *inode = filep->f_inode;
   FAR struct ramlog_dev_s *priv;
-  int readers_waken;
-  ssize_t nwritten;
-  char ch;
-  int ret;
 
   /* Some sanity checking */
 
   DEBUGASSERT(inode && inode->i_private);
   priv = (FAR struct ramlog_dev_s *)inode->i_private;
 
-  /* Loop until all of the bytes have been written.  This function may be
-   * called from an interrupt handler!  Semaphores cannot be used!
-   *
-   * The write logic only needs to modify the rl_head index.  Therefore,
-   * there is a difference in the way that rl_head and rl_tail are protected:
-   * rl_tail is protected with a semaphore; rl_head is protected by disabling
-   * interrupts.
+  /* This function may be called from an interrupt handler!  Semaphores
+   * cannot be used!  The indices are protected by disabling interrupts.
+   * If the buffer is full, the remaining data to be written is dropped on
+   * the floor.
    */
 
-  for (nwritten = 0; (size_t)nwritten < len; nwritten++)
-    {
-      /* Get the next character to output */
-
-      ch = buffer[nwritten];
-
-      /* Ignore carriage returns */
-
-#ifdef CONFIG_RAMLOG_CRLF
-      if (ch == '\r')
-        {
-          continue;
-        }
-
-      /* Pre-pend a carriage before a linefeed */
-
-      if (ch == '\n')
-        {
-          ret = ramlog_addchar(priv, '\r');
-          if (ret < 0)
-            {
-              /* The buffer is full and nothing was saved.  The remaining
-               * data to be written is dropped on the floor.
-               */
-
-              break;
-            }
-        }
-#endif
-
-      /* Then output the character */
-
-      ret = ramlog_addchar(priv, ch);
-      if (ret < 0)
-        {
-          /* The buffer is full and nothing was saved.  The remaining
-           * data to be written is dropped on the floor.
-           */
-
-          break;
-        }
-    }
-
-  /* Was anything written? */
-
-  if (nwritten > 0)
+  if (ramlog_addstring(priv, buffer, len) > 0)
     {
-      readers_waken = 0;
-
-#ifndef CONFIG_RAMLOG_NONBLOCKING
-      /* Are there threads waiting for read data? */
-
-      readers_waken = ramlog_readnotify(priv);
-#endif
-
-      /* If there are multiple readers, some of them might block despite
-       * POLLIN because first reader might read all data. Favor readers
-       * and notify poll waiters only if no reader was awaken, even if the
-       * latter may starve.
-       *
-       * This also implies we do not have to make these two notify
-       * operations a critical section.
-       */
+      /* Notify the readers once for the whole write */
 
-      if (readers_waken == 0)
-        {
-          /* Notify all poll/select waiters that they can read from the FIFO */
-
-          ramlog_pollnotify(priv, POLLIN);
-        }
+      ramlog_notify(priv);
     }
 
   /* We always have to return the number of bytes requested and NOT the
@@ -589,16 +746,25 @@ int ramlog_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
           next_head = 0;
         }
 
-      /* First, check if the receive buffer is not full. */
+      /* First, check if the receive buffer is not full.  Old data is
+       * overwritten if CONFIG_RAMLOG_OVERWRITE is selected.
+       */
 
+#ifndef CONFIG_RAMLOG_OVERWRITE
       if (next_head != priv->rl_tail)
+#endif
        {
          eventset |= POLLOUT;
        }
 
-      /* Check if the receive buffer is not empty. */
+      /* Check if the receive buffer is not empty (for this reader). */
 
+#ifdef CONFIG_RAMLOG_OVERWRITE
+      if (priv->rl_head != priv->rl_tail &&
+          (uint32_t)filep->f_pos != priv->rl_seq)
+#else
       if (priv->rl_head != priv->rl_tail)
+#endif
        {
          eventset |= POLLIN;
        }
@@ -719,61 +885,25 @@ void ramlog_syslog_register(void)
 int ramlog_putc(int ch)
 {
   FAR struct ramlog_dev_s *priv = &g_sysdev;
-  int readers_waken = 0;
-  int ret;
-
-#ifdef CONFIG_RAMLOG_CRLF
-  /* Ignore carriage returns.  But return success. */
-
-  if (ch == '\r')
-    {
-      return ch;
-    }
-
-  /* Pre-pend a newline with a carriage return */
-
-  if (ch == '\n')
-    {
-      ret = ramlog_addchar(priv, '\r');
-      if (ret < 0)
-        {
-          /* The buffer is full and nothing was saved. */
-
-          return ret;
-        }
-    }
-#endif
+  char c = (char)ch;
 
   /* Add the character to the RAMLOG */
 
-  ret = ramlog_addchar(priv, ch);
-  if (ret < 0)
+  if (ramlog_addstring(priv, &c, 1) < 1)
     {
       /* The buffer is full and 'ch' was not saved. */
 
-      return ret;
+      return -EBUSY;
     }
 
-#ifndef CONFIG_RAMLOG_NONBLOCKING
-  /* Are there threads waiting for read data? */
-
-  readers_waken = ramlog_readnotify(priv);
-#endif
-
-  /* If there are multiple readers, some of them might block despite
-   * POLLIN because first reader might read all data. Favor readers
-   * and notify poll waiters only if no reader was awaken, even if the
-   * latter may starve.
-   *
-   * This also implies we do not have to make these two notify
-   * operations a critical section.
+  /* Characters are mostly added one at a time by the SYSLOG.  Notify the
+   * readers only at the end of each line or when a quarter of the buffer
+   * was added.
    */
 
-  if (readers_waken == 0)
+  if (ch == '\n' || priv->rl_npending >= priv->rl_bufsize / 4)
     {
-      /* Notify all poll/select waiters that they can read from the FIFO */
-
-      ramlog_pollnotify(priv, POLLIN);
+      ramlog_notify(priv);
     }
 
   /* Return the character added on success */
@@ -43,6 +43,8 @@
 #include <nuttx/config.h>
 
 #include <stdbool.h>
+#include <stdarg.h>
+#include <time.h>
 
 /****************************************************************************
  * Public Data
@@ -248,6 +250,90 @@ int syslog_flush_intbuffer(FAR const struct syslog_channel_s *channel,
                            bool force);
 #endif
 
+/****************************************************************************
+ * Name: syslog_async_initialize
+ *
+ * Description:
+ *   Start the thread that drains the SYSLOG ring buffers.  Until it runs,
+ *   SYSLOG output is sent to the channel directly.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_ASYNC
+int syslog_async_initialize(void);
+#endif
+
+/****************************************************************************
+ * Name: syslog_async_write
+ *
+ * Description:
+ *   Add data to the ring buffer of this CPU and wake up the drain thread.
+ *   This never waits and may be called from any context.  The data that
+ *   does not fit into the ring is dropped and counted.
+ *
+ * Input Parameters:
+ *   buffer - The buffer containing the data to be output
+ *   buflen - The number of bytes in the buffer
+ *
+ * Returned Value:
+ *   The number of bytes buffered, or -EAGAIN if the drain thread is not
+ *   running yet.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_ASYNC
+ssize_t syslog_async_write(FAR const char *buffer, size_t buflen);
+#endif
+
+/****************************************************************************
+ * Name: syslog_async_flush
+ *
+ * Description:
+ *   Send all of the buffered data to the SYSLOG channel now.
+ *
+ * Input Parameters:
+ *   force - Use the force() method of the channel vs. the putc() method.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_ASYNC
+void syslog_async_flush(bool force);
+#endif
+
+/****************************************************************************
+ * Name: syslog_binary
+ *
+ * Description:
+ *   Record a SYSLOG message in binary form:  The address of the format
+ *   string and the raw arguments instead of the formatted text.
+ *   tools/syslogdecode.py formats the records using the ELF file.
+ *
+ * Input Parameters:
+ *   priority - The priority of the message
+ *   fmt      - The format string
+ *   ap       - The arguments
+ *   ts       - The time stamp of the message, or NULL
+ *
+ * Returned Value:
+ *   The size of the record sent to the SYSLOG channel.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SYSLOG_BINARY
+int syslog_binary(int priority, FAR const IPTR char *fmt, FAR va_list *ap,
+                  FAR const struct timespec *ts);
+#endif
+
 /****************************************************************************
  * Name: syslog_putc
  *
@@ -0,0 +1,369 @@
+/****************************************************************************
+ * drivers/syslog/syslog_async.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/syslog/syslog.h>
+
+#include "syslog.h"
+
+#ifdef CONFIG_SYSLOG_ASYNC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+#  define SYSLOG_ASYNC_NRINGS CONFIG_SMP_NCPUS
+#  define SYSLOG_ASYNC_CPU()  up_cpu_index()
+#else
+#  define SYSLOG_ASYNC_NRINGS 1
+#  define SYSLOG_ASYNC_CPU()  0
+#endif
+
+/* Without SMP, the drain thread and the writers share the same view of
+ * memory.
+ */
+
+#ifndef CONFIG_SPINLOCK
+#  define SP_DMB()
+#endif
+
+/* Room for the "[<count> bytes dropped]\n" message */
+
+#define SYSLOG_ASYNC_DROPLEN 32
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One ring buffer.  The head and tail are free-running indices:  The head
+ * is only changed by the CPU that owns the ring, with its interrupts
+ * disabled, and the tail only by the drain thread.  The number of dropped
+ * bytes only increases; the drain thread remembers how many it reported.
+ */
+
+struct syslog_async_s
+{
+  volatile uint32_t sa_head;           /* Index of the next byte written */
+  volatile uint32_t sa_tail;           /* Index of the next byte drained */
+  volatile uint32_t sa_dropped;        /* Number of bytes dropped */
+  uint32_t sa_reported;                /* Number of dropped bytes reported */
+  char sa_buffer[CONFIG_SYSLOG_ASYNC_BUFSIZE];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct syslog_async_s g_syslog_async[SYSLOG_ASYNC_NRINGS];
+
+/* Wakes up the drain thread */
+
+static sem_t g_syslog_async_sem;
+
+/* True once the drain thread is running */
+
+static bool g_syslog_async_started;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_async_output
+ *
+ * Description:
+ *   Send drained data to the SYSLOG channel.
+ *
+ ****************************************************************************/
+
+static void syslog_async_output(FAR const char *buffer, size_t buflen,
+                                bool force)
+{
+  FAR const struct syslog_channel_s *channel = g_syslog_channel;
+  size_t i;
+
+#ifdef CONFIG_SYSLOG_WRITE
+  if (!force && channel->sc_write != NULL)
+    {
+      channel->sc_write(buffer, buflen);
+      return;
+    }
+#endif
+
+  for (i = 0; i < buflen; i++)
+    {
+      if (force)
+        {
+          channel->sc_force(buffer[i]);
+        }
+      else
+        {
+          channel->sc_putc(buffer[i]);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: syslog_async_drain
+ *
+ * Description:
+ *   Send all of the data buffered in one ring to the SYSLOG channel,
+ *   followed by the number of bytes dropped since the last drain.
+ *
+ ****************************************************************************/
+
+static void syslog_async_drain(FAR struct syslog_async_s *ring, bool force)
+{
+  char msg[SYSLOG_ASYNC_DROPLEN];
+  uint32_t dropped;
+  uint32_t head;
+  uint32_t tail;
+  size_t offset;
+  size_t ncopy;
+
+  tail = ring->sa_tail;
+  while ((head = ring->sa_head) != tail)
+    {
+      /* Make sure that the data is read after the head index */
+
+      SP_DMB();
+
+      /* Up to the head or up to the end of the ring */
+
+      offset = tail % CONFIG_SYSLOG_ASYNC_BUFSIZE;
+      ncopy  = head - tail;
+      if (ncopy > CONFIG_SYSLOG_ASYNC_BUFSIZE - offset)
+        {
+          ncopy = CONFIG_SYSLOG_ASYNC_BUFSIZE - offset;
+        }
+
+      syslog_async_output(&ring->sa_buffer[offset], ncopy, force);
+
+      /* Make sure that the data is read before the space is released */
+
+      SP_DMB();
+      tail += ncopy;
+      ring->sa_tail = tail;
+    }
+
+  dropped = ring->sa_dropped;
+  if (dropped != ring->sa_reported)
+    {
+      ncopy = snprintf(msg, sizeof(msg), "[%lu bytes dropped]\n",
+                       (unsigned long)(dropped - ring->sa_reported));
+      ring->sa_reported = dropped;
+      syslog_async_output(msg, ncopy, force);
+    }
+}
+
+/****************************************************************************
+ * Name: syslog_async_main
+ *
+ * Description:
+ *   The drain thread.
+ *
+ ****************************************************************************/
+
+static int syslog_async_main(int argc, FAR char *argv[])
+{
+  int i;
+
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&g_syslog_async_sem);
+
+      for (i = 0; i < SYSLOG_ASYNC_NRINGS; i++)
+        {
+          syslog_async_drain(&g_syslog_async[i], false);
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_async_initialize
+ *
+ * Description:
+ *   Start the thread that drains the SYSLOG ring buffers.  Until it runs,
+ *   SYSLOG output is sent to the channel directly.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int syslog_async_initialize(void)
+{
+  int pid;
+
+  /* This semaphore is used for signaling and, hence, must not participate
+   * in priority inheritance.
+   */
+
+  nxsem_init(&g_syslog_async_sem, 0, 0);
+  nxsem_setprotocol(&g_syslog_async_sem, SEM_PRIO_NONE);
+
+  pid = kthread_create("syslog_async", CONFIG_SYSLOG_ASYNC_PRIORITY,
+                       CONFIG_SYSLOG_ASYNC_STACKSIZE, syslog_async_main,
+                       NULL);
+  if (pid < 0)
+    {
+      nxsem_destroy(&g_syslog_async_sem);
+      return pid;
+    }
+
+  g_syslog_async_started = true;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: syslog_async_write
+ *
+ * Description:
+ *   Add data to the ring buffer of this CPU and wake up the drain thread.
+ *   This never waits and may be called from any context.  The data that
+ *   does not fit into the ring is dropped and counted.
+ *
+ * Input Parameters:
+ *   buffer - The buffer containing the data to be output
+ *   buflen - The number of bytes in the buffer
+ *
+ * Returned Value:
+ *   The number of bytes buffered, or -EAGAIN if the drain thread is not
+ *   running yet.  The caller should then send the data to the channel
+ *   itself.
+ *
+ ****************************************************************************/
+
+ssize_t syslog_async_write(FAR const char *buffer, size_t buflen)
+{
+  FAR struct syslog_async_s *ring;
+  irqstate_t flags;
+  uint32_t head;
+  size_t nfree;
+  size_t offset;
+  size_t ncopy;
+  size_t nbytes;
+  int semcount;
+
+  if (!g_syslog_async_started)
+    {
+      return -EAGAIN;
+    }
+
+  /* Only the interrupts of this CPU are disabled:  No other CPU writes to
+   * this ring and the drain thread only moves the tail.
+   */
+
+  flags = up_irq_save();
+  ring  = &g_syslog_async[SYSLOG_ASYNC_CPU()];
+  head  = ring->sa_head;
+  nfree = CONFIG_SYSLOG_ASYNC_BUFSIZE - (head - ring->sa_tail);
+
+  nbytes = buflen;
+  if (nbytes > nfree)
+    {
+      ring->sa_dropped += nbytes - nfree;
+      nbytes = nfree;
+    }
+
+  /* At most two copies, before and after the end of the ring */
+
+  for (ncopy = 0; ncopy < nbytes; )
+    {
+      offset = (head + ncopy) % CONFIG_SYSLOG_ASYNC_BUFSIZE;
+      nfree  = nbytes - ncopy;
+      if (nfree > CONFIG_SYSLOG_ASYNC_BUFSIZE - offset)
+        {
+          nfree = CONFIG_SYSLOG_ASYNC_BUFSIZE - offset;
+        }
+
+      memcpy(&ring->sa_buffer[offset], buffer + ncopy, nfree);
+      ncopy += nfree;
+    }
+
+  /* Make sure that the data is written before the head index */
+
+  SP_DMB();
+  ring->sa_head = head + nbytes;
+  up_irq_restore(flags);
+
+  /* Wake up the drain thread if it is not already awake */
+
+  if (nbytes > 0 && nxsem_getvalue(&g_syslog_async_sem, &semcount) >= 0 &&
+      semcount <= 0)
+    {
+      nxsem_post(&g_syslog_async_sem);
+    }
+
+  return buflen;
+}
+
+/****************************************************************************
+ * Name: syslog_async_flush
+ *
+ * Description:
+ *   Send all of the buffered data to the SYSLOG channel now.  This is
+ *   called by the crash-handling logic through syslog_flush().
+ *
+ * Input Parameters:
+ *   force - Use the force() method of the channel vs. the putc() method.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void syslog_async_flush(bool force)
+{
+  int i;
+
+  for (i = 0; i < SYSLOG_ASYNC_NRINGS; i++)
+    {
+      syslog_async_drain(&g_syslog_async[i], force);
+    }
+}
+
+#endif /* CONFIG_SYSLOG_ASYNC */
@@ -0,0 +1,479 @@
+/****************************************************************************
+ * drivers/syslog/syslog_binary.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+#include <nuttx/syslog/syslog.h>
+
+#include "syslog.h"
+
+#ifdef CONFIG_SYSLOG_BINARY
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* A binary record is:
+ *
+ *   uint8_t   SYSLOG_BINARY_MAGIC
+ *   uint8_t   Flags, with the size of a pointer in bits 4-7
+ *   uint16_t  Size of the whole record
+ *   uint8_t   Priority
+ *   uintptr_t Address of the format string
+ *   uint32_t  Seconds and uint32_t microseconds, if SYSLOG_BINARY_TIMESTAMP
+ *
+ * followed by one tagged value for each argument consumed by the format.
+ * Multi-byte values are in the byte order of the target.
+ * tools/syslogdecode.py reads the format strings from the ELF file and
+ * formats the records.
+ */
+
+#define SYSLOG_BINARY_MAGIC      0xfe
+
+#define SYSLOG_BINARY_BIGENDIAN  0x01  /* The target is big-endian */
+#define SYSLOG_BINARY_TIMESTAMP  0x02  /* The record has a time stamp */
+#define SYSLOG_BINARY_TRUNCATED  0x04  /* Some arguments did not fit */
+#define SYSLOG_BINARY_PTRSHIFT   4
+
+#define SYSLOG_BINARY_HDRSIZE    (5 + sizeof(uintptr_t))
+
+/* Room for the header and the time stamp */
+
+#if CONFIG_SYSLOG_BINARY_BUFSIZE < 32
+#  error CONFIG_SYSLOG_BINARY_BUFSIZE too small
+#endif
+
+#define SYSLOG_BINARY_TAG_INT32  'i'   /* 4-byte integer */
+#define SYSLOG_BINARY_TAG_INT64  'q'   /* 8-byte integer */
+#define SYSLOG_BINARY_TAG_DOUBLE 'f'   /* 8-byte double */
+#define SYSLOG_BINARY_TAG_PTR    'p'   /* uintptr_t */
+#define SYSLOG_BINARY_TAG_STRING 's'   /* NUL-terminated string */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+enum syslog_binary_len_e
+{
+  BINARY_LEN_NONE = 0,                 /* int */
+  BINARY_LEN_CHAR,                     /* hh */
+  BINARY_LEN_SHORT,                    /* h */
+  BINARY_LEN_LONG,                     /* l */
+  BINARY_LEN_LLONG,                    /* ll */
+  BINARY_LEN_INTMAX,                   /* j */
+  BINARY_LEN_SIZE,                     /* z */
+  BINARY_LEN_PTRDIFF,                  /* t */
+  BINARY_LEN_LDOUBLE                   /* L */
+};
+
+struct syslog_binary_s
+{
+  uint8_t buffer[CONFIG_SYSLOG_BINARY_BUFSIZE];
+  size_t  len;
+  bool    full;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: binary_put
+ *
+ * Description:
+ *   Add a tag and its value to the record.  Once a value did not fit, no
+ *   more values are added.
+ *
+ ****************************************************************************/
+
+static void binary_put(FAR struct syslog_binary_s *rec, uint8_t tag,
+                       FAR const void *value, size_t size)
+{
+  if (rec->full || rec->len + 1 + size > CONFIG_SYSLOG_BINARY_BUFSIZE)
+    {
+      rec->full = true;
+      return;
+    }
+
+  rec->buffer[rec->len++] = tag;
+  memcpy(&rec->buffer[rec->len], value, size);
+  rec->len += size;
+}
+
+/****************************************************************************
+ * Name: binary_putint
+ *
+ * Description:
+ *   Add an integer of 'size' bytes to the record.
+ *
+ ****************************************************************************/
+
+static void binary_putint(FAR struct syslog_binary_s *rec, uint64_t value,
+                          size_t size)
+{
+  uint32_t value32;
+
+  if (size <= sizeof(uint32_t))
+    {
+      value32 = (uint32_t)value;
+      binary_put(rec, SYSLOG_BINARY_TAG_INT32, &value32, sizeof(value32));
+    }
+  else
+    {
+      binary_put(rec, SYSLOG_BINARY_TAG_INT64, &value, sizeof(value));
+    }
+}
+
+/****************************************************************************
+ * Name: binary_putstring
+ *
+ * Description:
+ *   Add a string to the record, truncated to the space left.
+ *
+ ****************************************************************************/
+
+static void binary_putstring(FAR struct syslog_binary_s *rec,
+                             FAR const char *str)
+{
+  size_t len;
+
+  if (str == NULL)
+    {
+      str = "(null)";
+    }
+
+  if (rec->full || rec->len + 2 > CONFIG_SYSLOG_BINARY_BUFSIZE)
+    {
+      rec->full = true;
+      return;
+    }
+
+  len = strnlen(str, CONFIG_SYSLOG_BINARY_BUFSIZE - rec->len - 2);
+
+  rec->buffer[rec->len++] = SYSLOG_BINARY_TAG_STRING;
+  memcpy(&rec->buffer[rec->len], str, len);
+  rec->len += len;
+  rec->buffer[rec->len++] = '\0';
+}
+
+/****************************************************************************
+ * Name: binary_putarg
+ *
+ * Description:
+ *   Take the argument of one integer conversion from the variable argument
+ *   list and add it to the record.
+ *
+ ****************************************************************************/
+
+static void binary_putarg(FAR struct syslog_binary_s *rec,
+                          enum syslog_binary_len_e length, bool sign,
+                          FAR va_list *ap)
+{
+  switch (length)
+    {
+      case BINARY_LEN_LONG:
+        binary_putint(rec, sign ? (uint64_t)va_arg(*ap, long) :
+                      (uint64_t)va_arg(*ap, unsigned long), sizeof(long));
+        break;
+
+      case BINARY_LEN_LLONG:
+        binary_putint(rec, sign ? (uint64_t)va_arg(*ap, long long) :
+                      (uint64_t)va_arg(*ap, unsigned long long),
+                      sizeof(long long));
+        break;
+
+      case BINARY_LEN_INTMAX:
+        binary_putint(rec, (uint64_t)va_arg(*ap, uintmax_t),
+                      sizeof(uintmax_t));
+        break;
+
+      case BINARY_LEN_SIZE:
+        binary_putint(rec, (uint64_t)va_arg(*ap, size_t), sizeof(size_t));
+        break;
+
+      case BINARY_LEN_PTRDIFF:
+        binary_putint(rec, (uint64_t)va_arg(*ap, ptrdiff_t),
+                      sizeof(ptrdiff_t));
+        break;
+
+      default:
+
+        /* char and short are promoted to int */
+
+        binary_putint(rec, sign ? (uint64_t)va_arg(*ap, int) :
+                      (uint64_t)va_arg(*ap, unsigned int), sizeof(int));
+        break;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: syslog_binary
+ *
+ * Description:
+ *   Record a SYSLOG message in binary form:  The address of the format
+ *   string and the raw arguments instead of the formatted text.  The
+ *   format string is only scanned for the types of the arguments.
+ *
+ * Input Parameters:
+ *   priority - The priority of the message
+ *   fmt      - The format string
+ *   ap       - The arguments
+ *   ts       - The time stamp of the message, or NULL
+ *
+ * Returned Value:
+ *   The size of the record sent to the SYSLOG channel.
+ *
+ ****************************************************************************/
+
+int syslog_binary(int priority, FAR const IPTR char *fmt, FAR va_list *ap,
+                  FAR const struct timespec *ts)
+{
+  struct syslog_binary_s rec;
+  enum syslog_binary_len_e length;
+  FAR const char *ptr;
+  uintptr_t addr;
+  uint32_t value32;
+  uint16_t size;
+  double dvalue;
+
+  rec.len  = SYSLOG_BINARY_HDRSIZE;
+  rec.full = false;
+
+  /* The time stamp follows the fixed header */
+
+  if (ts != NULL)
+    {
+      value32 = (uint32_t)ts->tv_sec;
+      memcpy(&rec.buffer[rec.len], &value32, sizeof(value32));
+      rec.len += sizeof(value32);
+
+      value32 = (uint32_t)(ts->tv_nsec / 1000);
+      memcpy(&rec.buffer[rec.len], &value32, sizeof(value32));
+      rec.len += sizeof(value32);
+    }
+
+  /* Take the arguments in the order of the conversions in the format */
+
+  for (ptr = fmt; *ptr != '\0' && !rec.full; ptr++)
+    {
+      if (*ptr != '%')
+        {
+          continue;
+        }
+
+      if (*++ptr == '%')
+        {
+          continue;
+        }
+
+      /* Skip the flags */
+
+      while (*ptr != '\0' && strchr("-+ #0'", *ptr) != NULL)
+        {
+          ptr++;
+        }
+
+      /* The field width and the precision may be arguments */
+
+      if (*ptr == '*')
+        {
+          binary_putint(&rec, (uint64_t)va_arg(*ap, int), sizeof(int));
+          ptr++;
+        }
+
+      while (*ptr >= '0' && *ptr <= '9')
+        {
+          ptr++;
+        }
+
+      if (*ptr == '.')
+        {
+          ptr++;
+          if (*ptr == '*')
+            {
+              binary_putint(&rec, (uint64_t)va_arg(*ap, int), sizeof(int));
+              ptr++;
+            }
+
+          while (*ptr >= '0' && *ptr <= '9')
+            {
+              ptr++;
+            }
+        }
+
+      /* The length modifier */
+
+      length = BINARY_LEN_NONE;
+      switch (*ptr)
+        {
+          case 'h':
+            length = BINARY_LEN_SHORT;
+            if (*++ptr == 'h')
+              {
+                length = BINARY_LEN_CHAR;
+                ptr++;
+              }
+            break;
+
+          case 'l':
+            length = BINARY_LEN_LONG;
+            if (*++ptr == 'l')
+              {
+                length = BINARY_LEN_LLONG;
+                ptr++;
+              }
+            break;
+
+          case 'j':
+            length = BINARY_LEN_INTMAX;
+            ptr++;
+            break;
+
+          case 'z':
+            length = BINARY_LEN_SIZE;
+            ptr++;
+            break;
+
+          case 't':
+            length = BINARY_LEN_PTRDIFF;
+            ptr++;
+            break;
+
+          case 'L':
+            length = BINARY_LEN_LDOUBLE;
+            ptr++;
+            break;
+
+          default:
+            break;
+        }
+
+      /* The conversion */
+
+      switch (*ptr)
+        {
+          case 'd':
+          case 'i':
+            binary_putarg(&rec, length, true, ap);
+            continue;
+
+          case 'c':
+          case 'u':
+          case 'o':
+          case 'x':
+          case 'X':
+            binary_putarg(&rec, length, false, ap);
+            continue;
+
+          case 'p':
+            addr = (uintptr_t)va_arg(*ap, FAR void *);
+            binary_put(&rec, SYSLOG_BINARY_TAG_PTR, &addr, sizeof(addr));
+            continue;
+
+          case 's':
+            binary_putstring(&rec, va_arg(*ap, FAR const char *));
+            continue;
+
+          case 'e':
+          case 'E':
+          case 'f':
+          case 'F':
+          case 'g':
+          case 'G':
+          case 'a':
+          case 'A':
+            if (length == BINARY_LEN_LDOUBLE)
+              {
+                dvalue = (double)va_arg(*ap, long double);
+              }
+            else
+              {
+                dvalue = va_arg(*ap, double);
+              }
+
+            binary_put(&rec, SYSLOG_BINARY_TAG_DOUBLE, &dvalue,
+                       sizeof(dvalue));
+            continue;
+
+          case 'n':
+            va_arg(*ap, FAR int *);
+            continue;
+
+          default:
+            break;
+        }
+
+      /* An unknown conversion or the end of the format.  The types of the
+       * remaining arguments are not known.
+       */
+
+      if (*ptr != '\0')
+        {
+          rec.full = true;
+        }
+
+      break;
+    }
+
+  /* Now fill in the fixed header */
+
+  rec.buffer[0] = SYSLOG_BINARY_MAGIC;
+  rec.buffer[1] = (uint8_t)(sizeof(uintptr_t) << SYSLOG_BINARY_PTRSHIFT);
+#ifdef CONFIG_ENDIAN_BIG
+  rec.buffer[1] |= SYSLOG_BINARY_BIGENDIAN;
+#endif
+  if (ts != NULL)
+    {
+      rec.buffer[1] |= SYSLOG_BINARY_TIMESTAMP;
+    }
+
+  if (rec.full)
+    {
+      rec.buffer[1] |= SYSLOG_BINARY_TRUNCATED;
+    }
+
+  size = (uint16_t)rec.len;
+  memcpy(&rec.buffer[2], &size, sizeof(size));
+  rec.buffer[4] = (uint8_t)priority;
+
+  addr = (uintptr_t)fmt;
+  memcpy(&rec.buffer[5], &addr, sizeof(addr));
+
+  syslog_write((FAR const char *)rec.buffer, rec.len);
+  return (int)rec.len;
+}
+
+#endif /* CONFIG_SYSLOG_BINARY */
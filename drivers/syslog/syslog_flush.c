@@ -89,6 +89,12 @@ int syslog_flush(void)
   syslog_flush_intbuffer(g_syslog_channel, true);
 #endif
 
+#ifdef CONFIG_SYSLOG_ASYNC
+  /* Flush the data that the drain thread did not send yet */
+
+  syslog_async_flush(true);
+#endif
+
   /* Then flush all of the buffered output to the SYSLOG device */
 
   if (g_syslog_channel->sc_flush != NULL)
@@ -106,6 +106,15 @@ int syslog_initialize(void)
   syslog_rpmsg_init();
 #endif
 
+#ifdef CONFIG_SYSLOG_ASYNC
+  /* Start the drain thread after the channel is ready */
+
+  if (ret >= 0)
+    {
+      ret = syslog_async_initialize();
+    }
+#endif
+
   return ret;
 }
 
@@ -130,6 +130,16 @@ static ssize_t syslog_default_write(FAR const char *buffer, size_t buflen)
 
 ssize_t syslog_write(FAR const char *buffer, size_t buflen)
 {
+#ifdef CONFIG_SYSLOG_ASYNC
+  /* Leave the output to the drain thread once it is running */
+
+  ssize_t ret = syslog_async_write(buffer, buflen);
+  if (ret >= 0)
+    {
+      return ret;
+    }
+#endif
+
 #ifdef CONFIG_SYSLOG_INTBUFFER
   if (!up_interrupt_context() && !sched_idletask())
     {
@@ -140,5 +150,6 @@ ssize_t syslog_write(FAR const char *buffer, size_t buflen)
       syslog_flush_intbuffer(g_syslog_channel, false);
     }
 #endif
+
   return syslog_default_write(buffer, buflen);
 }
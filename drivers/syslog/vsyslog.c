@@ -50,6 +50,8 @@
 #include <nuttx/streams.h>
 #include <nuttx/syslog/syslog.h>
 
+#include "syslog.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -111,6 +113,22 @@ int nx_vsyslog(int priority, FAR const IPTR char *fmt, FAR va_list *ap)
     }
 #endif
 
+#ifdef CONFIG_SYSLOG_BINARY
+  /* Record the message in binary form, to be formatted off-target.
+   * Emergency messages are still formatted so that they can be read as
+   * they are.
+   */
+
+  if (priority != LOG_EMERG)
+    {
+#ifdef CONFIG_SYSLOG_TIMESTAMP
+      return syslog_binary(priority, fmt, ap, &ts);
+#else
+      return syslog_binary(priority, fmt, ap, NULL);
+#endif
+    }
+#endif
+
   /* Wrap the low-level output in a stream object and let lib_vsprintf
    * do the work.  NOTE that emergency priority output is handled
    * differently.. it will use the SYSLOG emergency stream.
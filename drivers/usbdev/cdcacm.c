@@ -324,26 +324,37 @@ static uint16_t cdcacm_fillrequest(FAR struct cdcacm_dev_s *priv,
   FAR struct uart_buffer_s *xmit = &serdev->xmit;
   irqstate_t flags;
   uint16_t nbytes = 0;
+  uint16_t ncopy;
+  int16_t tail;
 
   /* Disable interrupts */
 
   flags = enter_critical_section();
 
   /* Transfer bytes while we have bytes available and there is room in the
-   * request.
+   * request.  The data is copied in (at most two) contiguous runs: up to
+   * the head or up to the end of the circular buffer.
    */
 
   while (xmit->head != xmit->tail && nbytes < reqlen)
     {
-      *reqbuf++ = xmit->buffer[xmit->tail];
-      nbytes++;
+      tail  = xmit->tail;
+      ncopy = (xmit->head > tail ? xmit->head : xmit->size) - tail;
+      ncopy = MIN(ncopy, reqlen - nbytes);
+
+      memcpy(reqbuf, &xmit->buffer[tail], ncopy);
+      reqbuf += ncopy;
+      nbytes += ncopy;
 
-      /* Increment the tail pointer */
+      /* Advance the tail pointer */
 
-      if (++(xmit->tail) >= xmit->size)
+      tail += ncopy;
+      if (tail >= xmit->size)
         {
-          xmit->tail = 0;
+          tail = 0;
         }
+
+      xmit->tail = tail;
     }
 
   /* When all of the characters have been sent from the buffer disable the
@@ -478,6 +489,9 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
   FAR uint8_t *reqbuf;
 #ifdef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
   unsigned int watermark;
+#else
+  uint16_t ncopy;
+  int16_t head;
 #endif
   uint16_t reqlen;
   uint16_t nexthead;
@@ -537,10 +551,42 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
    * proper way to throttle a serial device.
    */
 
+#ifndef CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS
+  /* Without watermarks there is nothing to check per byte.  Copy the data
+   * in contiguous runs: up to the byte before the tail or up to the end of
+   * the circular buffer.
+   */
+
   while (nexthead != recv->tail && nbytes < reqlen)
     {
-#if defined(CONFIG_SERIAL_IFLOWCONTROL) && \
-    defined(CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS)
+      head  = recv->head;
+      ncopy = recv->tail > head ? recv->tail - head - 1 :
+              recv->size - head - (recv->tail == 0 ? 1 : 0);
+      ncopy = MIN(ncopy, reqlen - nbytes);
+
+      memcpy(&recv->buffer[head], reqbuf, ncopy);
+      reqbuf += ncopy;
+      nbytes += ncopy;
+
+      /* Advance the head index and check for wrap around */
+
+      head += ncopy;
+      if (head >= recv->size)
+        {
+          head = 0;
+        }
+
+      recv->head = head;
+      nexthead   = head + 1;
+      if (nexthead >= recv->size)
+        {
+          nexthead = 0;
+        }
+    }
+#else
+  while (nexthead != recv->tail && nbytes < reqlen)
+    {
+#if defined(CONFIG_SERIAL_IFLOWCONTROL)
       unsigned int nbuffered;
 
       /* How many bytes are buffered */
@@ -584,6 +630,7 @@ static int cdcacm_recvpacket(FAR struct cdcacm_dev_s *priv,
           nexthead = 0;
         }
     }
+#endif
 
 #if defined(CONFIG_SERIAL_IFLOWCONTROL) && \
     !defined(CONFIG_SERIAL_IFLOWCONTROL_WATERMARKS)
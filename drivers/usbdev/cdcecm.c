@@ -502,11 +502,13 @@ static void cdcecm_receive(FAR struct cdcecm_driver_s *self)
    * configuration.
    */
 
-  /* Copy the data data from the hardware to self->dev.d_buf.  Set
+  /* The network stack processes the frame in the buffer of the read
+   * request (which is one full packet in size) instead of a copy of it in
+   * self->pktbuf.  The request is not resubmitted until this returns.  Set
    * amount of data in self->dev.d_len
    */
 
-  memcpy(self->dev.d_buf, self->rdreq->buf, self->rdreq->xfrd);
+  self->dev.d_buf = self->rdreq->buf;
   self->dev.d_len = self->rdreq->xfrd;
 
 #ifdef CONFIG_NET_PKT
@@ -574,6 +576,10 @@ static void cdcecm_receive(FAR struct cdcecm_driver_s *self)
     {
       NETDEV_RXDROPPED(&self->dev);
     }
+
+  /* Any reply has been sent.  Polls build their packets in pktbuf. */
+
+  self->dev.d_buf = self->pktbuf;
 }
 
 /****************************************************************************
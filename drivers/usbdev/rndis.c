@@ -78,6 +78,15 @@
   (CONFIG_NET_ETH_PKTSIZE + CONFIG_NET_GUARDSIZE + RNDIS_PACKET_HDR_SIZE)
 #define CONFIG_RNDIS_BULKOUT_REQLEN CONFIG_RNDIS_BULKIN_REQLEN
 
+/* The bulk OUT read request takes a whole RNDIS packet message, including
+ * the extra byte that the host sends when the message length is a multiple
+ * of the packet size.  Its length is a multiple of every valid bulk packet
+ * size, so a transfer can only end at a packet boundary.
+ */
+
+#define RNDIS_RDREQ_LEN \
+  (((CONFIG_RNDIS_BULKOUT_REQLEN + 1) + 511) & ~511)
+
 #define RNDIS_NCONFIGS          (1)
 #define RNDIS_CONFIGID          (1)
 #define RNDIS_CONFIGIDNONE      (0)
@@ -508,7 +517,7 @@ static int rndis_submit_rdreq(FAR struct rndis_dev_s *priv)
 
   if (!priv->rdreq_submitted && !priv->rx_blocked)
     {
-      priv->rdreq->len = priv->epbulkout->maxpacket;
+      priv->rdreq->len = RNDIS_RDREQ_LEN;
       ret = EP_SUBMIT(priv->epbulkout, priv->rdreq);
       if (ret != OK)
         {
@@ -1262,9 +1271,17 @@ static inline int rndis_recvpacket(FAR struct rndis_dev_s *priv,
               priv->current_rx_datagram_offset = msg->dataoffset + 8;
               if (priv->current_rx_datagram_offset < reqlen)
                 {
+                  /* The transfer usually holds the whole message.  Copy no
+                   * more than the datagram and the network buffer holds.
+                   */
+
+                  size_t copysize =
+                    min(reqlen - priv->current_rx_datagram_offset,
+                        priv->current_rx_datagram_size);
+
                   memcpy(&priv->rx_req->req->buf[RNDIS_PACKET_HDR_SIZE],
                          &reqbuf[priv->current_rx_datagram_offset],
-                         reqlen - priv->current_rx_datagram_offset);
+                         min(copysize, CONFIG_NET_ETH_PKTSIZE));
                 }
             }
           else
@@ -2123,14 +2140,11 @@ static int usbclass_bind(FAR struct usbdevclass_driver_s *driver,
 
   priv->epbulkout->priv = priv;
 
-  /* Pre-allocate read requests.  The buffer size is one full packet. */
-
-  reqlen = 64;
+  /* Pre-allocate the read request.  The buffer size is one full packet
+   * message, so each message is received with one transfer.
+   */
 
-  if (CONFIG_RNDIS_BULKOUT_REQLEN > reqlen)
-    {
-      reqlen = CONFIG_RNDIS_BULKOUT_REQLEN;
-    }
+  reqlen = RNDIS_RDREQ_LEN;
 
   priv->rdreq = usbclass_allocreq(priv->epbulkout, reqlen);
   if (priv->rdreq == NULL)
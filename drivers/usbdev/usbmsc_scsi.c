@@ -163,6 +163,7 @@ static inline int usbmsc_setupcmd(FAR struct usbmsc_dev_s *priv,
 static int    usbmsc_idlestate(FAR struct usbmsc_dev_s *priv);
 static int    usbmsc_cmdparsestate(FAR struct usbmsc_dev_s *priv);
 static int    usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv);
+static int    usbmsc_writesectors(FAR struct usbmsc_dev_s *priv);
 static int    usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv);
 static int    usbmsc_cmdfinishstate(FAR struct usbmsc_dev_s *priv);
 static int    usbmsc_cmdstatusstate(FAR struct usbmsc_dev_s *priv);
@@ -2187,7 +2188,9 @@ static int usbmsc_cmdparsestate(FAR struct usbmsc_dev_s *priv)
  * State variables:
  *   xfrlen     - holds the number of sectors read to be read.
  *   sector     - holds the sector number of the next sector to be read
- *   nsectbytes - holds the number of bytes buffered for the current sector
+ *   niobytes   - holds the number of bytes read into the I/O buffer
+ *   nsectbytes - holds the number of bytes in the I/O buffer that have not
+ *                been copied to a request yet
  *   nreqbytes  - holds the number of bytes currently buffered in the request
  *                at the head of the wrreqlist.
  *
@@ -2200,6 +2203,7 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
   FAR struct usbdev_req_s *req;
   irqstate_t flags;
   ssize_t nread;
+  uint32_t nsectors;
   uint8_t *src;
   uint8_t *dest;
   int nbytes;
@@ -2218,10 +2222,15 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
 
       if (priv->nsectbytes <= 0)
         {
-          /* Yes.. read the next sector */
+          /* Yes.. read as many of the next sectors as the I/O buffer holds.
+           * The requests already submitted are sent by the USB controller
+           * meanwhile.
+           */
 
-          nread = USBMSC_DRVR_READ(lun, priv->iobuffer, priv->sector, 1);
-          if (nread < 0)
+          nsectors = MIN(priv->u.xfrlen, priv->iosize / lun->sectorsize);
+          nread    = USBMSC_DRVR_READ(lun, priv->iobuffer, priv->sector,
+                                      nsectors);
+          if (nread <= 0)
             {
               usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDREADREADFAIL),
                        -nread);
@@ -2230,9 +2239,10 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
               break;
             }
 
-          priv->nsectbytes = lun->sectorsize;
-          priv->u.xfrlen--;
-          priv->sector++;
+          priv->niobytes   = (uint32_t)nread * lun->sectorsize;
+          priv->nsectbytes = priv->niobytes;
+          priv->u.xfrlen  -= nread;
+          priv->sector    += nread;
         }
 
       /* Check if there is a request in the wrreqlist that we will be able to
@@ -2260,7 +2270,7 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
        * OR (2) all of the data available in the sector buffer.
        */
 
-      src    = &priv->iobuffer[lun->sectorsize - priv->nsectbytes];
+      src    = &priv->iobuffer[priv->niobytes - priv->nsectbytes];
       dest   = &req->buf[priv->nreqbytes];
 
       nbytes = MIN(priv->epbulkin->maxpacket - priv->nreqbytes,
@@ -2321,6 +2331,44 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
   return OK;
 }
 
+/****************************************************************************
+ * Name: usbmsc_writesectors
+ *
+ * Description:
+ *   Write the complete sectors buffered in the I/O buffer by
+ *   usbmsc_cmdwritestate() to the block driver.
+ *
+ ****************************************************************************/
+
+static int usbmsc_writesectors(FAR struct usbmsc_dev_s *priv)
+{
+  FAR struct usbmsc_lun_s *lun = priv->lun;
+  ssize_t nwritten;
+  uint32_t nsectors;
+
+  nsectors = priv->nsectbytes / lun->sectorsize;
+  if (nsectors == 0)
+    {
+      return OK;
+    }
+
+  nwritten = USBMSC_DRVR_WRITE(lun, priv->iobuffer, priv->sector, nsectors);
+  if (nwritten < (ssize_t)nsectors)
+    {
+      usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDWRITEWRITEFAIL),
+               nwritten < 0 ? -nwritten : 0);
+      lun->sd     = SCSI_KCQME_WRITEFAULTAUTOREALLOCFAILED;
+      lun->sdinfo = priv->sector + (nwritten > 0 ? nwritten : 0);
+      return nwritten < 0 ? (int)nwritten : -EIO;
+    }
+
+  priv->nsectbytes = 0;
+  priv->residue   -= nsectors * lun->sectorsize;
+  priv->u.xfrlen  -= nsectors;
+  priv->sector    += nsectors;
+  return OK;
+}
+
 /****************************************************************************
  * Name: usbmsc_cmdwritestate
  *
@@ -2341,7 +2389,7 @@ static int usbmsc_cmdreadstate(FAR struct usbmsc_dev_s *priv)
  * State variables:
  *   xfrlen     - holds the number of sectors read to be written.
  *   sector     - holds the sector number of the next sector to write
- *   nsectbytes - holds the number of bytes buffered for the current sector
+ *   nsectbytes - holds the number of bytes buffered for the next sectors
  *   nreqbytes  - holds the number of untransferred bytes currently in the
  *                request at the head of the rdreqlist.
  *
@@ -2352,7 +2400,7 @@ static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
   FAR struct usbmsc_lun_s *lun = priv->lun;
   FAR struct usbmsc_req_s *privreq;
   FAR struct usbdev_req_s *req;
-  ssize_t nwritten;
+  uint32_t iobytes;
   uint16_t xfrd;
   uint8_t *src;
   uint8_t *dest;
@@ -2400,12 +2448,19 @@ static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
 
       while (priv->nreqbytes > 0 && priv->u.xfrlen > 0)
         {
+          /* The I/O buffer collects as many of the remaining sectors as it
+           * holds, so that they are written with one block driver access.
+           */
+
+          iobytes = MIN(priv->u.xfrlen, priv->iosize / lun->sectorsize) *
+                    lun->sectorsize;
+
           /* Copy the data received in the read request into the sector I/O buffer */
 
           src  = &req->buf[xfrd - priv->nreqbytes];
           dest = &priv->iobuffer[priv->nsectbytes];
 
-          nbytes = MIN(lun->sectorsize - priv->nsectbytes, priv->nreqbytes);
+          nbytes = MIN(iobytes - priv->nsectbytes, priv->nreqbytes);
 
           /* Copy the data from the sector buffer to the USB request and update counts */
 
@@ -2415,25 +2470,14 @@ static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
 
           /* Is the I/O buffer full? */
 
-          if (priv->nsectbytes >= lun->sectorsize)
+          if (priv->nsectbytes >= iobytes)
             {
-              /* Yes.. Write the next sector */
+              /* Yes.. Write the buffered sectors */
 
-              nwritten = USBMSC_DRVR_WRITE(lun, priv->iobuffer,
-                                           priv->sector, 1);
-              if (nwritten < 0)
+              if (usbmsc_writesectors(priv) < 0)
                 {
-                  usbtrace(TRACE_CLSERROR(USBMSC_TRACEERR_CMDWRITEWRITEFAIL),
-                           -nwritten);
-                  lun->sd     = SCSI_KCQME_WRITEFAULTAUTOREALLOCFAILED;
-                  lun->sdinfo = priv->sector;
                   goto errout;
                 }
-
-              priv->nsectbytes = 0;
-              priv->residue   -= lun->sectorsize;
-              priv->u.xfrlen--;
-              priv->sector++;
             }
         }
 
@@ -2457,7 +2501,10 @@ static int usbmsc_cmdwritestate(FAR struct usbmsc_dev_s *priv)
 
       if (xfrd != priv->epbulkout->maxpacket)
         {
+          /* Write the complete sectors that were received */
+
           priv->shortpacket = 1;
+          usbmsc_writesectors(priv);
           goto errout;
         }
     }
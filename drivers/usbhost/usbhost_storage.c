@@ -40,6 +40,7 @@
 #include <nuttx/scsi.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/drivers/rwbuffer.h>
 
 #include <nuttx/usb/usb.h>
 #include <nuttx/usb/usbhost.h>
@@ -75,6 +76,16 @@
 #  error "Currently limited to 26 devices /dev/sda-z"
 #endif
 
+/* The maximum number of sectors transferred by one READ10/WRITE10 */
+
+#ifndef CONFIG_USBHOST_MSC_MAXSECTORS
+#  define CONFIG_USBHOST_MSC_MAXSECTORS 240
+#endif
+
+#ifndef CONFIG_USBHOST_MSC_RHSECTORS
+#  define CONFIG_USBHOST_MSC_RHSECTORS 16
+#endif
+
 /* Driver support ***********************************************************/
 
 /* This format is used to construct the /dev/sd[n] device driver path.  It
@@ -123,6 +134,9 @@ struct usbhost_state_s
   size_t                  tbuflen;      /* Size of the allocated transfer buffer */
   usbhost_ep_t            bulkin;       /* Bulk IN endpoint */
   usbhost_ep_t            bulkout;      /* Bulk OUT endpoint */
+#ifdef CONFIG_USBHOST_MSC_READAHEAD
+  struct rwbuffer_s       rwbuffer;     /* Read-ahead buffer */
+#endif
 };
 
 /* This is how struct usbhost_state_s looks to the free list logic */
@@ -214,6 +228,18 @@ static inline int usbhost_tfree(FAR struct usbhost_state_s *priv);
 static FAR struct usbmsc_cbw_s *
        usbhost_cbwalloc(FAR struct usbhost_state_s *priv);
 
+/* Sector transfers */
+
+static ssize_t usbhost_xfersectors(FAR struct usbhost_state_s *priv,
+                                   FAR uint8_t *buffer, off_t startsector,
+                                   size_t nsectors, bool in);
+#ifdef CONFIG_USBHOST_MSC_READAHEAD
+static ssize_t usbhost_reload(FAR void *dev, FAR uint8_t *buffer,
+                              off_t startsector, size_t nsectors);
+static ssize_t usbhost_flush(FAR void *dev, FAR const uint8_t *buffer,
+                             off_t startsector, size_t nsectors);
+#endif
+
 /* struct usbhost_registry_s methods */
 
 static struct usbhost_class_s *
@@ -960,6 +986,9 @@ static void usbhost_destroy(FAR void *arg)
   /* Free any transfer buffers */
 
   usbhost_tfree(priv);
+#ifdef CONFIG_USBHOST_MSC_READAHEAD
+  rwb_uninitialize(&priv->rwbuffer);
+#endif
 
   /* Destroy the semaphores */
 
@@ -1361,6 +1390,29 @@ static inline int usbhost_initvolume(FAR struct usbhost_state_s *priv)
         }
     }
 
+#ifdef CONFIG_USBHOST_MSC_READAHEAD
+  /* Set up the read-ahead buffer.  Writes go straight to the device. */
+
+  if (ret >= 0)
+    {
+      priv->rwbuffer.blocksize   = priv->blocksize;
+      priv->rwbuffer.nblocks     = priv->nblocks;
+      priv->rwbuffer.rhmaxblocks = CONFIG_USBHOST_MSC_RHSECTORS;
+#ifdef CONFIG_DRVR_WRITEBUFFER
+      priv->rwbuffer.wrmaxblocks = 0;
+#endif
+      priv->rwbuffer.dev         = priv;
+      priv->rwbuffer.rhreload    = usbhost_reload;
+      priv->rwbuffer.wrflush     = usbhost_flush;
+
+      ret = rwb_initialize(&priv->rwbuffer);
+      if (ret < 0)
+        {
+          uerr("ERROR: Read-ahead buffer setup failed: %d\n", ret);
+        }
+    }
+#endif
+
   /* Register the block driver */
 
   if (ret >= 0)
@@ -1674,6 +1726,133 @@ static FAR struct usbmsc_cbw_s *
   return cbw;
 }
 
+/****************************************************************************
+ * Name: usbhost_xfersectors
+ *
+ * Description:
+ *   Transfer sectors between the device and a buffer with as few
+ *   READ10/WRITE10 commands as possible.  Each command moves up to
+ *   CONFIG_USBHOST_MSC_MAXSECTORS sectors.  The caller holds exclsem.
+ *
+ * Input Parameters:
+ *   priv        - The USB mass storage class instance
+ *   buffer      - The data to write or the buffer to read into
+ *   startsector - The first sector to transfer
+ *   nsectors    - The number of sectors to transfer
+ *   in          - True: read from the device; false: write to the device
+ *
+ * Returned Value:
+ *   The number of sectors transferred on success; a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+static ssize_t usbhost_xfersectors(FAR struct usbhost_state_s *priv,
+                                   FAR uint8_t *buffer, off_t startsector,
+                                   size_t nsectors, bool in)
+{
+  FAR struct usbhost_hubport_s *hport = priv->usbclass.hport;
+  FAR struct usbmsc_cbw_s *cbw;
+  FAR struct usbmsc_csw_s *csw;
+  size_t remaining;
+  size_t count;
+  ssize_t nbytes;
+
+  for (remaining = nsectors; remaining > 0; remaining -= count)
+    {
+      count = remaining;
+      if (count > CONFIG_USBHOST_MSC_MAXSECTORS)
+        {
+          count = CONFIG_USBHOST_MSC_MAXSECTORS;
+        }
+
+      /* Loop in the event that EAGAIN is returned (mean that the
+       * transaction was NAKed and we should try again.
+       */
+
+      do
+        {
+          /* Construct and send the CBW (re-using the allocated transfer
+           * buffer)
+           */
+
+          cbw = usbhost_cbwalloc(priv);
+          if (in)
+            {
+              usbhost_readcbw(startsector, priv->blocksize, count, cbw);
+            }
+          else
+            {
+              usbhost_writecbw(startsector, priv->blocksize, count, cbw);
+            }
+
+          nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
+                                 (FAR uint8_t *)cbw, USBMSC_CBW_SIZEOF);
+          if (nbytes >= 0)
+            {
+              /* Transfer the user data */
+
+              nbytes = DRVR_TRANSFER(hport->drvr,
+                                     in ? priv->bulkin : priv->bulkout,
+                                     buffer, priv->blocksize * count);
+              if (nbytes >= 0)
+                {
+                  /* Receive the CSW */
+
+                  nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
+                                         priv->tbuffer, USBMSC_CSW_SIZEOF);
+                }
+            }
+        }
+      while (nbytes == -EAGAIN);
+
+      if (nbytes < 0)
+        {
+          return nbytes;
+        }
+
+      /* Check the CSW status */
+
+      csw = (FAR struct usbmsc_csw_s *)priv->tbuffer;
+      if (csw->status != 0)
+        {
+          uerr("ERROR: CSW status error: %d\n", csw->status);
+          return -ENODEV;
+        }
+
+      buffer      += priv->blocksize * count;
+      startsector += count;
+    }
+
+  return nsectors;
+}
+
+#ifdef CONFIG_USBHOST_MSC_READAHEAD
+/****************************************************************************
+ * Name: usbhost_reload and usbhost_flush
+ *
+ * Description:
+ *   The read-ahead buffer callbacks.  They are only called from
+ *   usbhost_read() and usbhost_write() with exclsem held.
+ *
+ ****************************************************************************/
+
+static ssize_t usbhost_reload(FAR void *dev, FAR uint8_t *buffer,
+                              off_t startsector, size_t nsectors)
+{
+  return usbhost_xfersectors((FAR struct usbhost_state_s *)dev, buffer,
+                             startsector, nsectors, true);
+}
+
+static ssize_t usbhost_flush(FAR void *dev, FAR const uint8_t *buffer,
+                             off_t startsector, size_t nsectors)
+{
+  return usbhost_xfersectors((FAR struct usbhost_state_s *)dev,
+                             (FAR uint8_t *)buffer, startsector, nsectors,
+                             false);
+}
+#endif
+
 /****************************************************************************
  * Name: usbhost_create
  *
@@ -2012,15 +2191,11 @@ static ssize_t usbhost_read(FAR struct inode *inode, unsigned char *buffer,
                             size_t startsector, unsigned int nsectors)
 {
   FAR struct usbhost_state_s *priv;
-  FAR struct usbhost_hubport_s *hport;
-  ssize_t nbytes = 0;
-  int ret;
+  ssize_t ret = 0;
 
   DEBUGASSERT(inode && inode->i_private);
   priv = (FAR struct usbhost_state_s *)inode->i_private;
-
   DEBUGASSERT(priv->usbclass.hport);
-  hport = priv->usbclass.hport;
 
   uinfo("startsector: %d nsectors: %d sectorsize: %d\n",
         startsector, nsectors, priv->blocksize);
@@ -2034,73 +2209,31 @@ static ssize_t usbhost_read(FAR struct inode *inode, unsigned char *buffer,
        * attempt to read from the device.
        */
 
-      nbytes = -ENODEV;
+      ret = -ENODEV;
     }
   else if (nsectors > 0)
     {
-      FAR struct usbmsc_cbw_s *cbw;
-
       ret = usbhost_takesem(&priv->exclsem);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* Assume allocation failure */
-
-      nbytes = -ENOMEM;
-
-      /* Initialize a CBW (re-using the allocated transfer buffer) */
+#ifdef CONFIG_USBHOST_MSC_READAHEAD
+      /* Small requests go through the read-ahead buffer.  Larger ones
+       * would gain nothing from it and are read directly into the user
+       * buffer.
+       */
 
-      cbw = usbhost_cbwalloc(priv);
-      if (cbw)
+      if (nsectors < CONFIG_USBHOST_MSC_RHSECTORS)
         {
-          /* Loop in the event that EAGAIN is returned (mean that the
-           * transaction was NAKed and we should try again.
-           */
-
-          do
-            {
-              /* Assume some device failure */
-
-              nbytes = -ENODEV;
-
-              /* Construct and send the CBW */
-
-              usbhost_readcbw(startsector, priv->blocksize, nsectors, cbw);
-              nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
-                                     (FAR uint8_t *)cbw, USBMSC_CBW_SIZEOF);
-              if (nbytes >= 0)
-                {
-                  /* Receive the user data */
-
-                  nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
-                                         buffer, priv->blocksize * nsectors);
-                  if (nbytes >= 0)
-                    {
-                      /* Receive the CSW */
-
-                      nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
-                                             priv->tbuffer,
-                                             USBMSC_CSW_SIZEOF);
-                      if (nbytes >= 0)
-                        {
-                          FAR struct usbmsc_csw_s *csw;
-
-                          /* Check the CSW status */
-
-                          csw = (FAR struct usbmsc_csw_s *)priv->tbuffer;
-                          if (csw->status != 0)
-                            {
-                              uerr("ERROR: CSW status error: %d\n",
-                                   csw->status);
-                              nbytes = -ENODEV;
-                            }
-                        }
-                    }
-                }
-            }
-          while (nbytes == -EAGAIN);
+          ret = rwb_read(&priv->rwbuffer, startsector, nsectors, buffer);
+        }
+      else
+#endif
+        {
+          ret = usbhost_xfersectors(priv, buffer, startsector, nsectors,
+                                    true);
         }
 
       usbhost_givesem(&priv->exclsem);
@@ -2108,7 +2241,7 @@ static ssize_t usbhost_read(FAR struct inode *inode, unsigned char *buffer,
 
   /* On success, return the number of blocks read */
 
-  return nbytes < 0 ? (int)nbytes : nsectors;
+  return ret;
 }
 
 /****************************************************************************
@@ -2125,17 +2258,14 @@ static ssize_t usbhost_write(FAR struct inode *inode,
                              size_t startsector, unsigned int nsectors)
 {
   FAR struct usbhost_state_s *priv;
-  FAR struct usbhost_hubport_s *hport;
-  ssize_t nbytes;
-  int ret;
-
-  uinfo("sector: %d nsectors: %d sectorsize: %d\n");
+  ssize_t ret;
 
   DEBUGASSERT(inode && inode->i_private);
   priv = (FAR struct usbhost_state_s *)inode->i_private;
-
   DEBUGASSERT(priv->usbclass.hport);
-  hport = priv->usbclass.hport;
+
+  uinfo("startsector: %d nsectors: %d sectorsize: %d\n",
+        startsector, nsectors, priv->blocksize);
 
   /* Check if the mass storage device is still connected */
 
@@ -2146,72 +2276,33 @@ static ssize_t usbhost_write(FAR struct inode *inode,
        * attempt to write to the device.
        */
 
-      nbytes = -ENODEV;
+      ret = -ENODEV;
     }
   else
     {
-      FAR struct usbmsc_cbw_s *cbw;
-
       ret = usbhost_takesem(&priv->exclsem);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* Assume allocation failure */
-
-      nbytes = -ENOMEM;
-
-      /* Initialize a CBW (re-using the allocated transfer buffer) */
-
-      cbw = usbhost_cbwalloc(priv);
-      if (cbw)
-        {
-          /* Assume some device failure */
-
-          nbytes = -ENODEV;
-
-          /* Construct and send the CBW */
-
-          usbhost_writecbw(startsector, priv->blocksize, nsectors, cbw);
-          nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
-                                 (FAR uint8_t *)cbw, USBMSC_CBW_SIZEOF);
-          if (nbytes >= 0)
-            {
-              /* Send the user data */
-
-              nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkout,
-                                     (FAR uint8_t *)buffer,
-                                     priv->blocksize * nsectors);
-              if (nbytes >= 0)
-                {
-                  /* Receive the CSW */
+#ifdef CONFIG_USBHOST_MSC_READAHEAD
+      /* Drop any overlapping data from the read-ahead buffer, then write
+       * through to the device.
+       */
 
-                  nbytes = DRVR_TRANSFER(hport->drvr, priv->bulkin,
-                                         priv->tbuffer, USBMSC_CSW_SIZEOF);
-                  if (nbytes >= 0)
-                    {
-                      FAR struct usbmsc_csw_s *csw;
-
-                      /* Check the CSW status */
-
-                      csw = (FAR struct usbmsc_csw_s *)priv->tbuffer;
-                      if (csw->status != 0)
-                        {
-                          uerr("ERROR: CSW status error: %d\n", csw->status);
-                          nbytes = -ENODEV;
-                        }
-                    }
-                }
-            }
-        }
+      ret = rwb_write(&priv->rwbuffer, startsector, nsectors, buffer);
+#else
+      ret = usbhost_xfersectors(priv, (FAR uint8_t *)buffer, startsector,
+                                nsectors, false);
+#endif
 
       usbhost_givesem(&priv->exclsem);
     }
 
   /* On success, return the number of blocks written */
 
-  return nbytes < 0 ? (int)nbytes : nsectors;
+  return ret;
 }
 
 /****************************************************************************
@@ -84,6 +84,10 @@ static ssize_t fb_write(FAR struct file *filep, FAR const char *buffer,
                  size_t buflen);
 static off_t   fb_seek(FAR struct file *filep, off_t offset, int whence);
 static int     fb_ioctl(FAR struct file *filep, int cmd, unsigned long arg);
+#ifdef CONFIG_FB_PANNING
+static int     fb_getplaneinfo(FAR struct fb_chardev_s *fb,
+                               FAR struct fb_planeinfo_s *pinfo);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -295,6 +299,39 @@ static off_t fb_seek(FAR struct file *filep, off_t offset, int whence)
   return ret;
 }
 
+/****************************************************************************
+ * Name: fb_getplaneinfo
+ *
+ * Description:
+ *   Get the plane info from the driver.  A driver that does not know about
+ *   panning leaves the virtual resolution zero; it is then the resolution
+ *   of the display.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FB_PANNING
+static int fb_getplaneinfo(FAR struct fb_chardev_s *fb,
+                           FAR struct fb_planeinfo_s *pinfo)
+{
+  struct fb_videoinfo_s vinfo;
+  int ret;
+
+  memset(pinfo, 0, sizeof(struct fb_planeinfo_s));
+  ret = fb->vtable->getplaneinfo(fb->vtable, fb->plane, pinfo);
+  if (ret >= 0 && (pinfo->xres_virtual == 0 || pinfo->yres_virtual == 0))
+    {
+      ret = fb->vtable->getvideoinfo(fb->vtable, &vinfo);
+      if (ret >= 0)
+        {
+          pinfo->xres_virtual = vinfo.xres;
+          pinfo->yres_virtual = vinfo.yres;
+        }
+    }
+
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Name: fb_ioctl
  *
@@ -351,7 +388,11 @@ static int fb_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
           DEBUGASSERT(pinfo != 0 && fb->vtable != NULL &&
                       fb->vtable->getplaneinfo != NULL);
+#ifdef CONFIG_FB_PANNING
+          ret = fb_getplaneinfo(fb, pinfo);
+#else
           ret = fb->vtable->getplaneinfo(fb->vtable, fb->plane, pinfo);
+#endif
         }
         break;
 
@@ -534,6 +575,50 @@ static int fb_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 #endif
 #endif /* CONFIG_FB_OVERLAY */
 
+#ifdef CONFIG_FB_PANNING
+      case FBIOPAN_DISPLAY:  /* Show another part of the virtual plane */
+        {
+          FAR struct fb_planeinfo_s *pan =
+            (FAR struct fb_planeinfo_s *)((uintptr_t)arg);
+          struct fb_videoinfo_s vinfo;
+          struct fb_planeinfo_s pinfo;
+
+          DEBUGASSERT(pan != NULL && fb->vtable != NULL &&
+                      fb->vtable->getvideoinfo != NULL);
+
+          if (fb->vtable->pandisplay == NULL)
+            {
+              ret = -ENOTTY;
+              break;
+            }
+
+          ret = fb->vtable->getvideoinfo(fb->vtable, &vinfo);
+          if (ret >= 0)
+            {
+              ret = fb_getplaneinfo(fb, &pinfo);
+            }
+
+          if (ret < 0)
+            {
+              break;
+            }
+
+          /* The visible area must lie within the virtual plane */
+
+          if (pan->xoffset + vinfo.xres > pinfo.xres_virtual ||
+              pan->yoffset + vinfo.yres > pinfo.yres_virtual)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          pinfo.xoffset = pan->xoffset;
+          pinfo.yoffset = pan->yoffset;
+          ret = fb->vtable->pandisplay(fb->vtable, fb->plane, &pinfo);
+        }
+        break;
+#endif
+
       default:
         gerr("ERROR: Unsupported IOCTL command: %d\n", cmd);
         ret = -ENOTTY;
@@ -49,6 +49,7 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/board.h>
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 
 #include <arch/board/board.h>
@@ -133,6 +134,7 @@ struct video_type_inf_s
   sem_t                lock_state;
   enum video_state_e   state;
   int32_t              remaining_capnum;
+  uint16_t             sequence;   /* Sequence number of the next frame */
   video_wait_dma_t     wait_dma;
   video_framebuff_t    bufinf;
 };
@@ -842,6 +844,7 @@ static int video_streamon(FAR struct video_mng_s *vmng,
     }
   else
     {
+      type_inf->sequence = 0;
       next_video_state = estimate_next_video_state
                           (vmng, CAUSE_VIDEO_START);
       change_video_state(vmng, next_video_state);
@@ -927,6 +930,7 @@ static int video_takepict_start(FAR struct video_mng_s *vmng,
     }
   else
     {
+    vmng->still_inf.sequence = 0;
     if (capture_num > 0)
         {
          vmng->still_inf.remaining_capnum = capture_num;
@@ -1513,6 +1517,7 @@ int video_common_notify_dma_done(uint8_t  err_code,
   FAR video_mng_t      *vmng = (FAR video_mng_t *)priv;
   FAR video_type_inf_t *type_inf;
   FAR vbuf_container_t *container = NULL;
+  struct timespec      ts;
 
   type_inf = get_video_type_inf(vmng, buf_type);
   if (type_inf == NULL)
@@ -1520,6 +1525,15 @@ int video_common_notify_dma_done(uint8_t  err_code,
       return -EINVAL;
     }
 
+  /* Stamp the frame.  Frames dropped by the RING mode still consume a
+   * sequence number, so that the application can detect them.
+   */
+
+  clock_systime_timespec(&ts);
+  type_inf->bufinf.vbuf_dma->buf.timestamp.tv_sec  = ts.tv_sec;
+  type_inf->bufinf.vbuf_dma->buf.timestamp.tv_usec = ts.tv_nsec / 1000;
+  type_inf->bufinf.vbuf_dma->buf.sequence = type_inf->sequence++;
+
   if (err_code == 0)
     {
       type_inf->bufinf.vbuf_dma->buf.flags = 0;
@@ -66,6 +66,7 @@
 #include <nuttx/signal.h>
 #include <nuttx/wireless/gs2200m.h>
 #include <nuttx/net/netdev.h>
+#include <nuttx/fs/fs.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -86,6 +87,7 @@
 
 #define MAX_PKT_LEN  1500
 #define MAX_NOTIF_Q  16
+#define MAX_RX_BURST 8        /* Max packets received per interrupt */
 
 #define WR_REQ       0x01
 #define RD_REQ       0x02
@@ -186,6 +188,7 @@ struct gs2200m_dev_s
   uint16_t             valid_cid_bits;
   uint16_t             aip_cid_bits;
   uint8_t              tx_buff[MAX_PKT_LEN];
+  uint8_t              rx_buff[MAX_PKT_LEN];
   struct net_driver_s  net_dev;
   uint8_t              op_mode;
   FAR const struct gs2200m_lower_s *lower;
@@ -411,7 +414,7 @@ static void _notif_q_push(FAR struct gs2200m_dev_s *dev, char cid)
       /* If poll() waits and cid has been pushed to the queue, notify  */
 
       dev->pfd->revents |= POLLIN;
-      nxsem_post(dev->pfd->sem);
+      poll_notify(dev->pfd);
     }
 
   wlinfo("+++ pushed %c count=%d \n", cid, dev->notif_q.count);
@@ -1055,7 +1058,7 @@ enum spi_status_e gs2200m_hal_read(FAR struct gs2200m_dev_s *dev,
 
   /* Check the length */
 
-  ASSERT(0 < *len);
+  ASSERT(0 < *len && *len <= MAX_PKT_LEN);
 
   /* Read data header */
 
@@ -1401,8 +1404,11 @@ static enum pkt_type_e gs2200m_recv_pkt(FAR struct gs2200m_dev_s *dev,
   uint16_t len;
   uint8_t *p;
 
-  p = (uint8_t *)kmm_calloc(MAX_PKT_LEN, 1);
-  ASSERT(p);
+  /* The packet is parsed into pkt_dat before the next one is received, so
+   * one receive buffer is enough.  The caller holds the device lock.
+   */
+
+  p = dev->rx_buff;
 
   s = gs2200m_hal_read(dev, p, &len);
   t = _spi_err_to_pkt_type(s);
@@ -1429,7 +1435,6 @@ static enum pkt_type_e gs2200m_recv_pkt(FAR struct gs2200m_dev_s *dev,
     }
 
 errout:
-  kmm_free(p);
   return t;
 }
 
@@ -2708,7 +2713,7 @@ static int gs2200m_poll(FAR struct file *filep, FAR struct pollfd *fds,
       if (0 < n)
         {
           dev->pfd->revents |= POLLIN;
-          nxsem_post(dev->pfd->sem);
+          poll_notify(dev->pfd);
           wlinfo("==== _notif_q_count=%d \n", n);
         }
     }
@@ -2723,12 +2728,16 @@ errout:
 }
 
 /****************************************************************************
- * Name: gs2200m_irq_worker
+ * Name: gs2200m_irq_recv
+ *
+ * Description:
+ *   Receive one packet from gs2200m and add it to the packet queue of its
+ *   cid.  Called from the irq worker with the device locked.
+ *
  ****************************************************************************/
 
-static void gs2200m_irq_worker(FAR void *arg)
+static enum pkt_type_e gs2200m_irq_recv(FAR struct gs2200m_dev_s *dev)
 {
-  FAR struct gs2200m_dev_s *dev;
   enum pkt_type_e t = TYPE_ERROR;
   struct pkt_dat_s *pkt_dat;
   bool ignored = false;
@@ -2736,26 +2745,6 @@ static void gs2200m_irq_worker(FAR void *arg)
   char s_cid;
   char c_cid;
   int n;
-  int ec;
-  int ret;
-
-  DEBUGASSERT(arg != NULL);
-  dev = (FAR struct gs2200m_dev_s *)arg;
-
-  do
-    {
-      ret = gs2200m_lock(dev);
-
-      /* The only failure would be if the worker thread were canceled.  That
-       * is very unlikely, however.
-       */
-
-      DEBUGASSERT(ret == OK || ret == -ECANCELED);
-    }
-  while (ret < 0);
-
-  n = dev->lower->dready(&ec);
-  wlinfo("== start (dready=%d, ec=%d) \n", n, ec);
 
   /* Allocate a new pkt_dat and initialize it */
 
@@ -2843,22 +2832,71 @@ static void gs2200m_irq_worker(FAR void *arg)
     }
 
 errout:
+  wlinfo("== received: cid=%c type=%d \n", pkt_dat->cid, t);
 
-  /* NOTE: Enable gs2200m irq which was disabled in gs2200m_irq() */
+  if (ignored)
+    {
+      _release_pkt_dat(pkt_dat);
+      kmm_free(pkt_dat);
+    }
 
-  dev->lower->enable();
+  return t;
+}
+
+/****************************************************************************
+ * Name: gs2200m_irq_worker
+ ****************************************************************************/
+
+static void gs2200m_irq_worker(FAR void *arg)
+{
+  FAR struct gs2200m_dev_s *dev;
+  enum pkt_type_e t = TYPE_ERROR;
+  int i;
+  int n;
+  int ec;
+  int ret;
+
+  DEBUGASSERT(arg != NULL);
+  dev = (FAR struct gs2200m_dev_s *)arg;
+
+  do
+    {
+      ret = gs2200m_lock(dev);
+
+      /* The only failure would be if the worker thread were canceled.  That
+       * is very unlikely, however.
+       */
+
+      DEBUGASSERT(ret == OK || ret == -ECANCELED);
+    }
+  while (ret < 0);
 
   n = dev->lower->dready(&ec);
+  wlinfo("== start (dready=%d, ec=%d) \n", n, ec);
 
-  wlinfo("== end: cid=%c (dready=%d, ec=%d) type=%d \n",
-         pkt_dat->cid, n, ec, t);
+  /* Receive the packets that are ready.  If gs2200m has more packets for
+   * us, receive them here instead of taking another interrupt and worker
+   * cycle for each of them.
+   */
 
-  if (ignored)
+  for (i = 0; i < MAX_RX_BURST; i++)
     {
-      _release_pkt_dat(pkt_dat);
-      kmm_free(pkt_dat);
+      t = gs2200m_irq_recv(dev);
+
+      if (TYPE_ERROR == t || !dev->lower->dready(NULL))
+        {
+          break;
+        }
     }
 
+  /* NOTE: Enable gs2200m irq which was disabled in gs2200m_irq() */
+
+  dev->lower->enable();
+
+  n = dev->lower->dready(&ec);
+
+  wlinfo("== end: (dready=%d, ec=%d) type=%d \n", n, ec, t);
+
   gs2200m_unlock(dev);
 }
 
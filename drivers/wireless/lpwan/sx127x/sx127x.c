@@ -53,6 +53,7 @@
 #include <nuttx/semaphore.h>
 #include <nuttx/signal.h>
 #include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
 
 #include <nuttx/wireless/lpwan/sx127x.h>
 #include "sx127x.h"
@@ -1244,7 +1245,7 @@ static int sx127x_poll(FAR struct file *filep, FAR struct pollfd *fds,
           /* Data available for input */
 
           dev->pfd->revents |= POLLIN;
-          nxsem_post(dev->pfd->sem);
+          poll_notify(dev->pfd);
         }
 
       nxsem_post(&dev->rx_buffer_sem);
@@ -1330,7 +1331,7 @@ static int sx127x_lora_isr0_process(FAR struct sx127x_dev_s *dev)
                       dev->pfd->revents |= POLLIN;
 
                       wlinfo("Wake up polled fd\n");
-                      nxsem_post(dev->pfd->sem);
+                      poll_notify(dev->pfd);
                     }
 
                   /* Wake-up any thread waiting in recv */
@@ -1465,7 +1466,7 @@ static int sx127x_fskook_isr0_process(FAR struct sx127x_dev_s *dev)
                       dev->pfd->revents |= POLLIN;
 
                       wlinfo("Wake up polled fd\n");
-                      nxsem_post(dev->pfd->sem);
+                      poll_notify(dev->pfd);
                     }
 
                   /* Wake-up any thread waiting in recv */
@@ -63,6 +63,7 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/signal.h>
+#include <nuttx/fs/fs.h>
 
 #ifdef CONFIG_WL_NRF24L01_RXSUPPORT
 #  include <nuttx/wqueue.h>
@@ -732,7 +733,7 @@ static void nrf24l01_worker(FAR void *arg)
           dev->pfd->revents |= POLLIN;  /* Data available for input */
 
           wlinfo("Wake up polled fd\n");
-          nxsem_post(dev->pfd->sem);
+          poll_notify(dev->pfd);
         }
 
       /* Clear interrupt sources */
@@ -1427,7 +1428,7 @@ static int nrf24l01_poll(FAR struct file *filep, FAR struct pollfd *fds,
       if (dev->fifo_len > 0)
         {
           dev->pfd->revents |= POLLIN;  /* Data available for input */
-          nxsem_post(dev->pfd->sem);
+          poll_notify(dev->pfd);
         }
 
       nxsem_post(&dev->sem_fifo);
@@ -65,6 +65,7 @@
  */
 
 struct file;
+struct aioring_s;
 struct aio_container_s
 {
   dq_entry_t aioc_link;            /* Supports a doubly linked list */
@@ -78,6 +79,7 @@ struct aio_container_s
     FAR void *ptr;                 /* Generic pointer to FAR data */
   } u;
   struct work_s aioc_work;         /* Used to defer I/O to the work thread */
+  FAR struct aioring_s *aioc_ring; /* Completion ring or NULL to signal */
   pid_t aioc_pid;                  /* ID of the waiting task */
 #ifdef CONFIG_PRIORITY_INHERITANCE
   uint8_t aioc_prio;               /* Priority of the waiting task */
@@ -199,6 +201,60 @@ void aioc_free(FAR struct aio_container_s *aioc);
 
 FAR struct aio_container_s *aio_contain(FAR struct aiocb *aiocbp);
 
+/****************************************************************************
+ * Name: aio_read_submit, aio_write_submit, and aio_fsync_submit
+ *
+ * Description:
+ *   Queue an asynchronous read, write, or fsync.  These implement
+ *   aio_read(), aio_write(), and aio_fsync() and accept the completion ring
+ *   that the completion is posted to instead of signalling the client.
+ *
+ * Input Parameters:
+ *   aiocbp - The AIO control block pointer
+ *   ring   - The completion ring or NULL
+ *
+ * Returned Value:
+ *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
+ *   appropriately.
+ *
+ ****************************************************************************/
+
+int aio_read_submit(FAR struct aiocb *aiocbp, FAR struct aioring_s *ring);
+int aio_write_submit(FAR struct aiocb *aiocbp, FAR struct aioring_s *ring);
+int aio_fsync_submit(FAR struct aiocb *aiocbp, FAR struct aioring_s *ring);
+
+/****************************************************************************
+ * Name: aio_complete
+ *
+ * Description:
+ *   Report the completion of an I/O, either by posting it to the
+ *   completion ring it was submitted with or by signalling the client.
+ *
+ * Input Parameters:
+ *   pid    - ID of the task to signal
+ *   ring   - The completion ring or NULL
+ *   aiocbp - Pointer to the completed AIO control block
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aio_complete(pid_t pid, FAR struct aioring_s *ring,
+                  FAR struct aiocb *aiocbp);
+
+/****************************************************************************
+ * Name: aio_ringpost
+ *
+ * Description:
+ *   Post a completed AIO control block to a completion ring.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_AIO_RING
+void aio_ringpost(FAR struct aioring_s *ring, FAR struct aiocb *aiocbp);
+#endif
+
 /****************************************************************************
  * Name: aioc_decant
  *
@@ -83,6 +83,7 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
 {
   FAR struct aio_container_s *aioc;
   FAR struct aio_container_s *next;
+  FAR struct aioring_s *ring;
   pid_t pid;
   int status;
   int ret;
@@ -129,7 +130,8 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
                 {
                   /* Remove the container from the list of pending transfers */
 
-                  pid = aioc->aioc_pid;
+                  pid  = aioc->aioc_pid;
+                  ring = aioc->aioc_ring;
                   aioc_decant(aioc);
 
                   aiocbp->aio_result = -ECANCELED;
@@ -137,7 +139,7 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
 
                   /* Signal the client */
 
-                  aio_signal(pid, aiocbp);
+                  aio_complete(pid, ring, aiocbp);
                 }
               else
                 {
@@ -187,6 +189,7 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
                   next   =
                     (FAR struct aio_container_s *)aioc->aioc_link.flink;
                   pid    = aioc->aioc_pid;
+                  ring   = aioc->aioc_ring;
                   aiocbp = aioc_decant(aioc);
                   DEBUGASSERT(aiocbp);
 
@@ -198,7 +201,7 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
 
                   /* Signal the client */
 
-                  aio_signal(pid, aiocbp);
+                  aio_complete(pid, ring, aiocbp);
                 }
               else
                 {
@@ -75,7 +75,9 @@
 static void aio_fsync_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
+  FAR struct aioring_s *ring;
   FAR struct aiocb *aiocbp;
+  FAR void *ptr;
   pid_t pid;
 #ifdef CONFIG_PRIORITY_INHERITANCE
   uint8_t prio;
@@ -92,11 +94,13 @@ static void aio_fsync_worker(FAR void *arg)
 #ifdef CONFIG_PRIORITY_INHERITANCE
   prio   = aioc->aioc_prio;
 #endif
+  ring   = aioc->aioc_ring;
+  ptr    = aioc->u.ptr;
   aiocbp = aioc_decant(aioc);
 
   /* Perform the fsync using u.aioc_filep */
 
-  ret = file_fsync(aioc->u.aioc_filep);
+  ret = file_fsync((FAR struct file *)ptr);
   if (ret < 0)
     {
       ferr("ERROR: file_fsync failed: %d\n", ret);
@@ -109,7 +113,7 @@ static void aio_fsync_worker(FAR void *arg)
 
   /* Signal the client */
 
-  aio_signal(pid, aiocbp);
+  aio_complete(pid, ring, aiocbp);
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
   /* Restore the low priority worker thread default priority */
@@ -202,11 +206,25 @@ static void aio_fsync_worker(FAR void *arg)
  ****************************************************************************/
 
 int aio_fsync(int op, FAR struct aiocb *aiocbp)
+{
+  DEBUGASSERT(op == O_SYNC); /* || op == O_DSYNC */
+  return aio_fsync_submit(aiocbp, NULL);
+}
+
+/****************************************************************************
+ * Name: aio_fsync_submit
+ *
+ * Description:
+ *   Queue an asynchronous fsync whose completion is posted to 'ring', or
+ *   signalled as for aio_fsync() if 'ring' is NULL.
+ *
+ ****************************************************************************/
+
+int aio_fsync_submit(FAR struct aiocb *aiocbp, FAR struct aioring_s *ring)
 {
   FAR struct aio_container_s *aioc;
   int ret;
 
-  DEBUGASSERT(op == O_SYNC); /* || op == O_DSYNC */
   DEBUGASSERT(aiocbp);
 
   /* The result -EINPROGRESS means that the transfer has not yet completed */
@@ -228,6 +246,8 @@ int aio_fsync(int op, FAR struct aiocb *aiocbp)
       return ERROR;
     }
 
+  aioc->aioc_ring = ring;
+
   /* Defer the work to the worker thread */
 
   ret = aio_queue(aioc, aio_fsync_worker);
@@ -75,7 +75,9 @@
 static void aio_read_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
+  FAR struct aioring_s *ring;
   FAR struct aiocb *aiocbp;
+  FAR void *ptr;
   pid_t pid;
 #ifdef CONFIG_PRIORITY_INHERITANCE
   uint8_t prio;
@@ -92,6 +94,8 @@ static void aio_read_worker(FAR void *arg)
 #ifdef CONFIG_PRIORITY_INHERITANCE
   prio   = aioc->aioc_prio;
 #endif
+  ring   = aioc->aioc_ring;
+  ptr    = aioc->u.ptr;
   aiocbp = aioc_decant(aioc);
 
 #ifdef AIO_HAVE_PSOCK
@@ -106,7 +110,7 @@ static void aio_read_worker(FAR void *arg)
        *   aio_offset   - File offset
        */
 
-     nread = file_pread(aioc->u.aioc_filep, (FAR void *)aiocbp->aio_buf,
+     nread = file_pread((FAR struct file *)ptr, (FAR void *)aiocbp->aio_buf,
                         aiocbp->aio_nbytes, aiocbp->aio_offset);
     }
 #ifdef AIO_HAVE_PSOCK
@@ -119,8 +123,8 @@ static void aio_read_worker(FAR void *arg)
        *   aio_nbytes   - Length of transfer
        */
 
-      nread = psock_recv(aioc->u.aioc_psock, (FAR void *)aiocbp->aio_buf,
-                         aiocbp->aio_nbytes, 0);
+      nread = psock_recv((FAR struct socket *)ptr,
+                         (FAR void *)aiocbp->aio_buf, aiocbp->aio_nbytes, 0);
     }
 #endif
 
@@ -137,7 +141,7 @@ static void aio_read_worker(FAR void *arg)
 
   /* Signal the client */
 
-  aio_signal(pid, aiocbp);
+  aio_complete(pid, ring, aiocbp);
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
   /* Restore the low priority worker thread default priority */
@@ -247,6 +251,20 @@ static void aio_read_worker(FAR void *arg)
  ****************************************************************************/
 
 int aio_read(FAR struct aiocb *aiocbp)
+{
+  return aio_read_submit(aiocbp, NULL);
+}
+
+/****************************************************************************
+ * Name: aio_read_submit
+ *
+ * Description:
+ *   Queue an asynchronous read whose completion is posted to 'ring', or
+ *   signalled as for aio_read() if 'ring' is NULL.
+ *
+ ****************************************************************************/
+
+int aio_read_submit(FAR struct aiocb *aiocbp, FAR struct aioring_s *ring)
 {
   FAR struct aio_container_s *aioc;
   int ret;
@@ -272,6 +290,8 @@ int aio_read(FAR struct aiocb *aiocbp)
       return ERROR;
     }
 
+  aioc->aioc_ring = ring;
+
   /* Defer the work to the worker thread */
 
   ret = aio_queue(aioc, aio_read_worker);
@@ -0,0 +1,319 @@
+/****************************************************************************
+ * fs/aio/aio_ring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <aio.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/semaphore.h>
+
+#include "aio/aio.h"
+
+#ifdef CONFIG_FS_AIO_RING
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_ringpop
+ *
+ * Description:
+ *   Remove the oldest entry from the completion queue.  The caller has
+ *   already taken the count of the entry from the ring semaphore.
+ *
+ ****************************************************************************/
+
+static FAR struct aiocb *aio_ringpop(FAR struct aioring_s *ring)
+{
+  FAR struct aiocb *aiocbp;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  aiocbp = ring->ar_cq[ring->ar_head];
+  if (++ring->ar_head >= ring->ar_nentries)
+    {
+      ring->ar_head = 0;
+    }
+
+  DEBUGASSERT(ring->ar_inflight > 0);
+  ring->ar_inflight--;
+
+  leave_critical_section(flags);
+  return aiocbp;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_ringpost
+ *
+ * Description:
+ *   Post a completed AIO control block to a completion ring.  This is
+ *   called from the AIO worker threads and from aio_cancel().
+ *
+ * Input Parameters:
+ *   ring   - The completion ring
+ *   aiocbp - The completed AIO control block
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aio_ringpost(FAR struct aioring_s *ring, FAR struct aiocb *aiocbp)
+{
+  irqstate_t flags;
+
+  /* aio_submit() never has more entries in flight than the ring holds,
+   * so there is always room for the completion.
+   */
+
+  flags = enter_critical_section();
+
+  ring->ar_cq[ring->ar_tail] = aiocbp;
+  if (++ring->ar_tail >= ring->ar_nentries)
+    {
+      ring->ar_tail = 0;
+    }
+
+  leave_critical_section(flags);
+  nxsem_post(&ring->ar_sem);
+}
+
+/****************************************************************************
+ * Name: aio_ringinit
+ *
+ * Description:
+ *   Initialize a completion ring for use with aio_submit() and aio_reap().
+ *   This is a non-standard interface.
+ *
+ * Input Parameters:
+ *   ring     - The completion ring to initialize
+ *   cq       - Storage for the completion queue
+ *   nentries - The number of entries in 'cq'.  This is the maximum number
+ *              of I/Os that may be in flight through the ring.
+ *
+ * Returned Value:
+ *   Zero (OK) on success.  Otherwise, -1 (ERROR) is returned and errno is
+ *   set to EINVAL.
+ *
+ ****************************************************************************/
+
+int aio_ringinit(FAR struct aioring_s *ring, FAR struct aiocb **cq,
+                 unsigned int nentries)
+{
+  if (ring == NULL || cq == NULL || nentries == 0 || nentries > UINT16_MAX)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  nxsem_init(&ring->ar_sem, 0, 0);
+  nxsem_setprotocol(&ring->ar_sem, SEM_PRIO_NONE);
+
+  ring->ar_cq       = cq;
+  ring->ar_nentries = nentries;
+  ring->ar_head     = 0;
+  ring->ar_tail     = 0;
+  ring->ar_inflight = 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: aio_submit
+ *
+ * Description:
+ *   Queue a batch of asynchronous I/Os.  Each AIO control block selects
+ *   its operation with aio_lio_opcode:  LIO_READ, LIO_WRITE, or LIO_FSYNC.
+ *   NULL entries and LIO_NOP entries are ignored.  The aio_sigevent field
+ *   is not used:  When an I/O completes, its AIO control block is posted
+ *   to 'ring' to be collected with aio_reap().  This is a non-standard
+ *   interface.
+ *
+ * Input Parameters:
+ *   ring - The completion ring
+ *   list - The AIO control blocks to submit
+ *   nent - The number of entries in 'list'
+ *
+ * Returned Value:
+ *   The number of entries consumed from 'list'.  This is less than 'nent'
+ *   if the ring has no room for more I/Os in flight.  Each I/O consumed
+ *   is posted to the ring exactly once, also if it failed to start;
+ *   aio_error() then reports the error.  If no I/O could be consumed, -1
+ *   (ERROR) is returned and errno is set to EAGAIN (the ring is full) or
+ *   EINVAL.
+ *
+ ****************************************************************************/
+
+int aio_submit(FAR struct aioring_s *ring, FAR struct aiocb * const list[],
+               int nent)
+{
+  FAR struct aiocb *aiocbp;
+  irqstate_t flags;
+  int ret;
+  int i;
+
+  if (ring == NULL || list == NULL || nent < 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  for (i = 0; i < nent; i++)
+    {
+      aiocbp = list[i];
+      if (aiocbp == NULL || aiocbp->aio_lio_opcode == LIO_NOP)
+        {
+          continue;
+        }
+
+      /* Reserve a slot in the ring for the completion */
+
+      flags = enter_critical_section();
+      if (ring->ar_inflight >= ring->ar_nentries)
+        {
+          leave_critical_section(flags);
+          break;
+        }
+
+      ring->ar_inflight++;
+      leave_critical_section(flags);
+
+      switch (aiocbp->aio_lio_opcode)
+        {
+          case LIO_READ:
+            ret = aio_read_submit(aiocbp, ring);
+            break;
+
+          case LIO_WRITE:
+            ret = aio_write_submit(aiocbp, ring);
+            break;
+
+          case LIO_FSYNC:
+            ret = aio_fsync_submit(aiocbp, ring);
+            break;
+
+          default:
+            aiocbp->aio_result = -EINVAL;
+            ret = ERROR;
+            break;
+        }
+
+      /* aio_result holds the error if the I/O could not be queued.  Post
+       * the I/O anyway so that every consumed entry is reaped once.
+       */
+
+      if (ret < 0)
+        {
+          aio_ringpost(ring, aiocbp);
+        }
+    }
+
+  if (i == 0 && nent > 0)
+    {
+      set_errno(EAGAIN);
+      return ERROR;
+    }
+
+  return i;
+}
+
+/****************************************************************************
+ * Name: aio_reap
+ *
+ * Description:
+ *   Collect completed I/Os from a completion ring.  This is a non-standard
+ *   interface.
+ *
+ * Input Parameters:
+ *   ring    - The completion ring
+ *   list    - The location to return the completed AIO control blocks
+ *   nent    - The maximum number of entries to return in 'list'
+ *   timeout - The time to wait for the first completion.  NULL waits
+ *             indefinitely and a zero timeout does not wait at all.
+ *
+ * Returned Value:
+ *   The number of completed AIO control blocks returned in 'list'.  The
+ *   result of each I/O is available with aio_error() and aio_return().
+ *   Otherwise, -1 (ERROR) is returned and errno is set to EAGAIN (no I/O
+ *   completed within the timeout), EINTR, or EINVAL.
+ *
+ ****************************************************************************/
+
+int aio_reap(FAR struct aioring_s *ring, FAR struct aiocb *list[], int nent,
+             FAR const struct timespec *timeout)
+{
+  struct timespec abstime;
+  int ret;
+  int i;
+
+  if (ring == NULL || list == NULL || nent <= 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  /* Wait for the first completion */
+
+  if (timeout == NULL)
+    {
+      ret = nxsem_wait(&ring->ar_sem);
+    }
+  else if (timeout->tv_sec == 0 && timeout->tv_nsec == 0)
+    {
+      ret = nxsem_trywait(&ring->ar_sem);
+    }
+  else
+    {
+      clock_gettime(CLOCK_REALTIME, &abstime);
+      clock_timespec_add(&abstime, timeout, &abstime);
+      ret = nxsem_timedwait(&ring->ar_sem, &abstime);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(ret == -ETIMEDOUT ? EAGAIN : -ret);
+      return ERROR;
+    }
+
+  /* Then collect whatever else has completed without waiting */
+
+  list[0] = aio_ringpop(ring);
+  for (i = 1; i < nent && nxsem_trywait(&ring->ar_sem) >= 0; i++)
+    {
+      list[i] = aio_ringpop(ring);
+    }
+
+  return i;
+}
+
+#endif /* CONFIG_FS_AIO_RING */
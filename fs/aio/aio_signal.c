@@ -107,4 +107,35 @@ int aio_signal(pid_t pid, FAR struct aiocb *aiocbp)
   return OK;
 }
 
+/****************************************************************************
+ * Name: aio_complete
+ *
+ * Description:
+ *   Report the completion of an I/O, either by posting it to the
+ *   completion ring it was submitted with or by signalling the client.
+ *
+ * Input Parameters:
+ *   pid    - ID of the task to signal
+ *   ring   - The completion ring or NULL
+ *   aiocbp - Pointer to the completed AIO control block
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void aio_complete(pid_t pid, FAR struct aioring_s *ring,
+                  FAR struct aiocb *aiocbp)
+{
+#ifdef CONFIG_FS_AIO_RING
+  if (ring != NULL)
+    {
+      aio_ringpost(ring, aiocbp);
+      return;
+    }
+#endif
+
+  aio_signal(pid, aiocbp);
+}
+
 #endif /* CONFIG_FS_AIO */
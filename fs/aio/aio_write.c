@@ -75,7 +75,9 @@
 static void aio_write_worker(FAR void *arg)
 {
   FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
+  FAR struct aioring_s *ring;
   FAR struct aiocb *aiocbp;
+  FAR void *ptr;
   pid_t pid;
 #ifdef CONFIG_PRIORITY_INHERITANCE
   uint8_t prio;
@@ -93,6 +95,8 @@ static void aio_write_worker(FAR void *arg)
 #ifdef CONFIG_PRIORITY_INHERITANCE
   prio   = aioc->aioc_prio;
 #endif
+  ring   = aioc->aioc_ring;
+  ptr    = aioc->u.ptr;
   aiocbp = aioc_decant(aioc);
 
 #ifdef AIO_HAVE_PSOCK
@@ -101,7 +105,7 @@ static void aio_write_worker(FAR void *arg)
     {
       /* Call fcntl(F_GETFL) to get the file open mode. */
 
-      oflags = file_fcntl(aioc->u.aioc_filep, F_GETFL);
+      oflags = file_fcntl((FAR struct file *)ptr, F_GETFL);
       if (oflags < 0)
         {
           ferr("ERROR: file_fcntl failed: %d\n", oflags);
@@ -123,13 +127,13 @@ static void aio_write_worker(FAR void *arg)
         {
           /* Append to the current file position */
 
-          nwritten = file_write(aioc->u.aioc_filep,
+          nwritten = file_write((FAR struct file *)ptr,
                                 (FAR const void *)aiocbp->aio_buf,
                                 aiocbp->aio_nbytes);
         }
       else
         {
-          nwritten = file_pwrite(aioc->u.aioc_filep,
+          nwritten = file_pwrite((FAR struct file *)ptr,
                                  (FAR const void *)aiocbp->aio_buf,
                                  aiocbp->aio_nbytes,
                                  aiocbp->aio_offset);
@@ -145,7 +149,7 @@ static void aio_write_worker(FAR void *arg)
        *   aio_nbytes   - Length of transfer
        */
 
-      nwritten = psock_send(aioc->u.aioc_psock,
+      nwritten = psock_send((FAR struct socket *)ptr,
                             (FAR const void *)aiocbp->aio_buf,
                             aiocbp->aio_nbytes, 0);
     }
@@ -164,7 +168,7 @@ errout:
 
   /* Signal the client */
 
-  aio_signal(pid, aiocbp);
+  aio_complete(pid, ring, aiocbp);
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
   /* Restore the low priority worker thread default priority */
@@ -276,6 +280,20 @@ errout:
  ****************************************************************************/
 
 int aio_write(FAR struct aiocb *aiocbp)
+{
+  return aio_write_submit(aiocbp, NULL);
+}
+
+/****************************************************************************
+ * Name: aio_write_submit
+ *
+ * Description:
+ *   Queue an asynchronous write whose completion is posted to 'ring', or
+ *   signalled as for aio_write() if 'ring' is NULL.
+ *
+ ****************************************************************************/
+
+int aio_write_submit(FAR struct aiocb *aiocbp, FAR struct aioring_s *ring)
 {
   FAR struct aio_container_s *aioc;
   int ret;
@@ -301,6 +319,8 @@ int aio_write(FAR struct aiocb *aiocbp)
       return ERROR;
     }
 
+  aioc->aioc_ring = ring;
+
   /* Defer the work to the worker thread */
 
   ret = aio_queue(aioc, aio_write_worker);
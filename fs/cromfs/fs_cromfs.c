@@ -70,6 +70,8 @@
 struct cromfs_file_s
 {
   FAR const struct cromfs_node_s *ff_node;  /* The open file node */
+  FAR const struct lzf_header_s *ff_blkhdr; /* Block of the last read */
+  uint32_t ff_blkoffs;                      /* File offset of that block */
   uint32_t ff_offset;                       /* Cached block offset (zero means none) */
   uint16_t ff_ulen;                         /* Length of decompressed data in cache */
   FAR uint8_t *ff_buffer;                   /* Cached, decompressed data */
@@ -104,6 +106,8 @@ static FAR void *cromfs_offset2addr(FAR const struct cromfs_volume_s *fs,
                                     uint32_t offset);
 static uint32_t cromfs_addr2offset(FAR const struct cromfs_volume_s *fs,
                                    FAR const void *addr);
+static uint32_t cromfs_blkinfo(FAR const struct lzf_header_s *hdr,
+                               FAR uint16_t *ulen, FAR uint16_t *clen);
 static int      cromfs_foreach_node(FAR const struct cromfs_volume_s *fs,
                                     FAR const struct cromfs_node_s *node,
                                     cromfs_foreach_t callback, FAR void *arg);
@@ -253,6 +257,41 @@ static uint32_t cromfs_addr2offset(FAR const struct cromfs_volume_s *fs,
   return offset;
 }
 
+/****************************************************************************
+ * Name: cromfs_blkinfo
+ *
+ * Description:
+ *   Get the uncompressed (ulen) and compressed (clen) data lengths of a
+ *   block.  Returns the size of the block including its header.
+ *
+ ****************************************************************************/
+
+static uint32_t cromfs_blkinfo(FAR const struct lzf_header_s *hdr,
+                               FAR uint16_t *ulen, FAR uint16_t *clen)
+{
+  if (hdr->lzf_type == LZF_TYPE0_HDR)
+    {
+      FAR const struct lzf_type0_header_s *hdr0 =
+        (FAR const struct lzf_type0_header_s *)hdr;
+
+      *ulen = (uint16_t)hdr0->lzf_len[0] << 8 |
+              (uint16_t)hdr0->lzf_len[1];
+      *clen = *ulen;
+      return (uint32_t)*ulen + LZF_TYPE0_HDR_SIZE;
+    }
+  else
+    {
+      FAR const struct lzf_type1_header_s *hdr1 =
+        (FAR const struct lzf_type1_header_s *)hdr;
+
+      *ulen = (uint16_t)hdr1->lzf_ulen[0] << 8 |
+              (uint16_t)hdr1->lzf_ulen[1];
+      *clen = (uint16_t)hdr1->lzf_clen[0] << 8 |
+              (uint16_t)hdr1->lzf_clen[1];
+      return (uint32_t)*clen + LZF_TYPE1_HDR_SIZE;
+    }
+}
+
 /****************************************************************************
  * Name: cromfs_foreach_node
  ****************************************************************************/
@@ -598,13 +637,13 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
   FAR struct inode *inode;
   FAR const struct cromfs_volume_s *fs;
   FAR struct cromfs_file_s *ff;
-  FAR struct lzf_header_s *currhdr;
-  FAR struct lzf_header_s *nexthdr;
+  FAR const struct lzf_header_s *currhdr;
   FAR uint8_t *dest;
   FAR const uint8_t *src;
   off_t fpos;
   size_t remaining;
   uint32_t blkoffs;
+  uint32_t blksize;
   uint16_t ulen;
   uint16_t clen;
   unsigned int copysize;
@@ -645,80 +684,59 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
       buflen = ff->ff_node->cn_size - filep->f_pos;
     }
 
-  /* Find the compressed block containing the current offset, f_pos */
+  /* Find the compressed block containing the current offset, f_pos.
+   * Sequential reads continue the search at the block of the previous
+   * read.  The search restarts at the first block of the file only after
+   * a seek backward.
+   */
 
   dest      = (FAR uint8_t *)buffer;
   remaining = buflen;
   fpos      = filep->f_pos;
-  blkoffs   = 0;
-  ulen      = 0;
-  nexthdr   = (FAR struct lzf_header_s *)
-               cromfs_offset2addr(fs, ff->ff_node->u.cn_blocks);
 
-  /* Look until we find the compressed block containing the start of the
-   * requested data.
-   */
+  if (ff->ff_blkhdr == NULL || fpos < ff->ff_blkoffs)
+    {
+      ff->ff_blkhdr  = (FAR const struct lzf_header_s *)
+                       cromfs_offset2addr(fs, ff->ff_node->u.cn_blocks);
+      ff->ff_blkoffs = 0;
+    }
 
   while (remaining > 0)
     {
-      /* Search for the next block containing the fpos file offset.  This is
-       * real search on the first time through but the remaining blocks should
-       * be contiguous so that the logic should not loop.
-       *
+      /* Search for the block containing the fpos file offset.  The blocks
+       * are contiguous so, after the first block, this should not loop.
        */
 
-      do
-        {
-          uint32_t blksize;
-
-          /* Go to the next block */
+      currhdr = ff->ff_blkhdr;
+      blkoffs = ff->ff_blkoffs;
+      blksize = cromfs_blkinfo(currhdr, &ulen, &clen);
 
-          currhdr  = nexthdr;
+      while (fpos >= blkoffs + ulen)
+        {
+          currhdr  = (FAR const struct lzf_header_s *)
+                     ((FAR const uint8_t *)currhdr + blksize);
           blkoffs += ulen;
+          blksize  = cromfs_blkinfo(currhdr, &ulen, &clen);
+        }
 
-          if (currhdr->lzf_type == LZF_TYPE0_HDR)
-            {
-              FAR struct lzf_type0_header_s *hdr0 =
-                (FAR struct lzf_type0_header_s *)currhdr;
+      ff->ff_blkhdr  = currhdr;
+      ff->ff_blkoffs = blkoffs;
 
-              ulen    = (uint16_t)hdr0->lzf_len[0] << 8 |
-                        (uint16_t)hdr0->lzf_len[1];
-              blksize = (uint32_t)ulen + LZF_TYPE0_HDR_SIZE;
-            }
-          else
-            {
-              FAR struct lzf_type1_header_s * hdr1 =
-                (FAR struct lzf_type1_header_s *)currhdr;
-
-              ulen    = (uint16_t)hdr1->lzf_ulen[0] << 8 |
-                        (uint16_t)hdr1->lzf_ulen[1];
-              clen    = (uint16_t)hdr1->lzf_clen[0] << 8 |
-                        (uint16_t)hdr1->lzf_clen[1];
-              blksize = (uint32_t)clen + LZF_TYPE1_HDR_SIZE;
-            }
+      copyoffs = fpos - blkoffs;
+      DEBUGASSERT(ulen > copyoffs);
+      copysize = ulen - copyoffs;
 
-          nexthdr  = (FAR struct lzf_header_s *)
-                     ((FAR uint8_t *)currhdr + blksize);
+      if (copysize > remaining)  /* Clip to the size really needed */
+        {
+          copysize = remaining;
         }
-      while (fpos >= (blkoffs + ulen));
-
-      /* Check if we need to decompress the next block into the user buffer. */
 
       if (currhdr->lzf_type == LZF_TYPE0_HDR)
         {
-          /* Just copy the uncompressed data copy data from image to the
-           * user buffer.
+          /* Just copy the uncompressed data from the image to the user
+           * buffer.
            */
 
-          copyoffs = (blkoffs >= filep->f_pos) ? 0 : filep->f_pos - blkoffs;
-          DEBUGASSERT(ulen > copyoffs);
-          copysize = ulen - copyoffs;
-
-          if (copysize > remaining)  /* Clip to the size really needed */
-            {
-              copysize = remaining;
-            }
-
           src = (FAR const uint8_t *)currhdr + LZF_TYPE0_HDR_SIZE;
           memcpy(dest, &src[copyoffs], copysize);
 
@@ -727,82 +745,60 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
         }
       else
         {
-          /* If the source of the data is at the beginning of the compressed
-           * data buffer and if the uncompressed data would not overrun the
-           * buffer, then we can decompress directly into the user buffer.
+          uint32_t voloffs;
+
+          /* Get the address and offset in the CROMFS image of the
+           * compressed data.
            */
 
-          if (filep->f_pos <= blkoffs && ulen <= remaining)
-            {
-              uint32_t voloffs;
+          src     = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
+          voloffs = cromfs_addr2offset(fs, src);
 
-              copyoffs = 0;
-              copysize = ulen;
+          if (voloffs == ff->ff_offset)
+            {
+              /* The block is already decompressed in the cache */
 
-              /* Get the address and offset in the CROMFS image to obtain
-               * the data.  Check if we already have this offset in the
-               * cache.
+              DEBUGASSERT(ff->ff_ulen >= (copyoffs + copysize));
+              memcpy(dest, &ff->ff_buffer[copyoffs], copysize);
+            }
+          else if (copysize == ulen)
+            {
+              /* The whole block is wanted.  Decompress it directly into
+               * the user buffer.  The cache is left unchanged.
                */
 
-              src     = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
-              voloffs = cromfs_addr2offset(fs, src);
-              if (voloffs != ff->ff_offset)
+              if (lzf_decompress(src, clen, dest, ulen) != ulen)
                 {
-                  unsigned int decomplen;
-
-                  decomplen = lzf_decompress(src, clen, dest, fs->cv_bsize);
-
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
+                  ferr("ERROR: Bad block at voloffs=%lu\n",
+                       (unsigned long)voloffs);
+                  return -EIO;
                 }
-
-              finfo("voloffs=%lu blkoffs=%lu ulen=%u ff_offset=%u copysize=%u\n",
-                    (unsigned long)voloffs, (unsigned long)blkoffs, ulen,
-                    ff->ff_offset, copysize);
-              DEBUGASSERT(ff->ff_ulen >= copysize);
             }
           else
             {
-              uint32_t voloffs;
-
-              /* No, we will need to decompress into the our intermediate
-               * decompression buffer.
+              /* Decompress into the cache of the file, then copy the part
+               * of the block that we need.  The cache holds on to the
+               * block for the reads of the rest of it.
                */
 
-              copyoffs = (blkoffs >= filep->f_pos) ? 0 : filep->f_pos - blkoffs;
-              DEBUGASSERT(ulen > copyoffs);
-              copysize = ulen - copyoffs;
-
-              if (copysize > remaining)  /* Clip to the size really needed */
-                {
-                  copysize = remaining;
-                }
-
-              DEBUGASSERT((copyoffs + copysize) <=  fs->cv_bsize);
-
-              src = (FAR const uint8_t *)currhdr + LZF_TYPE1_HDR_SIZE;
-              voloffs = cromfs_addr2offset(fs, src);
-              if (voloffs != ff->ff_offset)
-                {
-                  unsigned int decomplen;
-
-                  decomplen = lzf_decompress(src, clen, ff->ff_buffer,
+              ff->ff_offset = 0;
+              ff->ff_ulen   = lzf_decompress(src, clen, ff->ff_buffer,
                                              fs->cv_bsize);
-
-                  ff->ff_offset = voloffs;
-                  ff->ff_ulen   = decomplen;
+              if (ff->ff_ulen != ulen)
+                {
+                  ferr("ERROR: Bad block at voloffs=%lu\n",
+                       (unsigned long)voloffs);
+                  return -EIO;
                 }
 
-              finfo("voloffs=%lu blkoffs=%lu ulen=%u clen=%u ff_offset=%u "
-                    "copyoffs=%u copysize=%u\n",
-                    (unsigned long)voloffs, (unsigned long)blkoffs, ulen,
-                    clen, ff->ff_offset, copyoffs, copysize);
-              DEBUGASSERT(ff->ff_ulen >= (copyoffs + copysize));
-
-              /* Then copy to user buffer */
-
+              ff->ff_offset = voloffs;
               memcpy(dest, &ff->ff_buffer[copyoffs], copysize);
             }
+
+          finfo("voloffs=%lu blkoffs=%lu ulen=%u clen=%u ff_offset=%u "
+                "copyoffs=%u copysize=%u\n",
+                (unsigned long)voloffs, (unsigned long)blkoffs, ulen,
+                clen, ff->ff_offset, copyoffs, copysize);
         }
 
       /* Adjust pointers counts and offset */
@@ -824,11 +820,51 @@ static ssize_t cromfs_read(FAR struct file *filep, FAR char *buffer,
 
 static int cromfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 {
+  FAR const struct cromfs_volume_s *fs;
+  FAR struct cromfs_file_s *ff;
+  FAR struct lzf_type0_header_s *hdr0;
+  FAR void **ppv = (FAR void **)arg;
+  uint16_t ulen;
+
   finfo("cmd: %d arg: %08lx\n", cmd, arg);
+  DEBUGASSERT(filep->f_priv != NULL && filep->f_inode != NULL);
+
+  /* Only one ioctl command is supported */
+
+  if (cmd != FIOC_MMAP || ppv == NULL)
+    {
+      return -ENOTTY;
+    }
+
+  fs = filep->f_inode->i_private;
+  ff = (FAR struct cromfs_file_s *)filep->f_priv;
+  DEBUGASSERT(fs != NULL && ff->ff_node != NULL);
+
+  /* The file data can be accessed in place only if it was stored as a
+   * single uncompressed block:  Otherwise, the data is compressed or
+   * interrupted by the headers of the following blocks.
+   */
+
+  hdr0 = (FAR struct lzf_type0_header_s *)
+         cromfs_offset2addr(fs, ff->ff_node->u.cn_blocks);
+
+  if (ff->ff_node->cn_size > 0)
+    {
+      if (hdr0->lzf_type != LZF_TYPE0_HDR)
+        {
+          return -ENOTTY;
+        }
 
-  /* No IOCTL commands yet supported */
+      ulen = (uint16_t)hdr0->lzf_len[0] << 8 |
+             (uint16_t)hdr0->lzf_len[1];
+      if (ulen < ff->ff_node->cn_size)
+        {
+          return -ENOTTY;
+        }
+    }
 
-  return -ENOTTY;
+  *ppv = (FAR void *)((FAR uint8_t *)hdr0 + LZF_TYPE0_HDR_SIZE);
+  return OK;
 }
 
 /****************************************************************************
@@ -334,8 +334,8 @@ static int fat_open(FAR struct file *filep, FAR const char *relpath,
 
   /* Create a file buffer to support partial sector accesses */
 
-  ff->ff_buffer = (FAR uint8_t *)fat_io_alloc(fs->fs_hwsectorsize);
-  if (!ff->ff_buffer)
+  ff->ff_rabuffer = (FAR uint8_t *)fat_io_alloc(FAT_FFBUFFER_SIZE(fs));
+  if (!ff->ff_rabuffer)
     {
       ret = -ENOMEM;
       goto errout_with_struct;
@@ -343,6 +343,7 @@ static int fat_open(FAR struct file *filep, FAR const char *relpath,
 
   /* Initialize the file private data (only need to initialize non-zero elements) */
 
+  ff->ff_buffer           = ff->ff_rabuffer;
   ff->ff_oflags           = oflags;
 
   /* Save information that can be used later to recover the directory entry */
@@ -465,9 +466,9 @@ static int fat_close(FAR struct file *filep)
    * Free the sector buffer that was used to manage partial sector accesses.
    */
 
-  if (ff->ff_buffer)
+  if (ff->ff_rabuffer)
     {
-      fat_io_free(ff->ff_buffer, fs->fs_hwsectorsize);
+      fat_io_free(ff->ff_rabuffer, FAT_FFBUFFER_SIZE(fs));
     }
 
   /* Then free the file structure itself. */
@@ -492,11 +493,11 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
   size_t bytesleft;
   int32_t cluster;
   FAR uint8_t *userbuffer = (FAR uint8_t *)buffer;
+  unsigned int nsectors;
   int sectorindex;
   int ret;
 
 #ifndef CONFIG_FAT_FORCE_INDIRECT
-  unsigned int nsectors;
   bool force_indirect = false;
 #endif
 
@@ -602,6 +603,9 @@ static ssize_t fat_read(FAR struct file *filep, FAR char *buffer,
           ff->ff_currentcluster   = cluster;
           ff->ff_currentsector    = fat_cluster2sector(fs, cluster);
           ff->ff_sectorsincluster = fs->fs_fatsecperclus;
+
+          fat_extentadd(ff, SEC_NSECTORS(fs, filep->f_pos) /
+                        fs->fs_fatsecperclus, cluster);
         }
 
 #ifdef CONFIG_FAT_DIRECT_RETRY /* Warning avoidance */
@@ -672,10 +676,19 @@ fat_read_restart:
           /* We are reading a partial sector, or handling a non-DMA-able
            * whole-sector transfer.  First, read the whole sector
            * into the file data buffer.  This is a caching buffer so if
-           * it is already there then all is well.
+           * it is already there then all is well.  Otherwise, read ahead
+           * the following sectors of the file in the same cluster.
            */
 
-          ret = fat_ffcacheread(fs, ff, ff->ff_currentsector);
+          nsectors = (sectorindex + ff->ff_size - filep->f_pos +
+                      fs->fs_hwsectorsize - 1) / fs->fs_hwsectorsize;
+          if (nsectors > ff->ff_sectorsincluster)
+            {
+              nsectors = ff->ff_sectorsincluster;
+            }
+
+          ret = fat_ffcachereadahead(fs, ff, ff->ff_currentsector,
+                                     nsectors);
           if (ret < 0)
             {
               goto errout_with_semaphore;
@@ -868,6 +881,9 @@ static ssize_t fat_write(FAR struct file *filep, FAR const char *buffer,
           ff->ff_currentcluster   = cluster;
           ff->ff_sectorsincluster = fs->fs_fatsecperclus;
           ff->ff_currentsector    = fat_cluster2sector(fs, cluster);
+
+          fat_extentadd(ff, SEC_NSECTORS(fs, filep->f_pos) /
+                        fs->fs_fatsecperclus, cluster);
         }
 
 #ifdef CONFIG_FAT_DIRECT_RETRY /* Warning avoidance */
@@ -954,9 +970,11 @@ fat_write_restart:
           if ((sectorindex == 0) && ((buflen >= fs->fs_hwsectorsize) ||
               ((filep->f_pos + buflen) >= ff->ff_size)))
             {
-              /* Flush unwritten data in the sector cache. */
+              /* Flush unwritten data in the sector cache and discard the
+               * sectors read ahead.
+               */
 
-              ret = fat_ffcacheflush(fs, ff);
+              ret = fat_ffcacheinvalidate(fs, ff);
               if (ret < 0)
                 {
                   goto errout_with_semaphore;
@@ -1045,6 +1063,10 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
   int32_t cluster;
   off_t position;
   unsigned int clustersize;
+#if CONFIG_FAT_NEXTENTS > 0
+  uint32_t runcluster;
+  uint32_t index;
+#endif
   int ret;
 
   /* Sanity checks */
@@ -1175,6 +1197,17 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
        */
 
       clustersize = fs->fs_fatsecperclus * fs->fs_hwsectorsize;
+
+#if CONFIG_FAT_NEXTENTS > 0
+      /* Skip over the clusters in the known runs of the file */
+
+      index         = fat_extentfind(ff, position / clustersize,
+                                     &runcluster);
+      cluster       = runcluster;
+      filep->f_pos  = (off_t)index * clustersize;
+      position     -= (off_t)index * clustersize;
+#endif
+
       for (; ; )
         {
           /* Skip over clusters prior to the one containing
@@ -1245,6 +1278,8 @@ static off_t fat_seek(FAR struct file *filep, off_t offset, int whence)
 
           filep->f_pos += clustersize;
           position     -= clustersize;
+
+          fat_extentadd(ff, filep->f_pos / clustersize, cluster);
         }
 
       /* We get here after we have found the sector containing
@@ -1517,8 +1552,8 @@ static int fat_dup(FAR const struct file *oldp, FAR struct file *newp)
 
   /* Create a file buffer to support partial sector accesses */
 
-  newff->ff_buffer = (FAR uint8_t *)fat_io_alloc(fs->fs_hwsectorsize);
-  if (!newff->ff_buffer)
+  newff->ff_rabuffer = (FAR uint8_t *)fat_io_alloc(FAT_FFBUFFER_SIZE(fs));
+  if (!newff->ff_rabuffer)
     {
       ret = -ENOMEM;
       goto errout_with_struct;
@@ -1553,6 +1588,12 @@ static int fat_dup(FAR const struct file *oldp, FAR struct file *newp)
   newff->ff_startcluster     = oldff->ff_startcluster;     /* Start cluster of file on media */
   newff->ff_currentsector    = oldff->ff_currentsector;    /* Current sector */
   newff->ff_cachesector      = 0;                          /* Sector in file buffer */
+  newff->ff_rasector         = 0;                          /* No sectors read ahead */
+  newff->ff_rancached        = 0;
+  newff->ff_buffer           = newff->ff_rabuffer;         /* Sector of file buffer in use */
+#if CONFIG_FAT_NEXTENTS > 0
+  newff->ff_nextents         = 0;                          /* No cluster runs cached */
+#endif
 
   /* Attach the private date to the struct file instance */
 
@@ -1856,6 +1897,10 @@ static int fat_truncate(FAR struct file *filep, off_t length)
           ret = fat_dirshrink(fs, direntry, length);
         }
 
+      /* The cached runs may include removed clusters */
+
+      fat_extentreset(ff);
+
       if (ret >= 0)
         {
           /* The truncation has completed without error.  Update the file
@@ -2279,6 +2324,20 @@ static int fat_unbind(FAR void *handle, FAR struct inode **blkdriver,
       fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
     }
 
+#if FAT_CACHE_NSLOTS > 0
+  if (fs->fs_cachebuffer)
+    {
+      fat_io_free(fs->fs_cachebuffer, FAT_CACHE_SIZE(fs));
+    }
+#endif
+
+#ifdef CONFIG_FAT_FREEMAP
+  if (fs->fs_freemap)
+    {
+      kmm_free(fs->fs_freemap);
+    }
+#endif
+
   nxsem_destroy(&fs->fs_sem);
   kmm_free(fs);
   return OK;
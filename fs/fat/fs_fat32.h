@@ -56,6 +56,24 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Configuration ************************************************************/
+
+/* The number of sectors in the volume sector cache and in the file buffer */
+
+#ifndef CONFIG_FAT_CACHE_NSECTORS
+#  define CONFIG_FAT_CACHE_NSECTORS 1
+#endif
+
+#ifndef CONFIG_FAT_READAHEAD_NSECTORS
+#  define CONFIG_FAT_READAHEAD_NSECTORS 1
+#endif
+
+/* The number of cluster runs remembered for each opened file */
+
+#ifndef CONFIG_FAT_NEXTENTS
+#  define CONFIG_FAT_NEXTENTS 0
+#endif
+
 /****************************************************************************
  * These offsets describes the master boot record (MBR).
  *
@@ -864,10 +882,34 @@
 #  define fat_io_free(m,s) kmm_free(m)
 #endif
 
+/* The volume sector cache holds the sectors other than the one in
+ * fs_buffer.
+ */
+
+#define FAT_CACHE_NSLOTS       (CONFIG_FAT_CACHE_NSECTORS - 1)
+#define FAT_CACHE_SIZE(fs)     (FAT_CACHE_NSLOTS * (fs)->fs_hwsectorsize)
+
+/* The size of the file buffer */
+
+#define FAT_FFBUFFER_SIZE(fs) \
+  (CONFIG_FAT_READAHEAD_NSECTORS * (fs)->fs_hwsectorsize)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
 
+/* This structure describes one sector of the volume sector cache.  The
+ * sectors are swapped with fs_buffer when they are accessed, so the cache
+ * never holds fs_currentsector.
+ */
+
+struct fat_cachesect_s
+{
+  off_t    cs_sector;              /* The sector number buffered (-1: none) */
+  uint32_t cs_age;                 /* Time of last use, for LRU replacement */
+  bool     cs_dirty;               /* true: Must be written back */
+};
+
 /* This structure represents the overall mountpoint state.  An instance of
  * this structure is retained as inode private data on each mountpoint that
  * is mounted with a fat32 filesystem.
@@ -902,6 +944,25 @@ struct fat_mountpt_s
   uint8_t  fs_fatsecperclus;       /* MBR: Sectors per allocation unit: 2**n, n=0..7 */
   uint8_t *fs_buffer;              /* This is an allocated buffer to hold one
                                     * sector from the device */
+#ifdef CONFIG_FAT_FREEMAP
+  uint32_t *fs_freemap;            /* Bitmap of the clusters in use (NULL:
+                                    * not built yet) */
+#endif
+#if FAT_CACHE_NSLOTS > 0
+  uint32_t fs_cacheage;            /* Incremented on each cache access */
+  uint8_t *fs_cachebuffer;         /* Allocated buffer to hold the sectors
+                                    * of the volume sector cache */
+  struct fat_cachesect_s fs_cache[FAT_CACHE_NSLOTS];
+#endif
+};
+
+/* This structure describes one run of contiguous clusters of a file */
+
+struct fat_extent_s
+{
+  uint32_t fe_index;               /* Index of the first cluster in the file */
+  uint32_t fe_cluster;             /* Number of the first cluster */
+  uint32_t fe_count;               /* Number of clusters in the run */
 };
 
 /* This structure represents on open file under the mountpoint.  An instance
@@ -922,7 +983,17 @@ struct fat_file_s
   off_t    ff_startcluster;        /* Start cluster of file on media */
   off_t    ff_currentsector;       /* Current sector being operated on */
   off_t    ff_cachesector;         /* Current sector in the file buffer */
-  uint8_t *ff_buffer;              /* File buffer (for partial sector accesses) */
+  off_t    ff_rasector;            /* First sector in ff_rabuffer */
+  uint8_t  ff_rancached;           /* Number of sectors in ff_rabuffer */
+  uint8_t *ff_buffer;              /* Sector of ff_rabuffer in use */
+  uint8_t *ff_rabuffer;            /* File buffer (for partial sector accesses) */
+#if CONFIG_FAT_NEXTENTS > 0
+  uint8_t  ff_nextents;            /* Number of entries in ff_extents */
+
+  /* The first runs of contiguous clusters of the file, in order */
+
+  struct fat_extent_s ff_extents[CONFIG_FAT_NEXTENTS];
+#endif
 };
 
 /* This structure holds the sequence of directory entries used by one
@@ -1098,6 +1169,9 @@ EXTERN int    fat_ffcacheflush(struct fat_mountpt_s *fs,
                                struct fat_file_s *ff);
 EXTERN int    fat_ffcacheread(struct fat_mountpt_s *fs,
                               struct fat_file_s *ff, off_t sector);
+EXTERN int    fat_ffcachereadahead(struct fat_mountpt_s *fs,
+                                   struct fat_file_s *ff, off_t sector,
+                                   unsigned int nsectors);
 EXTERN int    fat_ffcacheinvalidate(struct fat_mountpt_s *fs,
                                     struct fat_file_s *ff);
 
@@ -1109,6 +1183,19 @@ EXTERN int    fat_nfreeclusters(struct fat_mountpt_s *fs,
 EXTERN int    fat_currentsector(struct fat_mountpt_s *fs,
                                 struct fat_file_s *ff, off_t position);
 
+/* File extent cache */
+
+#if CONFIG_FAT_NEXTENTS > 0
+EXTERN uint32_t fat_extentfind(struct fat_file_s *ff, uint32_t index,
+                               FAR uint32_t *cluster);
+EXTERN void   fat_extentadd(struct fat_file_s *ff, uint32_t index,
+                            uint32_t cluster);
+#  define fat_extentreset(ff) ((ff)->ff_nextents = 0)
+#else
+#  define fat_extentadd(ff,i,c)
+#  define fat_extentreset(ff)
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
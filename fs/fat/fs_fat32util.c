@@ -67,6 +67,300 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: fat_writesector
+ *
+ * Description:
+ *   Write one sector buffered for the mountpoint.  A sector in the FAT
+ *   region is also written to the other FAT copies.
+ *
+ ****************************************************************************/
+
+static int fat_writesector(struct fat_mountpt_s *fs, uint8_t *buffer,
+                           off_t sector)
+{
+  int ret;
+
+  ret = fat_hwwrite(fs, buffer, sector, 1);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  /* Does the sector lie in the FAT region? */
+
+  if (sector >= fs->fs_fatbase &&
+      sector < fs->fs_fatbase + fs->fs_nfatsects)
+    {
+      int i;
+
+      /* Yes, then make the change in the FAT copy as well */
+
+      for (i = fs->fs_fatnumfats; i >= 2; i--)
+        {
+          sector += fs->fs_nfatsects;
+          ret = fat_hwwrite(fs, buffer, sector, 1);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  return OK;
+}
+
+#if FAT_CACHE_NSLOTS > 0
+/****************************************************************************
+ * Name: fat_cacheswap
+ *
+ * Description:
+ *   Exchange the contents of fs_buffer and of one sector of the volume
+ *   sector cache.
+ *
+ ****************************************************************************/
+
+static void fat_cacheswap(struct fat_mountpt_s *fs, int slot)
+{
+  FAR uint8_t *src = fs->fs_buffer;
+  FAR uint8_t *dest = &fs->fs_cachebuffer[slot * fs->fs_hwsectorsize];
+  off_t i;
+
+  for (i = 0; i < fs->fs_hwsectorsize; i++)
+    {
+      uint8_t tmp = src[i];
+
+      src[i]  = dest[i];
+      dest[i] = tmp;
+    }
+}
+
+/****************************************************************************
+ * Name: fat_cachediscard
+ *
+ * Description:
+ *   Discard the sectors of the volume sector cache in the range written to
+ *   the media from another buffer.
+ *
+ ****************************************************************************/
+
+static void fat_cachediscard(struct fat_mountpt_s *fs, uint8_t *buffer,
+                             off_t sector, unsigned int nsectors)
+{
+  FAR struct fat_cachesect_s *cache;
+  int i;
+
+  for (i = 0; i < FAT_CACHE_NSLOTS; i++)
+    {
+      cache = &fs->fs_cache[i];
+      if (cache->cs_sector >= sector &&
+          cache->cs_sector < sector + nsectors &&
+          buffer != &fs->fs_cachebuffer[i * fs->fs_hwsectorsize])
+        {
+          cache->cs_sector = -1;
+          cache->cs_dirty  = false;
+        }
+    }
+}
+#endif
+
+#ifdef CONFIG_FAT_FREEMAP
+/****************************************************************************
+ * Name: fat_freemapinit
+ *
+ * Description:
+ *   Build the free cluster bitmap with one pass over the FAT.  The free
+ *   cluster count is updated as well.
+ *
+ ****************************************************************************/
+
+static int fat_freemapinit(struct fat_mountpt_s *fs)
+{
+  FAR uint32_t *freemap;
+  uint32_t nfreeclusters;
+  uint32_t cluster;
+  off_t nextcluster;
+
+  freemap = (FAR uint32_t *)
+    kmm_zalloc(((fs->fs_nclusters + 31) >> 5) * sizeof(uint32_t));
+  if (freemap == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* Clusters 0 and 1 are never allocated */
+
+  freemap[0]    = 3;
+  nfreeclusters = 0;
+
+  for (cluster = 2; cluster < fs->fs_nclusters; cluster++)
+    {
+      nextcluster = fat_getcluster(fs, cluster);
+      if (nextcluster < 0)
+        {
+          kmm_free(freemap);
+          return (int)nextcluster;
+        }
+      else if (nextcluster == 0)
+        {
+          nfreeclusters++;
+        }
+      else
+        {
+          freemap[cluster >> 5] |= (uint32_t)1 << (cluster & 31);
+        }
+    }
+
+  fs->fs_freemap = freemap;
+
+  if (fs->fs_fsifreecount != nfreeclusters)
+    {
+      fs->fs_fsifreecount = nfreeclusters;
+      fs->fs_fsidirty     = true;
+    }
+
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name: fat_findfreecluster
+ *
+ * Description:
+ *   Find a free cluster, starting the search after startcluster and
+ *   wrapping around at the end of the FAT.
+ *
+ * Returned Value:
+ *   <0:error, 0: no free cluster, >=2: free cluster number
+ *
+ ****************************************************************************/
+
+static int32_t fat_findfreecluster(struct fat_mountpt_s *fs,
+                                   uint32_t startcluster)
+{
+  off_t    startsector;
+  uint32_t newcluster;
+
+#ifdef CONFIG_FAT_FREEMAP
+  /* Build the free cluster bitmap on the first allocation */
+
+  if (fs->fs_freemap == NULL)
+    {
+      fat_freemapinit(fs);
+    }
+
+  if (fs->fs_freemap != NULL)
+    {
+      uint32_t remaining = fs->fs_nclusters - 2;
+      uint32_t word;
+
+      newcluster = startcluster;
+      while (remaining > 0)
+        {
+          newcluster++;
+          if (newcluster >= fs->fs_nclusters)
+            {
+              newcluster = 2;
+            }
+
+          /* Skip 32 clusters in use at once */
+
+          word = fs->fs_freemap[newcluster >> 5];
+          if (word == 0xffffffff && (newcluster & 31) == 0 &&
+              remaining >= 32)
+            {
+              newcluster += 31;
+              remaining  -= 32;
+              continue;
+            }
+
+          remaining--;
+          if ((word & ((uint32_t)1 << (newcluster & 31))) != 0)
+            {
+              continue;
+            }
+
+          /* Verify the candidate in the FAT, in case it was not written
+           * as intended.
+           */
+
+          startsector = fat_getcluster(fs, newcluster);
+          if (startsector == 0)
+            {
+              return newcluster;
+            }
+          else if (startsector < 0)
+            {
+              return startsector;
+            }
+
+          fs->fs_freemap[newcluster >> 5] |=
+            (uint32_t)1 << (newcluster & 31);
+        }
+
+      return 0;
+    }
+#endif
+
+  /* Loop until (1) we discover that there are not free clusters
+   * (return 0), an errors occurs (return -errno), or (3) we find
+   * the next cluster (return the new cluster number).
+   */
+
+  newcluster = startcluster;
+  for (; ; )
+    {
+      /* Examine the next cluster in the FAT */
+
+      newcluster++;
+      if (newcluster >= fs->fs_nclusters)
+        {
+          /* If we hit the end of the available clusters, then
+           * wrap back to the beginning because we might have
+           * started at a non-optimal place.  But don't continue
+           * past the start cluster.
+           */
+
+          newcluster = 2;
+          if (newcluster > startcluster)
+            {
+              /* We are back past the starting cluster, then there
+               * is no free cluster.
+               */
+
+              return 0;
+            }
+        }
+
+      /* We have a candidate cluster.  Check if the cluster number is
+       * mapped to a group of sectors.
+       */
+
+      startsector = fat_getcluster(fs, newcluster);
+      if (startsector == 0)
+        {
+          /* Found have found a free cluster */
+
+          return newcluster;
+        }
+      else if (startsector < 0)
+        {
+          /* Some error occurred, return the error number */
+
+          return startsector;
+        }
+
+      /* We wrap all the back to the starting cluster?  If so, then
+       * there are no free clusters.
+       */
+
+      if (newcluster == startcluster)
+        {
+          return 0;
+        }
+    }
+}
+
 /****************************************************************************
  * Name: fat_checkfsinfo
  *
@@ -505,6 +799,9 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
 {
   FAR struct inode *inode;
   struct geometry geo;
+#if FAT_CACHE_NSLOTS > 0
+  int slot;
+#endif
   int ret;
 
   /* Assume that the mount is successful */
@@ -543,6 +840,23 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
       goto errout;
     }
 
+#if FAT_CACHE_NSLOTS > 0
+  /* And the buffer to hold the sectors of the volume sector cache */
+
+  fs->fs_cachebuffer = (FAR uint8_t *)fat_io_alloc(FAT_CACHE_SIZE(fs));
+  if (!fs->fs_cachebuffer)
+    {
+      ret = -ENOMEM;
+      goto errout_with_buffer;
+    }
+
+  for (slot = 0; slot < FAT_CACHE_NSLOTS; slot++)
+    {
+      fs->fs_cache[slot].cs_sector = -1;
+      fs->fs_cache[slot].cs_dirty  = false;
+    }
+#endif
+
   /* Search FAT boot record on the drive.  First check the MBR at sector
    * zero.  This could be either the boot record or a partition that refers
    * to the boot record.
@@ -671,6 +985,14 @@ int fat_mount(struct fat_mountpt_s *fs, bool writeable)
   return OK;
 
 errout_with_buffer:
+#if FAT_CACHE_NSLOTS > 0
+  if (fs->fs_cachebuffer)
+    {
+      fat_io_free(fs->fs_cachebuffer, FAT_CACHE_SIZE(fs));
+      fs->fs_cachebuffer = 0;
+    }
+#endif
+
   fat_io_free(fs->fs_buffer, fs->fs_hwsectorsize);
   fs->fs_buffer = 0;
 
@@ -785,6 +1107,14 @@ int fat_hwwrite(struct fat_mountpt_s *fs, uint8_t *buffer, off_t sector,
             {
               ret = nsectorswritten;
             }
+
+#if FAT_CACHE_NSLOTS > 0
+          /* Any copy of these sectors in the volume sector cache is now
+           * stale.
+           */
+
+          fat_cachediscard(fs, buffer, sector, nsectors);
+#endif
         }
     }
 
@@ -963,6 +1293,24 @@ int fat_putcluster(struct fat_mountpt_s *fs, uint32_t clusterno,
 
   if (clusterno == 0 || (clusterno >= 2 && clusterno < fs->fs_nclusters))
     {
+#ifdef CONFIG_FAT_FREEMAP
+      /* Keep the free cluster bitmap up to date */
+
+      if (fs->fs_freemap != NULL && clusterno >= 2)
+        {
+          if (nextcluster != 0)
+            {
+              fs->fs_freemap[clusterno >> 5] |=
+                (uint32_t)1 << (clusterno & 31);
+            }
+          else
+            {
+              fs->fs_freemap[clusterno >> 5] &=
+                ~((uint32_t)1 << (clusterno & 31));
+            }
+        }
+#endif
+
       /* Okay.. Write the next cluster into the FAT.  The way we will do
        * this depends on the type of FAT filesystem we are dealing with.
        */
@@ -1180,7 +1528,7 @@ int fat_removechain(struct fat_mountpt_s *fs, uint32_t cluster)
 int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
 {
   off_t    startsector;
-  uint32_t newcluster;
+  int32_t  newcluster;
   uint32_t startcluster;
   int      ret;
 
@@ -1231,67 +1579,17 @@ int32_t fat_extendchain(struct fat_mountpt_s *fs, uint32_t cluster)
       startcluster = cluster;
     }
 
-  /* Loop until (1) we discover that there are not free clusters
-   * (return 0), an errors occurs (return -errno), or (3) we find
-   * the next cluster (return the new cluster number).
-   */
+  /* Find the next free cluster */
 
-  newcluster = startcluster;
-  for (; ; )
+  newcluster = fat_findfreecluster(fs, startcluster);
+  if (newcluster <= 0)
     {
-      /* Examine the next cluster in the FAT */
-
-      newcluster++;
-      if (newcluster >= fs->fs_nclusters)
-        {
-          /* If we hit the end of the available clusters, then
-           * wrap back to the beginning because we might have
-           * started at a non-optimal place.  But don't continue
-           * past the start cluster.
-           */
-
-          newcluster = 2;
-          if (newcluster > startcluster)
-            {
-              /* We are back past the starting cluster, then there
-               * is no free cluster.
-               */
-
-              return 0;
-            }
-        }
-
-      /* We have a candidate cluster.  Check if the cluster number is
-       * mapped to a group of sectors.
-       */
-
-      startsector = fat_getcluster(fs, newcluster);
-      if (startsector == 0)
-        {
-          /* Found have found a free cluster break out */
-
-          break;
-        }
-      else if (startsector < 0)
-        {
-          /* Some error occurred, return the error number */
-
-          return startsector;
-        }
+      /* An error occurred or there is no free cluster */
 
-      /* We wrap all the back to the starting cluster?  If so, then
-       * there are no free clusters.
-       */
-
-      if (newcluster == startcluster)
-        {
-          return 0;
-        }
+      return newcluster;
     }
 
-  /* We get here only if we break out with an available cluster
-   * number in 'newcluster'  Now mark that cluster as in-use.
-   */
+  /* Now mark that cluster as in-use */
 
   ret = fat_putcluster(fs, newcluster, 0x0fffffff);
   if (ret < 0)
@@ -1697,9 +1995,11 @@ int fat_dirextend(FAR struct fat_mountpt_s *fs, FAR struct fat_file_s *ff,
       if (sectndx == 0 && (remaining >= fs->fs_hwsectorsize ||
           (pos + remaining) >= ff->ff_size))
         {
-          /* Flush unwritten data in the sector cache. */
+          /* Flush unwritten data in the sector cache and discard the
+           * sectors read ahead.
+           */
 
-          ret = fat_ffcacheflush(fs, ff);
+          ret = fat_ffcacheinvalidate(fs, ff);
           if (ret < 0)
             {
               return ret;
@@ -1765,7 +2065,8 @@ int fat_dirextend(FAR struct fat_mountpt_s *fs, FAR struct fat_file_s *ff,
  * Name: fat_fscacheflush
  *
  * Description:
- *   Flush any dirty sector if fs_buffer as necessary
+ *   Flush any dirty sector if fs_buffer and of the volume sector cache as
+ *   necessary
  *
  ****************************************************************************/
 
@@ -1773,6 +2074,38 @@ int fat_fscacheflush(struct fat_mountpt_s *fs)
 {
   int ret;
 
+#if FAT_CACHE_NSLOTS > 0
+  FAR struct fat_cachesect_s *cache;
+  int i;
+
+  /* Write back the dirty sectors of the volume sector cache.  A sector that
+   * was placed in fs_buffer without being read is newer than its copy in
+   * the cache, so that copy is discarded instead.
+   */
+
+  for (i = 0; i < FAT_CACHE_NSLOTS; i++)
+    {
+      cache = &fs->fs_cache[i];
+      if (cache->cs_sector == fs->fs_currentsector)
+        {
+          cache->cs_sector = -1;
+          cache->cs_dirty  = false;
+        }
+      else if (cache->cs_dirty)
+        {
+          ret = fat_writesector(fs,
+                                &fs->fs_cachebuffer[i * fs->fs_hwsectorsize],
+                                cache->cs_sector);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          cache->cs_dirty = false;
+        }
+    }
+#endif
+
   /* Check if the fs_buffer is dirty.  In this case, we will write back the
    * contents of fs_buffer.
    */
@@ -1781,32 +2114,12 @@ int fat_fscacheflush(struct fat_mountpt_s *fs)
     {
       /* Write the dirty sector */
 
-      ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
+      ret = fat_writesector(fs, fs->fs_buffer, fs->fs_currentsector);
       if (ret < 0)
         {
           return ret;
         }
 
-      /* Does the sector lie in the FAT region? */
-
-      if (fs->fs_currentsector >= fs->fs_fatbase &&
-          fs->fs_currentsector < fs->fs_fatbase + fs->fs_nfatsects)
-        {
-          int i;
-
-          /* Yes, then make the change in the FAT copy as well */
-
-          for (i = fs->fs_fatnumfats; i >= 2; i--)
-            {
-              fs->fs_currentsector += fs->fs_nfatsects;
-              ret = fat_hwwrite(fs, fs->fs_buffer, fs->fs_currentsector, 1);
-              if (ret < 0)
-                {
-                  return ret;
-                }
-            }
-        }
-
       /* No longer dirty */
 
       fs->fs_dirty = false;
@@ -1826,6 +2139,13 @@ int fat_fscacheflush(struct fat_mountpt_s *fs)
 
 int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
 {
+#if FAT_CACHE_NSLOTS > 0
+  FAR struct fat_cachesect_s *cache;
+  bool dirty;
+  int victim;
+  int hit;
+  int i;
+#endif
   int ret;
 
   /* fs->fs_currentsector holds the current sector that is buffered in
@@ -1835,6 +2155,83 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
 
   if (fs->fs_currentsector != sector)
     {
+#if FAT_CACHE_NSLOTS > 0
+      /* The sector in fs_buffer replaces the least recently used sector of
+       * the volume sector cache, or the requested sector if it is already
+       * in the cache.  Any other copy of the sector in fs_buffer is older.
+       */
+
+      victim = -1;
+      hit    = -1;
+
+      for (i = 0; i < FAT_CACHE_NSLOTS; i++)
+        {
+          cache = &fs->fs_cache[i];
+          if (cache->cs_sector == fs->fs_currentsector)
+            {
+              cache->cs_sector = -1;
+              cache->cs_dirty  = false;
+            }
+
+          if (cache->cs_sector == sector)
+            {
+              hit = i;
+            }
+          else if (victim < 0 || cache->cs_sector < 0 ||
+                   (fs->fs_cache[victim].cs_sector >= 0 &&
+                    fs->fs_cacheage - cache->cs_age >
+                    fs->fs_cacheage - fs->fs_cache[victim].cs_age))
+            {
+              victim = i;
+            }
+        }
+
+      if (hit >= 0)
+        {
+          victim = hit;
+        }
+
+      /* Make room for the sector in fs_buffer, writing back the victim if
+       * it is dirty and is not the requested sector.
+       */
+
+      cache = &fs->fs_cache[victim];
+      if (cache->cs_sector != sector && cache->cs_dirty)
+        {
+          ret = fat_writesector(fs,
+                                &fs->fs_cachebuffer[victim *
+                                                    fs->fs_hwsectorsize],
+                                cache->cs_sector);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          cache->cs_dirty = false;
+        }
+
+      /* Exchange the sector in fs_buffer with the victim.  The write-back
+       * of a dirty fs_buffer is deferred until it leaves the cache.
+       */
+
+      fat_cacheswap(fs, victim);
+
+      dirty                = cache->cs_dirty;
+      cache->cs_dirty      = fs->fs_dirty;
+      cache->cs_age        = ++fs->fs_cacheage;
+      fs->fs_dirty         = dirty;
+
+      if (cache->cs_sector == sector)
+        {
+          /* The requested sector was in the cache */
+
+          cache->cs_sector     = fs->fs_currentsector;
+          fs->fs_currentsector = sector;
+          return OK;
+        }
+
+      cache->cs_sector     = fs->fs_currentsector;
+#else
       /* We will need to read the new sector.  First, flush the cached
        * sector if it is dirty.
        */
@@ -1844,12 +2241,18 @@ int fat_fscacheread(struct fat_mountpt_s *fs, off_t sector)
         {
           return ret;
         }
+#endif
 
       /* Then read the specified sector into the cache */
 
       ret = fat_hwread(fs, fs->fs_buffer, sector, 1);
       if (ret < 0)
         {
+#if FAT_CACHE_NSLOTS > 0
+          /* fs_buffer no longer holds any sector */
+
+          fs->fs_currentsector = -1;
+#endif
           return ret;
         }
 
@@ -1908,6 +2311,23 @@ int fat_ffcacheflush(struct fat_mountpt_s *fs, struct fat_file_s *ff)
 
 int fat_ffcacheread(struct fat_mountpt_s *fs, struct fat_file_s *ff,
                     off_t sector)
+{
+  return fat_ffcachereadahead(fs, ff, sector, 1);
+}
+
+/****************************************************************************
+ * Name: fat_ffcachereadahead
+ *
+ * Description:
+ *   Read the specified sector into the sector cache, flushing any existing
+ *   dirty sectors as necessary.  If the sector is not already in the file
+ *   buffer, up to nsectors contiguous sectors starting with this one are
+ *   read into the file buffer, as far as it can hold them.
+ *
+ ****************************************************************************/
+
+int fat_ffcachereadahead(struct fat_mountpt_s *fs, struct fat_file_s *ff,
+                         off_t sector, unsigned int nsectors)
 {
   int ret;
 
@@ -1928,25 +2348,51 @@ int fat_ffcacheread(struct fat_mountpt_s *fs, struct fat_file_s *ff,
           return ret;
         }
 
-      /* Then read the specified sector into the cache */
+      /* The sector may have been read ahead already */
 
-      ret = fat_hwread(fs, ff->ff_buffer, sector, 1);
-      if (ret < 0)
+      if (sector < ff->ff_rasector ||
+          sector >= ff->ff_rasector + ff->ff_rancached)
         {
-          return ret;
+          /* No.. then read the specified sector and the following
+           * sectors into the file buffer.
+           */
+
+          if (nsectors > CONFIG_FAT_READAHEAD_NSECTORS)
+            {
+              nsectors = CONFIG_FAT_READAHEAD_NSECTORS;
+            }
+          else if (nsectors < 1)
+            {
+              nsectors = 1;
+            }
+
+          ff->ff_bflags   &= ~FFBUFF_VALID;
+          ff->ff_rancached = 0;
+          ff->ff_buffer    = ff->ff_rabuffer;
+
+          ret = fat_hwread(fs, ff->ff_rabuffer, sector, nsectors);
+          if (ret < 0)
+            {
+              return ret;
+            }
+
+          ff->ff_rasector  = sector;
+          ff->ff_rancached = nsectors;
         }
 
       /* Update the cached sector number */
 
+      ff->ff_buffer      = &ff->ff_rabuffer[(sector - ff->ff_rasector) *
+                                            fs->fs_hwsectorsize];
       ff->ff_cachesector = sector;
-      ff->ff_bflags |= FFBUFF_VALID;
+      ff->ff_bflags     |= FFBUFF_VALID;
     }
 
   return OK;
 }
 
 /****************************************************************************
- * Name: fat_ffcacheread
+ * Name: fat_ffcacheinvalidate
  *
  * Description:
  *   Invalidate the current file buffer contents
@@ -1975,6 +2421,12 @@ int fat_ffcacheinvalidate(struct fat_mountpt_s *fs, struct fat_file_s *ff)
       ff->ff_cachesector = 0;
     }
 
+  /* Also discard the sectors read ahead.  The whole file buffer is then
+   * available for the next sector.
+   */
+
+  ff->ff_rancached = 0;
+  ff->ff_buffer    = ff->ff_rabuffer;
   return OK;
 }
 
@@ -2040,6 +2492,15 @@ int fat_nfreeclusters(struct fat_mountpt_s *fs, off_t *pfreeclusters)
 {
   uint32_t nfreeclusters;
 
+#ifdef CONFIG_FAT_FREEMAP
+  /* Building the free cluster bitmap also counts the free clusters */
+
+  if (fs->fs_freemap == NULL && fs->fs_fsifreecount > fs->fs_nclusters - 2)
+    {
+      fat_freemapinit(fs);
+    }
+#endif
+
   /* If number of the first free cluster is valid, then just return that value. */
 
   if (fs->fs_fsifreecount <= fs->fs_nclusters - 2)
@@ -2176,3 +2637,105 @@ int fat_currentsector(struct fat_mountpt_s *fs, struct fat_file_s *ff,
 
   return -ENOSPC;
 }
+
+#if CONFIG_FAT_NEXTENTS > 0
+/****************************************************************************
+ * Name: fat_extentfind
+ *
+ * Description:
+ *   Look up a cluster of the file in the extent cache.
+ *
+ * Input Parameters:
+ *   ff      - The opened file
+ *   index   - The index of the cluster in the file
+ *   cluster - The location to return the number of the cluster found
+ *
+ * Returned Value:
+ *   The index of the cluster returned in cluster.  This is the requested
+ *   index if it is in the cache, or else the last cached index before it.
+ *   Zero (with the start cluster) is returned if the cache is empty.
+ *
+ ****************************************************************************/
+
+uint32_t fat_extentfind(struct fat_file_s *ff, uint32_t index,
+                        FAR uint32_t *cluster)
+{
+  FAR struct fat_extent_s *extent;
+  int i;
+
+  for (i = ff->ff_nextents - 1; i >= 0; i--)
+    {
+      extent = &ff->ff_extents[i];
+      if (index >= extent->fe_index)
+        {
+          if (index >= extent->fe_index + extent->fe_count)
+            {
+              index = extent->fe_index + extent->fe_count - 1;
+            }
+
+          *cluster = extent->fe_cluster + (index - extent->fe_index);
+          return index;
+        }
+    }
+
+  *cluster = ff->ff_startcluster;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: fat_extentadd
+ *
+ * Description:
+ *   Record a cluster of the file in the extent cache as the chain is
+ *   followed.  The cache holds the runs of the start of the chain, so the
+ *   cluster is only recorded if it follows the last cached cluster.
+ *
+ * Input Parameters:
+ *   ff      - The opened file
+ *   index   - The index of the cluster in the file
+ *   cluster - The cluster number
+ *
+ ****************************************************************************/
+
+void fat_extentadd(struct fat_file_s *ff, uint32_t index, uint32_t cluster)
+{
+  FAR struct fat_extent_s *extent;
+  uint32_t end;
+
+  /* The first run starts with the start cluster */
+
+  if (ff->ff_nextents == 0 && index > 0)
+    {
+      extent = &ff->ff_extents[0];
+      extent->fe_index   = 0;
+      extent->fe_cluster = ff->ff_startcluster;
+      extent->fe_count   = 1;
+      ff->ff_nextents    = 1;
+    }
+
+  end = 0;
+  if (ff->ff_nextents > 0)
+    {
+      /* Does the cluster continue the last run? */
+
+      extent = &ff->ff_extents[ff->ff_nextents - 1];
+      end    = extent->fe_index + extent->fe_count;
+
+      if (index == end && cluster == extent->fe_cluster + extent->fe_count)
+        {
+          extent->fe_count++;
+          return;
+        }
+    }
+
+  /* No.. start a new run if there is room */
+
+  if (index == end && ff->ff_nextents < CONFIG_FAT_NEXTENTS)
+    {
+      extent = &ff->ff_extents[ff->ff_nextents++];
+      extent->fe_index   = index;
+      extent->fe_cluster = cluster;
+      extent->fe_count   = 1;
+    }
+}
+#endif
@@ -51,6 +51,7 @@
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/fat.h>
@@ -66,6 +67,10 @@
 
 #define HOSTFS_RETRY_DELAY_MS       10
 
+/* The validity of cached data in clock ticks */
+
+#define HOSTFS_CACHE_TICKS          MSEC2TICK(CONFIG_FS_HOSTFS_CACHE_TIMEOUT)
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -247,6 +252,203 @@ static void hostfs_mkpath(FAR struct hostfs_mountpt_s  *fs,
     }
 }
 
+/****************************************************************************
+ * Name: hostfs_rasync
+ *
+ * Description:
+ *   Discard the read-ahead data of a file and move the file position of
+ *   the host back to the first byte that was not read yet.  This must be
+ *   done before any operation that depends on the file position of the
+ *   host.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+static int hostfs_rasync(FAR struct hostfs_ofile_s *hf)
+{
+  off_t ret = 0;
+
+  if (hf->raidx < hf->ralen)
+    {
+      ret = host_lseek(hf->fd, -(off_t)(hf->ralen - hf->raidx), SEEK_CUR);
+    }
+
+  hf->ralen = 0;
+  hf->raidx = 0;
+  return ret < 0 ? (int)ret : OK;
+}
+
+/****************************************************************************
+ * Name: hostfs_raread
+ *
+ * Description:
+ *   Read from a file through its read-ahead buffer.  Reads that are at
+ *   least as large as the buffer are passed to the host directly.
+ *
+ ****************************************************************************/
+
+static ssize_t hostfs_raread(FAR struct hostfs_ofile_s *hf,
+                             FAR char *buffer, size_t buflen)
+{
+  size_t nread = 0;
+  ssize_t ret = 0;
+  size_t ncopy;
+
+  /* Data that was read ahead too long ago may be outdated */
+
+  if (hf->ralen > 0 &&
+      clock_systime_ticks() - hf->ratime > HOSTFS_CACHE_TICKS)
+    {
+      ret = hostfs_rasync(hf);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  while (nread < buflen)
+    {
+      /* Copy what is left in the buffer */
+
+      if (hf->raidx < hf->ralen)
+        {
+          ncopy = MIN(hf->ralen - hf->raidx, buflen - nread);
+          memcpy(buffer + nread, hf->rabuf + hf->raidx, ncopy);
+          hf->raidx += ncopy;
+          nread     += ncopy;
+          continue;
+        }
+
+      hf->ralen = 0;
+      hf->raidx = 0;
+
+      if (hf->rabuf == NULL && buflen - nread < CONFIG_FS_HOSTFS_READAHEAD)
+        {
+          hf->rabuf = kmm_malloc(CONFIG_FS_HOSTFS_READAHEAD);
+        }
+
+      /* Large reads gain nothing from the buffer */
+
+      if (hf->rabuf == NULL || buflen - nread >= CONFIG_FS_HOSTFS_READAHEAD)
+        {
+          ret = host_read(hf->fd, buffer + nread, buflen - nread);
+          if (ret > 0)
+            {
+              nread += ret;
+            }
+
+          break;
+        }
+
+      /* Refill the buffer.  Stop at the end of the file. */
+
+      ret = host_read(hf->fd, hf->rabuf, CONFIG_FS_HOSTFS_READAHEAD);
+      if (ret <= 0)
+        {
+          break;
+        }
+
+      hf->ralen  = ret;
+      hf->ratime = clock_systime_ticks();
+
+      ncopy = MIN(hf->ralen, buflen - nread);
+      memcpy(buffer + nread, hf->rabuf, ncopy);
+      hf->raidx = ncopy;
+      nread    += ncopy;
+
+      if (ret < CONFIG_FS_HOSTFS_READAHEAD)
+        {
+          break;
+        }
+    }
+
+  return nread > 0 ? (ssize_t)nread : ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: hostfs_attrfind
+ *
+ * Description:
+ *   Return the cached attributes of a host path if they are still valid.
+ *
+ ****************************************************************************/
+
+#if CONFIG_FS_HOSTFS_ATTRCACHE > 0
+static bool hostfs_attrfind(FAR struct hostfs_mountpt_s *fs,
+                            FAR const char *path, FAR struct stat *buf)
+{
+  FAR struct hostfs_attr_s *attr;
+  clock_t now = clock_systime_ticks();
+  int i;
+
+  for (i = 0; i < CONFIG_FS_HOSTFS_ATTRCACHE; i++)
+    {
+      attr = &fs->fs_attr[i];
+      if (attr->path[0] != '\0' && strcmp(attr->path, path) == 0)
+        {
+          if (now - attr->time > HOSTFS_CACHE_TICKS)
+            {
+              attr->path[0] = '\0';
+              return false;
+            }
+
+          memcpy(buf, &attr->buf, sizeof(struct stat));
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: hostfs_attrsave
+ *
+ * Description:
+ *   Add the attributes of a host path to the cache.  The oldest entry is
+ *   replaced.
+ *
+ ****************************************************************************/
+
+static void hostfs_attrsave(FAR struct hostfs_mountpt_s *fs,
+                            FAR const char *path,
+                            FAR const struct stat *buf)
+{
+  FAR struct hostfs_attr_s *attr = &fs->fs_attr[fs->fs_attrnext];
+
+  if (++fs->fs_attrnext >= CONFIG_FS_HOSTFS_ATTRCACHE)
+    {
+      fs->fs_attrnext = 0;
+    }
+
+  strncpy(attr->path, path, sizeof(attr->path));
+  attr->path[sizeof(attr->path) - 1] = '\0';
+  memcpy(&attr->buf, buf, sizeof(struct stat));
+  attr->time = clock_systime_ticks();
+}
+
+/****************************************************************************
+ * Name: hostfs_attrflush
+ *
+ * Description:
+ *   Discard all cached attributes of the mountpoint.  This is done on each
+ *   change made through the mountpoint.
+ *
+ ****************************************************************************/
+
+static void hostfs_attrflush(FAR struct hostfs_mountpt_s *fs)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_FS_HOSTFS_ATTRCACHE; i++)
+    {
+      fs->fs_attr[i].path[0] = '\0';
+    }
+}
+#else
+#  define hostfs_attrflush(fs)
+#endif
+
 /****************************************************************************
  * Name: hostfs_open
  ****************************************************************************/
@@ -283,7 +485,7 @@ static int hostfs_open(FAR struct file *filep, FAR const char *relpath,
 
   /* Allocate memory for the open file */
 
-  hf = (struct hostfs_ofile_s *) kmm_malloc(sizeof *hf);
+  hf = (struct hostfs_ofile_s *) kmm_zalloc(sizeof *hf);
   if (hf == NULL)
     {
       ret = -ENOMEM;
@@ -305,6 +507,13 @@ static int hostfs_open(FAR struct file *filep, FAR const char *relpath,
       goto errout_with_buffer;
     }
 
+  /* Opening for writing may create or truncate the file */
+
+  if ((oflags & O_WROK) != 0)
+    {
+      hostfs_attrflush(fs);
+    }
+
   /* In write/append mode, we need to set the file pointer to the end of the
    * file.
    */
@@ -435,6 +644,9 @@ static int hostfs_close(FAR struct file *filep)
   /* Now free the pointer */
 
   filep->f_priv = NULL;
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  kmm_free(hf->rabuf);
+#endif
   kmm_free(hf);
 
 okout:
@@ -476,7 +688,11 @@ static ssize_t hostfs_read(FAR struct file *filep, FAR char *buffer,
 
   /* Call the host to perform the read */
 
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  ret = hostfs_raread(hf, buffer, buflen);
+#else
   ret = host_read(hf->fd, buffer, buflen);
+#endif
   if (ret > 0)
     {
       filep->f_pos += ret;
@@ -542,10 +758,19 @@ static ssize_t hostfs_write(FAR struct file *filep, const char *buffer,
 
   /* Call the host to perform the write */
 
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  ret = hostfs_rasync(hf);
+  if (ret < 0)
+    {
+      goto errout_with_semaphore;
+    }
+#endif
+
   ret = host_write(hf->fd, buffer, buflen);
   if (ret > 0)
     {
       filep->f_pos += ret;
+      hostfs_attrflush(fs);
     }
 
 errout_with_semaphore:
@@ -586,7 +811,14 @@ static off_t hostfs_seek(FAR struct file *filep, off_t offset, int whence)
 
   /* Call our internal routine to perform the seek */
 
-  ret = host_lseek(hf->fd, offset, whence);
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  ret = hostfs_rasync(hf);
+  if (ret >= 0)
+#endif
+    {
+      ret = host_lseek(hf->fd, offset, whence);
+    }
+
   if (ret >= 0)
     {
       filep->f_pos = ret;
@@ -629,7 +861,13 @@ static int hostfs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
   /* Call our internal routine to perform the ioctl */
 
-  ret = host_ioctl(hf->fd, cmd, arg);
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  ret = hostfs_rasync(hf);
+  if (ret >= 0)
+#endif
+    {
+      ret = host_ioctl(hf->fd, cmd, arg);
+    }
 
   hostfs_semgive(fs);
   return ret;
@@ -791,7 +1029,15 @@ static int hostfs_ftruncate(FAR struct file *filep, off_t length)
 
   /* Call the host to perform the truncate */
 
-  ret = host_ftruncate(hf->fd, length);
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  ret = hostfs_rasync(hf);
+  if (ret >= 0)
+#endif
+    {
+      ret = host_ftruncate(hf->fd, length);
+    }
+
+  hostfs_attrflush(fs);
 
   hostfs_semgive(fs);
   return ret;
@@ -1174,6 +1420,7 @@ static int hostfs_unlink(FAR struct inode *mountpt, FAR const char *relpath)
   /* Call the host fs to perform the unlink */
 
   ret = host_unlink(path);
+  hostfs_attrflush(fs);
 
   hostfs_semgive(fs);
   return ret;
@@ -1214,6 +1461,7 @@ static int hostfs_mkdir(FAR struct inode *mountpt, FAR const char *relpath,
   /* Call the host FS to do the mkdir */
 
   ret = host_mkdir(path, mode);
+  hostfs_attrflush(fs);
 
   hostfs_semgive(fs);
   return ret;
@@ -1255,6 +1503,7 @@ int hostfs_rmdir(FAR struct inode *mountpt, FAR const char *relpath)
   /* Call the host FS to do the mkdir */
 
   ret = host_rmdir(path);
+  hostfs_attrflush(fs);
 
   hostfs_semgive(fs);
   return ret;
@@ -1299,6 +1548,7 @@ int hostfs_rename(FAR struct inode *mountpt, FAR const char *oldrelpath,
   /* Call the host FS to do the mkdir */
 
   ret = host_rename(oldpath, newpath);
+  hostfs_attrflush(fs);
 
   hostfs_semgive(fs);
   return ret;
@@ -1338,8 +1588,23 @@ static int hostfs_stat(FAR struct inode *mountpt, FAR const char *relpath,
 
   /* Call the host FS to do the stat operation */
 
+#if CONFIG_FS_HOSTFS_ATTRCACHE > 0
+  if (hostfs_attrfind(fs, path, buf))
+    {
+      hostfs_semgive(fs);
+      return OK;
+    }
+#endif
+
   ret = host_stat(path, buf);
 
+#if CONFIG_FS_HOSTFS_ATTRCACHE > 0
+  if (ret >= 0)
+    {
+      hostfs_attrsave(fs, path, buf);
+    }
+#endif
+
   hostfs_semgive(fs);
   return ret;
 }
@@ -43,8 +43,10 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <sys/stat.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <time.h>
 
 #include <nuttx/semaphore.h>
 
@@ -64,6 +66,18 @@
 
 #define HOSTFS_MAX_PATH     256
 
+#ifndef CONFIG_FS_HOSTFS_READAHEAD
+#  define CONFIG_FS_HOSTFS_READAHEAD 0
+#endif
+
+#ifndef CONFIG_FS_HOSTFS_ATTRCACHE
+#  define CONFIG_FS_HOSTFS_ATTRCACHE 0
+#endif
+
+#ifndef CONFIG_FS_HOSTFS_CACHE_TIMEOUT
+#  define CONFIG_FS_HOSTFS_CACHE_TIMEOUT 100
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -78,8 +92,25 @@ struct hostfs_ofile_s
   int16_t                   crefs;      /* Reference count */
   mode_t                    oflags;     /* Open mode */
   int                       fd;
+#if CONFIG_FS_HOSTFS_READAHEAD > 0
+  FAR char                 *rabuf;      /* Read-ahead buffer */
+  size_t                    ralen;      /* Number of bytes in rabuf */
+  size_t                    raidx;      /* Index of the next byte to read */
+  clock_t                   ratime;     /* Time when rabuf was filled */
+#endif
 };
 
+/* One cached result of stat().  An empty path marks a free entry. */
+
+#if CONFIG_FS_HOSTFS_ATTRCACHE > 0
+struct hostfs_attr_s
+{
+  char                      path[HOSTFS_MAX_PATH];
+  struct stat               buf;
+  clock_t                   time;       /* Time when buf was obtained */
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of
  * this structure is retained as inode private data on each mountpoint that
  * is mounted with a hostfs filesystem.
@@ -90,6 +121,10 @@ struct hostfs_mountpt_s
   sem_t                      *fs_sem;       /* Used to assure thread-safe access */
   FAR struct hostfs_ofile_s  *fs_head;      /* A singly-linked list of open files */
   char                        fs_root[HOSTFS_MAX_PATH];
+#if CONFIG_FS_HOSTFS_ATTRCACHE > 0
+  struct hostfs_attr_s        fs_attr[CONFIG_FS_HOSTFS_ATTRCACHE];
+  unsigned int                fs_attrnext;  /* Next entry to replace */
+#endif
 };
 
 /****************************************************************************
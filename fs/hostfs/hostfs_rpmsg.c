@@ -51,6 +51,14 @@
 
 #include "hostfs_rpmsg.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The size in bytes of the names of a batch of directory entries */
+
+#define HOSTFS_RPMSG_DIRBUF         512
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -68,6 +76,26 @@ struct hostfs_rpmsg_cookie_s
   FAR void  *data;
 };
 
+/* An open directory.  The entries returned by one READDIRS request are
+ * kept here until they are read.
+ */
+
+#ifdef CONFIG_FS_HOSTFS_RPMSG_READDIRS
+struct hostfs_rpmsg_dir_s
+{
+  int       fd;
+  int       count;                /* Number of entries in names */
+  int       index;                /* Index of the next entry */
+  FAR char  *next;                /* Name of the next entry */
+  uint32_t  type[HOSTFS_RPMSG_READDIRS_MAX];
+  char      names[B2C(HOSTFS_RPMSG_DIRBUF)];
+};
+
+#  define HOSTFS_RPMSG_DIRFD(d) (((FAR struct hostfs_rpmsg_dir_s *)(d))->fd)
+#else
+#  define HOSTFS_RPMSG_DIRFD(d) ((uintptr_t)(d))
+#endif
+
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
@@ -81,12 +109,18 @@ static int hostfs_rpmsg_read_handler(FAR struct rpmsg_endpoint *ept,
 static int hostfs_rpmsg_readdir_handler(FAR struct rpmsg_endpoint *ept,
                                         FAR void *data, size_t len,
                                         uint32_t src, FAR void *priv);
+#ifdef CONFIG_FS_HOSTFS_RPMSG_READDIRS
+static int hostfs_rpmsg_readdirs_handler(FAR struct rpmsg_endpoint *ept,
+                                         FAR void *data, size_t len,
+                                         uint32_t src, FAR void *priv);
+#endif
 static int hostfs_rpmsg_statfs_handler(FAR struct rpmsg_endpoint *ept,
                                        FAR void *data, size_t len,
                                        uint32_t src, FAR void *priv);
 static int hostfs_rpmsg_stat_handler(FAR struct rpmsg_endpoint *ept,
                                      FAR void *data, size_t len,
                                      uint32_t src, FAR void *priv);
+static int  hostfs_rpmsg_closedir(int fd);
 static void hostfs_rpmsg_device_created(struct rpmsg_device *rdev,
                                         FAR void *priv_);
 static void hostfs_rpmsg_device_destroy(struct rpmsg_device *rdev,
@@ -126,6 +160,9 @@ static const rpmsg_ept_cb g_hostfs_rpmsg_handler[] =
   [HOSTFS_RPMSG_RMDIR]     = hostfs_rpmsg_default_handler,
   [HOSTFS_RPMSG_RENAME]    = hostfs_rpmsg_default_handler,
   [HOSTFS_RPMSG_STAT]      = hostfs_rpmsg_stat_handler,
+#ifdef CONFIG_FS_HOSTFS_RPMSG_READDIRS
+  [HOSTFS_RPMSG_READDIRS]  = hostfs_rpmsg_readdirs_handler,
+#endif
 };
 
 /****************************************************************************
@@ -194,6 +231,30 @@ static int hostfs_rpmsg_readdir_handler(FAR struct rpmsg_endpoint *ept,
   return 0;
 }
 
+#ifdef CONFIG_FS_HOSTFS_RPMSG_READDIRS
+static int hostfs_rpmsg_readdirs_handler(FAR struct rpmsg_endpoint *ept,
+                                         FAR void *data, size_t len,
+                                         uint32_t src, FAR void *priv)
+{
+  FAR struct hostfs_rpmsg_header_s *header = data;
+  FAR struct hostfs_rpmsg_cookie_s *cookie =
+      (struct hostfs_rpmsg_cookie_s *)(uintptr_t)header->cookie;
+  FAR struct hostfs_rpmsg_readdirs_s *rsp = data;
+  FAR struct hostfs_rpmsg_dir_s *dir = cookie->data;
+
+  cookie->result = header->result;
+  if (cookie->result > 0)
+    {
+      memcpy(dir->type, rsp->type, sizeof(dir->type));
+      memcpy(dir->names, rsp->names, B2C(rsp->size));
+    }
+
+  nxsem_post(&cookie->sem);
+
+  return 0;
+}
+#endif
+
 static int hostfs_rpmsg_statfs_handler(FAR struct rpmsg_endpoint *ept,
                                        FAR void *data, size_t len,
                                        uint32_t src, FAR void *priv)
@@ -255,6 +316,17 @@ static int hostfs_rpmsg_stat_handler(FAR struct rpmsg_endpoint *ept,
   return 0;
 }
 
+static int hostfs_rpmsg_closedir(int fd)
+{
+  struct hostfs_rpmsg_closedir_s msg =
+  {
+    .fd = fd,
+  };
+
+  return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_CLOSEDIR, true,
+          (struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), NULL);
+}
+
 static void hostfs_rpmsg_device_created(FAR struct rpmsg_device *rdev,
                                         FAR void *priv_)
 {
@@ -552,11 +624,65 @@ FAR void *host_opendir(FAR const char *name)
   ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_OPENDIR, false,
           (struct hostfs_rpmsg_header_s *)msg, len, NULL);
 
+#ifdef CONFIG_FS_HOSTFS_RPMSG_READDIRS
+  if (ret >= 0)
+    {
+      FAR struct hostfs_rpmsg_dir_s *dir;
+
+      dir = kmm_zalloc(sizeof(*dir));
+      if (dir == NULL)
+        {
+          hostfs_rpmsg_closedir(ret);
+          return NULL;
+        }
+
+      dir->fd = ret;
+      return dir;
+    }
+
+  return NULL;
+#else
   return ret < 0 ? NULL : (FAR void *)((uintptr_t)ret);
+#endif
 }
 
 int host_readdir(FAR void *dirp, FAR struct dirent *entry)
 {
+#ifdef CONFIG_FS_HOSTFS_RPMSG_READDIRS
+  FAR struct hostfs_rpmsg_dir_s *dir = dirp;
+  size_t len;
+  int ret;
+
+  /* Fetch the next batch of entries when all were read */
+
+  if (dir->index >= dir->count)
+    {
+      struct hostfs_rpmsg_readdirs_s msg =
+      {
+        .fd   = dir->fd,
+        .size = HOSTFS_RPMSG_DIRBUF,
+      };
+
+      ret = hostfs_rpmsg_send_recv(HOSTFS_RPMSG_READDIRS, true,
+              (struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), dir);
+      if (ret <= 0)
+        {
+          return ret < 0 ? ret : -ENOENT;
+        }
+
+      dir->count = ret;
+      dir->index = 0;
+      dir->next  = dir->names;
+    }
+
+  nbstr2cstr(entry->d_name, dir->next, NAME_MAX);
+  entry->d_name[NAME_MAX] = '\0';
+  entry->d_type = dir->type[dir->index++];
+
+  len = bstrnlen(dir->next, NAME_MAX + 1) + 1;
+  dir->next += B2C(HOSTFS_RPMSG_NAMESIZE(len));
+  return 0;
+#else
   struct hostfs_rpmsg_readdir_s msg =
   {
     .fd = (uintptr_t)dirp,
@@ -564,28 +690,36 @@ int host_readdir(FAR void *dirp, FAR struct dirent *entry)
 
   return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_READDIR, true,
           (struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), entry);
+#endif
 }
 
 void host_rewinddir(FAR void *dirp)
 {
   struct hostfs_rpmsg_rewinddir_s msg =
   {
-    .fd = (uintptr_t)dirp,
+    .fd = HOSTFS_RPMSG_DIRFD(dirp),
   };
 
+#ifdef CONFIG_FS_HOSTFS_RPMSG_READDIRS
+  FAR struct hostfs_rpmsg_dir_s *dir = dirp;
+
+  dir->count = 0;
+  dir->index = 0;
+#endif
+
   hostfs_rpmsg_send_recv(HOSTFS_RPMSG_REWINDDIR, true,
           (struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), NULL);
 }
 
 int host_closedir(FAR void *dirp)
 {
-  struct hostfs_rpmsg_closedir_s msg =
-  {
-    .fd = (uintptr_t)dirp,
-  };
+  int ret;
 
-  return hostfs_rpmsg_send_recv(HOSTFS_RPMSG_CLOSEDIR, true,
-          (struct hostfs_rpmsg_header_s *)&msg, sizeof(msg), NULL);
+  ret = hostfs_rpmsg_closedir(HOSTFS_RPMSG_DIRFD(dirp));
+#ifdef CONFIG_FS_HOSTFS_RPMSG_READDIRS
+  kmm_free(dirp);
+#endif
+  return ret;
 }
 
 int host_statfs(FAR const char *path, FAR struct statfs *buf)
@@ -74,6 +74,17 @@
 #define HOSTFS_RPMSG_RMDIR          18
 #define HOSTFS_RPMSG_RENAME         19
 #define HOSTFS_RPMSG_STAT           20
+#define HOSTFS_RPMSG_READDIRS       21
+
+/* The maximum number of directory entries returned by one READDIRS request.
+ * Each name in the response is terminated and padded to a multiple of
+ * HOSTFS_RPMSG_NAMEALIGN bytes.
+ */
+
+#define HOSTFS_RPMSG_READDIRS_MAX   16
+#define HOSTFS_RPMSG_NAMEALIGN      4
+#define HOSTFS_RPMSG_NAMESIZE(n)    (((n) + HOSTFS_RPMSG_NAMEALIGN - 1) & \
+                                     ~(HOSTFS_RPMSG_NAMEALIGN - 1))
 
 /****************************************************************************
  * Public Types
@@ -158,6 +169,15 @@ begin_packed_struct struct hostfs_rpmsg_readdir_s
   char                         name[0];
 } end_packed_struct;
 
+begin_packed_struct struct hostfs_rpmsg_readdirs_s
+{
+  struct hostfs_rpmsg_header_s header;
+  int32_t                      fd;
+  uint32_t                     size;    /* Maximum size of the names */
+  uint32_t                     type[HOSTFS_RPMSG_READDIRS_MAX];
+  char                         names[0];
+} end_packed_struct;
+
 #define hostfs_rpmsg_rewinddir_s hostfs_rpmsg_close_s
 #define hostfs_rpmsg_closedir_s hostfs_rpmsg_close_s
 
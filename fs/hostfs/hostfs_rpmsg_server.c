@@ -62,6 +62,7 @@ struct hostfs_rpmsg_server_s
   struct rpmsg_endpoint ept;
   struct file           files[CONFIG_NFILE_DESCRIPTORS];
   void                  *dirs[CONFIG_NFILE_DESCRIPTORS];
+  struct dirent         *pending[CONFIG_NFILE_DESCRIPTORS];
   sem_t                 sem;
 };
 
@@ -105,6 +106,9 @@ static int hostfs_rpmsg_opendir_handler(FAR struct rpmsg_endpoint *ept,
 static int hostfs_rpmsg_readdir_handler(FAR struct rpmsg_endpoint *ept,
                                         FAR void *data, size_t len,
                                         uint32_t src, FAR void *priv_);
+static int hostfs_rpmsg_readdirs_handler(FAR struct rpmsg_endpoint *ept,
+                                         FAR void *data, size_t len,
+                                         uint32_t src, FAR void *priv_);
 static int hostfs_rpmsg_rewinddir_handler(FAR struct rpmsg_endpoint *ept,
                                           FAR void *data, size_t len,
                                           uint32_t src, FAR void *priv_);
@@ -164,6 +168,7 @@ static const rpmsg_ept_cb g_hostfs_rpmsg_handler[] =
   [HOSTFS_RPMSG_RMDIR]     = hostfs_rpmsg_rmdir_handler,
   [HOSTFS_RPMSG_RENAME]    = hostfs_rpmsg_rename_handler,
   [HOSTFS_RPMSG_STAT]      = hostfs_rpmsg_stat_handler,
+  [HOSTFS_RPMSG_READDIRS]  = hostfs_rpmsg_readdirs_handler,
 };
 
 /****************************************************************************
@@ -440,7 +445,15 @@ static int hostfs_rpmsg_readdir_handler(FAR struct rpmsg_endpoint *ept,
 
   if (msg->fd >= 1 && msg->fd < CONFIG_NFILE_DESCRIPTORS)
     {
-      entry = readdir(priv->dirs[msg->fd]);
+      /* An entry left over by a READDIRS request comes first */
+
+      entry = priv->pending[msg->fd];
+      priv->pending[msg->fd] = NULL;
+      if (entry == NULL)
+        {
+          entry = readdir(priv->dirs[msg->fd]);
+        }
+
       if (entry)
         {
           msg->type = entry->d_type;
@@ -454,6 +467,71 @@ static int hostfs_rpmsg_readdir_handler(FAR struct rpmsg_endpoint *ept,
   return rpmsg_send(ept, msg, len);
 }
 
+static int hostfs_rpmsg_readdirs_handler(FAR struct rpmsg_endpoint *ept,
+                                         FAR void *data, size_t len,
+                                         uint32_t src, FAR void *priv_)
+{
+  FAR struct hostfs_rpmsg_server_s *priv = priv_;
+  FAR struct hostfs_rpmsg_readdirs_s *msg = data;
+  FAR struct hostfs_rpmsg_readdirs_s *rsp;
+  FAR struct dirent *entry;
+  uint32_t space;
+  size_t namesize;
+  size_t off = 0;
+  int ret = -ENOENT;
+
+  rsp = rpmsg_get_tx_payload_buffer(ept, &space, true);
+  if (!rsp)
+    {
+      return -ENOMEM;
+    }
+
+  *rsp = *msg;
+
+  space -= sizeof(*msg);
+  if (space > msg->size)
+    {
+      space = msg->size;
+    }
+
+  if (msg->fd >= 1 && msg->fd < CONFIG_NFILE_DESCRIPTORS)
+    {
+      for (ret = 0; ret < HOSTFS_RPMSG_READDIRS_MAX; ret++)
+        {
+          entry = priv->pending[msg->fd];
+          priv->pending[msg->fd] = NULL;
+          if (entry == NULL)
+            {
+              entry = readdir(priv->dirs[msg->fd]);
+              if (entry == NULL)
+                {
+                  break;
+                }
+            }
+
+          /* An entry that does not fit is kept for the next request.  The
+           * entry stays valid until the next readdir() of the directory.
+           */
+
+          namesize = HOSTFS_RPMSG_NAMESIZE(strlen(entry->d_name) + 1);
+          if (off + namesize > space)
+            {
+              priv->pending[msg->fd] = entry;
+              break;
+            }
+
+          rsp->type[ret] = entry->d_type;
+          memset(&rsp->names[off], 0, namesize);
+          strcpy(&rsp->names[off], entry->d_name);
+          off += namesize;
+        }
+    }
+
+  rsp->size          = off;
+  rsp->header.result = ret;
+  return rpmsg_send_nocopy(ept, rsp, sizeof(*rsp) + off);
+}
+
 static int hostfs_rpmsg_rewinddir_handler(FAR struct rpmsg_endpoint *ept,
                                           FAR void *data, size_t len,
                                           uint32_t src, FAR void *priv_)
@@ -465,6 +543,7 @@ static int hostfs_rpmsg_rewinddir_handler(FAR struct rpmsg_endpoint *ept,
   if (msg->fd >= 1 && msg->fd < CONFIG_NFILE_DESCRIPTORS)
     {
       rewinddir(priv->dirs[msg->fd]);
+      priv->pending[msg->fd] = NULL;
       ret = 0;
     }
 
@@ -485,6 +564,7 @@ static int hostfs_rpmsg_closedir_handler(FAR struct rpmsg_endpoint *ept,
       ret = closedir(priv->dirs[msg->fd]);
       nxsem_wait(&priv->sem);
       priv->dirs[msg->fd] = NULL;
+      priv->pending[msg->fd] = NULL;
       nxsem_post(&priv->sem);
       ret = ret ? -get_errno() : 0;
     }
@@ -141,6 +141,7 @@ int file_detach(int fd, FAR struct file *filep)
   parent->f_pos    = 0;
   parent->f_inode  = NULL;
   parent->f_priv   = NULL;
+  FILES_MAPCLR(list, fd);
 
   _files_semgive(list);
   return OK;
@@ -25,7 +25,9 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
+#include <strings.h>
 #include <assert.h>
 #include <sched.h>
 #include <errno.h>
@@ -55,6 +57,37 @@ static int _files_semtake(FAR struct filelist *list)
 
 #define _files_semgive(list) nxsem_post(&list->fl_sem)
 
+/****************************************************************************
+ * Name: _files_mapclr
+ *
+ * Description:
+ *   Mark the file structure as free in the bitmap of the list if it
+ *   belongs to that list.  File structures also live outside of file lists.
+ *
+ ****************************************************************************/
+
+static void _files_mapclr(FAR struct filelist *list, FAR struct file *filep)
+{
+  if (list != NULL && filep >= list->fl_files &&
+      filep < &list->fl_files[CONFIG_NFILE_DESCRIPTORS])
+    {
+      FILES_MAPCLR(list, filep - list->fl_files);
+    }
+}
+
+/****************************************************************************
+ * Name: _files_mapset
+ ****************************************************************************/
+
+static void _files_mapset(FAR struct filelist *list, FAR struct file *filep)
+{
+  if (list != NULL && filep >= list->fl_files &&
+      filep < &list->fl_files[CONFIG_NFILE_DESCRIPTORS])
+    {
+      FILES_MAPSET(list, filep - list->fl_files);
+    }
+}
+
 /****************************************************************************
  * Name: _files_close
  *
@@ -67,7 +100,7 @@ static int _files_semtake(FAR struct filelist *list)
  *
  ****************************************************************************/
 
-static int _files_close(FAR struct file *filep)
+static int _files_close(FAR struct filelist *list, FAR struct file *filep)
 {
   struct inode *inode = filep->f_inode;
   int ret = OK;
@@ -94,6 +127,7 @@ static int _files_close(FAR struct file *filep)
       filep->f_oflags  = 0;
       filep->f_pos     = 0;
       filep->f_inode = NULL;
+      _files_mapclr(list, filep);
     }
 
   return ret;
@@ -152,7 +186,7 @@ void files_releaselist(FAR struct filelist *list)
 
   for (i = 0; i < CONFIG_NFILE_DESCRIPTORS; i++)
     {
-      _files_close(&list->fl_files[i]);
+      _files_close(list, &list->fl_files[i]);
     }
 
   /* Destroy the semaphore */
@@ -212,7 +246,7 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
    * close the file and release the inode.
    */
 
-  ret = _files_close(filep2);
+  ret = _files_close(list, filep2);
   if (ret < 0)
     {
       /* An error occurred while closing the driver */
@@ -234,6 +268,7 @@ int file_dup2(FAR struct file *filep1, FAR struct file *filep2)
   filep2->f_oflags = filep1->f_oflags;
   filep2->f_pos    = filep1->f_pos;
   filep2->f_inode  = inode;
+  _files_mapset(list, filep2);
 
   /* Call the open method on the file, driver, mountpoint so that it
    * can maintain the correct open counts.
@@ -279,6 +314,7 @@ errout_with_inode:
   filep2->f_oflags = 0;
   filep2->f_pos    = 0;
   filep2->f_inode  = NULL;
+  _files_mapclr(list, filep2);
 
 errout_with_sem:
   if (list != NULL)
@@ -296,13 +332,18 @@ errout_with_sem:
  *   Allocate a struct files instance and associate it with an inode
  *   instance.  Returns the file descriptor == index into the files array.
  *
+ *   The lowest free descriptor at or above minfd is found in the bitmap
+ *   of descriptors in use.
+ *
  ****************************************************************************/
 
 int files_allocate(FAR struct inode *inode, int oflags, off_t pos, int minfd)
 {
   FAR struct filelist *list;
+  uint32_t map;
   int ret;
   int i;
+  int w;
 
   /* Get the file descriptor list.  It should not be NULL in this context. */
 
@@ -317,16 +358,41 @@ int files_allocate(FAR struct inode *inode, int oflags, off_t pos, int minfd)
       return ret;
     }
 
-  for (i = minfd; i < CONFIG_NFILE_DESCRIPTORS; i++)
+  for (w = minfd >> 5; w < FILELIST_NMAPS; w++)
     {
-      if (!list->fl_files[i].f_inode)
+      /* Ignore the descriptors below minfd in the first word */
+
+      map = list->fl_map[w];
+      if (w == (minfd >> 5) && (minfd & 31) != 0)
         {
-          list->fl_files[i].f_oflags = oflags;
-          list->fl_files[i].f_pos    = pos;
-          list->fl_files[i].f_inode  = inode;
-          list->fl_files[i].f_priv   = NULL;
-          _files_semgive(list);
-          return i;
+          map |= ((uint32_t)1 << (minfd & 31)) - 1;
+        }
+
+      while (map != UINT32_MAX)
+        {
+          i = (w << 5) + ffs((int)~map) - 1;
+          if (i >= CONFIG_NFILE_DESCRIPTORS)
+            {
+              break;
+            }
+
+          map |= (uint32_t)1 << (i & 31);
+          FILES_MAPSET(list, i);
+
+          /* The bit may not be set if the descriptor was assigned from
+           * outside of the list, such as when duplicating the descriptors
+           * of a new task.
+           */
+
+          if (!list->fl_files[i].f_inode)
+            {
+              list->fl_files[i].f_oflags = oflags;
+              list->fl_files[i].f_pos    = pos;
+              list->fl_files[i].f_inode  = inode;
+              list->fl_files[i].f_priv   = NULL;
+              _files_semgive(list);
+              return i;
+            }
         }
     }
 
@@ -371,7 +437,7 @@ int files_close(int fd)
   ret = _files_semtake(list);
   if (ret >= 0)
     {
-      ret = _files_close(&list->fl_files[fd]);
+      ret = _files_close(list, &list->fl_files[fd]);
       _files_semgive(list);
     }
 
@@ -403,6 +469,7 @@ void files_release(int fd)
           list->fl_files[fd].f_oflags  = 0;
           list->fl_files[fd].f_pos     = 0;
           list->fl_files[fd].f_inode = NULL;
+          FILES_MAPCLR(list, fd);
           _files_semgive(list);
         }
     }
@@ -0,0 +1,224 @@
+/****************************************************************************
+ * fs/inode/fs_inodecache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_FS_INODECACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define INODECACHE_NORELPATH 0xff  /* relpath of the result is NULL */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure holds the result of one inode_search().  Results with
+ * node == NULL and ret == -ENOENT are negative entries:  They record that
+ * the path does not exist and where it would be inserted.
+ */
+
+struct inode_cache_s
+{
+  uint32_t gen;                          /* Tree generation; 0: Unused */
+  FAR struct inode *node;                /* Result node */
+  FAR struct inode *peer;                /* Result peer */
+  FAR struct inode *parent;              /* Result parent */
+  int16_t  ret;                          /* Result of the search */
+  uint8_t  pathoff;                      /* Result path offset in path */
+  uint8_t  reloff;                       /* Result relpath offset in path */
+
+  /* The path searched */
+
+  char     path[CONFIG_FS_INODECACHE_PATHLEN];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct inode_cache_s g_inode_cache[CONFIG_FS_INODECACHE_NENTRIES];
+
+/* Incremented each time the inode tree changes so that all results found
+ * before the change are stale.
+ */
+
+static uint32_t g_inode_cachegen = 1;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cachehash
+ *
+ * Description:
+ *   Return the cache entry used for a path, or NULL if the path is too
+ *   long to be cached.
+ *
+ ****************************************************************************/
+
+static FAR struct inode_cache_s *inode_cachehash(FAR const char *path)
+{
+  uint32_t hash = 2166136261u;  /* FNV-1a */
+  size_t len;
+
+  for (len = 0; path[len] != '\0'; len++)
+    {
+      if (len >= CONFIG_FS_INODECACHE_PATHLEN - 1)
+        {
+          return NULL;
+        }
+
+      hash = (hash ^ (uint8_t)path[len]) * 16777619u;
+    }
+
+  return &g_inode_cache[hash % CONFIG_FS_INODECACHE_NENTRIES];
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_cachelookup
+ *
+ * Description:
+ *   Return the cached result of inode_search() for the path in 'desc'.
+ *
+ * Returned Value:
+ *   True if the result was found and returned in 'desc' and 'ret'.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+bool inode_cachelookup(FAR struct inode_search_s *desc, FAR int *ret)
+{
+  FAR struct inode_cache_s *entry;
+  FAR const char *path = desc->path;
+
+  entry = inode_cachehash(path);
+  if (entry == NULL || entry->gen != g_inode_cachegen ||
+      strcmp(entry->path, path) != 0)
+    {
+      return false;
+    }
+
+  desc->path    = path + entry->pathoff;
+  desc->node    = entry->node;
+  desc->peer    = entry->peer;
+  desc->parent  = entry->parent;
+  desc->relpath = entry->reloff == INODECACHE_NORELPATH ?
+                  NULL : path + entry->reloff;
+
+  *ret = entry->ret;
+  return true;
+}
+
+/****************************************************************************
+ * Name: inode_cacheadd
+ *
+ * Description:
+ *   Remember the result of inode_search() for 'path'.  Only results that
+ *   do not depend on soft links are cached, as well as only successes and
+ *   -ENOENT.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cacheadd(FAR const char *path, FAR struct inode_search_s *desc,
+                    int ret)
+{
+  FAR struct inode_cache_s *entry;
+
+  if (ret != OK && ret != -ENOENT)
+    {
+      return;
+    }
+
+#ifdef CONFIG_PSEUDOFS_SOFTLINKS
+  if (desc->linktgt != NULL || desc->buffer != NULL ||
+      (desc->node != NULL && INODE_IS_SOFTLINK(desc->node)))
+    {
+      return;
+    }
+#endif
+
+  entry = inode_cachehash(path);
+  if (entry != NULL)
+    {
+      strcpy(entry->path, path);
+      entry->gen     = g_inode_cachegen;
+      entry->node    = desc->node;
+      entry->peer    = desc->peer;
+      entry->parent  = desc->parent;
+      entry->ret     = (int16_t)ret;
+      entry->pathoff = (uint8_t)(desc->path - path);
+      entry->reloff  = desc->relpath == NULL ? INODECACHE_NORELPATH :
+                       (uint8_t)(desc->relpath - path);
+    }
+}
+
+/****************************************************************************
+ * Name: inode_cacheinvalidate
+ *
+ * Description:
+ *   Discard all cached results of inode_search().  This must be called
+ *   whenever the inode tree changes:  When an inode is inserted or
+ *   unlinked, or becomes or stops being a mountpoint or soft link.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+void inode_cacheinvalidate(void)
+{
+  /* Generation 0 marks unused entries, so clear the whole cache when the
+   * generation number wraps around.
+   */
+
+  if (++g_inode_cachegen == 0)
+    {
+      memset(g_inode_cache, 0, sizeof(g_inode_cache));
+      g_inode_cachegen = 1;
+    }
+}
+
+#endif /* CONFIG_FS_INODECACHE */
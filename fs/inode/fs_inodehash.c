@@ -0,0 +1,340 @@
+/****************************************************************************
+ * fs/inode/fs_inodehash.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_PSEUDOFS_HASH
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define INODE_HASH_MAXBUCKETS 32768
+
+#define INODE_HASH_SIZE(n) \
+  (sizeof(struct inode_hash_s) + ((n) - 1) * sizeof(FAR struct inode *))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The hash index of the children of one directory.  The inodes of a bucket
+ * are chained through i_hnext.
+ */
+
+struct inode_hash_s
+{
+  uint16_t nbuckets;                     /* Number of buckets, power of 2 */
+  uint16_t nchildren;                    /* Number of inodes in the index */
+  FAR struct inode *bucket[1];           /* Hash chains (variable) */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The index of the top level directory, which has no inode */
+
+static FAR struct inode_hash_s *g_root_hash;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_hashslot
+ *
+ * Description:
+ *   Return the location of the index pointer of a directory.
+ *
+ ****************************************************************************/
+
+static FAR struct inode_hash_s **inode_hashslot(FAR struct inode *parent)
+{
+  return parent != NULL ? &parent->i_hash : &g_root_hash;
+}
+
+/****************************************************************************
+ * Name: inode_hashname
+ *
+ * Description:
+ *   Return the hash of the first name in a path and its length.
+ *
+ ****************************************************************************/
+
+static uint32_t inode_hashname(FAR const char *name, FAR size_t *len)
+{
+  uint32_t hash = 2166136261u;  /* FNV-1a */
+  size_t i;
+
+  for (i = 0; name[i] != '\0' && name[i] != '/'; i++)
+    {
+      hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+
+  *len = i;
+  return hash;
+}
+
+/****************************************************************************
+ * Name: inode_hashlink
+ *
+ * Description:
+ *   Add an inode to the chain of its bucket.
+ *
+ ****************************************************************************/
+
+static void inode_hashlink(FAR struct inode_hash_s *hash,
+                           FAR struct inode *node)
+{
+  FAR struct inode **bucket;
+  size_t len;
+
+  bucket  = &hash->bucket[inode_hashname(node->i_name, &len) &
+                          (hash->nbuckets - 1)];
+  node->i_hnext = *bucket;
+  *bucket       = node;
+  hash->nchildren++;
+}
+
+/****************************************************************************
+ * Name: inode_hashbuild
+ *
+ * Description:
+ *   Build an index with 'nbuckets' buckets of all children of a directory.
+ *   The old index, if any, is kept if memory is short.
+ *
+ ****************************************************************************/
+
+static void inode_hashbuild(FAR struct inode *parent, unsigned int nbuckets)
+{
+  FAR struct inode_hash_s **slot = inode_hashslot(parent);
+  FAR struct inode_hash_s *hash;
+  FAR struct inode *node;
+
+  hash = (FAR struct inode_hash_s *)kmm_zalloc(INODE_HASH_SIZE(nbuckets));
+  if (hash == NULL)
+    {
+      return;
+    }
+
+  hash->nbuckets = nbuckets;
+
+  node = parent != NULL ? parent->i_child : g_root_inode;
+  for (; node != NULL; node = node->i_peer)
+    {
+      inode_hashlink(hash, node);
+    }
+
+  if (*slot != NULL)
+    {
+      kmm_free(*slot);
+    }
+
+  *slot = hash;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: inode_hashlookup
+ *
+ * Description:
+ *   Find a child of an indexed directory.
+ *
+ * Input Parameters:
+ *   parent - The directory; NULL for the top level directory
+ *   name   - A path whose first name is the name of the child
+ *   node   - The location to return the child, or NULL if there is none
+ *
+ * Returned Value:
+ *   True if the directory is indexed.  Otherwise, 'node' is not modified
+ *   and the children must be searched linearly.
+ *
+ ****************************************************************************/
+
+bool inode_hashlookup(FAR struct inode *parent, FAR const char *name,
+                      FAR struct inode **node)
+{
+  FAR struct inode_hash_s *hash = *inode_hashslot(parent);
+  FAR struct inode *curr;
+  uint32_t index;
+  size_t len;
+
+  if (hash == NULL)
+    {
+      return false;
+    }
+
+  index = inode_hashname(name, &len) & (hash->nbuckets - 1);
+  for (curr = hash->bucket[index]; curr != NULL; curr = curr->i_hnext)
+    {
+      if (strncmp(curr->i_name, name, len) == 0 && curr->i_name[len] == '\0')
+        {
+          break;
+        }
+    }
+
+  *node = curr;
+  return true;
+}
+
+/****************************************************************************
+ * Name: inode_hashadd
+ *
+ * Description:
+ *   Add an inode that was just linked into a directory to the index of the
+ *   directory.  The index is created when the directory reaches
+ *   CONFIG_PSEUDOFS_HASH_THRESHOLD entries and doubled in size when the
+ *   chains become longer than two inodes on average.
+ *
+ * Input Parameters:
+ *   parent - The directory; NULL for the top level directory
+ *   node   - The new child
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void inode_hashadd(FAR struct inode *parent, FAR struct inode *node)
+{
+  FAR struct inode_hash_s *hash = *inode_hashslot(parent);
+  FAR struct inode *curr;
+  unsigned int nchildren;
+  unsigned int nbuckets;
+
+  if (hash != NULL)
+    {
+      inode_hashlink(hash, node);
+      if (hash->nchildren > 2 * hash->nbuckets &&
+          hash->nbuckets < INODE_HASH_MAXBUCKETS)
+        {
+          inode_hashbuild(parent, 2 * hash->nbuckets);
+        }
+
+      return;
+    }
+
+  /* The directory is not indexed yet.  It has fewer children than the
+   * threshold, so counting them is cheap.
+   */
+
+  nchildren = 0;
+  curr = parent != NULL ? parent->i_child : g_root_inode;
+  for (; curr != NULL; curr = curr->i_peer)
+    {
+      nchildren++;
+    }
+
+  if (nchildren >= CONFIG_PSEUDOFS_HASH_THRESHOLD)
+    {
+      for (nbuckets = 1; nbuckets < nchildren; nbuckets <<= 1)
+        {
+        }
+
+      inode_hashbuild(parent, nbuckets);
+    }
+}
+
+/****************************************************************************
+ * Name: inode_hashremove
+ *
+ * Description:
+ *   Remove an inode from the index of its directory.  The index is freed
+ *   when the last child is removed.
+ *
+ * Input Parameters:
+ *   parent - The directory; NULL for the top level directory
+ *   node   - The child to be removed
+ *
+ * Returned Value:
+ *   True if the directory was indexed.
+ *
+ ****************************************************************************/
+
+bool inode_hashremove(FAR struct inode *parent, FAR struct inode *node)
+{
+  FAR struct inode_hash_s **slot = inode_hashslot(parent);
+  FAR struct inode_hash_s *hash = *slot;
+  FAR struct inode **link;
+  size_t len;
+
+  if (hash == NULL)
+    {
+      return false;
+    }
+
+  link = &hash->bucket[inode_hashname(node->i_name, &len) &
+                       (hash->nbuckets - 1)];
+  for (; *link != NULL; link = &(*link)->i_hnext)
+    {
+      if (*link == node)
+        {
+          *link = node->i_hnext;
+          node->i_hnext = NULL;
+          hash->nchildren--;
+          break;
+        }
+    }
+
+  if (hash->nchildren == 0)
+    {
+      kmm_free(hash);
+      *slot = NULL;
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: inode_hashfree
+ *
+ * Description:
+ *   Free the index of the children of an inode that is being freed.
+ *
+ ****************************************************************************/
+
+void inode_hashfree(FAR struct inode *node)
+{
+  if (node->i_hash != NULL)
+    {
+      kmm_free(node->i_hash);
+      node->i_hash = NULL;
+    }
+}
+
+#endif /* CONFIG_PSEUDOFS_HASH */
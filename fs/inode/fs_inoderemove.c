@@ -91,6 +91,23 @@ FAR struct inode *inode_unlink(FAR const char *path)
       node = desc.node;
       DEBUGASSERT(node != NULL);
 
+#ifdef CONFIG_PSEUDOFS_HASH
+      /* Nodes found through the hash index of a directory are returned
+       * without their left peer.  Unlinking is rare, so just look for it.
+       */
+
+      if (inode_hashremove(desc.parent, node))
+        {
+          FAR struct inode *curr;
+
+          curr = desc.parent != NULL ? desc.parent->i_child : g_root_inode;
+          for (desc.peer = NULL; curr != node; curr = curr->i_peer)
+            {
+              desc.peer = curr;
+            }
+        }
+#endif
+
       /* If peer is non-null, then remove the node from the right of
        * of that peer node.
        */
@@ -117,6 +134,7 @@ FAR struct inode *inode_unlink(FAR const char *path)
         }
 
       node->i_peer = NULL;
+      inode_cacheinvalidate();
     }
 
   RELEASE_SEARCH(&desc);
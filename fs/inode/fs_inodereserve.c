@@ -135,6 +135,9 @@ static void inode_insert(FAR struct inode *node,
       node->i_peer = g_root_inode;
       g_root_inode = node;
     }
+
+  inode_hashadd(parent, node);
+  inode_cacheinvalidate();
 }
 
 /****************************************************************************
@@ -280,7 +280,28 @@ static int _inode_search(FAR struct inode_search_s *desc)
 
   while (node != NULL)
     {
-      int result = _inode_compare(name, node);
+      int result;
+
+#ifdef CONFIG_PSEUDOFS_HASH
+      /* At the start of the children of an indexed directory, find the
+       * child through the hash index.  The children are not ordered then
+       * and the left peer is not returned.
+       */
+
+      if (left == NULL && inode_hashlookup(above, name, &node))
+        {
+          if (node == NULL)
+            {
+              break;
+            }
+
+          result = 0;
+        }
+      else
+#endif
+        {
+          result = _inode_compare(name, node);
+        }
 
       /* Case 1:  The name is less than the name of the node.
        * Since the names are ordered, these means that there
@@ -461,6 +482,9 @@ static int _inode_search(FAR struct inode_search_s *desc)
 
 int inode_search(FAR struct inode_search_s *desc)
 {
+#ifdef CONFIG_FS_INODECACHE
+  FAR const char *path;
+#endif
   int ret;
 
   /* Perform the common _inode_search() logic.  This does everything except
@@ -473,6 +497,19 @@ int inode_search(FAR struct inode_search_s *desc)
   desc->linktgt = NULL;
 #endif
 
+#ifdef CONFIG_FS_INODECACHE
+  /* Return the result of the last search for the same path unless the
+   * inode tree has changed since then.
+   */
+
+  if (inode_cachelookup(desc, &ret))
+    {
+      return ret;
+    }
+
+  path = desc->path;
+#endif
+
   ret = _inode_search(desc);
 
 #ifdef CONFIG_PSEUDOFS_SOFTLINKS
@@ -579,6 +616,10 @@ int inode_search(FAR struct inode_search_s *desc)
     }
 #endif
 
+#ifdef CONFIG_FS_INODECACHE
+  inode_cacheadd(path, desc, ret);
+#endif
+
   return ret;
 }
 
@@ -80,6 +80,13 @@
 
 #endif
 
+/* Mark a file descriptor as used or free in the bitmap of a file list */
+
+#define FILES_MAPSET(l,fd) \
+  ((l)->fl_map[(fd) >> 5] |= (uint32_t)1 << ((fd) & 31))
+#define FILES_MAPCLR(l,fd) \
+  ((l)->fl_map[(fd) >> 5] &= ~((uint32_t)1 << ((fd) & 31)))
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -91,7 +98,8 @@
  *  node     - INPUT:  (not used)
  *             OUTPUT: On success, holds the pointer to the inode found.
  *  peer     - INPUT:  (not used)
- *             OUTPUT: The inode to the "left" of the inode found.
+ *             OUTPUT: The inode to the "left" of the inode found.  Always
+ *                     NULL in a directory with a hash index.
  *  parent   - INPUT:  (not used)
  *             OUTPUT: The inode to the "above" of the inode found.
  *  relpath  - INPUT:  (not used)
@@ -222,6 +230,60 @@ int inode_checkflags(FAR struct inode *inode, int oflags);
 
 int inode_search(FAR struct inode_search_s *desc);
 
+/****************************************************************************
+ * Name: inode_cachelookup, inode_cacheadd, and inode_cacheinvalidate
+ *
+ * Description:
+ *   Cache the results of inode_search() by path.  inode_cacheinvalidate()
+ *   must be called whenever an inode is inserted into or unlinked from the
+ *   tree, or becomes or stops being a mountpoint or soft link.
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_INODECACHE
+bool inode_cachelookup(FAR struct inode_search_s *desc, FAR int *ret);
+void inode_cacheadd(FAR const char *path, FAR struct inode_search_s *desc,
+                    int ret);
+void inode_cacheinvalidate(void);
+#else
+#  define inode_cacheinvalidate()
+#endif
+
+/****************************************************************************
+ * Name: inode_hashlookup, inode_hashadd, inode_hashremove, inode_hashfree
+ *
+ * Description:
+ *   Hash index of the children of large directories (see fs_inodehash.c).
+ *   'parent' is NULL for the top level directory.
+ *
+ *   inode_hashlookup - Return true if the directory is indexed.  Then the
+ *                      child with the first name in 'name' (or NULL) is
+ *                      returned in 'node'.  The children of an indexed
+ *                      directory are not ordered.
+ *   inode_hashadd    - Index an inode just linked into a directory
+ *   inode_hashremove - Remove an inode from the index of its directory.
+ *                      Return true if the directory was indexed.
+ *   inode_hashfree   - Free the index of the children of an inode
+ *
+ * Assumptions:
+ *   The caller holds the g_inode_sem semaphore
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PSEUDOFS_HASH
+bool inode_hashlookup(FAR struct inode *parent, FAR const char *name,
+                      FAR struct inode **node);
+void inode_hashadd(FAR struct inode *parent, FAR struct inode *node);
+bool inode_hashremove(FAR struct inode *parent, FAR struct inode *node);
+void inode_hashfree(FAR struct inode *node);
+#else
+#  define inode_hashadd(p,n)
+#  define inode_hashfree(n)
+#endif
+
 /****************************************************************************
  * Name: inode_find
  *
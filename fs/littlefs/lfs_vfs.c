@@ -26,6 +26,8 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <nuttx/fs/dirent.h>
@@ -40,6 +42,27 @@
 #include "littlefs/lfs.h"
 #include "littlefs/lfs_util.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_FS_LITTLEFS_BLOCK_CYCLES
+#  define CONFIG_FS_LITTLEFS_BLOCK_CYCLES 500
+#endif
+
+#ifndef CONFIG_FS_LITTLEFS_CACHE_SIZE
+#  define CONFIG_FS_LITTLEFS_CACHE_SIZE 0
+#endif
+
+#ifndef CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE
+#  define CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE 0
+#endif
+
+/* Format requests from the mount options */
+
+#define LITTLEFS_FORCEFORMAT 1
+#define LITTLEFS_AUTOFORMAT  2
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -56,6 +79,7 @@ struct littlefs_mountpt_s
   struct mtd_geometry_s geo;
   struct lfs_config     cfg;
   lfs_t                 lfs;
+  bool                  defer;  /* Flush the driver only on fsync() */
 };
 
 /****************************************************************************
@@ -64,6 +88,7 @@ struct littlefs_mountpt_s
 
 static void    littlefs_semgive(FAR struct littlefs_mountpt_s *fs);
 static int     littlefs_semtake(FAR struct littlefs_mountpt_s *fs);
+static int     littlefs_flush(FAR struct littlefs_mountpt_s *fs);
 
 static int     littlefs_open(FAR struct file *filep, FAR const char *relpath,
                              int oflags, mode_t mode);
@@ -497,6 +522,11 @@ static int littlefs_sync(FAR struct file *filep)
     }
 
   ret = lfs_file_sync(&fs->lfs, priv);
+  if (ret >= 0 && fs->defer)
+    {
+      ret = littlefs_flush(fs);
+    }
+
   littlefs_semgive(fs);
 
   return ret;
@@ -866,12 +896,14 @@ static int littlefs_erase_block(FAR const struct lfs_config *c,
 }
 
 /****************************************************************************
- * Name: littlefs_sync_block
+ * Name: littlefs_flush
+ *
+ * Description: Write back any data buffered by the driver.
+ *
  ****************************************************************************/
 
-static int littlefs_sync_block(FAR const struct lfs_config *c)
+static int littlefs_flush(FAR struct littlefs_mountpt_s *fs)
 {
-  FAR struct littlefs_mountpt_s *fs = c->context;
   FAR struct inode *drv = fs->drv;
   int ret;
 
@@ -887,6 +919,82 @@ static int littlefs_sync_block(FAR const struct lfs_config *c)
   return ret == -ENOTTY ? OK : ret;
 }
 
+/****************************************************************************
+ * Name: littlefs_sync_block
+ ****************************************************************************/
+
+static int littlefs_sync_block(FAR const struct lfs_config *c)
+{
+  FAR struct littlefs_mountpt_s *fs = c->context;
+
+  /* In deferred mode, littlefs still commits its metadata at each close
+   * but the driver may keep it buffered, so that the commits of several
+   * files are programmed together.
+   */
+
+  return fs->defer ? OK : littlefs_flush(fs);
+}
+
+/****************************************************************************
+ * Name: littlefs_parse_options
+ *
+ * Description: Parse the comma separated mount options:
+ *
+ *   forceformat       - Format the device before mounting it
+ *   autoformat        - Format the device if it cannot be mounted
+ *   cache=<bytes>     - Size of the read, program, and file caches
+ *   lookahead=<bytes> - Size of the block allocator lookahead buffer
+ *   cycles=<n>        - Erase cycles before metadata is moved
+ *   defer             - Do not flush the driver at each metadata commit,
+ *                       only on fsync() and unmount.
+ *
+ *   Unknown options are ignored.
+ *
+ ****************************************************************************/
+
+static int littlefs_parse_options(FAR struct littlefs_mountpt_s *fs,
+                                  FAR const char *data)
+{
+  FAR const char *end;
+  size_t len;
+  int format = 0;
+
+  while (data != NULL && *data != '\0')
+    {
+      end = strchr(data, ',');
+      len = end != NULL ? end - data : strlen(data);
+
+      if (len == 11 && strncmp(data, "forceformat", 11) == 0)
+        {
+          format = LITTLEFS_FORCEFORMAT;
+        }
+      else if (len == 10 && strncmp(data, "autoformat", 10) == 0)
+        {
+          format = LITTLEFS_AUTOFORMAT;
+        }
+      else if (len == 5 && strncmp(data, "defer", 5) == 0)
+        {
+          fs->defer = true;
+        }
+      else if (strncmp(data, "cache=", 6) == 0)
+        {
+          fs->cfg.cache_size = strtoul(data + 6, NULL, 0);
+        }
+      else if (strncmp(data, "lookahead=", 10) == 0)
+        {
+          fs->cfg.lookahead_size = strtoul(data + 10, NULL, 0);
+        }
+      else if (strncmp(data, "cycles=", 7) == 0)
+        {
+          fs->cfg.block_cycles = strtol(data + 7, NULL, 0);
+        }
+
+      data = end != NULL ? end + 1 : NULL;
+    }
+
+  return format;
+}
+
 /****************************************************************************
  * Name: littlefs_bind
  ****************************************************************************/
@@ -895,6 +1003,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
                          FAR void **handle)
 {
   FAR struct littlefs_mountpt_s *fs;
+  int format;
   int ret;
 
   /* Open the block driver */
@@ -972,10 +1081,45 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
   fs->cfg.prog_size      = fs->geo.blocksize;
   fs->cfg.block_size     = fs->geo.erasesize;
   fs->cfg.block_count    = fs->geo.neraseblocks;
-  fs->cfg.block_cycles   = 500;
-  fs->cfg.cache_size     = fs->geo.blocksize;
-  fs->cfg.lookahead_size = lfs_min(lfs_alignup(fs->cfg.block_count / 8, 8),
-                                   fs->cfg.read_size);
+  fs->cfg.block_cycles   = CONFIG_FS_LITTLEFS_BLOCK_CYCLES;
+  fs->cfg.cache_size     = CONFIG_FS_LITTLEFS_CACHE_SIZE;
+  fs->cfg.lookahead_size = CONFIG_FS_LITTLEFS_LOOKAHEAD_SIZE;
+
+  format = littlefs_parse_options(fs, data);
+
+  /* The caches must hold whole driver blocks and evenly divide the erase
+   * blocks.  The lookahead buffer must be a multiple of 8 bytes and need
+   * not be larger than one bit per erase block.
+   */
+
+  if (fs->cfg.cache_size == 0)
+    {
+      fs->cfg.cache_size = fs->geo.blocksize;
+    }
+  else
+    {
+      fs->cfg.cache_size = lfs_alignup(fs->cfg.cache_size,
+                                       fs->geo.blocksize);
+    }
+
+  if (fs->cfg.cache_size > fs->cfg.block_size ||
+      fs->cfg.block_size % fs->cfg.cache_size != 0)
+    {
+      ret = -EINVAL;
+      goto errout_with_fs;
+    }
+
+  if (fs->cfg.lookahead_size == 0)
+    {
+      fs->cfg.lookahead_size =
+        lfs_min(lfs_alignup(fs->cfg.block_count / 8, 8), fs->cfg.read_size);
+    }
+  else
+    {
+      fs->cfg.lookahead_size =
+        lfs_min(lfs_alignup(fs->cfg.lookahead_size, 8),
+                lfs_alignup(fs->cfg.block_count / 8, 8));
+    }
 
   /* Then get information about the littlefs filesystem on the devices
    * managed by this driver.
@@ -983,7 +1127,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
 
   /* Force format the device if -o forceformat */
 
-  if (data && strcmp(data, "forceformat") == 0)
+  if (format == LITTLEFS_FORCEFORMAT)
     {
       ret = lfs_format(&fs->lfs, &fs->cfg);
       if (ret < 0)
@@ -997,8 +1141,7 @@ static int littlefs_bind(FAR struct inode *driver, FAR const void *data,
     {
       /* Auto format the device if -o autoformat */
 
-      if (ret != LFS_ERR_CORRUPT ||
-          !data || strcmp(data, "autoformat"))
+      if (ret != LFS_ERR_CORRUPT || format != LITTLEFS_AUTOFORMAT)
         {
           goto errout_with_fs;
         }
@@ -1058,6 +1201,11 @@ static int littlefs_unbind(FAR void *handle, FAR struct inode **driver,
     }
 
   ret = lfs_unmount(&fs->lfs);
+  if (ret >= 0 && fs->defer)
+    {
+      ret = littlefs_flush(fs);
+    }
+
   littlefs_semgive(fs);
 
   if (ret >= 0)
@@ -68,11 +68,15 @@
  *     a. The filesystem supports the FIOC_MMAP ioctl command.  Any file
  *        system that maps files contiguously on the media should support
  *        this ioctl. (vs. file system that scatter files over the media
- *        in non-contiguous sectors).  As of this writing, ROMFS is the
- *        only file system that meets this requirement.
+ *        in non-contiguous sectors).  As of this writing, ROMFS, TMPFS,
+ *        and CROMFS (for files stored uncompressed in a single block)
+ *        meet this requirement.
  *     b. The underlying block driver supports the BIOC_XIPBASE ioctl
  *        command that maps the underlying media to a randomly accessible
  *        address. At  present, only the RAM/ROM disk driver does this.
+ *     c. The mapping is MAP_SHARED or is not writable.  A writable
+ *        MAP_PRIVATE mapping must not modify the file and is always
+ *        copied.
  *
  *   2. If CONFIG_FS_RAMMAP is defined in the configuration, then mmap() will
  *      support simulation of memory mapped files by copying files whole
@@ -188,10 +192,11 @@ FAR void *mmap(FAR void *start, size_t length, int prot, int flags,
   /* Perform the ioctl to get the base address of the file in 'mapped'
    * in memory. (casting to uintptr_t first eliminates complaints on some
    * architectures where the sizeof long is different from the size of
-   * a pointer).
+   * a pointer).  A private mapping is accessed in place, instead of being
+   * copied, too, if it is read-only.
    */
 
-  if ((flags & MAP_PRIVATE) == 0)
+  if ((flags & MAP_PRIVATE) == 0 || (prot & PROT_WRITE) == 0)
     {
       ret = ioctl(fd, FIOC_MMAP, (unsigned long)((uintptr_t)&addr));
     }
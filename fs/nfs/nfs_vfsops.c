@@ -123,6 +123,9 @@ static int     nfs_fileopen(FAR struct nfsmount *nmp,
 static int     nfs_open(FAR struct file *filep, FAR const char *relpath,
                    int oflags, mode_t mode);
 static int     nfs_close(FAR struct file *filep);
+static ssize_t nfs_readrpc(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                 off_t offset, FAR char *buffer, size_t buflen,
+                 FAR bool *eof);
 static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
                         size_t buflen);
 static ssize_t nfs_write(FAR struct file *filep, FAR const char *buffer,
@@ -394,6 +397,12 @@ static int nfs_filetruncate(FAR struct nfsmount *nmp,
 
   finfo("Truncating file\n");
 
+#ifdef CONFIG_NFS_READAHEAD
+  /* Drop any read-ahead data beyond the new end of the file */
+
+  np->n_ralen = 0;
+#endif
+
   /* Create the SETATTR RPC call arguments */
 
   ptr    = (FAR uint32_t *)&nmp->nm_msgbuffer.setattr.setattr;
@@ -762,6 +771,9 @@ static int nfs_close(FAR struct file *filep)
 
               /* Then deallocate the file structure and return success */
 
+#ifdef CONFIG_NFS_READAHEAD
+              kmm_free(np->n_rabuf);
+#endif
               kmm_free(np);
               ret = OK;
               break;
@@ -774,6 +786,127 @@ static int nfs_close(FAR struct file *filep)
   return ret;
 }
 
+/****************************************************************************
+ * Name: nfs_readrpc
+ *
+ * Description:
+ *   Perform one READ RPC at 'offset' for at most 'buflen' bytes, limited by
+ *   the negotiated read size and by the size of the I/O buffer.
+ *
+ * Returned Value:
+ *   The (non-negative) number of bytes read on success; a negated errno
+ *   value on failure.  *eof is set if the server reported the end of the
+ *   file.
+ *
+ ****************************************************************************/
+
+static ssize_t nfs_readrpc(FAR struct nfsmount *nmp, FAR struct nfsnode *np,
+                           off_t offset, FAR char *buffer, size_t buflen,
+                           FAR bool *eof)
+{
+  ssize_t                    readsize;
+  ssize_t                    tmp;
+  size_t                     reqlen;
+  FAR uint32_t              *ptr;
+  int                        ret;
+
+  /* Make sure that the attempted read size does not exceed the RPC maximum */
+
+  readsize = buflen;
+  if (readsize > nmp->nm_rsize)
+    {
+      readsize = nmp->nm_rsize;
+    }
+
+  /* Make sure that the attempted read size does not exceed the IO buffer
+   * size.
+   */
+
+  tmp = SIZEOF_rpc_reply_read(readsize);
+  if (tmp > nmp->nm_buflen)
+    {
+      readsize -= (tmp - nmp->nm_buflen);
+    }
+
+  /* Initialize the request */
+
+  ptr     = (FAR uint32_t *)&nmp->nm_msgbuffer.read.read;
+  reqlen  = 0;
+
+  /* Copy the variable length, file handle */
+
+  *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
+  reqlen += sizeof(uint32_t);
+
+  memcpy(ptr, &np->n_fhandle, np->n_fhsize);
+  reqlen += uint32_alignup(np->n_fhsize);
+  ptr    += uint32_increment(np->n_fhsize);
+
+  /* Copy the file offset */
+
+  txdr_hyper((uint64_t)offset, ptr);
+  ptr += 2;
+  reqlen += 2*sizeof(uint32_t);
+
+  /* Set the readsize */
+
+  *ptr = txdr_unsigned(readsize);
+  reqlen += sizeof(uint32_t);
+
+  /* Perform the read */
+
+  finfo("Reading %d bytes\n", readsize);
+  nfs_statistics(NFSPROC_READ);
+  ret = nfs_request(nmp, NFSPROC_READ,
+                    (FAR void *)&nmp->nm_msgbuffer.read, reqlen,
+                    (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
+  if (ret)
+    {
+      ferr("ERROR: nfs_request failed: %d\n", ret);
+      return ret;
+    }
+
+  /* The read was successful.  Get a pointer to the beginning of the NFS
+   * response data.
+   */
+
+  ptr = (FAR uint32_t *)
+    &((FAR struct rpc_reply_read *)nmp->nm_iobuffer)->read;
+
+  /* Check if attributes are included in the responses */
+
+  tmp = *ptr++;
+  if (tmp != 0)
+    {
+      /* Yes.. Update the cached file status in the file structure. */
+
+      nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
+      ptr += uint32_increment(sizeof(struct nfs_fattr));
+    }
+
+  /* This is followed by the count of data read.  Isn't this
+   * the same as the length that is included in the read data?
+   *
+   * Just skip over if for now.
+   */
+
+  ptr++;
+
+  /* Next comes an EOF indication */
+
+  *eof = (*ptr++ != 0);
+
+  /* Then the length of the read data followed by the read data itself */
+
+  readsize = fxdr_unsigned(uint32_t, *ptr);
+  ptr++;
+
+  /* Copy the read data into the caller's buffer */
+
+  memcpy(buffer, ptr, readsize);
+  return readsize;
+}
+
 /****************************************************************************
  * Name: nfs_read
  *
@@ -791,8 +924,7 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
   ssize_t                    readsize;
   ssize_t                    tmp;
   ssize_t                    bytesread;
-  size_t                     reqlen;
-  FAR uint32_t              *ptr;
+  bool                       eof;
   int                        ret = 0;
 
   finfo("Read %d bytes from offset %d\n", buflen, filep->f_pos);
@@ -829,99 +961,67 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
 
   for (bytesread = 0; bytesread < buflen; )
     {
-      /* Make sure that the attempted read size does not exceed the RPC maximum */
+#ifdef CONFIG_NFS_READAHEAD
+      /* Take what we can from the read-ahead buffer */
 
-      readsize = buflen - bytesread;
-      if (readsize > nmp->nm_rsize)
+      if (np->n_ralen > 0 && filep->f_pos >= np->n_raoffset &&
+          filep->f_pos < np->n_raoffset + np->n_ralen)
         {
-          readsize = nmp->nm_rsize;
-        }
+          readsize = np->n_raoffset + np->n_ralen - filep->f_pos;
+          if (readsize > buflen - bytesread)
+            {
+              readsize = buflen - bytesread;
+            }
 
-      /* Make sure that the attempted read size does not exceed the IO buffer size */
+          memcpy(buffer, np->n_rabuf + (filep->f_pos - np->n_raoffset),
+                 readsize);
 
-      tmp = SIZEOF_rpc_reply_read(readsize);
-      if (tmp > nmp->nm_buflen)
-        {
-          readsize -= (tmp - nmp->nm_buflen);
+          filep->f_pos += readsize;
+          bytesread    += readsize;
+          buffer       += readsize;
+          continue;
         }
 
-      /* Initialize the request */
-
-      ptr     = (FAR uint32_t *)&nmp->nm_msgbuffer.read.read;
-      reqlen  = 0;
-
-      /* Copy the variable length, file handle */
-
-      *ptr++  = txdr_unsigned((uint32_t)np->n_fhsize);
-      reqlen += sizeof(uint32_t);
-
-      memcpy(ptr, &np->n_fhandle, np->n_fhsize);
-      reqlen += uint32_alignup(np->n_fhsize);
-      ptr    += uint32_increment(np->n_fhsize);
-
-      /* Copy the file offset */
-
-      txdr_hyper((uint64_t)filep->f_pos, ptr);
-      ptr += 2;
-      reqlen += 2*sizeof(uint32_t);
-
-      /* Set the readsize */
-
-      *ptr = txdr_unsigned(readsize);
-      reqlen += sizeof(uint32_t);
-
-      /* Perform the read */
+      /* Less than a block is left to read.  Read the whole block into the
+       * read-ahead buffer so that the next reads do not need an RPC.
+       */
 
-      finfo("Reading %d bytes\n", readsize);
-      nfs_statistics(NFSPROC_READ);
-      ret = nfs_request(nmp, NFSPROC_READ,
-                        (FAR void *)&nmp->nm_msgbuffer.read, reqlen,
-                        (FAR void *)nmp->nm_iobuffer, nmp->nm_buflen);
-      if (ret)
+      if (buflen - bytesread < nmp->nm_rsize)
         {
-          ferr("ERROR: nfs_request failed: %d\n", ret);
-          goto errout_with_semaphore;
-        }
+          if (np->n_rabuf == NULL)
+            {
+              np->n_rabuf = (FAR uint8_t *)kmm_malloc(nmp->nm_rsize);
+            }
 
-      /* The read was successful.  Get a pointer to the beginning of the NFS
-       * response data.
-       */
+          if (np->n_rabuf != NULL)
+            {
+              np->n_ralen = 0;
+              readsize    = nfs_readrpc(nmp, np, filep->f_pos,
+                                        (FAR char *)np->n_rabuf,
+                                        nmp->nm_rsize, &eof);
+              if (readsize <= 0)
+                {
+                  ret = readsize;
+                  break;
+                }
 
-      ptr = (FAR uint32_t *)
-        &((FAR struct rpc_reply_read *)nmp->nm_iobuffer)->read;
+              np->n_raoffset = filep->f_pos;
+              np->n_ralen    = readsize;
+              continue;
+            }
+        }
+#endif
 
-      /* Check if attributes are included in the responses */
+      /* Read directly into the user buffer */
 
-      tmp = *ptr++;
-      if (tmp != 0)
+      readsize = nfs_readrpc(nmp, np, filep->f_pos, buffer,
+                             buflen - bytesread, &eof);
+      if (readsize <= 0)
         {
-          /* Yes.. Update the cached file status in the file structure. */
-
-          nfs_attrupdate(np, (FAR struct nfs_fattr *)ptr);
-          ptr += uint32_increment(sizeof(struct nfs_fattr));
+          ret = readsize;
+          break;
         }
 
-      /* This is followed by the count of data read.  Isn't this
-       * the same as the length that is included in the read data?
-       *
-       * Just skip over if for now.
-       */
-
-      ptr++;
-
-      /* Next comes an EOF indication.  Save that in tmp for now. */
-
-      tmp = *ptr++;
-
-      /* Then the length of the read data followed by the read data itself */
-
-      readsize = fxdr_unsigned(uint32_t, *ptr);
-      ptr++;
-
-      /* Copy the read data into the user buffer */
-
-      memcpy(buffer, ptr, readsize);
-
       /* Update the read state data */
 
       filep->f_pos += readsize;
@@ -930,13 +1030,12 @@ static ssize_t nfs_read(FAR struct file *filep, FAR char *buffer,
 
       /* Check if we hit the end of file */
 
-      if (tmp != 0)
+      if (eof)
         {
           break;
         }
     }
 
-errout_with_semaphore:
   nfs_semgive(nmp);
   return bytesread > 0 ? bytesread : ret;
 }
@@ -992,6 +1091,12 @@ static ssize_t nfs_write(FAR struct file *filep, FAR const char *buffer,
       goto errout_with_semaphore;
     }
 
+#ifdef CONFIG_NFS_READAHEAD
+  /* The read-ahead data may no longer match the file */
+
+  np->n_ralen = 0;
+#endif
+
   /* Now loop until we send the entire user buffer */
 
   for (byteswritten = 0; byteswritten < buflen; )
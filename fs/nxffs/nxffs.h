@@ -247,6 +247,16 @@ struct nxffs_entry_s
   uint32_t                  datlen;    /* Length of inode data */
 };
 
+/* This structure remembers where the inode header of a file was found */
+
+#if CONFIG_NXFFS_NINDEX > 0
+struct nxffs_index_s
+{
+  uint32_t                  hash;      /* Hash of the inode name */
+  off_t                     hoffset;   /* FLASH offset to the inode header */
+};
+#endif
+
 /* This structure describes int in-memory representation of the data block */
 
 struct nxffs_blkentry_s
@@ -302,6 +312,9 @@ struct nxffs_volume_s
   FAR struct nxffs_ofile_s *ofiles;    /* A singly-linked list of open files */
   FAR uint8_t              *cache;     /* On cached erase block for general I/O */
   FAR uint8_t              *pack;      /* A full erase block to support packing */
+#if CONFIG_NXFFS_NINDEX > 0
+  struct nxffs_index_s      index[CONFIG_NXFFS_NINDEX]; /* Inode locations */
+#endif
 };
 
 /* This structure describes the state of the blocks on the NXFFS volume */
@@ -667,6 +680,30 @@ int nxffs_findinode(FAR struct nxffs_volume_s *volume, FAR const char *name,
 off_t nxffs_inodeend(FAR struct nxffs_volume_s *volume,
                      FAR struct nxffs_entry_s *entry);
 
+/****************************************************************************
+ * Name: nxffs_clearindex
+ *
+ * Description:
+ *   Forget all remembered inode locations.  This must be called before the
+ *   inodes are moved on FLASH, i.e., when the volume is packed or
+ *   re-formatted.
+ *
+ * Input Parameters:
+ *   volume - Describes the NXFFS volume
+ *
+ * Returned Value:
+ *   None
+ *
+ * Defined in nxffs_inode.c
+ *
+ ****************************************************************************/
+
+#if CONFIG_NXFFS_NINDEX > 0
+void nxffs_clearindex(FAR struct nxffs_volume_s *volume);
+#else
+#  define nxffs_clearindex(v)
+#endif
+
 /****************************************************************************
  * Name: nxffs_verifyblock
  *
@@ -197,6 +197,28 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: nxffs_namehash
+ *
+ * Description:
+ *   Return the (FNV-1a) hash of an inode name.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NXFFS_NINDEX > 0
+static uint32_t nxffs_namehash(FAR const char *name)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*name != '\0')
+    {
+      hash = (hash ^ (uint8_t)*name++) * 16777619u;
+    }
+
+  return hash;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -353,6 +375,29 @@ int nxffs_nextentry(FAR struct nxffs_volume_s *volume, off_t offset,
   return -ENOENT;
 }
 
+/****************************************************************************
+ * Name: nxffs_clearindex
+ *
+ * Description:
+ *   Forget all remembered inode locations.  This must be called before the
+ *   inodes are moved on FLASH, i.e., when the volume is packed or
+ *   re-formatted.
+ *
+ * Input Parameters:
+ *   volume - Describes the NXFFS volume
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#if CONFIG_NXFFS_NINDEX > 0
+void nxffs_clearindex(FAR struct nxffs_volume_s *volume)
+{
+  memset(volume->index, 0, sizeof(volume->index));
+}
+#endif
+
 /****************************************************************************
  * Name: nxffs_findinode
  *
@@ -375,9 +420,38 @@ int nxffs_nextentry(FAR struct nxffs_volume_s *volume, off_t offset,
 int nxffs_findinode(FAR struct nxffs_volume_s *volume, FAR const char *name,
                     FAR struct nxffs_entry_s *entry)
 {
+#if CONFIG_NXFFS_NINDEX > 0
+  FAR struct nxffs_index_s *index;
+  uint32_t hash;
+#endif
   off_t offset;
   int ret;
 
+#if CONFIG_NXFFS_NINDEX > 0
+  /* Try the remembered location first.  No header is found there if the
+   * file was deleted since, and the name does not match if the location
+   * belongs to another file.  Otherwise, this is the file.
+   */
+
+  hash  = nxffs_namehash(name);
+  index = &volume->index[hash % CONFIG_NXFFS_NINDEX];
+
+  if (index->hoffset != 0 && index->hash == hash)
+    {
+      if (nxffs_rdentry(volume, index->hoffset, entry) == OK)
+        {
+          if (strcmp(name, entry->name) == 0)
+            {
+              return OK;
+            }
+
+          nxffs_freeentry(entry);
+        }
+
+      index->hoffset = 0;
+    }
+#endif
+
   /* Start with the first valid inode that was discovered when the volume
    * was created (or modified after the last file system re-packing).
    */
@@ -404,6 +478,13 @@ int nxffs_findinode(FAR struct nxffs_volume_s *volume, FAR const char *name,
 
       else if (strcmp(name, entry->name) == 0)
         {
+#if CONFIG_NXFFS_NINDEX > 0
+          /* Remember where it was found */
+
+          index->hash    = hash;
+          index->hoffset = entry->hoffset;
+#endif
+
           /* Yes, return success with the entry data in 'entry' */
 
           return OK;
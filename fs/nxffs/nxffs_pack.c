@@ -1283,6 +1283,10 @@ int nxffs_pack(FAR struct nxffs_volume_s *volume)
   wrfile = NULL;
   packed = false;
 
+  /* The inodes will be moved */
+
+  nxffs_clearindex(volume);
+
   iooffset = nxffs_mediacheck(volume, &pack);
   if (iooffset == 0)
     {
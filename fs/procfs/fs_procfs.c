@@ -65,9 +65,15 @@ extern const struct procfs_operations proc_operations;
 extern const struct procfs_operations irq_operations;
 extern const struct procfs_operations cpuload_operations;
 extern const struct procfs_operations critmon_operations;
+extern const struct procfs_operations tracelat_operations;
 extern const struct procfs_operations meminfo_operations;
+extern const struct procfs_operations heapprof_operations;
+extern const struct procfs_operations heapfrag_operations;
 extern const struct procfs_operations iobinfo_operations;
+extern const struct procfs_operations mempool_operations;
 extern const struct procfs_operations module_operations;
+extern const struct procfs_operations paging_operations;
+extern const struct procfs_operations snapshot_operations;
 extern const struct procfs_operations uptime_operations;
 extern const struct procfs_operations version_operations;
 
@@ -117,6 +123,10 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "critmon",       &critmon_operations,         PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_SCHED_TRACE_LATENCY)
+  { "tracelat",      &tracelat_operations,        PROCFS_FILE_TYPE   },
+#endif
+
 #ifdef CONFIG_SCHED_IRQMONITOR
   { "irqs",          &irq_operations,             PROCFS_FILE_TYPE   },
 #endif
@@ -125,10 +135,30 @@ static const struct procfs_entry_s g_procfs_entries[] =
   { "meminfo",       &meminfo_operations,         PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_MM_PROFILE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_HEAPPROF)
+  { "heapprof",      &heapprof_operations,        PROCFS_FILE_TYPE   },
+#endif
+
+#if defined(CONFIG_MM_FRAGSTATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_HEAPFRAG)
+  { "heapfrag",      &heapfrag_operations,        PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
   { "iobinfo",       &iobinfo_operations,         PROCFS_FILE_TYPE   },
 #endif
 
+#if defined(CONFIG_MM_MEMPOOL) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
+  { "mempool",       &mempool_operations,         PROCFS_FILE_TYPE   },
+#endif
+
+#if defined(CONFIG_PAGING) && !defined(CONFIG_FS_PROCFS_EXCLUDE_PAGING)
+  { "paging",        &paging_operations,          PROCFS_FILE_TYPE   },
+#endif
+
+#ifndef CONFIG_FS_PROCFS_EXCLUDE_SNAPSHOT
+  { "snapshot",      &snapshot_operations,        PROCFS_FILE_TYPE   },
+#endif
+
 #if defined(CONFIG_MODULE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MODULE)
   { "modules",       &module_operations,          PROCFS_FILE_TYPE   },
 #endif
@@ -263,12 +263,60 @@ static ssize_t critmon_read_cpu(FAR struct critmon_file_s *attr,
 
   /* Generate output for maximum time in a critical section */
 
+#ifdef CONFIG_SMP
+  linesize = snprintf(attr->line, CRITMON_LINELEN, "%lu.%09lu,",
+                     (unsigned long)maxtime.tv_sec,
+                     (unsigned long)maxtime.tv_nsec);
+#else
   linesize = snprintf(attr->line, CRITMON_LINELEN, "%lu.%09lu\n",
                      (unsigned long)maxtime.tv_sec,
                      (unsigned long)maxtime.tv_nsec);
-  copysize = procfs_memcpy(attr->line, linesize, buffer, buflen, offset);
+#endif
+  copysize = procfs_memcpy(attr->line, linesize, buffer, remaining,
+                           offset);
 
   totalsize += copysize;
+
+#ifdef CONFIG_SMP
+  buffer    += copysize;
+  remaining -= copysize;
+
+  if (totalsize >= buflen)
+    {
+      return totalsize;
+    }
+
+  /* Convert and generate output for the contention on the critical
+   * section lock:  The number of times that this CPU had to wait for
+   * another CPU and the maximum time waited.
+   */
+
+  if (g_crit_waitmax[cpu] > 0)
+    {
+      up_critmon_convert(g_crit_waitmax[cpu], &maxtime);
+    }
+  else
+    {
+      maxtime.tv_sec = 0;
+      maxtime.tv_nsec = 0;
+    }
+
+  linesize = snprintf(attr->line, CRITMON_LINELEN, "%lu,%lu.%09lu\n",
+                     (unsigned long)g_crit_contended[cpu],
+                     (unsigned long)maxtime.tv_sec,
+                     (unsigned long)maxtime.tv_nsec);
+
+  /* Reset the statistics */
+
+  g_crit_contended[cpu] = 0;
+  g_crit_waitmax[cpu]   = 0;
+
+  copysize = procfs_memcpy(attr->line, linesize, buffer, remaining,
+                           offset);
+
+  totalsize += copysize;
+#endif
+
   return totalsize;
 }
 
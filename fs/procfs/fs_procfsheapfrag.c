@@ -0,0 +1,385 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsheapfrag.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mm.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_FRAGSTATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_HEAPFRAG)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define HEAPFRAG_LINELEN 80
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct heapfrag_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  unsigned int linesize;          /* Number of valid characters in line[] */
+  char line[HEAPFRAG_LINELEN];    /* Pre-allocated buffer for formatted lines */
+  struct mm_fraginfo_s info;      /* Fragmentation report of one heap */
+};
+
+/* This structure holds the state of one read() */
+
+struct heapfrag_read_s
+{
+  FAR struct heapfrag_file_s *fragfile;
+  FAR char *buffer;
+  size_t buflen;
+  size_t totalsize;
+  off_t offset;
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     heapfrag_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     heapfrag_close(FAR struct file *filep);
+static ssize_t heapfrag_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     heapfrag_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     heapfrag_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations heapfrag_operations =
+{
+  heapfrag_open,   /* open */
+  heapfrag_close,  /* close */
+  heapfrag_read,   /* read */
+  NULL,            /* write */
+  heapfrag_dup,    /* dup */
+  NULL,            /* opendir */
+  NULL,            /* closedir */
+  NULL,            /* readdir */
+  NULL,            /* rewinddir */
+  heapfrag_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: heapfrag_copyline
+ ****************************************************************************/
+
+static void heapfrag_copyline(FAR struct heapfrag_read_s *rd,
+                              size_t linesize)
+{
+  size_t copysize;
+
+  if (rd->totalsize < rd->buflen)
+    {
+      copysize       = procfs_memcpy(rd->fragfile->line, linesize,
+                                     rd->buffer + rd->totalsize,
+                                     rd->buflen - rd->totalsize,
+                                     &rd->offset);
+      rd->totalsize += copysize;
+    }
+}
+
+/****************************************************************************
+ * Name: heapfrag_readheap
+ *
+ * Description:
+ *   Generate the report of one heap:  A summary line, then one line for
+ *   each non-empty free list bucket and one line for each CPU.
+ *
+ ****************************************************************************/
+
+static void heapfrag_readheap(FAR struct heapfrag_read_s *rd,
+                              FAR const char *name,
+                              FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_fraginfo_s *info = &rd->fragfile->info;
+  FAR char *line = rd->fragfile->line;
+  size_t linesize;
+  int i;
+
+  mm_fraginfo(heap, info);
+
+  linesize = snprintf(line, HEAPFRAG_LINELEN,
+                      "%s: %lu bytes free in %lu chunks\n", name,
+                      (unsigned long)info->freebytes,
+                      (unsigned long)info->nfree);
+  heapfrag_copyline(rd, linesize);
+
+  linesize = snprintf(line, HEAPFRAG_LINELEN,
+                      "  largest %lu, fragmentation %u.%u%%\n",
+                      (unsigned long)info->largest,
+                      info->frag / 10, info->frag % 10);
+  heapfrag_copyline(rd, linesize);
+
+  /* The free chunks of each bucket.  A bucket holds the chunks from its
+   * MINSIZE up to the MINSIZE of the next bucket.
+   */
+
+  linesize = snprintf(line, HEAPFRAG_LINELEN, "%10s%10s%12s\n",
+                      "MINSIZE", "NFREE", "BYTES");
+  heapfrag_copyline(rd, linesize);
+
+  for (i = 0; i < MM_FRAG_NBUCKETS; i++)
+    {
+      if (info->buckets[i].nfree > 0)
+        {
+          linesize = snprintf(line, HEAPFRAG_LINELEN, "%10lu%10lu%12lu\n",
+                              (unsigned long)info->buckets[i].minsize,
+                              (unsigned long)info->buckets[i].nfree,
+                              (unsigned long)info->buckets[i].bytes);
+          heapfrag_copyline(rd, linesize);
+        }
+    }
+
+#ifdef MM_HAVE_CPUSTATS
+  /* Then the heap operations of each CPU */
+
+  linesize = snprintf(line, HEAPFRAG_LINELEN, "%4s%11s%11s%16s%16s\n",
+                      "CPU", "ALLOCS", "FREES", "ALLOCBYTES",
+                      "FREEBYTES");
+  heapfrag_copyline(rd, linesize);
+
+  for (i = 0; i < MM_STATS_NCPUS; i++)
+    {
+      linesize = snprintf(line, HEAPFRAG_LINELEN,
+                          "%4d%11lu%11lu%16llu%16llu\n", i,
+                          (unsigned long)info->cpus[i].nallocs,
+                          (unsigned long)info->cpus[i].nfrees,
+                          (unsigned long long)info->cpus[i].allocbytes,
+                          (unsigned long long)info->cpus[i].freebytes);
+      heapfrag_copyline(rd, linesize);
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: heapfrag_open
+ ****************************************************************************/
+
+static int heapfrag_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct heapfrag_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "heapfrag" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "heapfrag") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct heapfrag_file_s *)
+    kmm_zalloc(sizeof(struct heapfrag_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: heapfrag_close
+ ****************************************************************************/
+
+static int heapfrag_close(FAR struct file *filep)
+{
+  FAR struct heapfrag_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct heapfrag_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: heapfrag_read
+ ****************************************************************************/
+
+static ssize_t heapfrag_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  struct heapfrag_read_s rd;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  rd.fragfile  = (FAR struct heapfrag_file_s *)filep->f_priv;
+  rd.buffer    = buffer;
+  rd.buflen    = buflen;
+  rd.totalsize = 0;
+  rd.offset    = filep->f_pos;
+  DEBUGASSERT(rd.fragfile);
+
+  /* Report each heap */
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+  heapfrag_readheap(&rd, "Kmem", &g_kmmheap);
+#endif
+
+#ifdef CONFIG_BUILD_FLAT
+  heapfrag_readheap(&rd, "Umem", &g_mmheap);
+#endif
+
+  /* Update the file offset */
+
+  filep->f_pos += rd.totalsize;
+  return rd.totalsize;
+}
+
+/****************************************************************************
+ * Name: heapfrag_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int heapfrag_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct heapfrag_file_s *oldattr;
+  FAR struct heapfrag_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct heapfrag_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct heapfrag_file_s *)
+    kmm_malloc(sizeof(struct heapfrag_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct heapfrag_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: heapfrag_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int heapfrag_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "heapfrag" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "heapfrag") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "heapfrag" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_MM_FRAGSTATS && !CONFIG_FS_PROCFS_EXCLUDE_HEAPFRAG */
@@ -0,0 +1,406 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsheapprof.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mm.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_PROFILE) && !defined(CONFIG_FS_PROCFS_EXCLUDE_HEAPPROF)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define HEAPPROF_LINELEN 80
+
+/* The maximum number of tasks reported for each heap */
+
+#define HEAPPROF_NPIDS   CONFIG_MAX_TASKS
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct heapprof_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  unsigned int linesize;          /* Number of valid characters in line[] */
+  char line[HEAPPROF_LINELEN];    /* Pre-allocated buffer for formatted lines */
+
+  /* Per-task usage of one heap */
+
+  struct mm_profpid_s pids[HEAPPROF_NPIDS];
+};
+
+/* This structure holds the state of one read() */
+
+struct heapprof_read_s
+{
+  FAR struct heapprof_file_s *proffile;
+  FAR char *buffer;
+  size_t buflen;
+  size_t totalsize;
+  off_t offset;
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     heapprof_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     heapprof_close(FAR struct file *filep);
+static ssize_t heapprof_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     heapprof_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     heapprof_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations heapprof_operations =
+{
+  heapprof_open,   /* open */
+  heapprof_close,  /* close */
+  heapprof_read,   /* read */
+  NULL,            /* write */
+  heapprof_dup,    /* dup */
+  NULL,            /* opendir */
+  NULL,            /* closedir */
+  NULL,            /* readdir */
+  NULL,            /* rewinddir */
+  heapprof_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: heapprof_copyline
+ ****************************************************************************/
+
+static void heapprof_copyline(FAR struct heapprof_read_s *rd,
+                              size_t linesize)
+{
+  size_t copysize;
+
+  if (rd->totalsize < rd->buflen)
+    {
+      copysize       = procfs_memcpy(rd->proffile->line, linesize,
+                                     rd->buffer + rd->totalsize,
+                                     rd->buflen - rd->totalsize,
+                                     &rd->offset);
+      rd->totalsize += copysize;
+    }
+}
+
+/****************************************************************************
+ * Name: heapprof_readheap
+ *
+ * Description:
+ *   Generate the report of one heap:  One line plus one histogram line for
+ *   each call site, then one line for each task that owns live
+ *   allocations.
+ *
+ ****************************************************************************/
+
+static void heapprof_readheap(FAR struct heapprof_read_s *rd,
+                              FAR const char *name,
+                              FAR struct mm_heap_s *heap)
+{
+  FAR char *line = rd->proffile->line;
+  struct mm_profsite_s site;
+  unsigned long avglife;
+  size_t linesize;
+  int npids;
+  int ndx;
+  int i;
+
+  linesize = snprintf(line, HEAPPROF_LINELEN,
+                      "%s:\n%-18s%9s%9s%9s%9s%9s%9s\n", name, "CALLER",
+                      "ALLOCS", "FREES", "LIVE", "PEAK", "AVGLIFE",
+                      "MAXLIFE");
+  heapprof_copyline(rd, linesize);
+
+  for (ndx = 0; ndx < CONFIG_MM_PROFILE_NSITES; ndx++)
+    {
+      if (mm_profile_site(heap, ndx, &site) < 0 || site.nallocs == 0)
+        {
+          continue;
+        }
+
+      avglife  = site.nfrees > 0 ?
+                 (unsigned long)(site.lifetime / site.nfrees) : 0;
+      linesize = snprintf(line, HEAPPROF_LINELEN,
+                          "0x%016lx%9lu%9lu%9lu%9lu%9lu%9lu\n",
+                          (unsigned long)(uintptr_t)site.caller,
+                          (unsigned long)site.nallocs,
+                          (unsigned long)site.nfrees,
+                          (unsigned long)site.curbytes,
+                          (unsigned long)site.maxbytes,
+                          avglife, (unsigned long)site.maxlife);
+      heapprof_copyline(rd, linesize);
+
+      /* The histogram shows the number of allocations of each power-of-two
+       * size range as <smallest size in range>:<count>.
+       */
+
+      linesize = snprintf(line, HEAPPROF_LINELEN, "  sizes");
+      heapprof_copyline(rd, linesize);
+
+      for (i = 0; i < MM_PROFILE_NBUCKETS; i++)
+        {
+          if (site.hist[i] > 0)
+            {
+              linesize = snprintf(line, HEAPPROF_LINELEN, " %lu:%lu",
+                                  1ul << i, (unsigned long)site.hist[i]);
+              heapprof_copyline(rd, linesize);
+            }
+        }
+
+      linesize = snprintf(line, HEAPPROF_LINELEN, "\n");
+      heapprof_copyline(rd, linesize);
+    }
+
+  linesize = snprintf(line, HEAPPROF_LINELEN,
+                      "Untracked allocations: %lu\n%6s%9s%9s\n",
+                      (unsigned long)heap->mm_profdropped,
+                      "PID", "NBLKS", "BYTES");
+  heapprof_copyline(rd, linesize);
+
+  /* Then the live allocations of each task */
+
+  npids = mm_profile_pids(heap, rd->proffile->pids, HEAPPROF_NPIDS);
+  for (i = 0; i < npids; i++)
+    {
+      linesize = snprintf(line, HEAPPROF_LINELEN, "%6d%9lu%9lu\n",
+                          (int)rd->proffile->pids[i].pid,
+                          (unsigned long)rd->proffile->pids[i].nblks,
+                          (unsigned long)rd->proffile->pids[i].bytes);
+      heapprof_copyline(rd, linesize);
+    }
+}
+
+/****************************************************************************
+ * Name: heapprof_open
+ ****************************************************************************/
+
+static int heapprof_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct heapprof_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "heapprof" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "heapprof") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct heapprof_file_s *)
+    kmm_zalloc(sizeof(struct heapprof_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: heapprof_close
+ ****************************************************************************/
+
+static int heapprof_close(FAR struct file *filep)
+{
+  FAR struct heapprof_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct heapprof_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: heapprof_read
+ ****************************************************************************/
+
+static ssize_t heapprof_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  struct heapprof_read_s rd;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  rd.proffile  = (FAR struct heapprof_file_s *)filep->f_priv;
+  rd.buffer    = buffer;
+  rd.buflen    = buflen;
+  rd.totalsize = 0;
+  rd.offset    = filep->f_pos;
+  DEBUGASSERT(rd.proffile);
+
+  /* Report each profiled heap */
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+  heapprof_readheap(&rd, "Kmem", &g_kmmheap);
+#endif
+
+#ifdef CONFIG_BUILD_FLAT
+  heapprof_readheap(&rd, "Umem", &g_mmheap);
+#endif
+
+  /* Update the file offset */
+
+  filep->f_pos += rd.totalsize;
+  return rd.totalsize;
+}
+
+/****************************************************************************
+ * Name: heapprof_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int heapprof_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct heapprof_file_s *oldattr;
+  FAR struct heapprof_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct heapprof_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct heapprof_file_s *)
+    kmm_malloc(sizeof(struct heapprof_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct heapprof_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: heapprof_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int heapprof_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "heapprof" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "heapprof") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "heapprof" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_MM_PROFILE && !CONFIG_FS_PROCFS_EXCLUDE_HEAPPROF */
@@ -151,6 +151,12 @@ static FAR const char *g_iob_user_names[] =
 #ifdef CONFIG_NET_IPFORWARD
   "ipforward",
 #endif
+#ifdef CONFIG_NETDEV_IOB_RX
+  "netdev_rx",
+#endif
+#ifdef CONFIG_NET_IPv6_NEIGHBOR_QUEUE
+  "neighbor",
+#endif
 #ifdef CONFIG_WIRELESS_IEEE802154
   "rad802154",
 #endif
@@ -294,7 +300,8 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
   /* The first line is the headers */
 
   linesize  = snprintf(iobfile->line, IOBINFO_LINELEN,
-                        "                           TOTAL           TOTAL\n");
+                        "                           TOTAL           TOTAL"
+                        "           TOTAL\n");
 
   copysize  = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
                             &offset);
@@ -306,7 +313,8 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
       buflen    -= copysize;
 
       linesize  = snprintf(iobfile->line, IOBINFO_LINELEN,
-                        "        USER            CONSUMED        PRODUCED\n");
+                        "        USER            CONSUMED        PRODUCED"
+                        "          FAILED\n");
 
       copysize  = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
                                 &offset);
@@ -324,10 +332,11 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
 
           userstats  = iob_getuserstats(i);
           linesize   = snprintf(iobfile->line, IOBINFO_LINELEN,
-                                "%-16s%16lu%16lu\n",
+                                "%-16s%16lu%16lu%16lu\n",
                                 g_iob_user_names[i],
                                 (unsigned long)userstats->totalconsumed,
-                                (unsigned long)userstats->totalproduced);
+                                (unsigned long)userstats->totalproduced,
+                                (unsigned long)userstats->totalfailed);
 
           copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
                                      &offset);
@@ -342,10 +351,11 @@ static ssize_t iobinfo_read(FAR struct file *filep, FAR char *buffer,
 
       userstats  = iob_getuserstats(IOBUSER_GLOBAL);
       linesize   = snprintf(iobfile->line, IOBINFO_LINELEN,
-                            "\n%-16s%16lu%16lu\n",
+                            "\n%-16s%16lu%16lu%16lu\n",
                             g_iob_user_names[IOBUSER_GLOBAL],
                             (unsigned long)userstats->totalconsumed,
-                            (unsigned long)userstats->totalproduced);
+                            (unsigned long)userstats->totalproduced,
+                            (unsigned long)userstats->totalfailed);
 
       copysize   = procfs_memcpy(iobfile->line, linesize, buffer, buflen,
                                  &offset);
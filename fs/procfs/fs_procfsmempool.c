@@ -0,0 +1,335 @@
+/****************************************************************************
+ * fs/procfs/fs_procfsmempool.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mempool.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_MEMPOOL) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define MEMPOOL_LINELEN 80
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct mempool_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  unsigned int linesize;          /* Number of valid characters in line[] */
+  char line[MEMPOOL_LINELEN];     /* Pre-allocated buffer for formatted lines */
+};
+
+/* This structure holds the state of one read() while the pools are
+ * enumerated.
+ */
+
+struct mempool_read_s
+{
+  FAR struct mempool_file_s *poolfile;
+  FAR char *buffer;
+  size_t buflen;
+  size_t totalsize;
+  off_t offset;
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     mempool_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     mempool_close(FAR struct file *filep);
+static ssize_t mempool_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     mempool_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     mempool_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations mempool_operations =
+{
+  mempool_open,   /* open */
+  mempool_close,  /* close */
+  mempool_read,   /* read */
+  NULL,           /* write */
+  mempool_dup,    /* dup */
+  NULL,           /* opendir */
+  NULL,           /* closedir */
+  NULL,           /* readdir */
+  NULL,           /* rewinddir */
+  mempool_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_copyline
+ ****************************************************************************/
+
+static void mempool_copyline(FAR struct mempool_read_s *rd, size_t linesize)
+{
+  size_t copysize;
+
+  if (rd->totalsize < rd->buflen)
+    {
+      copysize       = procfs_memcpy(rd->poolfile->line, linesize,
+                                     rd->buffer + rd->totalsize,
+                                     rd->buflen - rd->totalsize,
+                                     &rd->offset);
+      rd->totalsize += copysize;
+    }
+}
+
+/****************************************************************************
+ * Name: mempool_readpool
+ ****************************************************************************/
+
+static void mempool_readpool(FAR struct mempool_s *pool, FAR void *arg)
+{
+  FAR struct mempool_read_s *rd = (FAR struct mempool_read_s *)arg;
+  struct mempoolinfo_s info;
+  size_t linesize;
+
+  mempool_info(pool, &info);
+
+  linesize = snprintf(rd->poolfile->line, MEMPOOL_LINELEN,
+                      "%-16.16s%9lu%9lu%9lu%9lu%9lu%9lu\n",
+                      pool->name != NULL ? pool->name : "",
+                      info.sizeblks, info.aordblks, info.ordblks,
+                      info.iordblks, info.arena, info.nwaiter);
+  mempool_copyline(rd, linesize);
+}
+
+/****************************************************************************
+ * Name: mempool_open
+ ****************************************************************************/
+
+static int mempool_open(FAR struct file *filep, FAR const char *relpath,
+                        int oflags, mode_t mode)
+{
+  FAR struct mempool_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "mempool" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "mempool") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct mempool_file_s *)
+    kmm_zalloc(sizeof(struct mempool_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mempool_close
+ ****************************************************************************/
+
+static int mempool_close(FAR struct file *filep)
+{
+  FAR struct mempool_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct mempool_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mempool_read
+ ****************************************************************************/
+
+static ssize_t mempool_read(FAR struct file *filep, FAR char *buffer,
+                            size_t buflen)
+{
+  struct mempool_read_s rd;
+  size_t linesize;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  rd.poolfile  = (FAR struct mempool_file_s *)filep->f_priv;
+  rd.buffer    = buffer;
+  rd.buflen    = buflen;
+  rd.totalsize = 0;
+  rd.offset    = filep->f_pos;
+  DEBUGASSERT(rd.poolfile);
+
+  /* The first line is the headers */
+
+  linesize = snprintf(rd.poolfile->line, MEMPOOL_LINELEN,
+                      "%-16s%9s%9s%9s%9s%9s%9s\n",
+                      "NAME", "BSIZE", "USED", "FREE", "IFREE", "ARENA",
+                      "WAITERS");
+  mempool_copyline(&rd, linesize);
+
+  /* Then one line for each memory pool */
+
+  mempool_foreach(mempool_readpool, &rd);
+
+  /* Update the file offset */
+
+  filep->f_pos += rd.totalsize;
+  return rd.totalsize;
+}
+
+/****************************************************************************
+ * Name: mempool_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int mempool_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct mempool_file_s *oldattr;
+  FAR struct mempool_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct mempool_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct mempool_file_s *)
+    kmm_malloc(sizeof(struct mempool_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct mempool_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mempool_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int mempool_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "mempool" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "mempool") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "mempool" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_MM_MEMPOOL && !CONFIG_FS_PROCFS_EXCLUDE_MEMPOOL */
@@ -98,6 +98,7 @@ enum proc_node_e
 #endif
 #ifdef CONFIG_SCHED_CRITMONITOR
   PROC_CRITMON,                       /* Critical section monitor */
+  PROC_RUNTIME,                       /* Accumulated run time */
 #endif
   PROC_STACK,                         /* Task stack info */
   PROC_GROUP,                         /* Group directory */
@@ -183,6 +184,9 @@ static ssize_t proc_loadavg(FAR struct proc_file_s *procfile,
 static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
                  off_t offset);
+static ssize_t proc_runtime(FAR struct proc_file_s *procfile,
+                 FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
+                 off_t offset);
 #endif
 static ssize_t proc_stack(FAR struct proc_file_s *procfile,
                  FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen,
@@ -278,6 +282,11 @@ static const struct proc_node_s g_critmon =
 {
   "critmon",       "critmon", (uint8_t)PROC_CRITMON,     DTYPE_FILE        /* Critical Section Monitor */
 };
+
+static const struct proc_node_s g_runtime =
+{
+  "runtime",       "runtime", (uint8_t)PROC_RUNTIME,     DTYPE_FILE        /* Accumulated run time */
+};
 #endif
 
 static const struct proc_node_s g_stack =
@@ -319,6 +328,7 @@ static FAR const struct proc_node_s * const g_nodeinfo[] =
 #endif
 #ifdef CONFIG_SCHED_CRITMONITOR
   &g_critmon,      /* Critical section Monitor */
+  &g_runtime,      /* Accumulated run time */
 #endif
   &g_stack,        /* Task stack info */
   &g_group,        /* Group directory */
@@ -342,6 +352,7 @@ static const struct proc_node_s * const g_level0info[] =
 #endif
 #ifdef CONFIG_SCHED_CRITMONITOR
   &g_critmon,      /* Critical section monitor */
+  &g_runtime,      /* Accumulated run time */
 #endif
   &g_stack,        /* Task stack info */
   &g_group,        /* Group directory */
@@ -854,6 +865,61 @@ static ssize_t proc_critmon(FAR struct proc_file_s *procfile,
 }
 #endif
 
+/****************************************************************************
+ * Name: proc_runtime
+ *
+ * Description:
+ *   Generate the total time the thread has been running in seconds.  The
+ *   time is measured with up_critmon_gettime() at each context switch.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CRITMONITOR
+static ssize_t proc_runtime(FAR struct proc_file_s *procfile,
+                            FAR struct tcb_s *tcb, FAR char *buffer,
+                            size_t buflen, off_t offset)
+{
+  struct timespec runtime;
+  struct timespec chunk;
+  irqstate_t flags;
+  uint64_t elapsed;
+  uint64_t nsec;
+  size_t linesize;
+
+  /* Take the run time, including the current run if the thread is running
+   * now.
+   */
+
+  flags   = enter_critical_section();
+  elapsed = tcb->run_time;
+  if (tcb->task_state == TSTATE_TASK_RUNNING && tcb->run_start != 0)
+    {
+      elapsed += up_critmon_gettime() - tcb->run_start;
+    }
+
+  leave_critical_section(flags);
+
+  /* up_critmon_convert() only converts 32-bit times.  Convert the time in
+   * chunks of 2^31 units.
+   */
+
+  up_critmon_convert((uint32_t)(elapsed & 0x7fffffff), &runtime);
+  nsec = (uint64_t)runtime.tv_sec * NSEC_PER_SEC + runtime.tv_nsec;
+
+  if ((elapsed >> 31) != 0)
+    {
+      up_critmon_convert(0x80000000, &chunk);
+      nsec += (elapsed >> 31) *
+              ((uint64_t)chunk.tv_sec * NSEC_PER_SEC + chunk.tv_nsec);
+    }
+
+  linesize = snprintf(procfile->line, STATUS_LINELEN, "%lu.%09lu\n",
+                      (unsigned long)(nsec / NSEC_PER_SEC),
+                      (unsigned long)(nsec % NSEC_PER_SEC));
+  return procfs_memcpy(procfile->line, linesize, buffer, buflen, &offset);
+}
+#endif
+
 /****************************************************************************
  * Name: proc_stack
  ****************************************************************************/
@@ -1454,6 +1520,10 @@ static ssize_t proc_read(FAR struct file *filep, FAR char *buffer,
     case PROC_CRITMON: /* Critical section monitor */
       ret = proc_critmon(procfile, tcb, buffer, buflen, filep->f_pos);
       break;
+
+    case PROC_RUNTIME: /* Accumulated run time */
+      ret = proc_runtime(procfile, tcb, buffer, buflen, filep->f_pos);
+      break;
 #endif
     case PROC_STACK: /* Task stack info */
       ret = proc_stack(procfile, tcb, buffer, buflen, filep->f_pos);
@@ -0,0 +1,402 @@
+/****************************************************************************
+ * fs/procfs/fs_procfssnapshot.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+#include <nuttx/sched.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mm/mm.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_SNAPSHOT)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file".  The snapshot is taken when
+ * the file is opened and the header and the task records are read back
+ * as one block of bytes.
+ */
+
+struct snapshot_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  size_t size;                    /* Number of valid bytes in the snapshot */
+  struct procfs_snapshot_s hdr;   /* The snapshot header */
+  struct procfs_snapshot_task_s task[CONFIG_MAX_TASKS];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     snapshot_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     snapshot_close(FAR struct file *filep);
+static ssize_t snapshot_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     snapshot_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     snapshot_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The number of snapshots taken so far */
+
+static uint32_t g_snapshot_sequence;
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations snapshot_operations =
+{
+  snapshot_open,   /* open */
+  snapshot_close,  /* close */
+  snapshot_read,   /* read */
+  NULL,            /* write */
+  snapshot_dup,    /* dup */
+  NULL,            /* opendir */
+  NULL,            /* closedir */
+  NULL,            /* readdir */
+  NULL,            /* rewinddir */
+  snapshot_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: snapshot_task
+ *
+ * Description:
+ *   nxsched_foreach() callback that adds the record of one task to the
+ *   snapshot.
+ *
+ ****************************************************************************/
+
+static void snapshot_task(FAR struct tcb_s *tcb, FAR void *arg)
+{
+  FAR struct snapshot_file_s *procfile = (FAR struct snapshot_file_s *)arg;
+  FAR struct procfs_snapshot_task_s *task;
+#ifdef CONFIG_SCHED_CPULOAD
+  struct cpuload_s cpuload;
+#endif
+
+  if (procfile->hdr.ntasks >= CONFIG_MAX_TASKS)
+    {
+      return;
+    }
+
+  task              = &procfile->task[procfile->hdr.ntasks++];
+  task->pid         = tcb->pid;
+  task->priority    = tcb->sched_priority;
+  task->state       = tcb->task_state;
+  task->flags       = tcb->flags;
+  task->stacksize   = tcb->adj_stack_size;
+
+  /* Task IDs are not reused until they wrap, so a task that exits and
+   * another that is created almost always change the hash.
+   */
+
+  procfile->hdr.generation = procfile->hdr.generation * 31 + tcb->pid;
+
+#ifdef CONFIG_SCHED_CPULOAD
+  if (clock_cpuload(tcb->pid, &cpuload) == OK)
+    {
+      task->active            = cpuload.active;
+      procfile->hdr.loadtotal = cpuload.total;
+    }
+#endif
+
+#ifdef CONFIG_STACK_COLORATION
+  task->stackused   = up_check_tcbstack(tcb);
+#endif
+
+#if CONFIG_TASK_NAME_SIZE > 0
+  strncpy(task->name, tcb->name, PROCFS_SNAPSHOT_NAMELEN - 1);
+#endif
+}
+
+/****************************************************************************
+ * Name: snapshot_take
+ *
+ * Description:
+ *   Fill in the snapshot of the system state.
+ *
+ ****************************************************************************/
+
+static void snapshot_take(FAR struct snapshot_file_s *procfile)
+{
+  FAR struct procfs_snapshot_s *hdr = &procfile->hdr;
+#if defined(CONFIG_MM_KERNEL_HEAP) || !defined(CONFIG_BUILD_KERNEL)
+  struct mallinfo mem;
+#endif
+
+  hdr->version  = PROCFS_SNAPSHOT_VERSION;
+  hdr->hdrsize  = offsetof(struct snapshot_file_s, task) -
+                  offsetof(struct snapshot_file_s, hdr);
+  hdr->tasksize = sizeof(struct procfs_snapshot_task_s);
+
+  /* The heaps are walked before the tasks are visited, so that the
+   * critical sections of nxsched_foreach() are not held for that long.
+   */
+
+#if !defined(CONFIG_BUILD_KERNEL)
+  mem                = kumm_mallinfo();
+  hdr->umem_arena    = mem.arena;
+  hdr->umem_used     = mem.uordblks;
+  hdr->umem_free     = mem.fordblks;
+  hdr->umem_largest  = mem.mxordblk;
+#endif
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+  mem                = kmm_mallinfo();
+  hdr->kmem_arena    = mem.arena;
+  hdr->kmem_used     = mem.uordblks;
+  hdr->kmem_free     = mem.fordblks;
+  hdr->kmem_largest  = mem.mxordblk;
+#endif
+
+#ifdef CONFIG_MM_IOB
+  hdr->iob_free      = iob_navail(false);
+  hdr->iob_throttled = iob_navail(true);
+  hdr->iob_qfree     = iob_qentry_navail();
+#else
+  hdr->iob_free      = -1;
+  hdr->iob_throttled = -1;
+  hdr->iob_qfree     = -1;
+#endif
+
+  /* The lock keeps the task records consistent with each other */
+
+  sched_lock();
+  hdr->sequence      = ++g_snapshot_sequence;
+  hdr->uptime        = clock_systime_ticks();
+  nxsched_foreach(snapshot_task, procfile);
+  sched_unlock();
+
+  procfile->size     = hdr->hdrsize + hdr->ntasks * hdr->tasksize;
+}
+
+/****************************************************************************
+ * Name: snapshot_open
+ *
+ * Description:
+ *   Open the file and take the snapshot.
+ *
+ ****************************************************************************/
+
+static int snapshot_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct snapshot_file_s *procfile;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "snapshot" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "snapshot") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct snapshot_file_s *)
+    kmm_zalloc(sizeof(struct snapshot_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  snapshot_take(procfile);
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: snapshot_close
+ ****************************************************************************/
+
+static int snapshot_close(FAR struct file *filep)
+{
+  FAR struct snapshot_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct snapshot_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: snapshot_read
+ *
+ * Description:
+ *   Return the bytes of the snapshot taken at open.  A new snapshot is
+ *   taken by reopening the file.
+ *
+ ****************************************************************************/
+
+static ssize_t snapshot_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct snapshot_file_s *procfile;
+  size_t copysize;
+  off_t offset;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct snapshot_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  offset   = filep->f_pos;
+  copysize = procfs_memcpy((FAR const char *)&procfile->hdr,
+                           procfile->size, buffer, buflen, &offset);
+
+  /* Update the file offset */
+
+  filep->f_pos += copysize;
+  return copysize;
+}
+
+/****************************************************************************
+ * Name: snapshot_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int snapshot_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct snapshot_file_s *oldattr;
+  FAR struct snapshot_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct snapshot_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct snapshot_file_s *)
+    kmm_malloc(sizeof(struct snapshot_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct snapshot_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: snapshot_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int snapshot_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "snapshot" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "snapshot") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "snapshot" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_SNAPSHOT */
@@ -0,0 +1,333 @@
+/****************************************************************************
+ * fs/procfs/fs_procfstracelat.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched_note.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_SCHED_TRACE_LATENCY)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Determines the size of an intermediate buffer that must be large enough
+ * to handle the longest line generated by this logic.
+ */
+
+#define TRACELAT_LINELEN 256
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct tracelat_file_s
+{
+  struct procfs_file_s base;      /* Base open file structure */
+  char line[TRACELAT_LINELEN];    /* Pre-allocated buffer for formatted lines */
+
+  /* The histograms taken when the file was opened */
+
+  struct note_tracelat_s lat[NOTE_TRACE_NCATEGORIES];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int     tracelat_open(FAR struct file *filep, FAR const char *relpath,
+                 int oflags, mode_t mode);
+static int     tracelat_close(FAR struct file *filep);
+static ssize_t tracelat_read(FAR struct file *filep, FAR char *buffer,
+                 size_t buflen);
+static int     tracelat_dup(FAR const struct file *oldp,
+                 FAR struct file *newp);
+static int     tracelat_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The names of the tracepoint categories */
+
+static FAR const char * const g_tracelat_names[NOTE_TRACE_NCATEGORIES] =
+{
+  "net",
+  "fs",
+  "mm",
+  "wqueue",
+  "boot"
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations tracelat_operations =
+{
+  tracelat_open,   /* open */
+  tracelat_close,  /* close */
+  tracelat_read,   /* read */
+  NULL,            /* write */
+  tracelat_dup,    /* dup */
+  NULL,            /* opendir */
+  NULL,            /* closedir */
+  NULL,            /* readdir */
+  NULL,            /* rewinddir */
+  tracelat_stat    /* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tracelat_open
+ *
+ * Description:
+ *   Open the file and take the histograms.  The histograms are cleared so
+ *   that each open reports the operations since the previous one.
+ *
+ ****************************************************************************/
+
+static int tracelat_open(FAR struct file *filep, FAR const char *relpath,
+                         int oflags, mode_t mode)
+{
+  FAR struct tracelat_file_s *procfile;
+  int i;
+
+  finfo("Open '%s'\n", relpath);
+
+  /* PROCFS is read-only.  Any attempt to open with any kind of write
+   * access is not permitted.
+   */
+
+  if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0)
+    {
+      ferr("ERROR: Only O_RDONLY supported\n");
+      return -EACCES;
+    }
+
+  /* "tracelat" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "tracelat") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* Allocate a container to hold the file attributes */
+
+  procfile = (FAR struct tracelat_file_s *)
+    kmm_zalloc(sizeof(struct tracelat_file_s));
+  if (!procfile)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < NOTE_TRACE_NCATEGORIES; i++)
+    {
+      sched_trace_latency(i, &procfile->lat[i], true);
+    }
+
+  /* Save the attributes as the open-specific state in filep->f_priv */
+
+  filep->f_priv = (FAR void *)procfile;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tracelat_close
+ ****************************************************************************/
+
+static int tracelat_close(FAR struct file *filep)
+{
+  FAR struct tracelat_file_s *procfile;
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct tracelat_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  /* Release the file attributes structure */
+
+  kmm_free(procfile);
+  filep->f_priv = NULL;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tracelat_read
+ *
+ * Description:
+ *   Generate one line for each tracepoint category:  The name, the longest
+ *   time in microseconds and the number of operations in each histogram
+ *   bucket.
+ *
+ ****************************************************************************/
+
+static ssize_t tracelat_read(FAR struct file *filep, FAR char *buffer,
+                             size_t buflen)
+{
+  FAR struct tracelat_file_s *procfile;
+  FAR struct note_tracelat_s *lat;
+  size_t linesize;
+  size_t copysize;
+  size_t totalsize;
+  off_t offset;
+  int i;
+  int j;
+
+  finfo("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+  DEBUGASSERT(filep != NULL && buffer != NULL && buflen > 0);
+
+  /* Recover our private data from the struct file instance */
+
+  procfile = (FAR struct tracelat_file_s *)filep->f_priv;
+  DEBUGASSERT(procfile);
+
+  totalsize = 0;
+  offset    = filep->f_pos;
+
+  for (i = 0; i < NOTE_TRACE_NCATEGORIES && totalsize < buflen; i++)
+    {
+      lat      = &procfile->lat[i];
+      linesize = snprintf(procfile->line, TRACELAT_LINELEN, "%s,%lu",
+                          g_tracelat_names[i], (unsigned long)lat->ntl_max);
+
+      for (j = 0; j < NOTE_TRACE_NBUCKETS; j++)
+        {
+          linesize += snprintf(procfile->line + linesize,
+                               TRACELAT_LINELEN - linesize, ",%lu",
+                               (unsigned long)lat->ntl_count[j]);
+        }
+
+      linesize += snprintf(procfile->line + linesize,
+                           TRACELAT_LINELEN - linesize, "\n");
+
+      copysize   = procfs_memcpy(procfile->line, linesize,
+                                 buffer + totalsize, buflen - totalsize,
+                                 &offset);
+      totalsize += copysize;
+    }
+
+  /* Update the file offset */
+
+  filep->f_pos += totalsize;
+  return totalsize;
+}
+
+/****************************************************************************
+ * Name: tracelat_dup
+ *
+ * Description:
+ *   Duplicate open file data in the new file structure.
+ *
+ ****************************************************************************/
+
+static int tracelat_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+  FAR struct tracelat_file_s *oldattr;
+  FAR struct tracelat_file_s *newattr;
+
+  finfo("Dup %p->%p\n", oldp, newp);
+
+  /* Recover our private data from the old struct file instance */
+
+  oldattr = (FAR struct tracelat_file_s *)oldp->f_priv;
+  DEBUGASSERT(oldattr);
+
+  /* Allocate a new container to hold the task and attribute selection */
+
+  newattr = (FAR struct tracelat_file_s *)
+    kmm_malloc(sizeof(struct tracelat_file_s));
+  if (!newattr)
+    {
+      ferr("ERROR: Failed to allocate file attributes\n");
+      return -ENOMEM;
+    }
+
+  /* The copy the file attributes from the old attributes to the new */
+
+  memcpy(newattr, oldattr, sizeof(struct tracelat_file_s));
+
+  /* Save the new attributes in the new file structure */
+
+  newp->f_priv = (FAR void *)newattr;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tracelat_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int tracelat_stat(FAR const char *relpath, FAR struct stat *buf)
+{
+  /* "tracelat" is the only acceptable value for the relpath */
+
+  if (strcmp(relpath, "tracelat") != 0)
+    {
+      ferr("ERROR: relpath is '%s'\n", relpath);
+      return -ENOENT;
+    }
+
+  /* "tracelat" is the name for a read-only file */
+
+  memset(buf, 0, sizeof(struct stat));
+  buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+  return OK;
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * CONFIG_SCHED_TRACE_LATENCY */
@@ -844,6 +844,12 @@ static size_t smartfs_status_read(FAR struct file *filep, FAR char *buffer,
                                          "Sectors Per Block: %d\nSector Utilization:%d%%\n"
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
                                          "Uneven Wear Count: %d\n"
+#endif
+                                         "GC Collects:       %d\n"
+                                         "GC Time (ms):      %d\n"
+                                         "GC Max Time (ms):  %d\n"
+#ifdef CONFIG_MTD_SMART_BGGC
+                                         "BG GC Collects:    %d\n"
 #endif
                   ,
                   procfs_data.formatversion, procfs_data.namelen,
@@ -854,6 +860,11 @@ static size_t smartfs_status_read(FAR struct file *filep, FAR char *buffer,
                   procfs_data.sectorsperblk, utilization
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
                   , procfs_data.uneven_wearcount
+#endif
+                  , procfs_data.gccollects, procfs_data.gctime,
+                  procfs_data.gcmaxtime
+#ifdef CONFIG_MTD_SMART_BGGC
+                  , procfs_data.bgcollects
 #endif
            );
         }
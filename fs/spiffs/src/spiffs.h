@@ -72,6 +72,12 @@ extern "C"
 
 #define SPIFFS_NO_HOLDER                ((pid_t)-1)
 
+/* The number of remembered object header locations */
+
+#ifndef CONFIG_SPIFFS_LOOKUP_CACHE
+#  define CONFIG_SPIFFS_LOOKUP_CACHE    16
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -117,6 +123,16 @@ struct spiffs_sem_s
   uint16_t count;                   /* Number of counts held */
 };
 
+/* Remembers the object header page of a file name */
+
+#if CONFIG_SPIFFS_LOOKUP_CACHE > 0
+struct spiffs_lucache_s
+{
+  uint32_t hash;                    /* Hash of the file name */
+  int16_t pgndx;                    /* Object header page, 0 if unused */
+};
+#endif
+
 /* spiffs SPI configuration struct */
 
 /* This structure represents the current state of an SPIFFS volume */
@@ -148,9 +164,12 @@ struct spiffs_s
   uint32_t stats_gc_runs;
 #endif
   uint32_t cache_size;              /* Cache size */
-#ifdef CONFIG_SPIFFS_CACHEDBG
   uint32_t cache_hits;              /* Number of cache hits */
   uint32_t cache_misses;            /* Number of cache misses */
+#if CONFIG_SPIFFS_LOOKUP_CACHE > 0
+  uint32_t lu_hits;                 /* Number of name lookup cache hits */
+  uint32_t lu_misses;               /* Number of name lookup cache misses */
+  struct spiffs_lucache_s lu_cache[CONFIG_SPIFFS_LOOKUP_CACHE];
 #endif
   int16_t free_blkndx;              /* Cursor for free blocks, block index */
   int16_t lu_blkndx;                /* Cursor when searching, block index */
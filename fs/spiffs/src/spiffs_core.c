@@ -277,29 +277,23 @@ static int spiffs_objlu_find_id_and_span_callback(FAR struct spiffs_s *fs,
 }
 
 /****************************************************************************
- * Name: spiffs_find_objhdr_pgndx_callback
+ * Name: spiffs_objhdr_match
  *
  * Description:
+ *   Check if a page holds the live object header of a file name.
+ *
+ * Returned Value:
+ *   One if it does, zero if it does not, or a negated errno value on a
+ *   read failure.
  *
  ****************************************************************************/
 
-static int spiffs_find_objhdr_pgndx_callback(FAR struct spiffs_s *fs, int16_t objid,
-                                             int16_t blkndx, int entry,
-                                             FAR const void *user_const,
-                                             FAR void *user_var)
+static int spiffs_objhdr_match(FAR struct spiffs_s *fs, int16_t pgndx,
+                               FAR const char *name)
 {
   struct spiffs_pgobj_ndxheader_s objhdr;
-  int16_t pgndx;
   int ret;
 
-  if (objid == SPIFFS_OBJID_FREE || objid == SPIFFS_OBJID_DELETED ||
-      (objid & SPIFFS_OBJID_NDXFLAG) == 0)
-    {
-      return SPIFFS_VIS_COUNTINUE;
-    }
-
-  pgndx = SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry);
-
   ret = spiffs_cache_read(fs, SPIFFS_OP_T_OBJ_LU2 | SPIFFS_OP_C_READ,
                           0, SPIFFS_PAGE_TO_PADDR(fs, pgndx),
                           sizeof(struct spiffs_pgobj_ndxheader_s),
@@ -315,13 +309,67 @@ static int spiffs_find_objhdr_pgndx_callback(FAR struct spiffs_s *fs, int16_t ob
                             SPIFFS_PH_FLAG_NDXDELE)) ==
       (SPIFFS_PH_FLAG_DELET | SPIFFS_PH_FLAG_NDXDELE))
     {
-      if (strcmp((FAR const char *)user_const, (FAR char *)objhdr.name) == 0)
+      if (strcmp(name, (FAR char *)objhdr.name) == 0)
         {
-          return OK;
+          return 1;
         }
     }
 
-  return SPIFFS_VIS_COUNTINUE;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: spiffs_name_hash
+ *
+ * Description:
+ *   Return the (FNV-1a) hash of a file name.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SPIFFS_LOOKUP_CACHE > 0
+static uint32_t spiffs_name_hash(FAR const uint8_t *name)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*name != '\0')
+    {
+      hash = (hash ^ *name++) * 16777619u;
+    }
+
+  return hash;
+}
+#endif
+
+/****************************************************************************
+ * Name: spiffs_find_objhdr_pgndx_callback
+ *
+ * Description:
+ *
+ ****************************************************************************/
+
+static int spiffs_find_objhdr_pgndx_callback(FAR struct spiffs_s *fs, int16_t objid,
+                                             int16_t blkndx, int entry,
+                                             FAR const void *user_const,
+                                             FAR void *user_var)
+{
+  int16_t pgndx;
+  int ret;
+
+  if (objid == SPIFFS_OBJID_FREE || objid == SPIFFS_OBJID_DELETED ||
+      (objid & SPIFFS_OBJID_NDXFLAG) == 0)
+    {
+      return SPIFFS_VIS_COUNTINUE;
+    }
+
+  pgndx = SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry);
+
+  ret = spiffs_objhdr_match(fs, pgndx, (FAR const char *)user_const);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return ret > 0 ? OK : SPIFFS_VIS_COUNTINUE;
 }
 
 /****************************************************************************
@@ -2679,10 +2727,47 @@ int spiffs_find_objhdr_pgndx(FAR struct spiffs_s *fs,
                              const uint8_t name[CONFIG_SPIFFS_NAME_MAX],
                              FAR int16_t *pgndx)
 {
+#if CONFIG_SPIFFS_LOOKUP_CACHE > 0
+  FAR struct spiffs_lucache_s *lu;
+  uint32_t hash;
+#endif
   int16_t blkndx;
   int entry;
   int ret;
 
+#if CONFIG_SPIFFS_LOOKUP_CACHE > 0
+  /* Try the remembered object header first.  If the file was deleted or
+   * moved by the garbage collector, the page no longer holds its live
+   * header and the lookup pages are searched.
+   */
+
+  hash = spiffs_name_hash(name);
+  lu   = &fs->lu_cache[hash % CONFIG_SPIFFS_LOOKUP_CACHE];
+
+  if (lu->pgndx != 0 && lu->hash == hash)
+    {
+      ret = spiffs_objhdr_match(fs, lu->pgndx, (FAR const char *)name);
+      if (ret < 0)
+        {
+          return ret;
+        }
+      else if (ret > 0)
+        {
+          fs->lu_hits++;
+          if (pgndx != NULL)
+            {
+              *pgndx = lu->pgndx;
+            }
+
+          return OK;
+        }
+
+      lu->pgndx = 0;
+    }
+
+  fs->lu_misses++;
+#endif
+
   ret = spiffs_foreach_objlu(fs, fs->lu_blkndx, fs->lu_entry,
                              0, 0, spiffs_find_objhdr_pgndx_callback,
                              name, 0, &blkndx, &entry);
@@ -2702,6 +2787,14 @@ int spiffs_find_objhdr_pgndx(FAR struct spiffs_s *fs,
       *pgndx = SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry);
     }
 
+#if CONFIG_SPIFFS_LOOKUP_CACHE > 0
+  if (ret >= 0)
+    {
+      lu->hash  = hash;
+      lu->pgndx = SPIFFS_OBJ_LOOKUP_ENTRY_TO_PGNDX(fs, blkndx, entry);
+    }
+#endif
+
   fs->lu_blkndx = blkndx;
   fs->lu_entry  = entry;
 
@@ -1074,6 +1074,35 @@ static int spiffs_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
         break;
 #endif
 
+      /* Return the cache statistics.
+       * IN:  A pointer to struct fs_cachestats_s
+       * OUT: The statistics
+       */
+
+      case FIOC_CACHESTATS:
+        {
+          FAR struct fs_cachestats_s *stats =
+            (FAR struct fs_cachestats_s *)((uintptr_t)arg);
+
+          if (stats == NULL)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          stats->hits          = fs->cache_hits;
+          stats->misses        = fs->cache_misses;
+#if CONFIG_SPIFFS_LOOKUP_CACHE > 0
+          stats->lookup_hits   = fs->lu_hits;
+          stats->lookup_misses = fs->lu_misses;
+#else
+          stats->lookup_hits   = 0;
+          stats->lookup_misses = 0;
+#endif
+          ret = OK;
+        }
+        break;
+
       default:
 
         /* Pass through to the contained MTD driver */
@@ -360,12 +360,24 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
   FAR struct tmpfs_file_s *newtfo;
   size_t objsize;
   size_t allocsize;
+  size_t guard;
   size_t delta;
 
   /* Check if the current allocation is sufficient */
 
   objsize = SIZEOF_TMPFS_FILE(newsize);
 
+  /* Some additional amount is added to the new size to avoid frequent
+   * reallocations.  It grows with the size of the file so that appending
+   * to a large file does not copy the whole file over and over again.
+   */
+
+  guard = objsize / 100 * CONFIG_FS_TMPFS_FILE_ALLOCPERCENT;
+  if (guard < CONFIG_FS_TMPFS_FILE_ALLOCGUARD)
+    {
+      guard = CONFIG_FS_TMPFS_FILE_ALLOCGUARD;
+    }
+
   /* Are we growing or shrinking the object? */
 
   if (objsize <= oldtfo->tfo_alloc)
@@ -376,12 +388,13 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
 
       if (newsize > 0)
         {
-          /* Otherwise, don't realloc unless the object has shrunk by a
-           * lot.
+          /* Otherwise, don't realloc if the file grows within the current
+           * allocation or unless the object would shrink by a lot.
            */
 
           delta = oldtfo->tfo_alloc - objsize;
-          if (delta <= CONFIG_FS_TMPFS_FILE_FREEGUARD)
+          if (newsize >= oldtfo->tfo_size ||
+              delta <= CONFIG_FS_TMPFS_FILE_FREEGUARD + guard)
             {
               /* Hasn't shrunk enough.. Return doing nothing for now */
 
@@ -391,11 +404,7 @@ static int tmpfs_realloc_file(FAR struct tmpfs_file_s **tfo,
         }
     }
 
-  /* Added some additional amount to the new size to account frequent
-   * reallocations.
-   */
-
-  allocsize = objsize + CONFIG_FS_TMPFS_FILE_ALLOCGUARD;
+  allocsize = objsize + guard;
 
   /* Realloc the file object */
 
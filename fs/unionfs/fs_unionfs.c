@@ -125,6 +125,11 @@ static int     unionfs_trystatdir(FAR struct inode *inode,
                  FAR const char *relpath, FAR const char *prefix);
 static int     unionfs_trystatfile(FAR struct inode *inode,
                  FAR const char *relpath, FAR const char *prefix);
+static uint32_t unionfs_namehash(FAR const char *name);
+static void    unionfs_addname(FAR struct fs_unionfsdir_s *fu,
+                 FAR const char *name);
+static bool    unionfs_mayhavename(FAR struct fs_unionfsdir_s *fu,
+                 FAR const char *name);
 static FAR char *unionfs_relpath(FAR const char *path,
                  FAR const char *name);
 
@@ -716,6 +721,66 @@ static FAR char *unionfs_relpath(FAR const char *path, FAR const char *name)
     }
 }
 
+/****************************************************************************
+ * Name: unionfs_namehash
+ *
+ * Description:
+ *   Return the (FNV-1a) hash of a directory entry name.
+ *
+ ****************************************************************************/
+
+static uint32_t unionfs_namehash(FAR const char *name)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*name != '\0')
+    {
+      hash = (hash ^ (uint8_t)*name++) * 16777619u;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Name: unionfs_addname
+ *
+ * Description:
+ *   Record a name enumerated on file system 1 in the Bloom filter of the
+ *   directory.  Two bits of the 256-bit filter are set for each name.
+ *
+ ****************************************************************************/
+
+static void unionfs_addname(FAR struct fs_unionfsdir_s *fu,
+                            FAR const char *name)
+{
+  uint32_t hash = unionfs_namehash(name);
+  uint8_t bit1  = hash & 0xff;
+  uint8_t bit2  = (hash >> 16) & 0xff;
+
+  fu->fu_names[bit1 >> 5] |= (uint32_t)1 << (bit1 & 31);
+  fu->fu_names[bit2 >> 5] |= (uint32_t)1 << (bit2 & 31);
+}
+
+/****************************************************************************
+ * Name: unionfs_mayhavename
+ *
+ * Description:
+ *   Return false if the name was certainly not enumerated on file system 1.
+ *   A return value of true must be confirmed on file system 1.
+ *
+ ****************************************************************************/
+
+static bool unionfs_mayhavename(FAR struct fs_unionfsdir_s *fu,
+                                FAR const char *name)
+{
+  uint32_t hash = unionfs_namehash(name);
+  uint8_t bit1  = hash & 0xff;
+  uint8_t bit2  = (hash >> 16) & 0xff;
+
+  return (fu->fu_names[bit1 >> 5] & ((uint32_t)1 << (bit1 & 31))) != 0 &&
+         (fu->fu_names[bit2 >> 5] & ((uint32_t)1 << (bit2 & 31))) != 0;
+}
+
 /****************************************************************************
  * Name: unionfs_unbind_child
  ****************************************************************************/
@@ -1871,14 +1936,25 @@ static int unionfs_readdir(struct inode *mountpt, struct fs_dirent_s *dir)
                 }
             }
 
+          /* Remember the names on file system 1.  They are all enumerated
+           * before those on file system 2.
+           */
+
+          if (ret >= 0 && fu->fu_ndx == 0)
+            {
+              unionfs_addname(fu, fu->fu_lower[0]->fd_dir.d_name);
+            }
+
           /* Did we successfully read a directory from file system 2?  If
            * so, we need to omit an duplicates that should be occluded by
            * the matching file on file system 1 (if we are enumerating
-           * file system 1).
+           * file system 1).  Names that the filter has not seen on file
+           * system 1 need no lookup there.
            */
 
           duplicate = false;
-          if (ret >= 0 && fu->fu_ndx == 1 && fu->fu_lower[0] != NULL)
+          if (ret >= 0 && fu->fu_ndx == 1 && fu->fu_lower[0] != NULL &&
+              unionfs_mayhavename(fu, fu->fu_lower[1]->fd_dir.d_name))
             {
               /* Get the relative path to the same file on file system 1.
                * NOTE: the on any failures we just assume that the filep
@@ -1968,6 +2044,10 @@ static int unionfs_rewinddir(struct inode *mountpt, struct fs_dirent_s *dir)
       fu->fu_ndx = 0;
     }
 
+  /* File system 1 will be enumerated again */
+
+  memset(fu->fu_names, 0, sizeof(fu->fu_names));
+
   if (!fu->fu_prefix[fu->fu_ndx])
     {
       DEBUGASSERT(fu->fu_lower[fu->fu_ndx] != NULL);
@@ -2843,6 +2923,7 @@ int unionfs_mount(FAR const char *fspath1, FAR const char *prefix1,
   /* Populate the inode with driver specific information. */
 
   INODE_SET_MOUNTPT(mpinode);
+  inode_cacheinvalidate();
 
   mpinode->u.i_mops  = &unionfs_operations;
 #ifdef CONFIG_FILE_MODE
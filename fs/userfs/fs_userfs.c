@@ -1077,7 +1077,12 @@ static int userfs_opendir(FAR struct inode *mountpt, FAR const char *relpath,
   /* Save the opaque dir reference in struct fs_dirent_s */
 
   DEBUGASSERT(dir != NULL);
-  dir->u.userfs.fs_dir = resp->dir;
+  dir->u.userfs.fs_dir     = resp->dir;
+#if CONFIG_FS_USERFS_READDIR_BATCH > 1
+  dir->u.userfs.fs_entries = NULL;
+  dir->u.userfs.fs_next    = 0;
+  dir->u.userfs.fs_count   = 0;
+#endif
   return resp->ret;
 }
 
@@ -1103,6 +1108,16 @@ static int userfs_closedir(FAR struct inode *mountpt,
               mountpt->i_private != NULL);
   priv = mountpt->i_private;
 
+#if CONFIG_FS_USERFS_READDIR_BATCH > 1
+  /* Free the entries that were read ahead */
+
+  if (dir->u.userfs.fs_entries != NULL)
+    {
+      kmm_free(dir->u.userfs.fs_entries);
+      dir->u.userfs.fs_entries = NULL;
+    }
+#endif
+
   /* Get exclusive access */
 
   ret = nxsem_wait(&priv->exclsem);
@@ -1169,13 +1184,54 @@ static int userfs_readdir(FAR struct inode *mountpt,
   FAR struct userfs_state_s *priv;
   FAR struct userfs_readdir_request_s *req;
   FAR struct userfs_readdir_response_s *resp;
+  FAR struct fs_userfsdir_s *udir;
+  unsigned int maxent;
   ssize_t nsent;
   ssize_t nrecvd;
   int ret;
 
   DEBUGASSERT(mountpt != NULL &&
-              mountpt->i_private != NULL);
+              mountpt->i_private != NULL && dir != NULL);
   priv = mountpt->i_private;
+  udir = &dir->u.userfs;
+
+  /* Ask for as many entries as fit into the I/O buffer */
+
+  maxent = 1;
+
+#if CONFIG_FS_USERFS_READDIR_BATCH > 1
+  /* Return an entry that was read ahead with the last request */
+
+  if (udir->fs_next < udir->fs_count)
+    {
+      memcpy(&dir->fd_dir, &udir->fs_entries[udir->fs_next++],
+             sizeof(struct dirent));
+      return OK;
+    }
+
+  if (IOBUFFER_SIZE(priv) > SIZEOF_USERFS_READDIR_RESPONSE_S(1))
+    {
+      maxent = (IOBUFFER_SIZE(priv) - SIZEOF_USERFS_READDIR_RESPONSE_S(1)) /
+               sizeof(struct dirent) + 1;
+      if (maxent > CONFIG_FS_USERFS_READDIR_BATCH)
+        {
+          maxent = CONFIG_FS_USERFS_READDIR_BATCH;
+        }
+    }
+
+  /* The first entry is returned now, the others are kept for later */
+
+  if (maxent > 1 && udir->fs_entries == NULL)
+    {
+      udir->fs_entries = (FAR struct dirent *)
+        kmm_malloc((CONFIG_FS_USERFS_READDIR_BATCH - 1) *
+                   sizeof(struct dirent));
+      if (udir->fs_entries == NULL)
+        {
+          maxent = 1;
+        }
+    }
+#endif
 
   /* Get exclusive access */
 
@@ -1187,9 +1243,10 @@ static int userfs_readdir(FAR struct inode *mountpt,
 
   /* Construct and send the request to the server */
 
-  req      = (FAR struct userfs_readdir_request_s *)priv->iobuffer;
-  req->req = USERFS_REQ_READDIR;
-  req->dir = dir->u.userfs.fs_dir;
+  req           = (FAR struct userfs_readdir_request_s *)priv->iobuffer;
+  req->req      = USERFS_REQ_READDIR;
+  req->nentries = maxent;
+  req->dir      = udir->fs_dir;
 
   nsent = psock_sendto(&priv->psock, priv->iobuffer,
                        sizeof(struct userfs_readdir_request_s), 0,
@@ -1206,32 +1263,53 @@ static int userfs_readdir(FAR struct inode *mountpt,
 
   nrecvd = psock_recvfrom(&priv->psock, priv->iobuffer, IOBUFFER_SIZE(priv),
                           0, NULL, NULL);
-  nxsem_post(&priv->exclsem);
-
   if (nrecvd < 0)
     {
       ferr("ERROR: psock_recvfrom failed: %d\n", (int)nrecvd);
+      nxsem_post(&priv->exclsem);
       return (int)nrecvd;
     }
 
-  if (nrecvd != sizeof(struct userfs_readdir_response_s))
+  resp = (FAR struct userfs_readdir_response_s *)priv->iobuffer;
+  if (nrecvd < SIZEOF_USERFS_READDIR_RESPONSE_S(1) ||
+      resp->nentries > maxent ||
+      nrecvd != SIZEOF_USERFS_READDIR_RESPONSE_S(resp->nentries > 0 ?
+                                                 resp->nentries : 1))
     {
       ferr("ERROR: Response size incorrect: %u\n", (unsigned int)nrecvd);
+      nxsem_post(&priv->exclsem);
       return -EIO;
     }
 
-  resp = (FAR struct userfs_readdir_response_s *)priv->iobuffer;
   if (resp->resp != USERFS_RESP_READDIR)
     {
       ferr("ERROR: Incorrect response: %u\n", resp->resp);
+      nxsem_post(&priv->exclsem);
       return -EIO;
     }
 
-  /* Return the dirent */
+  /* Return the first dirent and keep the others.  The I/O buffer must not
+   * be released before the entries are copied out of it.
+   */
 
-  DEBUGASSERT(dir != NULL);
-  memcpy(&dir->fd_dir, &resp->entry, sizeof(struct dirent));
-  return resp->ret;
+  ret = resp->ret;
+  if (resp->nentries > 0)
+    {
+      memcpy(&dir->fd_dir, &resp->entry[0], sizeof(struct dirent));
+
+#if CONFIG_FS_USERFS_READDIR_BATCH > 1
+      udir->fs_next  = 0;
+      udir->fs_count = resp->nentries - 1;
+      if (udir->fs_count > 0)
+        {
+          memcpy(udir->fs_entries, &resp->entry[1],
+                 udir->fs_count * sizeof(struct dirent));
+        }
+#endif
+    }
+
+  nxsem_post(&priv->exclsem);
+  return ret;
 }
 
 /****************************************************************************
@@ -1269,6 +1347,13 @@ static int userfs_rewinddir(FAR struct inode *mountpt,
   req->req = USERFS_REQ_REWINDDIR;
   req->dir = dir->u.userfs.fs_dir;
 
+#if CONFIG_FS_USERFS_READDIR_BATCH > 1
+  /* Discard the entries that were read ahead */
+
+  dir->u.userfs.fs_next  = 0;
+  dir->u.userfs.fs_count = 0;
+#endif
+
   nsent = psock_sendto(&priv->psock, priv->iobuffer,
                        sizeof(struct userfs_rewinddir_request_s), 0,
                        (FAR struct sockaddr *)&priv->server,
@@ -42,12 +42,306 @@
 #include <sys/epoll.h>
 
 #include <stdint.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <queue.h>
 #include <poll.h>
+#include <assert.h>
 #include <errno.h>
-#include <string.h>
 #include <debug.h>
 
+#include <nuttx/nuttx.h>
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* REVISIT: This will not work on machines where:
+ * sizeof(struct epoll_head_s *) > sizeof(int)
+ */
+
+#define epoll_head(epfd) ((FAR struct epoll_head_s *)((intptr_t)(epfd)))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One descriptor registered with an epoll instance.  Its pollfd stays set
+ * up with the driver for as long as the descriptor is registered.  The
+ * driver reports events through the poll callback which queues the node
+ * in the ready list of the instance, so epoll_wait() never has to visit
+ * the descriptors that are not ready.
+ */
+
+struct epoll_head_s;
+
+struct epoll_node_s
+{
+  dq_entry_t               node;     /* Link in the list of all nodes */
+  dq_entry_t               rnode;    /* Link in the ready list */
+  dq_entry_t               anode;    /* Link in the list to re-arm */
+  FAR struct epoll_head_s *eph;      /* The epoll instance */
+  struct epoll_event       ev;       /* The registered events and data */
+  struct pollfd            pfd;      /* The persistent poll setup */
+  bool                     armed;    /* The poll is set up with the driver */
+  bool                     ready;    /* The node is in the ready list */
+  bool                     rearm;    /* The node is in the re-arm list */
+  bool                     disabled; /* Disabled after an EPOLLONESHOT event */
+};
+
+/* One epoll instance */
+
+struct epoll_head_s
+{
+  sem_t                    lock;     /* Serializes access to the instance */
+  sem_t                    sem;      /* Posted when a node becomes ready */
+  dq_queue_t               nodes;    /* All registered descriptors */
+  dq_queue_t               ready;    /* Descriptors with pending events */
+  dq_queue_t               rearm;    /* Reported descriptors to re-arm */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_pollcb
+ *
+ * Description:
+ *   The poll callback of a registered descriptor.  Queue the node in the
+ *   ready list and wake up epoll_wait().
+ *
+ * Assumptions:
+ *   May be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+static void epoll_pollcb(FAR struct pollfd *fds)
+{
+  FAR struct epoll_node_s *epn = (FAR struct epoll_node_s *)fds->arg;
+  FAR struct epoll_head_s *eph = epn->eph;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  if (!epn->ready && !epn->disabled && fds->revents != 0)
+    {
+      dq_addlast(&epn->rnode, &eph->ready);
+      epn->ready = true;
+      nxsem_post(&eph->sem);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_setup
+ *
+ * Description:
+ *   Set up (or tear down) the persistent poll of a registered descriptor.
+ *
+ ****************************************************************************/
+
+static int epoll_setup(FAR struct epoll_node_s *epn, bool setup)
+{
+  int fd = epn->pfd.fd;
+  int ret;
+
+  if (setup)
+    {
+      epn->pfd.revents = 0;
+      epn->pfd.priv    = NULL;
+    }
+  else if (!epn->armed)
+    {
+      return OK;
+    }
+
+  if (fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+#ifdef CONFIG_NET
+      if (fd < (CONFIG_NFILE_DESCRIPTORS + CONFIG_NSOCKET_DESCRIPTORS))
+        {
+          ret = net_poll(fd, &epn->pfd, setup);
+        }
+      else
+#endif
+        {
+          ret = -EBADF;
+        }
+    }
+  else
+    {
+      ret = fs_poll(fd, &epn->pfd, setup);
+    }
+
+  if (ret >= 0)
+    {
+      epn->armed = setup;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: epoll_unready
+ *
+ * Description:
+ *   Remove a node from the ready list and from the re-arm list.
+ *
+ ****************************************************************************/
+
+static void epoll_unready(FAR struct epoll_head_s *eph,
+                          FAR struct epoll_node_s *epn)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  if (epn->ready)
+    {
+      dq_rem(&epn->rnode, &eph->ready);
+      epn->ready = false;
+    }
+
+  leave_critical_section(flags);
+
+  if (epn->rearm)
+    {
+      dq_rem(&epn->anode, &eph->rearm);
+      epn->rearm = false;
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_find
+ *
+ * Description:
+ *   Find the node of a registered descriptor.
+ *
+ ****************************************************************************/
+
+static FAR struct epoll_node_s *epoll_find(FAR struct epoll_head_s *eph,
+                                           int fd)
+{
+  FAR dq_entry_t *entry;
+
+  for (entry = dq_peek(&eph->nodes); entry != NULL; entry = dq_next(entry))
+    {
+      FAR struct epoll_node_s *epn =
+        container_of(entry, struct epoll_node_s, node);
+
+      if (epn->pfd.fd == fd)
+        {
+          return epn;
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: epoll_rearm
+ *
+ * Description:
+ *   Process the nodes reported by the last epoll_wait():  Level-triggered
+ *   descriptors are set up again so that their drivers re-evaluate (and
+ *   report again) the current state; descriptors disabled by EPOLLONESHOT
+ *   are torn down.
+ *
+ ****************************************************************************/
+
+static void epoll_rearm(FAR struct epoll_head_s *eph)
+{
+  FAR struct epoll_node_s *epn;
+  FAR dq_entry_t *entry;
+
+  while ((entry = dq_remfirst(&eph->rearm)) != NULL)
+    {
+      epn        = container_of(entry, struct epoll_node_s, anode);
+      epn->rearm = false;
+
+      if (epn->disabled)
+        {
+          epoll_setup(epn, false);
+        }
+      else if (!epn->ready)
+        {
+          /* Nothing needs to be done if the node is already reported
+           * again.
+           */
+
+          epoll_setup(epn, false);
+          if (epoll_setup(epn, true) < 0)
+            {
+              ferr("ERROR: Failed to re-arm fd=%d\n", epn->pfd.fd);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_collect
+ *
+ * Description:
+ *   Return the events of up to maxevents nodes from the ready list.
+ *
+ ****************************************************************************/
+
+static int epoll_collect(FAR struct epoll_head_s *eph,
+                         FAR struct epoll_event *evs, int maxevents)
+{
+  FAR struct epoll_node_s *epn;
+  FAR dq_entry_t *entry;
+  pollevent_t revents;
+  irqstate_t flags;
+  int count = 0;
+
+  flags = enter_critical_section();
+
+  while (count < maxevents && (entry = dq_remfirst(&eph->ready)) != NULL)
+    {
+      epn              = container_of(entry, struct epoll_node_s, rnode);
+      epn->ready       = false;
+      revents          = epn->pfd.revents;
+      epn->pfd.revents = 0;
+
+      if (revents == 0 || epn->disabled)
+        {
+          continue;
+        }
+
+      evs[count].events = revents;
+      evs[count].data   = epn->ev.data;
+      count++;
+
+      if ((epn->ev.events & EPOLLONESHOT) != 0)
+        {
+          epn->disabled = true;
+        }
+      else if ((epn->ev.events & EPOLLET) != 0)
+        {
+          /* The node is queued again when the driver reports new events */
+
+          continue;
+        }
+
+      if (!epn->rearm)
+        {
+          dq_addlast(&epn->anode, &eph->rearm);
+          epn->rearm = true;
+        }
+    }
+
+  leave_critical_section(flags);
+  return count;
+}
 
 /****************************************************************************
  * Public Functions
@@ -57,26 +351,48 @@
  * Name: epoll_create
  *
  * Description:
+ *   Create an epoll instance.
  *
  * Input Parameters:
+ *   size - A hint of the number of descriptors; it must be greater than
+ *          zero.  The number of descriptors is not limited.
  *
  * Returned Value:
+ *   The handle of the new instance is returned on success.  On failure, -1
+ *   is returned and errno is set appropriately.
  *
  ****************************************************************************/
 
 int epoll_create(int size)
 {
-  FAR struct epoll_head *eph =
-    (FAR struct epoll_head *)kmm_malloc(sizeof(struct epoll_head));
+  FAR struct epoll_head_s *eph;
 
-  eph->size = size;
-  eph->occupied = 0;
-  eph->evs = kmm_malloc(sizeof(struct epoll_event) * eph->size);
+  if (size <= 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  eph = (FAR struct epoll_head_s *)kmm_zalloc(sizeof(struct epoll_head_s));
+  if (eph == NULL)
+    {
+      set_errno(ENOMEM);
+      return ERROR;
+    }
+
+  nxsem_init(&eph->lock, 0, 1);
 
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
+  /* This semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
    */
 
+  nxsem_init(&eph->sem, 0, 0);
+  nxsem_setprotocol(&eph->sem, SEM_PRIO_NONE);
+
+  dq_init(&eph->nodes);
+  dq_init(&eph->ready);
+  dq_init(&eph->rearm);
+
   return (int)((intptr_t)eph);
 }
 
@@ -84,22 +400,33 @@ int epoll_create(int size)
  * Name: epoll_close
  *
  * Description:
+ *   Tear down all registered descriptors and free an epoll instance.
  *
  * Input Parameters:
- *
- * Returned Value:
+ *   epfd - The epoll instance
  *
  ****************************************************************************/
 
 void epoll_close(int epfd)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
-   */
+  FAR struct epoll_head_s *eph = epoll_head(epfd);
+  FAR struct epoll_node_s *epn;
+  FAR dq_entry_t *entry;
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  nxsem_wait_uninterruptible(&eph->lock);
 
-  kmm_free(eph->evs);
+  while ((entry = dq_remfirst(&eph->nodes)) != NULL)
+    {
+      epn = container_of(entry, struct epoll_node_s, node);
+      epoll_setup(epn, false);
+      epoll_unready(eph, epn);
+      kmm_free(epn);
+    }
+
+  nxsem_post(&eph->lock);
+
+  nxsem_destroy(&eph->sem);
+  nxsem_destroy(&eph->lock);
   kmm_free(eph);
 }
 
@@ -107,128 +434,246 @@ void epoll_close(int epfd)
  * Name: epoll_ctl
  *
  * Description:
+ *   Add, modify or remove a descriptor of an epoll instance.  The poll of
+ *   an added descriptor is set up once here and stays set up until the
+ *   descriptor is removed.  The descriptor must be removed before it is
+ *   closed.
  *
  * Input Parameters:
+ *   epfd - The epoll instance
+ *   op   - EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+ *   fd   - The descriptor
+ *   ev   - The events to monitor and the data returned with them.  May be
+ *          NULL for EPOLL_CTL_DEL.
  *
  * Returned Value:
+ *   Zero (OK) is returned on success.  On failure, -1 is returned and
+ *   errno is set appropriately.
  *
  ****************************************************************************/
 
 int epoll_ctl(int epfd, int op, int fd, struct epoll_event *ev)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
-   */
+  FAR struct epoll_head_s *eph = epoll_head(epfd);
+  FAR struct epoll_node_s *epn;
+  int ret = OK;
+
+  if (op != EPOLL_CTL_DEL && ev == NULL)
+    {
+      set_errno(EFAULT);
+      return ERROR;
+    }
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
+  nxsem_wait_uninterruptible(&eph->lock);
+
+  epn = epoll_find(eph, fd);
 
   switch (op)
     {
       case EPOLL_CTL_ADD:
-        finfo("%08x CTL ADD(%d): fd=%d ev=%08x\n",
-              epfd, eph->occupied, fd, ev->events);
-
-        eph->evs[eph->occupied].events = ev->events | POLLERR | POLLHUP;
-        eph->evs[eph->occupied++].data.fd = fd;
-        return 0;
+        finfo("%08x CTL ADD: fd=%d ev=%08" PRIx32 "\n",
+              epfd, fd, ev->events);
+
+        if (epn != NULL)
+          {
+            ret = -EEXIST;
+            break;
+          }
+
+        epn = (FAR struct epoll_node_s *)
+          kmm_zalloc(sizeof(struct epoll_node_s));
+        if (epn == NULL)
+          {
+            ret = -ENOMEM;
+            break;
+          }
+
+        epn->eph        = eph;
+        epn->ev         = *ev;
+        epn->pfd.fd     = fd;
+        epn->pfd.events = (ev->events & (POLLIN | POLLOUT)) |
+                          POLLERR | POLLHUP;
+        epn->pfd.sem    = &eph->sem;
+        epn->pfd.cb     = epoll_pollcb;
+        epn->pfd.arg    = epn;
+
+        ret = epoll_setup(epn, true);
+        if (ret < 0)
+          {
+            epoll_unready(eph, epn);
+            kmm_free(epn);
+            break;
+          }
+
+        dq_addlast(&epn->node, &eph->nodes);
+        break;
 
       case EPOLL_CTL_DEL:
-        {
-          int i;
+        finfo("%08x CTL DEL: fd=%d\n", epfd, fd);
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              if (eph->evs[i].data.fd == fd)
-                {
-                  if (i != eph->occupied - 1)
-                    {
-                      memmove(&eph->evs[i], &eph->evs[i + 1],
-                              eph->occupied - i);
-                    }
-
-                  eph->occupied--;
-                  return 0;
-                }
-            }
+        if (epn == NULL)
+          {
+            ret = -ENOENT;
+            break;
+          }
 
-          return -ENOENT;
-        }
+        ret = epoll_setup(epn, false);
+        epoll_unready(eph, epn);
+        dq_rem(&epn->node, &eph->nodes);
+        kmm_free(epn);
+        break;
 
       case EPOLL_CTL_MOD:
-        {
-          int i;
+        finfo("%08x CTL MOD: fd=%d ev=%08" PRIx32 "\n",
+              epfd, fd, ev->events);
 
-          finfo("%08x CTL MOD(%d): fd=%d ev=%08x\n",
-                epfd, eph->occupied, fd, ev->events);
+        if (epn == NULL)
+          {
+            ret = -ENOENT;
+            break;
+          }
 
-          for (i = 0; i < eph->occupied; i++)
-            {
-              if (eph->evs[i].data.fd == fd)
-                {
-                  eph->evs[i].events = ev->events | POLLERR | POLLHUP;
-                  return 0;
-                }
-            }
+        /* Set up the poll again with the new events.  This also re-arms a
+         * descriptor that was disabled by EPOLLONESHOT.
+         */
 
-          return -ENOENT;
-        }
+        epoll_setup(epn, false);
+        epoll_unready(eph, epn);
+
+        epn->ev         = *ev;
+        epn->pfd.events = (ev->events & (POLLIN | POLLOUT)) |
+                          POLLERR | POLLHUP;
+        epn->disabled   = false;
+
+        ret = epoll_setup(epn, true);
+        break;
+
+      default:
+        ret = -EINVAL;
+        break;
+    }
+
+  nxsem_post(&eph->lock);
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      return ERROR;
     }
 
-  return -EINVAL;
+  return OK;
 }
 
 /****************************************************************************
  * Name: epoll_wait
  *
  * Description:
+ *   Wait for events on the descriptors of an epoll instance.  Only the
+ *   descriptors in the ready list are visited.
+ *
+ *   By default, a descriptor is reported for as long as it is ready:  Its
+ *   poll is set up again on the next call so that the driver re-evaluates
+ *   its state.  With EPOLLET, it is reported only when its driver signals
+ *   new events and, with EPOLLONESHOT, only once until it is re-armed with
+ *   EPOLL_CTL_MOD.
  *
  * Input Parameters:
+ *   epfd      - The epoll instance
+ *   evs       - The location to return the events
+ *   maxevents - The maximum number of events to return
+ *   timeout   - The timeout in milliseconds.  A negative value means an
+ *               infinite timeout.
  *
  * Returned Value:
+ *   The number of events returned in evs; zero if the timeout expired.  On
+ *   failure, -1 is returned and errno is set appropriately.
  *
  ****************************************************************************/
 
 int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents,
                int timeout)
 {
-  /* REVISIT: This will not work on machines where:
-   * sizeof(struct epoll_head *) > sizeof(int)
-   */
+  FAR struct epoll_head_s *eph = epoll_head(epfd);
+  clock_t start;
+  clock_t ticks = 0;
+  int count;
+  int ret = OK;
+
+  if (evs == NULL || maxevents <= 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  if (timeout > 0)
+    {
+      /* Round timeout up to next full tick */
+
+#if (MSEC_PER_TICK * USEC_PER_MSEC) != USEC_PER_TICK && \
+    defined(CONFIG_HAVE_LONG_LONG)
+      ticks = (((unsigned long long)timeout * USEC_PER_MSEC) +
+               (USEC_PER_TICK - 1)) /
+              USEC_PER_TICK;
+#else
+      ticks = ((unsigned int)timeout + (MSEC_PER_TICK - 1)) /
+              MSEC_PER_TICK;
+#endif
+    }
+
+  start = clock_systime_ticks();
+
+  nxsem_wait_uninterruptible(&eph->lock);
 
-  FAR struct epoll_head *eph = (FAR struct epoll_head *)((intptr_t)epfd);
-  int counter;
-  int rc;
-  int i;
+  /* Re-evaluate the descriptors that were reported by the last call */
 
-  rc = poll((FAR struct pollfd *)eph->evs, eph->occupied, timeout);
+  epoll_rearm(eph);
 
-  if (rc <= 0)
+  for (; ; )
     {
-      if (rc < 0)
+      count = epoll_collect(eph, evs, maxevents);
+      if (count > 0 || timeout == 0)
+        {
+          break;
+        }
+
+      /* Wait for a node to become ready.  The semaphore may have been
+       * posted for nodes that were already collected, so check the ready
+       * list again after each wake-up.
+       */
+
+      nxsem_post(&eph->lock);
+
+      if (timeout > 0)
+        {
+          ret = nxsem_tickwait(&eph->sem, start, ticks);
+        }
+      else
+        {
+          ret = nxsem_wait(&eph->sem);
+        }
+
+      nxsem_wait_uninterruptible(&eph->lock);
+
+      if (ret < 0)
         {
-          ferr("ERROR: %08x poll fail: %d for %d, %d msecs\n",
-               epfd, rc, eph->occupied, timeout);
+          /* Return zero in the event of a timeout */
 
-          for (i = 0; i < eph->occupied; i++)
+          if (ret == -ETIMEDOUT)
             {
-              ferr("  %02d: fd=%d\n", i, eph->evs[i].data.fd);
+              ret = OK;
             }
-        }
 
-      return rc;
+          break;
+        }
     }
 
-  /* Iterate over non NULL event fds */
+  nxsem_post(&eph->lock);
 
-  for (i = 0, counter = 0; i < rc && counter < eph->size; counter++)
+  if (ret < 0)
     {
-      if (eph->evs[counter].revents != 0)
-        {
-          evs[i].data.fd = eph->evs[counter].data.fd;
-          evs[i].events  = eph->evs[counter].revents;
-          i += 1;
-        }
+      set_errno(-ret);
+      return ERROR;
     }
 
-  return i;
+  return count;
 }
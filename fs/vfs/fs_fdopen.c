@@ -226,6 +226,14 @@ FAR struct file_struct *fs_fdopen(int fd, int oflags, FAR struct tcb_s *tcb)
           nxsem_init(&stream->fs_sem, 0, 1);
 
 #if CONFIG_STDIO_BUFFER_SIZE > 0
+#ifdef CONFIG_STDIO_BUFFER_LAZY
+          /* Defer the allocation of the IO buffer until the stream is
+           * first read or written.  Streams that are never used, like
+           * stdin of many tasks, then do not cost any buffer memory.
+           */
+
+          stream->fs_flags  |= __FS_FLAG_LAZY;
+#else
           /* Allocate the IO buffer at the appropriate privilege level for
            * the group.
            */
@@ -244,6 +252,7 @@ FAR struct file_struct *fs_fdopen(int fd, int oflags, FAR struct tcb_s *tcb)
           stream->fs_bufend = &stream->fs_bufstart[CONFIG_STDIO_BUFFER_SIZE];
           stream->fs_bufpos = stream->fs_bufstart;
           stream->fs_bufread = stream->fs_bufstart;
+#endif /* CONFIG_STDIO_BUFFER_LAZY */
 
 #ifdef CONFIG_STDIO_LINEBUFFER
           /* Setup buffer flags */
@@ -270,7 +279,8 @@ FAR struct file_struct *fs_fdopen(int fd, int oflags, FAR struct tcb_s *tcb)
 
   errcode = ENFILE;
 
-#if !defined(CONFIG_STDIO_DISABLE_BUFFERING) && CONFIG_STDIO_BUFFER_SIZE > 0
+#if !defined(CONFIG_STDIO_DISABLE_BUFFERING) && \
+    CONFIG_STDIO_BUFFER_SIZE > 0 && !defined(CONFIG_STDIO_BUFFER_LAZY)
 errout_with_sem:
 #endif
   nxsem_post(&slist->sl_sem);
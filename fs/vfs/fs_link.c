@@ -165,6 +165,7 @@ int link(FAR const char *path1, FAR const char *path2)
 
       INODE_SET_SOFTLINK(inode);
       inode->u.i_link = newpath2;
+      inode_cacheinvalidate();
     }
 
   /* Symbolic link successfully created */
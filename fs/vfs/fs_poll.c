@@ -138,6 +138,7 @@ static inline int poll_setup(FAR struct pollfd *fds, nfds_t nfds,
       fds[i].sem     = sem;
       fds[i].revents = 0;
       fds[i].priv    = NULL;
+      fds[i].cb      = NULL;
 
       /* Check for invalid descriptors. "If the value of fd is less than 0,
        * events shall be ignored, and revents shall be set to 0 in that entry
@@ -347,7 +348,7 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
               fds->revents |= (fds->events & (POLLIN | POLLOUT));
               if (fds->revents != 0)
                 {
-                  nxsem_post(fds->sem);
+                  poll_notify(fds);
                 }
             }
 
@@ -397,6 +398,36 @@ int fs_poll(int fd, FAR struct pollfd *fds, bool setup)
   return file_poll(filep, fds, setup);
 }
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Report the events that a driver has set in fds->revents to the waiter:
+ *   The callback of the pollfd is called if one is provided (as it is for
+ *   epoll); otherwise the semaphore is posted.
+ *
+ * Input Parameters:
+ *   fds - The pollfd structure provided at poll setup time
+ *
+ * Assumptions:
+ *   May be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd *fds)
+{
+  DEBUGASSERT(fds != NULL);
+
+  if (fds->cb != NULL)
+    {
+      fds->cb(fds);
+    }
+  else
+    {
+      poll_semgive(fds->sem);
+    }
+}
+
 /****************************************************************************
  * Name: nx_poll
  *
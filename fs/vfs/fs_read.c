@@ -49,6 +49,7 @@
 
 #include <nuttx/cancelpt.h>
 #include <nuttx/net/net.h>
+#include <nuttx/sched_note.h>
 
 #include "inode/inode.h"
 
@@ -107,7 +108,9 @@ ssize_t file_read(FAR struct file *filep, FAR void *buf, size_t nbytes)
        * signature and position in the operations vtable.
        */
 
+      sched_trace_begin(NOTE_TRACE_FS, filep);
       ret = (int)inode->u.i_ops->read(filep, (FAR char *)buf, (size_t)nbytes);
+      sched_trace_end(NOTE_TRACE_FS, filep);
     }
 
   /* Return the number of bytes read (or possibly an error code) */
@@ -229,6 +229,9 @@ next_subdir:
   /* Copy the inode state from the old inode to the newly allocated inode */
 
   newinode->i_child   = oldinode->i_child;   /* Link to lower level inode */
+#ifdef CONFIG_PSEUDOFS_HASH
+  newinode->i_hash    = oldinode->i_hash;    /* Hash index of the children */
+#endif
   newinode->i_flags   = oldinode->i_flags;   /* Flags for inode */
   newinode->u.i_ops   = oldinode->u.i_ops;   /* Inode operations */
 #ifdef CONFIG_FILE_MODE
@@ -269,6 +272,9 @@ next_subdir:
   /* Remove all of the children from the unlinked inode */
 
   oldinode->i_child = NULL;
+#ifdef CONFIG_PSEUDOFS_HASH
+  oldinode->i_hash  = NULL;
+#endif
   ret = OK;
 
 errout_with_sem:
@@ -42,6 +42,7 @@
 #include <sys/select.h>
 #include <sys/time.h>
 
+#include <stdint.h>
 #include <string.h>
 #include <poll.h>
 #include <errno.h>
@@ -54,6 +55,52 @@
 
 #include "inode/inode.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Up to this many descriptors are polled from an array on the stack.  Only
+ * larger sets need the array to be allocated on each call.
+ */
+
+#define SELECT_NSTACKFDS 8
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: select_word
+ *
+ * Description:
+ *   Return the union of one word of the three sets of descriptors.  A zero
+ *   word lets 32 descriptors be skipped at once.
+ *
+ ****************************************************************************/
+
+static uint32_t select_word(FAR fd_set *readfds, FAR fd_set *writefds,
+                            FAR fd_set *exceptfds, int ndx)
+{
+  uint32_t word = 0;
+
+  if (readfds)
+    {
+      word |= readfds->arr[ndx];
+    }
+
+  if (writefds)
+    {
+      word |= writefds->arr[ndx];
+    }
+
+  if (exceptfds)
+    {
+      word |= exceptfds->arr[ndx];
+    }
+
+  return word;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -93,7 +140,12 @@
 int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
            FAR fd_set *exceptfds, FAR struct timeval *timeout)
 {
-  struct pollfd *pollset = NULL;
+  struct pollfd stackset[SELECT_NSTACKFDS];
+  FAR struct pollfd *pollset = stackset;
+  fd_set rset;
+  fd_set wset;
+  fd_set eset;
+  uint32_t word;
   int errcode = OK;
   int fd;
   int npfds;
@@ -105,17 +157,28 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
 
   enter_cancellation_point();
 
-  /* How many pollfd structures do we need to allocate? */
+  if (nfds < 0 || nfds > FD_SETSIZE)
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
 
-  /* Initialize the descriptor list for poll() */
+  /* How many pollfd structures do we need? */
 
   for (fd = 0, npfds = 0; fd < nfds; fd++)
     {
+      /* Skip the descriptors of a word that has none of them in any set */
+
+      word = select_word(readfds, writefds, exceptfds, _FD_NDX(fd));
+      if (word == 0)
+        {
+          fd |= 0x1f;
+          continue;
+        }
+
       /* Check if any monitor operation is requested on this fd */
 
-      if ((readfds   && FD_ISSET(fd, readfds))  ||
-          (writefds  && FD_ISSET(fd, writefds)) ||
-          (exceptfds && FD_ISSET(fd, exceptfds)))
+      if ((word & (1 << _FD_BIT(fd))) != 0)
         {
           /* Yes.. increment the count of pollfds structures needed */
 
@@ -123,9 +186,11 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
         }
     }
 
-  /* Allocate the descriptor list for poll() */
+  /* Allocate the descriptor list for poll() if it is too large for the
+   * stack.
+   */
 
-  if (npfds > 0)
+  if (npfds > SELECT_NSTACKFDS)
     {
       pollset = (FAR struct pollfd *)
         kmm_zalloc(npfds * sizeof(struct pollfd));
@@ -136,6 +201,10 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
           goto errout;
         }
     }
+  else
+    {
+      memset(stackset, 0, sizeof(stackset));
+    }
 
   /* Initialize the descriptor list for poll() */
 
@@ -143,6 +212,13 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
     {
       int incr = 0;
 
+      word = select_word(readfds, writefds, exceptfds, _FD_NDX(fd));
+      if (word == 0)
+        {
+          fd |= 0x1f;
+          continue;
+        }
+
       /* The readfs set holds the set of FDs that the caller can be assured
        * of reading from without blocking.  Note that POLLHUP is included as
        * a read-able condition.  POLLHUP will be reported at the end-of-file
@@ -196,80 +272,87 @@ int select(int nfds, FAR fd_set *readfds, FAR fd_set *writefds,
       msec = -1;
     }
 
-  /* Then let poll do all of the real work. */
+  /* Then let poll do all of the real work.  nx_poll() is used because this
+   * already is the cancellation point.
+   */
 
-  ret = poll(pollset, npfds, msec);
+  ret = nx_poll(pollset, npfds, msec);
   if (ret < 0)
     {
       /* poll() failed! Save the errno value */
 
-      errcode = get_errno();
-    }
-
-  /* Now set up the return values */
-
-  if (readfds)
-    {
-      memset(readfds, 0, sizeof(fd_set));
+      errcode = -ret;
     }
 
-  if (writefds)
-    {
-      memset(writefds, 0, sizeof(fd_set));
-    }
-
-  if (exceptfds)
-    {
-      memset(exceptfds, 0, sizeof(fd_set));
-    }
+  /* Convert the poll descriptor list back into selects 3 bitsets.  A
+   * descriptor is only reported in the sets that it was requested in.
+   */
 
-  /* Convert the poll descriptor list back into selects 3 bitsets */
+  FD_ZERO(&rset);
+  FD_ZERO(&wset);
+  FD_ZERO(&eset);
 
   if (ret > 0)
     {
       ret = 0;
       for (ndx = 0; ndx < npfds; ndx++)
         {
+          fd = pollset[ndx].fd;
+
           /* Check for read conditions.  Note that POLLHUP is included as a
            * read condition.  POLLHUP will be reported when no more data will
            * be available (such as when a connection is lost).  In either
            * case, the read() can then be performed without blocking.
            */
 
-          if (readfds)
+          if (readfds && FD_ISSET(fd, readfds) &&
+              (pollset[ndx].revents & (POLLIN | POLLHUP)) != 0)
             {
-              if (pollset[ndx].revents & (POLLIN | POLLHUP))
-                {
-                  FD_SET(pollset[ndx].fd, readfds);
-                  ret++;
-                }
+              FD_SET(fd, &rset);
+              ret++;
             }
 
           /* Check for write conditions */
 
-          if (writefds)
+          if (writefds && FD_ISSET(fd, writefds) &&
+              (pollset[ndx].revents & POLLOUT) != 0)
             {
-              if (pollset[ndx].revents & POLLOUT)
-                {
-                  FD_SET(pollset[ndx].fd, writefds);
-                  ret++;
-                }
+              FD_SET(fd, &wset);
+              ret++;
             }
 
           /* Check for exceptions */
 
-          if (exceptfds)
+          if (exceptfds && FD_ISSET(fd, exceptfds) &&
+              (pollset[ndx].revents & POLLERR) != 0)
             {
-              if (pollset[ndx].revents & POLLERR)
-                {
-                  FD_SET(pollset[ndx].fd, exceptfds);
-                  ret++;
-                }
+              FD_SET(fd, &eset);
+              ret++;
             }
         }
     }
 
-  kmm_free(pollset);
+  /* Now set up the return values */
+
+  if (readfds)
+    {
+      memcpy(readfds, &rset, sizeof(fd_set));
+    }
+
+  if (writefds)
+    {
+      memcpy(writefds, &wset, sizeof(fd_set));
+    }
+
+  if (exceptfds)
+    {
+      memcpy(exceptfds, &eset, sizeof(fd_set));
+    }
+
+  if (pollset != stackset)
+    {
+      kmm_free(pollset);
+    }
 
   /* Did poll() fail above? */
 
@@ -0,0 +1,544 @@
+/****************************************************************************
+ * fs/vfs/fs_uio.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "inode/inode.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: iov_check
+ *
+ * Description:
+ *   Verify an array of I/O vectors.  The sum of the lengths must be
+ *   representable as the return value of readv() and writev().
+ *
+ * Returned Value:
+ *   The sum of the lengths or -EINVAL.
+ *
+ ****************************************************************************/
+
+static ssize_t iov_check(FAR const struct iovec *iov, int iovcnt)
+{
+  size_t total = 0;
+  int i;
+
+  if (iov == NULL || iovcnt <= 0 || iovcnt > IOV_MAX)
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len > SSIZE_MAX - total)
+        {
+          return -EINVAL;
+        }
+
+      total += iov[i].iov_len;
+    }
+
+  return (ssize_t)total;
+}
+
+#ifdef CONFIG_NET
+/****************************************************************************
+ * Name: sock_readv
+ *
+ * Description:
+ *   Receive into the I/O vectors from a socket.  A stream is received into
+ *   each vector in turn; only the first reception may wait and one that
+ *   does not fill its buffer ends the transfer.  A datagram must be taken
+ *   at once, so it is received into a temporary buffer and scattered.
+ *
+ ****************************************************************************/
+
+static ssize_t sock_readv(int sockfd, FAR const struct iovec *iov,
+                          int iovcnt, size_t total)
+{
+  FAR struct socket *psock;
+  FAR uint8_t *buffer;
+  ssize_t ntotal = 0;
+  ssize_t nread = 0;
+  size_t ncopy;
+  int i;
+
+  psock = sockfd_socket(sockfd);
+  if (psock == NULL)
+    {
+      return -EBADF;
+    }
+
+  if (psock->s_type != SOCK_STREAM && iovcnt > 1 && total > 0)
+    {
+      buffer = (FAR uint8_t *)kmm_malloc(total);
+      if (buffer == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      nread = psock_recv(psock, buffer, total, 0);
+      for (i = 0; i < iovcnt && ntotal < nread; i++)
+        {
+          ncopy = iov[i].iov_len;
+          if (ncopy > (size_t)(nread - ntotal))
+            {
+              ncopy = (size_t)(nread - ntotal);
+            }
+
+          memcpy(iov[i].iov_base, buffer + ntotal, ncopy);
+          ntotal += ncopy;
+        }
+
+      kmm_free(buffer);
+      return nread;
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      nread = psock_recv(psock, iov[i].iov_base, iov[i].iov_len,
+                         ntotal > 0 ? MSG_DONTWAIT : 0);
+      if (nread <= 0)
+        {
+          break;
+        }
+
+      ntotal += nread;
+      if ((size_t)nread < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  return ntotal > 0 ? ntotal : nread;
+}
+#endif
+
+#ifdef CONFIG_NET_TCP
+/****************************************************************************
+ * Name: sock_writev
+ *
+ * Description:
+ *   Send the I/O vectors to a socket.  The vectors of a stream are sent in
+ *   turn with the network locked, so that all of the data is queued before
+ *   the device gets the chance to poll for it.  A datagram must be sent at
+ *   once, so it is gathered into a temporary buffer first.
+ *
+ ****************************************************************************/
+
+static ssize_t sock_writev(int sockfd, FAR const struct iovec *iov,
+                           int iovcnt, size_t total)
+{
+  FAR struct socket *psock;
+  FAR uint8_t *buffer;
+  ssize_t ntotal = 0;
+  ssize_t nwritten = 0;
+  int i;
+
+  psock = sockfd_socket(sockfd);
+  if (psock == NULL)
+    {
+      return -EBADF;
+    }
+
+  if (psock->s_type != SOCK_STREAM && iovcnt > 1 && total > 0)
+    {
+      buffer = (FAR uint8_t *)kmm_malloc(total);
+      if (buffer == NULL)
+        {
+          return -ENOMEM;
+        }
+
+      for (i = 0; i < iovcnt; i++)
+        {
+          memcpy(buffer + ntotal, iov[i].iov_base, iov[i].iov_len);
+          ntotal += iov[i].iov_len;
+        }
+
+      nwritten = psock_send(psock, buffer, total, 0);
+      kmm_free(buffer);
+      return nwritten;
+    }
+
+  net_lock();
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      nwritten = psock_send(psock, iov[i].iov_base, iov[i].iov_len, 0);
+      if (nwritten <= 0)
+        {
+          break;
+        }
+
+      ntotal += nwritten;
+      if ((size_t)nwritten < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  net_unlock();
+  return ntotal > 0 ? ntotal : nwritten;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_readv
+ *
+ * Description:
+ *   Equivalent to the standard readv() function except that is accepts a
+ *   struct file instance instead of a file descriptor.  It does not modify
+ *   the errno variable and it is not a cancellation point.
+ *
+ *   The buffers are filled in order.  A read that does not fill its buffer
+ *   (an end-of-file or no more data available from a device) ends the
+ *   transfer.  An error after some data was read returns the amount read.
+ *
+ * Input Parameters:
+ *   filep  - File structure instance
+ *   iov    - Array of read buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   The number of bytes read, 0 on an end-of-file condition, or a negated
+ *   errno value on any failure.
+ *
+ ****************************************************************************/
+
+ssize_t file_readv(FAR struct file *filep, FAR const struct iovec *iov,
+                   int iovcnt)
+{
+  ssize_t ntotal = 0;
+  ssize_t nread;
+  int i;
+
+  nread = iov_check(iov, iovcnt);
+  if (nread < 0)
+    {
+      return nread;
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      nread = file_read(filep, iov[i].iov_base, iov[i].iov_len);
+      if (nread <= 0)
+        {
+          break;
+        }
+
+      ntotal += nread;
+      if ((size_t)nread < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  return ntotal > 0 ? ntotal : nread;
+}
+
+/****************************************************************************
+ * Name: file_writev
+ *
+ * Description:
+ *   Equivalent to the standard writev() function except that is accepts a
+ *   struct file instance instead of a file descriptor.  It does not modify
+ *   the errno variable and it is not a cancellation point.
+ *
+ *   The buffers are written in order.  A partial write ends the transfer.
+ *   An error after some data was written returns the amount written.
+ *
+ * Input Parameters:
+ *   filep  - File structure instance
+ *   iov    - Array of write buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   The number of bytes written or a negated errno value on any failure.
+ *
+ ****************************************************************************/
+
+ssize_t file_writev(FAR struct file *filep, FAR const struct iovec *iov,
+                    int iovcnt)
+{
+  ssize_t ntotal = 0;
+  ssize_t nwritten;
+  int i;
+
+  nwritten = iov_check(iov, iovcnt);
+  if (nwritten < 0)
+    {
+      return nwritten;
+    }
+
+  for (i = 0; i < iovcnt; i++)
+    {
+      if (iov[i].iov_len == 0)
+        {
+          continue;
+        }
+
+      nwritten = file_write(filep, iov[i].iov_base, iov[i].iov_len);
+      if (nwritten <= 0)
+        {
+          break;
+        }
+
+      ntotal += nwritten;
+      if ((size_t)nwritten < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  return ntotal > 0 ? ntotal : nwritten;
+}
+
+/****************************************************************************
+ * Name: nx_readv
+ *
+ * Description:
+ *   nx_readv() is an internal OS interface.  It is functionally similar to
+ *   the standard readv() interface except:
+ *
+ *    - It does not modify the errno variable, and
+ *    - It is not a cancellation point.
+ *
+ * Input Parameters:
+ *   fd     - File (or socket) descriptor to read from
+ *   iov    - Array of read buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   The number of bytes read, 0 on an end-of-file condition, or a negated
+ *   errno value on any failure.
+ *
+ ****************************************************************************/
+
+ssize_t nx_readv(int fd, FAR const struct iovec *iov, int iovcnt)
+{
+  FAR struct file *filep;
+  ssize_t ret;
+
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+#ifdef CONFIG_NET
+      /* Reading from a socket descriptor is equivalent to recv() */
+
+      ret = iov_check(iov, iovcnt);
+      if (ret >= 0)
+        {
+          ret = sock_readv(fd, iov, iovcnt, (size_t)ret);
+        }
+
+      return ret;
+#else
+      return -EBADF;
+#endif
+    }
+
+  ret = (ssize_t)fs_getfilep(fd, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return file_readv(filep, iov, iovcnt);
+}
+
+/****************************************************************************
+ * Name: nx_writev
+ *
+ * Description:
+ *   nx_writev() is an internal OS interface.  It is functionally similar to
+ *   the standard writev() interface except:
+ *
+ *    - It does not modify the errno variable, and
+ *    - It is not a cancellation point.
+ *
+ * Input Parameters:
+ *   fd     - File (or socket) descriptor to write to
+ *   iov    - Array of write buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   The number of bytes written or a negated errno value on any failure.
+ *
+ ****************************************************************************/
+
+ssize_t nx_writev(int fd, FAR const struct iovec *iov, int iovcnt)
+{
+  FAR struct file *filep;
+  ssize_t ret;
+
+  if ((unsigned int)fd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+#ifdef CONFIG_NET_TCP
+      /* Writing to a socket descriptor is equivalent to send() */
+
+      ret = iov_check(iov, iovcnt);
+      if (ret >= 0)
+        {
+          ret = sock_writev(fd, iov, iovcnt, (size_t)ret);
+        }
+
+      return ret;
+#else
+      return -EBADF;
+#endif
+    }
+
+  ret = (ssize_t)fs_getfilep(fd, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return file_writev(filep, iov, iovcnt);
+}
+
+/****************************************************************************
+ * Name: readv
+ *
+ * Description:
+ *   The readv() function is equivalent to read(), except as described below.
+ *   The readv() function places the input data into the 'iovcnt' buffers
+ *   specified by the members of the 'iov' array: iov[0], iov[1], ...,
+ *   iov[iovcnt-1].  The 'iovcnt' argument is valid if greater than 0 and
+ *   less than or equal to IOV_MAX as defined in limits.h.
+ *
+ *   The whole vector is handled with one system call and one look-up of
+ *   the descriptor.
+ *
+ * Input Parameters:
+ *   fildes - The open file descriptor for the file to be read
+ *   iov    - Array of read buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   Upon successful completion, readv() will return a non-negative integer
+ *   indicating the number of bytes actually read.  Otherwise, the functions
+ *   will return -1 and set errno to indicate the error.  In addition to the
+ *   errors of read(), readv() will fail with EINVAL if the sum of the
+ *   iov_len values overflows an ssize_t or if 'iovcnt' is out of range.
+ *
+ ****************************************************************************/
+
+ssize_t readv(int fildes, FAR const struct iovec *iov, int iovcnt)
+{
+  ssize_t ret;
+
+  /* readv() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = nx_readv(fildes, iov, iovcnt);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: writev
+ *
+ * Description:
+ *   The writev() function is equivalent to write(), except as described
+ *   below.  The writev() function will gather output data from the 'iovcnt'
+ *   buffers specified by the members of the 'iov' array: iov[0], iov[1],
+ *   ..., iov[iovcnt-1].  The 'iovcnt' argument is valid if greater than 0
+ *   and less than or equal to IOV_MAX, as defined in limits.h.
+ *
+ *   The whole vector is handled with one system call and one look-up of
+ *   the descriptor.
+ *
+ * Input Parameters:
+ *   fildes - The open file descriptor for the file to be written
+ *   iov    - Array of write buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   Upon successful completion, writev() shall return the number of bytes
+ *   actually written.  Otherwise, it shall return a value of -1 and errno
+ *   shall be set to indicate an error.  In addition to the errors of
+ *   write(), writev() will fail with EINVAL if the sum of the iov_len
+ *   values overflows an ssize_t or if 'iovcnt' is out of range.
+ *
+ ****************************************************************************/
+
+ssize_t writev(int fildes, FAR const struct iovec *iov, int iovcnt)
+{
+  ssize_t ret;
+
+  /* writev() is a cancellation point */
+
+  enter_cancellation_point();
+
+  ret = nx_writev(fildes, iov, iovcnt);
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
@@ -53,6 +53,7 @@
 
 #include <nuttx/cancelpt.h>
 #include <nuttx/net/net.h>
+#include <nuttx/sched_note.h>
 
 #include "inode/inode.h"
 
@@ -89,6 +90,7 @@
 ssize_t file_write(FAR struct file *filep, FAR const void *buf, size_t nbytes)
 {
   FAR struct inode *inode;
+  ssize_t ret;
 
   /* Was this file opened for write access? */
 
@@ -107,7 +109,11 @@ ssize_t file_write(FAR struct file *filep, FAR const void *buf, size_t nbytes)
 
   /* Yes, then let the driver perform the write */
 
-  return inode->u.i_ops->write(filep, buf, nbytes);
+  sched_trace_begin(NOTE_TRACE_FS, filep);
+  ret = inode->u.i_ops->write(filep, buf, nbytes);
+  sched_trace_end(NOTE_TRACE_FS, filep);
+
+  return ret;
 }
 
 /****************************************************************************
@@ -190,6 +190,23 @@ struct nxbe_plane_s
   /* Framebuffer plane info describing destination video plane */
 
   NX_PLANEINFOTYPE pinfo;
+
+#ifdef CONFIG_NX_ACCEL
+  /* The framebuffer driver with the 2D accelerator, the number of the
+   * plane in the driver and the format of its pixels.
+   */
+
+  FAR struct fb_vtable_s *accel;
+  uint8_t planeno;
+  uint8_t fmt;
+#endif
+
+#ifdef CONFIG_NX_UPDATE_DEFER
+  /* The regions updated since the last nxbe_damage_flush() */
+
+  uint8_t ndamage;
+  struct nxgl_rect_s damage[CONFIG_NX_UPDATE_NRECTS];
+#endif
 };
 
 /* Clipping *****************************************************************/
@@ -727,6 +744,78 @@ void nxbe_flush(FAR struct nxbe_window_s *wnd,
                  unsigned int stride);
 #endif
 
+/****************************************************************************
+ * Name: nxbe_notify_rectangle
+ *
+ * Description:
+ *   Report that a region of a plane was updated.  With
+ *   CONFIG_NX_UPDATE_DEFER, the region is merged into the damage of the
+ *   plane and reported to nx_notify_rectangle() by the next
+ *   nxbe_damage_flush().  Otherwise, it is reported now.
+ *
+ * Input Parameters:
+ *   plane - The plane that was updated
+ *   rect  - The updated region (device coordinates)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_UPDATE
+void nxbe_notify_rectangle(FAR struct nxbe_plane_s *plane,
+                           FAR const struct nxgl_rect_s *rect);
+#endif
+
+/****************************************************************************
+ * Name: nxbe_damage_flush
+ *
+ * Description:
+ *   Report the damage accumulated on all planes to nx_notify_rectangle(),
+ *   one call for each merged region, and clear it.  The NX server calls
+ *   this when it has no more messages to process.
+ *
+ * Input Parameters:
+ *   be - The back-end state structure instance
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_UPDATE_DEFER
+void nxbe_damage_flush(FAR struct nxbe_state_s *be);
+#endif
+
+/****************************************************************************
+ * Name: nxbe_accel_fill, nxbe_accel_move and nxbe_accel_copy
+ *
+ * Description:
+ *   Fill, move or copy a rectangle of a plane with the 2D accelerator of
+ *   the framebuffer driver.  The parameters are those of the
+ *   fillrectangle(), moverectangle() and copyrectangle() methods of
+ *   struct nxbe_dev_vtable_s.
+ *
+ * Returned Value:
+ *   Zero (OK) if the operation was performed; a negated errno value if it
+ *   must be performed by the CPU rasterizer.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_ACCEL
+int nxbe_accel_fill(FAR struct nxbe_plane_s *plane,
+                    FAR const struct nxgl_rect_s *rect,
+                    nxgl_mxpixel_t color);
+int nxbe_accel_move(FAR struct nxbe_plane_s *plane,
+                    FAR const struct nxgl_rect_s *rect,
+                    FAR const struct nxgl_point_s *offset);
+int nxbe_accel_copy(FAR struct nxbe_plane_s *plane,
+                    FAR const struct nxgl_rect_s *dest,
+                    FAR const void *src,
+                    FAR const struct nxgl_point_s *origin,
+                    unsigned int stride);
+#endif
+
 /****************************************************************************
  * Name: nxbe_redraw
  *
@@ -0,0 +1,182 @@
+/****************************************************************************
+ * graphics/nxbe/nxbe_accel.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/video/fb.h>
+#include <nuttx/nx/nxglib.h>
+
+#include "nxbe.h"
+
+#ifdef CONFIG_NX_ACCEL
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_accel_area
+ *
+ * Description:
+ *   Convert a rectangle to the area of the framebuffer interface.
+ *
+ ****************************************************************************/
+
+static void nxbe_accel_area(FAR struct fb_area_s *area,
+                            FAR const struct nxgl_rect_s *rect)
+{
+  area->x = rect->pt1.x;
+  area->y = rect->pt1.y;
+  area->w = rect->pt2.x - rect->pt1.x + 1;
+  area->h = rect->pt2.y - rect->pt1.y + 1;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_accel_fill
+ *
+ * Description:
+ *   Fill a rectangle of a plane with the 2D accelerator of the framebuffer
+ *   driver.
+ *
+ * Input Parameters:
+ *   plane - The plane to draw to
+ *   rect  - The rectangle to fill (device coordinates)
+ *   color - The color in the format of the plane
+ *
+ * Returned Value:
+ *   Zero (OK) if the rectangle was filled; a negated errno value if it
+ *   must be filled by the CPU.
+ *
+ ****************************************************************************/
+
+int nxbe_accel_fill(FAR struct nxbe_plane_s *plane,
+                    FAR const struct nxgl_rect_s *rect,
+                    nxgl_mxpixel_t color)
+{
+  FAR struct fb_vtable_s *dev = plane->accel;
+  struct fb_area_s area;
+
+  if (dev == NULL || dev->fillarea == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  nxbe_accel_area(&area, rect);
+  return dev->fillarea(dev, plane->planeno, &area, color);
+}
+
+/****************************************************************************
+ * Name: nxbe_accel_move
+ *
+ * Description:
+ *   Move a rectangle of a plane with the 2D accelerator of the framebuffer
+ *   driver.
+ *
+ * Input Parameters:
+ *   plane  - The plane to draw to
+ *   rect   - The rectangle to move (device coordinates)
+ *   offset - The new position of the upper, left corner of the rectangle
+ *
+ * Returned Value:
+ *   Zero (OK) if the rectangle was moved; a negated errno value if it
+ *   must be moved by the CPU.
+ *
+ ****************************************************************************/
+
+int nxbe_accel_move(FAR struct nxbe_plane_s *plane,
+                    FAR const struct nxgl_rect_s *rect,
+                    FAR const struct nxgl_point_s *offset)
+{
+  FAR struct fb_vtable_s *dev = plane->accel;
+  struct fb_area_s area;
+
+  if (dev == NULL || dev->movearea == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  nxbe_accel_area(&area, rect);
+  return dev->movearea(dev, plane->planeno, &area, offset->x, offset->y);
+}
+
+/****************************************************************************
+ * Name: nxbe_accel_copy
+ *
+ * Description:
+ *   Copy a rectangular region of an image in memory to a plane with the 2D
+ *   accelerator of the framebuffer driver.  The image has the format of
+ *   the plane.
+ *
+ * Input Parameters:
+ *   plane  - The plane to draw to
+ *   dest   - The rectangle to copy to (device coordinates)
+ *   src    - The start of the source image
+ *   origin - The position of the upper, left corner of the image (device
+ *            coordinates)
+ *   stride - The length of a line of the image in bytes
+ *
+ * Returned Value:
+ *   Zero (OK) if the region was copied; a negated errno value if it must
+ *   be copied by the CPU.
+ *
+ ****************************************************************************/
+
+int nxbe_accel_copy(FAR struct nxbe_plane_s *plane,
+                    FAR const struct nxgl_rect_s *dest,
+                    FAR const void *src,
+                    FAR const struct nxgl_point_s *origin,
+                    unsigned int stride)
+{
+  FAR struct fb_vtable_s *dev = plane->accel;
+  struct fb_copyarea_s copy;
+  unsigned int bpp = plane->pinfo.bpp;
+
+  /* Sub-byte pixels do not start on a byte boundary in general */
+
+  if (dev == NULL || dev->copyarea == NULL || bpp < 8 ||
+      stride > UINT16_MAX)
+    {
+      return -ENOSYS;
+    }
+
+  copy.src    = (FAR const uint8_t *)src +
+                (dest->pt1.y - origin->y) * stride +
+                (dest->pt1.x - origin->x) * (bpp >> 3);
+  copy.stride = stride;
+  copy.fmt    = plane->fmt;
+  copy.alpha  = 255;
+  nxbe_accel_area(&copy.dest, dest);
+
+  return dev->copyarea(dev, plane->planeno, &copy);
+}
+
+#endif /* CONFIG_NX_ACCEL */
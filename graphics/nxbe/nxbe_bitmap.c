@@ -80,13 +80,19 @@ static void bitmap_clipcopy(FAR struct nxbe_clipops_s *cops,
 
   /* Copy the rectangular region to the graphics device. */
 
-  plane->dev.copyrectangle(&plane->pinfo, rect, bminfo->src,
-                           &bminfo->origin, bminfo->stride);
+#ifdef CONFIG_NX_ACCEL
+  if (nxbe_accel_copy(plane, rect, bminfo->src, &bminfo->origin,
+                      bminfo->stride) < 0)
+#endif
+    {
+      plane->dev.copyrectangle(&plane->pinfo, rect, bminfo->src,
+                               &bminfo->origin, bminfo->stride);
+    }
 
 #ifdef CONFIG_NX_UPDATE
   /* Notify external logic that the display has been updated */
 
-  nx_notify_rectangle(&plane->pinfo, rect);
+  nxbe_notify_rectangle(plane, rect);
 #endif
 }
 
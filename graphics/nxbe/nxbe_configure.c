@@ -125,6 +125,14 @@ int nxbe_configure(FAR NX_DRIVERTYPE *dev, FAR struct nxbe_state_s *be)
           return ret;
         }
 
+#ifdef CONFIG_NX_ACCEL
+      /* Let the driver draw what its 2D accelerator can */
+
+      be->plane[i].accel   = dev;
+      be->plane[i].planeno = i;
+      be->plane[i].fmt     = be->vinfo.fmt;
+#endif
+
       /* Select rasterizers to match the BPP reported for this plane.
        * NOTE that there are configuration options to eliminate support
        * for unused BPP values.  If the unused BPP values are not suppressed
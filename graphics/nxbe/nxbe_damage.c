@@ -0,0 +1,195 @@
+/****************************************************************************
+ * graphics/nxbe/nxbe_damage.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <assert.h>
+
+#include <nuttx/nx/nxglib.h>
+#include <nuttx/nx/nx.h>
+
+#include "nxbe.h"
+
+#ifdef CONFIG_NX_UPDATE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_rectarea
+ *
+ * Description:
+ *   Return the number of pixels in a rectangle.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_UPDATE_DEFER
+static uint32_t nxbe_rectarea(FAR const struct nxgl_rect_s *rect)
+{
+  return (uint32_t)(rect->pt2.x - rect->pt1.x + 1) *
+         (uint32_t)(rect->pt2.y - rect->pt1.y + 1);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_notify_rectangle
+ *
+ * Description:
+ *   Report that a region of a plane was updated.  With
+ *   CONFIG_NX_UPDATE_DEFER, the region is merged into the damage of the
+ *   plane and reported to nx_notify_rectangle() by the next
+ *   nxbe_damage_flush().  Otherwise, it is reported now.
+ *
+ * Input Parameters:
+ *   plane - The plane that was updated
+ *   rect  - The updated region (device coordinates)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_notify_rectangle(FAR struct nxbe_plane_s *plane,
+                           FAR const struct nxgl_rect_s *rect)
+{
+#ifdef CONFIG_NX_UPDATE_DEFER
+  struct nxgl_rect_s region;
+  struct nxgl_rect_s merged;
+  uint32_t growth;
+  uint32_t best;
+  int besti;
+  int i;
+
+  DEBUGASSERT(plane != NULL && rect != NULL);
+
+  if (nxgl_nullrect(rect))
+    {
+      return;
+    }
+
+  /* Merge the region with every accumulated region where the merged one
+   * has no more pixels than the two taken separately, i.e. with the
+   * regions that overlap it or continue it.  The merged region may now
+   * qualify for a merge with another one:  Start over.
+   */
+
+  nxgl_rectcopy(&region, rect);
+  for (i = 0; i < plane->ndamage; )
+    {
+      nxgl_rectunion(&merged, &region, &plane->damage[i]);
+      if (nxbe_rectarea(&merged) <= nxbe_rectarea(&region) +
+                                    nxbe_rectarea(&plane->damage[i]))
+        {
+          nxgl_rectcopy(&region, &merged);
+
+          /* Remove the region that was merged */
+
+          plane->ndamage--;
+          nxgl_rectcopy(&plane->damage[i], &plane->damage[plane->ndamage]);
+          i = 0;
+        }
+      else
+        {
+          i++;
+        }
+    }
+
+  if (plane->ndamage < CONFIG_NX_UPDATE_NRECTS)
+    {
+      nxgl_rectcopy(&plane->damage[plane->ndamage], &region);
+      plane->ndamage++;
+      return;
+    }
+
+  /* No room left:  Merge with the region that grows the least */
+
+  besti = 0;
+  best  = UINT32_MAX;
+
+  for (i = 0; i < plane->ndamage; i++)
+    {
+      nxgl_rectunion(&merged, &region, &plane->damage[i]);
+      growth = nxbe_rectarea(&merged) - nxbe_rectarea(&plane->damage[i]);
+      if (growth < best)
+        {
+          best  = growth;
+          besti = i;
+        }
+    }
+
+  nxgl_rectunion(&plane->damage[besti], &region, &plane->damage[besti]);
+#else
+  nx_notify_rectangle(&plane->pinfo, rect);
+#endif
+}
+
+/****************************************************************************
+ * Name: nxbe_damage_flush
+ *
+ * Description:
+ *   Report the damage accumulated on all planes to nx_notify_rectangle(),
+ *   one call for each merged region, and clear it.  The NX server calls
+ *   this when it has no more messages to process.
+ *
+ * Input Parameters:
+ *   be - The back-end state structure instance
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_UPDATE_DEFER
+void nxbe_damage_flush(FAR struct nxbe_state_s *be)
+{
+  FAR struct nxbe_plane_s *plane;
+  int i;
+  int j;
+
+  DEBUGASSERT(be != NULL);
+
+#if CONFIG_NX_NPLANES > 1
+  for (i = 0; i < be->vinfo.nplanes; i++)
+#else
+  i = 0;
+#endif
+    {
+      plane = &be->plane[i];
+      for (j = 0; j < plane->ndamage; j++)
+        {
+          nx_notify_rectangle(&plane->pinfo, &plane->damage[j]);
+        }
+
+      plane->ndamage = 0;
+    }
+}
+#endif
+
+#endif /* CONFIG_NX_UPDATE */
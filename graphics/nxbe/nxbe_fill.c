@@ -78,12 +78,17 @@ static void nxbe_clipfill(FAR struct nxbe_clipops_s *cops,
 
   /* Draw the rectangle to the graphics device. */
 
-  plane->dev.fillrectangle(&plane->pinfo, rect, fillinfo->color);
+#ifdef CONFIG_NX_ACCEL
+  if (nxbe_accel_fill(plane, rect, fillinfo->color) < 0)
+#endif
+    {
+      plane->dev.fillrectangle(&plane->pinfo, rect, fillinfo->color);
+    }
 
 #ifdef CONFIG_NX_UPDATE
   /* Notify external logic that the display has been updated */
 
-  nx_notify_rectangle(&plane->pinfo, rect);
+  nxbe_notify_rectangle(plane, rect);
 #endif
 }
 
@@ -94,7 +94,12 @@ static void nxbe_clipmovesrc(FAR struct nxbe_clipops_s *cops,
 
       /* Move the source rectangle to the destination position in the device */
 
-      plane->dev.moverectangle(&plane->pinfo, rect, &offset);
+#ifdef CONFIG_NX_ACCEL
+      if (nxbe_accel_move(plane, rect, &offset) < 0)
+#endif
+        {
+          plane->dev.moverectangle(&plane->pinfo, rect, &offset);
+        }
 
 #ifdef CONFIG_NX_UPDATE
       /* Move the source rectangle back to window relative coordinates and
@@ -109,7 +114,7 @@ static void nxbe_clipmovesrc(FAR struct nxbe_clipops_s *cops,
        * rectangle has changed.
        */
 
-      nx_notify_rectangle(&plane->pinfo, &update);
+      nxbe_notify_rectangle(plane, &update);
 #endif
     }
 }
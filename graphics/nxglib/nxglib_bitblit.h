@@ -43,6 +43,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <string.h>
 
 #include <nuttx/nx/nxglib.h>
 
@@ -187,26 +188,22 @@
 #endif /* CONFIG_NX_ANTIALIASING */
 #else /* NXGLIB_BITSPERPIXEL == 16 || NXGLIB_BITSPERPIXEL == 32 */
 
+/* Runs of 16- and 32-bit pixels are filled a word at a time.  Rows are
+ * copied with memmove():  The C library copies whole words and the source
+ * and destination rows overlap when a rectangle is moved horizontally.
+ */
+
+#if NXGLIB_BITSPERPIXEL == 8
 #  define NXGL_MEMSET(dest,value,width) \
-   { \
-     FAR NXGL_PIXEL_T *_ptr = (FAR NXGL_PIXEL_T*)(dest); \
-     nxgl_coord_t     _npix = (width); \
-     while (_npix--) \
-       { \
-         *_ptr++ = (value); \
-       } \
-   }
+   memset((dest), (value), (width))
+#else
+#  define NXGL_MEMSET(dest,value,width) \
+   NXGL_FUNCNAME(nxgl_wordfill,NXGLIB_BITSPERPIXEL) \
+     ((FAR NXGL_PIXEL_T *)(dest), (NXGL_PIXEL_T)(value), (width))
+#endif
 
 #  define NXGL_MEMCPY(dest,src,width) \
-   { \
-     FAR NXGL_PIXEL_T *_dptr = (FAR NXGL_PIXEL_T*)(dest); \
-     FAR NXGL_PIXEL_T *_sptr = (FAR NXGL_PIXEL_T*)(src); \
-     nxgl_coord_t      _npix = (width); \
-     while (_npix--) \
-       { \
-         *_dptr++ = *_sptr++; \
-       } \
-   }
+   memmove((dest), (src), NXGL_SCALEX(width))
 
 #ifdef CONFIG_NX_ANTIALIASING
 
@@ -225,6 +222,76 @@
 #define _NXGL_FUNCNAME(a,b) a ## b
 #define NXGL_FUNCNAME(a,b)  _NXGL_FUNCNAME(a,b)
 
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxgl_wordfill16 and nxgl_wordfill32
+ *
+ * Description:
+ *   Fill a run of 16- or 32-bit pixels.  After (at most) one pixel to align
+ *   the destination, two 16-bit pixels are written with each 32-bit store.
+ *   The loop is unrolled so that the compiler may combine the stores.
+ *
+ ****************************************************************************/
+
+#if NXGLIB_BITSPERPIXEL == 16
+static inline void nxgl_wordfill16(FAR uint16_t *dest, uint16_t color,
+                                   size_t npixels)
+{
+  FAR uint32_t *wdest;
+  uint32_t wide;
+
+  if (npixels > 0 && ((uintptr_t)dest & 3) != 0)
+    {
+      *dest++ = color;
+      npixels--;
+    }
+
+  wide  = (uint32_t)color << 16 | color;
+  wdest = (FAR uint32_t *)dest;
+
+  for (; npixels >= 8; npixels -= 8)
+    {
+      wdest[0] = wide;
+      wdest[1] = wide;
+      wdest[2] = wide;
+      wdest[3] = wide;
+      wdest   += 4;
+    }
+
+  for (; npixels >= 2; npixels -= 2)
+    {
+      *wdest++ = wide;
+    }
+
+  if (npixels > 0)
+    {
+      *(FAR uint16_t *)wdest = color;
+    }
+}
+
+#elif NXGLIB_BITSPERPIXEL == 32
+static inline void nxgl_wordfill32(FAR uint32_t *dest, uint32_t color,
+                                   size_t npixels)
+{
+  for (; npixels >= 4; npixels -= 4)
+    {
+      dest[0] = color;
+      dest[1] = color;
+      dest[2] = color;
+      dest[3] = color;
+      dest   += 4;
+    }
+
+  while (npixels-- > 0)
+    {
+      *dest++ = color;
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -159,6 +159,37 @@ static void nxmu_event(FAR struct nxbe_window_s *wnd, enum nx_event_e event,
     }
 }
 
+/****************************************************************************
+ * Name: nxmu_present
+ *
+ * Description:
+ *   Report the merged display updates once the server has processed all
+ *   of the pending messages, i.e. once per burst of drawing operations.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_UPDATE_DEFER
+static void nxmu_present(FAR struct nxmu_state_s *nxmu,
+                         FAR NX_DRIVERTYPE *dev)
+{
+  struct mq_attr attr;
+
+  if (mq_getattr(nxmu->conn.crdmq, &attr) < 0 || attr.mq_curmsgs > 0)
+    {
+      return;
+    }
+
+#ifdef CONFIG_NX_UPDATE_VSYNC
+  if (dev->waitforvsync != NULL)
+    {
+      dev->waitforvsync(dev);
+    }
+#endif
+
+  nxbe_damage_flush(&nxmu->be);
+}
+#endif
+
 /****************************************************************************
  * Name: nxmu_setup
  ****************************************************************************/
@@ -301,6 +332,9 @@ int nx_runinstance(FAR const char *mqname, FAR NX_DRIVERTYPE *dev)
   /* Produce the initial, background display */
 
   nxbe_redraw(&nxmu.be, &nxmu.be.bkgd, &nxmu.be.bkgd.bounds);
+#ifdef CONFIG_NX_UPDATE_DEFER
+  nxmu_present(&nxmu, dev);
+#endif
 
   /* Message Loop ***********************************************************/
 
@@ -577,6 +611,10 @@ int nx_runinstance(FAR const char *mqname, FAR NX_DRIVERTYPE *dev)
            gerr("ERROR: Unrecognized command: %d\n", msg->msgid);
            break;
          }
+
+#ifdef CONFIG_NX_UPDATE_DEFER
+       nxmu_present(&nxmu, dev);
+#endif
     }
 
   nxmu_shutdown(&nxmu);
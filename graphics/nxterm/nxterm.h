@@ -60,6 +60,7 @@
 /* Bitmap flags */
 
 #define BMFLAGS_NOGLYPH    (1 << 0) /* No glyph available, use space */
+#define BMFLAGS_DEFERRED   (1 << 1) /* Not drawn until the scroll is done */
 #define BM_ISSPACE(bm)     (((bm)->flags & BMFLAGS_NOGLYPH) != 0)
 
 /* Device path formats */
@@ -146,6 +147,13 @@ struct nxterm_state_s
 
   struct nxgl_point_s fpos;                  /* Next display position */
 
+  /* Scrolling support.  While 'defer' is set, scrolling only moves the
+   * characters and the display is moved once by nxterm_scrollflush().
+   */
+
+  bool defer;                                /* True: Defer display moves */
+  nxgl_coord_t scrolled;                     /* Pending scroll in pixels */
+
   /* VT100 escape sequence processing */
 
   char seq[VT100_MAX_SEQUENCE];              /* Buffered characters */
@@ -232,7 +240,7 @@ enum nxterm_vt100state_e nxterm_vt100(FAR struct nxterm_state_s *priv, char ch);
 void nxterm_home(FAR struct nxterm_state_s *priv);
 void nxterm_clear(FAR struct nxterm_state_s *priv);
 void nxterm_newline(FAR struct nxterm_state_s *priv);
-FAR const struct nxterm_bitmap_s *nxterm_addchar(FAR struct nxterm_state_s *priv,
+FAR struct nxterm_bitmap_s *nxterm_addchar(FAR struct nxterm_state_s *priv,
     uint8_t ch);
 int nxterm_hidechar(FAR struct nxterm_state_s *priv,
     FAR const struct nxterm_bitmap_s *bm);
@@ -247,5 +255,6 @@ void nxterm_hidecursor(FAR struct nxterm_state_s *priv);
 /* Scrolling support */
 
 void nxterm_scroll(FAR struct nxterm_state_s *priv, int scrollheight);
+void nxterm_scrollflush(FAR struct nxterm_state_s *priv);
 
 #endif /* __GRAPHICS_NXTERM_NXTERM_H */
@@ -228,6 +228,12 @@ static ssize_t nxterm_write(FAR struct file *filep, FAR const char *buffer,
 
   nxterm_hidecursor(priv);
 
+  /* Move the display only once for all of the lines scrolled by this
+   * write.
+   */
+
+  priv->defer = true;
+
   /* Loop writing each character to the display */
 
   for (remaining = (ssize_t)buflen; remaining > 0; remaining--)
@@ -304,7 +310,10 @@ static ssize_t nxterm_write(FAR struct file *filep, FAR const char *buffer,
       while (state == VT100_ABORT);
     }
 
-  /* Show the cursor at its new position */
+  /* Perform the pending scroll and show the cursor at its new position */
+
+  priv->defer = false;
+  nxterm_scrollflush(priv);
 
   nxterm_showcursor(priv);
   nxterm_sempost(priv);
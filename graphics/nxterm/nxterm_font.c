@@ -148,7 +148,7 @@ static void nxterm_fillspace(FAR struct nxterm_state_s *priv,
  *
  ****************************************************************************/
 
-FAR const struct nxterm_bitmap_s *
+FAR struct nxterm_bitmap_s *
   nxterm_addchar(FAR struct nxterm_state_s *priv, uint8_t ch)
 {
   FAR struct nxterm_bitmap_s *bm = NULL;
@@ -251,6 +251,10 @@ int nxterm_backspace(FAR struct nxterm_state_s *priv)
   int ndx;
   int ret = -ENOENT;
 
+  /* The display must be up to date before a character is erased */
+
+  nxterm_scrollflush(priv);
+
   /* Is there a character on the display? */
 
   if (priv->nchars > 0)
@@ -61,7 +61,7 @@
 
 void nxterm_putc(FAR struct nxterm_state_s *priv, uint8_t ch)
 {
-  FAR const struct nxterm_bitmap_s *bm;
+  FAR struct nxterm_bitmap_s *bm;
   int lineheight;
 
   /* Ignore carriage returns */
@@ -123,11 +123,16 @@ void nxterm_putc(FAR struct nxterm_state_s *priv, uint8_t ch)
     }
 
   /* Find the glyph associated with the character and render it onto the
-   * display.
+   * display.  If a scroll of the display is pending, the character is
+   * rendered after the display has been moved.
    */
 
   bm = nxterm_addchar(priv, ch);
-  if (bm)
+  if (bm && priv->scrolled > 0)
+    {
+      bm->flags |= BMFLAGS_DEFERRED;
+    }
+  else if (bm)
     {
       nxterm_fillchar(priv, NULL, bm);
     }
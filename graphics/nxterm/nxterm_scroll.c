@@ -65,6 +65,9 @@
  *   easy.  However, many displays (such as SPI-based LCDs) are often read-
  *   only.
  *
+ *   'bottom' is the first row below the moved characters and
+ *   'scrollheight' is the distance that they were moved up.
+ *
  ****************************************************************************/
 
 #ifdef CONFIG_NX_WRITEONLY
@@ -74,6 +77,7 @@ static inline void nxterm_movedisplay(FAR struct nxterm_state_s *priv,
   FAR struct nxterm_bitmap_s *bm;
   struct nxgl_rect_s rect;
   nxgl_coord_t row;
+  int lineheight;
   int ret;
   int i;
 
@@ -83,15 +87,18 @@ static inline void nxterm_movedisplay(FAR struct nxterm_state_s *priv,
    * however, in much smaller chunks.
    */
 
+  UNUSED(scrollheight);
+
+  lineheight = priv->fheight + CONFIG_NXTERM_LINESEPARATION;
   rect.pt1.x = 0;
   rect.pt2.x = priv->wndo.wsize.w - 1;
 
-  for (row = CONFIG_NXTERM_LINESEPARATION; row < bottom; row += scrollheight)
+  for (row = CONFIG_NXTERM_LINESEPARATION; row < bottom; row += lineheight)
     {
       /* Create a bounding box the size of one row of characters */
 
       rect.pt1.y = row;
-      rect.pt2.y = row + scrollheight - 1;
+      rect.pt2.y = row + lineheight - 1;
 
       /* Clear the region */
 
@@ -133,9 +140,7 @@ static inline void nxterm_movedisplay(FAR struct nxterm_state_s *priv,
   struct nxgl_point_s offset;
   int ret;
 
-  /* Add the line separation value to the scroll height */
-
-  scrollheight += CONFIG_NXTERM_LINESEPARATION;
+  UNUSED(bottom);
 
   /* Move the display in the range of 0-height up one scrollheight.  The
    * line at the bottom will be reset to the background color automatically.
@@ -183,53 +188,101 @@ static inline void nxterm_movedisplay(FAR struct nxterm_state_s *priv,
 
 void nxterm_scroll(FAR struct nxterm_state_s *priv, int scrollheight)
 {
+  FAR struct nxterm_bitmap_s *bm;
   int i;
   int j;
 
-  /* Adjust the vertical position of each character */
+  /* Adjust the vertical position of each character, compacting the
+   * characters that remain on the screen to the front of bm[].
+   */
 
-  for (i = 0; i < priv->nchars; )
+  for (i = 0, j = 0; i < priv->nchars; i++)
     {
-      FAR struct nxterm_bitmap_s *bm = &priv->bm[i];
+      bm = &priv->bm[i];
 
-      /* Has any part of this character scrolled off the screen? */
+      /* Has any part of this character scrolled off the screen?  If so,
+       * just drop it.
+       */
 
-      if (bm->pos.y < scrollheight + CONFIG_NXTERM_LINESEPARATION)
+      if (bm->pos.y >= scrollheight + CONFIG_NXTERM_LINESEPARATION)
         {
-          /* Yes... Delete the character by moving all of the data */
+          /* No.. just decrement its vertical position (moving it "up" the
+           * display by one line) and keep it.
+           */
 
-          for (j = i; j < priv->nchars - 1; j++)
+          bm->pos.y -= scrollheight;
+          if (j != i)
             {
-              memcpy(&priv->bm[j], &priv->bm[j + 1],
-                     sizeof(struct nxterm_bitmap_s));
+              memcpy(&priv->bm[j], bm, sizeof(struct nxterm_bitmap_s));
             }
 
-          /* Decrement the number of cached characters ('i' is not incremented
-           * in this case because it already points to the next character)
-           */
-
-          priv->nchars--;
+          j++;
         }
+    }
 
-      /* No.. just decrement its vertical position (moving it "up" the
-       * display by one line).
-       */
+  priv->nchars = j;
 
-      else
-        {
-          bm->pos.y -= scrollheight;
+  /* And move the next display position up by one line as well */
 
-          /* We are keeping this one so increment to the next character */
+  priv->fpos.y -= scrollheight;
 
-          i++;
-        }
+  /* Move the display in the range of 0-height up one scrollheight now or,
+   * if display moves are deferred, together with the following scrolls.
+   */
+
+  if (priv->defer)
+    {
+      priv->scrolled += scrollheight;
+    }
+  else
+    {
+      nxterm_movedisplay(priv, priv->fpos.y, scrollheight);
     }
+}
 
-  /* And move the next display position up by one line as well */
+/****************************************************************************
+ * Name: nxterm_scrollflush
+ *
+ * Description:
+ *   Move the display by all of the scrolls deferred since the last flush
+ *   and render the characters that were added in the meantime.
+ *
+ ****************************************************************************/
 
-  priv->fpos.y -= scrollheight;
+void nxterm_scrollflush(FAR struct nxterm_state_s *priv)
+{
+  FAR struct nxterm_bitmap_s *bm;
+  int i;
+
+  if (priv->scrolled <= 0)
+    {
+      return;
+    }
 
-  /* Move the display in the range of 0-height up one scrollheight. */
+  /* If everything has scrolled off the screen, then just clear it */
 
-  nxterm_movedisplay(priv, priv->fpos.y, scrollheight);
+  if (priv->scrolled < priv->wndo.wsize.h)
+    {
+      nxterm_movedisplay(priv, priv->fpos.y, priv->scrolled);
+    }
+  else
+    {
+      nxterm_clear(priv);
+    }
+
+  priv->scrolled = 0;
+
+  /* Then render the characters that were added while the scroll was
+   * pending.
+   */
+
+  for (i = 0; i < priv->nchars; i++)
+    {
+      bm = &priv->bm[i];
+      if ((bm->flags & BMFLAGS_DEFERRED) != 0)
+        {
+          bm->flags &= ~BMFLAGS_DEFERRED;
+          nxterm_fillchar(priv, NULL, bm);
+        }
+    }
 }
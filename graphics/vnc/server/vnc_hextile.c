@@ -0,0 +1,527 @@
+/****************************************************************************
+ * graphics/vnc/server/vnc_hextile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <errno.h>
+
+#if defined(CONFIG_VNCSERVER_DEBUG) && !defined(CONFIG_DEBUG_GRAPHICS)
+#  undef  CONFIG_DEBUG_ERROR
+#  undef  CONFIG_DEBUG_WARN
+#  undef  CONFIG_DEBUG_INFO
+#  undef  CONFIG_DEBUG_GRAPHICS_ERROR
+#  undef  CONFIG_DEBUG_GRAPHICS_WARN
+#  undef  CONFIG_DEBUG_GRAPHICS_INFO
+#  define CONFIG_DEBUG_ERROR          1
+#  define CONFIG_DEBUG_WARN           1
+#  define CONFIG_DEBUG_INFO           1
+#  define CONFIG_DEBUG_GRAPHICS       1
+#  define CONFIG_DEBUG_GRAPHICS_ERROR 1
+#  define CONFIG_DEBUG_GRAPHICS_WARN  1
+#  define CONFIG_DEBUG_GRAPHICS_INFO  1
+#endif
+#include <debug.h>
+
+#include "vnc_server.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* rfb.h re-defines RFB_SUBENCODING_RAW for ZRLE, the Hextile value is 1 */
+
+#define HEXTILE_RAW       1
+
+/* The size of a raw tile is an upper bound of the size of any tile */
+
+#define HEXTILE_MAXSIZE(b) (1 + VNC_TILESIZE * VNC_TILESIZE * (b))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The state carried from one tile to the next */
+
+struct vnc_hextile_s
+{
+  FAR struct vnc_session_s *session;
+  unsigned int bytesperpixel;  /* Remote bytes per pixel */
+  bool bigendian;              /* True: Remote expects big-endian pixels */
+  bool bgvalid;                /* True: bg may be carried over */
+  bool fgvalid;                /* True: fg may be carried over */
+  lfb_color_t bg;              /* Background of the previous tile */
+  lfb_color_t fg;              /* Foreground of the previous tile */
+
+  union
+  {
+    vnc_convert8_t bpp8;
+    vnc_convert16_t bpp16;
+    vnc_convert32_t bpp32;
+  } convert;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_hextile_pixel
+ *
+ * Description:
+ *   Return the address of a pixel in the local framebuffer.
+ *
+ ****************************************************************************/
+
+static inline FAR const lfb_color_t *
+vnc_hextile_pixel(FAR struct vnc_session_s *session, nxgl_coord_t x,
+                  nxgl_coord_t y)
+{
+  return (FAR const lfb_color_t *)
+    (session->fb + RFB_STRIDE * y + RFB_BYTESPERPIXEL * x);
+}
+
+/****************************************************************************
+ * Name: vnc_hextile_putpixel
+ *
+ * Description:
+ *   Convert a pixel to the remote format and store it.
+ *
+ * Returned Value:
+ *   The address following the stored pixel.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *vnc_hextile_putpixel(FAR struct vnc_hextile_s *state,
+                                         FAR uint8_t *dest,
+                                         lfb_color_t color)
+{
+  if (state->bytesperpixel == 1)
+    {
+      *dest = state->convert.bpp8(color);
+    }
+  else if (state->bytesperpixel == 2)
+    {
+      if (state->bigendian)
+        {
+          rfb_putbe16(dest, state->convert.bpp16(color));
+        }
+      else
+        {
+          rfb_putle16(dest, state->convert.bpp16(color));
+        }
+    }
+  else /* bytesperpixel == 4 */
+    {
+      if (state->bigendian)
+        {
+          rfb_putbe32(dest, state->convert.bpp32(color));
+        }
+      else
+        {
+          rfb_putle32(dest, state->convert.bpp32(color));
+        }
+    }
+
+  return dest + state->bytesperpixel;
+}
+
+/****************************************************************************
+ * Name: vnc_hextile_tile
+ *
+ * Description:
+ *   Encode one tile.  A tile of one color is sent as its background, a
+ *   tile of two colors as runs of the foreground and any other tile as
+ *   runs of colored sub-rectangles.  If that does not save anything, the
+ *   tile is sent raw.
+ *
+ * Input Parameters:
+ *   state - The state carried from the previous tile
+ *   dest  - The location to save the encoded tile
+ *   x,y   - The upper left position of the tile
+ *   w,h   - The width and height of the tile
+ *
+ * Returned Value:
+ *   The size of the encoded tile, at most HEXTILE_MAXSIZE().
+ *
+ ****************************************************************************/
+
+static size_t vnc_hextile_tile(FAR struct vnc_hextile_s *state,
+                               FAR uint8_t *dest, nxgl_coord_t x,
+                               nxgl_coord_t y, nxgl_coord_t w,
+                               nxgl_coord_t h)
+{
+  FAR struct vnc_session_s *session = state->session;
+  FAR const lfb_color_t *src;
+  FAR uint8_t *limit;
+  FAR uint8_t *nsubrects;
+  FAR uint8_t *ptr;
+  lfb_color_t colors[2];
+  lfb_color_t bg;
+  lfb_color_t color;
+  unsigned int counts[2];
+  unsigned int ncolors;
+  unsigned int bytes = state->bytesperpixel;
+  nxgl_coord_t col;
+  nxgl_coord_t row;
+  nxgl_coord_t start;
+  uint8_t mask;
+
+  /* Count the first two colors of the tile and check for a third */
+
+  colors[0] = *vnc_hextile_pixel(session, x, y);
+  colors[1] = colors[0];
+  counts[0] = 0;
+  counts[1] = 0;
+  ncolors   = 1;
+
+  for (row = 0; row < h && ncolors <= 2; row++)
+    {
+      src = vnc_hextile_pixel(session, x, y + row);
+      for (col = 0; col < w; col++)
+        {
+          color = src[col];
+          if (color == colors[0])
+            {
+              counts[0]++;
+            }
+          else if (ncolors == 1 || color == colors[1])
+            {
+              colors[1] = color;
+              counts[1]++;
+              ncolors   = 2;
+            }
+          else
+            {
+              ncolors = 3;
+              break;
+            }
+        }
+    }
+
+  bg    = counts[1] > counts[0] ? colors[1] : colors[0];
+  limit = dest + 1 + w * h * bytes;
+  ptr   = dest + 1;
+  mask  = 0;
+
+  if (!state->bgvalid || bg != state->bg)
+    {
+      if (ptr + bytes > limit)
+        {
+          goto raw;
+        }
+
+      mask |= RFB_SUBENCODING_BACK;
+      ptr   = vnc_hextile_putpixel(state, ptr, bg);
+    }
+
+  if (ncolors == 1)
+    {
+      /* The background is all there is */
+
+      dest[0]        = mask;
+      state->bg      = bg;
+      state->bgvalid = true;
+      return ptr - dest;
+    }
+
+  mask |= RFB_SUBENCODING_ANY;
+  if (ncolors == 2)
+    {
+      /* All runs have the same color */
+
+      color = bg == colors[0] ? colors[1] : colors[0];
+      if (!state->fgvalid || color != state->fg)
+        {
+          if (ptr + bytes > limit)
+            {
+              goto raw;
+            }
+
+          mask |= RFB_SUBENCODING_FORE;
+          ptr   = vnc_hextile_putpixel(state, ptr, color);
+        }
+    }
+  else
+    {
+      mask |= RFB_SUBENCODING_COLORED;
+    }
+
+  if (ptr + 1 > limit)
+    {
+      goto raw;
+    }
+
+  nsubrects  = ptr++;
+  *nsubrects = 0;
+
+  /* One sub-rectangle for each horizontal run that is not background */
+
+  for (row = 0; row < h; row++)
+    {
+      src = vnc_hextile_pixel(session, x, y + row);
+      for (col = 0; col < w; )
+        {
+          color = src[col];
+          if (color == bg)
+            {
+              col++;
+              continue;
+            }
+
+          for (start = col; col < w && src[col] == color; col++)
+            {
+            }
+
+          if (ptr + 2 + ((mask & RFB_SUBENCODING_COLORED) ? bytes : 0) >
+              limit)
+            {
+              goto raw;
+            }
+
+          if ((mask & RFB_SUBENCODING_COLORED) != 0)
+            {
+              ptr = vnc_hextile_putpixel(state, ptr, color);
+            }
+
+          *ptr++ = (start << 4) | row;
+          *ptr++ = ((col - start - 1) << 4);
+          (*nsubrects)++;
+        }
+    }
+
+  dest[0]        = mask;
+  state->bg      = bg;
+  state->bgvalid = true;
+
+  if (ncolors == 2)
+    {
+      state->fg      = bg == colors[0] ? colors[1] : colors[0];
+      state->fgvalid = true;
+    }
+  else
+    {
+      state->fgvalid = false;
+    }
+
+  return ptr - dest;
+
+raw:
+
+  /* Nothing is carried over a raw tile */
+
+  dest[0] = HEXTILE_RAW;
+  ptr     = dest + 1;
+
+  for (row = 0; row < h; row++)
+    {
+      src = vnc_hextile_pixel(session, x, y + row);
+      for (col = 0; col < w; col++)
+        {
+          ptr = vnc_hextile_putpixel(state, ptr, src[col]);
+        }
+    }
+
+  state->bgvalid = false;
+  state->fgvalid = false;
+  return ptr - dest;
+}
+
+/****************************************************************************
+ * Name: vnc_hextile_send
+ *
+ * Description:
+ *   Send the content of the update buffer.
+ *
+ ****************************************************************************/
+
+static int vnc_hextile_send(FAR struct vnc_session_s *session, size_t size)
+{
+  FAR const uint8_t *src = session->outbuf;
+  ssize_t nsent;
+
+  while (size > 0)
+    {
+      nsent = psock_send(&session->connect, src, size, 0);
+      if (nsent < 0)
+        {
+          gerr("ERROR: Send Hextile FrameBufferUpdate failed: %d\n",
+               (int)nsent);
+          return (int)nsent;
+        }
+
+      DEBUGASSERT(nsent <= size);
+      src  += nsent;
+      size -= nsent;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: vnc_hextile
+ *
+ * Description:
+ *  Send the framebuffer update using the Hextile encoding, if the client
+ *  supports it.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect  - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero is returned if Hextile coding was not performed (but no error was
+ *   encountered).  Otherwise, the size of the framebuffer update message
+ *   is returned on success or a negated errno value is returned on failure
+ *   that indicates the nature of the failure.  A failure is only
+ *   returned in cases of a network failure and unexpected internal failures.
+ *
+ ****************************************************************************/
+
+int vnc_hextile(FAR struct vnc_session_s *session,
+                FAR struct nxgl_rect_s *rect)
+{
+  FAR struct rfb_framebufferupdate_s *update;
+  struct vnc_hextile_s state;
+  nxgl_coord_t tw;
+  nxgl_coord_t th;
+  nxgl_coord_t x;
+  nxgl_coord_t y;
+  size_t nbytes;
+  size_t total;
+  int ret;
+
+  /* Check if the client supports the Hextile encoding.  The pixel format
+   * is sampled once:  The tiles of one rectangle cannot switch formats.
+   */
+
+  if (!session->hextile)
+    {
+      return 0;
+    }
+
+  state.session       = session;
+  state.bytesperpixel = (session->bpp + 7) >> 3;
+  state.bigendian     = session->bigendian;
+  state.bgvalid       = false;
+  state.fgvalid       = false;
+
+  /* Each tile must fit into the update buffer */
+
+  if (HEXTILE_MAXSIZE(state.bytesperpixel) > VNCSERVER_UPDATE_BUFSIZE)
+    {
+      return 0;
+    }
+
+  switch (session->colorfmt)
+    {
+      case FB_FMT_RGB8_222:
+        state.convert.bpp8 = vnc_convert_rgb8_222;
+        break;
+
+      case FB_FMT_RGB8_332:
+        state.convert.bpp8 = vnc_convert_rgb8_332;
+        break;
+
+      case FB_FMT_RGB16_555:
+        state.convert.bpp16 = vnc_convert_rgb16_555;
+        break;
+
+      case FB_FMT_RGB16_565:
+        state.convert.bpp16 = vnc_convert_rgb16_565;
+        break;
+
+      case FB_FMT_RGB32:
+        state.convert.bpp32 = vnc_convert_rgb32_888;
+        break;
+
+      default:
+        gerr("ERROR: Unrecognized color format: %d\n", session->colorfmt);
+        return -EINVAL;
+    }
+
+  /* Format the FrameBuffer Update with a single Hextile encoded
+   * rectangle.
+   */
+
+  update          = (FAR struct rfb_framebufferupdate_s *)session->outbuf;
+  update->msgtype = RFB_FBUPDATE_MSG;
+  update->padding = 0;
+  rfb_putbe16(update->nrect, 1);
+
+  rfb_putbe16(update->rect[0].xpos, rect->pt1.x);
+  rfb_putbe16(update->rect[0].ypos, rect->pt1.y);
+  rfb_putbe16(update->rect[0].width, rect->pt2.x - rect->pt1.x + 1);
+  rfb_putbe16(update->rect[0].height, rect->pt2.y - rect->pt1.y + 1);
+  rfb_putbe32(update->rect[0].encoding, RFB_ENCODING_HEXTILE);
+
+  nbytes = SIZEOF_RFB_FRAMEBUFFERUPDATE_S(SIZEOF_RFB_RECTANGE_S(0));
+  total  = 0;
+
+  /* Encode the tiles left-to-right, top-to-bottom.  The buffer is sent
+   * whenever the next tile might not fit.
+   */
+
+  for (y = rect->pt1.y; y <= rect->pt2.y; y += VNC_TILESIZE)
+    {
+      th = MIN(VNC_TILESIZE, rect->pt2.y - y + 1);
+
+      for (x = rect->pt1.x; x <= rect->pt2.x; x += VNC_TILESIZE)
+        {
+          tw = MIN(VNC_TILESIZE, rect->pt2.x - x + 1);
+
+          if (nbytes + HEXTILE_MAXSIZE(state.bytesperpixel) >
+              VNCSERVER_UPDATE_BUFSIZE)
+            {
+              ret = vnc_hextile_send(session, nbytes);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+
+              total += nbytes;
+              nbytes = 0;
+            }
+
+          nbytes += vnc_hextile_tile(&state, &session->outbuf[nbytes],
+                                     x, y, tw, th);
+        }
+    }
+
+  ret = vnc_hextile_send(session, nbytes);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  updinfo("Sent {(%d, %d),(%d, %d)}\n",
+          rect->pt1.x, rect->pt1.y, rect->pt2.x, rect->pt2.y);
+  return total + nbytes;
+}
@@ -115,6 +115,43 @@ int vnc_read_remainder(FAR struct vnc_session_s *session, size_t msglen,
   return OK;
 }
 
+/****************************************************************************
+ * Name: vnc_forget_tiles
+ *
+ * Description:
+ *   Forget which content of the tiles within a rectangle the client has,
+ *   so that the updater sends them again.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect    - The rectangle requested by the client.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_TILEHASH
+static void vnc_forget_tiles(FAR struct vnc_session_s *session,
+                             FAR const struct nxgl_rect_s *rect)
+{
+  nxgl_coord_t x1 = MAX(rect->pt1.x, 0) >> VNC_TILESHIFT;
+  nxgl_coord_t y1 = MAX(rect->pt1.y, 0) >> VNC_TILESHIFT;
+  nxgl_coord_t x2 = MIN(rect->pt2.x >> VNC_TILESHIFT, VNC_XTILES - 1);
+  nxgl_coord_t y2 = MIN(rect->pt2.y >> VNC_TILESHIFT, VNC_YTILES - 1);
+  nxgl_coord_t tx;
+  nxgl_coord_t ty;
+
+  for (ty = y1; ty <= y2; ty++)
+    {
+      for (tx = x1; tx <= x2; tx++)
+        {
+          session->tilehash[ty * VNC_XTILES + tx] = 0;
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -277,6 +314,9 @@ int vnc_receiver(FAR struct vnc_session_s *session)
             {
               FAR struct rfb_fbupdatereq_s *update;
               struct nxgl_rect_s rect;
+#ifdef CONFIG_VNCSERVER_PACING
+              int semcount;
+#endif
 
               ginfo("Received FramebufferUpdateRequest\n");
 
@@ -301,6 +341,28 @@ int vnc_receiver(FAR struct vnc_session_s *session)
                   rect.pt2.x = rect.pt1.x + rfb_getbe16(update->width);
                   rect.pt2.y = rect.pt1.y + rfb_getbe16(update->height);
 
+#ifdef CONFIG_VNCSERVER_TILEHASH
+                  /* The client wants all of the rectangle, changed or not */
+
+                  if (update->incremental == 0)
+                    {
+                      vnc_forget_tiles(session, &rect);
+                    }
+#endif
+
+#ifdef CONFIG_VNCSERVER_PACING
+                  /* The client is ready for the next update.  Wake up the
+                   * updater if it is waiting for this.
+                   */
+
+                  session->nfbreq++;
+                  if (nxsem_getvalue(&session->reqsem, &semcount) >= 0 &&
+                      semcount <= 0)
+                    {
+                      nxsem_post(&session->reqsem);
+                    }
+#endif
+
                   ret = vnc_update_rectangle(session, &rect, false);
                   if (ret < 0)
                     {
@@ -470,6 +532,9 @@ int vnc_client_encodings(FAR struct vnc_session_s *session,
   /* Assume that there are no common encodings (other than RAW) */
 
   session->rre = false;
+#ifdef CONFIG_VNCSERVER_HEXTILE
+  session->hextile = false;
+#endif
 
   /* Loop for each client supported encoding */
 
@@ -486,6 +551,13 @@ int vnc_client_encodings(FAR struct vnc_session_s *session,
         {
           session->rre = true;
         }
+
+#ifdef CONFIG_VNCSERVER_HEXTILE
+      if (encoding == RFB_ENCODING_HEXTILE)
+        {
+          session->hextile = true;
+        }
+#endif
     }
 
   session->change = true;
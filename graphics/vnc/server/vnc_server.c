@@ -140,6 +140,17 @@ static void vnc_reset_session(FAR struct vnc_session_s *session,
   session->nwhupd  = 0;
   session->change  = true;
 
+#ifdef CONFIG_VNCSERVER_TILEHASH
+  /* Nothing is known about the framebuffer of the next client */
+
+  memset(session->tilehash, 0, sizeof(session->tilehash));
+#endif
+
+#ifdef CONFIG_VNCSERVER_PACING
+  session->nfbreq  = 0;
+  nxsem_reset(&session->reqsem, 0);
+#endif
+
   /* Careful not to disturb the keyboard/mouse callouts set by
    * vnc_fbinitialize().  Client related data left in garbage state.
    */
@@ -293,6 +304,10 @@ int vnc_server(int argc, FAR char *argv[])
   g_vnc_sessions[display] = session;
   nxsem_init(&session->freesem, 0, CONFIG_VNCSERVER_NUPDATES);
   nxsem_init(&session->queuesem, 0, 0);
+#ifdef CONFIG_VNCSERVER_PACING
+  nxsem_init(&session->reqsem, 0, 0);
+  nxsem_setprotocol(&session->reqsem, SEM_PRIO_NONE);
+#endif
 
   /* Inform any waiter that we have started */
 
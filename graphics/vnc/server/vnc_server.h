@@ -162,6 +162,15 @@
 #define RFB_STRIDE          (RFB_BYTESPERPIXEL * CONFIG_VNCSERVER_SCREENWIDTH)
 #define RFB_SIZE            (RFB_STRIDE * CONFIG_VNCSERVER_SCREENHEIGHT)
 
+/* Tiles of the Hextile encoding and of the change detection */
+
+#define VNC_TILESHIFT       4
+#define VNC_TILESIZE        (1 << VNC_TILESHIFT)
+#define VNC_XTILES \
+  ((CONFIG_VNCSERVER_SCREENWIDTH + VNC_TILESIZE - 1) >> VNC_TILESHIFT)
+#define VNC_YTILES \
+  ((CONFIG_VNCSERVER_SCREENHEIGHT + VNC_TILESIZE - 1) >> VNC_TILESHIFT)
+
 /* RFB Port Number */
 
 #define RFB_PORT_BASE       5900
@@ -235,8 +244,26 @@ struct vnc_session_s
   volatile uint8_t bpp;        /* Remote bits per pixel */
   volatile bool bigendian;     /* True: Remote expect data in big-endian format */
   volatile bool rre;           /* True: Remote supports RRE encoding */
+#ifdef CONFIG_VNCSERVER_HEXTILE
+  volatile bool hextile;       /* True: Remote supports Hextile encoding */
+#endif
   FAR uint8_t *fb;             /* Allocated local frame buffer */
 
+#ifdef CONFIG_VNCSERVER_TILEHASH
+  /* Hash of each tile as last sent to the client, zero if unknown */
+
+  uint32_t tilehash[VNC_XTILES * VNC_YTILES];
+#endif
+
+#ifdef CONFIG_VNCSERVER_PACING
+  /* Number of FramebufferUpdateRequests received.  reqsem wakes up the
+   * updater waiting for the next one.
+   */
+
+  volatile uint32_t nfbreq;
+  sem_t reqsem;
+#endif
+
   /* VNC client input support */
 
   vnc_kbdout_t kbdout;         /* Callout when keyboard input is received */
@@ -482,6 +509,31 @@ int vnc_receiver(FAR struct vnc_session_s *session);
 
 int vnc_rre(FAR struct vnc_session_s *session, FAR struct nxgl_rect_s *rect);
 
+/****************************************************************************
+ * Name: vnc_hextile
+ *
+ * Description:
+ *  Send the framebuffer update using the Hextile encoding, if the client
+ *  supports it.
+ *
+ * Input Parameters:
+ *   session - An instance of the session structure.
+ *   rect  - Describes the rectangle in the local framebuffer.
+ *
+ * Returned Value:
+ *   Zero is returned if Hextile coding was not performed (but no error was
+ *   encountered).  Otherwise, the size of the framebuffer update message
+ *   is returned on success or a negated errno value is returned on failure
+ *   that indicates the nature of the failure.  A failure is only
+ *   returned in cases of a network failure and unexpected internal failures.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_HEXTILE
+int vnc_hextile(FAR struct vnc_session_s *session,
+                FAR struct nxgl_rect_s *rect);
+#endif
+
 /****************************************************************************
  * Name: vnc_raw
  *
@@ -336,6 +336,114 @@ static void vnc_add_queue(FAR struct vnc_session_s *session,
   sched_unlock();
 }
 
+/****************************************************************************
+ * Name: vnc_tilehash
+ *
+ * Description:
+ *   Return the FNV-1a hash of the pixels of a tile, never zero.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_VNCSERVER_TILEHASH
+static uint32_t vnc_tilehash(FAR struct vnc_session_s *session,
+                             FAR const struct nxgl_rect_s *tile)
+{
+  FAR const lfb_color_t *src;
+  uint32_t hash = 2166136261u;
+  nxgl_coord_t x;
+  nxgl_coord_t y;
+
+  for (y = tile->pt1.y; y <= tile->pt2.y; y++)
+    {
+      src = (FAR const lfb_color_t *)
+        (session->fb + RFB_STRIDE * y + RFB_BYTESPERPIXEL * tile->pt1.x);
+
+      for (x = tile->pt1.x; x <= tile->pt2.x; x++)
+        {
+          hash = (hash ^ *src++) * 16777619u;
+        }
+    }
+
+  return hash != 0 ? hash : 1;
+}
+
+/****************************************************************************
+ * Name: vnc_changed_tiles
+ *
+ * Description:
+ *   Reduce an update rectangle to the bounding box of the tiles that
+ *   differ from what was last sent to the client and remember what will
+ *   be sent now.  Tiles only partly covered by the rectangle always count
+ *   as changed; their hash is then unknown.  So are the tiles requested by
+ *   a non-incremental FramebufferUpdateRequest.
+ *
+ * Input Parameters:
+ *   session - A reference to the VNC session structure.
+ *   rect    - The update rectangle, modified in place.
+ *
+ * Returned Value:
+ *   True if anything is left to send.
+ *
+ ****************************************************************************/
+
+static bool vnc_changed_tiles(FAR struct vnc_session_s *session,
+                              FAR struct nxgl_rect_s *rect)
+{
+  struct nxgl_rect_s changed;
+  struct nxgl_rect_s tile;
+  FAR uint32_t *stored;
+  uint32_t hash;
+  nxgl_coord_t tx;
+  nxgl_coord_t ty;
+
+  changed.pt1.x = rect->pt2.x + 1;
+  changed.pt1.y = rect->pt2.y + 1;
+  changed.pt2.x = rect->pt1.x - 1;
+  changed.pt2.y = rect->pt1.y - 1;
+
+  for (ty = rect->pt1.y >> VNC_TILESHIFT;
+       ty <= rect->pt2.y >> VNC_TILESHIFT; ty++)
+    {
+      for (tx = rect->pt1.x >> VNC_TILESHIFT;
+           tx <= rect->pt2.x >> VNC_TILESHIFT; tx++)
+        {
+          tile.pt1.x = tx << VNC_TILESHIFT;
+          tile.pt1.y = ty << VNC_TILESHIFT;
+          tile.pt2.x = MIN(tile.pt1.x + VNC_TILESIZE,
+                           CONFIG_VNCSERVER_SCREENWIDTH) - 1;
+          tile.pt2.y = MIN(tile.pt1.y + VNC_TILESIZE,
+                           CONFIG_VNCSERVER_SCREENHEIGHT) - 1;
+
+          stored = &session->tilehash[ty * VNC_XTILES + tx];
+
+          if (tile.pt1.x >= rect->pt1.x && tile.pt2.x <= rect->pt2.x &&
+              tile.pt1.y >= rect->pt1.y && tile.pt2.y <= rect->pt2.y)
+            {
+              hash = vnc_tilehash(session, &tile);
+              if (hash == *stored)
+                {
+                  continue;
+                }
+
+              *stored = hash;
+            }
+          else
+            {
+              *stored = 0;
+            }
+
+          changed.pt1.x = MIN(changed.pt1.x, tile.pt1.x);
+          changed.pt1.y = MIN(changed.pt1.y, tile.pt1.y);
+          changed.pt2.x = MAX(changed.pt2.x, tile.pt2.x);
+          changed.pt2.y = MAX(changed.pt2.y, tile.pt2.y);
+        }
+    }
+
+  nxgl_rectintersect(rect, rect, &changed);
+  return !nxgl_nullrect(rect);
+}
+#endif
+
 /****************************************************************************
  * Name: vnc_updater
  *
@@ -355,6 +463,10 @@ static FAR void *vnc_updater(FAR void *arg)
 {
   FAR struct vnc_session_s *session = (FAR struct vnc_session_s *)arg;
   FAR struct vnc_fbupdate_s *srcrect;
+#ifdef CONFIG_VNCSERVER_PACING
+  uint32_t served = 0;
+  uint32_t nfbreq = 0;
+#endif
   int ret;
 
   DEBUGASSERT(session != NULL);
@@ -379,9 +491,54 @@ static FAR void *vnc_updater(FAR void *arg)
               srcrect->rect.pt1.x, srcrect->rect.pt1.y,
               srcrect->rect.pt2.x, srcrect->rect.pt2.y);
 
+#ifdef CONFIG_VNCSERVER_PACING
+      /* Wait until the client has asked for more since the last burst of
+       * updates.  Everything queued meanwhile is sent in the next burst.
+       */
+
+      while (session->nfbreq == served &&
+             session->state == VNCSERVER_RUNNING)
+        {
+          nxsem_wait_uninterruptible(&session->reqsem);
+        }
+
+      if (session->state != VNCSERVER_RUNNING)
+        {
+          vnc_free_update(session, srcrect);
+          break;
+        }
+
+      nfbreq = session->nfbreq;
+#endif
+
+      ret = 0;
+
+#ifdef CONFIG_VNCSERVER_TILEHASH
+      /* Skip the tiles that the client already has */
+
+      if (!vnc_changed_tiles(session, &srcrect->rect))
+        {
+          updinfo("Unchanged\n");
+          ret = 1;
+        }
+#endif
+
       /* Attempt to use RRE encoding */
 
-      ret = vnc_rre(session, &srcrect->rect);
+      if (ret == 0)
+        {
+          ret = vnc_rre(session, &srcrect->rect);
+        }
+
+#ifdef CONFIG_VNCSERVER_HEXTILE
+      /* Then the Hextile encoding */
+
+      if (ret == 0)
+        {
+          ret = vnc_hextile(session, &srcrect->rect);
+        }
+#endif
+
       if (ret == 0)
         {
           /* Perform the framebuffer update using the default RAW encoding */
@@ -389,6 +546,15 @@ static FAR void *vnc_updater(FAR void *arg)
           ret = vnc_raw(session, &srcrect->rect);
         }
 
+#ifdef CONFIG_VNCSERVER_PACING
+      /* The burst ends when the queue is empty */
+
+      if (sq_empty(&session->updqueue))
+        {
+          served = nfbreq;
+        }
+#endif
+
       /* Release the update structure */
 
       vnc_free_update(session, srcrect);
@@ -482,6 +648,12 @@ int vnc_stop_updater(FAR struct vnc_session_s *session)
 
       session->state = VNCSERVER_STOPPING;
 
+#ifdef CONFIG_VNCSERVER_PACING
+      /* In case it is waiting for the client */
+
+      nxsem_post(&session->reqsem);
+#endif
+
       /* Wait for the thread to comply with our request */
 
       status = pthread_join(session->updater, &result);
@@ -552,6 +724,19 @@ int vnc_update_rectangle(FAR struct vnc_session_s *session,
           return OK;
         }
 
+#ifdef CONFIG_VNCSERVER_PACING
+      /* The updater may be waiting for the client for a long time.  Rather
+       * than waiting for a free update structure, replace all queued
+       * updates with one whole screen update.
+       */
+
+      if (session->nwhupd == 0 && sq_empty(&session->updfree))
+        {
+          nxgl_rectcopy(&intersection, &g_wholescreen);
+          whupd = true;
+        }
+#endif
+
       /* Ignore all updates if there is a queued whole screen update */
 
       if (session->nwhupd == 0)
@@ -43,6 +43,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <semaphore.h>
 #include <time.h>
 
 #include <nuttx/signal.h>
@@ -97,11 +98,14 @@
  * LIO_NOP         - Indicates that no transfer is requested.
  * LIO_READ        - Requests a read operation.
  * LIO_WRITE       - Requests a write operation.
+ * LIO_FSYNC       - Requests an fsync operation (non-standard, only
+ *                   supported by aio_submit()).
  */
 
 #define LIO_NOP         0
 #define LIO_READ        1
 #define LIO_WRITE       2
+#define LIO_FSYNC       3
 
 /* lio_listio modes
  *
@@ -145,6 +149,24 @@ struct aiocb
   FAR void *aio_priv;            /* Used by signal handlers */
 };
 
+#ifdef CONFIG_FS_AIO_RING
+/* Completion ring used with aio_submit() and aio_reap() (non-standard).
+ * The ring is initialized with aio_ringinit() and must hold at least as
+ * many entries as there are I/Os in flight.  The fields are private to
+ * the implementation.
+ */
+
+struct aioring_s
+{
+  sem_t ar_sem;                  /* Counts the completed entries */
+  FAR struct aiocb **ar_cq;      /* Completion queue */
+  uint16_t ar_nentries;          /* Size of the completion queue */
+  uint16_t ar_head;              /* Next completed entry to be reaped */
+  uint16_t ar_tail;              /* Next completed entry to be posted */
+  uint16_t ar_inflight;          /* Submitted entries not yet reaped */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -172,6 +194,15 @@ int aio_write(FAR struct aiocb *aiocbp);
 int lio_listio(int mode, FAR struct aiocb * const list[], int nent,
                FAR struct sigevent *sig);
 
+#ifdef CONFIG_FS_AIO_RING
+int aio_ringinit(FAR struct aioring_s *ring, FAR struct aiocb **cq,
+                 unsigned int nentries);
+int aio_submit(FAR struct aioring_s *ring, FAR struct aiocb * const list[],
+               int nent);
+int aio_reap(FAR struct aioring_s *ring, FAR struct aiocb *list[], int nent,
+             FAR const struct timespec *timeout);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
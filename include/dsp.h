@@ -369,6 +369,57 @@ struct foc_data_s
   float vab_mod_scale;       /* Voltage alpha-beta modulation scale */
 };
 
+/* FIR filter data.
+ * The state buffer has 2*ntaps entries, each sample is stored twice so
+ * that the last ntaps samples are always contiguous.
+ */
+
+struct fir_s
+{
+  FAR const float *coeffs;   /* ntaps coefficients, coeffs[0] applies to
+                              * the newest sample
+                              */
+  FAR float       *state;    /* 2*ntaps samples */
+  size_t           ntaps;    /* Number of taps */
+  size_t           pos;      /* Position of the newest sample */
+  size_t           phase;    /* Decimation phase */
+};
+
+/* Cascade of biquad (second order IIR) filters in the transposed direct
+ * form II.  Each stage has the 5 coefficients b0, b1, b2, a1, a2 of the
+ * transfer function
+ *
+ *   H(z) = (b0 + b1*z^-1 + b2*z^-2) / (1 + a1*z^-1 + a2*z^-2)
+ */
+
+struct biquad_s
+{
+  FAR const float *coeffs;   /* 5*nstages coefficients */
+  FAR float       *state;    /* 2*nstages state variables */
+  size_t           nstages;  /* Number of stages */
+};
+
+/* Moving average filter data */
+
+struct movavg_s
+{
+  FAR float *buf;            /* len most recent samples */
+  size_t     len;            /* Length of the window */
+  size_t     pos;            /* Position of the oldest sample */
+  size_t     count;          /* Number of samples in the window */
+  float      sum;            /* Sum of the samples in the window */
+};
+
+/* Real FFT data */
+
+struct fft_s
+{
+  FAR float *twiddle;        /* n floats: cos and sin of -2*PI*k/n
+                              * for k < n/2
+                              */
+  size_t     n;              /* Number of points, a power of 2 */
+};
+
 /****************************************************************************
  * Public Functions Prototypes
  ****************************************************************************/
@@ -444,6 +495,28 @@ void foc_process(FAR struct foc_data_s *foc,
                  FAR abc_frame_t *i_abc,
                  FAR phase_angle_t *angle);
 
+/* Filters */
+
+void fir_init(FAR struct fir_s *fir, FAR const float *coeffs,
+              FAR float *state, size_t ntaps);
+void fir_process(FAR struct fir_s *fir, FAR const float *in,
+                 FAR float *out, size_t n);
+size_t fir_decimate(FAR struct fir_s *fir, FAR const float *in,
+                    FAR float *out, size_t n, size_t factor);
+
+void biquad_init(FAR struct biquad_s *bq, FAR const float *coeffs,
+                 FAR float *state, size_t nstages);
+void biquad_process(FAR struct biquad_s *bq, FAR const float *in,
+                    FAR float *out, size_t n);
+
+void movavg_init(FAR struct movavg_s *ma, FAR float *buf, size_t len);
+float movavg_process(FAR struct movavg_s *ma, float x);
+
+/* Real FFT */
+
+int fft_init(FAR struct fft_s *fft, FAR float *twiddle, size_t n);
+void fft_real(FAR struct fft_s *fft, FAR float *buf);
+
 /* BLDC/PMSM motor observers */
 
 void motor_observer_init(FAR struct motor_observer_s *observer,
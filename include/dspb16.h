@@ -0,0 +1,401 @@
+/****************************************************************************
+ * include/dspb16.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_DSPB16_H
+#define __INCLUDE_DSPB16_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/compiler.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <fixedmath.h>
+
+#include <assert.h>
+
+/* The fixed-point version of libdsp uses the b16_t (Q16.16) type of
+ * fixedmath.h.  It needs no floating point unit, only 32x32->64 bit
+ * multiplications.
+ */
+
+#ifndef CONFIG_HAVE_LONG_LONG
+#  error CONFIG_HAVE_LONG_LONG must be selected
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Disable DEBUGASSERT macro if LIBDSP debug is not enabled */
+
+#ifdef CONFIG_LIBDSP_DEBUG
+#  ifndef CONFIG_DEBUG_ASSERTIONS
+#    warning "Need CONFIG_DEBUG_ASSERTIONS to work properly"
+#  endif
+#else
+#  undef DEBUGASSERT
+#  define DEBUGASSERT(x)
+#endif
+
+/* Phase rotation direction */
+
+#define DIR_CW_B16   (b16ONE)
+#define DIR_CCW_B16  (-b16ONE)
+
+/* Some math constants ******************************************************/
+
+#define SQRT3_BY_TWO_B16     (0x0000ddb4)   /* 0.866025 */
+#define SQRT3_BY_THREE_B16   (0x000093cd)   /* 0.57735 */
+#define ONE_BY_SQRT3_B16     (0x000093cd)   /* 0.57735 */
+#define TWO_BY_SQRT3_B16     (0x0001279a)   /* 1.15470 */
+
+/* Some useful macros *******************************************************/
+
+/* Single-pole digital low pass filter, see LP_FILTER() in dsp.h */
+
+#define LP_FILTER_B16(val, sample, filter) \
+  val -= b16mulb16(filter, (val - sample))
+
+/* Maximum voltage for SVM3 without overmodulation, see
+ * SVM3_BASE_VOLTAGE_GET() in dsp.h
+ */
+
+#define SVM3_BASE_VOLTAGE_GET_B16(vbus) b16mulb16(vbus, SQRT3_BY_THREE_B16)
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* These are the fixed-point versions of the types of dsp.h */
+
+/* Phase angle with its sine and cosine */
+
+struct phase_angle_b16_s
+{
+  b16_t angle;                 /* Phase angle in radians <0, 2PI> */
+  b16_t sin;                   /* Phase angle sine */
+  b16_t cos;                   /* Phase angle cosine */
+};
+
+typedef struct phase_angle_b16_s phase_angle_b16_t;
+
+/* Number saturaton */
+
+struct b16_sat_s
+{
+  b16_t min;                   /* Lower limit */
+  b16_t max;                   /* Upper limit */
+};
+
+typedef struct b16_sat_s b16_sat_t;
+
+/* PI/PID controller state structure */
+
+struct pid_controller_b16_s
+{
+  b16_t     out;               /* Controller output */
+  b16_sat_t sat;               /* Output saturation */
+  b16_t     err;               /* Current error value */
+  b16_t     err_prev;          /* Previous error value */
+  b16_t     KP;                /* Proportional coefficient */
+  b16_t     KI;                /* Integral coefficient */
+  b16_t     KD;                /* Derivative coefficient */
+  b16_t     part[3];           /* 0 - proporitonal part
+                                * 1 - integral part
+                                * 2 - derivative part
+                                */
+};
+
+typedef struct pid_controller_b16_s pid_controller_b16_t;
+
+/* ABC frame (3 phase vector) */
+
+struct abc_frame_b16_s
+{
+  b16_t a;                     /* A component */
+  b16_t b;                     /* B component */
+  b16_t c;                     /* C component */
+};
+
+typedef struct abc_frame_b16_s abc_frame_b16_t;
+
+/* Alpha-beta frame (2 phase vector) */
+
+struct ab_frame_b16_s
+{
+  b16_t a;                     /* Alpha component */
+  b16_t b;                     /* Beta component */
+};
+
+typedef struct ab_frame_b16_s ab_frame_b16_t;
+
+/* Direct-quadrature frame */
+
+struct dq_frame_b16_s
+{
+  b16_t d;                     /* Driect component */
+  b16_t q;                     /* Quadrature component */
+};
+
+typedef struct dq_frame_b16_s dq_frame_b16_t;
+
+/* Space Vector Modulation data for 3-phase system */
+
+struct svm3_state_b16_s
+{
+  uint8_t sector;              /* Current space vector sector */
+  b16_t   d_u;                 /* Duty cycle for phase U */
+  b16_t   d_v;                 /* Duty cycle for phase V */
+  b16_t   d_w;                 /* Duty cycle for phase W */
+  b16_t   d_max;               /* Duty cycle max */
+  b16_t   d_min;               /* Duty cycle min */
+};
+
+/* Field oriented control (FOC) data */
+
+struct foc_data_b16_s
+{
+  abc_frame_b16_t      v_abc;    /* Voltage in ABC frame */
+  ab_frame_b16_t       v_ab;     /* Voltage in alpha-beta frame */
+  dq_frame_b16_t       v_dq;     /* Voltage in dq frame */
+  ab_frame_b16_t       v_ab_mod; /* Modulation voltage normalized to
+                                  * magnitude (0.0, 1.0)
+                                  */
+
+  abc_frame_b16_t      i_abc;    /* Current in ABC frame */
+  ab_frame_b16_t       i_ab;     /* Current in apha-beta frame */
+  dq_frame_b16_t       i_dq;     /* Current in dq frame */
+  dq_frame_b16_t       i_dq_err; /* DQ current error */
+
+  dq_frame_b16_t       i_dq_ref; /* Current dq reference frame */
+  pid_controller_b16_t id_pid;   /* Current d-axis component PI controller */
+  pid_controller_b16_t iq_pid;   /* Current q-axis component PI controller */
+
+  b16_t vdq_mag_max;             /* Maximum dq voltage magnitude */
+  b16_t vab_mod_scale;           /* Voltage alpha-beta modulation scale */
+};
+
+/* FIR filter data, see struct fir_s in dsp.h */
+
+struct fir_b16_s
+{
+  FAR const b16_t *coeffs;     /* ntaps coefficients */
+  FAR b16_t       *state;      /* 2*ntaps samples */
+  size_t           ntaps;      /* Number of taps */
+  size_t           pos;        /* Position of the newest sample */
+  size_t           phase;      /* Decimation phase */
+};
+
+/* Cascade of biquad filters in the direct form I, which suits fixed-point
+ * arithmetic better than the transposed direct form II of the float
+ * version.  The coefficients are the same as for struct biquad_s, but the
+ * state has x[n-1], x[n-2], y[n-1], y[n-2] for each stage.
+ */
+
+struct biquad_b16_s
+{
+  FAR const b16_t *coeffs;     /* 5*nstages coefficients */
+  FAR b16_t       *state;      /* 4*nstages state variables */
+  size_t           nstages;    /* Number of stages */
+};
+
+/* Moving average filter data.  The sum is exact, there is no drift. */
+
+struct movavg_b16_s
+{
+  FAR b16_t *buf;              /* len most recent samples */
+  size_t     len;              /* Length of the window */
+  size_t     pos;              /* Position of the oldest sample */
+  size_t     count;            /* Number of samples in the window */
+  b32_t      sum;              /* Sum of the samples in the window */
+};
+
+/* Real FFT data */
+
+struct fft_b16_s
+{
+  FAR b16_t *twiddle;          /* n values: cos and sin of -2*PI*k/n
+                                * for k < n/2
+                                */
+  size_t     n;                /* Number of points, a power of 2 */
+};
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: b16_add_sat
+ *
+ * Description:
+ *   Saturating addition.  A control loop must clip rather than wrap
+ *   around when a sum gets out of range.
+ *
+ ****************************************************************************/
+
+static inline b16_t b16_add_sat(b16_t a, b16_t b)
+{
+  b32_t sum = (b32_t)a + b;
+
+  if (sum > INT32_MAX)
+    {
+      return INT32_MAX;
+    }
+  else if (sum < INT32_MIN)
+    {
+      return INT32_MIN;
+    }
+
+  return (b16_t)sum;
+}
+
+/****************************************************************************
+ * Name: b32_to_b16_sat
+ *
+ * Description:
+ *   Round a b32_t (e.g. an accumulated sum of b16_t products) to b16_t
+ *   and saturate it.
+ *
+ ****************************************************************************/
+
+static inline b16_t b32_to_b16_sat(b32_t a)
+{
+  a = (a + 0x8000) >> 16;
+
+  if (a > INT32_MAX)
+    {
+      return INT32_MAX;
+    }
+  else if (a < INT32_MIN)
+    {
+      return INT32_MIN;
+    }
+
+  return (b16_t)a;
+}
+
+/****************************************************************************
+ * Public Functions Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/* Math functions */
+
+void f_saturate_b16(FAR b16_t *val, b16_t min, b16_t max);
+
+b16_t vector2d_mag_b16(b16_t x, b16_t y);
+void vector2d_saturate_b16(FAR b16_t *x, FAR b16_t *y, b16_t max);
+
+void dq_saturate_b16(FAR dq_frame_b16_t *dq, b16_t max);
+b16_t dq_mag_b16(FAR dq_frame_b16_t *dq);
+
+/* PID controller functions */
+
+void pid_controller_init_b16(FAR pid_controller_b16_t *pid,
+                             b16_t KP, b16_t KI, b16_t KD);
+void pi_controller_init_b16(FAR pid_controller_b16_t *pid,
+                            b16_t KP, b16_t KI);
+void pid_saturation_set_b16(FAR pid_controller_b16_t *pid, b16_t min,
+                            b16_t max);
+void pi_saturation_set_b16(FAR pid_controller_b16_t *pid, b16_t min,
+                           b16_t max);
+void pid_integral_reset_b16(FAR pid_controller_b16_t *pid);
+void pi_integral_reset_b16(FAR pid_controller_b16_t *pid);
+b16_t pi_controller_b16(FAR pid_controller_b16_t *pid, b16_t err);
+b16_t pid_controller_b16(FAR pid_controller_b16_t *pid, b16_t err);
+
+/* Transformation functions */
+
+void clarke_transform_b16(FAR abc_frame_b16_t *abc,
+                          FAR ab_frame_b16_t *ab);
+void inv_clarke_transform_b16(FAR ab_frame_b16_t *ab,
+                              FAR abc_frame_b16_t *abc);
+void park_transform_b16(FAR phase_angle_b16_t *angle,
+                        FAR ab_frame_b16_t *ab,
+                        FAR dq_frame_b16_t *dq);
+void inv_park_transform_b16(FAR phase_angle_b16_t *angle,
+                            FAR dq_frame_b16_t *dq,
+                            FAR ab_frame_b16_t *ab);
+
+/* Phase angle related functions */
+
+void angle_norm_b16(FAR b16_t *angle, b16_t per, b16_t bottom, b16_t top);
+void angle_norm_2pi_b16(FAR b16_t *angle, b16_t bottom, b16_t top);
+void phase_angle_update_b16(FAR struct phase_angle_b16_s *angle, b16_t val);
+
+/* 3-phase system space vector modulation */
+
+void svm3_init_b16(FAR struct svm3_state_b16_s *s, b16_t min, b16_t max);
+void svm3_b16(FAR struct svm3_state_b16_s *s, FAR ab_frame_b16_t *ab);
+void svm3_current_correct_b16(FAR struct svm3_state_b16_s *s,
+                              int32_t *c0, int32_t *c1, int32_t *c2);
+
+/* Filters */
+
+void fir_init_b16(FAR struct fir_b16_s *fir, FAR const b16_t *coeffs,
+                  FAR b16_t *state, size_t ntaps);
+void fir_process_b16(FAR struct fir_b16_s *fir, FAR const b16_t *in,
+                     FAR b16_t *out, size_t n);
+size_t fir_decimate_b16(FAR struct fir_b16_s *fir, FAR const b16_t *in,
+                        FAR b16_t *out, size_t n, size_t factor);
+
+void biquad_init_b16(FAR struct biquad_b16_s *bq, FAR const b16_t *coeffs,
+                     FAR b16_t *state, size_t nstages);
+void biquad_process_b16(FAR struct biquad_b16_s *bq, FAR const b16_t *in,
+                        FAR b16_t *out, size_t n);
+
+void movavg_init_b16(FAR struct movavg_b16_s *ma, FAR b16_t *buf,
+                     size_t len);
+b16_t movavg_process_b16(FAR struct movavg_b16_s *ma, b16_t x);
+
+/* Real FFT */
+
+int fft_init_b16(FAR struct fft_b16_s *fft, FAR b16_t *twiddle, size_t n);
+void fft_real_b16(FAR struct fft_b16_s *fft, FAR b16_t *buf);
+
+/* Field Oriented control */
+
+void foc_vbase_update_b16(FAR struct foc_data_b16_s *foc, b16_t vbase);
+void foc_idq_ref_set_b16(FAR struct foc_data_b16_s *data, b16_t d, b16_t q);
+
+void foc_init_b16(FAR struct foc_data_b16_s *data,
+                  b16_t id_kp, b16_t id_ki, b16_t iq_kp, b16_t iq_ki);
+void foc_process_b16(FAR struct foc_data_b16_s *foc,
+                     FAR abc_frame_b16_t *i_abc,
+                     FAR phase_angle_b16_t *angle);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* __INCLUDE_DSPB16_H */
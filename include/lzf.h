@@ -31,6 +31,15 @@
 #ifndef __INCLUDE_LZF_H
 #define __INCLUDE_LZF_H
 
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
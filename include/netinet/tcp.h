@@ -69,5 +69,9 @@
 #define TCP_KEEPCNT   (__SO_PROTOCOL + 3) /* Number of keepalives before death
                                            * Argument: max retry count */
 #define TCP_MAXSEG    (__SO_PROTOCOL + 4) /* The maximum segment size */
+#define TCP_CONGESTION (__SO_PROTOCOL + 5) /* Congestion control algorithm
+                                            * Argument: name string */
+#define TCP_QUICKACK  (__SO_PROTOCOL + 6) /* Do not delay ACKs
+                                           * Argument: int boolean */
 
 #endif /* __INCLUDE_NETINET_TCP_H */
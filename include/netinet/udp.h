@@ -51,5 +51,8 @@
 #define UDP_BINDTODEVICE   (__SO_PROTOCOL + 0) /* Bind this UDP socket to a
                                                 * specific network device.
                                                 */
+#define UDP_SEGMENT        (__SO_PROTOCOL + 1) /* Split sends into datagrams
+                                                * of this size (int).
+                                                */
 
 #endif /* __INCLUDE_NETINET_UDP_H */
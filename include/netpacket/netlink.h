@@ -306,6 +306,13 @@
 #define IFA_F_SECONDARY      0x01
 #define IFA_F_PERMANENT      0x80
 
+/* Values for rta_type */
+
+#define IFA_UNSPEC           0
+#define IFA_ADDRESS          1  /* Interface address */
+#define IFA_LOCAL            2  /* Local address */
+#define IFA_LABEL            3  /* Name of the interface */
+
 /* Definitions for struct ifinfomsg *****************************************/
 
 #define IFLA_RTA(r)          ((FAR struct rtattr *) \
@@ -47,6 +47,43 @@
 #include <nuttx/config.h>
 #include <stdint.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Packet socket options (level SOL_PACKET) */
+
+#define PACKET_RX_RING    1 /* Set up the receive ring (set only).
+                             * arg: struct tpacket_req.  A tp_block_nr
+                             * of zero releases the ring.
+                             */
+#define PACKET_STATISTICS 2 /* Read and clear the counters (get only).
+                             * arg: struct tpacket_stats
+                             */
+
+/* Values of tp_status.  A frame of the ring belongs to the network while
+ * its status is TP_STATUS_KERNEL.  The network fills the frame and sets
+ * TP_STATUS_USER.  The application hands the frame back by setting
+ * TP_STATUS_KERNEL again.
+ */
+
+#define TP_STATUS_KERNEL          0
+#define TP_STATUS_USER            (1u << 0)  /* The frame holds a packet */
+#define TP_STATUS_LOSING          (1u << 2)  /* Packets were dropped before */
+#define TP_STATUS_TS_SOFTWARE     (1u << 29) /* tp_sec/tp_usec: Software */
+#define TP_STATUS_TS_RAW_HARDWARE (1u << 31) /* tp_sec/tp_usec: Hardware */
+
+/* Layout of the frames of the ring:  The frame starts with the struct
+ * tpacket_hdr followed by a struct sockaddr_ll.  The packet itself starts
+ * at the offset tp_mac from the beginning of the frame.
+ */
+
+#define TPACKET_ALIGNMENT 16
+#define TPACKET_ALIGN(x)  (((x) + TPACKET_ALIGNMENT - 1) & \
+                           ~(TPACKET_ALIGNMENT - 1))
+#define TPACKET_HDRLEN    (TPACKET_ALIGN(sizeof(struct tpacket_hdr)) + \
+                           sizeof(struct sockaddr_ll))
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -58,4 +95,39 @@ struct sockaddr_ll
   int16_t  sll_ifindex;
 };
 
+/* The geometry of the receive ring, see PACKET_RX_RING.  The ring is
+ * tp_block_nr blocks of tp_block_size bytes.  Each block holds
+ * tp_block_size / tp_frame_size frames and tp_frame_nr is the total number
+ * of frames.  The ring is mapped into the application with mmap().
+ */
+
+struct tpacket_req
+{
+  unsigned int tp_block_size; /* Size of a block */
+  unsigned int tp_block_nr;   /* Number of blocks */
+  unsigned int tp_frame_size; /* Size of a frame */
+  unsigned int tp_frame_nr;   /* Total number of frames */
+};
+
+/* The header at the beginning of each frame of the receive ring */
+
+struct tpacket_hdr
+{
+  uint32_t tp_status;  /* See TP_STATUS_* definitions */
+  uint32_t tp_len;     /* Length of the packet */
+  uint32_t tp_snaplen; /* Number of bytes of the packet in the frame */
+  uint16_t tp_mac;     /* Offset of the packet from the frame start */
+  uint16_t tp_net;     /* Offset of the network header */
+  uint32_t tp_sec;     /* Receive time:  Seconds */
+  uint32_t tp_usec;    /* Receive time:  Microseconds */
+};
+
+/* The counters of PACKET_STATISTICS */
+
+struct tpacket_stats
+{
+  unsigned int tp_packets; /* Packets accepted by the filter */
+  unsigned int tp_drops;   /* Packets dropped because the ring was full */
+};
+
 #endif /* __INCLUDE_NETPACKET_PACKET_H */
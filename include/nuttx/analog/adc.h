@@ -109,8 +109,50 @@ struct adc_callback_s
    */
 
   CODE int (*au_receive)(FAR struct adc_dev_s *dev, uint8_t ch, int32_t data);
+
+#ifdef CONFIG_ADC_STREAM
+  /* This method is called from the lower half each time the DMA has filled
+   * one block of its streaming buffer, e.g. from the half-transfer and the
+   * transfer-complete interrupts of a circular DMA into a double buffer.
+   * The block must stay valid until the next block is reported:  The lower
+   * half must not write to it before then.  The lower half invalidates the
+   * data cache for the block, where needed, before the call.
+   *
+   * Input Parameters:
+   *   dev    - The ADC device structure that was previously registered by
+   *            adc_register()
+   *   buffer - The block of samples
+   *   nbytes - The size of the block in bytes
+   *
+   * Returned Value:
+   *   Zero on success; a negated errno value on failure.
+   */
+
+  CODE int (*au_stream)(FAR struct adc_dev_s *dev, FAR const void *buffer,
+                        size_t nbytes);
+#endif
 };
 
+#ifdef CONFIG_ADC_STREAM
+/* The argument of the ANIOC_STREAM_START command */
+
+struct adc_stream_s
+{
+  /* Provided by the caller */
+
+  uint32_t     as_rate;                  /* Conversion (trigger) rate in Hz,
+                                          * 0: The board-configured trigger */
+
+  /* Returned by the lower half.  read() returns one block at a time, the
+   * samples in the order of the converted channels.
+   */
+
+  uint32_t     as_blocksize;             /* Size of one block in bytes */
+  uint8_t      as_samplesize;            /* Size of one sample in bytes */
+  uint8_t      as_nchannels;             /* Number of channels per scan */
+};
+#endif
+
 /* This describes on ADC message */
 
 begin_packed_struct struct adc_msg_s
@@ -172,6 +214,18 @@ struct adc_ops_s
   /* All ioctl calls will be routed through this method */
 
   CODE int (*ao_ioctl)(FAR struct adc_dev_s *dev, int cmd, unsigned long arg);
+
+#ifdef CONFIG_ADC_STREAM
+  /* Start continuous conversions with DMA into a double buffer of the
+   * lower half, reporting each full block through au_stream(), with the
+   * conversions paced by the trigger timer at stream->as_rate.  Called
+   * with stream == NULL to stop.  Optional; lower halves that leave it
+   * NULL do not support streaming.
+   */
+
+  CODE int (*ao_stream)(FAR struct adc_dev_s *dev,
+                        FAR struct adc_stream_s *stream);
+#endif
 };
 
 /* This is the device structure used by the driver.  The caller of
@@ -193,6 +247,14 @@ struct adc_dev_s
   sem_t                       ad_closesem;   /* Locks out new opens while close is in progress */
   sem_t                       ad_recvsem;    /* Used to wakeup user waiting for space in ad_recv.buffer */
   struct adc_fifo_s           ad_recv;       /* Describes receive FIFO */
+#ifdef CONFIG_ADC_STREAM
+  bool                        ad_streaming;  /* DMA streaming is running */
+  FAR const void             *ad_stbuffer;   /* The last block reported */
+  size_t                      ad_stnbytes;   /* The size of that block */
+  volatile uint32_t           ad_stseq;      /* Number of blocks reported */
+  uint32_t                    ad_stread;     /* Number of the last block read */
+  uint32_t                    ad_stoverruns; /* Number of blocks lost */
+#endif
 
   /* The following is a list of poll structures of threads waiting for
    * driver events. The 'struct pollfd' reference for each open is also
@@ -64,9 +64,19 @@
 #define ANIOC_WDOG_LOWER  _ANIOC(0x0003)  /* Set lower threshold for watchdog
                                            * IN: Threshold value
                                            * OUT: None */
+#define ANIOC_STREAM_START _ANIOC(0x0004) /* Start DMA streaming
+                                           * IN: struct adc_stream_s *
+                                           * OUT: Block and sample sizes */
+#define ANIOC_STREAM_STOP _ANIOC(0x0005)  /* Stop DMA streaming
+                                           * IN: None
+                                           * OUT: None */
+#define ANIOC_STREAM_OVERRUNS _ANIOC(0x0006) /* Get and clear the number of
+                                              * blocks lost
+                                              * IN: uint32_t *
+                                              * OUT: Number of blocks */
 
 #define AN_FIRST          0x0001          /* First common command */
-#define AN_NCMDS          3               /* Number of common commands */
+#define AN_NCMDS          6               /* Number of common commands */
 
 /* User defined ioctl commands are also supported. These will be forwarded
  * by the upper-half driver to the lower-half driver via the ioctl()
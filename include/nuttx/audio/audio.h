@@ -62,6 +62,7 @@
 #include <nuttx/spi/spi.h>
 
 #include <queue.h>
+#include <time.h>
 
 #ifdef CONFIG_AUDIO
 
@@ -109,6 +110,18 @@
  * AUDIOIOC_STOP - Stop Audio streaming
  *
  *   ioctl argument:  None
+ *
+ * AUDIOIOC_GETPOSITION - Get the stream position
+ *
+ *   ioctl argument:  Pointer to the audio_position_s structure to receive
+ *                    the number of bytes of the buffers completed since
+ *                    AUDIOIOC_START and the time the last one completed.
+ *
+ * AUDIOIOC_GETSTATS - Get the transfer statistics of the lower half
+ *
+ *   ioctl argument:  Pointer to the audio_stats_s structure to receive the
+ *                    buffer and xrun counts.  Only supported by lower
+ *                    halves that keep them.
  */
 
 #define AUDIOIOC_GETCAPS            _AUDIOIOC(1)
@@ -128,6 +141,8 @@
 #define AUDIOIOC_UNREGISTERMQ       _AUDIOIOC(15)
 #define AUDIOIOC_HWRESET            _AUDIOIOC(16)
 #define AUDIOIOC_SETBUFFERINFO      _AUDIOIOC(17)
+#define AUDIOIOC_GETPOSITION        _AUDIOIOC(18)
+#define AUDIOIOC_GETSTATS           _AUDIOIOC(19)
 
 /* Audio Device Types *******************************************************/
 
@@ -416,6 +431,34 @@ struct ap_buffer_info_s
 };
 #endif
 
+/* This structure reports the position of the stream.  The buffers are
+ * played (or recorded) at the sample rate, so an application can tell the
+ * current position to within a sample from nbytes, the age of ts and the
+ * sample rate, without waiting for the next buffer to complete.
+ */
+
+struct audio_position_s
+{
+  uint64_t         nbytes;  /* Bytes of the buffers completed since start */
+  struct timespec  ts;      /* Time since boot when the last buffer
+                             * completed */
+};
+
+/* This structure reports the transfer statistics of a lower half.  An
+ * underrun is counted when a transmit buffer completes with no further
+ * buffer queued (other than at the end of the stream), an overrun when a
+ * receive buffer completes with no free buffer queued.  In both cases the
+ * stream has a gap.
+ */
+
+struct audio_stats_s
+{
+  uint32_t         txbuffers;  /* Transmit buffers completed */
+  uint32_t         rxbuffers;  /* Receive buffers completed */
+  uint32_t         underruns;  /* Transmit underruns */
+  uint32_t         overruns;   /* Receive overruns */
+};
+
 /* This structure describes an Audio Pipeline Buffer */
 
 struct ap_buffer_s
@@ -49,6 +49,7 @@
 #include <elf.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/symtab.h>
 #include <nuttx/binfmt/binfmt.h>
 
 /****************************************************************************
@@ -73,6 +74,10 @@
 #  define CONFIG_ELF_BUFFERINCR 32
 #endif
 
+#ifndef CONFIG_ELF_READAHEAD
+#  define CONFIG_ELF_READAHEAD 0
+#endif
+
 /* Allocation array size and indices */
 
 #define LIBELF_ELF_ALLOC     0
@@ -116,6 +121,20 @@ struct elf_loadinfo_s
   FAR Elf_Shdr      *shdr;       /* Buffered ELF section headers */
   uint8_t           *iobuffer;   /* File I/O buffer */
 
+#if CONFIG_ELF_READAHEAD > 0
+  FAR uint8_t       *rabuffer;   /* Read-ahead buffer */
+  off_t              raoffset;   /* File offset of rabuffer[0] */
+  size_t             ralen;      /* Number of valid bytes in rabuffer[] */
+#endif
+
+#ifdef CONFIG_ELF_XIP
+  FAR const uint8_t *xipbase;    /* Address of the mapped file (or NULL) */
+#endif
+
+#ifdef CONFIG_SYMTAB_HASH
+  struct symtab_hash_s exphash;  /* Hash table of the exported symbols */
+#endif
+
   /* Constructors and destructors */
 
 #ifdef CONFIG_BINFMT_CONSTRUCTORS
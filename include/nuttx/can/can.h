@@ -47,6 +47,9 @@
 #include <sys/types.h>
 #include <stdint.h>
 #include <stdbool.h>
+#ifdef CONFIG_CAN_TIMESTAMP
+#  include <sys/time.h>
+#endif
 
 #include <nuttx/list.h>
 #include <nuttx/fs/fs.h>
@@ -436,6 +439,9 @@ begin_packed_struct struct can_hdr_s
 #endif
   uint8_t      ch_extid  : 1; /* Extended ID indication */
   uint8_t      ch_unused : 1; /* Unused */
+#ifdef CONFIG_CAN_TIMESTAMP
+  struct timeval ch_ts;       /* Time when the frame was received */
+#endif
 } end_packed_struct;
 
 #else
@@ -448,6 +454,9 @@ begin_packed_struct struct can_hdr_s
   uint8_t      ch_error  : 1; /* 1=ch_id is an error report */
 #endif
   uint8_t      ch_unused : 2; /* Unused */
+#ifdef CONFIG_CAN_TIMESTAMP
+  struct timeval ch_ts;       /* Time when the frame was received */
+#endif
 } end_packed_struct;
 #endif
 
@@ -42,6 +42,7 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /****************************************************************************
@@ -49,6 +50,7 @@
  ****************************************************************************/
 
 #define AES128_KEY_SIZE    16
+#define AES128_BLOCK_SIZE  16
 
 /****************************************************************************
  * Public Types
@@ -164,6 +166,68 @@ void aes_encipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
 void aes_decipher(FAR struct aes_state_s *state, FAR uint8_t *blocks,
                   int nblk);
 
+/****************************************************************************
+ * Name: aes_swcypher
+ *
+ * Description:
+ *   AES128 encryption or decryption of a buffer in ECB, CBC or CTR mode
+ *   with the software implementation.  This has the interface of
+ *   aes_cypher() and is the last resort of crypto_cypher().
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -ENOTSUP if the key or mode is not supported
+ *   -EINVAL if a parameter is invalid
+ *
+ ****************************************************************************/
+
+int aes_swcypher(FAR void *out, FAR const void *in, uint32_t size,
+                 FAR const void *iv, FAR const void *key, uint32_t keysize,
+                 int mode, int encrypt);
+
+/****************************************************************************
+ * Name: aes_gcm_encrypt
+ *
+ * Description:
+ *   AES128-GCM authenticated encryption of 'len' bytes from 'in' to 'out'
+ *   ('in' may be equal to 'out').  The 'aad' is authenticated but not
+ *   encrypted.  A tag of 'taglen' (at most 16) bytes is returned in 'tag'.
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -ENOTSUP if the key size is not supported
+ *   -EINVAL if a parameter is invalid
+ *
+ ****************************************************************************/
+
+int aes_gcm_encrypt(FAR const uint8_t *key, uint32_t keysize,
+                    FAR const uint8_t *iv, size_t ivlen,
+                    FAR const uint8_t *aad, size_t aadlen,
+                    FAR const uint8_t *in, FAR uint8_t *out, size_t len,
+                    FAR uint8_t *tag, size_t taglen);
+
+/****************************************************************************
+ * Name: aes_gcm_decrypt
+ *
+ * Description:
+ *   AES128-GCM authenticated decryption of 'len' bytes from 'in' to 'out'
+ *   ('in' may be equal to 'out').  If the tag does not match, the output is
+ *   cleared.
+ *
+ * Returned Value:
+ *   0 if OK
+ *   -EBADMSG if the tag does not match
+ *   -ENOTSUP if the key size is not supported
+ *   -EINVAL if a parameter is invalid
+ *
+ ****************************************************************************/
+
+int aes_gcm_decrypt(FAR const uint8_t *key, uint32_t keysize,
+                    FAR const uint8_t *iv, size_t ivlen,
+                    FAR const uint8_t *aad, size_t aadlen,
+                    FAR const uint8_t *in, FAR uint8_t *out, size_t len,
+                    FAR const uint8_t *tag, size_t taglen);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
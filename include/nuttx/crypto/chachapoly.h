@@ -0,0 +1,98 @@
+/****************************************************************************
+ * include/nuttx/crypto/chachapoly.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_CRYPTO_CHACHAPOLY_H
+#define __INCLUDE_NUTTX_CRYPTO_CHACHAPOLY_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define CHACHA20_KEY_LENGTH    32
+#define CHACHA20_NONCE_LENGTH  12
+#define CHACHA20_BLOCK_LENGTH  64
+#define POLY1305_KEY_LENGTH    32
+#define POLY1305_TAG_LENGTH    16
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct poly1305_ctx_s
+{
+  uint32_t r[5];                      /* Clamped key, 26-bit limbs */
+  uint32_t h[5];                      /* Accumulator, 26-bit limbs */
+  uint32_t pad[4];                    /* Key part added at the end */
+  size_t leftover;                    /* Bytes in buffer[] */
+  uint8_t buffer[POLY1305_TAG_LENGTH];
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* ChaCha20 stream cipher as in RFC 8439.  'counter' is the block counter of
+ * the first block.  Encryption and decryption are the same operation and
+ * may be done in place.
+ */
+
+void chacha20(FAR uint8_t *out, FAR const uint8_t *in, size_t len,
+              FAR const uint8_t *key, FAR const uint8_t *nonce,
+              uint32_t counter);
+
+/* Poly1305 one-time authenticator */
+
+void poly1305_init(FAR struct poly1305_ctx_s *ctx, FAR const uint8_t *key);
+void poly1305_update(FAR struct poly1305_ctx_s *ctx, FAR const uint8_t *in,
+                     size_t inlen);
+void poly1305_final(FAR struct poly1305_ctx_s *ctx, FAR uint8_t *tag);
+
+/* ChaCha20-Poly1305 AEAD as in RFC 8439.  chachapoly_decrypt() returns
+ * -EBADMSG and clears the output if the tag does not match.
+ */
+
+void chachapoly_encrypt(FAR const uint8_t *key, FAR const uint8_t *nonce,
+                        FAR const uint8_t *aad, size_t aadlen,
+                        FAR const uint8_t *in, FAR uint8_t *out,
+                        size_t len, FAR uint8_t *tag);
+int chachapoly_decrypt(FAR const uint8_t *key, FAR const uint8_t *nonce,
+                       FAR const uint8_t *aad, size_t aadlen,
+                       FAR const uint8_t *in, FAR uint8_t *out,
+                       size_t len, FAR const uint8_t *tag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_CRYPTO_CHACHAPOLY_H */
@@ -41,33 +41,91 @@
  ****************************************************************************/
 
 #include <nuttx/config.h>
+
+#include <stdint.h>
 #include <debug.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#if defined(CONFIG_CRYPTO_AES)
-#  define AES_MODE_MIN 1
+#define AES_MODE_MIN 1
 
-#  define AES_MODE_ECB 1
-#  define AES_MODE_CBC 2
-#  define AES_MODE_CTR 3
-#  define AES_MODE_CFB 4
+#define AES_MODE_ECB 1
+#define AES_MODE_CBC 2
+#define AES_MODE_CTR 3
+#define AES_MODE_CFB 4
 
-#  define AES_MODE_MAX 4
+#define AES_MODE_MAX 4
 
-#  define AES_MODE_MAC 0x80000000
+#define AES_MODE_MAC 0x80000000
 
-#  define AES_MODE_MASK 0xffff
-#endif
+#define AES_MODE_MASK 0xffff
 
 #define CYPHER_ENCRYPT 1
 #define CYPHER_DECRYPT 0
 
-/*******************************************************************************
+/* Priorities of crypto providers.  Providers with a higher priority are
+ * tried first.
+ */
+
+#define CRYPTO_PRIO_SOFTWARE   0
+#define CRYPTO_PRIO_HARDWARE   100
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifndef __ASSEMBLY__
+
+/* A crypto provider, typically the cypher engine of the SoC, that is
+ * registered with crypto_register().  The cypher method has the interface
+ * of aes_cypher().  It returns -ENOTSUP if it does not support the mode,
+ * the key size or the buffers of a request.  It must not modify the output
+ * buffer in that case so that the next provider can handle the request.
+ */
+
+struct crypto_provider_s
+{
+  FAR struct crypto_provider_s *flink; /* Supports a singly linked list */
+  FAR const char *name;                /* Name of the provider */
+  uint8_t priority;                    /* See CRYPTO_PRIO_* */
+
+  CODE int (*cypher)(FAR struct crypto_provider_s *provider,
+                     FAR void *out, FAR const void *in, uint32_t size,
+                     FAR const void *iv, FAR const void *key,
+                     uint32_t keysize, int mode, int encrypt);
+};
+
+#ifdef CONFIG_CRYPTO_ASYNC
+/* An asynchronous request submitted with crypto_submit().  The request is
+ * completed by calling 'done' on the low priority work queue with the
+ * result of crypto_cypher() in 'result'.
+ */
+
+struct crypto_req_s
+{
+  FAR struct crypto_req_s *flink;      /* Supports a singly linked list */
+  FAR void *out;                       /* Output buffer */
+  FAR const void *in;                  /* Input buffer */
+  uint32_t size;                       /* Size of the buffers in bytes */
+  FAR const void *iv;                  /* Initialization vector */
+  FAR const void *key;                 /* The key */
+  uint32_t keysize;                    /* Size of the key in bytes */
+  int mode;                            /* See AES_MODE_* */
+  int encrypt;                         /* CYPHER_ENCRYPT or CYPHER_DECRYPT */
+  int result;                          /* Returned: the result */
+
+  CODE void (*done)(FAR struct crypto_req_s *req);
+  FAR void *arg;                       /* For use by 'done' */
+};
+#endif
+
+#endif /* __ASSEMBLY__ */
+
+/****************************************************************************
  * Public Data
- ******************************************************************************/
+ ****************************************************************************/
 
 #ifndef __ASSEMBLY__
 
@@ -80,9 +138,9 @@ extern "C"
 #define EXTERN extern
 #endif
 
-/*******************************************************************************
+/****************************************************************************
  * Public Function Prototypes
- ******************************************************************************/
+ ****************************************************************************/
 
 int up_cryptoinitialize(void);
 
@@ -92,6 +150,59 @@ int aes_cypher(FAR void *out, FAR const void *in, uint32_t size,
                int mode, int encrypt);
 #endif
 
+/****************************************************************************
+ * Name: crypto_register
+ *
+ * Description:
+ *   Register a crypto provider.  crypto_cypher() will then offer requests to
+ *   the provider before the providers of a lower priority.
+ *
+ ****************************************************************************/
+
+int crypto_register(FAR struct crypto_provider_s *provider);
+
+/****************************************************************************
+ * Name: crypto_unregister
+ *
+ * Description:
+ *   Unregister a crypto provider registered with crypto_register().
+ *
+ ****************************************************************************/
+
+int crypto_unregister(FAR struct crypto_provider_s *provider);
+
+/****************************************************************************
+ * Name: crypto_cypher
+ *
+ * Description:
+ *   Encrypt or decrypt a buffer with the first provider that supports the
+ *   request.  The registered providers are tried in the order of their
+ *   priority, then aes_cypher() (CONFIG_CRYPTO_AES) and finally the software
+ *   AES (CONFIG_CRYPTO_SW_AES).
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.  -ENOTSUP if no
+ *   provider supports the request.
+ *
+ ****************************************************************************/
+
+int crypto_cypher(FAR void *out, FAR const void *in, uint32_t size,
+                  FAR const void *iv, FAR const void *key, uint32_t keysize,
+                  int mode, int encrypt);
+
+#ifdef CONFIG_CRYPTO_ASYNC
+/****************************************************************************
+ * Name: crypto_submit
+ *
+ * Description:
+ *   Queue a request to be processed on the low priority work queue.  All
+ *   requests queued before the worker runs are processed in one batch.
+ *
+ ****************************************************************************/
+
+int crypto_submit(FAR struct crypto_req_s *req);
+#endif
+
 #if defined(CONFIG_CRYPTO_ALGTEST)
 int crypto_test(void);
 #endif
@@ -53,7 +53,10 @@
 #define CRYPTO_AES_ECB          1
 #define CRYPTO_AES_CBC          2
 #define CRYPTO_AES_CTR          3
-#define CRYPTO_ALGORITHM_MAX    1
+#define CRYPTO_CHACHA20_POLY1305 4 /* Tag in crypt_op.mac, no AAD */
+#define CRYPTO_SHA2_256         5  /* session_op.mac, digest in crypt_op.mac */
+#define CRYPTO_SHA2_512         6
+#define CRYPTO_ALGORITHM_MAX    6
 
 #define CRYPTO_FLAG_HARDWARE    0x01000000 /* hardware accelerated */
 #define CRYPTO_FLAG_SOFTWARE    0x02000000 /* software implementation */
@@ -65,6 +68,7 @@
 #define CIOCGSESSION            101
 #define CIOCFSESSION            102
 #define CIOCCRYPT               103
+#define CIOCNCRYPTM             104 /* Batch of crypt_op, see crypt_mop */
 
 typedef char* caddr_t;
 
@@ -92,4 +96,15 @@ struct crypt_op
   caddr_t iv;
 };
 
+/* A batch of operations for CIOCNCRYPTM.  The operations are performed in
+ * order until one fails.  On return, 'count' is the number of operations
+ * that succeeded.
+ */
+
+struct crypt_mop
+{
+  uint32_t count;     /* Number of operations in reqs[] */
+  FAR struct crypt_op *reqs;
+};
+
 #endif /* __INCLUDE_NUTTX_CRYPTO_CRYPTODEV_H */
@@ -0,0 +1,90 @@
+/****************************************************************************
+ * include/nuttx/crypto/sha2.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_CRYPTO_SHA2_H
+#define __INCLUDE_NUTTX_CRYPTO_SHA2_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SHA256_BLOCK_LENGTH   64
+#define SHA256_DIGEST_LENGTH  32
+#define SHA512_BLOCK_LENGTH   128
+#define SHA512_DIGEST_LENGTH  64
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct sha256_ctx_s
+{
+  uint32_t state[8];                   /* Intermediate hash value */
+  uint64_t count;                      /* Number of bytes hashed */
+  uint8_t buffer[SHA256_BLOCK_LENGTH]; /* Partial block */
+};
+
+struct sha512_ctx_s
+{
+  uint64_t state[8];                   /* Intermediate hash value */
+  uint64_t count;                      /* Number of bytes hashed */
+  uint8_t buffer[SHA512_BLOCK_LENGTH]; /* Partial block */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* Streaming API */
+
+void sha256_init(FAR struct sha256_ctx_s *ctx);
+void sha256_update(FAR struct sha256_ctx_s *ctx, FAR const void *in,
+                   size_t inlen);
+void sha256_final(FAR struct sha256_ctx_s *ctx, FAR uint8_t *digest);
+
+void sha512_init(FAR struct sha512_ctx_s *ctx);
+void sha512_update(FAR struct sha512_ctx_s *ctx, FAR const void *in,
+                   size_t inlen);
+void sha512_final(FAR struct sha512_ctx_s *ctx, FAR uint8_t *digest);
+
+/* Simple API */
+
+void sha256(FAR uint8_t *digest, FAR const void *in, size_t inlen);
+void sha512(FAR uint8_t *digest, FAR const void *in, size_t inlen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_CRYPTO_SHA2_H */
@@ -0,0 +1,113 @@
+/****************************************************************************
+ * include/nuttx/drivers/blkcache.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_DRIVERS_BLKCACHE_H
+#define __INCLUDE_NUTTX_DRIVERS_BLKCACHE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/fs/ioctl.h>
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This is the structure returned by the BIOC_CACHESTATS ioctl command */
+
+struct blkcache_stats_s
+{
+  uint32_t bs_hits;          /* Sectors read from the cache */
+  uint32_t bs_misses;        /* Sectors read from the device */
+  uint32_t bs_reads;         /* Read transfers from the device */
+  uint32_t bs_writes;        /* Write transfers to the device */
+  uint32_t bs_nwritten;      /* Sectors written to the device */
+  uint32_t bs_evictions;     /* Cached sectors replaced by other sectors */
+  uint16_t bs_nblocks;       /* Number of sectors in the cache */
+  uint16_t bs_ndirty;        /* Number of sectors not yet written back */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+#ifdef CONFIG_DRVR_BLKCACHE
+
+/****************************************************************************
+ * Name: blkcache_setup
+ *
+ * Description:
+ *   Register the block driver 'devname' that caches the sectors of the
+ *   block driver 'blkdev'.
+ *
+ * Input Parameters:
+ *   devname  - The path of the caching block driver to be created
+ *   blkdev   - The path of the block driver to be cached
+ *   nblocks  - The number of sectors to cache
+ *   readonly - True: Only read access will be supported
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int blkcache_setup(FAR const char *devname, FAR const char *blkdev,
+                   uint16_t nblocks, bool readonly);
+
+/****************************************************************************
+ * Name: blkcache_teardown
+ *
+ * Description:
+ *   Write back the cached sectors and undo the setup performed by
+ *   blkcache_setup().
+ *
+ * Input Parameters:
+ *   devname - The path of the caching block driver
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.  -EBUSY is
+ *   returned if the caching block driver is still open.
+ *
+ ****************************************************************************/
+
+int blkcache_teardown(FAR const char *devname);
+
+#endif /* CONFIG_DRVR_BLKCACHE */
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_DRIVERS_BLKCACHE_H */
@@ -142,9 +142,8 @@ struct rwbuffer_s
   sem_t         wrsem;           /* Enforces exclusive access to the write buffer */
   struct work_s work;            /* Delayed work to flush buffer after a delay with no activity */
   uint8_t      *wrbuffer;        /* Allocated write buffer */
+  off_t        *wrblocks;        /* Block number of each buffered block */
   uint16_t      wrnblocks;       /* Number of blocks in write buffer */
-  off_t         wrblockstart;    /* First block in write buffer */
-  off_t         wrexpectedblock; /* Next block expected */
 #endif
 
   /* This is the state of the read-ahead buffering */
@@ -195,6 +195,7 @@ struct fs_unionfsdir_s
   bool fu_prefix[2];                          /* True: Fake directory in prefix */
   FAR char *fu_relpath;                       /* Path being enumerated */
   FAR struct fs_dirent_s *fu_lower[2];        /* dirent struct used by contained file system */
+  uint32_t fu_names[8];                       /* Bloom filter of names on file system 1 */
 };
 #endif
 
@@ -206,6 +207,11 @@ struct fs_unionfsdir_s
 struct fs_userfsdir_s
 {
   FAR void *fs_dir;                           /* Opaque pointer to UserFS DIR */
+#if CONFIG_FS_USERFS_READDIR_BATCH > 1
+  FAR struct dirent *fs_entries;              /* Entries read ahead from the server */
+  uint8_t fs_next;                            /* Index of the next entry to return */
+  uint8_t fs_count;                           /* Number of entries in fs_entries[] */
+#endif
 };
 #endif
 
@@ -101,6 +101,7 @@
 #define __FS_FLAG_ERROR (1 << 1) /* Error detected by any operation */
 #define __FS_FLAG_LBF   (1 << 2) /* Line buffered */
 #define __FS_FLAG_UBF   (1 << 3) /* Buffer allocated by caller of setvbuf */
+#define __FS_FLAG_LAZY  (1 << 4) /* Buffer not allocated until first use */
 
 /* Inode i_flags values:
  *
@@ -383,10 +384,18 @@ union inode_ops_u
 
 /* This structure represents one inode in the NuttX pseudo-file system */
 
+#ifdef CONFIG_PSEUDOFS_HASH
+struct inode_hash_s;            /* Defined in fs/inode/fs_inodehash.c */
+#endif
+
 struct inode
 {
   FAR struct inode *i_peer;     /* Link to same level inode */
   FAR struct inode *i_child;    /* Link to lower level inode */
+#ifdef CONFIG_PSEUDOFS_HASH
+  FAR struct inode *i_hnext;    /* Next inode in the same hash chain */
+  FAR struct inode_hash_s *i_hash; /* Hash index of the children */
+#endif
   int16_t           i_crefs;    /* References to inode */
   uint16_t          i_flags;    /* Flags for inode */
   union inode_ops_u u;          /* Inode operations */
@@ -412,11 +421,17 @@ struct file
   void             *f_priv;     /* Per file driver private data */
 };
 
-/* This defines a list of files indexed by the file descriptor */
+/* This defines a list of files indexed by the file descriptor.  fl_map
+ * has one bit set for each descriptor in use so that the lowest free
+ * descriptor is found a word at a time.
+ */
+
+#define FILELIST_NMAPS ((CONFIG_NFILE_DESCRIPTORS + 31) / 32)
 
 struct filelist
 {
   sem_t   fl_sem;               /* Manage access to the file list */
+  uint32_t fl_map[FILELIST_NMAPS];
   struct file fl_files[CONFIG_NFILE_DESCRIPTORS];
 };
 
@@ -1163,6 +1178,53 @@ ssize_t file_write(FAR struct file *filep, FAR const void *buf,
 
 ssize_t nx_write(int fd, FAR const void *buf, size_t nbytes);
 
+/****************************************************************************
+ * Name: file_readv and file_writev
+ *
+ * Description:
+ *   Equivalent to the standard readv() and writev() functions except that
+ *   they accept a struct file instance instead of a file descriptor, do
+ *   not modify the errno variable, and are not cancellation points.
+ *
+ * Input Parameters:
+ *   filep  - File structure instance
+ *   iov    - Array of buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   The number of bytes transferred (0 on an end-of-file condition for
+ *   file_readv()) or a negated errno value on any failure.
+ *
+ ****************************************************************************/
+
+struct iovec;
+ssize_t file_readv(FAR struct file *filep, FAR const struct iovec *iov,
+                   int iovcnt);
+ssize_t file_writev(FAR struct file *filep, FAR const struct iovec *iov,
+                    int iovcnt);
+
+/****************************************************************************
+ * Name: nx_readv and nx_writev
+ *
+ * Description:
+ *   Internal OS versions of readv() and writev() that do not modify the
+ *   errno variable and are not cancellation points.  The descriptor may
+ *   be a file or a socket descriptor.
+ *
+ * Input Parameters:
+ *   fd     - File (or socket) descriptor
+ *   iov    - Array of buffer descriptors
+ *   iovcnt - Number of elements in iov[]
+ *
+ * Returned Value:
+ *   The number of bytes transferred (0 on an end-of-file condition for
+ *   nx_readv()) or a negated errno value on any failure.
+ *
+ ****************************************************************************/
+
+ssize_t nx_readv(int fd, FAR const struct iovec *iov, int iovcnt);
+ssize_t nx_writev(int fd, FAR const struct iovec *iov, int iovcnt);
+
 /****************************************************************************
  * Name: file_pread
  *
@@ -1392,6 +1454,24 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup);
 
 int fs_poll(int fd, FAR struct pollfd *fds, bool setup);
 
+/****************************************************************************
+ * Name: poll_notify
+ *
+ * Description:
+ *   Report the events that a driver has set in fds->revents to the waiter:
+ *   The callback of the pollfd is called if one is provided (as it is for
+ *   epoll); otherwise the semaphore is posted.
+ *
+ * Input Parameters:
+ *   fds - The pollfd structure provided at poll setup time
+ *
+ * Assumptions:
+ *   May be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void poll_notify(FAR struct pollfd *fds);
+
 /****************************************************************************
  * Name: nx_poll
  *
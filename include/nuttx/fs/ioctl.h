@@ -43,6 +43,8 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -97,6 +99,7 @@
 #define _NXTERMBASE     (0x2900) /* NxTerm character driver ioctl commands */
 #define _RFIOCBASE      (0x2a00) /* RF devices ioctl commands */
 #define _RPTUNBASE      (0x2b00) /* Remote processor tunnel ioctl commands */
+#define _NOTEBASE       (0x2c00) /* Scheduler note driver ioctl commands */
 #define _WLIOCBASE      (0x8b00) /* Wireless modules ioctl network commands */
 
 /* boardctl() commands share the same number space */
@@ -176,6 +179,11 @@
                                            *      int value.
                                            * OUT: Origin option.
                                            */
+#define FIOC_CACHESTATS _FIOC(0x000c)     /* IN:  Pointer to struct
+                                           *      fs_cachestats_s
+                                           * OUT: The cache statistics of the
+                                           *      volume.
+                                           */
 
 /* NuttX file system ioctl definitions **************************************/
 
@@ -270,6 +278,12 @@
                                            * IN:  None
                                            * OUT: None (ioctl return value provides
                                            *      success/failure indication). */
+#define BIOC_CACHESTATS _BIOC(0x000e)     /* Get the statistics of a block cache
+                                           * IN:  Pointer to writable instance
+                                           *      of struct blkcache_stats_s in
+                                           *      which to return the statistics.
+                                           * OUT: Data return in user-provided
+                                           *      buffer. */
 
 /* NuttX MTD driver ioctl definitions ***************************************/
 
@@ -510,6 +524,11 @@
 #define _RPTUNIOCVALID(c)   (_IOC_TYPE(c)==_RPTUNBASE)
 #define _RPTUNIOC(nr)       _IOC(_RPTUNBASE,nr)
 
+/* Scheduler note driver ****************************************************/
+
+#define _NOTEIOCVALID(c)  (_IOC_TYPE(c)==_NOTEBASE)
+#define _NOTEIOC(nr)      _IOC(_NOTEBASE,nr)
+
 /* Wireless driver network ioctl definitions ********************************/
 
 /* (see nuttx/include/wireless/wireless.h */
@@ -526,6 +545,16 @@
  * Public Type Definitions
  ****************************************************************************/
 
+/* Returned by FIOC_CACHESTATS */
+
+struct fs_cachestats_s
+{
+  uint32_t hits;               /* Data or page cache hits */
+  uint32_t misses;             /* Data or page cache misses */
+  uint32_t lookup_hits;        /* Name lookup cache hits */
+  uint32_t lookup_misses;      /* Name lookup cache misses */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
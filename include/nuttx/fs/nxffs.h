@@ -88,6 +88,12 @@
 #  define CONFIG_NXFFS_TAILTHRESHOLD (8*1024)
 #endif
 
+/* The number of inode locations remembered in RAM */
+
+#ifndef CONFIG_NXFFS_NINDEX
+#  define CONFIG_NXFFS_NINDEX 16
+#endif
+
 /* At present, only a single pre-allocated NXFFS volume is supported.  This
  * is because here can be only a single NXFFS volume mounted at any time.
  * This has to do with the fact that we bind to an MTD driver (instead of a
@@ -46,6 +46,12 @@
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
+
+/* Layout of the binary /proc/snapshot file *********************************/
+
+#define PROCFS_SNAPSHOT_VERSION  1   /* Bumped on incompatible changes */
+#define PROCFS_SNAPSHOT_NAMELEN  16  /* Size of the task name field */
+
 /* Data entry declaration prototypes ****************************************/
 
 /* Procfs operations are a subset of the mountpt_operations */
@@ -133,6 +139,60 @@ struct procfs_dir_priv_s
   FAR const struct procfs_entry_s *procfsentry; /* Pointer to procfs handler entry */
 };
 
+/* /proc/snapshot returns the state of the whole system in one read:  A
+ * struct procfs_snapshot_s followed by ntasks records of tasksize bytes,
+ * each starting with a struct procfs_snapshot_task_s.  Readers must use
+ * hdrsize and tasksize to step through the data, so that fields can be
+ * appended to either structure without breaking them.
+ *
+ * Unavailable values (e.g. CPU load without CONFIG_SCHED_CPULOAD) read as
+ * zero, except for the IOB counts which read as -1 without CONFIG_MM_IOB.
+ */
+
+struct procfs_snapshot_s
+{
+  uint16_t version;         /* PROCFS_SNAPSHOT_VERSION */
+  uint16_t hdrsize;         /* Size of this header in bytes */
+  uint16_t tasksize;        /* Size of each task record in bytes */
+  uint16_t ntasks;          /* Number of task records that follow */
+  uint32_t sequence;        /* Incremented by each snapshot taken */
+  uint32_t generation;      /* Hash of the task IDs present */
+  uint32_t uptime;          /* System time in clock ticks */
+  uint32_t loadtotal;       /* Ticks in the CPU load measurement window */
+
+  /* Heaps: size, bytes in use, bytes free and largest free chunk */
+
+  uint32_t umem_arena;
+  uint32_t umem_used;
+  uint32_t umem_free;
+  uint32_t umem_largest;
+  uint32_t kmem_arena;
+  uint32_t kmem_used;
+  uint32_t kmem_free;
+  uint32_t kmem_largest;
+
+  /* Free I/O buffers */
+
+  int32_t  iob_free;        /* Free IOBs */
+  int32_t  iob_throttled;   /* Free IOBs available to throttled users */
+  int32_t  iob_qfree;       /* Free IOB queue containers */
+};
+
+struct procfs_snapshot_task_s
+{
+  int32_t  pid;             /* Task/thread ID */
+  uint8_t  priority;        /* Current priority */
+  uint8_t  state;           /* enum tstate_e */
+  uint16_t flags;           /* TCB_FLAG_* */
+  uint32_t active;          /* Ticks active in the CPU load window */
+  uint32_t stacksize;       /* Size of the stack in bytes */
+  uint32_t stackused;       /* Stack used (CONFIG_STACK_COLORATION) */
+
+  /* The task name, NUL terminated and truncated if needed */
+
+  char     name[PROCFS_SNAPSHOT_NAMELEN];
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
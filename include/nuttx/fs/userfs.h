@@ -410,16 +410,22 @@ struct userfs_closedir_response_s
 struct userfs_readdir_request_s
 {
   uint8_t req;              /* Must be USERFS_REQ_READDIR */
+  uint8_t nentries;         /* Maximum number of entries to read */
   FAR void *dir;            /* Opaque pointer to directory information */
 };
 
 struct userfs_readdir_response_s
 {
   uint8_t resp;             /* Must be USERFS_RESP_READDIR */
+  uint8_t nentries;         /* Number of entries that were read */
   int ret;                  /* Result of the operation */
-  struct dirent entry;      /* Directory entry that was read */
+  struct dirent entry[1];   /* Directory entries that were read */
 };
 
+#define SIZEOF_USERFS_READDIR_RESPONSE_S(n) \
+  (sizeof(struct userfs_readdir_response_s) + \
+   ((n) - 1) * sizeof(struct dirent))
+
 struct userfs_rewinddir_request_s
 {
   uint8_t req;              /* Must be USERFS_REQ_REWINDDIR */
@@ -47,6 +47,11 @@
 
 #include <nuttx/fs/ioctl.h>
 
+#ifdef CONFIG_I2C_QUEUE
+#  include <queue.h>
+#  include <nuttx/wqueue.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -247,6 +252,43 @@ struct i2c_transfer_s
   size_t msgc;                /* Number of messages in the array. */
 };
 
+#ifdef CONFIG_I2C_QUEUE
+/* This describes one request handled by i2c_queue_submit():  An array of
+ * I2C messages performed by one call of I2C_TRANSFER() and the function to
+ * call when it completes.  The requests of a bus are performed in order of
+ * priority, higher values first, and in submission order within the same
+ * priority.
+ *
+ * The request and the buffers that it refers to belong to the I2C queue
+ * from the call to i2c_queue_submit() up to the call of the callback.
+ */
+
+struct i2c_request_s;
+typedef CODE void (*i2c_complete_t)(FAR struct i2c_request_s *req,
+                                    int result, FAR void *arg);
+
+struct i2c_request_s
+{
+  FAR struct i2c_request_s *flink; /* Supports a singly linked list */
+  uint8_t priority;                /* Higher values are performed first */
+  int count;                       /* Number of messages in msgv */
+  FAR struct i2c_msg_s *msgv;      /* Array of I2C messages */
+  i2c_complete_t callback;         /* Called when the request completes */
+  FAR void *arg;                   /* Argument of the callback */
+};
+
+/* The queue of requests of one I2C bus.  The contents are private to the
+ * I2C queue logic.
+ */
+
+struct i2c_queue_s
+{
+  FAR struct i2c_master_s *i2c;    /* The I2C bus */
+  sq_queue_t pending;              /* The requests waiting for the bus */
+  struct work_s work;              /* Performs the requests */
+};
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -356,6 +398,69 @@ int i2c_read(FAR struct i2c_master_s *dev,
              FAR const struct i2c_config_s *config,
              FAR uint8_t *buffer, int buflen);
 
+/****************************************************************************
+ * Name: i2c_queue_initialize
+ *
+ * Description:
+ *   Initialize the request queue of one I2C bus.  All of the drivers that
+ *   submit requests to that bus must share the same queue.
+ *
+ * Input Parameters:
+ *   queue - The queue to initialize
+ *   i2c   - An instance of the I2C bus that the queue feeds
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_I2C_QUEUE
+void i2c_queue_initialize(FAR struct i2c_queue_s *queue,
+                          FAR struct i2c_master_s *i2c);
+
+/****************************************************************************
+ * Name: i2c_queue_submit
+ *
+ * Description:
+ *   Add a request to the queue of an I2C bus and return without waiting.
+ *   The requests are performed on the I2C work queue, followed by the call
+ *   of their callback with the result of I2C_TRANSFER().  This may be
+ *   called from an interrupt handler.
+ *
+ * Input Parameters:
+ *   queue - The queue of the I2C bus
+ *   req   - The request to perform
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.  The callback
+ *   is not called if the request could not be queued.
+ *
+ ****************************************************************************/
+
+int i2c_queue_submit(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req);
+
+/****************************************************************************
+ * Name: i2c_queue_cancel
+ *
+ * Description:
+ *   Remove a request from the queue before it is started.
+ *
+ * Input Parameters:
+ *   queue - The queue of the I2C bus
+ *   req   - The request to remove
+ *
+ * Returned Value:
+ *   Zero (OK) if the request was removed; its callback will not be called.
+ *   -ENOENT if the request is no longer queued: It is being performed or
+ *   it already completed.
+ *
+ ****************************************************************************/
+
+int i2c_queue_cancel(FAR struct i2c_queue_s *queue,
+                     FAR struct i2c_request_s *req);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -115,6 +115,17 @@ int CONFIG_USER_ENTRYPOINT(int argc, char *argv[]);
 
 void nx_start(void) noreturn_function;
 
+/* Functions contained in nx_deferinit.c ************************************/
+/* Perform independent initialization steps on the low priority work queue
+ * and wait for their completion.
+ */
+
+#ifdef CONFIG_INIT_DEFER
+int nx_defer_init(FAR const char *name, CODE int (*func)(FAR void *arg),
+                  FAR void *arg);
+void nx_defer_wait(void);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
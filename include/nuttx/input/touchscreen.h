@@ -122,6 +122,8 @@ struct touch_point_s
   int16_t  h;        /* Height of touch point (uncalibrated) */
   int16_t  w;        /* Width of touch point (uncalibrated) */
   uint16_t pressure; /* Touch pressure */
+  uint64_t timestamp; /* Time of the touch event in microseconds.  Only set by
+                       * drivers built on the touchscreen upper half. */
 };
 
 /* The typical touchscreen driver is a read-only, input character device driver.
@@ -147,6 +149,33 @@ struct touch_sample_s
 #define SIZEOF_TOUCH_SAMPLE_S(n) \
   (sizeof(struct touch_sample_s) + ((n) - 1) * sizeof(struct touch_point_s))
 
+#ifdef CONFIG_INPUT_TOUCHSCREEN
+/* This structure is the interface between the common touchscreen upper half
+ * and a lower half driver.  The upper half provides the character driver,
+ * queues the samples reported by the lower half with touch_event() and lets
+ * the application read several of them at once.
+ *
+ * Each sample in the queue describes one complete frame of the controller:
+ * all of the touch points reported at the same time.  If the newest queued
+ * sample and a new sample only report movement of the same contacts, the
+ * new sample replaces the queued one instead of using another entry.
+ */
+
+struct touch_lowerhalf_s
+{
+  uint8_t maxpoint;  /* The maximum number of touch points in one sample */
+
+  /* Handle the IOCTL commands that are not handled by the upper half.  May
+   * be NULL.
+   */
+
+  CODE int (*control)(FAR struct touch_lowerhalf_s *lower, int cmd,
+                      unsigned long arg);
+
+  FAR void *priv;    /* Reserved for the upper half, set by touch_register() */
+};
+#endif
+
 /************************************************************************************
  * Public Function Prototypes
  ************************************************************************************/
@@ -159,6 +188,54 @@ extern "C"
 #define EXTERN extern
 #endif
 
+#ifdef CONFIG_INPUT_TOUCHSCREEN
+/************************************************************************************
+ * Name: touch_event
+ *
+ * Description:
+ *   Queue a sample reported by the lower half.  The time stamp of each touch
+ *   point is set here.  If the queue is full, the oldest sample is discarded.
+ *   This function may be called from the interrupt level.
+ *
+ * Input Parameters:
+ *   priv    - The priv field of the lower half structure
+ *   sample  - The sample.  It must not hold more than maxpoint touch points.
+ *
+ ************************************************************************************/
+
+void touch_event(FAR void *priv, FAR const struct touch_sample_s *sample);
+
+/************************************************************************************
+ * Name: touch_register
+ *
+ * Description:
+ *   Register a touchscreen lower half driver with the common upper half.
+ *
+ * Input Parameters:
+ *   lower   - The lower half driver.  Its maxpoint field must be set.
+ *   path    - The path of the device, by convention /dev/inputN
+ *   nums    - The number of samples that can be queued
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ************************************************************************************/
+
+int touch_register(FAR struct touch_lowerhalf_s *lower,
+                   FAR const char *path, uint8_t nums);
+
+/************************************************************************************
+ * Name: touch_unregister
+ *
+ * Description:
+ *   Unregister a touchscreen device registered with touch_register().
+ *
+ ************************************************************************************/
+
+void touch_unregister(FAR struct touch_lowerhalf_s *lower,
+                      FAR const char *path);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
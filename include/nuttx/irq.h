@@ -46,6 +46,9 @@
 #ifndef __ASSEMBLY__
 # include <stdint.h>
 # include <assert.h>
+# ifdef CONFIG_SMP
+#   include <nuttx/spinlock.h>
+# endif
 #endif
 
 /****************************************************************************
@@ -60,6 +63,12 @@
 
 #  define irq_detach(irq) irq_attach(irq, NULL, NULL)
 
+/* The top half of a threaded interrupt returns IRQ_WAKE_THREAD to have its
+ * bottom half run by the thread (see irq_attach_thread()).
+ */
+
+#  define IRQ_WAKE_THREAD 1
+
 /* Maximum/minimum values of IRQ integer types */
 
 #  if NR_IRQS <= 256
@@ -170,6 +179,21 @@ int irqchain_detach(int irq, xcpt_t isr, FAR void *arg);
 #  define irqchain_detach(irq, isr, arg) irq_detach(irq)
 #endif
 
+/****************************************************************************
+ * Name: irq_attach_thread
+ *
+ * Description:
+ *   Attach a threaded interrupt: 'isr' runs in the interrupt context and
+ *   returns IRQ_WAKE_THREAD to have 'isrthread' run by a kernel thread with
+ *   the given priority.  A NULL 'isrthread' detaches the IRQ.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_IRQ_THREAD
+int irq_attach_thread(int irq, xcpt_t isr, xcpt_t isrthread, FAR void *arg,
+                      int priority, int stack_size);
+#endif
+
 /****************************************************************************
  * Name: enter_critical_section
  *
@@ -296,6 +320,70 @@ void spin_unlock_irqrestore(irqstate_t flags);
 #  define spin_unlock_irqrestore(f) leave_critical_section(f)
 #endif
 
+/****************************************************************************
+ * Name: spin_lock_irqsave_private
+ *
+ * Description:
+ *   If SMP is enabled:
+ *     Disable local interrupts and take a spinlock private to a driver or
+ *     subsystem.  Unlike enter_critical_section() and spin_lock_irqsave(),
+ *     this does not serialize with unrelated code on other CPUs.  It is
+ *     the way for a subsystem to move its data off the global critical
+ *     section.
+ *
+ *     NOTE: The lock is not reentrant.  Do not use this API with kernel
+ *     APIs which suspend a caller thread (e.g. nxsem_wait) or which change
+ *     the ready-to-run lists (e.g. nxsem_post), and do not hold two
+ *     private locks at the same time.
+ *
+ *   If SMP is not enabled:
+ *     This function is equivalent to up_irq_save().  The lock is not
+ *     referenced and need not be declared.
+ *
+ * Input Parameters:
+ *   lock - The private spinlock
+ *
+ * Returned Value:
+ *   An opaque, architecture-specific value that represents the state of
+ *   the interrupts prior to the call to spin_lock_irqsave_private();
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+irqstate_t spin_lock_irqsave_private(FAR volatile spinlock_t *lock);
+#else
+#  define spin_lock_irqsave_private(l) up_irq_save()
+#endif
+
+/****************************************************************************
+ * Name: spin_unlock_irqrestore_private
+ *
+ * Description:
+ *   If SMP is enabled:
+ *     Release a private spinlock and restore the interrupt state as it was
+ *     prior to the previous call to spin_lock_irqsave_private().
+ *
+ *   If SMP is not enabled:
+ *     This function is equivalent to up_irq_restore().
+ *
+ * Input Parameters:
+ *   lock  - The private spinlock
+ *   flags - The architecture-specific value that represents the state of
+ *           the interrupts prior to the call to
+ *           spin_lock_irqsave_private();
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+void spin_unlock_irqrestore_private(FAR volatile spinlock_t *lock,
+                                    irqstate_t flags);
+#else
+#  define spin_unlock_irqrestore_private(l,f) up_irq_restore(f)
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -69,11 +69,13 @@ extern "C"
 
 #define kumm_initialize(h,s)     umm_initialize(h,s)
 #define kumm_addregion(h,s)      umm_addregion(h,s)
+#define kumm_addregion_attr(h,s,a) umm_addregion_attr(h,s,a)
 #define kumm_trysemaphore()      umm_trysemaphore()
 #define kumm_givesemaphore()     umm_givesemaphore()
 
 #define kumm_calloc(n,s)         calloc(n,s);
 #define kumm_malloc(s)           malloc(s)
+#define kumm_malloc_attr(s,a)    malloc_attr(s,a)
 #define kumm_zalloc(s)           zalloc(s)
 #define kumm_realloc(p,s)        realloc(p,s)
 #define kumm_memalign(a,s)       memalign(a,s)
@@ -90,11 +92,13 @@ extern "C"
 
 #  define kmm_initialize(h,s)    /* Initialization done by kumm_initialize */
 #  define kmm_addregion(h,s)     umm_addregion(h,s)
+#  define kmm_addregion_attr(h,s,a) umm_addregion_attr(h,s,a)
 #  define kmm_trysemaphore()     umm_trysemaphore()
 #  define kmm_givesemaphore()    umm_givesemaphore()
 
 #  define kmm_calloc(n,s)        calloc(n,s);
 #  define kmm_malloc(s)          malloc(s)
+#  define kmm_malloc_attr(s,a)   malloc_attr(s,a)
 #  define kmm_zalloc(s)          zalloc(s)
 #  define kmm_realloc(p,s)       realloc(p,s)
 #  define kmm_memalign(a,s)      memalign(a,s)
@@ -0,0 +1,105 @@
+/****************************************************************************
+ * include/nuttx/lib/libxx.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_LIB_LIBXX_H
+#define __INCLUDE_NUTTX_LIB_LIBXX_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+
+#ifdef CONFIG_LIBXX_POOL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of size classes of the operator new pool and the largest
+ * object that it holds.  Larger objects are allocated with malloc().
+ */
+
+#define LIBXX_POOL_NCLASSES 8
+#define LIBXX_POOL_MAXSIZE  128
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* Statistics of one size class of the pool */
+
+struct libxx_poolclass_s
+{
+  size_t        objsize;  /* Size of the objects of the class */
+  size_t        nobjs;    /* Number of objects in the pages of the class */
+  size_t        inuse;    /* Number of objects in use */
+  size_t        peak;     /* Highest value of inuse */
+  unsigned long nalloc;   /* Total number of allocations */
+};
+
+/* Statistics of the pool, returned by libxx_pool_stats() */
+
+struct libxx_poolstats_s
+{
+  size_t        size;     /* Size of the pool in bytes */
+  size_t        used;     /* Bytes of the pool given to size classes */
+  unsigned long fallback; /* Allocations that were passed to malloc() */
+  struct libxx_poolclass_s classes[LIBXX_POOL_NCLASSES];
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: libxx_pool_stats
+ *
+ * Description:
+ *   Return the statistics of the pool that serves the small allocations of
+ *   the C++ operator new.
+ *
+ * Input Parameters:
+ *   stats - The location to return the statistics.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void libxx_pool_stats(FAR struct libxx_poolstats_s *stats);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_LIBXX_POOL */
+#endif /* __INCLUDE_NUTTX_LIB_LIBXX_H */
@@ -83,6 +83,8 @@
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
 
+#include <stddef.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -123,6 +125,7 @@
 
 #define M_PI_F     ((float)M_PI)
 #define M_PI_2_F   ((float)M_PI_2)
+#define M_PI_4_F   ((float)M_PI_4)
 
 /****************************************************************************
  * Public Function Prototypes
@@ -237,6 +240,10 @@ double      gamma(double x);
 double      lgamma(double x);
 #endif
 
+float       __cosf(float x);
+float       __sinf(float x);
+int         __rem_pio2f(float x, FAR float *y);
+
 float       logf  (float x);
 #ifdef CONFIG_HAVE_DOUBLE
 double      log   (double x);
@@ -418,6 +425,15 @@ double      trunc (double x);
 long double truncl (long double x);
 #endif
 
+/* Array versions (non-standard): dst[i] = f(src[i]) for the n elements of
+ * src.  dst may be the same array as src.
+ */
+
+void        vsinf (FAR float *dst, FAR const float *src, size_t n);
+void        vcosf (FAR float *dst, FAR const float *src, size_t n);
+void        vexpf (FAR float *dst, FAR const float *src, size_t n);
+void        vlogf (FAR float *dst, FAR const float *src, size_t n);
+
 #define nanf(x) ((float)(NAN))
 #ifdef CONFIG_HAVE_DOUBLE
 #define nan(x) ((double)(NAN))
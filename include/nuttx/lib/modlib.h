@@ -168,6 +168,9 @@ struct module_s
 #ifdef HAVE_MODLIB_NAMES
   FAR char modname[MODLIB_NAMEMAX];    /* Module name */
 #endif
+#ifdef CONFIG_MODULE_LAZY
+  FAR char *filename;                  /* Module file, if not loaded yet */
+#endif
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_MODULE)
   mod_initializer_t initializer;       /* Module initializer function */
 #endif
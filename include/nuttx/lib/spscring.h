@@ -0,0 +1,170 @@
+/****************************************************************************
+ * include/nuttx/lib/spscring.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* A lock-free ring buffer for one producer and one consumer.  The ring
+ * holds no pointers, so it can be placed in memory that is shared between
+ * tasks or processes and that is mapped at different addresses in each of
+ * them (for example a region attached with shmat()).  Several producers
+ * must serialize the write side among themselves.
+ */
+
+#ifndef __INCLUDE_NUTTX_LIB_SPSCRING_H
+#define __INCLUDE_NUTTX_LIB_SPSCRING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of bytes of memory needed by a ring with n bytes of data */
+
+#define SPSCRING_SIZE(n)  (sizeof(struct spscring_s) + (n))
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The state of the ring.  The data area of size bytes immediately follows
+ * this structure.  head and tail are free running byte counters.
+ */
+
+struct spscring_s
+{
+  volatile uint32_t head;  /* Total bytes written.  Only set by producer */
+  volatile uint32_t tail;  /* Total bytes read.  Only set by consumer */
+  uint32_t size;           /* Size of the data area, a power of two */
+  uint32_t reserved;       /* Keeps the data area 64-bit aligned */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: spscring_init
+ *
+ * Description:
+ *   Initialize an empty ring in memory of SPSCRING_SIZE(size) bytes.  This
+ *   must be done once before either side uses the ring.
+ *
+ * Input Parameters:
+ *   ring - The ring
+ *   size - The size of the data area.  Must be a power of two.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if the size is not a power of two.
+ *
+ ****************************************************************************/
+
+int spscring_init(FAR struct spscring_s *ring, size_t size);
+
+/****************************************************************************
+ * Name: spscring_used / spscring_space
+ *
+ * Description:
+ *   Return the number of bytes that can be read from / written to the
+ *   ring.  The value is only exact for the side that consumes it.
+ *
+ ****************************************************************************/
+
+size_t spscring_used(FAR const struct spscring_s *ring);
+size_t spscring_space(FAR const struct spscring_s *ring);
+
+/****************************************************************************
+ * Name: spscring_write
+ *
+ * Description:
+ *   Copy up to len bytes into the ring.  Called by the producer only.
+ *
+ * Returned Value:
+ *   The number of bytes copied, which is less than len if the ring is
+ *   full.
+ *
+ ****************************************************************************/
+
+size_t spscring_write(FAR struct spscring_s *ring, FAR const void *buf,
+                      size_t len);
+
+/****************************************************************************
+ * Name: spscring_read
+ *
+ * Description:
+ *   Copy up to len bytes out of the ring.  Called by the consumer only.
+ *
+ * Returned Value:
+ *   The number of bytes copied, which is less than len if the ring holds
+ *   less data.
+ *
+ ****************************************************************************/
+
+size_t spscring_read(FAR struct spscring_s *ring, FAR void *buf,
+                     size_t len);
+
+/****************************************************************************
+ * Name: spscring_wbuf / spscring_wcommit
+ *
+ * Description:
+ *   Access the free space of the ring without a copy.  spscring_wbuf()
+ *   returns the address and the length of the contiguous free space at the
+ *   write position.  After filling (a part of) it, spscring_wcommit() makes
+ *   the first len bytes visible to the consumer.  Called by the producer
+ *   only.
+ *
+ ****************************************************************************/
+
+size_t spscring_wbuf(FAR struct spscring_s *ring, FAR void **ptr);
+void spscring_wcommit(FAR struct spscring_s *ring, size_t len);
+
+/****************************************************************************
+ * Name: spscring_rbuf / spscring_rcommit
+ *
+ * Description:
+ *   Access the data of the ring without a copy.  spscring_rbuf() returns
+ *   the address and the length of the contiguous data at the read
+ *   position.  spscring_rcommit() gives the first len bytes of it back to
+ *   the producer.  Called by the consumer only.
+ *
+ ****************************************************************************/
+
+size_t spscring_rbuf(FAR struct spscring_s *ring, FAR const void **ptr);
+void spscring_rcommit(FAR struct spscring_s *ring, size_t len);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_LIB_SPSCRING_H */
@@ -45,6 +45,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#ifdef CONFIG_NET_TIMESTAMP
+#  include <time.h>
+#endif
+
 #ifdef CONFIG_IOB_NOTIFIER
 #  include <nuttx/wqueue.h>
 #endif
@@ -84,10 +88,28 @@
 #  error CONFIG_IOB_NBUFFERS <= CONFIG_IOB_THROTTLE
 #endif
 
+/* Large I/O buffers are optional */
+
+#if !defined(CONFIG_IOB_LARGE_NBUFFERS)
+#  define CONFIG_IOB_LARGE_NBUFFERS 0
+#endif
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0 && \
+    (!defined(CONFIG_IOB_LARGE_BUFSIZE) || \
+     CONFIG_IOB_LARGE_BUFSIZE <= CONFIG_IOB_BUFSIZE)
+#  error CONFIG_IOB_LARGE_BUFSIZE must be larger than CONFIG_IOB_BUFSIZE
+#endif
+
 /* IOB helpers */
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+#  define IOB_BUFSIZE(p) ((p)->io_bufsize)
+#else
+#  define IOB_BUFSIZE(p) CONFIG_IOB_BUFSIZE
+#endif
+
 #define IOB_DATA(p)      (&(p)->io_data[(p)->io_offset])
-#define IOB_FREESPACE(p) (CONFIG_IOB_BUFSIZE - (p)->io_len - (p)->io_offset)
+#define IOB_FREESPACE(p) (IOB_BUFSIZE(p) - (p)->io_len - (p)->io_offset)
 
 #if CONFIG_IOB_NCHAINS > 0
 /* Queue helpers */
@@ -101,8 +123,12 @@
  ****************************************************************************/
 
 /* Represents one I/O buffer.  A packet is contained by one or more I/O
- * buffers in a chain.  The io_pktlen is only valid for the I/O buffer at
- * the head of the chain.
+ * buffers in a chain.  The io_pktlen and the receive timestamps are only
+ * valid for the I/O buffer at the head of the chain.
+ *
+ * If large I/O buffers are enabled, io_data points to a payload buffer of
+ * io_bufsize bytes: CONFIG_IOB_BUFSIZE or CONFIG_IOB_LARGE_BUFSIZE.  A
+ * chain may mix both sizes.
  */
 
 struct iob_s
@@ -113,7 +139,7 @@ struct iob_s
 
   /* Payload */
 
-#if CONFIG_IOB_BUFSIZE < 256
+#if CONFIG_IOB_BUFSIZE < 256 && CONFIG_IOB_LARGE_NBUFFERS == 0
   uint8_t  io_len;      /* Length of the data in the entry */
   uint8_t  io_offset;   /* Data begins at this offset */
 #else
@@ -121,8 +147,24 @@ struct iob_s
   uint16_t io_offset;   /* Data begins at this offset */
 #endif
   uint16_t io_pktlen;   /* Total length of the packet */
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  uint16_t io_bufsize;  /* Size of the payload buffer */
+#endif
+
+#ifdef CONFIG_NET_TIMESTAMP
+  /* Receive timestamps of a queued datagram, set by the network when the
+   * datagram is queued for a socket.  Zero means that there is none.
+   */
 
+  struct timespec io_swtime;  /* Software timestamp */
+  struct timespec io_hwtime;  /* Hardware timestamp */
+#endif
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  FAR uint8_t *io_data;
+#else
   uint8_t  io_data[CONFIG_IOB_BUFSIZE];
+#endif
 };
 
 #if CONFIG_IOB_NCHAINS > 0
@@ -202,6 +244,12 @@ enum iob_user_e
 #ifdef CONFIG_NET_IPFORWARD
   IOBUSER_NET_IPFORWARD,
 #endif
+#ifdef CONFIG_NETDEV_IOB_RX
+  IOBUSER_NET_NETDEV_RX,
+#endif
+#ifdef CONFIG_NET_IPv6_NEIGHBOR_QUEUE
+  IOBUSER_NET_NEIGHBOR,
+#endif
 #ifdef CONFIG_WIRELESS_IEEE802154
   IOBUSER_WIRELESS_RAD802154,
 #endif
@@ -228,6 +276,7 @@ struct iob_userstats_s
 {
   int totalconsumed;
   int totalproduced;
+  int totalfailed;       /* Allocations that found no free I/O buffer */
 };
 
 /****************************************************************************
@@ -265,6 +314,21 @@ FAR struct iob_s *iob_alloc(bool throttled, enum iob_user_e consumerid);
 
 FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid);
 
+/****************************************************************************
+ * Name: iob_tryalloc_large
+ *
+ * Description:
+ *   Try to allocate a large I/O buffer of CONFIG_IOB_LARGE_BUFSIZE bytes
+ *   without waiting.  Large I/O buffers are a separate pool that is not
+ *   counted by iob_navail(), so the caller must fall back to the normal
+ *   I/O buffers if none is free.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+FAR struct iob_s *iob_tryalloc_large(enum iob_user_e consumerid);
+#endif
+
 /****************************************************************************
  * Name: iob_navail
  *
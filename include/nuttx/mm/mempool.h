@@ -0,0 +1,218 @@
+/****************************************************************************
+ * include/nuttx/mm/mempool.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_MM_MEMPOOL_H
+#define __INCLUDE_NUTTX_MM_MEMPOOL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <queue.h>
+#include <semaphore.h>
+
+#ifdef CONFIG_GRAN
+#  include <nuttx/mm/gran.h>
+#endif
+
+#ifdef CONFIG_MM_MEMPOOL
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This describes one pool of fixed-size blocks.  The first group of fields
+ * must be set up by the caller before calling mempool_init().  The
+ * remaining fields are private to the mempool logic.
+ */
+
+struct mempool_s
+{
+  size_t bsize;           /* The size of each block in the pool */
+  size_t ninitial;        /* The number of blocks created by mempool_init() */
+  size_t ninterrupt;      /* Blocks reserved for use in interrupt context */
+  size_t nexpand;         /* Blocks added when the pool is exhausted (0:
+                           * the pool has a fixed size) */
+  bool wait;              /* true: mempool_alloc() waits for a free block
+                           * if the pool is exhausted and cannot grow */
+#ifdef CONFIG_GRAN
+  GRAN_HANDLE gran;       /* If non-NULL, the pool storage is taken from this
+                           * granule allocator instead of the kernel heap */
+#endif
+
+  /* Private data */
+
+  FAR const char *name;   /* Name reported by /proc/mempool */
+  sq_entry_t node;        /* Entry in the list of registered pools */
+  sq_queue_t list;        /* The free block list */
+  sq_queue_t ilist;       /* The free blocks reserved for interrupt use */
+  sq_queue_t elist;       /* The storage chunks that back the pool */
+  size_t nilist;          /* Number of blocks in ilist */
+  size_t nused;           /* Number of blocks in use */
+  size_t ntotal;          /* Total number of blocks in the pool */
+  size_t arena;           /* Total bytes of storage backing the pool */
+  sem_t waitsem;          /* Supports waiting for a free block */
+};
+
+/* Form in which the state of a memory pool is returned */
+
+struct mempoolinfo_s
+{
+  unsigned long arena;     /* Total bytes of storage backing the pool */
+  unsigned long ordblks;   /* Number of free blocks */
+  unsigned long iordblks;  /* Number of free blocks reserved for interrupts */
+  unsigned long aordblks;  /* Number of blocks in use */
+  unsigned long sizeblks;  /* The size of each block */
+  unsigned long nwaiter;   /* Number of tasks waiting for a block */
+};
+
+/* Callback used by mempool_foreach() */
+
+typedef CODE void (*mempool_foreach_t)(FAR struct mempool_s *pool,
+                                       FAR void *arg);
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: mempool_init
+ *
+ * Description:
+ *   Initialize a memory pool.  The caller must set the size and growth
+ *   fields of the pool before calling this function.
+ *
+ * Input Parameters:
+ *   pool - The memory pool to initialize
+ *   name - The name of the pool as reported by /proc/mempool (may be NULL)
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int mempool_init(FAR struct mempool_s *pool, FAR const char *name);
+
+/****************************************************************************
+ * Name: mempool_alloc
+ *
+ * Description:
+ *   Allocate a block from the memory pool.  This may be called from an
+ *   interrupt handler, in which case only the interrupt reserve and the
+ *   normal free list are used and the pool never grows or waits.
+ *
+ * Input Parameters:
+ *   pool - The memory pool to allocate from
+ *
+ * Returned Value:
+ *   The address of the allocated block or NULL if no block is available.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_alloc(FAR struct mempool_s *pool);
+
+/****************************************************************************
+ * Name: mempool_free
+ *
+ * Description:
+ *   Return a block to the memory pool.  This may be called from an
+ *   interrupt handler.
+ *
+ * Input Parameters:
+ *   pool - The memory pool that the block was allocated from
+ *   blk  - The block to release
+ *
+ ****************************************************************************/
+
+void mempool_free(FAR struct mempool_s *pool, FAR void *blk);
+
+/****************************************************************************
+ * Name: mempool_info
+ *
+ * Description:
+ *   Return the current state of the memory pool.
+ *
+ * Input Parameters:
+ *   pool - The memory pool of interest
+ *   info - The location to return the state
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int mempool_info(FAR struct mempool_s *pool,
+                 FAR struct mempoolinfo_s *info);
+
+/****************************************************************************
+ * Name: mempool_deinit
+ *
+ * Description:
+ *   Release all storage of the memory pool.  All blocks must have been
+ *   returned to the pool.
+ *
+ * Input Parameters:
+ *   pool - The memory pool to release
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -EBUSY is returned if blocks of the
+ *   pool are still in use.
+ *
+ ****************************************************************************/
+
+int mempool_deinit(FAR struct mempool_s *pool);
+
+/****************************************************************************
+ * Name: mempool_foreach
+ *
+ * Description:
+ *   Call a function for each initialized memory pool.  This is used by
+ *   /proc/mempool.
+ *
+ * Input Parameters:
+ *   handler - The function to call
+ *   arg     - An opaque argument passed to the handler
+ *
+ ****************************************************************************/
+
+void mempool_foreach(mempool_foreach_t handler, FAR void *arg);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_MM_MEMPOOL */
+#endif /* __INCLUDE_NUTTX_MM_MEMPOOL_H */
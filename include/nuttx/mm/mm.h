@@ -163,6 +163,114 @@
 #define MM_IS_ALLOCATED(n) \
   ((int)((struct mm_allocnode_s*)(n)->preceding) < 0)
 
+/* TLSF free chunk index definitions.  Free chunks are kept in one of
+ * MM_TLSF_FLCOUNT x MM_TLSF_SLCOUNT segregated lists.  The first level
+ * list is selected by the most significant bit of the chunk size (in units
+ * of MM_MIN_CHUNK) and the second level list linearly subdivides that
+ * power-of-two range.  Two levels of bitmaps locate a non-empty list in
+ * constant time.
+ */
+
+#ifdef CONFIG_MM_TLSF
+#  ifdef CONFIG_MM_SMALL
+#    define MMSIZE_BITS      16
+#  else
+#    define MMSIZE_BITS      32
+#  endif
+#  define MM_TLSF_SLSHIFT    CONFIG_MM_TLSF_SLBITS
+#  define MM_TLSF_SLCOUNT    (1 << MM_TLSF_SLSHIFT)
+#  define MM_TLSF_FLCOUNT    (MMSIZE_BITS - MM_MIN_SHIFT - MM_TLSF_SLSHIFT + 1)
+#endif
+
+/* Per-CPU chunk cache definitions.  The cache holds recently freed chunks
+ * with a size no larger than CONFIG_MM_CPUCACHE_MAXSIZE (including the
+ * chunk header).  There is one bin for each multiple of MM_MIN_CHUNK.
+ */
+
+#ifdef CONFIG_MM_CPUCACHE
+#  ifdef CONFIG_SMP
+#    define MM_CACHE_NCPUS   CONFIG_SMP_NCPUS
+#  else
+#    define MM_CACHE_NCPUS   1
+#  endif
+#  define MM_CACHE_MAXSIZE   MM_ALIGN_DOWN(CONFIG_MM_CPUCACHE_MAXSIZE)
+#  define MM_CACHE_NBINS     (MM_CACHE_MAXSIZE >> MM_MIN_SHIFT)
+#  define MM_CACHE_NDX(s)    (((s) >> MM_MIN_SHIFT) - 1)
+
+/* The cache can only be used where the allocator can disable (local)
+ * interrupts, i.e., not in the user-space half of a protected build.
+ */
+
+#  if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+#    define MM_HAVE_CPUCACHE 1
+#  endif
+#endif
+
+/* Allocation profiler definitions.  The requested sizes are counted in
+ * MM_PROFILE_NBUCKETS power-of-two histogram buckets; the last bucket
+ * holds all larger sizes.  The profiler relies on the critical section and
+ * on the system timer so it is not available in the user-space half of a
+ * protected build.
+ */
+
+#ifdef CONFIG_MM_PROFILE
+#  define MM_PROFILE_NBUCKETS 16
+#  define MM_PROFILE_NOSITE   0xffff
+
+/* The call site is identified by the return address of the heap entry */
+
+#  ifdef __GNUC__
+#    define MM_PROFILE_CALLER() __builtin_return_address(0)
+#  else
+#    define MM_PROFILE_CALLER() NULL
+#  endif
+
+#  if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+#    define MM_HAVE_PROFILE 1
+#  endif
+#endif
+
+/* Region attribute definitions.  The attributes are the MALLOC_ATTR_*
+ * definitions of stdlib.h.  If MM_ATTR_PREFER is also set, an allocation
+ * that cannot be placed in a region with the attributes is taken from any
+ * region instead of failing.  The default placement of the task is kept in
+ * its TCB, which is not accessible in the user-space half of a protected
+ * build.
+ */
+
+#ifdef CONFIG_MM_REGION_ATTR
+#  define MM_ATTR_PREFER     0x80
+
+#  if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+#    define MM_HAVE_TASKATTR 1
+#  endif
+#endif
+
+/* Free chunk statistics definitions.  The free chunks are counted in one
+ * bucket for each free list:  There is one bucket for each nodelist index
+ * or, with CONFIG_MM_TLSF, for each first level index.  The per-CPU
+ * counters need to disable local interrupts, so they are not available in
+ * the user-space half of a protected build.
+ */
+
+#ifdef CONFIG_MM_FRAGSTATS
+#  ifdef CONFIG_MM_TLSF
+#    define MM_FRAG_NBUCKETS MM_TLSF_FLCOUNT
+#  else
+#    define MM_FRAG_NBUCKETS MM_NNODES
+#  endif
+
+#  ifdef CONFIG_SMP
+#    define MM_STATS_NCPUS   CONFIG_SMP_NCPUS
+#  else
+#    define MM_STATS_NCPUS   1
+#  endif
+
+#  if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+#    define MM_HAVE_CPUSTATS 1
+#  endif
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -214,6 +322,115 @@ struct mm_delaynode_s
   struct mm_delaynode_s *flink;
 };
 
+#ifdef CONFIG_MM_CPUCACHE
+/* This describes one size class of the per-CPU chunk cache.  The cached
+ * chunks remain marked as allocated in the heap and are simply linked
+ * together through their payload.
+ */
+
+struct mm_cachebin_s
+{
+  FAR struct mm_delaynode_s *head; /* List of cached chunks */
+  uint16_t count;                  /* Number of chunks in the list */
+};
+
+/* This is the chunk cache for one CPU */
+
+struct mm_cpucache_s
+{
+  struct mm_cachebin_s bins[MM_CACHE_NBINS];
+};
+#endif
+
+#ifdef CONFIG_MM_PROFILE
+/* This holds the statistics of one allocation call site */
+
+struct mm_profsite_s
+{
+  FAR void *caller;                /* Return address of the heap entry */
+  uint32_t nallocs;                /* Number of allocations */
+  uint32_t nfrees;                 /* Number of allocations freed */
+  size_t curbytes;                 /* Requested bytes still allocated */
+  size_t maxbytes;                 /* Peak value of curbytes */
+  uint64_t lifetime;               /* Sum of lifetimes of freed allocations */
+  uint32_t maxlife;                /* Longest lifetime of a freed allocation */
+
+  /* Histogram of the requested sizes */
+
+  uint32_t hist[MM_PROFILE_NBUCKETS];
+};
+
+/* This record is kept at the end of each profiled chunk.  The lifetimes
+ * are in units of system clock ticks.
+ */
+
+struct mm_proftail_s
+{
+  uint32_t tstamp;                 /* System tick count when allocated */
+  uint32_t size;                   /* The requested size */
+  pid_t pid;                       /* The task that allocated the chunk */
+  uint16_t site;                   /* Index into mm_profsite[] */
+};
+
+/* This describes the live allocations of one task */
+
+struct mm_profpid_s
+{
+  pid_t pid;                       /* The allocating task */
+  size_t nblks;                    /* Number of live allocations */
+  size_t bytes;                    /* Requested bytes of those allocations */
+};
+#endif
+
+#ifdef CONFIG_MM_FRAGSTATS
+/* These are the heap operations of one CPU.  The byte counts are the
+ * sizes of the chunks, including the chunk headers.
+ */
+
+struct mm_cpustats_s
+{
+  uint32_t nallocs;                /* Number of allocations */
+  uint32_t nfrees;                 /* Number of frees */
+  uint64_t allocbytes;             /* Bytes allocated */
+  uint64_t freebytes;              /* Bytes freed */
+};
+
+/* This describes the free chunks of one bucket */
+
+struct mm_fragbucket_s
+{
+  size_t minsize;                  /* Smallest chunk size of the bucket */
+  size_t nfree;                    /* Number of free chunks */
+  size_t bytes;                    /* Total size of the free chunks */
+};
+
+/* This is the fragmentation report of one heap.  'frag' is the part of
+ * the free memory that is not in the largest free chunk, in units of 0.1
+ * percent:  0 if all free memory is available in one chunk.  Chunks held
+ * in the per-CPU caches count as allocated.
+ */
+
+struct mm_fraginfo_s
+{
+  size_t freebytes;                /* Total size of the free chunks */
+  size_t nfree;                    /* Number of free chunks */
+  size_t largest;                  /* Size of the largest free chunk */
+  unsigned int frag;               /* Fragmentation in permille */
+  struct mm_fragbucket_s buckets[MM_FRAG_NBUCKETS];
+#ifdef MM_HAVE_CPUSTATS
+  struct mm_cpustats_s cpus[MM_STATS_NCPUS];
+#endif
+};
+#endif
+
+/* What is the size of the profiler record? */
+
+#ifdef MM_HAVE_PROFILE
+#  define SIZEOF_MM_PROFTAIL ((sizeof(struct mm_proftail_s) + 7) & ~7)
+#else
+#  define SIZEOF_MM_PROFTAIL 0
+#endif
+
 /* What is the size of the freenode? */
 
 #define MM_PTR_SIZE sizeof(FAR struct mm_freenode_s *)
@@ -247,16 +464,69 @@ struct mm_heap_s
   int mm_nregions;
 #endif
 
+#ifdef CONFIG_MM_REGION_ATTR
+  /* The placement attributes of each region and of all regions together */
+
+  uint8_t mm_regattr[CONFIG_MM_REGIONS];
+  uint8_t mm_allattr;
+#endif
+
+#ifdef CONFIG_MM_TLSF
+  /* All free nodes are maintained in segregated, doubly linked lists.
+   * A bit is set in mm_slbitmap[fl] for each non-empty second level list
+   * and a bit is set in mm_flbitmap for each non-zero mm_slbitmap[].
+   */
+
+  uint32_t mm_flbitmap;
+  uint32_t mm_slbitmap[MM_TLSF_FLCOUNT];
+  FAR struct mm_freenode_s *mm_freelist[MM_TLSF_FLCOUNT][MM_TLSF_SLCOUNT];
+#else
   /* All free nodes are maintained in a doubly linked list.  This
    * array provides some hooks into the list at various points to
    * speed searches for free nodes.
    */
 
   struct mm_freenode_s mm_nodelist[MM_NNODES];
+#endif
 
   /* Free delay list, for some situation can't do free immdiately */
 
   struct mm_delaynode_s *mm_delaylist;
+
+#ifdef CONFIG_MM_CPUCACHE
+  /* Per-CPU caches of small chunks.  Each cache is accessed only by its
+   * own CPU with local interrupts disabled.
+   */
+
+  struct mm_cpucache_s mm_cache[MM_CACHE_NCPUS];
+#endif
+
+#ifdef CONFIG_MM_PROFILE
+  /* Allocation statistics for each call site.  These are protected by the
+   * critical section so that they can also be updated from interrupt
+   * handlers.
+   */
+
+  struct mm_profsite_s mm_profsite[CONFIG_MM_PROFILE_NSITES];
+  uint32_t mm_profdropped;         /* Allocations from untracked sites */
+#endif
+
+#ifdef CONFIG_MM_FRAGSTATS
+  /* The number and the total size of the free chunks in each bucket.
+   * These are updated with the free lists, under the MM semaphore.
+   */
+
+  size_t mm_fragnfree[MM_FRAG_NBUCKETS];
+  size_t mm_fragbytes[MM_FRAG_NBUCKETS];
+
+#ifdef MM_HAVE_CPUSTATS
+  /* Heap operations of each CPU.  Each entry is updated only by its own
+   * CPU with local interrupts disabled.
+   */
+
+  struct mm_cpustats_s mm_cpustats[MM_STATS_NCPUS];
+#endif
+#endif
 };
 
 /****************************************************************************
@@ -317,6 +587,10 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heap_start,
                    size_t heap_size);
 void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
                   size_t heapsize);
+#ifdef CONFIG_MM_REGION_ATTR
+void mm_addregion_attr(FAR struct mm_heap_s *heap, FAR void *heapstart,
+                       size_t heapsize, int attr);
+#endif
 
 /* Functions contained in umm_initialize.c **********************************/
 
@@ -331,11 +605,17 @@ void kmm_initialize(FAR void *heap_start, size_t heap_size);
 /* Functions contained in umm_addregion.c ***********************************/
 
 void umm_addregion(FAR void *heapstart, size_t heapsize);
+#ifdef CONFIG_MM_REGION_ATTR
+void umm_addregion_attr(FAR void *heapstart, size_t heapsize, int attr);
+#endif
 
 /* Functions contained in kmm_addregion.c ***********************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 void kmm_addregion(FAR void *heapstart, size_t heapsize);
+#ifdef CONFIG_MM_REGION_ATTR
+void kmm_addregion_attr(FAR void *heapstart, size_t heapsize, int attr);
+#endif
 #endif
 
 /* Functions contained in mm_sem.c ******************************************/
@@ -360,11 +640,22 @@ void kmm_givesemaphore(void);
 /* Functions contained in mm_malloc.c ***************************************/
 
 FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size);
+#ifdef MM_HAVE_PROFILE
+FAR void *mm_malloc_caller(FAR struct mm_heap_s *heap, size_t size,
+                           FAR void *caller);
+#endif
+#ifdef CONFIG_MM_REGION_ATTR
+FAR void *mm_malloc_attr(FAR struct mm_heap_s *heap, size_t size,
+                         int attr);
+#endif
 
 /* Functions contained in kmm_malloc.c **************************************/
 
 #ifdef CONFIG_MM_KERNEL_HEAP
 FAR void *kmm_malloc(size_t size);
+#ifdef CONFIG_MM_REGION_ATTR
+FAR void *kmm_malloc_attr(size_t size, int attr);
+#endif
 #endif
 
 /* Functions contained in mm_free.c *****************************************/
@@ -422,6 +713,9 @@ FAR void *kmm_memalign(size_t alignment, size_t size);
 /* Functions contained in mm_heapmember.c ***********************************/
 
 bool mm_heapmember(FAR struct mm_heap_s *heap, FAR void *mem);
+#ifdef CONFIG_MM_REGION_ATTR
+int mm_regionattr(FAR struct mm_heap_s *heap, FAR void *mem);
+#endif
 
 /* Functions contained in mm_uheapmember.c **********************************/
 
@@ -492,15 +786,68 @@ struct mallinfo kmm_mallinfo(void);
 void mm_shrinkchunk(FAR struct mm_heap_s *heap,
                     FAR struct mm_allocnode_s *node, size_t size);
 
-/* Functions contained in mm_addfreechunk.c *********************************/
+/* Functions contained in mm_addfreechunk.c or mm_tlsf.c ********************/
 
 void mm_addfreechunk(FAR struct mm_heap_s *heap,
                      FAR struct mm_freenode_s *node);
 
+/* Functions contained in mm_delfreechunk.c or mm_tlsf.c ********************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node);
+
+/* Functions contained in mm_findfreechunk.c or mm_tlsf.c *******************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size);
+#ifdef CONFIG_MM_REGION_ATTR
+FAR struct mm_freenode_s *mm_findfreechunk_attr(FAR struct mm_heap_s *heap,
+                                                size_t size, int attr);
+#endif
+
+/* Functions contained in mm_tlsf.c *****************************************/
+
+#ifdef CONFIG_MM_TLSF
+void mm_tlsf_initialize(FAR struct mm_heap_s *heap);
+#endif
+
 /* Functions contained in mm_size2ndx.c.c ***********************************/
 
 int mm_size2ndx(size_t size);
 
+/* Functions contained in mm_cache.c ****************************************/
+
+#ifdef MM_HAVE_CPUCACHE
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t size);
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem);
+FAR struct mm_delaynode_s *mm_cache_drain(FAR struct mm_heap_s *heap,
+                                          size_t size);
+#endif
+
+/* Functions contained in mm_profile.c **************************************/
+
+#ifdef MM_HAVE_PROFILE
+void mm_profile_alloc(FAR struct mm_heap_s *heap, FAR void *mem,
+                      size_t size, FAR void *caller);
+void mm_profile_free(FAR struct mm_heap_s *heap, FAR void *mem);
+void mm_profile_ignore(FAR void *mem);
+int mm_profile_site(FAR struct mm_heap_s *heap, int ndx,
+                    FAR struct mm_profsite_s *site);
+int mm_profile_pids(FAR struct mm_heap_s *heap,
+                    FAR struct mm_profpid_s *pids, int npids);
+#endif
+
+/* Functions contained in mm_fragstats.c ************************************/
+
+#ifdef CONFIG_MM_FRAGSTATS
+int mm_fraginfo(FAR struct mm_heap_s *heap,
+                FAR struct mm_fraginfo_s *info);
+#ifdef MM_HAVE_CPUSTATS
+void mm_cpustats_alloc(FAR struct mm_heap_s *heap, FAR void *mem);
+void mm_cpustats_free(FAR struct mm_heap_s *heap, FAR void *mem);
+#endif
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
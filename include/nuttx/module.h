@@ -85,6 +85,30 @@ extern "C"
 
 FAR void *insmod(FAR const char *filename, FAR const char *modname);
 
+/****************************************************************************
+ * Name: insmod_lazy
+ *
+ * Description:
+ *   Register a module without loading it.  The module is loaded on its
+ *   first use:  When its symbols are looked up with modsym() or when
+ *   another module that is being loaded has symbols that are not exported
+ *   by any loaded module.
+ *
+ * Input Parameters:
+ *   filename - Full path to the module binary to be loaded
+ *   modname  - The name that can be used to refer to the module.
+ *
+ * Returned Value:
+ *   A non-NULL module handle that can be used on subsequent calls to other
+ *   module interfaces is returned on success.  Otherwise, a NULL handle is
+ *   returned and the errno variable is set appropriately.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODULE_LAZY
+FAR void *insmod_lazy(FAR const char *filename, FAR const char *modname);
+#endif
+
 /****************************************************************************
  * Name: rmmod
  *
@@ -274,6 +274,22 @@ int mtd_setpartitionname(FAR struct mtd_dev_s *mtd, FAR const char *name);
 FAR struct mtd_dev_s *mtd_rwb_initialize(FAR struct mtd_dev_s *mtd);
 #endif
 
+/************************************************************************************
+ * Name: mtd_rwb_initialize_nblocks
+ *
+ * Description:
+ *   Create an initialized MTD device instance like mtd_rwb_initialize(), but
+ *   with the given number of write buffer and read-ahead blocks.  This is
+ *   usually used to buffer each partition (see mtd_partition()) differently.
+ *
+ ************************************************************************************/
+
+#if defined(CONFIG_MTD_WRBUFFER) || defined(CONFIG_MTD_READAHEAD)
+FAR struct mtd_dev_s *mtd_rwb_initialize_nblocks(FAR struct mtd_dev_s *mtd,
+                                                 uint16_t nwrblocks,
+                                                 uint16_t nrdblocks);
+#endif
+
 /****************************************************************************
  * Name: ftl_initialize_by_path
  *
@@ -322,6 +338,28 @@ int ftl_initialize(int minor, FAR struct mtd_dev_s *mtd);
 int smart_initialize(int minor, FAR struct mtd_dev_s *mtd,
                      FAR const char *partname);
 
+/****************************************************************************
+ * Name: lzfblk_initialize_by_path and lzfblk_initialize
+ *
+ * Description:
+ *   Initialize a read-only block driver that presents the uncompressed
+ *   contents of an LZF block image (made by tools/mklzfblk.py) stored on
+ *   an MTD device.  A file system can then be mounted read-only on it.
+ *
+ * Input Parameters:
+ *   path - The block device path.
+ *   minor - The minor device number.  The block device will be
+ *      registered as /dev/lzfblockN where N is the minor number.
+ *   mtd - The MTD device that holds the image.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_LZFBLK
+int lzfblk_initialize_by_path(FAR const char *path,
+                              FAR struct mtd_dev_s *mtd);
+int lzfblk_initialize(int minor, FAR struct mtd_dev_s *mtd);
+#endif
+
 /* MTD Driver Initialization ************************************************/
 
 /* Create an initialized MTD device instance for a particular memory device.
@@ -96,6 +96,12 @@ struct mtd_smart_procfs_data_s
 #endif
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
   uint32_t            uneven_wearcount; /* Number of uneven block erases */
+#endif
+  uint32_t            gccollects;       /* Blocks collected by writes */
+  uint32_t            gctime;           /* Total time of those (msec) */
+  uint32_t            gcmaxtime;        /* Longest of those (msec) */
+#ifdef CONFIG_MTD_SMART_BGGC
+  uint32_t            bgcollects;       /* Blocks collected in background */
 #endif
 };
 
@@ -214,6 +214,10 @@ struct sock_intf_s
   CODE ssize_t    (*si_recvfrom)(FAR struct socket *psock, FAR void *buf,
                     size_t len, int flags, FAR struct sockaddr *from,
                     FAR socklen_t *fromlen);
+#ifdef CONFIG_NET_TIMESTAMP
+  CODE ssize_t    (*si_recvmsg)(FAR struct socket *psock,
+                    FAR struct msghdr *msg, int flags);
+#endif
   CODE int        (*si_close)(FAR struct socket *psock);
 #ifdef CONFIG_NET_USRSOCK
   CODE int        (*si_ioctl)(FAR struct socket *psock, int cmd,
@@ -1052,6 +1056,104 @@ ssize_t nx_recvfrom(int sockfd, FAR void *buf, size_t len, int flags,
 
 #define nx_recv(psock,buf,len,flags) nx_recvfrom(psock,buf,len,flags,NULL,0)
 
+/****************************************************************************
+ * Name: psock_recvmsg
+ *
+ * Description:
+ *   psock_recvmsg() receives a message from a socket together with its
+ *   ancillary data.  This is an internal OS interface.  It is functionally
+ *   equivalent to recvmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ *   Only a single I/O vector is supported.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - The message header with the buffer and, optionally, the source
+ *           address and control data buffers
+ *   flags - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received and updates
+ *   msg_namelen, msg_controllen and msg_flags.  On any failure, a negated
+ *   errno value is returned (see comments with recvfrom() for a list of
+ *   appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags);
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives up to 'vlen' messages from a socket with the
+ *   network locked only once.  This is an internal OS interface.  It is
+ *   functionally equivalent to recvmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The messages.  msg_len is set to the length of each message
+ *             received.
+ *   vlen    - The number of messages in msgvec
+ *   flags   - Receive flags.  With MSG_WAITFORONE, only the first message
+ *             is waited for.
+ *   timeout - No further messages are waited for once this time has
+ *             passed, if not NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  If an error
+ *   occurs before the first message is received, a negated errno value is
+ *   returned.
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR const struct timespec *timeout);
+
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends up to 'vlen' messages on a socket with the
+ *   network locked only once, so that the network device is polled for
+ *   all of them together.  This is an internal OS interface.  It is
+ *   functionally equivalent to sendmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ *   Only a single I/O vector per message is supported.
+ *
+ * Input Parameters:
+ *   psock  - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec - The messages.  msg_len is set to the length of each message
+ *            sent.
+ *   vlen   - The number of messages in msgvec
+ *   flags  - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent.  If an error occurs
+ *   before the first message is sent, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags);
+
 /****************************************************************************
  * Name: psock_getsockopt
  *
@@ -51,8 +51,14 @@
 
 #include <sys/ioctl.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <queue.h>
 
+#ifdef CONFIG_NET_TIMESTAMP
+#  include <sys/socket.h>
+#  include <time.h>
+#endif
+
 #include <net/if.h>
 #include <net/ethernet.h>
 #include <arpa/inet.h>
@@ -60,6 +66,10 @@
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/ip.h>
 
+#ifdef CONFIG_NETDEV_RXPOLL
+#  include <nuttx/wqueue.h>
+#endif
+
 #ifdef CONFIG_NET_IGMP
 #  include <nuttx/net/igmp.h>
 #endif
@@ -152,6 +162,29 @@
 #  define NETDEV_ERRORS(dev)
 #endif
 
+/* Hardware offload features of a network device (d_features):
+ *
+ * NETDEV_FEATURE_TXCSUM - The hardware inserts the IPv4 header checksum and
+ *   the TCP and UDP checksums of outgoing frames.  The stack leaves these
+ *   fields zero.
+ * NETDEV_FEATURE_RXCSUM - The hardware verifies the IPv4 header checksum
+ *   and the TCP and UDP checksums of received frames and drops frames with
+ *   bad checksums.
+ * NETDEV_FEATURE_TSO - The hardware splits outgoing TCP super-segments of up
+ *   to d_tsomax bytes of payload into segments of d_txmss bytes.  This
+ *   requires scatter-gather transmit (d_txsg) and NETDEV_FEATURE_TXCSUM.
+ */
+
+#define NETDEV_FEATURE_TXCSUM   (1 << 0)
+#define NETDEV_FEATURE_RXCSUM   (1 << 1)
+#define NETDEV_FEATURE_TSO      (1 << 2)
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+#  define NETDEV_HAS_FEATURE(dev, f) (((dev)->d_features & (f)) != 0)
+#else
+#  define NETDEV_HAS_FEATURE(dev, f) (0)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -214,12 +247,38 @@ struct netdev_varaddr_s
 };
 #endif
 
+#ifdef CONFIG_NET_TIMESTAMP
+/* The timestamping state of a UDP or packet socket (SO_TIMESTAMP and
+ * SO_TIMESTAMPING).  ts_tx holds the transmit timestamps of the last frame
+ * sent; ts_txvalid tells which of them (SOF_TIMESTAMPING_TX_*) are valid
+ * and not yet read with recvmsg(MSG_ERRQUEUE).
+ */
+
+struct net_tstamp_s
+{
+  bool     ts_timeval;          /* SO_TIMESTAMP is enabled */
+  uint8_t  ts_flags;            /* SO_TIMESTAMPING flags */
+  uint8_t  ts_txvalid;          /* Valid transmit timestamps */
+
+  /* Transmit timestamps */
+
+  struct scm_timestamping ts_tx;
+};
+
+/* True if the socket wants the receive time of its datagrams */
+
+#define NET_TSTAMP_RXENABLED(t) \
+  ((t)->ts_timeval || ((t)->ts_flags & (SOF_TIMESTAMPING_RX_SOFTWARE | \
+                                        SOF_TIMESTAMPING_RX_HARDWARE)) != 0)
+#endif
+
 /* This structure collects information that is specific to a specific network
  * interface driver.  If the hardware platform supports only a single instance
  * of this structure.
  */
 
 struct devif_callback_s; /* Forward reference */
+struct iob_s;            /* Forward reference */
 
 struct net_driver_s
 {
@@ -242,6 +301,15 @@ struct net_driver_s
 
   uint8_t d_flags;
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* Hardware offload features of the driver.  See NETDEV_FEATURE_*
+   * definitions.  These are set by the driver before registering the
+   * device.
+   */
+
+  uint8_t d_features;
+#endif
+
   /* Multi network devices using multiple link layer protocols are supported */
 
   uint8_t d_lltype;             /* See enum net_lltype_e */
@@ -301,6 +369,61 @@ struct net_driver_s
 
   FAR uint8_t *d_buf;
 
+#ifdef CONFIG_NETDEV_IOB_RX
+  /* d_iob is the I/O buffer that holds d_buf when the driver receives
+   * frames with netdev_iob_prepare().  The payload of a received TCP or UDP
+   * packet may be handed to a socket together with this IOB; d_iob and
+   * d_buf are then replaced by a new IOB holding a copy of the headers.
+   */
+
+  FAR struct iob_s *d_iob;
+#endif
+
+#ifdef CONFIG_NETDEV_IOB_TX
+  /* Scatter-gather transmit.  A driver that can send a frame from several
+   * fragments sets d_txsg before registering the device.  The payload of an
+   * outgoing TCP packet may then be left in the I/O buffer chain d_txiob:
+   * The frame consists of the first d_len - d_txlen bytes of d_buf followed
+   * by d_txlen bytes of d_txiob starting at offset d_txoffset.  d_txiob is
+   * NULL if the whole frame is in d_buf.
+   *
+   * The I/O buffer chain is not owned by the driver.  It belongs to the TCP
+   * write buffer and stays valid until the data is acknowledged by the
+   * peer or the connection is freed.
+   */
+
+  bool d_txsg;
+  FAR struct iob_s *d_txiob;
+  uint16_t d_txoffset;
+  uint16_t d_txlen;
+#endif
+
+#ifdef CONFIG_NETDEV_TSO
+  /* TCP segmentation offload.  d_tsomax is set by the driver to the largest
+   * TCP payload that the hardware can split into segments.  d_txmss is set
+   * by the stack to the MSS of the connection if the outgoing frame is a
+   * super-segment that the hardware must split; it is zero otherwise.
+   */
+
+  uint16_t d_tsomax;
+  uint16_t d_txmss;
+#endif
+
+#ifdef CONFIG_NET_TIMESTAMP
+  /* Packet timestamps.  A driver with hardware timestamping sets d_rxtime
+   * to the time each frame was received before passing the frame to the
+   * network; it stays zero otherwise.
+   *
+   * d_txtstamp is set by the network if the socket that sent the frame in
+   * d_buf requested a hardware transmit timestamp.  The driver then takes
+   * a timestamp for that frame, sets d_txtstamp to NULL and later reports
+   * the timestamp with netdev_txtimestamp().
+   */
+
+  struct timespec d_rxtime;
+  FAR struct net_tstamp_s *d_txtstamp;
+#endif
+
   /* d_appdata points to the location where application data can be read from
    * or written to in the packet buffer.
    */
@@ -344,6 +467,7 @@ struct net_driver_s
 
 #ifdef CONFIG_NET_IGMP
   sq_queue_t d_igmp_grplist;    /* IGMP group list */
+  uint32_t d_igmp_grpmap;       /* Hash of the IGMP group addresses */
 #endif
 #ifdef CONFIG_NET_MLD
   struct mld_netdev_s d_mld;    /* MLD state information */
@@ -402,6 +526,28 @@ struct net_driver_s
 
 typedef CODE int (*devif_poll_callback_t)(FAR struct net_driver_s *dev);
 
+#ifdef CONFIG_NETDEV_RXPOLL
+/* Budgeted receive polling.  The receive callback is called with the
+ * network locked to receive and dispatch one frame (including sending any
+ * reply).  It returns a positive value if a frame was processed, zero if
+ * no more frames are pending, or a negated errno value on a failure.  The
+ * enable callback re-enables the receive interrupt of the device.
+ */
+
+typedef CODE int (*netdev_rxpoll_receive_t)(FAR struct net_driver_s *dev);
+typedef CODE void (*netdev_rxpoll_enable_t)(FAR struct net_driver_s *dev);
+
+struct netdev_rxpoll_s
+{
+  struct work_s rp_work;              /* Receive polling work */
+  FAR struct net_driver_s *rp_dev;    /* The polled device */
+  netdev_rxpoll_receive_t rp_receive; /* Receive one frame */
+  netdev_rxpoll_enable_t rp_enable;   /* Re-enable the receive interrupt */
+  int rp_qid;                         /* The work queue to poll on */
+  int rp_budget;                      /* Maximum frames per poll */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -605,6 +751,198 @@ int devif_loopback(FAR struct net_driver_s *dev);
 int netdev_carrier_on(FAR struct net_driver_s *dev);
 int netdev_carrier_off(FAR struct net_driver_s *dev);
 
+/****************************************************************************
+ * Name: netdev_iob_prepare
+ *
+ * Description:
+ *   Make sure that the device has an I/O buffer to receive the next frame
+ *   into and set d_buf to the data of that I/O buffer.  This should be
+ *   called by the driver before it receives each frame into d_buf.
+ *
+ * Input Parameters:
+ *   dev       - The network device
+ *   throttled - An indication of the I/O buffer should be allocated from
+ *               the throttled pool
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOMEM is returned if no I/O buffer
+ *   is available.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_RX
+int netdev_iob_prepare(FAR struct net_driver_s *dev, bool throttled);
+#endif
+
+/****************************************************************************
+ * Name: netdev_iob_release
+ *
+ * Description:
+ *   Release the receive I/O buffer of the device, as when the device is
+ *   brought down.  d_buf is set to NULL.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_RX
+void netdev_iob_release(FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: netdev_rxpoll_initialize
+ *
+ * Description:
+ *   Initialize the receive polling state of a network device.
+ *
+ * Input Parameters:
+ *   rxpoll  - The receive polling state, usually part of the driver state
+ *   dev     - The network device
+ *   qid     - The work queue to poll on (HPWORK or LPWORK)
+ *   receive - Called to receive and dispatch one frame
+ *   enable  - Called to re-enable the receive interrupt
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_RXPOLL
+void netdev_rxpoll_initialize(FAR struct netdev_rxpoll_s *rxpoll,
+                              FAR struct net_driver_s *dev, int qid,
+                              netdev_rxpoll_receive_t receive,
+                              netdev_rxpoll_enable_t enable);
+#endif
+
+/****************************************************************************
+ * Name: netdev_rxpoll_schedule
+ *
+ * Description:
+ *   Schedule the receive polling of a device.  This is called from the
+ *   receive interrupt handler after the receive interrupt was disabled.  The
+ *   poll drains up to CONFIG_NETDEV_RXPOLL_BUDGET frames while holding the
+ *   network lock once.  If more frames are pending, the poll is rescheduled
+ *   with the interrupt still disabled; otherwise the interrupt is
+ *   re-enabled.
+ *
+ * Input Parameters:
+ *   rxpoll - The receive polling state
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_RXPOLL
+int netdev_rxpoll_schedule(FAR struct netdev_rxpoll_s *rxpoll);
+#endif
+
+/****************************************************************************
+ * Name: netdev_rxpoll_cancel
+ *
+ * Description:
+ *   Cancel any pending receive polling, as when the device is brought
+ *   down.  The receive interrupt is not re-enabled.
+ *
+ * Input Parameters:
+ *   rxpoll - The receive polling state
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_RXPOLL
+void netdev_rxpoll_cancel(FAR struct netdev_rxpoll_s *rxpoll);
+#endif
+
+/****************************************************************************
+ * Name: netdev_iob_txlinearize
+ *
+ * Description:
+ *   Copy the payload of an outgoing frame from d_txiob into d_buf behind
+ *   the headers so that the whole frame is in d_buf.  This may be called by
+ *   a scatter-gather driver that cannot send the fragments of a frame.
+ *   Nothing is done if the frame is already in d_buf.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_TX
+void netdev_iob_txlinearize(FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: netdev_iob_txreset
+ *
+ * Description:
+ *   Forget the payload fragment of the outgoing frame.  This is done
+ *   whenever a new packet is built in d_buf.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NETDEV_TSO)
+#  define netdev_iob_txreset(dev) \
+     do { (dev)->d_txiob = NULL; (dev)->d_txlen = 0; (dev)->d_txmss = 0; } \
+     while (0)
+#elif defined(CONFIG_NETDEV_IOB_TX)
+#  define netdev_iob_txreset(dev) \
+     do { (dev)->d_txiob = NULL; (dev)->d_txlen = 0; } while (0)
+#else
+#  define netdev_iob_txreset(dev)
+#endif
+
+/****************************************************************************
+ * Name: netdev_txtimestamp
+ *
+ * Description:
+ *   Report the hardware transmit timestamp of a frame to the socket that
+ *   sent it.  This is called by the driver when the timestamp of a frame
+ *   that was sent with d_txtstamp set becomes available.
+ *
+ * Input Parameters:
+ *   dev    - The network device that sent the frame
+ *   tstamp - The value of d_txtstamp when the frame was sent
+ *   ts     - The time the frame was transmitted
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMP
+void netdev_txtimestamp(FAR struct net_driver_s *dev,
+                        FAR struct net_tstamp_s *tstamp,
+                        FAR const struct timespec *ts);
+#endif
+
+/****************************************************************************
+ * Name: netdev_txtstamp_reset
+ *
+ * Description:
+ *   Forget the transmit timestamp request of the outgoing frame, as when
+ *   the frame in d_buf is replaced by another one.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMP
+#  define netdev_txtstamp_reset(dev) do { (dev)->d_txtstamp = NULL; } while (0)
+#else
+#  define netdev_txtstamp_reset(dev)
+#endif
+
 /****************************************************************************
  * Name: net_ioctl_arglen
  *
@@ -76,8 +76,14 @@
 #define TCP_OPT_END       0   /* End of TCP options list */
 #define TCP_OPT_NOOP      1   /* "No-operation" TCP option */
 #define TCP_OPT_MSS       2   /* Maximum segment size TCP option */
+#define TCP_OPT_WS        3   /* Window scale TCP option */
+#define TCP_OPT_SACK_PERM 4   /* Selective acknowledgment permitted option */
+#define TCP_OPT_SACK      5   /* Selective acknowledgment option */
 
 #define TCP_OPT_MSS_LEN   4   /* Length of TCP MSS option. */
+#define TCP_OPT_WS_LEN    3   /* Length of TCP window scale option. */
+#define TCP_OPT_SACK_PERM_LEN 2 /* Length of TCP SACK permitted option */
+#define TCP_OPT_SACK_BLKLEN   8 /* Length of one block of the SACK option */
 
 /* The TCP states used in the struct tcp_conn_s tcpstateflags field */
 
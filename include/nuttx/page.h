@@ -44,6 +44,8 @@
 #include <nuttx/config.h>
 
 #ifndef __ASSEMBLY__
+#  include <sys/types.h>
+#  include <stdint.h>
 #  include <stdbool.h>
 #  include <nuttx/sched.h>
 #endif
@@ -224,11 +226,25 @@
  */
 
 /****************************************************************************
- * Public Data
+ * Public Types
  ****************************************************************************/
 
 #ifndef __ASSEMBLY__
 
+/* Page fault statistics, see pg_getstats() */
+
+struct pg_stats_s
+{
+  uint32_t pg_faults;    /* Number of page faults (calls to pg_miss()) */
+  uint32_t pg_fills;     /* Number of page fills */
+  uint32_t pg_mapped;    /* Faults found to be mapped before the fill */
+  clock_t  pg_filltime;  /* Total time spent in page fills, in ticks */
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
 #undef EXTERN
 #if defined(__cplusplus)
 #define EXTERN extern "C"
@@ -311,6 +327,22 @@ extern "C"
 
 void pg_miss(void);
 
+/****************************************************************************
+ * Name: pg_getstats
+ *
+ * Description:
+ *   Return the page fault statistics since boot.
+ *
+ * Input Parameters:
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pg_getstats(FAR struct pg_stats_s *stats);
+
 /****************************************************************************
  * Public Functions -- Provided by architecture-specific logic to common
  *                     paging logic.
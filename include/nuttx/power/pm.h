@@ -72,6 +72,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <queue.h>
 
 #ifdef CONFIG_PM
@@ -283,6 +284,18 @@ struct pm_governor_s
   FAR void *priv;
 };
 
+/* A wakeup latency constraint of a driver (see pm_qos_add()).  The
+ * structure is allocated by the driver and must stay valid until it is
+ * removed with pm_qos_remove().
+ */
+
+struct pm_qos_s
+{
+  struct dq_entry_s entry;   /* Supports a doubly linked list */
+  int domain;                /* The PM domain of the constraint */
+  uint32_t latency;          /* Maximum tolerable wakeup latency (usec) */
+};
+
 /* To be used for accessing the user governor via ioctl calls */
 
 struct pm_user_governor_state_s
@@ -460,6 +473,92 @@ void pm_relax(int domain, enum pm_state_e state);
 
 uint32_t pm_staycount(int domain, enum pm_state_e state);
 
+/****************************************************************************
+ * Name: pm_qos_add
+ *
+ * Description:
+ *   This function is called by a device driver to declare the longest
+ *   wakeup latency that it can tolerate in a PM domain.  The governor will
+ *   not recommend a state that takes longer to leave.  The constraint holds
+ *   until it is removed with pm_qos_remove().
+ *
+ * Input Parameters:
+ *   qos     - The constraint structure allocated by the driver
+ *   domain  - The domain of the constraint
+ *   latency - The maximum tolerable wakeup latency in microseconds
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void pm_qos_add(FAR struct pm_qos_s *qos, int domain, uint32_t latency);
+
+/****************************************************************************
+ * Name: pm_qos_update
+ *
+ * Description:
+ *   This function is called by a device driver to change the latency of a
+ *   constraint added with pm_qos_add().
+ *
+ * Input Parameters:
+ *   qos     - The constraint to change
+ *   latency - The new maximum tolerable wakeup latency in microseconds
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void pm_qos_update(FAR struct pm_qos_s *qos, uint32_t latency);
+
+/****************************************************************************
+ * Name: pm_qos_remove
+ *
+ * Description:
+ *   This function is called by a device driver to remove a constraint added
+ *   with pm_qos_add().
+ *
+ * Input Parameters:
+ *   qos - The constraint to remove
+ *
+ * Returned Value:
+ *   None.
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+void pm_qos_remove(FAR struct pm_qos_s *qos);
+
+/****************************************************************************
+ * Name: pm_qos_latency
+ *
+ * Description:
+ *   This function is called by the governor to get the strictest wakeup
+ *   latency constraint of a PM domain.
+ *
+ * Input Parameters:
+ *   domain - The domain of the constraints
+ *
+ * Returned Value:
+ *   The smallest tolerable wakeup latency in microseconds or UINT32_MAX if
+ *   there is no constraint.
+ *
+ * Assumptions:
+ *   This function may be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+uint32_t pm_qos_latency(int domain);
+
 /****************************************************************************
  * Name: pm_checkstate
  *
@@ -563,6 +662,9 @@ enum pm_state_e pm_querystate(int domain);
 #  define pm_checkstate(domain)        (0)
 #  define pm_changestate(domain,state) (0)
 #  define pm_querystate(domain)        (0)
+#  define pm_qos_add(qos,domain,lat)
+#  define pm_qos_update(qos,lat)
+#  define pm_qos_remove(qos)
 
 #endif /* CONFIG_PM */
 #endif /* __INCLUDE_NUTTX_POWER_PM_H */
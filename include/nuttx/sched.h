@@ -75,6 +75,17 @@
 #  define CONFIG_SCHED_SPORADIC_MAXREPL 3
 #endif
 
+/* Number of pthread TCBs kept for reuse (see sched/pthread/pthread_tcb.c) */
+
+#if !defined(CONFIG_PTHREAD_TCB_CACHE) || defined(CONFIG_DISABLE_PTHREAD)
+#  undef CONFIG_PTHREAD_TCB_CACHE
+#  define CONFIG_PTHREAD_TCB_CACHE 0
+#endif
+
+/* Tracepoints (see include/nuttx/sched_note.h) */
+
+#define SCHED_TRACE_NCATEGORIES    5
+
 /* Task Management Definitions **************************************************/
 
 /* Special task IDS.  Any negative PID is invalid. */
@@ -106,7 +117,8 @@
 #define TCB_FLAG_SIGNAL_ACTION     (1 << 8)                      /* Bit 8: In a signal handler */
 #define TCB_FLAG_SYSCALL           (1 << 9)                      /* Bit 9: In a system call */
 #define TCB_FLAG_EXIT_PROCESSING   (1 << 10)                     /* Bit 10: Exitting */
-                                                                 /* Bits 11-15: Available */
+#define TCB_FLAG_COND_MORPHED      (1 << 11)                     /* Bit 11: Condition wait moved to mutex */
+                                                                 /* Bits 12-15: Available */
 
 /* Values for struct task_group tg_flags */
 
@@ -131,7 +143,8 @@
 #define SPORADIC_FLAG_ALLOCED      (1 << 0)                      /* Bit 0: Timer is allocated */
 #define SPORADIC_FLAG_MAIN         (1 << 1)                      /* Bit 1: The main timer */
 #define SPORADIC_FLAG_REPLENISH    (1 << 2)                      /* Bit 2: Replenishment cycle */
-                                                                 /* Bits 3-7: Available */
+#define SPORADIC_FLAG_DELAYED      (1 << 3)                      /* Bit 3: Replenishment is pending */
+                                                                 /* Bits 4-7: Available */
 
 /* Most internal nxsched_* interfaces are not available in the user space in
  * PROTECTED and KERNEL builds.  In that context, the application semaphore
@@ -270,7 +283,7 @@ struct sporadic_s;
 struct replenishment_s
 {
   FAR struct tcb_s *tcb;            /* The parent TCB structure                 */
-  WDOG_ID timer;                    /* Timer dedicated to this interval         */
+  struct wdog_s timer;              /* Timer dedicated to this interval         */
   uint32_t budget;                  /* Current budget time                      */
   uint8_t  flags;                   /* See SPORADIC_FLAG_* definitions          */
 };
@@ -292,6 +305,10 @@ struct sporadic_s
   uint32_t  repl_period;            /* Sporadic replenishment period            */
   uint32_t  budget;                 /* Sporadic execution budget period         */
   clock_t   eventtime;              /* Time thread suspended or [re-]started    */
+#ifdef CONFIG_SCHED_SPORADIC_HIRES
+  uint32_t  eventstamp;             /* Cycle counter at eventtime               */
+  uint32_t  residue;                /* Unaccounted time below one tick (usec)   */
+#endif
 
   /* This is the last interval timer activated */
 
@@ -432,6 +449,10 @@ struct join_s;                      /* Forward reference
 struct binary_s;                    /* Forward reference                        */
                                     /* Defined in include/nuttx/binfmt/binfmt.h */
 #endif
+#ifndef CONFIG_DISABLE_ENVIRON
+struct environ_s;                   /* Forward reference                        */
+                                    /* Defined in sched/environ/environ.h       */
+#endif
 
 struct task_group_s
 {
@@ -538,6 +559,7 @@ struct task_group_s
 
   sq_queue_t tg_sigactionq;         /* List of actions for signals              */
   sq_queue_t tg_sigpendingq;        /* List of pending signals                  */
+  sigset_t tg_sigpendset;           /* Set of signals in tg_sigpendingq         */
 #ifdef CONFIG_SIG_DEFAULT
   sigset_t tg_sigdefault;           /* Set of signals set to the default action */
 #endif
@@ -545,8 +567,7 @@ struct task_group_s
 #ifndef CONFIG_DISABLE_ENVIRON
   /* Environment variables ******************************************************/
 
-  size_t     tg_envsize;            /* Size of environment string allocation    */
-  FAR char  *tg_envp;               /* Allocated environment strings            */
+  FAR struct environ_s *tg_env;     /* Environment (may be shared)              */
 #endif
 
 #ifndef CONFIG_DISABLE_POSIX_TIMERS
@@ -654,6 +675,9 @@ struct tcb_s
   int16_t  cpcount;                      /* Nested cancellation point count     */
 #endif
   int16_t  errcode;                      /* Used to pass error information      */
+#ifdef CONFIG_MM_REGION_ATTR
+  uint8_t  mmattr;                       /* Default heap placement attributes   */
+#endif
 
 #if CONFIG_RR_INTERVAL > 0 || defined(CONFIG_SCHED_SPORADIC)
   int32_t  timeslice;                    /* RR timeslice OR Sporadic budget     */
@@ -706,6 +730,14 @@ struct tcb_s
   uint32_t premp_max;                    /* Max time preemption disabled        */
   uint32_t crit_start;                   /* Time critical section entered       */
   uint32_t crit_max;                     /* Max time in critical section        */
+  uint32_t run_start;                    /* Time when last resumed              */
+  uint64_t run_time;                     /* Total time running                  */
+#endif
+
+#ifdef CONFIG_SCHED_TRACE_LATENCY
+  /* Begin times of the traced operations, one per tracepoint category */
+
+  uint32_t trace_start[SCHED_TRACE_NCATEGORIES];
 #endif
 
   /* State save areas ***********************************************************/
@@ -770,6 +802,9 @@ struct pthread_tcb_s
 
   pthread_addr_t arg;                    /* Startup argument                    */
   FAR void *joininfo;                    /* Detach-able info to support join    */
+#if CONFIG_PTHREAD_TCB_CACHE > 0
+  size_t stacksize;                      /* Requested size of a created stack   */
+#endif
 
   /* Robust mutex support *******************************************************/
 
@@ -820,6 +855,15 @@ EXTERN uint32_t g_crit_max[CONFIG_SMP_NCPUS];
 EXTERN uint32_t g_premp_max[1];
 EXTERN uint32_t g_crit_max[1];
 #endif
+
+#ifdef CONFIG_SMP
+/* Number of times that entering a critical section had to wait for
+ * another CPU and the maximum time waited.
+ */
+
+EXTERN uint32_t g_crit_contended[CONFIG_SMP_NCPUS];
+EXTERN uint32_t g_crit_waitmax[CONFIG_SMP_NCPUS];
+#endif
 #endif /* CONFIG_SCHED_CRITMONITOR */
 
 /********************************************************************************
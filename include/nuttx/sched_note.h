@@ -47,6 +47,7 @@
 #include <stdbool.h>
 
 #include <nuttx/sched.h>
+#include <nuttx/fs/ioctl.h>
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION
 
@@ -66,6 +67,69 @@
 #  define CONFIG_SCHED_NOTE_BUFSIZE 2048
 #endif
 
+#ifndef CONFIG_SCHED_INSTRUMENTATION_TRACEMASK
+#  define CONFIG_SCHED_INSTRUMENTATION_TRACEMASK 0x1f
+#endif
+
+/* Tracepoint categories.  Each category is one bit of g_note_tracemask. */
+
+#define NOTE_TRACE_NET       0  /* Network device polls (net/devif) */
+#define NOTE_TRACE_FS        1  /* File reads and writes (fs/vfs) */
+#define NOTE_TRACE_MM        2  /* Heap allocations (mm) */
+#define NOTE_TRACE_WQUEUE    3  /* Work queue items (sched/wqueue) */
+#define NOTE_TRACE_BOOT      4  /* Boot stages and deferred initialization
+                                 * (sched/init).  The argument is the name
+                                 * of the stage. */
+
+#define NOTE_TRACE_NCATEGORIES SCHED_TRACE_NCATEGORIES
+
+/* Number of buckets in a tracepoint latency histogram.  Bucket 0 holds the
+ * times below one microsecond and bucket n the times from 2^(n-1) up to
+ * 2^n - 1 microseconds.  The last bucket also holds all longer times.
+ */
+
+#define NOTE_TRACE_NBUCKETS  20
+
+/* ioctl commands of the /dev/note driver */
+
+#define NOTEIOC_TRACEMASK    _NOTEIOC(0x0001) /* Set the enabled tracepoint
+                                               * categories.
+                                               * Argument: The new mask */
+
+/* Tracepoints.  sched_trace_begin() and sched_trace_end() mark the begin
+ * and the end of a traced operation of the category 'c', and 'a' is an
+ * argument to identify the instance of the operation.  They generate no
+ * code unless CONFIG_SCHED_INSTRUMENTATION_TRACE is selected and do nothing
+ * at run time unless the category is enabled in g_note_tracemask.
+ *
+ * Tracepoints are only available to kernel code.
+ */
+
+#if defined(CONFIG_SCHED_INSTRUMENTATION_TRACE) && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define sched_trace_begin(c,a) \
+     do \
+       { \
+         if ((g_note_tracemask & (1 << (c))) != 0) \
+           { \
+             sched_trace_event((c), true, (FAR void *)(a)); \
+           } \
+       } \
+     while (0)
+#  define sched_trace_end(c,a) \
+     do \
+       { \
+         if ((g_note_tracemask & (1 << (c))) != 0) \
+           { \
+             sched_trace_event((c), false, (FAR void *)(a)); \
+           } \
+       } \
+     while (0)
+#else
+#  define sched_trace_begin(c,a)
+#  define sched_trace_end(c,a)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -106,6 +170,11 @@ enum note_type_e
   NOTE_SPINLOCK_UNLOCK = 16,
   NOTE_SPINLOCK_ABORT  = 17
 #endif
+#ifdef CONFIG_SCHED_INSTRUMENTATION_TRACE
+  ,
+  NOTE_TRACE_BEGIN     = 18,
+  NOTE_TRACE_END       = 19
+#endif
 };
 
 /* This structure provides the common header of each note */
@@ -232,10 +301,50 @@ struct note_spinlock_s
   struct note_common_s nsp_cmn; /* Common note parameters */
   FAR void *nsp_spinlock;       /* Address of spinlock */
   uint8_t nsp_value;            /* Value of spinlock */
+
+  /* NOTE_SPINLOCK_LOCKED:  The number of failed attempts to take the
+   * spinlock (saturated at 0xffff).  Zero if there was no contention.
+   */
+
+  uint8_t nsp_spins[2];
 };
 #endif /* CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS */
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_TRACE
+/* This is the specific form of the NOTE_TRACE_BEGIN/END note */
+
+struct note_trace_s
+{
+  struct note_common_s ntr_cmn; /* Common note parameters */
+  uint8_t ntr_category;         /* Tracepoint category */
+  FAR void *ntr_arg;            /* Tracepoint argument */
+};
+#endif /* CONFIG_SCHED_INSTRUMENTATION_TRACE */
 #endif /* CONFIG_SCHED_INSTRUMENTATION_BUFFER */
 
+#ifdef CONFIG_SCHED_TRACE_LATENCY
+/* This is the latency histogram of one tracepoint category */
+
+struct note_tracelat_s
+{
+  uint32_t ntl_max;             /* Longest time (microseconds) */
+
+  /* The number of operations in each bucket */
+
+  uint32_t ntl_count[NOTE_TRACE_NBUCKETS];
+};
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_TRACE
+/* The set of enabled tracepoint categories */
+
+extern volatile uint32_t g_note_tracemask;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -295,16 +404,66 @@ void sched_note_csection(FAR struct tcb_s *tcb, bool enter);
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
 void sched_note_spinlock(FAR struct tcb_s *tcb, FAR volatile void *spinlock);
-void sched_note_spinlocked(FAR struct tcb_s *tcb, FAR volatile void *spinlock);
+void sched_note_spinlocked(FAR struct tcb_s *tcb, FAR volatile void *spinlock,
+                           unsigned int spins);
 void sched_note_spinunlock(FAR struct tcb_s *tcb, FAR volatile void *spinlock);
 void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock);
 #else
 #  define sched_note_spinlock(t,s)
-#  define sched_note_spinlocked(t,s)
+#  define sched_note_spinlocked(t,s,n)
 #  define sched_note_spinunlock(t,s)
 #  define sched_note_spinabort(t,s)
 #endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_TRACE
+void sched_note_trace(FAR struct tcb_s *tcb, uint8_t category, bool begin,
+                      FAR void *arg);
+#else
+#  define sched_note_trace(t,c,b,a)
+#endif
+
+/****************************************************************************
+ * Name: sched_trace_event
+ *
+ * Description:
+ *   Report the begin or the end of a traced operation.  This is called
+ *   through sched_trace_begin() and sched_trace_end(), not directly.
+ *
+ * Input Parameters:
+ *   category - The tracepoint category
+ *   begin    - True: The operation begins; false: It ends
+ *   arg      - The tracepoint argument
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_TRACE
+void sched_trace_event(int category, bool begin, FAR void *arg);
+#endif
+
+/****************************************************************************
+ * Name: sched_trace_latency
+ *
+ * Description:
+ *   Return the latency histogram of a tracepoint category.
+ *
+ * Input Parameters:
+ *   category - The tracepoint category
+ *   lat      - The location to return the histogram
+ *   reset    - True: Clear the histogram after it was returned
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TRACE_LATENCY
+void sched_trace_latency(int category, FAR struct note_tracelat_s *lat,
+                         bool reset);
+#endif
+
 /****************************************************************************
  * Name: sched_note_get
  *
@@ -384,9 +543,12 @@ int note_register(void);
 #  define sched_note_premption(t,l)
 #  define sched_note_csection(t,e)
 #  define sched_note_spinlock(t,s)
-#  define sched_note_spinlocked(t,s)
+#  define sched_note_spinlocked(t,s,n)
 #  define sched_note_spinunlock(t,s)
 #  define sched_note_spinabort(t,s)
+#  define sched_note_trace(t,c,b,a)
+#  define sched_trace_begin(c,a)
+#  define sched_trace_end(c,a)
 
 #endif /* CONFIG_SCHED_INSTRUMENTATION */
 #endif /* __INCLUDE_NUTTX_SCHED_NOTE_H */
@@ -129,7 +129,7 @@
 #  define MMCSD_CMDIDX19  19  /* HS_BUSTEST_WRITE: */
 #  define MMC_CMDIDX20    20  /* WRITE_DAT_UNTIL_STOP: (MMC)
                                * -Addressed data transfer command, R1 response 31:0=DADR R1 */
-#  define MMC_CMDIDX23    23  /* SET_BLOCK_COUNT: (MMC)
+#  define MMC_CMDIDX23    23  /* SET_BLOCK_COUNT: (MMC, SD per SCR)
                                * -Addressed command, R1 response 31:0=DADR */
 #  define MMCSD_CMDIDX24  24  /* WRITE_BLOCK: Writes a block of the selected size
                                * -Addressed data transfer command, R1 response 31:0=DADR */
@@ -276,6 +276,7 @@
 #define MMCSD_CMD19     (MMCSD_CMDIDX19|MMCSD_R1_RESPONSE |MMCSD_NODATAXFR)
 #define MMC_CMD20       (MMC_CMDIDX20  |MMCSD_R1B_RESPONSE|MMCSD_WRSTREAM )
 #define MMC_CMD23       (MMC_CMDIDX23  |MMCSD_R1_RESPONSE |MMCSD_NODATAXFR)
+#define SD_CMD23        (MMC_CMDIDX23  |MMCSD_R1_RESPONSE |MMCSD_NODATAXFR)
 #define MMCSD_CMD24     (MMCSD_CMDIDX24|MMCSD_R1_RESPONSE |MMCSD_WRDATAXFR)
 #define MMCSD_CMD25     (MMCSD_CMDIDX25|MMCSD_R1_RESPONSE |MMCSD_WRDATAXFR |MMCSD_MULTIBLOCK)
 #define MMCSD_CMD26     (MMCSD_CMDIDX26|MMCSD_R1_RESPONSE |MMCSD_WRDATAXFR)
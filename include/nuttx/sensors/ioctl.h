@@ -227,4 +227,10 @@
 #define SNIOC_SET_RESOLUTION       _SNIOC(0x0065) /* Arg: uint8_t value */
 #define SNIOC_SET_RANGE            _SNIOC(0x0066) /* Arg: uint8_t value */
 
+/* IOCTL commands of the common sensor upper half (see sensor.h) */
+
+#define SNIOC_ACTIVATE             _SNIOC(0x0067) /* Arg: bool value */
+#define SNIOC_SET_PERIOD           _SNIOC(0x0068) /* Arg: unsigned int* pointer (us) */
+#define SNIOC_BATCH                _SNIOC(0x0069) /* Arg: unsigned int* pointer (us) */
+
 #endif /* __INCLUDE_NUTTX_SENSORS_IOCTL_H */
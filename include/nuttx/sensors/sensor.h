@@ -0,0 +1,293 @@
+/****************************************************************************
+ * include/nuttx/sensors/sensor.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_SENSORS_SENSOR_H
+#define __INCLUDE_NUTTX_SENSORS_SENSOR_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/sensors/ioctl.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The types of sensors handled by the common upper half.  The type selects
+ * the event structure that the device returns and the name of the device:
+ * /dev/sensor/<name><devno>, e.g. /dev/sensor/accel0.
+ */
+
+#define SENSOR_TYPE_ACCELEROMETER       0  /* accel, struct sensor_event_accel */
+#define SENSOR_TYPE_MAGNETIC_FIELD      1  /* mag, struct sensor_event_mag */
+#define SENSOR_TYPE_GYROSCOPE           2  /* gyro, struct sensor_event_gyro */
+#define SENSOR_TYPE_LIGHT               3  /* light, struct sensor_event_light */
+#define SENSOR_TYPE_BAROMETER           4  /* baro, struct sensor_event_baro */
+#define SENSOR_TYPE_PROXIMITY           5  /* prox, struct sensor_event_prox */
+#define SENSOR_TYPE_RELATIVE_HUMIDITY   6  /* humi, struct sensor_event_humi */
+#define SENSOR_TYPE_AMBIENT_TEMPERATURE 7  /* temp, struct sensor_event_temp */
+#define SENSOR_TYPE_COUNT               8
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The events returned by read().  Each one starts with the time of the
+ * sample in microseconds, on the clock_systime_timespec() time base.
+ */
+
+struct sensor_event_accel   /* Accelerometer */
+{
+  uint64_t timestamp;       /* Units is microseconds */
+  float x;                  /* Axis X in m/s^2 */
+  float y;                  /* Axis Y in m/s^2 */
+  float z;                  /* Axis Z in m/s^2 */
+  float temperature;        /* Temperature in degrees Celsius */
+};
+
+struct sensor_event_mag     /* Magnetic field */
+{
+  uint64_t timestamp;       /* Units is microseconds */
+  float x;                  /* Axis X in microtesla */
+  float y;                  /* Axis Y in microtesla */
+  float z;                  /* Axis Z in microtesla */
+  float temperature;        /* Temperature in degrees Celsius */
+};
+
+struct sensor_event_gyro    /* Gyroscope */
+{
+  uint64_t timestamp;       /* Units is microseconds */
+  float x;                  /* Axis X in rad/s */
+  float y;                  /* Axis Y in rad/s */
+  float z;                  /* Axis Z in rad/s */
+  float temperature;        /* Temperature in degrees Celsius */
+};
+
+struct sensor_event_light   /* Ambient light */
+{
+  uint64_t timestamp;       /* Units is microseconds */
+  float light;              /* Visible light in lux */
+  float ir;                 /* Infrared light in lux */
+};
+
+struct sensor_event_baro    /* Barometer */
+{
+  uint64_t timestamp;       /* Units is microseconds */
+  float pressure;           /* Pressure in hectopascal */
+  float temperature;        /* Temperature in degrees Celsius */
+};
+
+struct sensor_event_prox    /* Proximity */
+{
+  uint64_t timestamp;       /* Units is microseconds */
+  float proximity;          /* Distance in centimeters */
+};
+
+struct sensor_event_humi    /* Relative humidity */
+{
+  uint64_t timestamp;       /* Units is microseconds */
+  float humidity;           /* Relative humidity in percent */
+};
+
+struct sensor_event_temp    /* Ambient temperature */
+{
+  uint64_t timestamp;       /* Units is microseconds */
+  float temperature;        /* Temperature in degrees Celsius */
+};
+
+/* Called by the lower half to add events to the buffer of the upper half.
+ * The data is an array of complete events of the type of the sensor, e.g.
+ * all of the samples read from the hardware FIFO in one bus transfer.
+ * This may be called from an interrupt handler or from a work queue.
+ */
+
+typedef CODE void (*sensor_push_event_t)(FAR void *priv,
+                                         FAR const void *data,
+                                         size_t bytes);
+
+/* The lower half interface.  All of the methods are optional. */
+
+struct sensor_lowerhalf_s;
+struct sensor_ops_s
+{
+  /**************************************************************************
+   * Name: activate
+   *
+   * Description:
+   *   Start or stop producing samples.  The last close of the device stops
+   *   the sensor.
+   *
+   **************************************************************************/
+
+  CODE int (*activate)(FAR struct sensor_lowerhalf_s *lower, bool enable);
+
+  /**************************************************************************
+   * Name: set_interval
+   *
+   * Description:
+   *   Set the sampling period, i.e. the output data rate, in microseconds.
+   *   The lower half selects the closest period that the hardware supports
+   *   and returns it in *period_us.
+   *
+   **************************************************************************/
+
+  CODE int (*set_interval)(FAR struct sensor_lowerhalf_s *lower,
+                           FAR unsigned int *period_us);
+
+  /**************************************************************************
+   * Name: batch
+   *
+   * Description:
+   *   Set the longest time in microseconds that a sample may wait in the
+   *   hardware FIFO before it is pushed:  The lower half sets the FIFO
+   *   watermark to about latency / period samples, reads the whole FIFO in
+   *   one bus transfer when the watermark interrupt fires and pushes all of
+   *   the samples at once.  Zero means one interrupt per sample.  The
+   *   lower half returns the latency that it could set in *latency_us.
+   *
+   **************************************************************************/
+
+  CODE int (*batch)(FAR struct sensor_lowerhalf_s *lower,
+                    FAR unsigned int *latency_us);
+
+  /**************************************************************************
+   * Name: fetch
+   *
+   * Description:
+   *   For sensors without a data-ready interrupt:  Read the samples now,
+   *   into the buffer of read().  A lower half that provides fetch() does
+   *   not push events and the upper half allocates no buffer for it.
+   *
+   **************************************************************************/
+
+  CODE int (*fetch)(FAR struct sensor_lowerhalf_s *lower,
+                    FAR char *buffer, size_t buflen);
+
+  /**************************************************************************
+   * Name: control
+   *
+   * Description:
+   *   Handle the IOCTL commands that are specific to the device.
+   *
+   **************************************************************************/
+
+  CODE int (*control)(FAR struct sensor_lowerhalf_s *lower,
+                      int cmd, unsigned long arg);
+};
+
+/* The lower half state that is visible to the upper half.  The lower half
+ * sets type, buffer_number and ops before calling sensor_register().  The
+ * upper half sets push_event and priv.
+ */
+
+struct sensor_lowerhalf_s
+{
+  int type;                           /* See SENSOR_TYPE_* */
+  unsigned long buffer_number;        /* Number of events buffered */
+  FAR const struct sensor_ops_s *ops; /* The lower half methods */
+
+  sensor_push_event_t push_event;     /* Adds events to the buffer */
+  FAR void *priv;                     /* Argument of push_event() */
+};
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sensor_get_timestamp
+ *
+ * Description:
+ *   Return the time in microseconds for the timestamp of an event.  The
+ *   lower half takes it when the watermark interrupt fires and computes
+ *   the times of the older samples in the FIFO from the sampling period.
+ *
+ ****************************************************************************/
+
+static inline uint64_t sensor_get_timestamp(void)
+{
+  struct timespec ts;
+
+  clock_systime_timespec(&ts);
+  return 1000000ull * ts.tv_sec + ts.tv_nsec / 1000;
+}
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: sensor_register
+ *
+ * Description:
+ *   Register the character device of a sensor lower half as
+ *   /dev/sensor/<name><devno>.  The device returns timestamped events of
+ *   the type of the sensor; one read() returns as many buffered events as
+ *   fit into the user buffer.
+ *
+ * Input Parameters:
+ *   lower - The lower half of the sensor
+ *   devno - The number of the device, e.g. 0 for /dev/sensor/accel0
+ *
+ * Returned Value:
+ *   OK if the driver was successfully registered; A negated errno value is
+ *   returned on any failure.
+ *
+ ****************************************************************************/
+
+int sensor_register(FAR struct sensor_lowerhalf_s *lower, int devno);
+
+/****************************************************************************
+ * Name: sensor_unregister
+ *
+ * Description:
+ *   Unregister the character device of a sensor and free its upper half.
+ *
+ * Input Parameters:
+ *   lower - The lower half of the sensor
+ *   devno - The number of the device
+ *
+ ****************************************************************************/
+
+void sensor_unregister(FAR struct sensor_lowerhalf_s *lower, int devno);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_SENSORS_SENSOR_H */
@@ -155,6 +155,20 @@ struct uart_dmaxfer_s
 };
 #endif /* CONFIG_SERIAL_RXDMA || CONFIG_SERIAL_TXDMA */
 
+#ifdef CONFIG_SERIAL_RXDMA_CIRCULAR
+/* This structure describes the buffer of a DMA channel that receives in
+ * circular mode.  The lower half driver provides the buffer and its size;
+ * pos is only used by uart_recvchars_circular().
+ */
+
+struct uart_dmacirc_s
+{
+  FAR char        *buffer;  /* The DMA buffer */
+  size_t           size;    /* Size of the DMA buffer */
+  size_t           pos;     /* Offset of the first byte not yet moved */
+};
+#endif
+
 /* This structure defines all of the operations providd by the architecture specific
  * logic.  All fields must be provided with non-NULL function pointers by the
  * caller of uart_register().
@@ -325,6 +339,9 @@ struct uart_dev_s
 #ifdef CONFIG_SERIAL_RXDMA
   struct uart_dmaxfer_s dmarx;       /* Describes receive DMA transfer */
 #endif
+#ifdef CONFIG_SERIAL_RXDMA_CIRCULAR
+  struct uart_dmacirc_s dmacirc;     /* Describes circular receive DMA buffer */
+#endif
 
   /* Driver interface */
 
@@ -495,6 +512,27 @@ void uart_recvchars_dma(FAR uart_dev_t *dev);
 void uart_recvchars_done(FAR uart_dev_t *dev);
 #endif
 
+/************************************************************************************
+ * Name: uart_recvchars_circular
+ *
+ * Description:
+ *   Move the data received by a circular DMA channel into the RX circular buffer
+ *   and wake up any threads that may have been waiting for the data.  The lower
+ *   half driver calls this from its half-transfer, full-transfer and IDLE-line
+ *   interrupt handlers and from its dmarxfree() method, with 'pos' set to the
+ *   offset in dev->dmacirc.buffer where the DMA will write the next byte.
+ *
+ *   The half-transfer interrupt assures that this is called at least once for
+ *   each half of the DMA buffer; otherwise a full buffer could not be told from
+ *   an empty one.  Data that does not fit into the RX buffer is left in the DMA
+ *   buffer and moved by the dmarxfree() call after uart_read() made room.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_RXDMA_CIRCULAR
+void uart_recvchars_circular(FAR uart_dev_t *dev, size_t pos);
+#endif
+
 /************************************************************************************
  * Name: uart_reset_sem
  *
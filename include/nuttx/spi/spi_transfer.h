@@ -49,6 +49,11 @@
 #include <nuttx/fs/ioctl.h>
 #include <nuttx/spi/spi.h>
 
+#ifdef CONFIG_SPI_QUEUE
+#  include <queue.h>
+#  include <nuttx/wqueue.h>
+#endif
+
 #ifdef CONFIG_SPI_EXCHANGE
 
 /* SPI Character Driver IOCTL Commands **************************************/
@@ -125,6 +130,41 @@ struct spi_sequence_s
   FAR struct spi_trans_s *trans;
 };
 
+#ifdef CONFIG_SPI_QUEUE
+/* This describes one SPI message handled by spi_queue_submit():  A sequence
+ * of transfers and the function to call when it completes.  Each message
+ * carries its own device, mode, number of bits and frequency in its
+ * sequence, so messages for different devices on the same bus may be
+ * queued together.
+ *
+ * The message and the buffers that it refers to belong to the SPI queue
+ * from the call to spi_queue_submit() up to the call of the callback.
+ */
+
+struct spi_message_s;
+typedef CODE void (*spi_complete_t)(FAR struct spi_message_s *msg,
+                                    int result, FAR void *arg);
+
+struct spi_message_s
+{
+  FAR struct spi_message_s *flink; /* Supports a singly linked list */
+  FAR struct spi_sequence_s *seq;  /* The sequence of transfers */
+  spi_complete_t callback;         /* Called when the message completes */
+  FAR void *arg;                   /* Argument of the callback */
+};
+
+/* The queue of messages of one SPI bus.  The contents are private to the
+ * SPI queue logic.
+ */
+
+struct spi_queue_s
+{
+  FAR struct spi_dev_s *spi;       /* The SPI bus */
+  sq_queue_t pending;              /* The messages waiting for the bus */
+  struct work_s work;              /* Performs the messages */
+};
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -174,6 +214,70 @@ int spi_transfer(FAR struct spi_dev_s *spi, FAR struct spi_sequence_s *seq);
 int spi_register(FAR struct spi_dev_s *spi, int bus);
 #endif
 
+/****************************************************************************
+ * Name: spi_queue_initialize
+ *
+ * Description:
+ *   Initialize the message queue of one SPI bus.  All of the drivers that
+ *   submit messages to that bus must share the same queue.
+ *
+ * Input Parameters:
+ *   queue - The queue to initialize
+ *   spi   - An instance of the SPI bus that the queue feeds
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPI_QUEUE
+void spi_queue_initialize(FAR struct spi_queue_s *queue,
+                          FAR struct spi_dev_s *spi);
+
+/****************************************************************************
+ * Name: spi_queue_submit
+ *
+ * Description:
+ *   Add a message to the queue of an SPI bus and return without waiting.
+ *   The messages are performed in order on the SPI work queue, followed by
+ *   the call of their callback with the result of the message.  This may
+ *   be called from an interrupt handler, e.g. to start reading a sensor
+ *   when it reports new data.
+ *
+ * Input Parameters:
+ *   queue - The queue of the SPI bus
+ *   msg   - The message to perform
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.  The callback
+ *   is not called if the message could not be queued.
+ *
+ ****************************************************************************/
+
+int spi_queue_submit(FAR struct spi_queue_s *queue,
+                     FAR struct spi_message_s *msg);
+
+/****************************************************************************
+ * Name: spi_queue_cancel
+ *
+ * Description:
+ *   Remove a message from the queue before it is started.
+ *
+ * Input Parameters:
+ *   queue - The queue of the SPI bus
+ *   msg   - The message to remove
+ *
+ * Returned Value:
+ *   Zero (OK) if the message was removed; its callback will not be called.
+ *   -ENOENT if the message is no longer queued: It is being performed or
+ *   it already completed.
+ *
+ ****************************************************************************/
+
+int spi_queue_cancel(FAR struct spi_queue_s *queue,
+                     FAR struct spi_message_s *msg);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 #define EXTERN extern "C"
@@ -96,6 +96,32 @@
 #  define SP_SECTION
 #endif
 
+#ifdef CONFIG_SPINLOCK_TICKET
+/* Initializer and state of a ticket spinlock */
+
+#  define SP_TICKET_INITIALIZER  {0, 0}
+#  define spin_initialize_ticket(l) \
+     do { (l)->next = 0; (l)->owner = 0; } while (0)
+#  define spin_islocked_ticket(l) ((l)->next != (l)->owner)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_TICKET
+/* A ticket spinlock:  Each CPU draws a ticket from 'next' and waits until
+ * 'owner' reaches its ticket.  The CPUs take the spinlock in the order that
+ * they asked for it, and they wait by reading 'owner' only.
+ */
+
+typedef struct
+{
+  volatile uint16_t next;       /* The next ticket to draw */
+  volatile uint16_t owner;      /* The ticket holding the spinlock */
+} spinlock_ticket_t;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -342,5 +368,50 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
                  FAR volatile spinlock_t *orlock);
 #endif
 
+/****************************************************************************
+ * Name: spin_lock_ticket
+ *
+ * Description:
+ *   Take a ticket spinlock.  Unlike spin_lock(), this is fair under
+ *   contention:  The spinlock is granted in the order of the calls.
+ *
+ *   This implementation is non-reentrant and is prone to deadlocks in
+ *   the case that any logic on the same CPU attempts to take the lock
+ *   more than once.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to lock.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the spinlock was successfully locked
+ *   by this CPU.
+ *
+ * Assumptions:
+ *   Not running at the interrupt level.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_TICKET
+void spin_lock_ticket(FAR spinlock_ticket_t *lock);
+#endif
+
+/****************************************************************************
+ * Name: spin_unlock_ticket
+ *
+ * Description:
+ *   Release a ticket spinlock and pass it to the next waiting CPU, if any.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to unlock.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_TICKET
+void spin_unlock_ticket(FAR spinlock_ticket_t *lock);
+#endif
+
 #endif /* CONFIG_SPINLOCK */
 #endif /* __INCLUDE_NUTTX_SPINLOCK_H */
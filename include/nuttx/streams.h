@@ -44,6 +44,10 @@
 #include <nuttx/config.h>
 #include <stdio.h>
 
+#ifdef CONFIG_LIBC_LZF
+#  include <lzf.h>
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -55,6 +59,8 @@ typedef CODE int  (*lib_getc_t)(FAR struct lib_instream_s *this);
 
 struct lib_outstream_s;
 typedef CODE void (*lib_putc_t)(FAR struct lib_outstream_s *this, int ch);
+typedef CODE void (*lib_puts_t)(FAR struct lib_outstream_s *this,
+                                FAR const void *buf, int len);
 typedef CODE int  (*lib_flush_t)(FAR struct lib_outstream_s *this);
 
 struct lib_instream_s
@@ -67,6 +73,8 @@ struct lib_instream_s
 struct lib_outstream_s
 {
   lib_putc_t             put;     /* Put one character to the outstream */
+  lib_puts_t             puts;    /* Put a buffer to the outstream.  May be
+                                   * NULL, then put is used per character */
   lib_flush_t            flush;   /* Flush any buffered characters in the outstream */
   int                    nput;    /* Total number of characters put.  Written
                                    * by put method, readable by user */
@@ -201,6 +209,43 @@ struct lib_syslogstream_s
 #endif
 };
 
+#ifdef CONFIG_LIBC_LZF
+/* These are streams that compress the data written to another output
+ * stream, and decompress the data read from another input stream, as a
+ * series of LZF blocks.  Each block is preceded by the 'ZV' header of
+ * include/lzf.h and holds up to CONFIG_LIBC_LZF_BLOCKSIZE bytes of
+ * uncompressed data.
+ */
+
+struct lib_lzfoutstream_s
+{
+  struct lib_outstream_s public;
+
+  /* The stream that receives the compressed blocks */
+
+  FAR struct lib_outstream_s *backend;
+  lzf_state_t            state;   /* Hash table, reused for every block */
+  size_t                 offset;  /* Number of bytes in in_buf */
+  uint8_t                in_buf[LZF_TYPE0_HDR_SIZE +
+                                CONFIG_LIBC_LZF_BLOCKSIZE];
+  uint8_t                out_buf[LZF_TYPE1_HDR_SIZE +
+                                 CONFIG_LIBC_LZF_BLOCKSIZE];
+};
+
+struct lib_lzfinstream_s
+{
+  struct lib_instream_s  public;
+
+  /* The stream that provides the compressed blocks */
+
+  FAR struct lib_instream_s *backend;
+  size_t                 offset;  /* Next byte to return from out_buf */
+  size_t                 outlen;  /* Number of bytes in out_buf */
+  uint8_t                in_buf[CONFIG_LIBC_LZF_BLOCKSIZE];
+  uint8_t                out_buf[CONFIG_LIBC_LZF_BLOCKSIZE];
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -356,6 +401,45 @@ void lib_zeroinstream(FAR struct lib_instream_s *zeroinstream);
 void lib_nullinstream(FAR struct lib_instream_s *nullinstream);
 void lib_nulloutstream(FAR struct lib_outstream_s *nulloutstream);
 
+/****************************************************************************
+ * Name: lib_lzfoutstream, lib_lzfinstream
+ *
+ * Description:
+ *   Initializes LZF compression streams:
+ *
+ *   o The stream created by lib_lzfoutstream collects the data written to
+ *     it into blocks of CONFIG_LIBC_LZF_BLOCKSIZE bytes.  Each full block
+ *     is compressed and written to the backend stream with its LZF header.
+ *     Flushing the stream writes the partial block and then flushes the
+ *     backend.  Defined in lib/stdio/lib_lzfoutstream.c
+ *   o The stream created by lib_lzfinstream reads LZF blocks from the
+ *     backend stream and returns the decompressed data.  It returns EOF at
+ *     the end of the backend stream, and at a corrupted block or a block
+ *     larger than CONFIG_LIBC_LZF_BLOCKSIZE.
+ *     Defined in lib/stdio/lib_lzfinstream.c
+ *
+ *   Only the two buffers of a block and, for compression, the hash table
+ *   are used, whatever the length of the data.
+ *
+ * Input Parameters:
+ *   outstream - User allocated, uninitialized instance of struct
+ *               lib_lzfoutstream_s to be initialized.
+ *   instream  - User allocated, uninitialized instance of struct
+ *               lib_lzfinstream_s to be initialized.
+ *   backend   - The stream that receives or provides the compressed data.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_LZF
+void lib_lzfoutstream(FAR struct lib_lzfoutstream_s *outstream,
+                      FAR struct lib_outstream_s *backend);
+void lib_lzfinstream(FAR struct lib_lzfinstream_s *instream,
+                     FAR struct lib_instream_s *backend);
+#endif
+
 /****************************************************************************
  * Name: syslogstream_create
  *
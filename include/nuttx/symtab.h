@@ -42,6 +42,8 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -70,6 +72,21 @@ struct symtab_s
   FAR const void *sym_value;         /* The value associated with the string */
 };
 
+/* struct symtab_hash_s is a hash table over the names of a symbol table.
+ * index[] holds the index + 1 of the symbols (zero marks an empty entry).
+ * If index is NULL, lookups search the symbol table.
+ */
+
+#ifdef CONFIG_SYMTAB_HASH
+struct symtab_hash_s
+{
+  FAR const struct symtab_s *symtab; /* The hashed symbol table */
+  FAR uint16_t *index;               /* The hash table */
+  uint16_t mask;                     /* Number of entries in index[] - 1 */
+  int nsyms;                         /* Number of symbols in symtab[] */
+};
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -150,6 +167,53 @@ symtab_findbyvalue(FAR const struct symtab_s *symtab,
 
 void symtab_sortbyname(FAR struct symtab_s *symtab, int nsyms);
 
+#ifdef CONFIG_SYMTAB_HASH
+/****************************************************************************
+ * Name: symtab_hashinit
+ *
+ * Description:
+ *   Build the hash table over the names of a symbol table.  If the hash
+ *   table can not be allocated, the symbol table is still recorded and
+ *   symtab_findbyhash() searches it instead.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if the hash table could not be
+ *   allocated.
+ *
+ ****************************************************************************/
+
+int symtab_hashinit(FAR struct symtab_hash_s *hash,
+                    FAR const struct symtab_s *symtab, int nsyms);
+
+/****************************************************************************
+ * Name: symtab_hashfree
+ *
+ * Description:
+ *   Release the hash table built by symtab_hashinit().
+ *
+ ****************************************************************************/
+
+void symtab_hashfree(FAR struct symtab_hash_s *hash);
+
+/****************************************************************************
+ * Name: symtab_findbyhash
+ *
+ * Description:
+ *   Find the symbol with the matching name in a hashed symbol table.  Of
+ *   several symbols with the same name, the first one in the table is
+ *   found, as with symtab_findbyname().
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+symtab_findbyhash(FAR const struct symtab_hash_s *hash,
+                  FAR const char *name);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -288,6 +288,13 @@
 #endif
 #endif /* CONFIG_FB_OVERLAY */
 
+#ifdef CONFIG_FB_PANNING
+#  define FBIOPAN_DISPLAY     _FBIOC(0x0012)  /* Show another part of the
+                                               * virtual plane
+                                               * Argument: read-only struct
+                                               *           fb_planeinfo_s */
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -322,6 +329,13 @@ struct fb_planeinfo_s
   fb_coord_t stride;      /* Length of a line in bytes */
   uint8_t    display;     /* Display number */
   uint8_t    bpp;         /* Bits per pixel */
+#ifdef CONFIG_FB_PANNING
+  fb_coord_t xres_virtual; /* Width of the plane memory in pixel columns */
+  fb_coord_t yres_virtual; /* Height of the plane memory in pixel rows,
+                            * e.g. twice yres for double buffering */
+  fb_coord_t xoffset;      /* First visible pixel column */
+  fb_coord_t yoffset;      /* First visible pixel row */
+#endif
 };
 
 #ifdef CONFIG_FB_OVERLAY
@@ -332,7 +346,9 @@ struct fb_transp_s
   uint8_t    transp;      /* Transparency */
   uint8_t    transp_mode; /* Transparency mode */
 };
+#endif /* CONFIG_FB_OVERLAY */
 
+#if defined(CONFIG_FB_OVERLAY) || defined(CONFIG_FB_ACCEL)
 /* This structure describes an area. */
 
 struct fb_area_s
@@ -342,7 +358,9 @@ struct fb_area_s
   fb_coord_t w;           /* Width of the area */
   fb_coord_t h;           /* Height of the area */
 };
+#endif
 
+#ifdef CONFIG_FB_OVERLAY
 /* This structure describes one overlay. */
 
 struct fb_overlayinfo_s
@@ -388,6 +406,23 @@ struct fb_overlayblend_s
 #endif
 #endif /* CONFIG_FB_OVERLAY */
 
+#ifdef CONFIG_FB_ACCEL
+/* This structure describes a copy of an image in memory to an area of a
+ * color plane by a 2D accelerator.  The source pixels are converted from
+ * their format to the format of the plane.  With an alpha value below 255,
+ * they are blended with the pixels of the plane.
+ */
+
+struct fb_copyarea_s
+{
+  FAR const void *src;    /* First source pixel to copy */
+  fb_coord_t stride;      /* Length of a source line in bytes */
+  uint8_t    fmt;         /* Format of the source pixels, see FB_FMT_* */
+  uint8_t    alpha;       /* 255: copy, else weight of the source pixels */
+  struct fb_area_s dest;  /* Destination area within the plane */
+};
+#endif
+
 /* On video controllers that support mapping of a pixel palette value
  * to an RGB encoding, the following structure may be used to define
  * that mapping.
@@ -517,6 +552,45 @@ struct fb_vtable_s
   int (*waitforvsync)(FAR struct fb_vtable_s *vtable);
 #endif
 
+#ifdef CONFIG_FB_PANNING
+  /* Show the part of the virtual plane that starts at pinfo->xoffset,
+   * pinfo->yoffset from the next frame on.  The offsets have been checked
+   * against the virtual resolution.  Drivers without a virtual resolution
+   * larger than the display leave this NULL.  Together with
+   * waitforvsync() this gives page flipping without tearing.
+   */
+
+  int (*pandisplay)(FAR struct fb_vtable_s *vtable, int planeno,
+                    FAR struct fb_planeinfo_s *pinfo);
+#endif
+
+#ifdef CONFIG_FB_ACCEL
+  /* The following are provided only if a 2D accelerator can draw to the
+   * color planes.  Any of them may be NULL.  An operation must be complete
+   * when it returns, since the CPU may draw over the same pixels next.  A
+   * negated errno value, e.g. -ENOTSUP for an area that the hardware can
+   * not handle, lets the caller draw with the CPU instead.
+   */
+
+  /* Fill an area of a plane with a color in the format of the plane */
+
+  int (*fillarea)(FAR struct fb_vtable_s *vtable, int planeno,
+                  FAR const struct fb_area_s *area, uint32_t color);
+
+  /* Move an area of a plane to the position (x, y).  The source and
+   * destination areas may overlap.
+   */
+
+  int (*movearea)(FAR struct fb_vtable_s *vtable, int planeno,
+                  FAR const struct fb_area_s *area, fb_coord_t x,
+                  fb_coord_t y);
+
+  /* Copy (and convert or blend) an image in memory to an area of a plane */
+
+  int (*copyarea)(FAR struct fb_vtable_s *vtable, int planeno,
+                  FAR const struct fb_copyarea_s *copy);
+#endif
+
 #ifdef CONFIG_FB_OVERLAY
   /* Get information about the video controller configuration and the
    * configuration of each overlay.
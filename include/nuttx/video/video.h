@@ -42,6 +42,7 @@
 
 #include <stdint.h>
 #include <sys/ioctl.h>
+#include <sys/time.h>
 #include "video_controls.h"
 
 #ifdef __cplusplus
@@ -322,8 +323,10 @@ typedef struct v4l2_plane v4l2_plane_t;
 
 /* struct v4l2_buffer
  * Parameter of ioctl(VIDIOC_QBUF) and ioctl(VIDIOC_DQBUF).
- * Currently, support only index, type, bytesused, memory,
- * m.userptr, and length.
+ * Currently, support only index, type, bytesused, flags, timestamp,
+ * sequence, memory, m.userptr, and length.  The timestamp is the system
+ * time since boot when the capture of the frame completed.  A gap in the
+ * sequence numbers means that frames were dropped.
  */
 
 struct v4l2_buffer
@@ -333,6 +336,7 @@ struct v4l2_buffer
   uint32_t             bytesused; /* Driver sets the image size */
   uint16_t             flags;     /* buffer flags. */
   uint16_t             field;     /* the field order of the image */
+  struct timeval       timestamp; /* frame timestamp */
   struct v4l2_timecode timecode;  /* frame timecode */
   uint16_t             sequence;  /* frame sequence number */
   uint16_t             memory;    /* enum #v4l2_memory */
@@ -30,6 +30,10 @@
 #include <stdint.h>
 #include <queue.h>
 
+#ifdef CONFIG_WDOG_WHEEL
+#  include <nuttx/list.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -61,25 +65,39 @@
 #define WDOGF_ACTIVE       (1 << 0) /* Bit 0: 1=Watchdog is actively timing */
 #define WDOGF_ALLOCED      (1 << 1) /* Bit 1: 0=Pre-allocated, 1=Allocated */
 #define WDOGF_STATIC       (1 << 2) /* Bit 2: 0=[Pre-]allocated, 1=Static */
+#define WDOGF_HARDIRQ      (1 << 3) /* Bit 3: 1=Run in the timer interrupt */
+#define WDOGF_PENDING      (1 << 4) /* Bit 4: 1=Expired, not yet run */
 
 #define WDOG_SETACTIVE(w)  do { (w)->flags |= WDOGF_ACTIVE; } while (0)
 #define WDOG_SETALLOCED(w) do { (w)->flags |= WDOGF_ALLOCED; } while (0)
 #define WDOG_SETSTATIC(w)  do { (w)->flags |= WDOGF_STATIC; } while (0)
+#define WDOG_SETHARDIRQ(w) do { (w)->flags |= WDOGF_HARDIRQ; } while (0)
+#define WDOG_SETPENDING(w) do { (w)->flags |= WDOGF_PENDING; } while (0)
 
 #define WDOG_CLRACTIVE(w)  do { (w)->flags &= ~WDOGF_ACTIVE; } while (0)
 #define WDOG_CLRALLOCED(w) do { (w)->flags &= ~WDOGF_ALLOCED; } while (0)
 #define WDOG_CLRSTATIC(w)  do { (w)->flags &= ~WDOGF_STATIC; } while (0)
+#define WDOG_CLRHARDIRQ(w) do { (w)->flags &= ~WDOGF_HARDIRQ; } while (0)
+#define WDOG_CLRPENDING(w) do { (w)->flags &= ~WDOGF_PENDING; } while (0)
 
 #define WDOG_ISACTIVE(w)   (((w)->flags & WDOGF_ACTIVE) != 0)
 #define WDOG_ISALLOCED(w)  (((w)->flags & WDOGF_ALLOCED) != 0)
 #define WDOG_ISSTATIC(w)   (((w)->flags & WDOGF_STATIC) != 0)
+#define WDOG_ISHARDIRQ(w)  (((w)->flags & WDOGF_HARDIRQ) != 0)
+#define WDOG_ISPENDING(w)  (((w)->flags & WDOGF_PENDING) != 0)
 
 /* Initialization of statically allocated timers ****************************/
 
 #define wd_static(w) \
   do { (w)->next = NULL; (w)->flags = WDOGF_STATIC; } while (0)
 
-#ifdef CONFIG_PIC
+#if defined(CONFIG_WDOG_WHEEL) && defined(CONFIG_PIC)
+#  define WDOG_INITIAILIZER \
+    { NULL, LIST_INITIAL_CLEARED_VALUE, NULL, NULL, 0, WDOGF_STATIC, 0 }
+#elif defined(CONFIG_WDOG_WHEEL)
+#  define WDOG_INITIAILIZER \
+    { NULL, LIST_INITIAL_CLEARED_VALUE, NULL, 0, WDOGF_STATIC, 0 }
+#elif defined(CONFIG_PIC)
 #  define WDOG_INITIAILIZER { NULL, NULL, NULL, 0, WDOGF_STATIC, 0 }
 #else
 #  define WDOG_INITIAILIZER { NULL, NULL, 0, WDOGF_STATIC, 0 }
@@ -123,6 +141,9 @@ typedef CODE void (*wdentry_t)(int argc, wdparm_t arg1, ...);
 struct wdog_s
 {
   FAR struct wdog_s *next;       /* Support for singly linked lists. */
+#ifdef CONFIG_WDOG_WHEEL
+  struct list_node   node;       /* Entry in a timing wheel slot */
+#endif
   wdentry_t          func;       /* Function to execute when delay expires */
 #ifdef CONFIG_PIC
   FAR void          *picbase;    /* PIC base address */
@@ -226,7 +247,9 @@ int wd_delete(WDOG_ID wdog);
  *
  * Assumptions:
  *   The watchdog routine runs in the context of the timer interrupt handler
- *   and is subject to all ISR restrictions.
+ *   and is subject to all ISR restrictions.  With CONFIG_WDOG_THREAD, it
+ *   runs in the watchdog thread with interrupts enabled instead, unless the
+ *   watchdog was marked with WDOG_SETHARDIRQ().
  *
  ****************************************************************************/
 
@@ -269,6 +292,24 @@ int wd_cancel(WDOG_ID wdog);
 
 int wd_gettime(WDOG_ID wdog);
 
+/****************************************************************************
+ * Name: wd_getnext
+ *
+ * Description:
+ *   This function returns the time remaining before the first active
+ *   watchdog timer expires.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The time in system ticks remaining until the first watchdog expires,
+ *   zero if it has already expired, or INT_MAX if no watchdog is active.
+ *
+ ****************************************************************************/
+
+int wd_getnext(void);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
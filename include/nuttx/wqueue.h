@@ -265,6 +265,9 @@ struct work_s
   FAR void *arg;         /* Callback argument */
   clock_t qtime;         /* Time work queued */
   clock_t delay;         /* Delay until work performed */
+#ifdef CONFIG_SCHED_LPWORKSTEAL
+  FAR struct dq_queue_s *wq; /* The list holding queued low-priority work */
+#endif
 };
 
 /* This is an enumeration of the various events that may be
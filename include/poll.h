@@ -110,6 +110,15 @@ typedef unsigned int nfds_t;
 
 typedef uint8_t pollevent_t;
 
+/* A poll callback.  If one is provided in the pollfd, it is called by the
+ * driver through poll_notify() instead of posting the semaphore.  This is
+ * called with the events already set in revents and may be called from an
+ * interrupt handler.
+ */
+
+struct pollfd;
+typedef CODE void (*pollcb_t)(FAR struct pollfd *fds);
+
 /* This is the Nuttx variant of the standard pollfd structure.  The poll()
  * interfaces receive a variable length array of such structures.
  *
@@ -132,6 +141,8 @@ struct pollfd
   FAR void    *ptr;     /* The psock or file being polled */
   FAR sem_t   *sem;     /* Pointer to semaphore used to post output event */
   FAR void    *priv;    /* For use by drivers */
+  pollcb_t     cb;      /* Optional callback used to report output events */
+  FAR void    *arg;     /* The argument of the callback */
 };
 
 /****************************************************************************
@@ -278,6 +278,12 @@ typedef int pthread_condattr_t;
 struct pthread_cond_s
 {
   sem_t sem;
+
+  /* The mutex of the waiting threads.  pthread_cond_broadcast() moves the
+   * waiters directly to the wait queue of this mutex when it is locked.
+   */
+
+  FAR struct pthread_mutex_s *mutex;
 };
 
 #ifndef __PTHREAD_COND_T_DEFINED
@@ -285,7 +291,7 @@ typedef struct pthread_cond_s pthread_cond_t;
 #define __PTHREAD_COND_T_DEFINED 1
 #endif
 
-#define PTHREAD_COND_INITIALIZER {SEM_INITIALIZER(0)}
+#define PTHREAD_COND_INITIALIZER {SEM_INITIALIZER(0), NULL}
 
 struct pthread_mutexattr_s
 {
@@ -383,7 +389,8 @@ typedef bool pthread_once_t;
 struct pthread_rwlock_s
 {
   pthread_mutex_t lock;
-  pthread_cond_t  cv;
+  pthread_cond_t  cv;            /* Blocked readers wait here */
+  pthread_cond_t  wcv;           /* Blocked writers wait here */
   unsigned int num_readers;
   unsigned int num_writers;
   bool write_in_progress;
@@ -394,6 +401,7 @@ typedef struct pthread_rwlock_s pthread_rwlock_t;
 typedef int pthread_rwlockattr_t;
 
 #define PTHREAD_RWLOCK_INITIALIZER  {PTHREAD_MUTEX_INITIALIZER, \
+                                     PTHREAD_COND_INITIALIZER, \
                                      PTHREAD_COND_INITIALIZER, \
                                      0, 0, false}
 
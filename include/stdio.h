@@ -92,6 +92,15 @@
 #define getchar()  fgetc(stdin)
 #define rewind(s)  ((void)fseek((s),0,SEEK_SET))
 
+/* Variants that do not lock the stream.  The caller must hold the lock of
+ * flockfile() or otherwise make sure that no other thread uses the stream.
+ */
+
+#define putc_unlocked(c,s)  fputc_unlocked((c),(s))
+#define putchar_unlocked(c) fputc_unlocked(c, stdout)
+#define getc_unlocked(s)    fgetc_unlocked(s)
+#define getchar_unlocked()  fgetc_unlocked(stdin)
+
 /* Path to the directory where temporary files can be created */
 
 #ifndef CONFIG_LIBC_TMPDIR
@@ -172,6 +181,18 @@ void   setbuf(FAR FILE *stream, FAR char *buf);
 int    setvbuf(FAR FILE *stream, FAR char *buffer, int mode, size_t size);
 int    ungetc(int c, FAR FILE *stream);
 
+/* Operations on streams without locking (POSIX and common extensions) */
+
+void   flockfile(FAR FILE *stream);
+int    ftrylockfile(FAR FILE *stream);
+void   funlockfile(FAR FILE *stream);
+int    fgetc_unlocked(FAR FILE *stream);
+int    fputc_unlocked(int c, FAR FILE *stream);
+size_t fread_unlocked(FAR void *ptr, size_t size, size_t n_items,
+         FAR FILE *stream);
+size_t fwrite_unlocked(FAR const void *ptr, size_t size, size_t n_items,
+         FAR FILE *stream);
+
 /* Operations on the stdout stream, buffers, paths,
  * and the whole printf-family
  */
@@ -66,6 +66,15 @@
 #  define environ get_environ_ptr()
 #endif
 
+/* Placement attributes of heap regions for malloc_attr() and
+ * malloc_setattr().  An allocation is only taken from a region that has
+ * all of the requested attributes.
+ */
+
+#define MALLOC_ATTR_FAST 0x01 /* Fast memory, e.g., tightly coupled memory */
+#define MALLOC_ATTR_DMA  0x02 /* Memory that is accessible by DMA */
+#define MALLOC_ATTR_SLOW 0x04 /* Slow memory, e.g., external SDRAM */
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -218,6 +227,13 @@ FAR void *calloc(size_t, size_t);
 
 struct mallinfo mallinfo(void);
 
+#ifdef CONFIG_MM_REGION_ATTR
+FAR void *malloc_attr(size_t size, int attr);
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+int       malloc_setattr(int attr);
+#endif
+#endif
+
 /* Pseudo-Terminals */
 
 #ifdef CONFIG_PSEUDOTERM_SUSV1
@@ -256,6 +272,12 @@ int      mkstemp(FAR char *path_template);
 
 void     qsort(FAR void *base, size_t nel, size_t width,
                CODE int (*compar)(FAR const void *, FAR const void *));
+#ifdef CONFIG_LIBC_QSORT_PARALLEL
+void     qsort_parallel(FAR void *base, size_t nel, size_t width,
+                        CODE int (*compar)(FAR const void *,
+                                           FAR const void *),
+                        int nthreads);
+#endif
 
 /* Binary search */
 
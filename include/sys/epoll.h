@@ -40,6 +40,7 @@
  * Included Files
  ****************************************************************************/
 
+#include <stdint.h>
 #include <poll.h>
 
 /****************************************************************************
@@ -50,6 +51,19 @@
 #define EPOLL_CTL_DEL 2 /* Remove a file descriptor from the interface.  */
 #define EPOLL_CTL_MOD 3 /* Change file descriptor epoll_event structure.  */
 
+/* Input flags that modify the way that events are reported:
+ *
+ *   EPOLLONESHOT
+ *     Report an event on the descriptor only once.  After that the
+ *     descriptor is disabled until it is re-armed with EPOLL_CTL_MOD.
+ *   EPOLLET
+ *     Edge-triggered:  Report the descriptor only when new events are
+ *     signaled by its driver instead of for as long as it stays ready.
+ */
+
+#define EPOLLONESHOT  (1u << 30)
+#define EPOLLET       (1u << 31)
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -78,23 +92,15 @@ enum EPOLL_EVENTS
 
 typedef union poll_data
 {
+  FAR void    *ptr;      /* User data */
   int          fd;       /* The descriptor being polled */
+  uint32_t     u32;      /* User data */
 } epoll_data_t;
 
 struct epoll_event
 {
-  epoll_data_t data;
-  FAR sem_t   *sem;      /* Pointer to semaphore used to post output event */
-  pollevent_t  events;   /* The input event flags */
-  pollevent_t  revents;  /* The output event flags */
-  FAR void    *priv;     /* For use by drivers */
-};
-
-struct epoll_head
-{
-  int size;
-  int occupied;
-  FAR struct epoll_event *evs;
+  uint32_t     events;   /* The event flags */
+  epoll_data_t data;     /* User data returned with the events */
 };
 
 /****************************************************************************
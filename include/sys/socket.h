@@ -43,6 +43,7 @@
 
 #include <sys/types.h>
 #include <sys/uio.h>
+#include <time.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -126,6 +127,7 @@
 #define MSG_ERRQUEUE   0x2000 /* Fetch message from error queue.  */
 #define MSG_NOSIGNAL   0x4000 /* Do not generate SIGPIPE.  */
 #define MSG_MORE       0x8000 /* Sender will send more.  */
+#define MSG_WAITFORONE 0x10000 /* Wait for the first message only.  */
 
 /* Protocol levels supported by get/setsockopt(): */
 
@@ -199,6 +201,40 @@
 #define SO_TYPE         15 /* Reports the socket type (get only).
                             * return: int
                             */
+#define SO_TIMESTAMP    16 /* Report the receive time of datagrams with an
+                            * SCM_TIMESTAMP control message (get/set).
+                            * arg: pointer to integer containing a boolean
+                            * value
+                            */
+#define SO_TIMESTAMPING 17 /* Select software and hardware timestamps,
+                            * reported with SCM_TIMESTAMPING (get/set).
+                            * arg: integer value of SOF_TIMESTAMPING_* flags
+                            */
+#define SO_ATTACH_FILTER 18 /* Attach a socket filter that selects the
+                             * packets that are received (set only).
+                             * arg: struct sock_fprog, see net/bpf.h
+                             */
+#define SO_DETACH_FILTER 19 /* Remove the socket filter (set only).
+                             * arg: ignored
+                             */
+
+/* Control message types used with recvmsg() */
+
+#define SCM_TIMESTAMP    SO_TIMESTAMP    /* struct timeval */
+#define SCM_TIMESTAMPING SO_TIMESTAMPING /* struct scm_timestamping */
+
+/* Flags of the SO_TIMESTAMPING option.  The TX and RX flags select the
+ * timestamps that are taken; SOFTWARE and RAW_HARDWARE select the ones that
+ * are reported.  Transmit timestamps are read with recvmsg(MSG_ERRQUEUE).
+ */
+
+#define SOF_TIMESTAMPING_TX_HARDWARE  (1 << 0)
+#define SOF_TIMESTAMPING_TX_SOFTWARE  (1 << 1)
+#define SOF_TIMESTAMPING_RX_HARDWARE  (1 << 2)
+#define SOF_TIMESTAMPING_RX_SOFTWARE  (1 << 3)
+#define SOF_TIMESTAMPING_SOFTWARE     (1 << 4)
+#define SOF_TIMESTAMPING_RAW_HARDWARE (1 << 6)
+#define SOF_TIMESTAMPING_MASK         0x5f
 
 /* Protocol-level socket operations. */
 
@@ -210,10 +246,11 @@
 #define SOL_L2CAP       6 /* See options in include/netpacket/bluetooth.h */
 #define SOL_SCO         7 /* See options in include/netpacket/bluetooth.h */
 #define SOL_RFCOMM      8 /* See options in include/netpacket/bluetooth.h */
+#define SOL_PACKET      9 /* See options in include/netpacket/packet.h */
 
 /* Protocol-level socket options may begin with this value */
 
-#define __SO_PROTOCOL  16
+#define __SO_PROTOCOL  20
 
 /* Values for the 'how' argument of shutdown() */
 
@@ -288,6 +325,16 @@ struct sockaddr
   char        sa_data[14];     /* 14-bytes data (actually variable length) */
 };
 
+/* The SCM_TIMESTAMPING control message:  ts[0] is the software timestamp
+ * and ts[2] the hardware timestamp.  ts[1] is not used.  A timestamp that
+ * is not available is zero.
+ */
+
+struct scm_timestamping
+{
+  struct timespec ts[3];
+};
+
 /* Used with the SO_LINGER socket option */
 
 struct linger
@@ -307,6 +354,14 @@ struct msghdr
   unsigned int msg_flags;
 };
 
+/* One message of recvmmsg() and sendmmsg() */
+
+struct mmsghdr
+{
+  struct msghdr msg_hdr;        /* The message */
+  unsigned int msg_len;         /* The number of bytes transferred */
+};
+
 struct cmsghdr
 {
   unsigned long cmsg_len;       /* Data byte count, including hdr */
@@ -383,6 +438,11 @@ int getpeername(int sockfd, FAR struct sockaddr *addr,
 ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags);
 
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout);
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
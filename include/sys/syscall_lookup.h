@@ -125,6 +125,9 @@ SYSCALL_LOOKUP(up_assert,                  2)
   SYSCALL_LOOKUP(insmod,                   2)
   SYSCALL_LOOKUP(rmmod,                    1)
   SYSCALL_LOOKUP(modhandle,                1)
+#ifdef CONFIG_MODULE_LAZY
+  SYSCALL_LOOKUP(insmod_lazy,              2)
+#endif
 #endif
 
 /* The following can only be defined if we are configured to execute
@@ -197,11 +200,18 @@ SYSCALL_LOOKUP(read,                       3)
 SYSCALL_LOOKUP(write,                      3)
 SYSCALL_LOOKUP(pread,                      4)
 SYSCALL_LOOKUP(pwrite,                     4)
+SYSCALL_LOOKUP(readv,                      3)
+SYSCALL_LOOKUP(writev,                     3)
 #ifdef CONFIG_FS_AIO
   SYSCALL_LOOKUP(aio_read,                 1)
   SYSCALL_LOOKUP(aio_write,                1)
   SYSCALL_LOOKUP(aio_fsync,                2)
   SYSCALL_LOOKUP(aio_cancel,               2)
+#ifdef CONFIG_FS_AIO_RING
+  SYSCALL_LOOKUP(aio_ringinit,             3)
+  SYSCALL_LOOKUP(aio_submit,               3)
+  SYSCALL_LOOKUP(aio_reap,                 4)
+#endif
 #endif
   SYSCALL_LOOKUP(poll,                     3)
   SYSCALL_LOOKUP(select,                   5)
@@ -360,8 +370,11 @@ SYSCALL_LOOKUP(telldir,                    1)
   SYSCALL_LOOKUP(listen,                   2)
   SYSCALL_LOOKUP(recv,                     4)
   SYSCALL_LOOKUP(recvfrom,                 6)
+  SYSCALL_LOOKUP(recvmsg,                  3)
+  SYSCALL_LOOKUP(recvmmsg,                 5)
   SYSCALL_LOOKUP(send,                     4)
   SYSCALL_LOOKUP(sendto,                   6)
+  SYSCALL_LOOKUP(sendmmsg,                 4)
   SYSCALL_LOOKUP(setsockopt,               5)
   SYSCALL_LOOKUP(socket,                   3)
 #endif
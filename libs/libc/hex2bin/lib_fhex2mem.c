@@ -30,6 +30,8 @@
 
 #include <nuttx/streams.h>
 
+#include "libc.h"
+
 #ifdef CONFIG_LIB_HEX2BIN
 
 /****************************************************************************
@@ -65,6 +67,7 @@ int fhex2mem(FAR FILE *instream, uint32_t baseaddr, uint32_t endpaddr,
 {
   struct lib_stdinstream_s stdinstream;
   struct lib_memsostream_s memoutstream;
+  int ret;
 
   /* Check memory addresses */
 
@@ -78,11 +81,17 @@ int fhex2mem(FAR FILE *instream, uint32_t baseaddr, uint32_t endpaddr,
   lib_memsostream(&memoutstream, (FAR char *)baseaddr,
                   (int)(endpaddr - baseaddr));
 
-  /* And do the deed */
+  /* And do the deed.  The stdin stream reads without locking, so hold the
+   * stream semaphore throughout.
+   */
+
+  lib_take_semaphore(instream);
+  ret = hex2bin(&stdinstream.public, &memoutstream.public,
+                (uint32_t)baseaddr, (uint32_t)endpaddr,
+                (enum hex2bin_swap_e)swap);
+  lib_give_semaphore(instream);
 
-  return hex2bin(&stdinstream.public, &memoutstream.public,
-                 (uint32_t)baseaddr, (uint32_t)endpaddr,
-                 (enum hex2bin_swap_e)swap);
+  return ret;
 }
 
 #endif /* CONFIG_LIB_HEX2BIN */
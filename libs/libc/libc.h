@@ -73,9 +73,16 @@
 #ifdef CONFIG_STDIO_DISABLE_BUFFERING
 #  define lib_sem_initialize(s)
 #  define lib_take_semaphore(s)
+#  define lib_trytake_semaphore(s) (0)
 #  define lib_give_semaphore(s)
 #endif
 
+/* The I/O buffer is allocated on first use only if so configured */
+
+#ifndef CONFIG_STDIO_BUFFER_LAZY
+#  define lib_allocbuffer(s)
+#endif
+
 /* The NuttX C library an be build in two modes: (1) as a standard, C-library
  * that can be used by normal, user-space applications, or (2) as a special,
  * kernel-mode C-library only used within the OS.  If NuttX is not being
@@ -161,12 +168,21 @@ int lib_mode2oflags(FAR const char *mode);
 
 /* Defined in lib_libfwrite.c */
 
+ssize_t lib_fwrite_unlocked(FAR const void *ptr, size_t count,
+                            FAR FILE *stream);
 ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream);
 
 /* Defined in lib_libfread.c */
 
+ssize_t lib_fread_unlocked(FAR void *ptr, size_t count, FAR FILE *stream);
 ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream);
 
+/* Defined in lib_libbuffer.c */
+
+#ifdef CONFIG_STDIO_BUFFER_LAZY
+void lib_allocbuffer(FAR FILE *stream);
+#endif
+
 /* Defined in lib_libfgets.c */
 
 FAR char *lib_fgets(FAR char *buf, size_t buflen, FILE *stream,
@@ -189,6 +205,7 @@ int lib_wrflush(FAR FILE *stream);
 #ifndef CONFIG_STDIO_DISABLE_BUFFERING
 void lib_sem_initialize(FAR struct file_struct *stream);
 void lib_take_semaphore(FAR struct file_struct *stream);
+int  lib_trytake_semaphore(FAR struct file_struct *stream);
 void lib_give_semaphore(FAR struct file_struct *stream);
 #endif
 
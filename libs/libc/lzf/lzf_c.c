@@ -159,7 +159,7 @@ size_t lzf_compress(FAR const void *const in_data,
     }
 
 #if INIT_HTAB
-  memset(htab, 0, sizeof(htab));
+  memset(htab, 0, sizeof(lzf_state_t));
 #endif
 
   lit = 0; /* start run */
@@ -0,0 +1,137 @@
+/****************************************************************************
+ * libs/libc/machine/risc-v/rv64/arch_chksum.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: chksum
+ *
+ * Description:
+ *   Calculate the raw change sum over the memory region described by
+ *   data and len.
+ *
+ *   The one's complement sum does not depend on the byte order, so the
+ *   data is summed as little-endian 32-bit words into a 64-bit accumulator
+ *   and byte-swapped at the end.  With at most 64 KiB of data the
+ *   accumulator cannot overflow.  If the data starts at an odd address, the
+ *   first byte is added as the upper byte and the rest is summed from the
+ *   next, aligned address; that sums every byte in the opposite lane, which
+ *   cancels the final byte swap.
+ *
+ * Input Parameters:
+ *   sum  - Partial calculations carried over from a previous call to
+ *          chksum().  This should be zero on the first time that check
+ *          sum is called.
+ *   data - Beginning of the data to include in the checksum.
+ *   len  - Length of the data to include in the checksum.
+ *
+ * Returned Value:
+ *   The updated checksum value.
+ *
+ ****************************************************************************/
+
+uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
+{
+  FAR const uint32_t *words;
+  uint64_t acc = 0;
+  bool odd = ((uintptr_t)data & 1) != 0;
+
+  if (len == 0)
+    {
+      return sum;
+    }
+
+  /* Odd start address:  Add the first byte as the upper byte */
+
+  if (odd)
+    {
+      acc = (uint64_t)*data++ << 8;
+      len--;
+    }
+
+  /* Halfword aligned:  Add one halfword to get word aligned */
+
+  if (((uintptr_t)data & 2) != 0 && len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+  /* Word aligned:  Add blocks of 16 bytes, then the remaining words */
+
+  words = (FAR const uint32_t *)data;
+  while (len >= 16)
+    {
+      acc   += (uint64_t)words[0] + words[1] + words[2] + words[3];
+      words += 4;
+      len   -= 16;
+    }
+
+  while (len >= 4)
+    {
+      acc += *words++;
+      len -= 4;
+    }
+
+  /* Add the remaining halfword and byte */
+
+  data = (FAR const uint8_t *)words;
+  if (len >= 2)
+    {
+      acc  += *(FAR const uint16_t *)data;
+      data += 2;
+      len  -= 2;
+    }
+
+  if (len > 0)
+    {
+      acc += *data;
+    }
+
+  /* Fold to 16 bits, swap to host order unless the start address was odd
+   * and add the carried over sum.
+   */
+
+  acc = (acc & 0xffffffff) + (acc >> 32);
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+  acc = (acc & 0xffff) + (acc >> 16);
+
+  if (!odd)
+    {
+      acc = ((acc & 0xff) << 8) | (acc >> 8);
+    }
+
+  acc += sum;
+  acc  = (acc & 0xffff) + (acc >> 16);
+  return (uint16_t)acc;
+}
@@ -0,0 +1,52 @@
+/****************************************************************************
+ * libs/libc/math/__cosf.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <math.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: __cosf
+ *
+ * Description:
+ *   Kernel cosine function on [-pi/4, pi/4].  The polynomial is the one of
+ *   the Cephes library; its error is below 1 ULP on the interval.
+ *
+ ****************************************************************************/
+
+float __cosf(float x)
+{
+  float z  = x * x;
+  float hz = 0.5f * z;
+  float w  = 1.0f - hz;
+
+  /* Add the rounding error of 1 - z/2 back in */
+
+  return w + (((1.0f - w) - hz) +
+              z * z * ((2.443315711809948e-5f * z -
+                        1.388731625493765e-3f) * z +
+                       4.166664568298827e-2f));
+}
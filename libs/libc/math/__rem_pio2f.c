@@ -0,0 +1,215 @@
+/****************************************************************************
+ * libs/libc/math/__rem_pio2f.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* pi/2 split into three parts for the Cody-Waite reduction.  The first two
+ * parts have at most 17 significant bits, so n * PIO2_1 and n * PIO2_2 are
+ * exact for |n| < 2^7.
+ */
+
+#define PIO2_1      1.57080078125f
+#define PIO2_2      -4.45445766672492027283e-06f
+#define PIO2_3      2.56334406825708960298e-12f
+
+#define INV_PIO2    6.36619772e-1f
+
+/* Arguments below this limit (|n| <= 128) are reduced with the Cody-Waite
+ * method, above with the Payne-Hanek method.
+ */
+
+#define CW_LIMIT    200.0f
+
+/* pi/2 * 2^31 */
+
+#define PIO2_Q31    0xc90fdaa2u
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Binary expansion of 2/pi: 0.a2f9836e 4e441529 ... */
+
+static const uint32_t g_two_over_pi[] =
+{
+  0xa2f9836e, 0x4e441529, 0xfc2757d1, 0xf534ddc0, 0xdb629599,
+  0x3c439041, 0xfe5163ab, 0xdebbc561, 0xb7246e3a
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: two_over_pi_bits
+ *
+ * Description:
+ *   Return the 32 bits of 2/pi that start at bit 'pos' after the binary
+ *   point (bit 0 has the weight 1/2).  The bits before the binary point
+ *   are zero.
+ *
+ ****************************************************************************/
+
+static uint32_t two_over_pi_bits(int pos)
+{
+  int idx;
+  int off;
+
+  if (pos < 0)
+    {
+      return pos > -32 ? g_two_over_pi[0] >> -pos : 0;
+    }
+
+  idx = pos >> 5;
+  off = pos & 31;
+
+  if (off == 0)
+    {
+      return g_two_over_pi[idx];
+    }
+
+  return (g_two_over_pi[idx] << off) |
+         (g_two_over_pi[idx + 1] >> (32 - off));
+}
+
+/****************************************************************************
+ * Name: rem_pio2f_large
+ *
+ * Description:
+ *   Payne-Hanek reduction of a large, finite argument.  x = m * 2^e with an
+ *   integer m of 24 bits is multiplied by a window of 96 bits of 2/pi that
+ *   is selected by e.  The bits of 2/pi before the window only contribute
+ *   multiples of 4 to the product and are not needed; the bits after it are
+ *   below the precision of the result.
+ *
+ ****************************************************************************/
+
+static int rem_pio2f_large(float x, FAR float *y)
+{
+  uint32_t ix;
+  uint32_t m;
+  uint64_t r;
+  uint64_t f;
+  bool neg;
+  int shift;
+  int pos;
+  int n;
+
+  memcpy(&ix, &x, sizeof(ix));
+  m   = (ix & 0x007fffff) | 0x00800000;
+  pos = (int)((ix >> 23) & 0xff) - 150 - 2;
+
+  /* The bits of x * 2/pi from the weight 2^1 down to 2^-62.  This is
+   * computed modulo 2^64, which drops the multiples of 4.
+   */
+
+  r = ((uint64_t)(m * two_over_pi_bits(pos)) << 32) +
+      (uint64_t)m * two_over_pi_bits(pos + 32) +
+      (((uint64_t)m * two_over_pi_bits(pos + 64)) >> 32);
+
+  /* Round to the nearest quadrant and keep the magnitude of the signed
+   * remainder, a fraction of pi/2 with 62 bits after the binary point.
+   */
+
+  n   = (int)((r + ((uint64_t)1 << 61)) >> 62);
+  f   = r - ((uint64_t)n << 62);
+  neg = (int64_t)f < 0;
+  if (neg)
+    {
+      f = -f;
+    }
+
+  /* Normalize the remainder and multiply the top 32 bits by pi/2 in fixed
+   * point, so that the result is only rounded once.
+   */
+
+  for (shift = 0; shift < 62 && (f >> 56) == 0; shift += 8)
+    {
+      f <<= 8;
+    }
+
+  for (; shift < 62 && (f >> 63) == 0; shift++)
+    {
+      f <<= 1;
+    }
+
+  ix = (uint32_t)(127 - 61 - shift) << 23;
+  memcpy(y, &ix, sizeof(ix));
+  *y *= (float)((f >> 32) * PIO2_Q31);
+  if (neg != (x < 0.0f))
+    {
+      *y = -*y;
+    }
+
+  if (x < 0.0f)
+    {
+      n = -n;
+    }
+
+  return n & 3;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: __rem_pio2f
+ *
+ * Description:
+ *   Reduce x to y = x - n * pi/2 with |y| <= ~pi/4.
+ *
+ * Returned Value:
+ *   n modulo 4, the quadrant of x.  y is invalid if x is not finite.
+ *
+ ****************************************************************************/
+
+int __rem_pio2f(float x, FAR float *y)
+{
+  float fn;
+  int n;
+
+  if (fabsf(x) < CW_LIMIT)
+    {
+      n  = (int)(x * INV_PIO2 + (x < 0.0f ? -0.5f : 0.5f));
+      fn = (float)n;
+      *y = ((x - fn * PIO2_1) - fn * PIO2_2) - fn * PIO2_3;
+      return n & 3;
+    }
+
+  if (!isfinite(x))
+    {
+      *y = x - x;
+      return 0;
+    }
+
+  return rem_pio2f_large(x, y);
+}
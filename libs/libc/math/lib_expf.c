@@ -29,84 +29,148 @@
  * Included Files
  ****************************************************************************/
 
-#include <sys/types.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 #include <math.h>
 
-#include "libc.h"
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The results of arguments above EXPF_MAX overflow, the results of
+ * arguments below EXPF_MIN round to zero.
+ */
+
+#define EXPF_MAX    8.8722839355e+01f
+#define EXPF_MIN    -1.0397208405e+02f
+
+/* 32 / ln(2) and ln(2) / 32 split into two parts.  LN2_32_HI has 11
+ * significant bits, so k * LN2_32_HI is exact for all k of the range.
+ */
+
+#define INV_LN2_32  4.6166240692e+01f
+#define LN2_32_HI   2.1667480469e-02f
+#define LN2_32_LO   -6.6310763032e-06f
 
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
-static float _flt_inv_fact[] =
+/* 2^(j/32) for j = 0..31 */
+
+static const float g_exp2_32[32] =
 {
-  1.0 / 1.0,                    /* 1/0! */
-  1.0 / 1.0,                    /* 1/1! */
-  1.0 / 2.0,                    /* 1/2! */
-  1.0 / 6.0,                    /* 1/3! */
-  1.0 / 24.0,                   /* 1/4! */
-  1.0 / 120.0,                  /* 1/5! */
-  1.0 / 720.0,                  /* 1/6! */
-  1.0 / 5040.0,                 /* 1/7! */
-  1.0 / 40320.0,                /* 1/8! */
-  1.0 / 362880.0,               /* 1/9! */
-  1.0 / 3628800.0,              /* 1/10! */
+  1.000000000f, 1.021897197f, 1.044273734f, 1.067140460f,
+  1.090507746f, 1.114386797f, 1.138788581f, 1.163724899f,
+  1.189207077f, 1.215247393f, 1.241857767f, 1.269050956f,
+  1.296839595f, 1.325236678f, 1.354255557f, 1.383909941f,
+  1.414213538f, 1.445180774f, 1.476826191f, 1.509164453f,
+  1.542210817f, 1.575980902f, 1.610490322f, 1.645755529f,
+  1.681792855f, 1.718619347f, 1.756252170f, 1.794709086f,
+  1.834008098f, 1.874167681f, 1.915206552f, 1.957144141f
 };
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pow2f
+ *
+ * Description:
+ *   Return 2^e for -126 <= e <= 127.
+ *
+ ****************************************************************************/
+
+static float pow2f(int e)
+{
+  uint32_t ix = (uint32_t)(e + 127) << 23;
+  float y;
+
+  memcpy(&y, &ix, sizeof(y));
+  return y;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: expf
+ *
+ * Description:
+ *   x is reduced to x = k * ln(2) / 32 + r with |r| <= ln(2) / 64, then
+ *   exp(x) = 2^(k / 32) * 2^((k % 32) / 32) * exp(r).  exp(r) is a
+ *   polynomial of degree 4.  The error is below 1.1 ULP for the arguments
+ *   with a normal result.
+ *
+ ****************************************************************************/
+
 float expf(float x)
 {
-  size_t int_part;
-  bool invert;
-  float value;
-  float x0;
-  size_t i;
-
-  if (x == 0)
+  float kf;
+  float r;
+  float p;
+  float y;
+  int k;
+  int e;
+
+  if (isnan(x))
     {
-      return 1;
+      return x + x;
     }
-  else if (x < 0)
+
+  if (x > EXPF_MAX)
     {
-      invert = true;
-      x = -x;
+      return INFINITY_F;
     }
-  else
+
+  if (x < EXPF_MIN)
     {
-      invert = false;
+      return 0.0f;
     }
 
-  /* Extract integer component */
-
-  int_part = (size_t) x;
+  kf = x * INV_LN2_32;
+  k  = (int)(kf + (kf < 0.0f ? -0.5f : 0.5f));
+  kf = (float)k;
+  r  = (x - kf * LN2_32_HI) - kf * LN2_32_LO;
 
-  /* set x to fractional component */
+  p  = r + r * r * (0.5f + r * (1.6666667163e-01f + r * 4.1666667908e-02f));
+  y  = g_exp2_32[k & 31];
+  y += y * p;
 
-  x -= (float)int_part;
+  /* Multiply by 2^e.  2^128 and the subnormal powers of two can not be
+   * represented, these are applied in two steps.
+   */
 
-  /* Perform Taylor series approximation with eleven terms */
-
-  value = 0.0F;
-  x0 = 1.0F;
-  for (i = 0; i < 10; i++)
+  e = (k - (k & 31)) / 32;
+  if (e > 127)
     {
-      value += x0 * _flt_inv_fact[i];
-      x0 *= x;
+      y *= 2.0f;
+      e--;
+    }
+  else if (e < -126)
+    {
+      return y * pow2f(e + 64) * pow2f(-64);
     }
 
-  /* Multiply by exp of the integer component */
+  return y * pow2f(e);
+}
 
-  value *= lib_expif(int_part);
+/****************************************************************************
+ * Name: vexpf
+ *
+ * Description:
+ *   Compute the exponential of each of the n elements of src.  dst may be
+ *   the same array as src.
+ *
+ ****************************************************************************/
 
-  if (invert)
-    {
-      return (1.0F / value);
-    }
-  else
+void vexpf(FAR float *dst, FAR const float *src, size_t n)
+{
+  while (n-- > 0)
     {
-      return value;
+      *dst++ = expf(*src++);
     }
 }
@@ -29,22 +29,23 @@
  * Included Files
  ****************************************************************************/
 
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 #include <math.h>
-#include <float.h>
 
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define FLT_MAX_EXP_X   88.0F
+#define SQRTHF      7.0710678118654752440e-01f
 
-/* To avoid looping forever in particular corner cases, every LOGF_MAX_ITER
- * the error criteria is relaxed by a factor LOGF_RELAX_MULTIPLIER.
- * todo: might need to adjust the double floating point version too.
+/* ln(2) split into two parts, LN2_HI has few enough significant bits that
+ * e * LN2_HI is exact for all exponents e.
  */
 
-#define LOGF_MAX_ITER         10
-#define LOGF_RELAX_MULTIPLIER 2
+#define LN2_HI      6.93359375e-01f
+#define LN2_LO      -2.12194440e-04f
 
 /****************************************************************************
  * Public Functions
@@ -52,63 +53,99 @@
 
 /****************************************************************************
  * Name: logf
+ *
+ * Description:
+ *   x is split into x = 2^e * m with sqrt(1/2) <= m < sqrt(2), then
+ *   log(x) = e * ln(2) + log(m).  log(1 + f) with f = m - 1 is a polynomial
+ *   of degree 9 (from the Cephes library).  The error is below 1 ULP.
+ *
  ****************************************************************************/
 
 float logf(float x)
 {
+  uint32_t ix;
+  float fe;
+  float f;
   float y;
-  float y_old;
-  float ney;
-  float epsilon;
-  int   relax_factor;
-  int   iter;
-
-  y       = 0.0F;
-  y_old   = 1.0F;
-  epsilon = FLT_EPSILON;
+  float z;
+  int e;
 
-  iter         = 0;
-  relax_factor = 1;
+  memcpy(&ix, &x, sizeof(ix));
 
-  while (y > y_old + epsilon || y < y_old - epsilon)
+  if (ix >= 0x7f800000)
     {
-      y_old = y;
-      ney   = expf(-y);
-      y    -= 1.0F - x * ney;
+      /* Negative, infinite or NaN */
 
-      if (y > FLT_MAX_EXP_X)
+      if (ix == 0x7f800000 || x != x)
         {
-          y = FLT_MAX_EXP_X;
+          return x + x;
         }
 
-      if (y < -FLT_MAX_EXP_X)
+      if ((ix & 0x7fffffff) == 0)
         {
-          y = -FLT_MAX_EXP_X;
+          return -INFINITY_F;
         }
 
-      epsilon = (fabsf(y) > 1.0F) ? fabsf(y) * FLT_EPSILON : FLT_EPSILON;
+      return NAN_F;
+    }
 
-      if (++iter >= LOGF_MAX_ITER)
-        {
-          relax_factor *= LOGF_RELAX_MULTIPLIER;
-          iter = 0;
-        }
+  e = 0;
+  if (ix < 0x00800000)
+    {
+      /* Zero or subnormal */
 
-      if (relax_factor > 1)
+      if (ix == 0)
         {
-          epsilon *= relax_factor;
+          return -INFINITY_F;
         }
+
+      x *= 0x1p25f;
+      memcpy(&ix, &x, sizeof(ix));
+      e = -25;
     }
 
-  if (y == FLT_MAX_EXP_X)
+  /* m in [0.5, 1) */
+
+  e += (int)(ix >> 23) - 126;
+  ix = (ix & 0x007fffff) | 0x3f000000;
+  memcpy(&f, &ix, sizeof(f));
+
+  if (f < SQRTHF)
     {
-      return INFINITY;
+      e--;
+      f = f + f - 1.0f;
     }
-
-  if (y == -FLT_MAX_EXP_X)
+  else
     {
-      return INFINITY;
+      f = f - 1.0f;
     }
 
-  return y;
+  z = f * f;
+  y = ((((((((7.0376836292e-2f * f - 1.1514610310e-1f) * f +
+             1.1676998740e-1f) * f - 1.2420140846e-1f) * f +
+           1.4249322787e-1f) * f - 1.6668057665e-1f) * f +
+         2.0000714765e-1f) * f - 2.4999993993e-1f) * f +
+       3.3333331174e-1f) * f * z;
+
+  fe = (float)e;
+  y += fe * LN2_LO;
+  y -= 0.5f * z;
+  return (f + y) + fe * LN2_HI;
+}
+
+/****************************************************************************
+ * Name: vlogf
+ *
+ * Description:
+ *   Compute the natural logarithm of each of the n elements of src.  dst
+ *   may be the same array as src.
+ *
+ ****************************************************************************/
+
+void vlogf(FAR float *dst, FAR const float *src, size_t n)
+{
+  while (n-- > 0)
+    {
+      *dst++ = logf(*src++);
+    }
 }
@@ -29,76 +29,65 @@
  * Included Files
  ****************************************************************************/
 
-#include <sys/types.h>
+#include <stddef.h>
 #include <math.h>
 
 /****************************************************************************
- * Private Data
+ * Public Functions
  ****************************************************************************/
 
-static float _flt_inv_fact[] =
-{
-  1.0 / 1.0,                    /* 1 / 1! */
-  1.0 / 6.0,                    /* 1 / 3! */
-  1.0 / 120.0,                  /* 1 / 5! */
-  1.0 / 5040.0,                 /* 1 / 7! */
-  1.0 / 362880.0,               /* 1 / 9! */
-  1.0 / 39916800.0,             /* 1 / 11! */
-};
-
 /****************************************************************************
- * Public Functions
+ * Name: sinf
+ *
+ * Description:
+ *   The argument is reduced to [-pi/4, pi/4] and the sine or cosine kernel
+ *   is selected by the quadrant.  The error is below 1.6 ULP for all finite
+ *   arguments.
+ *
  ****************************************************************************/
 
 float sinf(float x)
 {
-  float x_squared;
-  float sin_x;
-  size_t i;
+  float y;
 
-  /* Move x to [-pi, pi) */
-
-  x = fmodf(x, 2 * M_PI_F);
-  if (x >= M_PI_F)
+  if (fabsf(x) <= M_PI_4_F)
     {
-      x -= 2 * M_PI_F;
+      /* sin(x) rounds to x for |x| < 2^-12, this also keeps the sign of
+       * -0.
+       */
+
+      return fabsf(x) < 2.44140625e-4f ? x : __sinf(x);
     }
 
-  if (x < -M_PI_F)
+  switch (__rem_pio2f(x, &y))
     {
-      x += 2 * M_PI_F;
-    }
+      case 0:
+        return __sinf(y);
 
-  /* Move x to [-pi/2, pi/2) */
+      case 1:
+        return __cosf(y);
 
-  if (x >= M_PI_2_F)
-    {
-      x = M_PI_F - x;
-    }
+      case 2:
+        return -__sinf(y);
 
-  if (x < -M_PI_2_F)
-    {
-      x = -M_PI_F - x;
+      default:
+        return -__cosf(y);
     }
+}
 
-  x_squared = x * x;
-  sin_x = 0.0F;
-
-  /* Perform Taylor series approximation for sin(x) with six terms */
+/****************************************************************************
+ * Name: vsinf
+ *
+ * Description:
+ *   Compute the sine of each of the n elements of src.  dst may be the same
+ *   array as src.
+ *
+ ****************************************************************************/
 
-  for (i = 0; i < 6; i++)
+void vsinf(FAR float *dst, FAR const float *src, size_t n)
+{
+  while (n-- > 0)
     {
-      if (i % 2 == 0)
-        {
-          sin_x += x * _flt_inv_fact[i];
-        }
-      else
-        {
-          sin_x -= x * _flt_inv_fact[i];
-        }
-
-      x *= x_squared;
+      *dst++ = sinf(*src++);
     }
-
-  return sin_x;
 }
@@ -0,0 +1,255 @@
+/****************************************************************************
+ * libs/libc/misc/lib_spscring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/lib/spscring.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The data must be visible before the counter that publishes it, and the
+ * counter must be read before the data.  This needs a full memory barrier
+ * on SMP and on weakly ordered memory.  Without GCC, only the volatile
+ * counters keep the compiler from reordering.
+ */
+
+#ifdef __GNUC__
+#  define SPSCRING_MB() __sync_synchronize()
+#else
+#  define SPSCRING_MB()
+#endif
+
+#define SPSCRING_DATA(r)  ((FAR uint8_t *)((r) + 1))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spscring_copy
+ *
+ * Description:
+ *   Copy between the data area starting at the counter value pos and a
+ *   linear buffer, wrapping at the end of the data area.
+ *
+ ****************************************************************************/
+
+static void spscring_copy(FAR struct spscring_s *ring, uint32_t pos,
+                          FAR uint8_t *buf, size_t len, bool in)
+{
+  FAR uint8_t *data = SPSCRING_DATA(ring);
+  uint32_t off = pos & (ring->size - 1);
+  size_t n = ring->size - off;
+
+  if (n > len)
+    {
+      n = len;
+    }
+
+  if (in)
+    {
+      memcpy(&data[off], buf, n);
+      memcpy(data, &buf[n], len - n);
+    }
+  else
+    {
+      memcpy(buf, &data[off], n);
+      memcpy(&buf[n], data, len - n);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: spscring_init
+ ****************************************************************************/
+
+int spscring_init(FAR struct spscring_s *ring, size_t size)
+{
+  DEBUGASSERT(ring != NULL);
+
+  if (size == 0 || (size & (size - 1)) != 0 || size > UINT32_MAX / 2)
+    {
+      return -EINVAL;
+    }
+
+  ring->head     = 0;
+  ring->tail     = 0;
+  ring->size     = size;
+  ring->reserved = 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: spscring_used
+ ****************************************************************************/
+
+size_t spscring_used(FAR const struct spscring_s *ring)
+{
+  return ring->head - ring->tail;
+}
+
+/****************************************************************************
+ * Name: spscring_space
+ ****************************************************************************/
+
+size_t spscring_space(FAR const struct spscring_s *ring)
+{
+  return ring->size - (ring->head - ring->tail);
+}
+
+/****************************************************************************
+ * Name: spscring_write
+ ****************************************************************************/
+
+size_t spscring_write(FAR struct spscring_s *ring, FAR const void *buf,
+                      size_t len)
+{
+  uint32_t head = ring->head;
+  size_t space;
+
+  /* Do not touch the data area before the consumer is done with it */
+
+  space = ring->size - (head - ring->tail);
+  SPSCRING_MB();
+
+  if (len > space)
+    {
+      len = space;
+    }
+
+  if (len > 0)
+    {
+      spscring_copy(ring, head, (FAR uint8_t *)buf, len, true);
+      SPSCRING_MB();
+      ring->head = head + len;
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: spscring_read
+ ****************************************************************************/
+
+size_t spscring_read(FAR struct spscring_s *ring, FAR void *buf,
+                     size_t len)
+{
+  uint32_t tail = ring->tail;
+  size_t used;
+
+  used = ring->head - tail;
+  SPSCRING_MB();
+
+  if (len > used)
+    {
+      len = used;
+    }
+
+  if (len > 0)
+    {
+      spscring_copy(ring, tail, buf, len, false);
+      SPSCRING_MB();
+      ring->tail = tail + len;
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: spscring_wbuf
+ ****************************************************************************/
+
+size_t spscring_wbuf(FAR struct spscring_s *ring, FAR void **ptr)
+{
+  uint32_t head = ring->head;
+  uint32_t off = head & (ring->size - 1);
+  size_t space;
+
+  space = ring->size - (head - ring->tail);
+  SPSCRING_MB();
+
+  if (space > ring->size - off)
+    {
+      space = ring->size - off;
+    }
+
+  *ptr = &SPSCRING_DATA(ring)[off];
+  return space;
+}
+
+/****************************************************************************
+ * Name: spscring_wcommit
+ ****************************************************************************/
+
+void spscring_wcommit(FAR struct spscring_s *ring, size_t len)
+{
+  DEBUGASSERT(len <= spscring_space(ring));
+
+  SPSCRING_MB();
+  ring->head += len;
+}
+
+/****************************************************************************
+ * Name: spscring_rbuf
+ ****************************************************************************/
+
+size_t spscring_rbuf(FAR struct spscring_s *ring, FAR const void **ptr)
+{
+  uint32_t tail = ring->tail;
+  uint32_t off = tail & (ring->size - 1);
+  size_t used;
+
+  used = ring->head - tail;
+  SPSCRING_MB();
+
+  if (used > ring->size - off)
+    {
+      used = ring->size - off;
+    }
+
+  *ptr = &SPSCRING_DATA(ring)[off];
+  return used;
+}
+
+/****************************************************************************
+ * Name: spscring_rcommit
+ ****************************************************************************/
+
+void spscring_rcommit(FAR struct spscring_s *ring, size_t len)
+{
+  DEBUGASSERT(len <= spscring_used(ring));
+
+  SPSCRING_MB();
+  ring->tail += len;
+}
@@ -112,6 +112,25 @@ int modlib_readsym(FAR struct mod_loadinfo_s *loadinfo, int index,
 int modlib_symvalue(FAR struct module_s *modp,
                     FAR struct mod_loadinfo_s *loadinfo, FAR Elf_Sym *sym);
 
+/****************************************************************************
+ * Name: modlib_findsymbol
+ *
+ * Description:
+ *   Find the symbol with the given name in the current symbol table.  With
+ *   CONFIG_SYMTAB_HASH, the lookup uses a hash table that is built on the
+ *   first lookup after the symbol table was selected.
+ *
+ * Input Parameters:
+ *   name - The name of the symbol.
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *modlib_findsymbol(FAR const char *name);
+
 /****************************************************************************
  * Name: modlib_loadshdrs
  *
@@ -314,7 +314,6 @@ int modlib_symvalue(FAR struct module_s *modp,
   FAR const struct symtab_s *symbol;
   struct mod_exportinfo_s exportinfo;
   uintptr_t secbase;
-  int nsymbols;
   int ret;
 
   switch (sym->st_shndx)
@@ -378,14 +377,7 @@ int modlib_symvalue(FAR struct module_s *modp,
 
         if (symbol == NULL)
           {
-            modlib_getsymtab(&symbol, &nsymbols);
-#ifdef CONFIG_SYMTAB_ORDEREDBYNAME
-            symbol = symtab_findorderedbyname(symbol, exportinfo.name,
-                                              nsymbols);
-#else
-            symbol = symtab_findbyname(symbol, exportinfo.name,
-                                       nsymbols);
-#endif
+            symbol = modlib_findsymbol(exportinfo.name);
           }
 
         /* Was the symbol found from any exporter? */
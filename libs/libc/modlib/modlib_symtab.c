@@ -29,6 +29,8 @@
 #include <nuttx/symtab.h>
 #include <nuttx/lib/modlib.h>
 
+#include "modlib/modlib.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -63,6 +65,12 @@ extern int CONFIG_MODLIB_NSYMBOLS_VAR;
 static FAR const struct symtab_s *g_modlib_symtab;
 static FAR int g_modlib_nsymbols;
 
+#ifdef CONFIG_SYMTAB_HASH
+/* Hash table of g_modlib_symtab, built on the first lookup */
+
+static struct symtab_hash_s g_modlib_hash;
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -127,3 +135,51 @@ void modlib_setsymtab(FAR const struct symtab_s *symtab, int nsymbols)
   g_modlib_nsymbols = nsymbols;
   modlib_registry_unlock();
 }
+
+/****************************************************************************
+ * Name: modlib_findsymbol
+ *
+ * Description:
+ *   Find the symbol with the given name in the current symbol table.  With
+ *   CONFIG_SYMTAB_HASH, the lookup uses a hash table that is built on the
+ *   first lookup after the symbol table was selected.
+ *
+ * Input Parameters:
+ *   name - The name of the symbol.
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *modlib_findsymbol(FAR const char *name)
+{
+  FAR const struct symtab_s *symtab;
+  FAR const struct symtab_s *symbol;
+  int nsymbols;
+
+  /* Borrow the registry lock to protect the hash table */
+
+  modlib_registry_lock();
+  modlib_getsymtab(&symtab, &nsymbols);
+
+#ifdef CONFIG_SYMTAB_HASH
+  if (g_modlib_hash.symtab != symtab || g_modlib_hash.nsyms != nsymbols)
+    {
+      /* Without memory for the hash table, the symbols are searched */
+
+      symtab_hashfree(&g_modlib_hash);
+      symtab_hashinit(&g_modlib_hash, symtab, nsymbols);
+    }
+
+  symbol = symtab_findbyhash(&g_modlib_hash, name);
+#elif defined(CONFIG_SYMTAB_ORDEREDBYNAME)
+  symbol = symtab_findorderedbyname(symtab, name, nsymbols);
+#else
+  symbol = symtab_findbyname(symtab, name, nsymbols);
+#endif
+
+  modlib_registry_unlock();
+  return symbol;
+}
@@ -90,6 +90,7 @@ int pthread_cond_init(FAR pthread_cond_t *cond, FAR const pthread_condattr_t *at
        */
 
       sem_setprotocol(&cond->sem, SEM_PRIO_NONE);
+      cond->mutex = NULL;
     }
 
   sinfo("Returning %d\n", ret);
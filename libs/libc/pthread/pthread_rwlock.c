@@ -68,9 +68,17 @@ int pthread_rwlock_init(FAR pthread_rwlock_t *lock,
       return err;
     }
 
+  err = pthread_cond_init(&lock->wcv, NULL);
+  if (err != 0)
+    {
+      pthread_cond_destroy(&lock->cv);
+      return err;
+    }
+
   err = pthread_mutex_init(&lock->lock, NULL);
   if (err != 0)
     {
+      pthread_cond_destroy(&lock->wcv);
       pthread_cond_destroy(&lock->cv);
       return err;
     }
@@ -81,6 +89,7 @@ int pthread_rwlock_init(FAR pthread_rwlock_t *lock,
 int pthread_rwlock_destroy(FAR pthread_rwlock_t *lock)
 {
   int cond_err  = pthread_cond_destroy(&lock->cv);
+  int wcond_err = pthread_cond_destroy(&lock->wcv);
   int mutex_err = pthread_mutex_destroy(&lock->lock);
 
   if (mutex_err)
@@ -88,7 +97,7 @@ int pthread_rwlock_destroy(FAR pthread_rwlock_t *lock)
       return mutex_err;
     }
 
-  return cond_err;
+  return cond_err != 0 ? cond_err : wcond_err;
 }
 
 int pthread_rwlock_unlock(FAR pthread_rwlock_t *rw_lock)
@@ -101,20 +110,32 @@ int pthread_rwlock_unlock(FAR pthread_rwlock_t *rw_lock)
       return err;
     }
 
+  /* Only writers can be blocked by readers.  Wake up one of them at a time
+   * since only one can get the lock.  Readers are blocked while any writer
+   * waits, so they are woken up only when no writers are left.
+   */
+
   if (rw_lock->num_readers > 0)
     {
       rw_lock->num_readers--;
 
-      if (rw_lock->num_readers == 0)
+      if (rw_lock->num_readers == 0 && rw_lock->num_writers > 0)
         {
-          err = pthread_cond_broadcast(&rw_lock->cv);
+          err = pthread_cond_signal(&rw_lock->wcv);
         }
     }
   else if (rw_lock->write_in_progress)
     {
       rw_lock->write_in_progress = false;
 
-      err = pthread_cond_broadcast(&rw_lock->cv);
+      if (rw_lock->num_writers > 0)
+        {
+          err = pthread_cond_signal(&rw_lock->wcv);
+        }
+      else
+        {
+          err = pthread_cond_broadcast(&rw_lock->cv);
+        }
     }
   else
     {
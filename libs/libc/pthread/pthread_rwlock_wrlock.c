@@ -48,12 +48,31 @@
  * Private Functions
  ****************************************************************************/
 
+/* Called when a blocked writer gives up.  It may have consumed the wakeup
+ * meant for another writer, so pass it on.  If it was the last writer,
+ * the readers that it blocked may now proceed.
+ */
+
+static void wrlock_abort(FAR pthread_rwlock_t *rw_lock)
+{
+  rw_lock->num_writers--;
+
+  if (rw_lock->num_writers > 0)
+    {
+      pthread_cond_signal(&rw_lock->wcv);
+    }
+  else
+    {
+      pthread_cond_broadcast(&rw_lock->cv);
+    }
+}
+
 #ifdef CONFIG_PTHREAD_CLEANUP
 static void wrlock_cleanup(FAR void *arg)
 {
   FAR pthread_rwlock_t *rw_lock = (FAR pthread_rwlock_t *)arg;
 
-  rw_lock->num_writers--;
+  wrlock_abort(rw_lock);
   pthread_mutex_unlock(&rw_lock->lock);
 }
 #endif
@@ -125,11 +144,11 @@ int pthread_rwlock_timedwrlock(FAR pthread_rwlock_t *rw_lock,
     {
       if (ts != NULL)
         {
-          err = pthread_cond_timedwait(&rw_lock->cv, &rw_lock->lock, ts);
+          err = pthread_cond_timedwait(&rw_lock->wcv, &rw_lock->lock, ts);
         }
       else
         {
-          err = pthread_cond_wait(&rw_lock->cv, &rw_lock->lock);
+          err = pthread_cond_wait(&rw_lock->wcv, &rw_lock->lock);
         }
 
       if (err != 0)
@@ -144,16 +163,13 @@ int pthread_rwlock_timedwrlock(FAR pthread_rwlock_t *rw_lock,
   if (err == 0)
     {
       rw_lock->write_in_progress = true;
+      rw_lock->num_writers--;
     }
   else
     {
-      /* In case of error, notify any blocked readers. */
-
-      pthread_cond_broadcast(&rw_lock->cv);
+      wrlock_abort(rw_lock);
     }
 
-  rw_lock->num_writers--;
-
 exit_with_mutex:
   pthread_mutex_unlock(&rw_lock->lock);
   return err;
@@ -38,6 +38,7 @@
  ****************************************************************************/
 
 #include <sys/types.h>
+#include <string.h>
 #include <math.h>
 
 #include "lib_dtoa_engine.h"
@@ -60,6 +61,257 @@
 #define MAX(a, b)     ((a) > (b) ? (a) : (b))
 #define MIN(a, b)     ((a) < (b) ? (a) : (b))
 
+/* With IEEE-754 doubles the digits are computed with integer arithmetic in
+ * the manner of Grisu: the 64-bit mantissa is multiplied by a 64-bit
+ * approximation of a power of ten, which gives 18 or 19 digits that are
+ * correct to within one unit of the last one.  Scaling with floating point
+ * needs up to ten inexact multiplications instead, which are slow with
+ * soft floating point and may get the 15th digit wrong.
+ */
+
+#if defined(CONFIG_HAVE_DOUBLE) && DBL_MANT_DIG == 53
+#  define DTOA_GRISU    1
+#  define POW10_KMIN    (-296)  /* Power of the first cached entry */
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef DTOA_GRISU
+struct dtoa_pow10_s
+{
+  uint64_t mant;                /* Normalized: bit 63 is set */
+  int16_t exp;                  /* 10^k = mant * 2^exp */
+};
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef DTOA_GRISU
+/* Every eighth power of ten from 1e-296 to 1e336, rounded to 64 bits */
+
+static const struct dtoa_pow10_s g_dtoa_pow10[] =
+{
+  { 0xd1476e2c07286faaull, -1047 }, /* 1e-296 */
+  { 0x9becce62836ac577ull, -1020 }, /* 1e-288 */
+  { 0xe858ad248f5c22caull,  -994 }, /* 1e-280 */
+  { 0xad1c8eab5ee43b67ull,  -967 }, /* 1e-272 */
+  { 0x80fa687f881c7f8eull,  -940 }, /* 1e-264 */
+  { 0xc0314325637a193aull,  -914 }, /* 1e-256 */
+  { 0x8f31cc0937ae58d3ull,  -887 }, /* 1e-248 */
+  { 0xd5605fcdcf32e1d7ull,  -861 }, /* 1e-240 */
+  { 0x9efa548d26e5a6e2ull,  -834 }, /* 1e-232 */
+  { 0xece53cec4a314ebeull,  -808 }, /* 1e-224 */
+  { 0xb080392cc4349dedull,  -781 }, /* 1e-216 */
+  { 0x8380dea93da4bc60ull,  -754 }, /* 1e-208 */
+  { 0xc3f490aa77bd60fdull,  -728 }, /* 1e-200 */
+  { 0x91ff83775423cc06ull,  -701 }, /* 1e-192 */
+  { 0xd98ddaee19068c76ull,  -675 }, /* 1e-184 */
+  { 0xa21727db38cb0030ull,  -648 }, /* 1e-176 */
+  { 0xf18899b1bc3f8ca2ull,  -622 }, /* 1e-168 */
+  { 0xb3f4e093db73a093ull,  -595 }, /* 1e-160 */
+  { 0x8613fd0145877586ull,  -568 }, /* 1e-152 */
+  { 0xc7caba6e7c5382c9ull,  -542 }, /* 1e-144 */
+  { 0x94db483840b717f0ull,  -515 }, /* 1e-136 */
+  { 0xddd0467c64bce4a1ull,  -489 }, /* 1e-128 */
+  { 0xa54394fe1eedb8ffull,  -462 }, /* 1e-120 */
+  { 0xf64335bcf065d37dull,  -436 }, /* 1e-112 */
+  { 0xb77ada0617e3bbcbull,  -409 }, /* 1e-104 */
+  { 0x88b402f7fd75539bull,  -382 }, /* 1e-96 */
+  { 0xcbb41ef979346bcaull,  -356 }, /* 1e-88 */
+  { 0x97c560ba6b0919a6ull,  -329 }, /* 1e-80 */
+  { 0xe2280b6c20dd5232ull,  -303 }, /* 1e-72 */
+  { 0xa87fea27a539e9a5ull,  -276 }, /* 1e-64 */
+  { 0xfb158592be068d2full,  -250 }, /* 1e-56 */
+  { 0xbb127c53b17ec159ull,  -223 }, /* 1e-48 */
+  { 0x8b61313bbabce2c6ull,  -196 }, /* 1e-40 */
+  { 0xcfb11ead453994baull,  -170 }, /* 1e-32 */
+  { 0x9abe14cd44753b53ull,  -143 }, /* 1e-24 */
+  { 0xe69594bec44de15bull,  -117 }, /* 1e-16 */
+  { 0xabcc77118461cefdull,   -90 }, /* 1e-8 */
+  { 0x8000000000000000ull,   -63 }, /* 1e0 */
+  { 0xbebc200000000000ull,   -37 }, /* 1e8 */
+  { 0x8e1bc9bf04000000ull,   -10 }, /* 1e16 */
+  { 0xd3c21bcecceda100ull,    16 }, /* 1e24 */
+  { 0x9dc5ada82b70b59eull,    43 }, /* 1e32 */
+  { 0xeb194f8e1ae525fdull,    69 }, /* 1e40 */
+  { 0xaf298d050e4395d7ull,    96 }, /* 1e48 */
+  { 0x82818f1281ed44a0ull,   123 }, /* 1e56 */
+  { 0xc2781f49ffcfa6d5ull,   149 }, /* 1e64 */
+  { 0x90e40fbeea1d3a4bull,   176 }, /* 1e72 */
+  { 0xd7e77a8f87daf7fcull,   202 }, /* 1e80 */
+  { 0xa0dc75f1778e39d6ull,   229 }, /* 1e88 */
+  { 0xefb3ab16c59b14a3ull,   255 }, /* 1e96 */
+  { 0xb2977ee300c50fe7ull,   282 }, /* 1e104 */
+  { 0x850fadc09923329eull,   309 }, /* 1e112 */
+  { 0xc646d63501a1511eull,   335 }, /* 1e120 */
+  { 0x93ba47c980e98ce0ull,   362 }, /* 1e128 */
+  { 0xdc21a1171d42645dull,   388 }, /* 1e136 */
+  { 0xa402b9c5a8d3a6e7ull,   415 }, /* 1e144 */
+  { 0xf46518c2ef5b8cd1ull,   441 }, /* 1e152 */
+  { 0xb616a12b7fe617aaull,   468 }, /* 1e160 */
+  { 0x87aa9aff79042287ull,   495 }, /* 1e168 */
+  { 0xca28a291859bbf93ull,   521 }, /* 1e176 */
+  { 0x969eb7c47859e744ull,   548 }, /* 1e184 */
+  { 0xe070f78d3927556bull,   574 }, /* 1e192 */
+  { 0xa738c6bebb12d16dull,   601 }, /* 1e200 */
+  { 0xf92e0c3537826146ull,   627 }, /* 1e208 */
+  { 0xb9a74a0637ce2ee1ull,   654 }, /* 1e216 */
+  { 0x8a5296ffe33cc930ull,   681 }, /* 1e224 */
+  { 0xce1de40642e3f4b9ull,   707 }, /* 1e232 */
+  { 0x9991a6f3d6bf1766ull,   734 }, /* 1e240 */
+  { 0xe4d5e82392a40515ull,   760 }, /* 1e248 */
+  { 0xaa7eebfb9df9de8eull,   787 }, /* 1e256 */
+  { 0xfe0efb53d30dd4d8ull,   813 }, /* 1e264 */
+  { 0xbd49d14aa79dbc82ull,   840 }, /* 1e272 */
+  { 0x8d07e33455637eb3ull,   867 }, /* 1e280 */
+  { 0xd226fc195c6a2f8cull,   893 }, /* 1e288 */
+  { 0x9c935e00d4b9d8d2ull,   920 }, /* 1e296 */
+  { 0xe950df20247c83fdull,   946 }, /* 1e304 */
+  { 0xadd57a27d29339f6ull,   973 }, /* 1e312 */
+  { 0x81842f29f2cce376ull,  1000 }, /* 1e320 */
+  { 0xc0fe908895cf3b44ull,  1026 }, /* 1e328 */
+  { 0x8fcac257558ee4e6ull,  1053 }, /* 1e336 */
+};
+
+static const uint64_t g_dtoa_int10[] =
+{
+  1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull,
+  10000000ull, 100000000ull, 1000000000ull, 10000000000ull,
+  100000000000ull, 1000000000000ull, 10000000000000ull,
+  100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+  100000000000000000ull, 1000000000000000000ull,
+  10000000000000000000ull
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+#ifdef DTOA_GRISU
+/****************************************************************************
+ * Name: dtoa_mulhi
+ *
+ * Description:
+ *   Return the upper 64 bits of the rounded 128-bit product a * b.
+ *
+ ****************************************************************************/
+
+static uint64_t dtoa_mulhi(uint64_t a, uint64_t b)
+{
+  uint64_t alo = (uint32_t)a;
+  uint64_t ahi = a >> 32;
+  uint64_t blo = (uint32_t)b;
+  uint64_t bhi = b >> 32;
+  uint64_t p0  = alo * blo;
+  uint64_t p1  = alo * bhi;
+  uint64_t p2  = ahi * blo;
+  uint64_t mid = (p0 >> 32) + (uint32_t)p1 + (uint32_t)p2 + (1u << 31);
+
+  return ahi * bhi + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+}
+
+/****************************************************************************
+ * Name: dtoa_pow10
+ *
+ * Description:
+ *   Return the normalized 64-bit mantissa of 10^k and its binary exponent.
+ *   The cached power is multiplied by an exact 10^0..10^7.
+ *
+ ****************************************************************************/
+
+static uint64_t dtoa_pow10(int k, FAR int *exp)
+{
+  FAR const struct dtoa_pow10_s *p = &g_dtoa_pow10[(k - POW10_KMIN) >> 3];
+  uint32_t small = (uint32_t)g_dtoa_int10[(k - POW10_KMIN) & 7];
+  uint64_t lo;
+  uint64_t hi;
+  int lz;
+
+  *exp = p->exp;
+  if (small == 1)
+    {
+      return p->mant;
+    }
+
+  /* The 96-bit product is hi:lo32.  Keep its upper 64 bits. */
+
+  lo  = (uint32_t)p->mant * (uint64_t)small;
+  hi  = (p->mant >> 32) * small + (lo >> 32);
+  lz  = __builtin_clzll(hi);
+
+  *exp += 32 - lz;
+  return (hi << lz) | ((uint32_t)lo >> (32 - lz));
+}
+
+/****************************************************************************
+ * Name: dtoa_digits
+ *
+ * Description:
+ *   Convert a finite, non-zero double to a 18 or 19 digit integer and the
+ *   decimal exponent of its first digit.
+ *
+ ****************************************************************************/
+
+static uint64_t dtoa_digits(double_t x, FAR int32_t *exp,
+                            FAR int *ndigits)
+{
+  uint64_t bits;
+  uint64_t mant;
+  uint64_t pm;
+  uint64_t n;
+  int e2;
+  int pe;
+  int k10;
+  int q;
+  int d;
+
+  memcpy(&bits, &x, sizeof(bits));
+  mant = bits & ((1ull << 52) - 1);
+  e2   = (int)((bits >> 52) & 0x7ff);
+
+  if (e2 != 0)
+    {
+      mant |= 1ull << 52;
+      e2   -= 1075;
+    }
+  else
+    {
+      e2    = -1074;  /* Subnormal */
+    }
+
+  /* Normalize to x = mant * 2^e2 with bit 63 of mant set */
+
+  d     = __builtin_clzll(mant);
+  mant <<= d;
+  e2   -= d;
+
+  /* log10(x) >= (e2 + 63) * log10(2) >= k10.  Scaling by 10^(17 - k10)
+   * gives at least 1e17 and less than 2^61.
+   */
+
+  k10 = ((e2 + 63) * 78913) >> 18;
+  q   = 17 - k10;
+
+  pm  = dtoa_pow10(q, &pe);
+  n   = dtoa_mulhi(mant, pm);
+
+  /* Truncate: the digits are rounded only once, by the caller */
+
+  d   = -(e2 + pe + 64);        /* 1..8 */
+  n >>= d;
+
+  d   = n >= g_dtoa_int10[18] ? 19 : 18;
+  *exp = d - 1 - q;
+  *ndigits = d;
+  return n;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -91,6 +343,57 @@ int __dtoa_engine(double_t x, FAR struct dtoa_s *dtoa, int max_digits,
     {
       flags |= DTOA_INF;
     }
+#ifdef DTOA_GRISU
+  else
+    {
+      uint64_t mant;
+      uint32_t part;
+      int drop;
+      int n;
+
+      mant = dtoa_digits(x, &exp, &n);
+
+      if (max_decimals != 0)
+        {
+          max_digits = MIN(max_digits, max_decimals + MAX(exp + 1, 1));
+        }
+
+      /* Round nearest on the last digit kept */
+
+      drop = n - max_digits;
+      mant = (mant + g_dtoa_int10[drop] / 2) / g_dtoa_int10[drop];
+
+      if (mant >= g_dtoa_int10[max_digits])
+        {
+          mant /= 10;
+          exp++;
+        }
+
+      /* Split into 8 digit parts so that most divisions are 32-bit */
+
+      i = max_digits;
+      while (i > 0)
+        {
+          if (i > 8)
+            {
+              part = (uint32_t)(mant % 100000000);
+              mant /= 100000000;
+              n = 8;
+            }
+          else
+            {
+              part = (uint32_t)mant;
+              n = i;
+            }
+
+          while (n-- > 0)
+            {
+              dtoa->digits[--i] = part % 10 + '0';
+              part /= 10;
+            }
+        }
+    }
+#else
   else
     {
       double_t y;
@@ -162,6 +465,7 @@ int __dtoa_engine(double_t x, FAR struct dtoa_s *dtoa, int max_digits,
           decimal /= 10;
         }
     }
+#endif
 
   dtoa->digits[max_digits] = '\0';
   dtoa->flags = flags;
@@ -37,7 +37,10 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
 #include <stdio.h>
+
 #include "libc.h"
 
 /****************************************************************************
@@ -45,15 +48,34 @@
  ****************************************************************************/
 
 /****************************************************************************
- * fgetc
+ * fgetc_unlocked
  ****************************************************************************/
 
-int fgetc(FAR FILE *stream)
+int fgetc_unlocked(FAR FILE *stream)
 {
   unsigned char ch;
   ssize_t ret;
 
-  ret = lib_fread(&ch, 1, stream);
+#ifndef CONFIG_STDIO_DISABLE_BUFFERING
+  /* Take the next character directly from the buffer if it holds read
+   * data and there are no characters from ungetc() to return first.
+   */
+
+#if CONFIG_NUNGET_CHARS > 0
+  if (stream != NULL && stream->fs_nungotten == 0)
+#else
+  if (stream != NULL)
+#endif
+    {
+      if (stream->fs_bufpos < stream->fs_bufread)
+        {
+          stream->fs_flags &= ~__FS_FLAG_EOF;
+          return *stream->fs_bufpos++;
+        }
+    }
+#endif
+
+  ret = lib_fread_unlocked(&ch, 1, stream);
   if (ret > 0)
     {
       return ch;
@@ -63,3 +85,23 @@ int fgetc(FAR FILE *stream)
       return EOF;
     }
 }
+
+/****************************************************************************
+ * fgetc
+ ****************************************************************************/
+
+int fgetc(FAR FILE *stream)
+{
+  int ret;
+
+  if (stream == NULL)
+    {
+      return fgetc_unlocked(stream);
+    }
+
+  lib_take_semaphore(stream);
+  ret = fgetc_unlocked(stream);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
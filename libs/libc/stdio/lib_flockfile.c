@@ -0,0 +1,75 @@
+/****************************************************************************
+ * libs/libc/stdio/lib_flockfile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: flockfile
+ *
+ * Description:
+ *   Acquire the lock of a stream for the calling thread.  The lock is
+ *   recursive; the normal stdio functions take it too, so a thread holding
+ *   it may mix them with the *_unlocked variants.
+ *
+ ****************************************************************************/
+
+void flockfile(FAR FILE *stream)
+{
+  lib_take_semaphore(stream);
+}
+
+/****************************************************************************
+ * Name: ftrylockfile
+ *
+ * Description:
+ *   Like flockfile() but return a non-zero value instead of waiting if the
+ *   stream is locked by another thread.
+ *
+ ****************************************************************************/
+
+int ftrylockfile(FAR FILE *stream)
+{
+  return lib_trytake_semaphore(stream) < 0 ? -1 : 0;
+}
+
+/****************************************************************************
+ * Name: funlockfile
+ *
+ * Description:
+ *   Release one count of the lock taken with flockfile().
+ *
+ ****************************************************************************/
+
+void funlockfile(FAR FILE *stream)
+{
+  lib_give_semaphore(stream);
+}
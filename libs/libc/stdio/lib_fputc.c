@@ -37,7 +37,11 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
 #include <stdio.h>
+#include <fcntl.h>
+
 #include "libc.h"
 
 /****************************************************************************
@@ -45,15 +49,32 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: fputc
+ * Name: fputc_unlocked
  ****************************************************************************/
 
-int fputc(int c, FAR FILE *stream)
+int fputc_unlocked(int c, FAR FILE *stream)
 {
   unsigned char buf = (unsigned char)c;
   int ret;
 
-  ret = lib_fwrite(&buf, 1, stream);
+#ifndef CONFIG_STDIO_DISABLE_BUFFERING
+  /* Store the character directly in the buffer if the buffer holds no
+   * read data, the character does not fill the buffer and it does not
+   * need a flush of a line buffered stream.
+   */
+
+  if (stream != NULL && stream->fs_bufstart != NULL &&
+      stream->fs_bufread == stream->fs_bufstart &&
+      stream->fs_bufpos + 1 < stream->fs_bufend &&
+      (stream->fs_oflags & O_WROK) != 0 &&
+      (c != '\n' || (stream->fs_flags & __FS_FLAG_LBF) == 0))
+    {
+      *stream->fs_bufpos++ = buf;
+      return c;
+    }
+#endif
+
+  ret = lib_fwrite_unlocked(&buf, 1, stream);
   if (ret > 0)
     {
       /* Flush the buffer if a newline is output */
@@ -74,3 +95,23 @@ int fputc(int c, FAR FILE *stream)
       return EOF;
     }
 }
+
+/****************************************************************************
+ * Name: fputc
+ ****************************************************************************/
+
+int fputc(int c, FAR FILE *stream)
+{
+  int ret;
+
+  if (stream == NULL)
+    {
+      return fputc_unlocked(c, stream);
+    }
+
+  lib_take_semaphore(stream);
+  ret = fputc_unlocked(c, stream);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
@@ -167,6 +167,10 @@ ssize_t getdelim(FAR char **lineptr, size_t *n, int delimiter,
   ncopied  = 0;             /* No bytes have been transferred yet */
   maxcopy  = bufsize - 1;   /* Reserve a byte for the NUL terminator */
 
+  /* Lock the stream once for the whole transfer */
+
+  lib_take_semaphore(stream);
+
   do
     {
       /* If the object pointed to by *lineptr is of insufficient size, the
@@ -188,6 +192,7 @@ ssize_t getdelim(FAR char **lineptr, size_t *n, int delimiter,
           newbuffer = (FAR char *)lib_realloc(*lineptr, bufsize);
           if (newbuffer == NULL)
             {
+              lib_give_semaphore(stream);
               ret = -ENOMEM;
               goto errout;
             }
@@ -200,9 +205,11 @@ ssize_t getdelim(FAR char **lineptr, size_t *n, int delimiter,
 
       /* Get the next character and test for EOF */
 
-      ch = fgetc(stream);
+      ch = fgetc_unlocked(stream);
       if (ch == EOF)
         {
+          lib_give_semaphore(stream);
+
 #ifdef __KERNEL_
           return -ENODATA;
 #else
@@ -225,6 +232,8 @@ ssize_t getdelim(FAR char **lineptr, size_t *n, int delimiter,
     }
   while (ch != delimiter);
 
+  lib_give_semaphore(stream);
+
   /* Add a NUL terminator character (but don't report this in the number of
    * bytes transferred).
    */
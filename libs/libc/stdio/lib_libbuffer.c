@@ -0,0 +1,72 @@
+/****************************************************************************
+ * libs/libc/stdio/lib_libbuffer.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+
+#include <nuttx/fs/fs.h>
+
+#include "libc.h"
+
+#ifdef CONFIG_STDIO_BUFFER_LAZY
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_allocbuffer
+ *
+ * Description:
+ *   Allocate the I/O buffer of a stream whose allocation was deferred by
+ *   fdopen() until the first use of the stream.  If the allocation fails,
+ *   the stream simply stays unbuffered.
+ *
+ *   The caller must hold the stream semaphore.
+ *
+ ****************************************************************************/
+
+void lib_allocbuffer(FAR FILE *stream)
+{
+  FAR unsigned char *buffer;
+
+  if ((stream->fs_flags & __FS_FLAG_LAZY) == 0)
+    {
+      return;
+    }
+
+  stream->fs_flags &= ~__FS_FLAG_LAZY;
+
+  buffer = (FAR unsigned char *)lib_malloc(CONFIG_STDIO_BUFFER_SIZE);
+  if (buffer != NULL)
+    {
+      stream->fs_bufstart = buffer;
+      stream->fs_bufend   = buffer + CONFIG_STDIO_BUFFER_SIZE;
+      stream->fs_bufpos   = buffer;
+      stream->fs_bufread  = buffer;
+    }
+}
+
+#endif /* CONFIG_STDIO_BUFFER_LAZY */
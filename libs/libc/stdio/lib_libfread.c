@@ -55,10 +55,14 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: lib_fread
+ * Name: lib_fread_unlocked
+ *
+ * Description:
+ *   The core logic of fread().  The caller must hold the stream semaphore.
+ *
  ****************************************************************************/
 
-ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
+ssize_t lib_fread_unlocked(FAR void *ptr, size_t count, FAR FILE *stream)
 {
   FAR unsigned char *dest  = (FAR unsigned char*)ptr;
   ssize_t bytes_read;
@@ -76,10 +80,6 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
     }
   else
     {
-      /* The stream must be stable until we complete the read */
-
-      lib_take_semaphore(stream);
-
 #if CONFIG_NUNGET_CHARS > 0
       /* First, re-read any previously ungotten characters */
 
@@ -100,6 +100,10 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
 #endif
 
 #ifndef CONFIG_STDIO_DISABLE_BUFFERING
+      /* Allocate the I/O buffer if that was deferred until the first use */
+
+      lib_allocbuffer(stream);
+
       /* Is there an I/O buffer? */
 
       if (stream->fs_bufstart != NULL)
@@ -112,7 +116,6 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
           ret = lib_wrflush(stream);
           if (ret < 0)
             {
-              lib_give_semaphore(stream);
               return ret;
             }
 
@@ -122,12 +125,20 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
             {
               /* Is there readable data in the buffer? */
 
-              while (remaining > 0 && stream->fs_bufpos < stream->fs_bufread)
+              size_t gulp_size = stream->fs_bufread - stream->fs_bufpos;
+              if (gulp_size > 0)
                 {
-                  /* Yes, copy a byte into the user buffer */
+                  /* Yes, copy as much as is needed into the user buffer */
 
-                  *dest++ = *stream->fs_bufpos++;
-                  remaining--;
+                  if (gulp_size > remaining)
+                    {
+                      gulp_size = remaining;
+                    }
+
+                  memcpy(dest, stream->fs_bufpos, gulp_size);
+                  stream->fs_bufpos += gulp_size;
+                  dest              += gulp_size;
+                  remaining         -= gulp_size;
                 }
 
               /* The buffer is empty OR we have already supplied the number of
@@ -280,8 +291,6 @@ shortread:
         {
           stream->fs_flags |= __FS_FLAG_EOF;
         }
-
-      lib_give_semaphore(stream);
     }
 
   return count - remaining;
@@ -290,6 +299,28 @@ shortread:
 
 errout_with_errno:
   stream->fs_flags |= __FS_FLAG_ERROR;
-  lib_give_semaphore(stream);
   return -get_errno();
 }
+
+/****************************************************************************
+ * Name: lib_fread
+ ****************************************************************************/
+
+ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
+{
+  ssize_t ret;
+
+  if (stream == NULL)
+    {
+      set_errno(EBADF);
+      return -1;
+    }
+
+  /* The stream must be stable until we complete the read */
+
+  lib_take_semaphore(stream);
+  ret = lib_fread_unlocked(ptr, count, stream);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
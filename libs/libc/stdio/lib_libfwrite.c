@@ -43,6 +43,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <string.h>
 #include <fcntl.h>
 #include <errno.h>
 
@@ -55,16 +56,20 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: lib_fwrite
+ * Name: lib_fwrite_unlocked
+ *
+ * Description:
+ *   The core logic of fwrite().  The caller must hold the stream semaphore.
+ *
  ****************************************************************************/
 
-ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
+ssize_t lib_fwrite_unlocked(FAR const void *ptr, size_t count,
+                            FAR FILE *stream)
 #ifndef CONFIG_STDIO_DISABLE_BUFFERING
 {
   FAR const unsigned char *start = ptr;
   FAR const unsigned char *src   = ptr;
   ssize_t ret = ERROR;
-  unsigned char *dest;
 
   /* Make sure that writing to this stream is allowed */
 
@@ -82,6 +87,10 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
       goto errout;
     }
 
+  /* Allocate the I/O buffer if that was deferred until the first use */
+
+  lib_allocbuffer(stream);
+
   /* If there is no I/O buffer, then output data immediately */
 
   if (stream->fs_bufstart == NULL)
@@ -98,10 +107,6 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
      goto errout;
    }
 
-  /* Get exclusive access to the stream */
-
-  lib_take_semaphore(stream);
-
   /* If the buffer is currently being used for read access, then
    * discard all of the read-ahead data.  We do not support concurrent
    * buffered read/write access.
@@ -109,16 +114,37 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
 
   if (lib_rdflush(stream) < 0)
     {
-      goto errout_with_semaphore;
+      goto errout;
     }
 
   /* Loop until all of the bytes have been buffered */
 
   while (count > 0)
     {
+      size_t gulp_size;
+
+      /* If the buffer is empty and the data would fill it anyway, then
+       * write the data directly instead of copying it through the buffer.
+       */
+
+      if (stream->fs_bufpos == stream->fs_bufstart &&
+          count >= (size_t)(stream->fs_bufend - stream->fs_bufstart))
+        {
+          ssize_t nwritten = _NX_WRITE(stream->fs_fd, src, count);
+          if (nwritten < 0)
+            {
+              _NX_SETERRNO(nwritten);
+              goto errout;
+            }
+
+          src   += nwritten;
+          count -= nwritten;
+          continue;
+        }
+
       /* Determine the number of bytes left in the buffer */
 
-      size_t gulp_size = stream->fs_bufend - stream->fs_bufpos;
+      gulp_size = stream->fs_bufend - stream->fs_bufpos;
 
       /* Will the user data fit into the amount of buffer space
        * that we have left?
@@ -139,23 +165,20 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
 
       /* Transfer the data into the buffer */
 
-      for (dest = stream->fs_bufpos; gulp_size > 0; gulp_size--)
-        {
-          *dest++ = *src++;
-        }
-
-      stream->fs_bufpos = dest;
+      memcpy(stream->fs_bufpos, src, gulp_size);
+      stream->fs_bufpos += gulp_size;
+      src               += gulp_size;
 
       /* Is the buffer full? */
 
-      if (dest >= stream->fs_bufend)
+      if (stream->fs_bufpos >= stream->fs_bufend)
         {
           /* Flush the buffered data to the IO stream */
 
           int bytes_buffered = lib_fflush(stream, false);
           if (bytes_buffered < 0)
             {
-              goto errout_with_semaphore;
+              goto errout;
             }
         }
     }
@@ -164,9 +187,6 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
 
   ret = (uintptr_t)src - (uintptr_t)start;
 
-errout_with_semaphore:
-  lib_give_semaphore(stream);
-
 errout:
   if (ret < 0)
     {
@@ -187,3 +207,26 @@ errout:
   return ret;
 }
 #endif /* CONFIG_STDIO_DISABLE_BUFFERING */
+
+/****************************************************************************
+ * Name: lib_fwrite
+ ****************************************************************************/
+
+ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
+{
+  ssize_t ret;
+
+  if (stream == NULL)
+    {
+      set_errno(EBADF);
+      return ERROR;
+    }
+
+  /* Get exclusive access to the stream */
+
+  lib_take_semaphore(stream);
+  ret = lib_fwrite_unlocked(ptr, count, stream);
+  lib_give_semaphore(stream);
+
+  return ret;
+}
@@ -75,6 +75,11 @@
 
 #define putc(c,stream)  (total_len++, (stream)->put(stream, c))
 
+/* Output a run of characters with one call to the stream */
+
+#define stream_puts(s,n,stream) \
+  (total_len += (n), vsprintf_puts(stream, s, n))
+
 /* Order is relevant here and matches order in format string */
 
 #define FL_ZFILL           0x0001
@@ -144,9 +149,35 @@ struct arg
  static const char g_nullstring[] = "(null)";
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: vsprintf_puts
+ *
+ * Description:
+ *   Output len characters, with the puts method of the stream if it has
+ *   one, otherwise character by character.
+ *
+ ****************************************************************************/
+
+static void vsprintf_puts(FAR struct lib_outstream_s *stream,
+                          FAR const void *buf, int len)
+{
+  FAR const char *ptr = buf;
+
+  if (stream->puts != NULL)
+    {
+      stream->puts(stream, buf, len);
+      return;
+    }
+
+  while (len-- > 0)
+    {
+      stream->put(stream, *ptr++);
+    }
+}
+
 static int vsprintf_internal(FAR struct lib_outstream_s *stream,
                              FAR struct arg *arglist, int numargs,
                              FAR const IPTR char *fmt, va_list ap)
@@ -185,6 +216,21 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
     {
       for (; ; )
         {
+#ifndef CONFIG_ARCH_ROMGETC
+          /* Output the literal text up to the next conversion at once */
+
+          pnt = fmt;
+          while (*fmt != '\0' && *fmt != '%')
+            {
+              fmt++;
+            }
+
+          if (fmt != pnt && stream != NULL)
+            {
+              stream_puts(pnt, fmt - pnt, stream);
+            }
+
+#endif
           c = fmt_char(fmt);
           if (c == '\0')
             {
@@ -904,17 +950,8 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
                 }
             }
 
-          while (size)
-            {
-              putc(*pnt++, stream);
-              if (width != 0)
-                {
-                  width -= 1;
-                }
-
-              size -= 1;
-            }
-
+          stream_puts(pnt, (int)size, stream);
+          width = (size < width) ? width - size : 0;
           goto tail;
         }
 
@@ -1207,11 +1244,20 @@ static int vsprintf_internal(FAR struct lib_outstream_s *stream,
           prec--;
         }
 
-      while (c)
+      /* The digits are in reverse order.  Turn them around and output
+       * them at once.
+       */
+
+      for (len = 0; len < c / 2; len++)
         {
-          putc(buf[--c], stream);
+          unsigned char t = buf[len];
+
+          buf[len]         = buf[c - 1 - len];
+          buf[c - 1 - len] = t;
         }
 
+      stream_puts(buf, c, stream);
+
 tail:
 
       /* Tail is possible.  */
@@ -0,0 +1,182 @@
+/****************************************************************************
+ * libs/libc/stdio/lib_lzfinstream.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <assert.h>
+
+#include <lzf.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lzfinstream_read
+ *
+ * Description:
+ *   Read len bytes from the backend.  Returns false at the end of the
+ *   backend stream.
+ *
+ ****************************************************************************/
+
+static bool lzfinstream_read(FAR struct lib_instream_s *backend,
+                             FAR uint8_t *buf, size_t len)
+{
+  int ch;
+
+  while (len-- > 0)
+    {
+      ch = backend->get(backend);
+      if (ch == EOF)
+        {
+          return false;
+        }
+
+      *buf++ = ch;
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: lzfinstream_block
+ *
+ * Description:
+ *   Read the next block from the backend into out_buf.  Returns false at
+ *   the end of the backend stream or if the block is not valid.
+ *
+ ****************************************************************************/
+
+static bool lzfinstream_block(FAR struct lib_lzfinstream_s *zthis)
+{
+  uint8_t header[LZF_MAX_HDR_SIZE];
+  size_t ulen;
+  size_t clen;
+
+  if (!lzfinstream_read(zthis->backend, header, LZF_MIN_HDR_SIZE) ||
+      header[0] != 'Z' || header[1] != 'V')
+    {
+      return false;
+    }
+
+  if (header[2] == LZF_TYPE0_HDR)
+    {
+      /* Uncompressed: read the data straight into out_buf */
+
+      ulen = (size_t)header[3] << 8 | header[4];
+      if (ulen > CONFIG_LIBC_LZF_BLOCKSIZE ||
+          !lzfinstream_read(zthis->backend, zthis->out_buf, ulen))
+        {
+          return false;
+        }
+    }
+  else if (header[2] == LZF_TYPE1_HDR)
+    {
+      if (!lzfinstream_read(zthis->backend, &header[LZF_MIN_HDR_SIZE],
+                            LZF_TYPE1_HDR_SIZE - LZF_MIN_HDR_SIZE))
+        {
+          return false;
+        }
+
+      clen = (size_t)header[3] << 8 | header[4];
+      ulen = (size_t)header[5] << 8 | header[6];
+      if (clen > CONFIG_LIBC_LZF_BLOCKSIZE ||
+          ulen > CONFIG_LIBC_LZF_BLOCKSIZE ||
+          !lzfinstream_read(zthis->backend, zthis->in_buf, clen) ||
+          lzf_decompress(zthis->in_buf, clen, zthis->out_buf, ulen) != ulen)
+        {
+          return false;
+        }
+    }
+  else
+    {
+      return false;
+    }
+
+  zthis->offset = 0;
+  zthis->outlen = ulen;
+  return true;
+}
+
+/****************************************************************************
+ * Name: lzfinstream_getc
+ ****************************************************************************/
+
+static int lzfinstream_getc(FAR struct lib_instream_s *this)
+{
+  FAR struct lib_lzfinstream_s *zthis =
+    (FAR struct lib_lzfinstream_s *)this;
+
+  DEBUGASSERT(this && zthis->backend);
+
+  /* Empty blocks are valid, so keep reading until there is data */
+
+  while (zthis->offset >= zthis->outlen)
+    {
+      if (!lzfinstream_block(zthis))
+        {
+          zthis->offset = 0;
+          zthis->outlen = 0;
+          return EOF;
+        }
+    }
+
+  this->nget++;
+  return zthis->out_buf[zthis->offset++];
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_lzfinstream
+ *
+ * Description:
+ *   Initializes a stream that decompresses the LZF blocks read from
+ *   another input stream.
+ *
+ * Input Parameters:
+ *   instream - User allocated, uninitialized instance of struct
+ *              lib_lzfinstream_s to be initialized.
+ *   backend  - The stream that provides the compressed data.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+void lib_lzfinstream(FAR struct lib_lzfinstream_s *instream,
+                     FAR struct lib_instream_s *backend)
+{
+  instream->public.get  = lzfinstream_getc;
+  instream->public.nget = 0;
+  instream->backend     = backend;
+  instream->offset      = 0;
+  instream->outlen      = 0;
+}
@@ -0,0 +1,193 @@
+/****************************************************************************
+ * libs/libc/stdio/lib_lzfoutstream.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+
+#include <lzf.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lzfoutstream_write
+ ****************************************************************************/
+
+static void lzfoutstream_write(FAR struct lib_outstream_s *backend,
+                               FAR const uint8_t *buf, size_t len)
+{
+  if (backend->puts != NULL)
+    {
+      backend->puts(backend, buf, len);
+    }
+  else
+    {
+      while (len-- > 0)
+        {
+          backend->put(backend, *buf++);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: lzfoutstream_block
+ *
+ * Description:
+ *   Compress the data in in_buf and write it to the backend as one block.
+ *   A block that does not get smaller is written uncompressed.
+ *
+ ****************************************************************************/
+
+static void lzfoutstream_block(FAR struct lib_lzfoutstream_s *zthis)
+{
+  FAR struct lzf_header_s *header;
+  size_t len;
+
+  if (zthis->offset == 0)
+    {
+      return;
+    }
+
+  /* The header is written in front of the data, in the reserved space of
+   * in_buf or out_buf.  The hash table is not cleared: stale entries only
+   * cost a failed comparison.
+   */
+
+  len = lzf_compress(&zthis->in_buf[LZF_TYPE0_HDR_SIZE], zthis->offset,
+                     &zthis->out_buf[LZF_TYPE1_HDR_SIZE],
+                     zthis->offset - 1, zthis->state, &header);
+
+  lzfoutstream_write(zthis->backend, (FAR const uint8_t *)header, len);
+  zthis->offset = 0;
+}
+
+/****************************************************************************
+ * Name: lzfoutstream_puts
+ ****************************************************************************/
+
+static void lzfoutstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const void *buf, int len)
+{
+  FAR struct lib_lzfoutstream_s *zthis =
+    (FAR struct lib_lzfoutstream_s *)this;
+  FAR const uint8_t *ptr = buf;
+  size_t ncopy;
+
+  DEBUGASSERT(this && zthis->backend);
+
+  while (len > 0)
+    {
+      ncopy = CONFIG_LIBC_LZF_BLOCKSIZE - zthis->offset;
+      if (ncopy > (size_t)len)
+        {
+          ncopy = len;
+        }
+
+      memcpy(&zthis->in_buf[LZF_TYPE0_HDR_SIZE + zthis->offset], ptr,
+             ncopy);
+
+      zthis->offset += ncopy;
+      this->nput    += ncopy;
+      ptr           += ncopy;
+      len           -= ncopy;
+
+      if (zthis->offset >= CONFIG_LIBC_LZF_BLOCKSIZE)
+        {
+          lzfoutstream_block(zthis);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: lzfoutstream_putc
+ ****************************************************************************/
+
+static void lzfoutstream_putc(FAR struct lib_outstream_s *this, int ch)
+{
+  FAR struct lib_lzfoutstream_s *zthis =
+    (FAR struct lib_lzfoutstream_s *)this;
+
+  DEBUGASSERT(this && zthis->backend);
+
+  zthis->in_buf[LZF_TYPE0_HDR_SIZE + zthis->offset] = ch;
+  zthis->offset++;
+  this->nput++;
+
+  if (zthis->offset >= CONFIG_LIBC_LZF_BLOCKSIZE)
+    {
+      lzfoutstream_block(zthis);
+    }
+}
+
+/****************************************************************************
+ * Name: lzfoutstream_flush
+ ****************************************************************************/
+
+static int lzfoutstream_flush(FAR struct lib_outstream_s *this)
+{
+  FAR struct lib_lzfoutstream_s *zthis =
+    (FAR struct lib_lzfoutstream_s *)this;
+
+  DEBUGASSERT(this && zthis->backend);
+
+  lzfoutstream_block(zthis);
+  return zthis->backend->flush(zthis->backend);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_lzfoutstream
+ *
+ * Description:
+ *   Initializes a stream that writes LZF compressed blocks to another
+ *   output stream.
+ *
+ * Input Parameters:
+ *   outstream - User allocated, uninitialized instance of struct
+ *               lib_lzfoutstream_s to be initialized.
+ *   backend   - The stream that receives the compressed data.
+ *
+ * Returned Value:
+ *   None (User allocated instance initialized).
+ *
+ ****************************************************************************/
+
+void lib_lzfoutstream(FAR struct lib_lzfoutstream_s *outstream,
+                      FAR struct lib_outstream_s *backend)
+{
+  outstream->public.put   = lzfoutstream_putc;
+  outstream->public.puts  = lzfoutstream_puts;
+  outstream->public.flush = lzfoutstream_flush;
+  outstream->public.nput  = 0;
+  outstream->backend      = backend;
+  outstream->offset       = 0;
+}
@@ -88,6 +88,35 @@ static void rawoutstream_putc(FAR struct lib_outstream_s *this, int ch)
   while (errcode == EINTR);
 }
 
+/****************************************************************************
+ * Name: rawoutstream_puts
+ ****************************************************************************/
+
+static void rawoutstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const void *buf, int len)
+{
+  FAR struct lib_rawoutstream_s *rthis = (FAR struct lib_rawoutstream_s *)this;
+  FAR const char *ptr = buf;
+  int nwritten;
+
+  DEBUGASSERT(this && rthis->fd >= 0);
+
+  while (len > 0)
+    {
+      nwritten = _NX_WRITE(rthis->fd, ptr, len);
+      if (nwritten > 0)
+        {
+          this->nput += nwritten;
+          ptr        += nwritten;
+          len        -= nwritten;
+        }
+      else if (_NX_GETERRNO(nwritten) != EINTR)
+        {
+          return;
+        }
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -112,6 +141,7 @@ static void rawoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 void lib_rawoutstream(FAR struct lib_rawoutstream_s *outstream, int fd)
 {
   outstream->public.put   = rawoutstream_putc;
+  outstream->public.puts  = rawoutstream_puts;
   outstream->public.flush = lib_noflush;
   outstream->public.nput  = 0;
   outstream->fd           = fd;
@@ -58,7 +58,7 @@ static int stdinstream_getc(FAR struct lib_instream_s *this)
 
   /* Get the next character from the incoming stream */
 
-  ret = getc(sthis->stream);
+  ret = getc_unlocked(sthis->stream);
   if (ret != EOF)
     {
       this->nget++;
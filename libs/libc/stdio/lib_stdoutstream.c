@@ -38,6 +38,7 @@
  ****************************************************************************/
 
 #include <fcntl.h>
+#include <string.h>
 #include <assert.h>
 #include <errno.h>
 
@@ -64,7 +65,7 @@ static void stdoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 
   do
     {
-      result = fputc(ch, sthis->stream);
+      result = fputc_unlocked(ch, sthis->stream);
       if (result != EOF)
         {
           this->nput++;
@@ -78,6 +79,43 @@ static void stdoutstream_putc(FAR struct lib_outstream_s *this, int ch)
   while (get_errno() == EINTR);
 }
 
+/****************************************************************************
+ * Name: stdoutstream_puts
+ ****************************************************************************/
+
+static void stdoutstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const void *buf, int len)
+{
+  FAR struct lib_stdoutstream_s *sthis = (FAR struct lib_stdoutstream_s *)this;
+  FAR const char *ptr = buf;
+  ssize_t result;
+
+  DEBUGASSERT(this && sthis->stream);
+
+  while (len > 0)
+    {
+      result = lib_fwrite_unlocked(ptr, len, sthis->stream);
+      if (result > 0)
+        {
+          this->nput += result;
+          ptr        += result;
+          len        -= result;
+        }
+      else if (result == 0 || get_errno() != EINTR)
+        {
+          return;
+        }
+    }
+
+  /* Flush a line buffered stream if a newline was output, like fputc() */
+
+  if ((sthis->stream->fs_flags & __FS_FLAG_LBF) != 0 &&
+      memchr(buf, '\n', ptr - (FAR const char *)buf) != NULL)
+    {
+      lib_fflush(sthis->stream, true);
+    }
+}
+
 /****************************************************************************
  * Name: stdoutstream_flush
  ****************************************************************************/
@@ -118,7 +156,8 @@ void lib_stdoutstream(FAR struct lib_stdoutstream_s *outstream,
 {
   /* Select the put operation */
 
-  outstream->public.put = stdoutstream_putc;
+  outstream->public.put  = stdoutstream_putc;
+  outstream->public.puts = stdoutstream_puts;
 
   /* Select the correct flush operation.  This flush is only called when
    * a newline is encountered in the output stream.  However, we do not
@@ -47,13 +47,52 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
+/* There are no pthreads in the kernel of the protected and kernel builds */
+
+#if defined(CONFIG_LIBC_QSORT_PARALLEL) && defined(__KERNEL__) && \
+    !defined(CONFIG_BUILD_FLAT)
+#  undef CONFIG_LIBC_QSORT_PARALLEL
+#endif
+
+#ifdef CONFIG_LIBC_QSORT_PARALLEL
+#  include <pthread.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define min(a, b)  (a) < (b) ? a : b
+#define min(a, b)  ((a) < (b) ? (a) : (b))
+
+/* Partitions smaller than this are sorted by insertion sort */
+
+#define QSORT_INSERTION      12
+
+/* The pivot is the median of three above this size and Tukey's ninther
+ * above QSORT_NINTHER.
+ */
+
+#define QSORT_MEDIAN3        7
+#define QSORT_NINTHER        40
+
+/* The number of element moves the optimistic insertion sort of an already
+ * partitioned array may make before it gives up.
+ */
+
+#define QSORT_PARTIAL_LIMIT  8
+
+/* The swap is done a long, an int or a char at a time, depending on the
+ * alignment of the array and the size of the elements.
+ */
+
+#define SWAP_LONG            0  /* Elements are exactly one long */
+#define SWAP_LONGS           1  /* Elements are a multiple of longs */
+#define SWAP_INTS            2  /* Elements are a multiple of ints */
+#define SWAP_CHARS           3  /* Anything else */
 
 #define swapcode(TYPE, parmi, parmj, n) \
   { \
@@ -67,12 +106,8 @@
     } while (--i > 0); \
   }
 
-#define SWAPINIT(a, width) \
-  swaptype = ((FAR char *)a - (FAR char *)0) % sizeof(long) || \
-  width % sizeof(long) ? 2 : width == sizeof(long)? 0 : 1;
-
 #define swap(a, b) \
-  if (swaptype == 0) \
+  if (ctx->swaptype == SWAP_LONG) \
     { \
       long t = *(long *)(a); \
       *(long *)(a) = *(long *)(b); \
@@ -80,30 +115,69 @@
     } \
   else \
     { \
-      swapfunc(a, b, width, swaptype); \
+      swapfunc(a, b, ctx->width, ctx->swaptype); \
     }
 
-#define vecswap(a, b, n) if ((n) > 0) swapfunc(a, b, n, swaptype)
+#define vecswap(a, b, n) if ((n) > 0) swapfunc(a, b, n, ctx->swaptype)
+
+#define compar(a, b) ctx->compar(a, b)
+
+#ifndef CONFIG_LIBC_QSORT_PARALLEL_MIN
+#  define CONFIG_LIBC_QSORT_PARALLEL_MIN 4096
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The parameters of one sort that do not change during the sort */
+
+struct qsort_ctx_s
+{
+  size_t width;
+  CODE int (*compar)(FAR const void *, FAR const void *);
+  int swaptype;
+};
+
+#ifdef CONFIG_LIBC_QSORT_PARALLEL
+/* A part of the array that is sorted by another thread */
+
+struct qsort_job_s
+{
+  FAR char *base;
+  size_t nel;
+  FAR const struct qsort_ctx_s *ctx;
+  int depth;
+  int nthreads;
+};
+#endif
 
 /****************************************************************************
  * Private Function Prototypes
  ****************************************************************************/
 
-static inline void swapfunc(FAR char *a, FAR char *b, int n, int swaptype);
+static inline void swapfunc(FAR char *a, FAR char *b, size_t n,
+                            int swaptype);
 static inline FAR char *med3(FAR char *a, FAR char *b, FAR char *c,
-                             CODE int (*compar)(FAR const void *,
-                             FAR const void *));
+                             FAR const struct qsort_ctx_s *ctx);
+static void qsort_intro(FAR char *base, size_t nel,
+                        FAR const struct qsort_ctx_s *ctx, int depth);
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
-static inline void swapfunc(FAR char *a, FAR char *b, int n, int swaptype)
+static inline void swapfunc(FAR char *a, FAR char *b, size_t n,
+                            int swaptype)
 {
-  if (swaptype <= 1)
+  if (swaptype <= SWAP_LONGS)
     {
       swapcode(long, a, b, n)
     }
+  else if (swaptype == SWAP_INTS)
+    {
+      swapcode(int, a, b, n)
+    }
   else
     {
       swapcode(char, a, b, n)
@@ -111,8 +185,7 @@ static inline void swapfunc(FAR char *a, FAR char *b, int n, int swaptype)
 }
 
 static inline FAR char *med3(FAR char *a, FAR char *b, FAR char *c,
-                             CODE int (*compar)(FAR const void *,
-                             FAR const void *))
+                             FAR const struct qsort_ctx_s *ctx)
 {
   return compar(a, b) < 0 ?
          (compar(b, c) < 0 ? b : (compar(a, c) < 0 ? c : a)) :
@@ -120,51 +193,192 @@ static inline FAR char *med3(FAR char *a, FAR char *b, FAR char *c,
 }
 
 /****************************************************************************
- * Public Function
+ * Name: qsort_init
+ *
+ * Description:
+ *   Set up the sort parameters and select the widest swap that the
+ *   alignment of the array and the element size allow.
+ *
  ****************************************************************************/
 
+static void qsort_init(FAR struct qsort_ctx_s *ctx, FAR void *base,
+                       size_t width,
+                       CODE int (*compar)(FAR const void *,
+                                          FAR const void *))
+{
+  uintptr_t align = (uintptr_t)base | width;
+
+  ctx->width  = width;
+  ctx->compar = compar;
+
+  if (align % sizeof(long) == 0)
+    {
+      ctx->swaptype = width == sizeof(long) ? SWAP_LONG : SWAP_LONGS;
+    }
+  else if (align % sizeof(int) == 0)
+    {
+      ctx->swaptype = SWAP_INTS;
+    }
+  else
+    {
+      ctx->swaptype = SWAP_CHARS;
+    }
+}
+
 /****************************************************************************
- * Name: qsort
+ * Name: qsort_depth
  *
  * Description:
- *   The qsort() function will sort an array of 'nel' objects, the initial
- *   element of which is pointed to by 'base'. The size of each object, in
- *   bytes, is specified by the 'width" argument. If the 'nel' argument has
- *   the value zero, the comparison function pointed to by 'compar' will not
- *   be called and no rearrangement will take place.
+ *   Return the number of partitioning levels after which the sort falls
+ *   back to heap sort: 2 * log2(nel).
  *
- *   The application will ensure that the comparison function pointed to by
- *   'compar' does not alter the contents of the array. The implementation
- *   may reorder elements of the array between calls to the comparison
- *   function, but will not alter the contents of any individual element.
+ ****************************************************************************/
+
+static int qsort_depth(size_t nel)
+{
+  int depth = 0;
+
+  while (nel > 1)
+    {
+      nel >>= 1;
+      depth += 2;
+    }
+
+  return depth;
+}
+
+/****************************************************************************
+ * Name: qsort_insertion
  *
- *   When the same objects (consisting of 'width" bytes, irrespective of
- *   their current positions in the array) are passed more than once to
- *   the comparison function, the results will be consistent with one
- *   another. That is, they will define a total ordering on the array.
+ * Description:
+ *   Sort a small array by insertion sort.  If 'limit' is non-zero, give up
+ *   and return false once more than 'limit' element moves were needed.
+ *   The array is a valid permutation of the input in either case.
  *
- *   The contents of the array will be sorted in ascending order according
- *   to a comparison function. The 'compar' argument is a pointer to the
- *   comparison function, which is called with two arguments that point to
- *   the elements being compared. The application will ensure that the
- *   function returns an integer less than, equal to, or greater than 0,
- *   if the first argument is considered respectively less than, equal to,
- *   or greater than the second. If two members compare as equal, their
- *   order in the sorted array is unspecified.
+ ****************************************************************************/
+
+static bool qsort_insertion(FAR char *base, size_t nel,
+                            FAR const struct qsort_ctx_s *ctx,
+                            size_t limit)
+{
+  size_t width = ctx->width;
+  size_t moves = 0;
+  FAR char *pm;
+  FAR char *pl;
+
+  for (pm = base + width; pm < base + nel * width; pm += width)
+    {
+      for (pl = pm; pl > base && compar(pl - width, pl) > 0; pl -= width)
+        {
+          swap(pl, pl - width);
+          moves++;
+        }
+
+      if (limit > 0 && moves > limit)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: qsort_heap
  *
- *   (Based on description from OpenGroup.org).
+ * Description:
+ *   Sort an array by heap sort.  Used when the partitioning degenerates,
+ *   which keeps the worst case at O(n log n).
  *
- * Returned Value:
- *   The qsort() function will not return a value.
+ ****************************************************************************/
+
+static void qsort_siftdown(FAR char *base, size_t root, size_t nel,
+                           FAR const struct qsort_ctx_s *ctx)
+{
+  size_t width = ctx->width;
+  size_t child;
+
+  while ((child = 2 * root + 1) < nel)
+    {
+      if (child + 1 < nel &&
+          compar(base + child * width, base + (child + 1) * width) < 0)
+        {
+          child++;
+        }
+
+      if (compar(base + root * width, base + child * width) >= 0)
+        {
+          break;
+        }
+
+      swap(base + root * width, base + child * width);
+      root = child;
+    }
+}
+
+static void qsort_heap(FAR char *base, size_t nel,
+                       FAR const struct qsort_ctx_s *ctx)
+{
+  size_t i;
+
+  for (i = nel / 2; i-- > 0; )
+    {
+      qsort_siftdown(base, i, nel, ctx);
+    }
+
+  for (i = nel - 1; i > 0; i--)
+    {
+      swap(base, base + i * ctx->width);
+      qsort_siftdown(base, 0, i, ctx);
+    }
+}
+
+/****************************************************************************
+ * Name: qsort_scramble
  *
- * Notes from the original BSD version:
- *   Qsort routine from Bentley & McIlroy's "Engineering a Sort Function".
+ * Description:
+ *   Swap a few elements of a part that came out of a badly unbalanced
+ *   partition.  This breaks up the patterns that made the pivot choice
+ *   fail, so that the next pivot is likely to be better.
  *
  ****************************************************************************/
 
-void qsort(FAR void *base, size_t nel, size_t width,
-           CODE int(*compar)(FAR const void *, FAR const void *))
+static void qsort_scramble(FAR char *base, size_t nel,
+                           FAR const struct qsort_ctx_s *ctx)
+{
+  size_t width = ctx->width;
+  size_t q = nel / 4;
+
+  if (nel >= QSORT_INSERTION)
+    {
+      swap(base, base + q * width);
+      swap(base + (nel - 1) * width, base + (nel - q) * width);
+      swap(base + (nel / 2) * width, base + (nel / 2 + 1) * width);
+    }
+}
+
+/****************************************************************************
+ * Name: qsort_partition
+ *
+ * Description:
+ *   Partition an array into the elements less than, equal to and greater
+ *   than a pivot with the split-end partitioning of Bentley and McIlroy.
+ *   The elements equal to the pivot end up in the middle and need no more
+ *   sorting.
+ *
+ * Returned Value:
+ *   True if no elements had to be exchanged, meaning that the array was
+ *   likely already sorted.  '*nleft' receives the number of elements at
+ *   the start, '*nright' the number of elements at the end of the array
+ *   that remain to be sorted.
+ *
+ ****************************************************************************/
+
+static bool qsort_partition(FAR char *base, size_t nel,
+                            FAR const struct qsort_ctx_s *ctx,
+                            FAR size_t *nleft, FAR size_t *nright)
 {
+  size_t width = ctx->width;
   FAR char *pa;
   FAR char *pb;
   FAR char *pc;
@@ -172,59 +386,38 @@ void qsort(FAR void *base, size_t nel, size_t width,
   FAR char *pl;
   FAR char *pm;
   FAR char *pn;
-  int swaptype;
-  int swap_cnt;
-  int d;
-  int r;
-
-loop:
-  SWAPINIT(base, width);
-  swap_cnt = 0;
+  bool swapped = false;
+  size_t d;
+  size_t r;
+  int cmp;
 
-  if (nel < 7)
-    {
-      for (pm = (FAR char *)base + width;
-           pm < (FAR char *)base + nel * width;
-           pm += width)
-        {
-          for (pl = pm;
-               pl > (FAR char *)base && compar(pl - width, pl) > 0;
-               pl -= width)
-            {
-              swap(pl, pl - width);
-            }
-        }
-
-      return;
-  }
-
-  pm = (FAR char *)base + (nel / 2) * width;
-  if (nel > 7)
+  pm = base + (nel / 2) * width;
+  if (nel > QSORT_MEDIAN3)
     {
       pl = base;
-      pn = (FAR char *)base + (nel - 1) * width;
-      if (nel > 40)
+      pn = base + (nel - 1) * width;
+      if (nel > QSORT_NINTHER)
         {
           d  = (nel / 8) * width;
-          pl = med3(pl, pl + d, pl + 2 * d, compar);
-          pm = med3(pm - d, pm, pm + d, compar);
-          pn = med3(pn - 2 * d, pn - d, pn, compar);
+          pl = med3(pl, pl + d, pl + 2 * d, ctx);
+          pm = med3(pm - d, pm, pm + d, ctx);
+          pn = med3(pn - 2 * d, pn - d, pn, ctx);
         }
 
-      pm = med3(pl, pm, pn, compar);
+      pm = med3(pl, pm, pn, ctx);
     }
 
   swap(base, pm);
-  pa = pb = (FAR char *)base + width;
+  pa = pb = base + width;
 
-  pc = pd = (FAR char *)base + (nel - 1) * width;
+  pc = pd = base + (nel - 1) * width;
   for (; ; )
     {
-      while (pb <= pc && (r = compar(pb, base)) <= 0)
+      while (pb <= pc && (cmp = compar(pb, base)) <= 0)
         {
-          if (r == 0)
+          if (cmp == 0)
             {
-              swap_cnt = 1;
+              swapped = true;
               swap(pa, pb);
               pa += width;
             }
@@ -232,11 +425,11 @@ loop:
           pb += width;
         }
 
-      while (pb <= pc && (r = compar(pc, base)) >= 0)
+      while (pb <= pc && (cmp = compar(pc, base)) >= 0)
         {
-          if (r == 0)
+          if (cmp == 0)
             {
-              swap_cnt = 1;
+              swapped = true;
               swap(pc, pd);
               pd -= width;
             }
@@ -250,48 +443,262 @@ loop:
         }
 
       swap(pb, pc);
-      swap_cnt = 1;
-      pb      += width;
-      pc      -= width;
+      swapped = true;
+      pb     += width;
+      pc     -= width;
     }
 
-  if (swap_cnt == 0)
+  pn = base + nel * width;
+  r  = min((size_t)(pa - base), (size_t)(pb - pa));
+  vecswap(base, pb - r, r);
+
+  r  = min((size_t)(pd - pc), (size_t)(pn - pd) - width);
+  vecswap(pb, pn - r, r);
+
+  *nleft  = (pb - pa) / width;
+  *nright = (pd - pc) / width;
+  return !swapped;
+}
+
+/****************************************************************************
+ * Name: qsort_intro
+ *
+ * Description:
+ *   Sort an array with introsort: quicksort down to small partitions that
+ *   are finished by insertion sort, with a fallback to heap sort once the
+ *   partitioning went more than 'depth' levels deep.  The smaller part is
+ *   sorted by recursion and the larger one by iteration, so the stack
+ *   usage is O(log n).
+ *
+ ****************************************************************************/
+
+static void qsort_intro(FAR char *base, size_t nel,
+                        FAR const struct qsort_ctx_s *ctx, int depth)
+{
+  FAR char *right;
+  size_t nleft;
+  size_t nright;
+  bool sorted;
+
+  while (nel >= QSORT_INSERTION)
     {
-      /* Switch to insertion sort */
+      if (depth-- <= 0)
+        {
+          qsort_heap(base, nel, ctx);
+          return;
+        }
 
-      for (pm = (FAR char *)base + width;
-           pm < (FAR char *)base + nel * width;
-           pm += width)
+      sorted = qsort_partition(base, nel, ctx, &nleft, &nright);
+      right  = base + (nel - nright) * ctx->width;
+
+      /* If nothing had to be exchanged, the input was probably sorted.
+       * Try to finish both parts with an insertion sort that gives up
+       * quickly if that was wrong.
+       */
+
+      if (sorted &&
+          qsort_insertion(base, nleft, ctx, QSORT_PARTIAL_LIMIT) &&
+          qsort_insertion(right, nright, ctx, QSORT_PARTIAL_LIMIT))
         {
-          for (pl = pm;
-               pl > (FAR char *)base && compar(pl - width, pl) > 0;
-               pl -= width)
-            {
-              swap(pl, pl - width);
-            }
+          return;
         }
 
+      /* A very unbalanced partition is usually caused by a pattern in the
+       * input.  Scramble the parts a little to defeat it.
+       */
+
+      if (min(nleft, nright) < nel / 8)
+        {
+          qsort_scramble(base, nleft, ctx);
+          qsort_scramble(right, nright, ctx);
+        }
+
+      if (nleft < nright)
+        {
+          qsort_intro(base, nleft, ctx, depth);
+          base = right;
+          nel  = nright;
+        }
+      else
+        {
+          qsort_intro(right, nright, ctx, depth);
+          nel  = nleft;
+        }
+    }
+
+  qsort_insertion(base, nel, ctx, 0);
+}
+
+#ifdef CONFIG_LIBC_QSORT_PARALLEL
+/****************************************************************************
+ * Name: qsort_split
+ *
+ * Description:
+ *   Partition an array and sort the two parts in parallel, 'nthreads'
+ *   threads in total.
+ *
+ ****************************************************************************/
+
+static FAR void *qsort_thread(FAR void *arg);
+
+static void qsort_split(FAR char *base, size_t nel,
+                        FAR const struct qsort_ctx_s *ctx, int depth,
+                        int nthreads)
+{
+  struct qsort_job_s job;
+  pthread_t thread;
+  bool threaded;
+  size_t nleft;
+  size_t nright;
+
+  if (nthreads < 2 || nel < CONFIG_LIBC_QSORT_PARALLEL_MIN || depth <= 0)
+    {
+      qsort_intro(base, nel, ctx, depth);
       return;
     }
 
-  pn = (FAR char *)base + nel * width;
-  r  = min(pa - (FAR char *)base, pb - pa);
-  vecswap(base, pb - r, r);
+  qsort_partition(base, nel, ctx, &nleft, &nright);
 
-  r  = min(pd - pc, pn - pd - width);
-  vecswap(pb, pn - r, r);
+  /* Sort the left part in a new thread and the right part in this one */
+
+  job.base     = base;
+  job.nel      = nleft;
+  job.ctx      = ctx;
+  job.depth    = depth - 1;
+  job.nthreads = nthreads / 2;
+
+  threaded = pthread_create(&thread, NULL, qsort_thread, &job) == 0;
+  if (!threaded)
+    {
+      /* No thread available.  Do it here. */
+
+      qsort_thread(&job);
+    }
+
+  qsort_split(base + (nel - nright) * ctx->width, nright, ctx, depth - 1,
+              nthreads - nthreads / 2);
+
+  if (threaded)
+    {
+      pthread_join(thread, NULL);
+    }
+}
+
+static FAR void *qsort_thread(FAR void *arg)
+{
+  FAR struct qsort_job_s *job = (FAR struct qsort_job_s *)arg;
+
+  qsort_split(job->base, job->nel, job->ctx, job->depth, job->nthreads);
+  return NULL;
+}
+#endif
 
-  if ((r = pb - pa) > width)
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: qsort
+ *
+ * Description:
+ *   The qsort() function will sort an array of 'nel' objects, the initial
+ *   element of which is pointed to by 'base'. The size of each object, in
+ *   bytes, is specified by the 'width" argument. If the 'nel' argument has
+ *   the value zero, the comparison function pointed to by 'compar' will not
+ *   be called and no rearrangement will take place.
+ *
+ *   The application will ensure that the comparison function pointed to by
+ *   'compar' does not alter the contents of the array. The implementation
+ *   may reorder elements of the array between calls to the comparison
+ *   function, but will not alter the contents of any individual element.
+ *
+ *   When the same objects (consisting of 'width" bytes, irrespective of
+ *   their current positions in the array) are passed more than once to
+ *   the comparison function, the results will be consistent with one
+ *   another. That is, they will define a total ordering on the array.
+ *
+ *   The contents of the array will be sorted in ascending order according
+ *   to a comparison function. The 'compar' argument is a pointer to the
+ *   comparison function, which is called with two arguments that point to
+ *   the elements being compared. The application will ensure that the
+ *   function returns an integer less than, equal to, or greater than 0,
+ *   if the first argument is considered respectively less than, equal to,
+ *   or greater than the second. If two members compare as equal, their
+ *   order in the sorted array is unspecified.
+ *
+ *   (Based on description from OpenGroup.org).
+ *
+ * Returned Value:
+ *   The qsort() function will not return a value.
+ *
+ * Notes:
+ *   The partitioning is from Bentley & McIlroy's "Engineering a Sort
+ *   Function", as in the original BSD version.  It is wrapped in an
+ *   introsort that falls back to heap sort, so the worst case is
+ *   O(n log n).
+ *
+ ****************************************************************************/
+
+void qsort(FAR void *base, size_t nel, size_t width,
+           CODE int(*compar)(FAR const void *, FAR const void *))
+{
+  struct qsort_ctx_s ctx;
+
+  if (nel < 2 || width == 0)
     {
-      qsort(base, r / width, width, compar);
+      return;
     }
 
-  if ((r = pd - pc) > width)
+  qsort_init(&ctx, base, width, compar);
+  qsort_intro(base, nel, &ctx, qsort_depth(nel));
+}
+
+#ifdef CONFIG_LIBC_QSORT_PARALLEL
+/****************************************************************************
+ * Name: qsort_parallel
+ *
+ * Description:
+ *   Like qsort(), but sort large arrays with up to 'nthreads' threads.
+ *   The array is partitioned and the parts are sorted by separate
+ *   threads until the parts are smaller than
+ *   CONFIG_LIBC_QSORT_PARALLEL_MIN elements.  The comparison function
+ *   must be safe to call from several threads at the same time.
+ *
+ * Input Parameters:
+ *   base     - The array to sort
+ *   nel      - The number of elements in the array
+ *   width    - The size of one element in bytes
+ *   compar   - The comparison function, as for qsort()
+ *   nthreads - The maximum number of threads, including the caller.  Zero
+ *              or less selects one thread per CPU.
+ *
+ * Returned Value:
+ *   None.  If no more threads can be created the remaining work is done
+ *   by the calling thread.
+ *
+ ****************************************************************************/
+
+void qsort_parallel(FAR void *base, size_t nel, size_t width,
+                    CODE int (*compar)(FAR const void *, FAR const void *),
+                    int nthreads)
+{
+  struct qsort_ctx_s ctx;
+
+  if (nel < 2 || width == 0)
     {
-      /* Iterate rather than recurse to save stack space */
+      return;
+    }
 
-      base = pn - r;
-      nel = r / width;
-      goto loop;
+  if (nthreads <= 0)
+    {
+#ifdef CONFIG_SMP
+      nthreads = CONFIG_SMP_NCPUS;
+#else
+      nthreads = 1;
+#endif
     }
+
+  qsort_init(&ctx, base, width, compar);
+  qsort_split(base, nel, &ctx, qsort_depth(nel), nthreads);
 }
+#endif
@@ -41,6 +41,8 @@
 
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -65,6 +67,29 @@ FAR void *memchr(FAR const void *s, int c, size_t n)
 
   if (s)
     {
+#ifdef CONFIG_STRING_OPTSPEED
+      if (n >= 2 * LIB_WSIZE)
+        {
+          FAR const uintptr_t *w;
+          uintptr_t mask = LIB_SPLAT(c);
+
+          for (; !LIB_ALIGNED(p); p++, n--)
+            {
+              if (*p == (unsigned char)c)
+                {
+                  return (FAR void *)p;
+                }
+            }
+
+          /* Skip the words without 'c' */
+
+          for (w = (FAR const uintptr_t *)p;
+               n >= LIB_WSIZE && !LIB_HASZERO(*w ^ mask);
+               w++, n -= LIB_WSIZE);
+          p = (FAR const unsigned char *)w;
+        }
+#endif
+
       while (n--)
         {
           if (*p == (unsigned char)c)
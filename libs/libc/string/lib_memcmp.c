@@ -39,8 +39,16 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WSIZE  sizeof(uintptr_t)
+#define WMASK  (WSIZE - 1)
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -51,6 +59,35 @@ int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
   unsigned char *p1 = (unsigned char *)s1;
   unsigned char *p2 = (unsigned char *)s2;
 
+#ifdef CONFIG_MEMCMP_OPTSPEED
+  /* Skip over the equal words if both can be aligned.  The byte loop
+   * below then finds the first difference inside the word.
+   */
+
+  if (n >= 2 * WSIZE && (((uintptr_t)p1 ^ (uintptr_t)p2) & WMASK) == 0)
+    {
+      while (((uintptr_t)p1 & WMASK) != 0)
+        {
+          if (*p1 != *p2)
+            {
+              return *p1 < *p2 ? -1 : 1;
+            }
+
+          p1++;
+          p2++;
+          n--;
+        }
+
+      while (n >= WSIZE &&
+             *(FAR const uintptr_t *)p1 == *(FAR const uintptr_t *)p2)
+        {
+          p1 += WSIZE;
+          p2 += WSIZE;
+          n  -= WSIZE;
+        }
+    }
+#endif
+
   while (n-- > 0)
     {
       if (*p1 < *p2)
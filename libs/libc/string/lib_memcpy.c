@@ -39,8 +39,25 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WSIZE  sizeof(uintptr_t)
+#define WMASK  (WSIZE - 1)
+#define WBITS  (8 * WSIZE)
+
+/* Combine the tail of one aligned source word with the head of the next */
+
+#ifdef CONFIG_ENDIAN_BIG
+#  define MERGE(w0, w1, ls, rs) (((w0) << (ls)) | ((w1) >> (rs)))
+#else
+#  define MERGE(w0, w1, ls, rs) (((w0) >> (ls)) | ((w1) << (rs)))
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -54,6 +71,88 @@ FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
   FAR unsigned char *pout = (FAR unsigned char *)dest;
   FAR unsigned char *pin  = (FAR unsigned char *)src;
+
+#ifdef CONFIG_MEMCPY_OPTSPEED
+  /* This version copies a word at a time.  Short copies are not worth
+   * the setup.
+   */
+
+  if (n >= 2 * WSIZE)
+    {
+      FAR uintptr_t *wout;
+      FAR const uintptr_t *win;
+      uintptr_t shift;
+
+      /* Align the destination */
+
+      while (((uintptr_t)pout & WMASK) != 0)
+        {
+          *pout++ = *pin++;
+          n--;
+        }
+
+      wout  = (FAR uintptr_t *)pout;
+      shift = (uintptr_t)pin & WMASK;
+
+      if (shift == 0)
+        {
+          /* Both are aligned: copy four words per iteration */
+
+          win = (FAR const uintptr_t *)pin;
+          while (n >= 4 * WSIZE)
+            {
+              uintptr_t w0 = win[0];
+              uintptr_t w1 = win[1];
+              uintptr_t w2 = win[2];
+              uintptr_t w3 = win[3];
+
+              wout[0] = w0;
+              wout[1] = w1;
+              wout[2] = w2;
+              wout[3] = w3;
+              win    += 4;
+              wout   += 4;
+              n      -= 4 * WSIZE;
+            }
+
+          while (n >= WSIZE)
+            {
+              *wout++ = *win++;
+              n      -= WSIZE;
+            }
+
+          pin = (FAR unsigned char *)win;
+        }
+      else
+        {
+          /* The source is misaligned: read aligned words and shift them
+           * into place.  The reads never leave the aligned words that
+           * hold the bytes being copied.
+           */
+
+          unsigned int ls = 8 * shift;
+          unsigned int rs = WBITS - ls;
+          uintptr_t w0;
+          uintptr_t w1;
+
+          win = (FAR const uintptr_t *)(pin - shift);
+          w0  = *win++;
+
+          while (n >= WSIZE)
+            {
+              w1      = *win++;
+              *wout++ = MERGE(w0, w1, ls, rs);
+              w0      = w1;
+              n      -= WSIZE;
+            }
+
+          pin = (FAR unsigned char *)win - WSIZE + shift;
+        }
+
+      pout = (FAR unsigned char *)wout;
+    }
+#endif
+
   while (n-- > 0) *pout++ = *pin++;
   return dest;
 }
@@ -39,8 +39,16 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WSIZE  sizeof(uintptr_t)
+#define WMASK  (WSIZE - 1)
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -51,11 +59,43 @@ FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
   FAR char *tmp;
   FAR char *s;
 
+#ifdef CONFIG_MEMMOVE_OPTSPEED
+  /* Buffers that do not overlap are left to memcpy() */
+
+  if ((FAR char *)dest + count <= (FAR char *)src ||
+      (FAR char *)src + count <= (FAR char *)dest)
+    {
+      return memcpy(dest, src, count);
+    }
+#endif
+
   if (dest <= src)
     {
       tmp = (FAR char *) dest;
       s   = (FAR char *) src;
 
+#ifdef CONFIG_MEMMOVE_OPTSPEED
+      /* Move a word at a time if both can be aligned */
+
+      if (count >= 2 * WSIZE &&
+          (((uintptr_t)tmp ^ (uintptr_t)s) & WMASK) == 0)
+        {
+          while (((uintptr_t)tmp & WMASK) != 0)
+            {
+              *tmp++ = *s++;
+              count--;
+            }
+
+          while (count >= WSIZE)
+            {
+              *(FAR uintptr_t *)tmp = *(FAR uintptr_t *)s;
+              tmp   += WSIZE;
+              s     += WSIZE;
+              count -= WSIZE;
+            }
+        }
+#endif
+
       while (count--)
         {
           *tmp++ = *s++;
@@ -66,6 +106,26 @@ FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
       tmp = (FAR char *) dest + count;
       s   = (FAR char *) src + count;
 
+#ifdef CONFIG_MEMMOVE_OPTSPEED
+      if (count >= 2 * WSIZE &&
+          (((uintptr_t)tmp ^ (uintptr_t)s) & WMASK) == 0)
+        {
+          while (((uintptr_t)tmp & WMASK) != 0)
+            {
+              *--tmp = *--s;
+              count--;
+            }
+
+          while (count >= WSIZE)
+            {
+              tmp   -= WSIZE;
+              s     -= WSIZE;
+              count -= WSIZE;
+              *(FAR uintptr_t *)tmp = *(FAR uintptr_t *)s;
+            }
+        }
+#endif
+
       while (count--)
         {
           *--tmp = *--s;
@@ -41,6 +41,8 @@
 
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -64,9 +66,33 @@ FAR char *strchr(FAR const char *s, int c)
 {
   if (s)
     {
+#ifdef CONFIG_STRING_OPTSPEED
+      FAR const uintptr_t *w;
+      uintptr_t mask = LIB_SPLAT(c);
+
+      for (; !LIB_ALIGNED(s); s++)
+        {
+          if (*s == (char)c)
+            {
+              return (FAR char *)s;
+            }
+
+          if (!*s)
+            {
+              return NULL;
+            }
+        }
+
+      /* Skip the words without 'c' and without a terminator */
+
+      for (w = (FAR const uintptr_t *)s;
+           !LIB_HASZERO(*w) && !LIB_HASZERO(*w ^ mask); w++);
+      s = (FAR const char *)w;
+#endif
+
       for (; ; s++)
         {
-          if (*s == c)
+          if (*s == (char)c)
             {
               return (FAR char *)s;
             }
@@ -41,6 +41,8 @@
 
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -49,6 +51,32 @@
 int strcmp(FAR const char *cs, FAR const char *ct)
 {
   register signed char result;
+
+#ifdef CONFIG_STRING_OPTSPEED
+  /* Skip equal words without a terminator if both can be aligned */
+
+  if ((((uintptr_t)cs ^ (uintptr_t)ct) & LIB_WMASK) == 0)
+    {
+      FAR const uintptr_t *w1;
+      FAR const uintptr_t *w2;
+
+      for (; !LIB_ALIGNED(cs); cs++, ct++)
+        {
+          if ((result = *cs - *ct) != 0 || !*cs)
+            {
+              return result;
+            }
+        }
+
+      w1 = (FAR const uintptr_t *)cs;
+      w2 = (FAR const uintptr_t *)ct;
+      for (; *w1 == *w2 && !LIB_HASZERO(*w1); w1++, w2++);
+
+      cs = (FAR const char *)w1;
+      ct = (FAR const char *)w2;
+    }
+#endif
+
   for (; ; )
     {
       if ((result = *cs - *ct++) != 0 || !*cs++)
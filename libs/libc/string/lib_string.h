@@ -0,0 +1,58 @@
+/****************************************************************************
+ * libs/libc/string/lib_string.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_STRING_LIB_STRING_H
+#define __LIBS_LIBC_STRING_LIB_STRING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Helpers for scanning strings a word at a time.  An aligned word never
+ * crosses a page or a memory region, so reading the whole word that holds
+ * the terminating byte is safe.
+ */
+
+#define LIB_WSIZE        sizeof(uintptr_t)
+#define LIB_WMASK        (LIB_WSIZE - 1)
+#define LIB_ALIGNED(p)   (((uintptr_t)(p) & LIB_WMASK) == 0)
+
+/* 0x01010101... and 0x80808080... of the word size */
+
+#define LIB_ONES         ((uintptr_t)-1 / 0xff)
+#define LIB_HIGHS        (LIB_ONES * 0x80)
+
+/* A word with 'c' in every byte */
+
+#define LIB_SPLAT(c)     (LIB_ONES * (uint8_t)(c))
+
+/* Non-zero if any byte of the word is zero */
+
+#define LIB_HASZERO(w)   (((w) - LIB_ONES) & ~(w) & LIB_HIGHS)
+
+#endif /* __LIBS_LIBC_STRING_LIB_STRING_H */
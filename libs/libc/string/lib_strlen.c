@@ -41,6 +41,8 @@
 #include <sys/types.h>
 #include <string.h>
 
+#include "lib_string.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -49,7 +51,27 @@
 size_t strlen(const char *s)
 {
   const char *sc;
-  for (sc = s; *sc != '\0'; ++sc);
+
+#ifdef CONFIG_STRING_OPTSPEED
+  FAR const uintptr_t *w;
+
+  for (sc = s; !LIB_ALIGNED(sc); ++sc)
+    {
+      if (*sc == '\0')
+        {
+          return sc - s;
+        }
+    }
+
+  /* Skip the words without a terminator */
+
+  for (w = (FAR const uintptr_t *)sc; !LIB_HASZERO(*w); w++);
+  sc = (FAR const char *)w;
+#else
+  sc = s;
+#endif
+
+  for (; *sc != '\0'; ++sc);
   return sc - s;
 }
 #endif
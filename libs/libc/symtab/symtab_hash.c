@@ -0,0 +1,218 @@
+/****************************************************************************
+ * libs/libc/symtab/symtab_hash.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/symtab.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The hash table is at most half full and holds 16-bit indices */
+
+#define SYMTAB_HASH_MAXSYMS 32768
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: symtab_namehash
+ *
+ * Description:
+ *   Return the FNV-1a hash of a symbol name.
+ *
+ ****************************************************************************/
+
+static uint32_t symtab_namehash(FAR const char *name)
+{
+  uint32_t hash = 2166136261u;
+
+  while (*name != '\0')
+    {
+      hash ^= (uint8_t)*name++;
+      hash *= 16777619u;
+    }
+
+  return hash;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: symtab_hashinit
+ *
+ * Description:
+ *   Build the hash table over the names of a symbol table.  If the hash
+ *   table can not be allocated, the symbol table is still recorded and
+ *   symtab_findbyhash() searches it instead.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if the hash table could not be
+ *   allocated.
+ *
+ ****************************************************************************/
+
+int symtab_hashinit(FAR struct symtab_hash_s *hash,
+                    FAR const struct symtab_s *symtab, int nsyms)
+{
+  uint32_t value;
+  size_t nentries;
+  int i;
+
+  DEBUGASSERT(hash != NULL && (symtab != NULL || nsyms == 0));
+
+  hash->symtab = symtab;
+  hash->nsyms  = nsyms;
+  hash->index  = NULL;
+  hash->mask   = 0;
+
+  if (nsyms <= 0)
+    {
+      return OK;
+    }
+
+  if (nsyms > SYMTAB_HASH_MAXSYMS)
+    {
+      return -ENOMEM;
+    }
+
+  for (nentries = 2; nentries < 2 * (size_t)nsyms; nentries <<= 1)
+    {
+    }
+
+  hash->index = lib_zalloc(nentries * sizeof(uint16_t));
+  if (hash->index == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  hash->mask = nentries - 1;
+
+  /* Insert the symbols in order so that a lookup finds the first of
+   * several symbols with the same name.
+   */
+
+  for (i = 0; i < nsyms; i++)
+    {
+      value = symtab_namehash(symtab[i].sym_name);
+      while (hash->index[value & hash->mask] != 0)
+        {
+          value++;
+        }
+
+      hash->index[value & hash->mask] = i + 1;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: symtab_hashfree
+ *
+ * Description:
+ *   Release the hash table built by symtab_hashinit().
+ *
+ ****************************************************************************/
+
+void symtab_hashfree(FAR struct symtab_hash_s *hash)
+{
+  DEBUGASSERT(hash != NULL);
+
+  if (hash->index != NULL)
+    {
+      lib_free(hash->index);
+    }
+
+  hash->symtab = NULL;
+  hash->nsyms  = 0;
+  hash->index  = NULL;
+  hash->mask   = 0;
+}
+
+/****************************************************************************
+ * Name: symtab_findbyhash
+ *
+ * Description:
+ *   Find the symbol with the matching name in a hashed symbol table.  Of
+ *   several symbols with the same name, the first one in the table is
+ *   found, as with symtab_findbyname().
+ *
+ * Returned Value:
+ *   A reference to the symbol table entry if an entry with the matching
+ *   name is found; NULL is returned if the entry is not found.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+symtab_findbyhash(FAR const struct symtab_hash_s *hash,
+                  FAR const char *name)
+{
+  FAR const struct symtab_s *symbol;
+  uint32_t value;
+  uint16_t entry;
+
+  DEBUGASSERT(hash != NULL && name != NULL);
+
+  if (hash->index == NULL)
+    {
+      /* No hash table.  Search the symbol table. */
+
+      if (hash->nsyms <= 0)
+        {
+          return NULL;
+        }
+
+#ifdef CONFIG_SYMTAB_ORDEREDBYNAME
+      return symtab_findorderedbyname(hash->symtab, name, hash->nsyms);
+#else
+      return symtab_findbyname(hash->symtab, name, hash->nsyms);
+#endif
+    }
+
+  for (value = symtab_namehash(name); ; value++)
+    {
+      entry = hash->index[value & hash->mask];
+      if (entry == 0)
+        {
+          return NULL;
+        }
+
+      symbol = &hash->symtab[entry - 1];
+      if (strcmp(symbol->sym_name, name) == 0)
+        {
+          return symbol;
+        }
+    }
+}
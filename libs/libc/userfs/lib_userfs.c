@@ -529,8 +529,13 @@ static inline int userfs_closedir_dispatch(FAR struct userfs_info_s *info,
 static inline int userfs_readdir_dispatch(FAR struct userfs_info_s *info,
                    FAR struct userfs_readdir_request_s *req, size_t reqlen)
 {
-  struct userfs_readdir_response_s resp;
+  FAR struct userfs_readdir_response_s *resp;
+  FAR void *dir;
+  unsigned int maxent;
+  unsigned int nentries;
+  size_t resplen;
   ssize_t nsent;
+  int ret;
 
   /* Verify the request size */
 
@@ -539,18 +544,53 @@ static inline int userfs_readdir_dispatch(FAR struct userfs_info_s *info,
       return -EINVAL;
     }
 
-  /* Dispatch the request */
+  /* The response is built in the I/O buffer and overwrites the request.
+   * Read as many entries as requested and as fit into the I/O buffer.
+   */
+
+  dir    = req->dir;
+  maxent = req->nentries;
+
+  if (info->iolen < SIZEOF_USERFS_READDIR_RESPONSE_S(1))
+    {
+      return -E2BIG;
+    }
+
+  nentries = (info->iolen - SIZEOF_USERFS_READDIR_RESPONSE_S(1)) /
+             sizeof(struct dirent) + 1;
+  if (maxent > nentries)
+    {
+      maxent = nentries;
+    }
+
+  /* Dispatch the request.  Stop at the first failure, the end of the
+   * directory for example.  The failure is reported only if no entry was
+   * read; otherwise it is reported again by the next request.
+   */
+
+  resp = (FAR struct userfs_readdir_response_s *)info->iobuffer;
 
   DEBUGASSERT(info->userops != NULL && info->userops->readdir != NULL);
-  resp.ret  = info->userops->readdir(info->volinfo, req->dir, &resp.entry);
+  for (nentries = 0, ret = OK; nentries < maxent; nentries++)
+    {
+      ret = info->userops->readdir(info->volinfo, dir,
+                                   &resp->entry[nentries]);
+      if (ret < 0)
+        {
+          break;
+        }
+    }
 
   /* Send the response */
 
-  resp.resp = USERFS_RESP_READDIR;
-  nsent     = sendto(info->sockfd, &resp,
-                     sizeof(struct userfs_readdir_response_s),
-                     0, (FAR struct sockaddr *)&info->client,
-                     sizeof(struct sockaddr_in));
+  resp->resp     = USERFS_RESP_READDIR;
+  resp->nentries = nentries;
+  resp->ret      = nentries > 0 ? OK : ret;
+  resplen        = SIZEOF_USERFS_READDIR_RESPONSE_S(nentries > 0 ?
+                                                    nentries : 1);
+  nsent          = sendto(info->sockfd, resp, resplen, 0,
+                          (FAR struct sockaddr *)&info->client,
+                          sizeof(struct sockaddr_in));
   return nsent < 0 ? nsent : OK;
 }
 
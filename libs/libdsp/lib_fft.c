@@ -0,0 +1,302 @@
+/****************************************************************************
+ * libs/libdsp/lib_fft.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <errno.h>
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fft_bitrev
+ *
+ * Description:
+ *   Bit reversal permutation of m complex values.
+ *
+ ****************************************************************************/
+
+static void fft_bitrev(FAR float *z, size_t m)
+{
+  size_t i;
+  size_t j = 0;
+  size_t bit;
+  float t;
+
+  for (i = 1; i < m; i++)
+    {
+      for (bit = m >> 1; j & bit; bit >>= 1)
+        {
+          j ^= bit;
+        }
+
+      j |= bit;
+
+      if (i < j)
+        {
+          t = z[2 * i];
+          z[2 * i] = z[2 * j];
+          z[2 * j] = t;
+
+          t = z[2 * i + 1];
+          z[2 * i + 1] = z[2 * j + 1];
+          z[2 * j + 1] = t;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: fft_complex
+ *
+ * Description:
+ *   In place complex FFT of m = n/2 values.  The twiddle factors of the
+ *   n point FFT are used, W_m^k = W_n^(2k).
+ *
+ *   After the bit reversal, the radix-2 stages are done in pairs: the two
+ *   stages of a 4-point group are merged into one radix-4 butterfly, which
+ *   needs 3 instead of 4 complex multiplications and loads and stores each
+ *   value once for both stages.
+ *
+ ****************************************************************************/
+
+static void fft_complex(FAR struct fft_s *fft, FAR float *z)
+{
+  FAR const float *w = fft->twiddle;
+  size_t m = fft->n / 2;
+  size_t h;
+  size_t j;
+  size_t k;
+
+  fft_bitrev(z, m);
+
+  h = 1;
+  if ((m & 0x55555555) == 0)
+    {
+      /* Odd number of stages: start with a radix-2 stage, its twiddle
+       * factors are all 1.
+       */
+
+      for (j = 0; j < m; j += 2)
+        {
+          float ar = z[2 * j];
+          float ai = z[2 * j + 1];
+          float br = z[2 * j + 2];
+          float bi = z[2 * j + 3];
+
+          z[2 * j]     = ar + br;
+          z[2 * j + 1] = ai + bi;
+          z[2 * j + 2] = ar - br;
+          z[2 * j + 3] = ai - bi;
+        }
+
+      h = 2;
+    }
+
+  for (; h < m; h *= 4)
+    {
+      size_t s1 = fft->n / (2 * h);   /* Twiddle step of stage h */
+      size_t s2 = s1 / 2;             /* Twiddle step of stage 2h */
+
+      for (j = 0; j < m; j += 4 * h)
+        {
+          for (k = 0; k < h; k++)
+            {
+              FAR float *p0 = &z[2 * (j + k)];
+              FAR float *p1 = p0 + 2 * h;
+              FAR float *p2 = p1 + 2 * h;
+              FAR float *p3 = p2 + 2 * h;
+              float w1r = w[2 * k * s1];
+              float w1i = w[2 * k * s1 + 1];
+              float w2r = w[2 * k * s2];
+              float w2i = w[2 * k * s2 + 1];
+              float tr;
+              float ti;
+              float ar;
+              float ai;
+              float br;
+              float bi;
+              float cr;
+              float ci;
+              float dr;
+              float di;
+
+              /* First stage: (p0, p1) and (p2, p3) with W_2h^k */
+
+              tr = w1r * p1[0] - w1i * p1[1];
+              ti = w1r * p1[1] + w1i * p1[0];
+              ar = p0[0] + tr;
+              ai = p0[1] + ti;
+              br = p0[0] - tr;
+              bi = p0[1] - ti;
+
+              tr = w1r * p3[0] - w1i * p3[1];
+              ti = w1r * p3[1] + w1i * p3[0];
+              cr = p2[0] + tr;
+              ci = p2[1] + ti;
+              dr = p2[0] - tr;
+              di = p2[1] - ti;
+
+              /* Second stage: (a, c) with W_4h^k and (b, d) with
+               * W_4h^(k+h) = -i * W_4h^k
+               */
+
+              tr = w2r * cr - w2i * ci;
+              ti = w2r * ci + w2i * cr;
+              p0[0] = ar + tr;
+              p0[1] = ai + ti;
+              p2[0] = ar - tr;
+              p2[1] = ai - ti;
+
+              tr = w2r * di + w2i * dr;
+              ti = w2i * di - w2r * dr;
+              p1[0] = br + tr;
+              p1[1] = bi + ti;
+              p3[0] = br - tr;
+              p3[1] = bi - ti;
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fft_init
+ *
+ * Description:
+ *   Initialize a real FFT.
+ *
+ * Input Parameters:
+ *   fft     - (out) pointer to the FFT data
+ *   twiddle - (in) buffer for n floats
+ *   n       - (in) number of points, a power of 2 and at least 4
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if n is not valid.
+ *
+ ****************************************************************************/
+
+int fft_init(FAR struct fft_s *fft, FAR float *twiddle, size_t n)
+{
+  size_t k;
+
+  DEBUGASSERT(fft != NULL);
+  DEBUGASSERT(twiddle != NULL);
+
+  if (n < 4 || (n & (n - 1)) != 0)
+    {
+      return -EINVAL;
+    }
+
+  for (k = 0; k < n / 2; k++)
+    {
+      float angle = -2.0f * M_PI_F * k / n;
+
+      twiddle[2 * k]     = cosf(angle);
+      twiddle[2 * k + 1] = sinf(angle);
+    }
+
+  fft->twiddle = twiddle;
+  fft->n       = n;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fft_real
+ *
+ * Description:
+ *   In place FFT of n real samples.  The n samples are transformed as n/2
+ *   complex values with a complex FFT, and the spectrum of the real
+ *   signal is then separated from it.
+ *
+ *   The first n/2 + 1 bins of the spectrum are returned (the others are
+ *   their complex conjugates) in the order
+ *
+ *     Re(X[0]), Re(X[n/2]), Re(X[1]), Im(X[1]), ...,
+ *     Re(X[n/2 - 1]), Im(X[n/2 - 1])
+ *
+ *   X[0] and X[n/2] are real.  The result is not scaled.
+ *
+ * Input Parameters:
+ *   fft - (in) pointer to the FFT data
+ *   buf - (in/out) n samples in, the spectrum out
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fft_real(FAR struct fft_s *fft, FAR float *buf)
+{
+  FAR const float *w = fft->twiddle;
+  size_t m = fft->n / 2;
+  size_t k;
+  float r0;
+  float i0;
+
+  DEBUGASSERT(fft != NULL);
+  DEBUGASSERT(buf != NULL);
+
+  fft_complex(fft, buf);
+
+  /* The FFTs of the even and the odd samples are
+   *
+   *   E[k] = (Z[k] + conj(Z[m - k])) / 2
+   *   O[k] = (Z[k] - conj(Z[m - k])) / 2i
+   *
+   * Bins k and m - k are computed together from Z[k] and Z[m - k].
+   */
+
+  r0 = buf[0];
+  i0 = buf[1];
+  buf[0] = r0 + i0;
+  buf[1] = r0 - i0;
+
+  for (k = 1; k <= m / 2; k++)
+    {
+      FAR float *p = &buf[2 * k];
+      FAR float *q = &buf[2 * (m - k)];
+      float wr = w[2 * k];
+      float wi = w[2 * k + 1];
+      float evr = 0.5f * (p[0] + q[0]);   /* Even samples E[k] */
+      float evi = 0.5f * (p[1] - q[1]);
+      float odr = 0.5f * (p[1] + q[1]);   /* Odd samples O[k] */
+      float odi = 0.5f * (q[0] - p[0]);
+      float tr  = wr * odr - wi * odi;
+      float ti  = wr * odi + wi * odr;
+
+      /* X[k] = E[k] + W_n^k * O[k] */
+
+      p[0] = evr + tr;
+      p[1] = evi + ti;
+
+      /* X[m - k] = conj(E[k]) - conj(W_n^k * O[k]) */
+
+      q[0] = evr - tr;
+      q[1] = ti - evi;
+    }
+}
@@ -0,0 +1,297 @@
+/****************************************************************************
+ * libs/libdsp/lib_fft_b16.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <errno.h>
+#include <math.h>
+
+#include <dspb16.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cmul_re / cmul_im
+ *
+ * Description:
+ *   Real and imaginary part of the product of two complex b16_t values,
+ *   rounded once.
+ *
+ ****************************************************************************/
+
+static inline b16_t cmul_re(b16_t ar, b16_t ai, b16_t br, b16_t bi)
+{
+  return b32tob16((b32_t)ar * br - (b32_t)ai * bi);
+}
+
+static inline b16_t cmul_im(b16_t ar, b16_t ai, b16_t br, b16_t bi)
+{
+  return b32tob16((b32_t)ar * bi + (b32_t)ai * br);
+}
+
+/****************************************************************************
+ * Name: fft_bitrev_b16
+ *
+ * Description:
+ *   Bit reversal permutation of m complex values.
+ *
+ ****************************************************************************/
+
+static void fft_bitrev_b16(FAR b16_t *z, size_t m)
+{
+  size_t i;
+  size_t j = 0;
+  size_t bit;
+  b16_t t;
+
+  for (i = 1; i < m; i++)
+    {
+      for (bit = m >> 1; j & bit; bit >>= 1)
+        {
+          j ^= bit;
+        }
+
+      j |= bit;
+
+      if (i < j)
+        {
+          t = z[2 * i];
+          z[2 * i] = z[2 * j];
+          z[2 * j] = t;
+
+          t = z[2 * i + 1];
+          z[2 * i + 1] = z[2 * j + 1];
+          z[2 * j + 1] = t;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: fft_complex_b16
+ *
+ * Description:
+ *   In place complex FFT of m = n/2 values, see fft_complex() in
+ *   lib_fft.c.  Every radix-2 stage halves the values, so that nothing
+ *   can overflow and the result is scaled by 1/m.
+ *
+ ****************************************************************************/
+
+static void fft_complex_b16(FAR struct fft_b16_s *fft, FAR b16_t *z)
+{
+  FAR const b16_t *w = fft->twiddle;
+  size_t m = fft->n / 2;
+  size_t h;
+  size_t j;
+  size_t k;
+
+  fft_bitrev_b16(z, m);
+
+  h = 1;
+  if ((m & 0x55555555) == 0)
+    {
+      /* Odd number of stages: start with a radix-2 stage */
+
+      for (j = 0; j < m; j += 2)
+        {
+          b16_t ar = z[2 * j] >> 1;
+          b16_t ai = z[2 * j + 1] >> 1;
+          b16_t br = z[2 * j + 2] >> 1;
+          b16_t bi = z[2 * j + 3] >> 1;
+
+          z[2 * j]     = ar + br;
+          z[2 * j + 1] = ai + bi;
+          z[2 * j + 2] = ar - br;
+          z[2 * j + 3] = ai - bi;
+        }
+
+      h = 2;
+    }
+
+  for (; h < m; h *= 4)
+    {
+      size_t s1 = fft->n / (2 * h);
+      size_t s2 = s1 / 2;
+
+      for (j = 0; j < m; j += 4 * h)
+        {
+          for (k = 0; k < h; k++)
+            {
+              FAR b16_t *p0 = &z[2 * (j + k)];
+              FAR b16_t *p1 = p0 + 2 * h;
+              FAR b16_t *p2 = p1 + 2 * h;
+              FAR b16_t *p3 = p2 + 2 * h;
+              b16_t w1r = w[2 * k * s1];
+              b16_t w1i = w[2 * k * s1 + 1];
+              b16_t w2r = w[2 * k * s2];
+              b16_t w2i = w[2 * k * s2 + 1];
+              b16_t tr;
+              b16_t ti;
+              b16_t ar;
+              b16_t ai;
+              b16_t br;
+              b16_t bi;
+              b16_t cr;
+              b16_t ci;
+              b16_t dr;
+              b16_t di;
+
+              /* First stage: (p0, p1) and (p2, p3) with W_2h^k */
+
+              tr = cmul_re(w1r, w1i, p1[0], p1[1]) >> 1;
+              ti = cmul_im(w1r, w1i, p1[0], p1[1]) >> 1;
+              ar = (p0[0] >> 1) + tr;
+              ai = (p0[1] >> 1) + ti;
+              br = (p0[0] >> 1) - tr;
+              bi = (p0[1] >> 1) - ti;
+
+              tr = cmul_re(w1r, w1i, p3[0], p3[1]) >> 1;
+              ti = cmul_im(w1r, w1i, p3[0], p3[1]) >> 1;
+              cr = (p2[0] >> 1) + tr;
+              ci = (p2[1] >> 1) + ti;
+              dr = (p2[0] >> 1) - tr;
+              di = (p2[1] >> 1) - ti;
+
+              /* Second stage: (a, c) with W_4h^k and (b, d) with
+               * W_4h^(k+h) = -i * W_4h^k
+               */
+
+              tr = cmul_re(w2r, w2i, cr, ci) >> 1;
+              ti = cmul_im(w2r, w2i, cr, ci) >> 1;
+              p0[0] = (ar >> 1) + tr;
+              p0[1] = (ai >> 1) + ti;
+              p2[0] = (ar >> 1) - tr;
+              p2[1] = (ai >> 1) - ti;
+
+              tr = cmul_im(w2r, w2i, dr, di) >> 1;
+              ti = -cmul_re(w2r, w2i, dr, di) >> 1;
+              p1[0] = (br >> 1) + tr;
+              p1[1] = (bi >> 1) + ti;
+              p3[0] = (br >> 1) - tr;
+              p3[1] = (bi >> 1) - ti;
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fft_init_b16
+ *
+ * Description:
+ *   Initialize a real FFT, see fft_init().  The twiddle factors are
+ *   computed with single precision floats, this is only done here.
+ *
+ * Input Parameters:
+ *   fft     - (out) pointer to the FFT data
+ *   twiddle - (in) buffer for n values
+ *   n       - (in) number of points, a power of 2 and at least 4
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EINVAL if n is not valid.
+ *
+ ****************************************************************************/
+
+int fft_init_b16(FAR struct fft_b16_s *fft, FAR b16_t *twiddle, size_t n)
+{
+  size_t k;
+
+  DEBUGASSERT(fft != NULL);
+  DEBUGASSERT(twiddle != NULL);
+
+  if (n < 4 || (n & (n - 1)) != 0)
+    {
+      return -EINVAL;
+    }
+
+  for (k = 0; k < n / 2; k++)
+    {
+      float angle = -2.0f * (float)M_PI * k / n;
+
+      twiddle[2 * k]     = ftob16(cosf(angle));
+      twiddle[2 * k + 1] = ftob16(sinf(angle));
+    }
+
+  fft->twiddle = twiddle;
+  fft->n       = n;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: fft_real_b16
+ *
+ * Description:
+ *   In place FFT of n real samples, see fft_real() for the layout of the
+ *   result.  The result is scaled by 1/n.
+ *
+ * Input Parameters:
+ *   fft - (in) pointer to the FFT data
+ *   buf - (in/out) n samples in, the spectrum out
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fft_real_b16(FAR struct fft_b16_s *fft, FAR b16_t *buf)
+{
+  FAR const b16_t *w = fft->twiddle;
+  size_t m = fft->n / 2;
+  size_t k;
+  b16_t r0;
+  b16_t i0;
+
+  DEBUGASSERT(fft != NULL);
+  DEBUGASSERT(buf != NULL);
+
+  fft_complex_b16(fft, buf);
+
+  /* See fft_real(), all terms are scaled by another 1/2 here */
+
+  r0 = buf[0] >> 1;
+  i0 = buf[1] >> 1;
+  buf[0] = r0 + i0;
+  buf[1] = r0 - i0;
+
+  for (k = 1; k <= m / 2; k++)
+    {
+      FAR b16_t *p = &buf[2 * k];
+      FAR b16_t *q = &buf[2 * (m - k)];
+      b16_t wr = w[2 * k];
+      b16_t wi = w[2 * k + 1];
+      b16_t evr = (p[0] >> 2) + (q[0] >> 2);
+      b16_t evi = (p[1] >> 2) - (q[1] >> 2);
+      b16_t odr = (p[1] >> 2) + (q[1] >> 2);
+      b16_t odi = (q[0] >> 2) - (p[0] >> 2);
+      b16_t tr  = cmul_re(wr, wi, odr, odi);
+      b16_t ti  = cmul_im(wr, wi, odr, odi);
+
+      p[0] = evr + tr;
+      p[1] = evi + ti;
+      q[0] = evr - tr;
+      q[1] = ti - evi;
+    }
+}
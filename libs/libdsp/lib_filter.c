@@ -0,0 +1,361 @@
+/****************************************************************************
+ * libs/libdsp/lib_filter.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dsp.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fir_push
+ *
+ * Description:
+ *   Add a sample to the FIR filter state.
+ *
+ ****************************************************************************/
+
+static inline void fir_push(FAR struct fir_s *fir, float x)
+{
+  fir->pos = (fir->pos == 0 ? fir->ntaps : fir->pos) - 1;
+  fir->state[fir->pos] = x;
+  fir->state[fir->pos + fir->ntaps] = x;
+}
+
+/****************************************************************************
+ * Name: fir_output
+ *
+ * Description:
+ *   Get the FIR filter output for the current state.
+ *
+ ****************************************************************************/
+
+static inline float fir_output(FAR struct fir_s *fir)
+{
+  FAR const float *c = fir->coeffs;
+  FAR const float *x = &fir->state[fir->pos];
+  float acc0 = 0.0f;
+  float acc1 = 0.0f;
+  size_t i;
+
+  /* Two accumulators hide the latency of the FPU */
+
+  for (i = 0; i + 1 < fir->ntaps; i += 2)
+    {
+      acc0 += c[i] * x[i];
+      acc1 += c[i + 1] * x[i + 1];
+    }
+
+  if (i < fir->ntaps)
+    {
+      acc0 += c[i] * x[i];
+    }
+
+  return acc0 + acc1;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fir_init
+ *
+ * Description:
+ *   Initialize FIR filter
+ *
+ * Input Parameters:
+ *   fir    - (out) pointer to the FIR filter data
+ *   coeffs - (in) ntaps filter coefficients, coeffs[0] applies to the
+ *            newest sample
+ *   state  - (in) buffer for 2*ntaps samples
+ *   ntaps  - (in) number of taps
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fir_init(FAR struct fir_s *fir, FAR const float *coeffs,
+              FAR float *state, size_t ntaps)
+{
+  DEBUGASSERT(fir != NULL);
+  DEBUGASSERT(coeffs != NULL);
+  DEBUGASSERT(state != NULL);
+  DEBUGASSERT(ntaps > 0);
+
+  memset(state, 0, 2 * ntaps * sizeof(float));
+
+  fir->coeffs = coeffs;
+  fir->state  = state;
+  fir->ntaps  = ntaps;
+  fir->pos    = 0;
+  fir->phase  = 0;
+}
+
+/****************************************************************************
+ * Name: fir_process
+ *
+ * Description:
+ *   Filter a block of samples.  in and out may be the same buffer.
+ *
+ * Input Parameters:
+ *   fir - (in/out) pointer to the FIR filter data
+ *   in  - (in) input samples
+ *   out - (out) output samples
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void fir_process(FAR struct fir_s *fir, FAR const float *in,
+                 FAR float *out, size_t n)
+{
+  DEBUGASSERT(fir != NULL);
+
+  while (n-- > 0)
+    {
+      fir_push(fir, *in++);
+      *out++ = fir_output(fir);
+    }
+}
+
+/****************************************************************************
+ * Name: fir_decimate
+ *
+ * Description:
+ *   Filter a block of samples and keep only every factor'th output.  The
+ *   outputs that are dropped are not computed.  in and out may be the same
+ *   buffer.
+ *
+ * Input Parameters:
+ *   fir    - (in/out) pointer to the FIR filter data
+ *   in     - (in) input samples
+ *   out    - (out) output samples
+ *   n      - (in) number of input samples
+ *   factor - (in) decimation factor
+ *
+ * Returned Value:
+ *   Number of output samples
+ *
+ ****************************************************************************/
+
+size_t fir_decimate(FAR struct fir_s *fir, FAR const float *in,
+                    FAR float *out, size_t n, size_t factor)
+{
+  size_t nout = 0;
+
+  DEBUGASSERT(fir != NULL);
+  DEBUGASSERT(factor > 0);
+
+  while (n-- > 0)
+    {
+      fir_push(fir, *in++);
+
+      if (++fir->phase >= factor)
+        {
+          fir->phase  = 0;
+          out[nout++] = fir_output(fir);
+        }
+    }
+
+  return nout;
+}
+
+/****************************************************************************
+ * Name: biquad_init
+ *
+ * Description:
+ *   Initialize a cascade of biquad filters
+ *
+ * Input Parameters:
+ *   bq      - (out) pointer to the biquad cascade data
+ *   coeffs  - (in) b0, b1, b2, a1, a2 of each stage
+ *   state   - (in) buffer for 2*nstages state variables
+ *   nstages - (in) number of stages
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void biquad_init(FAR struct biquad_s *bq, FAR const float *coeffs,
+                 FAR float *state, size_t nstages)
+{
+  DEBUGASSERT(bq != NULL);
+  DEBUGASSERT(coeffs != NULL);
+  DEBUGASSERT(state != NULL);
+
+  memset(state, 0, 2 * nstages * sizeof(float));
+
+  bq->coeffs  = coeffs;
+  bq->state   = state;
+  bq->nstages = nstages;
+}
+
+/****************************************************************************
+ * Name: biquad_process
+ *
+ * Description:
+ *   Filter a block of samples.  in and out may be the same buffer.
+ *
+ *   The block is run through one stage at a time, so that the coefficients
+ *   and the state of a stage stay in registers for the whole block.
+ *
+ * Input Parameters:
+ *   bq  - (in/out) pointer to the biquad cascade data
+ *   in  - (in) input samples
+ *   out - (out) output samples
+ *   n   - (in) number of samples
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void biquad_process(FAR struct biquad_s *bq, FAR const float *in,
+                    FAR float *out, size_t n)
+{
+  FAR const float *c = bq->coeffs;
+  FAR float *s = bq->state;
+  FAR const float *src = in;
+  size_t stage;
+  size_t i;
+
+  DEBUGASSERT(bq != NULL);
+
+  for (stage = 0; stage < bq->nstages; stage++, c += 5, s += 2)
+    {
+      float b0 = c[0];
+      float b1 = c[1];
+      float b2 = c[2];
+      float a1 = c[3];
+      float a2 = c[4];
+      float s1 = s[0];
+      float s2 = s[1];
+
+      for (i = 0; i < n; i++)
+        {
+          float x = src[i];
+          float y = b0 * x + s1;
+
+          s1 = b1 * x - a1 * y + s2;
+          s2 = b2 * x - a2 * y;
+          out[i] = y;
+        }
+
+      s[0] = s1;
+      s[1] = s2;
+
+      /* The next stages work in place on the output */
+
+      src = out;
+    }
+
+  if (bq->nstages == 0 && in != out)
+    {
+      memcpy(out, in, n * sizeof(float));
+    }
+}
+
+/****************************************************************************
+ * Name: movavg_init
+ *
+ * Description:
+ *   Initialize a moving average filter
+ *
+ * Input Parameters:
+ *   ma  - (out) pointer to the moving average data
+ *   buf - (in) buffer for len samples
+ *   len - (in) length of the window
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void movavg_init(FAR struct movavg_s *ma, FAR float *buf, size_t len)
+{
+  DEBUGASSERT(ma != NULL);
+  DEBUGASSERT(buf != NULL);
+  DEBUGASSERT(len > 0);
+
+  ma->buf   = buf;
+  ma->len   = len;
+  ma->pos   = 0;
+  ma->count = 0;
+  ma->sum   = 0.0f;
+}
+
+/****************************************************************************
+ * Name: movavg_process
+ *
+ * Description:
+ *   Add a sample to the moving average in constant time.  The sum is
+ *   recomputed once per window to get rid of the accumulated rounding
+ *   errors.
+ *
+ * Input Parameters:
+ *   ma - (in/out) pointer to the moving average data
+ *   x  - (in) new sample
+ *
+ * Returned Value:
+ *   Return the average of the last len samples (or of all samples if
+ *   there are fewer).
+ *
+ ****************************************************************************/
+
+float movavg_process(FAR struct movavg_s *ma, float x)
+{
+  size_t i;
+
+  DEBUGASSERT(ma != NULL);
+
+  if (ma->count < ma->len)
+    {
+      ma->count++;
+    }
+  else
+    {
+      ma->sum -= ma->buf[ma->pos];
+    }
+
+  ma->buf[ma->pos] = x;
+  ma->sum += x;
+
+  if (++ma->pos >= ma->len)
+    {
+      ma->pos = 0;
+      ma->sum = 0.0f;
+
+      for (i = 0; i < ma->len; i++)
+        {
+          ma->sum += ma->buf[i];
+        }
+    }
+
+  return ma->sum / ma->count;
+}
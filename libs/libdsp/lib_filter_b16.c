@@ -0,0 +1,276 @@
+/****************************************************************************
+ * libs/libdsp/lib_filter_b16.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dspb16.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fir_push_b16
+ ****************************************************************************/
+
+static inline void fir_push_b16(FAR struct fir_b16_s *fir, b16_t x)
+{
+  fir->pos = (fir->pos == 0 ? fir->ntaps : fir->pos) - 1;
+  fir->state[fir->pos] = x;
+  fir->state[fir->pos + fir->ntaps] = x;
+}
+
+/****************************************************************************
+ * Name: fir_output_b16
+ *
+ * Description:
+ *   Get the FIR filter output for the current state.  The products are
+ *   accumulated with 32 fractional bits and rounded once.
+ *
+ ****************************************************************************/
+
+static inline b16_t fir_output_b16(FAR struct fir_b16_s *fir)
+{
+  FAR const b16_t *c = fir->coeffs;
+  FAR const b16_t *x = &fir->state[fir->pos];
+  b32_t acc = 0;
+  size_t i;
+
+  for (i = 0; i < fir->ntaps; i++)
+    {
+      acc += (b32_t)c[i] * x[i];
+    }
+
+  return b32_to_b16_sat(acc);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: fir_init_b16
+ *
+ * Description:
+ *   Initialize FIR filter, see fir_init().
+ *
+ ****************************************************************************/
+
+void fir_init_b16(FAR struct fir_b16_s *fir, FAR const b16_t *coeffs,
+                  FAR b16_t *state, size_t ntaps)
+{
+  DEBUGASSERT(fir != NULL);
+  DEBUGASSERT(coeffs != NULL);
+  DEBUGASSERT(state != NULL);
+  DEBUGASSERT(ntaps > 0);
+
+  memset(state, 0, 2 * ntaps * sizeof(b16_t));
+
+  fir->coeffs = coeffs;
+  fir->state  = state;
+  fir->ntaps  = ntaps;
+  fir->pos    = 0;
+  fir->phase  = 0;
+}
+
+/****************************************************************************
+ * Name: fir_process_b16
+ *
+ * Description:
+ *   Filter a block of samples, see fir_process().
+ *
+ ****************************************************************************/
+
+void fir_process_b16(FAR struct fir_b16_s *fir, FAR const b16_t *in,
+                     FAR b16_t *out, size_t n)
+{
+  DEBUGASSERT(fir != NULL);
+
+  while (n-- > 0)
+    {
+      fir_push_b16(fir, *in++);
+      *out++ = fir_output_b16(fir);
+    }
+}
+
+/****************************************************************************
+ * Name: fir_decimate_b16
+ *
+ * Description:
+ *   Filter and decimate a block of samples, see fir_decimate().
+ *
+ ****************************************************************************/
+
+size_t fir_decimate_b16(FAR struct fir_b16_s *fir, FAR const b16_t *in,
+                        FAR b16_t *out, size_t n, size_t factor)
+{
+  size_t nout = 0;
+
+  DEBUGASSERT(fir != NULL);
+  DEBUGASSERT(factor > 0);
+
+  while (n-- > 0)
+    {
+      fir_push_b16(fir, *in++);
+
+      if (++fir->phase >= factor)
+        {
+          fir->phase  = 0;
+          out[nout++] = fir_output_b16(fir);
+        }
+    }
+
+  return nout;
+}
+
+/****************************************************************************
+ * Name: biquad_init_b16
+ *
+ * Description:
+ *   Initialize a cascade of biquad filters, see biquad_init().  state must
+ *   have room for 4*nstages values.
+ *
+ ****************************************************************************/
+
+void biquad_init_b16(FAR struct biquad_b16_s *bq, FAR const b16_t *coeffs,
+                     FAR b16_t *state, size_t nstages)
+{
+  DEBUGASSERT(bq != NULL);
+  DEBUGASSERT(coeffs != NULL);
+  DEBUGASSERT(state != NULL);
+
+  memset(state, 0, 4 * nstages * sizeof(b16_t));
+
+  bq->coeffs  = coeffs;
+  bq->state   = state;
+  bq->nstages = nstages;
+}
+
+/****************************************************************************
+ * Name: biquad_process_b16
+ *
+ * Description:
+ *   Filter a block of samples, see biquad_process().  Each output is
+ *   accumulated with 32 fractional bits and rounded once.
+ *
+ ****************************************************************************/
+
+void biquad_process_b16(FAR struct biquad_b16_s *bq, FAR const b16_t *in,
+                        FAR b16_t *out, size_t n)
+{
+  FAR const b16_t *c = bq->coeffs;
+  FAR b16_t *s = bq->state;
+  FAR const b16_t *src = in;
+  size_t stage;
+  size_t i;
+
+  DEBUGASSERT(bq != NULL);
+
+  for (stage = 0; stage < bq->nstages; stage++, c += 5, s += 4)
+    {
+      b16_t x1 = s[0];
+      b16_t x2 = s[1];
+      b16_t y1 = s[2];
+      b16_t y2 = s[3];
+
+      for (i = 0; i < n; i++)
+        {
+          b16_t x = src[i];
+          b16_t y = b32_to_b16_sat((b32_t)c[0] * x + (b32_t)c[1] * x1 +
+                                   (b32_t)c[2] * x2 - (b32_t)c[3] * y1 -
+                                   (b32_t)c[4] * y2);
+
+          x2 = x1;
+          x1 = x;
+          y2 = y1;
+          y1 = y;
+          out[i] = y;
+        }
+
+      s[0] = x1;
+      s[1] = x2;
+      s[2] = y1;
+      s[3] = y2;
+
+      src = out;
+    }
+
+  if (bq->nstages == 0 && in != out)
+    {
+      memcpy(out, in, n * sizeof(b16_t));
+    }
+}
+
+/****************************************************************************
+ * Name: movavg_init_b16
+ *
+ * Description:
+ *   Initialize a moving average filter, see movavg_init().
+ *
+ ****************************************************************************/
+
+void movavg_init_b16(FAR struct movavg_b16_s *ma, FAR b16_t *buf,
+                     size_t len)
+{
+  DEBUGASSERT(ma != NULL);
+  DEBUGASSERT(buf != NULL);
+  DEBUGASSERT(len > 0);
+
+  ma->buf   = buf;
+  ma->len   = len;
+  ma->pos   = 0;
+  ma->count = 0;
+  ma->sum   = 0;
+}
+
+/****************************************************************************
+ * Name: movavg_process_b16
+ *
+ * Description:
+ *   Add a sample to the moving average in constant time, see
+ *   movavg_process().
+ *
+ ****************************************************************************/
+
+b16_t movavg_process_b16(FAR struct movavg_b16_s *ma, b16_t x)
+{
+  DEBUGASSERT(ma != NULL);
+
+  if (ma->count < ma->len)
+    {
+      ma->count++;
+    }
+  else
+    {
+      ma->sum -= ma->buf[ma->pos];
+    }
+
+  ma->buf[ma->pos] = x;
+  ma->sum += x;
+
+  if (++ma->pos >= ma->len)
+    {
+      ma->pos = 0;
+    }
+
+  return (b16_t)(ma->sum / (b32_t)ma->count);
+}
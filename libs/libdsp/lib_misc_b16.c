@@ -0,0 +1,241 @@
+/****************************************************************************
+ * libs/libdsp/lib_misc_b16.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dspb16.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: f_saturate_b16
+ *
+ * Description:
+ *   Saturate b16_t number
+ *
+ * Input Parameters:
+ *   val - pointer to b16_t number
+ *   min - lower limit
+ *   max - upper limit
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void f_saturate_b16(FAR b16_t *val, b16_t min, b16_t max)
+{
+  if (*val < min)
+    {
+      *val = min;
+    }
+  else if (*val > max)
+    {
+      *val = max;
+    }
+}
+
+/****************************************************************************
+ * Name: vector2d_mag_b16
+ *
+ * Description:
+ *   Get 2D vector magnitude.
+ *
+ * Input Parameters:
+ *   x   - (in) vector x component
+ *   y   - (in) vector y component
+ *
+ * Returned Value:
+ *   Return 2D vector magnitude
+ *
+ ****************************************************************************/
+
+b16_t vector2d_mag_b16(b16_t x, b16_t y)
+{
+  /* The sum of the squares is computed with 32 fractional bits */
+
+  return (b16_t)ub32sqrtub16((ub32_t)((b32_t)x * x + (b32_t)y * y));
+}
+
+/****************************************************************************
+ * Name: vector2d_saturate_b16
+ *
+ * Description:
+ *   Saturate 2D vector magnitude.
+ *
+ * Input Parameters:
+ *   x   - (in/out) pointer to the vector x component
+ *   y   - (in/out) pointer to the vector y component
+ *   max - (in) maximum vector magnitude
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void vector2d_saturate_b16(FAR b16_t *x, FAR b16_t *y, b16_t max)
+{
+  b16_t mag;
+  b16_t tmp;
+
+  /* Get vector magnitude */
+
+  mag = vector2d_mag_b16(*x, *y);
+
+  if (mag > max)
+    {
+      /* Saturate vector */
+
+      tmp = b16divb16(max, mag);
+      *x  = b16mulb16(*x, tmp);
+      *y  = b16mulb16(*y, tmp);
+    }
+}
+
+/****************************************************************************
+ * Name: dq_mag_b16
+ *
+ * Description:
+ *   Get DQ vector magnitude.
+ *
+ * Input Parameters:
+ *   dq  - (in/out) dq frame vector
+ *
+ * Returned Value:
+ *  Return dq vector magnitude
+ *
+ ****************************************************************************/
+
+b16_t dq_mag_b16(FAR dq_frame_b16_t *dq)
+{
+  return vector2d_mag_b16(dq->d, dq->q);
+}
+
+/****************************************************************************
+ * Name: dq_saturate_b16
+ *
+ * Description:
+ *   Saturate dq frame vector magnitude.
+ *
+ * Input Parameters:
+ *   dq  - (in/out) dq frame vector
+ *   max - (in) maximum vector magnitude
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void dq_saturate_b16(FAR dq_frame_b16_t *dq, b16_t max)
+{
+  vector2d_saturate_b16(&dq->d, &dq->q, max);
+}
+
+/****************************************************************************
+ * Name: angle_norm_b16
+ *
+ * Description:
+ *   Normalize radians angle to a given boundary and a given period.
+ *
+ * Input Parameters:
+ *   angle  - (in/out) pointer to the angle data
+ *   per    - (in) angle period
+ *   bottom - (in) lower limit
+ *   top    - (in) upper limit
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void angle_norm_b16(FAR b16_t *angle, b16_t per, b16_t bottom, b16_t top)
+{
+  while (*angle > top)
+    {
+      /* Move the angle backwards by given period */
+
+      *angle = *angle - per;
+    }
+
+  while (*angle < bottom)
+    {
+      /* Move the angle forwards by given period */
+
+      *angle = *angle + per;
+    }
+}
+
+/****************************************************************************
+ * Name: angle_norm_2pi_b16
+ *
+ * Description:
+ *   Normalize radians angle with period 2*PI to a given boundary.
+ *
+ * Input Parameters:
+ *   angle  - (in/out) pointer to the angle data
+ *   bottom - (in) lower limit
+ *   top    - (in) upper limit
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void angle_norm_2pi_b16(FAR b16_t *angle, b16_t bottom, b16_t top)
+{
+  angle_norm_b16(angle, b16TWOPI, bottom, top);
+}
+
+/****************************************************************************
+ * Name: phase_angle_update_b16
+ *
+ * Description:
+ *   Update phase_angle_b16_s structure:
+ *     1. normalize angle value to <0.0, 2PI> range
+ *     2. update angle value
+ *     3. update sin/cos value for given angle
+ *
+ * Input Parameters:
+ *   angle - (in/out) pointer to the angle data
+ *   val   - (in) angle radian value
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void phase_angle_update_b16(FAR struct phase_angle_b16_s *angle, b16_t val)
+{
+  DEBUGASSERT(angle != NULL);
+
+  /* Normalize angle to <0.0, 2PI> */
+
+  angle_norm_2pi_b16(&val, 0, b16TWOPI);
+
+  /* Update structure */
+
+  angle->angle = val;
+  angle->sin   = b16sin(val);
+  angle->cos   = b16cos(val);
+}
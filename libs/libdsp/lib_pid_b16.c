@@ -0,0 +1,263 @@
+/****************************************************************************
+ * libs/libdsp/lib_pid_b16.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dspb16.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pid_controller_init_b16
+ *
+ * Description:
+ *   Initialize PID controller. This function does not initialize saturation
+ *   limits.
+ *
+ * Input Parameters:
+ *   pid - (out) pointer to the PID controller data
+ *   KP  - (in) proportional gain
+ *   KI  - (in) integral gain
+ *   KD  - (in) derivative gain
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pid_controller_init_b16(FAR pid_controller_b16_t *pid, b16_t KP,
+                             b16_t KI, b16_t KD)
+{
+  DEBUGASSERT(pid != NULL);
+
+  /* Reset controller data */
+
+  memset(pid, 0, sizeof(pid_controller_b16_t));
+
+  /* Copy controller parameters */
+
+  pid->KP = KP;
+  pid->KI = KI;
+  pid->KD = KD;
+}
+
+/****************************************************************************
+ * Name: pi_controller_init_b16
+ *
+ * Description:
+ *   Initialize PI controller. This function does not initialize saturation
+ *   limits.
+ *
+ * Input Parameters:
+ *   pid - (out) pointer to the PID controller data
+ *   KP  - (in) proportional gain
+ *   KI  - (in) integral gain
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pi_controller_init_b16(FAR pid_controller_b16_t *pid, b16_t KP,
+                            b16_t KI)
+{
+  pid_controller_init_b16(pid, KP, KI, 0);
+}
+
+/****************************************************************************
+ * Name: pid_saturation_set_b16
+ *
+ * Description:
+ *   Set controller saturation limits.
+ *
+ * Input Parameters:
+ *   pid - (out) pointer to the PID controller data
+ *   min - (in) lower limit
+ *   max - (in) upper limit
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pid_saturation_set_b16(FAR pid_controller_b16_t *pid, b16_t min,
+                            b16_t max)
+{
+  DEBUGASSERT(pid != NULL);
+  DEBUGASSERT(min < max);
+
+  pid->sat.max = max;
+  pid->sat.min = min;
+}
+
+/****************************************************************************
+ * Name: pi_saturation_set_b16
+ ****************************************************************************/
+
+void pi_saturation_set_b16(FAR pid_controller_b16_t *pid, b16_t min,
+                           b16_t max)
+{
+  pid_saturation_set_b16(pid, min, max);
+}
+
+/****************************************************************************
+ * Name: pid_integral_reset_b16
+ ****************************************************************************/
+
+void pid_integral_reset_b16(FAR pid_controller_b16_t *pid)
+{
+  pid->part[1] = 0;
+}
+
+/****************************************************************************
+ * Name: pi_integral_reset_b16
+ ****************************************************************************/
+
+void pi_integral_reset_b16(FAR pid_controller_b16_t *pid)
+{
+  pid_integral_reset_b16(pid);
+}
+
+/****************************************************************************
+ * Name: pi_controller_b16
+ *
+ * Description:
+ *   PI controller with output saturation and windup protection.  The sums
+ *   saturate instead of wrapping around.
+ *
+ * Input Parameters:
+ *   pid - (in/out) pointer to the PI controller data
+ *   err - (in) current controller error
+ *
+ * Returned Value:
+ *   Return controller output.
+ *
+ ****************************************************************************/
+
+b16_t pi_controller_b16(FAR pid_controller_b16_t *pid, b16_t err)
+{
+  DEBUGASSERT(pid != NULL);
+
+  /* Store error in controller structure */
+
+  pid->err = err;
+
+  /* Get proportional part */
+
+  pid->part[0] = b16mulb16(pid->KP, err);
+
+  /* Get intergral part */
+
+  pid->part[1] = b16_add_sat(pid->part[1], b16mulb16(pid->KI, err));
+
+  /* Add proportional, integral */
+
+  pid->out = b16_add_sat(pid->part[0], pid->part[1]);
+
+  /* Saturate output only if we are not in a PID calculation and only
+   * if some limits are set. Saturation for a PID controller are done later
+   * in PID routine.
+   */
+
+  if (pid->sat.max != pid->sat.min && pid->KD == 0)
+    {
+      if (pid->out > pid->sat.max)
+        {
+          /* Limit output to the upper limit */
+
+          pid->out = pid->sat.max;
+
+          /* Integral anti-windup - reset integral part */
+
+          if (err > 0)
+            {
+              pi_integral_reset_b16(pid);
+            }
+        }
+      else if (pid->out < pid->sat.min)
+        {
+          /* Limit output to the lower limit */
+
+          pid->out = pid->sat.min;
+
+          /* Integral anti-windup - reset integral part */
+
+          if (err < 0)
+            {
+              pi_integral_reset_b16(pid);
+            }
+        }
+    }
+
+  /* Return regulator output */
+
+  return pid->out;
+}
+
+/****************************************************************************
+ * Name: pid_controller_b16
+ *
+ * Description:
+ *   PID controller with output saturation and windup protection
+ *
+ * Input Parameters:
+ *   pid - (in/out) pointer to the PID controller data
+ *   err - (in) current controller error
+ *
+ * Returned Value:
+ *   Return controller output.
+ *
+ ****************************************************************************/
+
+b16_t pid_controller_b16(FAR pid_controller_b16_t *pid, b16_t err)
+{
+  DEBUGASSERT(pid != NULL);
+
+  /* Get PI output */
+
+  pi_controller_b16(pid, err);
+
+  /* Get derivative part */
+
+  pid->part[2] = b16mulb16(pid->KD, b16_add_sat(err, -pid->err_prev));
+
+  /* Add derivative part to the PI part */
+
+  pid->out = b16_add_sat(pid->out, pid->part[2]);
+
+  /* Store current error */
+
+  pid->err_prev = err;
+
+  /* Saturate output if limits are set */
+
+  if (pid->sat.max != pid->sat.min)
+    {
+      f_saturate_b16(&pid->out, pid->sat.min, pid->sat.max);
+    }
+
+  /* Return regulator output */
+
+  return pid->out;
+}
@@ -0,0 +1,329 @@
+/****************************************************************************
+ * libs/libdsp/lib_svm_b16.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <dspb16.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: svm3_sector_get_b16
+ *
+ * Description:
+ *   Get current sector for space vector modulation, see svm3_sector_get()
+ *   in lib_svm.c.
+ *
+ ****************************************************************************/
+
+static uint8_t svm3_sector_get_b16(FAR abc_frame_b16_t *ijk)
+{
+  if (ijk->c <= 0)
+    {
+      if (ijk->a <= 0)
+        {
+          return 2;
+        }
+
+      return ijk->b <= 0 ? 6 : 1;
+    }
+
+  if (ijk->a <= 0)
+    {
+      return ijk->b <= 0 ? 4 : 3;
+    }
+
+  return 5;
+}
+
+/****************************************************************************
+ * Name: svm3_duty_calc_b16
+ *
+ * Description:
+ *   Calculate duty cycles for space vector modulation, see
+ *   svm3_duty_calc() in lib_svm.c.
+ *
+ ****************************************************************************/
+
+static void svm3_duty_calc_b16(FAR struct svm3_state_b16_s *s,
+                               FAR abc_frame_b16_t *ijk)
+{
+  b16_t i = ijk->a;
+  b16_t j = ijk->b;
+  b16_t k = ijk->c;
+  b16_t T0_2;
+  b16_t T1 = 0;
+  b16_t T2 = 0;
+
+  /* Determine T1, T2 and T0 based on the sector */
+
+  switch (s->sector)
+    {
+      case 1:
+        {
+          T1 = i;
+          T2 = j;
+          break;
+        }
+
+      case 2:
+        {
+          T1 = -k;
+          T2 = -i;
+          break;
+        }
+
+      case 3:
+        {
+          T1 = j;
+          T2 = k;
+          break;
+        }
+
+      case 4:
+        {
+          T1 = -i;
+          T2 = -j;
+          break;
+        }
+
+      case 5:
+        {
+          T1 = k;
+          T2 = i;
+          break;
+        }
+
+      case 6:
+        {
+          T1 = -j;
+          T2 = -k;
+          break;
+        }
+
+      default:
+        {
+          /* We should not get here */
+
+          DEBUGASSERT(0);
+          break;
+        }
+    }
+
+  /* Get half of the null vector time */
+
+  T0_2 = (b16ONE - T1 - T2) >> 1;
+
+  /* Calculate duty cycle for 3 phase */
+
+  switch (s->sector)
+    {
+      case 1:
+        {
+          s->d_u = T1 + T2 + T0_2;
+          s->d_v = T2 + T0_2;
+          s->d_w = T0_2;
+          break;
+        }
+
+      case 2:
+        {
+          s->d_u = T1 + T0_2;
+          s->d_v = T1 + T2 + T0_2;
+          s->d_w = T0_2;
+          break;
+        }
+
+      case 3:
+        {
+          s->d_u = T0_2;
+          s->d_v = T1 + T2 + T0_2;
+          s->d_w = T2 + T0_2;
+          break;
+        }
+
+      case 4:
+        {
+          s->d_u = T0_2;
+          s->d_v = T1 + T0_2;
+          s->d_w = T1 + T2 + T0_2;
+          break;
+        }
+
+      case 5:
+        {
+          s->d_u = T2 + T0_2;
+          s->d_v = T0_2;
+          s->d_w = T1 + T2 + T0_2;
+          break;
+        }
+
+      case 6:
+        {
+          s->d_u = T1 + T2 + T0_2;
+          s->d_v = T0_2;
+          s->d_w = T1 + T0_2;
+          break;
+        }
+
+      default:
+        {
+          /* We should not get here */
+
+          DEBUGASSERT(0);
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: svm3_b16
+ *
+ * Description:
+ *   One step of the space vector modulation, see svm3().
+ *
+ * Input Parameters:
+ *   s    - (out) pointer to the SVM data
+ *   v_ab - (in) pointer to the modulation voltage vector in alpha-beta
+ *          frame, normalized to magnitude (0.0 - 1.0)
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void svm3_b16(FAR struct svm3_state_b16_s *s, FAR ab_frame_b16_t *v_ab)
+{
+  abc_frame_b16_t ijk;
+
+  DEBUGASSERT(s != NULL);
+  DEBUGASSERT(v_ab != NULL);
+
+  /* Perform modified inverse Clarke-transformation (alpha,beta) -> (i,j,k)
+   * to obtain auxiliary frame which will be used in further calculations.
+   */
+
+  ijk.a = b32tob16((b32_t)SQRT3_BY_TWO_B16 * v_ab->a -
+                   (b32_t)b16HALF * v_ab->b);
+  ijk.b = v_ab->b;
+  ijk.c = -ijk.b - ijk.a;
+
+  /* Get vector sector */
+
+  s->sector = svm3_sector_get_b16(&ijk);
+
+  /* Get duty cycle */
+
+  svm3_duty_calc_b16(s, &ijk);
+
+  /* Saturate output from SVM */
+
+  f_saturate_b16(&s->d_u, s->d_min, s->d_max);
+  f_saturate_b16(&s->d_v, s->d_min, s->d_max);
+  f_saturate_b16(&s->d_w, s->d_min, s->d_max);
+}
+
+/****************************************************************************
+ * Name: svm3_current_correct_b16
+ *
+ * Description:
+ *   Correct ADC samples (int32) according to SVM3 state, see
+ *   svm3_current_correct().
+ *   NOTE: This works only with 3 shunt resistors configuration.
+ *
+ ****************************************************************************/
+
+void svm3_current_correct_b16(FAR struct svm3_state_b16_s *s,
+                              int32_t *c0, int32_t *c1, int32_t *c2)
+{
+  /* Ignore the sample of the phase with the shortest V0 state and
+   * estimate its value with KCL for motor phases:
+   *    i_a + i_b + i_c = 0
+   */
+
+  switch (s->sector)
+    {
+      case 1:
+      case 6:
+        {
+          *c0 = -(*c1 + *c2);
+          break;
+        }
+
+      case 2:
+      case 3:
+        {
+          *c1 = -(*c0 + *c2);
+          break;
+        }
+
+      case 4:
+      case 5:
+        {
+          *c2 = -(*c0 + *c1);
+          break;
+        }
+
+      default:
+        {
+          /* We should not get here. */
+
+          *c0 = 0;
+          *c1 = 0;
+          *c2 = 0;
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: svm3_init_b16
+ *
+ * Description:
+ *   Initialize 3-phase SVM data.
+ *
+ * Input Parameters:
+ *   s   - (in/out) pointer to the SVM state data
+ *   min - (in) minimum duty cycle
+ *   max - (in) maximum duty cycle
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void svm3_init_b16(FAR struct svm3_state_b16_s *s, b16_t min, b16_t max)
+{
+  DEBUGASSERT(s != NULL);
+  DEBUGASSERT(max > min);
+
+  memset(s, 0, sizeof(struct svm3_state_b16_s));
+
+  s->d_max = max;
+  s->d_min = min;
+}
@@ -25,6 +25,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
@@ -35,6 +36,26 @@
 
 #include "nxcontext.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_NXFONTS_CACHE_NBUCKETS
+#  define CONFIG_NXFONTS_CACHE_NBUCKETS 16
+#endif
+
+#ifndef CONFIG_NXFONTS_CACHE_BUDGET
+#  define CONFIG_NXFONTS_CACHE_BUDGET 0
+#endif
+
+/* The hash bucket of a character code */
+
+#define NXF_BUCKET(ch) ((ch) % CONFIG_NXFONTS_CACHE_NBUCKETS)
+
+/* The size of the allocation holding a glyph */
+
+#define NXF_GLYPHSIZE(g) SIZEOF_NXFONTS_GLYPH_S((g)->stride * (g)->height)
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -62,10 +83,18 @@ struct nxfonts_fcache_s
   nxgl_mxpixel_t bgcolor;              /* Background color */
   nxf_renderer_t renderer;             /* Font renderer */
 
-  /* Glyph cache data storage */
+#if CONFIG_NXFONTS_CACHE_BUDGET > 0
+  size_t nbytes;                       /* Bytes of rendered glyphs */
+#endif
+
+  /* Glyph cache data storage.  The glyphs are kept in a doubly linked list
+   * ordered from the most recently used (head) to the least recently used
+   * (tail) glyph and are found by their character code in hash[].
+   */
 
   FAR struct nxfonts_glyph_s *head;    /* Head of the list of glyphs */
   FAR struct nxfonts_glyph_s *tail;    /* Tail of the list of glyphs */
+  FAR struct nxfonts_glyph_s *hash[CONFIG_NXFONTS_CACHE_NBUCKETS];
 };
 
 /****************************************************************************
@@ -77,6 +106,12 @@ struct nxfonts_fcache_s
 static FAR struct nxfonts_fcache_s *g_fcaches;
 static sem_t g_cachesem = SEM_INITIALIZER(1);
 
+#if CONFIG_NXFONTS_CACHE_BUDGET > 0
+/* Bytes of rendered glyphs in all font caches */
+
+static size_t g_cachebytes;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -166,52 +201,37 @@ static void nxf_cache_lock(FAR struct nxfonts_fcache_s *priv)
  * Name: nxf_removeglyph
  *
  * Description:
- *   Removes the entry 'glyph' from the font cache.
+ *   Removes the entry 'glyph' from the list of glyphs of the font cache.
  *
  ****************************************************************************/
 
 static inline void nxf_removeglyph(FAR struct nxfonts_fcache_s *priv,
-                                   FAR struct nxfonts_glyph_s *glyph,
-                                   FAR struct nxfonts_glyph_s *prev)
+                                   FAR struct nxfonts_glyph_s *glyph)
 {
   ginfo("fcache=%p glyph=%p\n", priv, glyph);
 
-  /* Remove the glyph for the list.  First check for removal from the head
-   * (which, I think, never actually happens).
-   */
+  /* Remove the glyph from the list */
 
-  if (prev == NULL)
+  if (glyph->blink == NULL)
     {
-      /* Replace the head with the node following glyph */
-
       priv->head = glyph->flink;
-
-      /* If there is no node following glyph, then the list is empty */
-
-      if (priv->head == NULL)
-        {
-          priv->tail = NULL;
-        }
     }
-
-  /* Check for removal from the tail (we know that the list cannot become
-   * empty in either of the next two cases).
-   */
-
-  else if (glyph->flink == NULL)
+  else
     {
-      priv->tail = prev;
-      prev->flink = NULL;
+      glyph->blink->flink = glyph->flink;
     }
 
-  /* No.. Remove from mid-list */
-
+  if (glyph->flink == NULL)
+    {
+      priv->tail = glyph->blink;
+    }
   else
     {
-      prev->flink = glyph->flink;
+      glyph->flink->blink = glyph->blink;
     }
 
   glyph->flink = NULL;
+  glyph->blink = NULL;
 
   /* Decrement the count of glyphs in the font cache */
 
@@ -235,11 +255,16 @@ static inline void nxf_addglyph(FAR struct nxfonts_fcache_s *priv,
   /* Add the glyph to the head of the list */
 
   glyph->flink = priv->head;
+  glyph->blink = NULL;
 
   if (priv->head == NULL)
     {
       priv->tail = glyph;
     }
+  else
+    {
+      priv->head->blink = glyph;
+    }
 
   priv->head = glyph;
 
@@ -249,6 +274,88 @@ static inline void nxf_addglyph(FAR struct nxfonts_fcache_s *priv,
   priv->nglyphs++;
 }
 
+/****************************************************************************
+ * Name: nxf_charge
+ *
+ * Description:
+ *   Account for the memory of a glyph that was added to (positive size) or
+ *   freed from (negative size) the font cache.
+ *
+ * Assumptions:
+ *   The caller holds the font cache semaphore, but not the font cache list
+ *   semaphore.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NXFONTS_CACHE_BUDGET > 0
+static void nxf_charge(FAR struct nxfonts_fcache_s *priv, ssize_t size)
+{
+  priv->nbytes += size;
+
+  nxf_list_lock();
+  g_cachebytes += size;
+  nxf_list_unlock();
+}
+#else
+#  define nxf_charge(p,s)
+#endif
+
+/****************************************************************************
+ * Name: nxf_overbudget
+ *
+ * Description:
+ *   Return true if adding 'size' more bytes of glyphs would exceed the
+ *   memory budget of the font caches.
+ *
+ * Assumptions:
+ *   The caller does not hold the font cache list semaphore.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NXFONTS_CACHE_BUDGET > 0
+static bool nxf_overbudget(size_t size)
+{
+  bool over;
+
+  nxf_list_lock();
+  over = g_cachebytes + size > CONFIG_NXFONTS_CACHE_BUDGET;
+  nxf_list_unlock();
+
+  return over;
+}
+#endif
+
+/****************************************************************************
+ * Name: nxf_freeglyph
+ *
+ * Description:
+ *   Remove the entry 'glyph' from the font cache and free the glyph memory.
+ *
+ ****************************************************************************/
+
+static void nxf_freeglyph(FAR struct nxfonts_fcache_s *priv,
+                          FAR struct nxfonts_glyph_s *glyph)
+{
+  FAR struct nxfonts_glyph_s **link;
+
+  /* Remove the glyph from its hash bucket */
+
+  for (link = &priv->hash[NXF_BUCKET(glyph->code)];
+       *link != glyph;
+       link = &(*link)->hlink)
+    {
+      DEBUGASSERT(*link != NULL);
+    }
+
+  *link = glyph->hlink;
+
+  /* Then from the list of glyphs */
+
+  nxf_removeglyph(priv, glyph);
+  nxf_charge(priv, -(ssize_t)NXF_GLYPHSIZE(glyph));
+  lib_free(glyph);
+}
+
 /****************************************************************************
  * Name: nxf_findglyph
  *
@@ -275,16 +382,15 @@ static FAR struct nxfonts_glyph_s *
   nxf_findglyph(FAR struct nxfonts_fcache_s *priv, uint8_t ch)
 {
   FAR struct nxfonts_glyph_s *glyph;
-  FAR struct nxfonts_glyph_s *prev;
 
   ginfo("fcache=%p ch=%c (%02x)\n",
         priv, (ch >= 32 && ch < 128) ? ch : '.', ch);
 
-  /* Try to find the glyph in the list of pre-rendered glyphs */
+  /* Try to find the glyph in the hash bucket of the character */
 
-  for (prev = NULL, glyph = priv->head;
+  for (glyph = priv->hash[NXF_BUCKET(ch)];
        glyph != NULL;
-       prev = glyph, glyph = glyph->flink)
+       glyph = glyph->hlink)
     {
       /* Check if we found the glyph for this character */
 
@@ -294,9 +400,9 @@ static FAR struct nxfonts_glyph_s *
            * of the list (if it is not already at the head of the list).
            */
 
-          if (prev != NULL)
+          if (glyph != priv->head)
             {
-              nxf_removeglyph(priv, glyph, prev);
+              nxf_removeglyph(priv, glyph);
               nxf_addglyph(priv, glyph);
             }
 
@@ -304,22 +410,16 @@ static FAR struct nxfonts_glyph_s *
 
           return glyph;
         }
+    }
 
-      /* Is this the last glyph in the list?  Has the cache reached its
-       * limit for the number of cached fonts?
-       */
-
-      if (glyph->flink == NULL && priv->nglyphs >= priv->maxglyphs)
-        {
-          /* Yes.. then remove it from the list and free the glyph memory.
-           * We do this because we have all of the information in hand now
-           * and we will surely need to have this space later.
-           */
+  /* Has the cache reached its limit for the number of cached fonts?  If so,
+   * free the least recently used glyph now since we will surely need the
+   * space later.
+   */
 
-          nxf_removeglyph(priv, glyph, prev);
-          lib_free(glyph);
-          return NULL;
-        }
+  while (priv->tail != NULL && priv->nglyphs >= priv->maxglyphs)
+    {
+      nxf_freeglyph(priv, priv->tail);
     }
 
   return NULL;
@@ -530,6 +630,20 @@ static inline FAR struct nxfonts_glyph_s *
   /* Allocate the glyph (always succeeds) */
 
   bmsize = stride * height;
+
+#if CONFIG_NXFONTS_CACHE_BUDGET > 0
+  /* Free the least recently used glyphs of this cache until the new glyph
+   * fits into the memory budget.  If it still does not fit, the budget is
+   * exceeded rather than failing to render the glyph.
+   */
+
+  while (priv->tail != NULL &&
+         nxf_overbudget(SIZEOF_NXFONTS_GLYPH_S(bmsize)))
+    {
+      nxf_freeglyph(priv, priv->tail);
+    }
+#endif
+
   glyph  = (FAR struct nxfonts_glyph_s *)
     lib_malloc(SIZEOF_NXFONTS_GLYPH_S(bmsize));
 
@@ -565,6 +679,10 @@ static inline FAR struct nxfonts_glyph_s *
       /* Add the new glyph to the font cache */
 
       nxf_addglyph(priv, glyph);
+      nxf_charge(priv, SIZEOF_NXFONTS_GLYPH_S(bmsize));
+
+      glyph->hlink = priv->hash[NXF_BUCKET(ch)];
+      priv->hash[NXF_BUCKET(ch)] = glyph;
     }
 
   return glyph;
@@ -827,12 +945,17 @@ void nxf_cache_disconnect(FCACHE fhandle)
 
       for (prev = NULL, fcache = g_fcaches;
            fcache != priv && fcache != NULL;
-           fcache = fcache->flink)
+           prev = fcache, fcache = fcache->flink)
         {
         }
 
       DEBUGASSERT(fcache == priv);
       nxf_removecache(fcache, prev);
+
+#if CONFIG_NXFONTS_CACHE_BUDGET > 0
+      g_cachebytes -= priv->nbytes;
+#endif
+
       nxf_list_unlock();
 
       /* Free all allocated glyph memory */
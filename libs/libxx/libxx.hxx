@@ -42,6 +42,8 @@
 
 #include <nuttx/config.h>
 
+#include <cstddef>
+
 //***************************************************************************
 // Definitions
 //***************************************************************************
@@ -66,6 +68,19 @@
 #  define lib_free(p)      free(p)
 #endif
 
+// The memory of operator new and delete comes from the pool of size
+// classes if CONFIG_LIBXX_POOL is selected, else from the heap.
+
+#ifdef CONFIG_LIBXX_POOL
+#  define lib_new(s)              libxx_pool_alloc(s)
+#  define lib_delete(p)           libxx_pool_free(p)
+#  define lib_delete_sized(p,s)   libxx_pool_free_sized(p,s)
+#else
+#  define lib_new(s)              lib_malloc(s)
+#  define lib_delete(p)           lib_free(p)
+#  define lib_delete_sized(p,s)   lib_free(p)
+#endif
+
 //***************************************************************************
 // Public Types
 //***************************************************************************/
@@ -84,4 +99,10 @@ extern "C" FAR void *__dso_handle;
 
 extern "C" int __cxa_atexit(__cxa_exitfunc_t func, void *arg, void *dso_handle);
 
+#ifdef CONFIG_LIBXX_POOL
+FAR void *libxx_pool_alloc(std::size_t nbytes);
+void libxx_pool_free(FAR void *ptr);
+void libxx_pool_free_sized(FAR void *ptr, std::size_t nbytes);
+#endif
+
 #endif // __LIBXX_LIBXX_HXX
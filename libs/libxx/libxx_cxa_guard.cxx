@@ -33,16 +33,32 @@
 //
 //***************************************************************************
 
+
 //***************************************************************************
 // Included Files
 //***************************************************************************
 
+#include <nuttx/config.h>
 #include <nuttx/compiler.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <semaphore.h>
+#include <assert.h>
+
 //***************************************************************************
 // Pre-processor Definitions
 //***************************************************************************
 
+// The guards are protected by a small table of locks.  A guard uses the
+// lock selected by its address.  The locks are only taken until the
+// object has been initialized; after that, __cxa_guard_acquire() is a
+// single load.
+
+#define GUARD_NLOCKS      8
+#define GUARD_LOCK(g)     (&g_guardlocks[((uintptr_t)(g) >> 3) % GUARD_NLOCKS])
+
 //***************************************************************************
 // Private Types
 //***************************************************************************
@@ -62,10 +78,86 @@ typedef int __guard;
 __extension__ typedef int __guard __attribute__((mode(__DI__)));
 #endif
 
+// The rest of the guard is ours.  The second byte is non-zero while a
+// thread is running the initialization.  It does not overlap the
+// initialized bit in either ABI, whatever the byte order.
+
+#define GUARD_PENDING(g)  (((FAR volatile uint8_t *)(g))[1])
+
+struct guard_lock_s
+{
+  sem_t lock;              // Protects the pending bytes of the guards
+  sem_t wait;              // Threads waiting for an initialization
+  unsigned int nwaiters;   // Number of threads waiting on wait
+};
+
 //***************************************************************************
 // Private Data
 //***************************************************************************
 
+static struct guard_lock_s g_guardlocks[GUARD_NLOCKS] =
+{
+  { SEM_INITIALIZER(1), SEM_INITIALIZER(0), 0 },
+  { SEM_INITIALIZER(1), SEM_INITIALIZER(0), 0 },
+  { SEM_INITIALIZER(1), SEM_INITIALIZER(0), 0 },
+  { SEM_INITIALIZER(1), SEM_INITIALIZER(0), 0 },
+  { SEM_INITIALIZER(1), SEM_INITIALIZER(0), 0 },
+  { SEM_INITIALIZER(1), SEM_INITIALIZER(0), 0 },
+  { SEM_INITIALIZER(1), SEM_INITIALIZER(0), 0 },
+  { SEM_INITIALIZER(1), SEM_INITIALIZER(0), 0 }
+};
+
+//***************************************************************************
+// Private Functions
+//***************************************************************************
+
+//***************************************************************************
+// Name: guard_done
+//
+// Description:
+//   Return true if the object of the guard has been initialized.  The
+//   acquire load makes the initialized object visible to this thread.
+//
+//***************************************************************************
+
+static inline bool guard_done(FAR __guard *g)
+{
+#ifdef __ARM_EABI__
+  return (__atomic_load_n(g, __ATOMIC_ACQUIRE) & 1) != 0;
+#else
+  return __atomic_load_n((FAR uint8_t *)g, __ATOMIC_ACQUIRE) != 0;
+#endif
+}
+
+//***************************************************************************
+// Name: guard_wait
+//***************************************************************************
+
+static void guard_wait(FAR sem_t *sem)
+{
+  while (sem_wait(sem) < 0)
+    {
+      DEBUGASSERT(errno == EINTR || errno == ECANCELED);
+    }
+}
+
+//***************************************************************************
+// Name: guard_wakeup
+//
+// Description:
+//   Wake up all threads waiting on a lock.  They check their guards again.
+//   The lock must be held.
+//
+//***************************************************************************
+
+static void guard_wakeup(FAR struct guard_lock_s *gl)
+{
+  for (; gl->nwaiters > 0; gl->nwaiters--)
+    {
+      sem_post(&gl->wait);
+    }
+}
+
 //***************************************************************************
 // Public Functions
 //***************************************************************************
@@ -74,35 +166,88 @@ extern "C"
 {
   //*************************************************************************
   // Name: __cxa_guard_acquire
+  //
+  // Description:
+  //   Return 1 if the caller must initialize the object, 0 if it has been
+  //   initialized.  A thread that finds another thread initializing the
+  //   object waits until that thread calls __cxa_guard_release() or
+  //   __cxa_guard_abort().
+  //
   //*************************************************************************
 
   int __cxa_guard_acquire(FAR __guard *g)
   {
-#ifdef __ARM_EABI__
-    return !(*g & 1);
-#else
-    return !*(char *)g;
-#endif
+    FAR struct guard_lock_s *gl;
+
+    if (guard_done(g))
+      {
+        return 0;
+      }
+
+    gl = GUARD_LOCK(g);
+    guard_wait(&gl->lock);
+
+    while (!guard_done(g))
+      {
+        if (!GUARD_PENDING(g))
+          {
+            GUARD_PENDING(g) = 1;
+            sem_post(&gl->lock);
+            return 1;
+          }
+
+        // Another thread is initializing the object.  Wait for it without
+        // holding the lock, since the initialization may need other guards
+        // of the same lock.
+
+        gl->nwaiters++;
+        sem_post(&gl->lock);
+        guard_wait(&gl->wait);
+        guard_wait(&gl->lock);
+      }
+
+    sem_post(&gl->lock);
+    return 0;
   }
 
   //*************************************************************************
   // Name: __cxa_guard_release
+  //
+  // Description:
+  //   Mark the object as initialized and wake up the waiting threads.
+  //
   //*************************************************************************
 
   void __cxa_guard_release(FAR __guard *g)
   {
+    FAR struct guard_lock_s *gl = GUARD_LOCK(g);
+
+    guard_wait(&gl->lock);
+    GUARD_PENDING(g) = 0;
 #ifdef __ARM_EABI__
-    *g = 1;
+    __atomic_store_n(g, 1, __ATOMIC_RELEASE);
 #else
-    *(char *)g = 1;
+    __atomic_store_n((FAR uint8_t *)g, 1, __ATOMIC_RELEASE);
 #endif
+    guard_wakeup(gl);
+    sem_post(&gl->lock);
   }
 
   //*************************************************************************
   // Name: __cxa_guard_abort
+  //
+  // Description:
+  //   The initialization threw an exception.  Let the next thread try.
+  //
   //*************************************************************************
 
-  void __cxa_guard_abort(FAR __guard *)
+  void __cxa_guard_abort(FAR __guard *g)
   {
+    FAR struct guard_lock_s *gl = GUARD_LOCK(g);
+
+    guard_wait(&gl->lock);
+    GUARD_PENDING(g) = 0;
+    guard_wakeup(gl);
+    sem_post(&gl->lock);
   }
 }
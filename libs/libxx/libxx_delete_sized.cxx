@@ -65,7 +65,7 @@
 
 void operator delete(FAR void *ptr, std::size_t size)
 {
-  lib_free(ptr);
+  lib_delete_sized(ptr, size);
 }
 
 #endif /* CONFIG_HAVE_CXX14 */
@@ -80,7 +80,7 @@ FAR void *operator new[](std::size_t nbytes)
 
   // Perform the allocation
 
-  FAR void *alloc = lib_malloc(nbytes);
+  FAR void *alloc = lib_new(nbytes);
 
 #ifdef CONFIG_DEBUG_ERROR
   if (alloc == 0)
@@ -0,0 +1,359 @@
+//***************************************************************************
+// libs/libxx/libxx_pool.cxx
+//
+// Licensed to the Apache Software Foundation (ASF) under one or more
+// contributor license agreements.  See the NOTICE file distributed with
+// this work for additional information regarding copyright ownership.  The
+// ASF licenses this file to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance with the
+// License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+// WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+// License for the specific language governing permissions and limitations
+// under the License.
+//
+//***************************************************************************
+
+//***************************************************************************
+// Included Files
+//***************************************************************************
+
+#include <nuttx/config.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <semaphore.h>
+#include <assert.h>
+
+#include <nuttx/lib/libxx.h>
+
+#include "libxx.hxx"
+
+#ifdef CONFIG_LIBXX_POOL
+
+//***************************************************************************
+// Pre-processor Definitions
+//***************************************************************************
+
+// The pool is split into pages.  A page is given to a size class when the
+// class runs out of objects, and it is split into objects of that size.
+// Pages are never given back, so the pool adapts to the object sizes that
+// the application uses.
+
+#define POOL_PAGESIZE  CONFIG_LIBXX_POOL_PAGESIZE
+#define POOL_NPAGES    (CONFIG_LIBXX_POOL_SIZE / POOL_PAGESIZE)
+#define POOL_SIZE      (POOL_NPAGES * POOL_PAGESIZE)
+
+// Objects are rounded up to multiples of 8 bytes
+
+#define POOL_ALIGN     8
+#define POOL_NROUNDED  (LIBXX_POOL_MAXSIZE / POOL_ALIGN + 1)
+
+//***************************************************************************
+// Private Types
+//***************************************************************************
+
+// A free object holds the link to the next free object of its class
+
+struct pool_free_s
+{
+  FAR struct pool_free_s *next;
+};
+
+struct pool_class_s
+{
+  sem_t lock;                       // Protects the class
+  FAR struct pool_free_s *freelist; // Free objects of the class
+  struct libxx_poolclass_s stats;   // Statistics of the class
+};
+
+//***************************************************************************
+// Private Data
+//***************************************************************************
+
+// The pool itself.  A pointer is in the pool if it is inside of g_pool.
+
+static uint64_t g_pool[POOL_SIZE / sizeof(uint64_t)];
+
+// The size class of each page that has been handed out
+
+static uint8_t g_pageclass[POOL_NPAGES];
+
+// The first page that has not been handed out, and the count of the
+// allocations that did not come from the pool.  Both are protected by
+// g_pagelock.
+
+static sem_t g_pagelock = SEM_INITIALIZER(1);
+static unsigned int g_nextpage;
+static unsigned long g_fallback;
+
+// The size of the objects of each class
+
+static const uint8_t g_objsize[LIBXX_POOL_NCLASSES] =
+{
+  8, 16, 24, 32, 48, 64, 96, 128
+};
+
+// The class of each size, rounded up to a multiple of POOL_ALIGN
+
+static const uint8_t g_sizeclass[POOL_NROUNDED] =
+{
+  0, 0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7
+};
+
+static struct pool_class_s g_classes[LIBXX_POOL_NCLASSES] =
+{
+  { SEM_INITIALIZER(1), NULL, { 0 } },
+  { SEM_INITIALIZER(1), NULL, { 0 } },
+  { SEM_INITIALIZER(1), NULL, { 0 } },
+  { SEM_INITIALIZER(1), NULL, { 0 } },
+  { SEM_INITIALIZER(1), NULL, { 0 } },
+  { SEM_INITIALIZER(1), NULL, { 0 } },
+  { SEM_INITIALIZER(1), NULL, { 0 } },
+  { SEM_INITIALIZER(1), NULL, { 0 } }
+};
+
+//***************************************************************************
+// Private Functions
+//***************************************************************************
+
+//***************************************************************************
+// Name: pool_lock and pool_unlock
+//***************************************************************************
+
+static void pool_lock(FAR sem_t *lock)
+{
+  while (sem_wait(lock) < 0)
+    {
+      DEBUGASSERT(errno == EINTR || errno == ECANCELED);
+    }
+}
+
+static void pool_unlock(FAR sem_t *lock)
+{
+  sem_post(lock);
+}
+
+//***************************************************************************
+// Name: pool_newpage
+//
+// Description:
+//   Give the next free page of the pool to a size class and return the
+//   first object of the page.  The other objects are put on the free list
+//   of the class, which must be locked and empty.  Returns NULL if the
+//   pool is exhausted.
+//
+//***************************************************************************
+
+static FAR void *pool_newpage(int ndx)
+{
+  FAR struct pool_class_s *cls = &g_classes[ndx];
+  FAR struct pool_free_s *obj;
+  FAR uint8_t *page;
+  unsigned int objsize = g_objsize[ndx];
+  unsigned int nobjs = POOL_PAGESIZE / objsize;
+  unsigned int pageno;
+  unsigned int i;
+
+  pool_lock(&g_pagelock);
+  pageno = g_nextpage;
+  if (pageno < POOL_NPAGES)
+    {
+      g_pageclass[pageno] = ndx;
+      g_nextpage++;
+    }
+
+  pool_unlock(&g_pagelock);
+
+  if (pageno >= POOL_NPAGES)
+    {
+      return NULL;
+    }
+
+  // Link the objects after the first one, in address order
+
+  page = (FAR uint8_t *)g_pool + pageno * POOL_PAGESIZE;
+  for (i = nobjs - 1; i > 0; i--)
+    {
+      obj           = (FAR struct pool_free_s *)(page + i * objsize);
+      obj->next     = cls->freelist;
+      cls->freelist = obj;
+    }
+
+  cls->stats.nobjs += nobjs;
+  return page;
+}
+
+//***************************************************************************
+// Name: pool_give
+//
+// Description:
+//   Return an object to the free list of its class.
+//
+//***************************************************************************
+
+static void pool_give(int ndx, FAR void *ptr)
+{
+  FAR struct pool_class_s *cls = &g_classes[ndx];
+  FAR struct pool_free_s *obj = (FAR struct pool_free_s *)ptr;
+
+  pool_lock(&cls->lock);
+  obj->next     = cls->freelist;
+  cls->freelist = obj;
+  cls->stats.inuse--;
+  pool_unlock(&cls->lock);
+}
+
+//***************************************************************************
+// Name: pool_page
+//
+// Description:
+//   Return the page of a pointer, or -1 if it is not in the pool.
+//
+//***************************************************************************
+
+static inline int pool_page(FAR void *ptr)
+{
+  uintptr_t offset = (uintptr_t)ptr - (uintptr_t)g_pool;
+
+  return offset < POOL_SIZE ? (int)(offset / POOL_PAGESIZE) : -1;
+}
+
+//***************************************************************************
+// Public Functions
+//***************************************************************************
+
+//***************************************************************************
+// Name: libxx_pool_alloc
+//
+// Description:
+//   Allocate the memory of operator new.  Objects up to LIBXX_POOL_MAXSIZE
+//   bytes come from the free list of their size class.  Each class has its
+//   own lock, so they do not contend for the heap lock.  Larger objects,
+//   and all objects once the pool is exhausted, come from malloc().
+//
+//***************************************************************************
+
+FAR void *libxx_pool_alloc(std::size_t nbytes)
+{
+  if (nbytes <= LIBXX_POOL_MAXSIZE)
+    {
+      int ndx = g_sizeclass[(nbytes + POOL_ALIGN - 1) / POOL_ALIGN];
+      FAR struct pool_class_s *cls = &g_classes[ndx];
+      FAR void *ptr;
+
+      pool_lock(&cls->lock);
+      ptr = cls->freelist;
+      if (ptr != NULL)
+        {
+          cls->freelist = cls->freelist->next;
+        }
+      else
+        {
+          ptr = pool_newpage(ndx);
+        }
+
+      if (ptr != NULL)
+        {
+          cls->stats.nalloc++;
+          if (++cls->stats.inuse > cls->stats.peak)
+            {
+              cls->stats.peak = cls->stats.inuse;
+            }
+        }
+
+      pool_unlock(&cls->lock);
+
+      if (ptr != NULL)
+        {
+          return ptr;
+        }
+    }
+
+  pool_lock(&g_pagelock);
+  g_fallback++;
+  pool_unlock(&g_pagelock);
+
+  return lib_malloc(nbytes);
+}
+
+//***************************************************************************
+// Name: libxx_pool_free
+//
+// Description:
+//   Free the memory of operator delete.  The size class of an object in
+//   the pool is that of its page.
+//
+//***************************************************************************
+
+void libxx_pool_free(FAR void *ptr)
+{
+  int pageno = pool_page(ptr);
+
+  if (pageno >= 0)
+    {
+      pool_give(g_pageclass[pageno], ptr);
+    }
+  else
+    {
+      lib_free(ptr);
+    }
+}
+
+//***************************************************************************
+// Name: libxx_pool_free_sized
+//
+// Description:
+//   Free the memory of the sized operator delete.  The size class follows
+//   from the size, so the page table is not needed.
+//
+//***************************************************************************
+
+void libxx_pool_free_sized(FAR void *ptr, std::size_t nbytes)
+{
+  if (pool_page(ptr) >= 0)
+    {
+      DEBUGASSERT(nbytes <= LIBXX_POOL_MAXSIZE);
+
+      int ndx = g_sizeclass[(nbytes + POOL_ALIGN - 1) / POOL_ALIGN];
+
+      DEBUGASSERT(g_pageclass[pool_page(ptr)] == ndx);
+      pool_give(ndx, ptr);
+    }
+  else
+    {
+      lib_free(ptr);
+    }
+}
+
+//***************************************************************************
+// Name: libxx_pool_stats
+//***************************************************************************
+
+void libxx_pool_stats(FAR struct libxx_poolstats_s *stats)
+{
+  int ndx;
+
+  for (ndx = 0; ndx < LIBXX_POOL_NCLASSES; ndx++)
+    {
+      FAR struct pool_class_s *cls = &g_classes[ndx];
+
+      pool_lock(&cls->lock);
+      stats->classes[ndx]         = cls->stats;
+      stats->classes[ndx].objsize = g_objsize[ndx];
+      pool_unlock(&cls->lock);
+    }
+
+  pool_lock(&g_pagelock);
+  stats->size     = POOL_SIZE;
+  stats->used     = g_nextpage * POOL_PAGESIZE;
+  stats->fallback = g_fallback;
+  pool_unlock(&g_pagelock);
+}
+
+#endif // CONFIG_LIBXX_POOL
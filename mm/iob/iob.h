@@ -85,6 +85,12 @@ extern FAR struct iob_qentry_s *g_iob_freeqlist;
 extern FAR struct iob_qentry_s *g_iob_qcommitted;
 #endif
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+/* A list of all free, unallocated large I/O buffers */
+
+extern FAR struct iob_s *g_iob_largelist;
+#endif
+
 /* Counting semaphores that tracks the number of free IOBs/qentries */
 
 extern sem_t g_iob_sem;       /* Counts free I/O buffers */
@@ -111,6 +117,20 @@ extern sem_t g_qentry_sem;    /* Counts free I/O buffer queue containers */
 
 FAR struct iob_qentry_s *iob_alloc_qentry(void);
 
+/****************************************************************************
+ * Name: iob_alloc_fit
+ *
+ * Description:
+ *   Allocate the I/O buffer that extends a chain by 'len' more bytes:  A
+ *   large I/O buffer if 'len' does not fit in a normal one and a large one
+ *   is free, otherwise a normal I/O buffer.  This function is intended only
+ *   for internal use by the IOB module.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_fit(unsigned int len, bool throttled,
+                                bool can_block, enum iob_user_e consumerid);
+
 /****************************************************************************
  * Name: iob_tryalloc_qentry
  *
@@ -198,5 +218,26 @@ void iob_stats_onalloc(enum iob_user_e consumerid);
 void iob_stats_onfree(enum iob_user_e producerid);
 #endif
 
+/****************************************************************************
+ * Name: iob_stats_onfail
+ *
+ * Description:
+ *   An IOB allocation by the consumer failed because no IOB was available
+ *   to it.  This is a hook for the IOB statistics to be updated when
+ *   /proc/iobinfo is enabled.
+ *
+ * Input Parameters:
+ *   consumerid - id representing who is consuming the IOB
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+void iob_stats_onfail(enum iob_user_e consumerid);
+#endif
+
 #endif /* CONFIG_MM_IOB */
 #endif /* __MM_IOB_IOB_H */
@@ -303,6 +303,91 @@ FAR struct iob_s *iob_tryalloc(bool throttled, enum iob_user_e consumerid)
         }
     }
 
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+  iob_stats_onfail(consumerid);
+#endif
+
+  leave_critical_section(flags);
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: iob_tryalloc_large
+ *
+ * Description:
+ *   Try to allocate a large I/O buffer of CONFIG_IOB_LARGE_BUFSIZE bytes
+ *   without waiting.  Large I/O buffers are a separate pool that is not
+ *   counted by iob_navail(), so the caller must fall back to the normal
+ *   I/O buffers if none is free.
+ *
+ ****************************************************************************/
+
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+FAR struct iob_s *iob_tryalloc_large(enum iob_user_e consumerid)
+{
+  FAR struct iob_s *iob;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  iob = g_iob_largelist;
+  if (iob != NULL)
+    {
+      g_iob_largelist = iob->io_flink;
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+      iob_stats_onalloc(consumerid);
+#endif
+
+      leave_critical_section(flags);
+
+      /* Put the I/O buffer in a known state */
+
+      iob->io_flink  = NULL; /* Not in a chain */
+      iob->io_len    = 0;    /* Length of the data in the entry */
+      iob->io_offset = 0;    /* Offset to the beginning of data */
+      iob->io_pktlen = 0;    /* Total length of the packet */
+      return iob;
+    }
+
   leave_critical_section(flags);
   return NULL;
 }
+#endif
+
+/****************************************************************************
+ * Name: iob_alloc_fit
+ *
+ * Description:
+ *   Allocate the I/O buffer that extends a chain by 'len' more bytes:  A
+ *   large I/O buffer if 'len' does not fit in a normal one and a large one
+ *   is free, otherwise a normal I/O buffer.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *iob_alloc_fit(unsigned int len, bool throttled,
+                                bool can_block, enum iob_user_e consumerid)
+{
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  if (len > CONFIG_IOB_BUFSIZE)
+    {
+      FAR struct iob_s *iob = iob_tryalloc_large(consumerid);
+
+      if (iob != NULL)
+        {
+          return iob;
+        }
+    }
+#endif
+
+  if (can_block)
+    {
+      return iob_alloc(throttled, consumerid);
+    }
+  else
+    {
+      return iob_tryalloc(throttled, consumerid);
+    }
+}
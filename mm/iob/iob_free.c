@@ -136,6 +136,24 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob,
 
   flags = enter_critical_section();
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  /* Nobody waits for a large I/O buffer.  Just return it to its list. */
+
+  if (iob->io_bufsize > CONFIG_IOB_BUFSIZE)
+    {
+      iob->io_flink   = g_iob_largelist;
+      g_iob_largelist = iob;
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    defined(CONFIG_MM_IOB) && !defined(CONFIG_FS_PROCFS_EXCLUDE_IOBINFO)
+      iob_stats_onfree(producerid);
+#endif
+
+      leave_critical_section(flags);
+      return next;
+    }
+#endif
+
   /* Which list?  If there is a task waiting for an IOB, then put
    * the IOB on either the free list or on the committed list where
    * it is reserved for that allocation (and not available to
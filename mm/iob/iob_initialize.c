@@ -40,7 +40,9 @@
 #include <nuttx/config.h>
 
 #include <stdbool.h>
+#include <stdint.h>
 
+#include <nuttx/compiler.h>
 #include <nuttx/mm/iob.h>
 
 #include "iob.h"
@@ -60,6 +62,17 @@
 /* This is a pool of pre-allocated I/O buffers */
 
 static struct iob_s        g_iob_pool[CONFIG_IOB_NBUFFERS];
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+static struct iob_s        g_iob_largepool[CONFIG_IOB_LARGE_NBUFFERS];
+
+/* The payload buffers of the I/O buffers above */
+
+static uint8_t g_iob_buffers[CONFIG_IOB_NBUFFERS][CONFIG_IOB_BUFSIZE]
+  aligned_data(sizeof(uintptr_t));
+static uint8_t g_iob_largebuffers[CONFIG_IOB_LARGE_NBUFFERS]
+                                 [CONFIG_IOB_LARGE_BUFSIZE]
+  aligned_data(sizeof(uintptr_t));
+#endif
 #if CONFIG_IOB_NCHAINS > 0
 static struct iob_qentry_s g_iob_qpool[CONFIG_IOB_NCHAINS];
 #endif
@@ -76,6 +89,12 @@ FAR struct iob_s *g_iob_freelist;
 
 FAR struct iob_s *g_iob_committed;
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+/* A list of all free, unallocated large I/O buffers */
+
+FAR struct iob_s *g_iob_largelist;
+#endif
+
 #if CONFIG_IOB_NCHAINS > 0
 /* A list of all free, unallocated I/O buffer queue containers */
 
@@ -123,6 +142,11 @@ void iob_initialize(void)
         {
           FAR struct iob_s *iob = &g_iob_pool[i];
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+          iob->io_data    = g_iob_buffers[i];
+          iob->io_bufsize = CONFIG_IOB_BUFSIZE;
+#endif
+
           /* Add the pre-allocate I/O buffer to the head of the free list */
 
           iob->io_flink  = g_iob_freelist;
@@ -131,6 +155,20 @@ void iob_initialize(void)
 
       g_iob_committed = NULL;
 
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+      /* Add each large I/O buffer to the free list of large buffers */
+
+      for (i = 0; i < CONFIG_IOB_LARGE_NBUFFERS; i++)
+        {
+          FAR struct iob_s *iob = &g_iob_largepool[i];
+
+          iob->io_data    = g_iob_largebuffers[i];
+          iob->io_bufsize = CONFIG_IOB_LARGE_BUFSIZE;
+          iob->io_flink   = g_iob_largelist;
+          g_iob_largelist = iob;
+        }
+#endif
+
       nxsem_init(&g_iob_sem, 0, CONFIG_IOB_NBUFFERS);
 #if CONFIG_IOB_THROTTLE > 0
       nxsem_init(&g_throttle_sem, 0, CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE);
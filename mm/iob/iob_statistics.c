@@ -109,6 +109,32 @@ void iob_stats_onfree(enum iob_user_e producerid)
   g_iobuserstats[IOBUSER_GLOBAL].totalproduced++;
 }
 
+/****************************************************************************
+ * Name: iob_stats_onfail
+ *
+ * Description:
+ *   An IOB allocation by the consumer failed because no IOB was available
+ *   to it.  This is a hook for the IOB statistics to be updated when
+ *   /proc/iobinfo is enabled.
+ *
+ * Input Parameters:
+ *   consumerid - id representing who is consuming the IOB
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+void iob_stats_onfail(enum iob_user_e consumerid)
+{
+  DEBUGASSERT(consumerid < IOBUSER_NENTRIES);
+  g_iobuserstats[consumerid].totalfailed++;
+
+  /* Increment the global statistic as well */
+
+  g_iobuserstats[IOBUSER_GLOBAL].totalfailed++;
+}
+
 /****************************************************************************
  * Name: iob_getuserstats
  *
@@ -67,4 +67,28 @@ void kmm_addregion(FAR void *heap_start, size_t heap_size)
   return mm_addregion(&g_kmmheap, heap_start, heap_size);
 }
 
+/****************************************************************************
+ * Name: kmm_addregion_attr
+ *
+ * Description:
+ *   This function adds a region of contiguous memory with the placement
+ *   attributes 'attr' to the kernel heap.
+ *
+ * Input Parameters:
+ *   heap_start - Address of the beginning of the memory region
+ *   heap_size  - The size (in bytes) if the memory region.
+ *   attr       - The MALLOC_ATTR_* attributes of the region
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REGION_ATTR
+void kmm_addregion_attr(FAR void *heap_start, size_t heap_size, int attr)
+{
+  mm_addregion_attr(&g_kmmheap, heap_start, heap_size, attr);
+}
+#endif
+
 #endif /* CONFIG_MM_KERNEL_HEAP */
@@ -66,4 +66,27 @@ FAR void *kmm_malloc(size_t size)
   return mm_malloc(&g_kmmheap, size);
 }
 
+/****************************************************************************
+ * Name: kmm_malloc_attr
+ *
+ * Description:
+ *   Allocate memory from the regions of the kernel heap that have all of
+ *   the placement attributes 'attr'.
+ *
+ * Input Parameters:
+ *   size - Size (in bytes) of the memory region to be allocated.
+ *   attr - The required MALLOC_ATTR_* attributes
+ *
+ * Returned Value:
+ *   The address of the allocated memory (NULL on failure to allocate)
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REGION_ATTR
+FAR void *kmm_malloc_attr(size_t size, int attr)
+{
+  return mm_malloc_attr(&g_kmmheap, size, attr);
+}
+#endif
+
 #endif /* CONFIG_MM_KERNEL_HEAP */
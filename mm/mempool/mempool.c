@@ -0,0 +1,508 @@
+/****************************************************************************
+ * mm/mempool/mempool.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/nuttx.h>
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/mm/mempool.h>
+
+#ifdef CONFIG_MM_MEMPOOL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* All blocks are aligned to this boundary (the same alignment as is
+ * provided by the heap).
+ */
+
+#define MEMPOOL_ALIGN       8
+#define MEMPOOL_ALIGN_MASK  (MEMPOOL_ALIGN - 1)
+#define MEMPOOL_ALIGN_UP(s) (((s) + MEMPOOL_ALIGN_MASK) & ~MEMPOOL_ALIGN_MASK)
+
+/* Each storage chunk begins with a header that links it into the elist of
+ * the pool.
+ */
+
+#define MEMPOOL_CHUNKHDR    MEMPOOL_ALIGN_UP(sizeof(struct mempool_chunk_s))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct mempool_chunk_s
+{
+  sq_entry_t node;              /* Entry in the elist of the pool */
+  size_t size;                  /* Size of the chunk, including this header */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The list of all initialized memory pools */
+
+static sq_queue_t g_mempool_list;
+static sem_t g_mempool_sem = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_bsize
+ *
+ * Description:
+ *   Return the actual size of each block in the pool.  Each free block must
+ *   be able to hold a list entry.
+ *
+ ****************************************************************************/
+
+static inline size_t mempool_bsize(FAR struct mempool_s *pool)
+{
+  size_t bsize = pool->bsize;
+
+  if (bsize < sizeof(sq_entry_t))
+    {
+      bsize = sizeof(sq_entry_t);
+    }
+
+  return MEMPOOL_ALIGN_UP(bsize);
+}
+
+/****************************************************************************
+ * Name: mempool_mmalloc and mempool_mmfree
+ *
+ * Description:
+ *   Allocate and free storage for the pool, either from the granule
+ *   allocator associated with the pool or from the kernel heap.
+ *
+ ****************************************************************************/
+
+static FAR void *mempool_mmalloc(FAR struct mempool_s *pool, size_t size)
+{
+#ifdef CONFIG_GRAN
+  if (pool->gran != NULL)
+    {
+      return gran_alloc(pool->gran, size);
+    }
+#endif
+
+  return kmm_malloc(size);
+}
+
+static void mempool_mmfree(FAR struct mempool_s *pool, FAR void *mem,
+                           size_t size)
+{
+#ifdef CONFIG_GRAN
+  if (pool->gran != NULL)
+    {
+      gran_free(pool->gran, mem, size);
+      return;
+    }
+#endif
+
+  UNUSED(size);
+  kmm_free(mem);
+}
+
+/****************************************************************************
+ * Name: mempool_expand
+ *
+ * Description:
+ *   Add 'nblocks' new blocks to the pool.  The interrupt reserve is filled
+ *   first.  This must not be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+static int mempool_expand(FAR struct mempool_s *pool, size_t nblocks)
+{
+  FAR struct mempool_chunk_s *chunk;
+  FAR char *blk;
+  irqstate_t flags;
+  size_t bsize = mempool_bsize(pool);
+  size_t size = MEMPOOL_CHUNKHDR + nblocks * bsize;
+  size_t i;
+
+  DEBUGASSERT(!up_interrupt_context());
+
+  chunk = (FAR struct mempool_chunk_s *)mempool_mmalloc(pool, size);
+  if (chunk == NULL)
+    {
+      merr("ERROR: Failed to allocate %lu blocks for pool %s\n",
+           (unsigned long)nblocks, pool->name ? pool->name : "");
+      return -ENOMEM;
+    }
+
+  chunk->size = size;
+  blk         = (FAR char *)chunk + MEMPOOL_CHUNKHDR;
+
+  flags = enter_critical_section();
+
+  sq_addlast(&chunk->node, &pool->elist);
+  pool->ntotal += nblocks;
+  pool->arena  += size;
+
+  for (i = 0; i < nblocks; i++, blk += bsize)
+    {
+      if (pool->nilist < pool->ninterrupt)
+        {
+          sq_addfirst((FAR sq_entry_t *)blk, &pool->ilist);
+          pool->nilist++;
+        }
+      else
+        {
+          sq_addfirst((FAR sq_entry_t *)blk, &pool->list);
+        }
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mempool_init
+ *
+ * Description:
+ *   Initialize a memory pool.  The caller must set the size and growth
+ *   fields of the pool before calling this function.
+ *
+ * Input Parameters:
+ *   pool - The memory pool to initialize
+ *   name - The name of the pool as reported by /proc/mempool (may be NULL)
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int mempool_init(FAR struct mempool_s *pool, FAR const char *name)
+{
+  size_t ninitial;
+  int ret;
+
+  DEBUGASSERT(pool != NULL && pool->bsize > 0);
+
+  pool->name   = name;
+  pool->nilist = 0;
+  pool->nused  = 0;
+  pool->ntotal = 0;
+  pool->arena  = 0;
+
+  sq_init(&pool->list);
+  sq_init(&pool->ilist);
+  sq_init(&pool->elist);
+
+  /* The wait semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&pool->waitsem, 0, 0);
+  nxsem_setprotocol(&pool->waitsem, SEM_PRIO_NONE);
+
+  /* Create the initial blocks and the interrupt reserve */
+
+  ninitial = pool->ninitial + pool->ninterrupt;
+  if (ninitial > 0)
+    {
+      ret = mempool_expand(pool, ninitial);
+      if (ret < 0)
+        {
+          nxsem_destroy(&pool->waitsem);
+          return ret;
+        }
+    }
+
+  /* Add the pool to the list of registered pools */
+
+  nxsem_wait_uninterruptible(&g_mempool_sem);
+  sq_addlast(&pool->node, &g_mempool_list);
+  nxsem_post(&g_mempool_sem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mempool_alloc
+ *
+ * Description:
+ *   Allocate a block from the memory pool.  This may be called from an
+ *   interrupt handler, in which case only the interrupt reserve and the
+ *   normal free list are used and the pool never grows or waits.
+ *
+ * Input Parameters:
+ *   pool - The memory pool to allocate from
+ *
+ * Returned Value:
+ *   The address of the allocated block or NULL if no block is available.
+ *
+ ****************************************************************************/
+
+FAR void *mempool_alloc(FAR struct mempool_s *pool)
+{
+  FAR sq_entry_t *blk;
+  irqstate_t flags;
+
+  DEBUGASSERT(pool != NULL);
+
+  flags = enter_critical_section();
+
+  for (; ; )
+    {
+      blk = sq_remfirst(&pool->list);
+      if (blk != NULL)
+        {
+          break;
+        }
+
+      if (up_interrupt_context())
+        {
+          /* Use the interrupt reserve */
+
+          blk = sq_remfirst(&pool->ilist);
+          if (blk != NULL)
+            {
+              pool->nilist--;
+            }
+
+          break;
+        }
+      else if (pool->nexpand > 0)
+        {
+          int ret;
+
+          /* Grow the pool.  Do not hold the critical section while
+           * allocating memory.
+           */
+
+          leave_critical_section(flags);
+          ret = mempool_expand(pool, pool->nexpand);
+          flags = enter_critical_section();
+
+          if (ret < 0 && sq_empty(&pool->list))
+            {
+              break;
+            }
+        }
+      else if (pool->wait)
+        {
+          /* Wait for another thread to free a block.  The critical section
+           * is released while we wait.
+           */
+
+          nxsem_wait_uninterruptible(&pool->waitsem);
+        }
+      else
+        {
+          break;
+        }
+    }
+
+  if (blk != NULL)
+    {
+      pool->nused++;
+    }
+
+  leave_critical_section(flags);
+  return blk;
+}
+
+/****************************************************************************
+ * Name: mempool_free
+ *
+ * Description:
+ *   Return a block to the memory pool.  This may be called from an
+ *   interrupt handler.
+ *
+ * Input Parameters:
+ *   pool - The memory pool that the block was allocated from
+ *   blk  - The block to release
+ *
+ ****************************************************************************/
+
+void mempool_free(FAR struct mempool_s *pool, FAR void *blk)
+{
+  irqstate_t flags;
+  int sval;
+
+  DEBUGASSERT(pool != NULL && blk != NULL && pool->nused > 0);
+
+  flags = enter_critical_section();
+
+  /* Replenish the interrupt reserve first */
+
+  if (pool->nilist < pool->ninterrupt)
+    {
+      sq_addfirst((FAR sq_entry_t *)blk, &pool->ilist);
+      pool->nilist++;
+    }
+  else
+    {
+      sq_addfirst((FAR sq_entry_t *)blk, &pool->list);
+    }
+
+  pool->nused--;
+
+  /* Wake up one waiter, if there is one */
+
+  if (pool->wait && nxsem_getvalue(&pool->waitsem, &sval) >= 0 && sval < 0)
+    {
+      nxsem_post(&pool->waitsem);
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: mempool_info
+ *
+ * Description:
+ *   Return the current state of the memory pool.
+ *
+ * Input Parameters:
+ *   pool - The memory pool of interest
+ *   info - The location to return the state
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned on
+ *   any failure.
+ *
+ ****************************************************************************/
+
+int mempool_info(FAR struct mempool_s *pool,
+                 FAR struct mempoolinfo_s *info)
+{
+  irqstate_t flags;
+  int sval;
+
+  DEBUGASSERT(pool != NULL && info != NULL);
+
+  flags = enter_critical_section();
+
+  info->arena    = pool->arena;
+  info->iordblks = pool->nilist;
+  info->aordblks = pool->nused;
+  info->ordblks  = pool->ntotal - pool->nused - pool->nilist;
+  info->sizeblks = mempool_bsize(pool);
+  info->nwaiter  = 0;
+
+  if (nxsem_getvalue(&pool->waitsem, &sval) >= 0 && sval < 0)
+    {
+      info->nwaiter = -sval;
+    }
+
+  leave_critical_section(flags);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mempool_deinit
+ *
+ * Description:
+ *   Release all storage of the memory pool.  All blocks must have been
+ *   returned to the pool.
+ *
+ * Input Parameters:
+ *   pool - The memory pool to release
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -EBUSY is returned if blocks of the
+ *   pool are still in use.
+ *
+ ****************************************************************************/
+
+int mempool_deinit(FAR struct mempool_s *pool)
+{
+  FAR struct mempool_chunk_s *chunk;
+
+  DEBUGASSERT(pool != NULL && !up_interrupt_context());
+
+  if (pool->nused > 0)
+    {
+      return -EBUSY;
+    }
+
+  nxsem_wait_uninterruptible(&g_mempool_sem);
+  sq_rem(&pool->node, &g_mempool_list);
+  nxsem_post(&g_mempool_sem);
+
+  /* Release all of the storage chunks */
+
+  while ((chunk = (FAR struct mempool_chunk_s *)
+                  sq_remfirst(&pool->elist)) != NULL)
+    {
+      mempool_mmfree(pool, chunk, chunk->size);
+    }
+
+  sq_init(&pool->list);
+  sq_init(&pool->ilist);
+  pool->nilist = 0;
+  pool->ntotal = 0;
+  pool->arena  = 0;
+
+  nxsem_destroy(&pool->waitsem);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mempool_foreach
+ *
+ * Description:
+ *   Call a function for each initialized memory pool.  This is used by
+ *   /proc/mempool.
+ *
+ * Input Parameters:
+ *   handler - The function to call
+ *   arg     - An opaque argument passed to the handler
+ *
+ ****************************************************************************/
+
+void mempool_foreach(mempool_foreach_t handler, FAR void *arg)
+{
+  FAR sq_entry_t *entry;
+
+  nxsem_wait_uninterruptible(&g_mempool_sem);
+
+  for (entry = sq_peek(&g_mempool_list); entry != NULL;
+       entry = sq_next(entry))
+    {
+      handler(container_of(entry, struct mempool_s, node), arg);
+    }
+
+  nxsem_post(&g_mempool_sem);
+}
+
+#endif /* CONFIG_MM_MEMPOOL */
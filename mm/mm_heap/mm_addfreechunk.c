@@ -69,6 +69,11 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 
   ndx = mm_size2ndx(node->size);
 
+#ifdef CONFIG_MM_FRAGSTATS
+  heap->mm_fragnfree[ndx]++;
+  heap->mm_fragbytes[ndx] += node->size;
+#endif
+
   /* Now put the new node into the next */
 
   for (prev = &heap->mm_nodelist[ndx], next = heap->mm_nodelist[ndx].flink;
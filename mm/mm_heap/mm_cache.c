@@ -0,0 +1,213 @@
+/****************************************************************************
+ * mm/mm_heap/mm_cache.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef MM_HAVE_CPUCACHE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cache_bin
+ *
+ * Description:
+ *   Return the cache bin of the current CPU that holds chunks of 'size'
+ *   bytes.  Local interrupts must be disabled so that the caller cannot
+ *   migrate to another CPU while it holds the reference.
+ *
+ ****************************************************************************/
+
+static inline FAR struct mm_cachebin_s *
+mm_cache_bin(FAR struct mm_heap_s *heap, size_t size)
+{
+  return &heap->mm_cache[up_cpu_index()].bins[MM_CACHE_NDX(size)];
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_cache_alloc
+ *
+ * Description:
+ *   Take a chunk of exactly 'size' bytes (including the chunk header) from
+ *   the cache of the current CPU.  This does not require the heap
+ *   semaphore.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   size - The aligned chunk size, including SIZEOF_MM_ALLOCNODE
+ *
+ * Returned Value:
+ *   A pointer to the user memory of the cached chunk or NULL if the size
+ *   is not cached or the bin is empty.
+ *
+ ****************************************************************************/
+
+FAR void *mm_cache_alloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  FAR struct mm_cachebin_s *bin;
+  FAR struct mm_delaynode_s *node;
+  irqstate_t flags;
+
+  if (size > MM_CACHE_MAXSIZE)
+    {
+      return NULL;
+    }
+
+  flags = up_irq_save();
+
+  bin  = mm_cache_bin(heap, size);
+  node = bin->head;
+  if (node != NULL)
+    {
+      bin->head = node->flink;
+      bin->count--;
+    }
+
+  up_irq_restore(flags);
+  return node;
+}
+
+/****************************************************************************
+ * Name: mm_cache_free
+ *
+ * Description:
+ *   Retain a chunk in the cache of the current CPU instead of returning it
+ *   to the heap.  The chunk stays marked as allocated so that it is never
+ *   coalesced with its neighbors while it is cached.  This may be called
+ *   from interrupt handlers.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   mem  - The user memory of the chunk to be cached
+ *
+ * Returned Value:
+ *   true if the chunk was cached; false if the chunk is too large or the
+ *   bin is already full.  In the latter case, the caller must return the
+ *   chunk to the heap.
+ *
+ ****************************************************************************/
+
+bool mm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_allocnode_s *alloc;
+  FAR struct mm_cachebin_s *bin;
+  FAR struct mm_delaynode_s *node;
+  irqstate_t flags;
+  bool cached = false;
+
+  alloc = (FAR struct mm_allocnode_s *)
+          ((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+  DEBUGASSERT(alloc->preceding & MM_ALLOC_BIT);
+
+  if (alloc->size > MM_CACHE_MAXSIZE)
+    {
+      return false;
+    }
+
+  node  = (FAR struct mm_delaynode_s *)mem;
+  flags = up_irq_save();
+
+  bin = mm_cache_bin(heap, alloc->size);
+  if (bin->count < CONFIG_MM_CPUCACHE_DEPTH)
+    {
+      node->flink = bin->head;
+      bin->head   = node;
+      bin->count++;
+      cached      = true;
+    }
+
+  up_irq_restore(flags);
+  return cached;
+}
+
+/****************************************************************************
+ * Name: mm_cache_drain
+ *
+ * Description:
+ *   Detach up to CONFIG_MM_CPUCACHE_BATCH chunks of 'size' bytes from the
+ *   cache of the current CPU so that the caller can return all of them to
+ *   the heap while it holds the heap semaphore just once.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   size - The chunk size, including SIZEOF_MM_ALLOCNODE
+ *
+ * Returned Value:
+ *   A list of detached chunks, linked through their payload, or NULL.
+ *
+ ****************************************************************************/
+
+FAR struct mm_delaynode_s *mm_cache_drain(FAR struct mm_heap_s *heap,
+                                          size_t size)
+{
+  FAR struct mm_cachebin_s *bin;
+  FAR struct mm_delaynode_s *head;
+  FAR struct mm_delaynode_s *tail;
+  irqstate_t flags;
+  int n;
+
+  if (size > MM_CACHE_MAXSIZE)
+    {
+      return NULL;
+    }
+
+  flags = up_irq_save();
+
+  bin  = mm_cache_bin(heap, size);
+  head = bin->head;
+  tail = NULL;
+
+  for (n = 0; n < CONFIG_MM_CPUCACHE_BATCH && bin->head != NULL; n++)
+    {
+      tail      = bin->head;
+      bin->head = tail->flink;
+      bin->count--;
+    }
+
+  if (tail != NULL)
+    {
+      tail->flink = NULL;
+    }
+  else
+    {
+      head = NULL;
+    }
+
+  up_irq_restore(flags);
+  return head;
+}
+
+#endif /* MM_HAVE_CPUCACHE */
@@ -0,0 +1,122 @@
+/****************************************************************************
+ * mm/mm_heap/mm_findfreechunk.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include <nuttx/mm/mm.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_findfreechunk
+ *
+ * Description:
+ *   Find the smallest free chunk of at least 'size' bytes.  The chunk is
+ *   not removed from the nodelist.  It is assumed that the caller holds
+ *   the mm semaphore.
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size)
+{
+  FAR struct mm_freenode_s *node;
+  int ndx;
+
+  /* Get the location in the node list to start the search. Special case
+   * really big allocations
+   */
+
+  if (size >= MM_MAX_CHUNK)
+    {
+      ndx = MM_NNODES - 1;
+    }
+  else
+    {
+      /* Convert the request size into a nodelist index */
+
+      ndx = mm_size2ndx(size);
+    }
+
+  /* Search for a large enough chunk in the list of nodes. This list is
+   * ordered by size, but will have occasional zero sized nodes as we visit
+   * other mm_nodelist[] entries.
+   */
+
+  for (node = heap->mm_nodelist[ndx].flink;
+       node && node->size < size;
+       node = node->flink)
+    {
+      DEBUGASSERT(node->blink->flink == node);
+    }
+
+  /* If we found a node with non-zero size, then this is one to use. Since
+   * the list is ordered, we know that is must be best fitting chunk
+   * available.
+   */
+
+  return node;
+}
+
+/****************************************************************************
+ * Name: mm_findfreechunk_attr
+ *
+ * Description:
+ *   Find the smallest free chunk of at least 'size' bytes that lies in a
+ *   heap region with all of the placement attributes 'attr'.  The chunk is
+ *   not removed from the nodelist.  It is assumed that the caller holds
+ *   the mm semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REGION_ATTR
+FAR struct mm_freenode_s *mm_findfreechunk_attr(FAR struct mm_heap_s *heap,
+                                                size_t size, int attr)
+{
+  FAR struct mm_freenode_s *node;
+
+  /* The list is ordered by size, so the first chunk that is large enough
+   * and that lies in a suitable region is the best fitting one.  The
+   * zero sized mm_nodelist[] entries are skipped by the size check.
+   */
+
+  for (node = heap->mm_nodelist[mm_size2ndx(size)].flink;
+       node != NULL;
+       node = node->flink)
+    {
+      if (node->size >= size &&
+          (mm_regionattr(heap, node) & attr) == attr)
+        {
+          break;
+        }
+    }
+
+  return node;
+}
+#endif
+
@@ -0,0 +1,237 @@
+/****************************************************************************
+ * mm/mm_heap/mm_fragstats.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_FRAGSTATS
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_frag_minsize
+ *
+ * Description:
+ *   Return the smallest chunk size that is counted in bucket 'ndx'.
+ *
+ ****************************************************************************/
+
+static size_t mm_frag_minsize(int ndx)
+{
+#ifdef CONFIG_MM_TLSF
+  /* The first level list 0 holds all chunks smaller than
+   * MM_TLSF_SLCOUNT granules.
+   */
+
+  if (ndx == 0)
+    {
+      return MM_MIN_CHUNK;
+    }
+
+  return (size_t)MM_MIN_CHUNK << (ndx + MM_TLSF_SLSHIFT - 1);
+#else
+  return (size_t)MM_MIN_CHUNK << ndx;
+#endif
+}
+
+/****************************************************************************
+ * Name: mm_frag_largest
+ *
+ * Description:
+ *   Return the size of the largest free chunk.  Only the free list of the
+ *   highest non-empty bucket has to be searched.  The caller must hold the
+ *   MM semaphore.
+ *
+ ****************************************************************************/
+
+static size_t mm_frag_largest(FAR struct mm_heap_s *heap)
+{
+  FAR struct mm_freenode_s *node;
+  size_t largest = 0;
+#ifdef CONFIG_MM_TLSF
+  int fl;
+  int sl;
+
+  if (heap->mm_flbitmap == 0)
+    {
+      return 0;
+    }
+
+  /* The chunks of a second level list are not sorted */
+
+  fl   = flsl((long)heap->mm_flbitmap) - 1;
+  sl   = flsl((long)heap->mm_slbitmap[fl]) - 1;
+  node = heap->mm_freelist[fl][sl];
+#else
+  int ndx;
+
+  for (ndx = MM_FRAG_NBUCKETS - 1; ndx > 0; ndx--)
+    {
+      if (heap->mm_fragnfree[ndx] > 0)
+        {
+          break;
+        }
+    }
+
+  /* The list of a bucket ends at the list head of the next bucket, which
+   * has the size zero.
+   */
+
+  node = heap->mm_nodelist[ndx].flink;
+#endif
+
+  for (; node != NULL && node->size != 0; node = node->flink)
+    {
+      if (node->size > largest)
+        {
+          largest = node->size;
+        }
+    }
+
+  return largest;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_fraginfo
+ *
+ * Description:
+ *   Return the distribution of the free chunks of a heap over the free
+ *   list buckets and the fragmentation of the free memory.  Unlike
+ *   mm_mallinfo(), this does not walk the heap:  The buckets are counted
+ *   as chunks are added to and removed from the free lists.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   info - The location to return the report
+ *
+ * Returned Value:
+ *   Zero (OK) is always returned.
+ *
+ ****************************************************************************/
+
+int mm_fraginfo(FAR struct mm_heap_s *heap,
+                FAR struct mm_fraginfo_s *info)
+{
+  int ndx;
+
+  DEBUGASSERT(info != NULL);
+
+  info->freebytes = 0;
+  info->nfree     = 0;
+
+  mm_takesemaphore(heap);
+
+  for (ndx = 0; ndx < MM_FRAG_NBUCKETS; ndx++)
+    {
+      info->buckets[ndx].minsize = mm_frag_minsize(ndx);
+      info->buckets[ndx].nfree   = heap->mm_fragnfree[ndx];
+      info->buckets[ndx].bytes   = heap->mm_fragbytes[ndx];
+
+      info->nfree     += heap->mm_fragnfree[ndx];
+      info->freebytes += heap->mm_fragbytes[ndx];
+    }
+
+  info->largest = mm_frag_largest(heap);
+
+  mm_givesemaphore(heap);
+
+#ifdef MM_HAVE_CPUSTATS
+  /* The per-CPU counters are not protected by the semaphore.  A copy may
+   * be out of date by the operations that are in progress on other CPUs.
+   */
+
+  memcpy(info->cpus, heap->mm_cpustats, sizeof(info->cpus));
+#endif
+
+  info->frag = 0;
+  if (info->freebytes > 0)
+    {
+      info->frag = 1000 - (unsigned int)
+                   (((uint64_t)info->largest * 1000) / info->freebytes);
+    }
+
+  return OK;
+}
+
+#ifdef MM_HAVE_CPUSTATS
+/****************************************************************************
+ * Name: mm_cpustats_alloc and mm_cpustats_free
+ *
+ * Description:
+ *   Count an allocation or a free of the chunk at 'mem' for the current
+ *   CPU.  These do not require the MM semaphore.
+ *
+ ****************************************************************************/
+
+void mm_cpustats_alloc(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_cpustats_s *stats;
+  irqstate_t flags;
+
+  node  = (FAR struct mm_allocnode_s *)((FAR char *)mem -
+                                        SIZEOF_MM_ALLOCNODE);
+  flags = up_irq_save();
+
+  stats = &heap->mm_cpustats[up_cpu_index()];
+  stats->nallocs++;
+  stats->allocbytes += node->size;
+
+  up_irq_restore(flags);
+}
+
+void mm_cpustats_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_cpustats_s *stats;
+  irqstate_t flags;
+
+  node  = (FAR struct mm_allocnode_s *)((FAR char *)mem -
+                                        SIZEOF_MM_ALLOCNODE);
+  flags = up_irq_save();
+
+  stats = &heap->mm_cpustats[up_cpu_index()];
+  stats->nfrees++;
+  stats->freebytes += node->size;
+
+  up_irq_restore(flags);
+}
+#endif
+
+#endif /* CONFIG_MM_FRAGSTATS */
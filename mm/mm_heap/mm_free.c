@@ -53,6 +53,23 @@
 static void mm_add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
 {
   FAR struct mm_delaynode_s *tmp = mem;
+#ifdef CONFIG_MM_DELAYLIST_LOCKFREE
+  FAR struct mm_delaynode_s *head;
+
+  /* Delay the deallocation until a more appropriate time.  Push the node
+   * onto the delay list with compare-and-swap.  There is no ABA problem
+   * because nodes are only ever removed all at once.
+   */
+
+  head = __atomic_load_n(&heap->mm_delaylist, __ATOMIC_RELAXED);
+  do
+    {
+      tmp->flink = head;
+    }
+  while (!__atomic_compare_exchange_n(&heap->mm_delaylist, &head, tmp,
+                                      true, __ATOMIC_RELEASE,
+                                      __ATOMIC_RELAXED));
+#else
   irqstate_t flags;
 
   /* Delay the deallocation until a more appropriate time. */
@@ -63,9 +80,89 @@ static void mm_add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
   heap->mm_delaylist = tmp;
 
   leave_critical_section(flags);
+#endif
 }
 #endif
 
+/****************************************************************************
+ * Name: mm_freechunk
+ *
+ * Description:
+ *   Return one chunk to the list of free nodes, merging it with adjacent
+ *   free chunks if possible.  The caller must hold the MM semaphore.
+ *
+ ****************************************************************************/
+
+static void mm_freechunk(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_freenode_s *node;
+  FAR struct mm_freenode_s *prev;
+  FAR struct mm_freenode_s *next;
+
+  DEBUGASSERT(mm_heapmember(heap, mem));
+
+  /* Map the memory chunk into a free node */
+
+  node = (FAR struct mm_freenode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+
+  /* Sanity check against double-frees */
+
+  DEBUGASSERT(node->preceding & MM_ALLOC_BIT);
+
+  node->preceding &= ~MM_ALLOC_BIT;
+
+  /* Check if the following node is free and, if so, merge it */
+
+  next = (FAR struct mm_freenode_s *)((FAR char *)node + node->size);
+  DEBUGASSERT((next->preceding & ~MM_ALLOC_BIT) == node->size);
+  if ((next->preceding & MM_ALLOC_BIT) == 0)
+    {
+      FAR struct mm_allocnode_s *andbeyond;
+
+      /* Get the node following the next node (which will
+       * become the new next node). We know that we can never
+       * index past the tail chunk because it is always allocated.
+       */
+
+      andbeyond = (FAR struct mm_allocnode_s *)
+                    ((FAR char *)next + next->size);
+
+      /* Remove the next node from the free list */
+
+      mm_delfreechunk(heap, next);
+
+      /* Then merge the two chunks */
+
+      node->size          += next->size;
+      andbeyond->preceding =  node->size |
+                              (andbeyond->preceding & MM_ALLOC_BIT);
+      next                 = (FAR struct mm_freenode_s *)andbeyond;
+    }
+
+  /* Check if the preceding node is also free and, if so, merge
+   * it with this node
+   */
+
+  prev = (FAR struct mm_freenode_s *)((FAR char *)node - node->preceding);
+  DEBUGASSERT((node->preceding & ~MM_ALLOC_BIT) == prev->size);
+  if ((prev->preceding & MM_ALLOC_BIT) == 0)
+    {
+      /* Remove the previous node from the free list */
+
+      mm_delfreechunk(heap, prev);
+
+      /* Then merge the two chunks */
+
+      prev->size     += node->size;
+      next->preceding = prev->size | (next->preceding & MM_ALLOC_BIT);
+      node            = prev;
+    }
+
+  /* Add the merged node to the nodelist */
+
+  mm_addfreechunk(heap, node);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -81,9 +178,10 @@ static void mm_add_delaylist(FAR struct mm_heap_s *heap, FAR void *mem)
 
 void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 {
-  FAR struct mm_freenode_s *node;
-  FAR struct mm_freenode_s *prev;
-  FAR struct mm_freenode_s *next;
+#ifdef MM_HAVE_CPUCACHE
+  FAR struct mm_delaynode_s *drain = NULL;
+  size_t cachesize = 0;
+#endif
   int ret;
 
   UNUSED(ret);
@@ -96,6 +194,33 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
       return;
     }
 
+#ifdef MM_HAVE_PROFILE
+  /* Account for the free now, even if the chunk is only released later */
+
+  mm_profile_free(heap, mem);
+#endif
+
+#ifdef MM_HAVE_CPUCACHE
+  /* Small chunks are retained in the cache of this CPU if there is room.
+   * That does not require the MM semaphore.
+   */
+
+  if (mm_cache_free(heap, mem))
+    {
+#ifdef MM_HAVE_CPUSTATS
+      mm_cpustats_free(heap, mem);
+#endif
+      return;
+    }
+
+  cachesize = ((FAR struct mm_allocnode_s *)
+               ((FAR char *)mem - SIZEOF_MM_ALLOCNODE))->size;
+  if (cachesize > MM_CACHE_MAXSIZE)
+    {
+      cachesize = 0;
+    }
+#endif
+
 #if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
   /* Check current environment */
 
@@ -130,81 +255,34 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
       mm_takesemaphore(heap);
     }
 
-  DEBUGASSERT(mm_heapmember(heap, mem));
-
-  /* Map the memory chunk into a free node */
-
-  node = (FAR struct mm_freenode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
-
-  /* Sanity check against double-frees */
-
-  DEBUGASSERT(node->preceding & MM_ALLOC_BIT);
-
-  node->preceding &= ~MM_ALLOC_BIT;
-
-  /* Check if the following node is free and, if so, merge it */
+#ifdef MM_HAVE_CPUCACHE
+  /* The cache of this CPU is full.  Return a batch of cached chunks of
+   * the same size along with this one so that the semaphore is taken only
+   * once for the whole batch.
+   */
 
-  next = (FAR struct mm_freenode_s *)((FAR char *)node + node->size);
-  DEBUGASSERT((next->preceding & ~MM_ALLOC_BIT) == node->size);
-  if ((next->preceding & MM_ALLOC_BIT) == 0)
+  if (cachesize > 0)
     {
-      FAR struct mm_allocnode_s *andbeyond;
-
-      /* Get the node following the next node (which will
-       * become the new next node). We know that we can never
-       * index past the tail chunk because it is always allocated.
-       */
-
-      andbeyond = (FAR struct mm_allocnode_s *)
-                    ((FAR char *)next + next->size);
-
-      /* Remove the next node.  There must be a predecessor,
-       * but there may not be a successor node.
-       */
-
-      DEBUGASSERT(next->blink);
-      next->blink->flink = next->flink;
-      if (next->flink)
-        {
-          next->flink->blink = next->blink;
-        }
-
-      /* Then merge the two chunks */
-
-      node->size          += next->size;
-      andbeyond->preceding =  node->size |
-                              (andbeyond->preceding & MM_ALLOC_BIT);
-      next                 = (FAR struct mm_freenode_s *)andbeyond;
+      drain = mm_cache_drain(heap, cachesize);
     }
+#endif
 
-  /* Check if the preceding node is also free and, if so, merge
-   * it with this node
-   */
-
-  prev = (FAR struct mm_freenode_s *)((FAR char *)node - node->preceding);
-  DEBUGASSERT((node->preceding & ~MM_ALLOC_BIT) == prev->size);
-  if ((prev->preceding & MM_ALLOC_BIT) == 0)
-    {
-      /* Remove the node.  There must be a predecessor, but there may
-       * not be a successor node.
-       */
+#ifdef MM_HAVE_CPUSTATS
+  /* Frees from the delay list are only counted here, when they are done */
 
-      DEBUGASSERT(prev->blink);
-      prev->blink->flink = prev->flink;
-      if (prev->flink)
-        {
-          prev->flink->blink = prev->blink;
-        }
+  mm_cpustats_free(heap, mem);
+#endif
 
-      /* Then merge the two chunks */
+  mm_freechunk(heap, mem);
 
-      prev->size     += node->size;
-      next->preceding = prev->size | (next->preceding & MM_ALLOC_BIT);
-      node            = prev;
+#ifdef MM_HAVE_CPUCACHE
+  while (drain != NULL)
+    {
+      mem   = drain;
+      drain = drain->flink;
+      mm_freechunk(heap, mem);
     }
+#endif
 
-  /* Add the merged node to the nodelist */
-
-  mm_addfreechunk(heap, node);
   mm_givesemaphore(heap);
 }
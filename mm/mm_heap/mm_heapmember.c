@@ -101,3 +101,39 @@ bool mm_heapmember(FAR struct mm_heap_s *heap, FAR void *mem)
 
 #endif
 }
+
+/****************************************************************************
+ * Name: mm_regionattr
+ *
+ * Description:
+ *   Return the placement attributes of the heap region that holds an
+ *   address.
+ *
+ * Parameters:
+ *   heap - The heap to check
+ *   mem  - The address to check
+ *
+ * Return Value:
+ *   The MALLOC_ATTR_* attributes of the region or zero if the address is
+ *   not a member of the heap.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REGION_ATTR
+int mm_regionattr(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  int i;
+
+  for (i = 0; i < heap->mm_nregions; i++)
+    {
+      if (mem > (FAR void *)heap->mm_heapstart[i] &&
+          mem < (FAR void *)heap->mm_heapend[i])
+        {
+          return heap->mm_regattr[i];
+        }
+    }
+
+  return 0;
+}
+#endif
+
@@ -35,15 +35,18 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: mm_addregion
+ * Name: mm_addregion and mm_addregion_attr
  *
  * Description:
  *   This function adds a region of contiguous memory to the selected heap.
+ *   If CONFIG_MM_REGION_ATTR is selected, mm_addregion_attr() also gives
+ *   the placement attributes of the region.
  *
  * Input Parameters:
  *   heap      - The selected heap
  *   heapstart - Start of the heap region
  *   heapsize  - Size of the heap region
+ *   attr      - The MALLOC_ATTR_* attributes of the region
  *
  * Returned Value:
  *   None
@@ -52,8 +55,13 @@
  *
  ****************************************************************************/
 
+#ifdef CONFIG_MM_REGION_ATTR
+void mm_addregion_attr(FAR struct mm_heap_s *heap, FAR void *heapstart,
+                       size_t heapsize, int attr)
+#else
 void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
                   size_t heapsize)
+#endif
 {
   FAR struct mm_freenode_s *node;
   uintptr_t heapbase;
@@ -118,6 +126,11 @@ void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
   heap->mm_heapend[IDX]->size        = SIZEOF_MM_ALLOCNODE;
   heap->mm_heapend[IDX]->preceding   = node->size | MM_ALLOC_BIT;
 
+#ifdef CONFIG_MM_REGION_ATTR
+  heap->mm_regattr[IDX] = (uint8_t)attr;
+  heap->mm_allattr     |= (uint8_t)attr;
+#endif
+
 #undef IDX
 
 #if CONFIG_MM_REGIONS > 1
@@ -129,6 +142,14 @@ void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
   mm_addfreechunk(heap, node);
 }
 
+#ifdef CONFIG_MM_REGION_ATTR
+void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
+                  size_t heapsize)
+{
+  mm_addregion_attr(heap, heapstart, heapsize, 0);
+}
+#endif
+
 /****************************************************************************
  * Name: mm_initialize
  *
@@ -151,7 +172,9 @@ void mm_addregion(FAR struct mm_heap_s *heap, FAR void *heapstart,
 void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
                    size_t heapsize)
 {
+#ifndef CONFIG_MM_TLSF
   int i;
+#endif
 
   minfo("Heap: start=%p size=%u\n", heapstart, heapsize);
 
@@ -175,10 +198,35 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
   heap->mm_nregions = 0;
 #endif
 
+#ifdef CONFIG_MM_REGION_ATTR
+  heap->mm_allattr  = 0;
+#endif
+
   /* Initialize mm_delaylist */
 
   heap->mm_delaylist = NULL;
 
+#ifdef CONFIG_MM_CPUCACHE
+  /* Initialize the per-CPU chunk caches */
+
+  memset(heap->mm_cache, 0, sizeof(heap->mm_cache));
+#endif
+
+#ifdef CONFIG_MM_FRAGSTATS
+  /* Reset the free chunk statistics */
+
+  memset(heap->mm_fragnfree, 0, sizeof(heap->mm_fragnfree));
+  memset(heap->mm_fragbytes, 0, sizeof(heap->mm_fragbytes));
+#ifdef MM_HAVE_CPUSTATS
+  memset(heap->mm_cpustats, 0, sizeof(heap->mm_cpustats));
+#endif
+#endif
+
+#ifdef CONFIG_MM_TLSF
+  /* Initialize the segregated free lists */
+
+  mm_tlsf_initialize(heap);
+#else
   /* Initialize the node array */
 
   memset(heap->mm_nodelist, 0, sizeof(struct mm_freenode_s) * MM_NNODES);
@@ -187,6 +235,7 @@ void mm_initialize(FAR struct mm_heap_s *heap, FAR void *heapstart,
       heap->mm_nodelist[i - 1].flink = &heap->mm_nodelist[i];
       heap->mm_nodelist[i].blink     = &heap->mm_nodelist[i - 1];
     }
+#endif
 
   /* Initialize the malloc semaphore to one (to support one-at-
    * a-time access to private data sets).
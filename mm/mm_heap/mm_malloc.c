@@ -46,6 +46,8 @@
 
 #include <nuttx/arch.h>
 #include <nuttx/mm/mm.h>
+#include <nuttx/sched.h>
+#include <nuttx/sched_note.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -55,24 +57,75 @@
 #  define NULL ((void *)0)
 #endif
 
+/* The call site that is recorded by the profiler */
+
+#ifdef MM_HAVE_PROFILE
+#  define MM_CALLER() MM_PROFILE_CALLER()
+#else
+#  define MM_CALLER() NULL
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: mm_taskattr
+ *
+ * Description:
+ *   Return the default placement of the allocations of the current task in
+ *   'heap':  The attributes of the task as a preference or zero if the
+ *   heap has no regions with attributes.
+ *
+ ****************************************************************************/
+
+#ifdef MM_HAVE_TASKATTR
+static inline int mm_taskattr(FAR struct mm_heap_s *heap)
+{
+  int attr;
+
+  if (heap->mm_allattr == 0)
+    {
+      return 0;
+    }
+
+  attr = nxsched_self()->mmattr;
+  return attr != 0 ? attr | MM_ATTR_PREFER : 0;
+}
+#else
+#  define mm_taskattr(heap) 0
+#endif
+
 static void mm_free_delaylist(FAR struct mm_heap_s *heap)
 {
 #if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
   FAR struct mm_delaynode_s *tmp;
+#ifndef CONFIG_MM_DELAYLIST_LOCKFREE
   irqstate_t flags;
+#endif
+
+  /* Nothing to do if the delay list is empty.  This unprotected check is
+   * safe:  A node that is added concurrently will just be freed by the
+   * next allocation.
+   */
+
+  if (*(FAR struct mm_delaynode_s * volatile *)&heap->mm_delaylist == NULL)
+    {
+      return;
+    }
 
   /* Move the delay list to local */
 
+#ifdef CONFIG_MM_DELAYLIST_LOCKFREE
+  tmp = __atomic_exchange_n(&heap->mm_delaylist, NULL, __ATOMIC_ACQUIRE);
+#else
   flags = enter_critical_section();
 
   tmp = heap->mm_delaylist;
   heap->mm_delaylist = NULL;
 
   leave_critical_section(flags);
+#endif
 
   /* Test if the delayed is empty */
 
@@ -95,99 +148,52 @@ static void mm_free_delaylist(FAR struct mm_heap_s *heap)
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: mm_malloc
+ * Name: mm_allocchunk
  *
  * Description:
- *  Find the smallest chunk that satisfies the request. Take the memory from
- *  that chunk, save the remaining, smaller chunk (if any).
- *
- *  8-byte alignment of the allocated data is assured.
+ *   Find a free chunk that can hold 'alignsize' bytes in a region with the
+ *   placement attributes 'attr' (if any), remove it from the free list and
+ *   split off the remainder.  The caller must hold the MM semaphore.
  *
  ****************************************************************************/
 
-FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+static FAR void *mm_allocchunk(FAR struct mm_heap_s *heap, size_t alignsize,
+                               int attr)
 {
   FAR struct mm_freenode_s *node;
-  size_t alignsize;
   void *ret = NULL;
-  int ndx;
-
-  /* Firstly, free mm_delaylist */
-
-  mm_free_delaylist(heap);
-
-  /* Ignore zero-length allocations */
-
-  if (size < 1)
-    {
-      return NULL;
-    }
 
-  /* Adjust the size to account for (1) the size of the allocated node and
-   * (2) to make sure that it is an even multiple of our granule size.
+  /* Find the chunk to use.  If CONFIG_MM_TLSF is selected, this is done in
+   * constant time.  Otherwise the smallest chunk that satisfies the request
+   * is located.
    */
 
-  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
-  DEBUGASSERT(alignsize >= size);  /* Check for integer overflow */
-  DEBUGASSERT(alignsize >= MM_MIN_CHUNK);
-  DEBUGASSERT(alignsize >= SIZEOF_MM_FREENODE);
-
-  /* We need to hold the MM semaphore while we muck with the nodelist. */
-
-  mm_takesemaphore(heap);
-
-  /* Get the location in the node list to start the search. Special case
-   * really big allocations
-   */
-
-  if (alignsize >= MM_MAX_CHUNK)
+#ifdef CONFIG_MM_REGION_ATTR
+  if ((attr & ~MM_ATTR_PREFER) != 0)
     {
-      ndx = MM_NNODES - 1;
+      node = mm_findfreechunk_attr(heap, alignsize, attr & ~MM_ATTR_PREFER);
+      if (node == NULL && (attr & MM_ATTR_PREFER) != 0)
+        {
+          node = mm_findfreechunk(heap, alignsize);
+        }
     }
   else
+#else
+  UNUSED(attr);
+#endif
     {
-      /* Convert the request size into a nodelist index */
-
-      ndx = mm_size2ndx(alignsize);
-    }
-
-  /* Search for a large enough chunk in the list of nodes. This list is
-   * ordered by size, but will have occasional zero sized nodes as we visit
-   * other mm_nodelist[] entries.
-   */
-
-  for (node = heap->mm_nodelist[ndx].flink;
-       node && node->size < alignsize;
-       node = node->flink)
-    {
-      DEBUGASSERT(node->blink->flink == node);
+      node = mm_findfreechunk(heap, alignsize);
     }
 
-  /* If we found a node with non-zero size, then this is one to use. Since
-   * the list is ordered, we know that is must be best fitting chunk
-   * available.
-   */
-
   if (node)
     {
       FAR struct mm_freenode_s *remainder;
       FAR struct mm_freenode_s *next;
       size_t remaining;
 
-      /* Remove the node.  There must be a predecessor, but there may not be
-       * a successor node.
-       */
+      /* Remove the node from the free list */
 
-      DEBUGASSERT(node->blink);
-      node->blink->flink = node->flink;
-      if (node->flink)
-        {
-          node->flink->blink = node->blink;
-        }
+      mm_delfreechunk(heap, node);
 
       /* Check if we have to split the free node into one of the allocated
        * size and another smaller freenode.  In some cases, the remaining
@@ -233,8 +239,100 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
       ret = (void *)((FAR char *)node + SIZEOF_MM_ALLOCNODE);
     }
 
-  DEBUGASSERT(ret == NULL || mm_heapmember(heap, ret));
-  mm_givesemaphore(heap);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_mallocattr
+ *
+ * Description:
+ *   Allocate 'size' bytes in a region with the placement attributes 'attr'
+ *   and record the allocation for the call site 'caller'.
+ *
+ ****************************************************************************/
+
+static FAR void *mm_mallocattr(FAR struct mm_heap_s *heap, size_t size,
+                               int attr, FAR void *caller)
+{
+  size_t alignsize;
+  void *ret;
+
+#ifndef MM_HAVE_PROFILE
+  UNUSED(caller);
+#endif
+
+  /* Firstly, free mm_delaylist */
+
+  mm_free_delaylist(heap);
+
+  /* Ignore zero-length allocations */
+
+  if (size < 1)
+    {
+      return NULL;
+    }
+
+  sched_trace_begin(NOTE_TRACE_MM, heap);
+
+  /* Adjust the size to account for (1) the size of the allocated node and
+   * (2) to make sure that it is an even multiple of our granule size.
+   */
+
+  alignsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE + SIZEOF_MM_PROFTAIL);
+  DEBUGASSERT(alignsize >= size);  /* Check for integer overflow */
+  DEBUGASSERT(alignsize >= MM_MIN_CHUNK);
+  DEBUGASSERT(alignsize >= SIZEOF_MM_FREENODE);
+
+#ifdef MM_HAVE_CPUCACHE
+  /* Try the cache of this CPU first.  That does not require the MM
+   * semaphore.  The cached chunks may come from any region.
+   */
+
+  ret = attr == 0 ? mm_cache_alloc(heap, alignsize) : NULL;
+  if (ret == NULL)
+#endif
+    {
+      /* We need to hold the MM semaphore while we muck with the
+       * nodelist.
+       */
+
+      mm_takesemaphore(heap);
+      ret = mm_allocchunk(heap, alignsize, attr);
+
+#ifdef MM_HAVE_CPUCACHE
+      /* The cache of this CPU was empty.  Refill it with a batch of chunks
+       * of the same size while we already hold the semaphore.
+       */
+
+      if (ret != NULL && attr == 0 && alignsize <= MM_CACHE_MAXSIZE)
+        {
+          FAR void *extra;
+          int i;
+
+          for (i = 1; i < CONFIG_MM_CPUCACHE_BATCH; i++)
+            {
+              extra = mm_allocchunk(heap, alignsize, 0);
+              if (extra == NULL)
+                {
+                  break;
+                }
+
+#ifdef MM_HAVE_PROFILE
+              mm_profile_ignore(extra);
+#endif
+
+              if (!mm_cache_free(heap, extra))
+                {
+                  mm_free(heap, extra);
+                  break;
+                }
+            }
+        }
+#endif
+
+      DEBUGASSERT(ret == NULL || mm_heapmember(heap, ret));
+      mm_givesemaphore(heap);
+    }
 
 #ifdef CONFIG_MM_FILL_ALLOCATIONS
   if (ret)
@@ -243,6 +341,27 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
     }
 #endif
 
+#ifdef MM_HAVE_CPUSTATS
+  if (ret)
+    {
+      mm_cpustats_alloc(heap, ret);
+    }
+#endif
+
+#ifdef MM_HAVE_PROFILE
+  if (ret)
+    {
+      if (caller != NULL)
+        {
+          mm_profile_alloc(heap, ret, size, caller);
+        }
+      else
+        {
+          mm_profile_ignore(ret);
+        }
+    }
+#endif
+
   /* If CONFIG_DEBUG_MM is defined, then output the result of the allocation
    * to the SYSLOG.
    */
@@ -258,5 +377,62 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
     }
 #endif
 
+  sched_trace_end(NOTE_TRACE_MM, heap);
   return ret;
 }
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_malloc and mm_malloc_caller
+ *
+ * Description:
+ *  Find the smallest chunk that satisfies the request. Take the memory from
+ *  that chunk, save the remaining, smaller chunk (if any).
+ *
+ *  8-byte alignment of the allocated data is assured.
+ *
+ *  If CONFIG_MM_PROFILE is selected, mm_malloc_caller() records the
+ *  allocation for the call site 'caller'.  Other allocation functions use
+ *  it to pass on their own caller.  If 'caller' is NULL, the allocation is
+ *  not recorded.
+ *
+ *  If CONFIG_MM_REGION_ATTR is selected, the chunk is taken from a region
+ *  with the default placement attributes of the task if possible.
+ *
+ ****************************************************************************/
+
+#ifdef MM_HAVE_PROFILE
+FAR void *mm_malloc_caller(FAR struct mm_heap_s *heap, size_t size,
+                           FAR void *caller)
+{
+  return mm_mallocattr(heap, size, mm_taskattr(heap), caller);
+}
+#endif
+
+FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
+{
+  return mm_mallocattr(heap, size, mm_taskattr(heap), MM_CALLER());
+}
+
+/****************************************************************************
+ * Name: mm_malloc_attr
+ *
+ * Description:
+ *   Allocate memory only from the regions of the heap that have all of the
+ *   placement attributes 'attr'.  The allocation fails if those regions
+ *   cannot satisfy the request unless MM_ATTR_PREFER is also set.  If
+ *   'attr' is zero, this is the same as mm_malloc() without the default
+ *   placement of the task.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REGION_ATTR
+FAR void *mm_malloc_attr(FAR struct mm_heap_s *heap, size_t size,
+                         int attr)
+{
+  return mm_mallocattr(heap, size, attr, MM_CALLER());
+}
+#endif
@@ -68,6 +68,10 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
   size_t alignedchunk;
   size_t mask = (size_t)(alignment - 1);
   size_t allocsize;
+#ifdef MM_HAVE_PROFILE
+  FAR void *caller = MM_PROFILE_CALLER();
+  size_t reqsize = size;
+#endif
 
   /* If this requested alinement's less than or equal to the natural alignment
    * of malloc, then just let malloc do the work.
@@ -75,7 +79,11 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
 
   if (alignment <= MM_MIN_CHUNK)
     {
+#ifdef MM_HAVE_PROFILE
+      return mm_malloc_caller(heap, size, caller);
+#else
       return mm_malloc(heap, size);
+#endif
     }
 
   /* Adjust the size to account for (1) the size of the allocated node, (2)
@@ -87,15 +95,20 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
    * alignment points within the allocated memory.
    *
    * NOTE:  These are sizes given to malloc and not chunk sizes. They do
-   * not include SIZEOF_MM_ALLOCNODE.
+   * not include SIZEOF_MM_ALLOCNODE but they do include the profiler
+   * record, if any.
    */
 
-  size      = MM_ALIGN_UP(size);   /* Make multiples of our granule size */
+  size      = MM_ALIGN_UP(size + SIZEOF_MM_PROFTAIL);
   allocsize = size + 2*alignment;  /* Add double full alignment size */
 
-  /* Then malloc that size */
+  /* Then malloc that size.  The aligned chunk is profiled below */
 
+#ifdef MM_HAVE_PROFILE
+  rawchunk = (size_t)mm_malloc_caller(heap, allocsize, NULL);
+#else
   rawchunk = (size_t)mm_malloc(heap, allocsize);
+#endif
   if (rawchunk == 0)
     {
       return NULL;
@@ -208,5 +221,10 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment,
     }
 
   mm_givesemaphore(heap);
+
+#ifdef MM_HAVE_PROFILE
+  mm_profile_alloc(heap, (FAR void *)alignedchunk, reqsize, caller);
+#endif
+
   return (FAR void *)alignedchunk;
 }
@@ -0,0 +1,377 @@
+/****************************************************************************
+ * mm/mm_heap/mm_profile.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/irq.h>
+#include <nuttx/mm/mm.h>
+
+#ifdef MM_HAVE_PROFILE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_profile_tail
+ *
+ * Description:
+ *   Return the profiler record at the end of an allocated chunk.
+ *
+ ****************************************************************************/
+
+static inline FAR struct mm_proftail_s *mm_profile_tail(FAR void *mem)
+{
+  FAR struct mm_allocnode_s *node;
+
+  node = (FAR struct mm_allocnode_s *)
+         ((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+  DEBUGASSERT(node->size >= SIZEOF_MM_ALLOCNODE + SIZEOF_MM_PROFTAIL);
+
+  return (FAR struct mm_proftail_s *)
+         ((FAR char *)node + node->size - SIZEOF_MM_PROFTAIL);
+}
+
+/****************************************************************************
+ * Name: mm_profile_bucket
+ *
+ * Description:
+ *   Return the histogram bucket for a requested size.  Bucket n holds the
+ *   sizes from 2^n up to 2^(n+1) - 1.
+ *
+ ****************************************************************************/
+
+static inline int mm_profile_bucket(size_t size)
+{
+  int bucket = flsl((long)size) - 1;
+
+  return bucket < MM_PROFILE_NBUCKETS ? bucket : MM_PROFILE_NBUCKETS - 1;
+}
+
+/****************************************************************************
+ * Name: mm_profile_lookup
+ *
+ * Description:
+ *   Find the site entry of a caller, creating it if necessary.  The caller
+ *   must be in the critical section.
+ *
+ * Returned Value:
+ *   The index of the site entry or MM_PROFILE_NOSITE if the table is full.
+ *
+ ****************************************************************************/
+
+static int mm_profile_lookup(FAR struct mm_heap_s *heap, FAR void *caller)
+{
+  FAR struct mm_profsite_s *site;
+  int ndx;
+  int i;
+
+  if (caller == NULL)
+    {
+      return MM_PROFILE_NOSITE;
+    }
+
+  ndx = ((uintptr_t)caller >> 2) % CONFIG_MM_PROFILE_NSITES;
+  for (i = 0; i < CONFIG_MM_PROFILE_NSITES; i++)
+    {
+      site = &heap->mm_profsite[ndx];
+      if (site->caller == caller)
+        {
+          return ndx;
+        }
+      else if (site->caller == NULL)
+        {
+          site->caller = caller;
+          return ndx;
+        }
+
+      if (++ndx >= CONFIG_MM_PROFILE_NSITES)
+        {
+          ndx = 0;
+        }
+    }
+
+  return MM_PROFILE_NOSITE;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_profile_alloc
+ *
+ * Description:
+ *   Record a new allocation.  The chunk must have been allocated with
+ *   SIZEOF_MM_PROFTAIL additional bytes.
+ *
+ * Input Parameters:
+ *   heap   - The selected heap
+ *   mem    - The allocated memory
+ *   size   - The size that was requested by the caller
+ *   caller - The call site
+ *
+ ****************************************************************************/
+
+void mm_profile_alloc(FAR struct mm_heap_s *heap, FAR void *mem,
+                      size_t size, FAR void *caller)
+{
+  FAR struct mm_proftail_s *tail = mm_profile_tail(mem);
+  FAR struct mm_profsite_s *site;
+  irqstate_t flags;
+  int ndx;
+
+  flags = enter_critical_section();
+
+  ndx          = mm_profile_lookup(heap, caller);
+  tail->tstamp = (uint32_t)clock_systime_ticks();
+  tail->size   = (uint32_t)size;
+  tail->pid    = getpid();
+  tail->site   = (uint16_t)ndx;
+
+  if (ndx == MM_PROFILE_NOSITE)
+    {
+      heap->mm_profdropped++;
+    }
+  else
+    {
+      site            = &heap->mm_profsite[ndx];
+      site->nallocs++;
+      site->curbytes += size;
+      if (site->curbytes > site->maxbytes)
+        {
+          site->maxbytes = site->curbytes;
+        }
+
+      site->hist[mm_profile_bucket(size)]++;
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: mm_profile_free
+ *
+ * Description:
+ *   Record that an allocation is freed.  Nothing is recorded if the chunk
+ *   was already accounted as free (as when a free is deferred to the delay
+ *   list and later completed).
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   mem  - The memory being freed
+ *
+ ****************************************************************************/
+
+void mm_profile_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+  FAR struct mm_proftail_s *tail = mm_profile_tail(mem);
+  FAR struct mm_profsite_s *site;
+  irqstate_t flags;
+  uint32_t life;
+
+  flags = enter_critical_section();
+
+  if (tail->site < CONFIG_MM_PROFILE_NSITES)
+    {
+      site            = &heap->mm_profsite[tail->site];
+      life            = (uint32_t)clock_systime_ticks() - tail->tstamp;
+
+      site->nfrees++;
+      site->curbytes -= tail->size;
+      site->lifetime += life;
+      if (life > site->maxlife)
+        {
+          site->maxlife = life;
+        }
+    }
+
+  tail->site = MM_PROFILE_NOSITE;
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: mm_profile_ignore
+ *
+ * Description:
+ *   Mark an allocated chunk that is not handed to a caller (such as a
+ *   chunk placed in a CPU cache) as not profiled.
+ *
+ ****************************************************************************/
+
+void mm_profile_ignore(FAR void *mem)
+{
+  mm_profile_tail(mem)->site = MM_PROFILE_NOSITE;
+}
+
+/****************************************************************************
+ * Name: mm_profile_site
+ *
+ * Description:
+ *   Return a snapshot of the statistics of one call site.
+ *
+ * Input Parameters:
+ *   heap - The selected heap
+ *   ndx  - The index of the site, 0 .. CONFIG_MM_PROFILE_NSITES - 1
+ *   site - The location to return the statistics
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOENT is returned if the entry is
+ *   not in use and -EINVAL if the index is out of range.
+ *
+ ****************************************************************************/
+
+int mm_profile_site(FAR struct mm_heap_s *heap, int ndx,
+                    FAR struct mm_profsite_s *site)
+{
+  irqstate_t flags;
+  int ret = -ENOENT;
+
+  if (ndx < 0 || ndx >= CONFIG_MM_PROFILE_NSITES)
+    {
+      return -EINVAL;
+    }
+
+  flags = enter_critical_section();
+
+  if (heap->mm_profsite[ndx].caller != NULL)
+    {
+      memcpy(site, &heap->mm_profsite[ndx], sizeof(struct mm_profsite_s));
+      ret = OK;
+    }
+
+  leave_critical_section(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mm_profile_pids
+ *
+ * Description:
+ *   Walk the heap and sum up the live profiled allocations of each task.
+ *
+ * Input Parameters:
+ *   heap  - The selected heap
+ *   pids  - The location to return the per-task sums
+ *   npids - The number of entries in pids[].  Tasks beyond this number are
+ *           not reported.
+ *
+ * Returned Value:
+ *   The number of entries of pids[] that were filled in.
+ *
+ ****************************************************************************/
+
+int mm_profile_pids(FAR struct mm_heap_s *heap,
+                    FAR struct mm_profpid_s *pids, int npids)
+{
+  FAR struct mm_allocnode_s *node;
+  FAR struct mm_proftail_s *tail;
+  irqstate_t flags;
+  uint32_t size;
+  pid_t pid;
+  int count = 0;
+  int i;
+#if CONFIG_MM_REGIONS > 1
+  int region;
+#else
+# define region 0
+#endif
+
+  /* Visit each region */
+
+#if CONFIG_MM_REGIONS > 1
+  for (region = 0; region < heap->mm_nregions; region++)
+#endif
+    {
+      /* Retake the semaphore for each region to reduce latencies */
+
+      mm_takesemaphore(heap);
+
+      for (node = heap->mm_heapstart[region];
+           node < heap->mm_heapend[region];
+           node = (FAR struct mm_allocnode_s *)
+                  ((FAR char *)node + node->size))
+        {
+          if ((node->preceding & MM_ALLOC_BIT) == 0 ||
+              node->size < SIZEOF_MM_ALLOCNODE + SIZEOF_MM_PROFTAIL)
+            {
+              continue;
+            }
+
+          /* The record may be updated from an interrupt handler */
+
+          tail  = (FAR struct mm_proftail_s *)
+                  ((FAR char *)node + node->size - SIZEOF_MM_PROFTAIL);
+          flags = enter_critical_section();
+
+          if (tail->site >= CONFIG_MM_PROFILE_NSITES)
+            {
+              leave_critical_section(flags);
+              continue;
+            }
+
+          pid  = tail->pid;
+          size = tail->size;
+          leave_critical_section(flags);
+
+          for (i = 0; i < count; i++)
+            {
+              if (pids[i].pid == pid)
+                {
+                  break;
+                }
+            }
+
+          if (i >= count)
+            {
+              if (count >= npids)
+                {
+                  continue;
+                }
+
+              pids[i].pid   = pid;
+              pids[i].nblks = 0;
+              pids[i].bytes = 0;
+              count++;
+            }
+
+          pids[i].nblks++;
+          pids[i].bytes += size;
+        }
+
+      mm_givesemaphore(heap);
+    }
+#undef region
+
+  return count;
+}
+
+#endif /* MM_HAVE_PROFILE */
@@ -54,6 +54,9 @@
  * Name: mm_realloc
  *
  * Description:
+ *   If the reallocation is for the same (aligned) size, the original
+ *   allocation is returned without taking the MM semaphore.
+ *
  *   If the reallocation is for less space, then:
  *
  *     (1) the current allocation is reduced in size
@@ -64,8 +67,12 @@
  *  extended, it will be extended by:
  *
  *     (1) Taking the additional space from the following free chunk, or
- *     (2) Taking the additional space from the preceding free chunk.
- *     (3) Or both
+ *     (2) Taking the rest of the additional space from the preceding free
+ *         chunk if the following chunk is not large enough.
+ *
+ *  The following chunk is preferred because the data does not move.  If
+ *  the preceding chunk is used, the data is moved after the MM semaphore
+ *  has been released.
  *
  *  If the request is for more space but the current chunk cannot be
  *  extended, then malloc a new buffer, copy the data into the new buffer,
@@ -84,12 +91,20 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
   size_t prevsize = 0;
   size_t nextsize = 0;
   FAR void *newmem;
+#ifdef MM_HAVE_PROFILE
+  FAR void *caller = MM_PROFILE_CALLER();
+  size_t reqsize = size;
+#endif
 
   /* If oldmem is NULL, then realloc is equivalent to malloc */
 
   if (oldmem == NULL)
     {
+#ifdef MM_HAVE_PROFILE
+      return mm_malloc_caller(heap, size, caller);
+#else
       return mm_malloc(heap, size);
+#endif
     }
 
   /* If size is zero, then realloc is equivalent to free */
@@ -104,13 +119,31 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
    * (2) to make sure that it is an even multiple of our granule size.
    */
 
-  newsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE);
+  newsize = MM_ALIGN_UP(size + SIZEOF_MM_ALLOCNODE + SIZEOF_MM_PROFTAIL);
 
   /* Map the memory chunk into an allocated node structure */
 
   oldnode = (FAR struct mm_allocnode_s *)
     ((FAR char *)oldmem - SIZEOF_MM_ALLOCNODE);
 
+  /* Handle the special case where we are not going to change the size of
+   * the allocation.  The size of an allocated chunk is only changed by its
+   * owner, so this does not require the MM semaphore.
+   */
+
+  oldsize = oldnode->size;
+  if (newsize == oldsize)
+    {
+      DEBUGASSERT(oldnode->preceding & MM_ALLOC_BIT);
+
+#ifdef MM_HAVE_PROFILE
+      mm_profile_free(heap, oldmem);
+      mm_profile_alloc(heap, oldmem, reqsize, caller);
+#endif
+
+      return oldmem;
+    }
+
   /* We need to hold the MM semaphore while we muck with the nodelist. */
 
   mm_takesemaphore(heap);
@@ -119,21 +152,22 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
 
   /* Check if this is a request to reduce the size of the allocation. */
 
-  oldsize = oldnode->size;
-  if (newsize <= oldsize)
+  if (newsize < oldsize)
     {
-      /* Handle the special case where we are not going to change the size
-       * of the allocation.
-       */
+#ifdef MM_HAVE_PROFILE
+      mm_profile_free(heap, oldmem);
+#endif
 
-      if (newsize < oldsize)
-        {
-          mm_shrinkchunk(heap, oldnode, newsize);
-        }
+      mm_shrinkchunk(heap, oldnode, newsize);
 
       /* Then return the original address */
 
       mm_givesemaphore(heap);
+
+#ifdef MM_HAVE_PROFILE
+      mm_profile_alloc(heap, oldmem, reqsize, caller);
+#endif
+
       return oldmem;
     }
 
@@ -163,59 +197,26 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
       size_t needed   = newsize - oldsize;
       size_t takeprev = 0;
       size_t takenext = 0;
+      size_t copysize = 0;
 
-      /* Check if we can extend into the previous chunk and if the
-       * previous chunk is smaller than the next chunk.
-       */
-
-      if (prevsize > 0 && (nextsize >= prevsize || nextsize < 1))
-        {
-          /* Can we get everything we need from the previous chunk? */
-
-          if (needed > prevsize)
-            {
-              /* No, take the whole previous chunk and get the
-               * rest that we need from the next chunk.
-               */
-
-              takeprev = prevsize;
-              takenext = needed - prevsize;
-            }
-          else
-            {
-              /* Yes, take what we need from the previous chunk */
-
-              takeprev = needed;
-              takenext = 0;
-            }
+#ifdef MM_HAVE_PROFILE
+      /* The profiler record moves to the end of the extended chunk */
 
-          needed = 0;
-        }
+      mm_profile_free(heap, oldmem);
+#endif
 
-      /* Check if we can extend into the next chunk and if we still need
-       * more memory.
+      /* Take as much as possible from the next chunk.  The data only has
+       * to be moved if the rest must be taken from the previous chunk.
        */
 
-      if (nextsize > 0 && needed)
+      if (needed > nextsize)
         {
-          /* Can we get everything we need from the next chunk? */
-
-          if (needed > nextsize)
-            {
-              /* No, take the whole next chunk and get the rest that we
-               * need from the previous chunk.
-               */
-
-              takeprev = needed - nextsize;
-              takenext = nextsize;
-            }
-          else
-            {
-              /* Yes, take what we need from the previous chunk */
-
-              takeprev = 0;
-              takenext = needed;
-            }
+          takenext = nextsize;
+          takeprev = needed - nextsize;
+        }
+      else
+        {
+          takenext = needed;
         }
 
       /* Extend into the previous free chunk */
@@ -225,16 +226,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
         {
           FAR struct mm_allocnode_s *newnode;
 
-          /* Remove the previous node.  There must be a predecessor, but
-           * there may not be a successor node.
-           */
+          /* Remove the previous node from the free list */
 
-          DEBUGASSERT(prev->blink);
-          prev->blink->flink = prev->flink;
-          if (prev->flink)
-            {
-              prev->flink->blink = prev->blink;
-            }
+          mm_delfreechunk(heap, prev);
 
           /* Extend the node into the previous free chunk */
 
@@ -256,7 +250,9 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
               next->preceding    = newnode->size |
                                    (next->preceding & MM_ALLOC_BIT);
 
-              /* Return the previous free node to the nodelist (with the new size) */
+              /* Return the previous free node to the nodelist (with the
+               * new size)
+               */
 
               mm_addfreechunk(heap, prev);
             }
@@ -270,17 +266,18 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
                                     (next->preceding & MM_ALLOC_BIT);
             }
 
+          /* The user data of the old chunk has to be moved 'down' in
+           * memory.  That is done below, once the semaphore has been
+           * released.
+           */
+
+          copysize = oldsize - SIZEOF_MM_ALLOCNODE - SIZEOF_MM_PROFTAIL;
+
           /* Now we want to return newnode */
 
           oldnode = newnode;
           oldsize = newnode->size;
-
-          /* Now we have to move the user contents 'down' in memory.  memcpy
-           * should be safe for this.
-           */
-
-          newmem = (FAR void *)((FAR char *)newnode + SIZEOF_MM_ALLOCNODE);
-          memcpy(newmem, oldmem, oldsize - SIZEOF_MM_ALLOCNODE);
+          newmem  = (FAR void *)((FAR char *)newnode + SIZEOF_MM_ALLOCNODE);
         }
 
       /* Extend into the next free chunk */
@@ -294,18 +291,12 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
            * chunk)
            */
 
-          andbeyond = (FAR struct mm_allocnode_s *)((FAR char *)next + nextsize);
+          andbeyond = (FAR struct mm_allocnode_s *)
+                      ((FAR char *)next + nextsize);
 
-          /* Remove the next node.  There must be a predecessor, but there
-           * may not be a successor node.
-           */
+          /* Remove the next node from the free list */
 
-          DEBUGASSERT(next->blink);
-          next->blink->flink = next->flink;
-          if (next->flink)
-            {
-              next->flink->blink = next->blink;
-            }
+          mm_delfreechunk(heap, next);
 
           /* Extend the node into the next chunk */
 
@@ -341,10 +332,27 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
         }
 
       mm_givesemaphore(heap);
+
+      /* The extended chunk already belongs to the caller, so the data can
+       * be moved without the semaphore.  The old and the new location
+       * overlap.
+       */
+
+      if (copysize > 0)
+        {
+          memmove(newmem, oldmem, copysize);
+        }
+
+#ifdef MM_HAVE_PROFILE
+      mm_profile_alloc(heap, newmem, reqsize, caller);
+#endif
+
       return newmem;
     }
 
-  /* The current chunk cannot be extended.  Just allocate a new chunk and copy */
+  /* The current chunk cannot be extended.  Just allocate a new chunk and
+   * copy
+   */
 
   else
     {
@@ -353,10 +361,19 @@ FAR void *mm_realloc(FAR struct mm_heap_s *heap, FAR void *oldmem,
        */
 
       mm_givesemaphore(heap);
+#ifdef MM_HAVE_PROFILE
+      newmem = (FAR void *)mm_malloc_caller(heap, size, caller);
+#else
       newmem = (FAR void *)mm_malloc(heap, size);
+#endif
       if (newmem)
         {
-          memcpy(newmem, oldmem, oldsize);
+          /* Copy only the user data.  oldsize includes the chunk header
+           * and the profiler record (if any).
+           */
+
+          memcpy(newmem, oldmem,
+                 oldsize - SIZEOF_MM_ALLOCNODE - SIZEOF_MM_PROFTAIL);
           mm_free(heap, oldmem);
         }
 
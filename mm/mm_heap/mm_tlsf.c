@@ -0,0 +1,317 @@
+/****************************************************************************
+ * mm/mm_heap/mm_tlsf.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <string.h>
+#include <strings.h>
+
+#include <nuttx/mm/mm.h>
+
+#ifdef CONFIG_MM_TLSF
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if MM_TLSF_SLCOUNT > 32
+#  error CONFIG_MM_TLSF_SLBITS is too large
+#endif
+
+#if MM_TLSF_FLCOUNT > 32
+#  error MM_TLSF_FLCOUNT is too large
+#endif
+
+/* Bit operations.  Bits are numbered starting at zero. */
+
+#define mm_tlsf_fls(v)  (flsl((long)(v)) - 1)
+#define mm_tlsf_ffs(v)  (ffsl((long)(v)) - 1)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_tlsf_mapping
+ *
+ * Description:
+ *   Map a chunk size to the first and second level list indices of the
+ *   range that contains the size.
+ *
+ ****************************************************************************/
+
+static inline void mm_tlsf_mapping(size_t size, FAR int *fl, FAR int *sl)
+{
+  size_t granules = size >> MM_MIN_SHIFT;
+  int msb;
+
+  if (granules < MM_TLSF_SLCOUNT)
+    {
+      /* Small chunks are linearly mapped into the first list */
+
+      *fl = 0;
+      *sl = (int)granules;
+    }
+  else
+    {
+      msb = mm_tlsf_fls(granules);
+      *fl = msb - MM_TLSF_SLSHIFT + 1;
+      *sl = (int)(granules >> (msb - MM_TLSF_SLSHIFT)) - MM_TLSF_SLCOUNT;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_tlsf_initialize
+ *
+ * Description:
+ *   Initialize the segregated free lists of the heap to the empty state.
+ *
+ ****************************************************************************/
+
+void mm_tlsf_initialize(FAR struct mm_heap_s *heap)
+{
+  heap->mm_flbitmap = 0;
+  memset(heap->mm_slbitmap, 0, sizeof(heap->mm_slbitmap));
+  memset(heap->mm_freelist, 0, sizeof(heap->mm_freelist));
+}
+
+/****************************************************************************
+ * Name: mm_addfreechunk
+ *
+ * Description:
+ *   Add a free chunk to the head of the segregated list that covers its
+ *   size.  It is assumed that the caller holds the mm semaphore
+ *
+ ****************************************************************************/
+
+void mm_addfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node)
+{
+  FAR struct mm_freenode_s *head;
+  int fl;
+  int sl;
+
+  DEBUGASSERT(node->size >= SIZEOF_MM_FREENODE);
+  DEBUGASSERT((node->preceding & MM_ALLOC_BIT) == 0);
+
+  mm_tlsf_mapping(node->size, &fl, &sl);
+
+#ifdef CONFIG_MM_FRAGSTATS
+  heap->mm_fragnfree[fl]++;
+  heap->mm_fragbytes[fl] += node->size;
+#endif
+
+  head        = heap->mm_freelist[fl][sl];
+  node->blink = NULL;
+  node->flink = head;
+
+  if (head != NULL)
+    {
+      head->blink = node;
+    }
+
+  heap->mm_freelist[fl][sl] = node;
+  heap->mm_slbitmap[fl]    |= (uint32_t)1 << sl;
+  heap->mm_flbitmap        |= (uint32_t)1 << fl;
+}
+
+/****************************************************************************
+ * Name: mm_delfreechunk
+ *
+ * Description:
+ *   Remove a free chunk from its segregated list.  It is assumed that the
+ *   caller holds the mm semaphore and that the size of the chunk has not
+ *   yet been modified.
+ *
+ ****************************************************************************/
+
+void mm_delfreechunk(FAR struct mm_heap_s *heap,
+                     FAR struct mm_freenode_s *node)
+{
+  int fl;
+  int sl;
+
+  mm_tlsf_mapping(node->size, &fl, &sl);
+
+#ifdef CONFIG_MM_FRAGSTATS
+  heap->mm_fragnfree[fl]--;
+  heap->mm_fragbytes[fl] -= node->size;
+#endif
+
+  if (node->flink != NULL)
+    {
+      node->flink->blink = node->blink;
+    }
+
+  if (node->blink != NULL)
+    {
+      node->blink->flink = node->flink;
+      return;
+    }
+
+  /* This was the head of its list */
+
+  DEBUGASSERT(heap->mm_freelist[fl][sl] == node);
+
+  heap->mm_freelist[fl][sl] = node->flink;
+  if (node->flink == NULL)
+    {
+      /* The list is now empty */
+
+      heap->mm_slbitmap[fl] &= ~((uint32_t)1 << sl);
+      if (heap->mm_slbitmap[fl] == 0)
+        {
+          heap->mm_flbitmap &= ~((uint32_t)1 << fl);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: mm_findfreechunk
+ *
+ * Description:
+ *   Find a free chunk of at least 'size' bytes in constant time.  The size
+ *   is first rounded up to the start of the next list range so that any
+ *   chunk in the selected list is large enough.  The chunk is not removed
+ *   from its list.  It is assumed that the caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+FAR struct mm_freenode_s *mm_findfreechunk(FAR struct mm_heap_s *heap,
+                                           size_t size)
+{
+  size_t granules = size >> MM_MIN_SHIFT;
+#ifdef CONFIG_DEBUG_ASSERTIONS
+  size_t reqsize = size;
+#endif
+  uint32_t bitmap;
+  int fl;
+  int sl;
+
+  if (granules >= MM_TLSF_SLCOUNT)
+    {
+      size += ((size_t)1 << (mm_tlsf_fls(granules) - MM_TLSF_SLSHIFT +
+                             MM_MIN_SHIFT)) - 1;
+    }
+
+  mm_tlsf_mapping(size, &fl, &sl);
+  if (fl >= MM_TLSF_FLCOUNT)
+    {
+      return NULL;
+    }
+
+  /* Look for a non-empty list in the same first level range */
+
+  bitmap = heap->mm_slbitmap[fl] & ((uint32_t)~0 << sl);
+  if (bitmap == 0)
+    {
+      /* None.. use the smallest non-empty first level range above it */
+
+      if (fl + 1 >= MM_TLSF_FLCOUNT)
+        {
+          return NULL;
+        }
+
+      bitmap = heap->mm_flbitmap & ((uint32_t)~0 << (fl + 1));
+      if (bitmap == 0)
+        {
+          return NULL;
+        }
+
+      fl     = mm_tlsf_ffs(bitmap);
+      bitmap = heap->mm_slbitmap[fl];
+    }
+
+  sl = mm_tlsf_ffs(bitmap);
+
+  DEBUGASSERT(heap->mm_freelist[fl][sl] != NULL &&
+              heap->mm_freelist[fl][sl]->size >= reqsize);
+  return heap->mm_freelist[fl][sl];
+}
+
+/****************************************************************************
+ * Name: mm_findfreechunk_attr
+ *
+ * Description:
+ *   Find a free chunk of at least 'size' bytes that lies in a heap region
+ *   with all of the placement attributes 'attr'.  The lists are searched
+ *   from the one that covers 'size' upward, so this is not done in
+ *   constant time.  The chunk is not removed from its list.  It is assumed
+ *   that the caller holds the mm semaphore.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REGION_ATTR
+FAR struct mm_freenode_s *mm_findfreechunk_attr(FAR struct mm_heap_s *heap,
+                                                size_t size, int attr)
+{
+  FAR struct mm_freenode_s *node;
+  uint32_t bitmap;
+  int fl;
+  int sl;
+
+  mm_tlsf_mapping(size, &fl, &sl);
+  if (fl >= MM_TLSF_FLCOUNT)
+    {
+      return NULL;
+    }
+
+  /* The first list may also hold chunks that are too small */
+
+  bitmap = heap->mm_slbitmap[fl] & ((uint32_t)~0 << sl);
+  for (; ; )
+    {
+      while (bitmap != 0)
+        {
+          sl      = mm_tlsf_ffs(bitmap);
+          bitmap &= ~((uint32_t)1 << sl);
+
+          for (node = heap->mm_freelist[fl][sl];
+               node != NULL;
+               node = node->flink)
+            {
+              if (node->size >= size &&
+                  (mm_regionattr(heap, node) & attr) == attr)
+                {
+                  return node;
+                }
+            }
+        }
+
+      if (++fl >= MM_TLSF_FLCOUNT)
+        {
+          return NULL;
+        }
+
+      bitmap = heap->mm_slbitmap[fl];
+    }
+}
+#endif
+
+#endif /* CONFIG_MM_TLSF */
@@ -57,7 +57,12 @@
 
 FAR void *mm_zalloc(FAR struct mm_heap_s *heap, size_t size)
 {
+#ifdef MM_HAVE_PROFILE
+  FAR void *alloc = mm_malloc_caller(heap, size, MM_PROFILE_CALLER());
+#else
   FAR void *alloc = mm_malloc(heap, size);
+#endif
+
   if (alloc)
     {
        memset(alloc, 0, size);
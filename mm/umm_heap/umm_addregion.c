@@ -68,3 +68,27 @@ void umm_addregion(FAR void *heap_start, size_t heap_size)
 {
   mm_addregion(USR_HEAP, heap_start, heap_size);
 }
+
+/****************************************************************************
+ * Name: umm_addregion_attr
+ *
+ * Description:
+ *   This is a simple wrapper for the mm_addregion_attr() function.  It adds
+ *   a region with the placement attributes 'attr' to the user heap.
+ *
+ * Input Parameters:
+ *   heap_start - Address of the beginning of the memory region
+ *   heap_size  - The size (in bytes) if the memory region.
+ *   attr       - The MALLOC_ATTR_* attributes of the region
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REGION_ATTR
+void umm_addregion_attr(FAR void *heap_start, size_t heap_size, int attr)
+{
+  mm_addregion_attr(USR_HEAP, heap_start, heap_size, attr);
+}
+#endif
@@ -43,6 +43,7 @@
 #include <unistd.h>
 
 #include <nuttx/mm/mm.h>
+#include <nuttx/sched.h>
 
 #include "umm_heap/umm_heap.h"
 
@@ -105,3 +106,55 @@ FAR void *malloc(size_t size)
   return mm_malloc(USR_HEAP, size);
 #endif
 }
+
+/****************************************************************************
+ * Name: malloc_attr
+ *
+ * Description:
+ *   Allocate memory from the regions of the user heap that have all of the
+ *   placement attributes 'attr'.
+ *
+ * Input Parameters:
+ *   size - Size (in bytes) of the memory region to be allocated.
+ *   attr - The required MALLOC_ATTR_* attributes
+ *
+ * Returned Value:
+ *   The address of the allocated memory (NULL on failure to allocate)
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MM_REGION_ATTR
+FAR void *malloc_attr(size_t size, int attr)
+{
+  return mm_malloc_attr(USR_HEAP, size, attr);
+}
+
+/****************************************************************************
+ * Name: malloc_setattr
+ *
+ * Description:
+ *   Set the default placement of the allocations of the current task.
+ *   Later allocations of the task are taken from regions with all of the
+ *   attributes 'attr' if possible and from any region otherwise.  Tasks
+ *   and threads that are created later inherit the setting.
+ *
+ * Input Parameters:
+ *   attr - The preferred MALLOC_ATTR_* attributes (zero for none)
+ *
+ * Returned Value:
+ *   The previous default placement of the task.
+ *
+ ****************************************************************************/
+
+#ifdef MM_HAVE_TASKATTR
+int malloc_setattr(int attr)
+{
+  FAR struct tcb_s *tcb = nxsched_self();
+  int oldattr = tcb->mmattr;
+
+  tcb->mmattr = (uint8_t)(attr & ~MM_ATTR_PREFER);
+  return oldattr;
+}
+#endif
+#endif
+
@@ -415,6 +415,28 @@ int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr);
 
 void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr);
 
+/****************************************************************************
+ * Name: arp_refresh
+ *
+ * Description:
+ *   Return the IP address of an ARP table entry that is due for a refresh
+ *   and that can be reached through a network device.
+ *
+ * Input Parameters:
+ *   dev - The network device that would send the ARP request
+ *
+ * Returned Value:
+ *   The IP address to send an ARP request to or zero if there is none.
+ *
+ * Assumptions
+ *   The network is locked to assure exclusive access to the ARP table.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_REFRESH
+in_addr_t arp_refresh(FAR struct net_driver_s *dev);
+#endif
+
 /****************************************************************************
  * Name: arp_snapshot
  *
@@ -262,6 +262,8 @@ void arp_out(FAR struct net_driver_s *dev)
        */
 
       arp_format(dev, ipaddr);
+      netdev_iob_txreset(dev);
+      netdev_txtstamp_reset(dev);
       arp_dump(ARPBUF);
       return;
     }
@@ -41,7 +41,9 @@
 
 #include <stdint.h>
 
+#include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
 
 #include "devif/devif.h"
 #include "arp/arp.h"
@@ -67,6 +69,10 @@
 
 int arp_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
 {
+#ifdef CONFIG_NET_ARP_REFRESH
+  in_addr_t ipaddr;
+#endif
+
   /* Setup for the ARP callback (most of these do not apply) */
 
   dev->d_appdata = NULL;
@@ -77,6 +83,24 @@ int arp_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
 
   devif_conn_event(dev, NULL, ARP_POLL, dev->d_conncb);
 
+#ifdef CONFIG_NET_ARP_REFRESH
+  /* If no ARP request was queued, refresh an ARP table entry that is about
+   * to expire.  No one waits for the response which updates the table in
+   * arp_arpin().
+   */
+
+  if (dev->d_len == 0 &&
+      (dev->d_lltype == NET_LL_ETHERNET ||
+       dev->d_lltype == NET_LL_IEEE80211))
+    {
+      ipaddr = arp_refresh(dev);
+      if (ipaddr != 0)
+        {
+          arp_format(dev, ipaddr);
+        }
+    }
+#endif
+
   /* Call back into the driver */
 
   return callback(dev);
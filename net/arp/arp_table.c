@@ -72,6 +72,26 @@
 
 #define ARP_MAXAGE_TICK SEC2TICK(10 * CONFIG_NET_ARP_MAXAGE)
 
+/* The hash chains link the table entries by their index plus one so that
+ * zero, the initial value of the static arrays, terminates a chain.
+ */
+
+#define ARP_HASH_END    0
+
+#if CONFIG_NET_ARPTAB_SIZE >= UINT16_MAX
+#  error CONFIG_NET_ARPTAB_SIZE is too large
+#endif
+
+#ifdef CONFIG_NET_ARP_REFRESH
+#  define ARP_REFRESH_TICK SEC2TICK(CONFIG_NET_ARP_REFRESH_TIME)
+
+/* The refresh states of an ARP table entry */
+
+#  define ARP_REFRESH_NONE    0 /* Not due for a refresh */
+#  define ARP_REFRESH_PENDING 1 /* The ARP request must be sent */
+#  define ARP_REFRESH_SENT    2 /* The ARP request has been sent */
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -90,6 +110,27 @@ struct arp_table_info_s
 
 static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
 
+/* The heads of the hash chains and the links between the entries in use.
+ * struct arp_entry_s is also the user interface of the ARP table so the
+ * links are kept aside.
+ */
+
+static uint16_t g_arphash[CONFIG_NET_ARPTAB_SIZE];
+static uint16_t g_arpnext[CONFIG_NET_ARPTAB_SIZE];
+
+/* The entry found by the last lookup.  Most traffic goes to the same peer
+ * (often the default router) so this saves hashing in the common case.
+ */
+
+static uint16_t g_arplast;
+
+#ifdef CONFIG_NET_ARP_REFRESH
+/* The refresh state of each entry and the number of pending refreshes */
+
+static uint8_t g_arprefresh[CONFIG_NET_ARPTAB_SIZE];
+static uint16_t g_arpnpending;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -140,6 +181,116 @@ static int arp_match(FAR struct net_driver_s *dev, FAR void *arg)
   return 1;
 }
 
+/****************************************************************************
+ * Name: arp_hash
+ *
+ * Description:
+ *   Return the hash chain of an IPv4 address.  The address is in network
+ *   order so the bits that differ between hosts of a subnet may be the
+ *   most significant ones;  fold them down after the multiplication.
+ *
+ ****************************************************************************/
+
+static inline unsigned int arp_hash(in_addr_t ipaddr)
+{
+  uint32_t hash = (uint32_t)ipaddr * 0x9e3779b1;
+
+  hash ^= hash >> 16;
+  return hash % CONFIG_NET_ARPTAB_SIZE;
+}
+
+/****************************************************************************
+ * Name: arp_search
+ *
+ * Description:
+ *   Return the index of the ARP table entry of an IPv4 address or -1 if
+ *   there is none.  The entry may be expired.
+ *
+ ****************************************************************************/
+
+static int arp_search(in_addr_t ipaddr)
+{
+  unsigned int link;
+
+  if (ipaddr == 0)
+    {
+      return -1;
+    }
+
+  /* Try the entry of the last lookup first */
+
+  if (g_arplast != ARP_HASH_END &&
+      net_ipv4addr_cmp(ipaddr, g_arptable[g_arplast - 1].at_ipaddr))
+    {
+      return g_arplast - 1;
+    }
+
+  for (link = g_arphash[arp_hash(ipaddr)]; link != ARP_HASH_END;
+       link = g_arpnext[link - 1])
+    {
+      if (net_ipv4addr_cmp(ipaddr, g_arptable[link - 1].at_ipaddr))
+        {
+          g_arplast = link;
+          return link - 1;
+        }
+    }
+
+  return -1;
+}
+
+/****************************************************************************
+ * Name: arp_unlink
+ *
+ * Description:
+ *   Remove an entry in use from its hash chain and mark it unused.
+ *
+ ****************************************************************************/
+
+static void arp_unlink(int index)
+{
+  FAR uint16_t *link = &g_arphash[arp_hash(g_arptable[index].at_ipaddr)];
+
+  while (*link != ARP_HASH_END)
+    {
+      if (*link == index + 1)
+        {
+          *link = g_arpnext[index];
+          break;
+        }
+
+      link = &g_arpnext[*link - 1];
+    }
+
+  if (g_arplast == index + 1)
+    {
+      g_arplast = ARP_HASH_END;
+    }
+
+  g_arptable[index].at_ipaddr = 0;
+}
+
+/****************************************************************************
+ * Name: arp_refresh_clear
+ *
+ * Description:
+ *   Forget any refresh of an entry that was updated or removed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_REFRESH
+static void arp_refresh_clear(int index)
+{
+  if (g_arprefresh[index] == ARP_REFRESH_PENDING)
+    {
+      g_arpnpending--;
+    }
+
+  g_arprefresh[index] = ARP_REFRESH_NONE;
+}
+#else
+#  define arp_refresh_clear(i)
+#endif
+
 /****************************************************************************
  * Name: arp_return_old_entry
  *
@@ -195,41 +346,44 @@ arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
 
 int arp_update(in_addr_t ipaddr, FAR uint8_t *ethaddr)
 {
-  FAR struct arp_entry_s *tabptr = &g_arptable[0];
+  FAR struct arp_entry_s *tabptr;
+  unsigned int hash;
+  int index;
   int i;
 
-  /* Walk through the ARP mapping table and try to find an entry to
-   * update. If none is found, the IP -> MAC address mapping is
-   * inserted in the ARP table.
-   */
+  /* Look up the entry to update in the hash chain of the address */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  index = arp_search(ipaddr);
+  if (index < 0)
     {
-      /* Check if the source IP address of the incoming packet matches
-       * the IP address in this ARP table entry.
+      /* If none is found, the IP -> MAC address mapping is inserted in an
+       * unused entry or in place of the oldest one.
        */
 
-      if (g_arptable[i].at_ipaddr != 0 &&
-          net_ipv4addr_cmp(ipaddr, g_arptable[i].at_ipaddr))
+      tabptr = &g_arptable[0];
+      for (i = 1; i < CONFIG_NET_ARPTAB_SIZE && tabptr->at_ipaddr != 0; ++i)
         {
-          /* An old entry found, break. */
-
-          tabptr = &g_arptable[i];
-          break;
+          tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
         }
-      else
-        {
-          /* Record the oldest entry. */
 
-          tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
+      index = tabptr - g_arptable;
+      if (tabptr->at_ipaddr != 0)
+        {
+          arp_unlink(index);
         }
+
+      tabptr->at_ipaddr = ipaddr;
+      hash              = arp_hash(ipaddr);
+      g_arpnext[index]  = g_arphash[hash];
+      g_arphash[hash]   = index + 1;
     }
 
   /* Now, tabptr is the ARP table entry which we will fill with the new
    * information.
    */
 
-  tabptr->at_ipaddr = ipaddr;
+  tabptr = &g_arptable[index];
+  arp_refresh_clear(index);
   memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
   tabptr->at_time = clock_systime_ticks();
   return OK;
@@ -282,15 +436,15 @@ void arp_hdr_update(FAR uint16_t *pipaddr, FAR uint8_t *ethaddr)
 FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr)
 {
   FAR struct arp_entry_s *tabptr;
-  int i;
+  int index;
 
   /* Check if the IPv4 address is already in the ARP table. */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  index = arp_search(ipaddr);
+  if (index >= 0)
     {
-      tabptr = &g_arptable[i];
-      if (net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr) &&
-          clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
+      tabptr = &g_arptable[index];
+      if (clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
         {
           return tabptr;
         }
@@ -324,6 +478,9 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
 {
   FAR struct arp_entry_s *tabptr;
   struct arp_table_info_s info;
+#ifdef CONFIG_NET_ARP_REFRESH
+  int index;
+#endif
 
   /* Check if the IPv4 address is already in the ARP table. */
 
@@ -339,6 +496,22 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
           memcpy(ethaddr, &tabptr->at_ethaddr, ETHER_ADDR_LEN);
         }
 
+#ifdef CONFIG_NET_ARP_REFRESH
+      /* An entry which is still in use when it is about to expire is
+       * refreshed before it does so that the traffic does not stall while
+       * the address is resolved again.
+       */
+
+      index = tabptr - g_arptable;
+      if (g_arprefresh[index] == ARP_REFRESH_NONE &&
+          clock_systime_ticks() - tabptr->at_time >
+          ARP_MAXAGE_TICK - ARP_REFRESH_TICK)
+        {
+          g_arprefresh[index] = ARP_REFRESH_PENDING;
+          g_arpnpending++;
+        }
+#endif
+
       /* Return success in any case meaning that a valid Ethernet MAC
        * address mapping is available for the IP address.
        */
@@ -380,18 +553,65 @@ int arp_find(in_addr_t ipaddr, FAR struct ether_addr *ethaddr)
 
 void arp_delete(in_addr_t ipaddr)
 {
-  FAR struct arp_entry_s *tabptr;
+  int index;
 
   /* Check if the IPv4 address is in the ARP table. */
 
-  tabptr = arp_lookup(ipaddr);
-  if (tabptr != NULL)
+  index = arp_search(ipaddr);
+  if (index >= 0)
+    {
+      /* Yes.. Unlink it and set the IP address to zero to "delete" it */
+
+      arp_refresh_clear(index);
+      arp_unlink(index);
+    }
+}
+
+/****************************************************************************
+ * Name: arp_refresh
+ *
+ * Description:
+ *   Return the IP address of an ARP table entry that is due for a refresh
+ *   and that can be reached through a network device.  The ARP request is
+ *   sent only once;  if no response is received the entry expires as
+ *   usual.
+ *
+ * Input Parameters:
+ *   dev - The network device that would send the ARP request
+ *
+ * Returned Value:
+ *   The IP address to send an ARP request to or zero if there is none.
+ *
+ * Assumptions
+ *   The network is locked to assure exclusive access to the ARP table.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_ARP_REFRESH
+in_addr_t arp_refresh(FAR struct net_driver_s *dev)
+{
+  int i;
+
+  if (g_arpnpending == 0)
     {
-      /* Yes.. Set the IP address to zero to "delete" it */
+      return 0;
+    }
 
-      tabptr->at_ipaddr = 0;
+  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; i++)
+    {
+      if (g_arprefresh[i] == ARP_REFRESH_PENDING &&
+          net_ipv4addr_maskcmp(g_arptable[i].at_ipaddr, dev->d_ipaddr,
+                               dev->d_netmask))
+        {
+          g_arprefresh[i] = ARP_REFRESH_SENT;
+          g_arpnpending--;
+          return g_arptable[i].at_ipaddr;
+        }
     }
+
+  return 0;
 }
+#endif
 
 /****************************************************************************
  * Name: arp_snapshot
@@ -109,6 +109,9 @@ const struct sock_intf_s g_bluetooth_sockif =
   NULL,                   /* si_sendfile */
 #endif
   bluetooth_recvfrom,    /* si_recvfrom */
+#ifdef CONFIG_NET_TIMESTAMP
+  NULL,                  /* si_recvmsg */
+#endif
   bluetooth_close        /* si_close */
 };
 
@@ -232,10 +232,14 @@
 
 /* Describes a connection/device event callback interface
  *
- *   nxtconn - Supports a singly linked list that supports connection
+ *   nxtconn - Supports a doubly linked list that supports connection
  *             specific event handlers.
- *   nxtdev  - Supports a singly linked list that supports device specific
+ *   prvconn - The previous entry of the connection list, NULL for the
+ *             head of the list.
+ *   nxtdev  - Supports a doubly linked list that supports device specific
  *             event handlers
+ *   prvdev  - The previous entry of the device list, NULL for the head of
+ *             the list.
  *   event   - Provides the address of the callback function entry point.
  *             pvconn is a pointer to a connection-specific datat structure
  *             such as struct tcp_conn_s or struct udp_conn_s.
@@ -255,7 +259,9 @@ typedef CODE uint16_t (*devif_callback_event_t)(FAR struct net_driver_s *dev,
 struct devif_callback_s
 {
   FAR struct devif_callback_s *nxtconn;
+  FAR struct devif_callback_s *prvconn;
   FAR struct devif_callback_s *nxtdev;
+  FAR struct devif_callback_s *prvdev;
   FAR devif_callback_event_t event;
   FAR void *priv;
   uint16_t flags;
@@ -476,6 +482,28 @@ void devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *buf,
                     unsigned int len, unsigned int offset);
 #endif
 
+/****************************************************************************
+ * Name: devif_iob_sendsg
+ *
+ * Description:
+ *   This is identical to calling devif_iob_send() except that the data is
+ *   not copied into d_buf if the device supports scatter-gather transmit.
+ *   The I/O buffer chain is then referenced by d_txiob and must remain
+ *   valid until the frame has been transmitted.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_TX
+void devif_iob_sendsg(FAR struct net_driver_s *dev, FAR struct iob_s *buf,
+                      unsigned int len, unsigned int offset);
+#elif defined(CONFIG_MM_IOB)
+#  define devif_iob_sendsg(dev, buf, len, offset) \
+     devif_iob_send(dev, buf, len, offset)
+#endif
+
 /****************************************************************************
  * Name: devif_pkt_send
  *
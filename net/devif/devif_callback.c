@@ -55,6 +55,11 @@ static FAR struct devif_callback_s *g_cbfreelist = NULL;
  * Description:
  *   Return a callback container to the free list.
  *
+ *   The lists are doubly linked so the callback is removed without
+ *   searching for it.  Callbacks are allocated and freed for each send on
+ *   a socket, so a search would cost time proportional to the number of
+ *   callbacks of the connection and of the device for each send.
+ *
  * Assumptions:
  *   This function is called with the network locked.
  *
@@ -64,8 +69,9 @@ static void devif_callback_free(FAR struct net_driver_s *dev,
                                 FAR struct devif_callback_s *cb,
                                 FAR struct devif_callback_s **list)
 {
-  FAR struct devif_callback_s *prev;
+#ifdef CONFIG_DEBUG_FEATURES
   FAR struct devif_callback_s *curr;
+#endif
 
   if (cb)
     {
@@ -89,28 +95,25 @@ static void devif_callback_free(FAR struct net_driver_s *dev,
 
       if (dev != NULL)
         {
-          /* Find the callback structure in the device event list */
-
-          for (prev = NULL, curr = dev->d_devcb;
-               curr != NULL && curr != cb;
-               prev = curr, curr = curr->nxtdev)
+          if (cb->prvdev != NULL)
             {
+              cb->prvdev->nxtdev = cb->nxtdev;
             }
-
-          /* Remove the structure from the device event list */
-
-          DEBUGASSERT(curr);
-          if (curr != NULL)
+          else
             {
-              if (prev)
-                {
-                  prev->nxtdev = cb->nxtdev;
-                }
-              else
+              /* The callback must be the head of the device event list */
+
+              DEBUGASSERT(dev->d_devcb == cb);
+              if (dev->d_devcb == cb)
                 {
                   dev->d_devcb = cb->nxtdev;
                 }
             }
+
+          if (cb->nxtdev != NULL)
+            {
+              cb->nxtdev->prvdev = cb->prvdev;
+            }
         }
 
       /* Remove the callback structure from the data notification list if
@@ -119,34 +122,33 @@ static void devif_callback_free(FAR struct net_driver_s *dev,
 
       if (list)
         {
-          /* Find the callback structure in the connection event list */
-
-          for (prev = NULL, curr = *list;
-               curr && curr != cb;
-               prev = curr, curr = curr->nxtconn)
+          if (cb->prvconn != NULL)
             {
+              cb->prvconn->nxtconn = cb->nxtconn;
             }
-
-          /* Remove the structure from the connection event list */
-
-          DEBUGASSERT(curr);
-          if (curr)
+          else
             {
-              if (prev)
-                {
-                  prev->nxtconn = cb->nxtconn;
-                }
-              else
+              /* The callback must be the head of the connection list */
+
+              DEBUGASSERT(*list == cb);
+              if (*list == cb)
                 {
                   *list = cb->nxtconn;
                 }
             }
+
+          if (cb->nxtconn != NULL)
+            {
+              cb->nxtconn->prvconn = cb->prvconn;
+            }
         }
 
       /* Put the structure into the free list */
 
       cb->nxtconn  = g_cbfreelist;
+      cb->prvconn  = NULL;
       cb->nxtdev   = NULL;
+      cb->prvdev   = NULL;
       g_cbfreelist = cb;
       net_unlock();
     }
@@ -266,14 +268,22 @@ FAR struct devif_callback_s *
 
           if (!netdev_verify(dev) && (dev->d_flags & IFF_UP) != 0)
             {
-              /* No.. release the callback structure and fail */
+              /* No.. return the callback structure to the free list and
+               * fail.  It is not in any list yet.
+               */
 
-              devif_callback_free(NULL, NULL, list);
+              ret->nxtconn = g_cbfreelist;
+              g_cbfreelist = ret;
               net_unlock();
               return NULL;
             }
 
           ret->nxtdev  = dev->d_devcb;
+          if (dev->d_devcb != NULL)
+            {
+              dev->d_devcb->prvdev = ret;
+            }
+
           dev->d_devcb = ret;
         }
 
@@ -281,8 +291,13 @@ FAR struct devif_callback_s *
 
       if (list)
         {
-           ret->nxtconn = *list;
-           *list = ret;
+          ret->nxtconn = *list;
+          if (*list != NULL)
+            {
+              (*list)->prvconn = ret;
+            }
+
+          *list = ret;
         }
     }
 #ifdef CONFIG_DEBUG_FEATURES
@@ -502,10 +517,6 @@ uint16_t devif_dev_event(FAR struct net_driver_s *dev, void *pvconn,
 
           flags = cb->event(dev, pvconn, cb->priv, flags);
         }
-
-      /* Set up for the next time through the loop */
-
-      cb = next;
     }
 
   net_unlock();
@@ -84,4 +84,45 @@ void devif_iob_send(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
 #endif
 }
 
+/****************************************************************************
+ * Name: devif_iob_sendsg
+ *
+ * Description:
+ *   This is identical to calling devif_iob_send() except that the data is
+ *   not copied into d_buf if the device supports scatter-gather transmit.
+ *   The I/O buffer chain is then referenced by d_txiob and must remain
+ *   valid until the frame has been transmitted.
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_TX
+void devif_iob_sendsg(FAR struct net_driver_s *dev, FAR struct iob_s *iob,
+                      unsigned int len, unsigned int offset)
+{
+  if (!dev->d_txsg)
+    {
+      devif_iob_send(dev, iob, len, offset);
+      return;
+    }
+
+#ifdef CONFIG_NETDEV_TSO
+  DEBUGASSERT(len > 0 && (len < NETDEV_PKTSIZE(dev) || dev->d_txmss > 0));
+#else
+  DEBUGASSERT(len > 0 && len < NETDEV_PKTSIZE(dev));
+#endif
+
+  /* Leave the data in the I/O buffer chain.  Only the headers will be built
+   * in d_buf.
+   */
+
+  dev->d_txiob    = iob;
+  dev->d_txoffset = offset;
+  dev->d_txlen    = len;
+  dev->d_sndlen   = len;
+}
+#endif
+
 #endif /* CONFIG_MM_IOB */
@@ -100,11 +100,31 @@ static bool is_loopback(FAR struct net_driver_s *dev)
 
 int devif_loopback(FAR struct net_driver_s *dev)
 {
+#ifdef CONFIG_NETDEV_OFFLOAD
+  uint8_t features;
+#endif
+
   if (!is_loopback(dev))
     {
       return 0;
     }
 
+#ifdef CONFIG_NETDEV_IOB_TX
+  /* The input logic expects the whole packet in d_buf */
+
+  netdev_iob_txlinearize(dev);
+#endif
+
+#ifdef CONFIG_NETDEV_OFFLOAD
+  /* The checksums were not inserted if the hardware inserts them, and
+   * there is nothing to verify anyway for packets that never leave the
+   * device.
+   */
+
+  features         = dev->d_features;
+  dev->d_features |= NETDEV_FEATURE_RXCSUM;
+#endif
+
   /* Loop while if there is data "sent" to ourself.
    * Sending, of course, just means relaying back through the network.
    */
@@ -157,5 +177,9 @@ int devif_loopback(FAR struct net_driver_s *dev)
     }
   while (dev->d_len > 0);
 
+#ifdef CONFIG_NETDEV_OFFLOAD
+  dev->d_features = features;
+#endif
+
   return 1;
 }
@@ -47,6 +47,7 @@
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/net.h>
+#include <nuttx/sched_note.h>
 
 #include "devif/devif.h"
 #include "arp/arp.h"
@@ -58,6 +59,7 @@
 #include "icmp/icmp.h"
 #include "igmp/igmp.h"
 #include "icmpv6/icmpv6.h"
+#include "neighbor/neighbor.h"
 #include "mld/mld.h"
 #include "ipforward/ipforward.h"
 #include "sixlowpan/sixlowpan.h"
@@ -192,6 +194,28 @@ static void devif_packet_conversion(FAR struct net_driver_s *dev,
 #  define devif_packet_conversion(dev,pkttype)
 #endif /* CONFIG_NET_6LOWPAN */
 
+/****************************************************************************
+ * Name: devif_poll_callback
+ *
+ * Description:
+ *   Call back into the driver if the poll of a connection produced a
+ *   packet.  Most connections are idle on most polls, so this saves a call
+ *   into the driver for each of them.
+ *
+ * Returned Value:
+ *   The value returned by the driver or zero if there was nothing to send.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static inline int devif_poll_callback(FAR struct net_driver_s *dev,
+                                      devif_poll_callback_t callback)
+{
+  return dev->d_len > 0 ? callback(dev) : 0;
+}
+
 /****************************************************************************
  * Name: devif_poll_pkt_connections
  *
@@ -225,7 +249,7 @@ static int devif_poll_pkt_connections(FAR struct net_driver_s *dev,
 
       /* Call back into the driver */
 
-      bstop = callback(dev);
+      bstop = devif_poll_callback(dev, callback);
     }
 
   return bstop;
@@ -333,7 +357,7 @@ static inline int devif_poll_icmp(FAR struct net_driver_s *dev,
 
       /* Call back into the driver */
 
-      bstop = callback(dev);
+      bstop = devif_poll_callback(dev, callback);
     }
 
   return bstop;
@@ -373,7 +397,7 @@ static inline int devif_poll_icmpv6(FAR struct net_driver_s *dev,
 
       /* Call back into the driver */
 
-      bstop = callback(dev);
+      bstop = devif_poll_callback(dev, callback);
     }
   while (!bstop && (conn = icmpv6_nextconn(conn)) != NULL);
 
@@ -501,7 +525,7 @@ static int devif_poll_udp_connections(FAR struct net_driver_s *dev,
 
       /* Call back into the driver */
 
-      bstop = callback(dev);
+      bstop = devif_poll_callback(dev, callback);
     }
 
   return bstop;
@@ -541,7 +565,11 @@ static inline int devif_poll_tcp_connections(FAR struct net_driver_s *dev,
 
       /* Call back into the driver */
 
-      bstop = callback(dev);
+      bstop = devif_poll_callback(dev, callback);
+
+      /* The next packet is built in d_buf */
+
+      netdev_iob_txreset(dev);
     }
 
   return bstop;
@@ -585,7 +613,11 @@ static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
 
       /* Call back into the driver */
 
-      bstop = callback(dev);
+      bstop = devif_poll_callback(dev, callback);
+
+      /* The next packet is built in d_buf */
+
+      netdev_iob_txreset(dev);
     }
 
   return bstop;
@@ -608,9 +640,10 @@ static inline int devif_poll_tcp_timer(FAR struct net_driver_s *dev,
  *   packet.
  *
  *   This function will call the provided callback function for every active
- *   connection. Polling will continue until all connections have been polled
- *   or until the user-supplied function returns a non-zero value (which it
- *   should do only if it cannot accept further write data).
+ *   connection that has a packet to send. Polling will continue until all
+ *   connections have been polled or until the user-supplied function returns
+ *   a non-zero value (which it should do only if it cannot accept further
+ *   write data).
  *
  *   When the callback function is called, there may be an outbound packet
  *   waiting for service in the device packet buffer, and if so the d_len field
@@ -627,6 +660,12 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
 {
   int bstop = false;
 
+  sched_trace_begin(NOTE_TRACE_NET, dev);
+
+  /* Forget the payload fragment of any frame sent before */
+
+  netdev_iob_txreset(dev);
+
   /* Traverse all of the active packet connections and perform the poll
    * action.
    */
@@ -637,6 +676,15 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
   bstop = arp_poll(dev, callback);
   if (!bstop)
 #endif
+#if defined(CONFIG_NET_IPv6) && defined(NEIGHBOR_HAVE_POLL)
+    {
+      /* Check for queued IPv6 packets and neighbor probes */
+
+      bstop = neighbor_poll(dev, callback);
+    }
+
+  if (!bstop)
+#endif
 #ifdef CONFIG_NET_PKT
     {
       /* Check for pending packet socket transfer */
@@ -735,6 +783,7 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
       /* Nothing more to do */
     }
 
+  sched_trace_end(NOTE_TRACE_NET, dev);
   return bstop;
 }
 
@@ -747,9 +796,10 @@ int devif_poll(FAR struct net_driver_s *dev, devif_poll_callback_t callback)
  *   logic to periodically call devif_timer().
  *
  *   This function will call the provided callback function for every active
- *   connection. Polling will continue until all connections have been polled
- *   or until the user-supplied function returns a non-zero value (which it
- *   should do only if it cannot accept further write data).
+ *   connection that has a packet to send. Polling will continue until all
+ *   connections have been polled or until the user-supplied function returns
+ *   a non-zero value (which it should do only if it cannot accept further
+ *   write data).
  *
  *   When the callback function is called, there may be an outbound packet
  *   waiting for service in the device packet buffer, and if so the d_len field
@@ -335,7 +335,11 @@ int ipv4_input(FAR struct net_driver_s *dev)
   uint16_t llhdrlen;
   uint16_t totlen;
 
-  /* This is where the input processing starts. */
+  /* This is where the input processing starts.  Any response is built in
+   * d_buf.
+   */
+
+  netdev_iob_txreset(dev);
 
 #ifdef CONFIG_NET_STATISTICS
   g_netstats.ipv4.recv++;
@@ -519,7 +523,8 @@ int ipv4_input(FAR struct net_driver_s *dev)
         }
     }
 
-  if (ipv4_chksum(dev) != 0xffff)
+  if (!NETDEV_HAS_FEATURE(dev, NETDEV_FEATURE_RXCSUM) &&
+      ipv4_chksum(dev) != 0xffff)
     {
       /* Compute and check the IP header checksum. */
 
@@ -45,6 +45,7 @@
 
 #include <nuttx/semaphore.h>
 #include <nuttx/net/net.h>
+#include <nuttx/fs/fs.h>
 
 #include "devif/devif.h"
 #include "netdev/netdev.h"
@@ -127,7 +128,7 @@ static uint16_t icmp_poll_eventhandler(FAR struct net_driver_s *dev,
       if (eventset)
         {
           info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(info->fds);
         }
     }
 
@@ -235,7 +236,7 @@ int icmp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(fds);
     }
 
 errout_with_lock:
@@ -54,6 +54,7 @@
 #include "netdev/netdev.h"
 #include "inet/inet.h"
 #include "icmpv6/icmpv6.h"
+#include "netlink/netlink.h"
 
 #ifdef CONFIG_NET_ICMPv6_AUTOCONF
 
@@ -363,6 +364,7 @@ int icmpv6_autoconfig(FAR struct net_driver_s *dev)
    */
 
   net_ipv6addr_copy(dev->d_ipv6addr, lladdr);
+  netlink_ipv6addr_notify(dev, RTM_NEWADDR);
 
   /* 4. Router Contact: The node next attempts to contact a local router for
    *    more information on continuing the configuration. This is done either
@@ -102,6 +102,9 @@ const struct sock_intf_s g_icmpv6_sockif =
   NULL,               /* si_sendfile */
 #endif
   icmpv6_recvfrom,    /* si_recvfrom */
+#ifdef CONFIG_NET_TIMESTAMP
+  NULL,               /* si_recvmsg */
+#endif
   icmpv6_close        /* si_close */
 };
 
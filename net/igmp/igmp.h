@@ -109,6 +109,15 @@
 #define IS_SCHEDMSG(f)           (((f) & IGMP_SCHEDMSG) != 0)
 #define IS_WAITMSG(f)            (((f) & IGMP_WAITMSG) != 0)
 
+/* Each group sets one bit of d_igmp_grpmap.  The bit is selected by the
+ * octets of the group address folded together so that the bit does not
+ * depend on the byte order of the host.  A clear bit means that there is
+ * no such group and the packet can be rejected without a list search.
+ */
+
+#define IGMP_GRPBIT(a) \
+  ((uint32_t)1 << (((a) ^ ((a) >> 8) ^ ((a) >> 16) ^ ((a) >> 24)) & 31))
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -138,6 +138,7 @@ FAR struct igmp_group_s *igmp_grpalloc(FAR struct net_driver_s *dev,
       /* Add the group structure to the list in the device structure */
 
       sq_addfirst((FAR sq_entry_t *)group, &dev->d_igmp_grplist);
+      dev->d_igmp_grpmap |= IGMP_GRPBIT(*addr);
     }
 
   return group;
@@ -161,6 +162,15 @@ FAR struct igmp_group_s *igmp_grpfind(FAR struct net_driver_s *dev,
 
   grpinfo("Searching for addr %08x\n", (int)*addr);
 
+  /* Most of the multicast traffic on a LAN is for groups that we have not
+   * joined.  Reject it without searching the list.
+   */
+
+  if ((dev->d_igmp_grpmap & IGMP_GRPBIT(*addr)) == 0)
+    {
+      return NULL;
+    }
+
   for (group = (FAR struct igmp_group_s *)dev->d_igmp_grplist.head;
        group;
        group = group->next)
@@ -218,6 +228,8 @@ FAR struct igmp_group_s *igmp_grpallocfind(FAR struct net_driver_s *dev,
 void igmp_grpfree(FAR struct net_driver_s *dev,
                   FAR struct igmp_group_s *group)
 {
+  FAR struct igmp_group_s *tmp;
+
   grpinfo("Free: %p flags: %02x\n", group, group->flags);
 
   /* Cancel the wdog */
@@ -228,6 +240,16 @@ void igmp_grpfree(FAR struct net_driver_s *dev,
 
   sq_rem((FAR sq_entry_t *)group, &dev->d_igmp_grplist);
 
+  /* Rebuild the hash of the remaining groups */
+
+  dev->d_igmp_grpmap = 0;
+  for (tmp = (FAR struct igmp_group_s *)dev->d_igmp_grplist.head;
+       tmp;
+       tmp = tmp->next)
+    {
+      dev->d_igmp_grpmap |= IGMP_GRPBIT(tmp->grpaddr);
+    }
+
   /* Destroy the wait semaphore */
 
   nxsem_destroy(&group->sem);
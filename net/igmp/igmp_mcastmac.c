@@ -43,6 +43,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <assert.h>
 #include <debug.h>
 
@@ -83,6 +84,62 @@ static void igmp_mcastmac(in_addr_t *ip, FAR uint8_t *mac)
         *ip, mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
 }
 
+/****************************************************************************
+ * Name:  igmp_samemac
+ *
+ * Description:
+ *   Return true if two IP addresses (in network order) map to the same
+ *   multicast MAC address.  Only the low 23 bits of the address are used
+ *   for the MAC address so 32 groups share each MAC address.
+ *
+ ****************************************************************************/
+
+static bool igmp_samemac(in_addr_t ip1, in_addr_t ip2)
+{
+  return (ip4_addr2(ip1) & 0x7f) == (ip4_addr2(ip2) & 0x7f) &&
+         ip4_addr3(ip1) == ip4_addr3(ip2) &&
+         ip4_addr4(ip1) == ip4_addr4(ip2);
+}
+
+/****************************************************************************
+ * Name:  igmp_mcastmac_inuse
+ *
+ * Description:
+ *   Return true if the multicast MAC address of the IP address is also
+ *   needed for some other address:  A different group or one of the
+ *   addresses that are always enabled by igmp_devinit().  The MAC filter
+ *   of the device must be programmed only by the first user of a MAC
+ *   address and cleared only by the last.
+ *
+ ****************************************************************************/
+
+static bool igmp_mcastmac_inuse(FAR struct net_driver_s *dev,
+                                in_addr_t ip)
+{
+  FAR struct igmp_group_s *group;
+
+  if ((!net_ipv4addr_cmp(ip, g_ipv4_allsystems) &&
+       igmp_samemac(ip, g_ipv4_allsystems)) ||
+      (!net_ipv4addr_cmp(ip, g_ipv4_allrouters) &&
+       igmp_samemac(ip, g_ipv4_allrouters)))
+    {
+      return true;
+    }
+
+  for (group = (FAR struct igmp_group_s *)dev->d_igmp_grplist.head;
+       group;
+       group = group->next)
+    {
+      if (!net_ipv4addr_cmp(group->grpaddr, ip) &&
+          igmp_samemac(group->grpaddr, ip))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -100,7 +157,7 @@ void igmp_addmcastmac(FAR struct net_driver_s *dev, FAR in_addr_t *ip)
   uint8_t mcastmac[6];
 
   ninfo("Adding: IP %08x\n", *ip);
-  if (dev->d_addmac)
+  if (dev->d_addmac && !igmp_mcastmac_inuse(dev, *ip))
     {
       igmp_mcastmac(ip, mcastmac);
       dev->d_addmac(dev, mcastmac);
@@ -120,7 +177,7 @@ void igmp_removemcastmac(FAR struct net_driver_s *dev, FAR in_addr_t *ip)
   uint8_t mcastmac[6];
 
   ninfo("Removing: IP %08x\n", *ip);
-  if (dev->d_rmmac)
+  if (dev->d_rmmac && !igmp_mcastmac_inuse(dev, *ip))
     {
       igmp_mcastmac(ip, mcastmac);
       dev->d_rmmac(dev, mcastmac);
@@ -94,6 +94,10 @@ static ssize_t    inet_sendfile(FAR struct socket *psock,
 static ssize_t    inet_recvfrom(FAR struct socket *psock, FAR void *buf,
                     size_t len, int flags, FAR struct sockaddr *from,
                     FAR socklen_t *fromlen);
+#ifdef CONFIG_NET_TIMESTAMP
+static ssize_t    inet_recvmsg(FAR struct socket *psock,
+                    FAR struct msghdr *msg, int flags);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -117,6 +121,9 @@ static const struct sock_intf_s g_inet_sockif =
   inet_sendfile,    /* si_sendfile */
 #endif
   inet_recvfrom,    /* si_recvfrom */
+#ifdef CONFIG_NET_TIMESTAMP
+  inet_recvmsg,     /* si_recvmsg */
+#endif
   inet_close        /* si_close */
 };
 
@@ -1268,6 +1275,54 @@ static ssize_t inet_sendfile(FAR struct socket *psock,
 }
 #endif
 
+/****************************************************************************
+ * Name: inet_checkfromlen
+ *
+ * Description:
+ *   Verify that a source address buffer is large enough to hold an address
+ *   of the address family of the socket.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   fromlen  The length of the address buffer
+ *
+ * Returned Value:
+ *   Zero (OK) if the buffer is large enough; -EINVAL otherwise.
+ *
+ ****************************************************************************/
+
+static int inet_checkfromlen(FAR struct socket *psock, socklen_t fromlen)
+{
+  socklen_t minlen;
+
+  /* Get the minimum socket length */
+
+  switch (psock->s_domain)
+    {
+#ifdef CONFIG_NET_IPv4
+    case PF_INET:
+      {
+        minlen = sizeof(struct sockaddr_in);
+      }
+      break;
+#endif
+
+#ifdef CONFIG_NET_IPv6
+    case PF_INET6:
+      {
+        minlen = sizeof(struct sockaddr_in6);
+      }
+      break;
+#endif
+
+    default:
+      DEBUGPANIC();
+      return -EINVAL;
+    }
+
+  return fromlen < minlen ? -EINVAL : OK;
+}
+
 /****************************************************************************
  * Name: inet_recvfrom
  *
@@ -1311,36 +1366,10 @@ static ssize_t inet_recvfrom(FAR struct socket *psock, FAR void *buf,
 
   if (from)
     {
-      socklen_t minlen;
-
-      /* Get the minimum socket length */
-
-      switch (psock->s_domain)
-        {
-#ifdef CONFIG_NET_IPv4
-        case PF_INET:
-          {
-            minlen = sizeof(struct sockaddr_in);
-          }
-          break;
-#endif
-
-#ifdef CONFIG_NET_IPv6
-        case PF_INET6:
-          {
-            minlen = sizeof(struct sockaddr_in6);
-          }
-          break;
-#endif
-
-        default:
-          DEBUGPANIC();
-          return -EINVAL;
-        }
-
-      if (*fromlen < minlen)
+      ret = inet_checkfromlen(psock, *fromlen);
+      if (ret < 0)
         {
-          return -EINVAL;
+          return ret;
         }
     }
 
@@ -1385,6 +1414,70 @@ static ssize_t inet_recvfrom(FAR struct socket *psock, FAR void *buf,
   return ret;
 }
 
+/****************************************************************************
+ * Name: inet_recvmsg
+ *
+ * Description:
+ *   Implements the socket recvmsg interface for the case of the AF_INET
+ *   and AF_INET6 address families.  UDP sockets return the receive
+ *   timestamps of the datagram and, with MSG_ERRQUEUE, the transmit
+ *   timestamps as ancillary data.  Other sockets return no ancillary data.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msg      The message header
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  Otherwise, on
+ *   errors, a negated errno value is returned (see recvmsg() for the list
+ *   of appropriate error values).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMP
+static ssize_t inet_recvmsg(FAR struct socket *psock,
+                            FAR struct msghdr *msg, int flags)
+{
+  socklen_t fromlen = msg->msg_namelen;
+  ssize_t ret;
+
+#ifdef NET_UDP_HAVE_STACK
+  if (psock->s_type == SOCK_DGRAM)
+    {
+      if (msg->msg_name != NULL)
+        {
+          ret = inet_checkfromlen(psock, fromlen);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+
+      return psock_udp_recvmsg(psock, msg, flags);
+    }
+#endif
+
+  /* There is no ancillary data and no error queue */
+
+  msg->msg_controllen = 0;
+  if ((flags & MSG_ERRQUEUE) != 0)
+    {
+      return -EAGAIN;
+    }
+
+  ret = inet_recvfrom(psock, msg->msg_iov->iov_base, msg->msg_iov->iov_len,
+                      flags, msg->msg_name,
+                      msg->msg_name != NULL ? &fromlen : NULL);
+  if (ret >= 0)
+    {
+      msg->msg_namelen = fromlen;
+    }
+
+  return ret;
+}
+#endif
+
 #endif /* NET_UDP_HAVE_STACK || NET_TCP_HAVE_STACK */
 
 /****************************************************************************
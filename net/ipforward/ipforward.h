@@ -44,6 +44,9 @@
 
 #include <stdint.h>
 
+#include <netinet/in.h>
+#include <nuttx/clock.h>
+
 #undef HAVE_FWDALLOC
 #ifdef CONFIG_NET_IPFORWARD
 
@@ -83,6 +86,21 @@ struct forward_s
 #endif
 };
 
+/* This structure describes one cached IPv4 flow */
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+struct ipv4_flow_s
+{
+  FAR struct net_driver_s *fl_dev;        /* Forwarding device or NULL */
+  clock_t                  fl_time;       /* Time of the route lookup */
+  uint32_t                 fl_npackets;   /* Number of packets forwarded */
+  uint32_t                 fl_nbytes;     /* Number of bytes forwarded */
+  in_addr_t                fl_srcipaddr;  /* Source address of the flow */
+  in_addr_t                fl_destipaddr; /* Destination address */
+  uint8_t                  fl_proto;      /* L3 protocol of the flow */
+};
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -375,5 +393,67 @@ void ipv4_dropstats(FAR struct ipv4_hdr_s *ipv4);
 #  define ipv4_dropstats(ipv4)
 #endif
 
+/****************************************************************************
+ * Name: ipv4_flow_route
+ *
+ * Description:
+ *   Return the device that forwards a packet and account the packet to
+ *   its flow.
+ *
+ * Input Parameters:
+ *   ipv4  - The IPv4 header of the packet to forward
+ *   len   - The length of the packet
+ *
+ * Returned Value:
+ *   The forwarding device or NULL if the packet is not routable.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+FAR struct net_driver_s *ipv4_flow_route(FAR struct ipv4_hdr_s *ipv4,
+                                         uint16_t len);
+#endif
+
+/****************************************************************************
+ * Name: ipv4_flow_flush
+ *
+ * Description:
+ *   Forget the flows forwarded by a network device.
+ *
+ * Input Parameters:
+ *   dev - The network device or NULL to forget all flows
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+void ipv4_flow_flush(FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: ipv4_flow_get
+ *
+ * Description:
+ *   Return a copy of a flow of the cache.
+ *
+ * Input Parameters:
+ *   index - The slot of the flow in the cache
+ *   flow  - The location to return the flow
+ *
+ * Returned Value:
+ *   OK if the flow was returned;  -ENOENT if the slot is unused;  -EINVAL
+ *   if the index is out of range.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+int ipv4_flow_get(int index, FAR struct ipv4_flow_s *flow);
+#endif
+
 #endif /* CONFIG_NET_IPFORWARD */
 #endif /* __NET_IPFORWARD_IPFORWARD_H */
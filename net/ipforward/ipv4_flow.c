@@ -0,0 +1,217 @@
+/****************************************************************************
+ * net/ipforward/ipv4_flow.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <net/if.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+#include "ipforward/ipforward.h"
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define FLOW_TIMEOUT_TICK SEC2TICK(CONFIG_NET_IPFORWARD_FLOWCACHE_TIMEOUT)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The cache of forwarded flows.  A flow is identified by the addresses and
+ * the protocol of its packets.  The cache is direct-mapped:  a new flow
+ * replaces the flow in the same slot.
+ */
+
+static struct ipv4_flow_s g_ipv4_flows[CONFIG_NET_IPFORWARD_NFLOWS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipv4_flow_hash
+ ****************************************************************************/
+
+static inline unsigned int ipv4_flow_hash(in_addr_t srcipaddr,
+                                          in_addr_t destipaddr,
+                                          uint8_t proto)
+{
+  uint32_t hash = (srcipaddr ^ (destipaddr * 0x9e3779b1) ^ proto);
+
+  hash ^= hash >> 16;
+  return hash % CONFIG_NET_IPFORWARD_NFLOWS;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ipv4_flow_route
+ *
+ * Description:
+ *   Return the device that forwards a packet and account the packet to
+ *   its flow.  The device of a flow is looked up again when the flow
+ *   expires or the device is down so that changes of the routing table
+ *   take effect.
+ *
+ * Input Parameters:
+ *   ipv4  - The IPv4 header of the packet to forward
+ *   len   - The length of the packet
+ *
+ * Returned Value:
+ *   The forwarding device or NULL if the packet is not routable.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct net_driver_s *ipv4_flow_route(FAR struct ipv4_hdr_s *ipv4,
+                                         uint16_t len)
+{
+  FAR struct ipv4_flow_s *flow;
+  in_addr_t destipaddr;
+  in_addr_t srcipaddr;
+  clock_t now;
+
+  destipaddr = net_ip4addr_conv32(ipv4->destipaddr);
+  srcipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
+  now        = clock_systime_ticks();
+
+  flow = &g_ipv4_flows[ipv4_flow_hash(srcipaddr, destipaddr, ipv4->proto)];
+  if (flow->fl_dev == NULL ||
+      !net_ipv4addr_cmp(flow->fl_srcipaddr, srcipaddr) ||
+      !net_ipv4addr_cmp(flow->fl_destipaddr, destipaddr) ||
+      flow->fl_proto != ipv4->proto)
+    {
+      /* A new flow.  Replace the flow in the slot. */
+
+      flow->fl_dev = netdev_findby_ripv4addr(srcipaddr, destipaddr);
+      if (flow->fl_dev == NULL)
+        {
+          return NULL;
+        }
+
+      net_ipv4addr_copy(flow->fl_srcipaddr, srcipaddr);
+      net_ipv4addr_copy(flow->fl_destipaddr, destipaddr);
+      flow->fl_proto    = ipv4->proto;
+      flow->fl_npackets = 0;
+      flow->fl_nbytes   = 0;
+      flow->fl_time     = now;
+    }
+  else if (now - flow->fl_time > FLOW_TIMEOUT_TICK ||
+           (flow->fl_dev->d_flags & IFF_UP) == 0)
+    {
+      /* The route of the flow may have changed */
+
+      flow->fl_dev = netdev_findby_ripv4addr(srcipaddr, destipaddr);
+      if (flow->fl_dev == NULL)
+        {
+          return NULL;
+        }
+
+      flow->fl_time = now;
+    }
+
+  flow->fl_npackets++;
+  flow->fl_nbytes += len;
+  return flow->fl_dev;
+}
+
+/****************************************************************************
+ * Name: ipv4_flow_flush
+ *
+ * Description:
+ *   Forget the flows forwarded by a network device.
+ *
+ * Input Parameters:
+ *   dev - The network device or NULL to forget all flows
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void ipv4_flow_flush(FAR struct net_driver_s *dev)
+{
+  int i;
+
+  for (i = 0; i < CONFIG_NET_IPFORWARD_NFLOWS; i++)
+    {
+      if (dev == NULL || g_ipv4_flows[i].fl_dev == dev)
+        {
+          g_ipv4_flows[i].fl_dev = NULL;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: ipv4_flow_get
+ *
+ * Description:
+ *   Return a copy of a flow of the cache.
+ *
+ * Input Parameters:
+ *   index - The slot of the flow in the cache
+ *   flow  - The location to return the flow
+ *
+ * Returned Value:
+ *   OK if the flow was returned;  -ENOENT if the slot is unused;  -EINVAL
+ *   if the index is out of range.
+ *
+ ****************************************************************************/
+
+int ipv4_flow_get(int index, FAR struct ipv4_flow_s *flow)
+{
+  int ret = -ENOENT;
+
+  if (index < 0 || index >= CONFIG_NET_IPFORWARD_NFLOWS)
+    {
+      return -EINVAL;
+    }
+
+  net_lock();
+  if (g_ipv4_flows[index].fl_dev != NULL)
+    {
+      memcpy(flow, &g_ipv4_flows[index], sizeof(struct ipv4_flow_s));
+      ret = OK;
+    }
+
+  net_unlock();
+  return ret;
+}
+
+#endif /* CONFIG_NET_IPFORWARD_FLOWCACHE */
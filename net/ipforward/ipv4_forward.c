@@ -152,8 +152,7 @@ static int ipv4_hdrsize(FAR struct ipv4_hdr_s *ipv4)
 
 static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
 {
-  uint16_t iphdrlen;
-  uint16_t sum;
+  uint32_t sum;
   int ttl;
 
   /* Check time-to-live (TTL) */
@@ -176,27 +175,13 @@ static int ipv4_decr_ttl(FAR struct ipv4_hdr_s *ipv4)
 
   ipv4->ttl = ttl;
 
-  /* Get the IP header length (accounting for possible options). */
-
-  iphdrlen = (ipv4->vhl & IPv4_HLMASK) << 2;
-
-  /* Re-calculate the IPv4 checksum.  This checksum is the Internet checksum
-   * of the 20 bytes of the IPv4 header.  This checksum will be different
-   * because we just modify the IPv4 TTL.
+  /* Update the IPv4 checksum incrementally (RFC 1624) instead of
+   * calculating it again over the whole header.  The TTL is the upper byte
+   * of its 16-bit word so the complemented sum grows by 0x0100.
    */
 
-  ipv4->ipchksum = 0;
-  sum            = chksum(0, (FAR const uint8_t *)ipv4, iphdrlen);
-  if (sum == 0)
-    {
-      sum = 0xffff;
-    }
-  else
-    {
-      sum = htons(sum);
-    }
-
-  ipv4->ipchksum = ~sum;
+  sum            = ipv4->ipchksum + HTONS(0x0100);
+  ipv4->ipchksum = (uint16_t)(sum + (sum >= 0xffff));
   return ttl;
 }
 
@@ -441,17 +426,23 @@ int ipv4_forward_callback(FAR struct net_driver_s *fwddev, FAR void *arg)
 
 int ipv4_forward(FAR struct net_driver_s *dev, FAR struct ipv4_hdr_s *ipv4)
 {
+#ifndef CONFIG_NET_IPFORWARD_FLOWCACHE
   in_addr_t destipaddr;
   in_addr_t srcipaddr;
+#endif
   FAR struct net_driver_s *fwddev;
   int ret;
 
   /* Search for a device that can forward this packet. */
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  fwddev     = ipv4_flow_route(ipv4, dev->d_len);
+#else
   destipaddr = net_ip4addr_conv32(ipv4->destipaddr);
   srcipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
 
   fwddev     = netdev_findby_ripv4addr(srcipaddr, destipaddr);
+#endif
   if (fwddev == NULL)
     {
       nwarn("WARNING: Not routable\n");
@@ -74,6 +74,9 @@
 #define LOCAL_SYNC_BYTE   0x42     /* Byte in sync sequence */
 #define LOCAL_END_BYTE    0xbd     /* End of sync sequence */
 
+#define LOCAL_PREAMBLE_SIZE 8      /* Sync bytes plus the end byte */
+#define LOCAL_HEADER_SIZE   (LOCAL_PREAMBLE_SIZE + sizeof(uint16_t))
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -129,6 +129,23 @@ errout:
 }
 #endif
 
+/****************************************************************************
+ * Name: local_inout_pollcb
+ *
+ * Description:
+ *   Forward the events reported on one of the shadow pollfds of a POLLIN |
+ *   POLLOUT poll to the pollfd of the caller.
+ *
+ ****************************************************************************/
+
+static void local_inout_pollcb(FAR struct pollfd *fds)
+{
+  FAR struct pollfd *originfds = fds->arg;
+
+  originfds->revents |= fds->revents;
+  poll_notify(originfds);
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -152,7 +169,7 @@ void local_accept_pollnotify(FAR struct local_conn_s *conn,
           if (fds->revents != 0)
             {
               ninfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
@@ -230,13 +247,19 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
                 }
             }
 
-          shadowfds[0].fd     = 1; /* Does not matter */
-          shadowfds[0].sem    = fds->sem;
-          shadowfds[0].events = fds->events & ~POLLOUT;
+          shadowfds[0].fd      = 1; /* Does not matter */
+          shadowfds[0].sem     = fds->sem;
+          shadowfds[0].events  = fds->events & ~POLLOUT;
+          shadowfds[0].revents = 0;
+          shadowfds[0].cb      = local_inout_pollcb;
+          shadowfds[0].arg     = fds;
 
-          shadowfds[1].fd     = 0; /* Does not matter */
-          shadowfds[1].sem    = fds->sem;
-          shadowfds[1].events = fds->events & ~POLLIN;
+          shadowfds[1].fd      = 0; /* Does not matter */
+          shadowfds[1].sem     = fds->sem;
+          shadowfds[1].events  = fds->events & ~POLLIN;
+          shadowfds[1].revents = 0;
+          shadowfds[1].cb      = local_inout_pollcb;
+          shadowfds[1].arg     = fds;
 
           net_unlock();
 
@@ -304,7 +327,7 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
 #ifdef CONFIG_NET_LOCAL_STREAM
 pollerr:
   fds->revents |= POLLERR;
-  nxsem_post(fds->sem);
+  poll_notify(fds);
   return OK;
 #endif
 }
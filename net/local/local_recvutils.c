@@ -141,15 +141,45 @@ errout:
 
 int local_sync(FAR struct file *filep)
 {
+  uint8_t header[LOCAL_HEADER_SIZE];
   size_t readlen;
   uint16_t pktlen;
   uint8_t sync;
   int ret;
+  int i;
 
-  /* Loop until a valid pre-amble is encountered:  SYNC bytes followed
-   * by one END byte.
+  /* The sender writes the preamble and the packet length at once, so the
+   * whole header is normally read at once, too.
    */
 
+  readlen = LOCAL_HEADER_SIZE;
+  ret     = local_fifo_read(filep, header, &readlen);
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to read sync bytes: %d\n", ret);
+      return ret;
+    }
+
+  for (i = 0; i < LOCAL_PREAMBLE_SIZE - 1; i++)
+    {
+      if (header[i] != LOCAL_SYNC_BYTE)
+        {
+          break;
+        }
+    }
+
+  if (i == LOCAL_PREAMBLE_SIZE - 1 && header[i] == LOCAL_END_BYTE)
+    {
+      memcpy(&pktlen, &header[LOCAL_PREAMBLE_SIZE], sizeof(uint16_t));
+      return pktlen;
+    }
+
+  /* The FIFO has lost sync.  Loop until a valid pre-amble is encountered:
+   * SYNC bytes followed by one END byte.
+   */
+
+  nwarn("WARNING: Lost sync\n");
+
   do
     {
       /* Read until we encounter a sync byte */
@@ -42,6 +42,7 @@
 #include <sys/types.h>
 #include <stdint.h>
 #include <unistd.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -52,12 +53,6 @@
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_LOCAL)
 
-/****************************************************************************
- * Pre-processor Definitions
- ****************************************************************************/
-
-#define LOCAL_PREAMBLE_SIZE 8
-
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -142,25 +137,22 @@ static int local_fifo_write(FAR struct file *filep, FAR const uint8_t *buf,
 int local_send_packet(FAR struct file *filep, FAR const uint8_t *buf,
                       size_t len)
 {
+  uint8_t header[LOCAL_HEADER_SIZE];
   uint16_t len16;
   int ret;
 
-  /* Send the packet preamble */
+  /* Send the packet preamble and the packet length with one write */
 
-  ret = local_fifo_write(filep, g_preamble, LOCAL_PREAMBLE_SIZE);
+  len16 = len;
+  memcpy(header, g_preamble, LOCAL_PREAMBLE_SIZE);
+  memcpy(&header[LOCAL_PREAMBLE_SIZE], &len16, sizeof(uint16_t));
+
+  ret = local_fifo_write(filep, header, LOCAL_HEADER_SIZE);
   if (ret == OK)
     {
-      /* Send the packet length */
-
-      len16 = len;
-      ret = local_fifo_write(filep, (FAR const uint8_t *)&len16,
-                             sizeof(uint16_t));
-      if (ret == OK)
-        {
-          /* Send the packet data */
+      /* Send the packet data */
 
-          ret = local_fifo_write(filep, buf, len);
-        }
+      ret = local_fifo_write(filep, buf, len);
     }
 
   return ret;
@@ -110,6 +110,9 @@ const struct sock_intf_s g_local_sockif =
   NULL,              /* si_sendfile */
 #endif
   local_recvfrom,    /* si_recvfrom */
+#ifdef CONFIG_NET_TIMESTAMP
+  NULL,              /* si_recvmsg */
+#endif
   local_close        /* si_close */
 };
 
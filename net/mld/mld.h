@@ -167,6 +167,14 @@
 #define IS_MLD_WAITMSG(f)        (((f) & MLD_WAITMSG) != 0)
 #define IS_MLD_RPTPEND(f)        (((f) & MLD_RPTPEND) != 0)
 
+/* Each group sets one bit of d_mld.grpmap, selected by the low 32 bits of
+ * the group address.  These are the bits that are also used for the
+ * multicast MAC address.  A clear bit means that there is no such group.
+ */
+
+#define MLD_GRPBIT(a) \
+  ((uint32_t)1 << (((a)[6] ^ ((a)[6] >> 8) ^ (a)[7] ^ ((a)[7] >> 8)) & 31))
+
 /* Debug ********************************************************************/
 
 #ifdef CONFIG_NET_MLD_DEBUG
@@ -160,6 +160,7 @@ FAR struct mld_group_s *mld_grpalloc(FAR struct net_driver_s *dev,
       /* Add the group structure to the list in the device structure */
 
       sq_addfirst((FAR sq_entry_t *)group, &dev->d_mld.grplist);
+      dev->d_mld.grpmap |= MLD_GRPBIT(addr);
     }
 
   return group;
@@ -190,6 +191,15 @@ FAR struct mld_group_s *mld_grpfind(FAR struct net_driver_s *dev,
           addr[0], addr[1], addr[2], addr[3], addr[4], addr[5], addr[6],
           addr[7]);
 
+  /* Reject the groups that we have not joined without searching the
+   * list.
+   */
+
+  if ((dev->d_mld.grpmap & MLD_GRPBIT(addr)) == 0)
+    {
+      return NULL;
+    }
+
   for (group = (FAR struct mld_group_s *)dev->d_mld.grplist.head;
        group;
        group = group->next)
@@ -247,6 +257,8 @@ FAR struct mld_group_s *mld_grpallocfind(FAR struct net_driver_s *dev,
 
 void mld_grpfree(FAR struct net_driver_s *dev, FAR struct mld_group_s *group)
 {
+  FAR struct mld_group_s *tmp;
+
   mldinfo("Free: %p flags: %02x\n", group, group->flags);
 
   /* Cancel the timers */
@@ -257,6 +269,16 @@ void mld_grpfree(FAR struct net_driver_s *dev, FAR struct mld_group_s *group)
 
   sq_rem((FAR sq_entry_t *)group, &dev->d_mld.grplist);
 
+  /* Rebuild the hash of the remaining groups */
+
+  dev->d_mld.grpmap = 0;
+  for (tmp = (FAR struct mld_group_s *)dev->d_mld.grplist.head;
+       tmp;
+       tmp = tmp->next)
+    {
+      dev->d_mld.grpmap |= MLD_GRPBIT(tmp->grpaddr);
+    }
+
   /* Destroy the wait semaphore */
 
   nxsem_destroy(&group->sem);
@@ -37,6 +37,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <assert.h>
 #include <debug.h>
 
@@ -46,6 +47,7 @@
 #include <nuttx/net/mld.h>
 
 #include "devif/devif.h"
+#include "inet/inet.h"
 #include "mld/mld.h"
 
 #ifdef CONFIG_NET_MLD
@@ -87,6 +89,62 @@ static void mld_mcastmac(FAR const net_ipv6addr_t ipaddr, FAR uint8_t *mac)
           mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
 }
 
+/****************************************************************************
+ * Name:  mld_samemac
+ *
+ * Description:
+ *   Return true if two IPv6 addresses map to the same multicast MAC
+ *   address, i.e., if the low 32 bits of the addresses are the same.
+ *
+ ****************************************************************************/
+
+static bool mld_samemac(FAR const net_ipv6addr_t ipaddr1,
+                        FAR const net_ipv6addr_t ipaddr2)
+{
+  return ipaddr1[6] == ipaddr2[6] && ipaddr1[7] == ipaddr2[7];
+}
+
+/****************************************************************************
+ * Name:  mld_mcastmac_inuse
+ *
+ * Description:
+ *   Return true if the multicast MAC address of the IPv6 address is also
+ *   needed for some other address:  A different group or one of the
+ *   addresses that are always enabled by mld_devinit().  The MAC filter of
+ *   the device must be programmed only by the first user of a MAC address
+ *   and cleared only by the last.
+ *
+ ****************************************************************************/
+
+static bool mld_mcastmac_inuse(FAR struct net_driver_s *dev,
+                               FAR const net_ipv6addr_t ipaddr)
+{
+  FAR struct mld_group_s *group;
+
+  if ((!net_ipv6addr_cmp(ipaddr, g_ipv6_allnodes) &&
+       mld_samemac(ipaddr, g_ipv6_allnodes)) ||
+      (!net_ipv6addr_cmp(ipaddr, g_ipv6_allrouters) &&
+       mld_samemac(ipaddr, g_ipv6_allrouters)) ||
+      (!net_ipv6addr_cmp(ipaddr, g_ipv6_allmldv2routers) &&
+       mld_samemac(ipaddr, g_ipv6_allmldv2routers)))
+    {
+      return true;
+    }
+
+  for (group = (FAR struct mld_group_s *)dev->d_mld.grplist.head;
+       group;
+       group = group->next)
+    {
+      if (!net_ipv6addr_cmp(group->grpaddr, ipaddr) &&
+          mld_samemac(group->grpaddr, ipaddr))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -106,7 +164,7 @@ void mld_addmcastmac(FAR struct net_driver_s *dev,
 
   mldinfo("Adding MAC address filter\n");
 
-  if (dev->d_addmac != NULL)
+  if (dev->d_addmac != NULL && !mld_mcastmac_inuse(dev, ipaddr))
     {
       mld_mcastmac(ipaddr, mcastmac);
       dev->d_addmac(dev, mcastmac);
@@ -128,7 +186,7 @@ void mld_removemcastmac(FAR struct net_driver_s *dev,
 
   mldinfo("Removing MAC address filter\n");
 
-  if (dev->d_rmmac != NULL)
+  if (dev->d_rmmac != NULL && !mld_mcastmac_inuse(dev, ipaddr))
     {
       mld_mcastmac(ipaddr, mcastmac);
       dev->d_rmmac(dev, mcastmac);
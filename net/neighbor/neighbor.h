@@ -46,6 +46,7 @@
  ****************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #include <net/ethernet.h>
 
@@ -56,6 +57,27 @@
 
 #ifdef CONFIG_NET_IPv6
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The hash chains link the table entries by their index plus one so that
+ * zero, the initial value of the static arrays, terminates a chain.
+ */
+
+#define NEIGHBOR_HASH_END 0
+
+#if CONFIG_NET_IPv6_NCONF_ENTRIES >= UINT16_MAX
+#  error CONFIG_NET_IPv6_NCONF_ENTRIES is too large
+#endif
+
+/* Is there output of the neighbor logic to be sent from the device poll? */
+
+#if defined(CONFIG_NET_IPv6_NEIGHBOR_QUEUE) || \
+    defined(CONFIG_NET_IPv6_NEIGHBOR_NUD)
+#  define NEIGHBOR_HAVE_POLL 1
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -66,6 +88,37 @@
 
 extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
 
+/* The heads of the hash chains and the links between the entries in use.
+ * struct neighbor_entry_s is also returned by the netlink snapshot so the
+ * links are kept aside.
+ */
+
+extern uint16_t g_neighbor_hash[CONFIG_NET_IPv6_NCONF_ENTRIES];
+extern uint16_t g_neighbor_next[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
+/****************************************************************************
+ * Inline Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_hash
+ *
+ * Description:
+ *   Return the hash chain of an IPv6 address.  Neighbors mostly differ in
+ *   the interface identifier, the lower 64 bits of the address.
+ *
+ ****************************************************************************/
+
+static inline unsigned int neighbor_hash(const net_ipv6addr_t ipaddr)
+{
+  uint32_t hash = ((uint32_t)ipaddr[4] << 16 | ipaddr[5]) ^
+                  ((uint32_t)ipaddr[6] << 16 | ipaddr[7]);
+
+  hash *= 0x9e3779b1;
+  hash ^= hash >> 16;
+  return hash % CONFIG_NET_IPv6_NCONF_ENTRIES;
+}
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -90,6 +143,23 @@ struct net_driver_s; /* Forward reference */
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr);
 
+/****************************************************************************
+ * Name: neighbor_unlink
+ *
+ * Description:
+ *   Remove an entry in use from its hash chain and mark it unused.  This
+ *   interface is internal to the neighbor implementation.
+ *
+ * Input Parameters:
+ *   neighbor - The Neighbor Table entry to remove
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void neighbor_unlink(FAR struct neighbor_entry_s *neighbor);
+
 /****************************************************************************
  * Name: neighbor_add
  *
@@ -180,6 +250,178 @@ void neighbor_update(const net_ipv6addr_t ipaddr);
 void neighbor_ethernet_out(FAR struct net_driver_s *dev);
 #endif
 
+/****************************************************************************
+ * Name: neighbor_enqueue
+ *
+ * Description:
+ *   Save a copy of the outgoing IPv6 packet in d_buf until the link layer
+ *   address of its next hop is known.  This is called before the packet
+ *   is replaced by a Neighbor Solicitation.
+ *
+ * Input Parameters:
+ *   dev    - The network device with the packet to send
+ *   ipaddr - The IPv6 address of the next hop being resolved
+ *
+ * Returned Value:
+ *   None.  The packet is simply not queued if it cannot be saved.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6_NEIGHBOR_QUEUE
+void neighbor_enqueue(FAR struct net_driver_s *dev,
+                      const net_ipv6addr_t ipaddr);
+#endif
+
+/****************************************************************************
+ * Name: neighbor_resolved
+ *
+ * Description:
+ *   Notify the queue that a Neighbor Table entry was added.  The network
+ *   device is polled to send the packets waiting for that neighbor.
+ *
+ * Input Parameters:
+ *   dev    - The network device that received the link layer address
+ *   ipaddr - The IPv6 address of the neighbor
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6_NEIGHBOR_QUEUE
+void neighbor_resolved(FAR struct net_driver_s *dev,
+                       const net_ipv6addr_t ipaddr);
+#else
+#  define neighbor_resolved(dev,ipaddr)
+#endif
+
+/****************************************************************************
+ * Name: neighbor_dequeue
+ *
+ * Description:
+ *   Copy the oldest queued packet of a device whose next hop is now in the
+ *   Neighbor Table into d_buf.  Queued packets that waited too long are
+ *   dropped.
+ *
+ * Input Parameters:
+ *   dev - The network device being polled
+ *
+ * Returned Value:
+ *   True if a packet was copied into d_buf.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6_NEIGHBOR_QUEUE
+bool neighbor_dequeue(FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: neighbor_reachable
+ *
+ * Description:
+ *   Check the reachability of a Neighbor Table entry that is about to be
+ *   used.  An entry that was not confirmed within the reachable time is
+ *   marked to be probed.  An entry that did not answer its probes is
+ *   removed.
+ *
+ * Input Parameters:
+ *   neighbor - The Neighbor Table entry
+ *
+ * Returned Value:
+ *   Zero (OK) if the entry may be used; -ENETUNREACH if it was removed.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6_NEIGHBOR_NUD
+int neighbor_reachable(FAR struct neighbor_entry_s *neighbor);
+#else
+#  define neighbor_reachable(neighbor) (0)
+#endif
+
+/****************************************************************************
+ * Name: neighbor_confirm
+ *
+ * Description:
+ *   Forget any probing of a Neighbor Table entry that was confirmed,
+ *   updated or replaced.
+ *
+ * Input Parameters:
+ *   neighbor - The Neighbor Table entry
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6_NEIGHBOR_NUD
+void neighbor_confirm(FAR struct neighbor_entry_s *neighbor);
+#else
+#  define neighbor_confirm(neighbor)
+#endif
+
+/****************************************************************************
+ * Name: neighbor_probe
+ *
+ * Description:
+ *   Build the next due unreachability probe for a neighbor on the network
+ *   of a device in d_buf.
+ *
+ * Input Parameters:
+ *   dev - The network device being polled
+ *
+ * Returned Value:
+ *   True if a Neighbor Solicitation was built in d_buf.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv6_NEIGHBOR_NUD
+bool neighbor_probe(FAR struct net_driver_s *dev);
+#endif
+
+/****************************************************************************
+ * Name: neighbor_poll
+ *
+ * Description:
+ *   Send the queued packets whose neighbor was resolved and the due
+ *   unreachability probes.  This is called from devif_poll().
+ *
+ * Input Parameters:
+ *   dev      - The network device being polled
+ *   callback - The poll callback of the device
+ *
+ * Returned Value:
+ *   The value returned by the last callback; non-zero stops the poll.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef NEIGHBOR_HAVE_POLL
+int neighbor_poll(FAR struct net_driver_s *dev,
+                  devif_poll_callback_t callback);
+#else
+#  define neighbor_poll(d,c) (0)
+#endif
+
 /****************************************************************************
  * Name: neighbor_snapshot
  *
@@ -55,6 +55,7 @@
 #include <nuttx/net/neighbor.h>
 
 #include "netdev/netdev.h"
+#include "inet/inet.h"
 #include "neighbor/neighbor.h"
 
 /****************************************************************************
@@ -81,6 +82,8 @@
 void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
                   FAR uint8_t *addr)
 {
+  unsigned int link;
+  unsigned int hash;
   uint8_t lltype;
   clock_t oldest_time;
   int     oldest_ndx;
@@ -88,38 +91,66 @@ void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
 
   DEBUGASSERT(dev != NULL && addr != NULL);
 
-  /* Find the matching entry, first unused entry, or the oldest used entry.
-   * The unused entry will have ne_time == 0 and should generate the oldest
-   * time.  REVISIT:  Could this fail on clock wraparound?  A more explicit
-   * check might be to compare ne_ipaddr with the IPv6 unspecified address.
-   */
+  /* Look up the matching entry in the hash chain of the address */
 
-  oldest_time = g_neighbors[0].ne_time;
-  oldest_ndx  = 0;
-  lltype      = dev->d_lltype;
+  lltype = dev->d_lltype;
+  hash   = neighbor_hash(ipaddr);
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  for (link = g_neighbor_hash[hash]; link != NEIGHBOR_HASH_END;
+       link = g_neighbor_next[link - 1])
     {
-      if (g_neighbors[i].ne_addr.na_lltype == lltype &&
-          net_ipv6addr_cmp(g_neighbors[i].ne_ipaddr, ipaddr))
+      if (g_neighbors[link - 1].ne_addr.na_lltype == lltype &&
+          net_ipv6addr_cmp(g_neighbors[link - 1].ne_ipaddr, ipaddr))
         {
-          oldest_ndx = i;
           break;
         }
+    }
+
+  if (link != NEIGHBOR_HASH_END)
+    {
+      oldest_ndx = link - 1;
+    }
+  else
+    {
+      /* Otherwise use the first unused entry or the oldest used entry.
+       * An unused entry has the IPv6 unspecified address.
+       */
+
+      oldest_time = g_neighbors[0].ne_time;
+      oldest_ndx  = 0;
 
-      if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
+      for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
         {
-          oldest_ndx = i;
-          oldest_time = g_neighbors[i].ne_time;
+          if (net_ipv6addr_cmp(g_neighbors[i].ne_ipaddr,
+                               g_ipv6_unspecaddr))
+            {
+              oldest_ndx = i;
+              break;
+            }
+
+          if ((int)(g_neighbors[i].ne_time - oldest_time) < 0)
+            {
+              oldest_ndx = i;
+              oldest_time = g_neighbors[i].ne_time;
+            }
         }
+
+      if (!net_ipv6addr_cmp(g_neighbors[oldest_ndx].ne_ipaddr,
+                            g_ipv6_unspecaddr))
+        {
+          neighbor_dumpentry("Replaced entry", &g_neighbors[oldest_ndx]);
+          neighbor_unlink(&g_neighbors[oldest_ndx]);
+        }
+
+      net_ipv6addr_copy(g_neighbors[oldest_ndx].ne_ipaddr, ipaddr);
+      g_neighbor_next[oldest_ndx] = g_neighbor_hash[hash];
+      g_neighbor_hash[hash]       = oldest_ndx + 1;
     }
 
-  /* Use the oldest or first free entry (either pointed to by the
-   * "oldest_ndx" variable).
-   */
+  /* The neighbor is known to be reachable now */
 
+  neighbor_confirm(&g_neighbors[oldest_ndx]);
   g_neighbors[oldest_ndx].ne_time = clock_systime_ticks();
-  net_ipv6addr_copy(g_neighbors[oldest_ndx].ne_ipaddr, ipaddr);
 
   g_neighbors[oldest_ndx].ne_addr.na_lltype = lltype;
   g_neighbors[oldest_ndx].ne_addr.na_llsize = netdev_lladdrsize(dev);
@@ -130,4 +161,8 @@ void neighbor_add(FAR struct net_driver_s *dev, FAR net_ipv6addr_t ipaddr,
   /* Dump the contents of the new entry */
 
   neighbor_dumpentry("Added entry", &g_neighbors[oldest_ndx]);
+
+  /* Send the packets that wait for this neighbor */
+
+  neighbor_resolved(dev, ipaddr);
 }
@@ -104,7 +104,9 @@
  *   the packet in the d_buf is replaced by an ICMPv6 Neighbor Solicit
  *   request packet for the IPv6 address. The IPv6 packet is dropped and
  *   it is assumed that the higher level protocols (e.g., TCP) eventually
- *   will retransmit the dropped packet.
+ *   will retransmit the dropped packet.  With
+ *   CONFIG_NET_IPv6_NEIGHBOR_QUEUE, a copy of the packet is sent when the
+ *   neighbor answers instead.
  *
  *   Upon return in either the case, a packet to be sent is present in the
  *   d_buf buffer and the d_len field holds the length of the Ethernet
@@ -180,12 +182,22 @@ void neighbor_ethernet_out(FAR struct net_driver_s *dev)
         {
            ninfo("IPv6 Neighbor solicitation for IPv6\n");
 
+#ifdef CONFIG_NET_IPv6_NEIGHBOR_QUEUE
+          /* Keep a copy of the IPv6 packet.  It is sent when the Neighbor
+           * Advertisement arrives.
+           */
+
+          neighbor_enqueue(dev, ipaddr);
+#endif
+
           /* The destination address was not in our Neighbor Table, so we
            * overwrite the IPv6 packet with an ICMDv6 Neighbor Solicitation
            * message.
            */
 
           icmpv6_solicit(dev, ipaddr);
+          netdev_iob_txreset(dev);
+          netdev_txtstamp_reset(dev);
         }
     }
 
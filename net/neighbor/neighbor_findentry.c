@@ -70,11 +70,13 @@
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
 {
-  int i;
+  unsigned int link;
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  for (link = g_neighbor_hash[neighbor_hash(ipaddr)];
+       link != NEIGHBOR_HASH_END;
+       link = g_neighbor_next[link - 1])
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
+      FAR struct neighbor_entry_s *neighbor = &g_neighbors[link - 1];
 
       if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
         {
@@ -86,3 +88,37 @@ FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
   neighbor_dumpipaddr("Not found", ipaddr);
   return NULL;
 }
+
+/****************************************************************************
+ * Name: neighbor_unlink
+ *
+ * Description:
+ *   Remove an entry in use from its hash chain and mark it unused.  This
+ *   interface is internal to the neighbor implementation.
+ *
+ * Input Parameters:
+ *   neighbor - The Neighbor Table entry to remove
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void neighbor_unlink(FAR struct neighbor_entry_s *neighbor)
+{
+  unsigned int index = neighbor - g_neighbors;
+  FAR uint16_t *link = &g_neighbor_hash[neighbor_hash(neighbor->ne_ipaddr)];
+
+  while (*link != NEIGHBOR_HASH_END)
+    {
+      if (*link == index + 1)
+        {
+          *link = g_neighbor_next[index];
+          break;
+        }
+
+      link = &g_neighbor_next[*link - 1];
+    }
+
+  memset(neighbor, 0, sizeof(*neighbor));
+}
@@ -56,6 +56,11 @@
 
 struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
 
+/* The heads of the hash chains and the links between the entries in use */
+
+uint16_t g_neighbor_hash[CONFIG_NET_IPv6_NCONF_ENTRIES];
+uint16_t g_neighbor_next[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
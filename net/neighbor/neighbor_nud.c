@@ -0,0 +1,249 @@
+/****************************************************************************
+ * net/neighbor/neighbor_nud.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/netdev.h>
+
+#include "icmpv6/icmpv6.h"
+#include "neighbor/neighbor.h"
+
+#ifdef CONFIG_NET_IPv6_NEIGHBOR_NUD
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* RFC 4861: REACHABLE_TIME, RETRANS_TIMER and MAX_UNICAST_SOLICIT */
+
+#define NEIGHBOR_REACHABLE_TICK SEC2TICK(CONFIG_NET_IPv6_NEIGHBOR_REACHABLE)
+#define NEIGHBOR_PROBE_TICK     SEC2TICK(1)
+#define NEIGHBOR_MAX_PROBES     3
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The probe state of each entry:  Zero if the entry is not probed, else
+ * the number of probes sent plus one.  And the time of the last probe.
+ */
+
+static uint8_t g_neighbor_probe[CONFIG_NET_IPv6_NCONF_ENTRIES];
+static clock_t g_neighbor_probetime[CONFIG_NET_IPv6_NCONF_ENTRIES];
+
+/* The number of entries being probed */
+
+static uint16_t g_neighbor_nprobing;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_expired
+ *
+ * Description:
+ *   Return true if the last probe of an entry was not answered in time.
+ *
+ ****************************************************************************/
+
+static bool neighbor_expired(int index, clock_t now)
+{
+  return g_neighbor_probe[index] > NEIGHBOR_MAX_PROBES &&
+         now - g_neighbor_probetime[index] >= NEIGHBOR_PROBE_TICK;
+}
+
+/****************************************************************************
+ * Name: neighbor_remove
+ *
+ * Description:
+ *   Remove an unreachable entry from the Neighbor Table.
+ *
+ ****************************************************************************/
+
+static void neighbor_remove(FAR struct neighbor_entry_s *neighbor)
+{
+  neighbor_dumpentry("Unreachable entry", neighbor);
+  neighbor_confirm(neighbor);
+  neighbor_unlink(neighbor);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_reachable
+ *
+ * Description:
+ *   Check the reachability of a Neighbor Table entry that is about to be
+ *   used.  An entry that was not confirmed within the reachable time is
+ *   marked to be probed.  An entry that did not answer its probes is
+ *   removed.
+ *
+ * Input Parameters:
+ *   neighbor - The Neighbor Table entry
+ *
+ * Returned Value:
+ *   Zero (OK) if the entry may be used; -ENETUNREACH if it was removed.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int neighbor_reachable(FAR struct neighbor_entry_s *neighbor)
+{
+  int index = neighbor - g_neighbors;
+  clock_t now = clock_systime_ticks();
+
+  if (g_neighbor_probe[index] == 0)
+    {
+      /* Probe the neighbor in the background if it is stale.  Until then
+       * the entry is used as it is.
+       */
+
+      if (now - neighbor->ne_time > NEIGHBOR_REACHABLE_TICK)
+        {
+          g_neighbor_probe[index] = 1;
+          g_neighbor_nprobing++;
+        }
+    }
+  else if (neighbor_expired(index, now))
+    {
+      neighbor_remove(neighbor);
+      return -ENETUNREACH;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: neighbor_confirm
+ *
+ * Description:
+ *   Forget any probing of a Neighbor Table entry that was confirmed,
+ *   updated or replaced.
+ *
+ * Input Parameters:
+ *   neighbor - The Neighbor Table entry
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void neighbor_confirm(FAR struct neighbor_entry_s *neighbor)
+{
+  int index = neighbor - g_neighbors;
+
+  if (g_neighbor_probe[index] != 0)
+    {
+      g_neighbor_probe[index] = 0;
+      g_neighbor_nprobing--;
+    }
+}
+
+/****************************************************************************
+ * Name: neighbor_probe
+ *
+ * Description:
+ *   Build the next due unreachability probe for a neighbor on the network
+ *   of a device in d_buf.
+ *
+ * Input Parameters:
+ *   dev - The network device being polled
+ *
+ * Returned Value:
+ *   True if a Neighbor Solicitation was built in d_buf.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool neighbor_probe(FAR struct net_driver_s *dev)
+{
+  clock_t now;
+  int i;
+
+  if (g_neighbor_nprobing == 0)
+    {
+      return false;
+    }
+
+  now = clock_systime_ticks();
+  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; i++)
+    {
+      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
+
+      if (g_neighbor_probe[i] == 0)
+        {
+          continue;
+        }
+
+      if (neighbor_expired(i, now))
+        {
+          neighbor_remove(neighbor);
+          continue;
+        }
+
+      /* Is a probe due and is the neighbor on the link of this device?
+       * Link-local addresses, like those of routers, are on every link.
+       */
+
+      if ((g_neighbor_probe[i] > 1 &&
+           now - g_neighbor_probetime[i] < NEIGHBOR_PROBE_TICK) ||
+          g_neighbor_probe[i] > NEIGHBOR_MAX_PROBES ||
+          neighbor->ne_addr.na_lltype != dev->d_lltype ||
+          (!net_is_addr_linklocal(neighbor->ne_ipaddr) &&
+           !net_ipv6addr_maskcmp(neighbor->ne_ipaddr, dev->d_ipv6addr,
+                                 dev->d_ipv6netmask)))
+        {
+          continue;
+        }
+
+      neighbor_dumpentry("Probing entry", neighbor);
+      icmpv6_solicit(dev, neighbor->ne_ipaddr);
+
+      g_neighbor_probe[i]++;
+      g_neighbor_probetime[i] = now;
+      return true;
+    }
+
+  return false;
+}
+
+#endif /* CONFIG_NET_IPv6_NEIGHBOR_NUD */
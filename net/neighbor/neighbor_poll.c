@@ -0,0 +1,96 @@
+/****************************************************************************
+ * net/neighbor/neighbor_poll.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <net/if.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "neighbor/neighbor.h"
+
+#ifdef NEIGHBOR_HAVE_POLL
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_poll
+ *
+ * Description:
+ *   Send the queued packets whose neighbor was resolved and the due
+ *   unreachability probes.  This is called from devif_poll().
+ *
+ * Input Parameters:
+ *   dev      - The network device being polled
+ *   callback - The poll callback of the device
+ *
+ * Returned Value:
+ *   The value returned by the last callback; non-zero stops the poll.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int neighbor_poll(FAR struct net_driver_s *dev,
+                  devif_poll_callback_t callback)
+{
+  int bstop = 0;
+
+  /* Only Ethernet-like devices resolve neighbors this way */
+
+  if (dev->d_lltype != NET_LL_ETHERNET &&
+      dev->d_lltype != NET_LL_IEEE80211)
+    {
+      return 0;
+    }
+
+#ifdef CONFIG_NET_IPv6_NEIGHBOR_QUEUE
+  /* The driver adds the link layer header in its callback with
+   * neighbor_out(), which now finds the neighbor.
+   */
+
+  while (!bstop && neighbor_dequeue(dev))
+    {
+      IFF_SET_IPv6(dev->d_flags);
+      bstop = callback(dev);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6_NEIGHBOR_NUD
+  if (!bstop && neighbor_probe(dev))
+    {
+      IFF_SET_IPv6(dev->d_flags);
+      bstop = callback(dev);
+    }
+#endif
+
+  return bstop;
+}
+
+#endif /* NEIGHBOR_HAVE_POLL */
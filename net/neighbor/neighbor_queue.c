@@ -0,0 +1,296 @@
+/****************************************************************************
+ * net/neighbor/neighbor_queue.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <debug.h>
+
+#include <net/if.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+#include "neighbor/neighbor.h"
+
+#ifdef CONFIG_NET_IPv6_NEIGHBOR_QUEUE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* A queued packet is dropped if the neighbor is not resolved in this time.
+ * This covers the retries of the Neighbor Solicitation.
+ */
+
+#define NEIGHBOR_QUEUE_TICK SEC2TICK(3)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A packet waiting for neighbor resolution */
+
+struct neighbor_pending_s
+{
+  FAR struct iob_s        *np_iob;    /* The IPv6 packet, NULL if unused */
+  FAR struct net_driver_s *np_dev;    /* The device to send it on */
+  net_ipv6addr_t           np_ipaddr; /* The IPv6 address of the next hop */
+  clock_t                  np_time;   /* When the packet was queued */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct neighbor_pending_s
+  g_neighbor_queue[CONFIG_NET_IPv6_NEIGHBOR_QUEUE_SIZE];
+
+/* The number of queued packets */
+
+static uint16_t g_neighbor_nqueued;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_drop
+ *
+ * Description:
+ *   Free a queued packet.
+ *
+ ****************************************************************************/
+
+static void neighbor_drop(FAR struct neighbor_pending_s *pend)
+{
+  iob_free_chain(pend->np_iob, IOBUSER_NET_NEIGHBOR);
+  pend->np_iob = NULL;
+  pend->np_dev = NULL;
+  g_neighbor_nqueued--;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_enqueue
+ *
+ * Description:
+ *   Save a copy of the outgoing IPv6 packet in d_buf until the link layer
+ *   address of its next hop is known.  This is called before the packet
+ *   is replaced by a Neighbor Solicitation.
+ *
+ * Input Parameters:
+ *   dev    - The network device with the packet to send
+ *   ipaddr - The IPv6 address of the next hop being resolved
+ *
+ * Returned Value:
+ *   None.  The packet is simply not queued if it cannot be saved.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void neighbor_enqueue(FAR struct net_driver_s *dev,
+                      const net_ipv6addr_t ipaddr)
+{
+  FAR struct neighbor_pending_s *pend = &g_neighbor_queue[0];
+  FAR struct iob_s *iob;
+  int ret;
+  int i;
+
+#ifdef CONFIG_NETDEV_IOB_TX
+  /* The payload may still be in the TCP write buffer.  Frames that exceed
+   * the device buffer (TSO) are not queued.
+   */
+
+  if (dev->d_txiob != NULL)
+    {
+      if (NET_LL_HDRLEN(dev) + dev->d_len > NETDEV_PKTSIZE(dev))
+        {
+          return;
+        }
+
+      netdev_iob_txlinearize(dev);
+    }
+#endif
+
+  /* Use an unused entry or drop the oldest packet */
+
+  for (i = 0; i < CONFIG_NET_IPv6_NEIGHBOR_QUEUE_SIZE; i++)
+    {
+      if (g_neighbor_queue[i].np_iob == NULL)
+        {
+          pend = &g_neighbor_queue[i];
+          break;
+        }
+
+      if ((int)(g_neighbor_queue[i].np_time - pend->np_time) < 0)
+        {
+          pend = &g_neighbor_queue[i];
+        }
+    }
+
+  if (pend->np_iob != NULL)
+    {
+      nwarn("WARNING: Neighbor queue full, dropping oldest packet\n");
+      neighbor_drop(pend);
+    }
+
+  iob = iob_tryalloc(false, IOBUSER_NET_NEIGHBOR);
+  if (iob == NULL)
+    {
+      nwarn("WARNING: iob_tryalloc() failed\n");
+      return;
+    }
+
+  ret = iob_trycopyin(iob, &dev->d_buf[NET_LL_HDRLEN(dev)], dev->d_len, 0,
+                      false, IOBUSER_NET_NEIGHBOR);
+  if (ret < 0)
+    {
+      nwarn("WARNING: iob_trycopyin() failed: %d\n", ret);
+      iob_free_chain(iob, IOBUSER_NET_NEIGHBOR);
+      return;
+    }
+
+  pend->np_iob  = iob;
+  pend->np_dev  = dev;
+  pend->np_time = clock_systime_ticks();
+  net_ipv6addr_copy(pend->np_ipaddr, ipaddr);
+  g_neighbor_nqueued++;
+}
+
+/****************************************************************************
+ * Name: neighbor_resolved
+ *
+ * Description:
+ *   Notify the queue that a Neighbor Table entry was added.  The network
+ *   device is polled to send the packets waiting for that neighbor.
+ *
+ * Input Parameters:
+ *   dev    - The network device that received the link layer address
+ *   ipaddr - The IPv6 address of the neighbor
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void neighbor_resolved(FAR struct net_driver_s *dev,
+                       const net_ipv6addr_t ipaddr)
+{
+  int i;
+
+  if (g_neighbor_nqueued == 0)
+    {
+      return;
+    }
+
+  for (i = 0; i < CONFIG_NET_IPv6_NEIGHBOR_QUEUE_SIZE; i++)
+    {
+      if (g_neighbor_queue[i].np_iob != NULL &&
+          g_neighbor_queue[i].np_dev == dev &&
+          net_ipv6addr_cmp(g_neighbor_queue[i].np_ipaddr, ipaddr))
+        {
+          netdev_txnotify_dev(dev);
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: neighbor_dequeue
+ *
+ * Description:
+ *   Copy the oldest queued packet of a device whose next hop is now in the
+ *   Neighbor Table into d_buf.  Queued packets that waited too long are
+ *   dropped.
+ *
+ * Input Parameters:
+ *   dev - The network device being polled
+ *
+ * Returned Value:
+ *   True if a packet was copied into d_buf.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+bool neighbor_dequeue(FAR struct net_driver_s *dev)
+{
+  FAR struct neighbor_pending_s *pend = NULL;
+  clock_t now;
+  int i;
+
+  if (g_neighbor_nqueued == 0)
+    {
+      return false;
+    }
+
+  now = clock_systime_ticks();
+  for (i = 0; i < CONFIG_NET_IPv6_NEIGHBOR_QUEUE_SIZE; i++)
+    {
+      FAR struct neighbor_pending_s *tmp = &g_neighbor_queue[i];
+
+      if (tmp->np_iob == NULL || tmp->np_dev != dev)
+        {
+          continue;
+        }
+
+      if (now - tmp->np_time > NEIGHBOR_QUEUE_TICK)
+        {
+          neighbor_dumpipaddr("Unresolved, dropping packet", tmp->np_ipaddr);
+          neighbor_drop(tmp);
+        }
+      else if (neighbor_findentry(tmp->np_ipaddr) != NULL &&
+               (pend == NULL || (int)(tmp->np_time - pend->np_time) < 0))
+        {
+          pend = tmp;
+        }
+    }
+
+  if (pend == NULL)
+    {
+      return false;
+    }
+
+  dev->d_len = pend->np_iob->io_pktlen;
+  iob_copyout(&dev->d_buf[NET_LL_HDRLEN(dev)], pend->np_iob, dev->d_len, 0);
+  neighbor_drop(pend);
+  return true;
+}
+
+#endif /* CONFIG_NET_IPv6_NEIGHBOR_QUEUE */
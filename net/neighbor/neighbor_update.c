@@ -72,6 +72,7 @@ void neighbor_update(const net_ipv6addr_t ipaddr)
   neighbor = neighbor_findentry(ipaddr);
   if (neighbor != NULL)
     {
+      neighbor_confirm(neighbor);
       neighbor->ne_time = clock_systime_ticks();
     }
 }
@@ -108,6 +108,7 @@ EXTERN uint32_t g_devfreed;
 /* Callback from netdev_foreach() */
 
 struct net_driver_s; /* Forward reference */
+struct iob_s;        /* Forward reference */
 typedef int (*netdev_callback_t)(FAR struct net_driver_s *dev, FAR void *arg);
 
 /****************************************************************************
@@ -570,6 +571,82 @@ int netdown_notifier_teardown(int key);
 void netdown_notifier_signal(FAR struct net_driver_s *dev);
 #endif
 
+/****************************************************************************
+ * Name: netdev_iob_take
+ *
+ * Description:
+ *   Take over the I/O buffer holding the received frame in order to queue
+ *   its payload without copying.  The headers in front of the payload are
+ *   copied into a new I/O buffer that becomes the d_iob and d_buf of the
+ *   device, and d_appdata is updated accordingly.
+ *
+ * Input Parameters:
+ *   dev  - The network device that received the frame
+ *   data - The payload in d_buf
+ *   len  - The length of the payload
+ *
+ * Returned Value:
+ *   The I/O buffer of the frame, with io_offset and io_len set to select
+ *   the payload, is returned on success.  NULL is returned if d_buf is not
+ *   held by an I/O buffer or no new I/O buffer is available; the caller
+ *   must then copy the payload.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_RX
+FAR struct iob_s *netdev_iob_take(FAR struct net_driver_s *dev,
+                                  FAR uint8_t *data, uint16_t len);
+#endif
+
+/****************************************************************************
+ * Name: netdev_tstamp_rx
+ *
+ * Description:
+ *   Get the timestamps of the frame just received by the device:  The
+ *   software timestamp is the current CLOCK_REALTIME and the hardware
+ *   timestamp is the d_rxtime reported by the driver (zero if none).
+ *
+ * Input Parameters:
+ *   dev    - The network device that received the frame
+ *   swtime - The location to return the software timestamp
+ *   hwtime - The location to return the hardware timestamp
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMP
+void netdev_tstamp_rx(FAR struct net_driver_s *dev,
+                      FAR struct timespec *swtime,
+                      FAR struct timespec *hwtime);
+#endif
+
+/****************************************************************************
+ * Name: netdev_tstamp_tx
+ *
+ * Description:
+ *   Take the transmit timestamps requested by a socket for the frame that
+ *   is about to be sent in d_buf:  The software timestamp is taken now and
+ *   d_txtstamp is set if a hardware timestamp is requested.
+ *
+ * Input Parameters:
+ *   dev    - The network device that will send the frame
+ *   tstamp - The timestamping state of the sending socket
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMP
+void netdev_tstamp_tx(FAR struct net_driver_s *dev,
+                      FAR struct net_tstamp_s *tstamp);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
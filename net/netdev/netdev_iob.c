@@ -0,0 +1,241 @@
+/****************************************************************************
+ * net/netdev/netdev_iob.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+
+#if defined(CONFIG_NETDEV_IOB_RX) || defined(CONFIG_NETDEV_IOB_TX)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_RX
+
+/****************************************************************************
+ * Name: netdev_iob_alloc
+ *
+ * Description:
+ *   Allocate an I/O buffer that holds a whole frame of the device without
+ *   waiting:  A large I/O buffer if one is free, otherwise a normal one.
+ *
+ ****************************************************************************/
+
+static FAR struct iob_s *netdev_iob_alloc(FAR struct net_driver_s *dev,
+                                          bool throttled)
+{
+#if CONFIG_IOB_LARGE_NBUFFERS > 0
+  FAR struct iob_s *iob;
+
+  iob = iob_tryalloc_large(IOBUSER_NET_NETDEV_RX);
+  if (iob != NULL || NETDEV_PKTSIZE(dev) > CONFIG_IOB_BUFSIZE)
+    {
+      return iob;
+    }
+#endif
+
+  return iob_tryalloc(throttled, IOBUSER_NET_NETDEV_RX);
+}
+
+/****************************************************************************
+ * Name: netdev_iob_prepare
+ *
+ * Description:
+ *   Make sure that the device has an I/O buffer to receive the next frame
+ *   into and set d_buf to the data of that I/O buffer.  This should be
+ *   called by the driver before it receives each frame into d_buf.
+ *
+ * Input Parameters:
+ *   dev       - The network device
+ *   throttled - An indication of the I/O buffer should be allocated from
+ *               the throttled pool
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; -ENOMEM is returned if no I/O buffer
+ *   is available.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int netdev_iob_prepare(FAR struct net_driver_s *dev, bool throttled)
+{
+  if (dev->d_iob == NULL)
+    {
+      dev->d_iob = netdev_iob_alloc(dev, throttled);
+      if (dev->d_iob == NULL)
+        {
+          nwarn("WARNING: No I/O buffer to receive into\n");
+          return -ENOMEM;
+        }
+    }
+
+  dev->d_buf = dev->d_iob->io_data;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: netdev_iob_release
+ *
+ * Description:
+ *   Release the receive I/O buffer of the device, as when the device is
+ *   brought down.  d_buf is set to NULL.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void netdev_iob_release(FAR struct net_driver_s *dev)
+{
+  if (dev->d_iob != NULL)
+    {
+      iob_free(dev->d_iob, IOBUSER_NET_NETDEV_RX);
+      dev->d_iob = NULL;
+      dev->d_buf = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_iob_take
+ *
+ * Description:
+ *   Take over the I/O buffer holding the received frame in order to queue
+ *   its payload without copying.  The headers in front of the payload are
+ *   copied into a new I/O buffer that becomes the d_iob and d_buf of the
+ *   device, and d_appdata is updated accordingly.
+ *
+ * Input Parameters:
+ *   dev  - The network device that received the frame
+ *   data - The payload in d_buf
+ *   len  - The length of the payload
+ *
+ * Returned Value:
+ *   The I/O buffer of the frame, with io_offset and io_len set to select
+ *   the payload, is returned on success.  NULL is returned if d_buf is not
+ *   held by an I/O buffer or no new I/O buffer is available; the caller
+ *   must then copy the payload.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *netdev_iob_take(FAR struct net_driver_s *dev,
+                                  FAR uint8_t *data, uint16_t len)
+{
+  FAR struct iob_s *iob = dev->d_iob;
+  FAR struct iob_s *next;
+  unsigned int hdrlen;
+
+  /* The driver may not have received this frame with netdev_iob_prepare() */
+
+  if (iob == NULL || dev->d_buf != iob->io_data)
+    {
+      return NULL;
+    }
+
+  DEBUGASSERT(data >= dev->d_buf &&
+              data + len <= &iob->io_data[IOB_BUFSIZE(iob)]);
+
+  /* The device needs a new I/O buffer for the response to this frame and
+   * for the next frame.  Don't wait for one; the payload is copied instead.
+   */
+
+  next = netdev_iob_alloc(dev, true);
+  if (next == NULL)
+    {
+      return NULL;
+    }
+
+  /* The headers are kept in d_buf so that a response can be built in
+   * place.
+   */
+
+  hdrlen = data - dev->d_buf;
+  memcpy(next->io_data, dev->d_buf, hdrlen);
+
+  dev->d_iob     = next;
+  dev->d_buf     = next->io_data;
+  dev->d_appdata = &next->io_data[hdrlen];
+
+  /* The old I/O buffer now holds only the payload */
+
+  iob->io_flink  = NULL;
+  iob->io_offset = hdrlen;
+  iob->io_len    = len;
+  iob->io_pktlen = len;
+
+  return iob;
+}
+#endif /* CONFIG_NETDEV_IOB_RX */
+
+/****************************************************************************
+ * Name: netdev_iob_txlinearize
+ *
+ * Description:
+ *   Copy the payload of an outgoing frame from d_txiob into d_buf behind
+ *   the headers so that the whole frame is in d_buf.  This may be called by
+ *   a scatter-gather driver that cannot send the fragments of a frame.
+ *   Nothing is done if the frame is already in d_buf.
+ *
+ * Input Parameters:
+ *   dev - The network device
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_IOB_TX
+void netdev_iob_txlinearize(FAR struct net_driver_s *dev)
+{
+  if (dev->d_txiob != NULL)
+    {
+      DEBUGASSERT(dev->d_len >= dev->d_txlen &&
+                  dev->d_len <= NETDEV_PKTSIZE(dev));
+
+      iob_copyout(&dev->d_buf[dev->d_len - dev->d_txlen], dev->d_txiob,
+                  dev->d_txlen, dev->d_txoffset);
+      netdev_iob_txreset(dev);
+    }
+}
+#endif /* CONFIG_NETDEV_IOB_TX */
+
+#endif /* CONFIG_NETDEV_IOB_RX || CONFIG_NETDEV_IOB_TX */
@@ -87,9 +87,11 @@
 #include "netdev/netdev.h"
 #include "devif/devif.h"
 #include "igmp/igmp.h"
+#include "inet/inet.h"
 #include "icmpv6/icmpv6.h"
 #include "route/route.h"
 #include "netlink/netlink.h"
+#include "pkt/pkt.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -165,20 +167,25 @@
 static int ioctl_add_ipv4route(FAR struct rtentry *rtentry)
 {
   FAR struct sockaddr_in *addr;
-  in_addr_t target;
-  in_addr_t netmask;
-  in_addr_t router;
+  struct net_route_ipv4_s route;
+  int ret;
+
+  addr          = (FAR struct sockaddr_in *)&rtentry->rt_dst;
+  route.target  = (in_addr_t)addr->sin_addr.s_addr;
 
-  addr    = (FAR struct sockaddr_in *)&rtentry->rt_dst;
-  target  = (in_addr_t)addr->sin_addr.s_addr;
+  addr          = (FAR struct sockaddr_in *)&rtentry->rt_genmask;
+  route.netmask = (in_addr_t)addr->sin_addr.s_addr;
 
-  addr    = (FAR struct sockaddr_in *)&rtentry->rt_genmask;
-  netmask = (in_addr_t)addr->sin_addr.s_addr;
+  addr          = (FAR struct sockaddr_in *)&rtentry->rt_gateway;
+  route.router  = (in_addr_t)addr->sin_addr.s_addr;
 
-  addr    = (FAR struct sockaddr_in *)&rtentry->rt_gateway;
-  router  = (in_addr_t)addr->sin_addr.s_addr;
+  ret = net_addroute_ipv4(route.target, route.netmask, route.router);
+  if (ret >= 0)
+    {
+      netlink_ipv4route_notify(&route, RTM_NEWROUTE);
+    }
 
-  return net_addroute_ipv4(target, netmask, router);
+  return ret;
 }
 #endif /* HAVE_WRITABLE_IPv4ROUTE */
 
@@ -199,18 +206,26 @@ static int ioctl_add_ipv6route(FAR struct rtentry *rtentry)
   FAR struct sockaddr_in6 *target;
   FAR struct sockaddr_in6 *netmask;
   FAR struct sockaddr_in6 *gateway;
-  net_ipv6addr_t router;
+  struct net_route_ipv6_s route;
+  int ret;
 
   target  = (FAR struct sockaddr_in6 *)&rtentry->rt_dst;
   netmask = (FAR struct sockaddr_in6 *)&rtentry->rt_genmask;
+  net_ipv6addr_copy(route.target, target->sin6_addr.s6_addr16);
+  net_ipv6addr_copy(route.netmask, netmask->sin6_addr.s6_addr16);
 
   /* The router is an optional argument */
 
   gateway = (FAR struct sockaddr_in6 *)&rtentry->rt_gateway;
-  net_ipv6addr_copy(router, gateway->sin6_addr.s6_addr16);
+  net_ipv6addr_copy(route.router, gateway->sin6_addr.s6_addr16);
 
-  return net_addroute_ipv6(target->sin6_addr.s6_addr16,
-                           netmask->sin6_addr.s6_addr16, router);
+  ret = net_addroute_ipv6(route.target, route.netmask, route.router);
+  if (ret >= 0)
+    {
+      netlink_ipv6route_notify(&route, RTM_NEWROUTE);
+    }
+
+  return ret;
 }
 #endif /* HAVE_WRITABLE_IPv6ROUTE */
 
@@ -229,16 +244,26 @@ static int ioctl_add_ipv6route(FAR struct rtentry *rtentry)
 static int ioctl_del_ipv4route(FAR struct rtentry *rtentry)
 {
   FAR struct sockaddr_in *addr;
-  in_addr_t target;
-  in_addr_t netmask;
+  struct net_route_ipv4_s route;
+  int ret;
 
-  addr    = (FAR struct sockaddr_in *)&rtentry->rt_dst;
-  target  = (in_addr_t)addr->sin_addr.s_addr;
+  addr          = (FAR struct sockaddr_in *)&rtentry->rt_dst;
+  route.target  = (in_addr_t)addr->sin_addr.s_addr;
 
-  addr    = (FAR struct sockaddr_in *)&rtentry->rt_genmask;
-  netmask = (in_addr_t)addr->sin_addr.s_addr;
+  addr          = (FAR struct sockaddr_in *)&rtentry->rt_genmask;
+  route.netmask = (in_addr_t)addr->sin_addr.s_addr;
 
-  return net_delroute_ipv4(target, netmask);
+  /* The router is not needed to find the route to be deleted */
+
+  route.router  = INADDR_ANY;
+
+  ret = net_delroute_ipv4(route.target, route.netmask);
+  if (ret >= 0)
+    {
+      netlink_ipv4route_notify(&route, RTM_DELROUTE);
+    }
+
+  return ret;
 }
 #endif /* HAVE_WRITABLE_IPv4ROUTE */
 
@@ -258,12 +283,25 @@ static int ioctl_del_ipv6route(FAR struct rtentry *rtentry)
 {
   FAR struct sockaddr_in6 *target;
   FAR struct sockaddr_in6 *netmask;
+  struct net_route_ipv6_s route;
+  int ret;
 
   target  = (FAR struct sockaddr_in6 *)&rtentry->rt_dst;
   netmask = (FAR struct sockaddr_in6 *)&rtentry->rt_genmask;
+  net_ipv6addr_copy(route.target, target->sin6_addr.s6_addr16);
+  net_ipv6addr_copy(route.netmask, netmask->sin6_addr.s6_addr16);
+
+  /* The router is not needed to find the route to be deleted */
 
-  return net_delroute_ipv6(target->sin6_addr.s6_addr16,
-                           netmask->sin6_addr.s6_addr16);
+  net_ipv6addr_copy(route.router, g_ipv6_unspecaddr);
+
+  ret = net_delroute_ipv6(route.target, route.netmask);
+  if (ret >= 0)
+    {
+      netlink_ipv6route_notify(&route, RTM_DELROUTE);
+    }
+
+  return ret;
 }
 #endif /* HAVE_WRITABLE_IPv6ROUTE */
 
@@ -690,7 +728,13 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
           dev = netdev_ifr_dev(req);
           if (dev)
             {
+              if (dev->d_ipaddr != INADDR_ANY)
+                {
+                  netlink_ipv4addr_notify(dev, RTM_DELADDR);
+                }
+
               ioctl_set_ipv4addr(&dev->d_ipaddr, &req->ifr_addr);
+              netlink_ipv4addr_notify(dev, RTM_NEWADDR);
               ret = OK;
             }
         }
@@ -765,6 +809,7 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
           if (dev)
             {
               ioctl_set_ipv4addr(&dev->d_netmask, &req->ifr_addr);
+              netlink_ipv4addr_notify(dev, RTM_NEWADDR);
               ret = OK;
             }
         }
@@ -794,7 +839,13 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
             {
               FAR struct lifreq *lreq = (FAR struct lifreq *)req;
 
+              if (!net_ipv6addr_cmp(dev->d_ipv6addr, g_ipv6_unspecaddr))
+                {
+                  netlink_ipv6addr_notify(dev, RTM_DELADDR);
+                }
+
               ioctl_set_ipv6addr(dev->d_ipv6addr, &lreq->lifr_addr);
+              netlink_ipv6addr_notify(dev, RTM_NEWADDR);
               ret = OK;
             }
         }
@@ -863,6 +914,7 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
             {
               FAR struct lifreq *lreq = (FAR struct lifreq *)req;
               ioctl_set_ipv6addr(dev->d_ipv6netmask, &lreq->lifr_addr);
+              netlink_ipv6addr_notify(dev, RTM_NEWADDR);
               ret = OK;
             }
         }
@@ -1026,9 +1078,19 @@ static int netdev_ifr_ioctl(FAR struct socket *psock, int cmd,
           if (dev)
             {
 #ifdef CONFIG_NET_IPv4
+              if (dev->d_ipaddr != INADDR_ANY)
+                {
+                  netlink_ipv4addr_notify(dev, RTM_DELADDR);
+                }
+
               dev->d_ipaddr = 0;
 #endif
 #ifdef CONFIG_NET_IPv6
+              if (!net_ipv6addr_cmp(dev->d_ipv6addr, g_ipv6_unspecaddr))
+                {
+                  netlink_ipv6addr_notify(dev, RTM_DELADDR);
+                }
+
               memset(&dev->d_ipv6addr, 0, sizeof(net_ipv6addr_t));
 #endif
               ret = OK;
@@ -1702,6 +1764,15 @@ int psock_vioctl(FAR struct socket *psock, int cmd, va_list ap)
     }
 #endif
 
+#ifdef CONFIG_NET_PKT_RXRING
+  /* Check for mmap() of the receive ring of a packet socket */
+
+  if (ret == -ENOTTY && cmd == FIOC_MMAP && psock->s_domain == PF_PACKET)
+    {
+      ret = pkt_ring_mmap(psock, (FAR void **)(uintptr_t)arg);
+    }
+#endif
+
   return ret;
 }
 
@@ -0,0 +1,189 @@
+/****************************************************************************
+ * net/netdev/netdev_rxpoll.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/wqueue.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+
+#ifdef CONFIG_NETDEV_RXPOLL
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_rxpoll_work
+ *
+ * Description:
+ *   Receive up to the budget of frames with the network locked once.
+ *
+ * Input Parameters:
+ *   arg - The receive polling state
+ *
+ * Assumptions:
+ *   Runs on a worker thread.
+ *
+ ****************************************************************************/
+
+static void netdev_rxpoll_work(FAR void *arg)
+{
+  FAR struct netdev_rxpoll_s *rxpoll = (FAR struct netdev_rxpoll_s *)arg;
+  int nframes = 0;
+  int ret = 0;
+
+  net_lock();
+
+  while (nframes < rxpoll->rp_budget)
+    {
+      ret = rxpoll->rp_receive(rxpoll->rp_dev);
+      if (ret <= 0)
+        {
+          break;
+        }
+
+      nframes++;
+    }
+
+  net_unlock();
+
+  if (ret > 0)
+    {
+      /* The budget is exhausted and more frames may be pending.  Poll again
+       * with the receive interrupt still disabled, but give other work on
+       * the same work queue a chance to run first.
+       */
+
+      work_queue(rxpoll->rp_qid, &rxpoll->rp_work, netdev_rxpoll_work,
+                 rxpoll, 0);
+    }
+  else
+    {
+      if (ret < 0)
+        {
+          nerr("ERROR: Receive failed on %s: %d\n",
+               rxpoll->rp_dev->d_ifname, ret);
+        }
+
+      /* All pending frames were received.  The driver must re-enable the
+       * interrupt so that a frame that arrived after the last receive
+       * raises it again.
+       */
+
+      rxpoll->rp_enable(rxpoll->rp_dev);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_rxpoll_initialize
+ *
+ * Description:
+ *   Initialize the receive polling state of a network device.
+ *
+ * Input Parameters:
+ *   rxpoll  - The receive polling state, usually part of the driver state
+ *   dev     - The network device
+ *   qid     - The work queue to poll on (HPWORK or LPWORK)
+ *   receive - Called to receive and dispatch one frame
+ *   enable  - Called to re-enable the receive interrupt
+ *
+ ****************************************************************************/
+
+void netdev_rxpoll_initialize(FAR struct netdev_rxpoll_s *rxpoll,
+                              FAR struct net_driver_s *dev, int qid,
+                              netdev_rxpoll_receive_t receive,
+                              netdev_rxpoll_enable_t enable)
+{
+  DEBUGASSERT(rxpoll != NULL && dev != NULL && receive != NULL &&
+              enable != NULL);
+
+  memset(rxpoll, 0, sizeof(struct netdev_rxpoll_s));
+  rxpoll->rp_dev     = dev;
+  rxpoll->rp_receive = receive;
+  rxpoll->rp_enable  = enable;
+  rxpoll->rp_qid     = qid;
+  rxpoll->rp_budget  = CONFIG_NETDEV_RXPOLL_BUDGET;
+}
+
+/****************************************************************************
+ * Name: netdev_rxpoll_schedule
+ *
+ * Description:
+ *   Schedule the receive polling of a device.  This is called from the
+ *   receive interrupt handler after the receive interrupt was disabled.  The
+ *   poll drains up to CONFIG_NETDEV_RXPOLL_BUDGET frames while holding the
+ *   network lock once.  If more frames are pending, the poll is rescheduled
+ *   with the interrupt still disabled; otherwise the interrupt is
+ *   re-enabled.
+ *
+ * Input Parameters:
+ *   rxpoll - The receive polling state
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int netdev_rxpoll_schedule(FAR struct netdev_rxpoll_s *rxpoll)
+{
+  /* Nothing to do if the poll is already pending */
+
+  if (!work_available(&rxpoll->rp_work))
+    {
+      return OK;
+    }
+
+  return work_queue(rxpoll->rp_qid, &rxpoll->rp_work, netdev_rxpoll_work,
+                    rxpoll, 0);
+}
+
+/****************************************************************************
+ * Name: netdev_rxpoll_cancel
+ *
+ * Description:
+ *   Cancel any pending receive polling, as when the device is brought
+ *   down.  The receive interrupt is not re-enabled.
+ *
+ * Input Parameters:
+ *   rxpoll - The receive polling state
+ *
+ ****************************************************************************/
+
+void netdev_rxpoll_cancel(FAR struct netdev_rxpoll_s *rxpoll)
+{
+  work_cancel(rxpoll->rp_qid, &rxpoll->rp_work);
+}
+
+#endif /* CONFIG_NETDEV_RXPOLL */
@@ -0,0 +1,143 @@
+/****************************************************************************
+ * net/netdev/netdev_tstamp.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <time.h>
+#include <assert.h>
+
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+
+#ifdef CONFIG_NET_TIMESTAMP
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_tstamp_rx
+ *
+ * Description:
+ *   Get the timestamps of the frame just received by the device:  The
+ *   software timestamp is the current CLOCK_REALTIME and the hardware
+ *   timestamp is the d_rxtime reported by the driver (zero if none).
+ *
+ * Input Parameters:
+ *   dev    - The network device that received the frame
+ *   swtime - The location to return the software timestamp
+ *   hwtime - The location to return the hardware timestamp
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void netdev_tstamp_rx(FAR struct net_driver_s *dev,
+                      FAR struct timespec *swtime,
+                      FAR struct timespec *hwtime)
+{
+  clock_gettime(CLOCK_REALTIME, swtime);
+  *hwtime = dev->d_rxtime;
+}
+
+/****************************************************************************
+ * Name: netdev_tstamp_tx
+ *
+ * Description:
+ *   Take the transmit timestamps requested by a socket for the frame that
+ *   is about to be sent in d_buf:  The software timestamp is taken now and
+ *   d_txtstamp is set if a hardware timestamp is requested.
+ *
+ * Input Parameters:
+ *   dev    - The network device that will send the frame
+ *   tstamp - The timestamping state of the sending socket
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void netdev_tstamp_tx(FAR struct net_driver_s *dev,
+                      FAR struct net_tstamp_s *tstamp)
+{
+  if ((tstamp->ts_flags & SOF_TIMESTAMPING_TX_SOFTWARE) != 0)
+    {
+      clock_gettime(CLOCK_REALTIME, &tstamp->ts_tx.ts[0]);
+      tstamp->ts_txvalid |= SOF_TIMESTAMPING_TX_SOFTWARE;
+    }
+
+  /* Only the last frame sent through the device can have a pending
+   * hardware timestamp request.
+   */
+
+  if ((tstamp->ts_flags & SOF_TIMESTAMPING_TX_HARDWARE) != 0)
+    {
+      dev->d_txtstamp = tstamp;
+    }
+  else
+    {
+      dev->d_txtstamp = NULL;
+    }
+}
+
+/****************************************************************************
+ * Name: netdev_txtimestamp
+ *
+ * Description:
+ *   Report the hardware transmit timestamp of a frame to the socket that
+ *   sent it.  This is called by the driver when the timestamp of a frame
+ *   that was sent with d_txtstamp set becomes available.
+ *
+ * Input Parameters:
+ *   dev    - The network device that sent the frame
+ *   tstamp - The value of d_txtstamp when the frame was sent
+ *   ts     - The time the frame was transmitted
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void netdev_txtimestamp(FAR struct net_driver_s *dev,
+                        FAR struct net_tstamp_s *tstamp,
+                        FAR const struct timespec *ts)
+{
+  DEBUGASSERT(dev != NULL && tstamp != NULL && ts != NULL);
+
+  /* The connection structures are statically allocated, so tstamp is still
+   * valid if the socket was closed in the meantime.  Drop the timestamp if
+   * the connection no longer asks for it.
+   */
+
+  if ((tstamp->ts_flags & SOF_TIMESTAMPING_TX_HARDWARE) != 0)
+    {
+      tstamp->ts_tx.ts[2] = *ts;
+      tstamp->ts_txvalid |= SOF_TIMESTAMPING_TX_HARDWARE;
+    }
+}
+
+#endif /* CONFIG_NET_TIMESTAMP */
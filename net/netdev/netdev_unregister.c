@@ -52,6 +52,7 @@
 
 #include "utils/utils.h"
 #include "netdev/netdev.h"
+#include "ipforward/ipforward.h"
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -163,6 +164,12 @@ int netdev_unregister(FAR struct net_driver_s *dev)
 #ifdef CONFIG_NETDEV_IFINDEX
       free_ifindex(dev->d_ifindex);
 #endif
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      /* Forget the flows that are forwarded through the device */
+
+      ipv4_flow_flush(dev);
+#endif
       net_unlock();
 
 #ifdef CONFIG_NET_ETHERNET
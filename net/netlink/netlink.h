@@ -49,6 +49,7 @@
 #include <netpacket/netlink.h>
 #include <nuttx/net/netlink.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
 
 #include "devif/devif.h"
 #include "socket/socket.h"
@@ -57,10 +58,21 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
-#ifndef CONFIG_NETLINK_ROUTE
+#if !defined(CONFIG_NETLINK_ROUTE) || defined(CONFIG_NETLINK_DISABLE_GETLINK)
   #define netlink_device_notify(dev)
 #endif
 
+#if !defined(CONFIG_NETLINK_ROUTE) || defined(CONFIG_NETLINK_DISABLE_GETADDR)
+  #define netlink_ipv4addr_notify(dev, type)
+  #define netlink_ipv6addr_notify(dev, type)
+#endif
+
+#if !defined(CONFIG_NETLINK_ROUTE) || !defined(CONFIG_NET_ROUTE) || \
+    defined(CONFIG_NETLINK_DISABLE_GETROUTE)
+  #define netlink_ipv4route_notify(route, type)
+  #define netlink_ipv6route_notify(route, type)
+#endif
+
 #ifdef CONFIG_NET_NETLINK
 
 /****************************************************************************
@@ -87,8 +99,7 @@ struct netlink_conn_s
   /* poll() support */
 
   int key;                           /* used to cancel notifications */
-  FAR sem_t *pollsem;                /* Used to wakeup poll() */
-  FAR pollevent_t *pollevent;        /* poll() wakeup event */
+  FAR struct pollfd *fds;            /* Used to wakeup poll() */
 
   /* Queued response data */
 
@@ -294,9 +305,60 @@ ssize_t netlink_route_sendto(NETLINK_HANDLE handle,
  *
  ****************************************************************************/
 
+#ifndef CONFIG_NETLINK_DISABLE_GETLINK
 void netlink_device_notify(FAR struct net_driver_s *dev);
 #endif
 
+/****************************************************************************
+ * Name: netlink_ipv4addr_notify() and netlink_ipv6addr_notify()
+ *
+ * Description:
+ *   Broadcast an RTM_NEWADDR or RTM_DELADDR message with the current
+ *   address of the device to the RTNLGRP_IPV4_IFADDR or RTNLGRP_IPV6_IFADDR
+ *   group.  RTM_DELADDR must be sent before the address is cleared.
+ *
+ * Input Parameters:
+ *   dev  - The device whose address changed
+ *   type - RTM_NEWADDR or RTM_DELADDR
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NETLINK_DISABLE_GETADDR
+#ifdef CONFIG_NET_IPv4
+void netlink_ipv4addr_notify(FAR struct net_driver_s *dev, int type);
+#endif
+#ifdef CONFIG_NET_IPv6
+void netlink_ipv6addr_notify(FAR struct net_driver_s *dev, int type);
+#endif
+#endif
+
+/****************************************************************************
+ * Name: netlink_ipv4route_notify() and netlink_ipv6route_notify()
+ *
+ * Description:
+ *   Broadcast an RTM_NEWROUTE or RTM_DELROUTE message to the
+ *   RTNLGRP_IPV4_ROUTE or RTNLGRP_IPV6_ROUTE group.
+ *
+ * Input Parameters:
+ *   route - The route that was added or deleted
+ *   type  - RTM_NEWROUTE or RTM_DELROUTE
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_ROUTE) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
+#ifdef CONFIG_NET_IPv4
+struct net_route_ipv4_s;
+void netlink_ipv4route_notify(FAR const struct net_route_ipv4_s *route,
+                              int type);
+#endif
+#ifdef CONFIG_NET_IPv6
+struct net_route_ipv6_s;
+void netlink_ipv6route_notify(FAR const struct net_route_ipv6_s *route,
+                              int type);
+#endif
+#endif
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -43,6 +43,7 @@
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
+#include <arpa/inet.h>
 
 #include <net/route.h>
 #include <netpacket/netlink.h>
@@ -57,7 +58,9 @@
 #include "netdev/netdev.h"
 #include "arp/arp.h"
 #include "neighbor/neighbor.h"
+#include "inet/inet.h"
 #include "route/route.h"
+#include "utils/utils.h"
 #include "netlink/netlink.h"
 
 #ifdef CONFIG_NETLINK_ROUTE
@@ -99,6 +102,42 @@ struct getlink_recvfrom_rsplist_s
   struct getlink_recvfrom_response_s payload;
 };
 
+/* RTM_GETADDR:  Enumerate the device addresses */
+
+#ifdef CONFIG_NET_IPv4
+struct getaddr_recvfrom_ipv4response_s
+{
+  struct nlmsghdr  hdr;
+  struct ifaddrmsg ifaddr;
+  struct rtattr    local;
+  in_addr_t        localaddr;      /* IFA_LOCAL */
+  struct rtattr    addr;
+  in_addr_t        address;        /* IFA_ADDRESS */
+};
+
+struct getaddr_recvfrom_ipv4resplist_s
+{
+  sq_entry_t flink;
+  struct getaddr_recvfrom_ipv4response_s payload;
+};
+#endif
+
+#ifdef CONFIG_NET_IPv6
+struct getaddr_recvfrom_ipv6response_s
+{
+  struct nlmsghdr  hdr;
+  struct ifaddrmsg ifaddr;
+  struct rtattr    addr;
+  net_ipv6addr_t   address;        /* IFA_ADDRESS */
+};
+
+struct getaddr_recvfrom_ipv6resplist_s
+{
+  sq_entry_t flink;
+  struct getaddr_recvfrom_ipv6response_s payload;
+};
+#endif
+
 /* RTM_GETNEIGH:  Get neighbor table entry */
 
 struct getneigh_recvfrom_response_s
@@ -299,6 +338,34 @@ static int netlink_add_terminator(NETLINK_HANDLE handle,
   return OK;
 }
 
+/****************************************************************************
+ * Name: netlink_add_notify
+ *
+ * Description:
+ *   Broadcast one unsolicited response, followed by NLMSG_DONE, to the
+ *   members of a multicast group.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_NETLINK_DISABLE_GETLINK) || \
+    !defined(CONFIG_NETLINK_DISABLE_GETADDR) || \
+    !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
+static void netlink_add_notify(int group,
+                               FAR struct netlink_response_s *resp)
+{
+  if (resp != NULL)
+    {
+      netlink_add_broadcast(group, resp);
+
+      resp = netlink_get_terminator(NULL);
+      if (resp != NULL)
+        {
+          netlink_add_broadcast(group, resp);
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: netlink_get_devlist
  *
@@ -347,6 +414,203 @@ static int netlink_get_devlist(NETLINK_HANDLE handle,
 }
 #endif
 
+/****************************************************************************
+ * Name: netlink_ipv4addr_response
+ *
+ * Description:
+ *   Generate one IPv4 address response.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPv4) && !defined(CONFIG_NETLINK_DISABLE_GETADDR)
+static FAR struct netlink_response_s *
+netlink_ipv4addr_response(FAR struct net_driver_s *dev, int type,
+                          FAR const struct nlroute_sendto_request_s *req)
+{
+  FAR struct getaddr_recvfrom_ipv4resplist_s *alloc;
+  FAR struct getaddr_recvfrom_ipv4response_s *resp;
+  in_addr_t mask;
+  uint8_t preflen;
+
+  /* Allocate the response buffer */
+
+  alloc = (FAR struct getaddr_recvfrom_ipv4resplist_s *)
+    kmm_zalloc(sizeof(struct getaddr_recvfrom_ipv4resplist_s));
+  if (alloc == NULL)
+    {
+      nerr("ERROR: Failed to allocate response buffer.\n");
+      return NULL;
+    }
+
+  /* The netmask is contiguous, count its leading ones */
+
+  mask = ntohl(dev->d_netmask);
+  for (preflen = 0; (mask & 0x80000000) != 0; preflen++)
+    {
+      mask <<= 1;
+    }
+
+  /* Initialize the response buffer */
+
+  resp                       = &alloc->payload;
+
+  resp->hdr.nlmsg_len        =
+    sizeof(struct getaddr_recvfrom_ipv4response_s);
+  resp->hdr.nlmsg_type       = type;
+  resp->hdr.nlmsg_flags      = req ? req->hdr.nlmsg_flags : 0;
+  resp->hdr.nlmsg_seq        = req ? req->hdr.nlmsg_seq : 0;
+  resp->hdr.nlmsg_pid        = req ? req->hdr.nlmsg_pid : 0;
+
+  resp->ifaddr.ifa_family    = AF_INET;
+  resp->ifaddr.ifa_prefixlen = preflen;
+  resp->ifaddr.ifa_flags     = IFA_F_PERMANENT;
+  resp->ifaddr.ifa_scope     = RT_SCOPE_UNIVERSE;
+#ifdef CONFIG_NETDEV_IFINDEX
+  resp->ifaddr.ifa_index     = dev->d_ifindex;
+#endif
+
+  resp->local.rta_len        = RTA_LENGTH(sizeof(in_addr_t));
+  resp->local.rta_type       = IFA_LOCAL;
+  resp->localaddr            = dev->d_ipaddr;
+
+  resp->addr.rta_len         = RTA_LENGTH(sizeof(in_addr_t));
+  resp->addr.rta_type        = IFA_ADDRESS;
+  resp->address              = dev->d_ipaddr;
+
+  /* Finally, return the response */
+
+  return (FAR struct netlink_response_s *)alloc;
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_ipv6addr_response
+ *
+ * Description:
+ *   Generate one IPv6 address response.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPv6) && !defined(CONFIG_NETLINK_DISABLE_GETADDR)
+static FAR struct netlink_response_s *
+netlink_ipv6addr_response(FAR struct net_driver_s *dev, int type,
+                          FAR const struct nlroute_sendto_request_s *req)
+{
+  FAR struct getaddr_recvfrom_ipv6resplist_s *alloc;
+  FAR struct getaddr_recvfrom_ipv6response_s *resp;
+
+  /* Allocate the response buffer */
+
+  alloc = (FAR struct getaddr_recvfrom_ipv6resplist_s *)
+    kmm_zalloc(sizeof(struct getaddr_recvfrom_ipv6resplist_s));
+  if (alloc == NULL)
+    {
+      nerr("ERROR: Failed to allocate response buffer.\n");
+      return NULL;
+    }
+
+  /* Initialize the response buffer */
+
+  resp                       = &alloc->payload;
+
+  resp->hdr.nlmsg_len        =
+    sizeof(struct getaddr_recvfrom_ipv6response_s);
+  resp->hdr.nlmsg_type       = type;
+  resp->hdr.nlmsg_flags      = req ? req->hdr.nlmsg_flags : 0;
+  resp->hdr.nlmsg_seq        = req ? req->hdr.nlmsg_seq : 0;
+  resp->hdr.nlmsg_pid        = req ? req->hdr.nlmsg_pid : 0;
+
+  resp->ifaddr.ifa_family    = AF_INET6;
+  resp->ifaddr.ifa_prefixlen = net_ipv6_mask2pref(dev->d_ipv6netmask);
+  resp->ifaddr.ifa_flags     = IFA_F_PERMANENT;
+  resp->ifaddr.ifa_scope     = net_is_addr_linklocal(dev->d_ipv6addr) ?
+                               RT_SCOPE_LINK : RT_SCOPE_UNIVERSE;
+#ifdef CONFIG_NETDEV_IFINDEX
+  resp->ifaddr.ifa_index     = dev->d_ifindex;
+#endif
+
+  resp->addr.rta_len         = RTA_LENGTH(sizeof(net_ipv6addr_t));
+  resp->addr.rta_type        = IFA_ADDRESS;
+  net_ipv6addr_copy(resp->address, dev->d_ipv6addr);
+
+  /* Finally, return the response */
+
+  return (FAR struct netlink_response_s *)alloc;
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_get_addrlist
+ *
+ * Description:
+ *   Dump the addresses of all network devices of the requested family.
+ *   Devices without an address of that family are skipped.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NETLINK_DISABLE_GETADDR
+static int netlink_addr_callback(FAR struct net_driver_s *dev,
+                                 FAR void *arg)
+{
+  FAR struct nlroute_info_s *info = arg;
+  FAR struct netlink_response_s *resp = NULL;
+
+#ifdef CONFIG_NET_IPv4
+  if (info->req->gen.rtgen_family == AF_INET)
+    {
+      if (dev->d_ipaddr == INADDR_ANY)
+        {
+          return OK;
+        }
+
+      resp = netlink_ipv4addr_response(dev, RTM_NEWADDR, info->req);
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if (info->req->gen.rtgen_family == AF_INET6)
+    {
+      if (net_ipv6addr_cmp(dev->d_ipv6addr, g_ipv6_unspecaddr))
+        {
+          return OK;
+        }
+
+      resp = netlink_ipv6addr_response(dev, RTM_NEWADDR, info->req);
+    }
+#endif
+
+  if (resp == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  netlink_add_response(info->handle, resp);
+  return OK;
+}
+
+static int netlink_get_addrlist(NETLINK_HANDLE handle,
+                              FAR const struct nlroute_sendto_request_s *req)
+{
+  struct nlroute_info_s info;
+  int ret;
+
+  /* Visit each device */
+
+  info.handle = handle;
+  info.req    = req;
+
+  net_lock();
+  ret = netdev_foreach(netlink_addr_callback, &info);
+  net_unlock();
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  return netlink_add_terminator(handle, req);
+}
+#endif
+
 /****************************************************************************
  * Name: netlink_get_arptable()
  *
@@ -522,15 +786,13 @@ static int netlink_get_nbtable(NETLINK_HANDLE handle,
  ****************************************************************************/
 
 #if defined(CONFIG_NET_IPv4) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
-static int netlink_ipv4_route(FAR struct net_route_ipv4_s *route,
-                              FAR void *arg)
+static FAR struct netlink_response_s *
+netlink_ipv4route_response(FAR const struct net_route_ipv4_s *route,
+                           int type,
+                           FAR const struct nlroute_sendto_request_s *req)
 {
   FAR struct getroute_recvfrom_ipv4resplist_s *alloc;
   FAR struct getroute_recvfrom_ipv4response_s *resp;
-  FAR struct nlroute_info_s *info;
-
-  DEBUGASSERT(route != NULL && arg != NULL);
-  info = (FAR struct nlroute_info_s *)arg;
 
   /* Allocate the response */
 
@@ -538,19 +800,20 @@ static int netlink_ipv4_route(FAR struct net_route_ipv4_s *route,
     kmm_zalloc(sizeof(struct getroute_recvfrom_ipv4resplist_s));
   if (alloc == NULL)
     {
-      return -ENOMEM;
+      nerr("ERROR: Failed to allocate response buffer.\n");
+      return NULL;
     }
 
   /* Format the response */
 
   resp                  = &alloc->payload;
   resp->hdr.nlmsg_len   = sizeof(struct getroute_recvfrom_ipv4response_s);
-  resp->hdr.nlmsg_type  = RTM_NEWROUTE;
-  resp->hdr.nlmsg_flags = info->req->hdr.nlmsg_flags;
-  resp->hdr.nlmsg_seq   = info->req->hdr.nlmsg_seq;
-  resp->hdr.nlmsg_pid   = info->req->hdr.nlmsg_pid;
+  resp->hdr.nlmsg_type  = type;
+  resp->hdr.nlmsg_flags = req ? req->hdr.nlmsg_flags : 0;
+  resp->hdr.nlmsg_seq   = req ? req->hdr.nlmsg_seq : 0;
+  resp->hdr.nlmsg_pid   = req ? req->hdr.nlmsg_pid : 0;
 
-  resp->rte.rtm_family   = info->req->gen.rtgen_family;
+  resp->rte.rtm_family   = AF_INET;
   resp->rte.rtm_table    = RT_TABLE_MAIN;
   resp->rte.rtm_protocol = RTPROT_STATIC;
   resp->rte.rtm_scope    = RT_SCOPE_SITE;
@@ -567,9 +830,29 @@ static int netlink_ipv4_route(FAR struct net_route_ipv4_s *route,
   resp->gateway.attr.rta_type = RTA_GATEWAY;
   resp->gateway.addr          = route->router;
 
-  /* Finally, add the response to the list of pending responses */
+  /* Finally, return the response */
 
-  netlink_add_response(info->handle, (FAR struct netlink_response_s *)alloc);
+  return (FAR struct netlink_response_s *)alloc;
+}
+
+static int netlink_ipv4_route(FAR struct net_route_ipv4_s *route,
+                              FAR void *arg)
+{
+  FAR struct nlroute_info_s *info;
+  FAR struct netlink_response_s *resp;
+
+  DEBUGASSERT(route != NULL && arg != NULL);
+  info = (FAR struct nlroute_info_s *)arg;
+
+  resp = netlink_ipv4route_response(route, RTM_NEWROUTE, info->req);
+  if (resp == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* Add the response to the list of pending responses */
+
+  netlink_add_response(info->handle, resp);
   return OK;
 }
 #endif
@@ -615,15 +898,13 @@ static int netlink_get_ipv4route(NETLINK_HANDLE handle,
  ****************************************************************************/
 
 #if defined(CONFIG_NET_IPv6) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
-static int netlink_ipv6_route(FAR struct net_route_ipv6_s *route,
-                              FAR void *arg)
+static FAR struct netlink_response_s *
+netlink_ipv6route_response(FAR const struct net_route_ipv6_s *route,
+                           int type,
+                           FAR const struct nlroute_sendto_request_s *req)
 {
   FAR struct getroute_recvfrom_ipv6resplist_s *alloc;
   FAR struct getroute_recvfrom_ipv6response_s *resp;
-  FAR struct nlroute_info_s *info;
-
-  DEBUGASSERT(route != NULL && arg != NULL);
-  info = (FAR struct nlroute_info_s *)arg;
 
   /* Allocate the response */
 
@@ -631,19 +912,20 @@ static int netlink_ipv6_route(FAR struct net_route_ipv6_s *route,
     kmm_zalloc(sizeof(struct getroute_recvfrom_ipv6resplist_s));
   if (alloc == NULL)
     {
-      return -ENOMEM;
+      nerr("ERROR: Failed to allocate response buffer.\n");
+      return NULL;
     }
 
   /* Format the response */
 
   resp                  = &alloc->payload;
   resp->hdr.nlmsg_len   = sizeof(struct getroute_recvfrom_ipv6response_s);
-  resp->hdr.nlmsg_type  = RTM_NEWROUTE;
-  resp->hdr.nlmsg_flags = info->req->hdr.nlmsg_flags;
-  resp->hdr.nlmsg_seq   = info->req->hdr.nlmsg_seq;
-  resp->hdr.nlmsg_pid   = info->req->hdr.nlmsg_pid;
+  resp->hdr.nlmsg_type  = type;
+  resp->hdr.nlmsg_flags = req ? req->hdr.nlmsg_flags : 0;
+  resp->hdr.nlmsg_seq   = req ? req->hdr.nlmsg_seq : 0;
+  resp->hdr.nlmsg_pid   = req ? req->hdr.nlmsg_pid : 0;
 
-  resp->rte.rtm_family   = info->req->gen.rtgen_family;
+  resp->rte.rtm_family   = AF_INET6;
   resp->rte.rtm_table    = RT_TABLE_MAIN;
   resp->rte.rtm_protocol = RTPROT_STATIC;
   resp->rte.rtm_scope    = RT_SCOPE_SITE;
@@ -660,9 +942,29 @@ static int netlink_ipv6_route(FAR struct net_route_ipv6_s *route,
   resp->gateway.attr.rta_type = RTA_GATEWAY;
   net_ipv6addr_copy(resp->gateway.addr, route->router);
 
-  /* Finally, add the response to the list of pending responses */
+  /* Finally, return the response */
+
+  return (FAR struct netlink_response_s *)alloc;
+}
+
+static int netlink_ipv6_route(FAR struct net_route_ipv6_s *route,
+                              FAR void *arg)
+{
+  FAR struct nlroute_info_s *info;
+  FAR struct netlink_response_s *resp;
 
-  netlink_add_response(info->handle, (FAR struct netlink_response_s *)alloc);
+  DEBUGASSERT(route != NULL && arg != NULL);
+  info = (FAR struct nlroute_info_s *)arg;
+
+  resp = netlink_ipv6route_response(route, RTM_NEWROUTE, info->req);
+  if (resp == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* Add the response to the list of pending responses */
+
+  netlink_add_response(info->handle, resp);
   return OK;
 }
 #endif
@@ -742,6 +1044,30 @@ ssize_t netlink_route_sendto(NETLINK_HANDLE handle,
         break;
 #endif
 
+#ifndef CONFIG_NETLINK_DISABLE_GETADDR
+      /* Dump the addresses of all devices */
+
+      case RTM_GETADDR:
+#ifdef CONFIG_NET_IPv4
+        if (req->gen.rtgen_family == AF_INET)
+          {
+            ret = netlink_get_addrlist(handle, req);
+          }
+        else
+#endif
+#ifdef CONFIG_NET_IPv6
+        if (req->gen.rtgen_family == AF_INET6)
+          {
+            ret = netlink_get_addrlist(handle, req);
+          }
+        else
+#endif
+          {
+            ret = -EAFNOSUPPORT;
+          }
+        break;
+#endif
+
 #ifndef CONFIG_NETLINK_DISABLE_GETNEIGH
       /* Retrieve ARP/Neighbor Tables */
 
@@ -821,21 +1147,69 @@ ssize_t netlink_route_sendto(NETLINK_HANDLE handle,
 #ifndef CONFIG_NETLINK_DISABLE_GETLINK
 void netlink_device_notify(FAR struct net_driver_s *dev)
 {
-  FAR struct netlink_response_s *resp;
+  DEBUGASSERT(dev != NULL);
 
+  netlink_add_notify(RTNLGRP_LINK, netlink_get_device(dev, NULL));
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_ipv4addr_notify() and netlink_ipv6addr_notify()
+ *
+ * Description:
+ *   Broadcast an address change to the RTNLGRP_IPV4_IFADDR or
+ *   RTNLGRP_IPV6_IFADDR group.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPv4) && !defined(CONFIG_NETLINK_DISABLE_GETADDR)
+void netlink_ipv4addr_notify(FAR struct net_driver_s *dev, int type)
+{
   DEBUGASSERT(dev != NULL);
 
-  resp = netlink_get_device(dev, NULL);
-  if (resp != NULL)
-    {
-      netlink_add_broadcast(RTNLGRP_LINK, resp);
+  netlink_add_notify(RTNLGRP_IPV4_IFADDR,
+                     netlink_ipv4addr_response(dev, type, NULL));
+}
+#endif
 
-      resp = netlink_get_terminator(NULL);
-      if (resp != NULL)
-        {
-          netlink_add_broadcast(RTNLGRP_LINK, resp);
-        }
-    }
+#if defined(CONFIG_NET_IPv6) && !defined(CONFIG_NETLINK_DISABLE_GETADDR)
+void netlink_ipv6addr_notify(FAR struct net_driver_s *dev, int type)
+{
+  DEBUGASSERT(dev != NULL);
+
+  netlink_add_notify(RTNLGRP_IPV6_IFADDR,
+                     netlink_ipv6addr_response(dev, type, NULL));
+}
+#endif
+
+/****************************************************************************
+ * Name: netlink_ipv4route_notify() and netlink_ipv6route_notify()
+ *
+ * Description:
+ *   Broadcast a routing table change to the RTNLGRP_IPV4_ROUTE or
+ *   RTNLGRP_IPV6_ROUTE group.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_IPv4) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
+void netlink_ipv4route_notify(FAR const struct net_route_ipv4_s *route,
+                              int type)
+{
+  DEBUGASSERT(route != NULL);
+
+  netlink_add_notify(RTNLGRP_IPV4_ROUTE,
+                     netlink_ipv4route_response(route, type, NULL));
+}
+#endif
+
+#if defined(CONFIG_NET_IPv6) && !defined(CONFIG_NETLINK_DISABLE_GETROUTE)
+void netlink_ipv6route_notify(FAR const struct net_route_ipv6_s *route,
+                              int type)
+{
+  DEBUGASSERT(route != NULL);
+
+  netlink_add_notify(RTNLGRP_IPV6_ROUTE,
+                     netlink_ipv6route_response(route, type, NULL));
 }
 #endif
 
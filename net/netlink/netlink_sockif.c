@@ -53,6 +53,7 @@
 #include <nuttx/semaphore.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/net/net.h>
+#include <nuttx/fs/fs.h>
 
 #include "netlink/netlink.h"
 
@@ -111,6 +112,9 @@ const struct sock_intf_s g_netlink_sockif =
   NULL,                 /* si_sendfile */
 #endif
   netlink_recvfrom,     /* si_recvfrom */
+#ifdef CONFIG_NET_TIMESTAMP
+  NULL,                 /* si_recvmsg */
+#endif
   netlink_close         /* si_close */
 };
 
@@ -539,12 +543,12 @@ static void netlink_response_available(FAR void *arg)
   sched_lock();
   net_lock();
 
-  if (conn->pollsem != NULL && conn->pollevent != NULL)
+  if (conn->fds != NULL)
     {
       /* Wake up the poll() with POLLIN */
 
-       *conn->pollevent |= POLLIN;
-       nxsem_post(conn->pollsem);
+       conn->fds->revents |= POLLIN;
+       poll_notify(conn->fds);
     }
   else
     {
@@ -553,8 +557,7 @@ static void netlink_response_available(FAR void *arg)
 
   /* Allow another poll() */
 
-  conn->pollsem   = NULL;
-  conn->pollevent = NULL;
+  conn->fds = NULL;
 
   net_unlock();
   sched_unlock();
@@ -618,7 +621,7 @@ static int netlink_poll(FAR struct socket *psock, FAR struct pollfd *fds,
       if (revents != 0)
         {
           fds->revents = revents;
-          nxsem_post(fds->sem);
+          poll_notify(fds);
           net_unlock();
           return OK;
         }
@@ -633,7 +636,7 @@ static int netlink_poll(FAR struct socket *psock, FAR struct pollfd *fds,
            * on the Netlink connection.
            */
 
-          if (conn->pollsem != NULL || conn->pollevent != NULL)
+          if (conn->fds != NULL)
             {
               nerr("ERROR: Multiple polls() on socket not supported.\n");
               net_unlock();
@@ -642,16 +645,14 @@ static int netlink_poll(FAR struct socket *psock, FAR struct pollfd *fds,
 
           /* Set up the notification */
 
-          conn->pollsem    = fds->sem;
-          conn->pollevent  = &fds->revents;
+          conn->fds = fds;
 
           ret = netlink_notifier_setup(netlink_response_available,
                                        conn, conn);
           if (ret < 0)
             {
               nerr("ERROR: netlink_notifier_setup() failed: %d\n", ret);
-              conn->pollsem   = NULL;
-              conn->pollevent = NULL;
+              conn->fds = NULL;
             }
         }
 
@@ -662,8 +663,7 @@ static int netlink_poll(FAR struct socket *psock, FAR struct pollfd *fds,
       /* Cancel any response notifications */
 
       ret = netlink_notifier_teardown(conn);
-      conn->pollsem   = NULL;
-      conn->pollevent = NULL;
+      conn->fds = NULL;
     }
 
   return ret;
@@ -43,8 +43,17 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <queue.h>
 
+#ifdef CONFIG_NET_PKT_RXRING
+#  include <netpacket/packet.h>
+#endif
+
+#ifdef CONFIG_NET_TIMESTAMP
+#  include <nuttx/net/netdev.h>
+#endif
+
 #ifdef CONFIG_NET_PKT
 
 /****************************************************************************
@@ -84,6 +93,30 @@ struct pkt_conn_s
   uint8_t    ifindex;
   uint16_t   proto;
   uint8_t    crefs;    /* Reference counts on this instance */
+
+#ifdef CONFIG_NET_TIMESTAMP
+  struct net_tstamp_s tstamp; /* SO_TIMESTAMP/SO_TIMESTAMPING state */
+#endif
+
+#ifdef CONFIG_NET_PKT_RXRING
+  /* The receive ring of PACKET_RX_RING */
+
+  FAR uint8_t *ring;          /* The frames (NULL: No ring) */
+  size_t      ringsize;       /* Size of the ring in bytes */
+  uint32_t    blocksize;      /* Size of a block */
+  uint32_t    framesize;      /* Size of a frame */
+  uint32_t    blkframes;      /* Number of frames in each block */
+  uint32_t    nframes;        /* Total number of frames */
+  uint32_t    rxhead;         /* The next frame to fill */
+  bool        losing;         /* A packet was dropped since the last one */
+  FAR struct pollfd *fds;     /* poll() waiting for frames */
+  struct tpacket_stats stats; /* PACKET_STATISTICS counters */
+#endif
+
+#ifdef CONFIG_NET_PKT_FILTER
+  FAR struct sock_filter *filter; /* The attached socket filter */
+  uint16_t    filterlen;          /* Number of filter instructions */
+#endif
 };
 
 /****************************************************************************
@@ -109,6 +142,8 @@ EXTERN const struct sock_intf_s g_pkt_sockif;
 struct net_driver_s; /* Forward reference */
 struct eth_hdr_s;    /* Forward reference */
 struct socket;       /* Forward reference */
+struct pollfd;       /* Forward reference */
+struct sock_fprog;   /* Forward reference */
 
 /****************************************************************************
  * Name: pkt_initialize()
@@ -248,6 +283,32 @@ ssize_t pkt_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
                      int flags, FAR struct sockaddr *from,
                      FAR socklen_t *fromlen);
 
+/****************************************************************************
+ * Name: pkt_recvmsg
+ *
+ * Description:
+ *   Implements the socket recvmsg interface for packet sockets.  The
+ *   receive timestamps selected by SO_TIMESTAMP and SO_TIMESTAMPING are
+ *   returned as control data.  With MSG_ERRQUEUE, the pending transmit
+ *   timestamps are returned instead of a packet.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msg      The message header
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  Otherwise, on
+ *   errors, a negated errno value is returned (see recvmsg() for the list
+ *   of appropriate error values).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMP
+ssize_t pkt_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                    int flags);
+#endif
+
 /****************************************************************************
  * Name: pkt_find_device
  *
@@ -308,6 +369,161 @@ struct socket;
 ssize_t psock_pkt_send(FAR struct socket *psock, FAR const void *buf,
                        size_t len);
 
+/****************************************************************************
+ * Name: pkt_setsockopt and pkt_getsockopt
+ *
+ * Description:
+ *   Set or get the packet socket options of the SOL_PACKET level:
+ *   PACKET_RX_RING sets up (or releases) the receive ring and
+ *   PACKET_STATISTICS reads and clears the counters of the ring.
+ *
+ * Input Parameters:
+ *   psock     - The socket
+ *   option    - The option to set or get
+ *   value     - Points to the argument value
+ *   value_len - The length of the argument value
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_RXRING
+int pkt_setsockopt(FAR struct socket *psock, int option,
+                   FAR const void *value, socklen_t value_len);
+int pkt_getsockopt(FAR struct socket *psock, int option,
+                   FAR void *value, FAR socklen_t *value_len);
+#endif
+
+/****************************************************************************
+ * Name: pkt_ring_setup
+ *
+ * Description:
+ *   Allocate the receive ring with the geometry of 'req', or release the
+ *   ring if req->tp_block_nr is zero.
+ *
+ * Input Parameters:
+ *   conn - The packet socket connection
+ *   req  - The geometry of the ring
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_RXRING
+int pkt_ring_setup(FAR struct pkt_conn_s *conn,
+                   FAR const struct tpacket_req *req);
+
+/****************************************************************************
+ * Name: pkt_ring_release
+ *
+ * Description:
+ *   Release the receive ring of the connection, if any.
+ *
+ ****************************************************************************/
+
+void pkt_ring_release(FAR struct pkt_conn_s *conn);
+
+/****************************************************************************
+ * Name: pkt_ring_input
+ *
+ * Description:
+ *   Copy the frame just received by the device into the next frame of the
+ *   receive ring.  The frame is dropped if the application still owns the
+ *   ring frame.
+ *
+ * Input Parameters:
+ *   dev     - The device driver structure containing the received packet
+ *   conn    - The packet socket connection with the ring
+ *   snaplen - The number of bytes of the packet to keep
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void pkt_ring_input(FAR struct net_driver_s *dev,
+                    FAR struct pkt_conn_s *conn, uint32_t snaplen);
+
+/****************************************************************************
+ * Name: pkt_ring_mmap
+ *
+ * Description:
+ *   Return the address of the receive ring for mmap() (FIOC_MMAP).
+ *
+ ****************************************************************************/
+
+int pkt_ring_mmap(FAR struct socket *psock, FAR void **addr);
+
+/****************************************************************************
+ * Name: pkt_ring_poll
+ *
+ * Description:
+ *   Set up or tear down the poll() of the receive ring.
+ *
+ ****************************************************************************/
+
+int pkt_ring_poll(FAR struct pkt_conn_s *conn, FAR struct pollfd *fds,
+                  bool setup);
+#endif
+
+/****************************************************************************
+ * Name: pkt_filter_setsockopt
+ *
+ * Description:
+ *   Attach (SO_ATTACH_FILTER) or detach (SO_DETACH_FILTER) the socket
+ *   filter of a packet socket.
+ *
+ * Input Parameters:
+ *   psock     - The socket
+ *   option    - SO_ATTACH_FILTER or SO_DETACH_FILTER
+ *   value     - Points to the struct sock_fprog (SO_ATTACH_FILTER)
+ *   value_len - The length of the argument value
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_PKT_FILTER
+int pkt_filter_setsockopt(FAR struct socket *psock, int option,
+                          FAR const void *value, socklen_t value_len);
+
+/****************************************************************************
+ * Name: pkt_filter_release
+ *
+ * Description:
+ *   Free the socket filter of the connection, if any.
+ *
+ ****************************************************************************/
+
+void pkt_filter_release(FAR struct pkt_conn_s *conn);
+
+/****************************************************************************
+ * Name: pkt_filter_run
+ *
+ * Description:
+ *   Run the socket filter of the connection on a packet.
+ *
+ * Input Parameters:
+ *   conn - The packet socket connection
+ *   data - The packet
+ *   len  - The length of the packet
+ *
+ * Returned Value:
+ *   The number of bytes of the packet to keep.  Zero means that the packet
+ *   is discarded.  The whole length is returned if there is no filter.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+uint32_t pkt_filter_run(FAR struct pkt_conn_s *conn,
+                        FAR const uint8_t *data, uint32_t len);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
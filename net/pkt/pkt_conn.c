@@ -43,6 +43,7 @@
 #include <nuttx/config.h>
 #if defined(CONFIG_NET) && defined(CONFIG_NET_PKT)
 
+#include <string.h>
 #include <assert.h>
 #include <errno.h>
 #include <debug.h>
@@ -157,6 +158,17 @@ FAR struct pkt_conn_s *pkt_alloc(void)
       /* Make sure that the connection is marked as uninitialized */
 
       conn->ifindex = 0;
+#ifdef CONFIG_NET_TIMESTAMP
+      memset(&conn->tstamp, 0, sizeof(struct net_tstamp_s));
+#endif
+#ifdef CONFIG_NET_PKT_RXRING
+      conn->ring = NULL;
+      conn->fds  = NULL;
+#endif
+#ifdef CONFIG_NET_PKT_FILTER
+      conn->filter    = NULL;
+      conn->filterlen = 0;
+#endif
 
       /* Enqueue the connection into the active list */
 
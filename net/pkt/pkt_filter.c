@@ -0,0 +1,566 @@
+/****************************************************************************
+ * net/pkt/pkt_filter.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <net/bpf.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/net.h>
+
+#include "pkt/pkt.h"
+
+#ifdef CONFIG_NET_PKT_FILTER
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_filter_check
+ *
+ * Description:
+ *   Verify a filter program before it is attached:  All instructions must
+ *   be known, all jumps and scratch memory accesses must be in range, and
+ *   the last instruction must be a return.  After this check, the program
+ *   can be run without any further checks of the instructions.
+ *
+ ****************************************************************************/
+
+static bool pkt_filter_check(FAR const struct sock_filter *filter,
+                             uint16_t len)
+{
+  FAR const struct sock_filter *insn;
+  uint32_t remain;
+  uint16_t i;
+
+  for (i = 0; i < len; i++)
+    {
+      insn   = &filter[i];
+      remain = len - i - 1;
+
+      switch (BPF_CLASS(insn->code))
+        {
+          case BPF_LD:
+          case BPF_LDX:
+            switch (BPF_MODE(insn->code))
+              {
+                case BPF_ABS:
+                case BPF_IND:
+                  if (BPF_CLASS(insn->code) == BPF_LDX ||
+                      BPF_SIZE(insn->code) == 0x18)
+                    {
+                      return false;
+                    }
+                  break;
+
+                case BPF_MSH:
+                  if (insn->code != (BPF_LDX | BPF_B | BPF_MSH))
+                    {
+                      return false;
+                    }
+                  break;
+
+                case BPF_MEM:
+                  if (insn->k >= BPF_MEMWORDS)
+                    {
+                      return false;
+                    }
+
+                  /* Fall through */
+
+                case BPF_IMM:
+                case BPF_LEN:
+                  if (BPF_SIZE(insn->code) != BPF_W)
+                    {
+                      return false;
+                    }
+                  break;
+
+                default:
+                  return false;
+              }
+            break;
+
+          case BPF_ST:
+          case BPF_STX:
+            if (insn->k >= BPF_MEMWORDS)
+              {
+                return false;
+              }
+            break;
+
+          case BPF_ALU:
+            switch (BPF_OP(insn->code))
+              {
+                case BPF_DIV:
+                case BPF_MOD:
+                  if (BPF_SRC(insn->code) == BPF_K && insn->k == 0)
+                    {
+                      return false;
+                    }
+                  break;
+
+                case BPF_ADD:
+                case BPF_SUB:
+                case BPF_MUL:
+                case BPF_OR:
+                case BPF_AND:
+                case BPF_LSH:
+                case BPF_RSH:
+                case BPF_NEG:
+                case BPF_XOR:
+                  break;
+
+                default:
+                  return false;
+              }
+            break;
+
+          case BPF_JMP:
+            switch (BPF_OP(insn->code))
+              {
+                case BPF_JA:
+                  if (insn->k >= remain)
+                    {
+                      return false;
+                    }
+                  break;
+
+                case BPF_JEQ:
+                case BPF_JGT:
+                case BPF_JGE:
+                case BPF_JSET:
+                  if (insn->jt >= remain || insn->jf >= remain)
+                    {
+                      return false;
+                    }
+                  break;
+
+                default:
+                  return false;
+              }
+            break;
+
+          case BPF_RET:
+            if (BPF_RVAL(insn->code) != BPF_K &&
+                BPF_RVAL(insn->code) != BPF_A)
+              {
+                return false;
+              }
+            break;
+
+          case BPF_MISC:
+            if (BPF_MISCOP(insn->code) != BPF_TAX &&
+                BPF_MISCOP(insn->code) != BPF_TXA)
+              {
+                return false;
+              }
+            break;
+        }
+    }
+
+  return len > 0 && BPF_CLASS(filter[len - 1].code) == BPF_RET;
+}
+
+/****************************************************************************
+ * Name: pkt_filter_load
+ *
+ * Description:
+ *   Load a word, a half word or a byte of the packet in network order.
+ *   Returns false if the load is beyond the end of the packet.
+ *
+ ****************************************************************************/
+
+static bool pkt_filter_load(FAR const uint8_t *data, uint32_t len,
+                            uint32_t offset, uint16_t size,
+                            FAR uint32_t *value)
+{
+  uint32_t width = size == BPF_W ? 4 : size == BPF_H ? 2 : 1;
+
+  if (offset >= len || len - offset < width)
+    {
+      return false;
+    }
+
+  data += offset;
+  switch (width)
+    {
+      case 4:
+        *value = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) |
+                 ((uint32_t)data[2] << 8) | data[3];
+        break;
+
+      case 2:
+        *value = ((uint32_t)data[0] << 8) | data[1];
+        break;
+
+      default:
+        *value = data[0];
+        break;
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_filter_setsockopt
+ *
+ * Description:
+ *   Attach (SO_ATTACH_FILTER) or detach (SO_DETACH_FILTER) the socket
+ *   filter of a packet socket.
+ *
+ * Input Parameters:
+ *   psock     - The socket
+ *   option    - SO_ATTACH_FILTER or SO_DETACH_FILTER
+ *   value     - Points to the struct sock_fprog (SO_ATTACH_FILTER)
+ *   value_len - The length of the argument value
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int pkt_filter_setsockopt(FAR struct socket *psock, int option,
+                          FAR const void *value, socklen_t value_len)
+{
+  FAR struct pkt_conn_s *conn = (FAR struct pkt_conn_s *)psock->s_conn;
+  FAR const struct sock_fprog *fprog;
+  FAR struct sock_filter *filter;
+  FAR struct sock_filter *old;
+
+  if (option == SO_DETACH_FILTER)
+    {
+      if (conn->filter == NULL)
+        {
+          return -ENOENT;
+        }
+
+      pkt_filter_release(conn);
+      return OK;
+    }
+
+  fprog = (FAR const struct sock_fprog *)value;
+  if (value_len != sizeof(struct sock_fprog) || fprog->filter == NULL ||
+      fprog->len == 0 || fprog->len > BPF_MAXINSNS)
+    {
+      return -EINVAL;
+    }
+
+  /* Copy the program, so that the application cannot change it after it
+   * has been checked.
+   */
+
+  filter = (FAR struct sock_filter *)
+    kmm_malloc(fprog->len * sizeof(struct sock_filter));
+  if (filter == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memcpy(filter, fprog->filter, fprog->len * sizeof(struct sock_filter));
+  if (!pkt_filter_check(filter, fprog->len))
+    {
+      nerr("ERROR: Invalid filter program\n");
+      kmm_free(filter);
+      return -EINVAL;
+    }
+
+  net_lock();
+  old             = conn->filter;
+  conn->filter    = filter;
+  conn->filterlen = fprog->len;
+  net_unlock();
+
+  if (old != NULL)
+    {
+      kmm_free(old);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pkt_filter_release
+ *
+ * Description:
+ *   Free the socket filter of the connection, if any.
+ *
+ ****************************************************************************/
+
+void pkt_filter_release(FAR struct pkt_conn_s *conn)
+{
+  FAR struct sock_filter *filter;
+
+  net_lock();
+  filter          = conn->filter;
+  conn->filter    = NULL;
+  conn->filterlen = 0;
+  net_unlock();
+
+  if (filter != NULL)
+    {
+      kmm_free(filter);
+    }
+}
+
+/****************************************************************************
+ * Name: pkt_filter_run
+ *
+ * Description:
+ *   Run the socket filter of the connection on a packet.
+ *
+ * Input Parameters:
+ *   conn - The packet socket connection
+ *   data - The packet
+ *   len  - The length of the packet
+ *
+ * Returned Value:
+ *   The number of bytes of the packet to keep.  Zero means that the packet
+ *   is discarded.  The whole length is returned if there is no filter.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+uint32_t pkt_filter_run(FAR struct pkt_conn_s *conn,
+                        FAR const uint8_t *data, uint32_t len)
+{
+  FAR const struct sock_filter *pc = conn->filter;
+  uint32_t mem[BPF_MEMWORDS];
+  uint32_t a = 0;
+  uint32_t x = 0;
+  uint32_t k;
+  bool cond;
+
+  if (pc == NULL)
+    {
+      return len;
+    }
+
+  memset(mem, 0, sizeof(mem));
+
+  /* The program was verified by pkt_filter_check():  It ends with a
+   * return and all jumps are forward and in range.
+   */
+
+  for (; ; pc++)
+    {
+      k = pc->k;
+
+      switch (BPF_CLASS(pc->code))
+        {
+          case BPF_LD:
+            switch (BPF_MODE(pc->code))
+              {
+                case BPF_IMM:
+                  a = k;
+                  break;
+
+                case BPF_LEN:
+                  a = len;
+                  break;
+
+                case BPF_MEM:
+                  a = mem[k];
+                  break;
+
+                case BPF_IND:
+                  k += x;
+
+                  /* Fall through */
+
+                default:
+                  if (!pkt_filter_load(data, len, k, BPF_SIZE(pc->code),
+                                       &a))
+                    {
+                      return 0;
+                    }
+                  break;
+              }
+            break;
+
+          case BPF_LDX:
+            switch (BPF_MODE(pc->code))
+              {
+                case BPF_IMM:
+                  x = k;
+                  break;
+
+                case BPF_LEN:
+                  x = len;
+                  break;
+
+                case BPF_MEM:
+                  x = mem[k];
+                  break;
+
+                default: /* BPF_MSH:  The length of an IPv4 header */
+                  if (k >= len)
+                    {
+                      return 0;
+                    }
+
+                  x = (uint32_t)(data[k] & 0x0f) << 2;
+                  break;
+              }
+            break;
+
+          case BPF_ST:
+            mem[k] = a;
+            break;
+
+          case BPF_STX:
+            mem[k] = x;
+            break;
+
+          case BPF_ALU:
+            if (BPF_SRC(pc->code) == BPF_X)
+              {
+                k = x;
+              }
+
+            switch (BPF_OP(pc->code))
+              {
+                case BPF_ADD:
+                  a += k;
+                  break;
+
+                case BPF_SUB:
+                  a -= k;
+                  break;
+
+                case BPF_MUL:
+                  a *= k;
+                  break;
+
+                case BPF_DIV:
+                  if (k == 0)
+                    {
+                      return 0;
+                    }
+
+                  a /= k;
+                  break;
+
+                case BPF_MOD:
+                  if (k == 0)
+                    {
+                      return 0;
+                    }
+
+                  a %= k;
+                  break;
+
+                case BPF_OR:
+                  a |= k;
+                  break;
+
+                case BPF_AND:
+                  a &= k;
+                  break;
+
+                case BPF_LSH:
+                  a = k < 32 ? a << k : 0;
+                  break;
+
+                case BPF_RSH:
+                  a = k < 32 ? a >> k : 0;
+                  break;
+
+                case BPF_NEG:
+                  a = -a;
+                  break;
+
+                default: /* BPF_XOR */
+                  a ^= k;
+                  break;
+              }
+            break;
+
+          case BPF_JMP:
+            if (BPF_OP(pc->code) == BPF_JA)
+              {
+                pc += k;
+                break;
+              }
+
+            if (BPF_SRC(pc->code) == BPF_X)
+              {
+                k = x;
+              }
+
+            switch (BPF_OP(pc->code))
+              {
+                case BPF_JEQ:
+                  cond = a == k;
+                  break;
+
+                case BPF_JGT:
+                  cond = a > k;
+                  break;
+
+                case BPF_JGE:
+                  cond = a >= k;
+                  break;
+
+                default: /* BPF_JSET */
+                  cond = (a & k) != 0;
+                  break;
+              }
+
+            pc += cond ? pc->jt : pc->jf;
+            break;
+
+          case BPF_RET:
+            return BPF_RVAL(pc->code) == BPF_A ? a : k;
+
+          default: /* BPF_MISC */
+            if (BPF_MISCOP(pc->code) == BPF_TAX)
+              {
+                x = a;
+              }
+            else
+              {
+                a = x;
+              }
+            break;
+        }
+    }
+}
+
+#endif /* CONFIG_NET_PKT_FILTER */
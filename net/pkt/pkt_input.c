@@ -93,8 +93,36 @@ int pkt_input(struct net_driver_s *dev)
   conn = pkt_active(pbuf);
   if (conn)
     {
+      uint32_t snaplen = dev->d_len;
       uint16_t flags;
 
+#ifdef CONFIG_NET_PKT_FILTER
+      /* Discard the frames that the socket filter rejects before anything
+       * is copied.
+       */
+
+      snaplen = pkt_filter_run(conn, dev->d_buf, dev->d_len);
+      if (snaplen == 0)
+        {
+          ninfo("Frame rejected by the socket filter\n");
+          return OK;
+        }
+#endif
+
+#ifdef CONFIG_NET_PKT_RXRING
+      /* With a receive ring, the frame is copied into the ring and the
+       * reader is not involved.
+       */
+
+      if (conn->ring != NULL)
+        {
+          pkt_ring_input(dev, conn, snaplen);
+          return OK;
+        }
+#endif
+
+      UNUSED(snaplen);
+
       /* Setup for the application callback */
 
       dev->d_appdata = dev->d_buf;
@@ -74,6 +74,9 @@ struct pkt_recvfrom_s
   FAR uint8_t *pr_buffer;              /* Pointer to receive buffer */
   ssize_t      pr_recvlen;             /* The received length */
   int          pr_result;              /* Success:OK, failure:negated errno */
+#ifdef CONFIG_NET_TIMESTAMP
+  FAR struct scm_timestamping *pr_ts;  /* Receive timestamps (may be NULL) */
+#endif
 };
 
 /****************************************************************************
@@ -203,6 +206,16 @@ static uint16_t pkt_recvfrom_eventhandler(FAR struct net_driver_s *dev,
 
           pkt_recvfrom_newdata(dev, pstate);
 
+#ifdef CONFIG_NET_TIMESTAMP
+          /* Get the receive timestamps of the packet */
+
+          if (pstate->pr_ts != NULL)
+            {
+              netdev_tstamp_rx(dev, &pstate->pr_ts->ts[0],
+                               &pstate->pr_ts->ts[2]);
+            }
+#endif
+
           /* We are finished. */
 
           ninfo("PKT done\n");
@@ -324,23 +337,10 @@ static ssize_t pkt_recvfrom_result(int result,
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: pkt_recvfrom
+ * Name: pkt_recvfrom_common
  *
  * Description:
- *   Implements the socket recvfrom interface for the case of the AF_INET
- *   and AF_INET6 address families.  pkt_recvfrom() receives messages from
- *   a socket, and may be used to receive data on a socket whether or not it
- *   is connection-oriented.
- *
- *   If 'from' is not NULL, and the underlying protocol provides the source
- *   address, this source address is filled in.  The argument 'fromlen' is
- *   initialized to the size of the buffer associated with from, and
- *   modified on return to indicate the actual size of the address stored
- *   there.
+ *   Receive a packet and optionally get its receive timestamps.
  *
  * Input Parameters:
  *   psock    A pointer to a NuttX-specific, internal socket structure
@@ -349,18 +349,19 @@ static ssize_t pkt_recvfrom_result(int result,
  *   flags    Receive flags
  *   from     Address of source (may be NULL)
  *   fromlen  The length of the address structure
+ *   ts       The location to return the receive timestamps (may be NULL)
  *
  * Returned Value:
- *   On success, returns the number of characters received.  If no data is
- *   available to be received and the peer has performed an orderly shutdown,
- *   recv() will return 0.  Otherwise, on errors, a negated errno value is
- *   returned (see recvfrom() for the list of appropriate error values).
+ *   On success, returns the number of characters received.  Otherwise, on
+ *   errors, a negated errno value is returned.
  *
  ****************************************************************************/
 
-ssize_t pkt_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
-                     int flags, FAR struct sockaddr *from,
-                     FAR socklen_t *fromlen)
+static ssize_t pkt_recvfrom_common(FAR struct socket *psock, FAR void *buf,
+                                   size_t len, int flags,
+                                   FAR struct sockaddr *from,
+                                   FAR socklen_t *fromlen,
+                                   FAR struct scm_timestamping *ts)
 {
   FAR struct pkt_conn_s *conn = (FAR struct pkt_conn_s *)psock->s_conn;
   FAR struct net_driver_s *dev;
@@ -390,6 +391,11 @@ ssize_t pkt_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
 
   net_lock();
   pkt_recvfrom_initialize(psock, buf, len, from, fromlen, &state);
+#ifdef CONFIG_NET_TIMESTAMP
+  state.pr_ts = ts;
+#else
+  UNUSED(ts);
+#endif
 
   /* Get the device driver that will service this transfer */
 
@@ -445,4 +451,101 @@ errout_with_state:
   return ret;
 }
 
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_recvfrom
+ *
+ * Description:
+ *   Implements the socket recvfrom interface for the case of the AF_INET
+ *   and AF_INET6 address families.  pkt_recvfrom() receives messages from
+ *   a socket, and may be used to receive data on a socket whether or not it
+ *   is connection-oriented.
+ *
+ *   If 'from' is not NULL, and the underlying protocol provides the source
+ *   address, this source address is filled in.  The argument 'fromlen' is
+ *   initialized to the size of the buffer associated with from, and
+ *   modified on return to indicate the actual size of the address stored
+ *   there.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   buf      Buffer to receive data
+ *   len      Length of buffer
+ *   flags    Receive flags
+ *   from     Address of source (may be NULL)
+ *   fromlen  The length of the address structure
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  If no data is
+ *   available to be received and the peer has performed an orderly shutdown,
+ *   recv() will return 0.  Otherwise, on errors, a negated errno value is
+ *   returned (see recvfrom() for the list of appropriate error values).
+ *
+ ****************************************************************************/
+
+ssize_t pkt_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
+                     int flags, FAR struct sockaddr *from,
+                     FAR socklen_t *fromlen)
+{
+  return pkt_recvfrom_common(psock, buf, len, flags, from, fromlen, NULL);
+}
+
+/****************************************************************************
+ * Name: pkt_recvmsg
+ *
+ * Description:
+ *   Implements the socket recvmsg interface for packet sockets.  The
+ *   receive timestamps selected by SO_TIMESTAMP and SO_TIMESTAMPING are
+ *   returned as control data.  With MSG_ERRQUEUE, the pending transmit
+ *   timestamps are returned instead of a packet.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   msg      The message header
+ *   flags    Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  Otherwise, on
+ *   errors, a negated errno value is returned (see recvmsg() for the list
+ *   of appropriate error values).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMP
+ssize_t pkt_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                    int flags)
+{
+  FAR struct pkt_conn_s *conn = (FAR struct pkt_conn_s *)psock->s_conn;
+  struct scm_timestamping ts;
+  socklen_t fromlen = msg->msg_namelen;
+  ssize_t ret;
+
+  if ((flags & MSG_ERRQUEUE) != 0)
+    {
+      net_lock();
+      ret = net_tstamp_errqueue(&conn->tstamp, msg);
+      net_unlock();
+      return ret;
+    }
+
+  memset(&ts, 0, sizeof(struct scm_timestamping));
+  ret = pkt_recvfrom_common(psock, msg->msg_iov->iov_base,
+                            msg->msg_iov->iov_len, flags, msg->msg_name,
+                            msg->msg_name != NULL ? &fromlen : NULL,
+                            NET_TSTAMP_RXENABLED(&conn->tstamp) ?
+                            &ts : NULL);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  msg->msg_namelen = fromlen;
+  net_tstamp_recvcmsg(&conn->tstamp, &ts, msg);
+  return ret;
+}
+#endif
+
 #endif /* CONFIG_NET */
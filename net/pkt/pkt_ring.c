@@ -0,0 +1,394 @@
+/****************************************************************************
+ * net/pkt/pkt_ring.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <stdint.h>
+#include <string.h>
+#include <poll.h>
+#include <time.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <netpacket/packet.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ethernet.h>
+
+#include "netdev/netdev.h"
+#include "pkt/pkt.h"
+
+#ifdef CONFIG_NET_PKT_RXRING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Offsets of the address and of the packet in a frame of the ring */
+
+#define PKT_RING_ADDROFF TPACKET_ALIGN(sizeof(struct tpacket_hdr))
+#define PKT_RING_MACOFF  TPACKET_ALIGN(TPACKET_HDRLEN)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_ring_frame
+ *
+ * Description:
+ *   Return the header of a frame of the ring.  The frames do not cross the
+ *   block boundaries, so the unused tail of each block is skipped.
+ *
+ ****************************************************************************/
+
+static FAR struct tpacket_hdr *pkt_ring_frame(FAR struct pkt_conn_s *conn,
+                                              uint32_t index)
+{
+  return (FAR struct tpacket_hdr *)
+    (conn->ring + (index / conn->blkframes) * conn->blocksize +
+     (index % conn->blkframes) * conn->framesize);
+}
+
+/****************************************************************************
+ * Name: pkt_ring_ready
+ *
+ * Description:
+ *   Return true if the application has frames to read.  This is the case
+ *   if the frame that was filled last is still owned by the application.
+ *
+ ****************************************************************************/
+
+static bool pkt_ring_ready(FAR struct pkt_conn_s *conn)
+{
+  uint32_t last = conn->rxhead > 0 ? conn->rxhead - 1 : conn->nframes - 1;
+
+  return pkt_ring_frame(conn, last)->tp_status != TP_STATUS_KERNEL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_ring_setup
+ *
+ * Description:
+ *   Allocate the receive ring with the geometry of 'req', or release the
+ *   ring if req->tp_block_nr is zero.
+ *
+ * Input Parameters:
+ *   conn - The packet socket connection
+ *   req  - The geometry of the ring
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int pkt_ring_setup(FAR struct pkt_conn_s *conn,
+                   FAR const struct tpacket_req *req)
+{
+  FAR uint8_t *ring;
+  uint32_t blkframes;
+  size_t size;
+
+  if (req->tp_block_nr == 0)
+    {
+      pkt_ring_release(conn);
+      return OK;
+    }
+
+  /* The frames must hold the headers and keep the packets aligned.  The
+   * number of frames must be the number of frames that fit into the
+   * blocks.
+   */
+
+  if (req->tp_frame_size <= PKT_RING_MACOFF ||
+      (req->tp_frame_size & (TPACKET_ALIGNMENT - 1)) != 0 ||
+      req->tp_block_size < req->tp_frame_size)
+    {
+      return -EINVAL;
+    }
+
+  blkframes = req->tp_block_size / req->tp_frame_size;
+  if (req->tp_block_nr > SIZE_MAX / req->tp_block_size ||
+      req->tp_frame_nr / blkframes != req->tp_block_nr ||
+      req->tp_frame_nr % blkframes != 0)
+    {
+      return -EINVAL;
+    }
+
+  if (conn->ring != NULL)
+    {
+      return -EBUSY;
+    }
+
+  /* The ring is shared with the application, so it is allocated from the
+   * user heap.  This is zeroed memory:  All frames are TP_STATUS_KERNEL.
+   */
+
+  size = (size_t)req->tp_block_size * req->tp_block_nr;
+  ring = (FAR uint8_t *)kumm_zalloc(size);
+  if (ring == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  net_lock();
+  if (conn->ring != NULL)
+    {
+      net_unlock();
+      kumm_free(ring);
+      return -EBUSY;
+    }
+
+  conn->blocksize = req->tp_block_size;
+  conn->framesize = req->tp_frame_size;
+  conn->blkframes = blkframes;
+  conn->nframes   = req->tp_frame_nr;
+  conn->ringsize  = size;
+  conn->rxhead    = 0;
+  conn->losing    = false;
+  memset(&conn->stats, 0, sizeof(struct tpacket_stats));
+  conn->ring      = ring;
+  net_unlock();
+
+  ninfo("Ring of %u frames of %u bytes (%zu bytes)\n",
+        req->tp_frame_nr, req->tp_frame_size, size);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_release
+ *
+ * Description:
+ *   Release the receive ring of the connection, if any.
+ *
+ ****************************************************************************/
+
+void pkt_ring_release(FAR struct pkt_conn_s *conn)
+{
+  FAR uint8_t *ring;
+
+  net_lock();
+  ring          = conn->ring;
+  conn->ring    = NULL;
+  conn->nframes = 0;
+  net_unlock();
+
+  if (ring != NULL)
+    {
+      kumm_free(ring);
+    }
+}
+
+/****************************************************************************
+ * Name: pkt_ring_input
+ *
+ * Description:
+ *   Copy the frame just received by the device into the next frame of the
+ *   receive ring.  The frame is dropped if the application still owns the
+ *   ring frame.
+ *
+ * Input Parameters:
+ *   dev     - The device driver structure containing the received packet
+ *   conn    - The packet socket connection with the ring
+ *   snaplen - The number of bytes of the packet to keep
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void pkt_ring_input(FAR struct net_driver_s *dev,
+                    FAR struct pkt_conn_s *conn, uint32_t snaplen)
+{
+  FAR struct tpacket_hdr *hdr;
+  FAR struct sockaddr_ll *addr;
+  struct timespec ts;
+#ifdef CONFIG_NET_TIMESTAMP
+  struct timespec hwtime;
+#endif
+  uint32_t status;
+
+  conn->stats.tp_packets++;
+
+  hdr = pkt_ring_frame(conn, conn->rxhead);
+  if (hdr->tp_status != TP_STATUS_KERNEL)
+    {
+      /* The application has not caught up.  Drop the packet and tell the
+       * application about it with the next packet.
+       */
+
+      conn->stats.tp_drops++;
+      conn->losing = true;
+      return;
+    }
+
+  if (snaplen > dev->d_len)
+    {
+      snaplen = dev->d_len;
+    }
+
+  if (snaplen > conn->framesize - PKT_RING_MACOFF)
+    {
+      snaplen = conn->framesize - PKT_RING_MACOFF;
+    }
+
+  memcpy((FAR uint8_t *)hdr + PKT_RING_MACOFF, dev->d_buf, snaplen);
+
+  addr = (FAR struct sockaddr_ll *)((FAR uint8_t *)hdr + PKT_RING_ADDROFF);
+  addr->sll_family   = AF_PACKET;
+  addr->sll_protocol = ((FAR struct eth_hdr_s *)dev->d_buf)->type;
+  addr->sll_ifindex  = conn->ifindex;
+
+  hdr->tp_len        = dev->d_len;
+  hdr->tp_snaplen    = snaplen;
+  hdr->tp_mac        = PKT_RING_MACOFF;
+  hdr->tp_net        = PKT_RING_MACOFF + ETH_HDRLEN;
+
+  /* Prefer the hardware timestamp of the driver, if there is one */
+
+#ifdef CONFIG_NET_TIMESTAMP
+  netdev_tstamp_rx(dev, &ts, &hwtime);
+  if (hwtime.tv_sec != 0 || hwtime.tv_nsec != 0)
+    {
+      ts     = hwtime;
+      status = TP_STATUS_USER | TP_STATUS_TS_RAW_HARDWARE;
+    }
+  else
+#else
+  clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+    {
+      status = TP_STATUS_USER | TP_STATUS_TS_SOFTWARE;
+    }
+
+  hdr->tp_sec  = ts.tv_sec;
+  hdr->tp_usec = ts.tv_nsec / 1000;
+
+  if (conn->losing)
+    {
+      status      |= TP_STATUS_LOSING;
+      conn->losing = false;
+    }
+
+  /* The status hands the frame over to the application, so it must be
+   * written after the rest of the frame.
+   */
+
+#ifdef CONFIG_SPINLOCK
+  SP_DMB();
+#endif
+  hdr->tp_status = status;
+
+  if (++conn->rxhead >= conn->nframes)
+    {
+      conn->rxhead = 0;
+    }
+
+  /* Wake up poll() */
+
+  if (conn->fds != NULL && (conn->fds->events & POLLIN) != 0)
+    {
+      conn->fds->revents |= POLLIN;
+      poll_notify(conn->fds);
+    }
+}
+
+/****************************************************************************
+ * Name: pkt_ring_mmap
+ *
+ * Description:
+ *   Return the address of the receive ring for mmap() (FIOC_MMAP).
+ *
+ ****************************************************************************/
+
+int pkt_ring_mmap(FAR struct socket *psock, FAR void **addr)
+{
+  FAR struct pkt_conn_s *conn = (FAR struct pkt_conn_s *)psock->s_conn;
+
+  if (conn == NULL || conn->ring == NULL || addr == NULL)
+    {
+      return -EINVAL;
+    }
+
+  *addr = conn->ring;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: pkt_ring_poll
+ *
+ * Description:
+ *   Set up or tear down the poll() of the receive ring.
+ *
+ ****************************************************************************/
+
+int pkt_ring_poll(FAR struct pkt_conn_s *conn, FAR struct pollfd *fds,
+                  bool setup)
+{
+  int ret = OK;
+
+  net_lock();
+  if (!setup)
+    {
+      if (conn->fds == fds)
+        {
+          conn->fds = NULL;
+        }
+    }
+  else if (conn->ring == NULL)
+    {
+      ret = -ENOSYS;
+    }
+  else if (conn->fds != NULL)
+    {
+      ret = -EBUSY;
+    }
+  else
+    {
+      conn->fds = fds;
+
+      /* Report the frames that are already waiting */
+
+      if ((fds->events & POLLIN) != 0 && pkt_ring_ready(conn))
+        {
+          fds->revents |= POLLIN;
+          poll_notify(fds);
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+
+#endif /* CONFIG_NET_PKT_RXRING */
@@ -124,6 +124,12 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           devif_pkt_send(dev, pstate->snd_buffer, pstate->snd_buflen);
           pstate->snd_sent = pstate->snd_buflen;
 
+#ifdef CONFIG_NET_TIMESTAMP
+          /* Take the transmit timestamps requested for this frame */
+
+          netdev_tstamp_tx(dev, &((FAR struct pkt_conn_s *)pvconn)->tstamp);
+#endif
+
           /* Make sure no ARP request overwrites this ARP request.  This
            * flag will be cleared in arp_out().
            */
@@ -108,6 +108,9 @@ const struct sock_intf_s g_pkt_sockif =
   NULL,            /* si_sendfile */
 #endif
   pkt_recvfrom,    /* si_recvfrom */
+#ifdef CONFIG_NET_TIMESTAMP
+  pkt_recvmsg,     /* si_recvmsg */
+#endif
   pkt_close        /* si_close */
 };
 
@@ -516,7 +519,13 @@ int pkt_listen(FAR struct socket *psock, int backlog)
 static int pkt_poll_local(FAR struct socket *psock, FAR struct pollfd *fds,
                           bool setup)
 {
+#ifdef CONFIG_NET_PKT_RXRING
+  /* Only the receive ring can be polled */
+
+  return pkt_ring_poll(psock->s_conn, fds, setup);
+#else
   return -ENOSYS;
+#endif
 }
 
 /****************************************************************************
@@ -627,6 +636,12 @@ static int pkt_close(FAR struct socket *psock)
               /* Yes... free the connection structure */
 
               conn->crefs = 0;          /* No more references on the connection */
+#ifdef CONFIG_NET_PKT_RXRING
+              pkt_ring_release(conn);   /* Free the receive ring */
+#endif
+#ifdef CONFIG_NET_PKT_FILTER
+              pkt_filter_release(conn); /* Free the socket filter */
+#endif
               pkt_free(psock->s_conn);  /* Free network resources */
             }
           else
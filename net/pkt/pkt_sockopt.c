@@ -0,0 +1,140 @@
+/****************************************************************************
+ * net/pkt/pkt_sockopt.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/socket.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <netpacket/packet.h>
+
+#include <nuttx/net/net.h>
+
+#include "pkt/pkt.h"
+
+#ifdef CONFIG_NET_PKT_RXRING
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pkt_setsockopt
+ *
+ * Description:
+ *   Set the packet socket options of the SOL_PACKET level.
+ *
+ * Input Parameters:
+ *   psock     - The socket
+ *   option    - The option to set
+ *   value     - Points to the argument value
+ *   value_len - The length of the argument value
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int pkt_setsockopt(FAR struct socket *psock, int option,
+                   FAR const void *value, socklen_t value_len)
+{
+  FAR struct pkt_conn_s *conn = (FAR struct pkt_conn_s *)psock->s_conn;
+
+  if (psock->s_domain != PF_PACKET || conn == NULL)
+    {
+      return -ENOPROTOOPT;
+    }
+
+  switch (option)
+    {
+      case PACKET_RX_RING:
+        if (value == NULL || value_len != sizeof(struct tpacket_req))
+          {
+            return -EINVAL;
+          }
+
+        return pkt_ring_setup(conn, (FAR const struct tpacket_req *)value);
+
+      default:
+        nerr("ERROR: Unrecognized packet option: %d\n", option);
+        return -ENOPROTOOPT;
+    }
+}
+
+/****************************************************************************
+ * Name: pkt_getsockopt
+ *
+ * Description:
+ *   Get the packet socket options of the SOL_PACKET level.
+ *
+ * Input Parameters:
+ *   psock     - The socket
+ *   option    - The option to get
+ *   value     - The location to return the value
+ *   value_len - The size of 'value'; on return, the length of the value
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int pkt_getsockopt(FAR struct socket *psock, int option,
+                   FAR void *value, FAR socklen_t *value_len)
+{
+  FAR struct pkt_conn_s *conn = (FAR struct pkt_conn_s *)psock->s_conn;
+
+  if (psock->s_domain != PF_PACKET || conn == NULL)
+    {
+      return -ENOPROTOOPT;
+    }
+
+  switch (option)
+    {
+      case PACKET_STATISTICS:
+        if (value == NULL || value_len == NULL ||
+            *value_len < sizeof(struct tpacket_stats))
+          {
+            return -EINVAL;
+          }
+
+        /* Return and clear the counters */
+
+        net_lock();
+        memcpy(value, &conn->stats, sizeof(struct tpacket_stats));
+        memset(&conn->stats, 0, sizeof(struct tpacket_stats));
+        net_unlock();
+
+        *value_len = sizeof(struct tpacket_stats);
+        return OK;
+
+      default:
+        nerr("ERROR: Unrecognized packet option: %d\n", option);
+        return -ENOPROTOOPT;
+    }
+}
+
+#endif /* CONFIG_NET_PKT_RXRING */
@@ -0,0 +1,142 @@
+/****************************************************************************
+ * net/procfs/net_flows.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* Output format:
+ *
+ * Source          Destination     Proto Device   Packets    Bytes
+ * xxx.xxx.xxx.xxx xxx.xxx.xxx.xxx xxx   xxxxxxxx xxxxxxxxxx xxxxxxxxxx
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <string.h>
+#include <debug.h>
+
+#include <arpa/inet.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "ipforward/ipforward.h"
+#include "procfs/procfs.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NET) && \
+    defined(CONFIG_NET_IPFORWARD_FLOWCACHE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* One header line and one line for each slot of the flow cache */
+
+#define NFLOW_LINES (CONFIG_NET_IPFORWARD_NFLOWS + 1)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_flow
+ ****************************************************************************/
+
+static int netprocfs_flow(FAR struct netprocfs_file_s *netfile)
+{
+  struct ipv4_flow_s flow;
+  char srcipaddr[INET_ADDRSTRLEN];
+  char destipaddr[INET_ADDRSTRLEN];
+  int len;
+
+  if (netfile->lineno == 0)
+    {
+      return snprintf(netfile->line, NET_LINELEN, "%-15s %-15s %-5s %-8s "
+                      "%-10s %s\n", "Source", "Destination", "Proto",
+                      "Device", "Packets", "Bytes");
+    }
+
+  /* Unused slots of the flow cache produce empty lines.  Keep the network
+   * locked so that the device of the flow cannot be unregistered.
+   */
+
+  net_lock();
+  if (ipv4_flow_get(netfile->lineno - 1, &flow) < 0)
+    {
+      net_unlock();
+      return 0;
+    }
+
+  inet_ntop(AF_INET, &flow.fl_srcipaddr, srcipaddr, INET_ADDRSTRLEN);
+  inet_ntop(AF_INET, &flow.fl_destipaddr, destipaddr, INET_ADDRSTRLEN);
+
+  len = snprintf(netfile->line, NET_LINELEN,
+                 "%-15s %-15s %-5u %-8.8s %-10lu %lu\n",
+                 srcipaddr, destipaddr, flow.fl_proto,
+                 flow.fl_dev->d_ifname, (unsigned long)flow.fl_npackets,
+                 (unsigned long)flow.fl_nbytes);
+  net_unlock();
+  return len;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_flows
+ *
+ * Description:
+ *   Read and format the cached IPv4 forwarding flows.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which the flows will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_flows(FAR struct netprocfs_file_s *priv,
+                             FAR char *buffer, size_t buflen)
+{
+  linegen_t gentab[NFLOW_LINES];
+  int i;
+
+  /* Every line is generated by the same function according to lineno */
+
+  for (i = 0; i < NFLOW_LINES; i++)
+    {
+      gentab[i] = netprocfs_flow;
+    }
+
+  return netprocfs_read_linegen(priv, buffer, buflen, gentab, NFLOW_LINES);
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_NET && CONFIG_NET_IPFORWARD_FLOWCACHE */
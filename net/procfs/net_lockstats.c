@@ -0,0 +1,133 @@
+/****************************************************************************
+ * net/procfs/net_lockstats.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* Output format:
+ *
+ * Acquired   Contended  HoldTotalms HoldMaxus  PID   WaitTotalms WaitMaxus
+ * xxxxxxxxxx xxxxxxxxxx xxxxxxxxxxx xxxxxxxxxx xxxxx xxxxxxxxxxx xxxxxxxxx
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <debug.h>
+
+#include <nuttx/net/net.h>
+
+#include "utils/utils.h"
+#include "procfs/procfs.h"
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS) && \
+    !defined(CONFIG_FS_PROCFS_EXCLUDE_NET) && defined(CONFIG_NET_LOCK_STATS)
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* Line generating functions */
+
+static int netprocfs_lockheader(FAR struct netprocfs_file_s *netfile);
+static int netprocfs_lockstats(FAR struct netprocfs_file_s *netfile);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Line generating functions */
+
+static const linegen_t g_lock_linegen[] =
+{
+  netprocfs_lockheader,
+  netprocfs_lockstats
+};
+
+#define NLOCK_LINES (sizeof(g_lock_linegen) / sizeof(linegen_t))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_lockheader
+ ****************************************************************************/
+
+static int netprocfs_lockheader(FAR struct netprocfs_file_s *netfile)
+{
+  return snprintf(netfile->line, NET_LINELEN,
+                  "%-10s %-10s %-11s %-10s %-5s %-11s %s\n",
+                  "Acquired", "Contended", "HoldTotalms", "HoldMaxus",
+                  "PID", "WaitTotalms", "WaitMaxus");
+}
+
+/****************************************************************************
+ * Name: netprocfs_lockstats
+ ****************************************************************************/
+
+static int netprocfs_lockstats(FAR struct netprocfs_file_s *netfile)
+{
+  struct net_lockstats_s stats;
+
+  net_lockstats(&stats);
+  return snprintf(netfile->line, NET_LINELEN,
+                  "%-10lu %-10lu %-11lu %-10lu %-5d %-11lu %lu\n",
+                  (unsigned long)stats.nlocks,
+                  (unsigned long)stats.ncontended,
+                  (unsigned long)(stats.totalhold / 1000),
+                  (unsigned long)stats.maxhold, (int)stats.maxholder,
+                  (unsigned long)(stats.totalwait / 1000),
+                  (unsigned long)stats.maxwait);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netprocfs_read_lockstats
+ *
+ * Description:
+ *   Read and format the statistics of the network lock.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which the statistics will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+ssize_t netprocfs_read_lockstats(FAR struct netprocfs_file_s *priv,
+                                 FAR char *buffer, size_t buflen)
+{
+  return netprocfs_read_linegen(priv, buffer, buflen, g_lock_linegen,
+                                NLOCK_LINES);
+}
+
+#endif /* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS &&
+        * !CONFIG_FS_PROCFS_EXCLUDE_NET && CONFIG_NET_LOCK_STATS */
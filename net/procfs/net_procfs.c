@@ -85,9 +85,23 @@
 
 #ifdef CONFIG_NET_ROUTE
 #  define ROUTE_INDEX    _ROUTE_INDEX
-#  define DEV_INDEX      (_ROUTE_INDEX + 1)
+#  define _FLOWS_INDEX   (_ROUTE_INDEX + 1)
 #else
-#  define DEV_INDEX      _ROUTE_INDEX
+#  define _FLOWS_INDEX   _ROUTE_INDEX
+#endif
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+#  define FLOWS_INDEX    _FLOWS_INDEX
+#  define _LOCK_INDEX    (_FLOWS_INDEX + 1)
+#else
+#  define _LOCK_INDEX    _FLOWS_INDEX
+#endif
+
+#ifdef CONFIG_NET_LOCK_STATS
+#  define LOCK_INDEX     _LOCK_INDEX
+#  define DEV_INDEX      (_LOCK_INDEX + 1)
+#else
+#  define DEV_INDEX      _LOCK_INDEX
 #endif
 
 /****************************************************************************
@@ -206,6 +220,32 @@ static int netprocfs_open(FAR struct file *filep, FAR const char *relpath,
     }
   else
 #endif
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* "net/flows" is an acceptable value for the relpath only if the flow
+   * cache is enabled.
+   */
+
+  if (strcmp(relpath, "net/flows") == 0)
+    {
+      entry = NETPROCFS_SUBDIR_FLOWS;
+      dev   = NULL;
+    }
+  else
+#endif
+
+#ifdef CONFIG_NET_LOCK_STATS
+  /* "net/lock" is an acceptable value for the relpath only if the lock
+   * statistics are enabled.
+   */
+
+  if (strcmp(relpath, "net/lock") == 0)
+    {
+      entry = NETPROCFS_SUBDIR_LOCK;
+      dev   = NULL;
+    }
+  else
+#endif
     {
       FAR char *devname;
       FAR char *copy;
@@ -323,6 +363,24 @@ static ssize_t netprocfs_read(FAR struct file *filep, FAR char *buffer,
 #endif
 #endif
 
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      case NETPROCFS_SUBDIR_FLOWS:
+
+        /* Show the cached forwarding flows */
+
+        nreturned = netprocfs_read_flows(priv, buffer, buflen);
+        break;
+#endif
+
+#ifdef CONFIG_NET_LOCK_STATS
+      case NETPROCFS_SUBDIR_LOCK:
+
+        /* Show the statistics of the network lock */
+
+        nreturned = netprocfs_read_lockstats(priv, buffer, buflen);
+        break;
+#endif
+
 #ifdef CONFIG_NET_ROUTE
       case NETPROCFS_SUBDIR_ROUTE:
         nerr("ERROR: Cannot read from directory net/route\n");
@@ -446,6 +504,12 @@ static int netprocfs_opendir(FAR const char *relpath,
 #endif
 #ifdef CONFIG_NET_ROUTE
       level1->base.nentries++;
+#endif
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      level1->base.nentries++;
+#endif
+#ifdef CONFIG_NET_LOCK_STATS
+      level1->base.nentries++;
 #endif
     }
   else
@@ -559,6 +623,26 @@ static int netprocfs_readdir(FAR struct fs_dirent_s *dir)
           strncpy(dir->fd_dir.d_name, "route", NAME_MAX + 1);
         }
       else
+#endif
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+      if (index == FLOWS_INDEX)
+        {
+          /* Copy the forwarding flows file entry */
+
+          dir->fd_dir.d_type = DTYPE_FILE;
+          strncpy(dir->fd_dir.d_name, "flows", NAME_MAX + 1);
+        }
+      else
+#endif
+#ifdef CONFIG_NET_LOCK_STATS
+      if (index == LOCK_INDEX)
+        {
+          /* Copy the network lock statistics file entry */
+
+          dir->fd_dir.d_type = DTYPE_FILE;
+          strncpy(dir->fd_dir.d_name, "lock", NAME_MAX + 1);
+        }
+      else
 #endif
         {
           int ifindex;
@@ -689,6 +773,24 @@ static int netprocfs_stat(FAR const char *relpath, FAR struct stat *buf)
       buf->st_mode = S_IFDIR | S_IROTH | S_IRGRP | S_IRUSR;
     }
   else
+#endif
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  /* Check for the forwarding flows "net/flows" */
+
+  if (strcmp(relpath, "net/flows") == 0)
+    {
+      buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+    }
+  else
+#endif
+#ifdef CONFIG_NET_LOCK_STATS
+  /* Check for the network lock statistics "net/lock" */
+
+  if (strcmp(relpath, "net/lock") == 0)
+    {
+      buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+    }
+  else
 #endif
     {
       FAR struct net_driver_s *dev;
@@ -78,6 +78,12 @@ enum netprocfs_entry_e
 #ifdef CONFIG_NET_ROUTE
   , NETPROCFS_SUBDIR_ROUTE           /* /proc/net/route */
 #endif
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+  , NETPROCFS_SUBDIR_FLOWS           /* /proc/net/flows */
+#endif
+#ifdef CONFIG_NET_LOCK_STATS
+  , NETPROCFS_SUBDIR_LOCK            /* /proc/net/lock */
+#endif
 };
 
 /* This structure describes one open "file" */
@@ -218,6 +224,52 @@ ssize_t netprocfs_read_routes(FAR struct netprocfs_file_s *priv,
                               FAR char *buffer, size_t buflen);
 #endif
 
+/****************************************************************************
+ * Name: netprocfs_read_flows
+ *
+ * Description:
+ *   Read and format the cached IPv4 forwarding flows.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which the flows will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFORWARD_FLOWCACHE
+ssize_t netprocfs_read_flows(FAR struct netprocfs_file_s *priv,
+                             FAR char *buffer, size_t buflen);
+#endif
+
+/****************************************************************************
+ * Name: netprocfs_read_lockstats
+ *
+ * Description:
+ *   Read and format the statistics of the network lock.
+ *
+ * Input Parameters:
+ *   priv - A reference to the network procfs file structure
+ *   buffer - The user-provided buffer into which the statistics will be
+ *            returned.
+ *   bulen  - The size in bytes of the user provided buffer.
+ *
+ * Returned Value:
+ *   Zero (OK) is returned on success; a negated errno value is returned
+ *   on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCK_STATS
+ssize_t netprocfs_read_lockstats(FAR struct netprocfs_file_s *priv,
+                                 FAR char *buffer, size_t buflen);
+#endif
+
 /****************************************************************************
  * Name: netprocfs_read_devstats
  *
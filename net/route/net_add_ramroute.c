@@ -100,6 +100,13 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
 
   ramroute_ipv4_addlast((FAR struct net_route_ipv4_entry_s *)route,
                         &g_ipv4_routes);
+
+#ifdef CONFIG_ROUTE_IPv4_TRIE
+  /* And to the trie.  An earlier route of the same network is kept. */
+
+  net_addtrie_ipv4(route);
+#endif
+
   net_unlock();
   return OK;
 }
@@ -135,6 +142,13 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
 
   ramroute_ipv6_addlast((FAR struct net_route_ipv6_entry_s *)route,
                         &g_ipv6_routes);
+
+#ifdef CONFIG_ROUTE_IPv6_TRIE
+  /* And to the trie.  An earlier route of the same network is kept. */
+
+  net_addtrie_ipv6(route);
+#endif
+
   net_unlock();
   return OK;
 }
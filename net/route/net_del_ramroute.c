@@ -122,6 +122,12 @@ static int net_match_ipv4(FAR struct net_route_ipv4_s *route, FAR void *arg)
           ramroute_ipv4_remfirst(&g_ipv4_routes);
         }
 
+#ifdef CONFIG_ROUTE_IPv4_TRIE
+      /* The trie cannot refer to the entry once it is freed */
+
+      net_reloadtrie_ipv4();
+#endif
+
       /* And free the routing table entry by adding it to the free list */
 
       net_freeroute_ipv4(route);
@@ -175,6 +181,12 @@ static int net_match_ipv6(FAR struct net_route_ipv6_s *route, FAR void *arg)
           ramroute_ipv6_remfirst(&g_ipv6_routes);
         }
 
+#ifdef CONFIG_ROUTE_IPv6_TRIE
+      /* The trie cannot refer to the entry once it is freed */
+
+      net_reloadtrie_ipv6();
+#endif
+
       /* And free the routing table entry by adding it to the free list */
 
       net_freeroute_ipv6(route);
@@ -45,10 +45,12 @@
 
 #include <netinet/in.h>
 
+#include <nuttx/net/net.h>
 #include <nuttx/net/ip.h>
 
 #include "devif/devif.h"
 #include "route/cacheroute.h"
+#include "route/ramroute.h"
 #include "route/route.h"
 
 #if defined(CONFIG_NET) && defined(CONFIG_NET_ROUTE)
@@ -122,8 +124,9 @@ static int net_ipv4_match(FAR struct net_route_ipv4_s *route, FAR void *arg)
   FAR struct route_ipv4_match_s *match = (FAR struct route_ipv4_match_s *)arg;
 
   /* To match, the masked target addresses must be the same.  In the event
-   * of multiple matches, only the first is returned.  There is not (yet) any
-   * concept for the precedence of networks.
+   * of multiple matches, only the first is returned.  There is no concept
+   * for the precedence of networks unless the routes are looked up in a
+   * trie.
    */
 
   if (net_ipv4addr_maskcmp(route->target, match->target, route->netmask))
@@ -165,8 +168,9 @@ static int net_ipv6_match(FAR struct net_route_ipv6_s *route, FAR void *arg)
   FAR struct route_ipv6_match_s *match = (FAR struct route_ipv6_match_s *)arg;
 
   /* To match, the masked target addresses must be the same.  In the event
-   * of multiple matches, only the first is returned.  There is not (yet) any
-   * concept for the precedence of networks.
+   * of multiple matches, only the first is returned.  There is no concept
+   * for the precedence of networks unless the routes are looked up in a
+   * trie.
    */
 
   if (net_ipv6addr_maskcmp(route->target, match->target, route->netmask))
@@ -212,6 +216,9 @@ static int net_ipv6_match(FAR struct net_route_ipv6_s *route, FAR void *arg)
 int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
 {
   struct route_ipv4_match_s match;
+#ifdef CONFIG_ROUTE_IPv4_TRIE
+  FAR struct net_route_ipv4_s *route;
+#endif
   int ret;
 
   /* Do not route the special broadcast IP address */
@@ -237,7 +244,16 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
        * routing table that can forward to this address
        */
 
+#ifdef CONFIG_ROUTE_IPv4_TRIE
+      /* Find the route of the longest matching network prefix */
+
+      net_lock();
+      route = net_lookuptrie_ipv4(target);
+      ret   = route != NULL ? net_ipv4_match(route, &match) : 0;
+      net_unlock();
+#else
       ret = net_foreachroute_ipv4(net_ipv4_match, &match);
+#endif
     }
 
   /* Did we find a route? */
@@ -287,6 +303,9 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router)
 int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
 {
   struct route_ipv6_match_s match;
+#ifdef CONFIG_ROUTE_IPv6_TRIE
+  FAR struct net_route_ipv6_s *route;
+#endif
   int ret;
 
   /* Do not route to any the special IPv6 multicast addresses */
@@ -312,7 +331,16 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router)
        * routing table that can forward to this address
        */
 
+#ifdef CONFIG_ROUTE_IPv6_TRIE
+      /* Find the route of the longest matching network prefix */
+
+      net_lock();
+      route = net_lookuptrie_ipv6(target);
+      ret   = route != NULL ? net_ipv6_match(route, &match) : 0;
+      net_unlock();
+#else
       ret = net_foreachroute_ipv6(net_ipv6_match, &match);
+#endif
     }
 
   /* Did we find a route? */
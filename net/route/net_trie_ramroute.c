@@ -0,0 +1,443 @@
+/****************************************************************************
+ * net/route/net_trie_ramroute.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <nuttx/net/ip.h>
+
+#include "route/ramroute.h"
+#include "route/route.h"
+
+#if defined(CONFIG_ROUTE_IPv4_TRIE) || defined(CONFIG_ROUTE_IPv6_TRIE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The length of the longest key in bytes */
+
+#ifdef CONFIG_ROUTE_IPv6_TRIE
+#  define ROUTE_TRIE_KEYLEN 16
+#else
+#  define ROUTE_TRIE_KEYLEN 4
+#endif
+
+/* Each route adds at most one branch node besides its own node */
+
+#define ROUTE_IPv4_TRIENODES (2 * CONFIG_ROUTE_MAX_IPv4_RAMROUTES)
+#define ROUTE_IPv6_TRIENODES (2 * CONFIG_ROUTE_MAX_IPv6_RAMROUTES)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A node of a path-compressed binary trie.  The node holds a prefix of
+ * 'plen' bits.  The prefixes of its children extend it with a zero or a
+ * one bit.  A node without a route only joins two branches.
+ */
+
+struct route_trienode_s
+{
+  FAR struct route_trienode_s *child[2];
+  FAR void *route;                  /* The route of the prefix or NULL */
+  uint8_t plen;                     /* The length of the prefix in bits */
+  uint8_t key[ROUTE_TRIE_KEYLEN];   /* The prefix in network order */
+};
+
+/* The trie of a routing table.  The nodes are taken from a fixed pool that
+ * is only recycled as a whole when the trie is reloaded.
+ */
+
+struct route_trie_s
+{
+  FAR struct route_trienode_s *root;
+  FAR struct route_trienode_s *pool;
+  uint16_t nnodes;                  /* The number of nodes in use */
+  uint16_t maxnodes;                /* The size of the pool */
+  uint8_t keylen;                   /* The length of the keys in bytes */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_TRIE
+static struct route_trienode_s g_ipv4_trienodes[ROUTE_IPv4_TRIENODES];
+static struct route_trie_s g_ipv4_trie =
+{
+  NULL, g_ipv4_trienodes, 0, ROUTE_IPv4_TRIENODES, sizeof(in_addr_t)
+};
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_TRIE
+static struct route_trienode_s g_ipv6_trienodes[ROUTE_IPv6_TRIENODES];
+static struct route_trie_s g_ipv6_trie =
+{
+  NULL, g_ipv6_trienodes, 0, ROUTE_IPv6_TRIENODES, sizeof(net_ipv6addr_t)
+};
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: route_trie_bit
+ *
+ * Description:
+ *   Return bit 'n' of a key, counting from the most significant bit of the
+ *   first byte.
+ *
+ ****************************************************************************/
+
+static inline int route_trie_bit(FAR const uint8_t *key, unsigned int n)
+{
+  return (key[n >> 3] >> (7 - (n & 7))) & 1;
+}
+
+/****************************************************************************
+ * Name: route_trie_common
+ *
+ * Description:
+ *   Return the number of leading bits that two keys have in common, up to
+ *   'limit'.  The bits before 'start' are known to be the same.
+ *
+ ****************************************************************************/
+
+static unsigned int route_trie_common(FAR const uint8_t *a,
+                                      FAR const uint8_t *b,
+                                      unsigned int start,
+                                      unsigned int limit)
+{
+  unsigned int i;
+  unsigned int n;
+  uint8_t diff;
+
+  for (i = start >> 3; (i << 3) < limit; i++)
+    {
+      diff = a[i] ^ b[i];
+      if (diff != 0)
+        {
+          for (n = i << 3; (diff & 0x80) == 0; n++)
+            {
+              diff <<= 1;
+            }
+
+          return n < limit ? n : limit;
+        }
+    }
+
+  return limit;
+}
+
+/****************************************************************************
+ * Name: route_trie_plen
+ *
+ * Description:
+ *   Return the prefix length of a network mask.  The mask is expected to
+ *   be contiguous;  any bits after the first zero bit are ignored.
+ *
+ ****************************************************************************/
+
+static unsigned int route_trie_plen(FAR const uint8_t *mask,
+                                    unsigned int keylen)
+{
+  unsigned int plen = 0;
+  unsigned int i;
+  uint8_t bits;
+
+  for (i = 0; i < keylen && mask[i] == 0xff; i++)
+    {
+      plen += 8;
+    }
+
+  if (i < keylen)
+    {
+      for (bits = mask[i]; (bits & 0x80) != 0; bits <<= 1)
+        {
+          plen++;
+        }
+    }
+
+  return plen;
+}
+
+/****************************************************************************
+ * Name: route_trie_alloc
+ *
+ * Description:
+ *   Take a node from the pool of a trie and initialize it.
+ *
+ ****************************************************************************/
+
+static FAR struct route_trienode_s *
+route_trie_alloc(FAR struct route_trie_s *trie, FAR const uint8_t *key,
+                 unsigned int plen, FAR void *route)
+{
+  FAR struct route_trienode_s *node = &trie->pool[trie->nnodes++];
+
+  node->child[0] = NULL;
+  node->child[1] = NULL;
+  node->route    = route;
+  node->plen     = plen;
+  memcpy(node->key, key, trie->keylen);
+  return node;
+}
+
+/****************************************************************************
+ * Name: route_trie_insert
+ *
+ * Description:
+ *   Add a route for a prefix to a trie.  If there is already a route for
+ *   the prefix, that route is kept so that the first of several routes of
+ *   the same network is used, as by the linear search of the table.
+ *
+ ****************************************************************************/
+
+static int route_trie_insert(FAR struct route_trie_s *trie,
+                             FAR const uint8_t *key, unsigned int plen,
+                             FAR void *route)
+{
+  FAR struct route_trienode_s **link = &trie->root;
+  FAR struct route_trienode_s *node;
+  FAR struct route_trienode_s *newnode;
+  unsigned int common = 0;
+
+  if (trie->nnodes + 2 > trie->maxnodes)
+    {
+      return -ENOMEM;
+    }
+
+  while ((node = *link) != NULL)
+    {
+      common = route_trie_common(node->key, key, common,
+                                 node->plen < plen ? node->plen : plen);
+      if (common < node->plen)
+        {
+          /* The new prefix ends or branches off within the prefix of the
+           * node.  Insert a node for the shorter prefix above it.
+           */
+
+          if (common == plen)
+            {
+              newnode = route_trie_alloc(trie, key, plen, route);
+              newnode->child[route_trie_bit(node->key, plen)] = node;
+            }
+          else
+            {
+              newnode = route_trie_alloc(trie, key, common, NULL);
+              newnode->child[route_trie_bit(node->key, common)] = node;
+              newnode->child[route_trie_bit(key, common)] =
+                route_trie_alloc(trie, key, plen, route);
+            }
+
+          *link = newnode;
+          return OK;
+        }
+
+      if (node->plen == plen)
+        {
+          /* The node holds the same prefix */
+
+          if (node->route != NULL)
+            {
+              return -EEXIST;
+            }
+
+          node->route = route;
+          return OK;
+        }
+
+      link = &node->child[route_trie_bit(key, node->plen)];
+    }
+
+  *link = route_trie_alloc(trie, key, plen, route);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: route_trie_lookup
+ *
+ * Description:
+ *   Return the route of the longest prefix of a trie that matches an
+ *   address or NULL if there is none.
+ *
+ ****************************************************************************/
+
+static FAR void *route_trie_lookup(FAR struct route_trie_s *trie,
+                                   FAR const uint8_t *key)
+{
+  FAR struct route_trienode_s *node = trie->root;
+  FAR void *best = NULL;
+  unsigned int nbits = trie->keylen << 3;
+  unsigned int common = 0;
+
+  while (node != NULL)
+    {
+      common = route_trie_common(node->key, key, common, node->plen);
+      if (common < node->plen)
+        {
+          break;
+        }
+
+      if (node->route != NULL)
+        {
+          best = node->route;
+        }
+
+      if (node->plen >= nbits)
+        {
+          break;
+        }
+
+      node = node->child[route_trie_bit(key, node->plen)];
+    }
+
+  return best;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_addtrie_ipv4 and net_addtrie_ipv6
+ *
+ * Description:
+ *   Add a route of the in-memory routing table to its trie.
+ *
+ * Input Parameters:
+ *   route - The route to add.  It must stay in the routing table until the
+ *           trie is reloaded.
+ *
+ * Returned Value:
+ *   OK on success;  -EEXIST if the trie already holds a route for the same
+ *   network and netmask.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_TRIE
+int net_addtrie_ipv4(FAR struct net_route_ipv4_s *route)
+{
+  return route_trie_insert(&g_ipv4_trie, (FAR const uint8_t *)&route->target,
+                           route_trie_plen((FAR const uint8_t *)
+                                           &route->netmask,
+                                           sizeof(in_addr_t)),
+                           route);
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_TRIE
+int net_addtrie_ipv6(FAR struct net_route_ipv6_s *route)
+{
+  return route_trie_insert(&g_ipv6_trie, (FAR const uint8_t *)route->target,
+                           route_trie_plen((FAR const uint8_t *)
+                                           route->netmask,
+                                           sizeof(net_ipv6addr_t)),
+                           route);
+}
+#endif
+
+/****************************************************************************
+ * Name: net_reloadtrie_ipv4 and net_reloadtrie_ipv6
+ *
+ * Description:
+ *   Rebuild the trie from the in-memory routing table.  This must be done
+ *   whenever routes are removed from the table.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_TRIE
+void net_reloadtrie_ipv4(void)
+{
+  FAR struct net_route_ipv4_entry_s *route;
+
+  g_ipv4_trie.root   = NULL;
+  g_ipv4_trie.nnodes = 0;
+
+  for (route = g_ipv4_routes.head; route != NULL; route = route->flink)
+    {
+      net_addtrie_ipv4(&route->entry);
+    }
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_TRIE
+void net_reloadtrie_ipv6(void)
+{
+  FAR struct net_route_ipv6_entry_s *route;
+
+  g_ipv6_trie.root   = NULL;
+  g_ipv6_trie.nnodes = 0;
+
+  for (route = g_ipv6_routes.head; route != NULL; route = route->flink)
+    {
+      net_addtrie_ipv6(&route->entry);
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: net_lookuptrie_ipv4 and net_lookuptrie_ipv6
+ *
+ * Description:
+ *   Return the route of the in-memory routing table with the longest
+ *   network prefix that matches the target address.
+ *
+ * Input Parameters:
+ *   target - The address on a remote network to look up
+ *
+ * Returned Value:
+ *   The route or NULL if no route matches.
+ *
+ * Assumptions:
+ *   The network is locked.  The route may be removed once it is unlocked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_TRIE
+FAR struct net_route_ipv4_s *net_lookuptrie_ipv4(in_addr_t target)
+{
+  return route_trie_lookup(&g_ipv4_trie, (FAR const uint8_t *)&target);
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_TRIE
+FAR struct net_route_ipv6_s *net_lookuptrie_ipv6(const net_ipv6addr_t target)
+{
+  return route_trie_lookup(&g_ipv6_trie, (FAR const uint8_t *)target);
+}
+#endif
+
+#endif /* CONFIG_ROUTE_IPv4_TRIE || CONFIG_ROUTE_IPv6_TRIE */
@@ -231,5 +231,78 @@ FAR struct net_route_ipv6_entry_s *
   struct net_route_ipv6_queue_s *list);
 #endif
 
+/****************************************************************************
+ * Name: net_addtrie_ipv4 and net_addtrie_ipv6
+ *
+ * Description:
+ *   Add a route of the in-memory routing table to its trie.
+ *
+ * Input Parameters:
+ *   route - The route to add.  It must stay in the routing table until the
+ *           trie is reloaded.
+ *
+ * Returned Value:
+ *   OK on success;  -EEXIST if the trie already holds a route for the same
+ *   network and netmask.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_TRIE
+int net_addtrie_ipv4(FAR struct net_route_ipv4_s *route);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_TRIE
+int net_addtrie_ipv6(FAR struct net_route_ipv6_s *route);
+#endif
+
+/****************************************************************************
+ * Name: net_reloadtrie_ipv4 and net_reloadtrie_ipv6
+ *
+ * Description:
+ *   Rebuild the trie from the in-memory routing table.  This must be done
+ *   whenever routes are removed from the table.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_TRIE
+void net_reloadtrie_ipv4(void);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_TRIE
+void net_reloadtrie_ipv6(void);
+#endif
+
+/****************************************************************************
+ * Name: net_lookuptrie_ipv4 and net_lookuptrie_ipv6
+ *
+ * Description:
+ *   Return the route of the in-memory routing table with the longest
+ *   network prefix that matches the target address.
+ *
+ * Input Parameters:
+ *   target - The address on a remote network to look up
+ *
+ * Returned Value:
+ *   The route or NULL if no route matches.
+ *
+ * Assumptions:
+ *   The network is locked.  The route may be removed once it is unlocked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_TRIE
+FAR struct net_route_ipv4_s *net_lookuptrie_ipv4(in_addr_t target);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_TRIE
+FAR struct net_route_ipv6_s *net_lookuptrie_ipv6(const net_ipv6addr_t target);
+#endif
+
 #endif /* CONFIG_ROUTE_IPv4_RAMROUTE || CONFIG_ROUTE_IPv6_RAMROUTE */
 #endif /* __NET_ROUTE_RAMROUTE_H */
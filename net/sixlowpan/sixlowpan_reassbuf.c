@@ -41,6 +41,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
@@ -58,6 +59,14 @@
 
 #define NET_6LOWPAN_TIMEOUT SEC2TICK(CONFIG_NET_6LOWPAN_MAXAGE)
 
+/* The active reassembly buffers are hashed by their reassembly tag so that
+ * each received fragment only has to search a short list.  Must be a power
+ * of two.
+ */
+
+#define REASS_HASH_SIZE     8
+#define REASS_HASH(t)       ((t) & (REASS_HASH_SIZE - 1))
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -69,9 +78,11 @@
 
 static FAR struct sixlowpan_reassbuf_s *g_free_reass;
 
-/* This is a list of active, allocated reassemby buffers */
+/* These are the lists of active, allocated reassemby buffers, indexed by
+ * REASS_HASH() of the reassembly tag.
+ */
 
-static FAR struct sixlowpan_reassbuf_s *g_active_reass;
+static FAR struct sixlowpan_reassbuf_s *g_active_reass[REASS_HASH_SIZE];
 
 /* Pool of pre-allocated reassembly buffer structures */
 
@@ -115,13 +126,15 @@ static bool sixlowpan_compare_fragsrc(FAR struct sixlowpan_reassbuf_s *reass,
 }
 
 /****************************************************************************
- * Name: sixlowpan_reass_expire
+ * Name: sixlowpan_reass_expire_list
  *
  * Description:
- *   Free all expired or inactive reassembly buffers.
+ *   Free all expired or inactive reassembly buffers in one list of active
+ *   reassembly buffers.
  *
  * Input Parameters:
- *   None
+ *   hash - The index of the list
+ *   now  - The current time in clock ticks
  *
  * Returned Value:
  *   None
@@ -131,15 +144,12 @@ static bool sixlowpan_compare_fragsrc(FAR struct sixlowpan_reassbuf_s *reass,
  *
  ****************************************************************************/
 
-static void sixlowpan_reass_expire(void)
+static void sixlowpan_reass_expire_list(unsigned int hash, clock_t now)
 {
   FAR struct sixlowpan_reassbuf_s *reass;
   FAR struct sixlowpan_reassbuf_s *next;
-  clock_t elapsed;
 
-  /* If reassembly timed out, cancel it */
-
-  for (reass = g_active_reass; reass != NULL; reass = next)
+  for (reass = g_active_reass[hash]; reass != NULL; reass = next)
     {
       /* Needed if 'reass' is freed */
 
@@ -153,20 +163,42 @@ static void sixlowpan_reass_expire(void)
         {
           sixlowpan_reass_free(reass);
         }
-      else
+
+      /* If the reassembly has expired, then free the reassembly buffer */
+
+      else if (now - reass->rb_time >= NET_6LOWPAN_TIMEOUT)
         {
-          /* Get the elpased time of the reassembly */
+          nwarn("WARNING: Reassembly timed out\n");
+          sixlowpan_reass_free(reass);
+        }
+    }
+}
 
-          elapsed = clock_systime_ticks() - reass->rb_time;
+/****************************************************************************
+ * Name: sixlowpan_reass_expire
+ *
+ * Description:
+ *   Free all expired or inactive reassembly buffers.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
 
-          /* If the reassembly has expired, then free the reassembly buffer */
+static void sixlowpan_reass_expire(void)
+{
+  clock_t now = clock_systime_ticks();
+  unsigned int hash;
 
-          if (elapsed >= NET_6LOWPAN_TIMEOUT)
-            {
-              nwarn("WARNING: Reassembly timed out\n");
-              sixlowpan_reass_free(reass);
-            }
-        }
+  for (hash = 0; hash < REASS_HASH_SIZE; hash++)
+    {
+      sixlowpan_reass_expire_list(hash, now);
     }
 }
 
@@ -189,12 +221,14 @@ static void sixlowpan_reass_expire(void)
 
 static void sixlowpan_remove_active(FAR struct sixlowpan_reassbuf_s *reass)
 {
+  FAR struct sixlowpan_reassbuf_s **list;
   FAR struct sixlowpan_reassbuf_s *curr;
   FAR struct sixlowpan_reassbuf_s *prev;
 
   /* Find the reassembly buffer in the list of active reassembly buffers */
 
-  for (prev = NULL, curr = g_active_reass;
+  list = &g_active_reass[REASS_HASH(reass->rb_reasstag)];
+  for (prev = NULL, curr = *list;
        curr != NULL && curr != reass;
        prev = curr, curr = curr->rb_flink)
     {
@@ -208,7 +242,7 @@ static void sixlowpan_remove_active(FAR struct sixlowpan_reassbuf_s *reass)
 
       if (prev == NULL)
         {
-          g_active_reass = reass->rb_flink;
+          *list = reass->rb_flink;
         }
       else
         {
@@ -304,11 +338,12 @@ FAR struct sixlowpan_reassbuf_s *
 
   /* Now, try the free list first */
 
+  pool = REASS_POOL_PREALLOCATED;
+
   if (g_free_reass != NULL)
     {
       reass         = g_free_reass;
       g_free_reass  = reass->rb_flink;
-      pool          = REASS_POOL_PREALLOCATED;
     }
   else
     {
@@ -329,9 +364,13 @@ FAR struct sixlowpan_reassbuf_s *
 
   if (reass != NULL)
     {
-      /* Zero and tag the allocated reassembly buffer structure. */
+      /* Zero and tag the allocated reassembly buffer structure.  The
+       * packet buffer itself does not need to be cleared.
+       */
 
-      memset(reass, 0, sizeof(struct sixlowpan_reassbuf_s));
+      memset(&reass->rb_pool, 0,
+             sizeof(struct sixlowpan_reassbuf_s) -
+             offsetof(struct sixlowpan_reassbuf_s, rb_pool));
       memcpy(&reass->rb_fragsrc, fragsrc, sizeof(struct netdev_varaddr_s));
       reass->rb_pool     = pool;
       reass->rb_active   = true;
@@ -340,8 +379,8 @@ FAR struct sixlowpan_reassbuf_s *
 
       /* Add the reassembly buffer to the list of active reassembly buffers */
 
-      reass->rb_flink   = g_active_reass;
-      g_active_reass    = reass;
+      reass->rb_flink   = g_active_reass[REASS_HASH(reasstag)];
+      g_active_reass[REASS_HASH(reasstag)] = reass;
     }
 
   return reass;
@@ -371,18 +410,20 @@ FAR struct sixlowpan_reassbuf_s *
                        FAR const struct netdev_varaddr_s *fragsrc)
 {
   FAR struct sixlowpan_reassbuf_s *reass;
+  unsigned int hash = REASS_HASH(reasstag);
 
-  /* First, removed any expired or inactive reassembly buffers (we don't want
-   * to return old reassembly buffer with the same tag)
+  /* First, removed any expired or inactive reassembly buffers with this
+   * hash (we don't want to return old reassembly buffer with the same tag).
+   * The other lists are cleaned up when a buffer is allocated.
    */
 
-  sixlowpan_reass_expire();
+  sixlowpan_reass_expire_list(hash, clock_systime_ticks());
 
   /* Now search for the matching reassembly buffer in the remainng, active
    * reassembly buffers.
    */
 
-  for (reass = g_active_reass; reass != NULL; reass = reass->rb_flink)
+  for (reass = g_active_reass[hash]; reass != NULL; reass = reass->rb_flink)
     {
       /* In order to be a match, it must have the same reassembly tag as
        * well as source address (different sources might use the same
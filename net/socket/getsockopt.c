@@ -50,6 +50,8 @@
 
 #include "socket/socket.h"
 #include "tcp/tcp.h"
+#include "udp/udp.h"
+#include "pkt/pkt.h"
 #include "usrsock/usrsock.h"
 #include "utils/utils.h"
 
@@ -264,6 +266,86 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
         }
         break;
 
+#if (defined(CONFIG_NET_TCP) && !defined(CONFIG_NET_TCP_NO_STACK)) || \
+    (defined(CONFIG_NET_UDP) && !defined(CONFIG_NET_UDP_NO_STACK))
+      case SO_RCVBUF:     /* Reports receive buffer size */
+        {
+          /* The receive buffer size is only supported for TCP and UDP
+           * sockets
+           */
+
+          if (psock->s_domain != PF_INET && psock->s_domain != PF_INET6)
+            {
+              return -ENOPROTOOPT;
+            }
+
+          if (*value_len < sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+#if defined(CONFIG_NET_TCP) && !defined(CONFIG_NET_TCP_NO_STACK)
+          if (psock->s_type == SOCK_STREAM)
+            {
+              FAR struct tcp_conn_s *conn =
+                (FAR struct tcp_conn_s *)psock->s_conn;
+
+              *(FAR int *)value = (int)conn->rcv_bufs;
+            }
+          else
+#endif
+#if defined(CONFIG_NET_UDP) && !defined(CONFIG_NET_UDP_NO_STACK)
+          if (psock->s_type == SOCK_DGRAM)
+            {
+              FAR struct udp_conn_s *conn =
+                (FAR struct udp_conn_s *)psock->s_conn;
+
+              *(FAR int *)value = (int)conn->rcv_bufs;
+            }
+          else
+#endif
+            {
+              return -ENOPROTOOPT;
+            }
+
+          *value_len = sizeof(int);
+        }
+        break;
+#endif
+
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+      case SO_SNDBUF:     /* Reports send buffer size */
+        {
+          FAR struct tcp_conn_s *conn;
+
+          /* The send buffer size is only supported for buffered TCP
+           * sockets
+           */
+
+          if ((psock->s_domain != PF_INET && psock->s_domain != PF_INET6) ||
+              psock->s_type != SOCK_STREAM)
+            {
+              return -ENOPROTOOPT;
+            }
+
+          if (*value_len < sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+          conn = (FAR struct tcp_conn_s *)psock->s_conn;
+          *(FAR int *)value = (int)conn->snd_bufs;
+          *value_len        = sizeof(int);
+        }
+        break;
+#endif
+
+#ifdef CONFIG_NET_TIMESTAMP
+      case SO_TIMESTAMP:    /* Reports whether receive times are returned */
+      case SO_TIMESTAMPING: /* Reports the timestamping flags */
+        return net_tstamp_getsockopt(psock, option, value, value_len);
+#endif
+
       case SO_ERROR:      /* Reports and clears error status. */
         {
           if (*value_len != sizeof(int))
@@ -279,9 +361,14 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
       /* The following are not yet implemented (return values other than {0,1) */
 
       case SO_LINGER:     /* Lingers on a close() if data is present */
+#if (!defined(CONFIG_NET_TCP) || defined(CONFIG_NET_TCP_NO_STACK)) && \
+    (!defined(CONFIG_NET_UDP) || defined(CONFIG_NET_UDP_NO_STACK))
       case SO_RCVBUF:     /* Sets receive buffer size */
+#endif
       case SO_RCVLOWAT:   /* Sets the minimum number of bytes to input */
+#ifndef CONFIG_NET_TCP_WRITE_BUFFERS
       case SO_SNDBUF:     /* Sets send buffer size */
+#endif
       case SO_SNDLOWAT:   /* Sets the minimum number of bytes to output */
 
       default:
@@ -367,6 +454,12 @@ int psock_getsockopt(FAR struct socket *psock, int level, int option,
        break;
 #endif
 
+#ifdef CONFIG_NET_PKT_RXRING
+      case SOL_PACKET: /* Packet options (see include/netpacket/packet.h) */
+       ret = pkt_getsockopt(psock, option, value, value_len);
+       break;
+#endif
+
       /* These levels are defined in sys/socket.h, but are not yet
        * implemented.
        */
@@ -0,0 +1,378 @@
+/****************************************************************************
+ * net/socket/net_tstamp.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "socket/socket.h"
+#include "udp/udp.h"
+#include "pkt/pkt.h"
+
+#ifdef CONFIG_NET_TIMESTAMP
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_tstamp_addcmsg
+ *
+ * Description:
+ *   Append one control message to the control data buffer of a message.
+ *   MSG_CTRUNC is set if there is no room left for it.
+ *
+ * Input Parameters:
+ *   msg   - The message header.  msg_controllen holds the length of the
+ *           control data added so far.
+ *   space - The size of the control data buffer
+ *   type  - The control message type
+ *   data  - The control message data
+ *   len   - The length of the control message data
+ *
+ ****************************************************************************/
+
+static void net_tstamp_addcmsg(FAR struct msghdr *msg, size_t space,
+                               int type, FAR const void *data, size_t len)
+{
+  FAR struct cmsghdr *cmsg;
+
+  if (msg->msg_controllen + CMSG_SPACE(len) > space)
+    {
+      msg->msg_flags |= MSG_CTRUNC;
+      return;
+    }
+
+  cmsg = (FAR struct cmsghdr *)
+    ((FAR char *)msg->msg_control + msg->msg_controllen);
+
+  cmsg->cmsg_len   = CMSG_LEN(len);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type  = type;
+  memcpy(CMSG_DATA(cmsg), data, len);
+
+  msg->msg_controllen += CMSG_SPACE(len);
+}
+
+/****************************************************************************
+ * Name: net_tstamp_report
+ *
+ * Description:
+ *   Select the timestamps that are reported with SCM_TIMESTAMPING.
+ *
+ * Input Parameters:
+ *   flags  - The SO_TIMESTAMPING flags of the socket
+ *   swflag - The flag that generates the software timestamp
+ *   hwflag - The flag that generates the hardware timestamp
+ *   ts     - The timestamps.  Those not reported are cleared.
+ *
+ * Returned Value:
+ *   True if any timestamp is reported.
+ *
+ ****************************************************************************/
+
+static bool net_tstamp_report(uint8_t flags, uint8_t swflag, uint8_t hwflag,
+                              FAR struct scm_timestamping *ts)
+{
+  bool report = false;
+
+  memset(&ts->ts[1], 0, sizeof(struct timespec));
+
+  if ((flags & swflag) != 0 && (flags & SOF_TIMESTAMPING_SOFTWARE) != 0 &&
+      (ts->ts[0].tv_sec != 0 || ts->ts[0].tv_nsec != 0))
+    {
+      report = true;
+    }
+  else
+    {
+      memset(&ts->ts[0], 0, sizeof(struct timespec));
+    }
+
+  if ((flags & hwflag) != 0 &&
+      (flags & SOF_TIMESTAMPING_RAW_HARDWARE) != 0 &&
+      (ts->ts[2].tv_sec != 0 || ts->ts[2].tv_nsec != 0))
+    {
+      report = true;
+    }
+  else
+    {
+      memset(&ts->ts[2], 0, sizeof(struct timespec));
+    }
+
+  return report;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_tstamp
+ *
+ * Description:
+ *   Return the timestamping state of a UDP or packet socket.
+ *
+ * Input Parameters:
+ *   psock - The socket
+ *
+ * Returned Value:
+ *   The timestamping state or NULL if the socket does not support
+ *   timestamps.
+ *
+ ****************************************************************************/
+
+FAR struct net_tstamp_s *psock_tstamp(FAR struct socket *psock)
+{
+  /* Only the inet and packet socket interfaces provide recvmsg() */
+
+  if (psock->s_sockif == NULL || psock->s_sockif->si_recvmsg == NULL ||
+      psock->s_conn == NULL)
+    {
+      return NULL;
+    }
+
+#ifdef CONFIG_NET_PKT
+  if (psock->s_domain == PF_PACKET)
+    {
+      return &((FAR struct pkt_conn_s *)psock->s_conn)->tstamp;
+    }
+#endif
+
+#ifdef CONFIG_NET_UDP
+  if (psock->s_type == SOCK_DGRAM)
+    {
+      return &((FAR struct udp_conn_s *)psock->s_conn)->tstamp;
+    }
+#endif
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: net_tstamp_setsockopt
+ *
+ * Description:
+ *   Set the SO_TIMESTAMP or SO_TIMESTAMPING socket option.
+ *
+ * Input Parameters:
+ *   psock     - The socket
+ *   option    - SO_TIMESTAMP or SO_TIMESTAMPING
+ *   value     - Points to the integer argument value
+ *   value_len - The length of the argument value
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int net_tstamp_setsockopt(FAR struct socket *psock, int option,
+                          FAR const void *value, socklen_t value_len)
+{
+  FAR struct net_tstamp_s *tstamp = psock_tstamp(psock);
+  int setting;
+
+  if (tstamp == NULL)
+    {
+      return -ENOPROTOOPT;
+    }
+
+  if (value_len != sizeof(int))
+    {
+      return -EINVAL;
+    }
+
+  setting = *(FAR const int *)value;
+  if (option == SO_TIMESTAMPING &&
+      (setting & ~SOF_TIMESTAMPING_MASK) != 0)
+    {
+      return -EINVAL;
+    }
+
+  net_lock();
+
+  if (option == SO_TIMESTAMP)
+    {
+      tstamp->ts_timeval = (setting != 0);
+    }
+  else
+    {
+      tstamp->ts_flags   = (uint8_t)setting;
+      tstamp->ts_txvalid = 0;
+    }
+
+  net_unlock();
+  return OK;
+}
+
+/****************************************************************************
+ * Name: net_tstamp_getsockopt
+ *
+ * Description:
+ *   Get the SO_TIMESTAMP or SO_TIMESTAMPING socket option.
+ *
+ * Input Parameters:
+ *   psock     - The socket
+ *   option    - SO_TIMESTAMP or SO_TIMESTAMPING
+ *   value     - The location to return the integer value
+ *   value_len - The length of the value buffer; updated with the length
+ *               returned
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int net_tstamp_getsockopt(FAR struct socket *psock, int option,
+                          FAR void *value, FAR socklen_t *value_len)
+{
+  FAR struct net_tstamp_s *tstamp = psock_tstamp(psock);
+
+  if (tstamp == NULL)
+    {
+      return -ENOPROTOOPT;
+    }
+
+  if (*value_len < sizeof(int))
+    {
+      return -EINVAL;
+    }
+
+  if (option == SO_TIMESTAMP)
+    {
+      *(FAR int *)value = tstamp->ts_timeval;
+    }
+  else
+    {
+      *(FAR int *)value = tstamp->ts_flags;
+    }
+
+  *value_len = sizeof(int);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: net_tstamp_recvcmsg
+ *
+ * Description:
+ *   Return the receive timestamps of a datagram as the control data of a
+ *   message, as selected by SO_TIMESTAMP and SO_TIMESTAMPING.
+ *
+ * Input Parameters:
+ *   tstamp - The timestamping state of the socket
+ *   ts     - The receive timestamps of the datagram (ts[0] software,
+ *            ts[2] hardware)
+ *   msg    - The message header.  msg_controllen is updated with the
+ *            length of the control data returned.
+ *
+ ****************************************************************************/
+
+void net_tstamp_recvcmsg(FAR struct net_tstamp_s *tstamp,
+                         FAR const struct scm_timestamping *ts,
+                         FAR struct msghdr *msg)
+{
+  struct scm_timestamping report;
+  size_t space = msg->msg_control != NULL ? msg->msg_controllen : 0;
+
+  msg->msg_controllen = 0;
+
+  if (tstamp->ts_timeval)
+    {
+      struct timeval tv;
+
+      tv.tv_sec  = ts->ts[0].tv_sec;
+      tv.tv_usec = ts->ts[0].tv_nsec / NSEC_PER_USEC;
+      net_tstamp_addcmsg(msg, space, SCM_TIMESTAMP, &tv, sizeof(tv));
+    }
+
+  report = *ts;
+  if (net_tstamp_report(tstamp->ts_flags, SOF_TIMESTAMPING_RX_SOFTWARE,
+                        SOF_TIMESTAMPING_RX_HARDWARE, &report))
+    {
+      net_tstamp_addcmsg(msg, space, SCM_TIMESTAMPING, &report,
+                         sizeof(report));
+    }
+}
+
+/****************************************************************************
+ * Name: net_tstamp_errqueue
+ *
+ * Description:
+ *   Return the pending transmit timestamps of a socket as the control data
+ *   of a message, as for recvmsg(MSG_ERRQUEUE).  The timestamps are
+ *   consumed.
+ *
+ * Input Parameters:
+ *   tstamp - The timestamping state of the socket
+ *   msg    - The message header
+ *
+ * Returned Value:
+ *   Zero (no data bytes) on success; -EAGAIN if no timestamp is pending.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+ssize_t net_tstamp_errqueue(FAR struct net_tstamp_s *tstamp,
+                            FAR struct msghdr *msg)
+{
+  struct scm_timestamping report;
+  size_t space = msg->msg_control != NULL ? msg->msg_controllen : 0;
+
+  msg->msg_controllen = 0;
+  msg->msg_namelen    = 0;
+
+  report = tstamp->ts_tx;
+  if ((tstamp->ts_txvalid & SOF_TIMESTAMPING_TX_SOFTWARE) == 0)
+    {
+      memset(&report.ts[0], 0, sizeof(struct timespec));
+    }
+
+  if ((tstamp->ts_txvalid & SOF_TIMESTAMPING_TX_HARDWARE) == 0)
+    {
+      memset(&report.ts[2], 0, sizeof(struct timespec));
+    }
+
+  tstamp->ts_txvalid = 0;
+
+  if (!net_tstamp_report(tstamp->ts_flags, SOF_TIMESTAMPING_TX_SOFTWARE,
+                         SOF_TIMESTAMPING_TX_HARDWARE, &report))
+    {
+      return -EAGAIN;
+    }
+
+  net_tstamp_addcmsg(msg, space, SCM_TIMESTAMPING, &report, sizeof(report));
+  msg->msg_flags |= MSG_ERRQUEUE;
+  return 0;
+}
+
+#endif /* CONFIG_NET_TIMESTAMP */
@@ -0,0 +1,189 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <time.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/cancelpt.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives up to 'vlen' messages from a socket with the
+ *   network locked only once.  This is an internal OS interface.  It is
+ *   functionally equivalent to recvmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock   - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec  - The messages.  msg_len is set to the length of each message
+ *             received.
+ *   vlen    - The number of messages in msgvec
+ *   flags   - Receive flags.  With MSG_WAITFORONE, only the first message
+ *             is waited for.
+ *   timeout - No further messages are waited for once this time has
+ *             passed, if not NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  If an error
+ *   occurs before the first message is received, a negated errno value is
+ *   returned.
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR const struct timespec *timeout)
+{
+  clock_t start = 0;
+  clock_t ticks = 0;
+  unsigned int count;
+  ssize_t ret = OK;
+
+  if (msgvec == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (timeout != NULL)
+    {
+      if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+          timeout->tv_nsec >= NSEC_PER_SEC)
+        {
+          return -EINVAL;
+        }
+
+      start = clock_systime_ticks();
+      ticks = SEC2TICK(timeout->tv_sec) + NSEC2TICK(timeout->tv_nsec);
+    }
+
+  /* The messages that are already queued are all taken with the network
+   * locked once.  The lock is only released while waiting.
+   */
+
+  net_lock();
+  for (count = 0; count < vlen; count++)
+    {
+      ret = psock_recvmsg(psock, &msgvec[count].msg_hdr, flags);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[count].msg_len = ret;
+
+      /* Don't wait for the next message if it is only the first one that
+       * is waited for or if the time is up.
+       */
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      if (timeout != NULL && clock_systime_ticks() - start >= ticks)
+        {
+          count++;
+          break;
+        }
+    }
+
+  net_unlock();
+
+  /* An error after the first message ends the batch.  A persistent error is
+   * then reported by the next call.
+   */
+
+  return count > 0 ? (int)count : (int)ret;
+}
+
+/****************************************************************************
+ * Name: recvmmsg
+ *
+ * Description:
+ *   recvmmsg() receives up to 'vlen' messages from a socket with one call,
+ *   each like recvmsg().
+ *
+ * Input Parameters:
+ *   sockfd  - Socket descriptor of socket
+ *   msgvec  - The messages
+ *   vlen    - The number of messages in msgvec
+ *   flags   - Receive flags
+ *   timeout - No further messages are waited for once this time has
+ *             passed, if not NULL
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  On  error,
+ *   -1 is returned, and errno is set appropriately (see recvmsg()).
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* Let psock_recvmmsg() do all of the work */
+
+  ret = psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+  if (ret < 0)
+    {
+      _SO_SETERRNO(psock, -ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
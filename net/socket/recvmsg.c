@@ -0,0 +1,176 @@
+/****************************************************************************
+ * net/socket/recvmsg.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmsg
+ *
+ * Description:
+ *   psock_recvmsg() receives a message from a socket together with its
+ *   ancillary data.  This is an internal OS interface.  It is functionally
+ *   equivalent to recvmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ *   Only a single I/O vector is supported.
+ *
+ * Input Parameters:
+ *   psock - A pointer to a NuttX-specific, internal socket structure
+ *   msg   - The message header with the buffer and, optionally, the source
+ *           address and control data buffers
+ *   flags - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received and updates
+ *   msg_namelen, msg_controllen and msg_flags.  On any failure, a negated
+ *   errno value is returned (see comments with recvfrom() for a list of
+ *   appropriate errno values).
+ *
+ ****************************************************************************/
+
+ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                      int flags)
+{
+  socklen_t fromlen;
+  ssize_t ret;
+
+  /* Verify that non-NULL pointers were passed */
+
+  if (msg == NULL || msg->msg_iov == NULL)
+    {
+      return -EINVAL;
+    }
+
+  if (msg->msg_iovlen != 1)
+    {
+      return -ENOTSUP;
+    }
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (psock == NULL || psock->s_crefs <= 0)
+    {
+      return -EBADF;
+    }
+
+  DEBUGASSERT(psock->s_sockif != NULL);
+  msg->msg_flags = 0;
+
+#ifdef CONFIG_NET_TIMESTAMP
+  /* Let logic specific to this address family handle the recvmsg()
+   * operation if it provides ancillary data.
+   */
+
+  if (psock->s_sockif->si_recvmsg != NULL)
+    {
+      return psock->s_sockif->si_recvmsg(psock, msg, flags);
+    }
+#endif
+
+  /* Otherwise, there is no ancillary data and no error queue */
+
+  msg->msg_controllen = 0;
+  if ((flags & MSG_ERRQUEUE) != 0)
+    {
+      return -EAGAIN;
+    }
+
+  fromlen = msg->msg_namelen;
+  ret = psock_recvfrom(psock, msg->msg_iov->iov_base,
+                       msg->msg_iov->iov_len, flags, msg->msg_name,
+                       msg->msg_name != NULL ? &fromlen : NULL);
+  if (ret >= 0)
+    {
+      msg->msg_namelen = fromlen;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: recvmsg
+ *
+ * Description:
+ *   recvmsg() receives a message from a socket like recvfrom(), but the
+ *   buffer, the source address and the ancillary data are described by a
+ *   message header.
+ *
+ * Input Parameters:
+ *   sockfd - Socket descriptor of socket
+ *   msg    - The message header
+ *   flags  - Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On  error,
+ *   -1 is returned, and errno is set appropriately (see recvfrom()).
+ *
+ ****************************************************************************/
+
+ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags)
+{
+  FAR struct socket *psock;
+  ssize_t ret;
+
+  /* recvmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* Let psock_recvmsg() do all of the work */
+
+  ret = psock_recvmsg(psock, msg, flags);
+  if (ret < 0)
+    {
+      _SO_SETERRNO(psock, -ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
@@ -0,0 +1,169 @@
+/****************************************************************************
+ * net/socket/sendmmsg.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_sendmmsg
+ *
+ * Description:
+ *   psock_sendmmsg() sends up to 'vlen' messages on a socket with the
+ *   network locked only once, so that the network device is polled for
+ *   all of them together.  This is an internal OS interface.  It is
+ *   functionally equivalent to sendmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - I accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ *   Only a single I/O vector per message is supported.
+ *
+ * Input Parameters:
+ *   psock  - A pointer to a NuttX-specific, internal socket structure
+ *   msgvec - The messages.  msg_len is set to the length of each message
+ *            sent.
+ *   vlen   - The number of messages in msgvec
+ *   flags  - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent.  If an error occurs
+ *   before the first message is sent, a negated errno value is returned.
+ *
+ ****************************************************************************/
+
+int psock_sendmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags)
+{
+  FAR struct msghdr *msg;
+  unsigned int count;
+  ssize_t ret = OK;
+
+  if (msgvec == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* With the network locked, the device is not polled until all of the
+   * messages are queued (unless a send has to wait).
+   */
+
+  net_lock();
+  for (count = 0; count < vlen; count++)
+    {
+      msg = &msgvec[count].msg_hdr;
+      if (msg->msg_iov == NULL)
+        {
+          ret = -EINVAL;
+          break;
+        }
+
+      if (msg->msg_iovlen != 1)
+        {
+          ret = -ENOTSUP;
+          break;
+        }
+
+      ret = psock_sendto(psock, msg->msg_iov->iov_base,
+                         msg->msg_iov->iov_len, flags, msg->msg_name,
+                         msg->msg_namelen);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[count].msg_len = ret;
+    }
+
+  net_unlock();
+
+  /* An error after the first message ends the batch.  A persistent error is
+   * then reported by the next call.
+   */
+
+  return count > 0 ? (int)count : (int)ret;
+}
+
+/****************************************************************************
+ * Name: sendmmsg
+ *
+ * Description:
+ *   sendmmsg() sends up to 'vlen' messages on a socket with one call, each
+ *   like sendmsg().
+ *
+ * Input Parameters:
+ *   sockfd - Socket descriptor of socket
+ *   msgvec - The messages
+ *   vlen   - The number of messages in msgvec
+ *   flags  - Send flags
+ *
+ * Returned Value:
+ *   On success, returns the number of messages sent.  On  error, -1 is
+ *   returned, and errno is set appropriately (see sendto()).
+ *
+ ****************************************************************************/
+
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags)
+{
+  FAR struct socket *psock;
+  int ret;
+
+  /* sendmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  psock = sockfd_socket(sockfd);
+
+  /* Let psock_sendmmsg() do all of the work */
+
+  ret = psock_sendmmsg(psock, msgvec, vlen, flags);
+  if (ret < 0)
+    {
+      _SO_SETERRNO(psock, -ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
@@ -55,6 +55,7 @@
 #include "inet/inet.h"
 #include "tcp/tcp.h"
 #include "udp/udp.h"
+#include "pkt/pkt.h"
 #include "usrsock/usrsock.h"
 #include "utils/utils.h"
 
@@ -276,11 +277,140 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
         }
         break;
 #endif
+
+#if (defined(CONFIG_NET_TCP) && !defined(CONFIG_NET_TCP_NO_STACK)) || \
+    (defined(CONFIG_NET_UDP) && !defined(CONFIG_NET_UDP_NO_STACK))
+      case SO_RCVBUF:     /* Sets receive buffer size */
+        {
+          int buffersize;
+
+          /* The receive buffer size is only supported for TCP and UDP
+           * sockets
+           */
+
+          if (psock->s_domain != PF_INET && psock->s_domain != PF_INET6)
+            {
+              return -ENOPROTOOPT;
+            }
+
+          /* Verify that option is the size of an 'int'.  Should also check
+           * that 'value' is properly aligned for an 'int'
+           */
+
+          if (value_len != sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+          buffersize = *(FAR int *)value;
+          if (buffersize < 0)
+            {
+              return -EINVAL;
+            }
+
+          net_lock();
+#if defined(CONFIG_NET_TCP) && !defined(CONFIG_NET_TCP_NO_STACK)
+          if (psock->s_type == SOCK_STREAM)
+            {
+              FAR struct tcp_conn_s *conn;
+
+              /* The new budget limits the receive window advertised next.
+               * The window scale was fixed when the connection was
+               * established.
+               */
+
+              conn = (FAR struct tcp_conn_s *)psock->s_conn;
+              conn->rcv_bufs = (uint32_t)buffersize;
+            }
+          else
+#endif
+#if defined(CONFIG_NET_UDP) && !defined(CONFIG_NET_UDP_NO_STACK)
+          if (psock->s_type == SOCK_DGRAM)
+            {
+              FAR struct udp_conn_s *conn;
+
+              /* The datagrams already read ahead are kept */
+
+              conn = (FAR struct udp_conn_s *)psock->s_conn;
+              conn->rcv_bufs = (uint32_t)buffersize;
+            }
+          else
+#endif
+            {
+              net_unlock();
+              return -ENOPROTOOPT;
+            }
+
+          net_unlock();
+        }
+        break;
+#endif
+
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+      case SO_SNDBUF:     /* Sets send buffer size */
+        {
+          FAR struct tcp_conn_s *conn;
+          int buffersize;
+
+          /* The send buffer size is only supported for buffered TCP
+           * sockets
+           */
+
+          if ((psock->s_domain != PF_INET && psock->s_domain != PF_INET6) ||
+              psock->s_type != SOCK_STREAM)
+            {
+              return -ENOPROTOOPT;
+            }
+
+          if (value_len != sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+          buffersize = *(FAR int *)value;
+          if (buffersize < 0)
+            {
+              return -EINVAL;
+            }
+
+          /* Senders waiting for the old budget check the new one */
+
+          net_lock();
+          conn = (FAR struct tcp_conn_s *)psock->s_conn;
+          conn->snd_bufs = (uint32_t)buffersize;
+          tcp_sndbuf_notify(conn);
+          net_unlock();
+        }
+        break;
+#endif
+
+#ifdef CONFIG_NET_TIMESTAMP
+      case SO_TIMESTAMP:    /* Return receive times as ancillary data */
+      case SO_TIMESTAMPING: /* Select software and hardware timestamps */
+        return net_tstamp_setsockopt(psock, option, value, value_len);
+#endif
+
+#ifdef CONFIG_NET_PKT_FILTER
+      case SO_ATTACH_FILTER: /* Attach a socket filter */
+      case SO_DETACH_FILTER: /* Remove the socket filter */
+        if (psock->s_domain != PF_PACKET)
+          {
+            return -ENOPROTOOPT;
+          }
+
+        return pkt_filter_setsockopt(psock, option, value, value_len);
+#endif
+
       /* The following are not yet implemented */
 
+#if (!defined(CONFIG_NET_TCP) || defined(CONFIG_NET_TCP_NO_STACK)) && \
+    (!defined(CONFIG_NET_UDP) || defined(CONFIG_NET_UDP_NO_STACK))
       case SO_RCVBUF:     /* Sets receive buffer size */
+#endif
       case SO_RCVLOWAT:   /* Sets the minimum number of bytes to input */
+#ifndef CONFIG_NET_TCP_WRITE_BUFFERS
       case SO_SNDBUF:     /* Sets send buffer size */
+#endif
       case SO_SNDLOWAT:   /* Sets the minimum number of bytes to output */
 
       /* There options are only valid when used with getopt */
@@ -396,6 +526,12 @@ int psock_setsockopt(FAR struct socket *psock, int level, int option,
         break;
 #endif
 
+#ifdef CONFIG_NET_PKT_RXRING
+      case SOL_PACKET: /* Packet options (see include/netpacket/packet.h) */
+        ret = pkt_setsockopt(psock, option, value, value_len);
+        break;
+#endif
+
       default:         /* The provided level is invalid */
         ret = -EINVAL;
         break;
@@ -77,10 +77,14 @@
 #define _SO_SNDLOWAT     _SO_BIT(SO_SNDLOWAT)
 #define _SO_SNDTIMEO     _SO_BIT(SO_SNDTIMEO)
 #define _SO_TYPE         _SO_BIT(SO_TYPE)
+#define _SO_TIMESTAMP    _SO_BIT(SO_TIMESTAMP)
+#define _SO_TIMESTAMPING _SO_BIT(SO_TIMESTAMPING)
+#define _SO_ATTACH_FILTER _SO_BIT(SO_ATTACH_FILTER)
+#define _SO_DETACH_FILTER _SO_BIT(SO_DETACH_FILTER)
 
 /* This is the largest option value.  REVISIT: belongs in sys/socket.h */
 
-#define _SO_MAXOPT       (15)
+#define _SO_MAXOPT       (19)
 
 /* Macros to set, test, clear options */
 
@@ -230,5 +234,96 @@ net_sockif(sa_family_t family, int type, int protocol);
 int net_timeo(clock_t start_time, socktimeo_t timeo);
 #endif
 
+/****************************************************************************
+ * Name: psock_tstamp
+ *
+ * Description:
+ *   Return the timestamping state of a UDP or packet socket.
+ *
+ * Input Parameters:
+ *   psock - The socket
+ *
+ * Returned Value:
+ *   The timestamping state or NULL if the socket does not support
+ *   timestamps.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMP
+struct net_tstamp_s;
+FAR struct net_tstamp_s *psock_tstamp(FAR struct socket *psock);
+#endif
+
+/****************************************************************************
+ * Name: net_tstamp_setsockopt and net_tstamp_getsockopt
+ *
+ * Description:
+ *   Set or get the SO_TIMESTAMP or SO_TIMESTAMPING socket option.
+ *
+ * Input Parameters:
+ *   psock     - The socket
+ *   option    - SO_TIMESTAMP or SO_TIMESTAMPING
+ *   value     - The integer value
+ *   value_len - The length of the value
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMP
+int net_tstamp_setsockopt(FAR struct socket *psock, int option,
+                          FAR const void *value, socklen_t value_len);
+int net_tstamp_getsockopt(FAR struct socket *psock, int option,
+                          FAR void *value, FAR socklen_t *value_len);
+#endif
+
+/****************************************************************************
+ * Name: net_tstamp_recvcmsg
+ *
+ * Description:
+ *   Return the receive timestamps of a datagram as the control data of a
+ *   message, as selected by SO_TIMESTAMP and SO_TIMESTAMPING.
+ *
+ * Input Parameters:
+ *   tstamp - The timestamping state of the socket
+ *   ts     - The receive timestamps of the datagram (ts[0] software,
+ *            ts[2] hardware)
+ *   msg    - The message header.  msg_controllen is updated with the
+ *            length of the control data returned.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMP
+void net_tstamp_recvcmsg(FAR struct net_tstamp_s *tstamp,
+                         FAR const struct scm_timestamping *ts,
+                         FAR struct msghdr *msg);
+#endif
+
+/****************************************************************************
+ * Name: net_tstamp_errqueue
+ *
+ * Description:
+ *   Return the pending transmit timestamps of a socket as the control data
+ *   of a message, as for recvmsg(MSG_ERRQUEUE).  The timestamps are
+ *   consumed.
+ *
+ * Input Parameters:
+ *   tstamp - The timestamping state of the socket
+ *   msg    - The message header
+ *
+ * Returned Value:
+ *   Zero (no data bytes) on success; -EAGAIN if no timestamp is pending.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMP
+ssize_t net_tstamp_errqueue(FAR struct net_tstamp_s *tstamp,
+                            FAR struct msghdr *msg);
+#endif
+
 #endif /* CONFIG_NET */
 #endif /* _NET_SOCKET_SOCKET_H */
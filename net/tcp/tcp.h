@@ -48,6 +48,7 @@
 #include <nuttx/clock.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/ip.h>
+#include <nuttx/semaphore.h>
 
 #ifdef CONFIG_NET_TCP_NOTIFIER
 #  include <nuttx/wqueue.h>
@@ -100,6 +101,54 @@
 #  endif
 #endif
 
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+/* The number of duplicate ACKs that trigger a fast retransmission */
+
+#  define TCP_FAST_REXMIT_THRESH     3
+
+/* Sequence number comparisons that allow for the wrap-around */
+
+#  define TCP_SEQ_LT(a,b)            ((int32_t)((a) - (b)) < 0)
+#  define TCP_SEQ_LTE(a,b)           ((int32_t)((a) - (b)) <= 0)
+#  define TCP_SEQ_GT(a,b)            ((int32_t)((a) - (b)) > 0)
+#  define TCP_SEQ_GTE(a,b)           ((int32_t)((a) - (b)) >= 0)
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+/* The maximum number of blocks in a SACK option (40 bytes of options) */
+
+#  define TCP_SACK_MAXBLOCKS         4
+#endif
+
+/* The default receive buffer size of a connection (zero: no limit) */
+
+#ifndef CONFIG_NET_TCP_RECV_BUFSIZE
+#  define CONFIG_NET_TCP_RECV_BUFSIZE 0
+#endif
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+/* The largest window scale shift permitted by RFC 7323 */
+
+#  define TCP_WS_MAXSHIFT            14
+#endif
+
+#ifdef CONFIG_NET_TCP_CC
+/* The maximum length of the name of a congestion control algorithm */
+
+#  define TCP_CC_NAME_MAX            16
+
+/* The congestion window must allow for another full-sized segment in
+ * flight.  One segment may always be sent if nothing is in flight.
+ */
+
+#  define TCP_CC_CANSEND(conn) \
+     ((conn)->tx_unacked == 0 || \
+      (conn)->tx_unacked + (conn)->mss <= (conn)->cwnd)
+#  define TCP_CC_AVAIL(conn) \
+     ((conn)->cwnd > (conn)->tx_unacked ? \
+      (conn)->cwnd - (conn)->tx_unacked : 0)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
@@ -122,6 +171,7 @@ struct net_driver_s;      /* Forward reference */
 struct devif_callback_s;  /* Forward reference */
 struct tcp_backlog_s;     /* Forward reference */
 struct tcp_hdr_s;         /* Forward reference */
+struct tcp_conn_s;        /* Forward reference */
 
 /* This is a container that holds the poll-related information */
 
@@ -135,6 +185,55 @@ struct tcp_poll_s
 #endif
 };
 
+#ifdef CONFIG_NET_TCP_CC
+/* A TCP congestion control algorithm.  Slow start is the same for all
+ * algorithms, so on_ack() is only called in congestion avoidance.
+ */
+
+struct tcp_cc_ops_s
+{
+  FAR const char *name;            /* Name used with TCP_CONGESTION */
+
+  /* Reset the private state of the algorithm */
+
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+
+  /* Grow cwnd after 'acked' bytes were newly ACKed */
+
+  CODE void (*on_ack)(FAR struct tcp_conn_s *conn, uint32_t acked);
+
+  /* Reduce ssthresh and cwnd after a loss that was detected by a
+   * retransmission timeout or by duplicate ACKs.
+   */
+
+  CODE void (*on_loss)(FAR struct tcp_conn_s *conn, bool timeout);
+};
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+/* The state of the CUBIC algorithm (RFC 8312) */
+
+struct tcp_cubic_s
+{
+  uint32_t wmax;                   /* cwnd before the last reduction */
+  uint32_t origin;                 /* cwnd at the plateau of the curve */
+  uint32_t k;                      /* Time from the epoch to the plateau
+                                    * (milliseconds) */
+  clock_t  epoch;                  /* Start of congestion avoidance */
+  bool     inepoch;                /* True: epoch is valid */
+};
+#endif
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+/* A block of data that was selectively acknowledged by the peer */
+
+struct tcp_sack_s
+{
+  uint32_t left;                   /* First sequence number of the block */
+  uint32_t right;                  /* Sequence number following the block */
+};
+#endif
+
 struct tcp_conn_s
 {
   /* Common prologue of all connection structures. */
@@ -169,6 +268,10 @@ struct tcp_conn_s
 
   /* TCP-specific content follows */
 
+#ifdef CONFIG_NET_TCP_HASH
+  dq_entry_t hnode;       /* Link in the hash table of active connections */
+  dq_entry_t pnode;       /* Link in the hash table of local ports */
+#endif
   union ip_binding_u u;   /* IP address binding */
   uint8_t  rcvseq[4];     /* The sequence number that we expect to
                            * receive next */
@@ -189,12 +292,17 @@ struct tcp_conn_s
 #ifdef CONFIG_NET_TCP_DELAYED_ACK
   uint8_t  rx_unackseg;   /* Number of un-ACKed received segments */
   uint8_t  rx_acktimer;   /* Time since last ACK sent (units: half-seconds) */
+  bool     quickack;      /* True: Do not delay ACKs (TCP_QUICKACK) */
 #endif
   uint16_t lport;         /* The local TCP port, in network byte order */
   uint16_t rport;         /* The remoteTCP port, in network byte order */
   uint16_t mss;           /* Current maximum segment size for the
                            * connection */
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  uint32_t winsize;       /* Current window size of the connection */
+#else
   uint16_t winsize;       /* Current window size of the connection */
+#endif
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   uint32_t tx_unacked;    /* Number bytes sent but not yet ACKed */
 #else
@@ -216,6 +324,23 @@ struct tcp_conn_s
 
   struct iob_queue_s readahead;   /* Read-ahead buffering */
 
+  /* Receive window
+   *
+   *   rcv_bufs  - The receive buffer size (SO_RCVBUF) in bytes.  The read-
+   *               ahead I/O buffers of the connection and the advertised
+   *               window are limited to this budget.  Zero means no limit.
+   *   wscale    - True if both ends sent the window scale option.
+   *   snd_scale - The shift applied to the window received from the peer.
+   *   rcv_scale - The shift applied to the window sent to the peer.
+   */
+
+  uint32_t   rcv_bufs;    /* Receive buffer size (bytes) */
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  bool       wscale;      /* True: Window scaling is in use */
+  uint8_t    snd_scale;   /* Send window scale shift */
+  uint8_t    rcv_scale;   /* Receive window scale shift */
+#endif
+
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   /* Write buffering
    *
@@ -223,10 +348,16 @@ struct tcp_conn_s
    *               list may be partially sent.  FIFO ordering.
    *   unacked_q - A queue of completely sent, but unacked I/O buffer
    *               chains.  Sequence number ordering.
+   *   snd_bufs  - The send buffer size (SO_SNDBUF) in bytes.  Sends wait
+   *               while the queued data exceeds this budget.  Zero means
+   *               no limit.
+   *   snd_sem   - Posted when queued data was ACKed or freed.
    */
 
   sq_queue_t write_q;     /* Write buffering for segments */
   sq_queue_t unacked_q;   /* Write buffering for un-ACKed segments */
+  uint32_t   snd_bufs;    /* Send buffer size (bytes) */
+  sem_t      snd_sem;     /* Waits for room in the send buffer */
   uint16_t   expired;     /* Number segments retransmitted but not yet ACKed,
                            * it can only be updated at TCP_ESTABLISHED state */
   uint32_t   sent;        /* The number of bytes sent (ACKed and un-ACKed) */
@@ -235,6 +366,61 @@ struct tcp_conn_s
                            * segment (next greater sndseq) */
 #endif
 
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+  /* Fast retransmit and recovery
+   *
+   *   dupacks    - The number of duplicate ACKs received in a row.
+   *   recovery   - True while recovering from a fast retransmission.
+   *   recover    - sndseq_max when fast recovery was entered.  Recovery
+   *                ends when all of the data up to this point is ACKed.
+   *   rexmitseq  - The start of the data to retransmit on the next send.
+   *   rexmitlen  - The length of that data, zero if there is none.
+   *   rexmitnext - The end of the data retransmitted so far.
+   */
+
+  uint8_t    dupacks;     /* Number of duplicate ACKs received */
+  bool       recovery;    /* True: In fast recovery */
+  uint16_t   rexmitlen;   /* Length of the data to fast retransmit */
+  uint32_t   recover;     /* sndseq_max when fast recovery was entered */
+  uint32_t   rexmitseq;   /* Start of the data to fast retransmit */
+  uint32_t   rexmitnext;  /* End of the data fast retransmitted so far */
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* Selective acknowledgment
+   *
+   *   sackperm - True if both ends permitted SACK when connecting.
+   *   sacks    - The SACK blocks of the last ACK above the ACK number, in
+   *              ascending order.
+   */
+
+  bool       sackperm;    /* True: SACK is permitted */
+  uint8_t    nsacks;      /* Number of valid SACK blocks */
+  struct tcp_sack_s sacks[TCP_SACK_MAXBLOCKS];
+#endif
+
+#ifdef CONFIG_NET_TCP_CC
+  /* Congestion control
+   *
+   *   cc       - The congestion control algorithm.  NULL selects the
+   *              default algorithm when the connection is established.
+   *   cwnd     - The congestion window: The number of bytes that may be
+   *              in flight (tx_unacked).
+   *   ssthresh - The slow start threshold.
+   *   ccstate  - The private state of the algorithm.
+   */
+
+  FAR const struct tcp_cc_ops_s *cc;
+  uint32_t   cwnd;        /* Congestion window (bytes) */
+  uint32_t   ssthresh;    /* Slow start threshold (bytes) */
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  union
+  {
+    struct tcp_cubic_s cubic;
+  } ccstate;
+#endif
+#endif
+
 #ifdef CONFIG_NET_TCPBACKLOG
   /* Listen backlog support
    *
@@ -346,6 +532,15 @@ extern "C"
 
 EXTERN struct net_driver_s *g_netdevices;
 
+#ifdef CONFIG_NET_TCP_CC
+/* The congestion control algorithms */
+
+EXTERN const struct tcp_cc_ops_s g_tcp_cc_newreno;
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+EXTERN const struct tcp_cc_ops_s g_tcp_cc_cubic;
+#endif
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -773,6 +968,57 @@ void tcp_initsequence(FAR uint8_t *seqno);
 
 void tcp_nextsequence(void);
 
+/****************************************************************************
+ * Name: tcp_syncookie
+ *
+ * Description:
+ *   Return the SYN cookie to be used as initial sequence number in the
+ *   SYNACK response to an incoming SYN.  The cookie encodes the MSS of the
+ *   connection.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure containing the received SYN
+ *   tcp - The TCP header of the SYN
+ *   mss - The MSS negotiated for the connection
+ *
+ * Returned Value:
+ *   The cookie
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+uint32_t tcp_syncookie(FAR struct net_driver_s *dev,
+                       FAR struct tcp_hdr_s *tcp, uint16_t mss);
+#endif
+
+/****************************************************************************
+ * Name: tcp_syncookie_check
+ *
+ * Description:
+ *   Check whether an incoming ACK acknowledges the SYNACK of a valid SYN
+ *   cookie and return the MSS encoded in the cookie.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure containing the received ACK
+ *   tcp - The TCP header of the ACK
+ *   mss - The location to return the MSS of the connection
+ *
+ * Returned Value:
+ *   Zero (OK) if the cookie is valid; -EINVAL otherwise.
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+int tcp_syncookie_check(FAR struct net_driver_s *dev,
+                        FAR struct tcp_hdr_s *tcp, FAR uint16_t *mss);
+#endif
+
 /****************************************************************************
  * Name: tcp_poll
  *
@@ -992,6 +1238,32 @@ void tcp_reset(FAR struct net_driver_s *dev);
 void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
                 uint8_t ack);
 
+/****************************************************************************
+ * Name: tcp_synack_cookie
+ *
+ * Description:
+ *   Answer an incoming SYN with a SYNACK that carries a SYN cookie without
+ *   allocating a connection structure.  The SYNACK is built in place of
+ *   the SYN.
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure containing the received SYN
+ *   cookie - The SYN cookie to be used as initial sequence number
+ *   mss    - The MSS encoded in the cookie
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from network stack logic with the network stack locked
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+void tcp_synack_cookie(FAR struct net_driver_s *dev, uint32_t cookie,
+                       uint16_t mss);
+#endif
+
 /****************************************************************************
  * Name: tcp_appsend
  *
@@ -1107,6 +1379,7 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *   receive the data.
  *
  * Input Parameters:
+ *   dev - The device which as active when the event was detected.
  *   conn - A pointer to the TCP connection structure
  *   buffer - A pointer to the buffer to be copied to the read-ahead
  *     buffers
@@ -1123,7 +1396,8 @@ uint16_t tcp_callback(FAR struct net_driver_s *dev,
  *
  ****************************************************************************/
 
-uint16_t tcp_datahandler(FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
+uint16_t tcp_datahandler(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn, FAR uint8_t *buffer,
                          uint16_t nbytes);
 
 /****************************************************************************
@@ -1423,21 +1697,122 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
                    FAR void *value, FAR socklen_t *value_len);
 #endif
 
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Initialize the congestion control of a connection that has just been
+ *   established:  Select the default algorithm if none was selected with
+ *   TCP_CONGESTION and set the initial window (RFC 6928).
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_init(FAR struct tcp_conn_s *conn);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name, as
+ *   for the TCP_CONGESTION socket option.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *   name - The name of the algorithm, not necessarily NUL terminated
+ *   len  - The maximum length of the name
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if there is no such algorithm.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name,
+                  size_t len);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Grow the congestion window after data was newly ACKed:  In slow start
+ *   by up to one segment per ACK, in congestion avoidance as determined by
+ *   the algorithm.  The window does not grow if it did not limit the
+ *   sender.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection
+ *   acked - The number of bytes that were newly ACKed
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t acked);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_loss
+ *
+ * Description:
+ *   Reduce the congestion window after a loss.
+ *
+ * Input Parameters:
+ *   conn    - The TCP connection
+ *   timeout - True if the loss was detected by the retransmission timeout,
+ *             false if it was detected by duplicate ACKs.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC
+void tcp_cc_loss(FAR struct tcp_conn_s *conn, bool timeout);
+#endif
+
 /****************************************************************************
  * Name: tcp_get_recvwindow
  *
  * Description:
- *   Calculate the TCP receive window for the specified device.
+ *   Calculate the TCP receive window for the specified device and
+ *   connection.
  *
  * Input Parameters:
- *   dev - The device whose TCP receive window will be updated.
+ *   dev  - The device whose TCP receive window will be updated.
+ *   conn - The TCP connection that advertises the window.
  *
  * Returned Value:
- *   The value of the TCP receive window to use.
+ *   The value of the window field of the TCP header, scaled by the receive
+ *   window scale of the connection.
  *
  ****************************************************************************/
 
-uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev);
+uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
+                            FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_get_rcvscale
+ *
+ * Description:
+ *   Get the receive window scale shift to offer in the window scale option
+ *   of a SYN or SYNACK:  The smallest shift for which the largest receive
+ *   window that the connection may advertise fits into 16 bits.
+ *
+ * Input Parameters:
+ *   dev  - The device used by the connection.
+ *   conn - The TCP connection.
+ *
+ * Returned Value:
+ *   The window scale shift (0-14).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+uint8_t tcp_get_rcvscale(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn);
+#endif
 
 /****************************************************************************
  * Name: psock_tcp_cansend
@@ -1465,6 +1840,28 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev);
 
 int psock_tcp_cansend(FAR struct socket *psock);
 
+/****************************************************************************
+ * Name: tcp_sndbuf_notify
+ *
+ * Description:
+ *   Wake up the senders that wait for room in the send buffer of the
+ *   connection (SO_SNDBUF).  They check the budget again when they run.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection.
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+void tcp_sndbuf_notify(FAR struct tcp_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Name: tcp_wrbuffer_initialize
  *
@@ -114,10 +114,11 @@ void tcp_appsend(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
        *    differently; they delay the ACKs for many more segments (6 or
        *    more).  Delaying for more segments would provide less network
        *    traffic and better performance but seems non-compliant.
+       * 4. Sockets with the TCP_QUICKACK option never delay the ACK.
        */
 
       if (conn->rx_unackseg > 0 || dev->d_sndlen > 0 ||
-          result != TCP_SNDACK)
+          result != TCP_SNDACK || conn->quickack)
         {
           /* Reset the delayed ACK state and send the ACK with this packet. */
 
@@ -215,7 +216,9 @@ void tcp_appsend(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
   else
     {
-#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+#if defined(CONFIG_NETDEV_TSO)
+      DEBUGASSERT(dev->d_sndlen <= conn->mss || dev->d_txmss == conn->mss);
+#elif defined(CONFIG_NET_TCP_WRITE_BUFFERS)
       DEBUGASSERT(dev->d_sndlen <= conn->mss);
 #else
       /* If d_sndlen > 0, the application has data to be sent. */
@@ -0,0 +1,282 @@
+/****************************************************************************
+ * net/tcp/tcp_cc.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/net/netconfig.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void newreno_init(FAR struct tcp_conn_s *conn);
+static void newreno_on_ack(FAR struct tcp_conn_s *conn, uint32_t acked);
+static void newreno_on_loss(FAR struct tcp_conn_s *conn, bool timeout);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_newreno =
+{
+  "reno",
+  newreno_init,
+  newreno_on_ack,
+  newreno_on_loss
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The congestion control algorithms that may be selected by name */
+
+static FAR const struct tcp_cc_ops_s * const g_tcp_cc_algorithms[] =
+{
+  &g_tcp_cc_newreno,
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  &g_tcp_cc_cubic,
+#endif
+};
+
+#define TCP_CC_NALGORITHMS \
+  (sizeof(g_tcp_cc_algorithms) / sizeof(g_tcp_cc_algorithms[0]))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: newreno_init
+ *
+ * Description:
+ *   NewReno has no private state.
+ *
+ ****************************************************************************/
+
+static void newreno_init(FAR struct tcp_conn_s *conn)
+{
+}
+
+/****************************************************************************
+ * Name: newreno_on_ack
+ *
+ * Description:
+ *   Congestion avoidance (RFC 5681):  Grow cwnd by about one segment per
+ *   round trip.
+ *
+ ****************************************************************************/
+
+static void newreno_on_ack(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  uint32_t incr = (uint32_t)conn->mss * conn->mss / conn->cwnd;
+
+  conn->cwnd += incr > 0 ? incr : 1;
+}
+
+/****************************************************************************
+ * Name: newreno_on_loss
+ *
+ * Description:
+ *   Halve the amount of data in flight (RFC 5681).  After a timeout, start
+ *   over in slow start with one segment.
+ *
+ ****************************************************************************/
+
+static void newreno_on_loss(FAR struct tcp_conn_s *conn, bool timeout)
+{
+  conn->ssthresh = conn->tx_unacked / 2;
+  if (conn->ssthresh < 2 * (uint32_t)conn->mss)
+    {
+      conn->ssthresh = 2 * (uint32_t)conn->mss;
+    }
+
+  conn->cwnd = timeout ? conn->mss : conn->ssthresh;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cc_init
+ *
+ * Description:
+ *   Initialize the congestion control of a connection that has just been
+ *   established:  Select the default algorithm if none was selected with
+ *   TCP_CONGESTION and set the initial window (RFC 6928).
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *
+ ****************************************************************************/
+
+void tcp_cc_init(FAR struct tcp_conn_s *conn)
+{
+  uint32_t iw;
+
+  if (conn->cc == NULL)
+    {
+#ifdef CONFIG_NET_TCP_CC_DEFAULT_CUBIC
+      conn->cc = &g_tcp_cc_cubic;
+#else
+      conn->cc = &g_tcp_cc_newreno;
+#endif
+    }
+
+  /* IW = min(10 * MSS, max(2 * MSS, 14600)) */
+
+  iw = 14600;
+  if (iw > 10 * (uint32_t)conn->mss)
+    {
+      iw = 10 * (uint32_t)conn->mss;
+    }
+  else if (iw < 2 * (uint32_t)conn->mss)
+    {
+      iw = 2 * (uint32_t)conn->mss;
+    }
+
+  conn->cwnd     = iw;
+  conn->ssthresh = UINT32_MAX;
+  conn->cc->init(conn);
+}
+
+/****************************************************************************
+ * Name: tcp_cc_select
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name, as
+ *   for the TCP_CONGESTION socket option.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection
+ *   name - The name of the algorithm, not necessarily NUL terminated
+ *   len  - The maximum length of the name
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if there is no such algorithm.
+ *
+ ****************************************************************************/
+
+int tcp_cc_select(FAR struct tcp_conn_s *conn, FAR const char *name,
+                  size_t len)
+{
+  FAR const struct tcp_cc_ops_s *cc;
+  int i;
+
+  for (i = 0; i < TCP_CC_NALGORITHMS; i++)
+    {
+      cc = g_tcp_cc_algorithms[i];
+      if (len >= strlen(cc->name) && strncmp(cc->name, name, len) == 0)
+        {
+          conn->cc = cc;
+
+          /* If the connection is already established, keep cwnd and
+           * ssthresh and only reset the state of the new algorithm.
+           */
+
+          if (conn->cwnd > 0)
+            {
+              cc->init(conn);
+            }
+
+          return OK;
+        }
+    }
+
+  nwarn("WARNING: No congestion control %.*s\n", (int)len, name);
+  return -ENOENT;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_ack
+ *
+ * Description:
+ *   Grow the congestion window after data was newly ACKed:  In slow start
+ *   by up to one segment per ACK, in congestion avoidance as determined by
+ *   the algorithm.  The window does not grow if it did not limit the
+ *   sender.
+ *
+ * Input Parameters:
+ *   conn  - The TCP connection
+ *   acked - The number of bytes that were newly ACKed
+ *
+ ****************************************************************************/
+
+void tcp_cc_ack(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  /* tx_unacked no longer includes the ACKed data.  Don't grow the window
+   * if less than half of it was in use since the sender was limited by the
+   * application or the receive window rather than by cwnd.
+   */
+
+  if (2 * (conn->tx_unacked + acked) < conn->cwnd)
+    {
+      return;
+    }
+
+  if (conn->cwnd < conn->ssthresh)
+    {
+      /* Slow start (RFC 3465 with L = 1 segment) */
+
+      conn->cwnd += acked < conn->mss ? acked : conn->mss;
+    }
+  else
+    {
+      conn->cc->on_ack(conn, acked);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_loss
+ *
+ * Description:
+ *   Reduce the congestion window after a loss.
+ *
+ * Input Parameters:
+ *   conn    - The TCP connection
+ *   timeout - True if the loss was detected by the retransmission timeout,
+ *             false if it was detected by duplicate ACKs.
+ *
+ ****************************************************************************/
+
+void tcp_cc_loss(FAR struct tcp_conn_s *conn, bool timeout)
+{
+  conn->cc->on_loss(conn, timeout);
+
+  ninfo("%s: cwnd=%u ssthresh=%u timeout=%d\n",
+        conn->cc->name, conn->cwnd, conn->ssthresh, timeout);
+}
+
+#endif /* CONFIG_NET_TCP_CC */
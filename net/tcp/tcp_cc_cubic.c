@@ -0,0 +1,263 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_cubic.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/netconfig.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The multiplicative decrease factor beta = 0.7, scaled by 1024 */
+
+#define CUBIC_BETA        717
+#define CUBIC_BETA_SCALE  1024
+
+/* K = cbrt((Wmax - cwnd) / C) with C = 0.4, the windows in segments and K
+ * in seconds.  In milliseconds:  K = cbrt((Wmax - cwnd) * 2.5e9).
+ */
+
+#define CUBIC_K_SCALE     2500000000ull
+
+/* W(t) = C * (t - K)^3 + Wmax with t in milliseconds:  C * 1e-9 = 4 / 1e10 */
+
+#define CUBIC_C_NUM       4
+#define CUBIC_C_DEN       10000000000ll
+
+/* Limit |t - K| so that its cube fits into 64 bits (about 17 minutes) */
+
+#define CUBIC_MAX_DELTA   1000000
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void cubic_init(FAR struct tcp_conn_s *conn);
+static void cubic_on_ack(FAR struct tcp_conn_s *conn, uint32_t acked);
+static void cubic_on_loss(FAR struct tcp_conn_s *conn, bool timeout);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_cubic =
+{
+  "cubic",
+  cubic_init,
+  cubic_on_ack,
+  cubic_on_loss
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: cubic_cbrt
+ *
+ * Description:
+ *   Return the integer cube root of x, rounded down.
+ *
+ ****************************************************************************/
+
+static uint32_t cubic_cbrt(uint64_t x)
+{
+  uint64_t y = 0;
+  uint64_t b;
+  int s;
+
+  for (s = 63; s >= 0; s -= 3)
+    {
+      y += y;
+      b  = 3 * y * (y + 1) + 1;
+      if ((x >> s) >= b)
+        {
+          x -= b << s;
+          y++;
+        }
+    }
+
+  return (uint32_t)y;
+}
+
+/****************************************************************************
+ * Name: cubic_init
+ *
+ * Description:
+ *   Reset the CUBIC state of a connection.
+ *
+ ****************************************************************************/
+
+static void cubic_init(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->ccstate.cubic;
+
+  cubic->wmax    = 0;
+  cubic->origin  = 0;
+  cubic->k       = 0;
+  cubic->epoch   = 0;
+  cubic->inepoch = false;
+}
+
+/****************************************************************************
+ * Name: cubic_on_ack
+ *
+ * Description:
+ *   Congestion avoidance:  Move cwnd towards the cubic function of the time
+ *   since the start of the epoch, but at least as fast as a standard TCP
+ *   would (the TCP-friendly region).
+ *
+ ****************************************************************************/
+
+static void cubic_on_ack(FAR struct tcp_conn_s *conn, uint32_t acked)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->ccstate.cubic;
+  uint32_t mss = conn->mss;
+  uint32_t cwnd = conn->cwnd;
+  uint32_t incr = 0;
+  uint32_t friendly;
+  uint64_t target;
+  int64_t offset;
+  int64_t delta;
+
+  if (!cubic->inepoch)
+    {
+      /* Start a new epoch at the first ACK of congestion avoidance */
+
+      cubic->inepoch = true;
+      cubic->epoch   = clock_systime_ticks();
+
+      if (cwnd < cubic->wmax)
+        {
+          cubic->k      = cubic_cbrt((uint64_t)(cubic->wmax - cwnd) / mss *
+                                     CUBIC_K_SCALE);
+          cubic->origin = cubic->wmax;
+        }
+      else
+        {
+          cubic->k      = 0;
+          cubic->origin = cwnd;
+        }
+    }
+
+  /* delta = t - K in milliseconds */
+
+  delta = (int64_t)TICK2MSEC(clock_systime_ticks() - cubic->epoch) -
+          cubic->k;
+  if (delta > CUBIC_MAX_DELTA)
+    {
+      delta = CUBIC_MAX_DELTA;
+    }
+  else if (delta < -CUBIC_MAX_DELTA)
+    {
+      delta = -CUBIC_MAX_DELTA;
+    }
+
+  /* target = W(t) in bytes, limited to 1.5 * cwnd per round trip */
+
+  offset = CUBIC_C_NUM * delta * delta * delta / CUBIC_C_DEN * (int64_t)mss;
+  if (offset < 0 && (uint64_t)-offset >= cubic->origin)
+    {
+      target = 0;
+    }
+  else
+    {
+      target = cubic->origin + offset;
+    }
+
+  if (target > cwnd + cwnd / 2)
+    {
+      target = cwnd + cwnd / 2;
+    }
+
+  if (target > cwnd)
+    {
+      incr = (uint32_t)((target - cwnd) * acked / cwnd);
+    }
+
+  /* A standard TCP with the same beta grows by about
+   * 3 * (1 - beta) / (1 + beta) = 0.53 segments per round trip.
+   */
+
+  friendly = (uint32_t)((uint64_t)mss * acked / cwnd * 53 / 100);
+  if (friendly > incr)
+    {
+      incr = friendly;
+    }
+
+  conn->cwnd += incr > 0 ? incr : 1;
+}
+
+/****************************************************************************
+ * Name: cubic_on_loss
+ *
+ * Description:
+ *   Reduce cwnd by beta and remember the window at which the loss occurred
+ *   as the plateau of the next epoch.
+ *
+ ****************************************************************************/
+
+static void cubic_on_loss(FAR struct tcp_conn_s *conn, bool timeout)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->ccstate.cubic;
+  uint32_t mss = conn->mss;
+  uint32_t cwnd = conn->cwnd;
+
+  /* Fast convergence:  Release bandwidth to new flows if the window did
+   * not reach the plateau of the last epoch.
+   */
+
+  if (cwnd < cubic->wmax)
+    {
+      cubic->wmax = (uint32_t)((uint64_t)cwnd *
+                               (CUBIC_BETA_SCALE + CUBIC_BETA) /
+                               (2 * CUBIC_BETA_SCALE));
+    }
+  else
+    {
+      cubic->wmax = cwnd;
+    }
+
+  conn->ssthresh = (uint32_t)((uint64_t)cwnd * CUBIC_BETA /
+                              CUBIC_BETA_SCALE);
+  if (conn->ssthresh < 2 * mss)
+    {
+      conn->ssthresh = 2 * mss;
+    }
+
+  conn->cwnd     = timeout ? mss : conn->ssthresh;
+  cubic->inepoch = false;
+}
+
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
@@ -45,6 +45,7 @@
 #if defined(CONFIG_NET) && defined(CONFIG_NET_TCP)
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include <assert.h>
 #include <errno.h>
@@ -54,11 +55,15 @@
 
 #include <arch/irq.h>
 
+#include <nuttx/nuttx.h>
+#include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/tcp.h>
+#include <nuttx/semaphore.h>
 
 #include "devif/devif.h"
 #include "inet/inet.h"
@@ -73,14 +78,31 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+#ifdef CONFIG_NET_TCP_HASH
+/* The bucket of a local port (in network byte order) */
+
+#  define TCP_PORT_HASH(p) ((unsigned int)(p) % CONFIG_NET_TCP_HASH_SIZE)
+
+/* Return the connection of a hash table link or NULL */
+
+#  define TCP_HASH_CONN(e, m) \
+     ((e) != NULL ? container_of(e, struct tcp_conn_s, m) : NULL)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
-/* The array containing all TCP connections. */
+/* The array containing all preallocated TCP connections. */
 
 static struct tcp_conn_s g_tcp_connections[CONFIG_NET_TCP_CONNS];
 
+#if CONFIG_NET_TCP_ALLOC_CONNS > 0
+/* The number of preallocated and dynamically allocated TCP connections */
+
+static unsigned int g_tcp_nconns = CONFIG_NET_TCP_CONNS;
+#endif
+
 /* A list of all free TCP connections */
 
 static dq_queue_t g_free_tcp_connections;
@@ -89,6 +111,16 @@ static dq_queue_t g_free_tcp_connections;
 
 static dq_queue_t g_active_tcp_connections;
 
+#ifdef CONFIG_NET_TCP_HASH
+/* The active TCP connections hashed by remote address and ports */
+
+static dq_queue_t g_tcp_active_hash[CONFIG_NET_TCP_HASH_SIZE];
+
+/* The allocated TCP connections with a local port hashed by that port */
+
+static dq_queue_t g_tcp_port_hash[CONFIG_NET_TCP_HASH_SIZE];
+#endif
+
 /* Last port used by a TCP connection connection. */
 
 static uint16_t g_last_tcp_port;
@@ -97,6 +129,234 @@ static uint16_t g_last_tcp_port;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_ipv4_hash and tcp_ipv6_hash
+ *
+ * Description:
+ *   Return the bucket of the active connection hash table for a remote
+ *   address and a pair of ports (all in network byte order).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_HASH
+static inline unsigned int tcp_hash_fold(uint32_t hash)
+{
+  hash ^= hash >> 16;
+  hash ^= hash >> 8;
+  return hash % CONFIG_NET_TCP_HASH_SIZE;
+}
+
+#ifdef CONFIG_NET_IPv4
+static inline unsigned int tcp_ipv4_hash(in_addr_t raddr, uint16_t lport,
+                                         uint16_t rport)
+{
+  return tcp_hash_fold((uint32_t)raddr ^
+                       ((uint32_t)lport << 16 | rport));
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static inline unsigned int tcp_ipv6_hash(const net_ipv6addr_t raddr,
+                                         uint16_t lport, uint16_t rport)
+{
+  uint32_t hash = (uint32_t)lport << 16 | rport;
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+    {
+      hash ^= (uint32_t)raddr[i] << 16 | raddr[i + 1];
+    }
+
+  return tcp_hash_fold(hash);
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_conn_hash
+ *
+ * Description:
+ *   Return the bucket of the active connection hash table for a
+ *   connection.
+ *
+ ****************************************************************************/
+
+static unsigned int tcp_conn_hash(FAR struct tcp_conn_s *conn)
+{
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return tcp_ipv4_hash(conn->u.ipv4.raddr, conn->lport, conn->rport);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return tcp_ipv6_hash(conn->u.ipv6.raddr, conn->lport, conn->rport);
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+#endif /* CONFIG_NET_TCP_HASH */
+
+/****************************************************************************
+ * Name: tcp_alloc_conns
+ *
+ * Description:
+ *   Allocate a group of CONFIG_NET_TCP_ALLOC_CONNS connection structures
+ *   from the heap when the preallocated ones are exhausted.  Return the
+ *   first one and put the others into the free list.  The structures are
+ *   never returned to the heap.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NET_TCP_ALLOC_CONNS > 0
+static FAR struct tcp_conn_s *tcp_alloc_conns(void)
+{
+  FAR struct tcp_conn_s *conns;
+  int nconns = CONFIG_NET_TCP_ALLOC_CONNS;
+  int i;
+
+#if CONFIG_NET_TCP_MAX_CONNS > 0
+  if (g_tcp_nconns + nconns > CONFIG_NET_TCP_MAX_CONNS)
+    {
+      nconns = CONFIG_NET_TCP_MAX_CONNS - (int)g_tcp_nconns;
+      if (nconns <= 0)
+        {
+          return NULL;
+        }
+    }
+#endif
+
+  /* The heap cannot be used from interrupt handlers */
+
+  if (up_interrupt_context())
+    {
+      return NULL;
+    }
+
+  conns = kmm_zalloc(nconns * sizeof(struct tcp_conn_s));
+  if (conns == NULL)
+    {
+      nerr("ERROR: Failed to allocate %d TCP connections\n", nconns);
+      return NULL;
+    }
+
+  g_tcp_nconns += nconns;
+  for (i = 1; i < nconns; i++)
+    {
+      conns[i].tcpstateflags = TCP_CLOSED;
+      dq_addlast(&conns[i].node, &g_free_tcp_connections);
+    }
+
+  return &conns[0];
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_reclaimable
+ *
+ * Description:
+ *   Return true if the structure of an active connection may be reused
+ *   when no free connection structure is left.  These are connections
+ *   that are about to be closed anyway and, with SYN cookies, half-open
+ *   connections that can be recreated from the ACK of the peer because
+ *   they negotiated no option that the cookie cannot hold.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_NET_SOLINGER
+static bool tcp_reclaimable(FAR struct tcp_conn_s *conn)
+{
+  if (conn->tcpstateflags == TCP_CLOSING    ||
+      conn->tcpstateflags == TCP_FIN_WAIT_1 ||
+      conn->tcpstateflags == TCP_FIN_WAIT_2 ||
+      conn->tcpstateflags == TCP_TIME_WAIT  ||
+      conn->tcpstateflags == TCP_LAST_ACK)
+    {
+      return true;
+    }
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+  if (conn->tcpstateflags == TCP_SYN_RCVD)
+    {
+#ifdef CONFIG_NET_TCP_SACK
+      if (conn->sackperm)
+        {
+          return false;
+        }
+#endif
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+      if (conn->wscale)
+        {
+          return false;
+        }
+#endif
+
+      return true;
+    }
+#endif
+
+  return false;
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_setlport
+ *
+ * Description:
+ *   Set the local port of a connection (in network byte order), keeping
+ *   the local port hash table up to date.  Zero removes the port.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_setlport(FAR struct tcp_conn_s *conn, uint16_t portno)
+{
+#ifdef CONFIG_NET_TCP_HASH
+  if (conn->lport != 0)
+    {
+      dq_rem(&conn->pnode, &g_tcp_port_hash[TCP_PORT_HASH(conn->lport)]);
+    }
+
+  if (portno != 0)
+    {
+      dq_addlast(&conn->pnode, &g_tcp_port_hash[TCP_PORT_HASH(portno)]);
+    }
+#endif
+
+  conn->lport = portno;
+}
+
+/****************************************************************************
+ * Name: tcp_addactive
+ *
+ * Description:
+ *   Add a connection to the list (and the hash table) of active
+ *   connections.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void tcp_addactive(FAR struct tcp_conn_s *conn)
+{
+  dq_addlast(&conn->node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_HASH
+  dq_addlast(&conn->hnode, &g_tcp_active_hash[tcp_conn_hash(conn)]);
+#endif
+}
+
 /****************************************************************************
  * Name: tcp_ipv4_listener
  *
@@ -114,13 +374,27 @@ static inline FAR struct tcp_conn_s *tcp_ipv4_listener(in_addr_t ipaddr,
                                                        uint16_t portno)
 {
   FAR struct tcp_conn_s *conn;
+#ifdef CONFIG_NET_TCP_HASH
+  FAR dq_entry_t *entry;
+#else
   int i;
+#endif
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
+#ifdef CONFIG_NET_TCP_HASH
+  for (entry = dq_peek(&g_tcp_port_hash[TCP_PORT_HASH(portno)]);
+       entry != NULL;
+       entry = dq_next(entry))
+#else
   for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
+#endif
     {
+#ifdef CONFIG_NET_TCP_HASH
+      conn = container_of(entry, struct tcp_conn_s, pnode);
+#else
       conn = &g_tcp_connections[i];
+#endif
 
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
@@ -165,13 +439,27 @@ static inline FAR struct tcp_conn_s *
 tcp_ipv6_listener(const net_ipv6addr_t ipaddr, uint16_t portno)
 {
   FAR struct tcp_conn_s *conn;
+#ifdef CONFIG_NET_TCP_HASH
+  FAR dq_entry_t *entry;
+#else
   int i;
+#endif
 
   /* Check if this port number is in use by any active UIP TCP connection */
 
+#ifdef CONFIG_NET_TCP_HASH
+  for (entry = dq_peek(&g_tcp_port_hash[TCP_PORT_HASH(portno)]);
+       entry != NULL;
+       entry = dq_next(entry))
+#else
   for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
+#endif
     {
+#ifdef CONFIG_NET_TCP_HASH
+      conn = container_of(entry, struct tcp_conn_s, pnode);
+#else
       conn = &g_tcp_connections[i];
+#endif
 
       /* Check if this connection is open and the local port assignment
        * matches the requested port number.
@@ -328,10 +616,16 @@ static inline FAR struct tcp_conn_s *
   in_addr_t srcipaddr;
   in_addr_t destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = net_ip4addr_conv32(ip->srcipaddr);
   destipaddr = net_ip4addr_conv32(ip->destipaddr);
 
+#ifdef CONFIG_NET_TCP_HASH
+  conn = TCP_HASH_CONN(dq_peek(&g_tcp_active_hash[
+           tcp_ipv4_hash(srcipaddr, tcp->destport, tcp->srcport)]), hnode);
+#else
+  conn = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -367,7 +661,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_HASH
+      conn = TCP_HASH_CONN(dq_next(&conn->hnode), hnode);
+#else
       conn = (FAR struct tcp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -395,10 +693,16 @@ static inline FAR struct tcp_conn_s *
   net_ipv6addr_t *srcipaddr;
   net_ipv6addr_t *destipaddr;
 
-  conn       = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
   srcipaddr  = (net_ipv6addr_t *)ip->srcipaddr;
   destipaddr = (net_ipv6addr_t *)ip->destipaddr;
 
+#ifdef CONFIG_NET_TCP_HASH
+  conn = TCP_HASH_CONN(dq_peek(&g_tcp_active_hash[
+           tcp_ipv6_hash(*srcipaddr, tcp->destport, tcp->srcport)]), hnode);
+#else
+  conn = (FAR struct tcp_conn_s *)g_active_tcp_connections.head;
+#endif
+
   while (conn)
     {
       /* Find an open connection matching the TCP input. The following
@@ -434,7 +738,11 @@ static inline FAR struct tcp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_TCP_HASH
+      conn = TCP_HASH_CONN(dq_next(&conn->hnode), hnode);
+#else
       conn = (FAR struct tcp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -480,7 +788,7 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
 
   /* Save the local address in the connection structure (network order). */
 
-  conn->lport = htons(port);
+  tcp_setlport(conn, htons(port));
   net_ipv4addr_copy(conn->u.ipv4.laddr, addr->sin_addr.s_addr);
 
   /* Find the device that can receive packets on the network associated with
@@ -496,7 +804,7 @@ static inline int tcp_ipv4_bind(FAR struct tcp_conn_s *conn,
 
       /* Back out the local address setting */
 
-      conn->lport = 0;
+      tcp_setlport(conn, 0);
       net_ipv4addr_copy(conn->u.ipv4.laddr, INADDR_ANY);
       return ret;
     }
@@ -547,7 +855,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
   /* Save the local address in the connection structure (network order). */
 
-  conn->lport = htons(port);
+  tcp_setlport(conn, htons(port));
   net_ipv6addr_copy(conn->u.ipv6.laddr, addr->sin6_addr.in6_u.u6_addr16);
 
   /* Find the device that can receive packets on the network
@@ -563,7 +871,7 @@ static inline int tcp_ipv6_bind(FAR struct tcp_conn_s *conn,
 
       /* Back out the local address setting */
 
-      conn->lport = 0;
+      tcp_setlport(conn, 0);
       net_ipv6addr_copy(conn->u.ipv6.laddr, g_ipv6_unspecaddr);
       return ret;
     }
@@ -595,6 +903,14 @@ void tcp_initialize(void)
   dq_init(&g_free_tcp_connections);
   dq_init(&g_active_tcp_connections);
 
+#ifdef CONFIG_NET_TCP_HASH
+  for (i = 0; i < CONFIG_NET_TCP_HASH_SIZE; i++)
+    {
+      dq_init(&g_tcp_active_hash[i]);
+      dq_init(&g_tcp_port_hash[i]);
+    }
+#endif
+
   /* Now initialize each connection structure */
 
   for (i = 0; i < CONFIG_NET_TCP_CONNS; i++)
@@ -634,6 +950,15 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
 
   conn = (FAR struct tcp_conn_s *)dq_remfirst(&g_free_tcp_connections);
 
+#if CONFIG_NET_TCP_ALLOC_CONNS > 0
+  /* Is the free list empty?  Then try to allocate more structures. */
+
+  if (!conn)
+    {
+      conn = tcp_alloc_conns();
+    }
+#endif
+
 #ifndef CONFIG_NET_SOLINGER
   /* Is the free list empty? */
 
@@ -658,11 +983,7 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
            * in the socket layer.
            */
 
-          if (tmp->tcpstateflags == TCP_CLOSING    ||
-              tmp->tcpstateflags == TCP_FIN_WAIT_1 ||
-              tmp->tcpstateflags == TCP_FIN_WAIT_2 ||
-              tmp->tcpstateflags == TCP_TIME_WAIT  ||
-              tmp->tcpstateflags == TCP_LAST_ACK)
+          if (tcp_reclaimable(tmp))
             {
               /* Yes.. Is it the oldest one we have seen so far? */
 
@@ -696,8 +1017,16 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
            * pending callback in netclose_disconnect waiting for getting
            * woken up.  Otherwise there's the callback too, but no one is
            * waiting for it.
+           *
+           * A half-open connection holds only the reference taken when the
+           * SYN was received.
            */
 
+          if (conn->tcpstateflags == TCP_SYN_RCVD)
+            {
+              conn->crefs = 0;
+            }
+
           tcp_free(conn);
 
           /* Now there is guaranteed to be one free connection.  Get it! */
@@ -718,6 +1047,12 @@ FAR struct tcp_conn_s *tcp_alloc(uint8_t domain)
       conn->tcpstateflags = TCP_ALLOCATED;
 #if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
       conn->domain        = domain;
+#endif
+      conn->rcv_bufs      = CONFIG_NET_TCP_RECV_BUFSIZE;
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+      conn->snd_bufs      = CONFIG_NET_TCP_SEND_BUFSIZE;
+      nxsem_init(&conn->snd_sem, 0, 0);
+      nxsem_setprotocol(&conn->snd_sem, SEM_PRIO_NONE);
 #endif
 #ifdef CONFIG_NET_TCP_KEEPALIVE
       conn->keeptime      = clock_systime_ticks();
@@ -774,8 +1109,15 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       /* Remove the connection from the active list */
 
       dq_rem(&conn->node, &g_active_tcp_connections);
+#ifdef CONFIG_NET_TCP_HASH
+      dq_rem(&conn->hnode, &g_tcp_active_hash[tcp_conn_hash(conn)]);
+#endif
     }
 
+  /* Release the local port */
+
+  tcp_setlport(conn, 0);
+
   /* Release any read-ahead buffers attached to the connection */
 
   iob_free_queue(&conn->readahead, IOBUSER_NET_TCP_READAHEAD);
@@ -1002,9 +1344,9 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
       conn->sa            = 0;
       conn->sv            = 4;
       conn->nrtx          = 0;
-      conn->lport         = tcp->destport;
       conn->rport         = tcp->srcport;
       conn->tcpstateflags = TCP_SYN_RCVD;
+      tcp_setlport(conn, tcp->destport);
 
       tcp_initsequence(conn->sndseq);
       conn->tx_unacked    = 1;
@@ -1034,7 +1376,7 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
        * Interrupts should already be disabled in this context.
        */
 
-      dq_addlast(&conn->node, &g_active_tcp_connections);
+      tcp_addactive(conn);
     }
 
   return conn;
@@ -1278,7 +1620,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
   conn->rto        = TCP_RTO;
   conn->sa         = 0;
   conn->sv         = 16;   /* Initial value of the RTT variance. */
-  conn->lport      = htons((uint16_t)port);
+  tcp_setlport(conn, htons((uint16_t)port));
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
   conn->expired    = 0;
   conn->isn        = 0;
@@ -1299,7 +1641,7 @@ int tcp_connect(FAR struct tcp_conn_s *conn, FAR const struct sockaddr *addr)
 
   /* And, finally, put the connection structure into the active list. */
 
-  dq_addlast(&conn->node, &g_active_tcp_connections);
+  tcp_addactive(conn);
   ret = OK;
 
 errout_with_lock:
@@ -41,6 +41,7 @@
 
 #include <sys/time.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -97,9 +98,10 @@
 int tcp_getsockopt(FAR struct socket *psock, int option,
                    FAR void *value, FAR socklen_t *value_len)
 {
-#ifdef CONFIG_NET_TCP_KEEPALIVE
-  /* Keep alive options are the only TCP protocol socket option currently
-   * supported.
+#if defined(CONFIG_NET_TCP_KEEPALIVE) || defined(CONFIG_NET_TCP_CC) || \
+    defined(CONFIG_NET_TCP_DELAYED_ACK)
+  /* Keep alive, congestion control and delayed ACK options are the only TCP
+   * protocol socket options currently supported.
    */
 
   FAR struct tcp_conn_s *conn;
@@ -120,10 +122,11 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
       return -ENOTCONN;
     }
 
-  /* Handle the Keep-Alive option */
+  /* Handle the Keep-Alive, congestion control and delayed ACK options */
 
   switch (option)
     {
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       /* Handle the SO_KEEPALIVE socket-level option.
        *
        * NOTE: SO_KEEPALIVE is not really a socket-level option; it is a
@@ -152,12 +155,14 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
             ret                = OK;
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
 
       case TCP_NODELAY:  /* Avoid coalescing of small segments. */
         nerr("ERROR: TCP_NODELAY not supported\n");
         ret = -ENOSYS;
         break;
 
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       case TCP_KEEPIDLE:  /* Start keepalives after this IDLE period */
         if (*value_len < sizeof(struct timeval))
           {
@@ -238,6 +243,57 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
             ret              = OK;
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
+
+#ifdef CONFIG_NET_TCP_CC
+      case TCP_CONGESTION: /* Congestion control algorithm */
+        {
+          FAR const struct tcp_cc_ops_s *cc = conn->cc;
+          size_t len;
+
+          /* Until the connection is established, report the algorithm
+           * that it will use.
+           */
+
+          if (cc == NULL)
+            {
+#ifdef CONFIG_NET_TCP_CC_DEFAULT_CUBIC
+              cc = &g_tcp_cc_cubic;
+#else
+              cc = &g_tcp_cc_newreno;
+#endif
+            }
+
+          /* The name is silently truncated to the size of the value */
+
+          len = strlen(cc->name) + 1;
+          if (len > *value_len)
+            {
+              len = *value_len;
+            }
+
+          memcpy(value, cc->name, len);
+          *value_len = len;
+          ret        = OK;
+        }
+        break;
+#endif
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+      case TCP_QUICKACK:  /* Do not delay ACKs */
+        if (*value_len < sizeof(int))
+          {
+            ret                = -EINVAL;
+          }
+        else
+          {
+            FAR int *quickack  = (FAR int *)value;
+            *quickack          = (int)conn->quickack;
+            *value_len         = sizeof(int);
+            ret                = OK;
+          }
+        break;
+#endif
 
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
@@ -248,7 +304,7 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
   return ret;
 #else
   return -ENOPROTOOPT;
-#endif /* CONFIG_NET_TCP_KEEPALIVE */
+#endif /* CONFIG_NET_TCP_KEEPALIVE || CONFIG_NET_TCP_CC || ... */
 }
 
 #endif /* CONFIG_NET_TCPPROTO_OPTIONS */
@@ -72,6 +72,80 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_synmss
+ *
+ * Description:
+ *   Return the MSS of a passive connection from the MSS option of the
+ *   incoming SYN, limited to the MSS of the device.  This is used when
+ *   there is no connection structure to hold the options.
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure containing the received SYN
+ *   tcp    - The TCP header of the SYN
+ *   iplen  - Length of the IP header (IPv4_HDRLEN or IPv6_HDRLEN).
+ *   hdrlen - Length of the link layer, the IP and the TCP header
+ *
+ * Returned Value:
+ *   The MSS of the connection
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+static uint16_t tcp_synmss(FAR struct net_driver_s *dev,
+                           FAR struct tcp_hdr_s *tcp, unsigned int iplen,
+                           unsigned int hdrlen)
+{
+  uint16_t tcp_mss = TCP_MSS(dev, iplen);
+  uint16_t mss;
+  uint8_t opt;
+  int i;
+
+  /* Without the option the MSS is the default of the IP domain */
+
+  mss = tcp_mss > TCP_DEFAULT_IPv4_MSS ? TCP_DEFAULT_IPv4_MSS : tcp_mss;
+#ifdef CONFIG_NET_IPv6
+  if (iplen == IPv6_HDRLEN)
+    {
+      mss = tcp_mss > TCP_DEFAULT_IPv6_MSS ? TCP_DEFAULT_IPv6_MSS : tcp_mss;
+    }
+#endif
+
+  for (i = 0; i < ((tcp->tcpoffset >> 4) - 5) << 2 ; )
+    {
+      opt = dev->d_buf[hdrlen + i];
+      if (opt == TCP_OPT_END)
+        {
+          break;
+        }
+      else if (opt == TCP_OPT_NOOP)
+        {
+          ++i;
+        }
+      else if (opt == TCP_OPT_MSS &&
+               dev->d_buf[hdrlen + 1 + i] == TCP_OPT_MSS_LEN)
+        {
+          mss = ((uint16_t)dev->d_buf[hdrlen + 2 + i] << 8) |
+                 (uint16_t)dev->d_buf[hdrlen + 3 + i];
+          mss = mss > tcp_mss ? tcp_mss : mss;
+          break;
+        }
+      else if (dev->d_buf[hdrlen + 1 + i] == 0)
+        {
+          /* The options are malformed */
+
+          break;
+        }
+      else
+        {
+          i += dev->d_buf[hdrlen + 1 + i];
+        }
+    }
+
+  return mss;
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_input
  *
@@ -133,7 +207,8 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   /* Start of TCP input header processing code. */
 
-  if (tcp_chksum(dev) != 0xffff)
+  if (!NETDEV_HAS_FEATURE(dev, NETDEV_FEATURE_RXCSUM) &&
+      tcp_chksum(dev) != 0xffff)
     {
       /* Compute and check the TCP checksum. */
 
@@ -223,6 +298,16 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
           if (!conn)
             {
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+              /* All available connections are in use.  Answer with a SYN
+               * cookie instead.  The connection is created when the ACK
+               * that returns the cookie is received.
+               */
+
+              tmp16 = tcp_synmss(dev, tcp, iplen, hdrlen);
+              tcp_synack_cookie(dev, tcp_syncookie(dev, tcp, tmp16), tmp16);
+              return;
+#else
               /* Either (1) all available connections are in use, or (2)
                * there is no application in place to accept the connection.
                * We drop packet and hope that the remote end will retransmit
@@ -235,11 +320,12 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 #endif
               nerr("ERROR: No free TCP connections\n");
               goto drop;
+#endif
             }
 
           net_incr32(conn->rcvseq, 1);
 
-          /* Parse the TCP MSS option, if present. */
+          /* Parse the TCP MSS and SACK permitted options, if present. */
 
           if ((tcp->tcpoffset & 0xf0) > 0x50)
             {
@@ -269,10 +355,44 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
                                (uint16_t)dev->d_buf[hdrlen + 3 + i];
                       conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
 
+#if defined(CONFIG_NET_TCP_SACK) || defined(CONFIG_NET_TCP_WINDOW_SCALE)
+                      /* Continue with the other options */
+
+                      i += TCP_OPT_MSS_LEN;
+#else
                       /* And we are done processing options. */
 
                       break;
+#endif
                     }
+#ifdef CONFIG_NET_TCP_SACK
+                  else if (opt == TCP_OPT_SACK_PERM &&
+                           dev->d_buf[hdrlen + 1 + i] ==
+                           TCP_OPT_SACK_PERM_LEN)
+                    {
+                      /* The peer permits SACK.  We'll accept it in the
+                       * SYNACK.
+                       */
+
+                      conn->sackperm = true;
+                      i += TCP_OPT_SACK_PERM_LEN;
+                    }
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+                  else if (opt == TCP_OPT_WS &&
+                           dev->d_buf[hdrlen + 1 + i] == TCP_OPT_WS_LEN)
+                    {
+                      /* The peer offers window scaling.  We'll accept it in
+                       * the SYNACK.
+                       */
+
+                      tmp16 = dev->d_buf[hdrlen + 2 + i];
+                      conn->snd_scale = tmp16 > TCP_WS_MAXSHIFT ?
+                                        TCP_WS_MAXSHIFT : tmp16;
+                      conn->wscale = true;
+                      i += TCP_OPT_WS_LEN;
+                    }
+#endif
                   else
                     {
                       /* All other options have a length field, so that we
@@ -293,12 +413,63 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
                 }
             }
 
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+          /* Use a SYN cookie as initial sequence number.  Then the
+           * connection can be recreated from the ACK if its structure is
+           * reclaimed before the handshake completes.
+           */
+
+          tcp_setsequence(conn->sndseq, tcp_syncookie(dev, tcp, conn->mss));
+#endif
+
           /* Our response will be a SYNACK. */
 
           tcp_synack(dev, conn, TCP_ACK | TCP_SYN);
           return;
         }
     }
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+  else if ((tcp->flags & (TCP_SYN | TCP_RST | TCP_ACK)) == TCP_ACK)
+    {
+      /* This may be the ACK of a SYNACK that carried a SYN cookie.  Is
+       * there a listener on this port?
+       */
+
+      tmp16 = tcp->destport;
+#if defined(CONFIG_NET_IPv4) && defined(CONFIG_NET_IPv6)
+      if (tcp_islistener(tmp16, domain) &&
+#else
+      if (tcp_islistener(tmp16) &&
+#endif
+          tcp_syncookie_check(dev, tcp, &tmp16) == OK)
+        {
+          /* Yes.. Recreate the connection in the TCP_SYN_RCVD state and
+           * let the state machine complete the handshake.
+           */
+
+          conn = tcp_alloc_accept(dev, tcp);
+          if (conn == NULL)
+            {
+#ifdef CONFIG_NET_STATISTICS
+              g_netstats.tcp.syndrop++;
+#endif
+              nerr("ERROR: No free TCP connections\n");
+              goto drop;
+            }
+
+          conn->crefs = 1;
+          conn->mss   = tmp16 > TCP_MSS(dev, iplen) ?
+                        TCP_MSS(dev, iplen) : tmp16;
+
+          /* The ACK already follows the SYN of the peer and acknowledges
+           * the cookie.
+           */
+
+          tcp_setsequence(conn->sndseq, tcp_getsequence(tcp->ackno) - 1);
+          goto found;
+        }
+    }
+#endif
 
   nwarn("WARNING: SYN with no listener (or old packet) .. reset\n");
 
@@ -327,6 +498,15 @@ found:
 
   conn->winsize = ((uint16_t)tcp->wnd[0] << 8) + (uint16_t)tcp->wnd[1];
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* The window of SYN segments is never scaled */
+
+  if ((tcp->flags & TCP_SYN) == 0)
+    {
+      conn->winsize <<= conn->snd_scale;
+    }
+#endif
+
   flags = 0;
 
   /* We do a very naive form of TCP reset processing; we just accept
@@ -611,6 +791,9 @@ found:
             conn->sndseq_max    = 0;
 #endif
             conn->tx_unacked    = 0;
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_init(conn);
+#endif
             flags               = TCP_CONNECTED;
             ninfo("TCP state: TCP_ESTABLISHED\n");
 
@@ -646,7 +829,7 @@ found:
         if ((flags & TCP_ACKDATA) != 0 &&
             (tcp->flags & TCP_CTL) == (TCP_SYN | TCP_ACK))
           {
-            /* Parse the TCP MSS option, if present. */
+            /* Parse the TCP MSS and SACK permitted options, if present. */
 
             if ((tcp->tcpoffset & 0xf0) > 0x50)
               {
@@ -677,10 +860,44 @@ found:
                           dev->d_buf[hdrlen + 3 + i];
                         conn->mss = tmp16 > tcp_mss ? tcp_mss : tmp16;
 
+#if defined(CONFIG_NET_TCP_SACK) || defined(CONFIG_NET_TCP_WINDOW_SCALE)
+                        /* Continue with the other options */
+
+                        i += TCP_OPT_MSS_LEN;
+#else
                         /* And we are done processing options. */
 
                         break;
+#endif
+                      }
+#ifdef CONFIG_NET_TCP_SACK
+                    else if (opt == TCP_OPT_SACK_PERM &&
+                             dev->d_buf[hdrlen + 1 + i] ==
+                             TCP_OPT_SACK_PERM_LEN)
+                      {
+                        /* The peer accepted the SACK that we offered in
+                         * the SYN.
+                         */
+
+                        conn->sackperm = true;
+                        i += TCP_OPT_SACK_PERM_LEN;
                       }
+#endif
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+                    else if (opt == TCP_OPT_WS &&
+                             dev->d_buf[hdrlen + 1 + i] == TCP_OPT_WS_LEN)
+                      {
+                        /* The peer accepted the window scaling that we
+                         * offered in the SYN.
+                         */
+
+                        tmp16 = dev->d_buf[hdrlen + 2 + i];
+                        conn->snd_scale = tmp16 > TCP_WS_MAXSHIFT ?
+                                          TCP_WS_MAXSHIFT : tmp16;
+                        conn->wscale = true;
+                        i += TCP_OPT_WS_LEN;
+                      }
+#endif
                     else
                       {
                         /* All other options have a length field, so that we
@@ -701,6 +918,17 @@ found:
                   }
               }
 
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+            /* Our window is not scaled if the peer did not accept the
+             * window scale option.
+             */
+
+            if (!conn->wscale)
+              {
+                conn->rcv_scale = 0;
+              }
+#endif
+
             conn->tcpstateflags = TCP_ESTABLISHED;
             memcpy(conn->rcvseq, tcp->seqno, 4);
 
@@ -710,6 +938,9 @@ found:
 #ifdef CONFIG_NET_TCP_WRITE_BUFFERS
             conn->isn           = tcp_getsequence(tcp->ackno);
             tcp_setsequence(conn->sndseq, conn->isn);
+#endif
+#ifdef CONFIG_NET_TCP_CC
+            tcp_cc_init(conn);
 #endif
             dev->d_len          = 0;
             dev->d_sndlen       = 0;
@@ -47,6 +47,7 @@
 
 #include <nuttx/net/net.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
 
 #include "devif/devif.h"
 #include "netdev/netdev.h"
@@ -122,14 +123,19 @@ static uint16_t tcp_poll_eventhandler(FAR struct net_driver_s *dev,
 
       if (eventset != 0)
         {
-          /* Stop further callbacks */
+          /* Stop further callbacks unless this is a persistent poll (as
+           * set up by epoll) that wants to see all events.
+           */
 
-          info->cb->flags   = 0;
-          info->cb->priv    = NULL;
-          info->cb->event   = NULL;
+          if (info->fds->cb == NULL)
+            {
+              info->cb->flags   = 0;
+              info->cb->priv    = NULL;
+              info->cb->event   = NULL;
+            }
 
           info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(info->fds);
         }
     }
 
@@ -177,7 +183,7 @@ static inline void tcp_iob_work(FAR void *arg)
            */
 
           fds->revents |= (POLLERR | POLLHUP);
-          nxsem_post(fds->sem);
+          poll_notify(fds);
         }
     }
 
@@ -195,7 +201,7 @@ static inline void tcp_iob_work(FAR void *arg)
           /* Yes.. then signal the poll logic */
 
           fds->revents |= POLLWRNORM;
-          nxsem_post(fds->sem);
+          poll_notify(fds);
         }
       else
         {
@@ -371,7 +377,7 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(fds);
     }
 
 #if defined(CONFIG_NET_TCP_WRITE_BUFFERS) && defined(CONFIG_IOB_NOTIFIER)
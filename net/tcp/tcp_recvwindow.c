@@ -53,30 +53,20 @@
 #include "tcp/tcp.h"
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: tcp_get_recvwindow
+ * Name: tcp_get_mss
  *
  * Description:
- *   Calculate the TCP receive window for the specified device.
- *
- * Input Parameters:
- *   dev - The device whose TCP receive window will be updated.
- *
- * Returned Value:
- *   The value of the TCP receive window to use.
+ *   Get the packet MSS of a device.
  *
  ****************************************************************************/
 
-uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
+static uint16_t tcp_get_mss(FAR struct net_driver_s *dev)
 {
   uint16_t iplen;
-  uint16_t mss;
-  uint16_t recvwndo;
-  int niob_avail;
-  int nqentry_avail;
 
 #ifdef CONFIG_NET_IPv6
 #ifdef CONFIG_NET_IPv4
@@ -102,7 +92,50 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
    * is the minimum size.
    */
 
-  mss = dev->d_pktsize - (NET_LL_HDRLEN(dev) + iplen + TCP_HDRLEN);
+  return dev->d_pktsize - (NET_LL_HDRLEN(dev) + iplen + TCP_HDRLEN);
+}
+
+/****************************************************************************
+ * Name: tcp_get_rcvbudget
+ *
+ * Description:
+ *   Get the part of the receive buffer budget of a connection that is not
+ *   used by read-ahead I/O buffers.  Each I/O buffer counts with its full
+ *   size.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_get_rcvbudget(FAR struct tcp_conn_s *conn)
+{
+  FAR struct iob_qentry_s *qentry;
+  FAR struct iob_s *iob;
+  uint32_t used = 0;
+
+  for (qentry = conn->readahead.qh_head; qentry != NULL;
+       qentry = qentry->qe_flink)
+    {
+      for (iob = qentry->qe_head; iob != NULL; iob = iob->io_flink)
+        {
+          used += IOB_BUFSIZE(iob);
+        }
+    }
+
+  return conn->rcv_bufs > used ? conn->rcv_bufs - used : 0;
+}
+
+/****************************************************************************
+ * Name: tcp_get_iobwindow
+ *
+ * Description:
+ *   Get the largest window that the available read-ahead I/O buffers
+ *   permit.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_get_iobwindow(uint16_t mss)
+{
+  int niob_avail;
+  int nqentry_avail;
 
   /* Update the TCP received window based on read-ahead I/O buffer
    * and IOB chain availability.  At least one queue entry is required.
@@ -136,8 +169,6 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
 
   if (nqentry_avail > 0 && niob_avail > 0)
     {
-      uint32_t rwnd;
-
       /* The optimal TCP window size is the amount of TCP data that we can
        * currently buffer via TCP read-ahead buffering plus MSS for the
        * device packet buffer.  This logic here assumes that all IOBs are
@@ -151,18 +182,11 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
        * sockets (and perhaps multiple network devices) or if there are
        * other consumers of IOBs (such as for TCP write buffering) then the
        * total number of IOBs will all not be available for read-ahead
-       * buffering for this connection.
+       * buffering for this connection.  The receive buffer budget of each
+       * connection (SO_RCVBUF) limits its share.
        */
 
-      rwnd = (niob_avail * CONFIG_IOB_BUFSIZE) + mss;
-      if (rwnd > UINT16_MAX)
-        {
-          rwnd = UINT16_MAX;
-        }
-
-      /* Save the new receive window size */
-
-      recvwndo = (uint16_t)rwnd;
+      return ((uint32_t)niob_avail * CONFIG_IOB_BUFSIZE) + mss;
     }
   else /* nqentry_avail == 0 || niob_avail == 0 */
     {
@@ -174,8 +198,116 @@ uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev)
        * lost if there is no listener on the connection.
        */
 
-      recvwndo = mss;
+      return mss;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_get_recvwindow
+ *
+ * Description:
+ *   Calculate the TCP receive window for the specified device and
+ *   connection.
+ *
+ * Input Parameters:
+ *   dev  - The device whose TCP receive window will be updated.
+ *   conn - The TCP connection that advertises the window.
+ *
+ * Returned Value:
+ *   The value of the window field of the TCP header, scaled by the receive
+ *   window scale of the connection.
+ *
+ ****************************************************************************/
+
+uint16_t tcp_get_recvwindow(FAR struct net_driver_s *dev,
+                            FAR struct tcp_conn_s *conn)
+{
+  uint16_t mss;
+  uint32_t rwnd;
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  uint8_t state;
+#endif
+
+  mss  = tcp_get_mss(dev);
+  rwnd = tcp_get_iobwindow(mss);
+
+  /* Don't exceed the unused receive buffer budget of the connection.  As
+   * when no I/O buffers are available, one MSS is still advertised so that
+   * the connection does not stall waiting for a window update.
+   */
+
+  if (conn->rcv_bufs > 0)
+    {
+      uint32_t budget = tcp_get_rcvbudget(conn);
+
+      if (rwnd > budget)
+        {
+          rwnd = budget > mss ? budget : mss;
+        }
+    }
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* The window of SYN and SYNACK segments is never scaled.  These are the
+   * only segments sent in the SYN_RCVD and SYN_SENT states.
+   */
+
+  state = conn->tcpstateflags & TCP_STATE_MASK;
+  if (state != TCP_SYN_RCVD && state != TCP_SYN_SENT)
+    {
+      rwnd >>= conn->rcv_scale;
+    }
+#endif
+
+  if (rwnd > UINT16_MAX)
+    {
+      rwnd = UINT16_MAX;
     }
 
-  return recvwndo;
+  return (uint16_t)rwnd;
 }
+
+/****************************************************************************
+ * Name: tcp_get_rcvscale
+ *
+ * Description:
+ *   Get the receive window scale shift to offer in the window scale option
+ *   of a SYN or SYNACK:  The smallest shift for which the largest receive
+ *   window that the connection may advertise fits into 16 bits.
+ *
+ * Input Parameters:
+ *   dev  - The device used by the connection.
+ *   conn - The TCP connection.
+ *
+ * Returned Value:
+ *   The window scale shift (0-14).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+uint8_t tcp_get_rcvscale(FAR struct net_driver_s *dev,
+                         FAR struct tcp_conn_s *conn)
+{
+  uint32_t maxwnd;
+  uint8_t shift = 0;
+
+  /* The largest window is advertised when all I/O buffers are free */
+
+  maxwnd = (uint32_t)(CONFIG_IOB_NBUFFERS - CONFIG_IOB_THROTTLE) *
+           CONFIG_IOB_BUFSIZE + tcp_get_mss(dev);
+  if (conn->rcv_bufs > 0 && maxwnd > conn->rcv_bufs)
+    {
+      maxwnd = conn->rcv_bufs;
+    }
+
+  while ((maxwnd >> shift) > UINT16_MAX && shift < TCP_WS_MAXSHIFT)
+    {
+      shift++;
+    }
+
+  return shift;
+}
+#endif
@@ -153,7 +153,10 @@ static inline void tcp_ipv4_sendcomplete(FAR struct net_driver_s *dev,
   tcp->urgp[1]      = 0;
 
   tcp->tcpchksum    = 0;
-  tcp->tcpchksum    = ~tcp_ipv4_chksum(dev);
+  if (!NETDEV_HAS_FEATURE(dev, NETDEV_FEATURE_TXCSUM))
+    {
+      tcp->tcpchksum = ~tcp_ipv4_chksum(dev);
+    }
 
   /* Finish initializing the IP header and calculate the IP checksum */
 
@@ -168,7 +171,10 @@ static inline void tcp_ipv4_sendcomplete(FAR struct net_driver_s *dev,
   /* Calculate IP checksum. */
 
   ipv4->ipchksum    = 0;
-  ipv4->ipchksum    = ~ipv4_chksum(dev);
+  if (!NETDEV_HAS_FEATURE(dev, NETDEV_FEATURE_TXCSUM))
+    {
+      ipv4->ipchksum = ~ipv4_chksum(dev);
+    }
 
   ninfo("IPv4 length: %d\n", ((int)ipv4->len[0] << 8) + ipv4->len[1]);
 
@@ -225,7 +231,10 @@ static inline void tcp_ipv6_sendcomplete(FAR struct net_driver_s *dev,
   tcp->urgp[1]     = 0;
 
   tcp->tcpchksum   = 0;
-  tcp->tcpchksum   = ~tcp_ipv6_chksum(dev);
+  if (!NETDEV_HAS_FEATURE(dev, NETDEV_FEATURE_TXCSUM))
+    {
+      tcp->tcpchksum = ~tcp_ipv6_chksum(dev);
+    }
 
   /* Finish initializing the IP header (no IPv6 checksum) */
 
@@ -360,7 +369,7 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
     {
       /* Update the TCP received window based on I/O buffer availability */
 
-      uint16_t recvwndo = tcp_get_recvwindow(dev);
+      uint16_t recvwndo = tcp_get_recvwindow(dev, conn);
 
       /* Set the TCP Window */
 
@@ -574,6 +583,7 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 {
   struct tcp_hdr_s *tcp;
   uint16_t tcp_mss;
+  uint16_t optlen;
 
   /* Get values that vary with the underlying IP domain */
 
@@ -587,9 +597,9 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
       tcp     = TCPIPv6BUF;
       tcp_mss = TCP_IPv6_MSS(dev);
 
-      /* Set the packet length for the TCP Maximum Segment Size */
+      /* Set the packet length without the TCP options */
 
-      dev->d_len  = IPv6TCP_HDRLEN + TCP_OPT_MSS_LEN;
+      dev->d_len  = IPv6TCP_HDRLEN;
     }
 #endif /* CONFIG_NET_IPv6 */
 
@@ -603,9 +613,9 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
       tcp     = TCPIPv4BUF;
       tcp_mss = TCP_IPv4_MSS(dev);
 
-      /* Set the packet length for the TCP Maximum Segment Size */
+      /* Set the packet length without the TCP options */
 
-      dev->d_len  = IPv4TCP_HDRLEN + TCP_OPT_MSS_LEN;
+      dev->d_len  = IPv4TCP_HDRLEN;
     }
 #endif /* CONFIG_NET_IPv4 */
 
@@ -619,11 +629,146 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   tcp->optdata[1] = TCP_OPT_MSS_LEN;
   tcp->optdata[2] = tcp_mss >> 8;
   tcp->optdata[3] = tcp_mss & 0xff;
-  tcp->tcpoffset  = ((TCP_HDRLEN + TCP_OPT_MSS_LEN) / 4) << 4;
+  optlen          = TCP_OPT_MSS_LEN;
+
+#ifdef CONFIG_NET_TCP_SACK
+  /* Offer selective acknowledgments in the SYN and accept them in the
+   * SYNACK if the peer offered them.
+   */
+
+  if ((ack & TCP_SYN) != 0 && ((ack & TCP_ACK) == 0 || conn->sackperm))
+    {
+      FAR uint8_t *optdata = (FAR uint8_t *)tcp + TCP_HDRLEN + optlen;
+
+      optdata[0] = TCP_OPT_NOOP;
+      optdata[1] = TCP_OPT_NOOP;
+      optdata[2] = TCP_OPT_SACK_PERM;
+      optdata[3] = TCP_OPT_SACK_PERM_LEN;
+      optlen    += 4;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  /* Offer window scaling in the SYN and accept it in the SYNACK if the
+   * peer offered it.  Otherwise, neither window is scaled.
+   */
+
+  if ((ack & TCP_SYN) != 0 && ((ack & TCP_ACK) == 0 || conn->wscale))
+    {
+      FAR uint8_t *optdata = (FAR uint8_t *)tcp + TCP_HDRLEN + optlen;
+
+      conn->rcv_scale = tcp_get_rcvscale(dev, conn);
+
+      optdata[0] = TCP_OPT_NOOP;
+      optdata[1] = TCP_OPT_WS;
+      optdata[2] = TCP_OPT_WS_LEN;
+      optdata[3] = conn->rcv_scale;
+      optlen    += 4;
+    }
+#endif
+
+  tcp->tcpoffset  = ((TCP_HDRLEN + optlen) / 4) << 4;
+  dev->d_len     += optlen;
 
   /* Complete the common portions of the TCP message */
 
   tcp_sendcommon(dev, conn, tcp);
 }
 
+/****************************************************************************
+ * Name: tcp_synack_cookie
+ *
+ * Description:
+ *   Answer an incoming SYN with a SYNACK that carries a SYN cookie.  No
+ *   connection structure is involved:  The SYNACK is built in place of the
+ *   SYN like a reset.  Only the MSS option is sent because the cookie
+ *   cannot hold the other options.
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure containing the received SYN
+ *   cookie - The SYN cookie to be used as initial sequence number
+ *   mss    - The MSS encoded in the cookie
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SYNCOOKIES
+void tcp_synack_cookie(FAR struct net_driver_s *dev, uint32_t cookie,
+                       uint16_t mss)
+{
+  FAR struct tcp_hdr_s *tcp = tcp_header(dev);
+  uint16_t tcp_mss;
+  uint16_t tmp16;
+
+  /* Acknowledge the SYN of the peer with the cookie as our sequence
+   * number.
+   */
+
+  tcp_setsequence(tcp->ackno, tcp_getsequence(tcp->seqno) + 1);
+  tcp_setsequence(tcp->seqno, cookie);
+
+  /* Swap port numbers. */
+
+  tmp16         = tcp->srcport;
+  tcp->srcport  = tcp->destport;
+  tcp->destport = tmp16;
+
+  /* Set the packet length and swap IP addresses. */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      FAR struct ipv6_hdr_s *ipv6 = IPv6BUF;
+
+      tcp_mss    = TCP_IPv6_MSS(dev);
+      dev->d_len = IPv6TCP_HDRLEN + TCP_OPT_MSS_LEN;
+
+      net_ipv6addr_hdrcopy(ipv6->destipaddr, ipv6->srcipaddr);
+      net_ipv6addr_hdrcopy(ipv6->srcipaddr, dev->d_ipv6addr);
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ipv4 = IPv4BUF;
+
+      tcp_mss    = TCP_IPv4_MSS(dev);
+      dev->d_len = IPv4TCP_HDRLEN + TCP_OPT_MSS_LEN;
+
+      net_ipv4addr_hdrcopy(ipv4->destipaddr, ipv4->srcipaddr);
+      net_ipv4addr_hdrcopy(ipv4->srcipaddr, &dev->d_ipaddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  tcp->flags      = TCP_SYN | TCP_ACK;
+  tcp->tcpoffset  = ((TCP_HDRLEN + TCP_OPT_MSS_LEN) / 4) << 4;
+  tcp->urgp[0]    = 0;
+  tcp->urgp[1]    = 0;
+
+  tcp->optdata[0] = TCP_OPT_MSS;
+  tcp->optdata[1] = TCP_OPT_MSS_LEN;
+  tcp->optdata[2] = tcp_mss >> 8;
+  tcp->optdata[3] = tcp_mss & 0xff;
+
+  /* Without a connection there is no receive buffer budget yet.  Offer a
+   * window of one segment until the connection is recreated by the ACK.
+   */
+
+  tcp->wnd[0]     = mss >> 8;
+  tcp->wnd[1]     = mss & 0xff;
+
+  tcp_sendcomplete(dev, tcp);
+}
+#endif /* CONFIG_NET_TCP_SYNCOOKIES */
+
 #endif /* CONFIG_NET && CONFIG_NET_TCP */
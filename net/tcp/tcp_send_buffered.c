@@ -65,9 +65,11 @@
 #include <nuttx/net/net.h>
 #include <nuttx/mm/iob.h>
 #include <nuttx/net/netdev.h>
+#include <nuttx/net/netstats.h>
 #include <nuttx/net/arp.h>
 #include <nuttx/net/tcp.h>
 #include <nuttx/net/net.h>
+#include <nuttx/semaphore.h>
 
 #include "netdev/netdev.h"
 #include "devif/devif.h"
@@ -189,6 +191,87 @@ static void psock_writebuffer_notify(FAR struct tcp_conn_s *conn)
 #  define psock_writebuffer_notify(conn)
 #endif
 
+/****************************************************************************
+ * Name: psock_sndbuf_used
+ *
+ * Description:
+ *   Return the number of bytes of the connection that are queued in write
+ *   buffers, unsent or waiting for an ACK.
+ *
+ * Input Parameters:
+ *   conn     The connection structure associated with the socket
+ *
+ * Returned Value:
+ *   The number of bytes counted against the send buffer size
+ *
+ ****************************************************************************/
+
+static uint32_t psock_sndbuf_used(FAR struct tcp_conn_s *conn)
+{
+  FAR sq_entry_t *entry;
+  uint32_t used = 0;
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+    {
+      used += TCP_WBPKTLEN((FAR struct tcp_wrbuffer_s *)entry);
+    }
+
+  for (entry = sq_peek(&conn->write_q); entry; entry = sq_next(entry))
+    {
+      used += TCP_WBPKTLEN((FAR struct tcp_wrbuffer_s *)entry);
+    }
+
+  return used;
+}
+
+/****************************************************************************
+ * Name: psock_tso_capable
+ *
+ * Description:
+ *   Check if the device can split a TCP super-segment of the connection
+ *   into segments.  Super-segments are not sent to ourself since looped
+ *   back packets must fit in d_buf.
+ *
+ * Input Parameters:
+ *   dev      The network device
+ *   conn     The connection structure associated with the socket
+ *
+ * Returned Value:
+ *   true if super-segments may be sent
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NETDEV_TSO
+static bool psock_tso_capable(FAR struct net_driver_s *dev,
+                              FAR struct tcp_conn_s *conn)
+{
+  if (!dev->d_txsg || dev->d_tsomax <= conn->mss ||
+      !NETDEV_HAS_FEATURE(dev, NETDEV_FEATURE_TSO) ||
+      !NETDEV_HAS_FEATURE(dev, NETDEV_FEATURE_TXCSUM))
+    {
+      return false;
+    }
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  if (conn->domain == PF_INET)
+#endif
+    {
+      return !net_ipv4addr_cmp(conn->u.ipv4.raddr, dev->d_ipaddr);
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  else
+#endif
+    {
+      return !net_ipv6addr_cmp(conn->u.ipv6.raddr, dev->d_ipv6addr);
+    }
+#endif /* CONFIG_NET_IPv6 */
+}
+#endif
+
 /****************************************************************************
  * Name: psock_lost_connection
  *
@@ -242,6 +325,7 @@ static inline void psock_lost_connection(FAR struct socket *psock,
       /* Notify any waiters if the write buffers have been drained. */
 
       psock_writebuffer_notify(conn);
+      tcp_sndbuf_notify(conn);
 
       conn->sent       = 0;
       conn->sndseq_max = 0;
@@ -291,6 +375,391 @@ static inline void send_ipselect(FAR struct net_driver_s *dev,
 }
 #endif
 
+/****************************************************************************
+ * Name: psock_snd_una
+ *
+ * Description:
+ *   Get the sequence number of the first byte that was sent but not yet
+ *   ACKed.
+ *
+ * Input Parameters:
+ *   conn     The connection structure associated with the socket
+ *   una      The location to return the sequence number
+ *
+ * Returned Value:
+ *   true if there is sent, un-ACKed data
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+static bool psock_snd_una(FAR struct tcp_conn_s *conn, FAR uint32_t *una)
+{
+  FAR struct tcp_wrbuffer_s *wrb;
+
+  /* The unacked_q is in sequence number order and holds older data than a
+   * partially sent write buffer at the head of the write_q.
+   */
+
+  wrb = (FAR struct tcp_wrbuffer_s *)sq_peek(&conn->unacked_q);
+  if (wrb == NULL)
+    {
+      wrb = (FAR struct tcp_wrbuffer_s *)sq_peek(&conn->write_q);
+      if (wrb == NULL || TCP_WBSENT(wrb) == 0)
+        {
+          return false;
+        }
+    }
+
+  *una = TCP_WBSEQNO(wrb);
+  return true;
+}
+
+/****************************************************************************
+ * Name: psock_sack_update
+ *
+ * Description:
+ *   Replace the SACK blocks of the connection with those of the SACK
+ *   option in an incoming ACK.  Blocks that are ACKed or that were not
+ *   sent are ignored.
+ *
+ * Input Parameters:
+ *   conn     The connection structure associated with the socket
+ *   tcp      The TCP header of the incoming ACK
+ *   ackno    The ACK number of the incoming ACK
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_SACK
+static void psock_sack_update(FAR struct tcp_conn_s *conn,
+                              FAR struct tcp_hdr_s *tcp, uint32_t ackno)
+{
+  FAR uint8_t *optdata = (FAR uint8_t *)tcp + TCP_HDRLEN;
+  struct tcp_sack_s sack;
+  int optlen;
+  int i;
+  int j;
+  int k;
+
+  optlen       = ((tcp->tcpoffset >> 4) << 2) - TCP_HDRLEN;
+  conn->nsacks = 0;
+
+  for (i = 0; i < optlen; )
+    {
+      if (optdata[i] == TCP_OPT_END)
+        {
+          break;
+        }
+      else if (optdata[i] == TCP_OPT_NOOP)
+        {
+          i++;
+          continue;
+        }
+      else if (i + 1 >= optlen || optdata[i + 1] < 2 ||
+               i + optdata[i + 1] > optlen)
+        {
+          /* The options are malformed */
+
+          break;
+        }
+
+      if (optdata[i] == TCP_OPT_SACK)
+        {
+          for (j = i + 2; j + TCP_OPT_SACK_BLKLEN <= i + optdata[i + 1];
+               j += TCP_OPT_SACK_BLKLEN)
+            {
+              sack.left  = tcp_getsequence(&optdata[j]);
+              sack.right = tcp_getsequence(&optdata[j + 4]);
+
+              if (conn->nsacks >= TCP_SACK_MAXBLOCKS ||
+                  TCP_SEQ_LTE(sack.right, sack.left) ||
+                  TCP_SEQ_LTE(sack.right, ackno) ||
+                  TCP_SEQ_GT(sack.right, conn->sndseq_max))
+                {
+                  continue;
+                }
+
+              if (TCP_SEQ_LT(sack.left, ackno))
+                {
+                  sack.left = ackno;
+                }
+
+              /* Keep the blocks in ascending order */
+
+              for (k = conn->nsacks;
+                   k > 0 && TCP_SEQ_LT(sack.left, conn->sacks[k - 1].left);
+                   k--)
+                {
+                  conn->sacks[k] = conn->sacks[k - 1];
+                }
+
+              conn->sacks[k] = sack;
+              conn->nsacks++;
+            }
+        }
+
+      i += optdata[i + 1];
+    }
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/****************************************************************************
+ * Name: psock_fastrexmit_next
+ *
+ * Description:
+ *   Select the next segment to retransmit during fast recovery.  This is
+ *   the segment at the ACK number or, if the peer reported SACK blocks,
+ *   the next hole between them that was not yet retransmitted.
+ *
+ * Input Parameters:
+ *   conn     The connection structure associated with the socket
+ *   ackno    The ACK number of the incoming ACK
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void psock_fastrexmit_next(FAR struct tcp_conn_s *conn,
+                                  uint32_t ackno)
+{
+  uint32_t limit = conn->sndseq_max;
+  uint32_t seq = ackno;
+  uint32_t end;
+#ifdef CONFIG_NET_TCP_SACK
+  int i;
+
+  if (conn->nsacks > 0)
+    {
+      /* The holes before rexmitnext have been retransmitted already */
+
+      if (TCP_SEQ_GT(conn->rexmitnext, seq))
+        {
+          seq = conn->rexmitnext;
+        }
+
+      /* Skip the SACKed data.  Only the holes below the highest SACKed
+       * block are known to be lost.
+       */
+
+      for (i = 0; i < conn->nsacks; i++)
+        {
+          if (TCP_SEQ_LT(seq, conn->sacks[i].left))
+            {
+              break;
+            }
+
+          if (TCP_SEQ_LT(seq, conn->sacks[i].right))
+            {
+              seq = conn->sacks[i].right;
+            }
+        }
+
+      if (i >= conn->nsacks)
+        {
+          return;
+        }
+
+      limit = conn->sacks[i].left;
+    }
+#endif
+
+  end = seq + conn->mss;
+  if (TCP_SEQ_GT(end, limit))
+    {
+      end = limit;
+    }
+
+  if (TCP_SEQ_LT(seq, end))
+    {
+      ninfo("REXMIT: fast retransmit seqno=%u len=%u\n", seq, end - seq);
+
+      conn->rexmitseq  = seq;
+      conn->rexmitlen  = end - seq;
+      conn->rexmitnext = end;
+    }
+}
+
+/****************************************************************************
+ * Name: psock_fastrexmit_ack
+ *
+ * Description:
+ *   Count duplicate ACKs, enter fast recovery on the third one and handle
+ *   the partial ACKs during recovery.
+ *
+ * Input Parameters:
+ *   conn     The connection structure associated with the socket
+ *   tcp      The TCP header of the incoming ACK
+ *   una      The first un-ACKed sequence number before this ACK
+ *   ackno    The ACK number of the incoming ACK
+ *   flags    Set of events describing why the callback was invoked
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void psock_fastrexmit_ack(FAR struct tcp_conn_s *conn,
+                                 FAR struct tcp_hdr_s *tcp, uint32_t una,
+                                 uint32_t ackno, uint16_t flags)
+{
+#ifdef CONFIG_NET_TCP_SACK
+  if (conn->sackperm)
+    {
+      psock_sack_update(conn, tcp, ackno);
+    }
+#endif
+
+  if (TCP_SEQ_GT(ackno, una))
+    {
+      /* New data was ACKed */
+
+      conn->dupacks = 0;
+#ifdef CONFIG_NET_TCP_CC
+      if (!conn->recovery)
+        {
+          tcp_cc_ack(conn, ackno - una);
+        }
+#endif
+
+      if (conn->recovery)
+        {
+          if (TCP_SEQ_GTE(ackno, conn->recover))
+            {
+              /* All data sent before the loss was detected is ACKed */
+
+              ninfo("REXMIT: leave fast recovery ackno=%u\n", ackno);
+
+              conn->recovery  = false;
+              conn->rexmitlen = 0;
+            }
+          else
+            {
+              /* A partial ACK:  More data was lost in the same window.
+               * Retransmit it now rather than after a timeout.
+               */
+
+              psock_fastrexmit_next(conn, ackno);
+            }
+        }
+    }
+  else if (ackno == una && (flags & TCP_NEWDATA) == 0)
+    {
+      /* A duplicate ACK:  The peer received a segment out of order */
+
+      if (!conn->recovery)
+        {
+          if (++conn->dupacks >= TCP_FAST_REXMIT_THRESH)
+            {
+              ninfo("REXMIT: enter fast recovery ackno=%u\n", ackno);
+
+              conn->recovery   = true;
+              conn->recover    = conn->sndseq_max;
+              conn->rexmitnext = ackno;
+#ifdef CONFIG_NET_TCP_CC
+              tcp_cc_loss(conn, false);
+#endif
+              psock_fastrexmit_next(conn, ackno);
+            }
+        }
+#ifdef CONFIG_NET_TCP_SACK
+      else if (conn->nsacks > 0)
+        {
+          /* Each further duplicate ACK means that a segment has left the
+           * network, so retransmit the next hole.
+           */
+
+          psock_fastrexmit_next(conn, ackno);
+        }
+#endif
+    }
+}
+
+/****************************************************************************
+ * Name: psock_fastrexmit_send
+ *
+ * Description:
+ *   Send the data selected for fast retransmission.  The data is sent
+ *   again from the write buffer holding it; the write buffer queues and
+ *   the counts of sent data are not changed.
+ *
+ * Input Parameters:
+ *   dev      The structure of the network driver that caused the event
+ *   conn     The connection structure associated with the socket
+ *
+ * Returned Value:
+ *   true if a segment was set up for sending
+ *
+ ****************************************************************************/
+
+static bool psock_fastrexmit_send(FAR struct net_driver_s *dev,
+                                  FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_wrbuffer_s *wrb = NULL;
+  FAR sq_entry_t *entry;
+  uint32_t offset;
+  uint32_t sndlen;
+
+  /* Find the write buffer that holds the data.  It is either in the
+   * unacked_q or the partially sent head of the write_q.
+   */
+
+  for (entry = sq_peek(&conn->unacked_q); entry; entry = sq_next(entry))
+    {
+      wrb = (FAR struct tcp_wrbuffer_s *)entry;
+      if (TCP_SEQ_GTE(conn->rexmitseq, TCP_WBSEQNO(wrb)) &&
+          TCP_SEQ_LT(conn->rexmitseq, TCP_WBSEQNO(wrb) + TCP_WBSENT(wrb)))
+        {
+          break;
+        }
+    }
+
+  if (entry == NULL)
+    {
+      wrb = (FAR struct tcp_wrbuffer_s *)sq_peek(&conn->write_q);
+      if (wrb == NULL ||
+          TCP_SEQ_LT(conn->rexmitseq, TCP_WBSEQNO(wrb)) ||
+          TCP_SEQ_GTE(conn->rexmitseq, TCP_WBSEQNO(wrb) + TCP_WBSENT(wrb)))
+        {
+          /* The data was ACKed meanwhile */
+
+          conn->rexmitlen = 0;
+          return false;
+        }
+    }
+
+  offset = conn->rexmitseq - TCP_WBSEQNO(wrb);
+  sndlen = conn->rexmitlen;
+  if (sndlen > TCP_WBSENT(wrb) - offset)
+    {
+      sndlen = TCP_WBSENT(wrb) - offset;
+    }
+
+  ninfo("REXMIT: wrb=%p seqno=%u offset=%u sndlen=%u\n",
+        wrb, conn->rexmitseq, offset, sndlen);
+
+  tcp_setsequence(conn->sndseq, conn->rexmitseq);
+
+#ifdef NEED_IPDOMAIN_SUPPORT
+  send_ipselect(dev, conn);
+#endif
+
+  devif_iob_sendsg(dev, TCP_WBIOB(wrb), sndlen, offset);
+
+#ifdef CONFIG_NET_STATISTICS
+  g_netstats.tcp.rexmit++;
+#endif
+
+  /* The rest is sent on the next poll if the data spans write buffers */
+
+  conn->rexmitseq += sndlen;
+  conn->rexmitlen -= sndlen;
+  return true;
+}
+#endif /* CONFIG_NET_TCP_FAST_RETRANSMIT */
+
 /****************************************************************************
  * Name: psock_send_eventhandler
  *
@@ -341,6 +810,10 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       FAR sq_entry_t *entry;
       FAR sq_entry_t *next;
       uint32_t ackno;
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+      uint32_t una = 0;
+      bool outstanding;
+#endif
 
       /* Get the offset address of the TCP header */
 
@@ -369,6 +842,12 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       ackno = tcp_getsequence(tcp->ackno);
       ninfo("ACK: ackno=%u flags=%04x\n", ackno, flags);
 
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+      /* Remember where the un-ACKed data started to detect duplicate ACKs */
+
+      outstanding = psock_snd_una(conn, &una);
+#endif
+
       /* Look at every write buffer in the unacked_q.  The unacked_q
        * holds write buffers that have been entirely sent, but which
        * have not yet been ACKed.
@@ -481,6 +960,17 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           ninfo("ACK: wrb=%p seqno=%u pktlen=%u sent=%u\n",
                 wrb, TCP_WBSEQNO(wrb), TCP_WBPKTLEN(wrb), TCP_WBSENT(wrb));
         }
+
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+      if (outstanding)
+        {
+          psock_fastrexmit_ack(conn, tcp, una, ackno, flags);
+        }
+#endif
+
+      /* The ACKed data no longer counts against the send buffer */
+
+      tcp_sndbuf_notify(conn);
     }
 
   /* Check for a loss of connection */
@@ -516,6 +1006,19 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
 
       ninfo("REXMIT: %04x\n", flags);
 
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+      /* The timeout ends any fast recovery; all un-ACKed data is resent */
+
+      conn->dupacks   = 0;
+      conn->recovery  = false;
+      conn->rexmitlen = 0;
+#endif
+#ifdef CONFIG_NET_TCP_CC
+      /* Restart in slow start.  tx_unacked still includes the lost data. */
+
+      tcp_cc_loss(conn, true);
+#endif
+
       /* If there is a partially sent write buffer at the head of the
        * write_q?  Has anything been sent from that write buffer?
        */
@@ -679,6 +1182,29 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
       return flags;
     }
 
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+  /* Retransmit lost data before any new data.  This is done in response to
+   * the ACK that reported the loss, unless that ACK carries data that is
+   * still unprocessed in d_buf.  Then wait for the poll instead.
+   */
+
+  if ((conn->tcpstateflags & TCP_ESTABLISHED) && conn->rexmitlen > 0 &&
+      (flags & (TCP_POLL | TCP_ACKDATA)) != 0)
+    {
+      if ((flags & TCP_NEWDATA) != 0)
+        {
+          netdev_txnotify_dev(dev);
+        }
+      else if (psock_fastrexmit_send(dev, conn))
+        {
+          /* Only one data can be sent by low level driver at once */
+
+          flags &= ~TCP_POLL;
+          return flags;
+        }
+    }
+#endif
+
   /* We get here if (1) not all of the data has been ACKed, (2) we have been
    * asked to retransmit data, (3) the connection is still healthy, and (4)
    * the outgoing packet is available for our use.  In this case, we are
@@ -690,6 +1216,9 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
   if ((conn->tcpstateflags & TCP_ESTABLISHED) &&
       (flags & (TCP_POLL | TCP_REXMIT)) &&
       !(sq_empty(&conn->write_q)) &&
+#ifdef CONFIG_NET_TCP_CC
+      TCP_CC_CANSEND(conn) &&
+#endif
       conn->winsize > 0)
     {
       FAR struct tcp_wrbuffer_s *wrb;
@@ -711,6 +1240,18 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
        */
 
       sndlen = TCP_WBPKTLEN(wrb) - TCP_WBSENT(wrb);
+#ifdef CONFIG_NETDEV_TSO
+      if (sndlen > conn->mss && psock_tso_capable(dev, conn))
+        {
+          /* Send a super-segment that the hardware splits */
+
+          if (sndlen > dev->d_tsomax)
+            {
+              sndlen = dev->d_tsomax;
+            }
+        }
+      else
+#endif
       if (sndlen > conn->mss)
         {
           sndlen = conn->mss;
@@ -721,6 +1262,24 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
           sndlen = conn->winsize;
         }
 
+#ifdef CONFIG_NET_TCP_CC
+      /* Don't exceed the congestion window, but always allow one segment
+       * when nothing is in flight.
+       */
+
+      if (conn->tx_unacked > 0 && sndlen > TCP_CC_AVAIL(conn))
+        {
+          sndlen = TCP_CC_AVAIL(conn);
+        }
+#endif
+
+#ifdef CONFIG_NETDEV_TSO
+      if (sndlen > conn->mss)
+        {
+          dev->d_txmss = conn->mss;
+        }
+#endif
+
       ninfo("SEND: wrb=%p pktlen=%u sent=%u sndlen=%u mss=%u "
             "winsize=%u\n",
             wrb, TCP_WBPKTLEN(wrb), TCP_WBSENT(wrb), sndlen, conn->mss,
@@ -759,7 +1318,7 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
        * won't actually happen until the polling cycle completes).
        */
 
-      devif_iob_send(dev, TCP_WBIOB(wrb), sndlen, TCP_WBSENT(wrb));
+      devif_iob_sendsg(dev, TCP_WBIOB(wrb), sndlen, TCP_WBSENT(wrb));
 
       /* Remember how much data we send out now so that we know
        * when everything has been acknowledged.  Just increment
@@ -1005,6 +1564,46 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
        */
 
       net_lock();
+
+      /* Wait until the queued data of the socket is below the send buffer
+       * size.  A blocking send may then queue all of its data, so the
+       * budget is exceeded by at most one send.
+       */
+
+      while (conn->snd_bufs > 0 && psock_sndbuf_used(conn) >= conn->snd_bufs)
+        {
+          if (nonblock)
+            {
+              ret = -EAGAIN;
+              goto errout_with_lock;
+            }
+
+          ret = net_lockedwait(&conn->snd_sem);
+          if (ret < 0)
+            {
+              goto errout_with_lock;
+            }
+
+          if (!_SS_ISCONNECTED(psock->s_flags))
+            {
+              nerr("ERROR: Disconnected while waiting for the buffer\n");
+              ret = -ENOTCONN;
+              goto errout_with_lock;
+            }
+        }
+
+      /* A non-blocking send queues no more than the rest of the budget */
+
+      if (nonblock && conn->snd_bufs > 0)
+        {
+          uint32_t avail = conn->snd_bufs - psock_sndbuf_used(conn);
+
+          if (len > avail)
+            {
+              len = avail;
+            }
+        }
+
       if (nonblock)
         {
           wrb = tcp_wrbuffer_tryalloc();
@@ -1153,6 +1752,34 @@ errout:
   return ret;
 }
 
+/****************************************************************************
+ * Name: tcp_sndbuf_notify
+ *
+ * Description:
+ *   Wake up the senders that wait for room in the send buffer of the
+ *   connection.  They check the budget again when they run.
+ *
+ * Input Parameters:
+ *   conn     The connection structure associated with the socket
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_sndbuf_notify(FAR struct tcp_conn_s *conn)
+{
+  int semcount;
+
+  while (nxsem_getvalue(&conn->snd_sem, &semcount) >= 0 && semcount < 0)
+    {
+      nxsem_post(&conn->snd_sem);
+    }
+}
+
 /****************************************************************************
  * Name: psock_tcp_cansend
  *
@@ -1179,6 +1806,8 @@ errout:
 
 int psock_tcp_cansend(FAR struct socket *psock)
 {
+  FAR struct tcp_conn_s *conn;
+
   /* Verify that we received a valid socket */
 
   if (!psock || psock->s_crefs <= 0)
@@ -1209,6 +1838,14 @@ int psock_tcp_cansend(FAR struct socket *psock)
       return -EWOULDBLOCK;
     }
 
+  /* Nor can it if the send buffer size of the socket is used up */
+
+  conn = (FAR struct tcp_conn_s *)psock->s_conn;
+  if (conn->snd_bufs > 0 && psock_sndbuf_used(conn) >= conn->snd_bufs)
+    {
+      return -EWOULDBLOCK;
+    }
+
   return OK;
 }
 
@@ -57,6 +57,7 @@
 #include <arch/irq.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/arp.h>
@@ -98,6 +99,7 @@ struct sendfile_s
   FAR struct devif_callback_s *snd_datacb; /* Data callback */
   FAR struct devif_callback_s *snd_ackcb;  /* ACK callback */
   FAR struct file   *snd_file;    /* File structure of the input file */
+  FAR const uint8_t *snd_addr;    /* Memory address of the file or NULL */
   sem_t              snd_sem;     /* Used to wake up the waiting thread */
   off_t              snd_foffset; /* Input file offset */
   size_t             snd_flen;    /* File length */
@@ -305,21 +307,47 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
            * happen until the polling cycle completes).
            */
 
-          ret = file_seek(pstate->snd_file,
-                          pstate->snd_foffset + pstate->snd_sent, SEEK_SET);
-          if (ret < 0)
+          if (pstate->snd_addr != NULL)
             {
-              nerr("ERROR: Failed to lseek: %d\n", ret);
-              pstate->snd_sent = ret;
-              goto end_wait;
-            }
+              /* The file is memory mapped:  Copy the data straight from the
+               * media into the packet.
+               */
 
-          ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
-          if (ret < 0)
+              memcpy(dev->d_appdata, pstate->snd_addr +
+                     pstate->snd_foffset + pstate->snd_sent, sndlen);
+            }
+          else
             {
-              nerr("ERROR: Failed to read from input file: %d\n", (int)ret);
-              pstate->snd_sent = ret;
-              goto end_wait;
+              ret = file_seek(pstate->snd_file,
+                              pstate->snd_foffset + pstate->snd_sent,
+                              SEEK_SET);
+              if (ret < 0)
+                {
+                  nerr("ERROR: Failed to lseek: %d\n", ret);
+                  pstate->snd_sent = ret;
+                  goto end_wait;
+                }
+
+              ret = file_read(pstate->snd_file, dev->d_appdata, sndlen);
+              if (ret < 0)
+                {
+                  nerr("ERROR: Failed to read from input file: %d\n",
+                       (int)ret);
+                  pstate->snd_sent = ret;
+                  goto end_wait;
+                }
+
+              if (ret == 0)
+                {
+                  /* End of file.  Just wait for the data already sent to
+                   * be ACKed.
+                   */
+
+                  pstate->snd_flen = pstate->snd_sent;
+                  goto end_file;
+                }
+
+              sndlen = ret;
             }
 
           dev->d_sndlen = sndlen;
@@ -351,6 +379,7 @@ static uint16_t sendfile_eventhandler(FAR struct net_driver_s *dev,
         }
     }
 
+end_file:
   if (pstate->snd_sent >= pstate->snd_flen
       && pstate->snd_acked < pstate->snd_flen)
     {
@@ -451,6 +480,10 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
 {
   FAR struct tcp_conn_s *conn;
   struct sendfile_s state;
+  FAR void *addr = NULL;
+  struct stat buf;
+  off_t foffset;
+  off_t fpos;
   int ret;
 
   /* If this is an un-connected socket, then return ENOTCONN */
@@ -497,6 +530,30 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
     }
 #endif /* CONFIG_NET_ARP_SEND || CONFIG_NET_ICMPv6_NEIGHBOR */
 
+  /* Start at the current file position if no offset is provided */
+
+  fpos    = infile->f_pos;
+  foffset = offset ? *offset : fpos;
+
+  /* If the file system can provide the address of the file, the data can
+   * be sent without any read() calls from the network driver poll.  The
+   * file size limits the transfer in that case.
+   */
+
+  if (file_ioctl(infile, FIOC_MMAP, (unsigned long)((uintptr_t)&addr)) < 0 ||
+      file_fstat(infile, &buf) < 0)
+    {
+      addr = NULL;
+    }
+  else if (foffset >= buf.st_size)
+    {
+      return 0;
+    }
+  else if (count > buf.st_size - foffset)
+    {
+      count = buf.st_size - foffset;
+    }
+
   /* Initialize the state structure.  This is done with the network
    * locked because we don't want anything to happen until we are
    * ready.
@@ -513,9 +570,10 @@ ssize_t tcp_sendfile(FAR struct socket *psock, FAR struct file *infile,
   nxsem_setprotocol(&state.snd_sem, SEM_PRIO_NONE);
 
   state.snd_sock    = psock;                /* Socket descriptor to use */
-  state.snd_foffset = offset ? *offset : 0; /* Input file offset */
+  state.snd_foffset = foffset;              /* Input file offset */
   state.snd_flen    = count;                /* Number of bytes to send */
   state.snd_file    = infile;               /* File to read from */
+  state.snd_addr    = addr;                 /* File in memory or NULL */
 
   /* Allocate resources to receive a callback */
 
@@ -589,10 +647,25 @@ errout_locked:
     {
       return ret;
     }
-  else
+
+  if (state.snd_sent > 0)
     {
-      return state.snd_sent;
+      /* Return the offset following the data sent.  The file position is
+       * only updated if no offset was provided.
+       */
+
+      if (offset != NULL)
+        {
+          *offset = foffset + state.snd_sent;
+          file_seek(infile, fpos, SEEK_SET);
+        }
+      else
+        {
+          file_seek(infile, foffset + state.snd_sent, SEEK_SET);
+        }
     }
+
+  return state.snd_sent;
 }
 
 #endif /* CONFIG_NET_SENDFILE && CONFIG_NET_TCP && NET_TCP_HAVE_STACK */
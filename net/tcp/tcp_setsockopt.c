@@ -87,9 +87,10 @@
 int tcp_setsockopt(FAR struct socket *psock, int option,
                    FAR const void *value, socklen_t value_len)
 {
-#ifdef CONFIG_NET_TCP_KEEPALIVE
-  /* Keep alive options are the only TCP protocol socket option currently
-   * supported.
+#if defined(CONFIG_NET_TCP_KEEPALIVE) || defined(CONFIG_NET_TCP_CC) || \
+    defined(CONFIG_NET_TCP_DELAYED_ACK)
+  /* Keep alive, congestion control and delayed ACK options are the only TCP
+   * protocol socket options currently supported.
    */
 
   FAR struct tcp_conn_s *conn;
@@ -109,10 +110,11 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
       return -ENOTCONN;
     }
 
-  /* Handle the Keep-Alive option */
+  /* Handle the Keep-Alive, congestion control and delayed ACK options */
 
   switch (option)
     {
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       /* Handle the SO_KEEPALIVE socket-level option.
        *
        * NOTE: SO_KEEPALIVE is not really a socket-level option; it is a
@@ -146,12 +148,14 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
               }
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
 
       case TCP_NODELAY: /* Avoid coalescing of small segments. */
         nerr("ERROR: TCP_NODELAY not supported\n");
         ret = -ENOSYS;
         break;
 
+#ifdef CONFIG_NET_TCP_KEEPALIVE
       case TCP_KEEPIDLE:  /* Start keepalives after this IDLE period */
         if (value_len != sizeof(struct timeval))
           {
@@ -250,6 +254,42 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
               }
           }
         break;
+#endif /* CONFIG_NET_TCP_KEEPALIVE */
+
+#ifdef CONFIG_NET_TCP_CC
+      case TCP_CONGESTION: /* Congestion control algorithm */
+        if (value_len == 0)
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            /* Lock the network so that the algorithm does not change while
+             * the connection is processing an ACK.
+             */
+
+            net_lock();
+            ret = tcp_cc_select(conn, (FAR const char *)value, value_len);
+            net_unlock();
+          }
+        break;
+#endif
+
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+      case TCP_QUICKACK:  /* Do not delay ACKs */
+        if (value_len != sizeof(int))
+          {
+            ret = -EDOM;
+          }
+        else
+          {
+            /* An ACK that is already delayed is still sent by the timer */
+
+            conn->quickack = *(FAR const int *)value != 0;
+            ret = OK;
+          }
+        break;
+#endif
 
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
@@ -260,7 +300,7 @@ int tcp_setsockopt(FAR struct socket *psock, int option,
   return ret;
 #else
   return -ENOPROTOOPT;
-#endif /* CONFIG_NET_TCP_KEEPALIVE */
+#endif /* CONFIG_NET_TCP_KEEPALIVE || CONFIG_NET_TCP_CC || ... */
 }
 
 #endif /* CONFIG_NET_TCPPROTO_OPTIONS */
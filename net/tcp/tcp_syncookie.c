@@ -0,0 +1,337 @@
+/****************************************************************************
+ * net/tcp/tcp_syncookie.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && \
+    defined(CONFIG_NET_TCP_SYNCOOKIES)
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#include <sys/random.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/netconfig.h>
+#include <nuttx/net/netdev.h>
+#include <nuttx/net/ip.h>
+#include <nuttx/net/tcp.h>
+
+#include "devif/devif.h"
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define IPv4BUF ((FAR struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+#define IPv6BUF ((FAR struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
+
+/* Layout of a SYN cookie:
+ *
+ *   Bits 27-31: Counter of 64 second periods when the cookie was made
+ *   Bits 24-26: Index of the MSS in g_tcp_cookie_mss[]
+ *   Bits  0-23: Keyed hash of the addresses, the ports, the initial
+ *               sequence number of the peer and the counter
+ */
+
+#define COOKIE_COUNT_SHIFT   27
+#define COOKIE_COUNT_MASK    0x1f
+#define COOKIE_MSS_SHIFT     24
+#define COOKIE_MSS_MASK      0x07
+#define COOKIE_HASH_MASK     0x00ffffff
+
+/* Cookies are accepted if they were made in the current or the previous
+ * period, that is during the last 64 to 128 seconds.
+ */
+
+#define COOKIE_PERIOD        (64 * CLK_TCK)
+#define COOKIE_MAXAGE        1
+
+#define ROTL64(x, b)         (((x) << (b)) | ((x) >> (64 - (b))))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The MSS values that can be encoded in a cookie */
+
+static const uint16_t g_tcp_cookie_mss[COOKIE_MSS_MASK + 1] =
+{
+  64, 256, 536, 1220, 1440, 1460, 4312, 8960
+};
+
+/* The secret key of the cookie hash */
+
+static uint64_t g_tcp_cookie_key[2];
+static bool g_tcp_cookie_keyvalid;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cookie_initkey
+ *
+ * Description:
+ *   Select the secret key when the first cookie is made.  Only the random
+ *   pool provides a key that cannot be guessed.
+ *
+ ****************************************************************************/
+
+static void tcp_cookie_initkey(void)
+{
+#ifdef CONFIG_CRYPTO_RANDOM_POOL
+  getrandom(g_tcp_cookie_key, sizeof(g_tcp_cookie_key));
+#else
+  uint64_t seed = clock_systime_ticks();
+
+  g_tcp_cookie_key[0] = seed ^ (uintptr_t)&seed;
+  g_tcp_cookie_key[1] = ROTL64(seed, 32) ^ (uintptr_t)g_tcp_cookie_mss;
+#endif
+
+  g_tcp_cookie_keyvalid = true;
+}
+
+/****************************************************************************
+ * Name: tcp_sipround
+ ****************************************************************************/
+
+static void tcp_sipround(FAR uint64_t *v)
+{
+  v[0] += v[1];
+  v[1]  = ROTL64(v[1], 13) ^ v[0];
+  v[0]  = ROTL64(v[0], 32);
+  v[2] += v[3];
+  v[3]  = ROTL64(v[3], 16) ^ v[2];
+  v[0] += v[3];
+  v[3]  = ROTL64(v[3], 21) ^ v[0];
+  v[2] += v[1];
+  v[1]  = ROTL64(v[1], 17) ^ v[2];
+  v[2]  = ROTL64(v[2], 32);
+}
+
+/****************************************************************************
+ * Name: tcp_siphash
+ *
+ * Description:
+ *   Return the SipHash-2-4 of an array of 32-bit words with the secret key.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_siphash(FAR const uint32_t *data, unsigned int nwords)
+{
+  uint64_t v[4];
+  uint64_t m;
+  unsigned int i;
+
+  v[0] = g_tcp_cookie_key[0] ^ 0x736f6d6570736575ull;
+  v[1] = g_tcp_cookie_key[1] ^ 0x646f72616e646f6dull;
+  v[2] = g_tcp_cookie_key[0] ^ 0x6c7967656e657261ull;
+  v[3] = g_tcp_cookie_key[1] ^ 0x7465646279746573ull;
+
+  for (i = 0; i + 2 <= nwords; i += 2)
+    {
+      m     = ((uint64_t)data[i + 1] << 32) | data[i];
+      v[3] ^= m;
+      tcp_sipround(v);
+      tcp_sipround(v);
+      v[0] ^= m;
+    }
+
+  m = (uint64_t)(nwords << 2) << 56;
+  if (i < nwords)
+    {
+      m |= data[i];
+    }
+
+  v[3] ^= m;
+  tcp_sipround(v);
+  tcp_sipround(v);
+  v[0] ^= m;
+
+  v[2] ^= 0xff;
+  for (i = 0; i < 4; i++)
+    {
+      tcp_sipround(v);
+    }
+
+  return (uint32_t)(v[0] ^ v[1] ^ v[2] ^ v[3]);
+}
+
+/****************************************************************************
+ * Name: tcp_cookie_hash
+ *
+ * Description:
+ *   Return the hash part of the cookie of an incoming segment.
+ *
+ * Input Parameters:
+ *   dev   - The device driver structure containing the received segment
+ *   tcp   - The TCP header of the segment
+ *   isn   - The initial sequence number of the peer
+ *   count - The period counter of the cookie
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cookie_hash(FAR struct net_driver_s *dev,
+                                FAR struct tcp_hdr_s *tcp,
+                                uint32_t isn, uint32_t count)
+{
+  uint32_t data[11];
+  unsigned int n;
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+  if (IFF_IS_IPv6(dev->d_flags))
+#endif
+    {
+      FAR struct ipv6_hdr_s *ip = IPv6BUF;
+
+      memcpy(&data[0], ip->destipaddr, 16);
+      memcpy(&data[4], ip->srcipaddr, 16);
+      n = 8;
+    }
+#endif /* CONFIG_NET_IPv6 */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+  else
+#endif
+    {
+      FAR struct ipv4_hdr_s *ip = IPv4BUF;
+
+      memcpy(&data[0], ip->destipaddr, 4);
+      memcpy(&data[1], ip->srcipaddr, 4);
+      n = 2;
+    }
+#endif /* CONFIG_NET_IPv4 */
+
+  data[n++] = ((uint32_t)tcp->destport << 16) | tcp->srcport;
+  data[n++] = isn;
+  data[n++] = count & COOKIE_COUNT_MASK;
+
+  return tcp_siphash(data, n) & COOKIE_HASH_MASK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_syncookie
+ *
+ * Description:
+ *   Return the SYN cookie to be used as initial sequence number in the
+ *   SYNACK response to an incoming SYN.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure containing the received SYN
+ *   tcp - The TCP header of the SYN
+ *   mss - The MSS negotiated for the connection.  The cookie encodes the
+ *         largest supported value not above it.
+ *
+ * Returned Value:
+ *   The cookie
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+uint32_t tcp_syncookie(FAR struct net_driver_s *dev,
+                       FAR struct tcp_hdr_s *tcp, uint16_t mss)
+{
+  uint32_t count = clock_systime_ticks() / COOKIE_PERIOD;
+  uint32_t index;
+
+  if (!g_tcp_cookie_keyvalid)
+    {
+      tcp_cookie_initkey();
+    }
+
+  for (index = COOKIE_MSS_MASK; index > 0; index--)
+    {
+      if (g_tcp_cookie_mss[index] <= mss)
+        {
+          break;
+        }
+    }
+
+  return ((count & COOKIE_COUNT_MASK) << COOKIE_COUNT_SHIFT) |
+         (index << COOKIE_MSS_SHIFT) |
+         tcp_cookie_hash(dev, tcp, tcp_getsequence(tcp->seqno), count);
+}
+
+/****************************************************************************
+ * Name: tcp_syncookie_check
+ *
+ * Description:
+ *   Check whether an incoming ACK for a listening port acknowledges the
+ *   SYNACK of a valid SYN cookie.
+ *
+ * Input Parameters:
+ *   dev - The device driver structure containing the received ACK
+ *   tcp - The TCP header of the ACK
+ *   mss - The location to return the MSS encoded in the cookie
+ *
+ * Returned Value:
+ *   Zero (OK) if the cookie is valid; -EINVAL otherwise.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int tcp_syncookie_check(FAR struct net_driver_s *dev,
+                        FAR struct tcp_hdr_s *tcp, FAR uint16_t *mss)
+{
+  uint32_t cookie = tcp_getsequence(tcp->ackno) - 1;
+  uint32_t count = clock_systime_ticks() / COOKIE_PERIOD;
+  uint32_t age;
+
+  if (!g_tcp_cookie_keyvalid)
+    {
+      return -EINVAL;
+    }
+
+  age = (count - (cookie >> COOKIE_COUNT_SHIFT)) & COOKIE_COUNT_MASK;
+  if (age > COOKIE_MAXAGE)
+    {
+      return -EINVAL;
+    }
+
+  if ((cookie & COOKIE_HASH_MASK) !=
+      tcp_cookie_hash(dev, tcp, tcp_getsequence(tcp->seqno) - 1,
+                      count - age))
+    {
+      return -EINVAL;
+    }
+
+  *mss = g_tcp_cookie_mss[(cookie >> COOKIE_MSS_SHIFT) & COOKIE_MSS_MASK];
+  return OK;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCP_SYNCOOKIES */
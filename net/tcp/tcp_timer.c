@@ -103,6 +103,20 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   uint16_t result;
   uint8_t hdrlen;
 
+  /* Only the device that the connection is bound to runs its timers.
+   * Every device calls devif_timer() with the time that elapsed for it, so
+   * with several devices the timers would otherwise advance several times
+   * as fast and time out early.  This also skips the rest of the work for
+   * the connections of the other devices.
+   */
+
+  if (conn->dev != NULL && conn->dev != dev)
+    {
+      dev->d_len    = 0;
+      dev->d_sndlen = 0;
+      return;
+    }
+
   /* Set up for the callback.  We can't know in advance if the application
    * is going to send a IPv4 or an IPv6 packet, so this setup may not
    * actually be used.  Furthermore, the TCP logic is required to call
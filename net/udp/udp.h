@@ -49,6 +49,10 @@
 #include <nuttx/net/ip.h>
 #include <nuttx/mm/iob.h>
 
+#ifdef CONFIG_NET_TIMESTAMP
+#  include <nuttx/net/netdev.h>
+#endif
+
 #ifdef CONFIG_NET_UDP_NOTIFIER
 #  include <nuttx/wqueue.h>
 #endif
@@ -126,6 +130,9 @@ struct udp_conn_s
 
   /* UDP-specific content follows */
 
+#ifdef CONFIG_NET_UDP_HASH
+  dq_entry_t hnode;       /* Link in the hash table of local ports */
+#endif
   union ip_binding_u u;   /* IP address binding */
   uint16_t lport;         /* Bound local port number (network byte order) */
   uint16_t rport;         /* Remote port number (network byte order) */
@@ -143,19 +150,30 @@ struct udp_conn_s
    *
    *   readahead - A singly linked list of type struct iob_qentry_s
    *               where the UDP/IP read-ahead data is retained.
+   *   rcv_bufs  - The receive buffer size (SO_RCVBUF) in bytes.  Datagrams
+   *               that do not fit in the rest of this budget are dropped.
+   *               Zero means no limit.
    */
 
   struct iob_queue_s readahead;   /* Read-ahead buffering */
+  uint32_t rcv_bufs;              /* Receive buffer size (bytes) */
+
+#ifdef CONFIG_NET_TIMESTAMP
+  struct net_tstamp_s tstamp;     /* SO_TIMESTAMP/SO_TIMESTAMPING state */
+#endif
 
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
   /* Write buffering
    *
    *   write_q   - The queue of unsent I/O buffers.  The head of this
    *               list may be partially sent.  FIFO ordering.
+   *   gso_size  - The segment size (UDP_SEGMENT).  A larger send is split
+   *               into datagrams of this size.  Zero means no splitting.
    */
 
   sq_queue_t write_q;             /* Write buffering for UDP packets */
   FAR struct net_driver_s *dev;   /* Last device */
+  uint16_t gso_size;              /* Segment size of sends */
 #endif
 
   /* The following is a list of poll structures of threads waiting for
@@ -663,6 +681,31 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR void *buf,
                            size_t len, int flags, FAR struct sockaddr *from,
                            FAR socklen_t *fromlen);
 
+/****************************************************************************
+ * Name: psock_udp_recvmsg
+ *
+ * Description:
+ *   Perform the recvmsg operation for a UDP SOCK_DGRAM.  The receive
+ *   timestamps selected by SO_TIMESTAMP and SO_TIMESTAMPING are returned
+ *   as control data.  With MSG_ERRQUEUE, the pending transmit timestamps
+ *   are returned instead of a datagram.
+ *
+ * Input Parameters:
+ *   psock  Pointer to the socket structure for the SOCK_DRAM socket
+ *   msg    The message header
+ *   flags  Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On  error,
+ *   -errno is returned (see recvmsg for list of errnos).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMP
+ssize_t psock_udp_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                          int flags);
+#endif
+
 /****************************************************************************
  * Name: psock_udp_sendto
  *
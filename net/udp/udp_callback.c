@@ -50,6 +50,7 @@
 #include <nuttx/net/udp.h>
 
 #include "devif/devif.h"
+#include "netdev/netdev.h"
 #include "udp/udp.h"
 
 /****************************************************************************
@@ -66,6 +67,29 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: udp_readahead_len
+ *
+ * Description:
+ *   Return the number of bytes retained in the UDP read-ahead buffer,
+ *   including the source address info of each datagram.
+ *
+ ****************************************************************************/
+
+static uint32_t udp_readahead_len(FAR struct udp_conn_s *conn)
+{
+  FAR struct iob_qentry_s *qentry;
+  uint32_t len = 0;
+
+  for (qentry = conn->readahead.qh_head; qentry != NULL;
+       qentry = qentry->qe_flink)
+    {
+      len += qentry->qe_head->io_pktlen;
+    }
+
+  return len;
+}
+
 /****************************************************************************
  * Name: udp_datahandler
  *
@@ -98,14 +122,12 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
   FAR void  *src_addr;
   uint8_t src_addr_size;
 
-  /* Allocate on I/O buffer to start the chain (throttling as necessary).
-   * We will not wait for an I/O buffer to become available in this context.
-   */
+  /* Drop the datagram if it does not fit in the receive buffer */
 
-  iob = iob_tryalloc(true, IOBUSER_NET_UDP_READAHEAD);
-  if (iob == NULL)
+  if (conn->rcv_bufs > 0 &&
+      udp_readahead_len(conn) + buflen > conn->rcv_bufs)
     {
-      nerr("ERROR: Failed to create new I/O buffer chain\n");
+      ninfo("Receive buffer is full\n");
       return 0;
     }
 
@@ -173,43 +195,51 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
     }
 #endif /* CONFIG_NET_IPv4 */
 
-  /* Copy the src address info into the I/O buffer chain.  We will not wait
-   * for an I/O buffer to become available in this context.  It there is
-   * any failure to allocated, the entire I/O buffer chain will be discarded.
+#ifdef CONFIG_NETDEV_IOB_RX
+  /* Try to queue the I/O buffer that holds the received frame instead of
+   * copying the data.  The src address info then replaces the headers in
+   * front of the payload.
    */
 
-  ret = iob_trycopyin(iob, (FAR const uint8_t *)&src_addr_size,
-                      sizeof(uint8_t), 0, true, IOBUSER_NET_UDP_READAHEAD);
-  if (ret < 0)
+  iob = NULL;
+  if (buffer - dev->d_buf >= src_addr_size + sizeof(uint8_t))
     {
-      /* On a failure, iob_trycopyin return a negated error value but does
-       * not free any I/O buffers.
-       */
-
-      nerr("ERROR: Failed to add data to the I/O buffer chain: %d\n", ret);
-      iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
-      return 0;
+      iob = netdev_iob_take(dev, buffer, buflen);
     }
 
-  ret = iob_trycopyin(iob, (FAR const uint8_t *)src_addr, src_addr_size,
-                      sizeof(uint8_t), true, IOBUSER_NET_UDP_READAHEAD);
-  if (ret < 0)
+  if (iob != NULL)
     {
-      /* On a failure, iob_trycopyin return a negated error value but does
-       * not free any I/O buffers.
-       */
+      iob->io_offset -= src_addr_size + sizeof(uint8_t);
+      iob->io_len    += src_addr_size + sizeof(uint8_t);
+      iob->io_pktlen  = iob->io_len;
 
-      nerr("ERROR: Failed to add data to the I/O buffer chain: %d\n", ret);
-      iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
-      return 0;
+      iob->io_data[iob->io_offset] = src_addr_size;
+      memcpy(&iob->io_data[iob->io_offset + sizeof(uint8_t)], src_addr,
+             src_addr_size);
     }
-
-  if (buflen > 0)
+  else
+#endif
     {
-      /* Copy the new appdata into the I/O buffer chain */
+      /* Allocate on I/O buffer to start the chain (throttling as
+       * necessary).  We will not wait for an I/O buffer to become available
+       * in this context.
+       */
+
+      iob = iob_tryalloc(true, IOBUSER_NET_UDP_READAHEAD);
+      if (iob == NULL)
+        {
+          nerr("ERROR: Failed to create new I/O buffer chain\n");
+          return 0;
+        }
+
+      /* Copy the src address info into the I/O buffer chain.  We will not
+       * wait for an I/O buffer to become available in this context.  It
+       * there is any failure to allocated, the entire I/O buffer chain will
+       * be discarded.
+       */
 
-      ret = iob_trycopyin(iob, buffer, buflen,
-                          src_addr_size + sizeof(uint8_t), true,
+      ret = iob_trycopyin(iob, (FAR const uint8_t *)&src_addr_size,
+                          sizeof(uint8_t), 0, true,
                           IOBUSER_NET_UDP_READAHEAD);
       if (ret < 0)
         {
@@ -222,8 +252,48 @@ static uint16_t udp_datahandler(FAR struct net_driver_s *dev,
           iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
           return 0;
         }
+
+      ret = iob_trycopyin(iob, (FAR const uint8_t *)src_addr, src_addr_size,
+                          sizeof(uint8_t), true, IOBUSER_NET_UDP_READAHEAD);
+      if (ret < 0)
+        {
+          nerr("ERROR: Failed to add data to the I/O buffer chain: %d\n",
+               ret);
+          iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
+          return 0;
+        }
+
+      if (buflen > 0)
+        {
+          /* Copy the new appdata into the I/O buffer chain */
+
+          ret = iob_trycopyin(iob, buffer, buflen,
+                              src_addr_size + sizeof(uint8_t), true,
+                              IOBUSER_NET_UDP_READAHEAD);
+          if (ret < 0)
+            {
+              nerr("ERROR: Failed to add data to the I/O buffer chain: "
+                   "%d\n", ret);
+              iob_free_chain(iob, IOBUSER_NET_UDP_READAHEAD);
+              return 0;
+            }
+        }
     }
 
+#ifdef CONFIG_NET_TIMESTAMP
+  /* Keep the receive timestamps with the datagram if they are wanted */
+
+  if (NET_TSTAMP_RXENABLED(&conn->tstamp))
+    {
+      netdev_tstamp_rx(dev, &iob->io_swtime, &iob->io_hwtime);
+    }
+  else
+    {
+      memset(&iob->io_swtime, 0, sizeof(struct timespec));
+      memset(&iob->io_hwtime, 0, sizeof(struct timespec));
+    }
+#endif
+
   /* Add the new I/O buffer chain to the tail of the read-ahead queue */
 
   ret = iob_tryadd_queue(iob, &conn->readahead);
@@ -54,6 +54,7 @@
 
 #include <arch/irq.h>
 
+#include <nuttx/nuttx.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
@@ -73,6 +74,17 @@
 #define IPv4BUF ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+#ifdef CONFIG_NET_UDP_HASH
+/* The bucket of a local port (in network byte order) */
+
+#  define UDP_PORT_HASH(p) ((unsigned int)(p) % CONFIG_NET_UDP_HASH_SIZE)
+
+/* Return the connection of a hash table link or NULL */
+
+#  define UDP_HASH_CONN(e) \
+     ((e) != NULL ? container_of(e, struct udp_conn_s, hnode) : NULL)
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -90,6 +102,12 @@ static sem_t g_free_sem;
 
 static dq_queue_t g_active_udp_connections;
 
+#ifdef CONFIG_NET_UDP_HASH
+/* The UDP connections with a local port hashed by that port */
+
+static dq_queue_t g_udp_port_hash[CONFIG_NET_UDP_HASH_SIZE];
+#endif
+
 /* Last port used by a UDP connection connection. */
 
 static uint16_t g_last_udp_port;
@@ -113,6 +131,39 @@ static inline void _udp_semtake(FAR sem_t *sem)
 
 #define _udp_semgive(sem) nxsem_post(sem)
 
+/****************************************************************************
+ * Name: udp_setlport
+ *
+ * Description:
+ *   Set the local port of a connection (in network byte order), keeping
+ *   the local port hash table up to date.  Zero removes the port.
+ *
+ ****************************************************************************/
+
+static void udp_setlport(FAR struct udp_conn_s *conn, uint16_t portno)
+{
+#ifdef CONFIG_NET_UDP_HASH
+  /* The hash table is also accessed from the network event processing */
+
+  net_lock();
+
+  if (conn->lport != 0)
+    {
+      dq_rem(&conn->hnode, &g_udp_port_hash[UDP_PORT_HASH(conn->lport)]);
+    }
+
+  if (portno != 0)
+    {
+      dq_addlast(&conn->hnode, &g_udp_port_hash[UDP_PORT_HASH(portno)]);
+    }
+
+  conn->lport = portno;
+  net_unlock();
+#else
+  conn->lport = portno;
+#endif
+}
+
 /****************************************************************************
  * Name: udp_find_conn()
  *
@@ -129,13 +180,27 @@ static FAR struct udp_conn_s *udp_find_conn(uint8_t domain,
                                             uint16_t portno)
 {
   FAR struct udp_conn_s *conn;
+#ifdef CONFIG_NET_UDP_HASH
+  FAR dq_entry_t *entry;
+#else
   int i;
+#endif
 
   /* Now search each connection structure. */
 
+#ifdef CONFIG_NET_UDP_HASH
+  for (entry = dq_peek(&g_udp_port_hash[UDP_PORT_HASH(portno)]);
+       entry != NULL;
+       entry = dq_next(entry))
+#else
   for (i = 0; i < CONFIG_NET_UDP_CONNS; i++)
+#endif
     {
+#ifdef CONFIG_NET_UDP_HASH
+      conn = container_of(entry, struct udp_conn_s, hnode);
+#else
       conn = &g_udp_connections[i];
+#endif
 
       /* If the port local port number assigned to the connections matches
        * AND the IP address of the connection matches, then return a
@@ -253,7 +318,12 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv4_hdr_s *ip = IPv4BUF;
   FAR struct udp_conn_s *conn;
 
+#ifdef CONFIG_NET_UDP_HASH
+  conn = UDP_HASH_CONN(dq_peek(&g_udp_port_hash[
+                                 UDP_PORT_HASH(udp->destport)]));
+#else
   conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+#endif
   while (conn)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -366,7 +436,11 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_UDP_HASH
+      conn = UDP_HASH_CONN(dq_next(&conn->hnode));
+#else
       conn = (FAR struct udp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -392,7 +466,12 @@ static inline FAR struct udp_conn_s *
   FAR struct ipv6_hdr_s *ip = IPv6BUF;
   FAR struct udp_conn_s *conn;
 
+#ifdef CONFIG_NET_UDP_HASH
+  conn = UDP_HASH_CONN(dq_peek(&g_udp_port_hash[
+                                 UDP_PORT_HASH(udp->destport)]));
+#else
   conn = (FAR struct udp_conn_s *)g_active_udp_connections.head;
+#endif
   while (conn != NULL)
     {
       /* If the local UDP port is non-zero, the connection is considered
@@ -505,7 +584,11 @@ static inline FAR struct udp_conn_s *
 
       /* Look at the next active connection */
 
+#ifdef CONFIG_NET_UDP_HASH
+      conn = UDP_HASH_CONN(dq_next(&conn->hnode));
+#else
       conn = (FAR struct udp_conn_s *)conn->node.flink;
+#endif
     }
 
   return conn;
@@ -535,6 +618,13 @@ void udp_initialize(void)
   dq_init(&g_active_udp_connections);
   nxsem_init(&g_free_sem, 0, 1);
 
+#ifdef CONFIG_NET_UDP_HASH
+  for (i = 0; i < CONFIG_NET_UDP_HASH_SIZE; i++)
+    {
+      dq_init(&g_udp_port_hash[i]);
+    }
+#endif
+
   for (i = 0; i < CONFIG_NET_UDP_CONNS; i++)
     {
       /* Mark the connection closed and move it to the free list */
@@ -576,11 +666,16 @@ FAR struct udp_conn_s *udp_alloc(uint8_t domain)
 #endif
       conn->lport   = 0;
       conn->ttl     = IP_TTL;
+      conn->rcv_bufs = CONFIG_NET_UDP_RECV_BUFSIZE;
+#ifdef CONFIG_NET_TIMESTAMP
+      memset(&conn->tstamp, 0, sizeof(struct net_tstamp_s));
+#endif
 
 #ifdef CONFIG_NET_UDP_WRITE_BUFFERS
       /* Initialize the write buffer lists */
 
       sq_init(&conn->write_q);
+      conn->gso_size = 0;
 #endif
       /* Enqueue the connection into the active list */
 
@@ -611,7 +706,7 @@ void udp_free(FAR struct udp_conn_s *conn)
   DEBUGASSERT(conn->crefs == 0);
 
   _udp_semtake(&g_free_sem);
-  conn->lport = 0;
+  udp_setlport(conn, 0);
 
   /* Remove the connection from the active list */
 
@@ -760,8 +855,8 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
     {
       /* Yes.. Select any unused local port number */
 
-      conn->lport = htons(udp_select_port(conn->domain, &conn->u));
-      ret         = OK;
+      udp_setlport(conn, htons(udp_select_port(conn->domain, &conn->u)));
+      ret = OK;
     }
   else
     {
@@ -775,7 +870,7 @@ int udp_bind(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
         {
           /* No.. then bind the socket to the port */
 
-          conn->lport = portno;
+          udp_setlport(conn, portno);
           ret         = OK;
         }
       else
@@ -828,7 +923,7 @@ int udp_connect(FAR struct udp_conn_s *conn, FAR const struct sockaddr *addr)
        * connection structure.
        */
 
-      conn->lport = htons(udp_select_port(conn->domain, &conn->u));
+      udp_setlport(conn, htons(udp_select_port(conn->domain, &conn->u)));
     }
 
   /* Is there a remote port (rport)? */
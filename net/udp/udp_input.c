@@ -130,7 +130,10 @@ static int udp_input(FAR struct net_driver_s *dev, unsigned int iplen)
   dev->d_appdata = &dev->d_buf[hdrlen];
 
 #ifdef CONFIG_NET_UDP_CHECKSUMS
-  chksum = udp->udpchksum;
+  /* There is nothing to verify if the hardware verified the checksum */
+
+  chksum = NETDEV_HAS_FEATURE(dev, NETDEV_FEATURE_RXCSUM) ?
+           0 : udp->udpchksum;
   if (chksum != 0)
     {
 #ifdef CONFIG_NET_IPv6
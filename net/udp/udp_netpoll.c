@@ -47,6 +47,7 @@
 
 #include <nuttx/net/net.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
 
 #include "devif/devif.h"
 #include "netdev/netdev.h"
@@ -119,7 +120,7 @@ static uint16_t udp_poll_eventhandler(FAR struct net_driver_s *dev,
       if (eventset)
         {
           info->fds->revents |= eventset;
-          nxsem_post(info->fds->sem);
+          poll_notify(info->fds);
         }
     }
 
@@ -167,7 +168,7 @@ static inline void udp_iob_work(FAR void *arg)
           /* Yes.. then signal the poll logic */
 
           fds->revents |= POLLWRNORM;
-          nxsem_post(fds->sem);
+          poll_notify(fds);
         }
       else
         {
@@ -303,7 +304,7 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(fds);
     }
 
 #if defined(CONFIG_NET_UDP_WRITE_BUFFERS) && defined(CONFIG_IOB_NOTIFIER)
@@ -82,6 +82,9 @@ struct udp_recvfrom_s
   FAR socklen_t           *ir_fromlen;   /* Number of bytes allocated for address of sender */
   ssize_t                  ir_recvlen;   /* The received length */
   int                      ir_result;    /* Success:OK, failure:negated errno */
+#ifdef CONFIG_NET_TIMESTAMP
+  FAR struct scm_timestamping *ir_ts;    /* Receive timestamps (may be NULL) */
+#endif
 };
 
 /****************************************************************************
@@ -189,6 +192,15 @@ static inline void udp_newdata(FAR struct net_driver_s *dev,
 
   udp_recvfrom_newdata(dev, pstate);
 
+#ifdef CONFIG_NET_TIMESTAMP
+  /* Get the receive timestamps of the packet */
+
+  if (pstate->ir_ts != NULL)
+    {
+      netdev_tstamp_rx(dev, &pstate->ir_ts->ts[0], &pstate->ir_ts->ts[2]);
+    }
+#endif
+
   /* Indicate no data in the buffer */
 
   dev->d_len = 0;
@@ -213,6 +225,16 @@ static inline void udp_readahead(struct udp_recvfrom_s *pstate)
 
       DEBUGASSERT(iob->io_pktlen > 0);
 
+#ifdef CONFIG_NET_TIMESTAMP
+      /* Get the receive timestamps kept with the datagram */
+
+      if (pstate->ir_ts != NULL)
+        {
+          pstate->ir_ts->ts[0] = iob->io_swtime;
+          pstate->ir_ts->ts[2] = iob->io_hwtime;
+        }
+#endif
+
       /* Transfer that buffered data from the I/O buffer chain into
        * the user buffer.
        */
@@ -585,32 +607,30 @@ static ssize_t udp_recvfrom_result(int result, struct udp_recvfrom_s *pstate)
 }
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: psock_udp_recvfrom
+ * Name: udp_recvfrom_common
  *
  * Description:
- *   Perform the recvfrom operation for a UDP SOCK_DGRAM
+ *   Perform the recvfrom operation for a UDP SOCK_DGRAM and optionally get
+ *   the receive timestamps of the datagram.
  *
  * Input Parameters:
  *   psock  Pointer to the socket structure for the SOCK_DRAM socket
  *   buf    Buffer to receive data
  *   len    Length of buffer
  *   from   INET address of source (may be NULL)
+ *   ts     The location to return the receive timestamps (may be NULL)
  *
  * Returned Value:
  *   On success, returns the number of characters received.  On  error,
  *   -errno is returned (see recvfrom for list of errnos).
  *
- * Assumptions:
- *
  ****************************************************************************/
 
-ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR void *buf,
-                           size_t len, int flags, FAR struct sockaddr *from,
-                           FAR socklen_t *fromlen)
+static ssize_t udp_recvfrom_common(FAR struct socket *psock, FAR void *buf,
+                                   size_t len, int flags,
+                                   FAR struct sockaddr *from,
+                                   FAR socklen_t *fromlen,
+                                   FAR struct scm_timestamping *ts)
 {
   FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)psock->s_conn;
   FAR struct net_driver_s *dev;
@@ -625,6 +645,11 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR void *buf,
 
   net_lock();
   udp_recvfrom_initialize(psock, buf, len, from, fromlen, &state);
+#ifdef CONFIG_NET_TIMESTAMP
+  state.ir_ts = ts;
+#else
+  UNUSED(ts);
+#endif
 
   /* Copy the read-ahead data from the packet */
 
@@ -708,4 +733,89 @@ ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR void *buf,
   return ret;
 }
 
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_udp_recvfrom
+ *
+ * Description:
+ *   Perform the recvfrom operation for a UDP SOCK_DGRAM
+ *
+ * Input Parameters:
+ *   psock  Pointer to the socket structure for the SOCK_DRAM socket
+ *   buf    Buffer to receive data
+ *   len    Length of buffer
+ *   from   INET address of source (may be NULL)
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On  error,
+ *   -errno is returned (see recvfrom for list of errnos).
+ *
+ * Assumptions:
+ *
+ ****************************************************************************/
+
+ssize_t psock_udp_recvfrom(FAR struct socket *psock, FAR void *buf,
+                           size_t len, int flags, FAR struct sockaddr *from,
+                           FAR socklen_t *fromlen)
+{
+  return udp_recvfrom_common(psock, buf, len, flags, from, fromlen, NULL);
+}
+
+/****************************************************************************
+ * Name: psock_udp_recvmsg
+ *
+ * Description:
+ *   Perform the recvmsg operation for a UDP SOCK_DGRAM.  The receive
+ *   timestamps selected by SO_TIMESTAMP and SO_TIMESTAMPING are returned
+ *   as control data.  With MSG_ERRQUEUE, the pending transmit timestamps
+ *   are returned instead of a datagram.
+ *
+ * Input Parameters:
+ *   psock  Pointer to the socket structure for the SOCK_DRAM socket
+ *   msg    The message header
+ *   flags  Receive flags
+ *
+ * Returned Value:
+ *   On success, returns the number of characters received.  On  error,
+ *   -errno is returned (see recvmsg for list of errnos).
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TIMESTAMP
+ssize_t psock_udp_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
+                          int flags)
+{
+  FAR struct udp_conn_s *conn = (FAR struct udp_conn_s *)psock->s_conn;
+  struct scm_timestamping ts;
+  socklen_t fromlen = msg->msg_namelen;
+  ssize_t ret;
+
+  if ((flags & MSG_ERRQUEUE) != 0)
+    {
+      net_lock();
+      ret = net_tstamp_errqueue(&conn->tstamp, msg);
+      net_unlock();
+      return ret;
+    }
+
+  memset(&ts, 0, sizeof(struct scm_timestamping));
+  ret = udp_recvfrom_common(psock, msg->msg_iov->iov_base,
+                            msg->msg_iov->iov_len, flags, msg->msg_name,
+                            msg->msg_name != NULL ? &fromlen : NULL,
+                            NET_TSTAMP_RXENABLED(&conn->tstamp) ?
+                            &ts : NULL);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  msg->msg_namelen = fromlen;
+  net_tstamp_recvcmsg(&conn->tstamp, &ts, msg);
+  return ret;
+}
+#endif
+
 #endif /* CONFIG_NET && CONFIG_NET_UDP */
@@ -451,6 +451,12 @@ static uint16_t sendto_eventhandler(FAR struct net_driver_s *dev,
 
       devif_iob_send(dev, wrb->wb_iob, sndlen, 0);
 
+#ifdef CONFIG_NET_TIMESTAMP
+      /* Take the transmit timestamps requested for this datagram */
+
+      netdev_tstamp_tx(dev, &conn->tstamp);
+#endif
+
       /* Free the write buffer at the head of the queue and attempt to
        * setup the next transfer.
        */
@@ -469,6 +475,184 @@ static uint16_t sendto_eventhandler(FAR struct net_driver_s *dev,
   return flags;
 }
 
+/****************************************************************************
+ * Name: sendto_queue
+ *
+ * Description:
+ *   Copy one datagram into a write buffer and add it to the write queue of
+ *   the connection.
+ *
+ * Input Parameters:
+ *   psock    A pointer to a NuttX-specific, internal socket structure
+ *   conn     The UDP connection of the socket
+ *   buf      Data to send
+ *   len      Length of data to send
+ *   to       Address of recipient
+ *   tolen    The length of the address structure
+ *   nonblock True: Don't wait for write buffers
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static int sendto_queue(FAR struct socket *psock,
+                        FAR struct udp_conn_s *conn, FAR const void *buf,
+                        size_t len, FAR const struct sockaddr *to,
+                        socklen_t tolen, bool nonblock)
+{
+  FAR struct udp_wrbuffer_s *wrb;
+  bool empty;
+  int ret;
+
+  /* Allocate a write buffer.  Careful, the network will be momentarily
+   * unlocked here.
+   */
+
+  if (nonblock)
+    {
+      wrb = udp_wrbuffer_tryalloc();
+    }
+  else
+    {
+      wrb = udp_wrbuffer_alloc();
+    }
+
+  if (wrb == NULL)
+    {
+      /* A buffer allocation error occurred */
+
+      nerr("ERROR: Failed to allocate write buffer\n");
+      return nonblock ? -EAGAIN : -ENOMEM;
+    }
+
+  /* Initialize the write buffer
+   *
+   * Check if the socket is connected
+   */
+
+  if (_SS_ISCONNECTED(psock->s_flags))
+    {
+      /* Yes.. get the connection address from the connection structure */
+
+#ifdef CONFIG_NET_IPv4
+#ifdef CONFIG_NET_IPv6
+      if (conn->domain == PF_INET)
+#endif
+        {
+          FAR struct sockaddr_in *addr4 =
+            (FAR struct sockaddr_in *)&wrb->wb_dest;
+
+          addr4->sin_family = AF_INET;
+          addr4->sin_port   = conn->rport;
+          net_ipv4addr_copy(addr4->sin_addr.s_addr, conn->u.ipv4.raddr);
+          memset(addr4->sin_zero, 0, sizeof(addr4->sin_zero));
+        }
+#endif /* CONFIG_NET_IPv4 */
+
+#ifdef CONFIG_NET_IPv6
+#ifdef CONFIG_NET_IPv4
+      else
+#endif
+        {
+          FAR struct sockaddr_in6 *addr6 =
+            (FAR struct sockaddr_in6 *)&wrb->wb_dest;
+
+          addr6->sin6_family = AF_INET6;
+          addr6->sin6_port   = conn->rport;
+          net_ipv6addr_copy(addr6->sin6_addr.s6_addr, conn->u.ipv6.raddr);
+        }
+#endif /* CONFIG_NET_IPv6 */
+    }
+
+  /* Not connected.  Use the provided destination address */
+
+  else
+    {
+      memcpy(&wrb->wb_dest, to, tolen);
+    }
+
+  /* Copy the user data into the write buffer.  We cannot wait for
+   * buffer space if the socket was opened non-blocking.
+   */
+
+  if (nonblock)
+    {
+      ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf, len, 0, false,
+                          IOBUSER_NET_SOCK_UDP);
+    }
+  else
+    {
+      unsigned int count;
+      int blresult;
+
+      /* iob_copyin might wait for buffers to be freed, but if
+       * network is locked this might never happen, since network
+       * driver is also locked, therefore we need to break the lock
+       */
+
+      blresult = net_breaklock(&count);
+      ret = iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf, len, 0, false,
+                       IOBUSER_NET_SOCK_UDP);
+      if (blresult >= 0)
+        {
+          net_restorelock(count);
+        }
+    }
+
+  if (ret < 0)
+    {
+      goto errout_with_wrb;
+    }
+
+  /* Dump I/O buffer chain */
+
+  UDP_WBDUMP("I/O buffer chain", wrb, wrb->wb_iob->io_pktlen, 0);
+
+  /* sendto_eventhandler() will send data in FIFO order from the
+   * conn->write_q.
+   *
+   * REVISIT:  Why FIFO order?  Because it is easy.  In a real world
+   * environment where there are multiple network devices this might
+   * be inefficient because we could be sending data to different
+   * device out-of-queued-order to optimize performance.  Sending
+   * data to different networks from a single UDP socket is probably
+   * not a very common use case, however.
+   */
+
+  empty = sq_empty(&conn->write_q);
+
+  sq_addlast(&wrb->wb_node, &conn->write_q);
+  ninfo("Queued WRB=%p pktlen=%u write_q(%p,%p)\n",
+        wrb, wrb->wb_iob->io_pktlen,
+        conn->write_q.head, conn->write_q.tail);
+
+  if (empty)
+    {
+      /* The new write buffer lies at the head of the write queue.  Set
+       * up for the next packet transfer by setting the connection
+       * address to the address of the next packet now at the header of
+       * the write buffer queue.
+       */
+
+      ret = sendto_next_transfer(psock, conn);
+      if (ret < 0)
+        {
+          sq_remlast(&conn->write_q);
+          goto errout_with_wrb;
+        }
+    }
+
+  return OK;
+
+errout_with_wrb:
+  udp_wrbuffer_release(wrb);
+  return ret;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -503,9 +687,9 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
                          socklen_t tolen)
 {
   FAR struct udp_conn_s *conn;
-  FAR struct udp_wrbuffer_s *wrb;
+  size_t seglen;
+  size_t offset;
   bool nonblock;
-  bool empty;
   int ret = OK;
 
   /* If the UDP socket was previously assigned a remote peer address via
@@ -637,144 +821,30 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
 
   if (len > 0)
     {
-      net_lock();
-
-      /* Allocate a write buffer.  Careful, the network will be momentarily
-       * unlocked here.
+      /* With UDP_SEGMENT, each segment of gso_size bytes is sent as a
+       * datagram of its own.  All of them are queued with the network
+       * locked once.
        */
 
-      if (nonblock)
-        {
-          wrb = udp_wrbuffer_tryalloc();
-        }
-      else
-        {
-          wrb = udp_wrbuffer_alloc();
-        }
-
-      if (wrb == NULL)
-        {
-          /* A buffer allocation error occurred */
-
-          nerr("ERROR: Failed to allocate write buffer\n");
-          ret = nonblock ? -EAGAIN : -ENOMEM;
-          goto errout_with_lock;
-        }
-
-      /* Initialize the write buffer
-       *
-       * Check if the socket is connected
-       */
-
-      if (_SS_ISCONNECTED(psock->s_flags))
-        {
-          /* Yes.. get the connection address from the connection structure */
-
-#ifdef CONFIG_NET_IPv4
-#ifdef CONFIG_NET_IPv6
-          if (conn->domain == PF_INET)
-#endif
-            {
-              FAR struct sockaddr_in *addr4 =
-                (FAR struct sockaddr_in *)&wrb->wb_dest;
-
-              addr4->sin_family = AF_INET;
-              addr4->sin_port   = conn->rport;
-              net_ipv4addr_copy(addr4->sin_addr.s_addr, conn->u.ipv4.raddr);
-              memset(addr4->sin_zero, 0, sizeof(addr4->sin_zero));
-            }
-#endif /* CONFIG_NET_IPv4 */
-
-#ifdef CONFIG_NET_IPv6
-#ifdef CONFIG_NET_IPv4
-          else
-#endif
-            {
-              FAR struct sockaddr_in6 *addr6 =
-                (FAR struct sockaddr_in6 *)&wrb->wb_dest;
-
-              addr6->sin6_family = AF_INET6;
-              addr6->sin6_port   = conn->rport;
-              net_ipv6addr_copy(addr6->sin6_addr.s6_addr, conn->u.ipv6.raddr);
-            }
-#endif /* CONFIG_NET_IPv6 */
-        }
-
-      /* Not connected.  Use the provided destination address */
-
-      else
+      seglen = len;
+      if (conn->gso_size > 0 && conn->gso_size < len)
         {
-          memcpy(&wrb->wb_dest, to, tolen);
+          seglen = conn->gso_size;
         }
 
-      /* Copy the user data into the write buffer.  We cannot wait for
-       * buffer space if the socket was opened non-blocking.
-       */
-
-      if (nonblock)
-        {
-          ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf, len, 0, false,
-                              IOBUSER_NET_SOCK_UDP);
-        }
-      else
+      net_lock();
+      for (offset = 0; offset < len; offset += seglen)
         {
-          unsigned int count;
-          int blresult;
-
-          /* iob_copyin might wait for buffers to be freed, but if
-           * network is locked this might never happen, since network
-           * driver is also locked, therefore we need to break the lock
-           */
-
-          blresult = net_breaklock(&count);
-          ret = iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf, len, 0, false,
-                           IOBUSER_NET_SOCK_UDP);
-          if (blresult >= 0)
+          ret = sendto_queue(psock, conn, (FAR const uint8_t *)buf + offset,
+                             MIN(seglen, len - offset), to, tolen,
+                             nonblock);
+          if (ret < 0)
             {
-              net_restorelock(count);
-            }
-        }
+              net_unlock();
 
-      if (ret < 0)
-        {
-          goto errout_with_wrb;
-        }
-
-      /* Dump I/O buffer chain */
-
-      UDP_WBDUMP("I/O buffer chain", wrb, wrb->wb_iob->io_pktlen, 0);
-
-      /* sendto_eventhandler() will send data in FIFO order from the
-       * conn->write_q.
-       *
-       * REVISIT:  Why FIFO order?  Because it is easy.  In a real world
-       * environment where there are multiple network devices this might
-       * be inefficient because we could be sending data to different
-       * device out-of-queued-order to optimize performance.  Sending
-       * data to different networks from a single UDP socket is probably
-       * not a very common use case, however.
-       */
-
-      empty = sq_empty(&conn->write_q);
-
-      sq_addlast(&wrb->wb_node, &conn->write_q);
-      ninfo("Queued WRB=%p pktlen=%u write_q(%p,%p)\n",
-            wrb, wrb->wb_iob->io_pktlen,
-            conn->write_q.head, conn->write_q.tail);
-
-      if (empty)
-        {
-          /* The new write buffer lies at the head of the write queue.  Set
-           * up for the next packet transfer by setting the connection
-           * address to the address of the next packet now at the header of
-           * the write buffer queue.
-           */
+              /* Report the segments that were queued, if any */
 
-          ret = sendto_next_transfer(psock, conn);
-          if (ret < 0)
-            {
-              sq_remlast(&conn->write_q);
-              goto errout_with_wrb;
+              return offset > 0 ? (ssize_t)offset : ret;
             }
         }
 
@@ -784,13 +854,6 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
   /* Return the number of bytes that will be sent */
 
   return len;
-
-errout_with_wrb:
-  udp_wrbuffer_release(wrb);
-
-errout_with_lock:
-  net_unlock();
-  return ret;
 }
 
 /****************************************************************************
@@ -227,6 +227,12 @@ static uint16_t sendto_eventhandler(FAR struct net_driver_s *dev,
 
           devif_send(dev, pstate->st_buffer, pstate->st_buflen);
           pstate->st_sndlen = pstate->st_buflen;
+
+#ifdef CONFIG_NET_TIMESTAMP
+          /* Take the transmit timestamps requested for this datagram */
+
+          netdev_tstamp_tx(dev, &((FAR struct udp_conn_s *)conn)->tstamp);
+#endif
         }
 
       /* Don't allow any further call backs. */
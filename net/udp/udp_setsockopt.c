@@ -87,11 +87,8 @@
 int udp_setsockopt(FAR struct socket *psock, int option,
                    FAR const void *value, socklen_t value_len)
 {
-#ifdef CONFIG_NET_UDP_BINDTODEVICE
-  /* Keep alive options are the only UDP protocol socket option currently
-   * supported.
-   */
-
+#if defined(CONFIG_NET_UDP_BINDTODEVICE) || \
+    defined(CONFIG_NET_UDP_WRITE_BUFFERS)
   FAR struct udp_conn_s *conn;
   int ret;
 
@@ -155,6 +152,34 @@ int udp_setsockopt(FAR struct socket *psock, int option,
         break;
 #endif
 
+#ifdef CONFIG_NET_UDP_WRITE_BUFFERS
+      /* Handle the UDP_SEGMENT option:  Each send is split into datagrams
+       * of this size.  The last one may be shorter.  Zero disables it.
+       */
+
+      case UDP_SEGMENT:
+        if (value_len != sizeof(int))
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            int gso_size = *(FAR const int *)value;
+
+            if (gso_size < 0 || gso_size > UINT16_MAX)
+              {
+                ret = -EINVAL;
+              }
+            else
+              {
+                conn->gso_size = (uint16_t)gso_size;
+                ret = OK;
+              }
+          }
+
+        break;
+#endif
+
       default:
         nerr("ERROR: Unrecognized UDP option: %d\n", option);
         ret = -ENOPROTOOPT;
@@ -164,7 +189,7 @@ int udp_setsockopt(FAR struct socket *psock, int option,
   return ret;
 #else
   return -ENOPROTOOPT;
-#endif /* CONFIG_NET_UDP_BINDTODEVICE */
+#endif /* CONFIG_NET_UDP_BINDTODEVICE || CONFIG_NET_UDP_WRITE_BUFFERS */
 }
 
 #endif /* CONFIG_NET_UDPPROTO_OPTIONS */
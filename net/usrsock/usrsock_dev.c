@@ -334,7 +334,7 @@ static void usrsockdev_pollnotify(FAR struct usrsockdev_s *dev,
           if (fds->revents != 0)
             {
               ninfo("Report events: %02x\n", fds->revents);
-              nxsem_post(fds->sem);
+              poll_notify(fds);
             }
         }
     }
@@ -395,6 +395,19 @@ static ssize_t usrsockdev_read(FAR struct file *filep, FAR char *buffer,
         {
           dev->req.pos += rlen;
           len = rlen;
+
+#ifdef CONFIG_NET_USRSOCK_PIPELINE
+          /* If all of the request was read, free the request line for the
+           * next request.  The response is matched by its xid.
+           */
+
+          if (iovec_get(NULL, 0, dev->req.iov, dev->req.iovcnt,
+                        dev->req.pos) < 0)
+            {
+              dev->req.iov = NULL;
+              nxsem_post(&dev->req.acksem);
+            }
+#endif
         }
     }
   else
@@ -835,6 +848,7 @@ static ssize_t usrsockdev_write(FAR struct file *filep,
   FAR struct usrsock_conn_s *conn;
   FAR struct usrsockdev_s *dev;
   size_t origlen = len;
+  size_t done = 0;
   ssize_t ret = 0;
 
   if (len == 0)
@@ -859,70 +873,92 @@ static ssize_t usrsockdev_write(FAR struct file *filep,
       return ret;
     }
 
-  if (!dev->datain_conn)
-    {
-      /* Start of message, buffer length should be at least size of common
-       * message header.
-       */
+  /* The buffer may hold several messages (events and responses) back to
+   * back.  Handle all of them.
+   */
 
-      if (len < sizeof(struct usrsock_message_common_s))
+  while (len > 0)
+    {
+      if (!dev->datain_conn)
         {
-          nwarn("message too short, %d < %d.\n", len,
-                sizeof(struct usrsock_message_common_s));
+          /* Start of message, buffer length should be at least size of
+           * common message header.
+           */
 
-          ret = -EINVAL;
-          goto errout;
-        }
+          done = origlen - len;
+
+          if (len < sizeof(struct usrsock_message_common_s))
+            {
+              nwarn("message too short, %d < %d.\n", len,
+                    sizeof(struct usrsock_message_common_s));
 
-      /* Handle message. */
+              ret = -EINVAL;
+              break;
+            }
+
+          /* Handle message. */
+
+          ret = usrsockdev_handle_message(dev, buffer, len);
+          if (ret < 0)
+            {
+              break;
+            }
 
-      ret = usrsockdev_handle_message(dev, buffer, len);
-      if (ret >= 0)
-        {
           buffer += ret;
           len -= ret;
           ret = origlen - len;
         }
-    }
 
-  /* Data input handling. */
+      /* Data input handling. */
 
-  if (dev->datain_conn)
-    {
-      conn = dev->datain_conn;
+      if (dev->datain_conn)
+        {
+          conn = dev->datain_conn;
 
-      /* Copy data from user-space. */
+          /* Copy data from user-space. */
 
-      ret = iovec_put(conn->resp.datain.iov, conn->resp.datain.iovcnt,
-                      conn->resp.datain.pos, buffer, len);
-      if (ret < 0)
-        {
-          /* Tried writing beyond buffer. */
+          ret = iovec_put(conn->resp.datain.iov, conn->resp.datain.iovcnt,
+                          conn->resp.datain.pos, buffer, len);
+          if (ret < 0)
+            {
+              /* Tried writing beyond buffer. */
 
-          ret = -EINVAL;
-          conn->resp.result = -EINVAL;
-          conn->resp.datain.pos =
-              conn->resp.datain.total;
-        }
-      else
-        {
-          conn->resp.datain.pos += ret;
-          buffer += ret;
-          len -= ret;
-          ret = origlen - len;
-        }
+              ret = -EINVAL;
+              conn->resp.result = -EINVAL;
+              conn->resp.datain.pos =
+                  conn->resp.datain.total;
+            }
+          else
+            {
+              conn->resp.datain.pos += ret;
+              buffer += ret;
+              len -= ret;
+              ret = origlen - len;
+            }
 
-      if (conn->resp.datain.pos == conn->resp.datain.total)
-        {
-          dev->datain_conn = NULL;
+          if (conn->resp.datain.pos == conn->resp.datain.total)
+            {
+              dev->datain_conn = NULL;
+
+              /* Done with data response. */
 
-          /* Done with data response. */
+              usrsock_event(conn, USRSOCK_EVENT_REQ_COMPLETE);
+            }
 
-          usrsock_event(conn, USRSOCK_EVENT_REQ_COMPLETE);
+          if (ret < 0)
+            {
+              break;
+            }
         }
     }
 
-errout:
+  /* Report the messages that were handled before the failing one */
+
+  if (ret < 0 && done > 0)
+    {
+      ret = done;
+    }
+
   usrsockdev_semgive(&dev->devsem);
   return ret;
 }
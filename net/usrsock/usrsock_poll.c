@@ -53,6 +53,7 @@
 #include <nuttx/semaphore.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/usrsock.h>
+#include <nuttx/fs/fs.h>
 
 #include "usrsock/usrsock.h"
 
@@ -133,7 +134,7 @@ static uint16_t poll_event(FAR struct net_driver_s *dev, FAR void *pvconn,
   if (eventset)
     {
       info->fds->revents |= eventset;
-      nxsem_post(info->fds->sem);
+      poll_notify(info->fds);
     }
 
   return flags;
@@ -281,7 +282,7 @@ static int usrsock_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
     {
       /* Yes.. then signal the poll logic */
 
-      nxsem_post(fds->sem);
+      poll_notify(fds);
     }
 
 errout_unlock:
@@ -87,6 +87,9 @@ const struct sock_intf_s g_usrsock_sockif =
   NULL,                       /* si_sendfile */
 #endif
   usrsock_recvfrom,           /* si_recvfrom */
+#ifdef CONFIG_NET_TIMESTAMP
+  NULL,                       /* si_recvmsg */
+#endif
   usrsock_sockif_close,       /* si_close */
   usrsock_ioctl               /* si_ioctl */
 };
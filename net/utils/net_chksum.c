@@ -64,9 +64,12 @@
  * Returned Value:
  *   The updated checksum value.
  *
+ *   If CONFIG_NET_ARCH_CHKSUM or CONFIG_LIBC_ARCH_CHKSUM is defined, then
+ *   this function must be provided by architecture-specific logic.
+ *
  ****************************************************************************/
 
-#ifndef CONFIG_NET_ARCH_CHKSUM
+#if !defined(CONFIG_NET_ARCH_CHKSUM) && !defined(CONFIG_LIBC_ARCH_CHKSUM)
 uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 {
   FAR const uint8_t *dataptr;
@@ -104,7 +107,7 @@ uint16_t chksum(uint16_t sum, FAR const uint8_t *data, uint16_t len)
 
   return sum;
 }
-#endif /* CONFIG_NET_ARCH_CHKSUM */
+#endif /* !CONFIG_NET_ARCH_CHKSUM && !CONFIG_LIBC_ARCH_CHKSUM */
 
 /****************************************************************************
  * Name: net_chksum
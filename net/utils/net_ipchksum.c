@@ -42,6 +42,7 @@
 
 #include <assert.h>
 
+#include <nuttx/mm/iob.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
 
@@ -56,6 +57,84 @@
 #define IPv4BUF  ((struct ipv4_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 #define IPv6BUF  ((struct ipv6_hdr_s *)&dev->d_buf[NET_LL_HDRLEN(dev)])
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: upperlayer_chksum
+ *
+ * Description:
+ *   Sum the upper layer header and payload of the outgoing packet.  With
+ *   scatter-gather transmit, the payload may follow the headers in the
+ *   I/O buffer chain d_txiob instead of d_buf.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_NET_ARCH_CHKSUM)
+static uint16_t upperlayer_chksum(FAR struct net_driver_s *dev,
+                                  uint16_t sum, unsigned int offset,
+                                  uint16_t upperlen)
+{
+#ifdef CONFIG_NETDEV_IOB_TX
+  FAR struct iob_s *iob = dev->d_txiob;
+  unsigned int iobofs;
+  uint16_t ncopy;
+  uint16_t len;
+  uint16_t tmp;
+  bool odd;
+
+  if (iob != NULL && dev->d_txlen <= upperlen)
+    {
+      /* Sum the headers in d_buf */
+
+      sum = chksum(sum, &dev->d_buf[offset], upperlen - dev->d_txlen);
+      odd = ((upperlen - dev->d_txlen) & 1) != 0;
+
+      /* Then the payload in each I/O buffer.  A fragment that follows an
+       * odd number of bytes is summed with its bytes swapped.
+       */
+
+      iobofs = dev->d_txoffset;
+      while (iob != NULL && iobofs >= iob->io_len)
+        {
+          iobofs -= iob->io_len;
+          iob     = iob->io_flink;
+        }
+
+      for (len = dev->d_txlen; iob != NULL && len > 0; iob = iob->io_flink)
+        {
+          ncopy = iob->io_len - iobofs;
+          if (ncopy > len)
+            {
+              ncopy = len;
+            }
+
+          tmp = chksum(0, &iob->io_data[iob->io_offset + iobofs], ncopy);
+          if (odd)
+            {
+              tmp = (tmp << 8) | (tmp >> 8);
+            }
+
+          sum += tmp;
+          if (sum < tmp)
+            {
+              sum++; /* carry */
+            }
+
+          odd    ^= (ncopy & 1) != 0;
+          len    -= ncopy;
+          iobofs  = 0;
+        }
+
+      return sum;
+    }
+#endif
+
+  return chksum(sum, &dev->d_buf[offset], upperlen);
+}
+#endif /* CONFIG_NET_ARCH_CHKSUM */
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -116,7 +195,8 @@ uint16_t ipv4_upperlayer_chksum(FAR struct net_driver_s *dev, uint8_t proto)
 
   /* Sum IP payload data. */
 
-  sum = chksum(sum, &dev->d_buf[iphdrlen + NET_LL_HDRLEN(dev)], upperlen);
+  sum = upperlayer_chksum(dev, sum, iphdrlen + NET_LL_HDRLEN(dev),
+                          upperlen);
   return (sum == 0) ? 0xffff : htons(sum);
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
@@ -183,7 +263,7 @@ uint16_t ipv6_upperlayer_chksum(FAR struct net_driver_s *dev,
 
   /* Sum IP payload data. */
 
-  sum = chksum(sum, &dev->d_buf[NET_LL_HDRLEN(dev) + iplen], upperlen);
+  sum = upperlayer_chksum(dev, sum, NET_LL_HDRLEN(dev) + iplen, upperlen);
   return (sum == 0) ? 0xffff : htons(sum);
 }
 #endif /* CONFIG_NET_ARCH_CHKSUM */
@@ -68,10 +68,58 @@ static sem_t        g_netlock;
 static pid_t        g_holder = NO_HOLDER;
 static unsigned int g_count  = 0;
 
+#ifdef CONFIG_NET_LOCK_STATS
+static struct net_lockstats_s g_lockstats;
+static struct timespec        g_locktime; /* When the lock was taken */
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: net_elapsed
+ *
+ * Description:
+ *   Return the microseconds since 'start'.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCK_STATS
+static uint32_t net_elapsed(FAR const struct timespec *start)
+{
+  struct timespec now;
+  int64_t usec;
+
+  clock_systime_timespec(&now);
+  usec = (int64_t)(now.tv_sec - start->tv_sec) * USEC_PER_SEC +
+         (now.tv_nsec - start->tv_nsec) / NSEC_PER_USEC;
+
+  return usec > 0 ? (uint32_t)usec : 0;
+}
+
+/****************************************************************************
+ * Name: net_lockreleased
+ *
+ * Description:
+ *   Account for the time the lock was held.  Called by the holder just
+ *   before it releases the lock.
+ *
+ ****************************************************************************/
+
+static void net_lockreleased(void)
+{
+  uint32_t hold = net_elapsed(&g_locktime);
+
+  g_lockstats.totalhold += hold;
+  if (hold > g_lockstats.maxhold)
+    {
+      g_lockstats.maxhold   = hold;
+      g_lockstats.maxholder = g_holder;
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: _net_takesem
  *
@@ -83,7 +131,37 @@ static unsigned int g_count  = 0;
 
 static int _net_takesem(void)
 {
+#ifdef CONFIG_NET_LOCK_STATS
+  struct timespec start;
+  uint32_t wait;
+  int ret;
+
+  /* The statistics are only updated by the holder of the lock */
+
+  if (nxsem_trywait(&g_netlock) < 0)
+    {
+      clock_systime_timespec(&start);
+      ret = nxsem_wait_uninterruptible(&g_netlock);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      wait = net_elapsed(&start);
+      g_lockstats.ncontended++;
+      g_lockstats.totalwait += wait;
+      if (wait > g_lockstats.maxwait)
+        {
+          g_lockstats.maxwait = wait;
+        }
+    }
+
+  g_lockstats.nlocks++;
+  clock_systime_timespec(&g_locktime);
+  return OK;
+#else
   return nxsem_wait_uninterruptible(&g_netlock);
+#endif
 }
 
 /****************************************************************************
@@ -194,13 +272,14 @@ void net_lockinitialize(void)
 
 int net_lock(void)
 {
-#ifdef CONFIG_SMP
-  irqstate_t flags = enter_critical_section();
-#endif
   pid_t me = getpid();
   int ret = OK;
 
-  /* Does this thread already hold the semaphore? */
+  /* Does this thread already hold the semaphore?  No critical section is
+   * needed, not even with SMP:  Only this thread can set g_holder to its
+   * own pid or clear it, so the test cannot be fooled by a thread that
+   * changes g_holder on another CPU.
+   */
 
   if (g_holder == me)
     {
@@ -222,9 +301,6 @@ int net_lock(void)
         }
     }
 
-#ifdef CONFIG_SMP
-  leave_critical_section(flags);
-#endif
   return ret;
 }
 
@@ -244,9 +320,6 @@ int net_lock(void)
 
 void net_unlock(void)
 {
-#ifdef CONFIG_SMP
-  irqstate_t flags = enter_critical_section();
-#endif
   DEBUGASSERT(g_holder == getpid() && g_count > 0);
 
   /* If the count would go to zero, then release the semaphore */
@@ -255,6 +328,9 @@ void net_unlock(void)
     {
       /* We no longer hold the semaphore */
 
+#ifdef CONFIG_NET_LOCK_STATS
+      net_lockreleased();
+#endif
       g_holder = NO_HOLDER;
       g_count  = 0;
       nxsem_post(&g_netlock);
@@ -265,10 +341,6 @@ void net_unlock(void)
 
       g_count--;
     }
-
-#ifdef CONFIG_SMP
-  leave_critical_section(flags);
-#endif
 }
 
 /****************************************************************************
@@ -297,6 +369,9 @@ int net_breaklock(FAR unsigned int *count)
 
       /* Release the network lock  */
 
+#ifdef CONFIG_NET_LOCK_STATS
+      net_lockreleased();
+#endif
       g_holder = NO_HOLDER;
       g_count  = 0;
 
@@ -485,3 +560,28 @@ FAR struct iob_s *net_ioballoc(bool throttled, enum iob_user_e consumerid)
   return iob;
 }
 #endif
+
+/****************************************************************************
+ * Name: net_lockstats
+ *
+ * Description:
+ *   Return a copy of the statistics of the network lock.
+ *
+ * Input Parameters:
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCK_STATS
+void net_lockstats(FAR struct net_lockstats_s *stats)
+{
+  /* The statistics are only changed by the holder of the lock */
+
+  net_lock();
+  *stats = g_lockstats;
+  net_unlock();
+}
+#endif
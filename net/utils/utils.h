@@ -57,6 +57,23 @@ enum tv2ds_remainder_e
   TV2DS_CEIL       /* Force to next larger full decisecond */
 };
 
+#ifdef CONFIG_NET_LOCK_STATS
+/* Statistics of the network lock.  Nested locks by the holder are not
+ * counted.  The times are in microseconds.
+ */
+
+struct net_lockstats_s
+{
+  uint32_t nlocks;        /* Number of times the lock was taken */
+  uint32_t ncontended;    /* Number of times a thread had to wait */
+  uint32_t maxhold;       /* Longest time the lock was held */
+  uint32_t maxwait;       /* Longest time a thread waited for the lock */
+  uint64_t totalhold;     /* Total time the lock was held */
+  uint64_t totalwait;     /* Total time threads waited for the lock */
+  pid_t    maxholder;     /* The thread that held the lock longest */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -111,6 +128,24 @@ int net_breaklock(FAR unsigned int *count);
 
 int net_restorelock(unsigned int count);
 
+/****************************************************************************
+ * Name: net_lockstats
+ *
+ * Description:
+ *   Return a copy of the statistics of the network lock.
+ *
+ * Input Parameters:
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCK_STATS
+void net_lockstats(FAR struct net_lockstats_s *stats);
+#endif
+
 /****************************************************************************
  * Name: net_dsec2timeval
  *
@@ -130,6 +130,23 @@ int clock_systime_timespec(FAR struct timespec *ts)
 
       return up_timer_gettime(ts);
 
+#elif (USEC_PER_SEC % USEC_PER_TICK) == 0
+      /* A second is a whole number of ticks.  Then one division splits the
+       * ticks into seconds and the ticks of the last second, which are
+       * exactly converted to nanoseconds without overflow.  No 64-bit
+       * intermediate values are needed.
+       */
+
+      clock_t ticks;
+      clock_t secs;
+
+      ticks = clock_systime_ticks();
+      secs  = ticks / TICK_PER_SEC;
+
+      ts->tv_sec  = (time_t)secs;
+      ts->tv_nsec = (long)(ticks - secs * TICK_PER_SEC) * NSEC_PER_TICK;
+      return OK;
+
 #elif defined(CONFIG_HAVE_LONG_LONG) && (CONFIG_USEC_PER_TICK % 1000) != 0
       /* 64-bit microsecond calculations should improve our accuracy
        * when the clock period is in units of microseconds.
@@ -42,6 +42,7 @@
 #ifndef CONFIG_DISABLE_ENVIRON
 
 #include <sys/types.h>
+#include <stdint.h>
 #include <sched.h>
 #include <string.h>
 #include <errno.h>
@@ -51,6 +52,62 @@
 #include "sched/sched.h"
 #include "environ/environ.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: env_clone
+ *
+ * Description:
+ *   Allocate a private copy of an environment, including its hash index.
+ *
+ ****************************************************************************/
+
+static FAR struct environ_s *env_clone(FAR struct environ_s *src)
+{
+  FAR struct environ_s *env;
+
+  env = (FAR struct environ_s *)kmm_zalloc(sizeof(struct environ_s));
+  if (env == NULL)
+    {
+      return NULL;
+    }
+
+  env->ev_crefs = 1;
+
+  if (src->ev_size > 0)
+    {
+      env->ev_env = (FAR char *)kumm_malloc(src->ev_size);
+      if (env->ev_env == NULL)
+        {
+          kmm_free(env);
+          return NULL;
+        }
+
+      memcpy(env->ev_env, src->ev_env, src->ev_size);
+      env->ev_size = src->ev_size;
+    }
+
+  /* The offsets in the hash index are the same in the copy.  Without an
+   * index, the copy is just searched linearly.
+   */
+
+  if (src->ev_hashsize > 0)
+    {
+      env->ev_hash = (FAR uint32_t *)
+        kmm_malloc(src->ev_hashsize * sizeof(uint32_t));
+      if (env->ev_hash != NULL)
+        {
+          memcpy(env->ev_hash, src->ev_hash,
+                 src->ev_hashsize * sizeof(uint32_t));
+          env->ev_hashsize = src->ev_hashsize;
+        }
+    }
+
+  return env;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -59,9 +116,10 @@
  * Name: env_dup
  *
  * Description:
- *   Copy the internal environment structure of a task.  This is the action
- *   that is performed when a new task is created: The new task has a private,
- *   exact duplicate of the parent task's environment.
+ *   Give a new task group the environment of the parent task.  The
+ *   environment is shared until one of the groups modifies it.  With
+ *   CONFIG_ARCH_ADDRENV, the strings do not lie in memory that is shared
+ *   with the child, so the new task gets a private copy.
  *
  * Input Parameters:
  *   group - The child task group to receive the newly allocated copy of the
@@ -78,8 +136,7 @@
 int env_dup(FAR struct task_group_s *group)
 {
   FAR struct tcb_s *ptcb = this_task();
-  FAR char *envp = NULL;
-  size_t envlen;
+  FAR struct environ_s *env;
   int ret = OK;
 
   DEBUGASSERT(group != NULL && ptcb != NULL && ptcb->group != NULL);
@@ -92,48 +149,76 @@ int env_dup(FAR struct task_group_s *group)
 
   /* Does the parent task have an environment? */
 
-  if (ptcb->group != NULL && ptcb->group->tg_envp != NULL)
+  env = ptcb->group->tg_env;
+  if (env != NULL)
     {
-      /* Yes.. The parent task has an environment allocation. */
-
-      envlen = ptcb->group->tg_envsize;
-      envp   = NULL;
+#ifdef CONFIG_ARCH_ADDRENV
+      /* Yes.. duplicate it */
 
-      /* A special case is that the parent has an "empty" environment
-       * allocation, i.e., there is an allocation in place but it
-       * contains no variable definitions and, hence, envlen == 0.
-       */
-
-      if (envlen > 0)
+      env = env_clone(env);
+      if (env == NULL)
         {
-          /* There is an environment, duplicate it */
-
-          envp = (FAR char *)kumm_malloc(envlen);
-          if (envp == NULL)
-            {
-              /* The parent's environment can not be inherited due to a
-               * failure in the allocation of the child environment.
-               */
-
-              envlen = 0;
-              ret    = -ENOMEM;
-            }
-          else
-            {
-              /* Duplicate the parent environment. */
-
-              memcpy(envp, ptcb->group->tg_envp, envlen);
-            }
-        }
+          /* The parent's environment can not be inherited due to a
+           * failure in the allocation of the child environment.
+           */
 
-      /* Save the size and child environment allocation. */
+          ret = -ENOMEM;
+        }
+#else
+      /* Yes.. share it with the parent */
 
-      group->tg_envsize = envlen;
-      group->tg_envp    = envp;
+      DEBUGASSERT(env->ev_crefs < UINT16_MAX);
+      env->ev_crefs++;
+#endif
     }
 
+  group->tg_env = env;
+
   sched_unlock();
   return ret;
 }
 
+/****************************************************************************
+ * Name: env_unshare
+ *
+ * Description:
+ *   Make sure that the environment of a task group is not shared with
+ *   other task groups before it is modified.  If it is shared, the group
+ *   gets a private copy.
+ *
+ * Input Parameters:
+ *   group - The task group whose environment is about to be modified
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if a copy could not be allocated.
+ *
+ * Assumptions:
+ *   - Not called from an interrupt handler
+ *   - Caller has pre-emption disabled
+ *
+ ****************************************************************************/
+
+int env_unshare(FAR struct task_group_s *group)
+{
+  FAR struct environ_s *env = group->tg_env;
+  FAR struct environ_s *copy;
+
+  if (env == NULL || env->ev_crefs <= 1)
+    {
+      return OK;
+    }
+
+  copy = env_clone(env);
+  if (copy == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* The other groups keep the original */
+
+  env->ev_crefs--;
+  group->tg_env = copy;
+  return OK;
+}
+
 #endif /* CONFIG_DISABLE_ENVIRON */
@@ -42,9 +42,12 @@
 #ifndef CONFIG_DISABLE_ENVIRON
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include <sched.h>
 
+#include <nuttx/kmalloc.h>
+
 #include "environ/environ.h"
 
 /****************************************************************************
@@ -73,6 +76,28 @@ static bool env_cmpname(const char *pszname, const char *peqname)
   return false;
 }
 
+/****************************************************************************
+ * Name: env_hash
+ *
+ * Description:
+ *   Return the FNV-1a hash of a variable name.  The name ends with either
+ *   '\0' or '=', so this can be used for the name of a name=value string
+ *   as well.
+ *
+ ****************************************************************************/
+
+static uint32_t env_hash(FAR const char *name)
+{
+  uint32_t hash = 2166136261u;
+
+  for (; *name != '\0' && *name != '='; name++)
+    {
+      hash = (hash ^ (uint8_t)*name) * 16777619u;
+    }
+
+  return hash;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -99,17 +124,49 @@ static bool env_cmpname(const char *pszname, const char *peqname)
 
 FAR char *env_findvar(FAR struct task_group_s *group, FAR const char *pname)
 {
+  FAR struct environ_s *env;
   FAR char *ptr;
   FAR char *end;
+  uint32_t mask;
+  uint32_t ndx;
 
   /* Verify input parameters */
 
   DEBUGASSERT(group != NULL && pname != NULL);
 
-  /* Search for a name=value string with matching name */
+  env = group->tg_env;
+  if (env == NULL)
+    {
+      return NULL;
+    }
+
+  /* Look up the name in the hash index.  The index is never full, so
+   * there is an empty entry at the end of every probe sequence.
+   */
+
+  if (env->ev_hashsize > 0)
+    {
+      mask = env->ev_hashsize - 1;
+      for (ndx = env_hash(pname) & mask;
+           env->ev_hash[ndx] != 0;
+           ndx = (ndx + 1) & mask)
+        {
+          ptr = &env->ev_env[env->ev_hash[ndx] - 1];
+          if (env_cmpname(pname, ptr))
+            {
+              return ptr;
+            }
+        }
+
+      return NULL;
+    }
+
+  /* There is no index.  Search for a name=value string with matching
+   * name
+   */
 
-  end = &group->tg_envp[group->tg_envsize];
-  for (ptr = group->tg_envp;
+  end = &env->ev_env[env->ev_size];
+  for (ptr = env->ev_env;
        ptr < end && !env_cmpname(pname, ptr);
        ptr += (strlen(ptr) + 1));
 
@@ -118,4 +175,95 @@ FAR char *env_findvar(FAR struct task_group_s *group, FAR const char *pname)
   return (ptr < end) ? ptr : NULL;
 }
 
+/****************************************************************************
+ * Name: env_rehash
+ *
+ * Description:
+ *   Rebuild the hash index of an environment after its strings have been
+ *   modified.  If the index cannot be allocated, the environment is left
+ *   without an index and is searched linearly.
+ *
+ * Input Parameters:
+ *   env - The modified environment
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   - Not called from an interrupt handler
+ *   - Caller has pre-emption disabled
+ *
+ ****************************************************************************/
+
+void env_rehash(FAR struct environ_s *env)
+{
+  FAR uint32_t *hash;
+  FAR char *ptr;
+  FAR char *end;
+  size_t hashsize = ENV_HASH_MINSIZE;
+  size_t nvars = 0;
+  uint32_t mask;
+  uint32_t ndx;
+
+  DEBUGASSERT(env != NULL);
+
+  /* Count the variables.  The index is kept at most half full. */
+
+  end = &env->ev_env[env->ev_size];
+  for (ptr = env->ev_env; ptr < end; ptr += (strlen(ptr) + 1))
+    {
+      nvars++;
+    }
+
+  while (hashsize < 2 * nvars)
+    {
+      hashsize <<= 1;
+    }
+
+  if (nvars == 0 || hashsize > UINT16_MAX)
+    {
+      /* Not worth an index (or too large for one).  Use the linear
+       * search.
+       */
+
+      goto errout;
+    }
+
+  if (hashsize != env->ev_hashsize)
+    {
+      hash = (FAR uint32_t *)kmm_realloc(env->ev_hash,
+                                         hashsize * sizeof(uint32_t));
+      if (hash == NULL)
+        {
+          goto errout;
+        }
+
+      env->ev_hash     = hash;
+      env->ev_hashsize = hashsize;
+    }
+
+  /* Enter each string at the first free entry of its probe sequence */
+
+  mask = hashsize - 1;
+  memset(env->ev_hash, 0, hashsize * sizeof(uint32_t));
+
+  for (ptr = env->ev_env; ptr < end; ptr += (strlen(ptr) + 1))
+    {
+      for (ndx = env_hash(ptr) & mask;
+           env->ev_hash[ndx] != 0;
+           ndx = (ndx + 1) & mask)
+        {
+        }
+
+      env->ev_hash[ndx] = (uint32_t)(ptr - env->ev_env) + 1;
+    }
+
+  return;
+
+errout:
+  kmm_free(env->ev_hash);
+  env->ev_hash     = NULL;
+  env->ev_hashsize = 0;
+}
+
 #endif /* CONFIG_DISABLE_ENVIRON */
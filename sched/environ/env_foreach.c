@@ -77,6 +77,7 @@
 
 int env_foreach(FAR struct task_group_s *group, env_foreach_t cb, FAR void *arg)
 {
+  FAR struct environ_s *env;
   FAR char *ptr;
   FAR char *end;
   int ret = OK;
@@ -85,10 +86,16 @@ int env_foreach(FAR struct task_group_s *group, env_foreach_t cb, FAR void *arg)
 
   DEBUGASSERT(group != NULL && cb != NULL);
 
+  env = group->tg_env;
+  if (env == NULL)
+    {
+      return OK;
+    }
+
   /* Search for a name=value string with matching name */
 
-  end = &group->tg_envp[group->tg_envsize];
-  for (ptr = group->tg_envp; ptr < end; ptr += (strlen(ptr) + 1))
+  end = &env->ev_env[env->ev_size];
+  for (ptr = env->ev_env; ptr < end; ptr += (strlen(ptr) + 1))
     {
       /* Perform the callback */
 
@@ -75,23 +75,37 @@
 
 void env_release(FAR struct task_group_s *group)
 {
+  FAR struct environ_s *env;
+
   DEBUGASSERT(group != NULL);
 
-  /* Free any allocate environment strings */
+  /* The environment may be shared with other task groups */
 
-  if (group->tg_envp)
+  sched_lock();
+  env = group->tg_env;
+  if (env != NULL && --env->ev_crefs == 0)
     {
-      /* Free the environment */
+      /* This was the last reference.  Free the environment */
+
+      if (env->ev_env != NULL)
+        {
+          kumm_free(env->ev_env);
+        }
+
+      if (env->ev_hash != NULL)
+        {
+          kmm_free(env->ev_hash);
+        }
 
-      kumm_free(group->tg_envp);
+      kmm_free(env);
     }
 
   /* In any event, make sure that all environment-related variables in the
    * task group structure are reset to initial values.
    */
 
-  group->tg_envsize = 0;
-  group->tg_envp = NULL;
+  group->tg_env = NULL;
+  sched_unlock();
 }
 
 #endif /* CONFIG_DISABLE_ENVIRON */
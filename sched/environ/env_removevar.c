@@ -68,23 +68,31 @@
  *   - Not called from an interrupt handler
  *   - Caller has pre-emption disabled
  *   - Caller will reallocate the environment structure to the correct size
+ *     and rebuild the hash index
+ *   - The environment is not shared with other task groups
  *
  ****************************************************************************/
 
 int env_removevar(FAR struct task_group_s *group, FAR char *pvar)
 {
+  FAR struct environ_s *env;
   FAR char *end;    /* Pointer to the end+1 of the environment */
   int alloc;        /* Size of the allocated environment */
   int ret = ERROR;
 
-  DEBUGASSERT(group != NULL && pvar != NULL);
+  DEBUGASSERT(group != NULL && group->tg_env != NULL && pvar != NULL);
+
+  /* The environment must not be shared with other task groups */
+
+  env = group->tg_env;
+  DEBUGASSERT(env->ev_crefs == 1);
 
   /* Verify that the pointer lies within the environment region */
 
-  alloc = group->tg_envsize;             /* Size of the allocated environment */
-  end   = &group->tg_envp[alloc];        /* Pointer to the end+1 of the environment */
+  alloc = env->ev_size;                  /* Size of the allocated environment */
+  end   = &env->ev_env[alloc];           /* Pointer to the end+1 of the environment */
 
-  if (pvar >= group->tg_envp && pvar < end)
+  if (pvar >= env->ev_env && pvar < end)
     {
       /* Set up for the removal */
 
@@ -107,7 +115,7 @@ int env_removevar(FAR struct task_group_s *group, FAR char *pvar)
        * caller may add more stuff to the environment.
        */
 
-      group->tg_envsize -= len;
+      env->ev_size -= len;
       ret = OK;
     }
 
@@ -83,6 +83,7 @@ int setenv(FAR const char *name, FAR const char *value, int overwrite)
 {
   FAR struct tcb_s *rtcb;
   FAR struct task_group_s *group;
+  FAR struct environ_s *env;
   FAR char *pvar;
   FAR char *newenvp;
   int newsize;
@@ -126,67 +127,88 @@ int setenv(FAR const char *name, FAR const char *value, int overwrite)
 
   /* Check if the variable already exists */
 
-  if (group->tg_envp && (pvar = env_findvar(group, name)) != NULL)
+  pvar = env_findvar(group, name);
+  if (pvar != NULL && !overwrite)
     {
-      /* It does! Do we have permission to overwrite the existing value? */
+      /* It does, but we do not have permission to overwrite the existing
+       * value.  Just return success.
+       */
 
-      if (!overwrite)
-        {
-          /* No.. then just return success */
+      sched_unlock();
+      return OK;
+    }
 
-          sched_unlock();
-          return OK;
-        }
+  /* The environment is about to be modified.  If it is shared with other
+   * task groups, give this group its own copy first.
+   */
 
-      /* Yes.. just remove the name=value pair from the environment.  It will
-       * be added again below.  Note that we are responsible for reallocating
-       * the environment buffer; this will happen below.
+  if (env_unshare(group) < 0)
+    {
+      ret = ENOMEM;
+      goto errout_with_lock;
+    }
+
+  if (pvar != NULL)
+    {
+      /* Remove the name=value pair from the (possibly new) environment.  It
+       * will be added again below.  Note that we are responsible for
+       * reallocating the environment buffer; this will happen below.
        */
 
+      pvar = env_findvar(group, name);
+      DEBUGASSERT(pvar != NULL);
       env_removevar(group, pvar);
     }
 
-  /* Get the size of the new name=value string.  The +2 is for the '=' and for
-   * null terminator
-   */
-
-  varlen = strlen(name) + strlen(value) + 2;
-
-  /* Then allocate or reallocate the environment buffer */
+  /* Allocate the environment structure if this is the first variable */
 
-  if (group->tg_envp)
+  env = group->tg_env;
+  if (env == NULL)
     {
-      newsize = group->tg_envsize + varlen;
-      newenvp = (FAR char *)kumm_realloc(group->tg_envp, newsize);
-      if (!newenvp)
+      env = (FAR struct environ_s *)kmm_zalloc(sizeof(struct environ_s));
+      if (env == NULL)
         {
           ret = ENOMEM;
           goto errout_with_lock;
         }
 
-      pvar = &newenvp[group->tg_envsize];
+      env->ev_crefs = 1;
+      group->tg_env = env;
     }
-  else
+
+  /* Get the size of the new name=value string.  The +2 is for the '=' and
+   * for null terminator
+   */
+
+  varlen = strlen(name) + strlen(value) + 2;
+
+  /* Then allocate or reallocate the environment buffer */
+
+  newsize = env->ev_size + varlen;
+  newenvp = (FAR char *)kumm_realloc(env->ev_env, newsize);
+  if (!newenvp)
     {
-      newsize = varlen;
-      newenvp = (FAR char *)kumm_malloc(varlen);
-      if (!newenvp)
-        {
-          ret = ENOMEM;
-          goto errout_with_lock;
-        }
+      /* A removed variable is gone, so the index must be rebuilt */
 
-      pvar = newenvp;
+      env_rehash(env);
+      ret = ENOMEM;
+      goto errout_with_lock;
     }
 
+  pvar = &newenvp[env->ev_size];
+
   /* Save the new buffer and size */
 
-  group->tg_envp    = newenvp;
-  group->tg_envsize = newsize;
+  env->ev_env  = newenvp;
+  env->ev_size = newsize;
 
   /* Now, put the new name=value string into the environment buffer */
 
   sprintf(pvar, "%s=%s", name, value);
+
+  /* And update the hash index */
+
+  env_rehash(env);
   sched_unlock();
   return OK;
 
@@ -76,6 +76,7 @@ int unsetenv(FAR const char *name)
 {
   FAR struct tcb_s *rtcb = this_task();
   FAR struct task_group_s *group = rtcb->group;
+  FAR struct environ_s *env;
   FAR char *pvar;
   FAR char *newenvp;
   int newsize;
@@ -86,32 +87,46 @@ int unsetenv(FAR const char *name)
   /* Check if the variable exists */
 
   sched_lock();
-  if (group && (pvar = env_findvar(group, name)) != NULL)
+  if (group && env_findvar(group, name) != NULL)
     {
-      /* It does!  Remove the name=value pair from the environment. */
+      /* It does!  If the environment is shared with other task groups,
+       * give this group its own copy before modifying it.
+       */
 
+      if (env_unshare(group) < 0)
+        {
+          sched_unlock();
+          set_errno(ENOMEM);
+          return ERROR;
+        }
+
+      /* Remove the name=value pair from the environment. */
+
+      env  = group->tg_env;
+      pvar = env_findvar(group, name);
+      DEBUGASSERT(pvar != NULL);
       env_removevar(group, pvar);
 
       /* Reallocate the new environment buffer */
 
-      newsize = group->tg_envsize;
+      newsize = env->ev_size;
       if (newsize <= 0)
         {
           /* Free the old environment (if there was one) */
 
-          if (group->tg_envp != NULL)
+          if (env->ev_env != NULL)
             {
-              kumm_free(group->tg_envp);
-              group->tg_envp = NULL;
+              kumm_free(env->ev_env);
+              env->ev_env = NULL;
             }
 
-          group->tg_envsize = 0;
+          env->ev_size = 0;
         }
       else
         {
           /* Reallocate the environment to reclaim a little memory */
 
-          newenvp = (FAR char *)kumm_realloc(group->tg_envp, newsize);
+          newenvp = (FAR char *)kumm_realloc(env->ev_env, newsize);
           if (newenvp == NULL)
             {
               set_errno(ENOMEM);
@@ -123,9 +138,13 @@ int unsetenv(FAR const char *name)
                * to reallocation).
                */
 
-              group->tg_envp = newenvp;
+              env->ev_env = newenvp;
             }
         }
+
+      /* The offsets of the following variables have changed */
+
+      env_rehash(env);
     }
 
   sched_unlock();
@@ -44,6 +44,8 @@
 #include <nuttx/config.h>
 #include <nuttx/sched.h>
 
+#include <stdint.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -53,6 +55,35 @@
 #  define env_release(group) (0)
 #else
 
+/* The smallest size of the hash index of an environment */
+
+#define ENV_HASH_MINSIZE 8
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This is the environment of a task group.  A new task group shares the
+ * environment of its parent until one of the groups modifies it
+ * (copy-on-write);  The environment that is shared is never modified.
+ *
+ * The name=value strings are packed into ev_env[].  They are allocated
+ * from the user heap because getenv() returns references into them.
+ * ev_hash[] is an open-addressing hash table of the variable names:  Each
+ * entry holds the offset of a string in ev_env[] plus one or zero if the
+ * entry is empty.  If there is no hash index (ev_hashsize is zero), the
+ * strings are searched linearly.
+ */
+
+struct environ_s
+{
+  uint16_t ev_crefs;               /* Number of task groups sharing this */
+  uint16_t ev_hashsize;            /* Number of entries in ev_hash[] */
+  size_t ev_size;                  /* Size of the strings in ev_env[] */
+  FAR char *ev_env;                /* The packed name=value strings */
+  FAR uint32_t *ev_hash;           /* Hash index of the names */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -73,9 +104,10 @@ extern "C"
  * Name: env_dup
  *
  * Description:
- *   Copy the internal environment structure of a task.  This is the action
- *   that is performed when a new task is created: The new task has a private,
- *   exact duplicate of the parent task's environment.
+ *   Give a new task group the environment of the parent task.  The
+ *   environment is shared until one of the groups modifies it.  With
+ *   CONFIG_ARCH_ADDRENV, the strings do not lie in memory that is shared
+ *   with the child, so the new task gets a private copy.
  *
  * Input Parameters:
  *   group - The child task group to receive the newly allocated copy of the
@@ -91,6 +123,28 @@ extern "C"
 
 int env_dup(FAR struct task_group_s *group);
 
+/****************************************************************************
+ * Name: env_unshare
+ *
+ * Description:
+ *   Make sure that the environment of a task group is not shared with
+ *   other task groups before it is modified.  If it is shared, the group
+ *   gets a private copy.
+ *
+ * Input Parameters:
+ *   group - The task group whose environment is about to be modified
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if a copy could not be allocated.
+ *
+ * Assumptions:
+ *   - Not called from an interrupt handler
+ *   - Caller has pre-emption disabled
+ *
+ ****************************************************************************/
+
+int env_unshare(FAR struct task_group_s *group);
+
 /****************************************************************************
  * Name: env_release
  *
@@ -136,6 +190,28 @@ void env_release(FAR struct task_group_s *group);
 
 FAR char *env_findvar(FAR struct task_group_s *group, FAR const char *pname);
 
+/****************************************************************************
+ * Name: env_rehash
+ *
+ * Description:
+ *   Rebuild the hash index of an environment after its strings have been
+ *   modified.  If the index cannot be allocated, the environment is left
+ *   without an index and is searched linearly.
+ *
+ * Input Parameters:
+ *   env - The modified environment
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   - Not called from an interrupt handler
+ *   - Caller has pre-emption disabled
+ *
+ ****************************************************************************/
+
+void env_rehash(FAR struct environ_s *env);
+
 /****************************************************************************
  * Name: env_removevar
  *
@@ -55,6 +55,7 @@
 #include <nuttx/symtab.h>
 #include <nuttx/wqueue.h>
 #include <nuttx/kthread.h>
+#include <nuttx/sched_note.h>
 #include <nuttx/userspace.h>
 #include <nuttx/binfmt/binfmt.h>
 
@@ -62,6 +63,7 @@
 # include "paging/paging.h"
 #endif
 # include "wqueue/wqueue.h"
+# include "wdog/wdog.h"
 # include "init/init.h"
 
 /****************************************************************************
@@ -250,7 +252,17 @@ static inline void nx_start_application(void)
    * configured.
    */
 
+  sched_trace_begin(NOTE_TRACE_BOOT, "board");
   board_late_initialize();
+  sched_trace_end(NOTE_TRACE_BOOT, "board");
+#endif
+
+#ifdef CONFIG_INIT_DEFER_WAIT
+  /* Wait for the initialization steps deferred to the work queue */
+
+  sched_trace_begin(NOTE_TRACE_BOOT, "deferred");
+  nx_defer_wait();
+  sched_trace_end(NOTE_TRACE_BOOT, "deferred");
 #endif
 
   /* Start the application initialization task.  In a flat build, this is
@@ -286,7 +298,17 @@ static inline void nx_start_application(void)
    * configured.
    */
 
+  sched_trace_begin(NOTE_TRACE_BOOT, "board");
   board_late_initialize();
+  sched_trace_end(NOTE_TRACE_BOOT, "board");
+#endif
+
+#ifdef CONFIG_INIT_DEFER_WAIT
+  /* Wait for the initialization steps deferred to the work queue */
+
+  sched_trace_begin(NOTE_TRACE_BOOT, "deferred");
+  nx_defer_wait();
+  sched_trace_end(NOTE_TRACE_BOOT, "deferred");
 #endif
 
 #ifdef CONFIG_INIT_MOUNT
@@ -448,6 +470,14 @@ int nx_bringup(void)
 
   nx_pgworker();
 
+#ifdef CONFIG_WDOG_THREAD
+  /* Start the thread that executes the functions of expired watchdogs.  It
+   * must run before any thread that depends on timeouts.
+   */
+
+  wd_thread_start();
+#endif
+
   /* Start the worker thread that will serve as the device driver "bottom-
    * half" and will perform misc garbage clean-up.
    */
@@ -0,0 +1,238 @@
+/****************************************************************************
+ * sched/init/nx_deferinit.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/init.h>
+#include <nuttx/sched_note.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wqueue.h>
+
+#ifdef CONFIG_INIT_DEFER
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One deferred initialization step */
+
+struct nx_deferinit_s
+{
+  struct work_s work;               /* Work queue item of the step */
+  CODE int (*func)(FAR void *arg);  /* Initialization function; NULL: Free */
+  FAR void *arg;                    /* Argument of the function */
+  FAR const char *name;             /* Name of the step */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct nx_deferinit_s g_deferinit[CONFIG_INIT_DEFER_NITEMS];
+
+/* The number of pending steps and of the threads waiting for them */
+
+static unsigned int g_defer_pending;
+static unsigned int g_defer_nwaiters;
+static sem_t g_defer_sem = SEM_INITIALIZER(0);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nx_defer_run
+ *
+ * Description:
+ *   Perform one initialization step.
+ *
+ ****************************************************************************/
+
+static int nx_defer_run(FAR const char *name,
+                        CODE int (*func)(FAR void *arg), FAR void *arg)
+{
+  int ret;
+
+  sched_trace_begin(NOTE_TRACE_BOOT, name);
+  ret = func(arg);
+  sched_trace_end(NOTE_TRACE_BOOT, name);
+
+  if (ret < 0)
+    {
+      serr("ERROR: Initialization of %s failed: %d\n", name, ret);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: nx_defer_release
+ *
+ * Description:
+ *   Free the entry of a completed step and wake up the waiting threads when
+ *   it was the last one.
+ *
+ ****************************************************************************/
+
+static void nx_defer_release(FAR struct nx_deferinit_s *item)
+{
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+
+  item->func = NULL;
+  if (--g_defer_pending == 0)
+    {
+      while (g_defer_nwaiters > 0)
+        {
+          g_defer_nwaiters--;
+          nxsem_post(&g_defer_sem);
+        }
+    }
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: nx_defer_worker
+ *
+ * Description:
+ *   Perform a deferred initialization step on the work queue.
+ *
+ ****************************************************************************/
+
+static void nx_defer_worker(FAR void *arg)
+{
+  FAR struct nx_deferinit_s *item = (FAR struct nx_deferinit_s *)arg;
+
+  nx_defer_run(item->name, item->func, item->arg);
+  nx_defer_release(item);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nx_defer_init
+ *
+ * Description:
+ *   Perform an initialization step on the low priority work queue.  Steps
+ *   that do not depend on each other may run in parallel if there is more
+ *   than one low priority worker thread.  The step is performed by the
+ *   caller if CONFIG_INIT_DEFER_NITEMS steps are already pending.
+ *
+ *   This may be called from board_late_initialize() and later, when the
+ *   work queues are running.
+ *
+ * Input Parameters:
+ *   name - The name of the step.  It identifies the step in the boot
+ *          tracepoints and must stay valid until the step is complete.
+ *   func - The initialization function
+ *   arg  - The argument of the initialization function
+ *
+ * Returned Value:
+ *   Zero (OK) if the step was deferred.  Otherwise, the return value of
+ *   the initialization function that was performed by the caller.
+ *
+ ****************************************************************************/
+
+int nx_defer_init(FAR const char *name, CODE int (*func)(FAR void *arg),
+                  FAR void *arg)
+{
+  FAR struct nx_deferinit_s *item = NULL;
+  irqstate_t flags;
+  int ret;
+  int i;
+
+  DEBUGASSERT(name != NULL && func != NULL);
+
+  flags = enter_critical_section();
+
+  for (i = 0; i < CONFIG_INIT_DEFER_NITEMS; i++)
+    {
+      if (g_deferinit[i].func == NULL)
+        {
+          item       = &g_deferinit[i];
+          item->func = func;
+          item->arg  = arg;
+          item->name = name;
+          g_defer_pending++;
+          break;
+        }
+    }
+
+  leave_critical_section(flags);
+
+  if (item == NULL)
+    {
+      return nx_defer_run(name, func, arg);
+    }
+
+  ret = work_queue(LPWORK, &item->work, nx_defer_worker, item, 0);
+  if (ret < 0)
+    {
+      nx_defer_release(item);
+      return nx_defer_run(name, func, arg);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nx_defer_wait
+ *
+ * Description:
+ *   Wait until all deferred initialization steps are complete.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nx_defer_wait(void)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(!up_interrupt_context());
+
+  flags = enter_critical_section();
+
+  while (g_defer_pending > 0)
+    {
+      g_defer_nwaiters++;
+      nxsem_wait_uninterruptible(&g_defer_sem);
+    }
+
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_INIT_DEFER */
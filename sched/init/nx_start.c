@@ -523,6 +523,7 @@ void nx_start(void)
       tasklist = TLIST_HEAD(TSTATE_TASK_RUNNING);
 #endif
       dq_addfirst((FAR dq_entry_t *)&g_idletcb[cpu], tasklist);
+      nxsched_index_add(tasklist, &g_idletcb[cpu].cmn);
 
       /* Mark the idle task as the running task */
 
@@ -545,6 +546,12 @@ void nx_start(void)
 
   nxsem_initialize();
 
+  /* From here on, the stages of the initialization are reported to the
+   * boot tracepoints (NOTE_TRACE_BOOT).
+   */
+
+  sched_trace_begin(NOTE_TRACE_BOOT, "memory");
+
 #if defined(MM_KERNEL_USRHEAP_INIT) || defined(CONFIG_MM_KERNEL_HEAP) || \
     defined(CONFIG_MM_PGALLOC)
   /* Initialize the memory manager */
@@ -593,10 +600,14 @@ void nx_start(void)
   iob_initialize();
 #endif
 
+  sched_trace_end(NOTE_TRACE_BOOT, "memory");
+
   /* The memory manager is available */
 
   g_nx_initstate = OSINIT_MEMORY;
 
+  sched_trace_begin(NOTE_TRACE_BOOT, "os");
+
 #if defined(CONFIG_SCHED_HAVE_PARENT) && defined(CONFIG_SCHED_CHILD_STATUS)
   /* Initialize tasking data structures */
 
@@ -675,14 +686,20 @@ void nx_start(void)
     }
 #endif
 
+  sched_trace_end(NOTE_TRACE_BOOT, "os");
+
   /* Initialize the file system (needed to support device drivers) */
 
+  sched_trace_begin(NOTE_TRACE_BOOT, "fs");
   fs_initialize();
+  sched_trace_end(NOTE_TRACE_BOOT, "fs");
 
 #ifdef CONFIG_NET
   /* Initialize the networking system */
 
+  sched_trace_begin(NOTE_TRACE_BOOT, "net");
   net_initialize();
+  sched_trace_end(NOTE_TRACE_BOOT, "net");
 #endif
 
   /* Initialize Hardware Facilities *****************************************/
@@ -693,6 +710,7 @@ void nx_start(void)
    * that are different for each  processor and hardware platform.
    */
 
+  sched_trace_begin(NOTE_TRACE_BOOT, "hardware");
   up_initialize();
 
 #ifdef CONFIG_BOARD_EARLY_INITIALIZE
@@ -704,12 +722,16 @@ void nx_start(void)
   board_early_initialize();
 #endif
 
+  sched_trace_end(NOTE_TRACE_BOOT, "hardware");
+
   /* Hardware resources are now available */
 
   g_nx_initstate = OSINIT_HARDWARE;
 
   /* Setup for Multi-Tasking ************************************************/
 
+  sched_trace_begin(NOTE_TRACE_BOOT, "libs");
+
 #ifdef CONFIG_MM_SHM
   /* Initialize shared memory support */
 
@@ -728,11 +750,14 @@ void nx_start(void)
   binfmt_initialize();
 #endif
 
+  sched_trace_end(NOTE_TRACE_BOOT, "libs");
+
   /* IDLE Group Initialization **********************************************/
 
   /* Announce that the CPU0 IDLE task has started */
 
   sched_note_start(&g_idletcb[0].cmn);
+  sched_trace_begin(NOTE_TRACE_BOOT, "idle");
 
 #ifdef CONFIG_SMP
   /* Initialize the IDLE group for the IDLE task of each CPU */
@@ -770,6 +795,8 @@ void nx_start(void)
       g_idletcb[cpu].cmn.group->tg_flags = GROUP_FLAG_NOCLDWAIT;
     }
 
+  sched_trace_end(NOTE_TRACE_BOOT, "idle");
+
   /* Start SYSLOG ***********************************************************/
 
   /* Late initialization of the system logging device.  Some SYSLOG channel
@@ -777,7 +804,9 @@ void nx_start(void)
    * depend on having IDLE task file structures setup.
    */
 
+  sched_trace_begin(NOTE_TRACE_BOOT, "syslog");
   syslog_initialize();
+  sched_trace_end(NOTE_TRACE_BOOT, "syslog");
 
 #ifdef CONFIG_SMP
   /* Start all CPUs *********************************************************/
@@ -794,7 +823,9 @@ void nx_start(void)
 
   /* Then start the other CPUs */
 
+  sched_trace_begin(NOTE_TRACE_BOOT, "smp");
   DEBUGVERIFY(nx_smp_start());
+  sched_trace_end(NOTE_TRACE_BOOT, "smp");
 
 #endif /* CONFIG_SMP */
 
@@ -806,7 +837,9 @@ void nx_start(void)
 
   /* Create initial tasks and bring-up the system */
 
+  sched_trace_begin(NOTE_TRACE_BOOT, "bringup");
   DEBUGVERIFY(nx_bringup());
+  sched_trace_end(NOTE_TRACE_BOOT, "bringup");
 
 #ifdef CONFIG_SMP
   /* Let other threads have access to the memory manager */
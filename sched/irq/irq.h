@@ -78,11 +78,12 @@ struct irq_info_s
   clock_t start;     /* Time interrupt attached */
 #ifdef CONFIG_HAVE_LONG_LONG
   uint64_t count;    /* Number of interrupts on this IRQ */
+  uint64_t total;    /* Total execution time on this IRQ (ns) */
 #else
   uint32_t mscount;  /* Number of interrupts on this IRQ (MS) */
   uint32_t lscount;  /* Number of interrupts on this IRQ (LS) */
 #endif
-  uint32_t time;     /* Maximum execution time on this IRQ */
+  uint32_t time;     /* Maximum execution time on this IRQ (ns) */
 #endif
 };
 
@@ -135,10 +135,12 @@ int irq_attach(int irq, xcpt_t isr, FAR void *arg)
       g_irqvector[ndx].start   = clock_systime_ticks();
 #ifdef CONFIG_HAVE_LONG_LONG
       g_irqvector[ndx].count   = 0;
+      g_irqvector[ndx].total   = 0;
 #else
       g_irqvector[ndx].mscount = 0;
       g_irqvector[ndx].lscount = 0;
 #endif
+      g_irqvector[ndx].time    = 0;
 #endif
 
       leave_critical_section(flags);
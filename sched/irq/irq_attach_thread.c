@@ -0,0 +1,296 @@
+/****************************************************************************
+ * sched/irq/irq_attach_thread.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <queue.h>
+#include <errno.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+
+#include "irq/irq.h"
+
+#ifdef CONFIG_IRQ_THREAD
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct irq_thread_s
+{
+  FAR struct irq_thread_s *flink;
+
+  xcpt_t isr;        /* The top half, run in the interrupt context */
+  xcpt_t isrthread;  /* The bottom half, run by the thread */
+  FAR void *arg;     /* The argument provided to both halves */
+  sem_t sem;         /* Posted by the top half to wake the thread */
+  pid_t pid;         /* The thread that runs the bottom half */
+  int irq;           /* The IRQ number */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The list of the IRQs with an attached thread */
+
+static sq_queue_t g_irqthreads;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irq_thread_find
+ *
+ * Description:
+ *   Find the thread attached to an IRQ.  Must be called within a critical
+ *   section.
+ *
+ ****************************************************************************/
+
+static FAR struct irq_thread_s *irq_thread_find(int irq)
+{
+  FAR struct irq_thread_s *info;
+
+  for (info = (FAR struct irq_thread_s *)sq_peek(&g_irqthreads);
+       info != NULL;
+       info = info->flink)
+    {
+      if (info->irq == irq)
+        {
+          break;
+        }
+    }
+
+  return info;
+}
+
+/****************************************************************************
+ * Name: irq_thread_isr
+ *
+ * Description:
+ *   The interrupt handler attached to the IRQ.  It runs the top half and,
+ *   if that asks for it, masks the IRQ and wakes the thread.  The IRQ
+ *   stays masked until the bottom half has run, so a level-triggered
+ *   source that only the bottom half can clear does not interrupt the
+ *   thread over and over.
+ *
+ ****************************************************************************/
+
+static int irq_thread_isr(int irq, FAR void *context, FAR void *arg)
+{
+  FAR struct irq_thread_s *info = (FAR struct irq_thread_s *)arg;
+  int ret = IRQ_WAKE_THREAD;
+
+  if (info->isr != NULL)
+    {
+      ret = info->isr(irq, context, info->arg);
+    }
+
+  if (ret == IRQ_WAKE_THREAD)
+    {
+      up_disable_irq(irq);
+      nxsem_post(&info->sem);
+      ret = OK;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: irq_thread_main
+ *
+ * Description:
+ *   The thread that runs the bottom half of a threaded interrupt.
+ *
+ ****************************************************************************/
+
+static int irq_thread_main(int argc, FAR char *argv[])
+{
+  FAR struct irq_thread_s *info;
+
+  info = (FAR struct irq_thread_s *)((uintptr_t)strtoul(argv[1], NULL, 0));
+
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&info->sem);
+      info->isrthread(info->irq, NULL, info->arg);
+      up_enable_irq(info->irq);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: irq_thread_detach
+ *
+ * Description:
+ *   Detach the IRQ and delete the thread attached to it.
+ *
+ ****************************************************************************/
+
+static int irq_thread_detach(int irq)
+{
+  FAR struct irq_thread_s *info;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  info = irq_thread_find(irq);
+  if (info != NULL)
+    {
+      irq_detach(irq);
+      sq_rem((FAR sq_entry_t *)info, &g_irqthreads);
+    }
+
+  leave_critical_section(flags);
+
+  if (info == NULL)
+    {
+      return -ENOENT;
+    }
+
+  kthread_delete(info->pid);
+  nxsem_destroy(&info->sem);
+  kmm_free(info);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: irq_attach_thread
+ *
+ * Description:
+ *   Attach a threaded interrupt.  'isr' is the top half.  It runs in the
+ *   interrupt context and returns IRQ_WAKE_THREAD to have 'isrthread' run
+ *   by a kernel thread of its own.  The IRQ is masked from then on until
+ *   'isrthread' returns.  Each threaded IRQ has its own thread, so the
+ *   priority of the bottom half can be chosen per device instead of
+ *   sharing the priority and the queue of a work queue with all the other
+ *   drivers.
+ *
+ *   The 'context' argument of 'isrthread' is always NULL.
+ *
+ * Input Parameters:
+ *   irq        - The IRQ number
+ *   isr        - The top half.  NULL wakes the thread on every interrupt.
+ *   isrthread  - The bottom half.  NULL detaches the IRQ and deletes the
+ *                thread.  Disable the IRQ before detaching it.
+ *   arg        - The argument provided to both halves
+ *   priority   - The priority of the thread
+ *   stack_size - The stack size of the thread
+ *
+ * Returned Value:
+ *   The ID of the thread on success, for example to bind it to a CPU with
+ *   nxsched_set_affinity(); zero if the IRQ was detached; a negated errno
+ *   value on failure.
+ *
+ ****************************************************************************/
+
+int irq_attach_thread(int irq, xcpt_t isr, xcpt_t isrthread, FAR void *arg,
+                      int priority, int stack_size)
+{
+  FAR struct irq_thread_s *info;
+  FAR char *argv[2];
+  char arg1[16];
+  char name[16];
+  irqstate_t flags;
+  pid_t pid;
+  int ret;
+
+  if (isrthread == NULL)
+    {
+      return irq_thread_detach(irq);
+    }
+
+  flags = enter_critical_section();
+  info = irq_thread_find(irq);
+  leave_critical_section(flags);
+
+  if (info != NULL)
+    {
+      return -EBUSY;
+    }
+
+  info = (FAR struct irq_thread_s *)kmm_zalloc(sizeof(*info));
+  if (info == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  info->isr       = isr;
+  info->isrthread = isrthread;
+  info->arg       = arg;
+  info->irq       = irq;
+
+  /* The semaphore is used for signaling and, hence, should not have
+   * priority inheritance enabled.
+   */
+
+  nxsem_init(&info->sem, 0, 0);
+  nxsem_setprotocol(&info->sem, SEM_PRIO_NONE);
+
+  snprintf(arg1, sizeof(arg1), "0x%" PRIxPTR, (uintptr_t)info);
+  snprintf(name, sizeof(name), "irq%d", irq);
+  argv[0] = arg1;
+  argv[1] = NULL;
+
+  pid = kthread_create(name, priority, stack_size, irq_thread_main, argv);
+  if (pid < 0)
+    {
+      ret = pid;
+      goto errout_with_info;
+    }
+
+  info->pid = pid;
+
+  ret = irq_attach(irq, irq_thread_isr, info);
+  if (ret < 0)
+    {
+      kthread_delete(pid);
+      goto errout_with_info;
+    }
+
+  flags = enter_critical_section();
+  sq_addlast((FAR sq_entry_t *)info, &g_irqthreads);
+  leave_critical_section(flags);
+  return pid;
+
+errout_with_info:
+  nxsem_destroy(&info->sem);
+  kmm_free(info);
+  return ret;
+}
+
+#endif /* CONFIG_IRQ_THREAD */
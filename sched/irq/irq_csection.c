@@ -109,7 +109,15 @@ static inline bool irq_waitlock(int cpu)
 {
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   FAR struct tcb_s *tcb = current_task(cpu);
+  unsigned int spins = 0;
+#endif
+#ifdef CONFIG_SCHED_CRITMONITOR
+  bool contended = false;
+  uint32_t start = 0;
+  uint32_t elapsed;
+#endif
 
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we are waiting for a spinlock */
 
   sched_note_spinlock(tcb, &g_cpu_irqlock);
@@ -121,30 +129,67 @@ static inline bool irq_waitlock(int cpu)
 
   while (spin_trylock_wo_note(&g_cpu_irqlock) == SP_LOCKED)
     {
-      /* Is a pause request pending? */
+#ifdef CONFIG_SCHED_CRITMONITOR
+      /* Another CPU holds the lock:  Measure how long we wait for it */
 
-      if (up_cpu_pausereq(cpu))
+      if (!contended)
         {
-          /* Yes.. some other CPU is requesting to pause this CPU!
-           * Abort the wait and return false.
-           */
+          contended = true;
+          start     = up_critmon_gettime();
+        }
+#endif
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+      spins++;
+#endif
+
+      /* Wait with plain reads until the lock is released.  Repeating the
+       * test-and-set would move the cache line between the waiting CPUs.
+       */
+
+      do
+        {
+          /* Is a pause request pending? */
+
+          if (up_cpu_pausereq(cpu))
+            {
+              /* Yes.. some other CPU is requesting to pause this CPU!
+               * Abort the wait and return false.
+               */
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
-          /* Notify that we are waiting for a spinlock */
+              /* Notify that we are waiting for a spinlock */
 
-          sched_note_spinabort(tcb, &g_cpu_irqlock);
+              sched_note_spinabort(tcb, &g_cpu_irqlock);
 #endif
 
-          return false;
+              return false;
+            }
+
+          SP_DSB();
         }
+      while (spin_islocked(&g_cpu_irqlock));
     }
 
   /* We have g_cpu_irqlock! */
 
+#ifdef CONFIG_SCHED_CRITMONITOR
+  if (contended)
+    {
+      elapsed = up_critmon_gettime() - start;
+      g_crit_contended[cpu]++;
+
+      if (elapsed > g_crit_waitmax[cpu])
+        {
+          g_crit_waitmax[cpu] = elapsed;
+        }
+    }
+#endif
+
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we have the spinlock */
 
-  sched_note_spinlocked(tcb, &g_cpu_irqlock);
+  sched_note_spinlocked(tcb, &g_cpu_irqlock, spins);
 #endif
 
   return true;
@@ -39,6 +39,7 @@
 
 #include <nuttx/config.h>
 
+#include <assert.h>
 #include <debug.h>
 #include <nuttx/arch.h>
 #include <nuttx/irq.h>
@@ -75,6 +76,33 @@
      while (0)
 #endif
 
+/* ADD_TIME - Account the execution time of one interrupt on this IRQ */
+
+#ifndef CONFIG_SCHED_IRQMONITOR
+#  define ADD_TIME(ndx, nsec)
+#elif defined(CONFIG_HAVE_LONG_LONG)
+#  define ADD_TIME(ndx, nsec) \
+     do \
+       { \
+         g_irqvector[ndx].total += (nsec); \
+         if ((nsec) > g_irqvector[ndx].time) \
+           { \
+             g_irqvector[ndx].time = (nsec); \
+           } \
+       } \
+     while (0)
+#else
+#  define ADD_TIME(ndx, nsec) \
+     do \
+       { \
+         if ((nsec) > g_irqvector[ndx].time) \
+           { \
+             g_irqvector[ndx].time = (nsec); \
+           } \
+       } \
+     while (0)
+#endif
+
 /* CALL_VECTOR - Call the interrupt service routine attached to this
  * interrupt request
  */
@@ -93,10 +121,7 @@
          vector(irq, context, arg); \
          elapsed = up_critmon_gettime() - start; \
          up_critmon_convert(elapsed, &delta); \
-         if (delta.tv_nsec > g_irqvector[ndx].time) \
-           { \
-             g_irqvector[ndx].time = delta.tv_nsec; \
-           } \
+         ADD_TIME(ndx, (uint32_t)delta.tv_nsec); \
        } \
      while (0)
 #else
@@ -110,10 +135,7 @@
          vector(irq, context, arg); \
          clock_systime_timespec(&end); \
          clock_timespec_subtract(&end, &start, &delta); \
-         if (delta.tv_nsec > g_irqvector[ndx].time) \
-           { \
-             g_irqvector[ndx].time = delta.tv_nsec; \
-           } \
+         ADD_TIME(ndx, (uint32_t)delta.tv_nsec); \
        } \
      while (0)
 #endif /* CONFIG_SCHED_IRQMONITOR */
@@ -138,6 +160,11 @@ void irq_dispatch(int irq, FAR void *context)
   FAR void *arg = NULL;
   unsigned int ndx = irq;
 
+  /* irq_initialize() points every entry of g_irqvector[] to
+   * irq_unexpected_isr() and irq_attach() restores it on detach, so the
+   * handler of an entry is never NULL and need not be checked here.
+   */
+
 #if NR_IRQS > 0
   if ((unsigned)irq < NR_IRQS)
     {
@@ -145,20 +172,16 @@ void irq_dispatch(int irq, FAR void *context)
       ndx = g_irqmap[irq];
       if (ndx < CONFIG_ARCH_NUSER_INTERRUPTS)
         {
-          if (g_irqvector[ndx].handler)
-            {
-              vector = g_irqvector[ndx].handler;
-              arg    = g_irqvector[ndx].arg;
-            }
+          DEBUGASSERT(g_irqvector[ndx].handler != NULL);
+          vector = g_irqvector[ndx].handler;
+          arg    = g_irqvector[ndx].arg;
 
           INCR_COUNT(ndx);
         }
 #else
-      if (g_irqvector[ndx].handler)
-        {
-          vector = g_irqvector[ndx].handler;
-          arg    = g_irqvector[ndx].arg;
-        }
+      DEBUGASSERT(g_irqvector[ndx].handler != NULL);
+      vector = g_irqvector[ndx].handler;
+      arg    = g_irqvector[ndx].arg;
 
       INCR_COUNT(ndx);
 #endif
@@ -93,6 +93,7 @@ void irq_initialize(void)
       g_irqvector[i].start   = 0;
 #ifdef CONFIG_HAVE_LONG_LONG
       g_irqvector[i].count   = 0;
+      g_irqvector[i].total   = 0;
 #else
       g_irqvector[i].mscount = 0;
       g_irqvector[i].lscount = 0;
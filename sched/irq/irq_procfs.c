@@ -61,26 +61,29 @@
 
 /* Output format:
  *
- *            1111111111222222222233333333334444444444
- *   1234567890123456789012345678901234567890123456789
+ *            11111111112222222222333333333344444444445555
+ *   12345678901234567890123456789012345678901234567890123
  *
- *   IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME
- *   DDD XXXXXXXX XXXXXXXX DDDDDDDDDD DDDD.DDD DDDD
+ *   IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME  AVG
+ *   DDD XXXXXXXX XXXXXXXX DDDDDDDDDD DDDD.DDD DDDD DDDD
+ *
+ * TIME is the maximum and AVG the average execution time of the interrupt
+ * handler, both in microseconds.
  *
  * NOTE:  This assumes that an address can be represented in 32-bits.  In
  * the typical configuration where CONFIG_HAVE_LONG_LONG=y, the COUNT field
  * may not be wide enough.
  */
 
-#define HDR_FMT "IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME\n"
-#define IRQ_FMT "%3u %08lx %08lx %10lu %4lu.%03lu %4lu\n"
+#define HDR_FMT "IRQ HANDLER  ARGUMENT    COUNT    RATE    TIME  AVG\n"
+#define IRQ_FMT "%3u %08lx %08lx %10lu %4lu.%03lu %4lu %4lu\n"
 
 /* Determines the size of an intermediate buffer that must be large enough
  * to handle the longest line generated by this logic (plus a couple of
  * bytes).
  */
 
-#define IRQ_LINELEN 50
+#define IRQ_LINELEN 56
 
 /****************************************************************************
  * Private Types
@@ -165,6 +168,7 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
   unsigned long intpart;
   unsigned long fracpart;
   unsigned long count;
+  unsigned long avg;
 
   DEBUGASSERT(irqfile != NULL);
 
@@ -176,6 +180,7 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
   info->start   = now;
 #ifdef CONFIG_HAVE_LONG_LONG
   info->count   = 0;
+  info->total   = 0;
 #else
   info->mscount = 0;
   info->lscount = 0;
@@ -243,6 +248,10 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
     {
       count = (unsigned long)copy.count;
     }
+
+  /* The average execution time in microseconds */
+
+  avg = (unsigned long)(copy.total / copy.count / 1000);
 #else
 #  error Missing logic
 #endif
@@ -254,7 +263,7 @@ static int irq_callback(int irq, FAR struct irq_info_s *info,
                       (unsigned long)((uintptr_t)copy.handler),
                       (unsigned long)((uintptr_t)copy.arg),
                       count, intpart, fracpart,
-                      (unsigned long)copy.time / 1000);
+                      (unsigned long)copy.time / 1000, avg);
 
   copysize  = procfs_memcpy(irqfile->line, linesize, irqfile->buffer,
                             irqfile->remaining, &irqfile->offset);
@@ -51,6 +51,8 @@
 #include <nuttx/module.h>
 #include <nuttx/lib/modlib.h>
 
+#include "module/module.h"
+
 #ifdef CONFIG_MODULE
 
 /****************************************************************************
@@ -141,58 +143,26 @@ static void mod_dumpinitializer(mod_initializer_t initializer,
 #endif
 
 /****************************************************************************
- * Public Functions
- ****************************************************************************/
-
-/****************************************************************************
- * Name: insmod
+ * Name: mod_loadfile
  *
  * Description:
- *   Verify that the file is an ELF module binary and, if so, load the
- *   module into kernel memory and initialize it for use.
- *
- *   NOTE: modlib_setsymtab() had to have been called in board-specific OS
- *   logic prior to calling this function from application logic (perhaps via
- *   boardctl(BOARDIOC_OS_SYMTAB).  Otherwise, insmod will be unable to
- *   resolve symbols in the OS module.
- *
- * Input Parameters:
- *
- *   filename - Full path to the module binary to be loaded
- *   modname  - The name that can be used to refer to the module after
- *     it has been loaded.
+ *   Load the module binary 'filename' into kernel memory, bind it to the
+ *   kernel symbol table and initialize it.  The registry lock must be held.
  *
  * Returned Value:
- *   A non-NULL module handle that can be used on subsequent calls to other
- *   module interfaces is returned on success.  If insmod() was unable to
- *   load the module insmod() will return a NULL handle and the errno
- *   variable will be set appropriately.
+ *   Zero (OK) on success; a negated errno value on failure.
  *
  ****************************************************************************/
 
-FAR void *insmod(FAR const char *filename, FAR const char *modname)
+static int mod_loadfile(FAR struct module_s *modp,
+                        FAR const char *filename)
 {
   struct mod_loadinfo_s loadinfo;
-  FAR struct module_s *modp;
   mod_initializer_t initializer;
   int ret;
 
-  DEBUGASSERT(filename != NULL && modname != NULL);
   binfo("Loading file: %s\n", filename);
 
-  /* Get exclusive access to the module registry */
-
-  modlib_registry_lock();
-
-  /* Check if this module is already installed */
-
-  if (modlib_registry_find(modname) != NULL)
-    {
-      modlib_registry_unlock();
-      ret = -EEXIST;
-      goto errout_with_lock;
-    }
-
   /* Initialize the ELF library to load the program binary. */
 
   ret = modlib_initialize(filename, &loadinfo);
@@ -200,21 +170,12 @@ FAR void *insmod(FAR const char *filename, FAR const char *modname)
   if (ret != 0)
     {
       berr("ERROR: Failed to initialize to load module: %d\n", ret);
-      goto errout_with_lock;
-    }
-
-  /* Allocate a module registry entry to hold the module data */
-
-  modp = (FAR struct module_s *)kmm_zalloc(sizeof(struct module_s));
-  if (ret != 0)
-    {
-      binfo("Failed to initialize for load of ELF program: %d\n", ret);
-      goto errout_with_loadinfo;
+      return ret;
     }
 
-  /* Save the module name in the registry entry */
-
-  strncpy(modp->modname, modname, MODLIB_NAMEMAX);
+#ifdef CONFIG_MODULE_LAZY
+retry:
+#endif
 
   /* Load the program binary */
 
@@ -223,7 +184,7 @@ FAR void *insmod(FAR const char *filename, FAR const char *modname)
   if (ret != 0)
     {
       binfo("Failed to load ELF program binary: %d\n", ret);
-      goto errout_with_registry_entry;
+      goto errout_with_loadinfo;
     }
 
   /* Bind the program to the kernel symbol table */
@@ -232,6 +193,22 @@ FAR void *insmod(FAR const char *filename, FAR const char *modname)
   if (ret != 0)
     {
       binfo("Failed to bind symbols program binary: %d\n", ret);
+
+#ifdef CONFIG_MODULE_LAZY
+      /* The missing symbols may be exported by modules that are registered
+       * but not loaded yet.  Load those modules and start over.
+       */
+
+      if (ret == -ENOENT && mod_loadstubs() > 0)
+        {
+          modlib_unload(&loadinfo);
+#if CONFIG_MODLIB_MAXDEPEND > 0
+          modlib_undepend(modp);
+#endif
+          goto retry;
+        }
+#endif
+
       goto errout_with_load;
     }
 
@@ -266,25 +243,264 @@ FAR void *insmod(FAR const char *filename, FAR const char *modname)
       goto errout_with_load;
     }
 
-  /* Add the new module entry to the registry */
-
-  modlib_registry_add(modp);
-
   modlib_uninitialize(&loadinfo);
-  modlib_registry_unlock();
-  return (FAR void *)modp;
+  return OK;
 
 errout_with_load:
   modlib_unload(&loadinfo);
+#if CONFIG_MODLIB_MAXDEPEND > 0
   modlib_undepend(modp);
-errout_with_registry_entry:
-  kmm_free(modp);
+#endif
+#if defined(CONFIG_ARCH_USE_MODULE_TEXT)
+  modp->textalloc   = NULL;
+  modp->dataalloc   = NULL;
+#else
+  modp->alloc       = NULL;
+#endif
 errout_with_loadinfo:
   modlib_uninitialize(&loadinfo);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: mod_loadstub
+ *
+ * Description:
+ *   modlib_registry_foreach() callback function.  Load the module if it has
+ *   been registered by insmod_lazy() and is not loaded yet.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODULE_LAZY
+static int mod_loadstub(FAR struct module_s *modp, FAR void *arg)
+{
+  FAR int *nloaded = (FAR int *)arg;
+
+  if (modp->filename != NULL && mod_loadlazy(modp) >= 0)
+    {
+      (*nloaded)++;
+    }
+
+  return 0;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mod_loadlazy
+ *
+ * Description:
+ *   Load a module that was registered by insmod_lazy() if it is not loaded
+ *   yet.  The registry lock must be held.
+ *
+ * Returned Value:
+ *   Zero (OK) if the module is loaded; a negated errno value if it could
+ *   not be loaded.  The module stays registered in that case.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODULE_LAZY
+int mod_loadlazy(FAR struct module_s *modp)
+{
+  FAR char *filename = modp->filename;
+  int ret;
+
+  if (filename == NULL)
+    {
+      return OK;
+    }
+
+  /* Clear the file name first:  This marks the module as loaded for any
+   * module that is loaded while binding this one.
+   */
+
+  modp->filename = NULL;
+
+  ret = mod_loadfile(modp, filename);
+  if (ret < 0)
+    {
+      berr("ERROR: Failed to load module %s: %d\n", filename, ret);
+      modp->filename = filename;
+      return ret;
+    }
+
+  kmm_free(filename);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: mod_loadstubs
+ *
+ * Description:
+ *   Load all modules that were registered by insmod_lazy() and are not
+ *   loaded yet.  The registry lock must be held.
+ *
+ * Returned Value:
+ *   The number of modules that were loaded.
+ *
+ ****************************************************************************/
+
+int mod_loadstubs(void)
+{
+  int nloaded = 0;
+
+  modlib_registry_foreach(mod_loadstub, &nloaded);
+  return nloaded;
+}
+#endif
+
+/****************************************************************************
+ * Name: insmod
+ *
+ * Description:
+ *   Verify that the file is an ELF module binary and, if so, load the
+ *   module into kernel memory and initialize it for use.
+ *
+ *   NOTE: modlib_setsymtab() had to have been called in board-specific OS
+ *   logic prior to calling this function from application logic (perhaps via
+ *   boardctl(BOARDIOC_OS_SYMTAB).  Otherwise, insmod will be unable to
+ *   resolve symbols in the OS module.
+ *
+ * Input Parameters:
+ *
+ *   filename - Full path to the module binary to be loaded
+ *   modname  - The name that can be used to refer to the module after
+ *     it has been loaded.
+ *
+ * Returned Value:
+ *   A non-NULL module handle that can be used on subsequent calls to other
+ *   module interfaces is returned on success.  If insmod() was unable to
+ *   load the module insmod() will return a NULL handle and the errno
+ *   variable will be set appropriately.
+ *
+ ****************************************************************************/
+
+FAR void *insmod(FAR const char *filename, FAR const char *modname)
+{
+  FAR struct module_s *modp;
+  int ret;
+
+  DEBUGASSERT(filename != NULL && modname != NULL);
+
+  /* Get exclusive access to the module registry */
+
+  modlib_registry_lock();
+
+  /* Check if this module is already installed */
+
+  if (modlib_registry_find(modname) != NULL)
+    {
+      ret = -EEXIST;
+      goto errout_with_lock;
+    }
+
+  /* Allocate a module registry entry to hold the module data */
+
+  modp = (FAR struct module_s *)kmm_zalloc(sizeof(struct module_s));
+  if (modp == NULL)
+    {
+      berr("ERROR: Failed to allocate the module registry entry\n");
+      ret = -ENOMEM;
+      goto errout_with_lock;
+    }
+
+  /* Save the module name in the registry entry */
+
+  strncpy(modp->modname, modname, MODLIB_NAMEMAX);
+
+  /* Load and initialize the module */
+
+  ret = mod_loadfile(modp, filename);
+  if (ret < 0)
+    {
+      kmm_free(modp);
+      goto errout_with_lock;
+    }
+
+  /* Add the new module entry to the registry */
+
+  modlib_registry_add(modp);
+  modlib_registry_unlock();
+  return (FAR void *)modp;
+
 errout_with_lock:
   modlib_registry_unlock();
   set_errno(-ret);
   return NULL;
 }
 
+/****************************************************************************
+ * Name: insmod_lazy
+ *
+ * Description:
+ *   Register a module without loading it.  The module is loaded on its
+ *   first use:  When its symbols are looked up with modsym() or when
+ *   another module that is being loaded has symbols that are not exported
+ *   by any loaded module.
+ *
+ * Input Parameters:
+ *   filename - Full path to the module binary to be loaded
+ *   modname  - The name that can be used to refer to the module.
+ *
+ * Returned Value:
+ *   A non-NULL module handle that can be used on subsequent calls to other
+ *   module interfaces is returned on success.  Otherwise, a NULL handle is
+ *   returned and the errno variable is set appropriately.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MODULE_LAZY
+FAR void *insmod_lazy(FAR const char *filename, FAR const char *modname)
+{
+  FAR struct module_s *modp;
+  int ret;
+
+  DEBUGASSERT(filename != NULL && modname != NULL);
+
+  /* Get exclusive access to the module registry */
+
+  modlib_registry_lock();
+
+  /* Check if this module is already installed */
+
+  if (modlib_registry_find(modname) != NULL)
+    {
+      ret = -EEXIST;
+      goto errout_with_lock;
+    }
+
+  /* Allocate a module registry entry that only holds the file name */
+
+  modp = (FAR struct module_s *)kmm_zalloc(sizeof(struct module_s));
+  if (modp == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout_with_lock;
+    }
+
+  modp->filename = (FAR char *)kmm_malloc(strlen(filename) + 1);
+  if (modp->filename == NULL)
+    {
+      kmm_free(modp);
+      ret = -ENOMEM;
+      goto errout_with_lock;
+    }
+
+  strcpy(modp->filename, filename);
+  strncpy(modp->modname, modname, MODLIB_NAMEMAX);
+
+  modlib_registry_add(modp);
+  modlib_registry_unlock();
+  return (FAR void *)modp;
+
+errout_with_lock:
+  modlib_registry_unlock();
+  set_errno(-ret);
+  return NULL;
+}
+#endif
+
 #endif /* CONFIG_MODULE */
@@ -47,6 +47,8 @@
 #include <nuttx/symtab.h>
 #include <nuttx/lib/modlib.h>
 
+#include "module/module.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -98,6 +100,17 @@ FAR const void *modsym(FAR void *handle, FAR const char *name)
       goto errout_with_lock;
     }
 
+#ifdef CONFIG_MODULE_LAZY
+  /* Load a lazily registered module on its first use */
+
+  ret = mod_loadlazy(modp);
+  if (ret < 0)
+    {
+      err = -ret;
+      goto errout_with_lock;
+    }
+#endif
+
   /* Does the module have a symbol table? */
 
   if (modp->modinfo.exports == NULL || modp->modinfo.nexports == 0)
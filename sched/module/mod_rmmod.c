@@ -172,6 +172,13 @@ int rmmod(FAR void *handle)
 
   /* And free the registry entry */
 
+#ifdef CONFIG_MODULE_LAZY
+  if (modp->filename != NULL)
+    {
+      kmm_free(modp->filename);
+    }
+#endif
+
   kmm_free(modp);
   return OK;
 
@@ -0,0 +1,67 @@
+/****************************************************************************
+ * sched/module/module.h
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __SCHED_MODULE_MODULE_H
+#define __SCHED_MODULE_MODULE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#include <nuttx/lib/modlib.h>
+
+#ifdef CONFIG_MODULE_LAZY
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mod_loadlazy
+ *
+ * Description:
+ *   Load a module that was registered by insmod_lazy() if it is not loaded
+ *   yet.  The registry lock must be held.
+ *
+ * Returned Value:
+ *   Zero (OK) if the module is loaded; a negated errno value if it could
+ *   not be loaded.  The module stays registered in that case.
+ *
+ ****************************************************************************/
+
+int mod_loadlazy(FAR struct module_s *modp);
+
+/****************************************************************************
+ * Name: mod_loadstubs
+ *
+ * Description:
+ *   Load all modules that were registered by insmod_lazy() and are not
+ *   loaded yet.  The registry lock must be held.
+ *
+ * Returned Value:
+ *   The number of modules that were loaded.
+ *
+ ****************************************************************************/
+
+int mod_loadstubs(void);
+
+#endif /* CONFIG_MODULE_LAZY */
+#endif /* __SCHED_MODULE_MODULE_H */
@@ -349,11 +349,20 @@ int nxmq_do_send(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg,
 
   /* Search the message list to find the location to insert the new
    * message. Each is list is maintained in ascending priority order.
+   *
+   * A message goes after all messages of the same or a higher priority.
+   * Most messages are sent with no higher priority than the last message
+   * in the queue, so check that first to avoid traversing the list.
    */
 
-  for (prev = NULL, next = (FAR struct mqueue_msg_s *)msgq->msglist.head;
-       next && prio <= next->priority;
-       prev = next, next = next->next);
+  prev = (FAR struct mqueue_msg_s *)msgq->msglist.tail;
+  if (prev != NULL && prio > prev->priority)
+    {
+      for (prev = NULL,
+           next = (FAR struct mqueue_msg_s *)msgq->msglist.head;
+           next && prio <= next->priority;
+           prev = next, next = next->next);
+    }
 
   /* Add the message at the right place */
 
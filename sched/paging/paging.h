@@ -92,6 +92,10 @@ extern pid_t g_pgworker;
 
 extern FAR struct tcb_s *g_pftcb;
 
+/* Page fault statistics.  Modified with interrupts disabled. */
+
+extern struct pg_stats_s g_pgstats;
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
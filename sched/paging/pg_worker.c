@@ -42,6 +42,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include <unistd.h>
 #include <queue.h>
 #include <assert.h>
@@ -50,6 +51,7 @@
 
 #include <nuttx/sched.h>
 #include <nuttx/arch.h>
+#include <nuttx/irq.h>
 #include <nuttx/signal.h>
 #include <nuttx/page.h>
 #include <nuttx/clock.h>
@@ -83,6 +85,10 @@ pid_t g_pgworker;
 
 FAR struct tcb_s *g_pftcb;
 
+/* Page fault statistics.  Modified with interrupts disabled. */
+
+struct pg_stats_s g_pgstats;
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -94,15 +100,14 @@ FAR struct tcb_s *g_pftcb;
  */
 
 static int g_fillresult;
+#endif
 
-/* A configurable timeout period (in clock ticks) may be select to detect
+/* The time that the page fill in progress was started.  This is used for
+ * the statistics and, if CONFIG_PAGING_TIMEOUT_TICKS is selected, to detect
  * page fill failures.
  */
 
-#ifdef CONFIG_PAGING_TIMEOUT_TICKS
 static clock_t g_starttime;
-#endif
-#endif
 
 /****************************************************************************
  * Private Functions
@@ -251,7 +256,11 @@ static inline bool pg_dequeue(void)
            * blocked task will simply be restarted.
            */
 
-          if (!up_checkmapping(g_pftcb))
+          if (up_checkmapping(g_pftcb))
+            {
+              g_pgstats.pg_mapped++;
+            }
+          else
             {
               /* This page needs to be filled.  pg_miss bumps up
                * the priority of the page fill worker thread as each
@@ -364,6 +373,12 @@ static inline bool pg_startfill(void)
       result = up_allocpage(g_pftcb, &vpage);
       DEBUGASSERT(result == OK);
 
+      /* Save the time that the fill was started.  This will be used for
+       * the statistics and to check for timeouts.
+       */
+
+      g_starttime = clock_systime_ticks();
+
       /* Start the fill.  The exact way that the fill is started depends upon
        * the nature of the architecture-specific up_fillpage() function -- Is
        * it a blocking or a non-blocking call?
@@ -396,14 +411,6 @@ static inline bool pg_startfill(void)
       result = up_fillpage(g_pftcb, vpage, pg_callback);
       DEBUGASSERT(result == OK);
 
-      /* Save the time that the fill was started.  These will be used to
-       * check for timeouts.
-       */
-
-#ifdef CONFIG_PAGING_TIMEOUT_TICKS
-      g_starttime = clock_systime_ticks();
-#endif
-
       /* Return and wait to be signaled for the next event -- the fill
        * completion event. While the fill is in progress, other tasks may
        * execute. If another page fault occurs during this time, the faulting
@@ -486,6 +493,9 @@ static inline void pg_alldone(void)
 
 static inline void pg_fillcomplete(void)
 {
+  g_pgstats.pg_fills++;
+  g_pgstats.pg_filltime += clock_systime_ticks() - g_starttime;
+
   /* Call up_unblocktask(g_pftcb) to make the task that just
    * received the fill ready-to-run.
    */
@@ -583,8 +593,7 @@ int pg_worker(int argc, char *argv[])
                * the task that was blocked waiting for this page fill.
                */
 
-              pginfo("Restarting TCB: %p\n", g_pftcb);
-              up_unblock_task(g_pftcb);
+              pg_fillcomplete();
 
               /* Yes .. Start the next asynchronous fill.  Check the return
                * value to see a fill was actually started (false means that
@@ -660,8 +669,7 @@ int pg_worker(int argc, char *argv[])
            * returns true.
            */
 
-          pginfo("Restarting TCB: %p\n", g_pftcb);
-          up_unblock_task(g_pftcb);
+          pg_fillcomplete();
         }
 
       /* All queued fills have been processed */
@@ -673,4 +681,30 @@ int pg_worker(int argc, char *argv[])
 
   return OK; /* To keep some compilers happy */
 }
+
+/****************************************************************************
+ * Name: pg_getstats
+ *
+ * Description:
+ *   Return the page fault statistics since boot.
+ *
+ * Input Parameters:
+ *   stats - The location to return the statistics
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void pg_getstats(FAR struct pg_stats_s *stats)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(stats != NULL);
+
+  flags = enter_critical_section();
+  memcpy(stats, &g_pgstats, sizeof(struct pg_stats_s));
+  leave_critical_section(flags);
+}
+
 #endif /* CONFIG_PAGING */
@@ -109,6 +109,11 @@ FAR struct join_s *pthread_findjoininfo(FAR struct task_group_s *group,
                                         pid_t pid);
 void pthread_release(FAR struct task_group_s *group);
 
+#if CONFIG_PTHREAD_TCB_CACHE > 0
+FAR struct pthread_tcb_s *pthread_tcb_alloc(size_t stacksize);
+void pthread_tcb_free(FAR struct pthread_tcb_s *ptcb);
+#endif
+
 int pthread_sem_take(FAR sem_t *sem, FAR const struct timespec *abs_timeout,
                      bool intr);
 #ifdef CONFIG_PTHREAD_MUTEX_UNSAFE
@@ -121,13 +126,17 @@ int pthread_mutex_take(FAR struct pthread_mutex_s *mutex,
                        FAR const struct timespec *abs_timeout, bool intr);
 int pthread_mutex_trytake(FAR struct pthread_mutex_s *mutex);
 int pthread_mutex_give(FAR struct pthread_mutex_s *mutex);
+int pthread_mutex_acquired(FAR struct pthread_mutex_s *mutex);
 void pthread_mutex_inconsistent(FAR struct pthread_tcb_s *tcb);
 #else
 #  define pthread_mutex_take(m,abs_timeout,i)  pthread_sem_take(&(m)->sem,(abs_timeout),(i))
+#  define pthread_mutex_acquired(m)            (OK)
 #  define pthread_mutex_trytake(m)             pthread_sem_trytake(&(m)->sem)
 #  define pthread_mutex_give(m)                pthread_sem_give(&(m)->sem)
 #endif
 
+bool pthread_cond_morphed(void);
+
 #ifdef CONFIG_PTHREAD_MUTEX_TYPES
 int pthread_mutexattr_verifytype(int type);
 #endif
@@ -39,17 +39,103 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <pthread.h>
 #include <sched.h>
 #include <errno.h>
 #include <debug.h>
 
+#include <nuttx/irq.h>
+
+#include "sched/sched.h"
 #include "pthread/pthread.h"
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_cond_morph
+ *
+ * Description:
+ *   Move the threads waiting for the condition to the wait queue of the
+ *   mutex instead of waking them up ("wait morphing").  This is only done
+ *   while the mutex is locked:  All of the awakened threads would block on
+ *   it at once otherwise, and each then runs in turn as the mutex is
+ *   unlocked.
+ *
+ *   All semaphore waiters share g_waitingforsemaphore, so the threads keep
+ *   their priority order with the threads already waiting for the mutex.
+ *   The waiters are flagged so that they do not take the mutex again when
+ *   they are restarted; see pthread_cond_morphed().
+ *
+ * Assumptions:
+ *   Called in a critical section.
+ *
+ ****************************************************************************/
+
+static void pthread_cond_morph(FAR pthread_cond_t *cond)
+{
+  FAR struct pthread_mutex_s *mutex = cond->mutex;
+  FAR struct tcb_s *tcb;
+
+  if (mutex == NULL || mutex->sem.semcount > 0)
+    {
+      return;
+    }
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  /* The waiters did not boost the priority of the holder of the mutex */
+
+  if ((mutex->sem.flags & PRIOINHERIT_FLAGS_DISABLE) == 0)
+    {
+      return;
+    }
+#endif
+
+  for (tcb = (FAR struct tcb_s *)g_waitingforsemaphore.head;
+       tcb != NULL && cond->sem.semcount < 0;
+       tcb = tcb->flink)
+    {
+      if (tcb->waitsem == &cond->sem)
+        {
+          tcb->waitsem  = &mutex->sem;
+          tcb->flags   |= TCB_FLAG_COND_MORPHED;
+          cond->sem.semcount++;
+          mutex->sem.semcount--;
+        }
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: pthread_cond_morphed
+ *
+ * Description:
+ *   Return true if pthread_cond_broadcast() moved the calling thread from
+ *   the condition to the mutex.  In that case, a successful wait means that
+ *   the mutex has already been assigned to the thread.  The flag is
+ *   cleared.
+ *
+ ****************************************************************************/
+
+bool pthread_cond_morphed(void)
+{
+  FAR struct tcb_s *rtcb = this_task();
+  irqstate_t flags;
+  bool morphed;
+
+  flags        = enter_critical_section();
+  morphed      = (rtcb->flags & TCB_FLAG_COND_MORPHED) != 0;
+  rtcb->flags &= ~TCB_FLAG_COND_MORPHED;
+  leave_critical_section(flags);
+
+  return morphed;
+}
+
 /****************************************************************************
  * Name: pthread_cond_broadcast
  *
@@ -68,6 +154,7 @@
 
 int pthread_cond_broadcast(FAR pthread_cond_t *cond)
 {
+  irqstate_t flags;
   int ret = OK;
   int sval;
 
@@ -86,6 +173,12 @@ int pthread_cond_broadcast(FAR pthread_cond_t *cond)
 
       sched_lock();
 
+      /* Move the waiters to the mutex if it is locked */
+
+      flags = enter_critical_section();
+      pthread_cond_morph(cond);
+      leave_critical_section(flags);
+
       /* Get the current value of the semaphore */
 
       if (nxsem_getvalue((FAR sem_t *)&cond->sem, &sval) != OK)
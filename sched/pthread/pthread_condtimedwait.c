@@ -26,6 +26,7 @@
 #include <nuttx/compiler.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdarg.h>
 #include <unistd.h>
 #include <pthread.h>
@@ -261,6 +262,8 @@ int pthread_cond_timedwait(FAR pthread_cond_t *cond,
                   uint8_t type;
                   int16_t nlocks;
 #endif
+                  bool morphed = false;
+
                   /* Give up the mutex */
 
                   mutex->pid = -1;
@@ -282,6 +285,10 @@ int pthread_cond_timedwait(FAR pthread_cond_t *cond,
                     }
                   else
                     {
+                      /* Let pthread_cond_broadcast() find the mutex */
+
+                      cond->mutex = mutex;
+
                       /* Start the watchdog */
 
                       wd_start(rtcb->waitdog, ticks,
@@ -295,7 +302,8 @@ int pthread_cond_timedwait(FAR pthread_cond_t *cond,
                        * the condition wait are started atomically.
                        */
 
-                      status = nxsem_wait((FAR sem_t *)&cond->sem);
+                      status  = nxsem_wait((FAR sem_t *)&cond->sem);
+                      morphed = pthread_cond_morphed();
 
                       /* Did we get the condition semaphore. */
 
@@ -331,7 +339,19 @@ int pthread_cond_timedwait(FAR pthread_cond_t *cond,
 
                   sinfo("Re-locking...\n");
 
-                  status = pthread_mutex_take(mutex, NULL, false);
+                  if (morphed && status == OK)
+                    {
+                      /* pthread_cond_broadcast() moved the wait to the
+                       * mutex and the mutex has already been assigned.
+                       */
+
+                      status = pthread_mutex_acquired(mutex);
+                    }
+                  else
+                    {
+                      status = pthread_mutex_take(mutex, NULL, false);
+                    }
+
                   if (status == OK)
                     {
                       mutex->pid    = mypid;
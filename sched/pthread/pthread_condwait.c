@@ -24,6 +24,7 @@
 
 #include <nuttx/config.h>
 
+#include <stdbool.h>
 #include <unistd.h>
 #include <pthread.h>
 #include <sched.h>
@@ -56,6 +57,7 @@
 
 int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
 {
+  bool morphed;
   int status;
   int ret;
 
@@ -103,16 +105,28 @@ int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
 #endif
       ret        = pthread_mutex_give(mutex);
 
+      /* Let pthread_cond_broadcast() find the mutex */
+
+      cond->mutex = mutex;
+
       /* Take the semaphore.  This may be awakened only be a signal (EINTR)
-       * or if the thread is canceled (ECANCELED)
+       * or if the thread is canceled (ECANCELED).  A signal is not ignored
+       * once pthread_cond_broadcast() has moved the wait to the mutex, the
+       * mutex must then be taken again below.
        */
 
-      status = pthread_sem_take((FAR sem_t *)&cond->sem, NULL, false);
+      do
+        {
+          status = pthread_sem_take((FAR sem_t *)&cond->sem, NULL, true);
+          morphed = pthread_cond_morphed();
+        }
+      while (status == EINTR && !morphed);
+
       if (ret == OK)
         {
           /* Report the first failure that occurs */
 
-          ret = status;
+          ret = status == EINTR ? OK : status;
         }
 
       sched_unlock();
@@ -122,11 +136,24 @@ int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
        * When cancellation points are enabled, we need to hold the mutex
        * when the pthread is canceled and cleanup handlers, if any, are
        * entered.
+       *
+       * If the wait was moved to the mutex and succeeded, the mutex is
+       * already ours.
        */
 
       sinfo("Reacquire mutex...\n");
 
-      status = pthread_mutex_take(mutex, NULL, false);
+      if (morphed && status == OK)
+        {
+          sched_lock();
+          status = pthread_mutex_acquired(mutex);
+          sched_unlock();
+        }
+      else
+        {
+          status = pthread_mutex_take(mutex, NULL, false);
+        }
+
       if (ret == OK)
         {
           /* Report the first failure that occurs */
@@ -258,10 +258,24 @@ int pthread_create(FAR pthread_t *thread, FAR const pthread_attr_t *attr,
       attr = &g_default_pthread_attr;
     }
 
-  /* Allocate a TCB for the new task. */
+  /* Allocate a TCB for the new task.  A cached TCB already has a stack of
+   * the requested size.
+   */
+
+#if CONFIG_PTHREAD_TCB_CACHE > 0
+  ptcb = NULL;
+  if (!attr->stackaddr)
+    {
+      ptcb = pthread_tcb_alloc(attr->stacksize);
+    }
+
+  if (!ptcb)
+#endif
+    {
+      ptcb = (FAR struct pthread_tcb_s *)
+                kmm_zalloc(sizeof(struct pthread_tcb_s));
+    }
 
-  ptcb = (FAR struct pthread_tcb_s *)
-            kmm_zalloc(sizeof(struct pthread_tcb_s));
   if (!ptcb)
     {
       serr("ERROR: Failed to allocate TCB\n");
@@ -307,12 +321,28 @@ int pthread_create(FAR pthread_t *thread, FAR const pthread_attr_t *attr,
       ret = up_use_stack((FAR struct tcb_s *)ptcb, attr->stackaddr,
                          attr->stacksize);
     }
+#if CONFIG_PTHREAD_TCB_CACHE > 0
+  else if (ptcb->cmn.stack_alloc_ptr)
+    {
+      /* The stack came with the cached TCB */
+
+      ret = OK;
+    }
+#endif
   else
     {
       /* Allocate the stack for the TCB */
 
       ret = up_create_stack((FAR struct tcb_s *)ptcb, attr->stacksize,
                             TCB_FLAG_TTYPE_PTHREAD);
+#if CONFIG_PTHREAD_TCB_CACHE > 0
+      if (ret == OK)
+        {
+          /* Remember the size so that the stack can be cached */
+
+          ptcb->stacksize = attr->stacksize;
+        }
+#endif
     }
 
   if (ret != OK)
@@ -143,6 +143,63 @@ static void pthread_mutex_remove(FAR struct pthread_mutex_s *mutex)
     }
 }
 
+/****************************************************************************
+ * Name: pthread_mutex_spin
+ *
+ * Description:
+ *   Spin while the holder of the mutex is running on another CPU, in the
+ *   hope that it unlocks the mutex soon.
+ *
+ * Input Parameters:
+ *  mutex - The mutex to be locked
+ *
+ * Returned Value:
+ *   true if the mutex was taken; false if the caller must block.
+ *
+ * Assumptions:
+ *   The scheduler is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PTHREAD_MUTEX_ADAPTIVE
+static bool pthread_mutex_spin(FAR struct pthread_mutex_s *mutex)
+{
+  FAR struct tcb_s *htcb;
+  pid_t pid;
+  int count;
+
+  for (count = 0; count < CONFIG_PTHREAD_MUTEX_SPINCOUNT; count++)
+    {
+      if (mutex->sem.semcount > 0 && nxsem_trywait(&mutex->sem) == OK)
+        {
+          return true;
+        }
+
+      /* The holder records its ID only after it took the semaphore, so
+       * keep spinning while the ID is not known yet.
+       */
+
+      pid = mutex->pid;
+      if (pid > 0)
+        {
+          /* The hash table is read without the critical section.  The
+           * holder may be exiting, but this is only a hint:  The mutex is
+           * taken with nxsem_trywait() above in any case.
+           */
+
+          htcb = g_pidhash[PIDHASH(pid)].tcb;
+          if (htcb == NULL || htcb->pid != pid ||
+              htcb->task_state != TSTATE_TASK_RUNNING)
+            {
+              return false;
+            }
+        }
+    }
+
+  return false;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -186,29 +243,27 @@ int pthread_mutex_take(FAR struct pthread_mutex_s *mutex,
         }
       else
         {
-          /* Take semaphore underlying the mutex.  pthread_sem_take
-           * returns zero on success and a positive errno value on failure.
-           */
+#ifdef CONFIG_PTHREAD_MUTEX_ADAPTIVE
+          /* Avoid blocking if the holder is about to unlock the mutex */
 
-          ret = pthread_sem_take(&mutex->sem, abs_timeout, intr);
-          if (ret == OK)
+          if (pthread_mutex_spin(mutex))
+            {
+              ret = OK;
+            }
+          else
+#endif
             {
-              /* Check if the holder of the mutex has terminated without
-               * releasing.  In that case, the state of the mutex is
-               * inconsistent and we return EOWNERDEAD.
+              /* Take semaphore underlying the mutex.  pthread_sem_take
+               * returns zero on success and a positive errno value on
+               * failure.
                */
 
-              if ((mutex->flags & _PTHREAD_MFLAGS_INCONSISTENT) != 0)
-                {
-                  ret = EOWNERDEAD;
-                }
-
-              /* Add the mutex to the list of mutexes held by this task */
+              ret = pthread_sem_take(&mutex->sem, abs_timeout, intr);
+            }
 
-              else
-                {
-                  pthread_mutex_add(mutex);
-                }
+          if (ret == OK)
+            {
+              ret = pthread_mutex_acquired(mutex);
             }
         }
 
@@ -218,6 +273,43 @@ int pthread_mutex_take(FAR struct pthread_mutex_s *mutex,
   return ret;
 }
 
+/****************************************************************************
+ * Name: pthread_mutex_acquired
+ *
+ * Description:
+ *   Complete taking the pthread_mutex once the count of its semaphore has
+ *   been assigned to this thread:  Either by pthread_mutex_take() or by a
+ *   wait on the semaphore that pthread_cond_broadcast() moved there.
+ *
+ * Input Parameters:
+ *  mutex - The mutex that was locked
+ *
+ * Returned Value:
+ *   0 on success or an errno value on failure.
+ *
+ * Assumptions:
+ *   The scheduler is locked.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_acquired(FAR struct pthread_mutex_s *mutex)
+{
+  /* Check if the holder of the mutex has terminated without releasing.  In
+   * that case, the state of the mutex is inconsistent and we return
+   * EOWNERDEAD.
+   */
+
+  if ((mutex->flags & _PTHREAD_MFLAGS_INCONSISTENT) != 0)
+    {
+      return EOWNERDEAD;
+    }
+
+  /* Add the mutex to the list of mutexes held by this task */
+
+  pthread_mutex_add(mutex);
+  return OK;
+}
+
 /****************************************************************************
  * Name: pthread_mutex_trytake
  *
@@ -0,0 +1,177 @@
+/****************************************************************************
+ * sched/pthread/pthread_tcb.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <string.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/sched.h>
+
+#include "pthread/pthread.h"
+
+#if CONFIG_PTHREAD_TCB_CACHE > 0
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A released TCB in the cache.  This overlays the start of the TCB memory
+ * and keeps the stack that belonged to the TCB.
+ */
+
+struct pthread_tcbcache_s
+{
+  FAR struct pthread_tcbcache_s *flink; /* Next cached TCB */
+  FAR void *stack;                      /* The stack of the TCB */
+  size_t stacksize;                     /* Requested size of the stack */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR struct pthread_tcbcache_s *g_tcbcache;
+static uint8_t g_ntcbcache;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_tcb_alloc
+ *
+ * Description:
+ *   Take a TCB with a stack of the requested size from the cache.  The TCB
+ *   is cleared and the stack is set up as by up_create_stack().
+ *
+ * Input Parameters:
+ *   stacksize - The stack size requested for the new pthread
+ *
+ * Returned Value:
+ *   The TCB or NULL if there is no cached TCB with a stack of that size.
+ *
+ ****************************************************************************/
+
+FAR struct pthread_tcb_s *pthread_tcb_alloc(size_t stacksize)
+{
+  FAR struct pthread_tcbcache_s **prev;
+  FAR struct pthread_tcbcache_s *entry;
+  FAR struct pthread_tcb_s *ptcb;
+  FAR void *stack;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  for (prev = &g_tcbcache; (entry = *prev) != NULL; prev = &entry->flink)
+    {
+      if (entry->stacksize == stacksize)
+        {
+          *prev = entry->flink;
+          g_ntcbcache--;
+          break;
+        }
+    }
+
+  leave_critical_section(flags);
+
+  if (entry == NULL)
+    {
+      return NULL;
+    }
+
+  stack = entry->stack;
+  ptcb  = (FAR struct pthread_tcb_s *)entry;
+  memset(ptcb, 0, sizeof(struct pthread_tcb_s));
+
+  /* up_create_stack() allocated exactly stacksize bytes, so using the same
+   * memory again gives the same stack layout.
+   */
+
+  if (up_use_stack(&ptcb->cmn, stack, stacksize) < 0)
+    {
+      serr("ERROR: Failed to reuse a cached stack\n");
+      ptcb->cmn.stack_alloc_ptr = stack;
+      up_release_stack(&ptcb->cmn, TCB_FLAG_TTYPE_PTHREAD);
+      kmm_free(ptcb);
+      return NULL;
+    }
+
+  ptcb->stacksize = stacksize;
+  return ptcb;
+}
+
+/****************************************************************************
+ * Name: pthread_tcb_free
+ *
+ * Description:
+ *   Release a pthread TCB and its stack.  If the stack was allocated by
+ *   pthread_create() and the cache is not full, both are kept for reuse by
+ *   pthread_tcb_alloc().
+ *
+ * Input Parameters:
+ *   ptcb - The TCB to be released.  All other resources of the TCB must
+ *          already have been released.
+ *
+ ****************************************************************************/
+
+void pthread_tcb_free(FAR struct pthread_tcb_s *ptcb)
+{
+  FAR struct pthread_tcbcache_s *entry;
+  irqstate_t flags;
+
+  if (ptcb->stacksize > 0 && ptcb->cmn.stack_alloc_ptr != NULL)
+    {
+      flags = enter_critical_section();
+      if (g_ntcbcache < CONFIG_PTHREAD_TCB_CACHE)
+        {
+          FAR void *stack = ptcb->cmn.stack_alloc_ptr;
+          size_t stacksize = ptcb->stacksize;
+
+          entry            = (FAR struct pthread_tcbcache_s *)ptcb;
+          entry->stack     = stack;
+          entry->stacksize = stacksize;
+          entry->flink     = g_tcbcache;
+          g_tcbcache       = entry;
+          g_ntcbcache++;
+
+          leave_critical_section(flags);
+          return;
+        }
+
+      leave_critical_section(flags);
+    }
+
+  if (ptcb->cmn.stack_alloc_ptr != NULL)
+    {
+      up_release_stack(&ptcb->cmn, TCB_FLAG_TTYPE_PTHREAD);
+    }
+
+  kmm_free(ptcb);
+}
+
+#endif /* CONFIG_PTHREAD_TCB_CACHE > 0 */
@@ -379,6 +379,24 @@ void nxsched_add_blocked(FAR struct tcb_s *btcb, tstate_t task_state);
 void nxsched_remove_blocked(FAR struct tcb_s *btcb);
 int  nxsched_set_priority(FAR struct tcb_s *tcb, int sched_priority);
 
+/* Priority index of the ready-to-run lists.  nxsched_index_add() must be
+ * called after a TCB is linked into a ready-to-run list and
+ * nxsched_index_remove() before it is unlinked.  nxsched_index_rebuild()
+ * is used after lists are moved or merged as a whole.
+ */
+
+#ifdef CONFIG_SCHED_READYTORUN_INDEX
+bool nxsched_index_lookup(FAR dq_queue_t *list, uint8_t priority,
+                          FAR struct tcb_s **next);
+void nxsched_index_add(FAR dq_queue_t *list, FAR struct tcb_s *tcb);
+void nxsched_index_remove(FAR dq_queue_t *list, FAR struct tcb_s *tcb);
+void nxsched_index_rebuild(FAR dq_queue_t *list);
+#else
+#  define nxsched_index_add(list,tcb)
+#  define nxsched_index_remove(list,tcb)
+#  define nxsched_index_rebuild(list)
+#endif
+
 /* Priority inheritance support */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
@@ -431,6 +449,9 @@ FAR struct tcb_s *this_task(void);
 
 int  nxsched_select_cpu(cpu_set_t affinity);
 int  nxsched_pause_cpu(FAR struct tcb_s *tcb);
+#ifdef CONFIG_SMP_BALANCE
+void nxsched_balance(void);
+#endif
 
 irqstate_t nxsched_lock_tasklist(void);
 void nxsched_unlock_tasklist(irqstate_t lock);
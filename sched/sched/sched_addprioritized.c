@@ -89,11 +89,17 @@ bool nxsched_add_prioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 
   /* Search the list to find the location to insert the new Tcb.
    * Each is list is maintained in descending sched_priority order.
+   * The ready-to-run lists may be indexed so that no search is needed.
    */
 
-  for (next = (FAR struct tcb_s *)list->head;
-       (next && sched_priority <= next->sched_priority);
-       next = next->flink);
+#ifdef CONFIG_SCHED_READYTORUN_INDEX
+  if (!nxsched_index_lookup(list, sched_priority, &next))
+#endif
+    {
+      for (next = (FAR struct tcb_s *)list->head;
+           (next && sched_priority <= next->sched_priority);
+           next = next->flink);
+    }
 
   /* Add the tcb to the spot found in the list.  Check if the tcb
    * goes at the end of the list. NOTE:  This could only happen if list
@@ -151,5 +157,6 @@ bool nxsched_add_prioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
         }
     }
 
+  nxsched_index_add(list, tcb);
   return ret;
 }
@@ -383,6 +383,7 @@ bool nxsched_add_readytorun(FAR struct tcb_s *btcb)
             {
               /* Remove the task from the assigned task list */
 
+              nxsched_index_remove(tasklist, next);
               dq_rem((FAR dq_entry_t *)next, tasklist);
 
               /* Add the task to the g_readytorun or to the g_pendingtasks
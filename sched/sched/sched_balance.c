@@ -0,0 +1,130 @@
+/****************************************************************************
+ * sched/sched/sched_balance.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sched.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SMP_BALANCE
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name:  nxsched_balance
+ *
+ * Description:
+ *   Start the ready-to-run tasks that have a higher priority than the task
+ *   running on a CPU in their affinity mask.  Normally a task is started
+ *   on the CPU running the lowest priority task when it becomes ready to
+ *   run, but a task may be left in the g_readytorun list while a CPU is
+ *   idle or runs a lower priority task, for example after the affinity or
+ *   the priority of a task was changed or after the scheduler was locked.
+ *
+ *   This is called periodically from the timer logic.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxsched_balance(void)
+{
+  FAR struct tcb_s *btcb;
+  FAR struct tcb_s *rtcb;
+  irqstate_t flags;
+  uint8_t minprio;
+  int cpu;
+  int i;
+
+  flags = enter_critical_section();
+
+  /* Tasks cannot be started while pre-emption is disabled */
+
+  if (nxsched_islocked_global())
+    {
+      leave_critical_section(flags);
+      return;
+    }
+
+  /* Each pass can start at most one task on each CPU */
+
+  for (i = 0; i < CONFIG_SMP_NCPUS; i++)
+    {
+      /* Find the lowest priority of the running tasks.  No ready-to-run
+       * task at or below this priority can preempt any CPU.
+       */
+
+      minprio = SCHED_PRIORITY_MAX;
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          rtcb = current_task(cpu);
+          if (rtcb->sched_priority < minprio)
+            {
+              minprio = rtcb->sched_priority;
+            }
+        }
+
+      /* g_readytorun is ordered by priority:  Find the first task with a
+       * CPU in its affinity mask that runs a lower priority task.
+       */
+
+      for (btcb = (FAR struct tcb_s *)g_readytorun.head;
+           btcb != NULL && btcb->sched_priority > minprio;
+           btcb = btcb->flink)
+        {
+          cpu  = nxsched_select_cpu(btcb->affinity);
+          rtcb = current_task(cpu);
+          if (rtcb->sched_priority < btcb->sched_priority)
+            {
+              break;
+            }
+        }
+
+      if (btcb == NULL || btcb->sched_priority <= minprio)
+        {
+          break;
+        }
+
+      /* Re-adding the task at its current priority starts it on that
+       * CPU, exactly as when it became ready to run.
+       */
+
+      up_reprioritize_rtr(btcb, btcb->sched_priority);
+    }
+
+  leave_critical_section(flags);
+}
+
+#endif /* CONFIG_SMP_BALANCE */
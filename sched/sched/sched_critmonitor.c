@@ -74,6 +74,13 @@ uint32_t g_premp_max[1];
 uint32_t g_crit_max[1];
 #endif
 
+/* Contention on the global critical section lock */
+
+#ifdef CONFIG_SMP
+uint32_t g_crit_contended[CONFIG_SMP_NCPUS];
+uint32_t g_crit_waitmax[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -212,7 +219,8 @@ void nxsched_critmon_csection(FAR struct tcb_s *tcb, bool state)
  *
  * Description:
  *   Called when a thread resumes execution, perhaps re-establishing a
- *   critical section or a non-pre-emptible state.
+ *   critical section or a non-pre-emptible state.  This also starts the
+ *   accounting of the run time of the thread.
  *
  * Assumptions:
  *   - Called within a critical section.
@@ -227,6 +235,12 @@ void nxsched_resume_critmon(FAR struct tcb_s *tcb)
 
   DEBUGASSERT(tcb->premp_start == 0 && tcb->crit_start == 0);
 
+  /* Save the time the thread starts running.  Zero means that the timer is
+   * not ready and this run is not accounted.
+   */
+
+  tcb->run_start = up_critmon_gettime();
+
   /* Did this task disable pre-emption? */
 
   if (tcb->lockcount > 0)
@@ -289,7 +303,8 @@ void nxsched_resume_critmon(FAR struct tcb_s *tcb)
  *
  * Description:
  *   Called when a thread suspends execution, perhaps terminating a
- *   critical section or a non-preemptible state.
+ *   critical section or a non-preemptible state.  The time the thread ran
+ *   is added to its run time.
  *
  * Assumptions:
  *   - Called within a critical section.
@@ -301,6 +316,14 @@ void nxsched_suspend_critmon(FAR struct tcb_s *tcb)
 {
   uint32_t elapsed;
 
+  /* Add the time since the thread was resumed to its run time */
+
+  if (tcb->run_start != 0)
+    {
+      tcb->run_time += up_critmon_gettime() - tcb->run_start;
+      tcb->run_start = 0;
+    }
+
   /* Did this task disable preemption? */
 
   if (tcb->lockcount > 0)
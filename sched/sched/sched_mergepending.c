@@ -138,6 +138,8 @@ bool nxsched_merge_pending(void)
           ptcb->task_state  = TSTATE_TASK_READYTORUN;
         }
 
+      nxsched_index_add((FAR dq_queue_t *)&g_readytorun, ptcb);
+
       /* Set up for the next time through */
 
       rtcb = ptcb;
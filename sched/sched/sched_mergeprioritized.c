@@ -93,6 +93,10 @@ void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
       goto ret_with_lock;
     }
 
+  /* list1 is now empty */
+
+  nxsched_index_rebuild(list1);
+
   /* Now the TCBs are no longer accessible and we can change the state on
    * each TCB.  We go through extra precaution to assure that a TCB is never
    * in a list with the wrong state.
@@ -113,7 +117,7 @@ void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
       /* Special case.. list2 is empty.  Move list1 to list2. */
 
       dq_move(&clone, list2);
-      goto ret_with_lock;
+      goto ret_with_index;
     }
 
   /* Now loop until all entries from list1 have been merged into list2. tcb1
@@ -163,6 +167,12 @@ void nxsched_merge_prioritized(FAR dq_queue_t *list1, FAR dq_queue_t *list2,
     }
   while (tcb1 != NULL);
 
+ret_with_index:
+
+  /* The TCBs were moved into list2 without updating its priority index */
+
+  nxsched_index_rebuild(list2);
+
 ret_with_lock:
 
 #ifdef CONFIG_SMP
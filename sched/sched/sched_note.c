@@ -177,8 +177,10 @@ static void note_common(FAR struct tcb_s *tcb,
  *   Common logic for NOTE_SPINLOCK, NOTE_SPINLOCKED, and NOTE_SPINUNLOCK
  *
  * Input Parameters:
- *   tcb  - The TCB containing the information
- *   note - The common note structure to use
+ *   tcb      - The TCB containing the information
+ *   spinlock - The spinlock
+ *   type     - The type of the note
+ *   spins    - The number of failed attempts to take the spinlock
  *
  * Returned Value:
  *   None
@@ -188,15 +190,22 @@ static void note_common(FAR struct tcb_s *tcb,
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
 void note_spincommon(FAR struct tcb_s *tcb,
                      FAR volatile spinlock_t *spinlock,
-                     int type)
+                     int type, unsigned int spins)
 {
   struct note_spinlock_s note;
 
+  if (spins > UINT16_MAX)
+    {
+      spins = UINT16_MAX;
+    }
+
   /* Format the note */
 
   note_common(tcb, &note.nsp_cmn, sizeof(struct note_spinlock_s), type);
   note.nsp_spinlock = (FAR void *)spinlock;
   note.nsp_value    = (uint8_t)*spinlock;
+  note.nsp_spins[0] = (uint8_t)(spins & 0xff);
+  note.nsp_spins[1] = (uint8_t)((spins >> 8) & 0xff);
 
   /* Add the note to circular buffer */
 
@@ -218,7 +227,6 @@ void note_spincommon(FAR struct tcb_s *tcb,
  *
  ****************************************************************************/
 
-#if defined(CONFIG_SCHED_NOTE_GET) || defined(CONFIG_DEBUG_ASSERTIONS)
 static unsigned int note_length(void)
 {
   unsigned int head = g_note_info.ni_head;
@@ -231,7 +239,6 @@ static unsigned int note_length(void)
 
   return head - tail;
 }
-#endif
 
 /****************************************************************************
  * Name: note_remove
@@ -294,7 +301,7 @@ static void note_remove(void)
 static void note_add(FAR const uint8_t *note, uint8_t notelen)
 {
   unsigned int head;
-  unsigned int next;
+  unsigned int nbytes;
 
 #ifdef CONFIG_SMP
   /* Ignore notes that are not in the set of monitored CPUs */
@@ -312,36 +319,36 @@ static void note_add(FAR const uint8_t *note, uint8_t notelen)
   spin_lock_wo_note(&g_note_lock);
 #endif
 
-  /* Get the index to the head of the circular buffer */
-
   DEBUGASSERT(note != NULL && notelen < CONFIG_SCHED_NOTE_BUFSIZE);
-  head = g_note_info.ni_head;
 
-  /* Loop until all bytes have been transferred to the circular buffer */
+  /* Remove the oldest notes until there is room for the whole note.  One
+   * byte is always left free so that the head never catches up with the
+   * tail.
+   */
 
-  while (notelen > 0)
+  while (note_length() + notelen >= CONFIG_SCHED_NOTE_BUFSIZE)
     {
-      /* Get the next head index.  Would it collide with the current tail
-       * index?
-       */
-
-      next = note_next(head, 1);
-      if (next == g_note_info.ni_tail)
-        {
-          /* Yes, then remove the note at the tail index */
-
-          note_remove();
-        }
+      note_remove();
+    }
 
-      /* Save the next byte at the head index */
+  /* Copy the note to the head of the circular buffer.  This takes at most
+   * two copies, one up to the end of the buffer and one from its start.
+   */
 
-      g_note_info.ni_buffer[head] = *note++;
+  head   = g_note_info.ni_head;
+  nbytes = CONFIG_SCHED_NOTE_BUFSIZE - head;
+  if (nbytes > notelen)
+    {
+      nbytes = notelen;
+    }
 
-      head = next;
-      notelen--;
+  memcpy(&g_note_info.ni_buffer[head], note, nbytes);
+  if (notelen > nbytes)
+    {
+      memcpy(g_note_info.ni_buffer, note + nbytes, notelen - nbytes);
     }
 
-  g_note_info.ni_head = head;
+  g_note_info.ni_head = note_next(head, notelen);
 
 #ifdef CONFIG_SMP
   spin_unlock_wo_note(&g_note_lock);
@@ -573,24 +580,44 @@ void sched_note_csection(FAR struct tcb_s *tcb, bool enter)
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
 void sched_note_spinlock(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
 {
-  note_spincommon(tcb, spinlock, NOTE_SPINLOCK_LOCK);
+  note_spincommon(tcb, spinlock, NOTE_SPINLOCK_LOCK, 0);
 }
 
 void sched_note_spinlocked(FAR struct tcb_s *tcb,
-                           FAR volatile void *spinlock)
+                           FAR volatile void *spinlock,
+                           unsigned int spins)
 {
-  note_spincommon(tcb, spinlock, NOTE_SPINLOCK_LOCKED);
+  note_spincommon(tcb, spinlock, NOTE_SPINLOCK_LOCKED, spins);
 }
 
 void sched_note_spinunlock(FAR struct tcb_s *tcb,
                            FAR volatile void *spinlock)
 {
-  note_spincommon(tcb, spinlock, NOTE_SPINLOCK_UNLOCK);
+  note_spincommon(tcb, spinlock, NOTE_SPINLOCK_UNLOCK, 0);
 }
 
 void sched_note_spinabort(FAR struct tcb_s *tcb, FAR volatile void *spinlock)
 {
-  note_spincommon(tcb, spinlock, NOTE_SPINLOCK_ABORT);
+  note_spincommon(tcb, spinlock, NOTE_SPINLOCK_ABORT, 0);
+}
+#endif
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_TRACE
+void sched_note_trace(FAR struct tcb_s *tcb, uint8_t category, bool begin,
+                      FAR void *arg)
+{
+  struct note_trace_s note;
+
+  /* Format the note */
+
+  note_common(tcb, &note.ntr_cmn, sizeof(struct note_trace_s),
+              begin ? NOTE_TRACE_BEGIN : NOTE_TRACE_END);
+  note.ntr_category = category;
+  note.ntr_arg      = arg;
+
+  /* Add the note to circular buffer */
+
+  note_add((FAR const uint8_t *)&note, sizeof(struct note_trace_s));
 }
 #endif
 
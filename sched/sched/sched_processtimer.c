@@ -223,6 +223,12 @@ void nxsched_process_timer(void)
 
   nxsched_process_scheduler();
 
+#ifdef CONFIG_SMP_BALANCE
+  /* Start ready-to-run tasks left behind on a lower priority CPU */
+
+  nxsched_balance();
+#endif
+
   /* Process watchdogs */
 
   wd_timer();
@@ -0,0 +1,279 @@
+/****************************************************************************
+ * sched/sched/sched_readyindex.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+#include <queue.h>
+#include <assert.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_READYTORUN_INDEX
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define INDEX_NPRIORITIES  (SCHED_PRIORITY_MAX + 1)
+#define INDEX_NWORDS       ((INDEX_NPRIORITIES + 31) >> 5)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure indexes one ready-to-run list by priority.  Each list is
+ * kept in descending priority order, so the TCBs of one priority form a
+ * FIFO segment of the list.  A bit is set in the bitmap for each priority
+ * that is present in the list and tail[] holds the last TCB of that
+ * segment.
+ */
+
+struct readyindex_s
+{
+  uint32_t bitmap[INDEX_NWORDS];              /* Priorities in the list */
+  FAR struct tcb_s *tail[INDEX_NPRIORITIES];  /* Last TCB of each priority */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The index of g_readytorun */
+
+static struct readyindex_s g_readytorun_index;
+
+#ifdef CONFIG_SMP
+/* The index of each g_assignedtasks[] list */
+
+static struct readyindex_s g_assignedtasks_index[CONFIG_SMP_NCPUS];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_get_index
+ *
+ * Description:
+ *   Return the index of a task list or NULL if the list is not indexed.
+ *
+ ****************************************************************************/
+
+static inline FAR struct readyindex_s *
+nxsched_get_index(FAR dq_queue_t *list)
+{
+  if (list == (FAR dq_queue_t *)&g_readytorun)
+    {
+      return &g_readytorun_index;
+    }
+
+#ifdef CONFIG_SMP
+  if (list >= (FAR dq_queue_t *)&g_assignedtasks[0] &&
+      list <  (FAR dq_queue_t *)&g_assignedtasks[CONFIG_SMP_NCPUS])
+    {
+      return &g_assignedtasks_index[list -
+                                    (FAR dq_queue_t *)&g_assignedtasks[0]];
+    }
+#endif
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxsched_index_lookup
+ *
+ * Description:
+ *   Find the position at which a TCB of the given priority is added to an
+ *   indexed list:  After all TCBs of the same or higher priority.
+ *
+ * Input Parameters:
+ *   list     - The task list
+ *   priority - The priority of the TCB to be added
+ *   next     - The location to return the TCB before which the new TCB
+ *              goes.  NULL is returned if the new TCB goes at the end of
+ *              the list.
+ *
+ * Returned Value:
+ *   true if the list is indexed and 'next' was returned; false if the list
+ *   is not indexed and must be searched.
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+bool nxsched_index_lookup(FAR dq_queue_t *list, uint8_t priority,
+                          FAR struct tcb_s **next)
+{
+  FAR struct readyindex_s *index = nxsched_get_index(list);
+  uint32_t bits;
+  int word;
+
+  if (index == NULL)
+    {
+      return false;
+    }
+
+  /* Find the lowest priority present in the list that is not lower than
+   * 'priority'.  The new TCB goes after the last TCB of that priority.
+   */
+
+  word = priority >> 5;
+  bits = index->bitmap[word] & (UINT32_MAX << (priority & 31));
+
+  while (bits == 0 && ++word < INDEX_NWORDS)
+    {
+      bits = index->bitmap[word];
+    }
+
+  if (bits == 0)
+    {
+      /* No TCB of the same or higher priority; the new TCB becomes the
+       * head of the list.
+       */
+
+      *next = (FAR struct tcb_s *)list->head;
+    }
+  else
+    {
+      *next = index->tail[(word << 5) + ffs((int)bits) - 1]->flink;
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: nxsched_index_add
+ *
+ * Description:
+ *   Update the index of a list after a TCB has been linked into the list
+ *   at its prioritized position.  Nothing is done if the list is not
+ *   indexed.
+ *
+ * Input Parameters:
+ *   list - The task list
+ *   tcb  - The TCB that was added to the list
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_index_add(FAR dq_queue_t *list, FAR struct tcb_s *tcb)
+{
+  FAR struct readyindex_s *index = nxsched_get_index(list);
+  uint8_t priority = tcb->sched_priority;
+
+  if (index != NULL &&
+      (tcb->flink == NULL || tcb->flink->sched_priority != priority))
+    {
+      /* The TCB is the new last TCB of its priority */
+
+      index->tail[priority]         = tcb;
+      index->bitmap[priority >> 5] |= (uint32_t)1 << (priority & 31);
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_index_remove
+ *
+ * Description:
+ *   Update the index of a list before a TCB is removed from the list.
+ *   Nothing is done if the list is not indexed.
+ *
+ * Input Parameters:
+ *   list - The task list
+ *   tcb  - The TCB that will be removed from the list
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_index_remove(FAR dq_queue_t *list, FAR struct tcb_s *tcb)
+{
+  FAR struct readyindex_s *index = nxsched_get_index(list);
+  uint8_t priority = tcb->sched_priority;
+  FAR struct tcb_s *prev;
+
+  if (index != NULL && index->tail[priority] == tcb)
+    {
+      prev = tcb->blink;
+      if (prev != NULL && prev->sched_priority == priority)
+        {
+          index->tail[priority] = prev;
+        }
+      else
+        {
+          /* This was the only TCB of its priority */
+
+          index->tail[priority]         = NULL;
+          index->bitmap[priority >> 5] &= ~((uint32_t)1 << (priority & 31));
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nxsched_index_rebuild
+ *
+ * Description:
+ *   Rebuild the index of a list after TCBs have been moved into or out of
+ *   the list as a whole (as when the list is merged with another one).
+ *   Nothing is done if the list is not indexed.
+ *
+ * Input Parameters:
+ *   list - The task list
+ *
+ * Assumptions:
+ *   The caller has established a critical section.
+ *
+ ****************************************************************************/
+
+void nxsched_index_rebuild(FAR dq_queue_t *list)
+{
+  FAR struct readyindex_s *index = nxsched_get_index(list);
+  FAR struct tcb_s *tcb;
+
+  if (index != NULL)
+    {
+      memset(index, 0, sizeof(struct readyindex_s));
+
+      for (tcb = (FAR struct tcb_s *)list->head; tcb != NULL;
+           tcb = tcb->flink)
+        {
+          nxsched_index_add(list, tcb);
+        }
+    }
+}
+
+#endif /* CONFIG_SCHED_READYTORUN_INDEX */
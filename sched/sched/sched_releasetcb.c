@@ -34,6 +34,7 @@
 #include "sched/sched.h"
 #include "group/group.h"
 #include "timer/timer.h"
+#include "pthread/pthread.h"
 
 /****************************************************************************
  * Private Functions
@@ -127,9 +128,15 @@ int nxsched_release_tcb(FAR struct tcb_s *tcb, uint8_t ttype)
           nxsched_releasepid(tcb->pid);
         }
 
-      /* Delete the thread's stack if one has been allocated */
+      /* Delete the thread's stack if one has been allocated.  The stack
+       * of a pthread is released with its TCB below.
+       */
 
+#if CONFIG_PTHREAD_TCB_CACHE > 0
+      if (tcb->stack_alloc_ptr && ttype != TCB_FLAG_TTYPE_PTHREAD)
+#else
       if (tcb->stack_alloc_ptr)
+#endif
         {
 #ifdef CONFIG_BUILD_KERNEL
           /* If the exiting thread is not a kernel thread, then it has an
@@ -183,7 +190,16 @@ int nxsched_release_tcb(FAR struct tcb_s *tcb, uint8_t ttype)
 
       /* And, finally, release the TCB itself */
 
-      kmm_free(tcb);
+#if CONFIG_PTHREAD_TCB_CACHE > 0
+      if (ttype == TCB_FLAG_TTYPE_PTHREAD)
+        {
+          pthread_tcb_free((FAR struct pthread_tcb_s *)tcb);
+        }
+      else
+#endif
+        {
+          kmm_free(tcb);
+        }
     }
 
   return ret;
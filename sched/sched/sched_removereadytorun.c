@@ -102,6 +102,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
    * is always the g_readytorun list.
    */
 
+  nxsched_index_remove((FAR dq_queue_t *)&g_readytorun, rtcb);
   dq_rem((FAR dq_entry_t *)rtcb, (FAR dq_queue_t *)&g_readytorun);
 
   /* Since the TCB is not in any list, it is now invalid */
@@ -199,6 +200,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
        * or the g_assignedtasks[cpu] list.
        */
 
+      nxsched_index_remove(tasklist, rtcb);
       dq_rem((FAR dq_entry_t *)rtcb, tasklist);
 
       /* Which task will go at the head of the list?  It will be either the
@@ -233,15 +235,19 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
         {
           FAR struct tcb_s *tmptcb;
 
-          /* The TCB at the head of the ready to run list has the higher
-           * priority.  Remove that task from the head of the g_readytorun
-           * list and add to the head of the g_assignedtasks[cpu] list.
+          /* The TCB from the ready to run list has the higher priority.
+           * Remove that task from the g_readytorun list and add to the
+           * head of the g_assignedtasks[cpu] list.  It is not necessarily
+           * the head of g_readytorun if the affinity of the head excludes
+           * this CPU.
            */
 
-          tmptcb = (FAR struct tcb_s *)
-            dq_remfirst((FAR dq_queue_t *)&g_readytorun);
+          tmptcb = rtrtcb;
+          nxsched_index_remove((FAR dq_queue_t *)&g_readytorun, tmptcb);
+          dq_rem((FAR dq_entry_t *)tmptcb, (FAR dq_queue_t *)&g_readytorun);
 
           dq_addfirst((FAR dq_entry_t *)tmptcb, tasklist);
+          nxsched_index_add(tasklist, tmptcb);
 
           tmptcb->cpu = cpu;
           nxttcb = tmptcb;
@@ -329,6 +335,7 @@ bool nxsched_remove_readytorun(FAR struct tcb_s *rtcb)
        * g_assignedtasks[cpu] list.
        */
 
+      nxsched_index_remove(tasklist, rtcb);
       dq_rem((FAR dq_entry_t *)rtcb, tasklist);
     }
 
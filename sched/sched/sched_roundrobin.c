@@ -48,6 +48,55 @@
 #  define MAX(a,b) (((a) > (b)) ? (a) : (b))
 #endif
 
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name:  nxsched_rr_peer
+ *
+ * Description:
+ *   Check if another ready-to-run task of at least the same priority may
+ *   take over the CPU when the time slice of 'tcb' expires.
+ *
+ * Input Parameters:
+ *   tcb - The TCB of the currently executing task
+ *
+ * Returned Value:
+ *   True if the task should be rescheduled behind the other task.
+ *
+ ****************************************************************************/
+
+static bool nxsched_rr_peer(FAR struct tcb_s *tcb)
+{
+#ifdef CONFIG_SMP_BALANCE
+  FAR struct tcb_s *btcb;
+#endif
+
+  /* Check the next task assigned to this CPU */
+
+  if (tcb->flink && tcb->flink->sched_priority >= tcb->sched_priority)
+    {
+      return true;
+    }
+
+#ifdef CONFIG_SMP_BALANCE
+  /* And the unassigned tasks that may run on this CPU */
+
+  for (btcb = (FAR struct tcb_s *)g_readytorun.head;
+       btcb != NULL && btcb->sched_priority >= tcb->sched_priority;
+       btcb = btcb->flink)
+    {
+      if (CPU_ISSET(tcb->cpu, &btcb->affinity))
+        {
+          return true;
+        }
+    }
+#endif
+
+  return false;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -137,8 +186,7 @@ uint32_t nxsched_process_roundrobin(FAR struct tcb_s *tcb, uint32_t ticks,
            * give that task a shot.
            */
 
-          if (tcb->flink &&
-              tcb->flink->sched_priority >= tcb->sched_priority)
+          if (nxsched_rr_peer(tcb))
             {
               /* Just resetting the task priority to its current value.
                * This this will cause the task to be rescheduled behind any
@@ -122,6 +122,9 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
                                                int sched_priority)
 {
   FAR struct tcb_s *nxttcb;
+#ifdef CONFIG_SCHED_READYTORUN_INDEX
+  FAR dq_queue_t *tasklist;
+#endif
 
   /* Get the TCB of the next highest priority, ready to run task */
 
@@ -149,9 +152,24 @@ static inline void nxsched_running_setpriority(FAR struct tcb_s *tcb,
 
   else
     {
-      /* Change the task priority */
+      /* Change the task priority.  The task remains at the head of its
+       * list but it moves to a different priority in the list index.
+       */
+
+#ifdef CONFIG_SCHED_READYTORUN_INDEX
+#ifdef CONFIG_SMP
+      tasklist = TLIST_HEAD(tcb->task_state, tcb->cpu);
+#else
+      tasklist = TLIST_HEAD(tcb->task_state);
+#endif
+      nxsched_index_remove(tasklist, tcb);
+#endif
 
       tcb->sched_priority = (uint8_t)sched_priority;
+
+#ifdef CONFIG_SCHED_READYTORUN_INDEX
+      nxsched_index_add(tasklist, tcb);
+#endif
     }
 }
 
@@ -81,6 +81,8 @@ static int sporadic_interval_start(FAR struct replenishment_s *mrepl);
 static int sporadic_replenish_start(FAR struct replenishment_s *repl);
 static int sporadic_replenish_delay(FAR struct replenishment_s *repl,
   uint32_t period, uint32_t replenish);
+static int sporadic_replenish_schedule(FAR struct sporadic_s *sporadic,
+  uint32_t period, uint32_t replenish);
 
 /* Timer expiration handlers */
 
@@ -91,6 +93,9 @@ static void sporadic_delay_expire(int argc, wdparm_t arg1, ...);
 
 /* Misc. helpers */
 
+static void sporadic_settime(FAR struct sporadic_s *sporadic, clock_t now);
+static uint32_t sporadic_unrealized(FAR struct sporadic_s *sporadic,
+                                    clock_t now);
 static void sporadic_timer_cancel(FAR struct tcb_s *tcb);
 FAR struct replenishment_s *
   sporadic_alloc_repl(FAR struct sporadic_s *sporadic);
@@ -150,7 +155,7 @@ static int sporadic_set_lowpriority(FAR struct tcb_s *tcb)
        * state.
        */
 
-      tcb->base_priority = tcb->low_priority;
+      tcb->base_priority = sporadic->low_priority;
     }
   else
 #endif
@@ -285,7 +290,7 @@ static int sporadic_budget_start(FAR struct replenishment_s *mrepl)
 
   /* Save the time that the budget was started */
 
-  sporadic->eventtime = clock_systime_ticks();
+  sporadic_settime(sporadic, clock_systime_ticks());
 
   /* And start the timer for the budget interval */
 
@@ -422,7 +427,7 @@ static int sporadic_replenish_delay(FAR struct replenishment_s *repl,
   /* Save information about the replenishment */
 
   repl->budget = replenish;
-  repl->flags |= SPORADIC_FLAG_REPLENISH;
+  repl->flags |= (SPORADIC_FLAG_REPLENISH | SPORADIC_FLAG_DELAYED);
 
   /* And start the timer for the delay prior to replenishing. */
 
@@ -431,6 +436,80 @@ static int sporadic_replenish_delay(FAR struct replenishment_s *repl,
   return OK;
 }
 
+/****************************************************************************
+ * Name: sporadic_replenish_schedule
+ *
+ * Description:
+ *   Arrange for a replenishment after a delay.  If a pending replenishment
+ *   is due no earlier and at most CONFIG_SCHED_SPORADIC_BATCH ticks later,
+ *   the budget is added to that one and no timer is started.  Delivering
+ *   a replenishment late is always safe; delivering it early is not.
+ *
+ * Input Parameters:
+ *   sporadic  - The thread's sporadic scheduling state
+ *   period    - The delay before the replenishment
+ *   replenish - The replenish time to be applied after the delay
+ *
+ * Returned Value:
+ *   Returns zero (OK) on success or -ENOMEM if the replenishment had to be
+ *   dropped because all replenishment timers are in use.
+ *
+ ****************************************************************************/
+
+static int sporadic_replenish_schedule(FAR struct sporadic_s *sporadic,
+                                       uint32_t period, uint32_t replenish)
+{
+  FAR struct replenishment_s *batch = NULL;
+  FAR struct replenishment_s *repl;
+  uint32_t batchtime = 0;
+  uint32_t remaining;
+  int i;
+
+  /* Find the pending replenishment that is due next, but not before this
+   * one.
+   */
+
+  for (i = 0; i < sporadic->max_repl; i++)
+    {
+      repl = &sporadic->replenishments[i];
+      if ((repl->flags & SPORADIC_FLAG_DELAYED) != 0)
+        {
+          remaining = wd_gettime(&repl->timer);
+          if (remaining >= period &&
+              (batch == NULL || remaining < batchtime))
+            {
+              batch     = repl;
+              batchtime = remaining;
+            }
+        }
+    }
+
+  if (batch == NULL || batchtime > period + CONFIG_SCHED_SPORADIC_BATCH)
+    {
+      /* Nothing to batch with.  Start a new replenishment timer.  This will
+       * limit us to the maximum number of replenishments (max_repl).
+       */
+
+      repl = sporadic_alloc_repl(sporadic);
+      if (repl != NULL)
+        {
+          return sporadic_replenish_delay(repl, period, replenish);
+        }
+
+      /* If all timers are in use, the time is given to the next later
+       * replenishment rather than being lost.
+       */
+
+      if (batch == NULL)
+        {
+          return -ENOMEM;
+        }
+    }
+
+  batch->budget = MIN(batch->budget + replenish, sporadic->budget);
+  return OK;
+}
+
 /****************************************************************************
  * Name: sporadic_budget_expire
  *
@@ -458,7 +537,6 @@ static int sporadic_replenish_delay(FAR struct replenishment_s *repl,
 static void sporadic_budget_expire(int argc, wdparm_t arg1, ...)
 {
   FAR struct replenishment_s *mrepl = (FAR struct replenishment_s *)arg1;
-  FAR struct replenishment_s *repl;
   FAR struct sporadic_s *sporadic;
   FAR struct tcb_s *tcb;
 
@@ -477,8 +555,8 @@ static void sporadic_budget_expire(int argc, wdparm_t arg1, ...)
 
   if (nxsched_islocked_tcb(tcb))
     {
-      DEBUGASSERT((mrepl->flags && SPORADIC_FLAG_ALLOCED) != 0 &&
-                  sporadic->nrepls > 0);
+      DEBUGASSERT((mrepl->flags & SPORADIC_FLAG_ALLOCED) != 0 &&
+                  tcb->sporadic->nrepls > 0);
 
       /* Set the timeslice to the magic value */
 
@@ -507,32 +585,23 @@ static void sporadic_budget_expire(int argc, wdparm_t arg1, ...)
        * that the thread was delayed for the entire interval).
        */
 
-      unrealized = sporadic->eventtime - clock_systime_ticks();
+      unrealized = sporadic_unrealized(sporadic, clock_systime_ticks());
       if (unrealized > 0)
         {
-          /* Allocate a new replenishment timer.  This will limit us to the
-           * maximum number of replenishments (max_repl).
+          /* The delay is one half of the scheduler cycle relative to the
+           * suspend time. Hence, we subtract the unrealized amount.
            */
 
-          repl = sporadic_alloc_repl(sporadic);
-          if (repl != NULL)
-            {
-              /* The delay is one half of the scheduler cycle relative to
-               * the suspend time. Hence, we subtract the unrealized amount.
-               */
-
-              uint32_t period;
+          uint32_t period;
 
-              DEBUGASSERT(unrealized <= (sporadic->repl_period >> 1))
-              period = (sporadic->repl_period >> 1) - unrealized;
+          DEBUGASSERT(unrealized <= (sporadic->repl_period >> 1));
+          period = (sporadic->repl_period >> 1) - unrealized;
 
-              /* Start the delay into the next cycle to perform the
-               * replenishment.
-               */
+          /* Schedule the replenishment into the next cycle.  It is just
+           * lost if no replenishment timer is available.
+           */
 
-              DEBUGVERIFY(sporadic_replenish_delay(repl, period,
-                                                   unrealized));
-            }
+          sporadic_replenish_schedule(sporadic, period, unrealized);
         }
     }
 
@@ -670,11 +739,79 @@ static void sporadic_delay_expire(int argc, wdparm_t arg1, ...)
 
   DEBUGASSERT(argc == 1 && repl != NULL);
 
-  /* Start the replenishment */
+  /* Start the replenishment.  No more budget can be added to it. */
 
+  repl->flags &= ~SPORADIC_FLAG_DELAYED;
   DEBUGVERIFY(sporadic_replenish_start(repl));
 }
 
+/****************************************************************************
+ * Name: sporadic_settime
+ *
+ * Description:
+ *   Save the time of a suspension or of a [re-]start of the thread.
+ *
+ * Input Parameters:
+ *   sporadic - The thread's sporadic scheduling state
+ *   now      - The current system time in ticks
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static void sporadic_settime(FAR struct sporadic_s *sporadic, clock_t now)
+{
+  sporadic->eventtime  = now;
+#ifdef CONFIG_SCHED_SPORADIC_HIRES
+  sporadic->eventstamp = up_critmon_gettime();
+#endif
+}
+
+/****************************************************************************
+ * Name: sporadic_unrealized
+ *
+ * Description:
+ *   Return the number of ticks since the time saved by sporadic_settime().
+ *   With CONFIG_SCHED_SPORADIC_HIRES, the time is measured with the cycle
+ *   counter and the part below one tick is carried over to the next call.
+ *
+ * Input Parameters:
+ *   sporadic - The thread's sporadic scheduling state
+ *   now      - The current system time in ticks
+ *
+ * Returned Value:
+ *   The elapsed time in ticks.
+ *
+ ****************************************************************************/
+
+static uint32_t sporadic_unrealized(FAR struct sporadic_s *sporadic,
+                                    clock_t now)
+{
+  uint32_t elapsed = now - sporadic->eventtime;
+#ifdef CONFIG_SCHED_SPORADIC_HIRES
+  struct timespec ts;
+  uint64_t usec;
+
+  /* The cycle counter wraps much sooner than the tick counter.  Budget
+   * lost for longer than a replenishment period is lost either way, so
+   * the ticks are good enough then.
+   */
+
+  if (elapsed <= sporadic->repl_period)
+    {
+      up_critmon_convert(up_critmon_gettime() - sporadic->eventstamp, &ts);
+      usec = (uint64_t)ts.tv_sec * USEC_PER_SEC +
+             ts.tv_nsec / NSEC_PER_USEC + sporadic->residue;
+
+      elapsed           = usec / USEC_PER_TICK;
+      sporadic->residue = usec % USEC_PER_TICK;
+    }
+#endif
+
+  return elapsed;
+}
+
 /****************************************************************************
  * Name: sporadic_timer_cancel
  *
@@ -806,6 +943,11 @@ int nxsched_initialize_sporadic(FAR struct tcb_s *tcb)
   for (i = 0; i < CONFIG_SCHED_SPORADIC_MAXREPL; i++)
     {
       sporadic->replenishments[i].tcb = tcb;
+      wd_static(&sporadic->replenishments[i].timer);
+
+      /* The budget timers change the priority of the running thread */
+
+      WDOG_SETHARDIRQ(&sporadic->replenishments[i].timer);
     }
 
   /* Hook the sporadic add-on into the TCB */
@@ -857,7 +999,7 @@ int nxsched_start_sporadic(FAR struct tcb_s *tcb)
 
   /* Save the time that the scheduler was started */
 
-  sporadic->eventtime = clock_systime_ticks();
+  sporadic_settime(sporadic, clock_systime_ticks());
   sporadic->suspended = true;
 
   /* Then start the first interval */
@@ -965,6 +1107,9 @@ int nxsched_reset_sporadic(FAR struct tcb_s *tcb)
   sporadic->repl_period  = 0;
   sporadic->budget       = 0;
   sporadic->eventtime    = 0;
+#ifdef CONFIG_SCHED_SPORADIC_HIRES
+  sporadic->residue      = 0;
+#endif
   sporadic->active       = NULL;
   return OK;
 }
@@ -998,7 +1143,6 @@ int nxsched_reset_sporadic(FAR struct tcb_s *tcb)
 int nxsched_resume_sporadic(FAR struct tcb_s *tcb)
 {
   FAR struct sporadic_s *sporadic;
-  FAR struct replenishment_s *repl;
   clock_t now;
   uint32_t unrealized;
   uint32_t last;
@@ -1035,7 +1179,7 @@ int nxsched_resume_sporadic(FAR struct tcb_s *tcb)
     {
       /* Unrealized budget time while the thread was suspended */
 
-      unrealized = now - sporadic->eventtime;
+      unrealized = sporadic_unrealized(sporadic, now);
 
       /* Ignore very short pre-emptions that are below
        * our timing resolution.
@@ -1075,28 +1219,23 @@ int nxsched_resume_sporadic(FAR struct tcb_s *tcb)
 
           if (tcb->timeslice < last)
             {
-              /* Allocate a new replenishment timer.  This will limit us to
-               * to maximum number of replenishments (max_repl).
+              /* The delay is one half of the scheduler cycle relative to
+               * the suspend time. Hence, we subtract the unrealized amount.
                */
 
-              repl = sporadic_alloc_repl(sporadic);
-              if (repl != NULL)
-                {
-                  /* The delay is one half of the scheduler cycle relative
-                   * to the suspend time. Hence, we subtract the unrealized.
-                   * amount.
-                   */
-
-                  uint32_t period;
+              uint32_t period;
+              int ret;
 
-                  DEBUGASSERT(unrealized <= (sporadic->repl_period >> 1))
-                  period = (sporadic->repl_period >> 1) - unrealized;
+              DEBUGASSERT(unrealized <= (sporadic->repl_period >> 1));
+              period = (sporadic->repl_period >> 1) - unrealized;
 
-                  /* Start the delay into the next cycle to perform the
-                   * replenishment.
-                   */
+              /* Schedule the replenishment into the next cycle */
 
-                  return sporadic_replenish_delay(repl, period, unrealized);
+              ret = sporadic_replenish_schedule(sporadic, period,
+                                                unrealized);
+              if (ret >= 0)
+                {
+                  return ret;
                 }
 
               /* We need to return success even on a failure to allocate.
@@ -1110,7 +1249,7 @@ int nxsched_resume_sporadic(FAR struct tcb_s *tcb)
         }
     }
 
-  sporadic->eventtime = now;
+  sporadic_settime(sporadic, now);
   return OK;
 }
 
@@ -1154,7 +1293,7 @@ int nxsched_suspend_sporadic(FAR struct tcb_s *tcb)
 
       /* Save the time that the thread was suspended */
 
-      sporadic->eventtime = clock_systime_ticks();
+      sporadic_settime(sporadic, clock_systime_ticks());
     }
 
   return OK;
@@ -111,6 +111,10 @@ static uint32_t nxsched_process_scheduler(uint32_t ticks, bool noswitches);
 #endif
 static unsigned int nxsched_timer_process(unsigned int ticks,
                                           bool noswitches);
+#if CONFIG_SCHED_TICKLESS_SLACK > 0
+static unsigned int nxsched_timer_coalesce(unsigned int deadline,
+                                           unsigned int schedtime);
+#endif
 static void nxsched_timer_start(unsigned int ticks);
 
 /****************************************************************************
@@ -356,14 +360,109 @@ static unsigned int nxsched_timer_process(unsigned int ticks,
    */
 
   tmp = nxsched_process_scheduler(ticks, noswitches);
+
+#ifdef CONFIG_SMP_BALANCE
+  /* Start ready-to-run tasks left behind on a lower priority CPU */
+
+  if (!noswitches)
+    {
+      nxsched_balance();
+    }
+#endif
+
   if (tmp > 0 && tmp < cmptime)
     {
       rettime = tmp;
     }
 
+#if CONFIG_SCHED_TICKLESS_SLACK > 0
+  /* Let the events due shortly after the first one expire with it */
+
+  if (rettime > 0)
+    {
+      rettime = nxsched_timer_coalesce(rettime, tmp);
+    }
+#endif
+
   return rettime;
 }
 
+/****************************************************************************
+ * Name:  nxsched_timer_coalesce
+ *
+ * Description:
+ *   Select the interval to the next timer expiration so that the events
+ *   due within CONFIG_SCHED_TICKLESS_SLACK ticks of the first one are
+ *   all processed by the same expiration.  The events are delayed by at
+ *   most the slack, never advanced.
+ *
+ * Input Parameters:
+ *   deadline  - The delay of the first event.
+ *   schedtime - The delay of the next scheduler event, zero if there is
+ *               none.
+ *
+ * Returned Value:
+ *   The number of ticks to use when setting up the next timer.
+ *
+ ****************************************************************************/
+
+#if CONFIG_SCHED_TICKLESS_SLACK > 0
+static unsigned int nxsched_timer_coalesce(unsigned int deadline,
+                                           unsigned int schedtime)
+{
+  FAR struct wdog_s *wdog;
+#ifdef CONFIG_SMP
+  irqstate_t flags;
+#endif
+  unsigned int rettime;
+  unsigned int limit;
+
+  /* The latest time that the first event may be delayed to */
+
+  rettime = deadline;
+  limit   = deadline + CONFIG_SCHED_TICKLESS_SLACK;
+  if (limit < deadline)
+    {
+      return deadline;
+    }
+
+  /* Extend the interval to the last watchdog that expires within the
+   * slack.  wd_timer() then runs all of them in one pass.
+   */
+
+#ifdef CONFIG_SMP
+  flags = enter_critical_section();
+#endif
+
+  deadline = 0;
+  for (wdog = (FAR struct wdog_s *)g_wdactivelist.head;
+       wdog != NULL;
+       wdog = wdog->next)
+    {
+      deadline += wdog->lag;
+      if (deadline > limit)
+        {
+          break;
+        }
+
+      rettime = MAX(rettime, deadline);
+    }
+
+#ifdef CONFIG_SMP
+  leave_critical_section(flags);
+#endif
+
+  /* And to the scheduler event if it is also due within the slack */
+
+  if (schedtime > rettime && schedtime <= limit)
+    {
+      rettime = schedtime;
+    }
+
+  return rettime;
+}
+#endif
+
 /****************************************************************************
  * Name:  nxsched_timer_start
  *
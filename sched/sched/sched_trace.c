@@ -0,0 +1,214 @@
+/****************************************************************************
+ * sched/sched/sched_trace.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <assert.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/irq.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/sched_note.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_TRACE
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The set of enabled tracepoint categories */
+
+volatile uint32_t g_note_tracemask = CONFIG_SCHED_INSTRUMENTATION_TRACEMASK;
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TRACE_LATENCY
+static struct note_tracelat_s g_trace_latency[NOTE_TRACE_NCATEGORIES];
+
+#ifdef CONFIG_SMP
+static volatile spinlock_t g_trace_lock;
+#endif
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: trace_record
+ *
+ * Description:
+ *   Add the time of one operation to the latency histogram of its
+ *   category.
+ *
+ * Input Parameters:
+ *   category - The tracepoint category
+ *   elapsed  - The time of the operation in up_critmon_gettime() units
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TRACE_LATENCY
+static void trace_record(int category, uint32_t elapsed)
+{
+  FAR struct note_tracelat_s *lat = &g_trace_latency[category];
+  struct timespec ts;
+  irqstate_t flags;
+  uint32_t usec;
+  int bucket;
+
+  up_critmon_convert(elapsed, &ts);
+  usec = (uint32_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+
+  bucket = usec == 0 ? 0 : fls((int)usec);
+  if (bucket >= NOTE_TRACE_NBUCKETS)
+    {
+      bucket = NOTE_TRACE_NBUCKETS - 1;
+    }
+
+  flags = up_irq_save();
+#ifdef CONFIG_SMP
+  spin_lock_wo_note(&g_trace_lock);
+#endif
+
+  lat->ntl_count[bucket]++;
+  if (usec > lat->ntl_max)
+    {
+      lat->ntl_max = usec;
+    }
+
+#ifdef CONFIG_SMP
+  spin_unlock_wo_note(&g_trace_lock);
+#endif
+  up_irq_restore(flags);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_trace_event
+ *
+ * Description:
+ *   Report the begin or the end of a traced operation.  This is called
+ *   through sched_trace_begin() and sched_trace_end(), not directly.
+ *
+ * Input Parameters:
+ *   category - The tracepoint category
+ *   begin    - True: The operation begins; false: It ends
+ *   arg      - The tracepoint argument
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sched_trace_event(int category, bool begin, FAR void *arg)
+{
+  FAR struct tcb_s *tcb = this_task();
+
+  DEBUGASSERT(category >= 0 && category < NOTE_TRACE_NCATEGORIES);
+
+#ifdef CONFIG_SCHED_TRACE_LATENCY
+  /* Operations performed by interrupt handlers are not measured; they do
+   * not belong to the interrupted thread.
+   */
+
+  if (!up_interrupt_context())
+    {
+      if (begin)
+        {
+          tcb->trace_start[category] = up_critmon_gettime();
+        }
+
+      /* An operation that began before its category was enabled has no
+       * begin time.
+       */
+
+      else if (tcb->trace_start[category] != 0)
+        {
+          trace_record(category,
+                       up_critmon_gettime() - tcb->trace_start[category]);
+          tcb->trace_start[category] = 0;
+        }
+    }
+#endif
+
+  sched_note_trace(tcb, (uint8_t)category, begin, arg);
+}
+
+/****************************************************************************
+ * Name: sched_trace_latency
+ *
+ * Description:
+ *   Return the latency histogram of a tracepoint category.
+ *
+ * Input Parameters:
+ *   category - The tracepoint category
+ *   lat      - The location to return the histogram
+ *   reset    - True: Clear the histogram after it was returned
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_TRACE_LATENCY
+void sched_trace_latency(int category, FAR struct note_tracelat_s *lat,
+                         bool reset)
+{
+  irqstate_t flags;
+
+  DEBUGASSERT(category >= 0 && category < NOTE_TRACE_NCATEGORIES &&
+              lat != NULL);
+
+  flags = up_irq_save();
+#ifdef CONFIG_SMP
+  spin_lock_wo_note(&g_trace_lock);
+#endif
+
+  memcpy(lat, &g_trace_latency[category], sizeof(struct note_tracelat_s));
+  if (reset)
+    {
+      memset(&g_trace_latency[category], 0, sizeof(struct note_tracelat_s));
+    }
+
+#ifdef CONFIG_SMP
+  spin_unlock_wo_note(&g_trace_lock);
+#endif
+  up_irq_restore(flags);
+}
+#endif
+
+#endif /* CONFIG_SCHED_INSTRUMENTATION_TRACE */
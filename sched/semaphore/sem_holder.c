@@ -76,14 +76,22 @@ static inline FAR struct semholder_s *nxsem_allocholder(sem_t *sem)
    */
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  pholder = g_freeholders;
+  /* Only a semaphore with more than one holder at a time takes holders
+   * from the pre-allocated pool.
+   */
+
+  pholder = sem->holder.htcb == NULL ? &sem->holder : g_freeholders;
   if (pholder != NULL)
     {
       /* Remove the holder from the free list an put it into the semaphore's
        * holder list
        */
 
-      g_freeholders    = pholder->flink;
+      if (pholder == g_freeholders)
+        {
+          g_freeholders = pholder->flink;
+        }
+
       pholder->flink   = sem->hhead;
       sem->hhead       = pholder;
 
@@ -217,10 +225,15 @@ static inline void nxsem_freeholder(sem_t *sem,
           sem->hhead = pholder->flink;
         }
 
-      /* And put it in the free list */
+      /* And put it in the free list, unless it is the holder embedded in
+       * the semaphore.
+       */
 
-      pholder->flink = g_freeholders;
-      g_freeholders  = pholder;
+      if (pholder != &sem->holder)
+        {
+          pholder->flink = g_freeholders;
+          g_freeholders  = pholder;
+        }
     }
 #endif
 }
@@ -107,6 +107,16 @@ int nxsem_timedwait(FAR sem_t *sem, FAR const struct timespec *abstime)
     }
 #endif
 
+  /* Try to take the semaphore without waiting first.  This is the normal,
+   * uncontended case and needs no watchdog.
+   */
+
+  ret = nxsem_trywait(sem);
+  if (ret == OK)
+    {
+      return OK;
+    }
+
   /* Create a watchdog.  We will not actually need this watchdog
    * unless the semaphore is unavailable, but we will reserve it up
    * front before we enter the following critical section.
@@ -81,6 +81,8 @@
 void spin_lock(FAR volatile spinlock_t *lock)
 {
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  unsigned int spins = 0;
+
   /* Notify that we are waiting for a spinlock */
 
   sched_note_spinlock(this_task(), lock);
@@ -88,13 +90,25 @@ void spin_lock(FAR volatile spinlock_t *lock)
 
   while (up_testset(lock) == SP_LOCKED)
     {
-      SP_DSB();
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+      spins++;
+#endif
+
+      /* Wait with plain reads until the lock is released.  Repeating the
+       * test-and-set would move the cache line between the waiting CPUs.
+       */
+
+      do
+        {
+          SP_DSB();
+        }
+      while (*lock == SP_LOCKED);
     }
 
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we have the spinlock */
 
-  sched_note_spinlocked(this_task(), lock);
+  sched_note_spinlocked(this_task(), lock, spins);
 #endif
   SP_DMB();
 }
@@ -125,7 +139,11 @@ void spin_lock_wo_note(FAR volatile spinlock_t *lock)
 {
   while (up_testset(lock) == SP_LOCKED)
     {
-      SP_DSB();
+      do
+        {
+          SP_DSB();
+        }
+      while (*lock == SP_LOCKED);
     }
 
   SP_DMB();
@@ -163,7 +181,7 @@ spinlock_t spin_trylock(FAR volatile spinlock_t *lock)
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
       /* Notify that we abort for a spinlock */
 
-      sched_note_spinabort(this_task(), &lock);
+      sched_note_spinabort(this_task(), lock);
 #endif
       SP_DSB();
       return SP_LOCKED;
@@ -172,7 +190,7 @@ spinlock_t spin_trylock(FAR volatile spinlock_t *lock)
 #ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
   /* Notify that we have the spinlock */
 
-  sched_note_spinlocked(this_task(), lock);
+  sched_note_spinlocked(this_task(), lock, 0);
 #endif
   SP_DMB();
   return SP_UNLOCKED;
@@ -321,7 +339,7 @@ void spin_setbit(FAR volatile cpu_set_t *set, unsigned int cpu,
     {
       /* Notify that we have locked the spinlock */
 
-      sched_note_spinlocked(this_task(), orlock);
+      sched_note_spinlocked(this_task(), orlock, 0);
     }
 #endif
 
@@ -395,4 +413,138 @@ void spin_clrbit(FAR volatile cpu_set_t *set, unsigned int cpu,
 }
 #endif
 
+/****************************************************************************
+ * Name: spin_lock_irqsave_private
+ *
+ * Description:
+ *   Disable local interrupts and take a private spinlock.
+ *
+ * Input Parameters:
+ *   lock - A reference to the spinlock object to lock.
+ *
+ * Returned Value:
+ *   The state of the interrupts prior to the call.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+irqstate_t spin_lock_irqsave_private(FAR volatile spinlock_t *lock)
+{
+  irqstate_t flags;
+
+  flags = up_irq_save();
+  spin_lock(lock);
+  return flags;
+}
+#endif
+
+/****************************************************************************
+ * Name: spin_unlock_irqrestore_private
+ *
+ * Description:
+ *   Release a private spinlock and restore the interrupt state.
+ *
+ * Input Parameters:
+ *   lock  - A reference to the spinlock object to unlock.
+ *   flags - The value returned by spin_lock_irqsave_private().
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SMP
+void spin_unlock_irqrestore_private(FAR volatile spinlock_t *lock,
+                                    irqstate_t flags)
+{
+  spin_unlock(lock);
+  up_irq_restore(flags);
+}
+#endif
+
+/****************************************************************************
+ * Name: spin_lock_ticket
+ *
+ * Description:
+ *   Take a ticket spinlock in the order of the calls.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to lock.
+ *
+ * Returned Value:
+ *   None.  When the function returns, the spinlock was successfully locked
+ *   by this CPU.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_TICKET
+void spin_lock_ticket(FAR spinlock_ticket_t *lock)
+{
+  uint16_t ticket;
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  uint16_t spins;
+
+  /* Notify that we are waiting for a spinlock */
+
+  sched_note_spinlock(this_task(), lock);
+#endif
+
+  /* up_fetchadd16() returns the incremented value */
+
+  ticket = (uint16_t)up_fetchadd16((FAR volatile int16_t *)&lock->next, 1);
+  ticket--;
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* The contention is the number of CPUs served before this one */
+
+  spins = ticket - lock->owner;
+#endif
+
+  while (lock->owner != ticket)
+    {
+      SP_DSB();
+    }
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* Notify that we have the spinlock */
+
+  sched_note_spinlocked(this_task(), lock, spins);
+#endif
+  SP_DMB();
+}
+#endif
+
+/****************************************************************************
+ * Name: spin_unlock_ticket
+ *
+ * Description:
+ *   Release a ticket spinlock.
+ *
+ * Input Parameters:
+ *   lock - A reference to the ticket spinlock object to unlock.
+ *
+ * Returned Value:
+ *   None.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SPINLOCK_TICKET
+void spin_unlock_ticket(FAR spinlock_ticket_t *lock)
+{
+  DEBUGASSERT(spin_islocked_ticket(lock));
+
+#ifdef CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS
+  /* Notify that we are unlocking the spinlock */
+
+  sched_note_spinunlock(this_task(), lock);
+#endif
+
+  /* Only the holder writes 'owner', so no atomic operation is needed */
+
+  SP_DMB();
+  lock->owner++;
+  SP_DSB();
+}
+#endif
+
 #endif /* CONFIG_SPINLOCK */
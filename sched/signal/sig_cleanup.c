@@ -111,4 +111,6 @@ void nxsig_release(FAR struct task_group_s *group)
     {
       nxsig_release_pendingsignal(sigpend);
     }
+
+  group->tg_sigpendset = NULL_SIGNAL_SET;
 }
@@ -204,6 +204,13 @@ static FAR sigpendq_t *
 
   DEBUGASSERT(group != NULL);
 
+  /* Most signals are not pending:  Avoid searching the list for them */
+
+  if (!nxsig_ismember(&group->tg_sigpendset, signo))
+    {
+      return NULL;
+    }
+
   /* Pending signals can be added from interrupt level. */
 
   flags = enter_critical_section();
@@ -266,6 +273,7 @@ static void nxsig_add_pendingsignal(FAR struct tcb_s *stcb,
 
           flags = enter_critical_section();
           sq_addlast((FAR sq_entry_t *)sigpend, &group->tg_sigpendingq);
+          nxsig_addset(&group->tg_sigpendset, info->si_signo);
           leave_critical_section(flags);
         }
     }
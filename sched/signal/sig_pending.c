@@ -88,29 +88,16 @@ int sigpending(FAR sigset_t *set)
  * Name: nxsig_pendingset
  *
  * Description:
- *   Convert the list of pending signals into a signal set
+ *   Return the set of pending signals.  The set is maintained together
+ *   with the list of pending signals, so the list is not searched.
  *
  ****************************************************************************/
 
 sigset_t nxsig_pendingset(FAR struct tcb_s *stcb)
 {
   FAR struct task_group_s *group = stcb->group;
-  sigset_t sigpendset;
-  FAR sigpendq_t *sigpend;
-  irqstate_t flags;
 
   DEBUGASSERT(group);
 
-  sigpendset = NULL_SIGNAL_SET;
-
-  flags = enter_critical_section();
-  for (sigpend = (FAR sigpendq_t *)group->tg_sigpendingq.head;
-       (sigpend); sigpend = sigpend->flink)
-    {
-      nxsig_addset(&sigpendset, sigpend->info.si_signo);
-    }
-
-  leave_critical_section(flags);
-
-  return sigpendset;
+  return group->tg_sigpendset;
 }
@@ -51,6 +51,7 @@
 #include <nuttx/arch.h>
 #include <nuttx/wdog.h>
 #include <nuttx/kmalloc.h>
+#include <nuttx/signal.h>
 
 #include "signal/signal.h"
 
@@ -75,6 +76,13 @@ FAR sigpendq_t *nxsig_remove_pendingsignal(FAR struct tcb_s *stcb, int signo)
 
   DEBUGASSERT(group);
 
+  /* Most signals are not pending:  Avoid searching the list for them */
+
+  if (!nxsig_ismember(&group->tg_sigpendset, signo))
+    {
+      return NULL;
+    }
+
   flags = enter_critical_section();
 
   for (prevsig = NULL,
@@ -92,6 +100,10 @@ FAR sigpendq_t *nxsig_remove_pendingsignal(FAR struct tcb_s *stcb, int signo)
         {
           sq_remfirst(&group->tg_sigpendingq);
         }
+
+      /* There is only one entry for each signal in the list */
+
+      nxsig_delset(&group->tg_sigpendset, signo);
     }
 
   leave_critical_section(flags);
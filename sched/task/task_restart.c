@@ -140,6 +140,7 @@ int task_restart(pid_t pid)
   tasklist = TLIST_HEAD(tcb->cmn.task_state);
 #endif
 
+  nxsched_index_remove(tasklist, &tcb->cmn);
   dq_rem((FAR dq_entry_t *)tcb, tasklist);
   tcb->cmn.task_state = TSTATE_TASK_INVALID;
 
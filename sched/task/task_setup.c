@@ -391,6 +391,12 @@ static int nxthread_schedsetup(FAR struct tcb_s *tcb, int priority,
       nxtask_inherit_affinity(tcb);
 #endif
 
+#ifdef CONFIG_MM_REGION_ATTR
+      /* The default heap placement is inherited as well */
+
+      tcb->mmattr = this_task()->mmattr;
+#endif
+
       /* exec(), pthread_create(), task_create(), and vfork() all
        * inherit the signal mask of the parent thread.
        */
@@ -55,6 +55,7 @@ struct posix_timer_s
   pid_t            pt_owner;       /* Creator of timer */
   int              pt_delay;       /* If non-zero, used to reset repetitive timers */
   int              pt_last;        /* Last value used to set watchdog */
+  int              pt_overrun;     /* Expirations while notification pending */
   WDOG_ID          pt_wdog;        /* The watchdog that provides the timing */
   struct sigevent  pt_event;       /* Notification information */
   struct sigwork_s pt_work;
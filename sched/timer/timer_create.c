@@ -190,6 +190,7 @@ int timer_create(clockid_t clockid, FAR struct sigevent *evp,
   ret->pt_crefs = 1;
   ret->pt_owner = getpid();
   ret->pt_delay = 0;
+  ret->pt_overrun = 0;
   ret->pt_wdog  = wdog;
 
   /* Was a struct sigevent provided? */
@@ -70,13 +70,23 @@
  *     timer_create() but not yet deleted by timer_delete().
  *
  * Assumptions:
+ *   Overruns are counted while the timer signal is pending (blocked and
+ *   not yet accepted, e.g. by sigwaitinfo()) or while the SIGEV_THREAD
+ *   function of the previous expiration has not yet run.
  *
  ****************************************************************************/
 
 int timer_getoverrun(timer_t timerid)
 {
-  set_errno(ENOSYS);
-  return ERROR;
+  FAR struct posix_timer_s *timer = (FAR struct posix_timer_s *)timerid;
+
+  if (!timer)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  return timer->pt_overrun;
 }
 
 #endif /* CONFIG_DISABLE_POSIX_TIMERS */
@@ -29,8 +29,14 @@
 #include <string.h>
 #include <errno.h>
 
+#include <limits.h>
+
 #include <nuttx/irq.h>
+#include <nuttx/signal.h>
+#include <nuttx/wqueue.h>
 
+#include "sched/sched.h"
+#include "signal/signal.h"
 #include "clock/clock.h"
 #include "timer/timer.h"
 
@@ -40,6 +46,7 @@
  * Private Function Prototypes
  ****************************************************************************/
 
+static bool timer_pending(FAR struct posix_timer_s *timer);
 static inline void timer_signotify(FAR struct posix_timer_s *timer);
 static inline void timer_restart(FAR struct posix_timer_s *timer,
                                  wdparm_t itimer);
@@ -49,6 +56,47 @@ static void timer_timeout(int argc, wdparm_t itimer, ...);
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: timer_pending
+ *
+ * Description:
+ *   Check if the notification of the previous expiration is still pending:
+ *   Its signal was not yet accepted by the owner or its SIGEV_THREAD
+ *   function has not yet run.
+ *
+ * Input Parameters:
+ *   timer - A reference to the POSIX timer that just timed out
+ *
+ * Returned Value:
+ *   True if the notification is still pending.
+ *
+ * Assumptions:
+ *   This function executes in the context of the watchod timer interrupt.
+ *
+ ****************************************************************************/
+
+static bool timer_pending(FAR struct posix_timer_s *timer)
+{
+  FAR struct tcb_s *tcb;
+
+  if (timer->pt_event.sigev_notify == SIGEV_SIGNAL)
+    {
+      tcb = nxsched_get_tcb(timer->pt_owner);
+      return tcb != NULL && tcb->group != NULL &&
+             nxsig_ismember(&tcb->group->tg_sigpendset,
+                            timer->pt_event.sigev_signo) == 1;
+    }
+
+#ifdef CONFIG_SIG_EVTHREAD
+  if (timer->pt_event.sigev_notify == SIGEV_THREAD)
+    {
+      return !work_available(&timer->pt_work.work);
+    }
+#endif
+
+  return false;
+}
+
 /****************************************************************************
  * Name: timer_signotify
  *
@@ -133,7 +181,23 @@ static void timer_timeout(int argc, wdparm_t itimer, ...)
    */
 
   timer->pt_crefs++;
-  timer_signotify(timer);
+
+  /* Only a single notification is queued for a timer at any time.  If the
+   * previous one is still pending, count an overrun instead.
+   */
+
+  if (timer_pending(timer))
+    {
+      if (timer->pt_overrun < DELAYTIMER_MAX)
+        {
+          timer->pt_overrun++;
+        }
+    }
+  else
+    {
+      timer->pt_overrun = 0;
+      timer_signotify(timer);
+    }
 
   /* Release the reference.  timer_release will return nonzero if the timer
    * was not deleted.
@@ -253,6 +317,7 @@ int timer_settime(timer_t timerid, int flags,
   /* Cancel any pending notification */
 
   nxsig_cancel_notification(&timer->pt_work);
+  timer->pt_overrun = 0;
 
   /* If the it_value member of value is zero, the timer will not be
    * re-armed
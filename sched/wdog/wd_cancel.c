@@ -57,8 +57,10 @@
 
 int wd_cancel(WDOG_ID wdog)
 {
+#ifndef CONFIG_WDOG_WHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
+#endif
   irqstate_t flags;
   int ret = -EINVAL;
 
@@ -74,6 +76,11 @@ int wd_cancel(WDOG_ID wdog)
 
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_WHEEL
+      /* Remove the watchdog from its timing wheel slot in constant time */
+
+      wd_wheel_remove(wdog);
+#else
       /* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
        * to do this because there are additional operations that need to be
        * done.
@@ -123,6 +130,7 @@ int wd_cancel(WDOG_ID wdog)
 
           nxsched_reassess_timer();
         }
+#endif
 
       /* Mark the watchdog inactive */
 
@@ -133,6 +141,17 @@ int wd_cancel(WDOG_ID wdog)
 
       ret = OK;
     }
+#ifdef CONFIG_WDOG_THREAD
+  else if (wdog != NULL && WDOG_ISPENDING(wdog))
+    {
+      /* The watchdog expired, but its function has not been executed by
+       * the watchdog thread yet.  Just forget about it.
+       */
+
+      wd_undefer(wdog);
+      ret = OK;
+    }
+#endif
 
   leave_critical_section(flags);
   return ret;
@@ -74,7 +74,7 @@ int wd_delete(WDOG_ID wdog)
 
   /* Check if the watchdog has been started. */
 
-  if (WDOG_ISACTIVE(wdog))
+  if (WDOG_ISACTIVE(wdog) || WDOG_ISPENDING(wdog))
     {
       /* Yes.. stop it */
 
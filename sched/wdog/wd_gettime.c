@@ -24,6 +24,8 @@
 
 #include <nuttx/config.h>
 
+#include <limits.h>
+
 #include <nuttx/wdog.h>
 #include <nuttx/irq.h>
 
@@ -59,6 +61,14 @@ int wd_gettime(WDOG_ID wdog)
   flags = enter_critical_section();
   if (wdog != NULL && WDOG_ISACTIVE(wdog))
     {
+#ifdef CONFIG_WDOG_WHEEL
+      /* The wheel holds the expiration time of the watchdog */
+
+      int delay = wd_wheel_remaining(wdog);
+
+      leave_critical_section(flags);
+      return delay;
+#else
       /* Traverse the watchdog list accumulating lag times until we find the
        * wdog that we are looking for
        */
@@ -78,8 +88,57 @@ int wd_gettime(WDOG_ID wdog)
               return delay;
             }
         }
+#endif
     }
 
   leave_critical_section(flags);
   return 0;
 }
+
+/****************************************************************************
+ * Name: wd_getnext
+ *
+ * Description:
+ *   This function returns the time remaining before the first active
+ *   watchdog timer expires.  This is the longest time that the system may
+ *   sleep without delaying a timer, so power management can use it to
+ *   choose a sleep state.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   The time in system ticks remaining until the first watchdog expires,
+ *   zero if it has already expired, or INT_MAX if no watchdog is active.
+ *
+ ****************************************************************************/
+
+int wd_getnext(void)
+{
+  irqstate_t flags;
+  int delay;
+
+  flags = enter_critical_section();
+
+#ifdef CONFIG_WDOG_WHEEL
+  delay = wd_wheel_next();
+#else
+  if (g_wdactivelist.head != NULL)
+    {
+      /* The lag of the head of the list is its own delay */
+
+      delay = ((FAR struct wdog_s *)g_wdactivelist.head)->lag - wd_elapse();
+      if (delay < 0)
+        {
+          delay = 0;
+        }
+    }
+  else
+    {
+      delay = INT_MAX;
+    }
+#endif
+
+  leave_critical_section(flags);
+  return delay;
+}
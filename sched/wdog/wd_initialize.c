@@ -43,7 +43,9 @@ sq_queue_t g_wdfreelist;
  * this linked list are removed and the function is called.
  */
 
+#ifndef CONFIG_WDOG_WHEEL
 sq_queue_t g_wdactivelist;
+#endif
 
 /* This is the number of free, pre-allocated watchdog structures in the
  * g_wdfreelist.  This value is used to enforce a reserve for interrupt
@@ -101,7 +103,11 @@ void wd_initialize(void)
   /* Initialize watchdog lists */
 
   sq_init(&g_wdfreelist);
+#ifdef CONFIG_WDOG_WHEEL
+  wd_wheel_initialize();
+#else
   sq_init(&g_wdactivelist);
+#endif
 
   /* The g_wdfreelist must be loaded at initialization time to hold the
    * configured number of watchdogs.
@@ -55,6 +55,35 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: wd_expire
+ *
+ * Description:
+ *   Execute the function of an expired watchdog in the timer interrupt or
+ *   pass it to the watchdog thread.  The watchdog has already been removed
+ *   from the active watchdogs and marked inactive.
+ *
+ * Input Parameters:
+ *   wdog - The expired watchdog
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+static inline void wd_expire(FAR struct wdog_s *wdog)
+{
+#ifdef CONFIG_WDOG_THREAD
+  if (!WDOG_ISHARDIRQ(wdog))
+    {
+      wd_defer(wdog);
+      return;
+    }
+#endif
+
+  wd_dispatch(wdog);
+}
+
 /****************************************************************************
  * Name: wd_expiration
  *
@@ -70,6 +99,7 @@
  *
  ****************************************************************************/
 
+#ifndef CONFIG_WDOG_WHEEL
 static inline void wd_expiration(void)
 {
   FAR struct wdog_s *wdog;
@@ -104,34 +134,57 @@ static inline void wd_expiration(void)
 
           /* Execute the watchdog function */
 
-          up_setpicbase(wdog->picbase);
+          wd_expire(wdog);
+        }
+    }
+}
+#endif /* !CONFIG_WDOG_WHEEL */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_dispatch
+ *
+ * Description:
+ *   Execute the function of an expired watchdog.  The watchdog has already
+ *   been removed from the active watchdogs and marked inactive.
+ *
+ * Input Parameters:
+ *   wdog - The expired watchdog
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void wd_dispatch(FAR struct wdog_s *wdog)
+{
+  /* Execute the watchdog function */
+
+  up_setpicbase(wdog->picbase);
 
 #if CONFIG_MAX_WDOGPARMS == 0
-          wdog->func(0);
+  wdog->func(0);
 #elif CONFIG_MAX_WDOGPARMS == 1
-          wdog->func((int)wdog->argc,
-                     wdog->parm[0]);
+  wdog->func((int)wdog->argc,
+             wdog->parm[0]);
 #elif CONFIG_MAX_WDOGPARMS == 2
-          wdog->func((int)wdog->argc,
-                     wdog->parm[0], wdog->parm[1]);
+  wdog->func((int)wdog->argc,
+             wdog->parm[0], wdog->parm[1]);
 #elif CONFIG_MAX_WDOGPARMS == 3
-          wdog->func((int)wdog->argc,
-                     wdog->parm[0], wdog->parm[1], wdog->parm[2]);
+  wdog->func((int)wdog->argc,
+             wdog->parm[0], wdog->parm[1], wdog->parm[2]);
 #elif CONFIG_MAX_WDOGPARMS == 4
-          wdog->func((int)wdog->argc,
-                     wdog->parm[0], wdog->parm[1], wdog->parm[2],
-                     wdog->parm[3]);
+  wdog->func((int)wdog->argc,
+             wdog->parm[0], wdog->parm[1], wdog->parm[2],
+             wdog->parm[3]);
 #else
 #  error Missing support
 #endif
-        }
-    }
 }
 
-/****************************************************************************
- * Public Functions
- ****************************************************************************/
-
 /****************************************************************************
  * Name: wd_start
  *
@@ -164,17 +217,21 @@ static inline void wd_expiration(void)
  *
  * Assumptions:
  *   The watchdog routine runs in the context of the timer interrupt handler
- *   and is subject to all ISR restrictions.
+ *   and is subject to all ISR restrictions.  With CONFIG_WDOG_THREAD, it
+ *   runs in the watchdog thread with interrupts enabled instead, unless the
+ *   watchdog was marked with WDOG_SETHARDIRQ().
  *
  ****************************************************************************/
 
 int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
 {
   va_list ap;
+#ifndef CONFIG_WDOG_WHEEL
   FAR struct wdog_s *curr;
   FAR struct wdog_s *prev;
   FAR struct wdog_s *next;
   int32_t now;
+#endif
   irqstate_t flags;
   int i;
 
@@ -192,7 +249,7 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
    */
 
   flags = enter_critical_section();
-  if (WDOG_ISACTIVE(wdog))
+  if (WDOG_ISACTIVE(wdog) || WDOG_ISPENDING(wdog))
     {
       wd_cancel(wdog);
     }
@@ -229,6 +286,11 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
       delay--;
     }
 
+#ifdef CONFIG_WDOG_WHEEL
+  /* Add the watchdog to the timing wheel.  This takes constant time. */
+
+  wd_wheel_add(wdog, delay);
+#else
 #ifdef CONFIG_SCHED_TICKLESS
   /* Cancel the interval timer that drives the timing events.  This will
    * cause wd_timer to be called which update the delay value for the first
@@ -329,9 +391,13 @@ int wd_start(WDOG_ID wdog, int32_t delay, wdentry_t wdentry,  int argc, ...)
         }
     }
 
-  /* Put the lag into the watchdog structure and mark it as active. */
+  /* Put the lag into the watchdog structure */
 
   wdog->lag = delay;
+#endif /* CONFIG_WDOG_WHEEL */
+
+  /* Mark the watchdog as active */
+
   WDOG_SETACTIVE(wdog);
 
 #ifdef CONFIG_SCHED_TICKLESS
@@ -403,10 +469,11 @@ unsigned int wd_timer(int ticks)
 
       wdog = (FAR struct wdog_s *)g_wdactivelist.head;
 
-#ifndef CONFIG_SCHED_TICKLESS_ALARM
+#if !defined(CONFIG_SCHED_TICKLESS_ALARM) && CONFIG_SCHED_TICKLESS_SLACK == 0
       /* There is logic to handle the case where ticks is greater than
        * the watchdog lag, but if the scheduling is working properly
-       * that should never happen.
+       * that should never happen.  With timer slack, expirations are
+       * coalesced and ticks may cover several watchdogs.
        */
 
       DEBUGASSERT(ticks <= wdog->lag);
@@ -444,6 +511,42 @@ unsigned int wd_timer(int ticks)
   return ret;
 }
 
+#elif defined(CONFIG_WDOG_WHEEL)
+void wd_timer(void)
+{
+  FAR struct wdog_s *wdog;
+#ifdef CONFIG_SMP
+  irqstate_t flags;
+
+  /* In the SMP case, interrupts may be disabled only on the local CPU.
+   * The rules for critical sections must be followed here, too.
+   */
+
+  flags = enter_critical_section();
+#endif
+
+  /* Advance the timing wheel by one tick and execute each watchdog that
+   * expires on this tick.
+   */
+
+  wd_wheel_tick();
+
+  while ((wdog = wd_wheel_expired()) != NULL)
+    {
+      /* Indicate that the watchdog is no longer active. */
+
+      WDOG_CLRACTIVE(wdog);
+
+      /* Execute the watchdog function */
+
+      wd_expire(wdog);
+    }
+
+#ifdef CONFIG_SMP
+  leave_critical_section(flags);
+#endif
+}
+
 #else
 void wd_timer(void)
 {
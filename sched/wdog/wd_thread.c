@@ -0,0 +1,210 @@
+/****************************************************************************
+ * sched/wdog/wd_thread.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <sched.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/irq.h>
+#include <nuttx/kthread.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_THREAD
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The expired watchdogs that wait for the watchdog thread, in the order of
+ * their expiration.
+ */
+
+static sq_queue_t g_wdpendlist;
+
+/* Posted when the first watchdog is added to an empty g_wdpendlist */
+
+static sem_t g_wdsem = SEM_INITIALIZER(0);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_thread
+ *
+ * Description:
+ *   The watchdog thread.  It executes the functions of the expired
+ *   watchdogs that are not marked WDOGF_HARDIRQ.
+ *
+ ****************************************************************************/
+
+static int wd_thread(int argc, FAR char *argv[])
+{
+  FAR struct wdog_s *wdog;
+  struct wdog_s expired;
+  irqstate_t flags;
+
+  for (; ; )
+    {
+      nxsem_wait_uninterruptible(&g_wdsem);
+
+      /* Execute all watchdogs that expired since the last time as one
+       * batch.  The tasks that they make ready to run are not switched to
+       * before the end of the batch.
+       */
+
+      sched_lock();
+      flags = enter_critical_section();
+
+      while ((wdog = (FAR struct wdog_s *)sq_remfirst(&g_wdpendlist)) !=
+             NULL)
+        {
+          wdog->next = NULL;
+          WDOG_CLRPENDING(wdog);
+
+          /* The watchdog may be restarted, cancelled or deleted as soon as
+           * the critical section is left.  Execute a copy of it.
+           */
+
+          memcpy(&expired, wdog, sizeof(struct wdog_s));
+          leave_critical_section(flags);
+
+          wd_dispatch(&expired);
+
+          flags = enter_critical_section();
+        }
+
+      leave_critical_section(flags);
+      sched_unlock();
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_thread_start
+ *
+ * Description:
+ *   Start the watchdog thread.  Watchdogs that expire before the thread is
+ *   started are executed when it starts.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int wd_thread_start(void)
+{
+  pid_t pid;
+
+  pid = kthread_create("wdog", CONFIG_WDOG_THREAD_PRIORITY,
+                       CONFIG_WDOG_THREAD_STACKSIZE,
+                       (main_t)wd_thread, (FAR char * const *)NULL);
+  if (pid < 0)
+    {
+      serr("ERROR: kthread_create failed: %d\n", (int)pid);
+      return (int)pid;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: wd_defer
+ *
+ * Description:
+ *   Pass an expired watchdog to the watchdog thread.  The watchdog has
+ *   already been removed from the active watchdogs and marked inactive.
+ *
+ * Input Parameters:
+ *   wdog - The expired watchdog
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called from the timer interrupt in the critical section.
+ *
+ ****************************************************************************/
+
+void wd_defer(FAR struct wdog_s *wdog)
+{
+  bool idle = sq_empty(&g_wdpendlist);
+
+  sq_addlast((FAR sq_entry_t *)wdog, &g_wdpendlist);
+  WDOG_SETPENDING(wdog);
+
+  /* The thread empties the whole list each time that it wakes up, so it
+   * needs to be woken up only once per batch.
+   */
+
+  if (idle)
+    {
+      nxsem_post(&g_wdsem);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_undefer
+ *
+ * Description:
+ *   Remove an expired watchdog that has not been executed yet from the
+ *   queue of the watchdog thread.
+ *
+ * Input Parameters:
+ *   wdog - The watchdog marked WDOGF_PENDING
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Called in the critical section.
+ *
+ ****************************************************************************/
+
+void wd_undefer(FAR struct wdog_s *wdog)
+{
+  DEBUGASSERT(WDOG_ISPENDING(wdog));
+
+  sq_rem((FAR sq_entry_t *)wdog, &g_wdpendlist);
+  wdog->next = NULL;
+  WDOG_CLRPENDING(wdog);
+}
+
+#endif /* CONFIG_WDOG_THREAD */
@@ -0,0 +1,333 @@
+/****************************************************************************
+ * sched/wdog/wd_wheel.c
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+
+#include <nuttx/list.h>
+#include <nuttx/wdog.h>
+
+#include "wdog/wdog.h"
+
+#ifdef CONFIG_WDOG_WHEEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WDOG_WHEEL_BITS    CONFIG_WDOG_WHEEL_BITS
+#define WDOG_WHEEL_LEVELS  CONFIG_WDOG_WHEEL_LEVELS
+#define WDOG_WHEEL_SLOTS   (1 << WDOG_WHEEL_BITS)
+#define WDOG_WHEEL_MASK    (WDOG_WHEEL_SLOTS - 1)
+
+#if WDOG_WHEEL_BITS * WDOG_WHEEL_LEVELS > 32
+#  error CONFIG_WDOG_WHEEL_BITS * CONFIG_WDOG_WHEEL_LEVELS exceeds 32
+#endif
+
+/* The slot index of 'tick' on a level */
+
+#define WDOG_WHEEL_INDEX(tick, level) \
+  (((tick) >> (WDOG_WHEEL_BITS * (level))) & WDOG_WHEEL_MASK)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Level 0 of the wheel has one slot for each of the next
+ * WDOG_WHEEL_SLOTS ticks.  Each slot of level n covers WDOG_WHEEL_SLOTS^n
+ * ticks.  The lag field of a watchdog in the wheel holds its absolute
+ * expiration tick.
+ */
+
+static struct list_node g_wdwheel[WDOG_WHEEL_LEVELS][WDOG_WHEEL_SLOTS];
+
+/* The tick count of the wheel.  This is advanced by each wd_timer() */
+
+static uint32_t g_wdnow;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   Put a watchdog in the slot that holds its expiration tick on the lowest
+ *   level that covers it.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_insert(FAR struct wdog_s *wdog)
+{
+  uint32_t expires = (uint32_t)wdog->lag;
+  uint32_t delta = expires - g_wdnow;
+  int level = 0;
+
+  while (level < WDOG_WHEEL_LEVELS - 1 &&
+         (delta >> (WDOG_WHEEL_BITS * (level + 1))) != 0)
+    {
+      level++;
+    }
+
+#if WDOG_WHEEL_BITS * WDOG_WHEEL_LEVELS < 32
+  /* A delay beyond the range of the wheel is parked in the last slot that
+   * the top level can reach.  It will be reinserted when that slot is
+   * cascaded.
+   */
+
+  if ((delta >> (WDOG_WHEEL_BITS * WDOG_WHEEL_LEVELS)) != 0)
+    {
+      expires = g_wdnow +
+                ((uint32_t)1 << (WDOG_WHEEL_BITS * WDOG_WHEEL_LEVELS)) - 1;
+    }
+#endif
+
+  list_add_tail(&g_wdwheel[level][WDOG_WHEEL_INDEX(expires, level)],
+                &wdog->node);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Move the watchdogs of one slot of a higher level down to the lower
+ *   levels.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(FAR struct list_node *slot)
+{
+  FAR struct list_node *node;
+  struct list_node pending;
+
+  if (list_is_empty(slot))
+    {
+      return;
+    }
+
+  /* Detach the whole slot first:  Watchdogs beyond the range of the wheel
+   * may be reinserted in the same slot.
+   */
+
+  pending.next       = slot->next;
+  pending.prev       = slot->prev;
+  pending.next->prev = &pending;
+  pending.prev->next = &pending;
+  list_initialize(slot);
+
+  while ((node = list_remove_head(&pending)) != NULL)
+    {
+      wd_wheel_insert(container_of(node, struct wdog_s, node));
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ *
+ * Description:
+ *   Initialize the timing wheel to the empty state.
+ *
+ ****************************************************************************/
+
+void wd_wheel_initialize(void)
+{
+  int level;
+  int slot;
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      for (slot = 0; slot < WDOG_WHEEL_SLOTS; slot++)
+        {
+          list_initialize(&g_wdwheel[level][slot]);
+        }
+    }
+
+  g_wdnow = 0;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_add
+ *
+ * Description:
+ *   Add a watchdog to the timing wheel so that it expires after 'delay'
+ *   ticks.  This takes constant time.
+ *
+ * Assumptions:
+ *   Called in the critical section.  The delay is at least one tick.
+ *
+ ****************************************************************************/
+
+void wd_wheel_add(FAR struct wdog_s *wdog, int32_t delay)
+{
+  DEBUGASSERT(delay > 0);
+
+  wdog->lag = (int)(g_wdnow + (uint32_t)delay);
+  wd_wheel_insert(wdog);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove a watchdog from the timing wheel.  This takes constant time.
+ *
+ * Assumptions:
+ *   Called in the critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+  list_delete(&wdog->node);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remaining
+ *
+ * Description:
+ *   Return the number of ticks remaining before a watchdog in the wheel
+ *   expires.
+ *
+ ****************************************************************************/
+
+int wd_wheel_remaining(FAR struct wdog_s *wdog)
+{
+  return (int)((uint32_t)wdog->lag - g_wdnow);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_tick
+ *
+ * Description:
+ *   Advance the timing wheel by one tick.  When a level wraps around, the
+ *   watchdogs of the current slot of the next level are cascaded down.
+ *
+ * Assumptions:
+ *   Called from the timer interrupt in the critical section.
+ *
+ ****************************************************************************/
+
+void wd_wheel_tick(void)
+{
+  uint32_t now = ++g_wdnow;
+  int level;
+
+  for (level = 1;
+       level < WDOG_WHEEL_LEVELS && WDOG_WHEEL_INDEX(now, level - 1) == 0;
+       level++)
+    {
+      wd_wheel_cascade(&g_wdwheel[level][WDOG_WHEEL_INDEX(now, level)]);
+    }
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expired
+ *
+ * Description:
+ *   Remove and return the next watchdog that expires on the current tick.
+ *
+ * Returned Value:
+ *   The expired watchdog or NULL if there are no more.
+ *
+ * Assumptions:
+ *   Called from the timer interrupt in the critical section.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expired(void)
+{
+  FAR struct list_node *node;
+  FAR struct wdog_s *wdog;
+
+  node = list_remove_head(&g_wdwheel[0][WDOG_WHEEL_INDEX(g_wdnow, 0)]);
+  if (node == NULL)
+    {
+      return NULL;
+    }
+
+  wdog = container_of(node, struct wdog_s, node);
+  DEBUGASSERT(wd_wheel_remaining(wdog) == 0);
+  return wdog;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the number of ticks until the first watchdog in the wheel
+ *   expires.  The slots of each level are visited in the order of their
+ *   expiration after the current tick, so only the first non-empty slot
+ *   of each level has to be searched.
+ *
+ * Returned Value:
+ *   The ticks until the next expiration or INT_MAX if the wheel is empty.
+ *
+ * Assumptions:
+ *   Called in the critical section.
+ *
+ ****************************************************************************/
+
+int wd_wheel_next(void)
+{
+  FAR struct list_node *slot;
+  FAR struct wdog_s *wdog;
+  uint32_t next = INT_MAX;
+  uint32_t remaining;
+  int level;
+  int i;
+
+  for (level = 0; level < WDOG_WHEEL_LEVELS; level++)
+    {
+      for (i = 1; i <= WDOG_WHEEL_SLOTS; i++)
+        {
+          slot = &g_wdwheel[level][(WDOG_WHEEL_INDEX(g_wdnow, level) + i) &
+                                   WDOG_WHEEL_MASK];
+          if (!list_is_empty(slot))
+            {
+              list_for_every_entry(slot, wdog, struct wdog_s, node)
+                {
+                  remaining = (uint32_t)wdog->lag - g_wdnow;
+                  if (remaining < next)
+                    {
+                      next = remaining;
+                    }
+                }
+
+              break;
+            }
+        }
+    }
+
+  return (int)next;
+}
+
+#endif /* CONFIG_WDOG_WHEEL */
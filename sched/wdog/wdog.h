@@ -75,10 +75,13 @@ extern sq_queue_t g_wdfreelist;
 
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
- * this linked list are removed and the function is called.
+ * this linked list are removed and the function is called.  It is not
+ * used if the active watchdogs are kept in a timing wheel.
  */
 
+#ifndef CONFIG_WDOG_WHEEL
 extern sq_queue_t g_wdactivelist;
+#endif
 
 /* This is the number of free, pre-allocated watchdog structures in the
  * g_wdfreelist.  This value is used to enforce a reserve for interrupt
@@ -151,6 +154,43 @@ unsigned int wd_timer(int ticks);
 void wd_timer(void);
 #endif
 
+/****************************************************************************
+ * Name: wd_dispatch
+ *
+ * Description:
+ *   Execute the function of an expired watchdog.  The watchdog has already
+ *   been removed from the active watchdogs and marked inactive.
+ *
+ * Input Parameters:
+ *   wdog - The expired watchdog
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void wd_dispatch(FAR struct wdog_s *wdog);
+
+/****************************************************************************
+ * Name: wd_thread_start, wd_defer, wd_undefer
+ *
+ * Description:
+ *   Support for executing the watchdog functions in the watchdog thread
+ *   (see wd_thread.c).  wd_defer() and wd_undefer() must be called in the
+ *   critical section.
+ *
+ *   wd_thread_start - Start the watchdog thread
+ *   wd_defer        - Pass an expired watchdog to the watchdog thread
+ *   wd_undefer      - Withdraw an expired watchdog that has not run yet
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_THREAD
+int  wd_thread_start(void);
+void wd_defer(FAR struct wdog_s *wdog);
+void wd_undefer(FAR struct wdog_s *wdog);
+#endif
+
 /****************************************************************************
  * Name: wd_recover
  *
@@ -173,6 +213,34 @@ void wd_timer(void);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+/****************************************************************************
+ * Name: wd_wheel_*
+ *
+ * Description:
+ *   Timing wheel support for the active watchdogs (see wd_wheel.c).  All of
+ *   these must be called in the critical section.
+ *
+ *   wd_wheel_initialize - Initialize the empty wheel
+ *   wd_wheel_add        - Add a watchdog that expires after 'delay' ticks
+ *   wd_wheel_remove     - Remove a watchdog from the wheel
+ *   wd_wheel_remaining  - Return the ticks until the watchdog expires
+ *   wd_wheel_tick       - Advance the wheel by one tick
+ *   wd_wheel_expired    - Remove and return the next watchdog that expires
+ *                         on the current tick, or NULL
+ *   wd_wheel_next       - Return the ticks until the first watchdog expires
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_WHEEL
+void wd_wheel_initialize(void);
+void wd_wheel_add(FAR struct wdog_s *wdog, int32_t delay);
+void wd_wheel_remove(FAR struct wdog_s *wdog);
+int  wd_wheel_remaining(FAR struct wdog_s *wdog);
+void wd_wheel_tick(void);
+FAR struct wdog_s *wd_wheel_expired(void);
+int  wd_wheel_next(void);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
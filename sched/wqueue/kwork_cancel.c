@@ -64,6 +64,7 @@
 static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
                         FAR struct work_s *work)
 {
+  FAR struct dq_queue_s *q = &wqueue->q;
   irqstate_t flags;
   int ret = -ENOENT;
 
@@ -77,18 +78,27 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue,
   flags = enter_critical_section();
   if (work->worker != NULL)
     {
+#ifdef CONFIG_SCHED_LPWORKSTEAL
+      /* Low-priority work is in the list of one of the worker threads */
+
+      if (wqueue == (FAR struct kwork_wqueue_s *)&g_lpwork)
+        {
+          q = work->wq;
+        }
+#endif
+
       /* A little test of the integrity of the work queue */
 
       DEBUGASSERT(work->dq.flink != NULL ||
-                  (FAR dq_entry_t *)work == wqueue->q.tail);
+                  (FAR dq_entry_t *)work == q->tail);
       DEBUGASSERT(work->dq.blink != NULL ||
-                  (FAR dq_entry_t *)work == wqueue->q.head);
+                  (FAR dq_entry_t *)work == q->head);
 
       /* Remove the entry from the work queue and make sure that it is
        * marked as available (i.e., the worker field is nullified).
        */
 
-      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+      dq_rem((FAR dq_entry_t *)work, q);
       work->worker = NULL;
       ret = OK;
     }
@@ -104,7 +104,11 @@ static int work_lpthread(int argc, char *argv[])
        * triggered, or delayed work expires.
        */
 
+#ifdef CONFIG_SCHED_LPWORKSTEAL
+      work_lpprocess(&g_lpwork, wndx);
+#else
       work_process((FAR struct kwork_wqueue_s *)&g_lpwork, wndx);
+#endif
     }
 
   return OK; /* To keep some compilers happy */
@@ -131,6 +135,9 @@ static int work_lpthread(int argc, char *argv[])
 
 int work_lpstart(void)
 {
+#ifdef CONFIG_SCHED_LPWORKSTEAL
+  cpu_set_t cpuset;
+#endif
   pid_t pid;
   int wndx;
 
@@ -161,6 +168,14 @@ int work_lpstart(void)
 
       g_lpwork.worker[wndx].pid  = pid;
       g_lpwork.worker[wndx].busy = true;
+
+#ifdef CONFIG_SCHED_LPWORKSTEAL
+      /* Each worker thread serves the work queued on its own CPU */
+
+      CPU_ZERO(&cpuset);
+      CPU_SET(wndx % CONFIG_SMP_NCPUS, &cpuset);
+      nxsched_set_affinity(pid, sizeof(cpu_set_t), &cpuset);
+#endif
     }
 
   sched_unlock();
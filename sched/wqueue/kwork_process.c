@@ -34,6 +34,7 @@
 #include <nuttx/clock.h>
 #include <nuttx/signal.h>
 #include <nuttx/wqueue.h>
+#include <nuttx/sched_note.h>
 
 #include "wqueue/wqueue.h"
 
@@ -64,55 +65,43 @@
 #endif
 
 /****************************************************************************
- * Public Functions
+ * Private Functions
  ****************************************************************************/
 
 /****************************************************************************
- * Name: work_process
+ * Name: work_ready
  *
  * Description:
- *   This is the logic that performs actions placed on any work list.  This
- *   logic is the common underlying logic to all work queues.  This logic is
- *   part of the internal implementation of each work queue; it should not
- *   be called from application level logic.
+ *   Take the work that is ready to execute from the head of a work list.
+ *   The list is sorted by the time when the work is ready (see
+ *   work_insert()), so the search stops at the first work that is not
+ *   ready.  Work that was cancelled while it was still in the list is
+ *   discarded.
  *
  * Input Parameters:
- *   wqueue - Describes the work queue to be processed
+ *   q     - The work list to search
+ *   stick - The time that processing of the list started
+ *   next  - The location of the time to the next scheduled wakeup.  This is
+ *           reduced if work in the list will be ready before then.
  *
  * Returned Value:
- *   None
+ *   The work that is ready or NULL if no work in the list is ready.
+ *
+ * Assumptions:
+ *   Called in the critical section.
  *
  ****************************************************************************/
 
-void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
+static FAR struct work_s *work_ready(FAR struct dq_queue_s *q, clock_t stick,
+                                     FAR clock_t *next)
 {
-  volatile FAR struct work_s *work;
-  worker_t  worker;
-  irqstate_t flags;
-  FAR void *arg;
+  FAR struct work_s *work;
+  FAR struct work_s *flink;
   clock_t elapsed;
   clock_t remaining;
-  clock_t stick;
   clock_t ctick;
-  clock_t next;
-
-  /* Then process queued work.  We need to keep interrupts disabled while
-   * we process items in the work list.
-   */
-
-  next  = WORK_DELAY_MAX;
-  flags = enter_critical_section();
-
-  /* Get the time that we started processing the queue in clock ticks. */
 
-  stick = clock_systime_ticks();
-
-  /* And check each entry in the work queue.  Since we have disabled
-   * interrupts we know:  (1) we will not be suspended unless we do
-   * so ourselves, and (2) there will be no changes to the work queue
-   */
-
-  work = (FAR struct work_s *)wqueue->q.head;
+  work = (FAR struct work_s *)q->head;
   while (work != NULL)
     {
       /* Is this work ready?  It is ready if there is no delay or if
@@ -123,55 +112,27 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
 
       ctick   = clock_systime_ticks();
       elapsed = ctick - work->qtime;
+      flink   = (FAR struct work_s *)work->dq.flink;
       if (elapsed >= work->delay)
         {
           /* Remove the ready-to-execute work from the list */
 
-          dq_rem((struct dq_entry_s *)work, &wqueue->q);
-
-          /* Extract the work description from the entry (in case the work
-           * instance by the re-used after it has been de-queued).
-           */
-
-          worker = work->worker;
+          dq_rem((struct dq_entry_s *)work, q);
 
           /* Check for a race condition where the work may be nullified
            * before it is removed from the queue.
            */
 
-          if (worker != NULL)
+          if (work->worker != NULL)
             {
-              /* Extract the work argument (before re-enabling interrupts) */
-
-              arg = work->arg;
-
-              /* Mark the work as no longer being queued */
-
-              work->worker = NULL;
-
-              /* Do the work.  Re-enable interrupts while the work is being
-               * performed... we don't have any idea how long this will take!
-               */
-
-              leave_critical_section(flags);
-              worker(arg);
-
-              /* Now, unfortunately, since we re-enabled interrupts we don't
-               * know the state of the work list and we will have to start
-               * back at the head of the list.
-               */
-
-              flags = enter_critical_section();
-              work  = (FAR struct work_s *)wqueue->q.head;
+              return work;
             }
-          else
-            {
-              /* Cancelled.. Just move to the next work in the list with
-               * interrupts still disabled.
-               */
 
-              work = (FAR struct work_s *)work->dq.flink;
-            }
+          /* Cancelled.. Just move to the next work in the list with
+           * interrupts still disabled.
+           */
+
+          work = flink;
         }
       else /* elapsed < work->delay */
         {
@@ -193,29 +154,88 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
           /* Will it be ready before the next scheduled wakeup interval? */
 
           remaining = work->delay - elapsed;
-          if (remaining < next)
+          if (remaining < *next)
             {
               /* Yes.. Then schedule to wake up when the work is ready */
 
-              next = remaining;
+              *next = remaining;
             }
 
-          /* Then try the next in the list. */
+          /* The rest of the list will not be ready earlier */
 
-          work = (FAR struct work_s *)work->dq.flink;
+          break;
         }
     }
 
-  /* When multiple worker threads are created for this work queue, only
-   * thread 0 (wndx = 0) will monitor the unexpired works.
-   *
-   * Other worker threads (wndx > 0) just process no-delay or expired
-   * works, then sleep. The unexpired works are left in the queue. They
-   * will be handled by thread 0 when it finishes current work and iterate
-   * over the queue again.
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: work_run
+ *
+ * Description:
+ *   Perform work that was removed from its work list.  The critical section
+ *   is left while the work is performed.
+ *
+ * Input Parameters:
+ *   work  - The work to perform
+ *   flags - The state returned when the critical section was entered
+ *
+ * Returned Value:
+ *   The state returned when the critical section was re-entered.
+ *
+ ****************************************************************************/
+
+static irqstate_t work_run(FAR struct work_s *work, irqstate_t flags)
+{
+  worker_t worker;
+  FAR void *arg;
+
+  /* Extract the work description from the entry (in case the work
+   * instance by the re-used after it has been de-queued).
+   */
+
+  worker = work->worker;
+  arg    = work->arg;
+
+  /* Mark the work as no longer being queued */
+
+  work->worker = NULL;
+
+  /* Do the work.  Re-enable interrupts while the work is being
+   * performed... we don't have any idea how long this will take!
    */
 
-  if (wndx > 0 || next == WORK_DELAY_MAX)
+  leave_critical_section(flags);
+
+  sched_trace_begin(NOTE_TRACE_WQUEUE, worker);
+  worker(arg);
+  sched_trace_end(NOTE_TRACE_WQUEUE, worker);
+
+  return enter_critical_section();
+}
+
+/****************************************************************************
+ * Name: work_wait
+ *
+ * Description:
+ *   Wait until the worker thread is signalled or until the next delayed
+ *   work is ready.
+ *
+ * Input Parameters:
+ *   kworker - The worker thread
+ *   next    - The time to the next delayed work or WORK_DELAY_MAX to wait
+ *             until signalled.
+ *
+ * Assumptions:
+ *   Called in the critical section.  Interrupts will be re-enabled while
+ *   we wait.
+ *
+ ****************************************************************************/
+
+static void work_wait(FAR struct kworker_s *kworker, clock_t next)
+{
+  if (next == WORK_DELAY_MAX)
     {
       sigset_t set;
 
@@ -224,23 +244,159 @@ void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
       sigemptyset(&set);
       nxsig_addset(&set, SIGWORK);
 
-      wqueue->worker[wndx].busy = false;
+      kworker->busy = false;
       DEBUGVERIFY(nxsig_waitinfo(&set, NULL));
-      wqueue->worker[wndx].busy = true;
+      kworker->busy = true;
     }
   else
     {
       /* Wait a while to check the work list.  We will wait here until
        * either the time elapses or until we are awakened by a signal.
-       * Interrupts will be re-enabled while we wait.
        */
 
-      wqueue->worker[wndx].busy = false;
+      kworker->busy = false;
       nxsig_usleep(next * USEC_PER_TICK);
-      wqueue->worker[wndx].busy = true;
+      kworker->busy = true;
     }
+}
 
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_process
+ *
+ * Description:
+ *   This is the logic that performs actions placed on any work list.  This
+ *   logic is the common underlying logic to all work queues.  This logic is
+ *   part of the internal implementation of each work queue; it should not
+ *   be called from application level logic.
+ *
+ * Input Parameters:
+ *   wqueue - Describes the work queue to be processed
+ *   wndx   - The worker thread index
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx)
+{
+  FAR struct work_s *work;
+  irqstate_t flags;
+  clock_t stick;
+  clock_t next;
+
+  /* Then process queued work.  We need to keep interrupts disabled while
+   * we process items in the work list.
+   */
+
+  next  = WORK_DELAY_MAX;
+  flags = enter_critical_section();
+
+  /* Get the time that we started processing the queue in clock ticks. */
+
+  stick = clock_systime_ticks();
+
+  /* And perform each entry in the work queue that is ready.  Since we have
+   * disabled interrupts we know:  (1) we will not be suspended unless we do
+   * so ourselves, and (2) there will be no changes to the work queue.
+   * Since interrupts are re-enabled while the work is performed, we don't
+   * know the state of the work list after that and we will have to start
+   * back at the head of the list.
+   */
+
+  while ((work = work_ready(&wqueue->q, stick, &next)) != NULL)
+    {
+      flags = work_run(work, flags);
+    }
+
+  /* When multiple worker threads are created for this work queue, only
+   * thread 0 (wndx = 0) will monitor the unexpired works.
+   *
+   * Other worker threads (wndx > 0) just process no-delay or expired
+   * works, then sleep. The unexpired works are left in the queue. They
+   * will be handled by thread 0 when it finishes current work and iterate
+   * over the queue again.
+   */
+
+  work_wait(&wqueue->worker[wndx], wndx > 0 ? WORK_DELAY_MAX : next);
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: work_lpprocess
+ *
+ * Description:
+ *   This is the work processing logic of the low-priority worker threads
+ *   when each has its own work list.  A worker thread performs the ready
+ *   work in its own list first.  When there is none, it takes ready work
+ *   from the lists of the other worker threads (which may be busy with long
+ *   running work) before it sleeps.  Each worker thread monitors the
+ *   delayed work in its own list.
+ *
+ * Input Parameters:
+ *   wqueue - Describes the low-priority work queue
+ *   wndx   - The worker thread index
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LPWORKSTEAL
+void work_lpprocess(FAR struct lp_wqueue_s *wqueue, int wndx)
+{
+  FAR struct work_s *work;
+  irqstate_t flags;
+  clock_t stick;
+  clock_t next;
+  clock_t skip;
+  int i;
+
+  next  = WORK_DELAY_MAX;
+  flags = enter_critical_section();
+  stick = clock_systime_ticks();
+
+  for (; ; )
+    {
+      /* Perform the ready work in our own list */
+
+      while ((work = work_ready(&wqueue->wq[wndx], stick, &next)) != NULL)
+        {
+          flags = work_run(work, flags);
+        }
+
+      /* Then look for ready work in the lists of the other workers,
+       * starting with the next one.  The delayed work of the other lists
+       * is left to their owners.
+       */
+
+      for (i = 1, work = NULL; i < CONFIG_SCHED_LPNTHREADS; i++)
+        {
+          skip = WORK_DELAY_MAX;
+          work = work_ready(&wqueue->wq[(wndx + i) %
+                                        CONFIG_SCHED_LPNTHREADS],
+                            stick, &skip);
+          if (work != NULL)
+            {
+              break;
+            }
+        }
+
+      if (work == NULL)
+        {
+          break;
+        }
+
+      flags = work_run(work, flags);
+    }
+
+  work_wait(&wqueue->worker[wndx], next);
   leave_critical_section(flags);
 }
+#endif
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
@@ -32,6 +32,7 @@
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/clock.h>
+#include <nuttx/signal.h>
 #include <nuttx/wqueue.h>
 
 #include "wqueue/wqueue.h"
@@ -42,6 +43,76 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_remaining
+ *
+ * Description:
+ *   Return the time until queued work is ready, zero if it is ready.
+ *
+ ****************************************************************************/
+
+static clock_t work_remaining(FAR struct work_s *work, clock_t now)
+{
+  clock_t elapsed = now - work->qtime;
+
+  return elapsed >= work->delay ? 0 : work->delay - elapsed;
+}
+
+/****************************************************************************
+ * Name: work_insert
+ *
+ * Description:
+ *   Add time-tagged work to a work list.  The list is kept sorted by the
+ *   time when the work is ready (work that is ready at the same time stays
+ *   in FIFO order), so the worker thread finds the ready work and the time
+ *   to its next wakeup at the head of the list instead of visiting every
+ *   delayed work on each pass.
+ *
+ *   Immediate work is placed after the ready work, which is found from the
+ *   head of the list.  Delayed work is usually the last to be ready, so its
+ *   place is searched from the tail.
+ *
+ * Assumptions:
+ *   Called in the critical section.
+ *
+ ****************************************************************************/
+
+static void work_insert(FAR struct dq_queue_s *q, FAR struct work_s *work)
+{
+  FAR struct work_s *curr;
+
+  if (work->delay == 0)
+    {
+      for (curr = (FAR struct work_s *)q->head;
+           curr != NULL && work_remaining(curr, work->qtime) == 0;
+           curr = (FAR struct work_s *)curr->dq.flink);
+
+      if (curr == NULL)
+        {
+          dq_addlast((FAR dq_entry_t *)work, q);
+        }
+      else
+        {
+          dq_addbefore((FAR dq_entry_t *)curr, (FAR dq_entry_t *)work, q);
+        }
+    }
+  else
+    {
+      for (curr = (FAR struct work_s *)q->tail;
+           curr != NULL && work_remaining(curr, work->qtime) > work->delay;
+           curr = (FAR struct work_s *)curr->dq.blink);
+
+      if (curr == NULL)
+        {
+          dq_addfirst((FAR dq_entry_t *)work, q);
+        }
+      else
+        {
+          dq_addafter((FAR dq_entry_t *)curr, (FAR dq_entry_t *)work, q);
+        }
+    }
+}
+
 /****************************************************************************
  * Name: work_qqueue
  *
@@ -89,8 +160,8 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
 
   if (work->worker != NULL)
     {
-      /* Remove the entry from the work queue.  It will re requeued at the
-       * end of the work queue.
+      /* Remove the entry from the work queue.  It will re requeued
+       * according to its new delay.
        */
 
       dq_rem((FAR dq_entry_t *)work, &wqueue->q);
@@ -106,10 +177,80 @@ static void work_qqueue(FAR struct kwork_wqueue_s *wqueue,
 
   work->qtime  = clock_systime_ticks(); /* Time work queued */
 
-  dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+  work_insert(&wqueue->q, work);
+
+  leave_critical_section(flags);
+}
+
+/****************************************************************************
+ * Name: work_lpqueue
+ *
+ * Description:
+ *   Queue work on the low-priority work queue when each worker thread has
+ *   its own work list.  The work is added to the list of the worker thread
+ *   that runs on the current CPU and that worker is signalled if it is
+ *   idle.  Otherwise, any idle worker is signalled to take the work.
+ *
+ * Input Parameters:
+ *   work   - The work structure to queue
+ *   worker - The worker callback to be invoked.  The callback will invoked
+ *            on the worker thread of execution.
+ *   arg    - The argument that will be passed to the workder callback when
+ *            int is invoked.
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LPWORKSTEAL
+static int work_lpqueue(FAR struct work_s *work, worker_t worker,
+                        FAR void *arg, clock_t delay)
+{
+  FAR struct kworker_s *kworker;
+  irqstate_t flags;
+  int wndx;
+
+  DEBUGASSERT(work != NULL && worker != NULL);
+
+  flags = enter_critical_section();
+
+  /* Is there already pending work?  It may be in the list of any worker */
+
+  if (work->worker != NULL)
+    {
+      dq_rem((FAR dq_entry_t *)work, work->wq);
+    }
+
+  /* Initialize the work structure. */
+
+  wndx         = up_cpu_index() % CONFIG_SCHED_LPNTHREADS;
+  work->worker = worker;           /* Work callback. non-NULL means queued */
+  work->arg    = arg;              /* Callback argument */
+  work->delay  = delay;            /* Delay until work performed */
+  work->wq     = &g_lpwork.wq[wndx];
+
+  /* Now, time-tag that entry and put it in the work list of this CPU */
+
+  work->qtime  = clock_systime_ticks(); /* Time work queued */
+
+  work_insert(work->wq, work);
 
   leave_critical_section(flags);
+
+  /* Wake up the worker of this CPU if it is idle */
+
+  kworker = &g_lpwork.worker[wndx];
+  if (!kworker->busy)
+    {
+      return nxsig_kill(kworker->pid, SIGWORK);
+    }
+
+  return work_signal(LPWORK);
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -166,9 +307,13 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
     {
       /* Queue low priority work */
 
+#ifdef CONFIG_SCHED_LPWORKSTEAL
+      return work_lpqueue(work, worker, arg, delay);
+#else
       work_qqueue((FAR struct kwork_wqueue_s *)&g_lpwork, work, worker,
                   arg, delay);
       return work_signal(LPWORK);
+#endif
     }
   else
 #endif
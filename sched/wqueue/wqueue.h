@@ -90,6 +90,12 @@ struct lp_wqueue_s
   /* Describes each thread in the low priority queue's thread pool */
 
   struct kworker_s  worker[CONFIG_SCHED_LPNTHREADS];
+
+#ifdef CONFIG_SCHED_LPWORKSTEAL
+  /* The work list of each worker thread.  q is not used in this case. */
+
+  struct dq_queue_s wq[CONFIG_SCHED_LPNTHREADS];
+#endif
 };
 #endif
 
@@ -171,6 +177,28 @@ int work_lpstart(void);
 
 void work_process(FAR struct kwork_wqueue_s *wqueue, int wndx);
 
+/****************************************************************************
+ * Name: work_lpprocess
+ *
+ * Description:
+ *   This is the logic that performs the actions placed on the per-worker
+ *   lists of the low-priority work queue.  Ready work is taken from the
+ *   lists of the other worker threads when there is none in the worker's
+ *   own list.
+ *
+ * Input Parameters:
+ *   wqueue - Describes the low-priority work queue
+ *   wndx   - The worker thread index
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_LPWORKSTEAL
+void work_lpprocess(FAR struct lp_wqueue_s *wqueue, int wndx);
+#endif
+
 /****************************************************************************
  * Name: work_notifier_initialize
  *
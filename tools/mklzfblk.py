@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+############################################################################
+# tools/mklzfblk.py
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+############################################################################
+
+"""Make an LZF block image for the lzfblk driver (CONFIG_MTD_LZFBLK).
+
+The input is an image of any file system, for example one made with
+genromfs or mkfs.vfat.  It is split into blocks that are compressed
+separately (see drivers/mtd/lzfblk.c for the format).  The output is
+written to the MTD device that lzfblk_initialize() is given.
+
+Usage: mklzfblk.py [-b <block-size>] <input> <output>
+"""
+
+import argparse
+import struct
+import sys
+
+LZFBLK_MAGIC = b"LZFB"
+LZFBLK_VERSION = 1
+
+LZF_TYPE0_HDR = 0
+LZF_TYPE1_HDR = 1
+
+MAX_LIT = 1 << 5
+MAX_OFF = 1 << 13
+MAX_REF = (1 << 8) + (1 << 3)
+
+
+def lzf_compress(data):
+    """Return the LZF compressed form of data (without a block header)."""
+
+    out = bytearray()
+    table = {}
+    lit = bytearray()
+    pos = 0
+    end = len(data)
+
+    def flush_literals():
+        for i in range(0, len(lit), MAX_LIT):
+            run = lit[i:i + MAX_LIT]
+            out.append(len(run) - 1)
+            out.extend(run)
+        del lit[:]
+
+    while pos < end - 2:
+        key = data[pos:pos + 3]
+        ref = table.get(key)
+        table[key] = pos
+
+        if ref is not None and pos - ref - 1 < MAX_OFF:
+            maxlen = min(end - pos, MAX_REF)
+            length = 3
+            while length < maxlen and data[ref + length] == data[pos + length]:
+                length += 1
+
+            flush_literals()
+
+            off = pos - ref - 1
+            code = length - 2
+            if code < 7:
+                out.append((code << 5) | (off >> 8))
+            else:
+                out.append((7 << 5) | (off >> 8))
+                out.append(code - 7)
+            out.append(off & 0xFF)
+
+            for i in range(pos + 1, min(pos + length, end - 2)):
+                table[data[i:i + 3]] = i
+            pos += length
+        else:
+            lit.append(data[pos])
+            pos += 1
+
+    lit.extend(data[pos:])
+    flush_literals()
+    return bytes(out)
+
+
+def lzf_block(data):
+    """Return one LZF block with its header, uncompressed if that is
+    smaller."""
+
+    cdata = lzf_compress(data)
+    if len(cdata) < len(data):
+        return struct.pack(">2sBHH", b"ZV", LZF_TYPE1_HDR,
+                           len(cdata), len(data)) + cdata
+    return struct.pack(">2sBH", b"ZV", LZF_TYPE0_HDR, len(data)) + data
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Make an LZF block image for the NuttX lzfblk driver")
+    parser.add_argument("input", help="The uncompressed image")
+    parser.add_argument("output", help="The LZF block image")
+    parser.add_argument("-b", "--block-size", type=int, default=4096,
+                        help="The uncompressed block size, a power of two "
+                             "from 512 to 32768 (default: 4096)")
+    args = parser.parse_args()
+
+    bsize = args.block_size
+    bshift = bsize.bit_length() - 1
+    if bsize != 1 << bshift or not 9 <= bshift <= 15:
+        sys.exit("ERROR: Bad block size %d" % bsize)
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    # The driver only knows whole blocks, so pad the last one.
+
+    if len(data) % bsize:
+        data += bytes(bsize - len(data) % bsize)
+
+    nblocks = len(data) // bsize
+    if nblocks == 0:
+        sys.exit("ERROR: %s is empty" % args.input)
+
+    blocks = [lzf_block(data[i:i + bsize])
+              for i in range(0, len(data), bsize)]
+
+    offset = 12 + 4 * (nblocks + 1)
+    index = []
+    for block in blocks:
+        index.append(offset)
+        offset += len(block)
+    index.append(offset)
+
+    with open(args.output, "wb") as f:
+        f.write(struct.pack(">4sBBHI", LZFBLK_MAGIC, LZFBLK_VERSION, bshift,
+                            0, nblocks))
+        f.write(struct.pack(">%dI" % len(index), *index))
+        for block in blocks:
+            f.write(block)
+
+    print("%s: %d blocks of %d bytes, %d -> %d bytes" %
+          (args.output, nblocks, bsize, len(data), offset))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,270 @@
+#!/usr/bin/env python3
+############################################################################
+# tools/syslogdecode.py
+#
+# Licensed to the Apache Software Foundation (ASF) under one or more
+# contributor license agreements.  See the NOTICE file distributed with
+# this work for additional information regarding copyright ownership.  The
+# ASF licenses this file to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance with the
+# License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+# License for the specific language governing permissions and limitations
+# under the License.
+#
+############################################################################
+
+"""Format the binary SYSLOG records of CONFIG_SYSLOG_BINARY.
+
+The records hold the address of the format string and the raw arguments
+(see drivers/syslog/syslog_binary.c).  The format strings are read from
+the ELF file of the firmware.  Anything in the log that is not a record
+is passed through unchanged.
+
+Usage: syslogdecode.py [-o <output>] <elf-file> [<log-file>]
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SYSLOG_BINARY_MAGIC = 0xFE
+
+SYSLOG_BINARY_BIGENDIAN = 0x01
+SYSLOG_BINARY_TIMESTAMP = 0x02
+SYSLOG_BINARY_TRUNCATED = 0x04
+SYSLOG_BINARY_PTRSHIFT = 4
+
+SHT_NOBITS = 8
+SHF_ALLOC = 2
+
+CONVERSION = re.compile(
+    r"%([-+ #0']*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|j|z|t|L)?(.)"
+)
+
+
+class Elf:
+    """Just enough of an ELF reader to find strings by their address."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError("%s: not an ELF file" % path)
+
+        is64 = self.data[4] == 2
+        endian = ">" if self.data[5] == 2 else "<"
+
+        if is64:
+            shoff, = struct.unpack_from(endian + "Q", self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + "HH",
+                                                  self.data, 0x3A)
+            shdr = endian + "IIQQQQ"
+        else:
+            shoff, = struct.unpack_from(endian + "I", self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + "HH",
+                                                  self.data, 0x2E)
+            shdr = endian + "IIIIII"
+
+        self.sections = []
+        for i in range(shnum):
+            _, shtype, flags, addr, offset, size = struct.unpack_from(
+                shdr, self.data, shoff + i * shentsize)
+            if shtype != SHT_NOBITS and (flags & SHF_ALLOC) and size > 0:
+                self.sections.append((addr, offset, size))
+
+    def string(self, addr):
+        for base, offset, size in self.sections:
+            if base <= addr < base + size:
+                start = offset + addr - base
+                end = self.data.find(b"\0", start, offset + size)
+                if end < 0:
+                    end = offset + size
+                return self.data[start:end].decode("latin-1")
+        return None
+
+
+def take_args(record, pos, endian, ptrsize):
+    """Return the list of (tag, value) pairs of a record."""
+
+    args = []
+    while pos < len(record):
+        tag = chr(record[pos])
+        pos += 1
+        if tag == "i":
+            value, = struct.unpack_from(endian + "I", record, pos)
+            pos += 4
+        elif tag == "q":
+            value, = struct.unpack_from(endian + "Q", record, pos)
+            pos += 8
+        elif tag == "f":
+            value, = struct.unpack_from(endian + "d", record, pos)
+            pos += 8
+        elif tag == "p":
+            value = int.from_bytes(record[pos:pos + ptrsize],
+                                   "big" if endian == ">" else "little")
+            pos += ptrsize
+        elif tag == "s":
+            end = record.find(b"\0", pos)
+            if end < 0:
+                end = len(record)
+            value = record[pos:end].decode("latin-1")
+            pos = end + 1
+        else:
+            break
+        args.append((tag, value))
+    return args
+
+
+def signed(tag, value):
+    bits = 32 if tag == "i" else 64
+    if value & (1 << (bits - 1)):
+        value -= 1 << bits
+    return value
+
+
+def format_record(fmt, args):
+    """Format the arguments like the C library would."""
+
+    args = list(args)
+
+    def next_arg():
+        return args.pop(0) if args else (None, None)
+
+    def convert(match):
+        flags, width, precision, _, conv = match.groups()
+        if conv == "%":
+            return "%"
+
+        flags = flags.replace("'", "")
+        if width == "*":
+            _, width = next_arg()
+            width = str(signed("i", width)) if width is not None else ""
+        if precision == "*":
+            _, precision = next_arg()
+            precision = (str(signed("i", precision))
+                         if precision is not None else "")
+
+        spec = "%" + flags + (width or "")
+        if precision is not None:
+            spec += "." + precision
+
+        if conv == "n":
+            next_arg()
+            return ""
+
+        tag, value = next_arg()
+        if tag is None:
+            return "<?>"
+
+        if conv in "di":
+            return (spec + "d") % signed(tag, value)
+        if conv == "u":
+            return (spec + "d") % value
+        if conv in "oxX":
+            return (spec + conv) % value
+        if conv == "c":
+            return (spec + "c") % chr(value & 0xFF)
+        if conv == "p":
+            return (spec + "s") % ("0x%x" % value)
+        if conv == "s":
+            return (spec + "s") % value
+        if conv in "aA":
+            text = float(value).hex()
+            return text.upper() if conv == "A" else text
+        if conv in "eEfFgG":
+            return (spec + conv) % value
+        return match.group(0)
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def decode(elf, data, out):
+    pos = 0
+    while pos < len(data):
+        start = data.find(bytes([SYSLOG_BINARY_MAGIC]), pos)
+        if start < 0:
+            start = len(data)
+
+        out.write(data[pos:start].decode("latin-1"))
+        pos = start
+        if pos >= len(data):
+            break
+
+        text = None
+        if pos + 2 <= len(data):
+            flags = data[pos + 1]
+            endian = ">" if flags & SYSLOG_BINARY_BIGENDIAN else "<"
+            ptrsize = flags >> SYSLOG_BINARY_PTRSHIFT
+            hdrsize = 5 + ptrsize
+            if ptrsize in (2, 4, 8) and pos + hdrsize <= len(data):
+                size, = struct.unpack_from(endian + "H", data, pos + 2)
+                if hdrsize <= size and pos + size <= len(data):
+                    text = decode_record(elf, data[pos:pos + size], flags,
+                                         endian, ptrsize)
+
+        if text is None:
+            # Not a record.  Pass the byte through.
+
+            out.write(chr(data[pos]))
+            pos += 1
+        else:
+            out.write(text)
+            pos += size
+
+
+def decode_record(elf, record, flags, endian, ptrsize):
+    addr = int.from_bytes(record[5:5 + ptrsize],
+                          "big" if endian == ">" else "little")
+    pos = 5 + ptrsize
+
+    prefix = ""
+    if flags & SYSLOG_BINARY_TIMESTAMP:
+        sec, usec = struct.unpack_from(endian + "II", record, pos)
+        pos += 8
+        prefix = "[%5d.%06d] " % (sec, usec)
+
+    fmt = elf.string(addr)
+    if fmt is None:
+        return prefix + "<unknown format 0x%x>\n" % addr
+
+    text = prefix + format_record(fmt,
+                                  take_args(record, pos, endian, ptrsize))
+    if flags & SYSLOG_BINARY_TRUNCATED:
+        text += "[truncated]\n"
+    return text
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Format the binary SYSLOG records of a NuttX target")
+    parser.add_argument("elf", help="The ELF file of the firmware")
+    parser.add_argument("log", nargs="?",
+                        help="The binary log (default: stdin)")
+    parser.add_argument("-o", "--output",
+                        help="The output file (default: stdout)")
+    args = parser.parse_args()
+
+    elf = Elf(args.elf)
+    if args.log:
+        with open(args.log, "rb") as f:
+            data = f.read()
+    else:
+        data = sys.stdin.buffer.read()
+
+    if args.output:
+        with open(args.output, "w") as out:
+            decode(elf, data, out)
+    else:
+        decode(elf, data, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -179,6 +179,12 @@ static int conn_tx_kthread(int argc, FAR char *argv[])
           break;
         }
 
+      /* Account for the controller buffer before sending so that the
+       * completion cannot be seen first.
+       */
+
+      bt_atomic_incr(&conn->pending_pkts);
+
       wlinfo("passing buf %p len %u to driver\n", buf, buf->len);
       g_btdev.btdev->send(g_btdev.btdev, buf);
       bt_buf_release(buf);
@@ -448,7 +454,7 @@ void bt_conn_send(FAR struct bt_conn_s *conn, FAR struct bt_buf_s *buf)
       buf = bt_l2cap_create_pdu(conn);
 
       len = remaining;
-      if (len < g_btdev.le_mtu)
+      if (len > g_btdev.le_mtu)
         {
           len = g_btdev.le_mtu;
         }
@@ -98,6 +98,13 @@ struct bt_conn_s
 
   mqd_t tx_queue;
 
+  /* Number of ACL packets passed to the controller for which no Number of
+   * Completed Packets event was received yet.  Each holds one of the
+   * controller buffers counted by g_btdev.le_pkts_sem.
+   */
+
+  bt_atomic_t pending_pkts;
+
   FAR struct bt_keys_s *keys;
 
   /* Fixed channel contexts */
@@ -432,6 +432,7 @@ static void hci_num_completed_packets(FAR struct bt_buf_s *buf)
 
   for (i = 0; i < num_handles; i++)
     {
+      FAR struct bt_conn_s *conn;
       uint16_t handle;
       uint16_t count;
 
@@ -439,12 +440,25 @@ static void hci_num_completed_packets(FAR struct bt_buf_s *buf)
       count  = BT_LE162HOST(evt->h[i].count);
 
       wlinfo("handle %u count %u\n", handle, count);
-      UNUSED(handle);
 
-      while (count--)
+      /* The buffers of a connection that is gone were already given back
+       * by hci_disconn_complete().
+       */
+
+      conn = bt_conn_lookup_handle(handle);
+      if (!conn)
+        {
+          wlwarn("WARNING: No conn for handle %u\n", handle);
+          continue;
+        }
+
+      while (count-- && bt_atomic_get(&conn->pending_pkts) > 0)
         {
+          bt_atomic_decr(&conn->pending_pkts);
           nxsem_post(&g_btdev.le_pkts_sem);
         }
+
+      bt_conn_release(conn);
     }
 }
 
@@ -653,6 +667,16 @@ static void hci_disconn_complete(FAR struct bt_buf_s *buf)
   bt_l2cap_disconnected(conn);
   bt_disconnected(conn);
 
+  /* The controller flushes the packets that were not transmitted and will
+   * not report them as completed.  Give their buffers back.
+   */
+
+  while (bt_atomic_get(&conn->pending_pkts) > 0)
+    {
+      bt_atomic_decr(&conn->pending_pkts);
+      nxsem_post(&g_btdev.le_pkts_sem);
+    }
+
   bt_conn_set_state(conn, BT_CONN_DISCONNECTED);
   conn->handle = 0;
 